@@ -54,6 +54,7 @@ Public Enum CRYPT_ALGO_TYPE
     CRYPT_ALGO_RESERVED1            ' Formerly RC5 
     CRYPT_ALGO_AES                  ' AES 
     CRYPT_ALGO_RESERVED2            ' Formerly Blowfish 
+    CRYPT_ALGO_CHACHA20             ' ChaCha20 
 
     ' Public-key encryption 
     CRYPT_ALGO_DH = 100             ' Diffie-Hellman 
@@ -112,6 +113,7 @@ Public Enum CRYPT_MODE_TYPE
     CRYPT_MODE_CBC                  ' CBC 
     CRYPT_MODE_CFB                  ' CFB 
     CRYPT_MODE_GCM                  ' GCM 
+    CRYPT_MODE_CTR                  ' CTR 
     CRYPT_MODE_LAST                 ' Last possible crypt mode value 
     
 
@@ -358,6 +360,29 @@ Public Enum CRYPT_ATTRIBUTE_TYPE
     CRYPT_OPTION_CONFIGCHANGED      ' Whether in-mem.opts match on-disk ones 
     CRYPT_OPTION_SELFTESTOK         ' Whether self-test was completed and OK 
 
+    ' Session key pool options, the hit/miss counts are read-only 
+    CRYPT_OPTION_SESSION_KEYPOOLSIZE ' Pre-generated DH/ECDH keys per group 
+    CRYPT_OPTION_SESSION_KEYPOOLLOWWATER ' Key pool refill threshold 
+    CRYPT_OPTION_SESSION_KEYPOOLHITS ' Key requests satisfied from pool 
+    CRYPT_OPTION_SESSION_KEYPOOLMISSES ' Key requests not satisfied from pool 
+
+    ' Crypto kernel selection 
+    CRYPT_OPTION_MISC_CPUTIER       ' Restrict crypto code to CPU tier 
+    CRYPT_OPTION_MISC_CPUKERNELS    ' Crypto kernels in use (read-only) 
+
+    ' TLS session ticket options 
+    CRYPT_OPTION_SESSION_TICKETKEYFILE ' Shared TLS session ticket keys 
+    CRYPT_OPTION_SESSION_TICKETHITS ' Sessions resumed from ticket 
+    CRYPT_OPTION_SESSION_TICKETMISSES ' Tickets that couldn't be used 
+
+    ' TLS session cache options 
+    CRYPT_OPTION_SESSION_CACHESIZE  ' TLS session cache entries 
+    CRYPT_OPTION_SESSION_CACHEFILE  ' Shared TLS session cache file 
+
+    ' OCSP stapling options 
+    CRYPT_OPTION_SESSION_OCSPSTAPLING ' Whether TLS server staples OCSP resp. 
+    CRYPT_OPTION_SESSION_OCSPRESPONDER ' OCSP responder for stapled resp. 
+
     ' Used internally 
     CRYPT_OPTION_LAST
     CRYPT_CTXINFO_FIRST = 1000
@@ -1045,6 +1070,19 @@ Public Enum CRYPT_ATTRIBUTE_TYPE
     CRYPT_SESSINFO_SSL_OPTIONS      ' SSL/TLS protocol options 
     CRYPT_SESSINFO_TSP_MSGIMPRINT   ' TSP message imprint 
 
+    ' Further pseudo-information about the session 
+    CRYPT_SESSINFO_NETWORKEVENTS    ' Network events session is waiting for 
+    CRYPT_SESSINFO_NONBLOCKING      ' Session driven from external event loop 
+    CRYPT_SESSINFO_CORK             ' Hold back flushes to coalesce writes 
+
+    ' Handshake timing information, in microseconds 
+    CRYPT_SESSINFO_TIMING_CONNECT   ' Network connection established 
+    CRYPT_SESSINFO_TIMING_HELLOSENT ' Hello sent 
+    CRYPT_SESSINFO_TIMING_HELLORECEIVED ' Hello received 
+    CRYPT_SESSINFO_TIMING_KEYEXCHANGE ' Key exchange computed 
+    CRYPT_SESSINFO_TIMING_CERTVERIFIED ' Peer cert/key verified 
+    CRYPT_SESSINFO_TIMING_FINISHED  ' Handshake completed 
+
     ' Used internally 
     CRYPT_SESSINFO_LAST
     CRYPT_USERINFO_FIRST = 7000
@@ -1369,6 +1407,22 @@ End Enum
   Public Const CRYPT_SSLOPTION_SUITEB_128 As Long = &H100   ' SuiteB security levels (may 
   Public Const CRYPT_SSLOPTION_SUITEB_256 As Long = &H200   '  vanish in future releases) 
 
+'  Network events that a session is waiting for, used when the session is
+'  being driven from an external event loop via select()/poll()/epoll() 
+'  with CRYPT_SESSINFO_NONBLOCKING set.  While the handshake is in progress
+'  they indicate what the handshake is waiting for before the session can
+'  be activated again.
+'  CRYPT_NETWORKEVENT_READ means that the socket should be polled for
+'  readability, CRYPT_NETWORKEVENT_WRITE that there's buffered data still
+'  waiting to be flushed, and CRYPT_NETWORKEVENT_DATA that there's already
+'  data (or a pending error) available to cryptPopData() without any further
+'  network I/O 
+
+  Public Const CRYPT_NETWORKEVENT_NONE As Long = &H00
+  Public Const CRYPT_NETWORKEVENT_READ As Long = &H01   ' Wait for socket readable 
+  Public Const CRYPT_NETWORKEVENT_WRITE As Long = &H02   ' Wait for socket writeable 
+  Public Const CRYPT_NETWORKEVENT_DATA As Long = &H04   ' Data already available 
+
 '****************************************************************************
 '*                                                                           *
 '*                               General Constants                           *
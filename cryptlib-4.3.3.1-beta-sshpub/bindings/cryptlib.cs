@@ -32,6 +32,7 @@ public class crypt
 	public const int ALGO_RESERVED1          = 7  ; // Formerly RC5
 	public const int ALGO_AES                = 8  ; // AES
 	public const int ALGO_RESERVED2          = 9  ; // Formerly Blowfish
+	public const int ALGO_CHACHA20           = 10 ; // ChaCha20
 	public const int ALGO_DH                 = 100; // Diffie-Hellman
 	public const int ALGO_RSA                = 101; // RSA
 	public const int ALGO_DSA                = 102; // DSA
@@ -68,7 +69,8 @@ public class crypt
 	public const int MODE_CBC  = 2; // CBC
 	public const int MODE_CFB  = 3; // CFB
 	public const int MODE_GCM  = 4; // GCM
-	public const int MODE_LAST = 5; // Last possible crypt mode value
+	public const int MODE_CTR  = 5; // CTR
+	public const int MODE_LAST = 6; // Last possible crypt mode value
 	
 	
 	/* Keyset subtypes */
@@ -240,7 +242,20 @@ public class crypt
 	public const int OPTION_MISC_SIDECHANNELPROTECTION           = 141 ; // Protect against side-channel attacks
 	public const int OPTION_CONFIGCHANGED                        = 142 ; // Whether in-mem.opts match on-disk ones
 	public const int OPTION_SELFTESTOK                           = 143 ; // Whether self-test was completed and OK
-	public const int OPTION_LAST                                 = 144 ;
+	public const int OPTION_SESSION_KEYPOOLSIZE                  = 144 ; // Pre-generated DH/ECDH keys per group
+	public const int OPTION_SESSION_KEYPOOLLOWWATER              = 145 ; // Key pool refill threshold
+	public const int OPTION_SESSION_KEYPOOLHITS                  = 146 ; // Key requests satisfied from pool
+	public const int OPTION_SESSION_KEYPOOLMISSES                = 147 ; // Key requests not satisfied from pool
+	public const int OPTION_MISC_CPUTIER                         = 148 ; // Restrict crypto code to CPU tier
+	public const int OPTION_MISC_CPUKERNELS                      = 149 ; // Crypto kernels in use (read-only)
+	public const int OPTION_SESSION_TICKETKEYFILE                = 150 ; // Shared TLS session ticket keys
+	public const int OPTION_SESSION_TICKETHITS                   = 151 ; // Sessions resumed from ticket
+	public const int OPTION_SESSION_TICKETMISSES                 = 152 ; // Tickets that couldn't be used
+	public const int OPTION_SESSION_CACHESIZE                    = 153 ; // TLS session cache entries
+	public const int OPTION_SESSION_CACHEFILE                    = 154 ; // Shared TLS session cache file
+	public const int OPTION_SESSION_OCSPSTAPLING                 = 155 ; // Whether TLS server staples OCSP resp.
+	public const int OPTION_SESSION_OCSPRESPONDER                = 156 ; // OCSP responder for stapled resp.
+	public const int OPTION_LAST                                 = 157 ;
 	public const int CTXINFO_FIRST                               = 1000; // ********************
 	public const int CTXINFO_ALGO                                = 1001; // Algorithm
 	public const int CTXINFO_MODE                                = 1002; // Mode
@@ -659,7 +674,16 @@ public class crypt
 	public const int SESSINFO_SSH_CHANNEL_ACTIVE                 = 6025; // SSH channel active
 	public const int SESSINFO_SSL_OPTIONS                        = 6026; // SSL/TLS protocol options
 	public const int SESSINFO_TSP_MSGIMPRINT                     = 6027; // TSP message imprint
-	public const int SESSINFO_LAST                               = 6028;
+	public const int SESSINFO_NETWORKEVENTS                      = 6028; // Network events session is waiting for
+	public const int SESSINFO_NONBLOCKING                        = 6029; // Session driven from external event loop
+	public const int SESSINFO_CORK                               = 6030; // Hold back flushes to coalesce writes
+	public const int SESSINFO_TIMING_CONNECT                     = 6031; // Network connection established
+	public const int SESSINFO_TIMING_HELLOSENT                   = 6032; // Hello sent
+	public const int SESSINFO_TIMING_HELLORECEIVED               = 6033; // Hello received
+	public const int SESSINFO_TIMING_KEYEXCHANGE                 = 6034; // Key exchange computed
+	public const int SESSINFO_TIMING_CERTVERIFIED                = 6035; // Peer cert/key verified
+	public const int SESSINFO_TIMING_FINISHED                    = 6036; // Handshake completed
+	public const int SESSINFO_LAST                               = 6037;
 	public const int USERINFO_FIRST                              = 7000; // ********************
 	public const int USERINFO_PASSWORD                           = 7001; // Password
 	public const int USERINFO_CAKEY_CERTSIGN                     = 7002; // CA cert signing key
@@ -924,6 +948,22 @@ public class crypt
 	public const int SSLOPTION_SUITEB_128                     = 0x100; // SuiteB security levels (may
 	public const int SSLOPTION_SUITEB_256                     = 0x200; // vanish in future releases)
 	
+	/* Network events that a session is waiting for, used when the session is
+	   being driven from an external event loop via select()/poll()/epoll() 
+	   with CRYPT_SESSINFO_NONBLOCKING set.  While the handshake is in progress
+	   they indicate what the handshake is waiting for before the session can
+	   be activated again.
+	   CRYPT_NETWORKEVENT_READ means that the socket should be polled for
+	   readability, CRYPT_NETWORKEVENT_WRITE that there's buffered data still
+	   waiting to be flushed, and CRYPT_NETWORKEVENT_DATA that there's already
+	   data (or a pending error) available to cryptPopData() without any further
+	   network I/O */
+	
+	public const int NETWORKEVENT_NONE                        = 0x00;
+	public const int NETWORKEVENT_READ                        = 0x01; // Wait for socket readable
+	public const int NETWORKEVENT_WRITE                       = 0x02; // Wait for socket writeable
+	public const int NETWORKEVENT_DATA                        = 0x04; // Data already available
+	
 	/****************************************************************************
 	*																			*
 	*								General Constants							*
@@ -70,6 +70,7 @@ const
   CRYPT_ALGO_RESERVED1 = 7;  { Formerly RC5 }
   CRYPT_ALGO_AES = 8;  { AES }
   CRYPT_ALGO_RESERVED2 = 9;  { Formerly Blowfish }
+  CRYPT_ALGO_CHACHA20 = 10;  { ChaCha20 }
   
   { Public-key encryption }
   CRYPT_ALGO_DH = 100;  { Diffie-Hellman }
@@ -129,6 +130,7 @@ type
     CRYPT_MODE_CBC,                 {  CBC  }
     CRYPT_MODE_CFB,                 {  CFB  }
     CRYPT_MODE_GCM,                 {  GCM  }
+    CRYPT_MODE_CTR,                 {  CTR  }
     CRYPT_MODE_LAST                 {  Last possible crypt mode value  }
     
   );
@@ -368,8 +370,31 @@ const
   CRYPT_OPTION_CONFIGCHANGED = 142;  { Whether in-mem.opts match on-disk ones }
   CRYPT_OPTION_SELFTESTOK = 143;  { Whether self-test was completed and OK }
   
+  { Session key pool options, the hit/miss counts are read-only }
+  CRYPT_OPTION_SESSION_KEYPOOLSIZE = 144;  { Pre-generated DH/ECDH keys per group }
+  CRYPT_OPTION_SESSION_KEYPOOLLOWWATER = 145;  { Key pool refill threshold }
+  CRYPT_OPTION_SESSION_KEYPOOLHITS = 146;  { Key requests satisfied from pool }
+  CRYPT_OPTION_SESSION_KEYPOOLMISSES = 147;  { Key requests not satisfied from pool }
+  
+  { Crypto kernel selection }
+  CRYPT_OPTION_MISC_CPUTIER = 148;  { Restrict crypto code to CPU tier }
+  CRYPT_OPTION_MISC_CPUKERNELS = 149;  { Crypto kernels in use (read-only) }
+  
+  { TLS session ticket options }
+  CRYPT_OPTION_SESSION_TICKETKEYFILE = 150;  { Shared TLS session ticket keys }
+  CRYPT_OPTION_SESSION_TICKETHITS = 151;  { Sessions resumed from ticket }
+  CRYPT_OPTION_SESSION_TICKETMISSES = 152;  { Tickets that couldn't be used }
+  
+  { TLS session cache options }
+  CRYPT_OPTION_SESSION_CACHESIZE = 153;  { TLS session cache entries }
+  CRYPT_OPTION_SESSION_CACHEFILE = 154;  { Shared TLS session cache file }
+  
+  { OCSP stapling options }
+  CRYPT_OPTION_SESSION_OCSPSTAPLING = 155;  { Whether TLS server staples OCSP resp. }
+  CRYPT_OPTION_SESSION_OCSPRESPONDER = 156;  { OCSP responder for stapled resp. }
+  
   { Used internally }
-  CRYPT_OPTION_LAST = 144;  CRYPT_CTXINFO_FIRST = 1000;  
+  CRYPT_OPTION_LAST = 157;  CRYPT_CTXINFO_FIRST = 1000;  
   
   {********************}
   { Context attributes }
@@ -1049,8 +1074,21 @@ const
   CRYPT_SESSINFO_SSL_OPTIONS = 6026;  { SSL/TLS protocol options }
   CRYPT_SESSINFO_TSP_MSGIMPRINT = 6027;  { TSP message imprint }
   
+  { Further pseudo-information about the session }
+  CRYPT_SESSINFO_NETWORKEVENTS = 6028;  { Network events session is waiting for }
+  CRYPT_SESSINFO_NONBLOCKING = 6029;  { Session driven from external event loop }
+  CRYPT_SESSINFO_CORK = 6030;  { Hold back flushes to coalesce writes }
+  
+  { Handshake timing information, in microseconds }
+  CRYPT_SESSINFO_TIMING_CONNECT = 6031;  { Network connection established }
+  CRYPT_SESSINFO_TIMING_HELLOSENT = 6032;  { Hello sent }
+  CRYPT_SESSINFO_TIMING_HELLORECEIVED = 6033;  { Hello received }
+  CRYPT_SESSINFO_TIMING_KEYEXCHANGE = 6034;  { Key exchange computed }
+  CRYPT_SESSINFO_TIMING_CERTVERIFIED = 6035;  { Peer cert/key verified }
+  CRYPT_SESSINFO_TIMING_FINISHED = 6036;  { Handshake completed }
+  
   { Used internally }
-  CRYPT_SESSINFO_LAST = 6028;  CRYPT_USERINFO_FIRST = 7000;  
+  CRYPT_SESSINFO_LAST = 6037;  CRYPT_USERINFO_FIRST = 7000;  
   
   {********************}
   { User attributes }
@@ -1372,6 +1410,24 @@ const
   CRYPT_SSLOPTION_SUITEB_128 = $100;   {  SuiteB security levels (may  }
   CRYPT_SSLOPTION_SUITEB_256 = $200;   {   vanish in future releases)  }
 
+{  Network events that a session is waiting for, used when the session is
+   being driven from an external event loop via select()/poll()/epoll() 
+   with CRYPT_SESSINFO_NONBLOCKING set.  While the handshake is in progress
+   they indicate what the handshake is waiting for before the session can
+   be activated again.
+   CRYPT_NETWORKEVENT_READ means that the socket should be polled for
+   readability, CRYPT_NETWORKEVENT_WRITE that there's buffered data still
+   waiting to be flushed, and CRYPT_NETWORKEVENT_DATA that there's already
+   data (or a pending error) available to cryptPopData() without any further
+   network I/O  }
+
+
+const
+  CRYPT_NETWORKEVENT_NONE = $00;
+  CRYPT_NETWORKEVENT_READ = $01;   {  Wait for socket readable  }
+  CRYPT_NETWORKEVENT_WRITE = $02;   {  Wait for socket writeable  }
+  CRYPT_NETWORKEVENT_DATA = $04;   {  Data already available  }
+
 {****************************************************************************
 *                                                                           *
 *                               General Constants                           *
@@ -27,6 +27,8 @@
 #define cryptlib_crypt_ALGO_AES 8L
 #undef cryptlib_crypt_ALGO_RESERVED2
 #define cryptlib_crypt_ALGO_RESERVED2 9L
+#undef cryptlib_crypt_ALGO_CHACHA20
+#define cryptlib_crypt_ALGO_CHACHA20 10L
 #undef cryptlib_crypt_ALGO_DH
 #define cryptlib_crypt_ALGO_DH 100L
 #undef cryptlib_crypt_ALGO_RSA
@@ -95,8 +97,10 @@
 #define cryptlib_crypt_MODE_CFB 3L
 #undef cryptlib_crypt_MODE_GCM
 #define cryptlib_crypt_MODE_GCM 4L
+#undef cryptlib_crypt_MODE_CTR
+#define cryptlib_crypt_MODE_CTR 5L
 #undef cryptlib_crypt_MODE_LAST
-#define cryptlib_crypt_MODE_LAST 5L
+#define cryptlib_crypt_MODE_LAST 6L
 #undef cryptlib_crypt_KEYSET_NONE
 #define cryptlib_crypt_KEYSET_NONE 0L
 #undef cryptlib_crypt_KEYSET_FILE
@@ -347,8 +351,34 @@
 #define cryptlib_crypt_OPTION_CONFIGCHANGED 142L
 #undef cryptlib_crypt_OPTION_SELFTESTOK
 #define cryptlib_crypt_OPTION_SELFTESTOK 143L
+#undef cryptlib_crypt_OPTION_SESSION_KEYPOOLSIZE
+#define cryptlib_crypt_OPTION_SESSION_KEYPOOLSIZE 144L
+#undef cryptlib_crypt_OPTION_SESSION_KEYPOOLLOWWATER
+#define cryptlib_crypt_OPTION_SESSION_KEYPOOLLOWWATER 145L
+#undef cryptlib_crypt_OPTION_SESSION_KEYPOOLHITS
+#define cryptlib_crypt_OPTION_SESSION_KEYPOOLHITS 146L
+#undef cryptlib_crypt_OPTION_SESSION_KEYPOOLMISSES
+#define cryptlib_crypt_OPTION_SESSION_KEYPOOLMISSES 147L
+#undef cryptlib_crypt_OPTION_MISC_CPUTIER
+#define cryptlib_crypt_OPTION_MISC_CPUTIER 148L
+#undef cryptlib_crypt_OPTION_MISC_CPUKERNELS
+#define cryptlib_crypt_OPTION_MISC_CPUKERNELS 149L
+#undef cryptlib_crypt_OPTION_SESSION_TICKETKEYFILE
+#define cryptlib_crypt_OPTION_SESSION_TICKETKEYFILE 150L
+#undef cryptlib_crypt_OPTION_SESSION_TICKETHITS
+#define cryptlib_crypt_OPTION_SESSION_TICKETHITS 151L
+#undef cryptlib_crypt_OPTION_SESSION_TICKETMISSES
+#define cryptlib_crypt_OPTION_SESSION_TICKETMISSES 152L
+#undef cryptlib_crypt_OPTION_SESSION_CACHESIZE
+#define cryptlib_crypt_OPTION_SESSION_CACHESIZE 153L
+#undef cryptlib_crypt_OPTION_SESSION_CACHEFILE
+#define cryptlib_crypt_OPTION_SESSION_CACHEFILE 154L
+#undef cryptlib_crypt_OPTION_SESSION_OCSPSTAPLING
+#define cryptlib_crypt_OPTION_SESSION_OCSPSTAPLING 155L
+#undef cryptlib_crypt_OPTION_SESSION_OCSPRESPONDER
+#define cryptlib_crypt_OPTION_SESSION_OCSPRESPONDER 156L
 #undef cryptlib_crypt_OPTION_LAST
-#define cryptlib_crypt_OPTION_LAST 144L
+#define cryptlib_crypt_OPTION_LAST 157L
 #undef cryptlib_crypt_CTXINFO_FIRST
 #define cryptlib_crypt_CTXINFO_FIRST 1000L
 #undef cryptlib_crypt_CTXINFO_ALGO
@@ -1183,8 +1213,26 @@
 #define cryptlib_crypt_SESSINFO_SSL_OPTIONS 6026L
 #undef cryptlib_crypt_SESSINFO_TSP_MSGIMPRINT
 #define cryptlib_crypt_SESSINFO_TSP_MSGIMPRINT 6027L
+#undef cryptlib_crypt_SESSINFO_NETWORKEVENTS
+#define cryptlib_crypt_SESSINFO_NETWORKEVENTS 6028L
+#undef cryptlib_crypt_SESSINFO_NONBLOCKING
+#define cryptlib_crypt_SESSINFO_NONBLOCKING 6029L
+#undef cryptlib_crypt_SESSINFO_CORK
+#define cryptlib_crypt_SESSINFO_CORK 6030L
+#undef cryptlib_crypt_SESSINFO_TIMING_CONNECT
+#define cryptlib_crypt_SESSINFO_TIMING_CONNECT 6031L
+#undef cryptlib_crypt_SESSINFO_TIMING_HELLOSENT
+#define cryptlib_crypt_SESSINFO_TIMING_HELLOSENT 6032L
+#undef cryptlib_crypt_SESSINFO_TIMING_HELLORECEIVED
+#define cryptlib_crypt_SESSINFO_TIMING_HELLORECEIVED 6033L
+#undef cryptlib_crypt_SESSINFO_TIMING_KEYEXCHANGE
+#define cryptlib_crypt_SESSINFO_TIMING_KEYEXCHANGE 6034L
+#undef cryptlib_crypt_SESSINFO_TIMING_CERTVERIFIED
+#define cryptlib_crypt_SESSINFO_TIMING_CERTVERIFIED 6035L
+#undef cryptlib_crypt_SESSINFO_TIMING_FINISHED
+#define cryptlib_crypt_SESSINFO_TIMING_FINISHED 6036L
 #undef cryptlib_crypt_SESSINFO_LAST
-#define cryptlib_crypt_SESSINFO_LAST 6028L
+#define cryptlib_crypt_SESSINFO_LAST 6037L
 #undef cryptlib_crypt_USERINFO_FIRST
 #define cryptlib_crypt_USERINFO_FIRST 7000L
 #undef cryptlib_crypt_USERINFO_PASSWORD
@@ -1539,6 +1587,14 @@
 #define cryptlib_crypt_SSLOPTION_SUITEB_128 256L
 #undef cryptlib_crypt_SSLOPTION_SUITEB_256
 #define cryptlib_crypt_SSLOPTION_SUITEB_256 512L
+#undef cryptlib_crypt_NETWORKEVENT_NONE
+#define cryptlib_crypt_NETWORKEVENT_NONE 0L
+#undef cryptlib_crypt_NETWORKEVENT_READ
+#define cryptlib_crypt_NETWORKEVENT_READ 1L
+#undef cryptlib_crypt_NETWORKEVENT_WRITE
+#define cryptlib_crypt_NETWORKEVENT_WRITE 2L
+#undef cryptlib_crypt_NETWORKEVENT_DATA
+#define cryptlib_crypt_NETWORKEVENT_DATA 4L
 #undef cryptlib_crypt_MAX_KEYSIZE
 #define cryptlib_crypt_MAX_KEYSIZE 256L
 #undef cryptlib_crypt_MAX_IVSIZE
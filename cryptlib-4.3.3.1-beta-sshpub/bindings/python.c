@@ -1592,6 +1592,10 @@ class CryptHandle:\n\
     PyDict_SetItemString(moduleDict, "CRYPT_ALGO_RESERVED2", v);
     Py_DECREF(v); /* Formerly Blowfish */
 
+    v = Py_BuildValue("i", CRYPT_ALGO_CHACHA20);
+    PyDict_SetItemString(moduleDict, "CRYPT_ALGO_CHACHA20", v);
+    Py_DECREF(v); /* ChaCha20 */
+
     v = Py_BuildValue("i", CRYPT_ALGO_DH);
     PyDict_SetItemString(moduleDict, "CRYPT_ALGO_DH", v);
     Py_DECREF(v); /* Diffie-Hellman */
@@ -1728,6 +1732,10 @@ class CryptHandle:\n\
     PyDict_SetItemString(moduleDict, "CRYPT_MODE_GCM", v);
     Py_DECREF(v); /* GCM */
 
+    v = Py_BuildValue("i", CRYPT_MODE_CTR);
+    PyDict_SetItemString(moduleDict, "CRYPT_MODE_CTR", v);
+    Py_DECREF(v); /* CTR */
+
     v = Py_BuildValue("i", CRYPT_MODE_LAST);
     PyDict_SetItemString(moduleDict, "CRYPT_MODE_LAST", v);
     Py_DECREF(v); /* Last possible crypt mode value */
@@ -2232,6 +2240,58 @@ class CryptHandle:\n\
     PyDict_SetItemString(moduleDict, "CRYPT_OPTION_SELFTESTOK", v);
     Py_DECREF(v); /* Whether self-test was completed and OK */
 
+    v = Py_BuildValue("i", CRYPT_OPTION_SESSION_KEYPOOLSIZE);
+    PyDict_SetItemString(moduleDict, "CRYPT_OPTION_SESSION_KEYPOOLSIZE", v);
+    Py_DECREF(v); /* Pre-generated DH/ECDH keys per group */
+
+    v = Py_BuildValue("i", CRYPT_OPTION_SESSION_KEYPOOLLOWWATER);
+    PyDict_SetItemString(moduleDict, "CRYPT_OPTION_SESSION_KEYPOOLLOWWATER", v);
+    Py_DECREF(v); /* Key pool refill threshold */
+
+    v = Py_BuildValue("i", CRYPT_OPTION_SESSION_KEYPOOLHITS);
+    PyDict_SetItemString(moduleDict, "CRYPT_OPTION_SESSION_KEYPOOLHITS", v);
+    Py_DECREF(v); /* Key requests satisfied from pool */
+
+    v = Py_BuildValue("i", CRYPT_OPTION_SESSION_KEYPOOLMISSES);
+    PyDict_SetItemString(moduleDict, "CRYPT_OPTION_SESSION_KEYPOOLMISSES", v);
+    Py_DECREF(v); /* Key requests not satisfied from pool */
+
+    v = Py_BuildValue("i", CRYPT_OPTION_MISC_CPUTIER);
+    PyDict_SetItemString(moduleDict, "CRYPT_OPTION_MISC_CPUTIER", v);
+    Py_DECREF(v); /* Restrict crypto code to CPU tier */
+
+    v = Py_BuildValue("i", CRYPT_OPTION_MISC_CPUKERNELS);
+    PyDict_SetItemString(moduleDict, "CRYPT_OPTION_MISC_CPUKERNELS", v);
+    Py_DECREF(v); /* Crypto kernels in use (read-only) */
+
+    v = Py_BuildValue("i", CRYPT_OPTION_SESSION_TICKETKEYFILE);
+    PyDict_SetItemString(moduleDict, "CRYPT_OPTION_SESSION_TICKETKEYFILE", v);
+    Py_DECREF(v); /* Shared TLS session ticket keys */
+
+    v = Py_BuildValue("i", CRYPT_OPTION_SESSION_TICKETHITS);
+    PyDict_SetItemString(moduleDict, "CRYPT_OPTION_SESSION_TICKETHITS", v);
+    Py_DECREF(v); /* Sessions resumed from ticket */
+
+    v = Py_BuildValue("i", CRYPT_OPTION_SESSION_TICKETMISSES);
+    PyDict_SetItemString(moduleDict, "CRYPT_OPTION_SESSION_TICKETMISSES", v);
+    Py_DECREF(v); /* Tickets that couldn't be used */
+
+    v = Py_BuildValue("i", CRYPT_OPTION_SESSION_CACHESIZE);
+    PyDict_SetItemString(moduleDict, "CRYPT_OPTION_SESSION_CACHESIZE", v);
+    Py_DECREF(v); /* TLS session cache entries */
+
+    v = Py_BuildValue("i", CRYPT_OPTION_SESSION_CACHEFILE);
+    PyDict_SetItemString(moduleDict, "CRYPT_OPTION_SESSION_CACHEFILE", v);
+    Py_DECREF(v); /* Shared TLS session cache file */
+
+    v = Py_BuildValue("i", CRYPT_OPTION_SESSION_OCSPSTAPLING);
+    PyDict_SetItemString(moduleDict, "CRYPT_OPTION_SESSION_OCSPSTAPLING", v);
+    Py_DECREF(v); /* Whether TLS server staples OCSP resp. */
+
+    v = Py_BuildValue("i", CRYPT_OPTION_SESSION_OCSPRESPONDER);
+    PyDict_SetItemString(moduleDict, "CRYPT_OPTION_SESSION_OCSPRESPONDER", v);
+    Py_DECREF(v); /* OCSP responder for stapled resp. */
+
     v = Py_BuildValue("i", CRYPT_OPTION_LAST);
     PyDict_SetItemString(moduleDict, "CRYPT_OPTION_LAST", v);
     Py_DECREF(v);
@@ -3908,6 +3968,42 @@ class CryptHandle:\n\
     PyDict_SetItemString(moduleDict, "CRYPT_SESSINFO_TSP_MSGIMPRINT", v);
     Py_DECREF(v); /* TSP message imprint */
 
+    v = Py_BuildValue("i", CRYPT_SESSINFO_NETWORKEVENTS);
+    PyDict_SetItemString(moduleDict, "CRYPT_SESSINFO_NETWORKEVENTS", v);
+    Py_DECREF(v); /* Network events session is waiting for */
+
+    v = Py_BuildValue("i", CRYPT_SESSINFO_NONBLOCKING);
+    PyDict_SetItemString(moduleDict, "CRYPT_SESSINFO_NONBLOCKING", v);
+    Py_DECREF(v); /* Session driven from external event loop */
+
+    v = Py_BuildValue("i", CRYPT_SESSINFO_CORK);
+    PyDict_SetItemString(moduleDict, "CRYPT_SESSINFO_CORK", v);
+    Py_DECREF(v); /* Hold back flushes to coalesce writes */
+
+    v = Py_BuildValue("i", CRYPT_SESSINFO_TIMING_CONNECT);
+    PyDict_SetItemString(moduleDict, "CRYPT_SESSINFO_TIMING_CONNECT", v);
+    Py_DECREF(v); /* Network connection established */
+
+    v = Py_BuildValue("i", CRYPT_SESSINFO_TIMING_HELLOSENT);
+    PyDict_SetItemString(moduleDict, "CRYPT_SESSINFO_TIMING_HELLOSENT", v);
+    Py_DECREF(v); /* Hello sent */
+
+    v = Py_BuildValue("i", CRYPT_SESSINFO_TIMING_HELLORECEIVED);
+    PyDict_SetItemString(moduleDict, "CRYPT_SESSINFO_TIMING_HELLORECEIVED", v);
+    Py_DECREF(v); /* Hello received */
+
+    v = Py_BuildValue("i", CRYPT_SESSINFO_TIMING_KEYEXCHANGE);
+    PyDict_SetItemString(moduleDict, "CRYPT_SESSINFO_TIMING_KEYEXCHANGE", v);
+    Py_DECREF(v); /* Key exchange computed */
+
+    v = Py_BuildValue("i", CRYPT_SESSINFO_TIMING_CERTVERIFIED);
+    PyDict_SetItemString(moduleDict, "CRYPT_SESSINFO_TIMING_CERTVERIFIED", v);
+    Py_DECREF(v); /* Peer cert/key verified */
+
+    v = Py_BuildValue("i", CRYPT_SESSINFO_TIMING_FINISHED);
+    PyDict_SetItemString(moduleDict, "CRYPT_SESSINFO_TIMING_FINISHED", v);
+    Py_DECREF(v); /* Handshake completed */
+
     v = Py_BuildValue("i", CRYPT_SESSINFO_LAST);
     PyDict_SetItemString(moduleDict, "CRYPT_SESSINFO_LAST", v);
     Py_DECREF(v);
@@ -4668,6 +4764,22 @@ class CryptHandle:\n\
     PyDict_SetItemString(moduleDict, "CRYPT_SSLOPTION_SUITEB_256", v);
     Py_DECREF(v); /* vanish in future releases) */
 
+    v = Py_BuildValue("i", CRYPT_NETWORKEVENT_NONE);
+    PyDict_SetItemString(moduleDict, "CRYPT_NETWORKEVENT_NONE", v);
+    Py_DECREF(v);
+
+    v = Py_BuildValue("i", CRYPT_NETWORKEVENT_READ);
+    PyDict_SetItemString(moduleDict, "CRYPT_NETWORKEVENT_READ", v);
+    Py_DECREF(v); /* Wait for socket readable */
+
+    v = Py_BuildValue("i", CRYPT_NETWORKEVENT_WRITE);
+    PyDict_SetItemString(moduleDict, "CRYPT_NETWORKEVENT_WRITE", v);
+    Py_DECREF(v); /* Wait for socket writeable */
+
+    v = Py_BuildValue("i", CRYPT_NETWORKEVENT_DATA);
+    PyDict_SetItemString(moduleDict, "CRYPT_NETWORKEVENT_DATA", v);
+    Py_DECREF(v); /* Data already available */
+
     v = Py_BuildValue("i", CRYPT_MAX_KEYSIZE);
     PyDict_SetItemString(moduleDict, "CRYPT_MAX_KEYSIZE", v);
     Py_DECREF(v);
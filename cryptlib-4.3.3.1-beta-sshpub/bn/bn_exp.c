@@ -695,6 +695,12 @@ int BN_mod_exp_mont_consttime(BIGNUM *rr, const BIGNUM *a, const BIGNUM *p,
 		return ret;
 		}
 
+#ifdef USE_BN_IFMA
+	/* If the CPU supports AVX-512 IFMA, use the vectorised version - pcg */
+	if (!a->neg && bn_mod_exp_ifma_ok(m))
+		return bn_mod_exp_mont_ifma(rr, a, p, m, ctx);
+#endif /* USE_BN_IFMA */
+
  	/* Initialize BIGNUM context and allocate intermediate result */
 	BN_CTX_start(ctx);
 	r = BN_CTX_get(ctx);
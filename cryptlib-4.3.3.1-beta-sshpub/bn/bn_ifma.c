@@ -0,0 +1,456 @@
+/****************************************************************************
+*																			*
+*				cryptlib AVX-512 IFMA Modular Exponentiation				*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+/* A vectorised constant-time modexp for x86-64 CPUs with the AVX-512 IFMA
+   (integer fused multiply-add) extensions.  The operands are held in a
+   redundant radix-2^52 representation, one digit per 64-bit lane, so that
+   the vpmadd52luq/vpmadd52huq instructions can accumulate the low and high
+   halves of eight 52 x 52-bit products per instruction.  The Montgomery
+   multiply is the "almost Montgomery" variant in which results are only
+   reduced to < 2m rather than < m, which avoids a conditional subtract
+   after every multiply at the cost of requiring R > 4m.
+
+   This is used by BN_mod_exp_mont_consttime() for moduli of 1024 bits and
+   up, which covers the CRT halves of RSA-2048/3072/4096 private-key ops
+   and DH key agreement with the private x.  On CPUs without IFMA the
+   existing scalar code is used */
+
+#if defined( INC_ALL )
+  #include "bn_lcl.h"
+#else
+  #include "bn/bn_lcl.h"
+#endif /* Compiler-specific includes */
+
+#ifdef USE_BN_IFMA
+
+#include <immintrin.h>
+#if defined( _MSC_VER )
+  #define BN_IFMA_INLINE	static __forceinline
+#else
+  #define BN_IFMA_INLINE	static inline __attribute__(( always_inline ))
+#endif /* Compiler-specific inlining */
+
+/* The digit size and mask for the radix-2^52 representation, the number of
+   digits in a vector, the maximum number of vectors (enough for a 4096-bit
+   modulus with two bits of headroom for the almost-Montgomery R > 4m
+   requirement), and the fixed window size used for the exponentiation */
+
+#define IFMA_DIGIT_BITS		52
+#define IFMA_DIGIT_MASK		( ( ( BN_ULONG ) 1 << IFMA_DIGIT_BITS ) - 1 )
+#define IFMA_VECTOR_DIGITS	8
+#define IFMA_MIN_VECTORS	3
+#define IFMA_MAX_VECTORS	10
+#define IFMA_WINDOW_BITS	5
+#define IFMA_NO_POWERS		( 1 << IFMA_WINDOW_BITS )
+
+/* Round a pointer up to the next cache line */
+
+#define IFMA_ALIGN( ptr ) \
+		( ( unsigned char * ) ( ptr ) + \
+		  ( MOD_EXP_CTIME_MIN_CACHE_LINE_WIDTH - \
+			( ( ( size_t ) ( ptr ) ) & MOD_EXP_CTIME_MIN_CACHE_LINE_MASK ) ) )
+
+/****************************************************************************
+*																			*
+*								CPU Capability Check						*
+*																			*
+****************************************************************************/
+
+/* Check whether the CPU supports AVX-512F and AVX-512 IFMA and the OS saves
+   the full ZMM register state on context switches.  The CPU capabilities 
+   are determined when cryptlib starts up, see getHWInfo() in 
+   misc/os_spec.c */
+
+static int hasIFMA( void )
+	{
+	return( ( getSysVar( SYSVAR_HWCAP ) & HWCAP_FLAG_AVX512IFMA ) ? \
+			TRUE : FALSE );
+	}
+
+/* Check whether we can use the IFMA code for a given modulus */
+
+int bn_mod_exp_ifma_ok( const BIGNUM *m )
+	{
+	const int bits = BN_num_bits( m );
+
+	if( bits < 1024 || \
+		bits + 2 > IFMA_MAX_VECTORS * IFMA_VECTOR_DIGITS * IFMA_DIGIT_BITS )
+		return( 0 );
+	return( hasIFMA() );
+	}
+
+/* Everything from here on is only called once we know that the CPU
+   supports IFMA */
+
+#if defined( __GNUC__ ) && !defined( _MSC_VER )
+  #pragma GCC target( "avx512f,avx512ifma" )
+#endif /* gcc/clang */
+
+/****************************************************************************
+*																			*
+*								Utility Functions							*
+*																			*
+****************************************************************************/
+
+/* Convert a bignum to and from the radix-2^52 form */
+
+static void bnToDigits( BN_ULONG *digits, const BIGNUM *bn,
+						const int noDigits )
+	{
+	int i;
+
+	for( i = 0; i < noDigits; i++ )
+		{
+		const int bitPos = i * IFMA_DIGIT_BITS;
+		const int word = bitPos / BN_BITS2, shift = bitPos % BN_BITS2;
+		BN_ULONG value = 0;
+
+		if( word < bn->top )
+			{
+			value = bn->d[ word ] >> shift;
+			if( shift > BN_BITS2 - IFMA_DIGIT_BITS && word + 1 < bn->top )
+				value |= bn->d[ word + 1 ] << ( BN_BITS2 - shift );
+			}
+		digits[ i ] = value & IFMA_DIGIT_MASK;
+		}
+	}
+
+static int digitsToBn( BIGNUM *bn, const BN_ULONG *digits,
+					   const int noDigits )
+	{
+	const int noWords = ( ( noDigits * IFMA_DIGIT_BITS ) + \
+						  BN_BITS2 - 1 ) / BN_BITS2;
+	int i;
+
+	if( bn_wexpand( bn, noWords + 1 ) == NULL )
+		return( 0 );
+	memset( bn->d, 0, ( noWords + 1 ) * sizeof( BN_ULONG ) );
+	for( i = 0; i < noDigits; i++ )
+		{
+		const int bitPos = i * IFMA_DIGIT_BITS;
+		const int word = bitPos / BN_BITS2, shift = bitPos % BN_BITS2;
+
+		bn->d[ word ] |= digits[ i ] << shift;
+		if( shift > BN_BITS2 - IFMA_DIGIT_BITS )
+			bn->d[ word + 1 ] |= digits[ i ] >> ( BN_BITS2 - shift );
+		}
+	bn->top = noWords;
+	bn->neg = 0;
+	bn_correct_top( bn );
+
+	return( 1 );
+	}
+
+/* Set r = r - m if r >= m, without any data-dependent branches */
+
+static void condSubtract( BN_ULONG *r, const BN_ULONG *m,
+						  const int noDigits )
+	{
+	BN_ULONG diff[ IFMA_MAX_VECTORS * IFMA_VECTOR_DIGITS ];
+	BN_ULONG borrow = 0, mask;
+	int i;
+
+	for( i = 0; i < noDigits; i++ )
+		{
+		const BN_ULONG value = r[ i ] - m[ i ] - borrow;
+
+		diff[ i ] = value & IFMA_DIGIT_MASK;
+		borrow = value >> ( BN_BITS2 - 1 );
+		}
+
+	/* If there's no borrow out then r >= m and we use the difference */
+	mask = borrow - 1;
+	for( i = 0; i < noDigits; i++ )
+		r[ i ] = ( diff[ i ] & mask ) | ( r[ i ] & ~mask );
+	}
+
+/* Compute k0 = -m^-1 mod 2^52 using Newton iteration, each step doubling
+   the number of correct low bits starting from the three bits that are
+   correct for any odd m when using m as its own inverse */
+
+static BN_ULONG getK0( const BN_ULONG m0 )
+	{
+	BN_ULONG inverse = m0;
+	int i;
+
+	for( i = 0; i < 5; i++ )
+		inverse *= 2 - ( m0 * inverse );
+
+	return( ( 0 - inverse ) & IFMA_DIGIT_MASK );
+	}
+
+/****************************************************************************
+*																			*
+*							Montgomery Multiplication						*
+*																			*
+****************************************************************************/
+
+/* Almost-Montgomery multiply r = a * b * R^-1 mod m with R = 2^52n, for
+   a, b < 2m.  Each iteration adds the low halves of a * b[i] and
+   m * q[i], at which point the bottom digit is zero, shifts the
+   accumulator down by one digit, and adds the high halves of the products,
+   which now line up with their correct digit positions.  The accumulator
+   lanes aren't normalised until the end, with at most 4 * 80 52-bit values
+   added to a lane there's no danger of overflow */
+
+BN_IFMA_INLINE void ammCore( BN_ULONG *r, const BN_ULONG *a,
+							 const BN_ULONG *b, const BN_ULONG *m,
+							 const BN_ULONG k0, const int noVectors )
+	{
+	__m512i acc[ IFMA_MAX_VECTORS ];
+	const __m512i zero = _mm512_setzero_si512();
+	BN_ULONG carry;
+	int i, j;
+
+	for( j = 0; j < noVectors; j++ )
+		acc[ j ] = zero;
+	for( i = 0; i < noVectors * IFMA_VECTOR_DIGITS; i++ )
+		{
+		const __m512i bi = _mm512_set1_epi64( b[ i ] );
+		__m512i qi;
+		BN_ULONG acc0, q;
+
+		/* acc += lo( a * b[i] ), then q = acc[0] * k0 mod 2^52 */
+		for( j = 0; j < noVectors; j++ )
+			{
+			acc[ j ] = _mm512_madd52lo_epu64( acc[ j ],
+						_mm512_load_si512( a + j * IFMA_VECTOR_DIGITS ), bi );
+			}
+		acc0 = _mm_cvtsi128_si64( _mm512_castsi512_si128( acc[ 0 ] ) );
+		q = ( acc0 * k0 ) & IFMA_DIGIT_MASK;
+		qi = _mm512_set1_epi64( q );
+
+		/* acc += lo( m * q ), after which the bottom digit is zero apart
+		   from the carry into the next digit */
+		for( j = 0; j < noVectors; j++ )
+			{
+			acc[ j ] = _mm512_madd52lo_epu64( acc[ j ],
+						_mm512_load_si512( m + j * IFMA_VECTOR_DIGITS ), qi );
+			}
+		carry = ( acc0 + ( ( m[ 0 ] * q ) & IFMA_DIGIT_MASK ) ) >> \
+				IFMA_DIGIT_BITS;
+
+		/* Shift the accumulator down one digit and add the carry */
+		for( j = 0; j < noVectors - 1; j++ )
+			acc[ j ] = _mm512_alignr_epi64( acc[ j + 1 ], acc[ j ], 1 );
+		acc[ noVectors - 1 ] = _mm512_alignr_epi64( zero,
+													acc[ noVectors - 1 ], 1 );
+		acc[ 0 ] = _mm512_mask_add_epi64( acc[ 0 ], 1, acc[ 0 ],
+										  _mm512_set1_epi64( carry ) );
+
+		/* acc += hi( a * b[i] ) + hi( m * q ) */
+		for( j = 0; j < noVectors; j++ )
+			{
+			acc[ j ] = _mm512_madd52hi_epu64( acc[ j ],
+						_mm512_load_si512( a + j * IFMA_VECTOR_DIGITS ), bi );
+			acc[ j ] = _mm512_madd52hi_epu64( acc[ j ],
+						_mm512_load_si512( m + j * IFMA_VECTOR_DIGITS ), qi );
+			}
+		}
+
+	/* Normalise the result back to 52-bit digits.  Since the result is
+	   < 2m < R there's no carry out of the top digit */
+	for( j = 0; j < noVectors; j++ )
+		_mm512_store_si512( r + j * IFMA_VECTOR_DIGITS, acc[ j ] );
+	carry = 0;
+	for( i = 0; i < noVectors * IFMA_VECTOR_DIGITS; i++ )
+		{
+		const BN_ULONG value = r[ i ] + carry;
+
+		r[ i ] = value & IFMA_DIGIT_MASK;
+		carry = value >> IFMA_DIGIT_BITS;
+		}
+	}
+
+/* Instantiate the multiply for each vector count so that the compiler can
+   unroll the inner loops and keep the accumulator in registers */
+
+typedef void ( *AMM_FUNCTION )( BN_ULONG *r, const BN_ULONG *a,
+								const BN_ULONG *b, const BN_ULONG *m,
+								const BN_ULONG k0 );
+
+#define AMM_INSTANCE( noVectors ) \
+	static void amm##noVectors( BN_ULONG *r, const BN_ULONG *a, \
+								const BN_ULONG *b, const BN_ULONG *m, \
+								const BN_ULONG k0 ) \
+		{ \
+		ammCore( r, a, b, m, k0, noVectors ); \
+		}
+
+AMM_INSTANCE( 3 )
+AMM_INSTANCE( 4 )
+AMM_INSTANCE( 5 )
+AMM_INSTANCE( 6 )
+AMM_INSTANCE( 7 )
+AMM_INSTANCE( 8 )
+AMM_INSTANCE( 9 )
+AMM_INSTANCE( 10 )
+
+static const AMM_FUNCTION ammFunctions[ IFMA_MAX_VECTORS + 1 ] = {
+	NULL, NULL, NULL, amm3, amm4, amm5, amm6, amm7, amm8, amm9, amm10
+	};
+
+/****************************************************************************
+*																			*
+*							Modular Exponentiation							*
+*																			*
+****************************************************************************/
+
+/* Copy table entry `index' into dest.  Every entry is read and the wanted
+   one is selected with a mask so that the memory access pattern is
+   independent of the index */
+
+static void selectPower( BN_ULONG *dest, const BN_ULONG *table,
+						 const int index, const int noVectors )
+	{
+	const int noDigits = noVectors * IFMA_VECTOR_DIGITS;
+	const __m512i indexVector = _mm512_set1_epi64( index );
+	__m512i value[ IFMA_MAX_VECTORS ];
+	int i, j;
+
+	for( j = 0; j < noVectors; j++ )
+		value[ j ] = _mm512_setzero_si512();
+	for( i = 0; i < IFMA_NO_POWERS; i++ )
+		{
+		const __mmask8 selectMask = \
+			_mm512_cmpeq_epi64_mask( _mm512_set1_epi64( i ), indexVector );
+
+		for( j = 0; j < noVectors; j++ )
+			{
+			value[ j ] = _mm512_mask_mov_epi64( value[ j ], selectMask,
+							_mm512_load_si512( table + ( i * noDigits ) + \
+											   ( j * IFMA_VECTOR_DIGITS ) ) );
+			}
+		}
+	for( j = 0; j < noVectors; j++ )
+		_mm512_store_si512( dest + j * IFMA_VECTOR_DIGITS, value[ j ] );
+	}
+
+/* Extract the exponent window with its low bit at bitPos */
+
+static int getWindow( const BIGNUM *p, const int bitPos )
+	{
+	const int word = bitPos / BN_BITS2, shift = bitPos % BN_BITS2;
+	BN_ULONG value = 0;
+
+	if( word < p->top )
+		{
+		value = p->d[ word ] >> shift;
+		if( shift > BN_BITS2 - IFMA_WINDOW_BITS && word + 1 < p->top )
+			value |= p->d[ word + 1 ] << ( BN_BITS2 - shift );
+		}
+
+	return( ( int ) ( value & ( IFMA_NO_POWERS - 1 ) ) );
+	}
+
+/* rr = a^p mod m using a fixed window and the IFMA Montgomery multiply.
+   The caller has checked m with bn_mod_exp_ifma_ok(), and that m is odd
+   and p is nonzero */
+
+int bn_mod_exp_mont_ifma( BIGNUM *rr, const BIGNUM *a, const BIGNUM *p,
+						  const BIGNUM *m, BN_CTX *ctx )
+	{
+	const int modBits = BN_num_bits( m );
+	const int noVectors = ( modBits + 2 + \
+							( IFMA_VECTOR_DIGITS * IFMA_DIGIT_BITS ) - 1 ) / \
+						  ( IFMA_VECTOR_DIGITS * IFMA_DIGIT_BITS );
+	const int noDigits = noVectors * IFMA_VECTOR_DIGITS;
+	const int workspaceLen = ( IFMA_NO_POWERS + 5 ) * noDigits * \
+							 sizeof( BN_ULONG );
+	AMM_FUNCTION amm;
+	BN_ULONG *table, *mod, *rr2, *one, *r, *tmp, k0;
+	BIGNUM *t, *R;
+	unsigned char *workspaceFree;
+	int bits, bitPos, i, ret = 0;
+
+	if( noVectors < IFMA_MIN_VECTORS || noVectors > IFMA_MAX_VECTORS || \
+		!BN_is_odd( m ) || a->neg )
+		return( 0 );
+	amm = ammFunctions[ noVectors ];
+
+	/* Allocate the cache-line-aligned workspace for the table of powers and
+	   the working values */
+	workspaceFree = clBnAlloc( "bn_mod_exp_mont_ifma",
+							   workspaceLen + MOD_EXP_CTIME_MIN_CACHE_LINE_WIDTH );
+	if( workspaceFree == NULL )
+		return( 0 );
+	table = ( BN_ULONG * ) IFMA_ALIGN( workspaceFree );
+	memset( table, 0, workspaceLen );
+	mod = table + ( IFMA_NO_POWERS * noDigits );
+	rr2 = mod + noDigits;
+	one = rr2 + noDigits;
+	r = one + noDigits;
+	tmp = r + noDigits;
+
+	/* Convert the modulus and get the Montgomery constants k0 and
+	   R^2 mod m for R = 2^52n.  R and the square of R mod m can be larger 
+	   than a standard bignum so they need an extended bignum */
+	BN_CTX_start( ctx );
+	t = BN_CTX_get( ctx );
+	R = BN_CTX_get_ext( ctx, BIGNUM_EXT_MONT );
+	if( t == NULL || R == NULL )
+		goto err;
+	bnToDigits( mod, m, noDigits );
+	k0 = getK0( m->d[ 0 ] );
+	one[ 0 ] = 1;
+	BN_zero( R );
+	if( !BN_set_bit( R, noDigits * IFMA_DIGIT_BITS ) || \
+		!BN_mod( t, R, m, ctx ) || !BN_sqr( R, t, ctx ) || \
+		!BN_mod( t, R, m, ctx ) )
+		goto err;
+	bnToDigits( rr2, t, noDigits );
+
+	/* Precompute the powers a^0 ... a^31 in Montgomery form */
+	if( BN_ucmp( a, m ) >= 0 )
+		{
+		if( !BN_mod( t, a, m, ctx ) )
+			goto err;
+		bnToDigits( tmp, t, noDigits );
+		}
+	else
+		bnToDigits( tmp, a, noDigits );
+	amm( table, rr2, one, mod, k0 );
+	amm( table + noDigits, tmp, rr2, mod, k0 );
+	for( i = 2; i < IFMA_NO_POWERS; i++ )
+		{
+		amm( table + ( i * noDigits ), table + ( ( i - 1 ) * noDigits ),
+			 table + noDigits, mod, k0 );
+		}
+
+	/* Process the exponent one window at a time starting from the most
+	   significant bits.  The exponent length is padded to a multiple of
+	   the window size so that there are no special cases */
+	bits = BN_num_bits( p );
+	bits = ( ( bits + IFMA_WINDOW_BITS - 1 ) / IFMA_WINDOW_BITS ) * \
+		   IFMA_WINDOW_BITS;
+	bitPos = bits - IFMA_WINDOW_BITS;
+	selectPower( r, table, getWindow( p, bitPos ), noVectors );
+	for( bitPos -= IFMA_WINDOW_BITS; bitPos >= 0;
+		 bitPos -= IFMA_WINDOW_BITS )
+		{
+		for( i = 0; i < IFMA_WINDOW_BITS; i++ )
+			amm( r, r, r, mod, k0 );
+		selectPower( tmp, table, getWindow( p, bitPos ), noVectors );
+		amm( r, r, tmp, mod, k0 );
+		}
+
+	/* Convert the result out of Montgomery form, which leaves it in the
+	   range 0...m, and perform the final reduction */
+	amm( r, r, one, mod, k0 );
+	condSubtract( r, mod, noDigits );
+	if( !digitsToBn( rr, r, noDigits ) )
+		goto err;
+	ret = 1;
+
+err:
+	BN_CTX_end_ext( ctx, BIGNUM_EXT_MONT );
+	OPENSSL_cleanse( table, workspaceLen );
+	OPENSSL_free( workspaceFree );
+
+	return( ret );
+	}
+#endif /* USE_BN_IFMA */
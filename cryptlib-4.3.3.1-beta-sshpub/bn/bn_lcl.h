@@ -545,6 +545,22 @@ BN_ULONG bn_sub_part_words(BN_ULONG *r, const BN_ULONG *a, const BN_ULONG *b,
 int bn_mul_mont(BN_ULONG *rp, const BN_ULONG *ap, const BN_ULONG *bp,
                 const BN_ULONG *np, const BN_ULONG *n0, int num);
 
+/* AVX-512 IFMA modexp used by BN_mod_exp_mont_consttime() on x86-64 CPUs 
+   that support it, see bn_ifma.c - pcg */
+
+#if ( defined( SIXTY_FOUR_BIT_LONG ) || defined( SIXTY_FOUR_BIT ) ) && \
+	( ( defined( __GNUC__ ) && ( __GNUC__ >= 8 ) && defined( __x86_64__ ) ) || \
+	  ( defined( __clang_major__ ) && ( __clang_major__ >= 7 ) && \
+		defined( __x86_64__ ) ) || \
+	  ( defined( _MSC_VER ) && ( _MSC_VER >= 1920 ) && defined( _M_X64 ) ) )
+  #define USE_BN_IFMA
+#endif /* gcc 8+/clang 7+/VS 2019+ on x86-64 */
+#ifdef USE_BN_IFMA
+int bn_mod_exp_ifma_ok(const BIGNUM *m);
+int bn_mod_exp_mont_ifma(BIGNUM *rr, const BIGNUM *a, const BIGNUM *p,
+                         const BIGNUM *m, BN_CTX *ctx);
+#endif /* USE_BN_IFMA */
+
 #ifdef  __cplusplus
 }
 #endif
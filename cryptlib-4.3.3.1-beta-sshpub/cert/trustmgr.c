@@ -373,13 +373,16 @@ int enumTrustedCerts( INOUT TYPECAST( TRUST_INFO ** ) void *trustInfoPtrPtr,
 *																			*
 ****************************************************************************/
 
-/* Add and delete a trust entry */
+/* Add and delete a trust entry.  If the hash of the encoded certificate's 
+   subject name has already been calculated by the caller then it's passed 
+   in as subjectHash */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
 static int addEntry( INOUT TYPECAST( TRUST_INFO ** ) void *trustInfoPtrPtr, 
 					 IN_HANDLE_OPT const CRYPT_CERTIFICATE iCryptCert, 
 					 IN_BUFFER_OPT( certObjectLength ) const void *certObject, 
-					 IN_LENGTH_SHORT_Z const int certObjectLength )
+					 IN_LENGTH_SHORT_Z const int certObjectLength,
+					 IN_BUFFER_OPT_C( HASH_DATA_SIZE ) const BYTE *subjectHash )
 	{
 	TRUST_INFO **trustInfoIndex = ( TRUST_INFO ** ) trustInfoPtrPtr;
 	TRUST_INFO *newElement, *trustInfoCursor, *trustInfoLast;
@@ -393,6 +396,8 @@ static int addEntry( INOUT TYPECAST( TRUST_INFO ** ) void *trustInfoPtrPtr,
 			  isHandleRangeValid( iCryptCert ) ) || \
 			( isReadPtrDynamic( certObject, certObjectLength ) && \
 			  iCryptCert == CRYPT_UNUSED ) );
+	assert( subjectHash == NULL || \
+			isReadPtr( subjectHash, HASH_DATA_SIZE ) );
 
 	REQUIRES( ( certObject == NULL && certObjectLength == 0 && \
 				isHandleRangeValid( iCryptCert ) ) || \
@@ -400,6 +405,7 @@ static int addEntry( INOUT TYPECAST( TRUST_INFO ** ) void *trustInfoPtrPtr,
 			    certObjectLength >= MIN_CRYPT_OBJECTSIZE && \
 				certObjectLength < MAX_INTLENGTH_SHORT && \
 				iCryptCert == CRYPT_UNUSED ) );
+	REQUIRES( subjectHash == NULL || certObject != NULL );
 
 	/* If we're adding a certificate, check whether it has a context 
 	   attached and if it does, whether it's a public-key context.  If 
@@ -478,7 +484,10 @@ static int addEntry( INOUT TYPECAST( TRUST_INFO ** ) void *trustInfoPtrPtr,
 		/* Generate the checksum and hash of the encoded certificate's 
 		   subject name and key ID */
 		sCheck = checksumData( subjectDNptr, subjectDNsize );
-		hashData( sHash, HASH_DATA_SIZE, subjectDNptr, subjectDNsize );
+		if( subjectHash != NULL )
+			memcpy( sHash, subjectHash, HASH_DATA_SIZE );
+		else
+			hashData( sHash, HASH_DATA_SIZE, subjectDNptr, subjectDNsize );
 #if 0	/* sKID lookup isn't used at present */
 		kCheck = checksumData( subjectKeyIDptr, subjectKeyIDsize );
 		hashData( kHash, HASH_DATA_SIZE, subjectKeyIDptr, subjectKeyIDsize );
@@ -595,7 +604,7 @@ int addTrustEntry( INOUT TYPECAST( TRUST_INFO ** ) void *trustInfoPtrPtr,
 	if( certObject != NULL )
 		{
 		return( addEntry( trustInfoPtrPtr, CRYPT_UNUSED, certObject, 
-						  certObjectLength ) );
+						  certObjectLength, NULL ) );
 		}
 
 	/* Add the certificate/each certificate in the trust list */
@@ -605,7 +614,7 @@ int addTrustEntry( INOUT TYPECAST( TRUST_INFO ** ) void *trustInfoPtrPtr,
 		return( status );
 	if( addSingleCert )
 		{
-		status = addEntry( trustInfoPtrPtr, iCryptCert, NULL, 0 );
+		status = addEntry( trustInfoPtrPtr, iCryptCert, NULL, 0, NULL );
 		if( cryptStatusOK( status ) )
 			itemAdded = TRUE;
 		}
@@ -636,7 +645,7 @@ int addTrustEntry( INOUT TYPECAST( TRUST_INFO ** ) void *trustInfoPtrPtr,
 			   containing further certificates so we keep track of whether 
 			   we've successfully added at least one item and clear data 
 			   duplicate errors */
-			status = addEntry( trustInfoPtrPtr, iCryptCert, NULL, 0 );
+			status = addEntry( trustInfoPtrPtr, iCryptCert, NULL, 0, NULL );
 			if( cryptStatusError( status ) )
 				{
 				if( status != CRYPT_ERROR_DUPLICATE )
@@ -662,6 +671,68 @@ int addTrustEntry( INOUT TYPECAST( TRUST_INFO ** ) void *trustInfoPtrPtr,
 	return( CRYPT_OK );
 	}
 
+/* Add a group of encoded trusted certificates, typically read from the 
+   user's configuration data when the trust information is loaded.  This 
+   is identical to calling addTrustEntry() for each certificate except that 
+   the subject name hashes are calculated as a batch, which allows several 
+   of them to be calculated in parallel */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int addTrustEntries( INOUT TYPECAST( TRUST_INFO ** ) void *trustInfoPtrPtr, 
+					 IN_ARRAY( noCertObjects ) const void *certObjects[],
+					 IN_ARRAY( noCertObjects ) const int certObjectLengths[],
+					 IN_RANGE( 1, MAX_TRUSTENTRY_BATCH ) \
+						const int noCertObjects )
+	{
+	HASH_FUNCTION_BATCH hashFunctionBatch;
+	HASH_BATCH_INFO hashBatchInfo[ MAX_TRUSTENTRY_BATCH + 1 ];
+	int i, status, LOOP_ITERATOR;
+
+	assert( isWritePtr( trustInfoPtrPtr, \
+						sizeof( TRUST_INFO * ) * TRUSTINFO_SIZE ) );
+	assert( isReadPtrDynamic( certObjects, \
+							  sizeof( void * ) * noCertObjects ) );
+	assert( isReadPtrDynamic( certObjectLengths, \
+							  sizeof( int ) * noCertObjects ) );
+
+	REQUIRES( noCertObjects >= 1 && noCertObjects <= MAX_TRUSTENTRY_BATCH );
+
+	/* Locate the subject name in each certificate and hash the names as a 
+	   batch */
+	LOOP_MED( i = 0, i < noCertObjects, i++ )
+		{
+		void *subjectDNptr;
+		int subjectDNsize;
+
+		REQUIRES( certObjects[ i ] != NULL && \
+				  certObjectLengths[ i ] >= MIN_CRYPT_OBJECTSIZE && \
+				  certObjectLengths[ i ] < MAX_INTLENGTH_SHORT );
+
+		status = getCertIdInfo( certObjects[ i ], certObjectLengths[ i ], 
+								&subjectDNptr, &subjectDNsize );
+		if( cryptStatusError( status ) )
+			return( status );
+		ANALYSER_HINT( subjectDNptr != NULL );
+		hashBatchInfo[ i ].data = subjectDNptr;
+		hashBatchInfo[ i ].dataLength = subjectDNsize;
+		}
+	ENSURES( LOOP_BOUND_OK );
+	getHashBatchParameters( CRYPT_ALGO_SHA1, 0, &hashFunctionBatch, NULL );
+	hashFunctionBatch( hashBatchInfo, noCertObjects );
+
+	/* Add each certificate using the precomputed subject name hash */
+	LOOP_MED( i = 0, i < noCertObjects, i++ )
+		{
+		status = addEntry( trustInfoPtrPtr, CRYPT_UNUSED, certObjects[ i ], 
+						   certObjectLengths[ i ], hashBatchInfo[ i ].hash );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	return( CRYPT_OK );
+	}
+
 STDC_NONNULL_ARG( ( 1, 2 ) ) \
 void deleteTrustEntry( INOUT TYPECAST( TRUST_INFO ** ) void *trustInfoPtrPtr, 
 					   IN TYPECAST( TRUST_INFO * ) void *entryToDeletePtr )
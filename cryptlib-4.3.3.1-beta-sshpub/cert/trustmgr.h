@@ -9,6 +9,11 @@
 
 #define _TRUSTMGR_DEFINED
 
+/* The maximum number of certificates that can be added in one go with
+   addTrustEntries() */
+
+#define MAX_TRUSTENTRY_BATCH	8
+
 /* Prototypes for certificate trust managemer functions */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
@@ -21,6 +26,12 @@ int addTrustEntry( INOUT void *trustInfoPtr,
 				   IN_BUFFER_OPT( certObjectLength ) const void *certObject, 
 				   IN_LENGTH_SHORT_Z const int certObjectLength,
 				   const BOOLEAN addSingleCert );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int addTrustEntries( INOUT void *trustInfoPtr, 
+					 IN_ARRAY( noCertObjects ) const void *certObjects[],
+					 IN_ARRAY( noCertObjects ) const int certObjectLengths[],
+					 IN_RANGE( 1, MAX_TRUSTENTRY_BATCH ) \
+						const int noCertObjects );
 STDC_NONNULL_ARG( ( 1, 2 ) ) \
 void deleteTrustEntry( INOUT void *trustInfoPtr, 
 					   IN void *entryToDeletePtr );
@@ -48,6 +59,9 @@ int enumTrustedCerts( INOUT void *trustInfoPtr,
 #define addTrustEntry( trustInfoPtr, iCryptCert, certObject, \
 					   certObjectLength, addSingleCert ) \
 		CRYPT_ERROR_NOTAVAIL
+#define addTrustEntries( trustInfoPtr, certObjects, certObjectLengths, \
+						 noCertObjects ) \
+		CRYPT_ERROR_NOTAVAIL
 #define deleteTrustEntry( trustInfoPtr, entryToDelete )
 #define findTrustEntry( trustInfoPtr, cryptCert, getIssuerEntry ) \
 		NULL
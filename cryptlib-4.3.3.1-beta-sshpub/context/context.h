@@ -128,6 +128,14 @@
 
 #define DLP_OVERFLOW_SIZE			bitsToBytes( 64 )
 
+/* The OIDs for X25519 and Ed25519 keys from RFC 8410.  These are too 
+   short to be handled via the general-purpose AlgorithmIdentifier code, 
+   which assumes a minimum-length algorithm OID, so they're handled 
+   explicitly by the key read/write code */
+
+#define OID_X25519					MKOID( "\x06\x03\x2B\x65\x6E" )
+#define OID_ED25519					MKOID( "\x06\x03\x2B\x65\x70" )
+
 /****************************************************************************
 *																			*
 *							Context Data Structures							*
@@ -270,6 +278,12 @@ typedef struct {
 	EC_GROUP *ecCTX;
 	EC_POINT *ecPoint;
 #endif /* USE_ECDH || USE_ECDSA */
+#ifdef USE_25519
+	BUFFER_FIXED( X25519_KEYSIZE ) \
+	BYTE curve25519PublicKey[ X25519_KEYSIZE + 8 ];	/* Curve25519 keys, */
+	BUFFER_FIXED( X25519_KEYSIZE ) \
+	BYTE curve25519PrivateKey[ X25519_KEYSIZE + 8 ];/*  little-endian */
+#endif /* USE_25519 */
 	int checksum;					/* Checksum for key data */
 
 	/* Temporary workspace values used to avoid having to allocate and
@@ -486,6 +500,8 @@ typedef struct CI {
 #define eccParam_d			param3
 #define eccParam_tmp4		param4
 #define eccParam_tmp5		param5
+#define ecdhParam_qxPrime	param4		/* Special values for ECDH */
+#define ecdhParam_qyPrime	param5
 
 /* Minimum and maximum permitted lengths for various PKC components.  These
    can be loaded in various ways (read from ASN.1 data, read from 
@@ -854,4 +870,26 @@ void sha2_ExtHashBufferAtomic( OUT_BUFFER_C( outBufMaxLength, 64 ) BYTE *outBuff
 							   IN_BUFFER( inLength ) const void *inBuffer, 
 							   IN_LENGTH_SHORT const int inLength );
 
+STDC_NONNULL_ARG( ( 1 ) ) \
+void shaHashBufferBatch( INOUT_ARRAY( noEntries ) \
+							HASH_BATCH_INFO *hashBatchInfo,
+						 IN_INT_SHORT const int noEntries );
+STDC_NONNULL_ARG( ( 1 ) ) \
+void sha2HashBufferBatch( INOUT_ARRAY( noEntries ) \
+							HASH_BATCH_INFO *hashBatchInfo,
+						  IN_INT_SHORT const int noEntries );
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int shaHmacChain( IN TYPECAST( HASHINFO ) const void *innerHashState,
+				  IN TYPECAST( HASHINFO ) const void *outerHashState,
+				  INOUT_ARRAY( noChains ) HMAC_CHAIN_INFO *hmacChainInfo,
+				  IN_RANGE( 1, MAX_HMAC_CHAINS ) const int noChains,
+				  IN_INT const int iterations );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int sha2HmacChain( IN TYPECAST( HASHINFO ) const void *innerHashState,
+				   IN TYPECAST( HASHINFO ) const void *outerHashState,
+				   INOUT_ARRAY( noChains ) HMAC_CHAIN_INFO *hmacChainInfo,
+				   IN_RANGE( 1, MAX_HMAC_CHAINS ) const int noChains,
+				   IN_INT const int iterations );
+
 #endif /* _CRYPTCTX_DEFINED */
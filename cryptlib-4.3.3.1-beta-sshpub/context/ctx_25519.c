@@ -0,0 +1,449 @@
+/****************************************************************************
+*																			*
+*					cryptlib X25519 Key Exchange Routines					*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#define PKC_CONTEXT		/* Indicate that we're working with PKC contexts */
+#if defined( INC_ALL )
+  #include "crypt.h"
+  #include "context.h"
+  #include "curve25519.h"
+#else
+  #include "crypt.h"
+  #include "context/context.h"
+  #include "crypt/curve25519.h"
+#endif /* Compiler-specific includes */
+
+/* X25519 works in the same manner as ECDH, with an "export" phase that
+   outputs our public value and an "import" phase that takes the other
+   side's public value and produces the shared secret.  The difference is
+   that there are no domain parameters to load, the keys are fixed-size
+   little-endian byte strings rather than bignums or points, and the private
+   key is a random 32-byte value that's clamped internally by the scalar
+   multiplication code:
+
+	A.load:		a = rand
+	A.export	output = X25519( a, 9 )
+
+	B.load		b = rand
+	B.import	input = X25519( a, 9 )
+				z = X25519( b, input )
+
+	B.export	output = X25519( b, 9 )
+
+	A.import	input = X25519( b, 9 )
+				z = X25519( a, input ) */
+
+#ifdef USE_25519
+
+/****************************************************************************
+*																			*
+*								Utility Routines							*
+*																			*
+****************************************************************************/
+
+/* Check whether a value is all zeroes, in constant time.  This is used to
+   detect small-order input points, which produce an all-zero shared
+   secret */
+
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+static BOOLEAN isAllZeroes( IN_BUFFER( length ) const BYTE *data,
+							IN_LENGTH_SHORT const int length )
+	{
+	int value = 0, i;
+
+	assert( isReadPtrDynamic( data, length ) );
+
+	for( i = 0; i < length; i++ )
+		value |= data[ i ];
+
+	return( ( value == 0 ) ? TRUE : FALSE );
+	}
+
+/* Derive the public value from the private key */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int calculatePublicValue( INOUT PKC_INFO *pkcInfo )
+	{
+	assert( isWritePtr( pkcInfo, sizeof( PKC_INFO ) ) );
+
+	if( isAllZeroes( pkcInfo->curve25519PrivateKey, X25519_KEYSIZE ) )
+		return( CRYPT_ERROR_NOTINITED );
+	curve25519ScalarMultBase( pkcInfo->curve25519PublicKey,
+							  pkcInfo->curve25519PrivateKey );
+	pkcInfo->keySizeBits = bytesToBits( X25519_KEYSIZE );
+
+	return( CRYPT_OK );
+	}
+
+/****************************************************************************
+*																			*
+*								Algorithm Self-test							*
+*																			*
+****************************************************************************/
+
+/* Perform a pairwise consistency test on a public/private key pair */
+
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+static BOOLEAN pairwiseConsistencyTest( INOUT CONTEXT_INFO *contextInfoPtr )
+	{
+	CONTEXT_INFO checkContextInfo;
+	PKC_INFO contextData, *pkcInfo = &contextData;
+	KEYAGREE_PARAMS keyAgreeParams1, keyAgreeParams2;
+	const CAPABILITY_INFO *capabilityInfoPtr;
+	MESSAGE_DATA msgData;
+	int status;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+
+	REQUIRES_B( sanityCheckContext( contextInfoPtr ) );
+
+	/* As with ECDH there's no matched public/private key pair so we have to
+	   generate a second key to use for key agreement with the first one */
+	status = staticInitContext( &checkContextInfo, CONTEXT_PKC,
+								get25519Capability(), &contextData,
+								sizeof( PKC_INFO ), NULL );
+	if( cryptStatusError( status ) )
+		return( FALSE );
+	setMessageData( &msgData, pkcInfo->curve25519PrivateKey,
+					X25519_KEYSIZE );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_GETATTRIBUTE_S,
+							  &msgData, CRYPT_IATTRIBUTE_RANDOM );
+	if( cryptStatusError( status ) )
+		{
+		staticDestroyContext( &checkContextInfo );
+		return( FALSE );
+		}
+
+	/* Perform the pairwise test using the check key */
+	capabilityInfoPtr = DATAPTR_GET( checkContextInfo.capabilityInfo );
+	REQUIRES_B( capabilityInfoPtr != NULL );
+	memset( &keyAgreeParams1, 0, sizeof( KEYAGREE_PARAMS ) );
+	memset( &keyAgreeParams2, 0, sizeof( KEYAGREE_PARAMS ) );
+	status = capabilityInfoPtr->initKeyFunction( &checkContextInfo, NULL, 0 );
+	if( cryptStatusOK( status ) )
+		status = capabilityInfoPtr->encryptFunction( contextInfoPtr,
+					( BYTE * ) &keyAgreeParams1, sizeof( KEYAGREE_PARAMS ) );
+	if( cryptStatusOK( status ) )
+		status = capabilityInfoPtr->encryptFunction( &checkContextInfo,
+					( BYTE * ) &keyAgreeParams2, sizeof( KEYAGREE_PARAMS ) );
+	if( cryptStatusOK( status ) )
+		status = capabilityInfoPtr->decryptFunction( contextInfoPtr,
+					( BYTE * ) &keyAgreeParams2, sizeof( KEYAGREE_PARAMS ) );
+	if( cryptStatusOK( status ) )
+		status = capabilityInfoPtr->decryptFunction( &checkContextInfo,
+					( BYTE * ) &keyAgreeParams1, sizeof( KEYAGREE_PARAMS ) );
+	if( cryptStatusError( status ) || \
+		keyAgreeParams1.wrappedKeyLen != keyAgreeParams2.wrappedKeyLen || \
+		memcmp( keyAgreeParams1.wrappedKey, keyAgreeParams2.wrappedKey,
+				keyAgreeParams1.wrappedKeyLen ) )
+		status = CRYPT_ERROR_FAILED;
+
+	/* Clean up */
+	zeroise( &keyAgreeParams1, sizeof( KEYAGREE_PARAMS ) );
+	zeroise( &keyAgreeParams2, sizeof( KEYAGREE_PARAMS ) );
+	staticDestroyContext( &checkContextInfo );
+
+	return( cryptStatusOK( status ) ? TRUE : FALSE );
+	}
+
+#ifndef CONFIG_NO_SELFTEST
+
+/* Test the X25519 implementation using the test vectors from RFC 7748
+   sections 5.2 and 6.1.  The first checks the raw scalar multiplication
+   with a non-canonical input scalar, the second performs a full key
+   agreement between Alice and Bob */
+
+static const FAR_DATA BYTE x25519TestScalar[] = {
+	0xA5, 0x46, 0xE3, 0x6B, 0xF0, 0x52, 0x7C, 0x9D,
+	0x3B, 0x16, 0x15, 0x4B, 0x82, 0x46, 0x5E, 0xDD,
+	0x62, 0x14, 0x4C, 0x0A, 0xC1, 0xFC, 0x5A, 0x18,
+	0x50, 0x6A, 0x22, 0x44, 0xBA, 0x44, 0x9A, 0xC4
+	};
+static const FAR_DATA BYTE x25519TestPoint[] = {
+	0xE6, 0xDB, 0x68, 0x67, 0x58, 0x30, 0x30, 0xDB,
+	0x35, 0x94, 0xC1, 0xA4, 0x24, 0xB1, 0x5F, 0x7C,
+	0x72, 0x66, 0x24, 0xEC, 0x26, 0xB3, 0x35, 0x3B,
+	0x10, 0xA9, 0x03, 0xA6, 0xD0, 0xAB, 0x1C, 0x4C
+	};
+static const FAR_DATA BYTE x25519TestResult[] = {
+	0xC3, 0xDA, 0x55, 0x37, 0x9D, 0xE9, 0xC6, 0x90,
+	0x8E, 0x94, 0xEA, 0x4D, 0xF2, 0x8D, 0x08, 0x4F,
+	0x32, 0xEC, 0xCF, 0x03, 0x49, 0x1C, 0x71, 0xF7,
+	0x54, 0xB4, 0x07, 0x55, 0x77, 0xA2, 0x85, 0x52
+	};
+
+static const FAR_DATA BYTE x25519AlicePrivKey[] = {
+	0x77, 0x07, 0x6D, 0x0A, 0x73, 0x18, 0xA5, 0x7D,
+	0x3C, 0x16, 0xC1, 0x72, 0x51, 0xB2, 0x66, 0x45,
+	0xDF, 0x4C, 0x2F, 0x87, 0xEB, 0xC0, 0x99, 0x2A,
+	0xB1, 0x77, 0xFB, 0xA5, 0x1D, 0xB9, 0x2C, 0x2A
+	};
+static const FAR_DATA BYTE x25519AlicePubKey[] = {
+	0x85, 0x20, 0xF0, 0x09, 0x89, 0x30, 0xA7, 0x54,
+	0x74, 0x8B, 0x7D, 0xDC, 0xB4, 0x3E, 0xF7, 0x5A,
+	0x0D, 0xBF, 0x3A, 0x0D, 0x26, 0x38, 0x1A, 0xF4,
+	0xEB, 0xA4, 0xA9, 0x8E, 0xAA, 0x9B, 0x4E, 0x6A
+	};
+static const FAR_DATA BYTE x25519BobPubKey[] = {
+	0xDE, 0x9E, 0xDB, 0x7D, 0x7B, 0x7D, 0xC1, 0xB4,
+	0xD3, 0x5B, 0x61, 0xC2, 0xEC, 0xE4, 0x35, 0x37,
+	0x3F, 0x83, 0x43, 0xC8, 0x5B, 0x78, 0x67, 0x4D,
+	0xAD, 0xFC, 0x7E, 0x14, 0x6F, 0x88, 0x2B, 0x4F
+	};
+static const FAR_DATA BYTE x25519SharedSecret[] = {
+	0x4A, 0x5D, 0x9D, 0x5B, 0xA4, 0xCE, 0x2D, 0xE1,
+	0x72, 0x8E, 0x3B, 0xF4, 0x80, 0x35, 0x0F, 0x25,
+	0xE0, 0x7E, 0x21, 0xC9, 0x47, 0xD1, 0x9E, 0x33,
+	0x76, 0xF0, 0x9B, 0x3C, 0x1E, 0x16, 0x17, 0x42
+	};
+
+CHECK_RETVAL \
+static int selfTest( void )
+	{
+	CONTEXT_INFO contextInfo;
+	PKC_INFO contextData, *pkcInfo = &contextData;
+	KEYAGREE_PARAMS keyAgreeParams;
+	const CAPABILITY_INFO *capabilityInfoPtr;
+	BYTE buffer[ X25519_KEYSIZE + 8 ];
+	int status;
+
+	/* Test the raw scalar multiplication */
+	curve25519ScalarMult( buffer, x25519TestScalar, x25519TestPoint );
+	if( memcmp( buffer, x25519TestResult, X25519_KEYSIZE ) )
+		return( CRYPT_ERROR_FAILED );
+
+	/* Initialise the key components */
+	status = staticInitContext( &contextInfo, CONTEXT_PKC,
+								get25519Capability(), &contextData,
+								sizeof( PKC_INFO ), NULL );
+	if( cryptStatusError( status ) )
+		return( CRYPT_ERROR_FAILED );
+	memcpy( pkcInfo->curve25519PrivateKey, x25519AlicePrivKey,
+			X25519_KEYSIZE );
+	capabilityInfoPtr = DATAPTR_GET( contextInfo.capabilityInfo );
+	REQUIRES( capabilityInfoPtr != NULL );
+
+	/* Perform the test key exchange, first checking that we get the
+	   expected public value and then the expected shared secret */
+	memset( &keyAgreeParams, 0, sizeof( KEYAGREE_PARAMS ) );
+	status = capabilityInfoPtr->initKeyFunction( &contextInfo, NULL, 0 );
+	if( cryptStatusOK( status ) )
+		status = capabilityInfoPtr->encryptFunction( &contextInfo,
+					( BYTE * ) &keyAgreeParams, sizeof( KEYAGREE_PARAMS ) );
+	if( cryptStatusOK( status ) && \
+		( keyAgreeParams.publicValueLen != X25519_KEYSIZE || \
+		  memcmp( keyAgreeParams.publicValue, x25519AlicePubKey,
+				  X25519_KEYSIZE ) ) )
+		status = CRYPT_ERROR_FAILED;
+	if( cryptStatusOK( status ) )
+		{
+		memcpy( keyAgreeParams.publicValue, x25519BobPubKey,
+				X25519_KEYSIZE );
+		keyAgreeParams.publicValueLen = X25519_KEYSIZE;
+		status = capabilityInfoPtr->decryptFunction( &contextInfo,
+					( BYTE * ) &keyAgreeParams, sizeof( KEYAGREE_PARAMS ) );
+		}
+	if( cryptStatusOK( status ) && \
+		( keyAgreeParams.wrappedKeyLen != X25519_KEYSIZE || \
+		  memcmp( keyAgreeParams.wrappedKey, x25519SharedSecret,
+				  X25519_KEYSIZE ) ) )
+		status = CRYPT_ERROR_FAILED;
+	if( cryptStatusOK( status ) && \
+		!pairwiseConsistencyTest( &contextInfo ) )
+		status = CRYPT_ERROR_FAILED;
+
+	/* Clean up */
+	staticDestroyContext( &contextInfo );
+
+	return( cryptStatusOK( status ) ? CRYPT_OK : CRYPT_ERROR_FAILED );
+	}
+#else
+	#define selfTest	NULL
+#endif /* !CONFIG_NO_SELFTEST */
+
+/****************************************************************************
+*																			*
+*							X25519 Key Exchange Routines					*
+*																			*
+****************************************************************************/
+
+/* Perform phase 1 of X25519 ("export").  We have to append the
+   distinguisher 'Fn' to the name since some systems already have 'encrypt'
+   and 'decrypt' in their standard headers */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int encryptFn( INOUT CONTEXT_INFO *contextInfoPtr,
+					  INOUT_BUFFER_FIXED( noBytes ) BYTE *buffer,
+					  IN_LENGTH_FIXED( sizeof( KEYAGREE_PARAMS ) ) int noBytes )
+	{
+	PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+	KEYAGREE_PARAMS *keyAgreeParams = ( KEYAGREE_PARAMS * ) buffer;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( isWritePtr( keyAgreeParams, sizeof( KEYAGREE_PARAMS ) ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( noBytes == sizeof( KEYAGREE_PARAMS ) );
+	REQUIRES( !isAllZeroes( pkcInfo->curve25519PublicKey,
+							X25519_KEYSIZE ) );
+
+	/* The public value was generated at keygen time, all we have to do is
+	   copy it to the output */
+	memcpy( keyAgreeParams->publicValue, pkcInfo->curve25519PublicKey,
+			X25519_KEYSIZE );
+	keyAgreeParams->publicValueLen = X25519_KEYSIZE;
+
+	ENSURES( sanityCheckPKCInfo( pkcInfo ) );
+
+	return( CRYPT_OK );
+	}
+
+/* Perform phase 2 of X25519 ("import") */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int decryptFn( INOUT CONTEXT_INFO *contextInfoPtr,
+					  INOUT_BUFFER_FIXED( noBytes ) BYTE *buffer,
+					  IN_LENGTH_FIXED( sizeof( KEYAGREE_PARAMS ) ) int noBytes )
+	{
+	KEYAGREE_PARAMS *keyAgreeParams = ( KEYAGREE_PARAMS * ) buffer;
+	PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( isWritePtr( keyAgreeParams, sizeof( KEYAGREE_PARAMS ) ) );
+	assert( isReadPtrDynamic( keyAgreeParams->publicValue,
+							  keyAgreeParams->publicValueLen ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( noBytes == sizeof( KEYAGREE_PARAMS ) );
+	REQUIRES( keyAgreeParams->publicValueLen > 0 && \
+			  keyAgreeParams->publicValueLen < MAX_INTLENGTH_SHORT );
+
+	/* The other side's public value has a fixed size */
+	if( keyAgreeParams->publicValueLen != X25519_KEYSIZE )
+		return( CRYPT_ERROR_BADDATA );
+
+	/* Calculate the shared secret */
+	curve25519ScalarMult( keyAgreeParams->wrappedKey,
+						  pkcInfo->curve25519PrivateKey,
+						  keyAgreeParams->publicValue );
+	keyAgreeParams->wrappedKeyLen = X25519_KEYSIZE;
+
+	/* If the other side has sent us a point of small order then the
+	   result will be all zeroes, as required by RFC 7748 section 6.1 we
+	   reject this.  Unlike ECDH we don't apply checkEntropy() to the 
+	   result since with only 255 bits of u-coordinate to work with its
+	   poker test has a false-positive rate that's high enough to show up 
+	   in practice */
+	if( isAllZeroes( keyAgreeParams->wrappedKey, X25519_KEYSIZE ) )
+		return( CRYPT_ERROR_BADDATA );
+
+	ENSURES( sanityCheckPKCInfo( pkcInfo ) );
+
+	return( CRYPT_OK );
+	}
+
+/****************************************************************************
+*																			*
+*								Key Management								*
+*																			*
+****************************************************************************/
+
+/* Load key components into an encryption context.  X25519 keys are only
+   ever generated internally, so the only load that we allow is the
+   internal one used to complete the setup of a private key that's been
+   placed in the context */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int initKey( INOUT CONTEXT_INFO *contextInfoPtr,
+					IN_BUFFER_OPT( keyLength ) const void *key,
+					IN_LENGTH_SHORT_OPT const int keyLength )
+	{
+	PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+	int status;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( ( key == NULL && keyLength == 0 ) || \
+			( isReadPtrDynamic( key, keyLength ) ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( ( key == NULL && keyLength == 0 ) || \
+			  ( key != NULL && keyLength > 0 && \
+				keyLength < MAX_INTLENGTH_SHORT ) );
+
+	if( key != NULL )
+		return( CRYPT_ERROR_NOTAVAIL );
+
+	/* Derive the public value from the private key */
+	status = calculatePublicValue( pkcInfo );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Checksum the key data to try and detect fault attacks.  Since we're
+	   setting the checksum at this point there's no need to check the
+	   return value */
+	( void ) checksumContextData( pkcInfo, CRYPT_ALGO_25519, TRUE );
+
+	return( CRYPT_OK );
+	}
+
+/* Generate a key into an encryption context */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int generateKey( INOUT CONTEXT_INFO *contextInfoPtr,
+						IN_LENGTH_SHORT_MIN( X25519_KEYSIZE * 8 ) \
+							const int keySizeBits )
+	{
+	PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+	MESSAGE_DATA msgData;
+	int status;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( keySizeBits == bytesToBits( X25519_KEYSIZE ) );
+
+	/* Generate the private key, a random 256-bit value that's clamped
+	   when it's used */
+	setMessageData( &msgData, pkcInfo->curve25519PrivateKey,
+					X25519_KEYSIZE );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_GETATTRIBUTE_S,
+							  &msgData, CRYPT_IATTRIBUTE_RANDOM );
+	if( cryptStatusOK( status ) )
+		status = initKey( contextInfoPtr, NULL, 0 );
+	if( cryptStatusOK( status ) &&
+#ifndef USE_FIPS140
+		( contextInfoPtr->flags & CONTEXT_FLAG_SIDECHANNELPROTECTION ) &&
+#endif /* USE_FIPS140 */
+		!pairwiseConsistencyTest( contextInfoPtr ) )
+		{
+		DEBUG_DIAG(( "Consistency check of freshly-generated X25519 key "
+					 "failed" ));
+		assert( DEBUG_WARN );
+		status = CRYPT_ERROR_FAILED;
+		}
+	return( cryptArgError( status ) ? CRYPT_ERROR_FAILED : status );
+	}
+
+/****************************************************************************
+*																			*
+*						Capability Access Routines							*
+*																			*
+****************************************************************************/
+
+static const CAPABILITY_INFO FAR_DATA capabilityInfo = {
+	CRYPT_ALGO_25519, bitsToBytes( 0 ), "X25519", 6,
+	X25519_KEYSIZE, X25519_KEYSIZE, X25519_KEYSIZE,
+	selfTest, getDefaultInfo, NULL, NULL, initKey, generateKey,
+	encryptFn, decryptFn
+	};
+
+CHECK_RETVAL_PTR_NONNULL \
+const CAPABILITY_INFO *get25519Capability( void )
+	{
+	return( &capabilityInfo );
+	}
+
+#endif /* USE_25519 */
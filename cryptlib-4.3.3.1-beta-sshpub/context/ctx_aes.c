@@ -146,6 +146,37 @@ static const AES_TEST FAR_DATA testAES[] = {
 		0xEA, 0xFC, 0x49, 0x90, 0x4B, 0x49, 0x60, 0x89 } }
 	};
 
+/* AES-CTR test vector from NIST SP 800-38A, F.5.1 */
+
+static const BYTE FAR_DATA ctrKey[] = {
+	0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 
+	0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C 
+	};
+static const BYTE FAR_DATA ctrCounter[] = {
+	0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 
+	0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF 
+	};
+static const BYTE FAR_DATA ctrPlaintext[] = {
+	0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 
+	0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A, 
+	0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C, 
+	0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51, 
+	0x30, 0xC8, 0x1C, 0x46, 0xA3, 0x5C, 0xE4, 0x11, 
+	0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF, 
+	0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17, 
+	0xAD, 0x2B, 0x41, 0x7B, 0xE6, 0x6C, 0x37, 0x10 
+	};
+static const BYTE FAR_DATA ctrCiphertext[] = {
+	0x87, 0x4D, 0x61, 0x91, 0xB6, 0x20, 0xE3, 0x26, 
+	0x1B, 0xEF, 0x68, 0x64, 0x99, 0x0D, 0xB6, 0xCE, 
+	0x98, 0x06, 0xF6, 0x6B, 0x79, 0x70, 0xFD, 0xFF, 
+	0x86, 0x17, 0x18, 0x7B, 0xB9, 0xFF, 0xFD, 0xFF, 
+	0x5A, 0xE4, 0xDF, 0x3E, 0xDB, 0xD5, 0xD3, 0x5E, 
+	0x5B, 0x4F, 0x09, 0x02, 0x0D, 0xB0, 0x3E, 0xAB, 
+	0x1E, 0x03, 0x1D, 0xDA, 0x2F, 0xBE, 0x03, 0xD1, 
+	0x79, 0x21, 0x70, 0xA0, 0xF3, 0x00, 0x9C, 0xEE 
+	};
+
 #if 0
 
 /* Test the AES code against the test vectors from the AES FIPS */
@@ -256,6 +287,269 @@ static int mct( CONTEXT_INFO *contextInfo,
 	}
 #endif
 
+/* Test CTR mode, processing the data in two uneven pieces to make sure 
+   that the partial-block state is carried over correctly */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int testCTR( const CAPABILITY_INFO *capabilityInfo, 
+					IN const void *keyDataStorage )
+	{
+	CONTEXT_INFO contextInfo;
+	CONV_INFO contextData;
+	BYTE temp[ 64 + 8 ];
+	int status;
+
+	status = staticInitContext( &contextInfo, CONTEXT_CONV, capabilityInfo,
+								&contextData, sizeof( CONV_INFO ), 
+								keyDataStorage );
+	if( cryptStatusError( status ) )
+		return( status );
+	contextData.mode = CRYPT_MODE_CTR;
+	contextData.keyDataSize = AES_EXPANDED_KEYSIZE;
+	memcpy( temp, ctrPlaintext, 64 );
+	status = capabilityInfo->initKeyFunction( &contextInfo, ctrKey, 16 );
+	if( cryptStatusOK( status ) )
+		{
+		memcpy( contextData.currentIV, ctrCounter, AES_BLOCKSIZE );
+		status = capabilityInfo->encryptCTRFunction( &contextInfo, temp, 
+													 20 );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = capabilityInfo->encryptCTRFunction( &contextInfo, 
+													 temp + 20, 44 );
+		}
+	staticDestroyContext( &contextInfo );
+	if( cryptStatusError( status ) || memcmp( temp, ctrCiphertext, 64 ) )
+		return( CRYPT_ERROR_FAILED );
+
+	return( CRYPT_OK );
+	}
+
+/* Cross-check the hardware-accelerated AES code against the portable C 
+   code.  The known-answer tests above only process one or a few blocks, 
+   which never reaches the multi-block interleaved paths in the AES-NI 
+   code or the PCLMULQDQ GHASH, so we process a longer message in each 
+   mode once with whatever code the CPU tier selects and once with the 
+   tier forced down to the generic C code and make sure that both give the
+   same result.  Since AES-GCM chooses its GHASH implementation when the 
+   key is loaded, the tier is switched before each key load */
+
+#define KERNEL_TEST_SIZE	( AES_BLOCKSIZE * 37 )
+#define KERNEL_ICV_SIZE		16
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 5, 7 ) ) \
+static int testKernelCrypt( const CAPABILITY_INFO *capabilityInfo, 
+							IN void *keyDataStorage,
+							IN_MODE const CRYPT_MODE_TYPE mode,
+							const BOOLEAN isEncrypt,
+							INOUT_BUFFER_FIXED( length ) BYTE *buffer,
+							IN_LENGTH_SHORT const int length,
+							OUT_BUFFER_FIXED( KERNEL_ICV_SIZE ) BYTE *icv )
+	{
+	static const BYTE FAR_DATA kernelKey[] = {
+		0x60, 0x3D, 0xEB, 0x10, 0x15, 0xCA, 0x71, 0xBE, 
+		0x2B, 0x73, 0xAE, 0xF0, 0x85, 0x7D, 0x77, 0x81,
+		0x1F, 0x35, 0x2C, 0x07, 0x3B, 0x61, 0x08, 0xD7, 
+		0x2D, 0x98, 0x10, 0xA3, 0x09, 0x14, 0xDF, 0xF4 
+		};
+	CONTEXT_INFO contextInfo;
+	CONV_INFO contextData;
+	int status;
+
+	REQUIRES( mode > CRYPT_MODE_NONE && mode < CRYPT_MODE_LAST );
+	REQUIRES( isEncrypt == TRUE || isEncrypt == FALSE );
+	REQUIRES( length > 0 && length <= KERNEL_TEST_SIZE );
+
+	/* Clear return value */
+	memset( icv, 0, KERNEL_ICV_SIZE );
+
+	status = staticInitContext( &contextInfo, CONTEXT_CONV, capabilityInfo,
+								&contextData, sizeof( CONV_INFO ), 
+								keyDataStorage );
+	if( cryptStatusError( status ) )
+		return( status );
+	contextData.mode = mode;
+#ifdef USE_GCM
+	contextData.keyDataSize = ( mode == CRYPT_MODE_GCM ) ? \
+							  AES_GCM_EXPANDED_KEYSIZE : AES_EXPANDED_KEYSIZE;
+#else
+	contextData.keyDataSize = AES_EXPANDED_KEYSIZE;
+#endif /* USE_GCM */
+	status = capabilityInfo->initKeyFunction( &contextInfo, kernelKey, 
+											  AES_KEYSIZE );
+	if( cryptStatusError( status ) )
+		{
+		staticDestroyContext( &contextInfo );
+		return( status );
+		}
+	memcpy( contextData.currentIV, ctrCounter, AES_BLOCKSIZE );
+#ifdef USE_GCM
+	if( mode == CRYPT_MODE_GCM )
+		{
+		/* AES-GCM takes the IV and AAD through the parameter-handling 
+		   function, which checks the key data before it changes the GCM 
+		   state so we have to set up the checksum that the key load would 
+		   normally provide.  The AAD length is deliberately not a multiple 
+		   of the block size */
+		contextData.keyDataChecksum = checksumData( keyDataStorage, 
+											contextData.keyDataSize );
+		status = capabilityInfo->initParamsFunction( &contextInfo, 
+											KEYPARAM_IV, ctrCounter, 12 );
+		if( cryptStatusOK( status ) )
+			{
+			status = capabilityInfo->initParamsFunction( &contextInfo, 
+											KEYPARAM_AAD, kernelKey, 20 );
+			}
+		if( cryptStatusError( status ) )
+			{
+			staticDestroyContext( &contextInfo );
+			return( status );
+			}
+		}
+#endif /* USE_GCM */
+	switch( mode )
+		{
+		case CRYPT_MODE_ECB:
+			status = isEncrypt ? \
+				capabilityInfo->encryptFunction( &contextInfo, buffer, 
+												 length ) : \
+				capabilityInfo->decryptFunction( &contextInfo, buffer, 
+												 length );
+			break;
+
+		case CRYPT_MODE_CBC:
+			status = isEncrypt ? \
+				capabilityInfo->encryptCBCFunction( &contextInfo, buffer, 
+													length ) : \
+				capabilityInfo->decryptCBCFunction( &contextInfo, buffer, 
+													length );
+			break;
+
+		case CRYPT_MODE_CFB:
+			status = isEncrypt ? \
+				capabilityInfo->encryptCFBFunction( &contextInfo, buffer, 
+													length ) : \
+				capabilityInfo->decryptCFBFunction( &contextInfo, buffer, 
+													length );
+			break;
+
+		case CRYPT_MODE_CTR:
+			status = capabilityInfo->encryptCTRFunction( &contextInfo, 
+														 buffer, length );
+			break;
+
+#ifdef USE_GCM
+		case CRYPT_MODE_GCM:
+			status = isEncrypt ? \
+				capabilityInfo->encryptGCMFunction( &contextInfo, buffer, 
+													length ) : \
+				capabilityInfo->decryptGCMFunction( &contextInfo, buffer, 
+													length );
+			if( cryptStatusOK( status ) )
+				{
+				status = capabilityInfo->getInfoFunction( CAPABILITY_INFO_ICV,
+											&contextInfo, icv, 
+											KERNEL_ICV_SIZE );
+				}
+			break;
+#endif /* USE_GCM */
+
+		default:
+			staticDestroyContext( &contextInfo );
+			retIntError();
+		}
+	staticDestroyContext( &contextInfo );
+
+	return( status );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int testKernels( const CAPABILITY_INFO *capabilityInfo )
+	{
+	static const CRYPT_MODE_TYPE modes[] = {
+		CRYPT_MODE_ECB, CRYPT_MODE_CBC, CRYPT_MODE_CFB, CRYPT_MODE_CTR, 
+#ifdef USE_GCM
+		CRYPT_MODE_GCM, 
+#endif /* USE_GCM */
+		CRYPT_MODE_NONE, CRYPT_MODE_NONE 
+		};
+	const HWCAP_TIER_TYPE hwCapTier = getHWCapTier();
+	union {
+		AES_CTX aesKey;
+#ifdef USE_GCM
+		AES_GCM_CTX gcmKey;		/* Provides the alignment that GCM needs */
+#endif /* USE_GCM */
+		} keyData;
+	void *keyDataStorage = &keyData;
+	BYTE data[ KERNEL_TEST_SIZE + 8 ], temp[ KERNEL_TEST_SIZE + 8 ];
+	BYTE nativeData[ KERNEL_TEST_SIZE + 8 ];
+	BYTE genericData[ KERNEL_TEST_SIZE + 8 ];
+	BYTE nativeICV[ KERNEL_ICV_SIZE + 8 ], genericICV[ KERNEL_ICV_SIZE + 8 ];
+	BYTE icv[ KERNEL_ICV_SIZE + 8 ];
+	int i, status = CRYPT_OK, LOOP_ITERATOR;
+
+	/* If there's no AES hardware support then both passes would run the 
+	   same code and there's nothing to cross-check */
+	if( !( getSysVar( SYSVAR_HWCAP ) & HWCAP_FLAG_AES ) )
+		return( CRYPT_OK );
+
+	LOOP_LARGE( i = 0, i < KERNEL_TEST_SIZE, i++ )
+		data[ i ] = intToByte( i * 0x9D + 0x2B );
+	ENSURES( LOOP_BOUND_OK );
+	LOOP_SMALL( i = 0, modes[ i ] != CRYPT_MODE_NONE && \
+					   i < FAILSAFE_ARRAYSIZE( modes, CRYPT_MODE_TYPE ), i++ )
+		{
+		const CRYPT_MODE_TYPE mode = modes[ i ];
+		const int length = ( mode == CRYPT_MODE_ECB || \
+							 mode == CRYPT_MODE_CBC ) ? \
+						   KERNEL_TEST_SIZE : KERNEL_TEST_SIZE - 5;
+		int pass, LOOP_ITERATOR_ALT;
+
+		/* Encrypt the data with the native code and then with the generic 
+		   code, decrypting the result of each pass with the code for that 
+		   pass.  The CPU tier has to be restored before we exit, including 
+		   on error */
+		LOOP_SMALL_ALT( pass = 0, pass < 2, pass++ )
+			{
+			BYTE *buffer = ( pass == 0 ) ? nativeData : genericData;
+			BYTE *bufferICV = ( pass == 0 ) ? nativeICV : genericICV;
+
+			if( pass == 1 )
+				{
+				status = setHWCapTier( HWCAP_TIER_GENERIC );
+				if( cryptStatusError( status ) )
+					break;
+				}
+			memcpy( buffer, data, length );
+			status = testKernelCrypt( capabilityInfo, keyDataStorage, mode, 
+									  TRUE, buffer, length, bufferICV );
+			if( cryptStatusOK( status ) )
+				{
+				memcpy( temp, buffer, length );
+				status = testKernelCrypt( capabilityInfo, keyDataStorage, 
+										  mode, FALSE, temp, length, icv );
+				}
+			if( cryptStatusOK( status ) && \
+				( memcmp( temp, data, length ) || \
+				  memcmp( icv, bufferICV, KERNEL_ICV_SIZE ) ) )
+				status = CRYPT_ERROR_FAILED;
+			if( cryptStatusError( status ) )
+				break;
+			}
+		ENSURES( LOOP_BOUND_OK_ALT );
+		( void ) setHWCapTier( hwCapTier );
+		if( cryptStatusError( status ) )
+			return( status );
+		if( memcmp( nativeData, genericData, length ) || \
+			memcmp( nativeICV, genericICV, KERNEL_ICV_SIZE ) )
+			return( CRYPT_ERROR_FAILED );
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	return( CRYPT_OK );
+	}
+
 CHECK_RETVAL \
 static int selfTest( void )
 	{
@@ -300,6 +594,12 @@ static int selfTest( void )
 			return( status );
 		}
 	ENSURES( LOOP_BOUND_OK );
+	status = testCTR( capabilityInfo, keyData );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = testKernels( capabilityInfo );
+	if( cryptStatusError( status ) )
+		return( status );
 
 #if 0	/* OK */
 	staticInitContext( &contextInfo, CONTEXT_CONV, capabilityInfo,
@@ -384,12 +684,22 @@ static int getInfo( IN_ENUM( CAPABILITY_INFO ) const CAPABILITY_INFO_TYPE type,
 		case CAPABILITY_INFO_ICV:
 			{
 			CONV_INFO *convInfo = contextInfoPtr->ctxConv;
+			int status;
 
 			REQUIRES( convInfo->mode == CRYPT_MODE_GCM );
 
-			return( ( gcm_compute_tag( data, length, 
-									   GCM_KEY( convInfo ) ) == RETURN_GOOD ) ? \
-					CRYPT_OK : CRYPT_ERROR_FAILED );
+			status = ( gcm_compute_tag( data, length, 
+										GCM_KEY( convInfo ) ) == RETURN_GOOD ) ? \
+					 CRYPT_OK : CRYPT_ERROR_FAILED;
+
+			/* Computing the tag updates the GHASH state which changes the 
+			   key data checksum, so we have to update the checksum before 
+			   we return to the caller.  If we don't do this then the next 
+			   IV load, for example for the next TLS record, will fail the
+			   checksum check */
+			convInfo->keyDataChecksum = checksumData( convInfo->key, 
+													  convInfo->keyDataSize );
+			return( status );
 			}
 #endif /* USE_GCM */
 
@@ -536,6 +846,51 @@ static int decryptCFB( INOUT CONTEXT_INFO *contextInfoPtr,
 	return( CRYPT_OK );
 	}
 
+/* Encrypt/decrypt data in CTR mode.  Since CTR mode is its own inverse the
+   same function is used for both operations.  The counter is held in the 
+   context IV and treated as a single 128-bit big-endian value, as required 
+   by SSH and NIST SP 800-38A */
+
+STDC_NONNULL_ARG( ( 1 ) ) \
+static void ctrInc( INOUT_BUFFER_FIXED( AES_BLOCKSIZE ) unsigned char *ctr )
+	{
+	int i, LOOP_ITERATOR;
+
+	LOOP_SMALL( i = AES_BLOCKSIZE - 1, i >= 0, i-- )
+		{
+		if( ++ctr[ i ] != 0 )
+			break;
+		}
+	ENSURES_V( LOOP_BOUND_OK );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int encryptCTR( INOUT CONTEXT_INFO *contextInfoPtr, 
+					   INOUT_BUFFER_FIXED( noBytes ) BYTE *buffer, 
+					   IN_LENGTH int noBytes )
+	{
+	CONV_INFO *convInfo = contextInfoPtr->ctxConv;
+	int status;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( isWritePtrDynamic( buffer, noBytes ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( noBytes > 0 && noBytes < MAX_INTLENGTH );
+
+	status = aes_ctr_crypt( buffer, buffer, noBytes, convInfo->currentIV,
+							ctrInc, ENC_KEY( convInfo ) );
+	if( status != EXIT_SUCCESS )
+		return( CRYPT_ERROR_FAILED );
+
+	/* The CTR process updates an internal keystream position which 
+	   changes the key data checksum, so we have to update the checksum 
+	   before we return to the caller */
+	convInfo->keyDataChecksum = checksumData( convInfo->key, 
+											  convInfo->keyDataSize );
+	return( CRYPT_OK );
+	}
+
 #ifdef USE_GCM
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
@@ -613,12 +968,16 @@ static int initParams( INOUT CONTEXT_INFO *contextInfoPtr,
 	REQUIRES( paramType > KEYPARAM_NONE && paramType < KEYPARAM_LAST );
 
 	/* Normally we implement the IV handling ourselves, however the AES code 
-	   implements these modes natively and maintains its own CFB and GCM 
-	   state, so when we get an IV load/reload we have to explicitly reset 
-	   the internal state before passing the load down to the global
-	   parameter-handling function */
+	   implements these modes natively and maintains its own CFB, CTR, and 
+	   GCM state, so when we get an IV load/reload we have to explicitly 
+	   reset the internal state before passing the load down to the global
+	   parameter-handling function.  If the IV is being loaded before the 
+	   key, which SSH does, then there's no CFB or CTR state to reset yet 
+	   since the key load clears it */
 	if( paramType == KEYPARAM_IV && \
-		( convInfo->mode == CRYPT_MODE_CFB || \
+		( ( ( convInfo->mode == CRYPT_MODE_CFB || \
+			  convInfo->mode == CRYPT_MODE_CTR ) && \
+			( contextInfoPtr->flags & CONTEXT_FLAG_KEY_SET ) ) || \
 		  convInfo->mode == CRYPT_MODE_GCM ) )
 		{
 		/* We're about the modify the keying data, make sure that it's still
@@ -628,7 +987,7 @@ static int initParams( INOUT CONTEXT_INFO *contextInfoPtr,
 			return( CRYPT_ERROR_FAILED );
 
 #ifdef USE_GCM
-		if( convInfo->mode == CRYPT_MODE_CFB )
+		if( convInfo->mode != CRYPT_MODE_GCM )
 			aes_mode_reset( ENC_KEY( convInfo ) );
 		else
 			{
@@ -738,10 +1097,13 @@ static const CAPABILITY_INFO FAR_DATA capabilityInfo = {
 	bitsToBytes( 128 ), bitsToBytes( 128 ), bitsToBytes( 256 ),
 	selfTest, getInfo, NULL, initParams, initKey, NULL,
 	encryptECB, decryptECB, encryptCBC, decryptCBC,
-	encryptCFB, decryptCFB 
+	encryptCFB, decryptCFB, 
 #ifdef USE_GCM
-	, encryptGCM, decryptGCM
+	encryptGCM, decryptGCM, 
+#else
+	NULL, NULL,
 #endif /* USE_GCM */
+	encryptCTR, encryptCTR
 	};
 
 CHECK_RETVAL_PTR_NONNULL \
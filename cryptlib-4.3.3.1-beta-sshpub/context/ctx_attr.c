@@ -174,7 +174,8 @@ int getContextAttribute( INOUT CONTEXT_INFO *contextInfoPtr,
 
 		case CRYPT_CTXINFO_BLOCKSIZE:
 			if( contextType == CONTEXT_CONV && \
-				contextInfoPtr->ctxConv->mode == CRYPT_MODE_CFB )
+				( contextInfoPtr->ctxConv->mode == CRYPT_MODE_CFB || \
+				  contextInfoPtr->ctxConv->mode == CRYPT_MODE_CTR ) )
 				*valuePtr = 1;	/* Block cipher in stream mode */
 			else
 				*valuePtr = capabilityInfoPtr->blockSize;
@@ -186,7 +187,8 @@ int getContextAttribute( INOUT CONTEXT_INFO *contextInfoPtr,
 			if( !needsIV( contextInfoPtr->ctxConv->mode ) || \
 				isStreamCipher( capabilityInfoPtr->cryptAlgo ) )
 				return( CRYPT_ERROR_NOTAVAIL );
-			*valuePtr = capabilityInfoPtr->blockSize;
+			*valuePtr = isNonceStreamCipher( capabilityInfoPtr->cryptAlgo ) ? \
+						NONCE_STREAM_IVSIZE : capabilityInfoPtr->blockSize;
 			return( CRYPT_OK );
 
 		case CRYPT_CTXINFO_KEYING_ALGO:
@@ -302,6 +304,8 @@ int getContextAttributeS( INOUT CONTEXT_INFO *contextInfoPtr,
 					return( attributeCopy( msgData, "CFB", 3 ) );
 				case CRYPT_MODE_GCM:
 					return( attributeCopy( msgData, "GCM", 3 ) );
+				case CRYPT_MODE_CTR:
+					return( attributeCopy( msgData, "CTR", 3 ) );
 				}
 			retIntError();
 
@@ -508,7 +512,8 @@ int getContextAttributeS( INOUT CONTEXT_INFO *contextInfoPtr,
 		case CRYPT_IATTRIBUTE_ICV:
 			REQUIRES( contextType == CONTEXT_CONV );
 
-			if( contextInfoPtr->ctxConv->mode != CRYPT_MODE_GCM )
+			if( contextInfoPtr->ctxConv->mode != CRYPT_MODE_GCM && \
+				!isNonceStreamCipher( capabilityInfoPtr->cryptAlgo ) )
 				return( CRYPT_ERROR_NOTAVAIL );
 			return( capabilityInfoPtr->getInfoFunction( CAPABILITY_INFO_ICV, 
 											contextInfoPtr, msgData->data,
@@ -957,13 +962,22 @@ int setContextAttributeS( INOUT CONTEXT_INFO *contextInfoPtr,
 
 			/* Make sure that the data size is valid.  GCM is handled 
 			   specially because the default IV size is somewhat smaller 
-			   than the cipher block size */
+			   than the cipher block size, and nonce-based stream ciphers
+			   have a nonce size that's unrelated to the block size and 
+			   that can be either 64 bits (SSH) or the standard size */
 			if( contextInfoPtr->ctxConv->mode == CRYPT_MODE_GCM )
 				{
 				if( dataLength < 8 || \
 					dataLength > capabilityInfoPtr->blockSize )
 					return( CRYPT_ARGERROR_NUM1 );
 				}
+			else
+			if( isNonceStreamCipher( capabilityInfoPtr->cryptAlgo ) )
+				{
+				if( dataLength != bitsToBytes( 64 ) && \
+					dataLength != NONCE_STREAM_IVSIZE )
+					return( CRYPT_ARGERROR_NUM1 );
+				}
 			else
 				{
 				if( dataLength != capabilityInfoPtr->blockSize )
@@ -1153,7 +1167,8 @@ int setContextAttributeS( INOUT CONTEXT_INFO *contextInfoPtr,
 		case CRYPT_IATTRIBUTE_AAD:
 			REQUIRES( contextType == CONTEXT_CONV );
 
-			if( contextInfoPtr->ctxConv->mode != CRYPT_MODE_GCM )
+			if( contextInfoPtr->ctxConv->mode != CRYPT_MODE_GCM && \
+				!isNonceStreamCipher( capabilityInfoPtr->cryptAlgo ) )
 				return( CRYPT_ERROR_NOTAVAIL );
 
 			/* Process the AAD */
@@ -784,6 +784,50 @@ BOOLEAN BN_mod_lshift_quick( BIGNUM *r, const BIGNUM *a,
 	}
 #endif /* USE_ECDH || USE_ECDSA */
 
+/* Modmult for values whose product is too large for a standard bignum, 
+   for example with RSA-3072 and RSA-4096 moduli.  The product is computed 
+   into the extended bignum that's also used by the Montgomery code, which 
+   is never in use when we're called */
+
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1, 2, 3, 4, 5 ) ) \
+static BOOLEAN BN_mod_mul_ext( INOUT BIGNUM *r, const BIGNUM *a, 
+							   const BIGNUM *b, const BIGNUM *m, 
+							   INOUT BN_CTX *ctx )
+	{
+	BIGNUM *tmp;
+	int bnStatus = BN_STATUS;
+
+	assert( isWritePtr( r, sizeof( BIGNUM ) ) );
+	assert( isReadPtr( a, sizeof( BIGNUM ) ) );
+	assert( isReadPtr( b, sizeof( BIGNUM ) ) );
+	assert( isReadPtr( m, sizeof( BIGNUM ) ) );
+	assert( isWritePtr( ctx, sizeof( BN_CTX ) ) );
+
+	BN_CTX_start( ctx );
+	tmp = BN_CTX_get_ext( ctx, BIGNUM_EXT_MONT );
+	if( tmp == NULL )
+		{
+		BN_CTX_end( ctx );
+		return( FALSE );
+		}
+	if( a == b )
+		{
+		CK( BN_sqr( tmp, a, ctx ) );
+		}
+	else
+		{
+		CK( BN_mul( tmp, a, b, ctx ) );
+		}
+	CK( BN_mod( r, tmp, m, ctx ) );
+	BN_CTX_end_ext( ctx, BIGNUM_EXT_MONT );
+	if( bnStatusError( bnStatus ) )
+		return( bnStatus );
+
+	ENSURES_B( sanityCheckBignum( r ) );
+
+	return( TRUE );
+	}
+
 /* Generic modmult without special tricks like Montgomery maths */
 
 CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1, 2, 3, 4, 5 ) ) \
@@ -812,6 +856,11 @@ BOOLEAN BN_mod_mul( INOUT BIGNUM *r, const BIGNUM *a, const BIGNUM *b,
 	if( !BN_cmp( a, b ) )
 		return( BN_mod_sqr( r, a, m, ctx ) );
 
+	/* For large moduli the product can be too big for a standard bignum, 
+	   in which case we have to use an extended bignum for it */
+	if( a->top + b->top > BIGNUM_ALLOC_WORDS )
+		return( BN_mod_mul_ext( r, a, b, m, ctx ) );
+
     BN_CTX_start( ctx );
     tmp = BN_CTX_get( ctx );
 	if( tmp == NULL )
@@ -849,6 +898,11 @@ BOOLEAN BN_mod_sqr( INOUT BIGNUM *r, const BIGNUM *a, const BIGNUM *m,
 				!BN_is_negative( m ) );
 	REQUIRES_B( sanityCheckBNCTX( ctx ) );
 
+	/* For large moduli the square can be too big for a standard bignum, 
+	   see the comment in BN_mod_mul() */
+	if( 2 * a->top > BIGNUM_ALLOC_WORDS )
+		return( BN_mod_mul_ext( r, a, a, m, ctx ) );
+
 	/* Since we know that r can't be negative after the squaring (which it 
 	   couldn't be in any case since a is positive), we can just call 
 	   BN_mod() directly */
@@ -316,6 +316,21 @@ static int bignumChecksum( INOUT PKC_INFO *pkcInfo,
 		}
 	else
 #endif /* USE_ECDH || USE_ECDSA */
+#ifdef USE_25519
+	if( is25519Algo( cryptAlgo ) )
+		{
+		/* Curve25519 keys are stored as raw byte strings rather than 
+		   bignums so we checksum the key data directly */
+		value = checksumBignumData( pkcInfo->curve25519PublicKey, 
+									X25519_KEYSIZE, value );
+		if( isPrivateKey )
+			{
+			value = checksumBignumData( pkcInfo->curve25519PrivateKey, 
+										X25519_KEYSIZE, value );
+			}
+		}
+	else
+#endif /* USE_25519 */
 	if( isDlpAlgo( cryptAlgo ) )
 		{
 		BN_checksum( &pkcInfo->dlpParam_p, &value );
@@ -0,0 +1,570 @@
+/****************************************************************************
+*																			*
+*					cryptlib ChaCha20/Poly1305 Encryption Routines			*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#if defined( INC_ALL )
+  #include "crypt.h"
+  #include "context.h"
+  #include "chacha20.h"
+#else
+  #include "crypt.h"
+  #include "context/context.h"
+  #include "crypt/chacha20.h"
+#endif /* Compiler-specific includes */
+
+/* ChaCha20 is a stream cipher but, unlike RC4, one that takes a nonce, so
+   rather than using the pseudo-CFB mode that pure stream ciphers use it's
+   presented as a cipher with a one-byte block size that only supports CTR
+   mode, with the nonce loaded as the IV.  The nonce can be either 12 bytes
+   for the RFC 8439 form or 8 bytes for the original form used by SSH.
+
+   Poly1305 is always used with ChaCha20 in the RFC 8439 AEAD construction
+   (or the SSH variant of it) and the MAC key is derived from the cipher
+   state, so rather than making it a standalone MAC algorithm it's
+   integrated into the ChaCha20 context in the same way as GHASH is for
+   AES-GCM: loading AAD after the IV derives the one-time Poly1305 key from
+   keystream block 0 and MACs the AAD, subsequent en/decryption starts at
+   block 1 and MACs the ciphertext, and reading the ICV returns the tag.
+   For the RFC 8439 form the AAD and ciphertext are zero-padded and the
+   lengths appended as required by the RFC, for the SSH form the MAC is
+   taken over the raw AAD (the encrypted packet length) and ciphertext */
+
+#ifdef USE_CHACHA20
+
+/* The ChaCha20 state, with the Poly1305 state for the AEAD mode */
+
+typedef struct {
+	CHACHA20_CTX chachaState;		/* ChaCha20 state */
+	POLY1305_CTX polyState;			/* Poly1305 state for AEAD mode */
+	long aadLength, dataLength;		/* AAD and ciphertext length */
+	int nonceSize;					/* RFC 8439 or SSH nonce */
+	BOOLEAN aeadActive;				/* Whether AEAD MAC'ing is active */
+	} CHACHA20_STATE;
+
+#define CHACHA20_STATE_SIZE		sizeof( CHACHA20_STATE )
+
+/****************************************************************************
+*																			*
+*							ChaCha20 Self-test Routines						*
+*																			*
+****************************************************************************/
+
+#ifndef CONFIG_NO_SELFTEST
+
+/* ChaCha20 keystream test vector from RFC 8439 appendix A.1, test vector
+   1, all-zero key and nonce */
+
+static const BYTE FAR_DATA testKeystream[] =
+	{ 0x76, 0xB8, 0xE0, 0xAD, 0xA0, 0xF1, 0x3D, 0x90,
+	  0x40, 0x5D, 0x6A, 0xE5, 0x53, 0x86, 0xBD, 0x28,
+	  0xBD, 0xD2, 0x19, 0xB8, 0xA0, 0x8D, 0xED, 0x1A,
+	  0xA8, 0x36, 0xEF, 0xCC, 0x8B, 0x77, 0x0D, 0xC7,
+	  0xDA, 0x41, 0x59, 0x7C, 0x51, 0x57, 0x48, 0x8D,
+	  0x77, 0x24, 0xE0, 0x3F, 0xB8, 0xD8, 0x4A, 0x37,
+	  0x6A, 0x43, 0xB8, 0xF4, 0x15, 0x18, 0xA1, 0x1C,
+	  0xC3, 0x87, 0xB6, 0x69, 0xB2, 0xEE, 0x65, 0x86 };
+
+/* ChaCha20/Poly1305 AEAD test vector from RFC 8439 section 2.8.2 */
+
+static const BYTE FAR_DATA testAEADKey[] =
+	{ 0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+	  0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F,
+	  0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+	  0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9F };
+static const BYTE FAR_DATA testAEADNonce[] =
+	{ 0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43,
+	  0x44, 0x45, 0x46, 0x47 };
+static const BYTE FAR_DATA testAEADAAD[] =
+	{ 0x50, 0x51, 0x52, 0x53, 0xC0, 0xC1, 0xC2, 0xC3,
+	  0xC4, 0xC5, 0xC6, 0xC7 };
+static const BYTE FAR_DATA testAEADCiphertext[] =
+	{ 0xD3, 0x1A, 0x8D, 0x34, 0x64, 0x8E, 0x60, 0xDB,
+	  0x7B, 0x86, 0xAF, 0xBC, 0x53, 0xEF, 0x7E, 0xC2,
+	  0xA4, 0xAD, 0xED, 0x51, 0x29, 0x6E, 0x08, 0xFE,
+	  0xA9, 0xE2, 0xB5, 0xA7, 0x36, 0xEE, 0x62, 0xD6,
+	  0x3D, 0xBE, 0xA4, 0x5E, 0x8C, 0xA9, 0x67, 0x12,
+	  0x82, 0xFA, 0xFB, 0x69, 0xDA, 0x92, 0x72, 0x8B,
+	  0x1A, 0x71, 0xDE, 0x0A, 0x9E, 0x06, 0x0B, 0x29,
+	  0x05, 0xD6, 0xA5, 0xB6, 0x7E, 0xCD, 0x3B, 0x36,
+	  0x92, 0xDD, 0xBD, 0x7F, 0x2D, 0x77, 0x8B, 0x8C,
+	  0x98, 0x03, 0xAE, 0xE3, 0x28, 0x09, 0x1B, 0x58,
+	  0xFA, 0xB3, 0x24, 0xE4, 0xFA, 0xD6, 0x75, 0x94,
+	  0x55, 0x85, 0x80, 0x8B, 0x48, 0x31, 0xD7, 0xBC,
+	  0x3F, 0xF4, 0xDE, 0xF0, 0x8E, 0x4B, 0x7A, 0x9D,
+	  0xE5, 0x76, 0xD2, 0x65, 0x86, 0xCE, 0xC6, 0x4B,
+	  0x61, 0x16 };
+static const BYTE FAR_DATA testAEADTag[] =
+	{ 0x1A, 0xE1, 0x0B, 0x59, 0x4F, 0x09, 0xE2, 0x6A,
+	  0x7E, 0x90, 0x2E, 0xCB, 0xD0, 0x60, 0x06, 0x91 };
+static const BYTE FAR_DATA testAEADPlaintext[] = \
+	"Ladies and Gentlemen of the class of '99: If I could offer you only "
+	"one tip for the future, sunscreen would be it.";
+
+/* Test the keystream generation, processing the data in two uneven pieces
+   to make sure that the partial-block state is carried over correctly */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int testKeystreamFn( const CAPABILITY_INFO *capabilityInfo,
+							IN void *keyDataStorage )
+	{
+	CONTEXT_INFO contextInfo;
+	CONV_INFO contextData;
+	const BYTE zeroes[ CHACHA20_KEY_SIZE + 8 ] = { 0 };
+	BYTE temp[ CHACHA20_BLOCK_SIZE + 8 ];
+	int status;
+
+	status = staticInitContext( &contextInfo, CONTEXT_CONV, capabilityInfo,
+								&contextData, sizeof( CONV_INFO ),
+								keyDataStorage );
+	if( cryptStatusError( status ) )
+		return( status );
+	contextData.mode = CRYPT_MODE_CTR;
+	contextData.keyDataSize = CHACHA20_STATE_SIZE;
+	memset( temp, 0, CHACHA20_BLOCK_SIZE );
+	status = capabilityInfo->initKeyFunction( &contextInfo, zeroes,
+											  CHACHA20_KEY_SIZE );
+	if( cryptStatusOK( status ) )
+		{
+		contextInfo.flags |= CONTEXT_FLAG_KEY_SET;
+		contextData.keyDataChecksum = \
+				checksumData( contextData.key, contextData.keyDataSize );
+		status = capabilityInfo->initParamsFunction( &contextInfo,
+								KEYPARAM_IV, zeroes, CHACHA20_NONCE_SIZE );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = capabilityInfo->encryptCTRFunction( &contextInfo, temp,
+													 20 );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = capabilityInfo->encryptCTRFunction( &contextInfo,
+													 temp + 20, 44 );
+		}
+	staticDestroyContext( &contextInfo );
+	if( cryptStatusError( status ) || \
+		memcmp( temp, testKeystream, CHACHA20_BLOCK_SIZE ) )
+		return( CRYPT_ERROR_FAILED );
+
+	return( CRYPT_OK );
+	}
+
+/* Test the AEAD mode, first encrypting and generating the tag and then
+   decrypting and checking it */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int testAEAD( const CAPABILITY_INFO *capabilityInfo,
+					 IN void *keyDataStorage,
+					 const BOOLEAN isEncrypt )
+	{
+	CONTEXT_INFO contextInfo;
+	CONV_INFO contextData;
+	BYTE temp[ 128 + 8 ], tag[ POLY1305_TAG_SIZE + 8 ];
+	const int length = sizeof( testAEADCiphertext );
+	int status;
+
+	static_assert( sizeof( testAEADCiphertext ) <= 128, \
+				   "AEAD test vector size" );
+
+	status = staticInitContext( &contextInfo, CONTEXT_CONV, capabilityInfo,
+								&contextData, sizeof( CONV_INFO ),
+								keyDataStorage );
+	if( cryptStatusError( status ) )
+		return( status );
+	contextData.mode = CRYPT_MODE_CTR;
+	contextData.keyDataSize = CHACHA20_STATE_SIZE;
+	memcpy( temp, isEncrypt ? testAEADPlaintext : testAEADCiphertext,
+			length );
+	status = capabilityInfo->initKeyFunction( &contextInfo, testAEADKey,
+											  CHACHA20_KEY_SIZE );
+	if( cryptStatusOK( status ) )
+		{
+		contextInfo.flags |= CONTEXT_FLAG_KEY_SET;
+		contextData.keyDataChecksum = \
+				checksumData( contextData.key, contextData.keyDataSize );
+		status = capabilityInfo->initParamsFunction( &contextInfo,
+								KEYPARAM_IV, testAEADNonce,
+								CHACHA20_NONCE_SIZE );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = capabilityInfo->initParamsFunction( &contextInfo,
+								KEYPARAM_AAD, testAEADAAD,
+								sizeof( testAEADAAD ) );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		if( isEncrypt )
+			{
+			status = capabilityInfo->encryptCTRFunction( &contextInfo,
+														 temp, length );
+			}
+		else
+			{
+			status = capabilityInfo->decryptCTRFunction( &contextInfo,
+														 temp, length );
+			}
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = capabilityInfo->getInfoFunction( CAPABILITY_INFO_ICV,
+												  &contextInfo, tag,
+												  POLY1305_TAG_SIZE );
+		}
+	staticDestroyContext( &contextInfo );
+	if( cryptStatusError( status ) || \
+		memcmp( temp, isEncrypt ? testAEADCiphertext : testAEADPlaintext,
+				length ) || \
+		memcmp( tag, testAEADTag, POLY1305_TAG_SIZE ) )
+		return( CRYPT_ERROR_FAILED );
+
+	return( CRYPT_OK );
+	}
+
+CHECK_RETVAL \
+static int selfTest( void )
+	{
+	const CAPABILITY_INFO *capabilityInfo = getChaCha20Capability();
+	CHACHA20_STATE keyData;
+	int status;
+
+	status = testKeystreamFn( capabilityInfo, &keyData );
+	if( cryptStatusOK( status ) )
+		status = testAEAD( capabilityInfo, &keyData, TRUE );
+	if( cryptStatusOK( status ) )
+		status = testAEAD( capabilityInfo, &keyData, FALSE );
+	zeroise( &keyData, CHACHA20_STATE_SIZE );
+	return( status );
+	}
+#else
+	#define selfTest	NULL
+#endif /* !CONFIG_NO_SELFTEST */
+
+/****************************************************************************
+*																			*
+*								Control Routines							*
+*																			*
+****************************************************************************/
+
+/* Return context subtype-specific information */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 3 ) ) \
+static int getInfo( IN_ENUM( CAPABILITY_INFO ) const CAPABILITY_INFO_TYPE type,
+					INOUT_OPT CONTEXT_INFO *contextInfoPtr,
+					OUT void *data,
+					IN_INT_Z const int length )
+	{
+	assert( contextInfoPtr == NULL || \
+			isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( ( length == 0 && isWritePtr( data, sizeof( int ) ) ) || \
+			( length > 0 && isWritePtrDynamic( data, length ) ) );
+
+	REQUIRES( type > CAPABILITY_INFO_NONE && type < CAPABILITY_INFO_LAST );
+	REQUIRES( type != CAPABILITY_INFO_ICV || contextInfoPtr != NULL );
+	REQUIRES( ( contextInfoPtr == NULL ) || \
+			  sanityCheckContext( contextInfoPtr ) );
+
+	switch( type )
+		{
+		case CAPABILITY_INFO_STATESIZE:
+			{
+			int *valuePtr = ( int * ) data;
+
+			*valuePtr = CHACHA20_STATE_SIZE;
+
+			return( CRYPT_OK );
+			}
+
+		case CAPABILITY_INFO_ICV:
+			{
+			CONV_INFO *convInfo = contextInfoPtr->ctxConv;
+			CHACHA20_STATE *state = convInfo->key;
+			BYTE tag[ POLY1305_TAG_SIZE + 8 ];
+
+			REQUIRES( length > 0 && length <= POLY1305_TAG_SIZE );
+
+			if( !state->aeadActive )
+				return( CRYPT_ERROR_NOTINITED );
+
+			/* For the RFC 8439 form we pad the ciphertext to a multiple of
+			   the Poly1305 block size and append the AAD and ciphertext
+			   lengths as little-endian 64-bit values, for the SSH form the
+			   MAC is over the raw AAD and ciphertext */
+			if( state->nonceSize == CHACHA20_NONCE_SIZE )
+				{
+				BYTE lengths[ 16 + 8 ];
+
+				poly1305Pad( &state->polyState );
+				memset( lengths, 0, 16 );
+				lengths[ 0 ] = ( BYTE ) state->aadLength;
+				lengths[ 1 ] = ( BYTE ) ( state->aadLength >> 8 );
+				lengths[ 2 ] = ( BYTE ) ( state->aadLength >> 16 );
+				lengths[ 3 ] = ( BYTE ) ( state->aadLength >> 24 );
+				lengths[ 8 ] = ( BYTE ) state->dataLength;
+				lengths[ 9 ] = ( BYTE ) ( state->dataLength >> 8 );
+				lengths[ 10 ] = ( BYTE ) ( state->dataLength >> 16 );
+				lengths[ 11 ] = ( BYTE ) ( state->dataLength >> 24 );
+				poly1305Update( &state->polyState, lengths, 16 );
+				}
+			poly1305Final( &state->polyState, tag );
+			memcpy( data, tag, length );
+			zeroise( tag, POLY1305_TAG_SIZE );
+			state->aeadActive = FALSE;
+
+			/* Computing the tag updates the Poly1305 state which changes
+			   the key data checksum, so we have to update the checksum
+			   before we return to the caller */
+			convInfo->keyDataChecksum = checksumData( convInfo->key,
+													  convInfo->keyDataSize );
+			return( CRYPT_OK );
+			}
+
+		default:
+			return( getDefaultInfo( type, contextInfoPtr, data, length ) );
+		}
+
+	retIntError();
+	}
+
+/****************************************************************************
+*																			*
+*						ChaCha20 En/Decryption Routines						*
+*																			*
+****************************************************************************/
+
+/* Encrypt/decrypt data.  Since ChaCha20 is a stream cipher encryption and
+   decryption are the same operation, but if the AEAD mode is active then
+   the ciphertext is MAC'd after encryption and before decryption */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int encryptFn( INOUT CONTEXT_INFO *contextInfoPtr,
+					  INOUT_BUFFER_FIXED( noBytes ) BYTE *buffer,
+					  IN_LENGTH int noBytes )
+	{
+	CONV_INFO *convInfo = contextInfoPtr->ctxConv;
+	CHACHA20_STATE *state = convInfo->key;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( isWritePtrDynamic( buffer, noBytes ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( noBytes > 0 && noBytes < MAX_INTLENGTH );
+
+	chacha20Crypt( &state->chachaState, buffer, noBytes );
+	if( state->aeadActive )
+		{
+		poly1305Update( &state->polyState, buffer, noBytes );
+		state->dataLength += noBytes;
+		}
+
+	/* The encryption process updates the keystream position which changes
+	   the key data checksum, so we have to update the checksum before we
+	   return to the caller */
+	convInfo->keyDataChecksum = checksumData( convInfo->key,
+											  convInfo->keyDataSize );
+	return( CRYPT_OK );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int decryptFn( INOUT CONTEXT_INFO *contextInfoPtr,
+					  INOUT_BUFFER_FIXED( noBytes ) BYTE *buffer,
+					  IN_LENGTH int noBytes )
+	{
+	CONV_INFO *convInfo = contextInfoPtr->ctxConv;
+	CHACHA20_STATE *state = convInfo->key;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( isWritePtrDynamic( buffer, noBytes ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( noBytes > 0 && noBytes < MAX_INTLENGTH );
+
+	if( state->aeadActive )
+		{
+		poly1305Update( &state->polyState, buffer, noBytes );
+		state->dataLength += noBytes;
+		}
+	chacha20Crypt( &state->chachaState, buffer, noBytes );
+
+	/* The decryption process updates the keystream position which changes
+	   the key data checksum, so we have to update the checksum before we
+	   return to the caller */
+	convInfo->keyDataChecksum = checksumData( convInfo->key,
+											  convInfo->keyDataSize );
+	return( CRYPT_OK );
+	}
+
+/****************************************************************************
+*																			*
+*						ChaCha20 Key Management Routines					*
+*																			*
+****************************************************************************/
+
+/* Initialise crypto parameters such as the IV and encryption mode */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int initParams( INOUT CONTEXT_INFO *contextInfoPtr,
+					   IN_ENUM( KEYPARAM ) const KEYPARAM_TYPE paramType,
+					   IN_OPT const void *data,
+					   IN_INT const int dataLength )
+	{
+	CONV_INFO *convInfo = contextInfoPtr->ctxConv;
+	CHACHA20_STATE *state = convInfo->key;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+
+	REQUIRES( contextInfoPtr->type == CONTEXT_CONV );
+	REQUIRES( paramType > KEYPARAM_NONE && paramType < KEYPARAM_LAST );
+
+	/* If we're loading a new nonce then we reset the cipher state to the
+	   start of the keystream and end any AEAD processing for the previous
+	   nonce.  If the nonce is being loaded before the key then there's no
+	   state to reset yet, the key load picks up the nonce from the IV */
+	if( paramType == KEYPARAM_IV )
+		{
+		REQUIRES( dataLength == CHACHA20_NONCE_SIZE || \
+				  dataLength == CHACHA20_NONCE_SIZE_64 );
+
+		if( contextInfoPtr->flags & CONTEXT_FLAG_KEY_SET )
+			{
+			/* We're about the modify the keying data, make sure that it's
+			   still valid before we start */
+			if( checksumData( convInfo->key, \
+							  convInfo->keyDataSize ) != convInfo->keyDataChecksum )
+				return( CRYPT_ERROR_FAILED );
+
+			chacha20SetNonce( &state->chachaState, data, dataLength, 0 );
+			state->nonceSize = dataLength;
+			state->aeadActive = FALSE;
+
+			/* This process updates internal state which changes the key
+			   data checksum, so we have to update the checksum before we
+			   return to the caller */
+			convInfo->keyDataChecksum = checksumData( convInfo->key,
+													  convInfo->keyDataSize );
+			}
+
+		/* Pass the call on down to the global parameter-handling function
+		   to record the IV in the context data */
+		return( initGenericParams( contextInfoPtr, paramType, data,
+								   dataLength ) );
+		}
+
+	/* Loading AAD begins AEAD processing for the current nonce, deriving
+	   the Poly1305 key from the first keystream block and leaving the
+	   cipher positioned at the start of the second block */
+	if( paramType == KEYPARAM_AAD )
+		{
+		BYTE polyKey[ CHACHA20_BLOCK_SIZE + 8 ];
+
+		REQUIRES( contextInfoPtr->flags & CONTEXT_FLAG_KEY_SET );
+		REQUIRES( dataLength > 0 && dataLength < MAX_INTLENGTH_SHORT );
+
+		/* We're about the modify the keying data, make sure that it's still
+		   valid before we start */
+		if( checksumData( convInfo->key, \
+						  convInfo->keyDataSize ) != convInfo->keyDataChecksum )
+			return( CRYPT_ERROR_FAILED );
+
+		/* The AAD has to be loaded immediately after the nonce, before any
+		   keystream has been used */
+		if( !( contextInfoPtr->flags & CONTEXT_FLAG_IV_SET ) || \
+			state->aeadActive || \
+			state->chachaState.keystreamPos != CHACHA20_BLOCK_SIZE || \
+			state->chachaState.state[ 12 ] != 0 )
+			return( CRYPT_ERROR_NOTINITED );
+
+		/* Derive the Poly1305 key from keystream block 0.  We generate the
+		   full block so that encryption continues from block 1 */
+		chacha20Keystream( &state->chachaState, polyKey,
+						   CHACHA20_BLOCK_SIZE );
+		poly1305Init( &state->polyState, polyKey );
+		zeroise( polyKey, CHACHA20_BLOCK_SIZE );
+
+		/* MAC the AAD, zero-padding it for the RFC 8439 form */
+		poly1305Update( &state->polyState, data, dataLength );
+		if( state->nonceSize == CHACHA20_NONCE_SIZE )
+			poly1305Pad( &state->polyState );
+		state->aadLength = dataLength;
+		state->dataLength = 0;
+		state->aeadActive = TRUE;
+
+		/* This process updates internal state which changes the key data
+		   checksum, so we have to update the checksum before we return to
+		   the caller */
+		convInfo->keyDataChecksum = checksumData( convInfo->key,
+												  convInfo->keyDataSize );
+
+		return( CRYPT_OK );
+		}
+
+	/* Pass the call on down to the global parameter-handling function */
+	return( initGenericParams( contextInfoPtr, paramType, data,
+							   dataLength ) );
+	}
+
+/* Set up the ChaCha20 key */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int initKey( INOUT CONTEXT_INFO *contextInfoPtr,
+					IN_BUFFER( keyLength ) const void *key,
+					IN_LENGTH_SHORT const int keyLength )
+	{
+	CONV_INFO *convInfo = contextInfoPtr->ctxConv;
+	CHACHA20_STATE *state = convInfo->key;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( isReadPtrDynamic( key, keyLength ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( keyLength == CHACHA20_KEY_SIZE );
+
+	/* Copy the key to internal storage */
+	if( convInfo->userKey != key )
+		{
+		memcpy( convInfo->userKey, key, keyLength );
+		convInfo->userKeyLength = keyLength;
+		}
+
+	memset( state, 0, CHACHA20_STATE_SIZE );
+	chacha20SetKey( &state->chachaState, convInfo->userKey );
+	state->nonceSize = CHACHA20_NONCE_SIZE;
+	state->aeadActive = FALSE;
+
+	/* If the nonce was loaded before the key, set it now */
+	if( ( contextInfoPtr->flags & CONTEXT_FLAG_IV_SET ) && \
+		( convInfo->ivLength == CHACHA20_NONCE_SIZE || \
+		  convInfo->ivLength == CHACHA20_NONCE_SIZE_64 ) )
+		{
+		chacha20SetNonce( &state->chachaState, convInfo->currentIV,
+						  convInfo->ivLength, 0 );
+		state->nonceSize = convInfo->ivLength;
+		}
+
+	return( CRYPT_OK );
+	}
+
+/****************************************************************************
+*																			*
+*						Capability Access Routines							*
+*																			*
+****************************************************************************/
+
+static const CAPABILITY_INFO FAR_DATA capabilityInfo = {
+	CRYPT_ALGO_CHACHA20, bitsToBytes( 8 ), "ChaCha20", 8,
+	bitsToBytes( 256 ), bitsToBytes( 256 ), bitsToBytes( 256 ),
+	selfTest, getInfo, NULL, initParams, initKey, NULL,
+	NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+	encryptFn, decryptFn
+	};
+
+CHECK_RETVAL_PTR_NONNULL \
+const CAPABILITY_INFO *getChaCha20Capability( void )
+	{
+	return( &capabilityInfo );
+	}
+
+#endif /* USE_CHACHA20 */
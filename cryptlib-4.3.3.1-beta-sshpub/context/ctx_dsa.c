@@ -751,7 +751,7 @@ static const CAPABILITY_INFO FAR_DATA capabilityInfo = {
 	CRYPT_ALGO_DSA, bitsToBytes( 0 ), "DSA", 3,
 	MIN_PKCSIZE, bitsToBytes( 1024 ), CRYPT_MAX_PKCSIZE,
 	selfTest, getDefaultInfo, NULL, NULL, initKey, generateKey,
-	NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 
+	NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 
 	sign, sigCheck
 	};
 
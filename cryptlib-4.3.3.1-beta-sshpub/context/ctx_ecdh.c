@@ -275,8 +275,10 @@ static int decryptFn( INOUT CONTEXT_INFO *contextInfoPtr,
 
 	/* The other party's Q value will be stored with the key agreement info 
 	   in X9.62 point form rather than having been read in when we read the 
-	   ECDH public key */
-	status = importECCPoint( &pkcInfo->eccParam_qx, &pkcInfo->eccParam_qy,
+	   ECDH public key.  We read it into separate Q' values rather than over 
+	   the top of our own Q, which is covered by the key data checksum */
+	status = importECCPoint( &pkcInfo->ecdhParam_qxPrime, 
+							 &pkcInfo->ecdhParam_qyPrime,
 							 keyAgreeParams->publicValue,
 							 keyAgreeParams->publicValueLen,
 							 MIN_PKCSIZE_ECC_THRESHOLD, 
@@ -286,14 +288,15 @@ static int decryptFn( INOUT CONTEXT_INFO *contextInfoPtr,
 		return( status );
 
 	/* Make sure that the Q value is valid */
-	if( !isPointOnCurve( &pkcInfo->eccParam_qx, &pkcInfo->eccParam_qy, 
+	if( !isPointOnCurve( &pkcInfo->ecdhParam_qxPrime, 
+						 &pkcInfo->ecdhParam_qyPrime, 
 						 &domainParams->a, &domainParams->b, pkcInfo ) )
 		return( CRYPT_ARGERROR_STR1 );
 
 	/* Fill in point structure with coordinates from Q */
 	CK( EC_POINT_set_affine_coordinates_GFp( ecCTX, q,
-											 &pkcInfo->eccParam_qx,
-											 &pkcInfo->eccParam_qy,
+											 &pkcInfo->ecdhParam_qxPrime,
+											 &pkcInfo->ecdhParam_qyPrime,
 											 &pkcInfo->bnCTX ) );
 	if( bnStatusError( bnStatus ) )
 		return( getBnStatus( bnStatus ) );
@@ -774,7 +774,7 @@ static const CAPABILITY_INFO FAR_DATA capabilityInfo = {
 	CRYPT_ALGO_ECDSA, bitsToBytes( 0 ), "ECDSA", 5,
 	MIN_PKCSIZE_ECC, bitsToBytes( 256 ), CRYPT_MAX_PKCSIZE_ECC,
 	selfTest, getDefaultInfo, NULL, NULL, initKey, generateKey,
-	NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 
+	NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 
 	sign, sigCheck
 	};
 
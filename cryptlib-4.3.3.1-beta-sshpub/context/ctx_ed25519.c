@@ -0,0 +1,515 @@
+/****************************************************************************
+*																			*
+*						cryptlib Ed25519 Signature Routines					*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#define PKC_CONTEXT		/* Indicate that we're working with PKC contexts */
+#if defined( INC_ALL )
+  #include "crypt.h"
+  #include "context.h"
+  #include "curve25519.h"
+#else
+  #include "crypt.h"
+  #include "context/context.h"
+  #include "crypt/curve25519.h"
+#endif /* Compiler-specific includes */
+
+/* Ed25519 (RFC 8032) differs from the other signature algorithms in that
+   it signs the message itself rather than a hash of it, since the message
+   is hashed twice during the signing process, once with a secret prefix to
+   derive the per-signature nonce and once with the signature's R value and
+   the public key to derive the challenge.  Because of this the DLP_PARAMS
+   inParam1 value is the data to be signed rather than a hash value.  The
+   private key is the 32-byte seed from which the signing scalar and nonce
+   prefix are derived, and the public key is the 32-byte encoded point A.
+   The signature is the 64-byte value R || S, which has only a single
+   encoding so the format type is ignored:
+
+	sign:		h = SHA512( seed ), a = clamp( h[ 0...31 ] )
+				r = SHA512( h[ 32...63 ] || M ) mod L, R = [ r ]B
+				k = SHA512( R || A || M ) mod L
+				S = ( r + k * a ) mod L
+
+	sigCheck:	k = SHA512( R || A || M ) mod L
+				check [ S ]B - [ k ]A == R */
+
+#ifdef USE_ED25519
+
+/****************************************************************************
+*																			*
+*								Utility Routines							*
+*																			*
+****************************************************************************/
+
+/* Expand the private key seed into the clamped signing scalar and the
+   nonce prefix */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int expandPrivateKey( OUT_BUFFER_FIXED( CRYPT_MAX_HASHSIZE ) \
+								BYTE *expandedKey,
+							 IN_BUFFER( X25519_KEYSIZE ) const BYTE *seed )
+	{
+	HASH_FUNCTION_ATOMIC hashFunctionAtomic;
+	int hashSize;
+
+	assert( isWritePtr( expandedKey, CRYPT_MAX_HASHSIZE ) );
+	assert( isReadPtr( seed, X25519_KEYSIZE ) );
+
+	getHashAtomicParameters( CRYPT_ALGO_SHA2, bitsToBytes( 512 ),
+							 &hashFunctionAtomic, &hashSize );
+	ENSURES( hashSize == bitsToBytes( 512 ) );
+	hashFunctionAtomic( expandedKey, CRYPT_MAX_HASHSIZE, seed,
+						X25519_KEYSIZE );
+	expandedKey[ 0 ] &= 0xF8;
+	expandedKey[ 31 ] &= 0x7F;
+	expandedKey[ 31 ] |= 0x40;
+
+	return( CRYPT_OK );
+	}
+
+/* Compute SHA512( prefix1 || prefix2 || message ) mod L, used for both the
+   nonce r and the challenge k */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 5 ) ) \
+static int hashToScalar( OUT_BUFFER_FIXED( X25519_KEYSIZE ) BYTE *scalar,
+						 IN_BUFFER( X25519_KEYSIZE ) const BYTE *prefix1,
+						 IN_BUFFER_OPT( X25519_KEYSIZE ) const BYTE *prefix2,
+						 IN_BUFFER( messageLength ) const void *message,
+						 IN_LENGTH_SHORT const int messageLength )
+	{
+	HASH_FUNCTION hashFunction;
+	HASHINFO hashInfo;
+	BYTE hashValue[ CRYPT_MAX_HASHSIZE + 8 ];
+	int hashSize;
+
+	assert( isWritePtr( scalar, X25519_KEYSIZE ) );
+	assert( isReadPtr( prefix1, X25519_KEYSIZE ) );
+	assert( prefix2 == NULL || isReadPtr( prefix2, X25519_KEYSIZE ) );
+	assert( isReadPtrDynamic( message, messageLength ) );
+
+	REQUIRES( messageLength > 0 && messageLength < MAX_INTLENGTH_SHORT );
+
+	getHashParameters( CRYPT_ALGO_SHA2, bitsToBytes( 512 ), &hashFunction,
+					   &hashSize );
+	ENSURES( hashSize == bitsToBytes( 512 ) );
+	hashFunction( hashInfo, NULL, 0, prefix1, X25519_KEYSIZE,
+				  HASH_STATE_START );
+	if( prefix2 != NULL )
+		{
+		hashFunction( hashInfo, NULL, 0, prefix2, X25519_KEYSIZE,
+					  HASH_STATE_CONTINUE );
+		}
+	hashFunction( hashInfo, hashValue, CRYPT_MAX_HASHSIZE, message,
+				  messageLength, HASH_STATE_END );
+	ed25519ScalarReduce( scalar, hashValue );
+	zeroise( hashInfo, sizeof( HASHINFO ) );
+	zeroise( hashValue, CRYPT_MAX_HASHSIZE );
+
+	return( CRYPT_OK );
+	}
+
+/* Check whether a value is all zeroes, used to check whether a key
+   component is present */
+
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+static BOOLEAN isAllZeroes( IN_BUFFER( length ) const BYTE *data,
+							IN_LENGTH_SHORT const int length )
+	{
+	int value = 0, i;
+
+	assert( isReadPtrDynamic( data, length ) );
+
+	for( i = 0; i < length; i++ )
+		value |= data[ i ];
+
+	return( ( value == 0 ) ? TRUE : FALSE );
+	}
+
+/****************************************************************************
+*																			*
+*								Algorithm Self-test							*
+*																			*
+****************************************************************************/
+
+/* Perform a pairwise consistency test on a public/private key pair */
+
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+static BOOLEAN pairwiseConsistencyTest( INOUT CONTEXT_INFO *contextInfoPtr )
+	{
+	const CAPABILITY_INFO *capabilityInfoPtr = \
+								DATAPTR_GET( contextInfoPtr->capabilityInfo );
+	DLP_PARAMS dlpParams;
+	BYTE buffer[ ED25519_SIGNATURE_SIZE + 8 ];
+	int sigSize, status;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+
+	REQUIRES_B( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES_B( capabilityInfoPtr != NULL );
+
+	/* Generate a signature with the private key */
+	setDLPParams( &dlpParams, "abcde", 5, buffer, ED25519_SIGNATURE_SIZE );
+	status = capabilityInfoPtr->signFunction( contextInfoPtr,
+						( BYTE * ) &dlpParams, sizeof( DLP_PARAMS ) );
+	if( cryptStatusError( status ) )
+		return( FALSE );
+
+	/* Verify the signature with the public key */
+	sigSize = dlpParams.outLen;
+	setDLPParams( &dlpParams, "abcde", 5, NULL, 0 );
+	dlpParams.inParam2 = buffer;
+	dlpParams.inLen2 = sigSize;
+	status = capabilityInfoPtr->sigCheckFunction( contextInfoPtr,
+						( BYTE * ) &dlpParams, sizeof( DLP_PARAMS ) );
+	return( cryptStatusOK( status ) ? TRUE : FALSE );
+	}
+
+#ifndef CONFIG_NO_SELFTEST
+
+/* Test the Ed25519 implementation using test 2 from RFC 8032 section 7.1,
+   which signs the single-byte message 0x72 */
+
+static const FAR_DATA BYTE ed25519TestPrivKey[] = {
+	0x4C, 0xCD, 0x08, 0x9B, 0x28, 0xFF, 0x96, 0xDA,
+	0x9D, 0xB6, 0xC3, 0x46, 0xEC, 0x11, 0x4E, 0x0F,
+	0x5B, 0x8A, 0x31, 0x9F, 0x35, 0xAB, 0xA6, 0x24,
+	0xDA, 0x8C, 0xF6, 0xED, 0x4F, 0xB8, 0xA6, 0xFB
+	};
+static const FAR_DATA BYTE ed25519TestPubKey[] = {
+	0x3D, 0x40, 0x17, 0xC3, 0xE8, 0x43, 0x89, 0x5A,
+	0x92, 0xB7, 0x0A, 0xA7, 0x4D, 0x1B, 0x7E, 0xBC,
+	0x9C, 0x98, 0x2C, 0xCF, 0x2E, 0xC4, 0x96, 0x8C,
+	0xC0, 0xCD, 0x55, 0xF1, 0x2A, 0xF4, 0x66, 0x0C
+	};
+static const FAR_DATA BYTE ed25519TestMessage[] = { 0x72 };
+static const FAR_DATA BYTE ed25519TestSignature[] = {
+	0x92, 0xA0, 0x09, 0xA9, 0xF0, 0xD4, 0xCA, 0xB8,
+	0x72, 0x0E, 0x82, 0x0B, 0x5F, 0x64, 0x25, 0x40,
+	0xA2, 0xB2, 0x7B, 0x54, 0x16, 0x50, 0x3F, 0x8F,
+	0xB3, 0x76, 0x22, 0x23, 0xEB, 0xDB, 0x69, 0xDA,
+	0x08, 0x5A, 0xC1, 0xE4, 0x3E, 0x15, 0x99, 0x6E,
+	0x45, 0x8F, 0x36, 0x13, 0xD0, 0xF1, 0x1D, 0x8C,
+	0x38, 0x7B, 0x2E, 0xAE, 0xB4, 0x30, 0x2A, 0xEE,
+	0xB0, 0x0D, 0x29, 0x16, 0x12, 0xBB, 0x0C, 0x00
+	};
+
+CHECK_RETVAL \
+static int selfTest( void )
+	{
+	CONTEXT_INFO contextInfo;
+	PKC_INFO contextData, *pkcInfo = &contextData;
+	const CAPABILITY_INFO *capabilityInfoPtr;
+	DLP_PARAMS dlpParams;
+	BYTE buffer[ ED25519_SIGNATURE_SIZE + 8 ];
+	int status;
+
+	/* Initialise the key components */
+	status = staticInitContext( &contextInfo, CONTEXT_PKC,
+								getEd25519Capability(), &contextData,
+								sizeof( PKC_INFO ), NULL );
+	if( cryptStatusError( status ) )
+		return( CRYPT_ERROR_FAILED );
+	memcpy( pkcInfo->curve25519PrivateKey, ed25519TestPrivKey,
+			X25519_KEYSIZE );
+	capabilityInfoPtr = DATAPTR_GET( contextInfo.capabilityInfo );
+	REQUIRES( capabilityInfoPtr != NULL );
+
+	/* Check that we derive the expected public key and get the expected
+	   (deterministic) signature value, and that the signature verifies */
+	status = capabilityInfoPtr->initKeyFunction( &contextInfo, NULL, 0 );
+	if( cryptStatusOK( status ) && \
+		memcmp( pkcInfo->curve25519PublicKey, ed25519TestPubKey,
+				X25519_KEYSIZE ) )
+		status = CRYPT_ERROR_FAILED;
+	if( cryptStatusOK( status ) )
+		{
+		setDLPParams( &dlpParams, ed25519TestMessage, 1, buffer,
+					  ED25519_SIGNATURE_SIZE );
+		status = capabilityInfoPtr->signFunction( &contextInfo,
+						( BYTE * ) &dlpParams, sizeof( DLP_PARAMS ) );
+		}
+	if( cryptStatusOK( status ) && \
+		( dlpParams.outLen != ED25519_SIGNATURE_SIZE || \
+		  memcmp( buffer, ed25519TestSignature, ED25519_SIGNATURE_SIZE ) ) )
+		status = CRYPT_ERROR_FAILED;
+	if( cryptStatusOK( status ) && \
+		!pairwiseConsistencyTest( &contextInfo ) )
+		status = CRYPT_ERROR_FAILED;
+
+	/* Make sure that a corrupted signature is rejected */
+	if( cryptStatusOK( status ) )
+		{
+		buffer[ 8 ] ^= 0x01;
+		setDLPParams( &dlpParams, ed25519TestMessage, 1, NULL, 0 );
+		dlpParams.inParam2 = buffer;
+		dlpParams.inLen2 = ED25519_SIGNATURE_SIZE;
+		status = capabilityInfoPtr->sigCheckFunction( &contextInfo,
+						( BYTE * ) &dlpParams, sizeof( DLP_PARAMS ) );
+		status = ( status == CRYPT_ERROR_SIGNATURE ) ? \
+				 CRYPT_OK : CRYPT_ERROR_FAILED;
+		}
+
+	/* Clean up */
+	staticDestroyContext( &contextInfo );
+
+	return( cryptStatusOK( status ) ? CRYPT_OK : CRYPT_ERROR_FAILED );
+	}
+#else
+	#define selfTest	NULL
+#endif /* !CONFIG_NO_SELFTEST */
+
+/****************************************************************************
+*																			*
+*							Ed25519 Signature Routines						*
+*																			*
+****************************************************************************/
+
+/* Sign a single block of data */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int sign( INOUT CONTEXT_INFO *contextInfoPtr,
+				 INOUT_BUFFER_FIXED( noBytes ) BYTE *buffer,
+				 IN_LENGTH_FIXED( sizeof( DLP_PARAMS ) ) int noBytes )
+	{
+	PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+	DLP_PARAMS *dlpParams = ( DLP_PARAMS * ) buffer;
+	BYTE expandedKey[ CRYPT_MAX_HASHSIZE + 8 ];
+	BYTE r[ X25519_KEYSIZE + 8 ], k[ X25519_KEYSIZE + 8 ];
+	BYTE *signature = dlpParams->outParam;
+	int status;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( isWritePtr( dlpParams, sizeof( DLP_PARAMS ) ) );
+	assert( isReadPtrDynamic( dlpParams->inParam1, dlpParams->inLen1 ) );
+	assert( isWritePtrDynamic( dlpParams->outParam, dlpParams->outLen ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( noBytes == sizeof( DLP_PARAMS ) );
+	REQUIRES( dlpParams->inLen1 > 0 && \
+			  dlpParams->inLen1 < MAX_INTLENGTH_SHORT );
+	REQUIRES( dlpParams->inParam2 == NULL && dlpParams->inLen2 == 0 );
+	REQUIRES( dlpParams->outLen >= ED25519_SIGNATURE_SIZE && \
+			  dlpParams->outLen < MAX_INTLENGTH_SHORT );
+	REQUIRES( !isAllZeroes( pkcInfo->curve25519PrivateKey,
+							X25519_KEYSIZE ) );
+
+	/* Expand the private key and derive the nonce r from the nonce prefix
+	   and message, then compute R = [ r ]B.  Since r is derived
+	   deterministically there's no need for the random-k special-casing
+	   required for DSA and ECDSA */
+	status = expandPrivateKey( expandedKey, pkcInfo->curve25519PrivateKey );
+	if( cryptStatusOK( status ) )
+		{
+		status = hashToScalar( r, expandedKey + X25519_KEYSIZE, NULL,
+							   dlpParams->inParam1, dlpParams->inLen1 );
+		}
+	if( cryptStatusError( status ) )
+		{
+		zeroise( expandedKey, CRYPT_MAX_HASHSIZE );
+		return( status );
+		}
+	ed25519ScalarMultBase( signature, r );
+
+	/* Compute k = H( R || A || M ) and S = ( r + k * a ) mod L */
+	status = hashToScalar( k, signature, pkcInfo->curve25519PublicKey,
+						   dlpParams->inParam1, dlpParams->inLen1 );
+	if( cryptStatusOK( status ) )
+		{
+		ed25519ScalarMulAdd( signature + X25519_KEYSIZE, k, expandedKey,
+							 r );
+		dlpParams->outLen = ED25519_SIGNATURE_SIZE;
+		}
+	zeroise( expandedKey, CRYPT_MAX_HASHSIZE );
+	zeroise( r, X25519_KEYSIZE );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	ENSURES( sanityCheckPKCInfo( pkcInfo ) );
+
+	return( CRYPT_OK );
+	}
+
+/* Signature check a single block of data */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int sigCheck( INOUT CONTEXT_INFO *contextInfoPtr,
+					 IN_BUFFER( noBytes ) BYTE *buffer,
+					 IN_LENGTH_FIXED( sizeof( DLP_PARAMS ) ) int noBytes )
+	{
+	PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+	DLP_PARAMS *dlpParams = ( DLP_PARAMS * ) buffer;
+	const BYTE *signature = dlpParams->inParam2;
+	BYTE k[ X25519_KEYSIZE + 8 ], checkR[ X25519_KEYSIZE + 8 ];
+	int status;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( isWritePtr( dlpParams, sizeof( DLP_PARAMS ) ) );
+	assert( isReadPtrDynamic( dlpParams->inParam1, dlpParams->inLen1 ) );
+	assert( isReadPtrDynamic( dlpParams->inParam2, dlpParams->inLen2 ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( noBytes == sizeof( DLP_PARAMS ) );
+	REQUIRES( dlpParams->inLen1 > 0 && \
+			  dlpParams->inLen1 < MAX_INTLENGTH_SHORT );
+	REQUIRES( dlpParams->inLen2 > 0 && \
+			  dlpParams->inLen2 < MAX_INTLENGTH_SHORT );
+	REQUIRES( dlpParams->outParam == NULL && dlpParams->outLen == 0 );
+
+	/* The signature has a fixed size, and to prevent signature malleability
+	   the S value has to be fully reduced */
+	if( dlpParams->inLen2 != ED25519_SIGNATURE_SIZE )
+		return( CRYPT_ERROR_BADDATA );
+	if( !ed25519ScalarIsCanonical( signature + X25519_KEYSIZE ) )
+		return( CRYPT_ERROR_BADDATA );
+
+	/* Compute k = H( R || A || M ) and check that [ S ]B - [ k ]A == R */
+	status = hashToScalar( k, signature, pkcInfo->curve25519PublicKey,
+						   dlpParams->inParam1, dlpParams->inLen1 );
+	if( cryptStatusOK( status ) )
+		{
+		status = ed25519DoubleScalarMult( checkR, k,
+										  pkcInfo->curve25519PublicKey,
+										  signature + X25519_KEYSIZE );
+		}
+	if( cryptStatusError( status ) )
+		return( status );
+	if( !compareDataConstTime( checkR, signature, X25519_KEYSIZE ) )
+		return( CRYPT_ERROR_SIGNATURE );
+
+	ENSURES( sanityCheckPKCInfo( pkcInfo ) );
+
+	return( CRYPT_OK );
+	}
+
+/****************************************************************************
+*																			*
+*								Key Management								*
+*																			*
+****************************************************************************/
+
+/* Load key components into an encryption context.  As with X25519 there
+   are no external key-component structures, so keys are either generated
+   internally or read from their encoded form, after which this function
+   is called to complete the key setup */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int initKey( INOUT CONTEXT_INFO *contextInfoPtr,
+					IN_BUFFER_OPT( keyLength ) const void *key,
+					IN_LENGTH_SHORT_OPT const int keyLength )
+	{
+	PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+	const BOOLEAN isPublicKey = \
+		( contextInfoPtr->flags & CONTEXT_FLAG_ISPUBLICKEY ) ? TRUE : FALSE;
+	BYTE expandedKey[ CRYPT_MAX_HASHSIZE + 8 ];
+	BYTE publicKey[ X25519_KEYSIZE + 8 ];
+	int status;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( ( key == NULL && keyLength == 0 ) || \
+			( isReadPtrDynamic( key, keyLength ) ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( ( key == NULL && keyLength == 0 ) || \
+			  ( key != NULL && keyLength > 0 && \
+				keyLength < MAX_INTLENGTH_SHORT ) );
+
+	if( key != NULL )
+		return( CRYPT_ERROR_NOTAVAIL );
+
+	if( isPublicKey )
+		{
+		/* It's a public key, make sure that it's a valid point */
+		if( !ed25519CheckPoint( pkcInfo->curve25519PublicKey ) )
+			return( CRYPT_ERROR_BADDATA );
+		}
+	else
+		{
+		/* It's a private key, derive the public key from it.  If there's
+		   already a public key present, for example because it was read
+		   from a certificate or public-key record before the private key
+		   was loaded, make sure that it matches the derived one */
+		if( isAllZeroes( pkcInfo->curve25519PrivateKey, X25519_KEYSIZE ) )
+			return( CRYPT_ERROR_NOTINITED );
+		status = expandPrivateKey( expandedKey,
+								   pkcInfo->curve25519PrivateKey );
+		if( cryptStatusError( status ) )
+			return( status );
+		ed25519ScalarMultBase( publicKey, expandedKey );
+		zeroise( expandedKey, CRYPT_MAX_HASHSIZE );
+		if( !isAllZeroes( pkcInfo->curve25519PublicKey, X25519_KEYSIZE ) && \
+			memcmp( pkcInfo->curve25519PublicKey, publicKey,
+					X25519_KEYSIZE ) )
+			return( CRYPT_ERROR_INVALID );
+		memcpy( pkcInfo->curve25519PublicKey, publicKey, X25519_KEYSIZE );
+		}
+	pkcInfo->keySizeBits = bytesToBits( X25519_KEYSIZE );
+
+	/* Checksum the key data to try and detect fault attacks.  Since we're
+	   setting the checksum at this point there's no need to check the
+	   return value */
+	( void ) checksumContextData( pkcInfo, CRYPT_ALGO_ED25519,
+								  isPublicKey ? FALSE : TRUE );
+
+	return( CRYPT_OK );
+	}
+
+/* Generate a key into an encryption context */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int generateKey( INOUT CONTEXT_INFO *contextInfoPtr,
+						IN_LENGTH_SHORT_MIN( X25519_KEYSIZE * 8 ) \
+							const int keySizeBits )
+	{
+	PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+	MESSAGE_DATA msgData;
+	int status;
+
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( keySizeBits == bytesToBits( X25519_KEYSIZE ) );
+
+	/* Generate the private key, a random 256-bit seed */
+	setMessageData( &msgData, pkcInfo->curve25519PrivateKey,
+					X25519_KEYSIZE );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_GETATTRIBUTE_S,
+							  &msgData, CRYPT_IATTRIBUTE_RANDOM );
+	if( cryptStatusOK( status ) )
+		status = initKey( contextInfoPtr, NULL, 0 );
+	if( cryptStatusOK( status ) &&
+#ifndef USE_FIPS140
+		( contextInfoPtr->flags & CONTEXT_FLAG_SIDECHANNELPROTECTION ) &&
+#endif /* USE_FIPS140 */
+		!pairwiseConsistencyTest( contextInfoPtr ) )
+		{
+		DEBUG_DIAG(( "Consistency check of freshly-generated Ed25519 key "
+					 "failed" ));
+		assert( DEBUG_WARN );
+		status = CRYPT_ERROR_FAILED;
+		}
+	return( cryptArgError( status ) ? CRYPT_ERROR_FAILED : status );
+	}
+
+/****************************************************************************
+*																			*
+*						Capability Access Routines							*
+*																			*
+****************************************************************************/
+
+static const CAPABILITY_INFO FAR_DATA capabilityInfo = {
+	CRYPT_ALGO_ED25519, bitsToBytes( 0 ), "Ed25519", 7,
+	X25519_KEYSIZE, X25519_KEYSIZE, X25519_KEYSIZE,
+	selfTest, getDefaultInfo, NULL, NULL, initKey, generateKey,
+	NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+	sign, sigCheck
+	};
+
+CHECK_RETVAL_PTR_NONNULL \
+const CAPABILITY_INFO *getEd25519Capability( void )
+	{
+	return( &capabilityInfo );
+	}
+
+#endif /* USE_ED25519 */
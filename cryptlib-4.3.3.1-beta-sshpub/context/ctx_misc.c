@@ -42,7 +42,9 @@ static BOOLEAN sanityCheckFunctionality( const CAPABILITY_INFO *capabilityInfoPt
 		  capabilityInfoPtr->encryptCFBFunction != NULL || \
 		  capabilityInfoPtr->decryptCFBFunction != NULL || \
 		  capabilityInfoPtr->encryptGCMFunction != NULL || \
-		  capabilityInfoPtr->decryptGCMFunction != NULL ) ? TRUE : FALSE;
+		  capabilityInfoPtr->decryptGCMFunction != NULL || \
+		  capabilityInfoPtr->encryptCTRFunction != NULL || \
+		  capabilityInfoPtr->decryptCTRFunction != NULL ) ? TRUE : FALSE;
 	const BOOLEAN isSig = \
 		( capabilityInfoPtr->signFunction != NULL || \
 		  capabilityInfoPtr->sigCheckFunction != NULL ) ? TRUE : FALSE;
@@ -76,6 +78,8 @@ static BOOLEAN sanityCheckFunctionality( const CAPABILITY_INFO *capabilityInfoPt
 		  capabilityInfoPtr->decryptCFBFunction == NULL ) && \
 		( capabilityInfoPtr->encryptGCMFunction == NULL || \
 		  capabilityInfoPtr->decryptGCMFunction == NULL ) && \
+		( capabilityInfoPtr->encryptCTRFunction == NULL || \
+		  capabilityInfoPtr->decryptCTRFunction == NULL ) && \
 		( capabilityInfoPtr->signFunction == NULL || \
 		  capabilityInfoPtr->sigCheckFunction == NULL ) )
 		{
@@ -106,7 +110,9 @@ static BOOLEAN sanityCheckFunctionality( const CAPABILITY_INFO *capabilityInfoPt
 				capabilityInfoPtr->encryptCFBFunction != NULL || \
 				capabilityInfoPtr->decryptCFBFunction != NULL || \
 				capabilityInfoPtr->encryptGCMFunction != NULL || \
-				capabilityInfoPtr->decryptGCMFunction != NULL )
+				capabilityInfoPtr->decryptGCMFunction != NULL || \
+				capabilityInfoPtr->encryptCTRFunction != NULL || \
+				capabilityInfoPtr->decryptCTRFunction != NULL )
 				{
 				DEBUG_PRINT(( "sanityCheckFunctionality: Spurious stream capability" ));
 				return( FALSE );
@@ -146,6 +152,14 @@ static BOOLEAN sanityCheckFunctionality( const CAPABILITY_INFO *capabilityInfoPt
 			DEBUG_PRINT(( "sanityCheckFunctionality: Inconsistent GCM" ));
 			return( FALSE );
 			}
+		if( ( capabilityInfoPtr->encryptCTRFunction != NULL && \
+			  capabilityInfoPtr->decryptCTRFunction == NULL ) || \
+			( capabilityInfoPtr->encryptCTRFunction == NULL && \
+			  capabilityInfoPtr->decryptCTRFunction != NULL ) )
+			{
+			DEBUG_PRINT(( "sanityCheckFunctionality: Inconsistent CTR" ));
+			return( FALSE );
+			}
 		
 		return( TRUE );
 		}
@@ -269,6 +283,7 @@ BOOLEAN sanityCheckCapability( const CAPABILITY_INFO *capabilityInfoPtr )
 			return( FALSE );
 			}
 		if( !isStreamCipher( cryptAlgo ) && \
+			!isNonceStreamCipher( cryptAlgo ) && \
 			 capabilityInfoPtr->blockSize < bitsToBytes( 64 ) )
 			{
 			DEBUG_PRINT(( "sanityCheckCapability: Conv. minimum block size" ));
@@ -281,8 +296,9 @@ BOOLEAN sanityCheckCapability( const CAPABILITY_INFO *capabilityInfoPtr )
 	/* Check any remaining algorithm types */
 	if( isPkcAlgo( cryptAlgo ) )
 		{
-		const int minKeySize = isEccAlgo( cryptAlgo ) ? \
-							   MIN_PKCSIZE_ECC : MIN_PKCSIZE;
+		const int minKeySize = isEccAlgo( cryptAlgo ) ? MIN_PKCSIZE_ECC : \
+							   is25519Algo( cryptAlgo ) ? X25519_KEYSIZE : \
+							   MIN_PKCSIZE;
 
 		if( capabilityInfoPtr->blockSize != 0 || \
 			( capabilityInfoPtr->minKeySize < minKeySize || \
@@ -717,6 +733,18 @@ typedef struct HAI {
 	const HASH_FUNCTION_ATOMIC function;
 	} HASHFUNCTION_ATOMIC_INFO;
 
+typedef struct HBAI {
+	const CRYPT_ALGO_TYPE cryptAlgo;
+	const int hashSize;
+	const HASH_FUNCTION_BATCH function;
+	} HASHFUNCTION_BATCH_INFO;
+
+typedef struct HCAI {
+	const CRYPT_ALGO_TYPE cryptAlgo;
+	const int hashSize;
+	const HASH_FUNCTION_HMACCHAIN function;
+	} HASHFUNCTION_HMACCHAIN_INFO;
+
 STDC_NONNULL_ARG( ( 3 ) ) \
 void getHashParameters( IN_ALGO const CRYPT_ALGO_TYPE hashAlgorithm,
 						IN_INT_SHORT_Z const int hashParam,
@@ -884,3 +912,96 @@ void getHashAtomicParameters( IN_ALGO const CRYPT_ALGO_TYPE hashAlgorithm,
 	if( hashOutputSize != NULL )
 		*hashOutputSize = hashFunctions[ i ].hashSize;
 	}
+
+STDC_NONNULL_ARG( ( 3 ) ) \
+void getHashBatchParameters( IN_ALGO const CRYPT_ALGO_TYPE hashAlgorithm,
+							 IN_INT_SHORT_Z const int hashParam,
+							 OUT_PTR HASH_FUNCTION_BATCH *hashFunctionBatch, 
+							 OUT_OPT_LENGTH_SHORT_Z int *hashOutputSize )
+	{
+	static const HASHFUNCTION_BATCH_INFO FAR_DATA hashFunctions[] = {
+		{ CRYPT_ALGO_SHA1, SHA_DIGEST_LENGTH, shaHashBufferBatch },
+		{ CRYPT_ALGO_SHA2, SHA256_DIGEST_SIZE, sha2HashBufferBatch },
+		{ CRYPT_ALGO_NONE, SHA_DIGEST_LENGTH, shaHashBufferBatch },
+		{ CRYPT_ALGO_NONE, SHA_DIGEST_LENGTH, shaHashBufferBatch }
+		};
+	int i, LOOP_ITERATOR;
+
+	assert( isHashAlgo( hashAlgorithm ) );
+	assert( hashParam >= 0 && hashParam < MAX_INTLENGTH_SHORT );
+	assert( isWritePtr( hashFunctionBatch, sizeof( HASH_FUNCTION_BATCH ) ) );
+	assert( ( hashOutputSize == NULL ) || \
+			isWritePtr( hashOutputSize, sizeof( int ) ) );
+
+	/* Clear return value */
+	if( hashOutputSize != NULL )
+		*hashOutputSize = 0;
+
+	/* Find the information for the requested hash algorithm.  Batch 
+	   hashing is only used for the algorithms that are used to generate 
+	   IDs and fingerprints so there are fewer entries here than for the 
+	   other hash functions */
+	LOOP_SMALL( i = 0, hashFunctions[ i ].cryptAlgo != CRYPT_ALGO_NONE && \
+					   i < FAILSAFE_ARRAYSIZE( hashFunctions, HASHFUNCTION_BATCH_INFO ), 
+				i++ )
+		{
+		if( hashFunctions[ i ].cryptAlgo == hashAlgorithm && \
+			( hashParam == 0 || hashFunctions[ i ].hashSize == hashParam ) )
+			break;
+		}
+	if( !LOOP_BOUND_OK || \
+		i >= FAILSAFE_ARRAYSIZE( hashFunctions, HASHFUNCTION_BATCH_INFO ) || \
+		hashFunctions[ i ].cryptAlgo == CRYPT_ALGO_NONE )
+		{
+		/* Make sure that we always get some sort of hash function rather 
+		   than just dying, as for getHashParameters() */
+		*hashFunctionBatch = shaHashBufferBatch;
+		if( hashOutputSize != NULL )
+			*hashOutputSize = SHA_DIGEST_LENGTH;
+		retIntError_Void();
+		}
+
+	*hashFunctionBatch = hashFunctions[ i ].function;
+	if( hashOutputSize != NULL )
+		*hashOutputSize = hashFunctions[ i ].hashSize;
+	}
+
+STDC_NONNULL_ARG( ( 3 ) ) \
+void getHashHmacChainParameters( IN_ALGO const CRYPT_ALGO_TYPE hashAlgorithm,
+								 IN_INT_SHORT_Z const int hashParam,
+								 OUT_PTR_OPT \
+									HASH_FUNCTION_HMACCHAIN *hashFunctionHmacChain )
+	{
+	static const HASHFUNCTION_HMACCHAIN_INFO FAR_DATA hashFunctions[] = {
+		{ CRYPT_ALGO_SHA1, SHA_DIGEST_LENGTH, shaHmacChain },
+		{ CRYPT_ALGO_SHA2, SHA256_DIGEST_SIZE, sha2HmacChain },
+		{ CRYPT_ALGO_NONE, 0, NULL }, { CRYPT_ALGO_NONE, 0, NULL }
+		};
+	int i, LOOP_ITERATOR;
+
+	assert( isHashAlgo( hashAlgorithm ) );
+	assert( hashParam >= 0 && hashParam < MAX_INTLENGTH_SHORT );
+	assert( isWritePtr( hashFunctionHmacChain, \
+						sizeof( HASH_FUNCTION_HMACCHAIN ) ) );
+
+	/* Clear return value */
+	*hashFunctionHmacChain = NULL;
+
+	/* Find the information for the requested hash algorithm.  HMAC chains 
+	   are only provided for the hash algorithms that are commonly used with
+	   PBKDF2, for anything else we return a NULL function and the caller 
+	   has to build the chain from the standard hash function */
+	LOOP_SMALL( i = 0, hashFunctions[ i ].cryptAlgo != CRYPT_ALGO_NONE && \
+					   i < FAILSAFE_ARRAYSIZE( hashFunctions, \
+											   HASHFUNCTION_HMACCHAIN_INFO ), 
+				i++ )
+		{
+		if( hashFunctions[ i ].cryptAlgo == hashAlgorithm && \
+			( hashParam == 0 || hashFunctions[ i ].hashSize == hashParam ) )
+			{
+			*hashFunctionHmacChain = hashFunctions[ i ].function;
+			break;
+			}
+		}
+	ENSURES_V( LOOP_BOUND_OK );
+	}
@@ -758,7 +758,7 @@ static const CAPABILITY_INFO FAR_DATA capabilityInfo = {
 	MIN_PKCSIZE, bitsToBytes( 1536 ), CRYPT_MAX_PKCSIZE,
 	selfTest, getDefaultInfo, NULL, NULL, initKey, generateKey, 
 	encryptFn, decryptFn, NULL, NULL, NULL, NULL, NULL, NULL, 
-	decryptFn, encryptFn
+	NULL, NULL, decryptFn, encryptFn
 	};
 
 CHECK_RETVAL_PTR_NONNULL \
@@ -9,10 +9,12 @@
   #include "crypt.h"
   #include "context.h"
   #include "sha.h"
+  #include "sha_ni.h"
 #else
   #include "crypt.h"
   #include "context/context.h"
   #include "crypt/sha.h"
+  #include "crypt/sha_ni.h"
 #endif /* Compiler-specific includes */
 
 #define HASH_STATE_SIZE		sizeof( SHA_CTX )
@@ -211,6 +213,142 @@ void shaHashBufferAtomic( OUT_BUFFER_C( outBufMaxLength, 20 ) BYTE *outBuffer,
 	zeroise( &shaInfo, sizeof( SHA_CTX ) );
 	}
 
+STDC_NONNULL_ARG( ( 1 ) ) \
+void shaHashBufferBatch( INOUT_ARRAY( noEntries ) HASH_BATCH_INFO *hashBatchInfo,
+						 IN_INT_SHORT const int noEntries )
+	{
+	int i, LOOP_ITERATOR;
+
+	assert( isWritePtrDynamic( hashBatchInfo, \
+							   sizeof( HASH_BATCH_INFO ) * noEntries ) );
+
+	if( noEntries <= 0 || noEntries >= MAX_INTLENGTH_SHORT )
+		retIntError_Void();
+	LOOP_MAX( i = 0, i < noEntries, i++ )
+		{
+		if( hashBatchInfo[ i ].data == NULL || \
+			hashBatchInfo[ i ].dataLength <= 0 || \
+			hashBatchInfo[ i ].dataLength >= MAX_INTLENGTH_SHORT )
+			retIntError_Void();
+		}
+	ENSURES_V( LOOP_BOUND_OK );
+
+#ifdef USE_SHA_NI_IF_PRESENT
+	/* If there's more than one message to hash and the hardware allows it, 
+	   hash them in parallel */
+	if( noEntries > 1 && sha1_mb_hash( hashBatchInfo, noEntries ) )
+		return;
+#endif /* USE_SHA_NI_IF_PRESENT */
+
+	LOOP_MAX( i = 0, i < noEntries, i++ )
+		{
+		shaHashBufferAtomic( hashBatchInfo[ i ].hash, CRYPT_MAX_HASHSIZE,
+							 hashBatchInfo[ i ].data, 
+							 hashBatchInfo[ i ].dataLength );
+		}
+	ENSURES_V( LOOP_BOUND_OK );
+	}
+
+/* Run a set of HMAC chains for PBKDF2.  The input to each HMAC is a single 
+   hash value so both the inner and the outer hash consist of a single 
+   compression-function call on a block containing the hash value followed
+   by the padding and length for a message of one HMAC pad block plus the 
+   hash value, which allows us to set up the block once and then just 
+   update the hash value in it for each step of the chain */
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static void getHashValue( OUT_BUFFER_FIXED_C( SHA_DIGEST_LENGTH ) BYTE *buffer,
+						  const SHA_CTX *shaInfo )
+	{
+	BYTE *bufPtr = buffer;
+
+	mputLong( bufPtr, shaInfo->h0 );
+	mputLong( bufPtr, shaInfo->h1 );
+	mputLong( bufPtr, shaInfo->h2 );
+	mputLong( bufPtr, shaInfo->h3 );
+	mputLong( bufPtr, shaInfo->h4 );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int shaHmacChain( IN TYPECAST( HASHINFO ) const void *innerHashState,
+				  IN TYPECAST( HASHINFO ) const void *outerHashState,
+				  INOUT_ARRAY( noChains ) HMAC_CHAIN_INFO *hmacChainInfo,
+				  IN_RANGE( 1, MAX_HMAC_CHAINS ) const int noChains,
+				  IN_INT const int iterations )
+	{
+	const SHA_CTX *innerInfo = ( const SHA_CTX * ) innerHashState;
+	const SHA_CTX *outerInfo = ( const SHA_CTX * ) outerHashState;
+	SHA_CTX shaInfo;
+	BYTE block[ SHA_CBLOCK + 8 ];
+	int i, LOOP_ITERATOR;
+
+	assert( isReadPtr( innerHashState, sizeof( HASHINFO ) ) );
+	assert( isReadPtr( outerHashState, sizeof( HASHINFO ) ) );
+	assert( isWritePtrDynamic( hmacChainInfo, \
+							   sizeof( HMAC_CHAIN_INFO ) * noChains ) );
+
+	REQUIRES( noChains >= 1 && noChains <= MAX_HMAC_CHAINS );
+	REQUIRES( iterations > 0 && iterations < MAX_INTLENGTH );
+
+	/* The hash states have to be positioned just after the HMAC pad block,
+	   with nothing further hashed yet */
+	REQUIRES( innerInfo->Nl == SHA_CBLOCK * 8 && innerInfo->Nh == 0 && \
+			  innerInfo->num == 0 && outerInfo->Nl == SHA_CBLOCK * 8 && \
+			  outerInfo->Nh == 0 && outerInfo->num == 0 );
+
+#ifdef USE_SHA_NI_IF_PRESENT
+	/* If the hardware allows it, run the chains in parallel */
+	{
+	const uint32_t innerHash[ 5 ] = { innerInfo->h0, innerInfo->h1, 
+		innerInfo->h2, innerInfo->h3, innerInfo->h4 };
+	const uint32_t outerHash[ 5 ] = { outerInfo->h0, outerInfo->h1, 
+		outerInfo->h2, outerInfo->h3, outerInfo->h4 };
+
+	if( sha1_mb_hmac_chain( innerHash, outerHash, hmacChainInfo, noChains, 
+							iterations ) )
+		return( CRYPT_OK );
+	}
+#endif /* USE_SHA_NI_IF_PRESENT */
+
+	/* Set up the padding and length for a 64 + 20 byte message */
+	memset( block, 0, SHA_CBLOCK );
+	block[ SHA_DIGEST_LENGTH ] = 0x80;
+	block[ SHA_CBLOCK - 2 ] = ( BYTE ) ( ( ( SHA_CBLOCK + SHA_DIGEST_LENGTH ) * 8 ) >> 8 );
+	block[ SHA_CBLOCK - 1 ] = ( BYTE ) ( ( SHA_CBLOCK + SHA_DIGEST_LENGTH ) * 8 );
+
+	LOOP_SMALL( i = 0, i < noChains, i++ )
+		{
+		HMAC_CHAIN_INFO *chainInfo = &hmacChainInfo[ i ];
+		int j, LOOP_ITERATOR_ALT;
+
+		memcpy( block, chainInfo->value, SHA_DIGEST_LENGTH );
+		LOOP_MAX_ALT( j = 0, j < iterations, j++ )
+			{
+			int k;
+
+			/* U_i = HMAC( U_i-1 ), with the inner and outer hash each 
+			   being a single compression-function call */
+			memcpy( &shaInfo, innerInfo, sizeof( SHA_CTX ) );
+			SHA1_Transform( &shaInfo, block );
+			getHashValue( block, &shaInfo );
+			memcpy( &shaInfo, outerInfo, sizeof( SHA_CTX ) );
+			SHA1_Transform( &shaInfo, block );
+			getHashValue( block, &shaInfo );
+
+			/* Accumulate U_1 ^ U_2 ^ ... ^ U_i */
+			for( k = 0; k < SHA_DIGEST_LENGTH; k++ )
+				chainInfo->output[ k ] ^= block[ k ];
+			}
+		ENSURES( LOOP_BOUND_OK_ALT );
+		memcpy( chainInfo->value, block, SHA_DIGEST_LENGTH );
+		}
+	ENSURES( LOOP_BOUND_OK );
+	zeroise( &shaInfo, sizeof( SHA_CTX ) );
+	zeroise( block, SHA_CBLOCK );
+
+	return( CRYPT_OK );
+	}
+
 /****************************************************************************
 *																			*
 *						Capability Access Routines							*
@@ -9,10 +9,12 @@
   #include "crypt.h"
   #include "context.h"
   #include "sha2.h"
+  #include "sha_ni.h"
 #else
   #include "crypt.h"
   #include "context/context.h"
   #include "crypt/sha2.h"
+  #include "crypt/sha_ni.h"
 #endif /* Compiler-specific includes */
 
 #define HASH_STATE_SIZE		sizeof( sha2_ctx )
@@ -287,6 +289,148 @@ void sha2HashBufferAtomic( OUT_BUFFER_C( outBufMaxLength, 32 ) BYTE *outBuffer,
 	zeroise( &shaInfo, sizeof( sha2_ctx ) );
 	}
 
+STDC_NONNULL_ARG( ( 1 ) ) \
+void sha2HashBufferBatch( INOUT_ARRAY( noEntries ) HASH_BATCH_INFO *hashBatchInfo,
+						  IN_INT_SHORT const int noEntries )
+	{
+	int i, LOOP_ITERATOR;
+
+	assert( isWritePtrDynamic( hashBatchInfo, \
+							   sizeof( HASH_BATCH_INFO ) * noEntries ) );
+
+	if( noEntries <= 0 || noEntries >= MAX_INTLENGTH_SHORT )
+		retIntError_Void();
+	LOOP_MAX( i = 0, i < noEntries, i++ )
+		{
+		if( hashBatchInfo[ i ].data == NULL || \
+			hashBatchInfo[ i ].dataLength <= 0 || \
+			hashBatchInfo[ i ].dataLength >= MAX_INTLENGTH_SHORT )
+			retIntError_Void();
+		}
+	ENSURES_V( LOOP_BOUND_OK );
+
+#ifdef USE_SHA_NI_IF_PRESENT
+	/* If there's more than one message to hash and the hardware allows it, 
+	   hash them in parallel */
+	if( noEntries > 1 && sha256_mb_hash( hashBatchInfo, noEntries ) )
+		return;
+#endif /* USE_SHA_NI_IF_PRESENT */
+
+	LOOP_MAX( i = 0, i < noEntries, i++ )
+		{
+		sha2HashBufferAtomic( hashBatchInfo[ i ].hash, CRYPT_MAX_HASHSIZE,
+							  hashBatchInfo[ i ].data, 
+							  hashBatchInfo[ i ].dataLength );
+		}
+	ENSURES_V( LOOP_BOUND_OK );
+	}
+
+/* Run a set of HMAC chains for PBKDF2, see the comment for shaHmacChain() 
+   for details.  The SHA-256 compression function works on a block of 
+   message words in host byte order so we can keep the chain values in 
+   that form and only convert them at the start and end.  Since 
+   sha256_compile() expands the message schedule in place in the message 
+   block we have to rebuild the complete block, including the padding, 
+   before each compression-function call */
+
+static const uint32_t hmacChainPadding[ 8 ] = {
+	0x80000000UL, 0, 0, 0, 0, 0, 0, 
+	( SHA256_BLOCK_SIZE + SHA256_DIGEST_SIZE ) * 8 
+	};
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static void hmacChainCompile( INOUT sha256_ctx *shaInfo,
+							  IN_ARRAY_C( 8 ) const uint32_t *initialHash,
+							  INOUT_ARRAY_C( 8 ) uint32_t *value )
+	{
+	memcpy( shaInfo->hash, initialHash, 8 * sizeof( uint32_t ) );
+	memcpy( shaInfo->wbuf, value, 8 * sizeof( uint32_t ) );
+	memcpy( shaInfo->wbuf + 8, hmacChainPadding, 8 * sizeof( uint32_t ) );
+	sha256_compile( shaInfo );
+	memcpy( value, shaInfo->hash, 8 * sizeof( uint32_t ) );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int sha2HmacChain( IN TYPECAST( HASHINFO ) const void *innerHashState,
+				   IN TYPECAST( HASHINFO ) const void *outerHashState,
+				   INOUT_ARRAY( noChains ) HMAC_CHAIN_INFO *hmacChainInfo,
+				   IN_RANGE( 1, MAX_HMAC_CHAINS ) const int noChains,
+				   IN_INT const int iterations )
+	{
+	const sha2_ctx *innerInfo = ( const sha2_ctx * ) innerHashState;
+	const sha2_ctx *outerInfo = ( const sha2_ctx * ) outerHashState;
+	const sha256_ctx *innerInfo256 = innerInfo->uu->ctx256;
+	const sha256_ctx *outerInfo256 = outerInfo->uu->ctx256;
+	sha256_ctx shaInfo;
+	uint32_t value[ 8 ], output[ 8 ];
+	int i, LOOP_ITERATOR;
+
+	assert( isReadPtr( innerHashState, sizeof( HASHINFO ) ) );
+	assert( isReadPtr( outerHashState, sizeof( HASHINFO ) ) );
+	assert( isWritePtrDynamic( hmacChainInfo, \
+							   sizeof( HMAC_CHAIN_INFO ) * noChains ) );
+
+	REQUIRES( noChains >= 1 && noChains <= MAX_HMAC_CHAINS );
+	REQUIRES( iterations > 0 && iterations < MAX_INTLENGTH );
+
+	/* The hash states have to be for SHA-256 and positioned just after the 
+	   HMAC pad block, with nothing further hashed yet */
+	REQUIRES( innerInfo->sha2_len == SHA256_DIGEST_SIZE && \
+			  outerInfo->sha2_len == SHA256_DIGEST_SIZE && \
+			  innerInfo256->count[ 0 ] == SHA256_BLOCK_SIZE && \
+			  innerInfo256->count[ 1 ] == 0 && \
+			  outerInfo256->count[ 0 ] == SHA256_BLOCK_SIZE && \
+			  outerInfo256->count[ 1 ] == 0 );
+
+#ifdef USE_SHA_NI_IF_PRESENT
+	/* If the hardware allows it, run the chains in parallel */
+	if( sha256_mb_hmac_chain( innerInfo256->hash, outerInfo256->hash, 
+							  hmacChainInfo, noChains, iterations ) )
+		return( CRYPT_OK );
+#endif /* USE_SHA_NI_IF_PRESENT */
+
+	memset( &shaInfo, 0, sizeof( sha256_ctx ) );
+	LOOP_SMALL( i = 0, i < noChains, i++ )
+		{
+		HMAC_CHAIN_INFO *chainInfo = &hmacChainInfo[ i ];
+		BYTE *valuePtr = chainInfo->value, *outputPtr = chainInfo->output;
+		int j, LOOP_ITERATOR_ALT;
+
+		for( j = 0; j < 8; j++ )
+			{
+			value[ j ] = mgetLong( valuePtr );
+			output[ j ] = mgetLong( outputPtr );
+			}
+		LOOP_MAX_ALT( j = 0, j < iterations, j++ )
+			{
+			int k;
+
+			/* U_i = HMAC( U_i-1 ), with the inner and outer hash each 
+			   being a single compression-function call */
+			hmacChainCompile( &shaInfo, innerInfo256->hash, value );
+			hmacChainCompile( &shaInfo, outerInfo256->hash, value );
+
+			/* Accumulate U_1 ^ U_2 ^ ... ^ U_i */
+			for( k = 0; k < 8; k++ )
+				output[ k ] ^= value[ k ];
+			}
+		ENSURES( LOOP_BOUND_OK_ALT );
+		valuePtr = chainInfo->value;
+		outputPtr = chainInfo->output;
+		for( j = 0; j < 8; j++ )
+			{
+			mputLong( valuePtr, value[ j ] );
+			mputLong( outputPtr, output[ j ] );
+			}
+		}
+	ENSURES( LOOP_BOUND_OK );
+	zeroise( &shaInfo, sizeof( sha256_ctx ) );
+	zeroise( value, 8 * sizeof( uint32_t ) );
+	zeroise( output, 8 * sizeof( uint32_t ) );
+
+	return( CRYPT_OK );
+	}
+
 #ifdef USE_SHA2_EXT
 
 #if defined( CONFIG_SUITEB )
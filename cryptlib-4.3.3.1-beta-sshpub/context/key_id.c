@@ -29,7 +29,10 @@
 *																			*
 ****************************************************************************/
 
-/* Calculate a keyID from an encoded SubjectPublicKeyInfo record */
+#ifdef USE_DEVICES
+
+/* Calculate a keyID from an encoded SubjectPublicKeyInfo record, used for 
+   keys held in devices where we only have the encoded form */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3 ) ) \
 static int calculateFlatKeyID( IN_BUFFER( keyInfoSize ) const void *keyInfo,
@@ -51,6 +54,7 @@ static int calculateFlatKeyID( IN_BUFFER( keyInfoSize ) const void *keyInfo,
 
 	return( CRYPT_OK );
 	}
+#endif /* USE_DEVICES */
 
 /****************************************************************************
 *																			*
@@ -253,40 +257,47 @@ static int calculateKeyIDFromEncoded( INOUT CONTEXT_INFO *contextInfoPtr,
 *																			*
 ****************************************************************************/
 
-/* Generate a PGP keyID */
+/* Write the data used to generate an OpenPGP keyID */
 
 #if defined( USE_PGP ) || defined( USE_PGPKEYS )
 
-CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
-static int calculateOpenPGPKeyID( INOUT CONTEXT_INFO *contextInfoPtr,
-								  IN_ALGO const CRYPT_ALGO_TYPE cryptAlgo )
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+static int writeOpenPGPKeyData( INOUT CONTEXT_INFO *contextInfoPtr,
+								OUT_BUFFER( keyDataMaxLength, *keyDataLength ) \
+									BYTE *keyData,
+								IN_LENGTH_SHORT_MIN( 64 ) \
+									const int keyDataMaxLength,
+								OUT_LENGTH_BOUNDED_Z( keyDataMaxLength ) \
+									int *keyDataLength )
 	{
 	PKC_INFO *publicKey = contextInfoPtr->ctxPKC;
 	const PKC_WRITEKEY_FUNCTION writePublicKeyFunction = \
 						FNPTR_GET( publicKey->writePublicKeyFunction );
-	HASH_FUNCTION hashFunction;
-	HASHINFO hashInfo;
 	STREAM stream;
-	BYTE buffer[ ( CRYPT_MAX_PKCSIZE * 4 ) + 50 + 8 ];
-	BYTE hash[ CRYPT_MAX_HASHSIZE + 8 ], packetHeader[ 64 + 8 ];
-	int hashSize, length, status;
+	int length, status;
 
 	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( isWritePtrDynamic( keyData, keyDataMaxLength ) );
+	assert( isWritePtr( keyDataLength, sizeof( int ) ) );
 
 	REQUIRES( sanityCheckContext( contextInfoPtr ) );
-	REQUIRES( isPkcAlgo( cryptAlgo ) );
+	REQUIRES( keyDataMaxLength >= 64 && \
+			  keyDataMaxLength < MAX_INTLENGTH_SHORT );
 	REQUIRES( writePublicKeyFunction != NULL );
 
-	/* Generate an OpenPGP key ID.  Note that the creation date isn't 
-	   necessarily present if the key came from a non-PGP source, in which 
-	   case the date will just have a value of zero.  In theory we could 
-	   also opportunistically set one on load so there'll be some value 
-	   present if the key is used in a PGP context, but that would mean that
-	   the key has in a new time being set each time it's instantiated from 
-	   non-PGP key data so the same non-PGP key used for PGP purposes would
-	   have a different ID each time it was loaded so we just leave the date
-	   as an all-zero value which may look a bit odd when viewed but at 
-	   least produces a constant ID:
+	/* Clear return value */
+	*keyDataLength = 0;
+
+	/* Write the data needed to generate an OpenPGP key ID.  Note that the 
+	   creation date isn't necessarily present if the key came from a non-
+	   PGP source, in which case the date will just have a value of zero.  
+	   In theory we could also opportunistically set one on load so there'll 
+	   be some value present if the key is used in a PGP context, but that 
+	   would mean that the key has in a new time being set each time it's 
+	   instantiated from non-PGP key data so the same non-PGP key used for 
+	   PGP purposes would have a different ID each time it was loaded so we 
+	   just leave the date as an all-zero value which may look a bit odd 
+	   when viewed but at least produces a constant ID:
 
 		byte		ctb = 0x99
 		byte[2]		length
@@ -296,9 +307,11 @@ static int calculateOpenPGPKeyID( INOUT CONTEXT_INFO *contextInfoPtr,
 		byte		algorithm
 		byte[]		key data
 
-	  We do this by writing the public key fields to a buffer and creating a 
-	  separate PGP public key header, then hashing the two */
-	sMemOpen( &stream, buffer, ( CRYPT_MAX_PKCSIZE * 4 ) + 50 );
+	  We do this by writing the public key fields to the buffer following 
+	  space for the PGP public key header and then filling in the header 
+	  once the length is known, so that the result can be hashed in one 
+	  go */
+	sMemOpen( &stream, keyData + 1 + 2, keyDataMaxLength - ( 1 + 2 ) );
 	status = writePublicKeyFunction( &stream, contextInfoPtr, KEYFORMAT_PGP, 
 									 "public_key", 10 );
 	if( cryptStatusError( status ) )
@@ -307,20 +320,11 @@ static int calculateOpenPGPKeyID( INOUT CONTEXT_INFO *contextInfoPtr,
 		return( status );
 		}
 	length = stell( &stream );
-	packetHeader[ 0 ] = 0x99;
-	packetHeader[ 1 ] = intToByte( ( length >> 8 ) & 0xFF );
-	packetHeader[ 2 ] = intToByte( length & 0xFF );
-
-	/* Hash the data needed to generate the OpenPGP keyID */
-	getHashParameters( CRYPT_ALGO_SHA1, 0, &hashFunction, &hashSize );
-	hashFunction( hashInfo, NULL, 0, packetHeader, 1 + 2, 
-				  HASH_STATE_START );
-	hashFunction( hashInfo, hash, CRYPT_MAX_HASHSIZE, buffer, length, 
-				  HASH_STATE_END );
-	memcpy( publicKey->openPgpKeyID, hash + hashSize - PGP_KEYID_SIZE, 
-			PGP_KEYID_SIZE );
-	sMemClose( &stream );
-	contextInfoPtr->ctxPKC->flags |= PKCINFO_FLAG_OPENPGPKEYID_SET;
+	sMemDisconnect( &stream );
+	keyData[ 0 ] = 0x99;
+	keyData[ 1 ] = intToByte( ( length >> 8 ) & 0xFF );
+	keyData[ 2 ] = intToByte( length & 0xFF );
+	*keyDataLength = 1 + 2 + length;
 
 	return( CRYPT_OK );
 	}
@@ -383,10 +387,15 @@ static int calculateKeyID( INOUT CONTEXT_INFO *contextInfoPtr )
 						FNPTR_GET( publicKey->writePublicKeyFunction );
 	const CAPABILITY_INFO *capabilityInfoPtr = \
 						DATAPTR_GET( contextInfoPtr->capabilityInfo );
+	HASH_FUNCTION_BATCH hashFunctionBatch;
+	HASH_BATCH_INFO hashBatchInfo[ 2 ];
 	STREAM stream;
 	BYTE buffer[ ( CRYPT_MAX_PKCSIZE * 4 ) + 50 + 8 ];
+#if defined( USE_PGP ) || defined( USE_PGPKEYS )
+	BYTE pgpBuffer[ ( CRYPT_MAX_PKCSIZE * 4 ) + 50 + 8 ];
+#endif /* USE_PGP || USE_PGPKEYS */
 	CRYPT_ALGO_TYPE cryptAlgo;
-	int status;
+	int noHashes = 1, hashSize, status;
 
 	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
 
@@ -408,7 +417,7 @@ static int calculateKeyID( INOUT CONTEXT_INFO *contextInfoPtr )
 #endif /* USE_DEVICES */
 		}
 
-	/* Write the public key fields to a buffer and hash them to get the key
+	/* Write the public key fields to a buffer to be hashed to get the key
 	   ID */
 	sMemOpen( &stream, buffer, ( CRYPT_MAX_PKCSIZE * 4 ) + 50 );
 	if( isDlpAlgo( cryptAlgo ) && BN_is_zero( &publicKey->dlpParam_q ) )
@@ -426,12 +435,13 @@ static int calculateKeyID( INOUT CONTEXT_INFO *contextInfoPtr )
 		status = writePublicKeyFunction( &stream, contextInfoPtr, 
 										 KEYFORMAT_CERT, "public_key", 10 );
 		}
-	if( cryptStatusOK( status ) )
-		status = calculateFlatKeyID( buffer, stell( &stream ), 
-									 publicKey->keyID, KEYID_SIZE );
-	sMemClose( &stream );
+	hashBatchInfo[ 0 ].data = buffer;
+	hashBatchInfo[ 0 ].dataLength = stell( &stream );
+	sMemDisconnect( &stream );
 	if( cryptStatusError( status ) )
 		return( status );
+	ENSURES( hashBatchInfo[ 0 ].dataLength >= 16 && \
+			 hashBatchInfo[ 0 ].dataLength < MAX_INTLENGTH_SHORT );
 
 #if defined( USE_PGP ) || defined( USE_PGPKEYS )
 	/* If it's an RSA key, we need to calculate the PGP 2 key ID alongside 
@@ -441,32 +451,48 @@ static int calculateKeyID( INOUT CONTEXT_INFO *contextInfoPtr )
 		const PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
 		int length;
 
-		status = exportBignum( buffer, CRYPT_MAX_PKCSIZE, &length,
+		status = exportBignum( pgpBuffer, CRYPT_MAX_PKCSIZE, &length,
 							   &pkcInfo->rsaParam_n );
 		if( cryptStatusError( status ) )
 			return( status );
 		if( length > PGP_KEYID_SIZE )
 			{
 			memcpy( publicKey->pgp2KeyID, 
-					buffer + length - PGP_KEYID_SIZE, PGP_KEYID_SIZE );
+					pgpBuffer + length - PGP_KEYID_SIZE, PGP_KEYID_SIZE );
 			contextInfoPtr->ctxPKC->flags |= PKCINFO_FLAG_PGPKEYID_SET;
 			}
 		}
 
-	/* If the OpenPGP ID is already set by having the key loaded from a PGP
-	   keyset, we're done */
-	if( contextInfoPtr->ctxPKC->flags & PKCINFO_FLAG_OPENPGPKEYID_SET )
-		return( CRYPT_OK );
-
-	/* If it's a non-PGP algorithm then we can't do anything with it */
-	if( cryptAlgo != CRYPT_ALGO_RSA && cryptAlgo != CRYPT_ALGO_DSA && \
-		cryptAlgo != CRYPT_ALGO_ELGAMAL )
-		return( CRYPT_OK );
+	/* If it's a PGP algorithm and the OpenPGP ID isn't already set by 
+	   having the key loaded from a PGP keyset, write the data needed to
+	   generate it so that it can be hashed alongside the cryptlib one */
+	if( !( contextInfoPtr->ctxPKC->flags & PKCINFO_FLAG_OPENPGPKEYID_SET ) && \
+		( cryptAlgo == CRYPT_ALGO_RSA || cryptAlgo == CRYPT_ALGO_DSA || \
+		  cryptAlgo == CRYPT_ALGO_ELGAMAL ) )
+		{
+		status = writeOpenPGPKeyData( contextInfoPtr, pgpBuffer, 
+									  ( CRYPT_MAX_PKCSIZE * 4 ) + 50, 
+									  &hashBatchInfo[ 1 ].dataLength );
+		if( cryptStatusError( status ) )
+			return( status );
+		hashBatchInfo[ 1 ].data = pgpBuffer;
+		noHashes = 2;
+		}
+#endif /* USE_PGP || USE_PGPKEYS */
 
-	/* Finally, set the OpenPGP key ID */
-	status = calculateOpenPGPKeyID( contextInfoPtr, cryptAlgo );
-	if( cryptStatusError( status ) )
-		return( status );
+	/* Hash the key data to get the key ID(s) */
+	getHashBatchParameters( CRYPT_ALGO_SHA1, 0, &hashFunctionBatch, 
+							&hashSize );
+	hashFunctionBatch( hashBatchInfo, noHashes );
+	memcpy( publicKey->keyID, hashBatchInfo[ 0 ].hash, KEYID_SIZE );
+#if defined( USE_PGP ) || defined( USE_PGPKEYS )
+	if( noHashes > 1 )
+		{
+		memcpy( publicKey->openPgpKeyID, 
+				hashBatchInfo[ 1 ].hash + hashSize - PGP_KEYID_SIZE, 
+				PGP_KEYID_SIZE );
+		contextInfoPtr->ctxPKC->flags |= PKCINFO_FLAG_OPENPGPKEYID_SET;
+		}
 #endif /* USE_PGP || USE_PGPKEYS */
 
 	return( CRYPT_OK );
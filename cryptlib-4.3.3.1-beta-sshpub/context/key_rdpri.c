@@ -785,6 +785,71 @@ static int readPrivateKeyEccFunction( INOUT STREAM *stream,
 	}
 #endif /* USE_ECDH || USE_ECDSA */
 
+#ifdef USE_25519
+
+/* X25519 keys are only ever used as ephemeral keys for key agreement, so 
+   there's no private-key storage format for them.  Ed25519 keys are stored
+   as the RFC 8410 CurvePrivateKey, an OCTET STRING containing the 32-byte 
+   seed, with the public key having been read beforehand */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int readPrivateKey25519Function( INOUT STREAM *stream, 
+										INOUT CONTEXT_INFO *contextInfoPtr,
+										IN_ENUM( KEYFORMAT )  \
+											const KEYFORMAT_TYPE formatType,
+										const BOOLEAN checkRead )
+	{
+#if defined( USE_ED25519 ) && defined( USE_INT_ASN1 )
+	PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+	const CAPABILITY_INFO *capabilityInfoPtr = \
+								DATAPTR_GET( contextInfoPtr->capabilityInfo );
+	BYTE buffer[ X25519_KEYSIZE + 8 ];
+	int length, status = CRYPT_OK;
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( capabilityInfoPtr != NULL );
+	REQUIRES( contextInfoPtr->type == CONTEXT_PKC && \
+			  is25519Algo( capabilityInfoPtr->cryptAlgo ) );
+	REQUIRES( formatType > KEYFORMAT_NONE && formatType < KEYFORMAT_LAST );
+	REQUIRES( checkRead == TRUE || checkRead == FALSE );
+
+	if( capabilityInfoPtr->cryptAlgo != CRYPT_ALGO_ED25519 || \
+		formatType != KEYFORMAT_PRIVATE )
+		return( CRYPT_ERROR_NOTAVAIL );
+
+	/* Read the key components.  If this is a check read then we compare
+	   the value read against the one that was loaded into the context */
+	status = readOctetString( stream, buffer, &length, X25519_KEYSIZE, 
+							  X25519_KEYSIZE );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( checkRead )
+		{
+		if( !compareDataConstTime( buffer, pkcInfo->curve25519PrivateKey, 
+								   X25519_KEYSIZE ) )
+			status = CRYPT_ERROR_INVALID;
+		}
+	else
+		memcpy( pkcInfo->curve25519PrivateKey, buffer, X25519_KEYSIZE );
+	zeroise( buffer, X25519_KEYSIZE );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	ENSURES( sanityCheckPKCInfo( pkcInfo ) );
+
+	return( CRYPT_OK );
+#else
+	UNUSED_ARG( stream );
+	UNUSED_ARG( contextInfoPtr );
+
+	return( CRYPT_ERROR_NOTAVAIL );
+#endif /* USE_ED25519 && USE_INT_ASN1 */
+	}
+#endif /* USE_25519 */
+
 /****************************************************************************
 *																			*
 *							Context Access Routines							*
@@ -820,6 +885,13 @@ void initPrivKeyRead( INOUT CONTEXT_INFO *contextInfoPtr )
 		return;
 		}
 #endif /* USE_ECDH || USE_ECDSA */
+#ifdef USE_25519
+	if( is25519Algo( cryptAlgo ) )
+		{
+		FNPTR_SET( pkcInfo->readPrivateKeyFunction, readPrivateKey25519Function );
+		return;
+		}
+#endif /* USE_25519 */
 	FNPTR_SET( pkcInfo->readPrivateKeyFunction, readPrivateKeyRsaFunction );
 	}
 #else
@@ -347,6 +347,84 @@ static int readEccSubjectPublicKey( INOUT STREAM *stream,
 	return( CRYPT_OK );
 	}
 #endif /* USE_ECDH || USE_ECDSA */
+
+#ifdef USE_25519
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+static int read25519SubjectPublicKey( INOUT STREAM *stream, 
+									  INOUT CONTEXT_INFO *contextInfoPtr,
+									  OUT_FLAGS_Z( ACTION_PERM ) int *actionFlags )
+	{
+	PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+	const CAPABILITY_INFO *capabilityInfoPtr = \
+								DATAPTR_GET( contextInfoPtr->capabilityInfo );
+	const BYTE *oid;
+	int length, status;
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( isWritePtr( actionFlags, sizeof( int ) ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( capabilityInfoPtr != NULL );
+	REQUIRES( contextInfoPtr->type == CONTEXT_PKC && \
+			  is25519Algo( capabilityInfoPtr->cryptAlgo ) );
+
+	/* Clear return value */
+	*actionFlags = ACTION_PERM_NONE;
+
+	/* Read the SubjectPublicKeyInfo header field and the RFC 8410 
+	   AlgorithmIdentifier, which consists of a bare OID with no 
+	   parameters */
+	oid = ( capabilityInfoPtr->cryptAlgo == CRYPT_ALGO_ED25519 ) ? \
+		  OID_ED25519 : OID_X25519;
+	status = readSequence( stream, NULL );
+	if( cryptStatusOK( status ) )
+		status = readSequence( stream, &length );
+	if( cryptStatusOK( status ) && length != sizeofOID( oid ) )
+		status = CRYPT_ERROR_BADDATA;
+	if( cryptStatusOK( status ) )
+		status = readFixedOID( stream, oid, sizeofOID( oid ) );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Set the maximum permitted actions.  As with ECDH and ECDSA keys the 
+	   usage is internal-only, and if the key is a pure public key then the 
+	   actions will be restricted by higher-level code to signature-check 
+	   only */
+	if( capabilityInfoPtr->cryptAlgo == CRYPT_ALGO_ED25519 )
+		{
+		*actionFlags = MK_ACTION_PERM( MESSAGE_CTX_SIGN, \
+									   ACTION_PERM_NONE_EXTERNAL ) | \
+					   MK_ACTION_PERM( MESSAGE_CTX_SIGCHECK, \
+									   ACTION_PERM_NONE_EXTERNAL );
+		}
+	else
+		{
+		*actionFlags = MK_ACTION_PERM( MESSAGE_CTX_ENCRYPT, \
+									   ACTION_PERM_NONE_EXTERNAL ) | \
+					   MK_ACTION_PERM( MESSAGE_CTX_DECRYPT, \
+									   ACTION_PERM_NONE_EXTERNAL );
+		}
+
+	/* Read the BIT STRING encapsulation and the public value, which has a
+	   fixed size */
+	status = readBitStringHole( stream, &length, X25519_KEYSIZE, 
+								DEFAULT_TAG );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( length != X25519_KEYSIZE )
+		return( CRYPT_ERROR_BADDATA );
+	status = sread( stream, pkcInfo->curve25519PublicKey, X25519_KEYSIZE );
+	if( cryptStatusError( status ) )
+		return( status );
+	pkcInfo->keySizeBits = bytesToBits( X25519_KEYSIZE );
+
+	ENSURES( sanityCheckPKCInfo( pkcInfo ) );
+
+	return( CRYPT_OK );
+	}
+#endif /* USE_25519 */
 #endif /* USE_INT_ASN1 */
 
 /****************************************************************************
@@ -373,7 +451,13 @@ static int readEccSubjectPublicKey( INOUT STREAM *stream,
 	string		[ server key/certificate ]
 		string	"ecdsa-sha2-*"
 		string	"*"				-- The "*" portion from the above field
-		string	Q */
+		string	Q
+
+   Ed25519:
+
+	string		[ server key/certificate ]
+		string	"ssh-ed25519"
+		string	A				-- 32-byte encoded point */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
 static int readSshRsaPublicKey( INOUT STREAM *stream, 
@@ -645,6 +729,60 @@ static int readSshEccPublicKey( INOUT STREAM *stream,
 	return( CRYPT_OK );
 	}
 #endif /* USE_ECDH || USE_ECDSA */
+
+#ifdef USE_ED25519
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+static int readSshEd25519PublicKey( INOUT STREAM *stream, 
+									INOUT CONTEXT_INFO *contextInfoPtr,
+									OUT_FLAGS_Z( ACTION_PERM ) int *actionFlags )
+	{
+	PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+	const CAPABILITY_INFO *capabilityInfoPtr = \
+								DATAPTR_GET( contextInfoPtr->capabilityInfo );
+	char buffer[ 16 + 8 ];
+	int length, status;
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( isWritePtr( actionFlags, sizeof( int ) ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( capabilityInfoPtr != NULL );
+	REQUIRES( contextInfoPtr->type == CONTEXT_PKC && \
+			  capabilityInfoPtr->cryptAlgo == CRYPT_ALGO_ED25519 );
+
+	/* Clear return value */
+	*actionFlags = ACTION_PERM_NONE;
+
+	/* Read the wrapper and make sure that it's OK */
+	readUint32( stream );
+	status = readString32( stream, buffer, 11, &length );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( length != 11 || memcmp( buffer, "ssh-ed25519", 11 ) )
+		return( CRYPT_ERROR_BADDATA );
+
+	/* Set the maximum permitted actions.  SSH keys are only used internally
+	   so we restrict the usage to internal-only */
+	*actionFlags = MK_ACTION_PERM( MESSAGE_CTX_SIGCHECK, \
+								   ACTION_PERM_NONE_EXTERNAL );
+
+	/* Read the public key, which has a fixed size.  The validity of the 
+	   encoded point is checked when the key is loaded */
+	status = readString32( stream, pkcInfo->curve25519PublicKey, 
+						   X25519_KEYSIZE, &length );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( length != X25519_KEYSIZE )
+		return( CRYPT_ERROR_BADDATA );
+	pkcInfo->keySizeBits = bytesToBits( X25519_KEYSIZE );
+
+	ENSURES( sanityCheckPKCInfo( pkcInfo ) );
+
+	return( CRYPT_OK );
+	}
+#endif /* USE_ED25519 */
 #endif /* USE_SSH */
 
 /****************************************************************************
@@ -1375,6 +1513,60 @@ static int readPublicKeyEccFunction( INOUT STREAM *stream,
 	}
 #endif /* USE_ECDH || USE_ECDSA */
 
+#ifdef USE_25519
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int readPublicKey25519Function( INOUT STREAM *stream, 
+									   INOUT CONTEXT_INFO *contextInfoPtr,
+									   IN_ENUM( KEYFORMAT )  \
+										const KEYFORMAT_TYPE formatType,
+									   STDC_UNUSED const BOOLEAN checkRead )
+	{
+	const CAPABILITY_INFO *capabilityInfoPtr = \
+								DATAPTR_GET( contextInfoPtr->capabilityInfo );
+	int actionFlags, status;
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isWritePtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( capabilityInfoPtr != NULL );
+	REQUIRES( contextInfoPtr->type == CONTEXT_PKC && \
+			  is25519Algo( capabilityInfoPtr->cryptAlgo ) );
+	REQUIRES( formatType == KEYFORMAT_CERT || \
+			  ( capabilityInfoPtr->cryptAlgo == CRYPT_ALGO_ED25519 && \
+				formatType == KEYFORMAT_SSH ) );
+	REQUIRES( checkRead == TRUE || checkRead == FALSE );
+
+	/* X25519 keys are only used as ephemeral keys in SSH and TLS, where the
+	   public value is exchanged as a raw byte string, so the only encoded 
+	   form that we need to handle is the X.509 one.  Ed25519 keys can 
+	   additionally be SSH host or user keys */
+	switch( formatType )
+		{
+#ifdef USE_INT_ASN1
+		case KEYFORMAT_CERT:
+			status = read25519SubjectPublicKey( stream, contextInfoPtr, 
+												&actionFlags );
+			break;
+#endif /* USE_INT_ASN1 */
+
+#if defined( USE_SSH ) && defined( USE_ED25519 )
+		case KEYFORMAT_SSH:
+			status = readSshEd25519PublicKey( stream, contextInfoPtr, 
+											  &actionFlags );
+			break;
+#endif /* USE_SSH && USE_ED25519 */
+
+		default:
+			retIntError();
+		}
+	if( cryptStatusError( status ) )
+		return( status );
+	return( completePubkeyRead( contextInfoPtr, actionFlags ) );
+	}
+#endif /* USE_25519 */
+
 /****************************************************************************
 *																			*
 *								Read DL Values								*
@@ -1566,6 +1758,13 @@ void initPubKeyRead( INOUT CONTEXT_INFO *contextInfoPtr )
 		return;
 		}
 #endif /* USE_ECDH || USE_ECDSA */
+#ifdef USE_25519
+	if( is25519Algo( cryptAlgo ) )
+		{
+		FNPTR_SET( pkcInfo->readPublicKeyFunction, readPublicKey25519Function );
+		return;
+		}
+#endif /* USE_25519 */
 	FNPTR_SET( pkcInfo->readPublicKeyFunction, readPublicKeyRsaFunction );
 	}
 #else
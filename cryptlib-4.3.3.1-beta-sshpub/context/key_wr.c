@@ -266,6 +266,49 @@ static int writeEccSubjectPublicKey( INOUT STREAM *stream,
 	return( status );
 	}
 #endif /* USE_ECDH || USE_ECDSA */
+
+#ifdef USE_25519
+
+/* Curve25519 keys don't use the standard ECC SubjectPublicKeyInfo but a
+   special-case form from RFC 8410 in which the AlgorithmIdentifier 
+   parameters are absent and the public value is the raw little-endian 
+   u-coordinate for X25519 or the encoded point for Ed25519 */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int write25519SubjectPublicKey( INOUT STREAM *stream, 
+									   const CONTEXT_INFO *contextInfoPtr )
+	{
+	const PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+	const CAPABILITY_INFO *capabilityInfoPtr = \
+								DATAPTR_GET( contextInfoPtr->capabilityInfo );
+	const BYTE *oid;
+	int algoIDsize;
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isReadPtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( capabilityInfoPtr != NULL );
+	REQUIRES( contextInfoPtr->type == CONTEXT_PKC && \
+			  is25519Algo( capabilityInfoPtr->cryptAlgo ) );
+	REQUIRES( sanityCheckPKCInfo( pkcInfo ) );
+
+	/* The two algorithms differ only in the OID that identifies them */
+	oid = ( capabilityInfoPtr->cryptAlgo == CRYPT_ALGO_ED25519 ) ? \
+		  OID_ED25519 : OID_X25519;
+	algoIDsize = ( int ) sizeofObject( sizeofOID( oid ) );
+
+	/* Write the SubjectPublicKeyInfo header field and AlgorithmIdentifier */
+	writeSequence( stream, algoIDsize + \
+						   ( int ) sizeofObject( X25519_KEYSIZE + 1 ) );
+	writeSequence( stream, sizeofOID( oid ) );
+	writeOID( stream, oid );
+
+	/* Write the BIT STRING wrapper and the public value */
+	writeBitStringHole( stream, X25519_KEYSIZE, DEFAULT_TAG );
+	return( swrite( stream, pkcInfo->curve25519PublicKey, X25519_KEYSIZE ) );
+	}
+#endif /* USE_25519 */
 #endif /* USE_INT_ASN1 */
 
 #ifdef USE_SSH
@@ -286,7 +329,13 @@ static int writeEccSubjectPublicKey( INOUT STREAM *stream,
 	string		[ server key/certificate ]
 		string	"ecdsa-sha2-*"
 		string	"*"				-- The "*" portion from the above field
-		string	Q */
+		string	Q
+
+   Ed25519:
+
+	string		[ server key/certificate ]
+		string	"ssh-ed25519"
+		string	A				-- 32-byte encoded point */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
 static int writeSshRsaPublicKey( INOUT STREAM *stream, 
@@ -438,6 +487,33 @@ static int writeSshEccPublicKey( INOUT STREAM *stream,
 	}
 #endif /* USE_ECDH || USE_ECDSA */
 
+#ifdef USE_ED25519
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int writeSshEd25519PublicKey( INOUT STREAM *stream, 
+									 const CONTEXT_INFO *contextInfoPtr )
+	{
+	const PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+	const CAPABILITY_INFO *capabilityInfoPtr = \
+								DATAPTR_GET( contextInfoPtr->capabilityInfo );
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isReadPtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( capabilityInfoPtr != NULL );
+	REQUIRES( contextInfoPtr->type == CONTEXT_PKC && \
+			  capabilityInfoPtr->cryptAlgo == CRYPT_ALGO_ED25519 );
+	REQUIRES( sanityCheckPKCInfo( pkcInfo ) );
+
+	writeUint32( stream, sizeofString32( 11 ) + \
+						 sizeofString32( X25519_KEYSIZE ) );
+	writeString32( stream, "ssh-ed25519", 11 );
+	return( writeString32( stream, pkcInfo->curve25519PublicKey, 
+						   X25519_KEYSIZE ) );
+	}
+#endif /* USE_ED25519 */
+
 #endif /* USE_SSH */
 
 #ifdef USE_SSL
@@ -460,6 +536,12 @@ static int writeSshEccPublicKey( INOUT STREAM *stream,
 	  [	uint8		ecPointLen	-- NB uint8 not uint16 ]
 	  [	byte[]		ecPoint ]
 
+	X25519:
+		byte		curveType
+		uint16		namedCurve = 29
+	  [	uint8		publicLen	-- NB uint8 not uint16 ]
+	  [	byte[]		public ]
+
    The DH y value is nominally attached to the DH p and g values but isn't 
    processed at this level since this is a pure PKCS #3 DH key and not a 
    generic DLP key.  The same holds for the ECDH Q value */
@@ -557,6 +639,29 @@ static int writeSslEccPublicKey( INOUT STREAM *stream,
 	}
 #endif /* USE_ECDH || USE_ECDSA */
 
+#ifdef USE_25519
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int writeSsl25519PublicKey( INOUT STREAM *stream, 
+								   const CONTEXT_INFO *contextInfoPtr )
+	{
+	const CAPABILITY_INFO *capabilityInfoPtr = \
+								DATAPTR_GET( contextInfoPtr->capabilityInfo );
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isReadPtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( capabilityInfoPtr != NULL );
+	REQUIRES( contextInfoPtr->type == CONTEXT_PKC && \
+			  capabilityInfoPtr->cryptAlgo == CRYPT_ALGO_25519 );
+
+	/* X25519 is identified by a fixed NamedCurve (NamedGroup) ID */
+	sputc( stream, 0x03 );	/* NamedCurve */
+	return( writeUint16( stream, 29 ) );
+	}
+#endif /* USE_25519 */
+
 #endif /* USE_SSL */
 
 #ifdef USE_PGP
@@ -829,6 +934,65 @@ static int writePublicKeyEccFunction( INOUT STREAM *stream,
 	}
 #endif /* USE_ECDH || USE_ECDSA */
 
+#ifdef USE_25519
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+static int writePublicKey25519Function( INOUT STREAM *stream, 
+										const CONTEXT_INFO *contextInfoPtr,
+										IN_ENUM( KEYFORMAT ) \
+											const KEYFORMAT_TYPE formatType,
+										IN_BUFFER( accessKeyLen ) \
+											const char *accessKey, 
+										IN_LENGTH_FIXED( 10 ) \
+											const int accessKeyLen )
+	{
+	const CAPABILITY_INFO *capabilityInfoPtr = \
+								DATAPTR_GET( contextInfoPtr->capabilityInfo );
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isReadPtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( isReadPtrDynamic( accessKey, accessKeyLen ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( capabilityInfoPtr != NULL );
+	REQUIRES( contextInfoPtr->type == CONTEXT_PKC && \
+			  is25519Algo( capabilityInfoPtr->cryptAlgo ) );
+	REQUIRES( ( capabilityInfoPtr->cryptAlgo == CRYPT_ALGO_25519 && \
+				( formatType == KEYFORMAT_CERT || \
+				  formatType == KEYFORMAT_SSL || \
+				  formatType == KEYFORMAT_SSL_EXT ) ) || \
+			  ( capabilityInfoPtr->cryptAlgo == CRYPT_ALGO_ED25519 && \
+				( formatType == KEYFORMAT_CERT || \
+				  formatType == KEYFORMAT_SSH ) ) );
+	REQUIRES( accessKeyLen == 10 );
+
+	/* Make sure that we really intended to call this function */
+	if( accessKeyLen != 10 || memcmp( accessKey, "public_key", 10 ) )
+		retIntError();
+
+	switch( formatType )
+		{
+#ifdef USE_INT_ASN1
+		case KEYFORMAT_CERT:
+			return( write25519SubjectPublicKey( stream, contextInfoPtr ) );
+#endif /* USE_INT_ASN1 */
+
+#ifdef USE_SSL
+		case KEYFORMAT_SSL:
+		case KEYFORMAT_SSL_EXT:
+			return( writeSsl25519PublicKey( stream, contextInfoPtr ) );
+#endif /* USE_SSL */
+
+#if defined( USE_SSH ) && defined( USE_ED25519 )
+		case KEYFORMAT_SSH:
+			return( writeSshEd25519PublicKey( stream, contextInfoPtr ) );
+#endif /* USE_SSH && USE_ED25519 */
+		}
+
+	retIntError();
+	}
+#endif /* USE_25519 */
+
 /****************************************************************************
 *																			*
 *								Write Private Keys							*
@@ -1426,6 +1590,60 @@ static int writePrivateKeyNullFunction( INOUT STREAM *stream,
 	}
 #endif /* USE_INT_ASN1 */
 
+#ifdef USE_25519
+
+/* X25519 keys are only ever used as ephemeral keys for key agreement, so 
+   there's no private-key storage format for them.  Ed25519 keys are 
+   long-term signing keys and are stored as the RFC 8410 CurvePrivateKey,
+   an OCTET STRING containing the 32-byte seed */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+static int writePrivateKey25519Function( INOUT STREAM *stream, 
+										 const CONTEXT_INFO *contextInfoPtr,
+										 IN_ENUM( KEYFORMAT ) \
+											const KEYFORMAT_TYPE formatType,
+										 IN_BUFFER( accessKeyLen ) \
+											const char *accessKey, 
+										 IN_LENGTH_FIXED( 11 ) \
+											const int accessKeyLen )
+	{
+#if defined( USE_ED25519 ) && defined( USE_INT_ASN1 )
+	const PKC_INFO *pkcInfo = contextInfoPtr->ctxPKC;
+	const CAPABILITY_INFO *capabilityInfoPtr = \
+								DATAPTR_GET( contextInfoPtr->capabilityInfo );
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isReadPtr( contextInfoPtr, sizeof( CONTEXT_INFO ) ) );
+	assert( isReadPtrDynamic( accessKey, accessKeyLen ) );
+
+	REQUIRES( sanityCheckContext( contextInfoPtr ) );
+	REQUIRES( capabilityInfoPtr != NULL );
+	REQUIRES( contextInfoPtr->type == CONTEXT_PKC && \
+			  is25519Algo( capabilityInfoPtr->cryptAlgo ) );
+	REQUIRES( formatType > KEYFORMAT_NONE && formatType < KEYFORMAT_LAST );
+	REQUIRES( accessKeyLen == 11 );
+
+	if( capabilityInfoPtr->cryptAlgo != CRYPT_ALGO_ED25519 )
+		return( CRYPT_ERROR_NOTAVAIL );
+
+	/* Make sure that we really intended to call this function */
+	if( accessKeyLen != 11 || memcmp( accessKey, "private_key", 11 ) || \
+		formatType != KEYFORMAT_PRIVATE )
+		retIntError();
+
+	/* Write the key components */
+	return( writeOctetString( stream, pkcInfo->curve25519PrivateKey, 
+							  X25519_KEYSIZE, DEFAULT_TAG ) );
+#else
+	UNUSED_ARG( stream );
+	UNUSED_ARG( contextInfoPtr );
+	UNUSED_ARG( accessKey );
+
+	return( CRYPT_ERROR_NOTAVAIL );
+#endif /* USE_ED25519 && USE_INT_ASN1 */
+	}
+#endif /* USE_25519 */
+
 STDC_NONNULL_ARG( ( 1 ) ) \
 void initKeyWrite( INOUT CONTEXT_INFO *contextInfoPtr )
 	{
@@ -1469,6 +1687,15 @@ void initKeyWrite( INOUT CONTEXT_INFO *contextInfoPtr )
 		return;
 		}
 #endif /* USE_ECDH || USE_ECDSA */
+#ifdef USE_25519
+	if( is25519Algo( cryptAlgo ) )
+		{
+		FNPTR_SET( pkcInfo->writePublicKeyFunction, writePublicKey25519Function );
+		FNPTR_SET( pkcInfo->writePrivateKeyFunction, writePrivateKey25519Function );
+
+		return;
+		}
+#endif /* USE_25519 */
 	FNPTR_SET( pkcInfo->writePublicKeyFunction, writePublicKeyRsaFunction );
 #ifdef USE_INT_ASN1
 	FNPTR_SET( pkcInfo->writePrivateKeyFunction, writePrivateKeyRsaFunction );
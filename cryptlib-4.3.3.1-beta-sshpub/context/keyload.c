@@ -120,6 +120,12 @@ int initGenericParams(INOUT CONTEXT_INFO *contextInfoPtr,
 			FNPTR_SET(contextInfoPtr->decryptFunction,
 				capabilityInfoPtr->decryptGCMFunction);
 			break;
+		case CRYPT_MODE_CTR:
+			FNPTR_SET(contextInfoPtr->encryptFunction,
+				capabilityInfoPtr->encryptCTRFunction);
+			FNPTR_SET(contextInfoPtr->decryptFunction,
+				capabilityInfoPtr->decryptCTRFunction);
+			break;
 		default:
 			retIntError();
 		}
@@ -504,6 +504,312 @@ cleanup:
 	return( status );
 	}
 
+/****************************************************************************
+*																			*
+*							Fixed-base Exponentiation						*
+*																			*
+****************************************************************************/
+
+#if defined( USE_SSH ) || defined( USE_SSL )
+
+/* The built-in DH domain parameters have a fixed p and g, so the g^x mod p
+   that dominates DH key generation always uses the same base.  For these 
+   we use a Lim-Lee comb, arranging the exponent bits into DH_COMB_TEETH 
+   rows of combWidth bits each and precomputing all 2^DH_COMB_TEETH 
+   products of g^( 2^( row * combWidth ) ).  g^x then needs only combWidth 
+   squarings and multiplications rather than the bits( x ) squarings and 
+   bits( x ) / window multiplications of a general exponentiation.  Table 
+   entries are read by scanning the whole table and selecting the required 
+   one with a mask, so that the memory access pattern doesn't depend on x.
+
+   Since the tables depend only on the public p and g, they're built the 
+   first time that each set of domain parameters is used and then shared 
+   across all contexts */
+
+#define DH_COMB_TEETH		6
+#define DH_COMB_SIZE		( 1 << DH_COMB_TEETH )
+#define DH_COMB_MAXWORDS	( bitsToBytes( 3072 ) / BN_BYTES )
+#define DH_COMB_NOTABLES	4
+
+typedef struct {
+	const DH_DOMAINPARAMS *domainParams;	/* Params that table is for */
+	int combWidth, noWords;					/* Comb width, entry size */
+	int checksum;							/* Table checksum */
+	BN_ULONG table[ DH_COMB_SIZE * DH_COMB_MAXWORDS ];
+	} DH_COMB_INFO;
+
+static DH_COMB_INFO dhCombInfo[ DH_COMB_NOTABLES ];
+
+/* Read and write a table entry.  The read scans every entry in the table 
+   to avoid data-dependent memory accesses */
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static void putCombEntry( INOUT DH_COMB_INFO *combInfo, 
+						  const BIGNUM *value,
+						  IN_RANGE( 0, DH_COMB_SIZE - 1 ) const int index )
+	{
+	BN_ULONG *entry = combInfo->table + ( index * combInfo->noWords );
+	int i, LOOP_ITERATOR;
+
+	assert( isWritePtr( combInfo, sizeof( DH_COMB_INFO ) ) );
+	assert( isReadPtr( value, sizeof( BIGNUM ) ) );
+
+	REQUIRES_V( index >= 0 && index < DH_COMB_SIZE );
+	REQUIRES_V( value->top <= combInfo->noWords );
+
+	LOOP_EXT( i = 0, i < combInfo->noWords, i++, DH_COMB_MAXWORDS + 1 )
+		entry[ i ] = ( i < value->top ) ? value->d[ i ] : 0;
+	ENSURES_V( LOOP_BOUND_OK );
+	}
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static void getCombEntry( OUT BIGNUM *value,
+						  const DH_COMB_INFO *combInfo, 
+						  IN_RANGE( 0, DH_COMB_SIZE - 1 ) const int index )
+	{
+	const int noWords = combInfo->noWords;
+	int entryIndex, i, LOOP_ITERATOR;
+
+	assert( isWritePtr( value, sizeof( BIGNUM ) ) );
+	assert( isReadPtr( combInfo, sizeof( DH_COMB_INFO ) ) );
+
+	REQUIRES_V( index >= 0 && index < DH_COMB_SIZE );
+
+	LOOP_EXT( i = 0, i < noWords, i++, DH_COMB_MAXWORDS + 1 )
+		value->d[ i ] = 0;
+	ENSURES_V( LOOP_BOUND_OK );
+	LOOP_EXT( entryIndex = 0, entryIndex < DH_COMB_SIZE, entryIndex++,
+			  DH_COMB_SIZE + 1 )
+		{
+		const BN_ULONG *entry = combInfo->table + ( entryIndex * noWords );
+		const unsigned int diff = ( unsigned int ) ( entryIndex ^ index );
+		const BN_ULONG mask = ( BN_ULONG ) 0 - \
+							  ( BN_ULONG ) ( ( diff - 1 ) >> \
+											 ( ( sizeof( int ) * 8 ) - 1 ) );
+		int LOOP_ITERATOR_ALT;
+
+		LOOP_EXT_ALT( i = 0, i < noWords, i++, DH_COMB_MAXWORDS + 1 )
+			value->d[ i ] |= entry[ i ] & mask;
+		ENSURES_V( LOOP_BOUND_OK_ALT );
+		}
+	ENSURES_V( LOOP_BOUND_OK );
+	value->top = noWords;
+	value->neg = FALSE;
+	BN_normalise( value );
+	}
+
+/* Build the comb table for a set of domain parameters:
+
+	table[ i ] = prod( g^( 2^( row * combWidth ) ) ) for each bit row in i
+
+   in Montgomery form, built a row at a time by multiplying the entries for 
+   the previous rows by the base value for the current row */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+static int buildCombTable( INOUT DH_COMB_INFO *combInfo, 
+						   const DH_DOMAINPARAMS *domainParams,
+						   INOUT PKC_INFO *pkcInfo )
+	{
+	const BIGNUM *p = &domainParams->p;
+	BIGNUM *value = &pkcInfo->tmp1, *rowBase = &pkcInfo->tmp2;
+	const int expSize = getDLPexpSize( BN_num_bits( p ) );
+	int row, bnStatus = BN_STATUS, LOOP_ITERATOR;
+
+	assert( isWritePtr( combInfo, sizeof( DH_COMB_INFO ) ) );
+	assert( isReadPtr( domainParams, sizeof( DH_DOMAINPARAMS ) ) );
+	assert( isWritePtr( pkcInfo, sizeof( PKC_INFO ) ) );
+
+	REQUIRES( p->top > 0 && p->top <= DH_COMB_MAXWORDS );
+	REQUIRES( expSize >= 160 && expSize < 1000 );
+
+	memset( combInfo, 0, sizeof( DH_COMB_INFO ) );
+	combInfo->combWidth = ( expSize + DH_COMB_TEETH - 1 ) / DH_COMB_TEETH;
+	combInfo->noWords = p->top;
+
+	/* table[ 0 ] = 1, and the base for the first row is g */
+	CK( BN_to_montgomery( value, BN_value_one(), &pkcInfo->dlpParam_mont_p,
+						  &pkcInfo->bnCTX ) );
+	CK( BN_to_montgomery( rowBase, &domainParams->g, 
+						  &pkcInfo->dlpParam_mont_p, &pkcInfo->bnCTX ) );
+	if( bnStatusError( bnStatus ) )
+		return( getBnStatus( bnStatus ) );
+	putCombEntry( combInfo, value, 0 );
+
+	LOOP_SMALL( row = 0, row < DH_COMB_TEETH, row++ )
+		{
+		const int rowStart = 1 << row;
+		int i, LOOP_ITERATOR_ALT;
+
+		/* Move the base up to g^( 2^( row * combWidth ) ) */
+		if( row > 0 )
+			{
+			LOOP_MAX_ALT( i = 0, i < combInfo->combWidth, i++ )
+				{
+				CK( BN_mod_mul_montgomery( rowBase, rowBase, rowBase, 
+										   &pkcInfo->dlpParam_mont_p,
+										   &pkcInfo->bnCTX ) );
+				}
+			ENSURES( LOOP_BOUND_OK_ALT );
+			}
+
+		/* table[ rowStart + i ] = table[ i ] * rowBase */
+		LOOP_EXT_ALT( i = 0, i < rowStart, i++, DH_COMB_SIZE + 1 )
+			{
+			getCombEntry( value, combInfo, i );
+			CK( BN_mod_mul_montgomery( value, value, rowBase, 
+									   &pkcInfo->dlpParam_mont_p,
+									   &pkcInfo->bnCTX ) );
+			if( bnStatusError( bnStatus ) )
+				break;
+			putCombEntry( combInfo, value, rowStart + i );
+			}
+		ENSURES( LOOP_BOUND_OK_ALT );
+		if( bnStatusError( bnStatus ) )
+			return( getBnStatus( bnStatus ) );
+		}
+	ENSURES( LOOP_BOUND_OK );
+	BN_clear( value );
+	BN_clear( rowBase );
+
+	/* Remember the table checksum so that we can detect corruption before 
+	   it's used */
+	combInfo->checksum = checksumData( combInfo->table, 
+									   DH_COMB_SIZE * combInfo->noWords * \
+										sizeof( BN_ULONG ) );
+	combInfo->domainParams = domainParams;
+
+	return( CRYPT_OK );
+	}
+
+/* Find the comb table for the context's domain parameters, building it if 
+   necessary.  If there's no table available then we return a NULL 
+   pointer and the caller falls back to a standard exponentiation */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int getCombTable( INOUT PKC_INFO *pkcInfo,
+						 OUT_PTR_OPT const DH_COMB_INFO **combInfoPtr )
+	{
+	const DH_DOMAINPARAMS *domainParams = pkcInfo->domainParams;
+	DH_COMB_INFO *combInfo = NULL;
+	int i, status, LOOP_ITERATOR;
+
+	assert( isWritePtr( pkcInfo, sizeof( PKC_INFO ) ) );
+	assert( isWritePtr( combInfoPtr, sizeof( DH_COMB_INFO * ) ) );
+
+	/* Clear return value */
+	*combInfoPtr = NULL;
+
+	if( domainParams == NULL || domainParams->p.top > DH_COMB_MAXWORDS )
+		return( CRYPT_OK );
+
+	status = krnlEnterMutex( MUTEX_DHTABLES );
+	if( cryptStatusError( status ) )
+		return( status );
+	LOOP_SMALL( i = 0, i < DH_COMB_NOTABLES, i++ )
+		{
+		if( dhCombInfo[ i ].domainParams == domainParams )
+			{
+			combInfo = &dhCombInfo[ i ];
+			break;
+			}
+		if( dhCombInfo[ i ].domainParams == NULL )
+			{
+			status = buildCombTable( &dhCombInfo[ i ], domainParams, 
+									 pkcInfo );
+			if( cryptStatusOK( status ) )
+				combInfo = &dhCombInfo[ i ];
+			break;
+			}
+		}
+	krnlExitMutex( MUTEX_DHTABLES );
+	ENSURES( LOOP_BOUND_OK );
+	if( cryptStatusError( status ) || combInfo == NULL )
+		return( status );
+
+	/* Make sure that the table hasn't been corrupted */
+	if( combInfo->checksum != \
+			checksumData( combInfo->table, 
+						  DH_COMB_SIZE * combInfo->noWords * \
+							sizeof( BN_ULONG ) ) )
+		{
+		DEBUG_DIAG(( "Fixed-base DH table has been corrupted" ));
+		retIntError();
+		}
+	*combInfoPtr = combInfo;
+
+	return( CRYPT_OK );
+	}
+#endif /* USE_SSH || USE_SSL */
+
+/* Calculate g^x mod p, using the fixed-base comb for built-in domain 
+   parameters if possible */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int calculateGx( INOUT PKC_INFO *pkcInfo, OUT BIGNUM *result )
+	{
+	const DH_DOMAINPARAMS *domainParams = pkcInfo->domainParams;
+	const BIGNUM *p = ( domainParams != NULL ) ? \
+					  &domainParams->p : &pkcInfo->dlpParam_p;
+	const BIGNUM *g = ( domainParams != NULL ) ? \
+					  &domainParams->g : &pkcInfo->dlpParam_g;
+	const BIGNUM *x = &pkcInfo->dlpParam_x;
+#if defined( USE_SSH ) || defined( USE_SSL )
+	const DH_COMB_INFO *combInfo;
+	BIGNUM *r = &pkcInfo->tmp2, *entry = &pkcInfo->tmp3;
+	int column, status, LOOP_ITERATOR;
+#endif /* USE_SSH || USE_SSL */
+	int bnStatus = BN_STATUS;
+
+	assert( isWritePtr( pkcInfo, sizeof( PKC_INFO ) ) );
+	assert( isWritePtr( result, sizeof( BIGNUM ) ) );
+
+	REQUIRES( result != &pkcInfo->tmp2 && result != &pkcInfo->tmp3 );
+
+#if defined( USE_SSH ) || defined( USE_SSL )
+	status = getCombTable( pkcInfo, &combInfo );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( combInfo != NULL && \
+		BN_num_bits( x ) <= combInfo->combWidth * DH_COMB_TEETH )
+		{
+		const int combWidth = combInfo->combWidth;
+
+		/* Walk down the comb columns, squaring the accumulated value and 
+		   multiplying in the table entry selected by the exponent bits in
+		   each column */
+		getCombEntry( r, combInfo, 0 );
+		LOOP_MAX( column = combWidth - 1, column >= 0, column-- )
+			{
+			int index = 0, row, LOOP_ITERATOR_ALT;
+
+			CK( BN_mod_mul_montgomery( r, r, r, &pkcInfo->dlpParam_mont_p,
+									   &pkcInfo->bnCTX ) );
+			LOOP_SMALL_ALT( row = 0, row < DH_COMB_TEETH, row++ )
+				{
+				index |= ( BN_is_bit_set( x, ( row * combWidth ) + column ) ? \
+						   1 : 0 ) << row;
+				}
+			ENSURES( LOOP_BOUND_OK_ALT );
+			getCombEntry( entry, combInfo, index );
+			CK( BN_mod_mul_montgomery( r, r, entry, 
+									   &pkcInfo->dlpParam_mont_p,
+									   &pkcInfo->bnCTX ) );
+			}
+		ENSURES( LOOP_BOUND_OK );
+		CK( BN_from_montgomery( result, r, &pkcInfo->dlpParam_mont_p,
+								&pkcInfo->bnCTX ) );
+		BN_clear( r );
+		BN_clear( entry );
+
+		return( getBnStatus( bnStatus ) );
+		}
+#endif /* USE_SSH || USE_SSL */
+
+	CK( BN_mod_exp_mont( result, g, x, p, &pkcInfo->bnCTX, 
+						 &pkcInfo->dlpParam_mont_p ) );
+	return( getBnStatus( bnStatus ) );
+	}
+
 /* Generate the DLP private value x and public value y */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
@@ -577,22 +883,15 @@ static int generateDLPPrivateValue( INOUT PKC_INFO *pkcInfo )
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
 static int generateDLPPublicValue( INOUT PKC_INFO *pkcInfo )
 	{
-	const DH_DOMAINPARAMS *domainParams = pkcInfo->domainParams;
-	const BIGNUM *p = ( domainParams != NULL ) ? \
-					  &domainParams->p : &pkcInfo->dlpParam_p;
-	const BIGNUM *g = ( domainParams != NULL ) ? \
-					  &domainParams->g : &pkcInfo->dlpParam_g;
-	BIGNUM *x = &pkcInfo->dlpParam_x, *y = &pkcInfo->dlpParam_y; 
-	int bnStatus = BN_STATUS;
+	int status;
 
 	assert( isWritePtr( pkcInfo, sizeof( PKC_INFO ) ) );
 
 	REQUIRES( sanityCheckPKCInfo( pkcInfo ) );
 
-	CK( BN_mod_exp_mont( y, g, x, p, &pkcInfo->bnCTX, 
-						 &pkcInfo->dlpParam_mont_p ) );
-	if( bnStatusError( bnStatus ) )
-		return( getBnStatus( bnStatus ) );
+	status = calculateGx( pkcInfo, &pkcInfo->dlpParam_y );
+	if( cryptStatusError( status ) )
+		return( status );
 
 	ENSURES( sanityCheckPKCInfo( pkcInfo ) );
 
@@ -840,14 +1139,9 @@ static int checkDLPPublicKey( INOUT PKC_INFO *pkcInfo,
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
 static int checkDLPPrivateKey( INOUT PKC_INFO *pkcInfo )
 	{
-	const DH_DOMAINPARAMS *domainParams = pkcInfo->domainParams;
-	const BIGNUM *p = ( domainParams != NULL ) ? \
-					  &domainParams->p : &pkcInfo->dlpParam_p;
-	const BIGNUM *g = ( domainParams != NULL ) ? \
-					  &domainParams->g : &pkcInfo->dlpParam_g;
 	BIGNUM *x = &pkcInfo->dlpParam_x, *y = &pkcInfo->dlpParam_y;
 	BIGNUM *tmp = &pkcInfo->tmp1;
-	int bnStatus = BN_STATUS, length;
+	int length;
 
 	assert( isWritePtr( pkcInfo, sizeof( PKC_INFO ) ) );
 
@@ -860,9 +1154,7 @@ static int checkDLPPrivateKey( INOUT PKC_INFO *pkcInfo )
 
 	/* Verify that g^x mod p == y */
 #ifndef CONFIG_FUZZ
-	CK( BN_mod_exp_mont( tmp, g, x, p, &pkcInfo->bnCTX,
-						 &pkcInfo->dlpParam_mont_p ) );
-	if( bnStatusError( bnStatus ) )
+	if( cryptStatusError( calculateGx( pkcInfo, tmp ) ) )
 		return( CRYPT_ARGERROR_STR1 );
 	if( BN_cmp( tmp, y ) )
 		return( CRYPT_ARGERROR_STR1 );
@@ -548,7 +548,8 @@ typedef struct {
 
 #define needsIV( mode )	( ( mode ) == CRYPT_MODE_CBC || \
 						  ( mode ) == CRYPT_MODE_CFB || \
-						  ( mode ) == CRYPT_MODE_GCM )
+						  ( mode ) == CRYPT_MODE_GCM || \
+						  ( mode ) == CRYPT_MODE_CTR )
 
 /* A macro to check whether an algorithm is a pure stream cipher (that is,
    a real stream cipher rather than just a block cipher run in a stream
@@ -556,6 +557,14 @@ typedef struct {
 
 #define isStreamCipher( algorithm )		( ( algorithm ) == CRYPT_ALGO_RC4 )
 
+/* A macro to check whether an algorithm is a stream cipher that takes a 
+   nonce, which is loaded as an IV of a size unrelated to the block size, 
+   and that provides an AEAD mode via the AAD and ICV attributes in the 
+   same way as GCM */
+
+#define isNonceStreamCipher( algorithm ) ( ( algorithm ) == CRYPT_ALGO_CHACHA20 )
+#define NONCE_STREAM_IVSIZE		12
+
 /* A macro to check whether an algorithm is regarded as being (relatively)
    insecure or not.  This is used by some of the higher-level internal
    routines that normally use the default algorithm set in the configuration
@@ -601,20 +610,25 @@ typedef struct {
    used in various places to distinguish DLP-based PKCs from non-DLP-based
    PKCs, while ECDLP-based-PKCs are in a separate class.  This means that
    when checking for the extended class { DLP | ECDLP } it's necessary to
-   explicitly include isEccAlgo() alongside isDlpAlgo() */
+   explicitly include isEccAlgo() alongside isDlpAlgo().  In the same vein
+   the Curve25519 algorithms are kept separate from isEccAlgo() since they 
+   don't use the generic bignum-based ECC code and key formats */
 
 #define isSigAlgo( algorithm ) \
 	( ( algorithm ) == CRYPT_ALGO_RSA || ( algorithm ) == CRYPT_ALGO_DSA || \
-	  ( algorithm ) == CRYPT_ALGO_ECDSA )
+	  ( algorithm ) == CRYPT_ALGO_ECDSA || ( algorithm ) == CRYPT_ALGO_ED25519 )
 #define isCryptAlgo( algorithm ) \
 	( ( algorithm ) == CRYPT_ALGO_RSA || ( algorithm ) == CRYPT_ALGO_ELGAMAL )
 #define isKeyxAlgo( algorithm ) \
-	( ( algorithm ) == CRYPT_ALGO_DH || ( algorithm ) == CRYPT_ALGO_ECDH )
+	( ( algorithm ) == CRYPT_ALGO_DH || ( algorithm ) == CRYPT_ALGO_ECDH || \
+	  ( algorithm ) == CRYPT_ALGO_25519 )
 #define isDlpAlgo( algorithm ) \
 	( ( algorithm ) == CRYPT_ALGO_DSA || ( algorithm ) == CRYPT_ALGO_ELGAMAL || \
 	  ( algorithm ) == CRYPT_ALGO_DH )
 #define isEccAlgo( algorithm ) \
 	( ( algorithm ) == CRYPT_ALGO_ECDSA || ( algorithm ) == CRYPT_ALGO_ECDH )
+#define is25519Algo( algorithm ) \
+	( ( algorithm ) == CRYPT_ALGO_25519 || ( algorithm ) == CRYPT_ALGO_ED25519 )
 
 /* Macros to check whether an algorithm has additional parameters that need 
    to be handled explicitly */
@@ -36,6 +36,13 @@ Issue Date: 20/12/2007
 #else
   #include "crypt/aesopt.h"
 #endif /* Compiler-specific includes */
+#if defined( USE_INTEL_AES_IF_PRESENT )
+  #if defined( INC_ALL )	/* pcg */
+	#include "aes_ni.h"
+  #else
+	#include "crypt/aes_ni.h"
+  #endif /* Compiler-specific includes */
+#endif /* USE_INTEL_AES_IF_PRESENT */
 
 #if defined( AES_MODES )
 #if defined(__cplusplus)
@@ -190,6 +197,11 @@ AES_RETURN aes_ecb_encrypt(const unsigned char *ibuf, unsigned char *obuf,
 
 #endif
 
+#if defined( USE_INTEL_AES_IF_PRESENT )
+    if(aes_ni_ecb_encrypt(ibuf, obuf, nb, ctx) == EXIT_SUCCESS)
+        return EXIT_SUCCESS;
+#endif
+
 #if !defined( ASSUME_VIA_ACE_PRESENT )
     while(nb--)
     {
@@ -252,6 +264,11 @@ AES_RETURN aes_ecb_decrypt(const unsigned char *ibuf, unsigned char *obuf,
 
 #endif
 
+#if defined( USE_INTEL_AES_IF_PRESENT )
+    if(aes_ni_ecb_decrypt(ibuf, obuf, nb, ctx) == EXIT_SUCCESS)
+        return EXIT_SUCCESS;
+#endif
+
 #if !defined( ASSUME_VIA_ACE_PRESENT )
     while(nb--)
     {
@@ -421,6 +438,11 @@ AES_RETURN aes_cbc_decrypt(const unsigned char *ibuf, unsigned char *obuf,
     }
 #endif
 
+#if defined( USE_INTEL_AES_IF_PRESENT )
+    if(aes_ni_cbc_decrypt(ibuf, obuf, nb, iv, ctx) == EXIT_SUCCESS)
+        return EXIT_SUCCESS;
+#endif
+
 #if !defined( ASSUME_VIA_ACE_PRESENT )
 # ifdef FAST_BUFFER_OPERATIONS
     if(!ALIGN_OFFSET( obuf, 4 ) && !ALIGN_OFFSET( iv, 4 ))
@@ -658,6 +680,15 @@ AES_RETURN aes_cfb_decrypt(const unsigned char *ibuf, unsigned char *obuf,
                 memcpy(iv, ivp, AES_BLOCK_SIZE);
         }
 #else
+# if defined( USE_INTEL_AES_IF_PRESENT )
+        if(aes_ni_cfb_decrypt(ibuf, obuf, nb, iv, ctx) == EXIT_SUCCESS)
+        {
+            ibuf += nb * AES_BLOCK_SIZE;
+            obuf += nb * AES_BLOCK_SIZE;
+            cnt  += nb * AES_BLOCK_SIZE;
+        }
+        else
+# endif
 # ifdef FAST_BUFFER_OPERATIONS
         if(!ALIGN_OFFSET( ibuf, 4 ) && !ALIGN_OFFSET( obuf, 4 ) &&!ALIGN_OFFSET( iv, 4 ))
             while(cnt + AES_BLOCK_SIZE <= len)
@@ -896,6 +927,16 @@ AES_RETURN aes_ctr_crypt(const unsigned char *ibuf, unsigned char *obuf,
         if(blen & (AES_BLOCK_SIZE - 1))
             memcpy(ip, cbuf, AES_BLOCK_SIZE), i++;
 
+#if defined( USE_INTEL_AES_IF_PRESENT )
+        if(!(blen & (AES_BLOCK_SIZE - 1)) &&
+           aes_ni_ctr_xor(ibuf, obuf, i, buf, ctx) == EXIT_SUCCESS)
+        {
+            ibuf += blen;
+            obuf += blen;
+            continue;
+        }
+#endif
+
 #if defined( USE_VIA_ACE_IF_PRESENT )
         if(ctx->inf.b[1] == 0xff)
         {
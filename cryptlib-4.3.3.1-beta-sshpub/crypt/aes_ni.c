@@ -27,48 +27,28 @@ Issue Date: 09/09/2014
 #if defined(_MSC_VER)
 
 #include <intrin.h>
-#pragma intrinsic(__cpuid)
 #define INLINE  __inline
 
-INLINE int has_aes_ni( void )	/* pcg */
-{
-	static int test = -1;
-	if(test < 0)
-	{
-        int cpu_info[4];
-        __cpuid(cpu_info, 1);
-		test = cpu_info[2] & 0x02000000;
-	}
-	return test;
-}
-
 #elif defined( __GNUC__ )
 
-#include <cpuid.h>
 #pragma GCC target ("ssse3")
 #pragma GCC target ("sse4.1")
 #pragma GCC target ("aes")
 #include <x86intrin.h>
 #define INLINE  static __inline
 
-INLINE int has_aes_ni( void )	/* pcg */
-{
-    static int test = -1;
-    if(test < 0)
-    {
-        unsigned int a, b, c, d;
-        if(!__get_cpuid(1, &a, &b, &c, &d))
-            test = 0;
-        else
-            test = (c & 0x2000000);
-    }
-    return test;
-}
-
 #else
 #error AES New Instructions require Microsoft, Intel, GNU C, or CLANG
 #endif
 
+/* The CPU capabilities are determined when cryptlib starts up, see 
+   getHWInfo() in misc/os_spec.c - pcg */
+
+INLINE int has_aes_ni( void )	/* pcg */
+{
+	return getSysVar( SYSVAR_HWCAP ) & HWCAP_FLAG_AES;
+}
+
 INLINE __m128i aes_128_assist(__m128i t1, __m128i t2)
 {
 	__m128i t3;
@@ -444,6 +424,290 @@ AES_RETURN aes_ni(decrypt)(const unsigned char *in, unsigned char *out, const ae
 	return EXIT_SUCCESS;
 }
 
+/* Multi-block kernels for the modes in which blocks can be processed 
+   independently (ECB, CBC decrypt, CFB decrypt, and CTR).  The 
+   single-block functions above leave the AES unit mostly idle since each 
+   aesenc/aesdec has to wait for the result of the previous one, so these 
+   push eight independent blocks through each round to hide the latency, 
+   with a single-block loop to handle any remainder.  They return 
+   EXIT_FAILURE if AES-NI isn't available, in which case the caller falls 
+   back to the per-block code - pcg */
+
+#define NI_BLOCKS	8
+
+#define round8( op, b, k ) \
+	b[ 0 ] = op( b[ 0 ], k ); b[ 1 ] = op( b[ 1 ], k ); \
+	b[ 2 ] = op( b[ 2 ], k ); b[ 3 ] = op( b[ 3 ], k ); \
+	b[ 4 ] = op( b[ 4 ], k ); b[ 5 ] = op( b[ 5 ], k ); \
+	b[ 6 ] = op( b[ 6 ], k ); b[ 7 ] = op( b[ 7 ], k )
+
+INLINE int ni_rounds(const uint8_t inf0)
+{
+	if(inf0 != 10 * 16 && inf0 != 12 * 16 && inf0 != 14 * 16)
+		return 0;
+	return inf0 >> 4;
+}
+
+INLINE void enc8(__m128i b[NI_BLOCKS], const __m128i *key, const int nr)
+{
+	__m128i k = key[0];
+	int i;
+
+	round8( _mm_xor_si128, b, k );
+	for(i = 1; i < nr; ++i)
+	{
+		k = key[i];
+		round8( _mm_aesenc_si128, b, k );
+	}
+	k = key[nr];
+	round8( _mm_aesenclast_si128, b, k );
+}
+
+INLINE void dec8(__m128i b[NI_BLOCKS], const __m128i *key, const int nr)
+{
+	__m128i k = key[nr];
+	int i;
+
+	round8( _mm_xor_si128, b, k );
+	for(i = nr - 1; i > 0; --i)
+	{
+		k = key[i];
+		round8( _mm_aesdec_si128, b, k );
+	}
+	k = key[0];
+	round8( _mm_aesdeclast_si128, b, k );
+}
+
+INLINE __m128i enc1(__m128i t, const __m128i *key, const int nr)
+{
+	int i;
+
+	t = _mm_xor_si128(t, key[0]);
+	for(i = 1; i < nr; ++i)
+		t = _mm_aesenc_si128(t, key[i]);
+	return _mm_aesenclast_si128(t, key[nr]);
+}
+
+INLINE __m128i dec1(__m128i t, const __m128i *key, const int nr)
+{
+	int i;
+
+	t = _mm_xor_si128(t, key[nr]);
+	for(i = nr - 1; i > 0; --i)
+		t = _mm_aesdec_si128(t, key[i]);
+	return _mm_aesdeclast_si128(t, key[0]);
+}
+
+#define load8( b, in ) \
+	b[ 0 ] = _mm_loadu_si128((__m128i*)in + 0); \
+	b[ 1 ] = _mm_loadu_si128((__m128i*)in + 1); \
+	b[ 2 ] = _mm_loadu_si128((__m128i*)in + 2); \
+	b[ 3 ] = _mm_loadu_si128((__m128i*)in + 3); \
+	b[ 4 ] = _mm_loadu_si128((__m128i*)in + 4); \
+	b[ 5 ] = _mm_loadu_si128((__m128i*)in + 5); \
+	b[ 6 ] = _mm_loadu_si128((__m128i*)in + 6); \
+	b[ 7 ] = _mm_loadu_si128((__m128i*)in + 7)
+
+#define store8( out, b ) \
+	_mm_storeu_si128((__m128i*)out + 0, b[ 0 ]); \
+	_mm_storeu_si128((__m128i*)out + 1, b[ 1 ]); \
+	_mm_storeu_si128((__m128i*)out + 2, b[ 2 ]); \
+	_mm_storeu_si128((__m128i*)out + 3, b[ 3 ]); \
+	_mm_storeu_si128((__m128i*)out + 4, b[ 4 ]); \
+	_mm_storeu_si128((__m128i*)out + 5, b[ 5 ]); \
+	_mm_storeu_si128((__m128i*)out + 6, b[ 6 ]); \
+	_mm_storeu_si128((__m128i*)out + 7, b[ 7 ])
+
+AES_RETURN aes_ni_ecb_encrypt(const unsigned char *in, unsigned char *out, int nb, const aes_encrypt_ctx cx[1])
+{
+	const __m128i *key = (const __m128i*)cx->ks;
+	const int nr = ni_rounds(cx->inf.b[0]);
+	__m128i b[NI_BLOCKS];
+
+	if(!nr || !has_aes_ni())
+		return EXIT_FAILURE;
+
+	for( ; nb >= NI_BLOCKS; nb -= NI_BLOCKS)
+	{
+		load8( b, in );
+		enc8(b, key, nr);
+		store8( out, b );
+		in += NI_BLOCKS * AES_BLOCK_SIZE;
+		out += NI_BLOCKS * AES_BLOCK_SIZE;
+	}
+	for( ; nb > 0; --nb)
+	{
+		b[0] = enc1(_mm_loadu_si128((__m128i*)in), key, nr);
+		_mm_storeu_si128((__m128i*)out, b[0]);
+		in += AES_BLOCK_SIZE;
+		out += AES_BLOCK_SIZE;
+	}
+	return EXIT_SUCCESS;
+}
+
+AES_RETURN aes_ni_ecb_decrypt(const unsigned char *in, unsigned char *out, int nb, const aes_decrypt_ctx cx[1])
+{
+	const __m128i *key = (const __m128i*)cx->ks;
+	const int nr = ni_rounds(cx->inf.b[0]);
+	__m128i b[NI_BLOCKS];
+
+	if(!nr || !has_aes_ni())
+		return EXIT_FAILURE;
+
+	for( ; nb >= NI_BLOCKS; nb -= NI_BLOCKS)
+	{
+		load8( b, in );
+		dec8(b, key, nr);
+		store8( out, b );
+		in += NI_BLOCKS * AES_BLOCK_SIZE;
+		out += NI_BLOCKS * AES_BLOCK_SIZE;
+	}
+	for( ; nb > 0; --nb)
+	{
+		b[0] = dec1(_mm_loadu_si128((__m128i*)in), key, nr);
+		_mm_storeu_si128((__m128i*)out, b[0]);
+		in += AES_BLOCK_SIZE;
+		out += AES_BLOCK_SIZE;
+	}
+	return EXIT_SUCCESS;
+}
+
+/* CBC decryption: P[i] = D(C[i]) ^ C[i-1], with all of the ciphertext 
+   blocks for a batch loaded before anything is written so that in-place 
+   operation works */
+
+AES_RETURN aes_ni_cbc_decrypt(const unsigned char *in, unsigned char *out, int nb, unsigned char iv[16], const aes_decrypt_ctx cx[1])
+{
+	const __m128i *key = (const __m128i*)cx->ks;
+	const int nr = ni_rounds(cx->inf.b[0]);
+	__m128i b[NI_BLOCKS], c[NI_BLOCKS], fb;
+
+	if(!nr || !has_aes_ni())
+		return EXIT_FAILURE;
+
+	fb = _mm_loadu_si128((__m128i*)iv);
+	for( ; nb >= NI_BLOCKS; nb -= NI_BLOCKS)
+	{
+		load8( c, in );
+		b[0] = c[0]; b[1] = c[1]; b[2] = c[2]; b[3] = c[3];
+		b[4] = c[4]; b[5] = c[5]; b[6] = c[6]; b[7] = c[7];
+		dec8(b, key, nr);
+		b[0] = _mm_xor_si128(b[0], fb);
+		b[1] = _mm_xor_si128(b[1], c[0]);
+		b[2] = _mm_xor_si128(b[2], c[1]);
+		b[3] = _mm_xor_si128(b[3], c[2]);
+		b[4] = _mm_xor_si128(b[4], c[3]);
+		b[5] = _mm_xor_si128(b[5], c[4]);
+		b[6] = _mm_xor_si128(b[6], c[5]);
+		b[7] = _mm_xor_si128(b[7], c[6]);
+		fb = c[7];
+		store8( out, b );
+		in += NI_BLOCKS * AES_BLOCK_SIZE;
+		out += NI_BLOCKS * AES_BLOCK_SIZE;
+	}
+	for( ; nb > 0; --nb)
+	{
+		c[0] = _mm_loadu_si128((__m128i*)in);
+		b[0] = _mm_xor_si128(dec1(c[0], key, nr), fb);
+		fb = c[0];
+		_mm_storeu_si128((__m128i*)out, b[0]);
+		in += AES_BLOCK_SIZE;
+		out += AES_BLOCK_SIZE;
+	}
+	_mm_storeu_si128((__m128i*)iv, fb);
+	return EXIT_SUCCESS;
+}
+
+/* CFB decryption over whole blocks: P[i] = E(C[i-1]) ^ C[i], so the 
+   keystream for a batch depends only on ciphertext that's already 
+   available.  On exit the IV holds the last ciphertext block, as for the 
+   per-block code */
+
+AES_RETURN aes_ni_cfb_decrypt(const unsigned char *in, unsigned char *out, int nb, unsigned char iv[16], const aes_encrypt_ctx cx[1])
+{
+	const __m128i *key = (const __m128i*)cx->ks;
+	const int nr = ni_rounds(cx->inf.b[0]);
+	__m128i b[NI_BLOCKS], c[NI_BLOCKS], fb;
+
+	if(!nr || !has_aes_ni())
+		return EXIT_FAILURE;
+
+	fb = _mm_loadu_si128((__m128i*)iv);
+	for( ; nb >= NI_BLOCKS; nb -= NI_BLOCKS)
+	{
+		load8( c, in );
+		b[0] = fb;   b[1] = c[0]; b[2] = c[1]; b[3] = c[2];
+		b[4] = c[3]; b[5] = c[4]; b[6] = c[5]; b[7] = c[6];
+		enc8(b, key, nr);
+		b[0] = _mm_xor_si128(b[0], c[0]);
+		b[1] = _mm_xor_si128(b[1], c[1]);
+		b[2] = _mm_xor_si128(b[2], c[2]);
+		b[3] = _mm_xor_si128(b[3], c[3]);
+		b[4] = _mm_xor_si128(b[4], c[4]);
+		b[5] = _mm_xor_si128(b[5], c[5]);
+		b[6] = _mm_xor_si128(b[6], c[6]);
+		b[7] = _mm_xor_si128(b[7], c[7]);
+		fb = c[7];
+		store8( out, b );
+		in += NI_BLOCKS * AES_BLOCK_SIZE;
+		out += NI_BLOCKS * AES_BLOCK_SIZE;
+	}
+	for( ; nb > 0; --nb)
+	{
+		c[0] = _mm_loadu_si128((__m128i*)in);
+		b[0] = _mm_xor_si128(enc1(fb, key, nr), c[0]);
+		fb = c[0];
+		_mm_storeu_si128((__m128i*)out, b[0]);
+		in += AES_BLOCK_SIZE;
+		out += AES_BLOCK_SIZE;
+	}
+	_mm_storeu_si128((__m128i*)iv, fb);
+	return EXIT_SUCCESS;
+}
+
+/* CTR mode: encrypt a batch of counter blocks prepared by the caller and 
+   XOR the result directly into the data, avoiding a second pass over a 
+   keystream buffer */
+
+AES_RETURN aes_ni_ctr_xor(const unsigned char *in, unsigned char *out, int nb, const unsigned char *cbuf, const aes_encrypt_ctx cx[1])
+{
+	const __m128i *key = (const __m128i*)cx->ks;
+	const int nr = ni_rounds(cx->inf.b[0]);
+	__m128i b[NI_BLOCKS], c[NI_BLOCKS];
+
+	if(!nr || !has_aes_ni())
+		return EXIT_FAILURE;
+
+	for( ; nb >= NI_BLOCKS; nb -= NI_BLOCKS)
+	{
+		load8( b, cbuf );
+		enc8(b, key, nr);
+		load8( c, in );
+		b[0] = _mm_xor_si128(b[0], c[0]);
+		b[1] = _mm_xor_si128(b[1], c[1]);
+		b[2] = _mm_xor_si128(b[2], c[2]);
+		b[3] = _mm_xor_si128(b[3], c[3]);
+		b[4] = _mm_xor_si128(b[4], c[4]);
+		b[5] = _mm_xor_si128(b[5], c[5]);
+		b[6] = _mm_xor_si128(b[6], c[6]);
+		b[7] = _mm_xor_si128(b[7], c[7]);
+		store8( out, b );
+		cbuf += NI_BLOCKS * AES_BLOCK_SIZE;
+		in += NI_BLOCKS * AES_BLOCK_SIZE;
+		out += NI_BLOCKS * AES_BLOCK_SIZE;
+	}
+	for( ; nb > 0; --nb)
+	{
+		b[0] = enc1(_mm_loadu_si128((__m128i*)cbuf), key, nr);
+		b[0] = _mm_xor_si128(b[0], _mm_loadu_si128((__m128i*)in));
+		_mm_storeu_si128((__m128i*)out, b[0]);
+		cbuf += AES_BLOCK_SIZE;
+		in += AES_BLOCK_SIZE;
+		out += AES_BLOCK_SIZE;
+	}
+	return EXIT_SUCCESS;
+}
+
 #ifdef ADD_AESNI_MODE_CALLS
 #ifdef USE_AES_CONTEXT
 
@@ -54,6 +54,14 @@ AES_RETURN aes_xi(decrypt_key256)(const unsigned char *key, aes_decrypt_ctx cx[1
 AES_RETURN aes_xi(encrypt)(const unsigned char *in, unsigned char *out, const aes_encrypt_ctx cx[1]);
 AES_RETURN aes_xi(decrypt)(const unsigned char *in, unsigned char *out, const aes_decrypt_ctx cx[1]);
 
+/* multi-block kernels for the parallelisable modes, these return 
+   EXIT_FAILURE if AES-NI isn't present - pcg */
+AES_RETURN aes_ni_ecb_encrypt(const unsigned char *in, unsigned char *out, int nb, const aes_encrypt_ctx cx[1]);
+AES_RETURN aes_ni_ecb_decrypt(const unsigned char *in, unsigned char *out, int nb, const aes_decrypt_ctx cx[1]);
+AES_RETURN aes_ni_cbc_decrypt(const unsigned char *in, unsigned char *out, int nb, unsigned char iv[16], const aes_decrypt_ctx cx[1]);
+AES_RETURN aes_ni_cfb_decrypt(const unsigned char *in, unsigned char *out, int nb, unsigned char iv[16], const aes_encrypt_ctx cx[1]);
+AES_RETURN aes_ni_ctr_xor(const unsigned char *in, unsigned char *out, int nb, const unsigned char *cbuf, const aes_encrypt_ctx cx[1]);
+
 #endif
 
 #endif
@@ -0,0 +1,538 @@
+/****************************************************************************
+*																			*
+*						cryptlib ChaCha20 Stream Cipher						*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+/* ChaCha20 as per RFC 8439, with the original 64-bit nonce/64-bit counter
+   variant also supported for OpenSSH's chacha20-poly1305@openssh.com.  The
+   portable code generates one 64-byte keystream block at a time, on x86-64
+   systems there are additionally SSE2 and AVX2 kernels that generate four
+   or eight blocks at a time in parallel using the usual vertical layout in
+   which each vector register holds the same state word for four or eight
+   consecutive blocks, so that the rounds become straight-line vector code
+   with no shuffling until the output is transposed back into block order.
+   SSE2 is always present on x86-64 so the four-way kernel is used
+   unless it's been disabled via CRYPT_OPTION_MISC_CPUTIER, the eight-way 
+   AVX2 one is selected at runtime if the CPU and OS support it.
+
+   All operations are constant-time, there are no data-dependent branches
+   or table lookups anywhere in the code */
+
+#if defined( INC_ALL )
+  #include "crypt.h"
+  #include "chacha20.h"
+#else
+  #include "crypt.h"
+  #include "crypt/chacha20.h"
+#endif /* Compiler-specific includes */
+
+#ifdef USE_CHACHA20
+
+/* Determine whether we can use the SIMD kernels.  These require an x86-64
+   build with a compiler that supports the SSE2 and AVX2 intrinsics */
+
+#if ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) && defined( __x86_64__ ) ) || \
+	( defined( __clang_major__ ) && ( __clang_major__ >= 4 ) && \
+	  defined( __x86_64__ ) ) || \
+	( defined( _MSC_VER ) && ( _MSC_VER >= 1800 ) && defined( _M_X64 ) )
+  #define USE_CHACHA20_SIMD
+#endif /* gcc 5+/clang 4+/VS 2013+ on x86-64 */
+
+#ifdef USE_CHACHA20_SIMD
+  #include <immintrin.h>
+#endif /* USE_CHACHA20_SIMD */
+
+/* Read and write little-endian 32-bit values */
+
+#define LOAD32_LE( p ) \
+		( ( uint32_t ) ( p )[ 0 ] | ( ( uint32_t ) ( p )[ 1 ] << 8 ) | \
+		  ( ( uint32_t ) ( p )[ 2 ] << 16 ) | ( ( uint32_t ) ( p )[ 3 ] << 24 ) )
+#define STORE32_LE( p, v ) \
+		( p )[ 0 ] = ( BYTE ) ( v ); ( p )[ 1 ] = ( BYTE ) ( ( v ) >> 8 ); \
+		( p )[ 2 ] = ( BYTE ) ( ( v ) >> 16 ); ( p )[ 3 ] = ( BYTE ) ( ( v ) >> 24 )
+
+/* The ChaCha quarter-round */
+
+#define ROTL32( x, n )	( ( ( x ) << ( n ) ) | ( ( x ) >> ( 32 - ( n ) ) ) )
+
+#define QUARTERROUND( a, b, c, d ) \
+		a += b; d ^= a; d = ROTL32( d, 16 ); \
+		c += d; b ^= c; b = ROTL32( b, 12 ); \
+		a += b; d ^= a; d = ROTL32( d, 8 ); \
+		c += d; b ^= c; b = ROTL32( b, 7 )
+
+/* The number of blocks processed at once by the SIMD kernels */
+
+#define SSE2_BLOCKS		4
+#define AVX2_BLOCKS		8
+
+/****************************************************************************
+*																			*
+*							Portable ChaCha20 Routines						*
+*																			*
+****************************************************************************/
+
+/* Generate a single keystream block */
+
+static void chachaBlock( IN_ARRAY_C( 16 ) const uint32_t state[ 16 ],
+						 OUT_BUFFER_FIXED_C( CHACHA20_BLOCK_SIZE ) BYTE *out )
+	{
+	uint32_t x0 = state[ 0 ], x1 = state[ 1 ], x2 = state[ 2 ], x3 = state[ 3 ];
+	uint32_t x4 = state[ 4 ], x5 = state[ 5 ], x6 = state[ 6 ], x7 = state[ 7 ];
+	uint32_t x8 = state[ 8 ], x9 = state[ 9 ], x10 = state[ 10 ];
+	uint32_t x11 = state[ 11 ], x12 = state[ 12 ], x13 = state[ 13 ];
+	uint32_t x14 = state[ 14 ], x15 = state[ 15 ];
+	int i;
+
+	for( i = 0; i < 10; i++ )
+		{
+		/* Column round */
+		QUARTERROUND( x0, x4, x8, x12 );
+		QUARTERROUND( x1, x5, x9, x13 );
+		QUARTERROUND( x2, x6, x10, x14 );
+		QUARTERROUND( x3, x7, x11, x15 );
+
+		/* Diagonal round */
+		QUARTERROUND( x0, x5, x10, x15 );
+		QUARTERROUND( x1, x6, x11, x12 );
+		QUARTERROUND( x2, x7, x8, x13 );
+		QUARTERROUND( x3, x4, x9, x14 );
+		}
+	x0 += state[ 0 ]; x1 += state[ 1 ]; x2 += state[ 2 ]; x3 += state[ 3 ];
+	x4 += state[ 4 ]; x5 += state[ 5 ]; x6 += state[ 6 ]; x7 += state[ 7 ];
+	x8 += state[ 8 ]; x9 += state[ 9 ]; x10 += state[ 10 ];
+	x11 += state[ 11 ]; x12 += state[ 12 ]; x13 += state[ 13 ];
+	x14 += state[ 14 ]; x15 += state[ 15 ];
+	STORE32_LE( out, x0 ); STORE32_LE( out + 4, x1 );
+	STORE32_LE( out + 8, x2 ); STORE32_LE( out + 12, x3 );
+	STORE32_LE( out + 16, x4 ); STORE32_LE( out + 20, x5 );
+	STORE32_LE( out + 24, x6 ); STORE32_LE( out + 28, x7 );
+	STORE32_LE( out + 32, x8 ); STORE32_LE( out + 36, x9 );
+	STORE32_LE( out + 40, x10 ); STORE32_LE( out + 44, x11 );
+	STORE32_LE( out + 48, x12 ); STORE32_LE( out + 52, x13 );
+	STORE32_LE( out + 56, x14 ); STORE32_LE( out + 60, x15 );
+	}
+
+/* Advance the block counter.  For the IETF variant the counter is 32 bits
+   and wraps, for the original variant it's 64 bits spread across two
+   state words */
+
+static void incCounter( INOUT CHACHA20_CTX *ctx, const uint32_t noBlocks )
+	{
+	const uint32_t counter = ctx->state[ 12 ];
+
+	ctx->state[ 12 ] += noBlocks;
+	if( ctx->counterWords > 1 && ctx->state[ 12 ] < counter )
+		ctx->state[ 13 ]++;
+	}
+
+/* Check whether the next noBlocks blocks can be generated from the current
+   state by adding 0...noBlocks-1 to the low counter word alone, which is
+   what the SIMD kernels do.  This is always the case for the IETF variant,
+   for which the counter is only 32 bits, and for the 64-bit counter it's
+   the case unless the low word is about to overflow */
+
+#define counterOK( ctx, noBlocks ) \
+		( ( ctx )->counterWords == 1 || \
+		  ( ctx )->state[ 12 ] <= 0xFFFFFFFFUL - ( ( noBlocks ) - 1 ) )
+
+/****************************************************************************
+*																			*
+*							SSE2/AVX2 ChaCha20 Kernels						*
+*																			*
+****************************************************************************/
+
+#ifdef USE_CHACHA20_SIMD
+
+/* Check whether the CPU supports AVX2 and the OS saves the YMM register
+   state on context switches, and whether the SSE2 kernel is enabled.  The 
+   CPU capabilities are determined when cryptlib starts up, see getHWInfo() 
+   in misc/os_spec.c.  SSE2 is always present on x86-64 but can be turned 
+   off along with the other SIMD kernels via CRYPT_OPTION_MISC_CPUTIER */
+
+static int hasAVX2( void )
+	{
+	return( ( getSysVar( SYSVAR_HWCAP ) & HWCAP_FLAG_AVX2 ) ? TRUE : FALSE );
+	}
+
+static int hasSSE2( void )
+	{
+	return( ( getSysVar( SYSVAR_HWCAP ) & HWCAP_FLAG_SSE2 ) ? TRUE : FALSE );
+	}
+
+/* The SSE2 quarter-round.  SSE2 doesn't have a vector rotate so we use
+   shifts, except for the rotate by 16 which can be done by swapping the
+   16-bit halves of each word */
+
+#define ROTL_SSE2( x, n ) \
+		_mm_or_si128( _mm_slli_epi32( x, n ), _mm_srli_epi32( x, 32 - ( n ) ) )
+#define ROTL16_SSE2( x ) \
+		_mm_shufflehi_epi16( _mm_shufflelo_epi16( x, 0xB1 ), 0xB1 )
+
+#define QUARTERROUND_SSE2( a, b, c, d ) \
+		a = _mm_add_epi32( a, b ); d = _mm_xor_si128( d, a ); \
+		d = ROTL16_SSE2( d ); \
+		c = _mm_add_epi32( c, d ); b = _mm_xor_si128( b, c ); \
+		b = ROTL_SSE2( b, 12 ); \
+		a = _mm_add_epi32( a, b ); d = _mm_xor_si128( d, a ); \
+		d = ROTL_SSE2( d, 8 ); \
+		c = _mm_add_epi32( c, d ); b = _mm_xor_si128( b, c ); \
+		b = ROTL_SSE2( b, 7 )
+
+/* Transpose four state words j...j+3 for four blocks from word-major into
+   block-major order and XOR them into the data */
+
+#define XOR_TRANSPOSE_SSE2( buffer, a, b, c, d, offset ) \
+		{ \
+		const __m128i t0 = _mm_unpacklo_epi32( a, b ); \
+		const __m128i t1 = _mm_unpacklo_epi32( c, d ); \
+		const __m128i t2 = _mm_unpackhi_epi32( a, b ); \
+		const __m128i t3 = _mm_unpackhi_epi32( c, d ); \
+		__m128i *p0 = ( __m128i * ) ( buffer + offset ); \
+		__m128i *p1 = ( __m128i * ) ( buffer + 64 + offset ); \
+		__m128i *p2 = ( __m128i * ) ( buffer + 128 + offset ); \
+		__m128i *p3 = ( __m128i * ) ( buffer + 192 + offset ); \
+		\
+		_mm_storeu_si128( p0, _mm_xor_si128( _mm_loadu_si128( p0 ), \
+											 _mm_unpacklo_epi64( t0, t1 ) ) ); \
+		_mm_storeu_si128( p1, _mm_xor_si128( _mm_loadu_si128( p1 ), \
+											 _mm_unpackhi_epi64( t0, t1 ) ) ); \
+		_mm_storeu_si128( p2, _mm_xor_si128( _mm_loadu_si128( p2 ), \
+											 _mm_unpacklo_epi64( t2, t3 ) ) ); \
+		_mm_storeu_si128( p3, _mm_xor_si128( _mm_loadu_si128( p3 ), \
+											 _mm_unpackhi_epi64( t2, t3 ) ) ); \
+		}
+
+/* En/decrypt four blocks of data */
+
+static void chachaBlocksSSE2( IN_ARRAY_C( 16 ) const uint32_t state[ 16 ],
+							  INOUT_ARRAY_C( SSE2_BLOCKS * \
+											 CHACHA20_BLOCK_SIZE ) \
+								BYTE *buffer )
+	{
+	const __m128i s0 = _mm_set1_epi32( state[ 0 ] ), s1 = _mm_set1_epi32( state[ 1 ] );
+	const __m128i s2 = _mm_set1_epi32( state[ 2 ] ), s3 = _mm_set1_epi32( state[ 3 ] );
+	const __m128i s4 = _mm_set1_epi32( state[ 4 ] ), s5 = _mm_set1_epi32( state[ 5 ] );
+	const __m128i s6 = _mm_set1_epi32( state[ 6 ] ), s7 = _mm_set1_epi32( state[ 7 ] );
+	const __m128i s8 = _mm_set1_epi32( state[ 8 ] ), s9 = _mm_set1_epi32( state[ 9 ] );
+	const __m128i s10 = _mm_set1_epi32( state[ 10 ] ), s11 = _mm_set1_epi32( state[ 11 ] );
+	const __m128i s12 = _mm_add_epi32( _mm_set1_epi32( state[ 12 ] ),
+									   _mm_set_epi32( 3, 2, 1, 0 ) );
+	const __m128i s13 = _mm_set1_epi32( state[ 13 ] );
+	const __m128i s14 = _mm_set1_epi32( state[ 14 ] ), s15 = _mm_set1_epi32( state[ 15 ] );
+	__m128i x0 = s0, x1 = s1, x2 = s2, x3 = s3, x4 = s4, x5 = s5, x6 = s6;
+	__m128i x7 = s7, x8 = s8, x9 = s9, x10 = s10, x11 = s11, x12 = s12;
+	__m128i x13 = s13, x14 = s14, x15 = s15;
+	int i;
+
+	for( i = 0; i < 10; i++ )
+		{
+		QUARTERROUND_SSE2( x0, x4, x8, x12 );
+		QUARTERROUND_SSE2( x1, x5, x9, x13 );
+		QUARTERROUND_SSE2( x2, x6, x10, x14 );
+		QUARTERROUND_SSE2( x3, x7, x11, x15 );
+		QUARTERROUND_SSE2( x0, x5, x10, x15 );
+		QUARTERROUND_SSE2( x1, x6, x11, x12 );
+		QUARTERROUND_SSE2( x2, x7, x8, x13 );
+		QUARTERROUND_SSE2( x3, x4, x9, x14 );
+		}
+	x0 = _mm_add_epi32( x0, s0 ); x1 = _mm_add_epi32( x1, s1 );
+	x2 = _mm_add_epi32( x2, s2 ); x3 = _mm_add_epi32( x3, s3 );
+	x4 = _mm_add_epi32( x4, s4 ); x5 = _mm_add_epi32( x5, s5 );
+	x6 = _mm_add_epi32( x6, s6 ); x7 = _mm_add_epi32( x7, s7 );
+	x8 = _mm_add_epi32( x8, s8 ); x9 = _mm_add_epi32( x9, s9 );
+	x10 = _mm_add_epi32( x10, s10 ); x11 = _mm_add_epi32( x11, s11 );
+	x12 = _mm_add_epi32( x12, s12 ); x13 = _mm_add_epi32( x13, s13 );
+	x14 = _mm_add_epi32( x14, s14 ); x15 = _mm_add_epi32( x15, s15 );
+	XOR_TRANSPOSE_SSE2( buffer, x0, x1, x2, x3, 0 );
+	XOR_TRANSPOSE_SSE2( buffer, x4, x5, x6, x7, 16 );
+	XOR_TRANSPOSE_SSE2( buffer, x8, x9, x10, x11, 32 );
+	XOR_TRANSPOSE_SSE2( buffer, x12, x13, x14, x15, 48 );
+	}
+
+/* Everything from here on is only called once we know that the CPU
+   supports AVX2 */
+
+#if defined( __GNUC__ ) && !defined( _MSC_VER )
+  #pragma GCC push_options
+  #pragma GCC target( "avx2" )
+#endif /* gcc/clang */
+
+/* The AVX2 quarter-round.  The rotates by 16 and 8 are byte permutations
+   so we use PSHUFB for those */
+
+#define ROTL_AVX2( x, n ) \
+		_mm256_or_si256( _mm256_slli_epi32( x, n ), \
+						 _mm256_srli_epi32( x, 32 - ( n ) ) )
+
+#define QUARTERROUND_AVX2( a, b, c, d ) \
+		a = _mm256_add_epi32( a, b ); d = _mm256_xor_si256( d, a ); \
+		d = _mm256_shuffle_epi8( d, rot16 ); \
+		c = _mm256_add_epi32( c, d ); b = _mm256_xor_si256( b, c ); \
+		b = ROTL_AVX2( b, 12 ); \
+		a = _mm256_add_epi32( a, b ); d = _mm256_xor_si256( d, a ); \
+		d = _mm256_shuffle_epi8( d, rot8 ); \
+		c = _mm256_add_epi32( c, d ); b = _mm256_xor_si256( b, c ); \
+		b = ROTL_AVX2( b, 7 )
+
+/* Transpose four state words j...j+3 within each 128-bit lane, giving
+   blocks 0...3 in the low lanes and blocks 4...7 in the high lanes */
+
+#define TRANSPOSE_AVX2( a, b, c, d ) \
+		{ \
+		const __m256i t0 = _mm256_unpacklo_epi32( a, b ); \
+		const __m256i t1 = _mm256_unpacklo_epi32( c, d ); \
+		const __m256i t2 = _mm256_unpackhi_epi32( a, b ); \
+		const __m256i t3 = _mm256_unpackhi_epi32( c, d ); \
+		\
+		a = _mm256_unpacklo_epi64( t0, t1 ); \
+		b = _mm256_unpackhi_epi64( t0, t1 ); \
+		c = _mm256_unpacklo_epi64( t2, t3 ); \
+		d = _mm256_unpackhi_epi64( t2, t3 ); \
+		}
+
+/* XOR 32 bytes of keystream made up of the words j...j+3 from lo and
+   j+4...j+7 from hi into blocks n and n + 4 */
+
+#define XOR_AVX2( buffer, lo, hi, block, offset ) \
+		{ \
+		__m256i *p0 = ( __m256i * ) ( buffer + ( block * 64 ) + offset ); \
+		__m256i *p1 = ( __m256i * ) ( buffer + ( ( block + 4 ) * 64 ) + offset ); \
+		\
+		_mm256_storeu_si256( p0, \
+				_mm256_xor_si256( _mm256_loadu_si256( p0 ), \
+								  _mm256_permute2x128_si256( lo, hi, 0x20 ) ) ); \
+		_mm256_storeu_si256( p1, \
+				_mm256_xor_si256( _mm256_loadu_si256( p1 ), \
+								  _mm256_permute2x128_si256( lo, hi, 0x31 ) ) ); \
+		}
+
+/* En/decrypt eight blocks of data */
+
+static void chachaBlocksAVX2( IN_ARRAY_C( 16 ) const uint32_t state[ 16 ],
+							  INOUT_ARRAY_C( AVX2_BLOCKS * \
+											 CHACHA20_BLOCK_SIZE ) \
+								BYTE *buffer )
+	{
+	const __m256i rot16 = _mm256_setr_epi8( 2, 3, 0, 1, 6, 7, 4, 5,
+											10, 11, 8, 9, 14, 15, 12, 13,
+											2, 3, 0, 1, 6, 7, 4, 5,
+											10, 11, 8, 9, 14, 15, 12, 13 );
+	const __m256i rot8 = _mm256_setr_epi8( 3, 0, 1, 2, 7, 4, 5, 6,
+										   11, 8, 9, 10, 15, 12, 13, 14,
+										   3, 0, 1, 2, 7, 4, 5, 6,
+										   11, 8, 9, 10, 15, 12, 13, 14 );
+	const __m256i s0 = _mm256_set1_epi32( state[ 0 ] ), s1 = _mm256_set1_epi32( state[ 1 ] );
+	const __m256i s2 = _mm256_set1_epi32( state[ 2 ] ), s3 = _mm256_set1_epi32( state[ 3 ] );
+	const __m256i s4 = _mm256_set1_epi32( state[ 4 ] ), s5 = _mm256_set1_epi32( state[ 5 ] );
+	const __m256i s6 = _mm256_set1_epi32( state[ 6 ] ), s7 = _mm256_set1_epi32( state[ 7 ] );
+	const __m256i s8 = _mm256_set1_epi32( state[ 8 ] ), s9 = _mm256_set1_epi32( state[ 9 ] );
+	const __m256i s10 = _mm256_set1_epi32( state[ 10 ] ), s11 = _mm256_set1_epi32( state[ 11 ] );
+	const __m256i s12 = _mm256_add_epi32( _mm256_set1_epi32( state[ 12 ] ),
+										  _mm256_set_epi32( 7, 6, 5, 4, 3, 2, 1, 0 ) );
+	const __m256i s13 = _mm256_set1_epi32( state[ 13 ] );
+	const __m256i s14 = _mm256_set1_epi32( state[ 14 ] ), s15 = _mm256_set1_epi32( state[ 15 ] );
+	__m256i x0 = s0, x1 = s1, x2 = s2, x3 = s3, x4 = s4, x5 = s5, x6 = s6;
+	__m256i x7 = s7, x8 = s8, x9 = s9, x10 = s10, x11 = s11, x12 = s12;
+	__m256i x13 = s13, x14 = s14, x15 = s15;
+	int i;
+
+	for( i = 0; i < 10; i++ )
+		{
+		QUARTERROUND_AVX2( x0, x4, x8, x12 );
+		QUARTERROUND_AVX2( x1, x5, x9, x13 );
+		QUARTERROUND_AVX2( x2, x6, x10, x14 );
+		QUARTERROUND_AVX2( x3, x7, x11, x15 );
+		QUARTERROUND_AVX2( x0, x5, x10, x15 );
+		QUARTERROUND_AVX2( x1, x6, x11, x12 );
+		QUARTERROUND_AVX2( x2, x7, x8, x13 );
+		QUARTERROUND_AVX2( x3, x4, x9, x14 );
+		}
+	x0 = _mm256_add_epi32( x0, s0 ); x1 = _mm256_add_epi32( x1, s1 );
+	x2 = _mm256_add_epi32( x2, s2 ); x3 = _mm256_add_epi32( x3, s3 );
+	x4 = _mm256_add_epi32( x4, s4 ); x5 = _mm256_add_epi32( x5, s5 );
+	x6 = _mm256_add_epi32( x6, s6 ); x7 = _mm256_add_epi32( x7, s7 );
+	x8 = _mm256_add_epi32( x8, s8 ); x9 = _mm256_add_epi32( x9, s9 );
+	x10 = _mm256_add_epi32( x10, s10 ); x11 = _mm256_add_epi32( x11, s11 );
+	x12 = _mm256_add_epi32( x12, s12 ); x13 = _mm256_add_epi32( x13, s13 );
+	x14 = _mm256_add_epi32( x14, s14 ); x15 = _mm256_add_epi32( x15, s15 );
+	TRANSPOSE_AVX2( x0, x1, x2, x3 );
+	TRANSPOSE_AVX2( x4, x5, x6, x7 );
+	TRANSPOSE_AVX2( x8, x9, x10, x11 );
+	TRANSPOSE_AVX2( x12, x13, x14, x15 );
+
+	/* Each xN now contains 16 bytes of keystream for block n (low lane)
+	   and n + 4 (high lane), pair them up to give 32 contiguous bytes for
+	   each block */
+	XOR_AVX2( buffer, x0, x4, 0, 0 );
+	XOR_AVX2( buffer, x8, x12, 0, 32 );
+	XOR_AVX2( buffer, x1, x5, 1, 0 );
+	XOR_AVX2( buffer, x9, x13, 1, 32 );
+	XOR_AVX2( buffer, x2, x6, 2, 0 );
+	XOR_AVX2( buffer, x10, x14, 2, 32 );
+	XOR_AVX2( buffer, x3, x7, 3, 0 );
+	XOR_AVX2( buffer, x11, x15, 3, 32 );
+
+	/* Avoid AVX-SSE transition penalties in the caller */
+	_mm256_zeroupper();
+	}
+
+#if defined( __GNUC__ ) && !defined( _MSC_VER )
+  #pragma GCC pop_options
+#endif /* gcc/clang */
+
+#endif /* USE_CHACHA20_SIMD */
+
+/****************************************************************************
+*																			*
+*								ChaCha20 Interface							*
+*																			*
+****************************************************************************/
+
+/* Set up the key and nonce.  The key setup leaves the counter and nonce
+   zeroed, with no keystream available */
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void chacha20SetKey( INOUT CHACHA20_CTX *ctx,
+					 IN_BUFFER_C( CHACHA20_KEY_SIZE ) const BYTE *key )
+	{
+	int i;
+
+	assert( isWritePtr( ctx, sizeof( CHACHA20_CTX ) ) );
+	assert( isReadPtr( key, CHACHA20_KEY_SIZE ) );
+
+	/* "expand 32-byte k" */
+	ctx->state[ 0 ] = 0x61707865UL;
+	ctx->state[ 1 ] = 0x3320646EUL;
+	ctx->state[ 2 ] = 0x79622D32UL;
+	ctx->state[ 3 ] = 0x6B206574UL;
+	for( i = 0; i < 8; i++ )
+		ctx->state[ 4 + i ] = LOAD32_LE( key + ( i * 4 ) );
+	for( i = 12; i < 16; i++ )
+		ctx->state[ i ] = 0;
+	ctx->keystreamPos = CHACHA20_BLOCK_SIZE;
+	ctx->counterWords = 1;
+	}
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void chacha20SetNonce( INOUT CHACHA20_CTX *ctx,
+					   IN_BUFFER( nonceLength ) const BYTE *nonce,
+					   IN_RANGE( CHACHA20_NONCE_SIZE_64, \
+								 CHACHA20_NONCE_SIZE ) const int nonceLength,
+					   const uint32_t counter )
+	{
+	assert( isWritePtr( ctx, sizeof( CHACHA20_CTX ) ) );
+	assert( isReadPtrDynamic( nonce, nonceLength ) );
+	assert( nonceLength == CHACHA20_NONCE_SIZE || \
+			nonceLength == CHACHA20_NONCE_SIZE_64 );
+
+	ctx->state[ 12 ] = counter;
+	if( nonceLength == CHACHA20_NONCE_SIZE )
+		{
+		/* RFC 8439 form, 32-bit counter and 96-bit nonce */
+		ctx->state[ 13 ] = LOAD32_LE( nonce );
+		ctx->state[ 14 ] = LOAD32_LE( nonce + 4 );
+		ctx->state[ 15 ] = LOAD32_LE( nonce + 8 );
+		ctx->counterWords = 1;
+		}
+	else
+		{
+		/* Original form, 64-bit counter and 64-bit nonce */
+		ctx->state[ 13 ] = 0;
+		ctx->state[ 14 ] = LOAD32_LE( nonce );
+		ctx->state[ 15 ] = LOAD32_LE( nonce + 4 );
+		ctx->counterWords = 2;
+		}
+	ctx->keystreamPos = CHACHA20_BLOCK_SIZE;
+	}
+
+/* En/decrypt data in place */
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void chacha20Crypt( INOUT CHACHA20_CTX *ctx,
+					INOUT_BUFFER_FIXED( length ) BYTE *buffer,
+					IN_LENGTH const int length )
+	{
+	int bytesLeft = length, i;
+
+	assert( isWritePtr( ctx, sizeof( CHACHA20_CTX ) ) );
+	assert( isWritePtrDynamic( buffer, length ) );
+
+	/* Use up any keystream left over from a previous call */
+	if( ctx->keystreamPos < CHACHA20_BLOCK_SIZE )
+		{
+		const int count = min( bytesLeft, \
+							   CHACHA20_BLOCK_SIZE - ctx->keystreamPos );
+
+		for( i = 0; i < count; i++ )
+			buffer[ i ] ^= ctx->keystream[ ctx->keystreamPos + i ];
+		ctx->keystreamPos += count;
+		buffer += count;
+		bytesLeft -= count;
+		}
+
+#ifdef USE_CHACHA20_SIMD
+	/* Process as much data as we can using the SIMD kernels */
+	if( bytesLeft >= AVX2_BLOCKS * CHACHA20_BLOCK_SIZE && hasAVX2() )
+		{
+		while( bytesLeft >= AVX2_BLOCKS * CHACHA20_BLOCK_SIZE && \
+			   counterOK( ctx, AVX2_BLOCKS ) )
+			{
+			chachaBlocksAVX2( ctx->state, buffer );
+			incCounter( ctx, AVX2_BLOCKS );
+			buffer += AVX2_BLOCKS * CHACHA20_BLOCK_SIZE;
+			bytesLeft -= AVX2_BLOCKS * CHACHA20_BLOCK_SIZE;
+			}
+		}
+	if( bytesLeft >= SSE2_BLOCKS * CHACHA20_BLOCK_SIZE && hasSSE2() )
+		{
+		while( bytesLeft >= SSE2_BLOCKS * CHACHA20_BLOCK_SIZE && \
+			   counterOK( ctx, SSE2_BLOCKS ) )
+			{
+			chachaBlocksSSE2( ctx->state, buffer );
+			incCounter( ctx, SSE2_BLOCKS );
+			buffer += SSE2_BLOCKS * CHACHA20_BLOCK_SIZE;
+			bytesLeft -= SSE2_BLOCKS * CHACHA20_BLOCK_SIZE;
+			}
+		}
+#endif /* USE_CHACHA20_SIMD */
+
+	/* Process any remaining whole blocks */
+	while( bytesLeft >= CHACHA20_BLOCK_SIZE )
+		{
+		chachaBlock( ctx->state, ctx->keystream );
+		incCounter( ctx, 1 );
+		for( i = 0; i < CHACHA20_BLOCK_SIZE; i++ )
+			buffer[ i ] ^= ctx->keystream[ i ];
+		buffer += CHACHA20_BLOCK_SIZE;
+		bytesLeft -= CHACHA20_BLOCK_SIZE;
+		}
+
+	/* Process any remaining partial block, saving the unused keystream for
+	   the next call */
+	if( bytesLeft > 0 )
+		{
+		chachaBlock( ctx->state, ctx->keystream );
+		incCounter( ctx, 1 );
+		for( i = 0; i < bytesLeft; i++ )
+			buffer[ i ] ^= ctx->keystream[ i ];
+		ctx->keystreamPos = bytesLeft;
+		}
+	}
+
+/* Return raw keystream, used to derive the Poly1305 one-time key */
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void chacha20Keystream( INOUT CHACHA20_CTX *ctx,
+						OUT_BUFFER_FIXED( length ) BYTE *buffer,
+						IN_LENGTH const int length )
+	{
+	assert( isWritePtr( ctx, sizeof( CHACHA20_CTX ) ) );
+	assert( isWritePtrDynamic( buffer, length ) );
+
+	memset( buffer, 0, length );
+	chacha20Crypt( ctx, buffer, length );
+	}
+#endif /* USE_CHACHA20 */
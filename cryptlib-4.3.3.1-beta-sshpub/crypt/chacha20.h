@@ -0,0 +1,90 @@
+/****************************************************************************
+*																			*
+*					cryptlib ChaCha20/Poly1305 Header File					*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#ifndef _CHACHA20_DEFINED
+
+#define _CHACHA20_DEFINED
+
+/* The ChaCha20 key, nonce, and keystream block sizes.  The nonce can be
+   either the RFC 8439 IETF form, a 96-bit nonce with a 32-bit block
+   counter, or the original Bernstein form with a 64-bit nonce and a 64-bit
+   block counter as used by OpenSSH */
+
+#define CHACHA20_KEY_SIZE		32
+#define CHACHA20_NONCE_SIZE		12
+#define CHACHA20_NONCE_SIZE_64	8
+#define CHACHA20_BLOCK_SIZE		64
+
+/* The Poly1305 key and tag sizes */
+
+#define POLY1305_KEY_SIZE		32
+#define POLY1305_TAG_SIZE		16
+#define POLY1305_BLOCK_SIZE		16
+
+/* The ChaCha20 state.  The state array contains the constants, key, block
+   counter, and nonce in the standard order, and any keystream left over
+   from a partial block is held in the keystream buffer so that data can be
+   processed in arbitrary-length pieces */
+
+typedef struct {
+	uint32_t state[ 16 ];				/* Cipher state */
+	BYTE keystream[ CHACHA20_BLOCK_SIZE + 8 ];	/* Leftover keystream */
+	int keystreamPos;					/* Position in keystream buffer */
+	int counterWords;					/* 1 = IETF, 2 = 64-bit counter */
+	} CHACHA20_CTX;
+
+/* The Poly1305 state.  If there's a native 128-bit type available we use
+   three 44-bit limbs, otherwise five 26-bit ones */
+
+typedef struct {
+#if defined( __SIZEOF_INT128__ )
+	uint64_t r[ 3 ], h[ 3 ], pad[ 2 ];	/* Key r, accumulator, key s */
+#else
+	uint32_t r[ 5 ], h[ 5 ], pad[ 4 ];	/* Key r, accumulator, key s */
+#endif /* __SIZEOF_INT128__ */
+	BYTE buffer[ POLY1305_BLOCK_SIZE + 8 ];	/* Partial-block buffer */
+	int bufPos;							/* Position in buffer */
+	} POLY1305_CTX;
+
+/* ChaCha20 functions.  chacha20SetNonce() resets the keystream position to
+   the start of the given block, chacha20Crypt() en/decrypts data in place
+   and chacha20Keystream() returns raw keystream */
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void chacha20SetKey( INOUT CHACHA20_CTX *ctx,
+					 IN_BUFFER_C( CHACHA20_KEY_SIZE ) const BYTE *key );
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void chacha20SetNonce( INOUT CHACHA20_CTX *ctx,
+					   IN_BUFFER( nonceLength ) const BYTE *nonce,
+					   IN_RANGE( CHACHA20_NONCE_SIZE_64, \
+								 CHACHA20_NONCE_SIZE ) const int nonceLength,
+					   const uint32_t counter );
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void chacha20Crypt( INOUT CHACHA20_CTX *ctx,
+					INOUT_BUFFER_FIXED( length ) BYTE *buffer,
+					IN_LENGTH const int length );
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void chacha20Keystream( INOUT CHACHA20_CTX *ctx,
+						OUT_BUFFER_FIXED( length ) BYTE *buffer,
+						IN_LENGTH const int length );
+
+/* Poly1305 functions */
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void poly1305Init( OUT POLY1305_CTX *ctx,
+				   IN_BUFFER_C( POLY1305_KEY_SIZE ) const BYTE *key );
+STDC_NONNULL_ARG( ( 1 ) ) \
+void poly1305Update( INOUT POLY1305_CTX *ctx,
+					 IN_BUFFER_OPT( length ) const BYTE *data,
+					 IN_LENGTH_Z const int length );
+STDC_NONNULL_ARG( ( 1 ) ) \
+void poly1305Pad( INOUT POLY1305_CTX *ctx );
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void poly1305Final( INOUT POLY1305_CTX *ctx,
+					OUT_BUFFER_FIXED_C( POLY1305_TAG_SIZE ) BYTE *tag );
+
+#endif /* _CHACHA20_DEFINED */
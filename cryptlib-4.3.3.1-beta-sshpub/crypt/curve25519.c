@@ -0,0 +1,1185 @@
+/****************************************************************************
+*																			*
+*						cryptlib Curve25519 Routines						*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#if defined( INC_ALL )
+  #include "crypt.h"
+  #include "curve25519.h"
+#else
+  #include "crypt.h"
+  #include "crypt/curve25519.h"
+#endif /* Compiler-specific includes */
+
+#ifdef USE_25519
+
+/* Field elements in GF( 2^255 - 19 ) are represented as five 51-bit limbs
+   in radix 2^51, so that a = a[0] + a[1] * 2^51 + ... + a[4] * 2^204.
+   Limbs are allowed to grow somewhat beyond 51 bits between reductions,
+   which avoids having to carry after every addition and subtraction.  The
+   products of two limbs are accumulated in 128-bit values, using the
+   compiler's native 128-bit type if there is one and a pair of 64-bit
+   words if not.
+
+   All operations are performed in constant time, there are no secret-
+   dependent branches or memory accesses anywhere in the code */
+
+typedef uint64_t FIELD_ELEMENT[ 5 ];
+
+#define MASK51			( ( ( uint64_t ) 1 << 51 ) - 1 )
+
+/****************************************************************************
+*																			*
+*							128-bit Arithmetic Routines						*
+*																			*
+****************************************************************************/
+
+#if defined( __SIZEOF_INT128__ )
+
+typedef unsigned __int128 UINT128;
+
+#define mul64( r, a, b )	( r ) = ( UINT128 ) ( a ) * ( b )
+#define mulAdd64( r, a, b )	( r ) += ( UINT128 ) ( a ) * ( b )
+#define add64( r, a )		( r ) += ( a )
+#define low51( r )			( ( uint64_t ) ( r ) & MASK51 )
+#define shift51( r )		( ( uint64_t ) ( ( r ) >> 51 ) )
+
+#else
+
+/* There's no native 128-bit type available, emulate it using a pair of
+   64-bit words.  The 64 x 64 -> 128-bit multiply is done via four
+   32 x 32 -> 64-bit multiplies */
+
+typedef struct {
+	uint64_t lo, hi;
+	} UINT128;
+
+static void mul64x64( UINT128 *result, const uint64_t a, const uint64_t b )
+	{
+	const uint64_t aLo = a & 0xFFFFFFFFUL, aHi = a >> 32;
+	const uint64_t bLo = b & 0xFFFFFFFFUL, bHi = b >> 32;
+	const uint64_t lolo = aLo * bLo, lohi = aLo * bHi;
+	const uint64_t hilo = aHi * bLo, hihi = aHi * bHi;
+	const uint64_t middle = ( lolo >> 32 ) + ( lohi & 0xFFFFFFFFUL ) + \
+							( hilo & 0xFFFFFFFFUL );
+
+	result->lo = ( middle << 32 ) | ( lolo & 0xFFFFFFFFUL );
+	result->hi = hihi + ( lohi >> 32 ) + ( hilo >> 32 ) + ( middle >> 32 );
+	}
+
+static void add128( UINT128 *result, const UINT128 *value )
+	{
+	const uint64_t lo = result->lo + value->lo;
+
+	result->hi += value->hi + ( lo < value->lo );
+	result->lo = lo;
+	}
+
+static void addWord( UINT128 *result, const uint64_t value )
+	{
+	const uint64_t lo = result->lo + value;
+
+	result->hi += ( lo < value );
+	result->lo = lo;
+	}
+
+#define mul64( r, a, b )	mul64x64( &( r ), a, b )
+#define mulAdd64( r, a, b ) \
+		{ \
+		UINT128 product; \
+		\
+		mul64x64( &product, a, b ); \
+		add128( &( r ), &product ); \
+		}
+#define add64( r, a )		addWord( &( r ), a )
+#define low51( r )			( ( r ).lo & MASK51 )
+#define shift51( r )		( ( ( r ).lo >> 51 ) | ( ( r ).hi << 13 ) )
+
+#endif /* __SIZEOF_INT128__ */
+
+/****************************************************************************
+*																			*
+*							Field Arithmetic Routines						*
+*																			*
+****************************************************************************/
+
+/* Basic operations: h = f, h = 0/1, h = f + g, h = f - g */
+
+static void feCopy( FIELD_ELEMENT h, const FIELD_ELEMENT f )
+	{
+	h[ 0 ] = f[ 0 ]; h[ 1 ] = f[ 1 ]; h[ 2 ] = f[ 2 ];
+	h[ 3 ] = f[ 3 ]; h[ 4 ] = f[ 4 ];
+	}
+
+static void feSetWord( FIELD_ELEMENT h, const uint64_t value )
+	{
+	h[ 0 ] = value; h[ 1 ] = h[ 2 ] = h[ 3 ] = h[ 4 ] = 0;
+	}
+
+static void feAdd( FIELD_ELEMENT h, const FIELD_ELEMENT f,
+				   const FIELD_ELEMENT g )
+	{
+	h[ 0 ] = f[ 0 ] + g[ 0 ]; h[ 1 ] = f[ 1 ] + g[ 1 ];
+	h[ 2 ] = f[ 2 ] + g[ 2 ]; h[ 3 ] = f[ 3 ] + g[ 3 ];
+	h[ 4 ] = f[ 4 ] + g[ 4 ];
+	}
+
+/* Subtraction adds 4p before subtracting so that the result can't go
+   negative, which allows the subtrahend limbs to be up to 53 bits */
+
+static void feSub( FIELD_ELEMENT h, const FIELD_ELEMENT f,
+				   const FIELD_ELEMENT g )
+	{
+	h[ 0 ] = ( f[ 0 ] + 0x1FFFFFFFFFFFB4ULL ) - g[ 0 ];
+	h[ 1 ] = ( f[ 1 ] + 0x1FFFFFFFFFFFFCULL ) - g[ 1 ];
+	h[ 2 ] = ( f[ 2 ] + 0x1FFFFFFFFFFFFCULL ) - g[ 2 ];
+	h[ 3 ] = ( f[ 3 ] + 0x1FFFFFFFFFFFFCULL ) - g[ 3 ];
+	h[ 4 ] = ( f[ 4 ] + 0x1FFFFFFFFFFFFCULL ) - g[ 4 ];
+	}
+
+/* Propagate carries through the 128-bit limb products, folding the
+   overflow out of the top limb back into the bottom one via
+   2^255 = 19 mod p */
+
+static void feCarry( FIELD_ELEMENT h, UINT128 r[ 5 ] )
+	{
+	uint64_t carry;
+
+	carry = shift51( r[ 0 ] ); h[ 0 ] = low51( r[ 0 ] );
+	add64( r[ 1 ], carry );
+	carry = shift51( r[ 1 ] ); h[ 1 ] = low51( r[ 1 ] );
+	add64( r[ 2 ], carry );
+	carry = shift51( r[ 2 ] ); h[ 2 ] = low51( r[ 2 ] );
+	add64( r[ 3 ], carry );
+	carry = shift51( r[ 3 ] ); h[ 3 ] = low51( r[ 3 ] );
+	add64( r[ 4 ], carry );
+	carry = shift51( r[ 4 ] ); h[ 4 ] = low51( r[ 4 ] );
+	h[ 0 ] += carry * 19;
+	h[ 1 ] += h[ 0 ] >> 51;
+	h[ 0 ] &= MASK51;
+	}
+
+/* h = f * g.  The input limbs can be up to 54 bits, the output limbs are
+   at most 52 bits */
+
+static void feMul( FIELD_ELEMENT h, const FIELD_ELEMENT f,
+				   const FIELD_ELEMENT g )
+	{
+	const uint64_t g1_19 = g[ 1 ] * 19, g2_19 = g[ 2 ] * 19;
+	const uint64_t g3_19 = g[ 3 ] * 19, g4_19 = g[ 4 ] * 19;
+	UINT128 r[ 5 ];
+
+	mul64( r[ 0 ], f[ 0 ], g[ 0 ] );
+	mulAdd64( r[ 0 ], f[ 1 ], g4_19 );
+	mulAdd64( r[ 0 ], f[ 2 ], g3_19 );
+	mulAdd64( r[ 0 ], f[ 3 ], g2_19 );
+	mulAdd64( r[ 0 ], f[ 4 ], g1_19 );
+
+	mul64( r[ 1 ], f[ 0 ], g[ 1 ] );
+	mulAdd64( r[ 1 ], f[ 1 ], g[ 0 ] );
+	mulAdd64( r[ 1 ], f[ 2 ], g4_19 );
+	mulAdd64( r[ 1 ], f[ 3 ], g3_19 );
+	mulAdd64( r[ 1 ], f[ 4 ], g2_19 );
+
+	mul64( r[ 2 ], f[ 0 ], g[ 2 ] );
+	mulAdd64( r[ 2 ], f[ 1 ], g[ 1 ] );
+	mulAdd64( r[ 2 ], f[ 2 ], g[ 0 ] );
+	mulAdd64( r[ 2 ], f[ 3 ], g4_19 );
+	mulAdd64( r[ 2 ], f[ 4 ], g3_19 );
+
+	mul64( r[ 3 ], f[ 0 ], g[ 3 ] );
+	mulAdd64( r[ 3 ], f[ 1 ], g[ 2 ] );
+	mulAdd64( r[ 3 ], f[ 2 ], g[ 1 ] );
+	mulAdd64( r[ 3 ], f[ 3 ], g[ 0 ] );
+	mulAdd64( r[ 3 ], f[ 4 ], g4_19 );
+
+	mul64( r[ 4 ], f[ 0 ], g[ 4 ] );
+	mulAdd64( r[ 4 ], f[ 1 ], g[ 3 ] );
+	mulAdd64( r[ 4 ], f[ 2 ], g[ 2 ] );
+	mulAdd64( r[ 4 ], f[ 3 ], g[ 1 ] );
+	mulAdd64( r[ 4 ], f[ 4 ], g[ 0 ] );
+
+	feCarry( h, r );
+	}
+
+/* h = f^2.  This uses the symmetry of the cross terms to reduce the
+   number of multiplies from 25 to 15 */
+
+static void feSquare( FIELD_ELEMENT h, const FIELD_ELEMENT f )
+	{
+	const uint64_t f0_2 = f[ 0 ] * 2, f1_2 = f[ 1 ] * 2;
+	const uint64_t f1_38 = f[ 1 ] * 38, f2_38 = f[ 2 ] * 38;
+	const uint64_t f3_38 = f[ 3 ] * 38, f3_19 = f[ 3 ] * 19;
+	const uint64_t f4_19 = f[ 4 ] * 19;
+	UINT128 r[ 5 ];
+
+	mul64( r[ 0 ], f[ 0 ], f[ 0 ] );
+	mulAdd64( r[ 0 ], f1_38, f[ 4 ] );
+	mulAdd64( r[ 0 ], f2_38, f[ 3 ] );
+
+	mul64( r[ 1 ], f0_2, f[ 1 ] );
+	mulAdd64( r[ 1 ], f2_38, f[ 4 ] );
+	mulAdd64( r[ 1 ], f3_19, f[ 3 ] );
+
+	mul64( r[ 2 ], f0_2, f[ 2 ] );
+	mulAdd64( r[ 2 ], f[ 1 ], f[ 1 ] );
+	mulAdd64( r[ 2 ], f3_38, f[ 4 ] );
+
+	mul64( r[ 3 ], f0_2, f[ 3 ] );
+	mulAdd64( r[ 3 ], f1_2, f[ 2 ] );
+	mulAdd64( r[ 3 ], f4_19, f[ 4 ] );
+
+	mul64( r[ 4 ], f0_2, f[ 4 ] );
+	mulAdd64( r[ 4 ], f1_2, f[ 3 ] );
+	mulAdd64( r[ 4 ], f[ 2 ], f[ 2 ] );
+
+	feCarry( h, r );
+	}
+
+/* h = f * 121665, the curve constant a24 = ( A - 2 ) / 4 used in the
+   Montgomery ladder */
+
+static void feMul121665( FIELD_ELEMENT h, const FIELD_ELEMENT f )
+	{
+	UINT128 r[ 5 ];
+
+	mul64( r[ 0 ], f[ 0 ], 121665 );
+	mul64( r[ 1 ], f[ 1 ], 121665 );
+	mul64( r[ 2 ], f[ 2 ], 121665 );
+	mul64( r[ 3 ], f[ 3 ], 121665 );
+	mul64( r[ 4 ], f[ 4 ], 121665 );
+
+	feCarry( h, r );
+	}
+
+/* h = f^( p - 2 ) = 1 / f, via the standard addition chain of 254
+   squarings and 11 multiplications */
+
+static void feSquareTimes( FIELD_ELEMENT h, const FIELD_ELEMENT f,
+						   const int count )
+	{
+	int i;
+
+	feSquare( h, f );
+	for( i = 1; i < count; i++ )
+		feSquare( h, h );
+	}
+
+static void feInvert( FIELD_ELEMENT h, const FIELD_ELEMENT f )
+	{
+	FIELD_ELEMENT z2, z9, z11, z2_5_0, z2_10_0, z2_20_0, z2_50_0;
+	FIELD_ELEMENT z2_100_0, t;
+
+	feSquare( z2, f );						/* 2 */
+	feSquareTimes( t, z2, 2 );				/* 8 */
+	feMul( z9, t, f );						/* 9 */
+	feMul( z11, z9, z2 );					/* 11 */
+	feSquare( t, z11 );						/* 22 */
+	feMul( z2_5_0, t, z9 );					/* 2^5 - 2^0 */
+	feSquareTimes( t, z2_5_0, 5 );
+	feMul( z2_10_0, t, z2_5_0 );			/* 2^10 - 2^0 */
+	feSquareTimes( t, z2_10_0, 10 );
+	feMul( z2_20_0, t, z2_10_0 );			/* 2^20 - 2^0 */
+	feSquareTimes( t, z2_20_0, 20 );
+	feMul( t, t, z2_20_0 );					/* 2^40 - 2^0 */
+	feSquareTimes( t, t, 10 );
+	feMul( z2_50_0, t, z2_10_0 );			/* 2^50 - 2^0 */
+	feSquareTimes( t, z2_50_0, 50 );
+	feMul( z2_100_0, t, z2_50_0 );			/* 2^100 - 2^0 */
+	feSquareTimes( t, z2_100_0, 100 );
+	feMul( t, t, z2_100_0 );				/* 2^200 - 2^0 */
+	feSquareTimes( t, t, 50 );
+	feMul( t, t, z2_50_0 );					/* 2^250 - 2^0 */
+	feSquareTimes( t, t, 5 );
+	feMul( h, t, z11 );						/* 2^255 - 21 */
+	}
+
+/* Conditionally swap f and g if swap = 1, without branching */
+
+static void feCondSwap( FIELD_ELEMENT f, FIELD_ELEMENT g,
+						const uint64_t swap )
+	{
+	const uint64_t mask = 0 - swap;
+	int i;
+
+	for( i = 0; i < 5; i++ )
+		{
+		const uint64_t x = mask & ( f[ i ] ^ g[ i ] );
+
+		f[ i ] ^= x;
+		g[ i ] ^= x;
+		}
+	}
+
+/* Convert between the little-endian byte-string and limb forms.  When
+   reading, the top bit of the value is ignored as per RFC 7748, when
+   writing the value is fully reduced mod p */
+
+static uint64_t load64( const BYTE *buffer )
+	{
+	return( ( ( uint64_t ) buffer[ 0 ] ) | \
+			( ( uint64_t ) buffer[ 1 ] << 8 ) | \
+			( ( uint64_t ) buffer[ 2 ] << 16 ) | \
+			( ( uint64_t ) buffer[ 3 ] << 24 ) | \
+			( ( uint64_t ) buffer[ 4 ] << 32 ) | \
+			( ( uint64_t ) buffer[ 5 ] << 40 ) | \
+			( ( uint64_t ) buffer[ 6 ] << 48 ) | \
+			( ( uint64_t ) buffer[ 7 ] << 56 ) );
+	}
+
+static void feFromBytes( FIELD_ELEMENT h, const BYTE *buffer )
+	{
+	h[ 0 ] = load64( buffer ) & MASK51;
+	h[ 1 ] = ( load64( buffer + 6 ) >> 3 ) & MASK51;
+	h[ 2 ] = ( load64( buffer + 12 ) >> 6 ) & MASK51;
+	h[ 3 ] = ( load64( buffer + 19 ) >> 1 ) & MASK51;
+	h[ 4 ] = ( load64( buffer + 24 ) >> 12 ) & MASK51;
+	}
+
+static void feToBytes( BYTE *buffer, const FIELD_ELEMENT f )
+	{
+	uint64_t t[ 5 ], word;
+	int i, j;
+
+	/* Carry twice to get the value into the range 0...2^255 - 1 with all
+	   limbs 51 bits */
+	feCopy( t, f );
+	for( i = 0; i < 2; i++ )
+		{
+		t[ 1 ] += t[ 0 ] >> 51; t[ 0 ] &= MASK51;
+		t[ 2 ] += t[ 1 ] >> 51; t[ 1 ] &= MASK51;
+		t[ 3 ] += t[ 2 ] >> 51; t[ 2 ] &= MASK51;
+		t[ 4 ] += t[ 3 ] >> 51; t[ 3 ] &= MASK51;
+		t[ 0 ] += ( t[ 4 ] >> 51 ) * 19; t[ 4 ] &= MASK51;
+		}
+
+	/* If the value is in the range p...2^255 - 1 then adding 19 will
+	   carry out of bit 255, so we add 19, fold any carry back in, and then
+	   add 2^255 - 19 and drop bit 255, which leaves the value fully
+	   reduced in both cases */
+	t[ 0 ] += 19;
+	t[ 1 ] += t[ 0 ] >> 51; t[ 0 ] &= MASK51;
+	t[ 2 ] += t[ 1 ] >> 51; t[ 1 ] &= MASK51;
+	t[ 3 ] += t[ 2 ] >> 51; t[ 2 ] &= MASK51;
+	t[ 4 ] += t[ 3 ] >> 51; t[ 3 ] &= MASK51;
+	t[ 0 ] += ( t[ 4 ] >> 51 ) * 19; t[ 4 ] &= MASK51;
+	t[ 0 ] += MASK51 + 1 - 19;
+	t[ 1 ] += MASK51; t[ 2 ] += MASK51;
+	t[ 3 ] += MASK51; t[ 4 ] += MASK51;
+	t[ 1 ] += t[ 0 ] >> 51; t[ 0 ] &= MASK51;
+	t[ 2 ] += t[ 1 ] >> 51; t[ 1 ] &= MASK51;
+	t[ 3 ] += t[ 2 ] >> 51; t[ 2 ] &= MASK51;
+	t[ 4 ] += t[ 3 ] >> 51; t[ 3 ] &= MASK51;
+	t[ 4 ] &= MASK51;
+
+	/* Pack the 5 x 51-bit limbs into 4 x 64-bit words and write them out
+	   in little-endian form */
+	for( i = 0; i < 4; i++ )
+		{
+		const int bitPos = i * 64, limb = bitPos / 51, shift = bitPos % 51;
+
+		word = t[ limb ] >> shift;
+		if( limb + 1 < 5 )
+			word |= t[ limb + 1 ] << ( 51 - shift );
+		if( limb + 2 < 5 && 102 - shift < 64 )
+			word |= t[ limb + 2 ] << ( 102 - shift );
+		for( j = 0; j < 8; j++ )
+			buffer[ ( i * 8 ) + j ] = ( BYTE ) ( word >> ( j * 8 ) );
+		}
+	zeroise( t, sizeof( t ) );
+	}
+
+/****************************************************************************
+*																			*
+*							X25519 Scalar Multiplication					*
+*																			*
+****************************************************************************/
+
+/* Perform the X25519 scalar multiplication using the Montgomery ladder
+   from RFC 7748 section 5, with the conditional swaps done in constant
+   time */
+
+STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+void curve25519ScalarMult( OUT_BUFFER_FIXED( CURVE25519_SIZE ) BYTE *result,
+						   IN_BUFFER( CURVE25519_SIZE ) const BYTE *scalar,
+						   IN_BUFFER( CURVE25519_SIZE ) const BYTE *point )
+	{
+	FIELD_ELEMENT x1, x2, z2, x3, z3, a, aa, b, bb, e, c, d, da, cb;
+	BYTE k[ CURVE25519_SIZE + 8 ];
+	uint64_t swap = 0;
+	int i;
+
+	assert( isWritePtr( result, CURVE25519_SIZE ) );
+	assert( isReadPtr( scalar, CURVE25519_SIZE ) );
+	assert( isReadPtr( point, CURVE25519_SIZE ) );
+
+	/* Clamp the scalar */
+	memcpy( k, scalar, CURVE25519_SIZE );
+	k[ 0 ] &= 0xF8;
+	k[ 31 ] &= 0x7F;
+	k[ 31 ] |= 0x40;
+
+	/* Set up the ladder state */
+	feFromBytes( x1, point );
+	feSetWord( x2, 1 );
+	feSetWord( z2, 0 );
+	feCopy( x3, x1 );
+	feSetWord( z3, 1 );
+
+	/* Run the ladder over bits 254...0 of the scalar */
+	for( i = 254; i >= 0; i-- )
+		{
+		const uint64_t bit = ( k[ i >> 3 ] >> ( i & 7 ) ) & 1;
+
+		swap ^= bit;
+		feCondSwap( x2, x3, swap );
+		feCondSwap( z2, z3, swap );
+		swap = bit;
+
+		feAdd( a, x2, z2 );
+		feSquare( aa, a );
+		feSub( b, x2, z2 );
+		feSquare( bb, b );
+		feSub( e, aa, bb );
+		feAdd( c, x3, z3 );
+		feSub( d, x3, z3 );
+		feMul( da, d, a );
+		feMul( cb, c, b );
+		feAdd( x3, da, cb );
+		feSquare( x3, x3 );
+		feSub( z3, da, cb );
+		feSquare( z3, z3 );
+		feMul( z3, z3, x1 );
+		feMul( x2, aa, bb );
+		feMul121665( z2, e );
+		feAdd( z2, z2, aa );
+		feMul( z2, z2, e );
+		}
+	feCondSwap( x2, x3, swap );
+	feCondSwap( z2, z3, swap );
+
+	/* Convert the result from projective to affine form */
+	feInvert( z2, z2 );
+	feMul( x2, x2, z2 );
+	feToBytes( result, x2 );
+
+	/* Clean up */
+	zeroise( k, CURVE25519_SIZE );
+	zeroise( x2, sizeof( FIELD_ELEMENT ) );
+	zeroise( z2, sizeof( FIELD_ELEMENT ) );
+	zeroise( x3, sizeof( FIELD_ELEMENT ) );
+	zeroise( z3, sizeof( FIELD_ELEMENT ) );
+	zeroise( a, sizeof( FIELD_ELEMENT ) );
+	zeroise( b, sizeof( FIELD_ELEMENT ) );
+	zeroise( aa, sizeof( FIELD_ELEMENT ) );
+	zeroise( bb, sizeof( FIELD_ELEMENT ) );
+	zeroise( da, sizeof( FIELD_ELEMENT ) );
+	zeroise( cb, sizeof( FIELD_ELEMENT ) );
+	}
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void curve25519ScalarMultBase( OUT_BUFFER_FIXED( CURVE25519_SIZE ) BYTE *result,
+							   IN_BUFFER( CURVE25519_SIZE ) const BYTE *scalar )
+	{
+	static const BYTE basePoint[ CURVE25519_SIZE ] = { 9 };
+
+	curve25519ScalarMult( result, scalar, basePoint );
+	}
+#ifdef USE_ED25519
+
+/****************************************************************************
+*																			*
+*						Ed25519 Field Arithmetic Routines					*
+*																			*
+****************************************************************************/
+
+/* Additional field operations needed for the Edwards-curve form.  Since
+   the Edwards formulae chain additions and subtractions more deeply than
+   the Montgomery ladder does, feReduce() is used to perform a single carry
+   pass that brings the limbs back down to 52 bits when the result of an
+   addition or subtraction is used as the subtrahend of a further
+   subtraction */
+
+static void feReduce( FIELD_ELEMENT h )
+	{
+	h[ 1 ] += h[ 0 ] >> 51; h[ 0 ] &= MASK51;
+	h[ 2 ] += h[ 1 ] >> 51; h[ 1 ] &= MASK51;
+	h[ 3 ] += h[ 2 ] >> 51; h[ 2 ] &= MASK51;
+	h[ 4 ] += h[ 3 ] >> 51; h[ 3 ] &= MASK51;
+	h[ 0 ] += ( h[ 4 ] >> 51 ) * 19; h[ 4 ] &= MASK51;
+	}
+
+static void feNeg( FIELD_ELEMENT h, const FIELD_ELEMENT f )
+	{
+	static const FIELD_ELEMENT zero = { 0 };
+
+	feSub( h, zero, f );
+	feReduce( h );
+	}
+
+/* Conditionally copy g to f if move = 1, without branching */
+
+static void feCondMove( FIELD_ELEMENT f, const FIELD_ELEMENT g,
+						const uint64_t move )
+	{
+	const uint64_t mask = 0 - move;
+	int i;
+
+	for( i = 0; i < 5; i++ )
+		f[ i ] ^= mask & ( f[ i ] ^ g[ i ] );
+	}
+
+/* Determine whether f is negative, i.e. whether the least significant bit 
+   of its fully-reduced form is set, and whether it's nonzero.  These are 
+   only applied to public values so they don't have to run in constant 
+   time */
+
+static int feIsNegative( const FIELD_ELEMENT f )
+	{
+	BYTE buffer[ CURVE25519_SIZE + 8 ];
+
+	feToBytes( buffer, f );
+	return( buffer[ 0 ] & 1 );
+	}
+
+static BOOLEAN feIsNonZero( const FIELD_ELEMENT f )
+	{
+	BYTE buffer[ CURVE25519_SIZE + 8 ];
+	int i;
+
+	feToBytes( buffer, f );
+	for( i = 0; i < CURVE25519_SIZE; i++ )
+		{
+		if( buffer[ i ] != 0 )
+			return( TRUE );
+		}
+	return( FALSE );
+	}
+
+/* h = f^( ( p - 5 ) / 8 ) = f^( 2^252 - 3 ), used to compute the square
+   root when decompressing a point.  This uses the same addition chain as 
+   feInvert() up to 2^250 - 1 */
+
+static void fePow22523( FIELD_ELEMENT h, const FIELD_ELEMENT f )
+	{
+	FIELD_ELEMENT z2, z9, z11, z2_5_0, z2_10_0, z2_20_0, z2_50_0;
+	FIELD_ELEMENT z2_100_0, t;
+
+	feSquare( z2, f );						/* 2 */
+	feSquareTimes( t, z2, 2 );				/* 8 */
+	feMul( z9, t, f );						/* 9 */
+	feMul( z11, z9, z2 );					/* 11 */
+	feSquare( t, z11 );						/* 22 */
+	feMul( z2_5_0, t, z9 );					/* 2^5 - 2^0 */
+	feSquareTimes( t, z2_5_0, 5 );
+	feMul( z2_10_0, t, z2_5_0 );			/* 2^10 - 2^0 */
+	feSquareTimes( t, z2_10_0, 10 );
+	feMul( z2_20_0, t, z2_10_0 );			/* 2^20 - 2^0 */
+	feSquareTimes( t, z2_20_0, 20 );
+	feMul( t, t, z2_20_0 );					/* 2^40 - 2^0 */
+	feSquareTimes( t, t, 10 );
+	feMul( z2_50_0, t, z2_10_0 );			/* 2^50 - 2^0 */
+	feSquareTimes( t, z2_50_0, 50 );
+	feMul( z2_100_0, t, z2_50_0 );			/* 2^100 - 2^0 */
+	feSquareTimes( t, z2_100_0, 100 );
+	feMul( t, t, z2_100_0 );				/* 2^200 - 2^0 */
+	feSquareTimes( t, t, 50 );
+	feMul( t, t, z2_50_0 );					/* 2^250 - 2^0 */
+	feSquareTimes( t, t, 2 );
+	feMul( h, t, f );						/* 2^252 - 3 */
+	}
+
+/****************************************************************************
+*																			*
+*							Ed25519 Group Operations						*
+*																			*
+****************************************************************************/
+
+/* Points on the twisted Edwards curve -x^2 + y^2 = 1 + dx^2y^2 are held in
+   one of several representations depending on what they're going to be
+   used for next:
+
+	GE_P2: Projective ( X : Y : Z ), x = X / Z, y = Y / Z.
+	GE_P3: Extended ( X : Y : Z : T ), xy = T / Z.
+	GE_P1P1: Completed ( ( X : Z ), ( Y : T ) ), x = X / Z, y = Y / T.
+	GE_PRECOMP: Affine ( y + x, y - x, 2dxy ), used for table entries.
+	GE_CACHED: ( Y + X, Y - X, Z, 2dT ), used for repeated additions.
+
+   These are the formulae from "High-speed high-security signatures" by
+   Bernstein, Duif, Lange, Schwabe, and Yang */
+
+typedef struct {
+	FIELD_ELEMENT X, Y, Z;
+	} GE_P2;
+
+typedef struct {
+	FIELD_ELEMENT X, Y, Z, T;
+	} GE_P3;
+
+typedef struct {
+	FIELD_ELEMENT X, Y, Z, T;
+	} GE_P1P1;
+
+typedef struct {
+	FIELD_ELEMENT yPlusX, yMinusX, xy2d;
+	} GE_PRECOMP;
+
+typedef struct {
+	FIELD_ELEMENT YplusX, YminusX, Z, T2d;
+	} GE_CACHED;
+
+#if defined( INC_ALL )
+  #include "ed25519tab.h"
+#else
+  #include "crypt/ed25519tab.h"
+#endif /* Compiler-specific includes */
+
+/* Conversions between point representations */
+
+static void geP3zero( GE_P3 *h )
+	{
+	feSetWord( h->X, 0 );
+	feSetWord( h->Y, 1 );
+	feSetWord( h->Z, 1 );
+	feSetWord( h->T, 0 );
+	}
+
+static void geP1P1toP2( GE_P2 *r, const GE_P1P1 *p )
+	{
+	feMul( r->X, p->X, p->T );
+	feMul( r->Y, p->Y, p->Z );
+	feMul( r->Z, p->Z, p->T );
+	}
+
+static void geP1P1toP3( GE_P3 *r, const GE_P1P1 *p )
+	{
+	feMul( r->X, p->X, p->T );
+	feMul( r->Y, p->Y, p->Z );
+	feMul( r->Z, p->Z, p->T );
+	feMul( r->T, p->X, p->Y );
+	}
+
+static void geP3toCached( GE_CACHED *r, const GE_P3 *p )
+	{
+	feAdd( r->YplusX, p->Y, p->X );
+	feSub( r->YminusX, p->Y, p->X );
+	feCopy( r->Z, p->Z );
+	feMul( r->T2d, p->T, curveD2 );
+	}
+
+/* r = 2 * p.  The P3 form is doubled by dropping T and treating it as a
+   P2 */
+
+static void geP2dbl( GE_P1P1 *r, const GE_P2 *p )
+	{
+	FIELD_ELEMENT t0;
+
+	feSquare( r->X, p->X );
+	feSquare( r->Z, p->Y );
+	feSquare( r->T, p->Z );
+	feAdd( r->T, r->T, r->T );
+	feAdd( r->Y, p->X, p->Y );
+	feSquare( t0, r->Y );
+	feAdd( r->Y, r->Z, r->X );
+	feSub( r->Z, r->Z, r->X );
+	feReduce( r->Z );
+	feSub( r->X, t0, r->Y );
+	feSub( r->T, r->T, r->Z );
+	}
+
+static void geP3dbl( GE_P1P1 *r, const GE_P3 *p )
+	{
+	GE_P2 q;
+
+	feCopy( q.X, p->X );
+	feCopy( q.Y, p->Y );
+	feCopy( q.Z, p->Z );
+	geP2dbl( r, &q );
+	}
+
+/* r = p + q and r = p - q for a cached or precomputed q */
+
+static void geAdd( GE_P1P1 *r, const GE_P3 *p, const GE_CACHED *q,
+				   const BOOLEAN isSubtract )
+	{
+	FIELD_ELEMENT t0;
+
+	feAdd( r->X, p->Y, p->X );
+	feSub( r->Y, p->Y, p->X );
+	feMul( r->Z, r->X, isSubtract ? q->YminusX : q->YplusX );
+	feMul( r->Y, r->Y, isSubtract ? q->YplusX : q->YminusX );
+	feMul( r->T, q->T2d, p->T );
+	feMul( r->X, p->Z, q->Z );
+	feAdd( t0, r->X, r->X );
+	feSub( r->X, r->Z, r->Y );
+	feAdd( r->Y, r->Z, r->Y );
+	if( isSubtract )
+		{
+		feSub( r->Z, t0, r->T );
+		feAdd( r->T, t0, r->T );
+		}
+	else
+		{
+		feAdd( r->Z, t0, r->T );
+		feSub( r->T, t0, r->T );
+		}
+	}
+
+static void geMixedAdd( GE_P1P1 *r, const GE_P3 *p, const GE_PRECOMP *q,
+						const BOOLEAN isSubtract )
+	{
+	FIELD_ELEMENT t0;
+
+	feAdd( r->X, p->Y, p->X );
+	feSub( r->Y, p->Y, p->X );
+	feMul( r->Z, r->X, isSubtract ? q->yMinusX : q->yPlusX );
+	feMul( r->Y, r->Y, isSubtract ? q->yPlusX : q->yMinusX );
+	feMul( r->T, q->xy2d, p->T );
+	feAdd( t0, p->Z, p->Z );
+	feSub( r->X, r->Z, r->Y );
+	feAdd( r->Y, r->Z, r->Y );
+	if( isSubtract )
+		{
+		feSub( r->Z, t0, r->T );
+		feAdd( r->T, t0, r->T );
+		}
+	else
+		{
+		feAdd( r->Z, t0, r->T );
+		feSub( r->T, t0, r->T );
+		}
+	}
+
+/* Convert a point to and from its encoded form, the little-endian
+   y-coordinate with the sign of x in the top bit */
+
+static void geToBytes( BYTE *buffer, const FIELD_ELEMENT X,
+					   const FIELD_ELEMENT Y, const FIELD_ELEMENT Z )
+	{
+	FIELD_ELEMENT recip, x, y;
+
+	feInvert( recip, Z );
+	feMul( x, X, recip );
+	feMul( y, Y, recip );
+	feToBytes( buffer, y );
+	buffer[ 31 ] ^= feIsNegative( x ) << 7;
+	}
+
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static BOOLEAN geFromBytes( GE_P3 *h, const BYTE *buffer )
+	{
+	FIELD_ELEMENT u, v, v3, vxx, check, one;
+	BYTE yBuffer[ CURVE25519_SIZE + 8 ];
+	const int xSign = buffer[ 31 ] >> 7;
+
+	feSetWord( one, 1 );
+	feFromBytes( h->Y, buffer );
+	feSetWord( h->Z, 1 );
+
+	/* Make sure that the y-coordinate is canonically encoded, i.e. that
+	   it's less than p */
+	feToBytes( yBuffer, h->Y );
+	yBuffer[ 31 ] |= buffer[ 31 ] & 0x80;
+	if( memcmp( yBuffer, buffer, CURVE25519_SIZE ) )
+		return( FALSE );
+
+	/* Compute x = sqrt( ( y^2 - 1 ) / ( dy^2 + 1 ) ) as 
+	   uv^3 ( uv^7 )^( ( p - 5 ) / 8 ) */
+	feSquare( u, h->Y );
+	feMul( v, u, curveD );
+	feSub( u, u, one );				/* u = y^2 - 1 */
+	feReduce( u );
+	feAdd( v, v, one );				/* v = dy^2 + 1 */
+	feSquare( v3, v );
+	feMul( v3, v3, v );				/* v3 = v^3 */
+	feSquare( h->X, v3 );
+	feMul( h->X, h->X, v );
+	feMul( h->X, h->X, u );			/* x = uv^7 */
+	fePow22523( h->X, h->X );		/* x = ( uv^7 )^( ( p - 5 ) / 8 ) */
+	feMul( h->X, h->X, v3 );
+	feMul( h->X, h->X, u );			/* x = uv^3 ( uv^7 )^( ( p - 5 ) / 8 ) */
+
+	/* If vx^2 == u then x is the square root, if vx^2 == -u then the 
+	   square root is x * sqrt( -1 ), otherwise there's no square root and 
+	   the point isn't on the curve */
+	feSquare( vxx, h->X );
+	feMul( vxx, vxx, v );
+	feSub( check, vxx, u );
+	if( feIsNonZero( check ) )
+		{
+		feAdd( check, vxx, u );
+		if( feIsNonZero( check ) )
+			return( FALSE );
+		feMul( h->X, h->X, sqrtM1 );
+		}
+
+	/* Adjust the sign of x.  x = 0 has no negative form so a set sign bit
+	   in that case is an invalid encoding */
+	if( !feIsNonZero( h->X ) && xSign )
+		return( FALSE );
+	if( feIsNegative( h->X ) != xSign )
+		feNeg( h->X, h->X );
+	feMul( h->T, h->X, h->Y );
+
+	return( TRUE );
+	}
+
+/****************************************************************************
+*																			*
+*						Ed25519 Scalar Multiplication						*
+*																			*
+****************************************************************************/
+
+/* Select baseTable[ pos ][ |b| - 1 ], negated if b < 0, in constant time */
+
+static void geSelect( GE_PRECOMP *t, const int pos, const int b )
+	{
+	const int64_t bValue = b;
+	const uint64_t bNegative = ( ( uint64_t ) bValue ) >> 63;
+	const uint64_t bAbs = ( uint64_t ) \
+				( ( bValue ^ -( int64_t ) bNegative ) + ( int64_t ) bNegative );
+	GE_PRECOMP minusT;
+	int i;
+
+	feSetWord( t->yPlusX, 1 );
+	feSetWord( t->yMinusX, 1 );
+	feSetWord( t->xy2d, 0 );
+	for( i = 0; i < 8; i++ )
+		{
+		const uint64_t isEqual = ( ( bAbs ^ ( i + 1 ) ) - 1 ) >> 63;
+
+		feCondMove( t->yPlusX, baseTable[ pos ][ i ].yPlusX, isEqual );
+		feCondMove( t->yMinusX, baseTable[ pos ][ i ].yMinusX, isEqual );
+		feCondMove( t->xy2d, baseTable[ pos ][ i ].xy2d, isEqual );
+		}
+	feCopy( minusT.yPlusX, t->yMinusX );
+	feCopy( minusT.yMinusX, t->yPlusX );
+	feNeg( minusT.xy2d, t->xy2d );
+	feCondMove( t->yPlusX, minusT.yPlusX, bNegative );
+	feCondMove( t->yMinusX, minusT.yMinusX, bNegative );
+	feCondMove( t->xy2d, minusT.xy2d, bNegative );
+	}
+
+/* Compute [ a ]B for the base point B and encode the result.  The scalar 
+   is converted into 64 signed radix-16 digits in the range -8...8, after 
+   which the odd- and even-position digits are each processed with one
+   table lookup and one mixed addition, so that the whole operation needs 
+   only four doublings */
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void ed25519ScalarMultBase( OUT_BUFFER_FIXED( CURVE25519_SIZE ) BYTE *result,
+							IN_BUFFER( CURVE25519_SIZE ) const BYTE *scalar )
+	{
+	signed char e[ 64 ];
+	GE_P1P1 r;
+	GE_P2 s;
+	GE_P3 h;
+	GE_PRECOMP t;
+	int carry, i;
+
+	assert( isWritePtr( result, CURVE25519_SIZE ) );
+	assert( isReadPtr( scalar, CURVE25519_SIZE ) );
+
+	/* Convert the scalar into signed radix-16 form.  This requires that 
+	   the top bit of the scalar is clear, which is always the case for
+	   clamped or reduced scalars */
+	for( i = 0; i < 32; i++ )
+		{
+		e[ ( 2 * i ) + 0 ] = ( scalar[ i ] >> 0 ) & 15;
+		e[ ( 2 * i ) + 1 ] = ( scalar[ i ] >> 4 ) & 15;
+		}
+	carry = 0;
+	for( i = 0; i < 63; i++ )
+		{
+		e[ i ] += carry;
+		carry = ( e[ i ] + 8 ) >> 4;
+		e[ i ] -= carry * 16;
+		}
+	e[ 63 ] += carry;
+
+	/* Accumulate the odd digits, multiply by 16, and then accumulate the
+	   even digits */
+	geP3zero( &h );
+	for( i = 1; i < 64; i += 2 )
+		{
+		geSelect( &t, i / 2, e[ i ] );
+		geMixedAdd( &r, &h, &t, FALSE );
+		geP1P1toP3( &h, &r );
+		}
+	geP3dbl( &r, &h );
+	geP1P1toP2( &s, &r );
+	geP2dbl( &r, &s );
+	geP1P1toP2( &s, &r );
+	geP2dbl( &r, &s );
+	geP1P1toP2( &s, &r );
+	geP2dbl( &r, &s );
+	geP1P1toP3( &h, &r );
+	for( i = 0; i < 64; i += 2 )
+		{
+		geSelect( &t, i / 2, e[ i ] );
+		geMixedAdd( &r, &h, &t, FALSE );
+		geP1P1toP3( &h, &r );
+		}
+	geToBytes( result, h.X, h.Y, h.Z );
+
+	/* Clean up */
+	zeroise( e, 64 );
+	zeroise( &h, sizeof( GE_P3 ) );
+	zeroise( &r, sizeof( GE_P1P1 ) );
+	zeroise( &s, sizeof( GE_P2 ) );
+	zeroise( &t, sizeof( GE_PRECOMP ) );
+	}
+
+/* Convert a scalar into a sliding-window form with odd digits in the range
+   -15...15 and runs of zeroes between them */
+
+static void slide( signed char *r, const BYTE *a )
+	{
+	int i, b, k;
+
+	for( i = 0; i < 256; i++ )
+		r[ i ] = 1 & ( a[ i >> 3 ] >> ( i & 7 ) );
+	for( i = 0; i < 256; i++ )
+		{
+		if( r[ i ] == 0 )
+			continue;
+		for( b = 1; b <= 6 && i + b < 256; b++ )
+			{
+			if( r[ i + b ] == 0 )
+				continue;
+			if( r[ i ] + ( r[ i + b ] << b ) <= 15 )
+				{
+				r[ i ] += r[ i + b ] << b;
+				r[ i + b ] = 0;
+				continue;
+				}
+			if( r[ i ] - ( r[ i + b ] << b ) < -15 )
+				break;
+			r[ i ] -= r[ i + b ] << b;
+			for( k = i + b; k < 256; k++ )
+				{
+				if( r[ k ] == 0 )
+					{
+					r[ k ] = 1;
+					break;
+					}
+				r[ k ] = 0;
+				}
+			}
+		}
+	}
+
+/* Compute [ s ]B - [ k ]A for the base point B and an encoded point A and 
+   encode the result, which is what's required for signature verification.
+   Since all of the values involved are public this doesn't have to run in 
+   constant time, so the two scalar multiplications are interleaved using 
+   sliding windows over a shared chain of doublings, with the odd multiples 
+   of B taken from a precomputed table and those of A computed on the fly */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3, 4 ) ) \
+int ed25519DoubleScalarMult( OUT_BUFFER_FIXED( CURVE25519_SIZE ) BYTE *result,
+							 IN_BUFFER( CURVE25519_SIZE ) const BYTE *kScalar,
+							 IN_BUFFER( CURVE25519_SIZE ) const BYTE *point,
+							 IN_BUFFER( CURVE25519_SIZE ) const BYTE *sScalar )
+	{
+	signed char kSlide[ 256 ], sSlide[ 256 ];
+	GE_CACHED Ai[ 8 ];
+	GE_P1P1 t;
+	GE_P3 A, A2, u;
+	GE_P2 r;
+	int i;
+
+	assert( isWritePtr( result, CURVE25519_SIZE ) );
+	assert( isReadPtr( kScalar, CURVE25519_SIZE ) );
+	assert( isReadPtr( point, CURVE25519_SIZE ) );
+	assert( isReadPtr( sScalar, CURVE25519_SIZE ) );
+
+	/* Decode the point and negate it, since we're computing -[ k ]A */
+	if( !geFromBytes( &A, point ) )
+		return( CRYPT_ERROR_BADDATA );
+	feNeg( A.X, A.X );
+	feNeg( A.T, A.T );
+
+	/* Precompute A, 3A, 5A, ..., 15A */
+	geP3toCached( &Ai[ 0 ], &A );
+	geP3dbl( &t, &A );
+	geP1P1toP3( &A2, &t );
+	for( i = 0; i < 7; i++ )
+		{
+		geAdd( &t, &A2, &Ai[ i ], FALSE );
+		geP1P1toP3( &u, &t );
+		geP3toCached( &Ai[ i + 1 ], &u );
+		}
+
+	/* Run the combined double-and-add over both scalars */
+	slide( kSlide, kScalar );
+	slide( sSlide, sScalar );
+	feSetWord( r.X, 0 );
+	feSetWord( r.Y, 1 );
+	feSetWord( r.Z, 1 );
+	for( i = 255; i >= 0; i-- )
+		{
+		if( kSlide[ i ] != 0 || sSlide[ i ] != 0 )
+			break;
+		}
+	for( ; i >= 0; i-- )
+		{
+		geP2dbl( &t, &r );
+		if( kSlide[ i ] != 0 )
+			{
+			geP1P1toP3( &u, &t );
+			geAdd( &t, &u, &Ai[ abs( kSlide[ i ] ) / 2 ], 
+				   ( kSlide[ i ] < 0 ) ? TRUE : FALSE );
+			}
+		if( sSlide[ i ] != 0 )
+			{
+			geP1P1toP3( &u, &t );
+			geMixedAdd( &t, &u, &oddBaseTable[ abs( sSlide[ i ] ) / 2 ], 
+						( sSlide[ i ] < 0 ) ? TRUE : FALSE );
+			}
+		geP1P1toP2( &r, &t );
+		}
+	geToBytes( result, r.X, r.Y, r.Z );
+
+	return( CRYPT_OK );
+	}
+
+/* Check whether an encoded value is a valid point on the curve */
+
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+BOOLEAN ed25519CheckPoint( IN_BUFFER( CURVE25519_SIZE ) const BYTE *point )
+	{
+	GE_P3 A;
+
+	assert( isReadPtr( point, CURVE25519_SIZE ) );
+
+	return( geFromBytes( &A, point ) );
+	}
+
+/****************************************************************************
+*																			*
+*						Ed25519 Scalar Arithmetic							*
+*																			*
+****************************************************************************/
+
+/* Arithmetic modulo the group order L = 2^252 + 
+   27742317777372353535851937790883648493.  Values are held as arrays of
+   signed 64-bit radix-2^8 digits, which provides enough headroom that the
+   intermediate products never need to be carried until the final 
+   reduction */
+
+static const int64_t orderL[ 32 ] = {
+	0xED, 0xD3, 0xF5, 0x5C, 0x1A, 0x63, 0x12, 0x58,
+	0xD6, 0x9C, 0xF7, 0xA2, 0xDE, 0xF9, 0xDE, 0x14,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+	};
+
+static void reduceModL( BYTE *result, int64_t x[ 64 ] )
+	{
+	int64_t carry;
+	int i, j;
+
+	/* Fold the upper 32 digits into the lower ones using 
+	   2^256 = -16 * ( L - 2^252 ) mod L */
+	for( i = 63; i >= 32; i-- )
+		{
+		carry = 0;
+		for( j = i - 32; j < i - 12; j++ )
+			{
+			x[ j ] += carry - 16 * x[ i ] * orderL[ j - ( i - 32 ) ];
+			carry = ( x[ j ] + 128 ) >> 8;
+			x[ j ] -= carry * 256;
+			}
+		x[ j ] += carry;
+		x[ i ] = 0;
+		}
+
+	/* Subtract off any remaining multiple of L contained in the top 
+	   digit */
+	carry = 0;
+	for( j = 0; j < 32; j++ )
+		{
+		x[ j ] += carry - ( x[ 31 ] >> 4 ) * orderL[ j ];
+		carry = x[ j ] >> 8;
+		x[ j ] &= 255;
+		}
+	for( j = 0; j < 32; j++ )
+		x[ j ] -= carry * orderL[ j ];
+
+	/* Carry the result into byte form */
+	for( i = 0; i < 32; i++ )
+		{
+		x[ i + 1 ] += x[ i ] >> 8;
+		result[ i ] = ( BYTE ) ( x[ i ] & 255 );
+		}
+	}
+
+/* result = value mod L for a 64-byte value */
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void ed25519ScalarReduce( OUT_BUFFER_FIXED( CURVE25519_SIZE ) BYTE *result,
+						  IN_BUFFER( CURVE25519_SIZE * 2 ) const BYTE *value )
+	{
+	int64_t x[ 64 ];
+	int i;
+
+	assert( isWritePtr( result, CURVE25519_SIZE ) );
+	assert( isReadPtr( value, CURVE25519_SIZE * 2 ) );
+
+	for( i = 0; i < 64; i++ )
+		x[ i ] = value[ i ];
+	reduceModL( result, x );
+	zeroise( x, sizeof( x ) );
+	}
+
+/* result = ( a * b + c ) mod L */
+
+STDC_NONNULL_ARG( ( 1, 2, 3, 4 ) ) \
+void ed25519ScalarMulAdd( OUT_BUFFER_FIXED( CURVE25519_SIZE ) BYTE *result,
+						  IN_BUFFER( CURVE25519_SIZE ) const BYTE *a,
+						  IN_BUFFER( CURVE25519_SIZE ) const BYTE *b,
+						  IN_BUFFER( CURVE25519_SIZE ) const BYTE *c )
+	{
+	int64_t x[ 64 ];
+	int i, j;
+
+	assert( isWritePtr( result, CURVE25519_SIZE ) );
+	assert( isReadPtr( a, CURVE25519_SIZE ) );
+	assert( isReadPtr( b, CURVE25519_SIZE ) );
+	assert( isReadPtr( c, CURVE25519_SIZE ) );
+
+	for( i = 0; i < 64; i++ )
+		x[ i ] = ( i < 32 ) ? c[ i ] : 0;
+	for( i = 0; i < 32; i++ )
+		{
+		for( j = 0; j < 32; j++ )
+			x[ i + j ] += ( int64_t ) a[ i ] * b[ j ];
+		}
+	reduceModL( result, x );
+	zeroise( x, sizeof( x ) );
+	}
+
+/* Check that a scalar is canonically encoded, i.e. that it's less than L.
+   This is used to reject malleable signatures */
+
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+BOOLEAN ed25519ScalarIsCanonical( IN_BUFFER( CURVE25519_SIZE ) const BYTE *scalar )
+	{
+	int i;
+
+	assert( isReadPtr( scalar, CURVE25519_SIZE ) );
+
+	for( i = 31; i >= 0; i-- )
+		{
+		if( scalar[ i ] < orderL[ i ] )
+			return( TRUE );
+		if( scalar[ i ] > orderL[ i ] )
+			return( FALSE );
+		}
+	return( FALSE );	/* scalar == L */
+	}
+#endif /* USE_ED25519 */
+#endif /* USE_25519 */
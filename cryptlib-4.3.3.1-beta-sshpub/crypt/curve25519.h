@@ -0,0 +1,61 @@
+/****************************************************************************
+*																			*
+*						cryptlib Curve25519 Header File						*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#ifndef _CURVE25519_DEFINED
+
+#define _CURVE25519_DEFINED
+
+/* The size of a Curve25519 scalar and u-coordinate, both of which are
+   encoded as little-endian byte strings */
+
+#define CURVE25519_SIZE			32
+
+/* Perform an X25519 scalar multiplication as per RFC 7748.  The scalar is
+   clamped internally, and the most significant bit of the input
+   u-coordinate is ignored.  The ScalarMultBase() form uses the standard
+   base point u = 9 */
+
+STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+void curve25519ScalarMult( OUT_BUFFER_FIXED( CURVE25519_SIZE ) BYTE *result,
+						   IN_BUFFER( CURVE25519_SIZE ) const BYTE *scalar,
+						   IN_BUFFER( CURVE25519_SIZE ) const BYTE *point );
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void curve25519ScalarMultBase( OUT_BUFFER_FIXED( CURVE25519_SIZE ) BYTE *result,
+							   IN_BUFFER( CURVE25519_SIZE ) const BYTE *scalar );
+
+#ifdef USE_ED25519
+
+/* Ed25519 group and scalar operations as used by RFC 8032 signatures.
+   Points are encoded as 32-byte little-endian y-coordinates with the sign
+   of x in the top bit, scalars are 32-byte little-endian values.
+   ed25519ScalarMultBase() computes [ a ]B using precomputed tables,
+   ed25519DoubleScalarMult() computes [ s ]B - [ k ]A in variable time for
+   signature verification */
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void ed25519ScalarMultBase( OUT_BUFFER_FIXED( CURVE25519_SIZE ) BYTE *result,
+							IN_BUFFER( CURVE25519_SIZE ) const BYTE *scalar );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3, 4 ) ) \
+int ed25519DoubleScalarMult( OUT_BUFFER_FIXED( CURVE25519_SIZE ) BYTE *result,
+							 IN_BUFFER( CURVE25519_SIZE ) const BYTE *kScalar,
+							 IN_BUFFER( CURVE25519_SIZE ) const BYTE *point,
+							 IN_BUFFER( CURVE25519_SIZE ) const BYTE *sScalar );
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+BOOLEAN ed25519CheckPoint( IN_BUFFER( CURVE25519_SIZE ) const BYTE *point );
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void ed25519ScalarReduce( OUT_BUFFER_FIXED( CURVE25519_SIZE ) BYTE *result,
+						  IN_BUFFER( CURVE25519_SIZE * 2 ) const BYTE *value );
+STDC_NONNULL_ARG( ( 1, 2, 3, 4 ) ) \
+void ed25519ScalarMulAdd( OUT_BUFFER_FIXED( CURVE25519_SIZE ) BYTE *result,
+						  IN_BUFFER( CURVE25519_SIZE ) const BYTE *a,
+						  IN_BUFFER( CURVE25519_SIZE ) const BYTE *b,
+						  IN_BUFFER( CURVE25519_SIZE ) const BYTE *c );
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+BOOLEAN ed25519ScalarIsCanonical( IN_BUFFER( CURVE25519_SIZE ) const BYTE *scalar );
+#endif /* USE_ED25519 */
+
+#endif /* _CURVE25519_DEFINED */
@@ -0,0 +1,1414 @@
+/****************************************************************************
+*																			*
+*						cryptlib Ed25519 Precomputed Tables					*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+/* This file is included by curve25519.c after the field-element and point
+   types have been defined.  The values are in the 5 x 51-bit limb form used
+   there, with each precomputed point stored as ( y + x, y - x, 2dxy ) */
+
+/* Precomputed multiples of the base point, baseTable[ i ][ j ] =
+   ( j + 1 ) * 256^i * B */
+
+static const GE_PRECOMP baseTable[ 32 ][ 8 ] = {
+	{
+		{
+			{ 0x493C6F58C3B85ULL, 0xDF7181C325F7ULL, 0xF50B0B3E4CB7ULL, 0x5329385A44C32ULL, 0x7CF9D3A33D4BULL },
+			{ 0x3905D740913EULL, 0xBA2817D673A2ULL, 0x23E2827F4E67CULL, 0x133D2E0C21A34ULL, 0x44FD2F9298F81ULL },
+			{ 0x11205877AAA68ULL, 0x479955893D579ULL, 0x50D66309B67A0ULL, 0x2D42D0DBEE5EEULL, 0x6F117B689F0C6ULL }
+		},
+		{
+			{ 0x4E7FC933C71D7ULL, 0x2CF41FEB6B244ULL, 0x7581C0A7D1A76ULL, 0x7172D534D32F0ULL, 0x590C063FA87D2ULL },
+			{ 0x1A56042B4D5A8ULL, 0x189CC159ED153ULL, 0x5B8DEAA3CAE04ULL, 0x2AAF04F11B5D8ULL, 0x6BB595A669C92ULL },
+			{ 0x2A8B3A59B7A5FULL, 0x3ABB359EF087FULL, 0x4F5A8C4DB05AFULL, 0x5B9A807D04205ULL, 0x701AF5B13EA50ULL }
+		},
+		{
+			{ 0x5B0A84CEE9730ULL, 0x61D10C97155E4ULL, 0x4059CC8096A10ULL, 0x47A608DA8014FULL, 0x7A164E1B9A80FULL },
+			{ 0x11FE8A4FCD265ULL, 0x7BCB8374FAACCULL, 0x52F5AF4EF4D4FULL, 0x5314098F98D10ULL, 0x2AB91587555BDULL },
+			{ 0x6933F0DD0D889ULL, 0x44386BB4C4295ULL, 0x3CB6D3162508CULL, 0x26368B872A2C6ULL, 0x5A2826AF12B9BULL }
+		},
+		{
+			{ 0x351B98EFC099FULL, 0x68FBFA4A7050EULL, 0x42A49959D971BULL, 0x393E51A469EFDULL, 0x680E910321E58ULL },
+			{ 0x6050A056818BFULL, 0x62ACC1F5532BFULL, 0x28141CCC9FA25ULL, 0x24D61F471E683ULL, 0x27933F4C7445AULL },
+			{ 0x3FBE9C476FF09ULL, 0xAF6B982E4B42ULL, 0xAD1251BA78E5ULL, 0x715AEEDEE7C88ULL, 0x7F9D0CBF63553ULL }
+		},
+		{
+			{ 0x2BC4408A5BB33ULL, 0x78EBDDA05442ULL, 0x2FFB112354123ULL, 0x375EE8DF5862DULL, 0x2945CCF146E20ULL },
+			{ 0x182C3A447D6BAULL, 0x22964E536EFF2ULL, 0x192821F540053ULL, 0x2F9F19E788E5CULL, 0x154A7E73EB1B5ULL },
+			{ 0x3DBF1812A8285ULL, 0xFA17BA3F9797ULL, 0x6F69CB49C3820ULL, 0x34D5A0DB3858DULL, 0x43AABE696B3BBULL }
+		},
+		{
+			{ 0x4EEEB77157131ULL, 0x1201915F10741ULL, 0x1669CDA6C9C56ULL, 0x45EC032DB346DULL, 0x51E57BB6A2CC3ULL },
+			{ 0x6B67B7D8CA4ULL, 0x84FA44E72933ULL, 0x1154EE55D6F8AULL, 0x4425D842E7390ULL, 0x38B64C41AE417ULL },
+			{ 0x4326702EA4B71ULL, 0x6834376030B5ULL, 0xEF0512F9C380ULL, 0xF1A9F2512584ULL, 0x10B8E91A9F0D6ULL }
+		},
+		{
+			{ 0x25CD0944EA3BFULL, 0x75673B81A4D63ULL, 0x150B925D1C0D4ULL, 0x13F38D9294114ULL, 0x461BEA69283C9ULL },
+			{ 0x72C9AAA3221B1ULL, 0x267774474F74DULL, 0x64B0E9B28085ULL, 0x3F04EF53B27C9ULL, 0x1D6EDD5D2E531ULL },
+			{ 0x36DC801B8B3A2ULL, 0xE0A7D4935E30ULL, 0x1DEB7CECC0D7DULL, 0x53A94E20DD2CULL, 0x7A9FBB1C6A0F9ULL }
+		},
+		{
+			{ 0x7596604DD3E8FULL, 0x6FC510E058B36ULL, 0x3670C8DB2CC0DULL, 0x297D899CE332FULL, 0x915E76061BCEULL },
+			{ 0x75DEDF39234D9ULL, 0x1C36AB1F3C54ULL, 0xF08FEE58F5DAULL, 0xE19613A0D637ULL, 0x3A9024A1320E0ULL },
+			{ 0x1F5D9C9A2911AULL, 0x7117994FAFCF8ULL, 0x2D8A8CAE28DC5ULL, 0x74AB1B2090C87ULL, 0x26907C5C2ECC4ULL }
+		}
+	},
+	{
+		{
+			{ 0x4DD0E632F9C1DULL, 0x2CED12622A5D9ULL, 0x18DE9614742DAULL, 0x79CA96FDBB5D4ULL, 0x6DD37D49A00EEULL },
+			{ 0x3635449AA515EULL, 0x3E178D0475DABULL, 0x50B4712A19712ULL, 0x2DCC2860FF4ADULL, 0x30D76D6F03D31ULL },
+			{ 0x444172106E4C7ULL, 0x1251AFED2D88ULL, 0x534FC9BED4F5AULL, 0x5D85A39CF5234ULL, 0x10C697112E864ULL }
+		},
+		{
+			{ 0x62AA08358C805ULL, 0x46F440848E194ULL, 0x447B771A8F52BULL, 0x377BA3269D31DULL, 0x3BF9BAF55080ULL },
+			{ 0x3C4277DBE5FDEULL, 0x5A335AFD44C92ULL, 0xC1164099753EULL, 0x70487006FE423ULL, 0x25E61CABED66FULL },
+			{ 0x3E128CC586604ULL, 0x5968B2E8FC7E2ULL, 0x49A3D5BD61CFULL, 0x116505B1EF6E6ULL, 0x566D78634586EULL }
+		},
+		{
+			{ 0x54285C65A2FD0ULL, 0x55E62CCF87420ULL, 0x46BB961B19044ULL, 0x1153405712039ULL, 0x14FBA5F34793BULL },
+			{ 0x7A49F9CC10834ULL, 0x2B513788A22C6ULL, 0x5FF4B6EF2395BULL, 0x2EC8E5AF607BFULL, 0x33975BCA5ECC3ULL },
+			{ 0x746166985F7D4ULL, 0x9939000AE79AULL, 0x5844C7964F97AULL, 0x13617E1F95B3DULL, 0x14829CEA83FC5ULL }
+		},
+		{
+			{ 0x70B2F4E71ECB8ULL, 0x728148EFC643CULL, 0x753E03995B76ULL, 0x5BF5FB2AB6767ULL, 0x5FC3BC4535D7ULL },
+			{ 0x37B8497DD95C2ULL, 0x61549D6B4FFE8ULL, 0x217A22DB1D138ULL, 0xB9CF062EB09EULL, 0x2FD9C71E5F758ULL },
+			{ 0xB3AE52AFDEDDULL, 0x19DA76619E497ULL, 0x6FA0654D2558EULL, 0x78219D25E41D4ULL, 0x373767475C651ULL }
+		},
+		{
+			{ 0x95CB14246590ULL, 0x2D82AA6AC68ULL, 0x442F183BC4851ULL, 0x6464F1C0A0644ULL, 0x6BF5905730907ULL },
+			{ 0x299FD40D1ADD9ULL, 0x5F2DE9A04E5F7ULL, 0x7C0EEBACC1C59ULL, 0x4CCA1B1F8290AULL, 0x1FBEA56C3B18FULL },
+			{ 0x778F1E1415B8AULL, 0x6F75874EFC1F4ULL, 0x28A694019027FULL, 0x52B37A96BDC4DULL, 0x2521CF67A635ULL }
+		},
+		{
+			{ 0x46720772F5EE4ULL, 0x632C0F359D622ULL, 0x2B2092BA3E252ULL, 0x662257C112680ULL, 0x1753D9F7CD6ULL },
+			{ 0x7EE0B0A9D5294ULL, 0x381FBEB4CCA27ULL, 0x7841F3A3E639DULL, 0x676EA30C3445FULL, 0x3FA00A7E71382ULL },
+			{ 0x1232D963DDB34ULL, 0x35692E70B078DULL, 0x247CA14777A1FULL, 0x6DB556BE8FCD0ULL, 0x12B5FE2FA048EULL }
+		},
+		{
+			{ 0x37C26AD6F1E92ULL, 0x46A0971227BE5ULL, 0x4722F0D2D9B4CULL, 0x3DC46204EE03AULL, 0x6F7E93C20796CULL },
+			{ 0xFBC496FCE34DULL, 0x575BE6B7DAE3EULL, 0x4A31585CEE609ULL, 0x37E9023930FFULL, 0x749B76F96FB12ULL },
+			{ 0x2F604AEA6AE05ULL, 0x637DC939323EBULL, 0x3FDAD9B048D47ULL, 0xA8B0D4045AF7ULL, 0xFCEC10F01E02ULL }
+		},
+		{
+			{ 0x2D29DC4244E45ULL, 0x6927B1BC147BEULL, 0x308534AC0839ULL, 0x4853664033F41ULL, 0x413779166FEABULL },
+			{ 0x558A649FE1E44ULL, 0x44635AEEFCC89ULL, 0x1FF434887F2BAULL, 0xF981220E2D44ULL, 0x4901AA7183C51ULL },
+			{ 0x1B7548C1AF8F0ULL, 0x7848C53368116ULL, 0x1B64E7383DE9ULL, 0x109FBB0587C8FULL, 0x41BB887B726D1ULL }
+		}
+	},
+	{
+		{
+			{ 0x34C597C6691AEULL, 0x7A150B6990FC4ULL, 0x52BEB9D922274ULL, 0x70EED7164861AULL, 0xA871E070C6A9ULL },
+			{ 0x7D44744346BEULL, 0x282B6A564A81DULL, 0x4ED80F875236BULL, 0x6FBBE1D450C50ULL, 0x4EB728C12FCDBULL },
+			{ 0x1B5994BBC8989ULL, 0x74B7BA84C0660ULL, 0x75678F1CDAEB8ULL, 0x23206B0D6F10CULL, 0x3EE7300F2685DULL }
+		},
+		{
+			{ 0x27947841E7518ULL, 0x32C7388DAE87FULL, 0x414ADD3971BE9ULL, 0x1850832F0EF1ULL, 0x7D47C6A2CFB89ULL },
+			{ 0x255E49E7DD6B7ULL, 0x38C2163D59EBAULL, 0x3861F2A005845ULL, 0x2E11E4CCBAEC9ULL, 0x1381576297912ULL },
+			{ 0x2D0148EF0D6E0ULL, 0x3522A8DE787FBULL, 0x2EE055E74F9D2ULL, 0x64038F6310813ULL, 0x148CF58D34C9EULL }
+		},
+		{
+			{ 0x72F7D9AE4756DULL, 0x7711E690FFC4AULL, 0x582A2355B0D16ULL, 0xDCCFE885B6B4ULL, 0x278FEBAD4EAEAULL },
+			{ 0x492F67934F027ULL, 0x7DED0815528D4ULL, 0x58461511A6612ULL, 0x5EA2E50DE1544ULL, 0x3FF2FA1EBD5DBULL },
+			{ 0x2681F8C933966ULL, 0x3840521931635ULL, 0x674F14A308652ULL, 0x3BD9C88A94890ULL, 0x4104DD02FE9C6ULL }
+		},
+		{
+			{ 0x14E06DB096AB8ULL, 0x1219C89E6B024ULL, 0x278ABD486A2DBULL, 0x240B292609520ULL, 0x165B5A48EFCAULL },
+			{ 0x2BF5E1124422AULL, 0x673146756AE56ULL, 0x14AD99A87E830ULL, 0x1EACA65B080FDULL, 0x2C863B00AFAF5ULL },
+			{ 0xA474A0846A76ULL, 0x99A5EF981E32ULL, 0x2A8AE3C4BBFE6ULL, 0x45C34AF14832CULL, 0x591B67D9BFFECULL }
+		},
+		{
+			{ 0x1B3719F18B55DULL, 0x754318C83D337ULL, 0x27C17B7919797ULL, 0x145B084089B61ULL, 0x489B4F8670301ULL },
+			{ 0x70D1C80B49BFAULL, 0x3D57E7D914625ULL, 0x3C0722165E545ULL, 0x5E5B93819E04FULL, 0x3DE02EC7CA8F7ULL },
+			{ 0x2102D3AEB92EFULL, 0x68C22D50C3A46ULL, 0x42EA89385894EULL, 0x75F9EBF55F38CULL, 0x49F5FBBA496CBULL }
+		},
+		{
+			{ 0x5628C1E9C572EULL, 0x598B108E822ABULL, 0x55D8FAE29361AULL, 0xADC8D1A97B28ULL, 0x6A1A6C288675ULL },
+			{ 0x49A108A5BCFD4ULL, 0x6178C8E7D6612ULL, 0x1F03473710375ULL, 0x73A49614A6098ULL, 0x5604A86DCBFA6ULL },
+			{ 0xD1D47C1764B6ULL, 0x1C08316A2E51ULL, 0x2B3DB45C95045ULL, 0x1634F818D300CULL, 0x20989E89FE274ULL }
+		},
+		{
+			{ 0x4278B85EAEC2EULL, 0xEF59657BE2CEULL, 0x72FD169588770ULL, 0x2E9B205260B30ULL, 0x730B9950F7059ULL },
+			{ 0x777FD3A2DCC7FULL, 0x594A9FB124932ULL, 0x1F8E80CA15F0ULL, 0x714D13CEC3269ULL, 0x403ED1D0CA67ULL },
+			{ 0x32D35874EC552ULL, 0x1F3048DF1B929ULL, 0x300D73B179B23ULL, 0x6E67BE5A37D0BULL, 0x5BD7454308303ULL }
+		},
+		{
+			{ 0x4932115E7792AULL, 0x457B9BBB930B8ULL, 0x68F5D8B193226ULL, 0x4164E8F1ED456ULL, 0x5BB7DB123067FULL },
+			{ 0x2D19528B24CC2ULL, 0x4AC66B8302FF3ULL, 0x701C8D9FDAD51ULL, 0x6C1B35C5B3727ULL, 0x133A78007380AULL },
+			{ 0x1F467C6CA62BEULL, 0x2C4232A5DC12CULL, 0x7551DC013B087ULL, 0x690C11B03BCDULL, 0x740DCA6D58F0EULL }
+		}
+	},
+	{
+		{
+			{ 0x28C570478433CULL, 0x1D8502873A463ULL, 0x7641E7EDED49CULL, 0x1ECEDD54CF571ULL, 0x2C03F5256C2B0ULL },
+			{ 0xEE0752CFCE4EULL, 0x660DD8116FBE9ULL, 0x55167130FFFEBULL, 0x1C682B885955CULL, 0x161D25FA963EAULL },
+			{ 0x718757B53A47DULL, 0x619E18B0F2F21ULL, 0x5FBDFE4C1EC04ULL, 0x5D798C81EBB92ULL, 0x699468BDBD96BULL }
+		},
+		{
+			{ 0x53DE66AA91948ULL, 0x45F81A599B1BULL, 0x3F7A8BD214193ULL, 0x71D4DA412331AULL, 0x293E1C4E6C4A2ULL },
+			{ 0x72F46F4DAFECFULL, 0x2948FFADEF7A3ULL, 0x11ECDFDF3BC04ULL, 0x3C2E98FFEED25ULL, 0x525219A473905ULL },
+			{ 0x6134B925112E1ULL, 0x6BB942BB406EDULL, 0x70C445C0DDE2ULL, 0x411D822C4D7A3ULL, 0x5B605C447F032ULL }
+		},
+		{
+			{ 0x1FEC6F0E7F04CULL, 0x3CEBC692C477DULL, 0x77986A19A95EULL, 0x6EAAAA1778B0FULL, 0x2F12FEF4CC5ABULL },
+			{ 0x5805920C47C89ULL, 0x1924771F9972CULL, 0x38BBDDF9FC040ULL, 0x1F7000092B281ULL, 0x24A76DCEA8AEBULL },
+			{ 0x522B2DFC0C740ULL, 0x7E8193480E148ULL, 0x33FD9A04341B9ULL, 0x3C863678A20BCULL, 0x5E607B2518A43ULL }
+		},
+		{
+			{ 0x4431CA596CF14ULL, 0x15DA7C801405ULL, 0x3C9B6F8F10B5ULL, 0x346922934017ULL, 0x201F33139E457ULL },
+			{ 0x31D8F6CDF1818ULL, 0x1F86C4B144B16ULL, 0x39875B8D73E9DULL, 0x2FBF0D9FFA7B3ULL, 0x5067ACAB6CCDDULL },
+			{ 0x27F6B08039D51ULL, 0x4802F8000DFAAULL, 0x9692A062C525ULL, 0x1BAEA91075817ULL, 0x397CBA8862460ULL }
+		},
+		{
+			{ 0x5C3FBC81379E7ULL, 0x41BBC255E2F02ULL, 0x6A3F756998650ULL, 0x1297FD4E07C42ULL, 0x771B4022C1E1CULL },
+			{ 0x13093F05959B2ULL, 0x1BD352F2EC618ULL, 0x75789B88EA86ULL, 0x61D1117EA48B9ULL, 0x2339D320766E6ULL },
+			{ 0x5D986513A2FA7ULL, 0x63F3A99E11B0FULL, 0x28A0ECFD6B26DULL, 0x53B6835E18D8FULL, 0x331A189219971ULL }
+		},
+		{
+			{ 0x12F3A9D7572AFULL, 0x10D00E953C4CAULL, 0x603DF116F2F8AULL, 0x33DC276E0E088ULL, 0x1AC9619FF649AULL },
+			{ 0x66F45FB4F80C6ULL, 0x3CC38EEB9FEA2ULL, 0x107647270DB1FULL, 0x710F1EA740DC8ULL, 0x31167C6B83BDFULL },
+			{ 0x33842524B1068ULL, 0x77DD39D30FE45ULL, 0x189432141A0D0ULL, 0x88FE4EB8C225ULL, 0x612436341F08BULL }
+		},
+		{
+			{ 0x349E31A2D2638ULL, 0x137A7FA6B16CULL, 0x681AE92777EDCULL, 0x222BFC5F8DC51ULL, 0x1522AA3178D90ULL },
+			{ 0x541DB874E898DULL, 0x62D80FB841B33ULL, 0x3E6EF027FA97ULL, 0x7A03C9E9633E8ULL, 0x46EBE2309E5EFULL },
+			{ 0x2F5369614938ULL, 0x356E5ADA20587ULL, 0x11BC89F6BF902ULL, 0x36746419C8DBULL, 0x45FE70F505243ULL }
+		},
+		{
+			{ 0x24920C8951491ULL, 0x107EC61944C5EULL, 0x72752E017C01FULL, 0x122B7DDA2E97AULL, 0x16619F6DB57A2ULL },
+			{ 0x75A6960C0B8CULL, 0x6DDE1C5E41B49ULL, 0x42E3F516DA341ULL, 0x16A03FDA8E79EULL, 0x428D1623A0E39ULL },
+			{ 0x74A4401A308FDULL, 0x6ED4B9558109ULL, 0x746F1F6A08867ULL, 0x4636F5C6F2321ULL, 0x1D81592D60BD3ULL }
+		}
+	},
+	{
+		{
+			{ 0x5B69F7B85C5E8ULL, 0x17A2D175650ECULL, 0x4CC3E6DBFC19EULL, 0x73E1D3873BE0EULL, 0x3A5F6D51B0AF8ULL },
+			{ 0x68756A60DAC5FULL, 0x55D757B8AEC26ULL, 0x3383DF45F80BDULL, 0x6783F8C9F96A6ULL, 0x20234A7789ECDULL },
+			{ 0x20DB67178B252ULL, 0x73AA3DA2C0EDAULL, 0x79045C01C70D3ULL, 0x1B37B15251059ULL, 0x7CD682353CFFEULL }
+		},
+		{
+			{ 0x5CD6068ACF4F3ULL, 0x3079AFC7A74CCULL, 0x58097650B64B4ULL, 0x47FABAC9C4E99ULL, 0x3EF0253B2B2CDULL },
+			{ 0x1A45BD887FAB6ULL, 0x65748076DC17CULL, 0x5B98000AA11A8ULL, 0x4A1ECC9080974ULL, 0x2838C8863BDC0ULL },
+			{ 0x3B0CF4A465030ULL, 0x22B8AEF57A2DULL, 0x2AD0677E925ADULL, 0x4094167D7457AULL, 0x21DCB8A606A82ULL }
+		},
+		{
+			{ 0x500FABE7731BAULL, 0x7CC53C3113351ULL, 0x7CF65FE080D81ULL, 0x3C5D966011BA1ULL, 0x5D840DBF6C6F6ULL },
+			{ 0x4468C9D9FC8ULL, 0x5DA8554796B8CULL, 0x3B8BE70950025ULL, 0x6D5892DA6A609ULL, 0xBC3D08194A31ULL },
+			{ 0x6380D309FE18BULL, 0x4D73C2CB8EE0DULL, 0x6B882ADBAC0B6ULL, 0x36EABDDDD4CBEULL, 0x3A4276232AC19ULL }
+		},
+		{
+			{ 0xC172DB447ECBULL, 0x3F8C505B7A77FULL, 0x6A857F97F3F10ULL, 0x4FCC0567FE03AULL, 0x770C9E824E1AULL },
+			{ 0x2432C8A7084FAULL, 0x47BF73CA8A968ULL, 0x1639176262867ULL, 0x5E8DF4F8010CEULL, 0x1FF177CEA16DEULL },
+			{ 0x1D99A45B5B5FDULL, 0x523674F2499ECULL, 0xF8FA26182613ULL, 0x58F7398048C98ULL, 0x39F264FD41500ULL }
+		},
+		{
+			{ 0x34AABFE097BE1ULL, 0x43BFC03253A33ULL, 0x29BC7FE91B7F3ULL, 0xA761E4844A16ULL, 0x65C621272C35FULL },
+			{ 0x53417DBE7E29CULL, 0x54573827394F5ULL, 0x565EEA6F650DDULL, 0x42050748DC749ULL, 0x1712D73468889ULL },
+			{ 0x389F8CE3193DDULL, 0x2D424B8177CE5ULL, 0x73FA0D3440CDULL, 0x139020CD49E97ULL, 0x22F9800AB19CEULL }
+		},
+		{
+			{ 0x29FDD9A6EFDACULL, 0x7C694A9282840ULL, 0x6F7CDEEE44B3AULL, 0x55A3207B25CC3ULL, 0x4171A4D38598CULL },
+			{ 0x2368A3E9EF8CBULL, 0x454AA08E2AC0BULL, 0x490923F8FA700ULL, 0x372AA9EA4582FULL, 0x13F416CD64762ULL },
+			{ 0x758AA99C94C8CULL, 0x5F6001700FF44ULL, 0x7694E488C01BDULL, 0xD5FDE948EED6ULL, 0x508214FA574BDULL }
+		},
+		{
+			{ 0x215BB53D003D6ULL, 0x1179E792CA8C3ULL, 0x1A0E96AC840A2ULL, 0x22393E2BB3AB6ULL, 0x3A7758A4C86CBULL },
+			{ 0x269153ED6FE4BULL, 0x72A23AEF89840ULL, 0x52BE5299699CULL, 0x3A5E5EF132316ULL, 0x22F960EC6FABAULL },
+			{ 0x111F693AE5076ULL, 0x3E3BFAA94CA90ULL, 0x445799476B887ULL, 0x24A0912464879ULL, 0x5D9FD15F8DE7FULL }
+		},
+		{
+			{ 0x44D2AEED7521EULL, 0x50865D2C2A7E4ULL, 0x2705B5238EA40ULL, 0x46C70B25D3B97ULL, 0x3BC187FA47EB9ULL },
+			{ 0x408D36D63727FULL, 0x5FAF8F6A66062ULL, 0x2BB892DA8DE6BULL, 0x769D4F0C7E2E6ULL, 0x332F35914F8FBULL },
+			{ 0x70115EA86C20CULL, 0x16D88DA24ADA8ULL, 0x1980622662ADFULL, 0x501EBBC195A9DULL, 0x450D81CE906FBULL }
+		}
+	},
+	{
+		{
+			{ 0x4D8961CAE743FULL, 0x6BDC38C7DBA0EULL, 0x7D3B4A7E1B463ULL, 0x844BDEE2ADF3ULL, 0x4CBAD279663ABULL },
+			{ 0x3B6A1A6205275ULL, 0x2E82791D06DCFULL, 0x23D72CAA93C87ULL, 0x5F0B7AB68AAF4ULL, 0x2DE25D4BA6345ULL },
+			{ 0x19024A0D71FCDULL, 0x15F65115F101AULL, 0x4E99067149708ULL, 0x119D8D1CBA5AFULL, 0x7D7FBCEFE2007ULL }
+		},
+		{
+			{ 0x45DC5F3C29094ULL, 0x3455220B579AFULL, 0x70C1631E068AULL, 0x26BC0630E9B21ULL, 0x4F9CD196DCD8DULL },
+			{ 0x71E6A266B2801ULL, 0x9AAE73E2DF5DULL, 0x40DD8B219B1A3ULL, 0x546FB4517DE0DULL, 0x5975435E87B75ULL },
+			{ 0x297D86A7B3768ULL, 0x4835A2F4C6332ULL, 0x70305F434160ULL, 0x183DD014E56AEULL, 0x7CCDD084387A0ULL }
+		},
+		{
+			{ 0x484186760CC93ULL, 0x7435665533361ULL, 0x2F686336B801ULL, 0x5225446F64331ULL, 0x3593CA848190CULL },
+			{ 0x6422C6D260417ULL, 0x212904817BB94ULL, 0x5A319DEB854F5ULL, 0x7A9D4E060DA7DULL, 0x428BD0ED61D0CULL },
+			{ 0x3189A5E849AA7ULL, 0x6ACBB1F59B242ULL, 0x7F6EF4753630CULL, 0x1F346292A2DA9ULL, 0x27398308DA2D6ULL }
+		},
+		{
+			{ 0x10E4C0A702453ULL, 0x4DAAFA37BD734ULL, 0x49F6BDC3E8961ULL, 0x1FEFFDCECDAE6ULL, 0x572C2945492C3ULL },
+			{ 0x38D28435ED413ULL, 0x4064F19992858ULL, 0x7680FBEF543CDULL, 0x1AADD83D58D3CULL, 0x269597AEBE8C3ULL },
+			{ 0x7C745D6CD30BEULL, 0x27C7755DF78EFULL, 0x1776833937FA3ULL, 0x5405116441855ULL, 0x7F985498C05BCULL }
+		},
+		{
+			{ 0x615520FBF6363ULL, 0xB9E9BF74DA6AULL, 0x4FE8308201169ULL, 0x173F76127DE43ULL, 0x30F2653CD69B1ULL },
+			{ 0x1CE889F0BE117ULL, 0x36F6A94510709ULL, 0x7F248720016B4ULL, 0x1821ED1E1CF91ULL, 0x76C2EC470A31FULL },
+			{ 0xC938AAC10C85ULL, 0x41B64ED797141ULL, 0x1BEB1C1185E6DULL, 0x1ED5490600F07ULL, 0x2F1273F159647ULL }
+		},
+		{
+			{ 0x8BD755A70BC0ULL, 0x49E3A885CE609ULL, 0x16585881B5AD6ULL, 0x3C27568D34F5EULL, 0x38AC1997EDC5FULL },
+			{ 0x1FC7C8AE01E11ULL, 0x2094D5573E8E7ULL, 0x5CA3CBBF549D2ULL, 0x4F920ECC54143ULL, 0x5D9E572AD85B6ULL },
+			{ 0x6B517A751B13BULL, 0xCFD370B180CCULL, 0x5377925D1F41AULL, 0x34E56566008A2ULL, 0x22DFCD9CBFE9EULL }
+		},
+		{
+			{ 0x459B4103BE0A1ULL, 0x59A4B3F2D2ADDULL, 0x7D734C8BB8EEBULL, 0x2393CBE594A09ULL, 0xFE9877824CDEULL },
+			{ 0x3D2E0C30D0CD9ULL, 0x3F597686671BBULL, 0xAA587EB63999ULL, 0xE3C7B592C619ULL, 0x6B2916C05448CULL },
+			{ 0x334D10ABA913BULL, 0x45CDB581CFDBULL, 0x5E3E0553A8F36ULL, 0x50BB3041EFFB2ULL, 0x4C303F307FF00ULL }
+		},
+		{
+			{ 0x403580DD94500ULL, 0x48DF77D92653FULL, 0x38A9FE3B349EAULL, 0xEA89850AAFE1ULL, 0x416B151AB706AULL },
+			{ 0x23BD617B28C85ULL, 0x6E72EE77D5A61ULL, 0x1A972FF174DDEULL, 0x3E2636373C60FULL, 0xD61B8F78B2ABULL },
+			{ 0xD7EFE9C136B0ULL, 0x1AB1C89640AD5ULL, 0x55F82AEF41F97ULL, 0x46957F317ED0DULL, 0x191A2AF74277EULL }
+		}
+	},
+	{
+		{
+			{ 0x62B434F460EFBULL, 0x294C6C0FAD3FCULL, 0x68368937B4C0FULL, 0x5C9F82910875BULL, 0x237E7DBE00545ULL },
+			{ 0x6F74BC53C1431ULL, 0x1C40E5DBBD9C2ULL, 0x6C8FB9CAE5C97ULL, 0x4845C5CE1B7DAULL, 0x7E2E0E450B5CCULL },
+			{ 0x575ED6701B430ULL, 0x4D3E17FA20026ULL, 0x791FC888C4253ULL, 0x2F1BA99078AC1ULL, 0x71AFA699B1115ULL }
+		},
+		{
+			{ 0x23C1C473B50D6ULL, 0x3E7671DE21D48ULL, 0x326FA5547A1E8ULL, 0x50E4DC25FAFD9ULL, 0x731FBC78F89ULL },
+			{ 0x66F9B3953B61DULL, 0x555F4283CCCB9ULL, 0x7DD67FB1960E7ULL, 0x14707A1AFFED4ULL, 0x21142E9C2B1CULL },
+			{ 0xC71848F81880ULL, 0x44BD9D8233C86ULL, 0x6E8578EFE5830ULL, 0x4045B6D7041B5ULL, 0x4C4D6F3347E15ULL }
+		},
+		{
+			{ 0x4DDFC988F1970ULL, 0x4F6173EA365E1ULL, 0x645DAF9AE4588ULL, 0x7D43763DB623BULL, 0x38BF9500A88F9ULL },
+			{ 0x7ECCFC17D1FC9ULL, 0x4CA280782831EULL, 0x7B8337DB1D7D6ULL, 0x5116DEF3895FBULL, 0x193FDDAAA7E47ULL },
+			{ 0x2C93C37E8876FULL, 0x3431A28C583FAULL, 0x49049DA8BD879ULL, 0x4B4A8407AC11CULL, 0x6A6FB99EBF0D4ULL }
+		},
+		{
+			{ 0x122B5B6E423C6ULL, 0x21E50DFF1DDD6ULL, 0x73D76324E75C0ULL, 0x588485495418EULL, 0x136FDA9F42C5EULL },
+			{ 0x6C1BB560855EBULL, 0x71F127E13AD48ULL, 0x5C6B304905AECULL, 0x3756B8E889BC7ULL, 0x75F76914A3189ULL },
+			{ 0x4DFB1A305BDD1ULL, 0x3B3FF05811F29ULL, 0x6ED62283CD92EULL, 0x65D1543EC52E1ULL, 0x22183510BE8DULL }
+		},
+		{
+			{ 0x2710143307A7FULL, 0x3D88FB48BF3ABULL, 0x249EB4EC18F7AULL, 0x136115DFF295FULL, 0x1387C441FD404ULL },
+			{ 0x766385EAD2D14ULL, 0x194F8B06095EULL, 0x8478F6823B62ULL, 0x6018689D37308ULL, 0x6A071CE17B806ULL },
+			{ 0x3C3D187978AF8ULL, 0x7AFE1C88276BAULL, 0x51DF281C8AD68ULL, 0x64906BDA4245DULL, 0x3171B26AAF1EDULL }
+		},
+		{
+			{ 0x5B7D8B28A47D1ULL, 0x2C2EE149E34C1ULL, 0x776F5629AFC53ULL, 0x1F4EA50FC49A9ULL, 0x6C514A6334424ULL },
+			{ 0x7319097564CA8ULL, 0x1844EBC233525ULL, 0x21D4543FDEEE1ULL, 0x1AD27AAFF1BD2ULL, 0x221FD4873CF08ULL },
+			{ 0x2204F3A156341ULL, 0x537414065A464ULL, 0x43C0C3BEDCF83ULL, 0x5557E706EA620ULL, 0x48DAA596FB924ULL }
+		},
+		{
+			{ 0x61D5DC84C9793ULL, 0x47DE83040C29EULL, 0x189DEB26507E7ULL, 0x4D4E6FADC479AULL, 0x58C837FA0E8A7ULL },
+			{ 0x28E665CA59CC7ULL, 0x165C715940DD9ULL, 0x785F3AA11C95ULL, 0x57B98D7E38469ULL, 0x676DD6FCCAD84ULL },
+			{ 0x1688596FC9058ULL, 0x66F6AD403619FULL, 0x4D759A87772EFULL, 0x7856E6173BEA4ULL, 0x1C4F73F2C6A57ULL }
+		},
+		{
+			{ 0x6706EFC7C3484ULL, 0x6987839EC366DULL, 0x731F95CF7F26ULL, 0x3AE758EBCE4BCULL, 0x70459ADB7DAF6ULL },
+			{ 0x24FBD305FA0BBULL, 0x40A98CC75A1CFULL, 0x78CE1220A7533ULL, 0x6217A10E1C197ULL, 0x795AC80D1BF64ULL },
+			{ 0x1DB4991B42BB3ULL, 0x469605B994372ULL, 0x631E3715C9A58ULL, 0x7E9CFEFCF728FULL, 0x5FE162848CE21ULL }
+		}
+	},
+	{
+		{
+			{ 0x1852D5D7CB208ULL, 0x60D0FBE5CE50FULL, 0x5A1E246E37B75ULL, 0x51AEE05FFD590ULL, 0x2B44C043677DAULL },
+			{ 0x1214FE194961AULL, 0xE1AE39A9E9CBULL, 0x543C8B526F9F7ULL, 0x119498067E91DULL, 0x4789D446FC917ULL },
+			{ 0x487AB074EB78EULL, 0x1D33B5E8CE343ULL, 0x13E419FEB1B46ULL, 0x2721F565DE6A4ULL, 0x60C52EEF2BB9AULL }
+		},
+		{
+			{ 0x3C5C27CAE6D11ULL, 0x36A9491956E05ULL, 0x124BAC9131DA6ULL, 0x3B6F7DE202B5DULL, 0x70D77248D9B66ULL },
+			{ 0x589BC3BFD8BF1ULL, 0x6F93E6AA3416BULL, 0x4C0A3D6C1AE48ULL, 0x55587260B586AULL, 0x10BC9C312CCFCULL },
+			{ 0x2E84B3EC2A05BULL, 0x69DA2F03C1551ULL, 0x23A174661A67BULL, 0x209BCA289F238ULL, 0x63755BD3A976FULL }
+		},
+		{
+			{ 0x7101897F1ACB7ULL, 0x3D82CB77B07B8ULL, 0x684083D7769F5ULL, 0x52B28472DCE07ULL, 0x2763751737C52ULL },
+			{ 0x7A03E2AD10853ULL, 0x213DCC6AD36ABULL, 0x1A6E240D5BDD6ULL, 0x7C24FFCF8FEDFULL, 0xD8CC1C48BC16ULL },
+			{ 0x402D36EB419A9ULL, 0x7CEF68C14A052ULL, 0xF1255BC2D139ULL, 0x373E7D431186AULL, 0x70C2DD8A7AD16ULL }
+		},
+		{
+			{ 0x4967DB8ED7E13ULL, 0x15AEED02F523AULL, 0x6149591D094BCULL, 0x672F204C17006ULL, 0x32B8613816A53ULL },
+			{ 0x194509F6FEC0EULL, 0x528D8CA31ACACULL, 0x7826D73B8B9FAULL, 0x24ACB99E0F9B3ULL, 0x2E0FAC6363948ULL },
+			{ 0x7F7BEE448CD64ULL, 0x4E10F10DA0F3CULL, 0x3936CB9AB20E9ULL, 0x7A0FC4FEA6CD0ULL, 0x4179215C735A4ULL }
+		},
+		{
+			{ 0x633B9286BCD34ULL, 0x6CAB3BADB9C95ULL, 0x74E387EDFBDFAULL, 0x14313C58A0FD9ULL, 0x31FA85662241CULL },
+			{ 0x94E7D7DCED2AULL, 0x68FA738E118EULL, 0x41B640A5FEE2BULL, 0x6BB709DF019D4ULL, 0x700344A30CD99ULL },
+			{ 0x26C422E3622F4ULL, 0xF3066A05B5F0ULL, 0x4E2448F0480A6ULL, 0x244CDE0DBF095ULL, 0x24BB2312A9952ULL }
+		},
+		{
+			{ 0xC2AF5F85C6BULL, 0x609F4CF2883FULL, 0x6E86EB5A1CA13ULL, 0x68B44A2EFCCD1ULL, 0xD1D2AF9FFEB5ULL },
+			{ 0xED1732DE67C3ULL, 0x308C369291635ULL, 0x33EF348F2D250ULL, 0x4475EA1A1BBULL, 0xFEE3E871E188ULL },
+			{ 0x28AA132621EDFULL, 0x42B244CAF353BULL, 0x66B064CC2E08AULL, 0x6BB20020CBDD3ULL, 0x16ACD79718531ULL }
+		},
+		{
+			{ 0x1C6C57887B6ADULL, 0x5ABF21FD7592BULL, 0x50BD41253867AULL, 0x3800B71273151ULL, 0x164ED34B18161ULL },
+			{ 0x772AF2D9B1D3DULL, 0x6D486448B4E5BULL, 0x2CE58DD8D18A8ULL, 0x1849F67503C8BULL, 0x123E0EF6B9302ULL },
+			{ 0x6D94C192FE69AULL, 0x5475222A2690FULL, 0x693789D86B8B3ULL, 0x1F5C3BDFB69DCULL, 0x78DA0FC61073FULL }
+		},
+		{
+			{ 0x780F1680C3A94ULL, 0x2A35D3CFCD453ULL, 0x5E5CDC7DDF8ULL, 0x6EE888078AC24ULL, 0x54AA4B316B38ULL },
+			{ 0x15D28E52BC66AULL, 0x30E1E0351CB7EULL, 0x30A2F74B11F8CULL, 0x39D120CD7DE03ULL, 0x2D25DEEB256B1ULL },
+			{ 0x468D19267CB8ULL, 0x38CDCA9B5FBF9ULL, 0x1BBB05C2CA1E2ULL, 0x3B015758E9533ULL, 0x134610A6AB7DAULL }
+		}
+	},
+	{
+		{
+			{ 0x265E777D1F515ULL, 0xF1F54C1E39A5ULL, 0x2F01B95522646ULL, 0x4FDD8DB9DDE6DULL, 0x654878CBA97CCULL },
+			{ 0x38EC78DF6B0FEULL, 0x13CAEBEA36A22ULL, 0x5EBC6E54E5F6AULL, 0x32804903D0EB8ULL, 0x2102FDBA2B20DULL },
+			{ 0x6E405055CE6A1ULL, 0x5024A35A532D3ULL, 0x1F69054DAF29DULL, 0x15D1D0D7A8BD5ULL, 0xAD725DB29ECBULL }
+		},
+		{
+			{ 0x7BC0C9B056F85ULL, 0x51CFEBFFAFFD8ULL, 0x44ABBE94DF549ULL, 0x7ECBBD7E33121ULL, 0x4F675F5302399ULL },
+			{ 0x267B1834E2457ULL, 0x6AE19C378BB88ULL, 0x7457B5ED9D512ULL, 0x3280D783D05FBULL, 0x4AEFCFFB71A03ULL },
+			{ 0x536360415171EULL, 0x2313309077865ULL, 0x251444334AFBCULL, 0x2B0C3853756E8ULL, 0xBCCBB72A2A86ULL }
+		},
+		{
+			{ 0x55E4C50FE1296ULL, 0x5FDD13EFC30DULL, 0x1C0C6C380E5EEULL, 0x3E11DE3FB62A8ULL, 0x6678FD69108F3ULL },
+			{ 0x6962FEAB1A9C8ULL, 0x6ACA28FB9A30BULL, 0x56DB7CA1B9F98ULL, 0x39F58497018DDULL, 0x4024F0AB59D6BULL },
+			{ 0x6FA31636863C2ULL, 0x10AE5A67E42B0ULL, 0x27ABBF01FDA31ULL, 0x380A7B9E64FBCULL, 0x2D42E2108EAD4ULL }
+		},
+		{
+			{ 0x17B0D0F537593ULL, 0x16263C0C9842EULL, 0x4AB827E4539A4ULL, 0x6370DDB43D73AULL, 0x420BF3A79B423ULL },
+			{ 0x5131594DFD29BULL, 0x3A627E98D52FEULL, 0x1154041855661ULL, 0x19175D09F8384ULL, 0x676B2608B8D2DULL },
+			{ 0xBA651C5B2B47ULL, 0x5862363701027ULL, 0xC4D6C219C6DBULL, 0xF03DFF8658DEULL, 0x745D2FFA9C0CFULL }
+		},
+		{
+			{ 0x6DF5721D34E6AULL, 0x4F32F767A0C06ULL, 0x1D5ABEAC76E20ULL, 0x41CE9E104E1E4ULL, 0x6E15BE54C1DCULL },
+			{ 0x25A1E2BC9C8BDULL, 0x104C8F3B037EAULL, 0x405576FA96C98ULL, 0x2E86A88E3876FULL, 0x1AE23CEB960CFULL },
+			{ 0x25D871932994AULL, 0x6B9D63B560B6EULL, 0x2DF2814C8D472ULL, 0xFBBEE20AA4EDULL, 0x58DED861278ECULL }
+		},
+		{
+			{ 0x35BA8B6C2C9A8ULL, 0x1DEA58B3185BFULL, 0x4B455CD23BBBEULL, 0x5EC19C04883F8ULL, 0x8BA696B531D5ULL },
+			{ 0x73793F266C55CULL, 0xB988A9C93B02ULL, 0x9B0EA32325DBULL, 0x37CAE71C17C5EULL, 0x2FF39DE85485FULL },
+			{ 0x53EEEC3EFC57AULL, 0x2FA9FE9022EFDULL, 0x699C72C138154ULL, 0x72A751EBD1FF8ULL, 0x120633B4947CFULL }
+		},
+		{
+			{ 0x531474912100AULL, 0x5AFCDF7C0D057ULL, 0x7A9E71B788DEDULL, 0x5EF708F3B0C88ULL, 0x7433BE3CB393ULL },
+			{ 0x4987891610042ULL, 0x79D9D7F5D0172ULL, 0x3C293013B9EC4ULL, 0xC2B85F39CACAULL, 0x35D30A99B4D59ULL },
+			{ 0x144C05CE997F4ULL, 0x4960B8A347FEFULL, 0x1DA11F15D74F7ULL, 0x54FAC19C0FEADULL, 0x2D873EDE7AF6DULL }
+		},
+		{
+			{ 0x202E14E5DF981ULL, 0x2EA02BC3EB54CULL, 0x38875B2883564ULL, 0x1298C513AE9DDULL, 0x543618A01600ULL },
+			{ 0x2316443373409ULL, 0x5DE95503B22AFULL, 0x699201BEAE2DFULL, 0x3DB5849FF737AULL, 0x2E773654707FAULL },
+			{ 0x2BDF4974C23C1ULL, 0x4B3B9C8D261BDULL, 0x26AE8B2A9BC28ULL, 0x3068210165C51ULL, 0x4B1443362D079ULL }
+		}
+	},
+	{
+		{
+			{ 0x454E91C529CCBULL, 0x24C98C6BF72CFULL, 0x486594C3D89AULL, 0x7AE13A3D7FA3CULL, 0x17038418EAF66ULL },
+			{ 0x4B7C7B66E1F7AULL, 0x4BEA185EFD998ULL, 0x4FABC711055F8ULL, 0x1FB9F7836FE38ULL, 0x582F446752DA6ULL },
+			{ 0x17BD320324CE4ULL, 0x51489117898C6ULL, 0x1684D92A0410BULL, 0x6E4D90F78C5A7ULL, 0xC2A1C4BCDA28ULL }
+		},
+		{
+			{ 0x4814869BD6945ULL, 0x7B7C391A45DB8ULL, 0x57316AC35B641ULL, 0x641E31DE9096AULL, 0x5A6A9B30A314DULL },
+			{ 0x5C7D06F1F0447ULL, 0x7DB70F80B3A49ULL, 0x6CB4A3EC89A78ULL, 0x43BE8AD81397DULL, 0x7C558BD1C6F64ULL },
+			{ 0x41524D396463DULL, 0x1586B449E1A1DULL, 0x2F17E904AED8AULL, 0x7E1D2861D3C8EULL, 0x404A5CA0AFBAULL }
+		},
+		{
+			{ 0x49E1B2A416FD1ULL, 0x51C6A0B316C57ULL, 0x575A59ED71BDCULL, 0x74C021A1FEC1EULL, 0x39527516E7F8EULL },
+			{ 0x740070AA743D6ULL, 0x16B64CBDD1183ULL, 0x23F4B7B32EB43ULL, 0x319ABA58235B3ULL, 0x46395BFDCADD9ULL },
+			{ 0x7DB2D1A5D9A9CULL, 0x79A200B85422FULL, 0x355BFAA71DD16ULL, 0xB77EA5F78AAULL, 0x76579A29E822DULL }
+		},
+		{
+			{ 0x4B51352B434F2ULL, 0x1327BD01C2667ULL, 0x434D73B60C8A1ULL, 0x3E0DAA89443BAULL, 0x2C514BB2A277ULL },
+			{ 0x68E7E49C02A17ULL, 0x45795346FE8B6ULL, 0x89306C8F3546ULL, 0x6D89F6B2F88F6ULL, 0x43A384DC9E05BULL },
+			{ 0x3D5DA8BF1B645ULL, 0x7DED6A96A6D09ULL, 0x6C3494FEE2F4DULL, 0x2C989C8B6BD4ULL, 0x1160920961548ULL }
+		},
+		{
+			{ 0x5616369B4DCDULL, 0x4ECAB86AC6F47ULL, 0x3C60085D700B2ULL, 0x213EE10DFCEAULL, 0x2F637D7491E6EULL },
+			{ 0x5166929DACFAAULL, 0x190826B31F689ULL, 0x4F55567694A7DULL, 0x705F4F7B1E522ULL, 0x351E125BC5698ULL },
+			{ 0x49B461AF67BBEULL, 0x75915712C3A96ULL, 0x69A67EF580C0DULL, 0x54D38EF70CFFCULL, 0x7F182D06E7CE2ULL }
+		},
+		{
+			{ 0x54B728E217522ULL, 0x69A90971B0128ULL, 0x51A40F2A963A3ULL, 0x10BE9AC12A6BFULL, 0x44ACC043241C5ULL },
+			{ 0x48E64AB0168ECULL, 0x2A2BDB8A86F4FULL, 0x7343B6B2D6929ULL, 0x1D804AA8CE9A3ULL, 0x67D4AC8C343E9ULL },
+			{ 0x56BBB4F7A5777ULL, 0x29230627C238FULL, 0x5AD1A122CD7FBULL, 0xDEA56E50E364ULL, 0x556D1C8312AD7ULL }
+		},
+		{
+			{ 0x6756B11BE821ULL, 0x462147E7BB03EULL, 0x26519743EBFE0ULL, 0x782FC59682AB5ULL, 0x97ABE38CC8C7ULL },
+			{ 0x740E30C8D3982ULL, 0x7C2B47F4682FDULL, 0x5CD91B8C7DC1CULL, 0x77FA790F9E583ULL, 0x746C6C6D1D824ULL },
+			{ 0x1C9877EA52DA4ULL, 0x2B37B83A86189ULL, 0x733AF49310DA5ULL, 0x25E81161C04FBULL, 0x577E14A34BEE8ULL }
+		},
+		{
+			{ 0x6CEBEBD4DD72BULL, 0x340C1E442329FULL, 0x32347FFD1A93FULL, 0x14A89252CBBE0ULL, 0x705304B8FB009ULL },
+			{ 0x268AC61A73B0AULL, 0x206F234BEBE1CULL, 0x5B403A7CBEBE8ULL, 0x7A160F09F4135ULL, 0x60FA7EE96FD78ULL },
+			{ 0x51D354D296EC6ULL, 0x7CBF5A63B16C7ULL, 0x2F50BB3CF0C14ULL, 0x1FEB385CAC65AULL, 0x21398E0CA1635ULL }
+		}
+	},
+	{
+		{
+			{ 0xAAF9B4B75601ULL, 0x26B91B5AE44F3ULL, 0x6DE808D7AB1C8ULL, 0x6A769675530B0ULL, 0x1BBFB284E98F7ULL },
+			{ 0x5058A382B33F3ULL, 0x175A91816913EULL, 0x4F6CDB96B8AE8ULL, 0x17347C9DA81D2ULL, 0x5AA3ED9D95A23ULL },
+			{ 0x777E9C7D96561ULL, 0x28E58F006CCACULL, 0x541BBBB2CAC49ULL, 0x3E63282994CECULL, 0x4A07E14E5E895ULL }
+		},
+		{
+			{ 0x358CDC477A49BULL, 0x3CC88FE02E481ULL, 0x721AAB7F4E36BULL, 0x408CC9469953ULL, 0x50AF7AED84AFAULL },
+			{ 0x412CB980DF999ULL, 0x5E78DD8EE29DCULL, 0x171DFF68C575DULL, 0x2015DD2F6EF49ULL, 0x3F0BAC391D313ULL },
+			{ 0x7DE0115F65BE5ULL, 0x4242C21364DC9ULL, 0x6B75B64A66098ULL, 0x33C0102C085ULL, 0x1921A316BAEBDULL }
+		},
+		{
+			{ 0x2AD9AD9F3C18BULL, 0x5EC1638339AEBULL, 0x5703B6559A83BULL, 0x3FA9F4D05D612ULL, 0x7B049DECA062CULL },
+			{ 0x22F7EDFB870FCULL, 0x569EED677B128ULL, 0x30937DCB0A5AFULL, 0x758039C78EA1BULL, 0x6458DF41E273AULL },
+			{ 0x3E37A35444483ULL, 0x661FDB7D27B99ULL, 0x317761DD621E4ULL, 0x7323C30026189ULL, 0x6093DCCBC2950ULL }
+		},
+		{
+			{ 0x6EEBE6084034BULL, 0x6CF01F70A8D7BULL, 0xB41A54C6670AULL, 0x6C84B99BB55DBULL, 0x6E3180C98B647ULL },
+			{ 0x39A8585E0706DULL, 0x3167CE72663FEULL, 0x63D14ECDB4297ULL, 0x4BE21DCF970B8ULL, 0x57D1EA084827AULL },
+			{ 0x2B6E7A128B071ULL, 0x5B27511755DCFULL, 0x8584C2930565ULL, 0x68C7BDA6F4159ULL, 0x363E999DDD97BULL }
+		},
+		{
+			{ 0x48DCE24BAEC6ULL, 0x2B75795EC05E3ULL, 0x3BFA4C5DA6DC9ULL, 0x1AAC8659E371EULL, 0x231F979BC6F9BULL },
+			{ 0x43C135EE1FC4ULL, 0x2A11C9919F2D5ULL, 0x6334CC25DBACDULL, 0x295DA17B400DAULL, 0x48EE9B78693A0ULL },
+			{ 0x1DE4BCC2AF3C6ULL, 0x61FC411A3EB86ULL, 0x53ED19AC12EC0ULL, 0x209DBC6B804E0ULL, 0x79BFA9B08792ULL }
+		},
+		{
+			{ 0x1ED80A2D54245ULL, 0x70EFEC72A5E79ULL, 0x42151D42A822DULL, 0x1B5EBB6D631E8ULL, 0x1EF4FB1594706ULL },
+			{ 0x3A51DA300DF4ULL, 0x467B52B561C72ULL, 0x4D5920210E590ULL, 0xCA769E789685ULL, 0x38C77F684817ULL },
+			{ 0x65EE65B167BECULL, 0x52DA19B850A9ULL, 0x408665656429ULL, 0x7AB39596F9A4CULL, 0x575EE92A4A0BFULL }
+		},
+		{
+			{ 0x6BC450AA4D801ULL, 0x4F4A6773B0BA8ULL, 0x6241B0B0EBC48ULL, 0x40D9C4F1D9315ULL, 0x200A1E7E382F5ULL },
+			{ 0x80908A182FCFULL, 0x532913B7BA98ULL, 0x3DCCF78C385C3ULL, 0x68002DD5EABA9ULL, 0x43D4E7112CD3FULL },
+			{ 0x5B967EAF93AC5ULL, 0x360ACCA580A31ULL, 0x1C65FD5C6F262ULL, 0x71C7F15C2ECABULL, 0x50ECA52651E4ULL }
+		},
+		{
+			{ 0x4397660E668EAULL, 0x7C2A75692F2F5ULL, 0x3B29E7E6C66EFULL, 0x72BA658BCDA9AULL, 0x6151C09FA131AULL },
+			{ 0x31ADE453F0C9CULL, 0x3DFEE07737868ULL, 0x611ECF7A7D411ULL, 0x2637E6CBD64F6ULL, 0x4B0EE6C21C58FULL },
+			{ 0x55C0DFDF05D96ULL, 0x405569DCF475EULL, 0x5C5C277498BBULL, 0x18588D95DC389ULL, 0x1FEF24FA800F0ULL }
+		}
+	},
+	{
+		{
+			{ 0x2AFF530976B86ULL, 0xD85A48C0845AULL, 0x796EB963642E0ULL, 0x60BEE50C4B626ULL, 0x28005FE6C8340ULL },
+			{ 0x653FB1AA73196ULL, 0x607FAEC8306FAULL, 0x4E85EC83E5254ULL, 0x9F56900584FDULL, 0x544D49292FC86ULL },
+			{ 0x7BA9F34528688ULL, 0x284A20FB42D5DULL, 0x3652CD9706FFEULL, 0x6FD7BADDDE6B3ULL, 0x72E472930F316ULL }
+		},
+		{
+			{ 0x3F635D32A7627ULL, 0xCBECACDE00FEULL, 0x3411141EAA936ULL, 0x21C1E42F3CB94ULL, 0x1FEE7F000FE06ULL },
+			{ 0x5208C9781084FULL, 0x16468A1DC24D2ULL, 0x7BF780AC540A8ULL, 0x1A67ECED75301ULL, 0x5A9D2E8C2733AULL },
+			{ 0x305DA03DBF7E5ULL, 0x1228699B7AECAULL, 0x12A23B2936BC9ULL, 0x2A1BDA56AE6E9ULL, 0xF94051EE040ULL }
+		},
+		{
+			{ 0x793BB07AF9753ULL, 0x1E7B6ECD4FAFDULL, 0x2C7B1560FB43ULL, 0x2296734CC5FB7ULL, 0x47B7FFD25DD40ULL },
+			{ 0x56B23C3D330B2ULL, 0x37608E360D1A6ULL, 0x10AE0F3C8722EULL, 0x86D9B618B637ULL, 0x7D79C7E8BEABULL },
+			{ 0x3FB9CBC08DD12ULL, 0x75C3DD85370FFULL, 0x47F06FE2819ACULL, 0x5DB06AB9215EDULL, 0x1C3520A35EA64ULL }
+		},
+		{
+			{ 0x6F40216BC059ULL, 0x3A2579B0FD9B5ULL, 0x71C26407EEC8CULL, 0x72ADA4AB54F0BULL, 0x38750C3B66D12ULL },
+			{ 0x253A6BCCBA34AULL, 0x427070433701AULL, 0x20B8E58F9870EULL, 0x337C861DB00CCULL, 0x1C3D05775D0EEULL },
+			{ 0x6F1409422E51AULL, 0x7856BBECE2D25ULL, 0x13380A72F031CULL, 0x43E1080A7F3BAULL, 0x621E2C7D3304ULL }
+		},
+		{
+			{ 0x61796B0DBF0F3ULL, 0x73C2F9C32D6F5ULL, 0x6AA8ED1537EBEULL, 0x74E92C91838F4ULL, 0x5D8E589CA1002ULL },
+			{ 0x60CC8259838DULL, 0x38D3F35B95F3ULL, 0x56078C243A923ULL, 0x2DE3293241BB2ULL, 0x7D6097BD3AULL },
+			{ 0x71D950842A94BULL, 0x46B11E5C7D817ULL, 0x5478BBECB4F0DULL, 0x7C3054B0A1C5DULL, 0x1583D7783C1CBULL }
+		},
+		{
+			{ 0x34704CC9D28C7ULL, 0x3DEE598B1F200ULL, 0x16E1C98746D9EULL, 0x4050B7095AFDFULL, 0x4958064E83C55ULL },
+			{ 0x6A2EF5DA27AE1ULL, 0x28AACE02E9D9DULL, 0x2459E965F0E8ULL, 0x7B864D3150933ULL, 0x252A5F2E81ED8ULL },
+			{ 0x94265066E80DULL, 0xA60F918D61A5ULL, 0x444BF7F30FDEULL, 0x1C40DA9ED3C06ULL, 0x79C170BD843BULL }
+		},
+		{
+			{ 0x6CD50C0D5D056ULL, 0x5B7606AE779BAULL, 0x70FBD226BDDA1ULL, 0x5661E53391FF9ULL, 0x6768C0D7317B8ULL },
+			{ 0x6ECE464FA6FFFULL, 0x3CC40BCA460A0ULL, 0x6E3A90AFB8D0CULL, 0x5801ABCA11228ULL, 0x6DEC05E34AC9FULL },
+			{ 0x625E5F155C1B3ULL, 0x4F32F6F723296ULL, 0x5AC980105EFCEULL, 0x17A61165EEE36ULL, 0x51445E14DDCD5ULL }
+		},
+		{
+			{ 0x147AB2BBEA455ULL, 0x1F240F2253126ULL, 0xC3DE9E314E89ULL, 0x21EA5A4FCA45FULL, 0x12E990086E4FDULL },
+			{ 0x2B4B3B144951ULL, 0x5688977966AEAULL, 0x18E176E399FFDULL, 0x2E45C5EB4938BULL, 0x13186F31E3929ULL },
+			{ 0x496B37FDFBB2EULL, 0x3C2439D5F3E21ULL, 0x16E60FE7E6A4DULL, 0x4D7EF889B621DULL, 0x77B2E3F05D3E9ULL }
+		}
+	},
+	{
+		{
+			{ 0x639C12DDB0A4ULL, 0x6180490CD7AB3ULL, 0x3F3918297467CULL, 0x74568BE1781ACULL, 0x7A195152E095ULL },
+			{ 0x7A9C59C2EC4DEULL, 0x7E9F09E79652DULL, 0x6A3E422F22D86ULL, 0x2AE8E3B836C8BULL, 0x63B795FC7AD32ULL },
+			{ 0x68F02389E5FC8ULL, 0x59F1BC877506ULL, 0x504990E410CECULL, 0x9BD7D0FEAEE2ULL, 0x3E8FE83D032F0ULL }
+		},
+		{
+			{ 0x4C8DE8EFD13CULL, 0x1C67C06E6210EULL, 0x183378F7F146AULL, 0x64352CEAED289ULL, 0x22D60899A6258ULL },
+			{ 0x315B90570A294ULL, 0x60CE108A925F1ULL, 0x6EFF61253C909ULL, 0x3EF0E2D70B0ULL, 0x75BA3B797FAC4ULL },
+			{ 0x1DBC070CDD196ULL, 0x16D8FB1534C47ULL, 0x500498183FA2AULL, 0x72F59C423DE75ULL, 0x904D07B87779ULL }
+		},
+		{
+			{ 0x22D6648F940B9ULL, 0x197A5A1873E86ULL, 0x207E4C41A54BCULL, 0x5360B3B4BD6D0ULL, 0x6240AACEBAF72ULL },
+			{ 0x61FD4DDBA919CULL, 0x7D8E991B55699ULL, 0x61B31473CC76CULL, 0x7039631E631D6ULL, 0x43E2143FBC1DDULL },
+			{ 0x4749C5BA295A0ULL, 0x37946FA4B5F06ULL, 0x724C5AB5A51F1ULL, 0x65633789DD3F3ULL, 0x56BDAF238DB40ULL }
+		},
+		{
+			{ 0xD36CC19D3BB2ULL, 0x6EC4470D72262ULL, 0x6853D7018A9AEULL, 0x3AA3E4DC2C8EBULL, 0x3AA31507E1E5ULL },
+			{ 0x2B9E3F53533EBULL, 0x2ADD727A806C5ULL, 0x56955C8CE15A3ULL, 0x18C4F070A290EULL, 0x1D24A86D83741ULL },
+			{ 0x47648FFD4CE1FULL, 0x60A9591839E9DULL, 0x424D5F38117ABULL, 0x42CC46912C10EULL, 0x43B261DC9AEB4ULL }
+		},
+		{
+			{ 0x13D8B6C951364ULL, 0x4C0017E8F632AULL, 0x53E559E53F9C4ULL, 0x4B20146886EEAULL, 0x2B4D5E242940ULL },
+			{ 0x31E1988BB79BBULL, 0x7B82F46B3BCABULL, 0xF7A8CE827B41ULL, 0x5E15816177130ULL, 0x326055CF5B276ULL },
+			{ 0x155CB28D18DF2ULL, 0xC30D9CA11694ULL, 0x2090E27AB3119ULL, 0x208624E7A49B6ULL, 0x27A6C809AE5D3ULL }
+		},
+		{
+			{ 0x4270AC43D6954ULL, 0x2ED4CD95659A5ULL, 0x75C0DB37528F9ULL, 0x2CCBCFD2C9234ULL, 0x221503603D8C2ULL },
+			{ 0x6EBCD1F0DB188ULL, 0x74CEB4B7D1174ULL, 0x7D56168DF4F5CULL, 0xBF79176FD18AULL, 0x2CB67174FF60AULL },
+			{ 0x6CDF9390BE1D0ULL, 0x8E519C7E2B3DULL, 0x253C3D2A50881ULL, 0x21B41448E333DULL, 0x7B1DF4B73890FULL }
+		},
+		{
+			{ 0x6221807F8F58CULL, 0x3FA92813A8BE5ULL, 0x6DA98C38D5572ULL, 0x1ED95554468FULL, 0x68698245D352EULL },
+			{ 0x2F2E0B3B2A224ULL, 0xC56AA22C1C92ULL, 0x5FDEC39F1B278ULL, 0x4C90AF5C7F106ULL, 0x61FCEF2658FC5ULL },
+			{ 0x15D852A18187AULL, 0x270DBB59AFB76ULL, 0x7DB120BCF92ABULL, 0xE7A25D714087ULL, 0x46CF4C473DAF0ULL }
+		},
+		{
+			{ 0x46EA7F1498140ULL, 0x70725690A8427ULL, 0xA73AE9F079FBULL, 0x2DD924461C62BULL, 0x1065AAE50D8CCULL },
+			{ 0x525ED9EC4E5F9ULL, 0x22D20660684CULL, 0x7972B70397B68ULL, 0x7A03958D3F965ULL, 0x29387BCD14EB5ULL },
+			{ 0x44525DF200D57ULL, 0x2D7F94CE94385ULL, 0x60D00C170ECB7ULL, 0x38B0503F3D8F0ULL, 0x69A198E64F1CEULL }
+		}
+	},
+	{
+		{
+			{ 0x14434DCC5CAEDULL, 0x2C7909F667C20ULL, 0x61A839D1FB576ULL, 0x4F23800CABB76ULL, 0x25B2697BD267FULL },
+			{ 0x2B2E0D91A78BCULL, 0x3990A12CCF20CULL, 0x141C2E11F2622ULL, 0xDFCEFAA53320ULL, 0x7369E6A92493AULL },
+			{ 0x73FFB13986864ULL, 0x3282BB8F713ACULL, 0x49CED78F297EFULL, 0x6697027661DEFULL, 0x1420683DB54E4ULL }
+		},
+		{
+			{ 0x6BB6FC1CC5AD0ULL, 0x532C8D591669DULL, 0x1AF794DA86C33ULL, 0xE0E9D86D24D3ULL, 0x31E83B4161D08ULL },
+			{ 0xBD1E249DD197ULL, 0xBCB1820568FULL, 0x2EAB1718830D4ULL, 0x396FD816997E6ULL, 0x60B63BEBF508AULL },
+			{ 0xC7129E062B4FULL, 0x1E526415B12FDULL, 0x461A0FD27923DULL, 0x18BADF670A5B7ULL, 0x55CF1EB62D550ULL }
+		},
+		{
+			{ 0x6B5E37DF58C52ULL, 0x3BCF33986C60EULL, 0x44FB8835CEAE7ULL, 0x99DEC18E71A4ULL, 0x1A56FBAA62BA0ULL },
+			{ 0x1101065C23D58ULL, 0x5AA1290338B0FULL, 0x3157E9E2E7421ULL, 0xEA712017D489ULL, 0x669A656457089ULL },
+			{ 0x66B505C9DC9ECULL, 0x774EF86E35287ULL, 0x4D1D944C0955EULL, 0x52E4C39D72B20ULL, 0x13C4836799C58ULL }
+		},
+		{
+			{ 0x4FB6A5D8BD080ULL, 0x58AE34908589BULL, 0x3954D977BAF13ULL, 0x413EA597441DCULL, 0x50BDC87DC8E5BULL },
+			{ 0x25D465AB3E1B9ULL, 0xF8FE27EC2847ULL, 0x2D6E6DBF04F06ULL, 0x3038CFC1B3276ULL, 0x66F80C93A637BULL },
+			{ 0x537836EDFE111ULL, 0x2BE02357B2C0DULL, 0x6DCEE58C8D4F8ULL, 0x2D732581D6192ULL, 0x1DD56444725FDULL }
+		},
+		{
+			{ 0x7E60008BAC89AULL, 0x23D5C387C1852ULL, 0x79E5DF1F533A8ULL, 0x2E6F9F1C5F0CFULL, 0x3A3A450F63A30ULL },
+			{ 0x47FF83362127DULL, 0x8E39AF82B1F4ULL, 0x488322EF27DABULL, 0x1973738A2A1A4ULL, 0xE645912219F7ULL },
+			{ 0x72F31D8394627ULL, 0x7BD294A200F1ULL, 0x665BE00E274C6ULL, 0x43DE8F1B6368BULL, 0x318C8D9393A9AULL }
+		},
+		{
+			{ 0x69E29AB1DD398ULL, 0x30685B3C76BACULL, 0x565CF37F24859ULL, 0x57B2AC28EFEF9ULL, 0x509A41C325950ULL },
+			{ 0x45D032AFFFE19ULL, 0x12FE49B6CDE4EULL, 0x21663BC327CF1ULL, 0x18A5E4C69F1DDULL, 0x224C7C679A1D5ULL },
+			{ 0x6EDCA6F925E9ULL, 0x68C8363E677B8ULL, 0x60CFA25E4FBCFULL, 0x1C4C17609404EULL, 0x5BFF02328A11ULL }
+		},
+		{
+			{ 0x1A0DD0DC512E4ULL, 0x10894BF5FCD10ULL, 0x52949013F9C37ULL, 0x1F50FBA4735C7ULL, 0x576277CDEE01AULL },
+			{ 0x2137023CAE00BULL, 0x15A3599EB26C6ULL, 0x687221512B3CULL, 0x253CB3A0824E9ULL, 0x780B8CC3FA2A4ULL },
+			{ 0x38ABC234F305FULL, 0x7A280BBC103DEULL, 0x398A836695DFEULL, 0x3D0AF41528A1AULL, 0x5FF418726271BULL }
+		},
+		{
+			{ 0x347E813B69540ULL, 0x76864C21C3CBBULL, 0x1E049DBCD74A8ULL, 0x5B4D60F93749CULL, 0x29D4DB8CA0A0CULL },
+			{ 0x6080C1789DB9DULL, 0x4BE7CEF1EA731ULL, 0x2F40D769D8080ULL, 0x35F7D4C44A603ULL, 0x106A03DC25A96ULL },
+			{ 0x50AAF333353D0ULL, 0x4B59A613CBB35ULL, 0x223DFC0E19A76ULL, 0x77D1E2BB2C564ULL, 0x4AB38A51052CBULL }
+		}
+	},
+	{
+		{
+			{ 0x7D1EF5FDDC09CULL, 0x7BEEAEBB9DAD9ULL, 0x58D30BA0ACFBULL, 0x5CD92EAB5AE90ULL, 0x3041C6BB04ED2ULL },
+			{ 0x42B256768D593ULL, 0x2E88459427B4FULL, 0x2B3876630701ULL, 0x34878D405EAE5ULL, 0x29CDD1ADC088AULL },
+			{ 0x2F2F9D956E148ULL, 0x6B3E6AD65C1FEULL, 0x5B00972B79E5DULL, 0x53D8D234C5DAFULL, 0x104BBD6814049ULL }
+		},
+		{
+			{ 0x59A5FD67FF163ULL, 0x3A998EAD0352BULL, 0x83C95FA4AF9AULL, 0x6FADBFC01266FULL, 0x204F2A20FB072ULL },
+			{ 0xFD3168F1ED67ULL, 0x1BB0DE7784A3EULL, 0x34BCB78B20477ULL, 0xA4A26E2E2182ULL, 0x5BE8CC57092A7ULL },
+			{ 0x43B3D30EBB079ULL, 0x357ACA5C61902ULL, 0x5B570C5D62455ULL, 0x30FB29E1E18C7ULL, 0x2570FB17C2791ULL }
+		},
+		{
+			{ 0x6A9550BB8245AULL, 0x511F20A1A2325ULL, 0x29324D7239BEEULL, 0x3343CC37516C4ULL, 0x241C5F91DE018ULL },
+			{ 0x2367F2CB61575ULL, 0x6C39AC04D87DFULL, 0x6D4958BD7E5BDULL, 0x566F4638A1532ULL, 0x3DCB65EA53030ULL },
+			{ 0x172940DE6CAAULL, 0x6045B2E67451BULL, 0x56C07463EFCB3ULL, 0x728B6BFE6E91ULL, 0x8420EDD5FCDFULL }
+		},
+		{
+			{ 0xC34E04F410CEULL, 0x344EDC0D0A06BULL, 0x6E45486D84D6DULL, 0x44E2ECB3863F5ULL, 0x4D654F321DB8ULL },
+			{ 0x720AB8362FA4AULL, 0x29C4347CDD9BFULL, 0xE798AD5F8463ULL, 0x4FEF18BCB0BFEULL, 0xD9A53EFBC176ULL },
+			{ 0x5C116DDBDB5D5ULL, 0x6D1B4BBA5ABCFULL, 0x4D28A48A5537AULL, 0x56B8E5B040B99ULL, 0x4A7A4F2618991ULL }
+		},
+		{
+			{ 0x3B291AF372A4BULL, 0x60E3028FE4498ULL, 0x2267BCA4F6A09ULL, 0x719EEC242B243ULL, 0x4A96314223E0EULL },
+			{ 0x718025FB15F95ULL, 0x68D6B8371FE94ULL, 0x3804448F7D97CULL, 0x42466FE784280ULL, 0x11B50C4CDDD31ULL },
+			{ 0x274408A4FFD6ULL, 0x7D382AEDB34DDULL, 0x40ACFC9CE385DULL, 0x628BB99A45B1EULL, 0x4F4BCE4DCE6BCULL }
+		},
+		{
+			{ 0x2616EC49D0B6FULL, 0x1F95D8462E61CULL, 0x1AD3E9B9159C6ULL, 0x79BA475A04DF9ULL, 0x3042CEE561595ULL },
+			{ 0x7CE5AE2242584ULL, 0x2D25EB153D4E3ULL, 0x3A8F3D09BA9C9ULL, 0xF3690D04EB8EULL, 0x73FCDD14B71C0ULL },
+			{ 0x67079449BAC41ULL, 0x5B79C4621484FULL, 0x61069F2156B8DULL, 0xEB26573B10AFULL, 0x389E740C9A9CEULL }
+		},
+		{
+			{ 0x578F6570EAC28ULL, 0x644F2339C3937ULL, 0x66E47B7956C2CULL, 0x34832FE1F55D0ULL, 0x25C425E5D6263ULL },
+			{ 0x4B3AE34DCB9CEULL, 0x47C691A15AC9FULL, 0x318E06E5D400CULL, 0x3C422D9F83EB1ULL, 0x61545379465A6ULL },
+			{ 0x606A6F1D7DE6EULL, 0x4F1C0C46107E7ULL, 0x229B1DCFBE5D8ULL, 0x3ACC60A7B1327ULL, 0x6539A08915484ULL }
+		},
+		{
+			{ 0x4DBD414BB4A19ULL, 0x7930849F1DBB8ULL, 0x329C5A466CAF0ULL, 0x6C824544FEB9BULL, 0xF65320EF019BULL },
+			{ 0x21F74C3D2F773ULL, 0x24B88D08BD3AULL, 0x6E678CF054151ULL, 0x43631272E747CULL, 0x11C5E4AAC5CD1ULL },
+			{ 0x6D1B1CAFDE0C6ULL, 0x462C76A303A90ULL, 0x3CA4E693CFF9BULL, 0x3952CD45786FDULL, 0x4CABC7BDEC330ULL }
+		}
+	},
+	{
+		{
+			{ 0x7788F3F78D289ULL, 0x5942809B3F811ULL, 0x5973277F8C29CULL, 0x10F93BC5FE67ULL, 0x7EE498165ACB2ULL },
+			{ 0x69624089C0A2EULL, 0x75FC8E70473ULL, 0x13E84AB1D2313ULL, 0x2C10BEDF6953BULL, 0x639B93F0321C8ULL },
+			{ 0x508E39111A1C3ULL, 0x290120E912F7AULL, 0x1CBF464ACAE43ULL, 0x15373E9576157ULL, 0xEDF493C85B60ULL }
+		},
+		{
+			{ 0x7C4D284764113ULL, 0x7FEFEBF06ACECULL, 0x39AFB7A824100ULL, 0x1B48E47E7FD65ULL, 0x4C00C54D1DFAULL },
+			{ 0x48158599B5A68ULL, 0x1FD75BC41D5D9ULL, 0x2D9FC1FA95D3CULL, 0x7DA27F20EBA11ULL, 0x403B92E3019D4ULL },
+			{ 0x22F818B465CF8ULL, 0x342901DFF09B8ULL, 0x31F595DC683CDULL, 0x37A57745FD682ULL, 0x355BB12AB2617ULL }
+		},
+		{
+			{ 0x1DAC75A8C7318ULL, 0x3B679D5423460ULL, 0x6B8FCB7B6400EULL, 0x6C73783BE5F9DULL, 0x7518EAF8E052AULL },
+			{ 0x664CC7493BBF4ULL, 0x33D94761874E3ULL, 0x179E1796F613ULL, 0x1890535E2867DULL, 0xF9B8132182ECULL },
+			{ 0x59C41B7F6C32ULL, 0x79E8706531491ULL, 0x6C747643CB582ULL, 0x2E20C0AD494E4ULL, 0x47C3871BBB175ULL }
+		},
+		{
+			{ 0x65D50C85066B0ULL, 0x6167453361F7CULL, 0x6BA3818BB312ULL, 0x6AFF29BAA7522ULL, 0x8FEA02CE8D48ULL },
+			{ 0x4539771EC4F48ULL, 0x7B9318BADCA28ULL, 0x70F19AFE016C5ULL, 0x4EE7BB1608D23ULL, 0xB89B8576469ULL },
+			{ 0x5DD7668DEEAD0ULL, 0x4096D0BA47049ULL, 0x6275997219114ULL, 0x29BDA8A67E6AEULL, 0x473829A74F75DULL }
+		},
+		{
+			{ 0x1533AAD3902C9ULL, 0x1DDE06B11E47BULL, 0x784BED1930B77ULL, 0x1C80A92B9C867ULL, 0x6C668B4D44E4DULL },
+			{ 0x2DA754679C418ULL, 0x3164C31BE105AULL, 0x11FAC2B98EF5FULL, 0x35A1AAF779256ULL, 0x2078684C4833CULL },
+			{ 0xCF217A78820CULL, 0x65024E7D2E769ULL, 0x23BB5EFDDA82AULL, 0x19FD4B632D3C6ULL, 0x7411A6054F8A4ULL }
+		},
+		{
+			{ 0x2E53D18B175B4ULL, 0x33E7254204AF3ULL, 0x3BCD7D5A1C4C5ULL, 0x4C7C22AF65D0FULL, 0x1EC9A872458C3ULL },
+			{ 0x59D32B99DC86DULL, 0x6AC075E22A9ACULL, 0x30B9220113371ULL, 0x27FD9A638966EULL, 0x7C136574FB813ULL },
+			{ 0x6A4D400A2509BULL, 0x41791056971CULL, 0x655D5866E075CULL, 0x2302BF3E64DF8ULL, 0x3ADD88A5C7CD6ULL }
+		},
+		{
+			{ 0x298D459393046ULL, 0x30BFECB3D90B8ULL, 0x3D9B8EA3DF8D6ULL, 0x3900E96511579ULL, 0x61BA1131A406AULL },
+			{ 0x15770B635DCF2ULL, 0x59ECD83F79571ULL, 0x2DB461C0B7FBDULL, 0x73A42A981345FULL, 0x249929FCCC879ULL },
+			{ 0xA0F116959029ULL, 0x5974FD7B1347AULL, 0x1E0CC1C08EDADULL, 0x673BDF8AD1F13ULL, 0x5620310CBBD8EULL }
+		},
+		{
+			{ 0x6B5F477E285D6ULL, 0x4ED91EC326CC8ULL, 0x6D6537503A3FDULL, 0x626D3763988D5ULL, 0x7EC846F3658CEULL },
+			{ 0x193434934D643ULL, 0xD4A2445EAA51ULL, 0x7D0708AE76FE0ULL, 0x39847B6C3C7E1ULL, 0x37676A2A4D9D9ULL },
+			{ 0x68F3F1DA22EC7ULL, 0x6ED8039A2736BULL, 0x2627EE04C3C75ULL, 0x6EA90A647E7D1ULL, 0x6DAAF723399B9ULL }
+		}
+	},
+	{
+		{
+			{ 0x304BFACAD8EA2ULL, 0x502917D108B07ULL, 0x43176CA6DD0FULL, 0x5D5158F2C1D84ULL, 0x2B5449E58EB3BULL },
+			{ 0x27562EB3DBE47ULL, 0x291D7B4170BE7ULL, 0x5D1CA67DFA8E1ULL, 0x2A88061F298A2ULL, 0x1304E9E71627DULL },
+			{ 0x14D26ADC9CFEULL, 0x7F1691BA16F13ULL, 0x5E71828F06EACULL, 0x349ED07F0FFFCULL, 0x4468DE2D7C2DDULL }
+		},
+		{
+			{ 0x2D8C6F86307CEULL, 0x6286BA1850973ULL, 0x5E9DCB08444D4ULL, 0x1A96A543362B2ULL, 0x5DA6427E63247ULL },
+			{ 0x3355E9419469EULL, 0x1847BB8EA8A37ULL, 0x1FE6588CF9B71ULL, 0x6B1C9D2DB6B22ULL, 0x6CCE7C6FFB44BULL },
+			{ 0x4C688DEAC22CAULL, 0x6F775C3FF0352ULL, 0x565603EE419BBULL, 0x6544456C61C46ULL, 0x58F29ABFE79F2ULL }
+		},
+		{
+			{ 0x264BF710ECDF6ULL, 0x708C58527896BULL, 0x42CEAE6C53394ULL, 0x4381B21E82B6AULL, 0x6AF93724185B4ULL },
+			{ 0x6CFAB8DE73E68ULL, 0x3E6EFCED4BD21ULL, 0x56609500DBEULL, 0x71B7824AD85DFULL, 0x577629C4A7F41ULL },
+			{ 0x24509C6A888ULL, 0x2696AB12E6644ULL, 0xCCA27F4B80D8ULL, 0xC7C1F11B119EULL, 0x701F25BB0CAECULL }
+		},
+		{
+			{ 0xF6D97CBEC113ULL, 0x4CE97FB7C93A3ULL, 0x139835A11281BULL, 0x728907ADA9156ULL, 0x720A5BC050955ULL },
+			{ 0xB0F8E4616CEDULL, 0x1D3C4B50FB875ULL, 0x2F29673DC0198ULL, 0x5F4B0F1830FFAULL, 0x2E0C92BFBDC40ULL },
+			{ 0x709439B805A35ULL, 0x6EC48557F8187ULL, 0x8A4D1BA13A2CULL, 0x76348A0BF9AEULL, 0xE9B9CBB144EFULL }
+		},
+		{
+			{ 0x69BD55DB1BEEEULL, 0x6E14E47F731BDULL, 0x1A35E47270EACULL, 0x66F225478DF8EULL, 0x366D44191CFD3ULL },
+			{ 0x2D48FFB5720ADULL, 0x57B7F21A1DF77ULL, 0x5550EFFBA0645ULL, 0x5EC6A4098A931ULL, 0x221104EB3F337ULL },
+			{ 0x41743F2BC8C14ULL, 0x796B0AD8773C7ULL, 0x29FEE5CBB689BULL, 0x122665C178734ULL, 0x4167A4E6BC593ULL }
+		},
+		{
+			{ 0x62665F8CE8FEEULL, 0x29D101AC59857ULL, 0x4D93BBBA59FFCULL, 0x17B7897373F17ULL, 0x34B33370CB7EDULL },
+			{ 0x39D2876F62700ULL, 0x1CECD1D6C87ULL, 0x7F01A11747675ULL, 0x2350DA5A18190ULL, 0x7938BB7E22552ULL },
+			{ 0x591EE8681D6CCULL, 0x39DB0B4EA79B8ULL, 0x202220F380842ULL, 0x2F276BA42E0ACULL, 0x1176FC6E2DFE6ULL }
+		},
+		{
+			{ 0xE28949770EB8ULL, 0x5559E88147B72ULL, 0x35E1E6E63EF30ULL, 0x35B109AA7FF6FULL, 0x1F6A3E54F2690ULL },
+			{ 0x76CD05B9C619BULL, 0x69654B0901695ULL, 0x7A53710B77F27ULL, 0x79A1EA7D28175ULL, 0x8FC3A4C677D5ULL },
+			{ 0x4C199D30734EAULL, 0x6C622CB9ACC14ULL, 0x5660A55030216ULL, 0x68F1199F11FBULL, 0x4F2FAD0116B90ULL }
+		},
+		{
+			{ 0x4D91DB73BB638ULL, 0x55F82538112C5ULL, 0x6D85A279815DEULL, 0x740B7B0CD9CF9ULL, 0x3451995F2944EULL },
+			{ 0x6B24194AE4E54ULL, 0x2230AFDED8897ULL, 0x23412617D5071ULL, 0x3D5D30F35969BULL, 0x445484A4972EFULL },
+			{ 0x2FCD09FEA7D7CULL, 0x296126B9ED22AULL, 0x4A171012A05B2ULL, 0x1DB92C74D5523ULL, 0x10B89CA604289ULL }
+		}
+	},
+	{
+		{
+			{ 0x141BE5A45F06EULL, 0x5ADB38BECAEA7ULL, 0x3FD46DB41F2BBULL, 0x6D488BBB5CE39ULL, 0x17D2D1D9EF0D4ULL },
+			{ 0x147499718289CULL, 0xA48A67E4C7ABULL, 0x30FBC544BAFE3ULL, 0xC701315FE58AULL, 0x20B878D577B75ULL },
+			{ 0x2AF18073F3E6AULL, 0x33AEA420D24FEULL, 0x298008BF4FF94ULL, 0x3539171DB961EULL, 0x72214F63CC65CULL }
+		},
+		{
+			{ 0x5B7B9F43B29C9ULL, 0x149EA31EEA3B3ULL, 0x4BE7713581609ULL, 0x2D87960395E98ULL, 0x1F24AC855A154ULL },
+			{ 0x37F405307A693ULL, 0x2E5E66CF2B69CULL, 0x5D84266AE9C53ULL, 0x5E4EB7DE853B9ULL, 0x5FDF48C58171CULL },
+			{ 0x608328E9505AAULL, 0x22182841DC49AULL, 0x3EC96891D2307ULL, 0x2F363FFF22E03ULL, 0xBA739E2AE39ULL }
+		},
+		{
+			{ 0x426F5EA88BB26ULL, 0x33092E77F75C8ULL, 0x1A53940D819E7ULL, 0x1132E4F818613ULL, 0x72297DE7D518DULL },
+			{ 0x698DE5C8790D6ULL, 0x268B8545BEB25ULL, 0x6D2648B96FEDFULL, 0x47988AD1DB07CULL, 0x3283A3E67AD7ULL },
+			{ 0x41DC7BE0CB939ULL, 0x1B16C66100904ULL, 0xA24C20CBC66DULL, 0x4A2E9EFE48681ULL, 0x5E1296846271ULL }
+		},
+		{
+			{ 0x7BBC8242C4550ULL, 0x59A06103B35B7ULL, 0x7237E4AF32033ULL, 0x726421AB3537AULL, 0x78CF25D38258CULL },
+			{ 0x2EEB32D9C495AULL, 0x79E25772F9750ULL, 0x6D747833BBF23ULL, 0x6CDD816D5D749ULL, 0x39C00C9C13698ULL },
+			{ 0x66B8E31489D68ULL, 0x573857E10E2B5ULL, 0x13BE816AA1472ULL, 0x41964D3AD4BF8ULL, 0x6B52076B3FFULL }
+		},
+		{
+			{ 0x37E16B9CE082DULL, 0x1882F57853EB9ULL, 0x7D29EACD01FC5ULL, 0x2E76A59B5E715ULL, 0x7DE2E9561A9F7ULL },
+			{ 0xCFE19D95781CULL, 0x312CC621C453CULL, 0x145ACE6DA077CULL, 0x912BEF9CE9B8ULL, 0x4D57E3443BC76ULL },
+			{ 0xD4F4B6A55ECBULL, 0x7EBB0BB733BCEULL, 0x7BA6A05200549ULL, 0x4F6EDE4E22069ULL, 0x6B2A90AF1A602ULL }
+		},
+		{
+			{ 0x3F3245BB2D80AULL, 0xE5F720F36EFDULL, 0x3B9CCCF60C06DULL, 0x84E323F37926ULL, 0x465812C8276C2ULL },
+			{ 0x3F4FC9AE61E97ULL, 0x3BC07EBFA2D24ULL, 0x3B744B55CD4A0ULL, 0x72553B25721F3ULL, 0x5FD8F4E9D12D3ULL },
+			{ 0x3BEB22A1062D9ULL, 0x6A7063B82C9A8ULL, 0xA5A35DC197EDULL, 0x3C80C06A53DEFULL, 0x5B32C2B1CB16ULL }
+		},
+		{
+			{ 0x4A42C7AD58195ULL, 0x5C8667E799EFFULL, 0x2E5E74C850A1ULL, 0x3F0DB614E869AULL, 0x31771A4856730ULL },
+			{ 0x5ECCD24DA8FDULL, 0x580BBFDF07918ULL, 0x7E73586873C6AULL, 0x74CEDDF77F93EULL, 0x3B5556A37B471ULL },
+			{ 0xC524E14DD482ULL, 0x283457496C656ULL, 0xAD6BCFB6CD45ULL, 0x375D1E8B02414ULL, 0x4FC079D27A733ULL }
+		},
+		{
+			{ 0x48B440C86C50DULL, 0x139929CCA3B86ULL, 0xF8F2E44CDF2FULL, 0x68432117BA6B2ULL, 0x241170C2BAE3CULL },
+			{ 0x138B089BF2F7FULL, 0x4A05BFD34EA39ULL, 0x203914C925EF5ULL, 0x7497FFFE04E3CULL, 0x124567CECAF98ULL },
+			{ 0x1AB860AC473B4ULL, 0x5C0227C86A7FFULL, 0x71B12BFC24477ULL, 0x6A573A83075ULL, 0x3F8612966C870ULL }
+		}
+	},
+	{
+		{
+			{ 0xFCFA36048D13ULL, 0x66E7133BBB383ULL, 0x64B42A8A45676ULL, 0x4EA6E4F9A85CFULL, 0x26F57EEE878A1ULL },
+			{ 0x20CC9782A0DDEULL, 0x65D4E3070AAB3ULL, 0x7BC8E31547736ULL, 0x9EBFB1432D98ULL, 0x504AA77679736ULL },
+			{ 0x32CD55687EFB1ULL, 0x4448F5E2F6195ULL, 0x568919D460345ULL, 0x34C2E0AD1A27ULL, 0x4041943D9DBA3ULL }
+		},
+		{
+			{ 0x17743A26CAADDULL, 0x48C9156F9C964ULL, 0x7EF278D1E9AD0ULL, 0xCE58EA7BD01ULL, 0x12D931429800DULL },
+			{ 0xEEBA43EBCC96ULL, 0x384DD5395F878ULL, 0x1DF331A35D272ULL, 0x207ECFD4AF70EULL, 0x1420A1D976843ULL },
+			{ 0x67799D337594FULL, 0x1647548F6018ULL, 0x57FCE5578F145ULL, 0x9220C142A71ULL, 0x1B4F92314359AULL }
+		},
+		{
+			{ 0x73030A49866B1ULL, 0x2442BE90B2679ULL, 0x77BD3D8947DCFULL, 0x1FB55C1552028ULL, 0x5FF191D56F9A2ULL },
+			{ 0x4109D89150951ULL, 0x225BD2D2D47CBULL, 0x57CC080E73BEAULL, 0x6D71075721FCBULL, 0x239B572A7F132ULL },
+			{ 0x6D433AC2D9068ULL, 0x72BF930A47033ULL, 0x64FACF4A20EADULL, 0x365F7A2B9402AULL, 0x20C526A758F3ULL }
+		},
+		{
+			{ 0x1EF59F042CC89ULL, 0x3B1C24976DD26ULL, 0x31D665CB16272ULL, 0x28656E470C557ULL, 0x452CFE0A5602CULL },
+			{ 0x34F89ED8DBBCULL, 0x73B8F948D8EF3ULL, 0x786C1D323CAABULL, 0x43BD4A9266E51ULL, 0x2AACC4615313ULL },
+			{ 0xF7A0647877DFULL, 0x4E1CC0F93F0D4ULL, 0x7EC4726EF1190ULL, 0x3BDD58BF512F8ULL, 0x4CFB7D7B304B8ULL }
+		},
+		{
+			{ 0x699C29789EF12ULL, 0x63BEAE321BC50ULL, 0x325C340ADBB35ULL, 0x562E1A1E42BF6ULL, 0x5B1D4CBC434D3ULL },
+			{ 0x43D6CB89B75FEULL, 0x3338D5B900E56ULL, 0x38D327D531A53ULL, 0x1B25C61D51B9FULL, 0x14B4622B39075ULL },
+			{ 0x32615CC0A9F26ULL, 0x57711B99CB6DFULL, 0x5A69C14E93C38ULL, 0x6E88980A4C599ULL, 0x2F98F71258592ULL }
+		},
+		{
+			{ 0x2AE444F54A701ULL, 0x615397AFBC5C2ULL, 0x60D7783F3F8FBULL, 0x2AA675FC486BAULL, 0x1D8062E9E7614ULL },
+			{ 0x4A74CB50F9E56ULL, 0x531D1C2640192ULL, 0xC03D9D6C7FD2ULL, 0x57CCD156610C1ULL, 0x3A6AE249D806AULL },
+			{ 0x2DA85A9907C5AULL, 0x6B23721EC4CAFULL, 0x4D2D3A4683AA2ULL, 0x7F9C6870EFDEFULL, 0x298B8CE8AEF25ULL }
+		},
+		{
+			{ 0x272EA0A2165DEULL, 0x68179EF3ED06FULL, 0x4E2B9C0FEAC1EULL, 0x3EE290B1B63BBULL, 0x6BA6271803A7DULL },
+			{ 0x27953EFF70CB2ULL, 0x54F22AE0EC552ULL, 0x29F3DA92E2724ULL, 0x242CA0C22BD18ULL, 0x34B8A8404D5CEULL },
+			{ 0x6ECB583693335ULL, 0x3EC76BFDFB84DULL, 0x2C895CF56A04FULL, 0x6355149D54D52ULL, 0x71D62BDD465E1ULL }
+		},
+		{
+			{ 0x5B5DAB1F75EF5ULL, 0x1E2D60CBEB9A5ULL, 0x527C2175DFE57ULL, 0x59E8A2B8FF51FULL, 0x1C333621262B2ULL },
+			{ 0x3CC28D378DF80ULL, 0x72141F4968CA6ULL, 0x407696BDB6D0DULL, 0x5D271B22FFCFBULL, 0x74D5F317F3172ULL },
+			{ 0x7E55467D9CA81ULL, 0x6A5653186F50DULL, 0x6B188ECE62DF1ULL, 0x4C66D36844971ULL, 0x4AEBCC4547E9DULL }
+		}
+	},
+	{
+		{
+			{ 0x8D9E7354B610ULL, 0x26B750B6DC168ULL, 0x162881E01ACC9ULL, 0x7966DF31D01A5ULL, 0x173BD9DDC9A1DULL },
+			{ 0x71B276D01C9ULL, 0xB0D8918E025EULL, 0x75BEEA79EE2EBULL, 0x3C92984094DB8ULL, 0x5D88FBF95A3DBULL },
+			{ 0xF1EFE5872DFULL, 0x5DA872318256AULL, 0x59CEB81635960ULL, 0x18CF37693C764ULL, 0x6E1CD13B19EAULL }
+		},
+		{
+			{ 0x3AF629E5B0353ULL, 0x204F1A088E8E5ULL, 0x10EFC9CEEA82EULL, 0x589863C2FA34BULL, 0x7F3A6A1A8D837ULL },
+			{ 0xAD516F166F23ULL, 0x263F56D57C81AULL, 0x13422384638CAULL, 0x1331FF1AF0A50ULL, 0x3080603526E16ULL },
+			{ 0x644395D3D800BULL, 0x2B9203DBEDEFCULL, 0x4B18CE656A355ULL, 0x3F3466BC182CULL, 0x30D0FDED2E513ULL }
+		},
+		{
+			{ 0x4971E68B84750ULL, 0x52CCC9779F396ULL, 0x3E904AE8255C8ULL, 0x4ECAE46F39339ULL, 0x4615084351C58ULL },
+			{ 0x14D1AF21233B3ULL, 0x1DE1989B39C0BULL, 0x52669DC6F6F9EULL, 0x43434B28C3FC7ULL, 0xA9214202C099ULL },
+			{ 0x19C0AEB9A02EULL, 0x1A2C06995D792ULL, 0x664CBB1571C44ULL, 0x6FF0736FA80B2ULL, 0x3BCA0D2895CA5ULL }
+		},
+		{
+			{ 0x8EB69ECC01BFULL, 0x5B4C8912DF38DULL, 0x5EA7F8BC2F20EULL, 0x120E516CAAFAFULL, 0x4EA8B4038DF28ULL },
+			{ 0x31BC3C5D62A4ULL, 0x7D9FE0F4C081EULL, 0x43ED51467F22CULL, 0x1E6CC0C1ED109ULL, 0x5631DEDDAE8F1ULL },
+			{ 0x5460AF1CAD202ULL, 0xB4919DD0655DULL, 0x7C4697D18C14CULL, 0x231C890BBA2A4ULL, 0x24CE0930542CAULL }
+		},
+		{
+			{ 0x7A155FDF30B85ULL, 0x1C6C6E5D487F9ULL, 0x24BE1134BDC5AULL, 0x1405970326F32ULL, 0x549928A7324F4ULL },
+			{ 0x90F5FD06C106ULL, 0x6ABB1021E43FDULL, 0x232BCFAD711A0ULL, 0x3A5C13C047F37ULL, 0x41D4E3C28A06DULL },
+			{ 0x632A763EE1A2EULL, 0x6FA4BFFBD5E4DULL, 0x5FD35A6BA4792ULL, 0x7B55E1DE99DE8ULL, 0x491B66DEC0DCFULL }
+		},
+		{
+			{ 0x4A8ED0DA64A1ULL, 0x5ECFC45096EBEULL, 0x5EDEE93B488B2ULL, 0x5B3C11A51BC8FULL, 0x4CF6B8B0B7018ULL },
+			{ 0x5B13DC7EA32A7ULL, 0x18FC2DB73131EULL, 0x7E3651F8F57E3ULL, 0x25656055FA965ULL, 0x8F338D0C85EEULL },
+			{ 0x3A821991A73BDULL, 0x3BE6418F5870ULL, 0x1DDC18EAC9EF0ULL, 0x54CE09E998DC2ULL, 0x530D4A82EB078ULL }
+		},
+		{
+			{ 0x173456C9ABF9EULL, 0x7892015100DADULL, 0x33EE14095FECBULL, 0x6AD95D67A0964ULL, 0xDB3E7E00CBFBULL },
+			{ 0x43630E1F94825ULL, 0x4D1956A6B4009ULL, 0x213FE2DF8B5E0ULL, 0x5CE3A41191E6ULL, 0x65EA753F10177ULL },
+			{ 0x6FC3EE2096363ULL, 0x7EC36B96D67ACULL, 0x510EC6A0758B1ULL, 0xED87DF022109ULL, 0x2A4EC1921E1AULL }
+		},
+		{
+			{ 0x6162F1CF795FULL, 0x324DDCAFE5EB9ULL, 0x18D5E0463218ULL, 0x7E78B9092428EULL, 0x36D12B5DEC067ULL },
+			{ 0x6259A3B24B8A2ULL, 0x188B5F4170B9CULL, 0x681C0DEE15DEBULL, 0x4DFE665F37445ULL, 0x3D143C5112780ULL },
+			{ 0x5279179154557ULL, 0x39F8F0741424DULL, 0x45E6EB357923DULL, 0x42C9B5EDB746FULL, 0x2EF517885BA82ULL }
+		}
+	},
+	{
+		{
+			{ 0x6BFFB305B2F51ULL, 0x5B112B2D712DDULL, 0x35774974FE4E2ULL, 0x4AF87A96E3A3ULL, 0x57968290BB3A0ULL },
+			{ 0x7974E8C58AEDCULL, 0x7757E083488C6ULL, 0x601C62AE7BC8BULL, 0x45370C2ECAB74ULL, 0x2F1B78FAB143AULL },
+			{ 0x2B8430A20E101ULL, 0x1A49E1D88FEE3ULL, 0x38BBB47CE4D96ULL, 0x1F0E7BA84D437ULL, 0x7DC43E35DC2AAULL }
+		},
+		{
+			{ 0x2A5C273E9718ULL, 0x32BC9DFB28B4FULL, 0x48DF4F8D5DB1AULL, 0x54C87976C028FULL, 0x44FB81D82D50ULL },
+			{ 0x66665887DD9C3ULL, 0x629760A6AB0B2ULL, 0x481E6C7243E6CULL, 0x97E37046FC77ULL, 0x7EF72016758CCULL },
+			{ 0x718C5A907E3D9ULL, 0x3B9C98C6B383BULL, 0x6ED255ECCDCULL, 0x6976538229A59ULL, 0x7F79823F9C30DULL }
+		},
+		{
+			{ 0x41FF068F587BAULL, 0x1C00A191BCD53ULL, 0x7B56F9C209E25ULL, 0x3781E5FCCAABEULL, 0x64A9B0431C06DULL },
+			{ 0x4D239A3B513E8ULL, 0x29723F51B1066ULL, 0x642F4CF04D9C3ULL, 0x4DA095AA09B7AULL, 0xA4E0373D784DULL },
+			{ 0x3D6A15B7D2919ULL, 0x41AA75046A5D6ULL, 0x691751EC2D3DAULL, 0x23638AB6721C4ULL, 0x71A7D0ACE183ULL }
+		},
+		{
+			{ 0x4355220E14431ULL, 0xE1362A283981ULL, 0x2757CD8359654ULL, 0x2E9CD7AB10D90ULL, 0x7C69BCF761775ULL },
+			{ 0x72DAAC887BA0BULL, 0xB7F4AC5DDA60ULL, 0x3BDDA2C0498A4ULL, 0x74E67AA180160ULL, 0x2C3BCC7146EA7ULL },
+			{ 0xD7EB04E8295FULL, 0x4A5EA1E6FA0FEULL, 0x45E635C436C60ULL, 0x28EF4A8D4D18BULL, 0x6F5A9A7322ACAULL }
+		},
+		{
+			{ 0x1D4EBA3D944BEULL, 0x100F15F3DCE5ULL, 0x61A700E367825ULL, 0x5922292AB3D23ULL, 0x2AB9680EE8D3ULL },
+			{ 0x1000C2F41C6C5ULL, 0x219FDF737174ULL, 0x314727F127DE7ULL, 0x7E5277D23B81EULL, 0x494E21A2E147AULL },
+			{ 0x48A85DDE50D9AULL, 0x1C1F734493DF4ULL, 0x47BDB64866889ULL, 0x59A7D048F8EECULL, 0x6B5D76CBEA46BULL }
+		},
+		{
+			{ 0x141171E782522ULL, 0x6806D26DA7C1FULL, 0x3F31D1BC79AB9ULL, 0x9F20459F5168ULL, 0x16FB869C03DD3ULL },
+			{ 0x7556CEC0CD994ULL, 0x5EB9A03B7510AULL, 0x50AD1DD91CB71ULL, 0x1AA5780B48A47ULL, 0xAE333F685277ULL },
+			{ 0x6199733B60962ULL, 0x69B157C266511ULL, 0x64740F893F1CAULL, 0x3AA408FBF684ULL, 0x3F81E38B8F70DULL }
+		},
+		{
+			{ 0x37F355F17C824ULL, 0x7AE85334815BULL, 0x7E3ABDDD2E48FULL, 0x61EEABE1F45E5ULL, 0xAD3E2D34CDEDULL },
+			{ 0x10FCC7ED9AFFEULL, 0x4248CB0E96FF2ULL, 0x4311C115172E2ULL, 0x4C9D41CBF6925ULL, 0x50510FC104F50ULL },
+			{ 0x40FC5336E249DULL, 0x3386639FB2DE1ULL, 0x7BBF871D17B78ULL, 0x75F796B7E8004ULL, 0x127C158BF0FA1ULL }
+		},
+		{
+			{ 0x28FC4AE51B974ULL, 0x26E89BFD2DBD4ULL, 0x4E122A07665CFULL, 0x7CAB1203405C3ULL, 0x4ED82479D167DULL },
+			{ 0x17C422E9879A2ULL, 0x28A5946C8FEC3ULL, 0x53AB32E912B77ULL, 0x7B44DA09FE0A5ULL, 0x354EF87D07EF4ULL },
+			{ 0x3B52260C5D975ULL, 0x79D6836171FDCULL, 0x7D994F140D4BBULL, 0x1B6C404561854ULL, 0x302D92D205392ULL }
+		}
+	},
+	{
+		{
+			{ 0x46FB6E4E0F177ULL, 0x53497AD5265B7ULL, 0x1EBDBA01386FCULL, 0x302F0CB36A3CULL, 0xEDC5F5EB426DULL },
+			{ 0x3C1A2BCA4283DULL, 0x23430C7BB2F02ULL, 0x1A3EA1BB58BC2ULL, 0x7265763DE5C61ULL, 0x10E5D3B76F1CAULL },
+			{ 0x3BFD653DA8E67ULL, 0x584953EC82A8AULL, 0x55E288FA7707BULL, 0x5395FC3931D81ULL, 0x45B46C51361CBULL }
+		},
+		{
+			{ 0x54DDD8A7FE3E4ULL, 0x2CECC41C619D3ULL, 0x43A6562AC4D91ULL, 0x4EFA5ACA7BDD9ULL, 0x5C1C0AEF32122ULL },
+			{ 0x2ABF314F7FA1ULL, 0x391D19E8A1528ULL, 0x6A2FA13895FC7ULL, 0x9D8EDDEAA591ULL, 0x2177BFA36DCB7ULL },
+			{ 0x1BBCFA79DB8FULL, 0x3D84BEB3666E1ULL, 0x20C921D812204ULL, 0x2DD843D3B32CEULL, 0x4AE619387D8ABULL }
+		},
+		{
+			{ 0x17E44985BFB83ULL, 0x54E32C626CC22ULL, 0x96412FF38118ULL, 0x6B241D61A246AULL, 0x75685ABE5BA43ULL },
+			{ 0x3F6AA5344A32EULL, 0x69683680F11BBULL, 0x4C3581F623AAULL, 0x701AF5875CBA5ULL, 0x1A00D91B17BF3ULL },
+			{ 0x60933EB61F2B2ULL, 0x5193FE92A4DD2ULL, 0x3D995A550F43EULL, 0x3556FB93A883DULL, 0x135529B623B0EULL }
+		},
+		{
+			{ 0x716BCE22E83FEULL, 0x33D0130B83EB8ULL, 0x952ABAD0AFACULL, 0x309F64ED31B8AULL, 0x5972EA051590AULL },
+			{ 0xDBD7ADD1D518ULL, 0x119F823E2231EULL, 0x451D66E5E7DE2ULL, 0x500C39970F838ULL, 0x79B5B81A65CA3ULL },
+			{ 0x4AC20DC8F7811ULL, 0x29589A9F501FAULL, 0x4D810D26A6B4AULL, 0x5EDE00D96B259ULL, 0x4F7E9C95905F3ULL }
+		},
+		{
+			{ 0x443D355299FEULL, 0x39B7D7D5AEE39ULL, 0x692519A2F34ECULL, 0x6E4404924CF78ULL, 0x1942EEC4A144AULL },
+			{ 0x74BBC5781302EULL, 0x73135BB81EC4CULL, 0x7EF671B61483CULL, 0x7264614CCD729ULL, 0x31993AD92E638ULL },
+			{ 0x45319AE234992ULL, 0x2219D47D24FB5ULL, 0x4F04488B06CF6ULL, 0x53AAA9E724A12ULL, 0x2A0A65314EF9CULL }
+		},
+		{
+			{ 0x61ACD3C1C793AULL, 0x58B46B78779E6ULL, 0x3369AACBE7AF2ULL, 0x509B0743074D4ULL, 0x55DC39B6DEA1ULL },
+			{ 0x7937FF7F927C2ULL, 0xC2FA14C6A5B6ULL, 0x556BDDB6DD07CULL, 0x6F6ACC179D108ULL, 0x4CF6E218647C2ULL },
+			{ 0x1227CC28D5BB6ULL, 0x78EE9BFF57623ULL, 0x28CB2241F893AULL, 0x25B541E3C6772ULL, 0x121A307710AA2ULL }
+		},
+		{
+			{ 0x1713EC77483C9ULL, 0x6F70572D5FACBULL, 0x25EF34E22FF81ULL, 0x54D944F141188ULL, 0x527BB94A6CED3ULL },
+			{ 0x35D5E9F034A97ULL, 0x126069785BC9BULL, 0x5474EC7854FF0ULL, 0x296A302A348CAULL, 0x333FC76C7A40EULL },
+			{ 0x5992A995B482EULL, 0x78DC707002AC7ULL, 0x5936394D01741ULL, 0x4FBA4281AEF17ULL, 0x6B89069B20A7AULL }
+		},
+		{
+			{ 0x2FA8CB5C7DB77ULL, 0x718E6982AA810ULL, 0x39E95F81A1A1BULL, 0x5E794F3646CFBULL, 0x473D308A7639ULL },
+			{ 0x2A0416270220DULL, 0x75F248B69D025ULL, 0x1CBBC16656A27ULL, 0x5B9FFD6E26728ULL, 0x23BC2103AA73EULL },
+			{ 0x6792603589E05ULL, 0x248DB9892595DULL, 0x6A53CAD2D08ULL, 0x20D0150F7BA73ULL, 0x102F73BFDE043ULL }
+		}
+	},
+	{
+		{
+			{ 0x4DAE0B5511C9AULL, 0x5257FFFE0D456ULL, 0x54108D1EB2180ULL, 0x96CC0F9BAEFAULL, 0x3F6BD725DA4EAULL },
+			{ 0xB9AB7F5745C6ULL, 0x5CAF0F8D21D63ULL, 0x7DEBEA408EA2BULL, 0x9EDB93896D16ULL, 0x36597D25EA5C0ULL },
+			{ 0x58D7B106058ACULL, 0x3CDF8D20BEE69ULL, 0xA4CB765015EULL, 0x36832337C7CC9ULL, 0x7B7ECC19DA60DULL }
+		},
+		{
+			{ 0x64A51A77CFA9BULL, 0x29CF470CA0DB5ULL, 0x4B60B6E0898D9ULL, 0x55D04DDFFE6C7ULL, 0x3BEDC661BF5CULL },
+			{ 0x2373C695C690DULL, 0x4C0C8520DCF18ULL, 0x384AF4B7494B9ULL, 0x4AB4A8EA22225ULL, 0x4235AD7601743ULL },
+			{ 0xCB0D078975F5ULL, 0x292313E530C4BULL, 0x38DBB9124A509ULL, 0x350D0655A11F1ULL, 0xE7CE2B0CDF06ULL }
+		},
+		{
+			{ 0x6FEDFD94B70F9ULL, 0x2383F9745BFD4ULL, 0x4BEAE27C4C301ULL, 0x75AA4416A3F3FULL, 0x615256138AECEULL },
+			{ 0x4643AC48C85A3ULL, 0x6878C2735B892ULL, 0x3A53523F4D877ULL, 0x3A504ED8BEE9DULL, 0x666E0A5D8FB46ULL },
+			{ 0x3F64E4870CB0DULL, 0x61548B16D6557ULL, 0x7A261773596F3ULL, 0x7724D5F275D3AULL, 0x7F0BC810D514DULL }
+		},
+		{
+			{ 0x49DAD737213A0ULL, 0x745DEE5D31075ULL, 0x7B1A55E7FDBE2ULL, 0x5BA988F176EA1ULL, 0x1D3A907DDEC5AULL },
+			{ 0x6BA426F4136FULL, 0x3CAFC0606B720ULL, 0x518F0A2359CDAULL, 0x5FAE5E46FECA7ULL, 0xD1F8DBCF8EEDULL },
+			{ 0x693313ED081DCULL, 0x5B0A366901742ULL, 0x40C872CA4CA7EULL, 0x6F18094009E01ULL, 0x11B44A31BFULL }
+		},
+		{
+			{ 0x61F696A0AA75CULL, 0x38B0A57AD42CAULL, 0x1E59AB706FDC9ULL, 0x1308D46EBFCDULL, 0x63D988A2D2851ULL },
+			{ 0x7A06C3FC66C0CULL, 0x1C9BAC1BA47FBULL, 0x23935C575038EULL, 0x3F0BD71C59C13ULL, 0x3AC48D916E835ULL },
+			{ 0x20753AFBD232EULL, 0x71FBB1ED06002ULL, 0x39CAE47A4AF3AULL, 0x337C0B34D9C2ULL, 0x33FAD52B2368AULL }
+		},
+		{
+			{ 0x4C8D0C422CFE8ULL, 0x760B4275971A5ULL, 0x3DA95BC1CAD3DULL, 0xF151FF5B7376ULL, 0x3CC355CCB90A7ULL },
+			{ 0x649C6C5E41E16ULL, 0x60667EEE6AA80ULL, 0x4179D182BE190ULL, 0x653D9567E6979ULL, 0x16C0F429A256DULL },
+			{ 0x69443903E9131ULL, 0x16F4AC6F9DD36ULL, 0x2EA4912E29253ULL, 0x2B4643E68D25DULL, 0x631EAF426BAE7ULL }
+		},
+		{
+			{ 0x175B9A3700DE8ULL, 0x77C5F00AA48FBULL, 0x3917785CA0317ULL, 0x5AA9B2C79399ULL, 0x431F2C7F665F8ULL },
+			{ 0x10410DA66FE9FULL, 0x24D82DCB4D67DULL, 0x3E6FE0E17752DULL, 0x4DADE1ECBB08FULL, 0x5599648B1EA91ULL },
+			{ 0x26344858F7B19ULL, 0x5F43D4A295AC0ULL, 0x242A75C52ACD4ULL, 0x5934480220D10ULL, 0x7B04715F91253ULL }
+		},
+		{
+			{ 0x6C280C4E6BAC6ULL, 0x3ADA3B361766EULL, 0x42FE5125C3B4FULL, 0x111D84D4AAC22ULL, 0x48D0ACFA57CDEULL },
+			{ 0x5BD28ACF6AE43ULL, 0x16FAB8F56907DULL, 0x7ACB11218D5F2ULL, 0x41FE02023B4DBULL, 0x59B37BF5C2F65ULL },
+			{ 0x726E47DABE671ULL, 0x2EC45E746F6C1ULL, 0x6580E53C74686ULL, 0x5EDA104673F74ULL, 0x16234191336D3ULL }
+		}
+	},
+	{
+		{
+			{ 0x19CD61FF38640ULL, 0x60C6C4B41BA9ULL, 0x75CF70CA7366FULL, 0x118A8F16C011EULL, 0x4A25707A203B9ULL },
+			{ 0x499DEF6267FF6ULL, 0x76E858108773CULL, 0x693CAC5DDCB29ULL, 0x311D00A9FF4ULL, 0x2CDFDFECD5D05ULL },
+			{ 0x7668A53F6ED6AULL, 0x303BA2E142556ULL, 0x3880584C10909ULL, 0x4FE20000A261DULL, 0x5721896D248E4ULL }
+		},
+		{
+			{ 0x55091A1D0DA4EULL, 0x4F6BFC7C1050BULL, 0x64E4ECD2EA9BEULL, 0x7EB1F28BBE70ULL, 0x3C935AFC4B03ULL },
+			{ 0x65517FD181BAEULL, 0x3E5772C76816DULL, 0x19189640898AULL, 0x1ED2A84DE7499ULL, 0x578EDD74F63C1ULL },
+			{ 0x276C6492B0C3DULL, 0x9BFC40BF932EULL, 0x588E8F11F330BULL, 0x3D16E694DC26EULL, 0x3EC2AB590288CULL }
+		},
+		{
+			{ 0x13A09AE32D1CBULL, 0x3E81EB85AB4E4ULL, 0x7AACA43CAE1FULL, 0x62F05D7526374ULL, 0xE1BF66C6ADBAULL },
+			{ 0xD27BE4D87BB9ULL, 0x56C27235DB434ULL, 0x72E6E0EA62D37ULL, 0x5674CD06EE839ULL, 0x2DD5C25A200FCULL },
+			{ 0x3D5E9792C887EULL, 0x319724DABBC55ULL, 0x2B97C78680800ULL, 0x7AFDFDD34E6DDULL, 0x730548B35AE88ULL }
+		},
+		{
+			{ 0x3094BA1D6E334ULL, 0x6E126A7E3300BULL, 0x89C0AEFCFBC5ULL, 0x2EEA11F836583ULL, 0x585A2277D8784ULL },
+			{ 0x551A3CBA8B8EEULL, 0x3B6422BE2D886ULL, 0x630E1419689BCULL, 0x4653B07A7A955ULL, 0x3043443B411DBULL },
+			{ 0x25F8233D48962ULL, 0x6BD8F04AFF431ULL, 0x4F907FD9A6312ULL, 0x40FD3C737D29BULL, 0x7656278950EF9ULL }
+		},
+		{
+			{ 0x73A3EA86CF9DULL, 0x6E0E2ABFB9C2EULL, 0x60E2A38EA33EEULL, 0x30B2429F3FE18ULL, 0x28BBF484B613FULL },
+			{ 0x3CF59D51FC8C0ULL, 0x7A0A0D6DE4718ULL, 0x55C3A3E6FB74BULL, 0x353135F884FD5ULL, 0x3F4160A8C1B84ULL },
+			{ 0x12F5C6F136C7CULL, 0xFEDBA237DE4CULL, 0x779BCCEBFAB44ULL, 0x3AEA93F4D6909ULL, 0x1E79CB358188FULL }
+		},
+		{
+			{ 0x153D8F5E08181ULL, 0x8533BBDB2EFDULL, 0x1149796129431ULL, 0x17A6E36168643ULL, 0x478AB52D39D1FULL },
+			{ 0x436C3EEF7E3F1ULL, 0x7FFD3C21F0026ULL, 0x3E77BF20A2DA9ULL, 0x418BFFC8472DEULL, 0x65D7951B3A3B3ULL },
+			{ 0x6A4D39252D159ULL, 0x790E35900ECD4ULL, 0x30725BF977786ULL, 0x10A5C1635A053ULL, 0x16D87A411A212ULL }
+		},
+		{
+			{ 0x4D5E2D54E0583ULL, 0x2E5D7B33F5F74ULL, 0x3A5DE3F887EBFULL, 0x6EF24BD6139B7ULL, 0x1F990B577A5A6ULL },
+			{ 0x57E5A42066215ULL, 0x1A18B44983677ULL, 0x3E652DE1E6F8FULL, 0x6532BE02ED8EBULL, 0x28F87C8165F38ULL },
+			{ 0x44EAD1BE8F7D6ULL, 0x5759D4F31F466ULL, 0x378149F47943ULL, 0x69F3BE32B4F29ULL, 0x45882FE1534D6ULL }
+		},
+		{
+			{ 0x49929943C6FE4ULL, 0x4347072545B15ULL, 0x3226BCED7E7C5ULL, 0x3A134CED89DFULL, 0x7DCF843CE405FULL },
+			{ 0x1345D757983D6ULL, 0x222F54234CCCDULL, 0x1784A3D8ADBB4ULL, 0x36EBEEE8C2BCCULL, 0x688FE5B8F626FULL },
+			{ 0xD6484A4732C0ULL, 0x7B94AC6532D92ULL, 0x5771B8754850FULL, 0x48DD9DF1461C8ULL, 0x6739687E73271ULL }
+		}
+	},
+	{
+		{
+			{ 0x5CC9DC80C1AC0ULL, 0x683671486D4CDULL, 0x76F5F1A5E8173ULL, 0x6D5D3F5F9DF4AULL, 0x7DA0B8F68D7E7ULL },
+			{ 0x2014385675A6ULL, 0x6155FB53D1DEFULL, 0x37EA32E89927CULL, 0x59A668F5A82EULL, 0x46115ABA1D4DCULL },
+			{ 0x71953C3B5DA76ULL, 0x6642233D37A81ULL, 0x2C9658076B1BDULL, 0x5A581E63010FFULL, 0x5A5F887E83674ULL }
+		},
+		{
+			{ 0x628D3A0A643B9ULL, 0x1CD8640C93D2ULL, 0xB7B0CAD70F2CULL, 0x3864DA98144BEULL, 0x43E37AE2D5D1CULL },
+			{ 0x301CF70A13D11ULL, 0x2A6A1BA1891ECULL, 0x2F291FB3F3AE0ULL, 0x21A7B814BEA52ULL, 0x3669B656E44D1ULL },
+			{ 0x63F06EDA6E133ULL, 0x233342758070FULL, 0x98E0459CC075ULL, 0x4DF5EAD6C7C1BULL, 0x6A21E6CD4FD5EULL }
+		},
+		{
+			{ 0x129126699B2E3ULL, 0xEE11A2603DE8ULL, 0x60AC2F5C74C21ULL, 0x59B192A196808ULL, 0x45371B07001E8ULL },
+			{ 0x6170A3046E65FULL, 0x5401A46A49E38ULL, 0x20ADD5561C4A8ULL, 0x7ABB4EDDE9E46ULL, 0x586BF9F1A195FULL },
+			{ 0x3088D5EF8790BULL, 0x38C2126FCB4DBULL, 0x685BAE149E3C3ULL, 0xBCD601A4E930ULL, 0xEAFB03790E52ULL }
+		},
+		{
+			{ 0x805E0F75AE1DULL, 0x464CC59860A28ULL, 0x248E5B7B00BEFULL, 0x5D99675EF8F75ULL, 0x44AE3344C5435ULL },
+			{ 0x555C13748042FULL, 0x4D041754232C0ULL, 0x521B430866907ULL, 0x3308E40FB9C39ULL, 0x309ACC675A02CULL },
+			{ 0x289B9BBA543EEULL, 0x3AB592E28539EULL, 0x64D82ABCDD83AULL, 0x3C78EC172E327ULL, 0x62D5221B7F946ULL }
+		},
+		{
+			{ 0x5D4263AF77A3CULL, 0x23FDD2289AEB0ULL, 0x7DC64F77EB9ECULL, 0x1BD28338402CULL, 0x14F29A5383922ULL },
+			{ 0x4299C18D0936DULL, 0x5914183418A49ULL, 0x52A18C721AED5ULL, 0x2B151BA82976DULL, 0x5C0EFDE4BC754ULL },
+			{ 0x17EDC25B2D7F5ULL, 0x37336A6081BEEULL, 0x7B5318887E5C3ULL, 0x49F6D491A5BE1ULL, 0x5E72365C7BEE0ULL }
+		},
+		{
+			{ 0x339062F08B33EULL, 0x4BBF3E657CFB2ULL, 0x67AF7F56E5967ULL, 0x4DBD67F9ED68FULL, 0x70B20555CB734ULL },
+			{ 0x3FC074571217FULL, 0x3A0D29B2B6AEBULL, 0x6478CCDDE59DULL, 0x55E4D051BDDFAULL, 0x77F1104C47B4EULL },
+			{ 0x113C555112C4CULL, 0x7535103F9B7CAULL, 0x140ED1D9A2108ULL, 0x2522333BC2AFULL, 0xE34398F4A064ULL }
+		},
+		{
+			{ 0x30B093E4B1928ULL, 0x1CE7E7EC80312ULL, 0x4E575BDF78F84ULL, 0x61F7A190BED39ULL, 0x6F8ADED6CA379ULL },
+			{ 0x522D93ECEBDE8ULL, 0x24F045E0F6CFULL, 0x16DB63426CFA1ULL, 0x1B93A1FD30FD8ULL, 0x5E5405368A362ULL },
+			{ 0x123DFDB7B29AULL, 0x4344356523C68ULL, 0x79A527921EE5FULL, 0x74BFCCB3E817EULL, 0x780DE72EC8D3DULL }
+		},
+		{
+			{ 0x7EAF300F42772ULL, 0x5455188354CE3ULL, 0x4DCCA4A3DCBACULL, 0x3D314D0BFEBCBULL, 0x1DEFC6AD32B58ULL },
+			{ 0x28545089AE7BCULL, 0x1E38FE9A0C15CULL, 0x12046E0E2377BULL, 0x6721C560AA885ULL, 0xEB28BF671928ULL },
+			{ 0x3BE1AEF5195A7ULL, 0x6F22F62BDB5EBULL, 0x39768B8523049ULL, 0x43394C8FBFDBDULL, 0x467D201BF8DD2ULL }
+		}
+	},
+	{
+		{
+			{ 0x6F4BD567AE7A9ULL, 0x65AC89317B783ULL, 0x7D3B20FD8932ULL, 0xF208326916ULL, 0x2EF9C5A5BA384ULL },
+			{ 0x6919A74EF4FADULL, 0x59ED4611452BFULL, 0x691EC04EA09EFULL, 0x3CBCB2700E984ULL, 0x71C43C4F5BA3CULL },
+			{ 0x56DF6FA9E74CDULL, 0x79C95E4CF56DFULL, 0x7BE643BC609E2ULL, 0x149C12AD9E878ULL, 0x5A758CA390C5FULL }
+		},
+		{
+			{ 0x918B1D61DC94ULL, 0xD350260CD19CULL, 0x7A2AB4E37B4D9ULL, 0x21FEA735414D7ULL, 0xA738027F639DULL },
+			{ 0x72710D9462495ULL, 0x25AAFAA007456ULL, 0x2D21F28EAA31BULL, 0x17671EA005FD0ULL, 0x2DBAE244B3EB7ULL },
+			{ 0x74A2F57FFE1CCULL, 0x1BC3073087301ULL, 0x7EC57F4019C34ULL, 0x34E082E1FA524ULL, 0x2698CA635126AULL }
+		},
+		{
+			{ 0x5702F5E3DD90EULL, 0x31C9A4A70C5C7ULL, 0x136A5AA78FC24ULL, 0x1992F3B9F7B01ULL, 0x3C004B0C4AFA3ULL },
+			{ 0x5318832B0BA78ULL, 0x6F24B9FF17CECULL, 0xA47F30E060C7ULL, 0x58384540DC8D0ULL, 0x1FB43DCC49CAEULL },
+			{ 0x146AC06F4B82BULL, 0x4B500D89E7355ULL, 0x3351E1C728A12ULL, 0x10B9F69932FE3ULL, 0x6B43FD01CD1FDULL }
+		},
+		{
+			{ 0x742583E760EF3ULL, 0x73DC1573216B8ULL, 0x4AE48FDD7714AULL, 0x4F85F8A13E103ULL, 0x73420B2D6FF0DULL },
+			{ 0x75D4B4697C544ULL, 0x11BE1FFF7F8F4ULL, 0x119E16857F7E1ULL, 0x38A14345CF5D5ULL, 0x5A68D7105B52FULL },
+			{ 0x4F6CB9E851E06ULL, 0x278C4471895E5ULL, 0x7EFCDCE3D64E4ULL, 0x64F6D455C4B4CULL, 0x3DB5632FEA34BULL }
+		},
+		{
+			{ 0x190B1829825D5ULL, 0xE7D3513225C9ULL, 0x1C12BE3B7ABAEULL, 0x58777781E9CA6ULL, 0x59197EA495DF2ULL },
+			{ 0x6EE2BF75DD9D8ULL, 0x6C72CEB34BE8DULL, 0x679C9CC345EC7ULL, 0x7898DF96898A4ULL, 0x4321ADF49D75ULL },
+			{ 0x16019E4E55AAEULL, 0x74FC5F25D209CULL, 0x4566A939DED0DULL, 0x66063E716E0B7ULL, 0x45EAFDC1F4D70ULL }
+		},
+		{
+			{ 0x64624CFCCB1EDULL, 0x257AB8072B6C1ULL, 0x120725676F0AULL, 0x4A018D04E8EEEULL, 0x3F73CEEA5D56DULL },
+			{ 0x401858045D72BULL, 0x459E5E0CA2D30ULL, 0x488B719308BEAULL, 0x56F4A0D1B32B5ULL, 0x5A5EEBC80362DULL },
+			{ 0x7BFD10A4E8DC6ULL, 0x7C899366736F4ULL, 0x55EBBEAF95C01ULL, 0x46DB060903F8AULL, 0x2605889126621ULL }
+		},
+		{
+			{ 0x18E3CC676E542ULL, 0x26079D995A990ULL, 0x4A7C217908B2ULL, 0x1DC7603E6655AULL, 0xDEDFA10B2444ULL },
+			{ 0x704A68360FF04ULL, 0x3CECC3CDE8B3EULL, 0x21CD5470F64FFULL, 0x6ABC18D953989ULL, 0x54AD0C2E4E615ULL },
+			{ 0x367D5B82B522AULL, 0xD3F4B83D7DC7ULL, 0x3067F4CDBC58DULL, 0x20452DA697937ULL, 0x62ECB2BAA77A9ULL }
+		},
+		{
+			{ 0x72836AFB62874ULL, 0xAF3C2094B240ULL, 0xC285297F357AULL, 0x7CC2D5680D6E3ULL, 0x61913D5075663ULL },
+			{ 0x5795261152B3DULL, 0x7A1DBBAFA3CBDULL, 0x5AD31C52588D5ULL, 0x45F3A4164685CULL, 0x2E59F919A966DULL },
+			{ 0x62D361A3231DAULL, 0x65284004E01B8ULL, 0x656533BE91D60ULL, 0x6AE016C00A89FULL, 0x3DDBC2A131C05ULL }
+		}
+	},
+	{
+		{
+			{ 0x257A22796BB14ULL, 0x6F360FB443E75ULL, 0x680E47220EAEAULL, 0x2FCF2A5F10C18ULL, 0x5EE7FB38D8320ULL },
+			{ 0x40FF9CE5EC54BULL, 0x57185E261B35BULL, 0x3E254540E70A9ULL, 0x1B5814003E3F8ULL, 0x78968314AC04BULL },
+			{ 0x5FDCB41446A8EULL, 0x5286926FF2A71ULL, 0xF231E296B3F6ULL, 0x684A357C84693ULL, 0x61D0633C9BCA0ULL }
+		},
+		{
+			{ 0x328BCF8FC73DFULL, 0x3B4DE06FF95B4ULL, 0x30AA427BA11A5ULL, 0x5EE31BFDA6D9CULL, 0x5B23AC2DF8067ULL },
+			{ 0x44935FFDB2566ULL, 0x12F016D176C6EULL, 0x4FBB00F16F5AEULL, 0x3FAB78D99402AULL, 0x6E965FD847AEDULL },
+			{ 0x2B953EE80527BULL, 0x55F5BCDB1B35AULL, 0x43A0B3FA23C66ULL, 0x76E07388B820AULL, 0x79B9BBB9DD95DULL }
+		},
+		{
+			{ 0x17DAE8E9F7374ULL, 0x719F76102DA33ULL, 0x5117C2A80CA8BULL, 0x41A66B65D0936ULL, 0x1BA811460ACCBULL },
+			{ 0x355406A3126C2ULL, 0x50D1918727D76ULL, 0x6E5EA0B498E0EULL, 0xA3B6063214F2ULL, 0x5065F158C9FD2ULL },
+			{ 0x169FB0C429954ULL, 0x59AEDD9ECEE10ULL, 0x39916EB851802ULL, 0x57917555CC538ULL, 0x3981F39E58A4FULL }
+		},
+		{
+			{ 0x5DFA56DE66FDEULL, 0x58809075908ULL, 0x6D3D8CB854A94ULL, 0x5B2F4E970B1E3ULL, 0x30F4452EDCBC1ULL },
+			{ 0x38A7559230A93ULL, 0x52C1CDE8BA31FULL, 0x2A4F2D4745A3DULL, 0x7E9D42D4A28AULL, 0x38DC083705ACDULL },
+			{ 0x52782C5759740ULL, 0x53F3397D990ADULL, 0x3A939C7E84D15ULL, 0x234C4227E39E0ULL, 0x632D9A1A593F2ULL }
+		},
+		{
+			{ 0x1FD11ED0C84A7ULL, 0x21B3ED2757E1ULL, 0x73E1DE58FC1C6ULL, 0x5D110C84616ABULL, 0x3A5A7DF28AF64ULL },
+			{ 0x36B15B807CBA6ULL, 0x3F78A9E1AFED7ULL, 0xA59C2C608F1FULL, 0x52BDD8ECB81B7ULL, 0xB24F48847ED4ULL },
+			{ 0x2D4BE511BEAC7ULL, 0x6BDA4D99E5B9BULL, 0x17E6996914E01ULL, 0x7B1F0CE7FCF80ULL, 0x34FCF74475481ULL }
+		},
+		{
+			{ 0x31DAB78CFAA98ULL, 0x4E3216E5E54B7ULL, 0x249823973B689ULL, 0x2584984E48885ULL, 0x119A3042FB37ULL },
+			{ 0x7E04C789767CAULL, 0x1671B28CFB832ULL, 0x7E57EA2E1C537ULL, 0x1FBAAEF444141ULL, 0x3D3BDC164DFA6ULL },
+			{ 0x2D89CE8C2177DULL, 0x6CD12BA182CF4ULL, 0x20A8AC19A7697ULL, 0x539FAB2CC72D9ULL, 0x56C088F1EDE20ULL }
+		},
+		{
+			{ 0x35FAC24F38F02ULL, 0x7D75C6197AB03ULL, 0x33E4BC2A42FA7ULL, 0x1C7CD10B48145ULL, 0x38B7EA483590ULL },
+			{ 0x53D1110A86E17ULL, 0x6416EB65F466DULL, 0x41CA6235FCE20ULL, 0x5C3FC8A99BB12ULL, 0x9674C6B99108ULL },
+			{ 0x6F82199316FF8ULL, 0x5D54F1A9F3E9ULL, 0x3BCC5D0BD274AULL, 0x5B284B8D2D5ADULL, 0x6E5E31025969EULL }
+		},
+		{
+			{ 0x4FB0E63066222ULL, 0x130F59747E660ULL, 0x41868FECD41AULL, 0x3105E8C923BC6ULL, 0x3058AD43D1838ULL },
+			{ 0x462F587E593FBULL, 0x3D94BA7CE362DULL, 0x330F9B52667B7ULL, 0x5D45A48E0F00AULL, 0x8F5114789A8DULL },
+			{ 0x40FFDE57663D0ULL, 0x71445D4C20647ULL, 0x2653E68170F7CULL, 0x64CDEE3C55ED6ULL, 0x26549FA4EFE3DULL }
+		}
+	},
+	{
+		{
+			{ 0x68549AF3F666EULL, 0x9E2941D4BB68ULL, 0x2E8311F5DFF3CULL, 0x6429EF91FFBD2ULL, 0x3A10DFE132CE3ULL },
+			{ 0x55A461E6BF9D6ULL, 0x78EEEF4B02E83ULL, 0x1D34F648C16CFULL, 0x7FEA2ABA5132ULL, 0x1926E1DC6401EULL },
+			{ 0x74E8AEA17CEA0ULL, 0xC743F83FBC0FULL, 0x7CB03C4BF5455ULL, 0x68A8BA9917E98ULL, 0x1FA1D01D861E5ULL }
+		},
+		{
+			{ 0x4AC00D1DF94ABULL, 0x3BA2101BD271BULL, 0x7578988B9C4AFULL, 0xF2BF89F49F7EULL, 0x73FCED18EE9A0ULL },
+			{ 0x55947D599832ULL, 0x346FE2AA41990ULL, 0x164C8079195BULL, 0x799CCFB7BBA27ULL, 0x773563BC6A75CULL },
+			{ 0x1E90863139CB3ULL, 0x4F8B407D9A0D6ULL, 0x58E24CA924F69ULL, 0x7A246BBE76456ULL, 0x1F426B701B864ULL }
+		},
+		{
+			{ 0x635C891A12552ULL, 0x26AEBD38EDE2FULL, 0x66DC8FADDAE05ULL, 0x21C7D41A03786ULL, 0xB76BB1B3FA7EULL },
+			{ 0x1264C41911C01ULL, 0x702F44584BDF9ULL, 0x43C511FC68EDEULL, 0x482C3AED35F9ULL, 0x4E1AF5271D31BULL },
+			{ 0xC1F97F92939BULL, 0x17A88956DC117ULL, 0x6EE005EF99DC7ULL, 0x4AA9172B231CCULL, 0x7B6DD61EB772AULL }
+		},
+		{
+			{ 0xABF9AB01D2C7ULL, 0x3880287630AE6ULL, 0x32ECA045BEDDBULL, 0x57F43365F32D0ULL, 0x53FA9B659BFF6ULL },
+			{ 0x5C1E850F33D92ULL, 0x1EC119AB9F6F5ULL, 0x7F16F6DE663E9ULL, 0x7A7D6CB16DEC6ULL, 0x703E9BCEAF1D2ULL },
+			{ 0x4C8E994885455ULL, 0x4CCB5DA9CAD82ULL, 0x3596BC610E975ULL, 0x7A80C0DDB9F5EULL, 0x398D93E5C4C61ULL }
+		},
+		{
+			{ 0x77C60D2E7E3F2ULL, 0x4061051763870ULL, 0x67BC4E0ECD2AAULL, 0x2BB941F1373B9ULL, 0x699C9C9002C30ULL },
+			{ 0x3D16733E248F3ULL, 0xE2B7E14BE389ULL, 0x42C0DDAF6784AULL, 0x589EA1FC67850ULL, 0x53B09B5DDF191ULL },
+			{ 0x6A7235946F1CCULL, 0x6B99CBB2FBE60ULL, 0x6D3A5D6485C62ULL, 0x4839466E923C0ULL, 0x51CAF30C6FCDDULL }
+		},
+		{
+			{ 0x2F99A18AC54C7ULL, 0x398A39661EE6FULL, 0x384331E40CDE3ULL, 0x4CD15C4DE19A6ULL, 0x12AE29C189F8EULL },
+			{ 0x3A7427674E00AULL, 0x6142F4F7E74C1ULL, 0x4CC93318C3A15ULL, 0x6D51BAC2B1EE7ULL, 0x5504AA292383FULL },
+			{ 0x6C0CB1F0D01CFULL, 0x187469EF5D533ULL, 0x27138883747BFULL, 0x2F52AE53A90E8ULL, 0x5FD14FE958EBAULL }
+		},
+		{
+			{ 0x2FE5EBF93CB8EULL, 0x226DA8ACBE788ULL, 0x10883A2FB7EA1ULL, 0x94707842CF44ULL, 0x7DD73F960725DULL },
+			{ 0x42DDF2845AB2CULL, 0x6214FFD3276BBULL, 0xB8D181A5246ULL, 0x268A6D579EB20ULL, 0x93FF26E58647ULL },
+			{ 0x524FE68059829ULL, 0x65B75E47CB621ULL, 0x15EB0A5D5CC19ULL, 0x5209B3929D5AULL, 0x2F59BCBC86B47ULL }
+		},
+		{
+			{ 0x1D560B691C301ULL, 0x7F5BAFCE3CE08ULL, 0x4CD561614806CULL, 0x4588B6170B188ULL, 0x2AA55E3D01082ULL },
+			{ 0x47D429917135FULL, 0x3EACFA07AF070ULL, 0x1DEAB46B46E44ULL, 0x7A53F3BA46CDFULL, 0x5458B42E2E51AULL },
+			{ 0x192E60C07444FULL, 0x5AE8843A21DAAULL, 0x6D721910B1538ULL, 0x3321A95A6417EULL, 0x13E9004A8A768ULL }
+		}
+	},
+	{
+		{
+			{ 0x600C9193B877FULL, 0x21C1B8A0D7765ULL, 0x379927FB38EA2ULL, 0x70D7679DBE01BULL, 0x5F46040898DE9ULL },
+			{ 0x58845832FCEDBULL, 0x135CD7F0C6E73ULL, 0x53FFBDFE8E35BULL, 0x22F195E06E55BULL, 0x73937E8814BCEULL },
+			{ 0x37116297BF48DULL, 0x45A9E0D069720ULL, 0x25AF71AA744ECULL, 0x41AF0CB8AABA3ULL, 0x2CF8A4E891D5EULL }
+		},
+		{
+			{ 0x5487E17D06BA2ULL, 0x3872A032D6596ULL, 0x65E28C09348E0ULL, 0x27B6BB2CE40C2ULL, 0x7A6F7F2891D6AULL },
+			{ 0x3FD8707110F67ULL, 0x26F8716A92DB2ULL, 0x1CDAA1B753027ULL, 0x504BE58B52661ULL, 0x2049BD6E58252ULL },
+			{ 0x1FD8D6A9AEF49ULL, 0x7CB67B7216FA1ULL, 0x67AFF53C3B982ULL, 0x20EA610DA9628ULL, 0x6011AADFC5459ULL }
+		},
+		{
+			{ 0x6D0C802CBF890ULL, 0x141BFED554C7BULL, 0x6DBB667EF4263ULL, 0x58F3126857EDCULL, 0x69CE18B779340ULL },
+			{ 0x7926DCF95F83CULL, 0x42E25120E2BECULL, 0x63DE96DF1FA15ULL, 0x4F06B50F3F9CCULL, 0x6FC5CC1B0B62FULL },
+			{ 0x75528B29879CBULL, 0x79A8FD2125A3DULL, 0x27C8D4B746AB8ULL, 0xF8893F02210CULL, 0x15596B3AE5710ULL }
+		},
+		{
+			{ 0x731167E5124CAULL, 0x17B38E8BBE13FULL, 0x3D55B942F9056ULL, 0x9C1495BE913FULL, 0x3AA4E241AFB6DULL },
+			{ 0x739D23F9179A2ULL, 0x632FADBB9E8C4ULL, 0x7C8522BFE0C48ULL, 0x6ED0983EF5AA9ULL, 0xD2237687B5F4ULL },
+			{ 0x138BF2A3305F5ULL, 0x1F45D24D86598ULL, 0x5274BAD2160FEULL, 0x1B6041D58D12AULL, 0x32FCAA6E4687AULL }
+		},
+		{
+			{ 0x7A4732787CCDFULL, 0x11E427C7F0640ULL, 0x3659385F8C64ULL, 0x5F4EAD9766BFBULL, 0x746F6336C2600ULL },
+			{ 0x56E8DC57D9AF5ULL, 0x5B3BE17BE4F78ULL, 0x3BF928CF82F4BULL, 0x52E55600A6F11ULL, 0x4627E9CEFEBD6ULL },
+			{ 0x2F345AB6C971CULL, 0x653286E63E7E9ULL, 0x51061B78A23ADULL, 0x14999ACB54501ULL, 0x7B4917007ED66ULL }
+		},
+		{
+			{ 0x41B28DD53A2DDULL, 0x37BE85F87EA86ULL, 0x74BE3D2A85E41ULL, 0x1BE87FAC96CA6ULL, 0x1D03620FE08CDULL },
+			{ 0x5FB5CAB84B064ULL, 0x2513E778285B0ULL, 0x457383125E043ULL, 0x6BDA3B56E223DULL, 0x122BA376F844FULL },
+			{ 0x232CDA2B4E554ULL, 0x422BA30FF840ULL, 0x751E7667B43F5ULL, 0x6261755DA5F3EULL, 0x2C70BF52B68EULL }
+		},
+		{
+			{ 0x532BF458D72E1ULL, 0x40F96E796B59CULL, 0x22EF79D6F9DA3ULL, 0x501AB67BECA77ULL, 0x6B0697E3FEB43ULL },
+			{ 0x7EC4B5D0B2FBBULL, 0x200E910595450ULL, 0x742057105715EULL, 0x2F07022530F60ULL, 0x26334F0A409EFULL },
+			{ 0xF04ADF62A3C0ULL, 0x5E0EDB48BB6D9ULL, 0x7C34AA4FBC003ULL, 0x7D74E4E5CAC24ULL, 0x1CC37F43441B2ULL }
+		},
+		{
+			{ 0x656F1C9CEAEB9ULL, 0x7031CACAD5AECULL, 0x1308CD0716C57ULL, 0x41C1373941942ULL, 0x3A346F772F196ULL },
+			{ 0x7565A5CC7324FULL, 0x1CA0D5244A11ULL, 0x116B067418713ULL, 0xA57D8C55EDAEULL, 0x6C6809C103803ULL },
+			{ 0x55112E2DA6AC8ULL, 0x6363D0A3DBA5AULL, 0x319C98BA6F40CULL, 0x2E84B03A36EC7ULL, 0x5911B9F6EF7CULL }
+		}
+	},
+	{
+		{
+			{ 0x1ACF3512EEAEFULL, 0x2639839692A69ULL, 0x669A234830507ULL, 0x68B920C0603D4ULL, 0x555EF9D1C64B2ULL },
+			{ 0x39983F5DF0EBBULL, 0x1EA2589959826ULL, 0x6CE638703CDD6ULL, 0x6311678898505ULL, 0x6B3CECF9AA270ULL },
+			{ 0x770BA3B73BD08ULL, 0x11475F7E186D4ULL, 0x251BC9892BBCULL, 0x24EAB9BFFCC5AULL, 0x675F4DE133817ULL }
+		},
+		{
+			{ 0x7F6D93BDAB31DULL, 0x1F3ACA5BFD425ULL, 0x2FA521C1C9760ULL, 0x62180CE27F9CDULL, 0x60F450B882CD3ULL },
+			{ 0x452036B1782FCULL, 0x2D95B07681C5ULL, 0x5901CF99205B2ULL, 0x290686E5EECB4ULL, 0x13D99DF70164CULL },
+			{ 0x35EC321E5C0CAULL, 0x13AE337F44029ULL, 0x4008E813F2DA7ULL, 0x640272F8E0C3AULL, 0x1C06DE9E55EDAULL }
+		},
+		{
+			{ 0x52B40FF6D69AAULL, 0x31B8809377FFAULL, 0x536625CD14C2CULL, 0x516AF252E17D1ULL, 0x78096F8E7D32BULL },
+			{ 0x77AD6A33EC4E2ULL, 0x717C5DC11D321ULL, 0x4A114559823E4ULL, 0x306CE50A1E2B1ULL, 0x4CF38A1FEC2DBULL },
+			{ 0x2AA650DFA5CE7ULL, 0x54916A8F19415ULL, 0xDC96FE71278ULL, 0x55F2784E63EB8ULL, 0x373CAD3A26091ULL }
+		},
+		{
+			{ 0x6A8FB89DDBBADULL, 0x78C35D5D97E37ULL, 0x66E3674EF2CB2ULL, 0x34347AC53DD8FULL, 0x21547EDA5112AULL },
+			{ 0x4634D82C9F57CULL, 0x4249268A6D652ULL, 0x6336D687F2FF7ULL, 0x4FE4F4E26D9A0ULL, 0x40F3D945441ULL },
+			{ 0x5E939FD5986D3ULL, 0x12A2147019BDFULL, 0x4C466E7D09CB2ULL, 0x6FA5B95D203DDULL, 0x63550A334A254ULL }
+		},
+		{
+			{ 0x2584572547B49ULL, 0x75C58811C1377ULL, 0x4D3C637CC171BULL, 0x33D30747D34E3ULL, 0x39A92BAFAA7D7ULL },
+			{ 0x7D6EDB569CF37ULL, 0x60194A5DC2CA0ULL, 0x5AF59745E10A6ULL, 0x7A8F53E004875ULL, 0x3EEA62C7DAF78ULL },
+			{ 0x4C713E693274EULL, 0x6ED1B7A6EB3A4ULL, 0x62ACE697D8E15ULL, 0x266B8292AB075ULL, 0x68436A0665C9CULL }
+		},
+		{
+			{ 0x6D317E820107CULL, 0x90815D2CA3CAULL, 0x3FF1EB1499A1ULL, 0x23960F050E319ULL, 0x5373669C91611ULL },
+			{ 0x235E8202F3F27ULL, 0x44C9F2EB61780ULL, 0x630905B1D7003ULL, 0x4FCC8D274EAD1ULL, 0x17B6E7F68AB78ULL },
+			{ 0x14AB9A0E5257ULL, 0x9939567F8BA5ULL, 0x4B47B2A423C82ULL, 0x688D7E57AC42DULL, 0x1CB4B5A678F87ULL }
+		},
+		{
+			{ 0x4AA62A2A007E7ULL, 0x61E0E38F62D6EULL, 0x2F888FCC4782ULL, 0x7562B83F21C00ULL, 0x2DC0FD2D82EF6ULL },
+			{ 0x4C06B394AFC6CULL, 0x4931B4BF636CCULL, 0x72B60D0322378ULL, 0x25127C6818B25ULL, 0x330BCA78DE743ULL },
+			{ 0x6FF841119744EULL, 0x2C560E8E49305ULL, 0x7254FEFE5A57AULL, 0x67AE2C560A7DFULL, 0x3C31BE1B369F1ULL }
+		},
+		{
+			{ 0xBC93F9CB4272ULL, 0x3F8F9DB73182DULL, 0x2B235EABAE1C4ULL, 0x2DDBF8729551AULL, 0x41CEC1097E7D5ULL },
+			{ 0x4864D08948AEEULL, 0x5D237438DF61EULL, 0x2B285601F7067ULL, 0x25DBCBAE6D753ULL, 0x330B61134262DULL },
+			{ 0x619D7A26D808AULL, 0x3C3B3C2ADBEF2ULL, 0x6877C9EEC7F52ULL, 0x3BEB9EBE1B66DULL, 0x26B44CD91F287ULL }
+		}
+	},
+	{
+		{
+			{ 0x7F29362730383ULL, 0x7FD7951459C36ULL, 0x7504C512D49E7ULL, 0x87ED7E3BC55FULL, 0x7DEB10149C726ULL },
+			{ 0x48478F387475ULL, 0x69397D9678A3EULL, 0x67C8156C976F3ULL, 0x2EB4D5589226CULL, 0x2C709E6C1C10AULL },
+			{ 0x2AF6A8766EE7AULL, 0x8AAA79A1D96CULL, 0x42F92D59B2FB0ULL, 0x1752C40009C07ULL, 0x8E68E9FF62CEULL }
+		},
+		{
+			{ 0x509D50AB8F2F9ULL, 0x1B8AB247BE5E5ULL, 0x5D9B2E6B2E486ULL, 0x4FAA5479A1339ULL, 0x4CB13BD738F71ULL },
+			{ 0x5500A4BC130ADULL, 0x127A17A938695ULL, 0x2A26FA34E36DULL, 0x584D12E1ECC28ULL, 0x2F1F3F87EEBA3ULL },
+			{ 0x48C75E515B64AULL, 0x75B6952071EF0ULL, 0x5D46D42965406ULL, 0x7746106989F9FULL, 0x19A1E353C0AE2ULL }
+		},
+		{
+			{ 0x172CDD596BDBDULL, 0x731DDF881684ULL, 0x10426D64F8115ULL, 0x71A4FD8A9A3DAULL, 0x736BD3990266AULL },
+			{ 0x47560BAFA05C3ULL, 0x418DCABCC2FA3ULL, 0x35991CECF8682ULL, 0x24371A94B8C60ULL, 0x41546B11C20C3ULL },
+			{ 0x32D509334B3B4ULL, 0x16C102CAE70AAULL, 0x1720DD51BF445ULL, 0x5AE662FAF9821ULL, 0x412295A2B87FAULL }
+		},
+		{
+			{ 0x55261E293EAC6ULL, 0x6426759B65CCULL, 0x40265AE116A48ULL, 0x6C02304BAE5BCULL, 0x760BB8D195ADULL },
+			{ 0x19B88F57ED6E9ULL, 0x4CDBF1904A339ULL, 0x42B49CD4E4F2CULL, 0x71A2E771909D9ULL, 0x14E153EBB52D2ULL },
+			{ 0x61A17CDE6818AULL, 0x53DAD34108827ULL, 0x32B32C55C55B6ULL, 0x2F9165F9347A3ULL, 0x6B34BE9BC33ACULL }
+		},
+		{
+			{ 0x469656571F2D3ULL, 0xAA61CE6F423FULL, 0x3F940D71B27A1ULL, 0x185F19D73D16AULL, 0x1B9C7B62E6DDULL },
+			{ 0x72F643A78C0B2ULL, 0x3DE45C04F9E7BULL, 0x706D68D30FA5CULL, 0x696F63E8E2F24ULL, 0x2012C18F0922DULL },
+			{ 0x355E55AC89D29ULL, 0x3E8B414EC7101ULL, 0x39DB07C520C90ULL, 0x6F41E9B77EFE1ULL, 0x8AF5B784E4BAULL }
+		},
+		{
+			{ 0x314D289CC2C4BULL, 0x23450E2F1BC4EULL, 0xCD93392F92F4ULL, 0x1370C6A946B7DULL, 0x6423C1D5AFD98ULL },
+			{ 0x499DC881F2533ULL, 0x34EF26476C506ULL, 0x4D107D2741497ULL, 0x346C4BD6EFDB3ULL, 0x32B79D71163A1ULL },
+			{ 0x5F8D9EDFCB36AULL, 0x1E6E8DCBF3990ULL, 0x7974F348AF30AULL, 0x6E6724EF19C7CULL, 0x480A5EFBC13E2ULL }
+		},
+		{
+			{ 0x14CE442CE221FULL, 0x18980A72516CCULL, 0x72F80DB86677ULL, 0x703331FDA526EULL, 0x24B31D47691C8ULL },
+			{ 0x1E70B01622071ULL, 0x1F163B5F8A16AULL, 0x56AAF341AD417ULL, 0x7989635D830F7ULL, 0x47AA27600CB7BULL },
+			{ 0x41EEDC015F8C3ULL, 0x7CF8D27EF854AULL, 0x289E3584693F9ULL, 0x4A7857B309A7ULL, 0x545B585D14DDAULL }
+		},
+		{
+			{ 0x4E4D0E3B321E1ULL, 0x7451FE3D2AC40ULL, 0x666F678EEA98DULL, 0x38858667FEADULL, 0x4D22DC3E64C8DULL },
+			{ 0x7275EA0D43A0FULL, 0x681137DD7CCF7ULL, 0x1E79CBAB79A38ULL, 0x22A214489A66AULL, 0xF62F9C332BA5ULL },
+			{ 0x46589D63B5F39ULL, 0x7EAF979EC3F96ULL, 0x4EBE81572B9A8ULL, 0x21B7F5D61694AULL, 0x1C0FA01A36371ULL }
+		}
+	},
+	{
+		{
+			{ 0x2B0E8C936A50ULL, 0x6B83B58B6CD21ULL, 0x37ED8D3E72680ULL, 0xA037DB9F2A62ULL, 0x4005419B1D2BCULL },
+			{ 0x604B622943DFFULL, 0x1C899F6741A58ULL, 0x60219E2F232FBULL, 0x35FAE92A7F9CBULL, 0xFA3614F3B1CAULL },
+			{ 0x3FEBDB9BE82F0ULL, 0x5E74895921400ULL, 0x553EA38822706ULL, 0x5A17C24CFC88CULL, 0x1FBA218AEF40AULL }
+		},
+		{
+			{ 0x657043E7B0194ULL, 0x5C11B55EFE9E7ULL, 0x7737BC6A074FBULL, 0xEAE41CE355CCULL, 0x6C535D13FF776ULL },
+			{ 0x49448FAC8F53EULL, 0x34F74C6E8356AULL, 0xAD780607DBA2ULL, 0x7213A7EB63EB6ULL, 0x392E3ACAA8C86ULL },
+			{ 0x534E93E8A35AFULL, 0x8B10FD02C997ULL, 0x26AC2ACB81E05ULL, 0x9D8C98CE3B79ULL, 0x25E17FE4D50ACULL }
+		},
+		{
+			{ 0x77FF576F121A7ULL, 0x4E5F9B0FC722BULL, 0x46F949B0D28C8ULL, 0x4CDE65D17EF26ULL, 0x6BBA828F89698ULL },
+			{ 0x9BD71E04F676ULL, 0x25AC841F2A145ULL, 0x1A47EAC823871ULL, 0x1A8A8C36C581AULL, 0x255751442A9FBULL },
+			{ 0x1BC6690FE3901ULL, 0x314132F5ABC5AULL, 0x611835132D528ULL, 0x5F24B8EB48A57ULL, 0x559D504F7F6B7ULL }
+		},
+		{
+			{ 0x91E7F6D266FDULL, 0x36060EF037389ULL, 0x18788EC1D1286ULL, 0x287441C478EB0ULL, 0x123EA6A3354BDULL },
+			{ 0x38378B3EB54D5ULL, 0x4D4AAA78F94EEULL, 0x4A002E875A74DULL, 0x10B851367B17CULL, 0x1AB12D5807E3ULL },
+			{ 0x5189041E32D96ULL, 0x5B062B090231ULL, 0xC91766E7B78FULL, 0xAA0F55A138ECULL, 0x4A3961E2C918AULL }
+		},
+		{
+			{ 0x7D644F3233F1EULL, 0x1C69F9E02C064ULL, 0x36AE5E5266898ULL, 0x8FC1DAD38B79ULL, 0x68ACEEAD9BD41ULL },
+			{ 0x43BE0F8E6BBA0ULL, 0x68FDFFC614E3BULL, 0x4E91DAB5B3BE0ULL, 0x3B1D4C9212FF0ULL, 0x2CD6BCE3FB1DBULL },
+			{ 0x4C90EF3D7C210ULL, 0x496F5A0818716ULL, 0x79CF88CC239B8ULL, 0x2CB9C306CF8DBULL, 0x595760D5B508FULL }
+		},
+		{
+			{ 0x2CBEBFD022790ULL, 0xB8822AEC1105ULL, 0x4D1CFD226BCCCULL, 0x515B2FA4971BEULL, 0x2CB2C5DF54515ULL },
+			{ 0x1BFE104AA6397ULL, 0x11494FF996C25ULL, 0x64251623E5800ULL, 0xD49FC5E044BEULL, 0x709FA43EDCB29ULL },
+			{ 0x25D8C63FD2ACAULL, 0x4C5CD29DFFD61ULL, 0x32EC0EB48AF05ULL, 0x18F9391F9B77CULL, 0x70F029ECF0C81ULL }
+		},
+		{
+			{ 0x2AFAA5E10B0B9ULL, 0x61DE08355254DULL, 0xEB587DE3C28DULL, 0x4F0BB9F7DBBD5ULL, 0x44ECA5A2A74BDULL },
+			{ 0x307B32EED3E33ULL, 0x6748AB03CE8C2ULL, 0x57C0D9AB810BCULL, 0x42C64A224E98CULL, 0xB7D5D8A6C314ULL },
+			{ 0x448327B95D543ULL, 0x146681E3A4BAULL, 0x38714ADC34E0CULL, 0x4F26F0E298E30ULL, 0x272224512C7DEULL }
+		},
+		{
+			{ 0x3BB8A42A975FCULL, 0x6F2D5B46B17EFULL, 0x7B6A9223170E5ULL, 0x53713FE3B7E6ULL, 0x19735FD7F6BC2ULL },
+			{ 0x492AF49C5342EULL, 0x2365CDF5A0357ULL, 0x32138A7FFBB60ULL, 0x2A1F7D14646FEULL, 0x11B5DF18A44CCULL },
+			{ 0x390D042C84266ULL, 0x1EFE32A8FDC75ULL, 0x6925EE7AE1238ULL, 0x4AF9281D0E832ULL, 0xFEF911191DF8ULL }
+		}
+	}
+	};
+
+/* Odd multiples of the base point, oddBaseTable[ i ] = ( 2i + 1 ) * B */
+
+static const GE_PRECOMP oddBaseTable[ 8 ] = {
+	{
+		{ 0x493C6F58C3B85ULL, 0xDF7181C325F7ULL, 0xF50B0B3E4CB7ULL, 0x5329385A44C32ULL, 0x7CF9D3A33D4BULL },
+		{ 0x3905D740913EULL, 0xBA2817D673A2ULL, 0x23E2827F4E67CULL, 0x133D2E0C21A34ULL, 0x44FD2F9298F81ULL },
+		{ 0x11205877AAA68ULL, 0x479955893D579ULL, 0x50D66309B67A0ULL, 0x2D42D0DBEE5EEULL, 0x6F117B689F0C6ULL }
+	},
+	{
+		{ 0x5B0A84CEE9730ULL, 0x61D10C97155E4ULL, 0x4059CC8096A10ULL, 0x47A608DA8014FULL, 0x7A164E1B9A80FULL },
+		{ 0x11FE8A4FCD265ULL, 0x7BCB8374FAACCULL, 0x52F5AF4EF4D4FULL, 0x5314098F98D10ULL, 0x2AB91587555BDULL },
+		{ 0x6933F0DD0D889ULL, 0x44386BB4C4295ULL, 0x3CB6D3162508CULL, 0x26368B872A2C6ULL, 0x5A2826AF12B9BULL }
+	},
+	{
+		{ 0x2BC4408A5BB33ULL, 0x78EBDDA05442ULL, 0x2FFB112354123ULL, 0x375EE8DF5862DULL, 0x2945CCF146E20ULL },
+		{ 0x182C3A447D6BAULL, 0x22964E536EFF2ULL, 0x192821F540053ULL, 0x2F9F19E788E5CULL, 0x154A7E73EB1B5ULL },
+		{ 0x3DBF1812A8285ULL, 0xFA17BA3F9797ULL, 0x6F69CB49C3820ULL, 0x34D5A0DB3858DULL, 0x43AABE696B3BBULL }
+	},
+	{
+		{ 0x25CD0944EA3BFULL, 0x75673B81A4D63ULL, 0x150B925D1C0D4ULL, 0x13F38D9294114ULL, 0x461BEA69283C9ULL },
+		{ 0x72C9AAA3221B1ULL, 0x267774474F74DULL, 0x64B0E9B28085ULL, 0x3F04EF53B27C9ULL, 0x1D6EDD5D2E531ULL },
+		{ 0x36DC801B8B3A2ULL, 0xE0A7D4935E30ULL, 0x1DEB7CECC0D7DULL, 0x53A94E20DD2CULL, 0x7A9FBB1C6A0F9ULL }
+	},
+	{
+		{ 0x6678AA6A8632FULL, 0x5EA3788D8B365ULL, 0x21BD6D6994279ULL, 0x7ACE75919E4E3ULL, 0x34B9ED338ADD7ULL },
+		{ 0x6217E039D8064ULL, 0x6DEA408337E6DULL, 0x57AC112628206ULL, 0x647CB65E30473ULL, 0x49C05A51FADC9ULL },
+		{ 0x4E8BF9045AF1BULL, 0x514E33A45E0D6ULL, 0x7533C5B8BFE0FULL, 0x583557B7E14C9ULL, 0x73C172021B008ULL }
+	},
+	{
+		{ 0x700848A802ADEULL, 0x1E04605C4E5F7ULL, 0x5C0D01B9767FBULL, 0x7D7889F42388BULL, 0x4275AAE2546D8ULL },
+		{ 0x75B0249864348ULL, 0x52EE11070262BULL, 0x237AE54FB5ACDULL, 0x3BFD1D03AAAB5ULL, 0x18AB598029D5CULL },
+		{ 0x32CC5FD6089E9ULL, 0x426505C949B05ULL, 0x46A18880C7AD2ULL, 0x4A4221888CCDAULL, 0x3DC65522B53DFULL }
+	},
+	{
+		{ 0xC222A2007F6DULL, 0x356B79BDB77EEULL, 0x41EE81EFE12CEULL, 0x120A9BD07097DULL, 0x234FD7EEC346FULL },
+		{ 0x7013B327FBF93ULL, 0x1336EEDED6A0DULL, 0x2B565A2BBF3AFULL, 0x253CE89591955ULL, 0x267882D17602ULL },
+		{ 0xA119732EA378ULL, 0x63BF1BA8E2A6CULL, 0x69F94CC90DF9AULL, 0x431D1779BFC48ULL, 0x497BA6FDAA097ULL }
+	},
+	{
+		{ 0x6CC0313CFEAA0ULL, 0x1A313848DA499ULL, 0x7CB534219230AULL, 0x39596DEDEFD60ULL, 0x61E22917F12DEULL },
+		{ 0x3CD86468CCF0BULL, 0x48553221AC081ULL, 0x6C9464B4E0A6EULL, 0x75FBA84180403ULL, 0x43B5CD4218D05ULL },
+		{ 0x2762F9BD0B516ULL, 0x1C6E7FBDDCBB3ULL, 0x75909C3ACE2BDULL, 0x42101972D3EC9ULL, 0x511D61210AE4DULL }
+	}
+	};
+
+/* The curve constants d, 2d, and sqrt( -1 ) */
+
+static const FIELD_ELEMENT curveD = \
+	{ 0x34DCA135978A3ULL, 0x1A8283B156EBDULL, 0x5E7A26001C029ULL, 0x739C663A03CBBULL, 0x52036CEE2B6FFULL };
+static const FIELD_ELEMENT curveD2 = \
+	{ 0x69B9426B2F159ULL, 0x35050762ADD7AULL, 0x3CF44C0038052ULL, 0x6738CC7407977ULL, 0x2406D9DC56DFFULL };
+static const FIELD_ELEMENT sqrtM1 = \
+	{ 0x61B274A0EA0B0ULL, 0xD5A5FC8F189DULL, 0x7EF5E9CBD0C60ULL, 0x78595A6804C9EULL, 0x2B8324804FC1DULL };
@@ -114,6 +114,13 @@ ret_type gcm_init_and_key(                  /* initialise mode and set key  */
     /* compute E(0) (for the hash function)     */
     aes_encrypt(UI8_PTR(ctx->ghash_h), UI8_PTR(ctx->ghash_h), ctx->aes);
 
+#if defined( USE_GCM_CLMUL_IF_PRESENT )
+    /* if PCLMULQDQ and AES-NI are available we don't need the tables */
+    ctx->hw_ghash = gcm_ni_init(ctx);
+    if(ctx->hw_ghash)
+        return RETURN_GOOD;
+#endif
+
 #if defined( GF_REPRESENTATION )
     convert_representation(ctx->ghash_h, ctx->ghash_h, GF_REPRESENTATION);
 #endif
@@ -138,6 +145,13 @@ void gf_mul_hh(gf_t a, gcm_ctx ctx[1])
 #if defined( GF_REPRESENTATION ) || !defined( NO_TABLES )
     gf_t    scr;
 #endif
+#if defined( USE_GCM_CLMUL_IF_PRESENT )
+    if(ctx->hw_ghash)
+    {
+        gcm_ni_mul(a, ctx->ghash_h);
+        return;
+    }
+#endif
 #if defined(  GF_REPRESENTATION )
     convert_representation(a, a, GF_REPRESENTATION);
 #endif
@@ -164,6 +178,16 @@ void gf_mul_hh(gf_t a, gcm_ctx ctx[1])
 #endif
 }
 
+/* the bit-by-bit gf_mul() is slow so if we have PCLMULQDQ available we use 
+   that instead for the exponentiation in gcm_compute_tag() */
+
+#if defined( USE_GCM_CLMUL_IF_PRESENT )
+#  define gf_mul_ctx(a, b, ctx) \
+    {   if((ctx)->hw_ghash) gcm_ni_mul(a, b); else gf_mul(a, b); }
+#else
+#  define gf_mul_ctx(a, b, ctx) gf_mul(a, b)
+#endif
+
 ret_type gcm_init_message(                  /* initialise a new message     */
             const unsigned char iv[],       /* the initialisation vector    */
             unsigned long iv_len,           /* and its length in bytes      */
@@ -410,11 +434,11 @@ ret_type gcm_compute_tag(                   /* compute authentication tag   */
             {
                 if(ln & 1)
                 {
-                    gf_mul((void*)ctx->hdr_ghv, tbuf);
+                    gf_mul_ctx((void*)ctx->hdr_ghv, tbuf, ctx);
                 }
                 if(!(ln >>= 1))
                     break;
-                gf_mul(tbuf, tbuf);
+                gf_mul_ctx(tbuf, tbuf, ctx);
             }
 #else       /* this one seems slower on x86 and x86_64 :-( */
             i = ln | ln >> 1; i |= i >> 2; i |= i >> 4;
@@ -496,7 +520,17 @@ ret_type gcm_encrypt(                       /* encrypt & authenticate data  */
             unsigned long data_len,         /* and its length in bytes      */
             gcm_ctx ctx[1])                 /* the mode context             */
 {
-
+#if defined( USE_GCM_CLMUL_IF_PRESENT )
+    /* if we're at a block boundary for both encryption and authentication 
+       then we can use the stitched AES-NI/GHASH code for whole blocks */
+    if(ctx->hw_ghash && ctx->txt_ccnt == ctx->txt_acnt && 
+       !(ctx->txt_ccnt & BLK_ADR_MASK))
+    {   unsigned long cnt = gcm_ni_encrypt(data, data_len, ctx);
+
+        data += cnt;
+        data_len -= cnt;
+    }
+#endif
     gcm_crypt_data(data, data_len, ctx);
     gcm_auth_data(data, data_len, ctx);
     return RETURN_GOOD;
@@ -507,6 +541,15 @@ ret_type gcm_decrypt(                       /* authenticate & decrypt data  */
             unsigned long data_len,         /* and its length in bytes      */
             gcm_ctx ctx[1])                 /* the mode context             */
 {
+#if defined( USE_GCM_CLMUL_IF_PRESENT )
+    if(ctx->hw_ghash && ctx->txt_ccnt == ctx->txt_acnt && 
+       !(ctx->txt_ccnt & BLK_ADR_MASK))
+    {   unsigned long cnt = gcm_ni_decrypt(data, data_len, ctx);
+
+        data += cnt;
+        data_len -= cnt;
+    }
+#endif
     gcm_auth_data(data, data_len, ctx);
     gcm_crypt_data(data, data_len, ctx);
     return RETURN_GOOD;
@@ -71,6 +71,16 @@ Issue Date: 11/01/2011
 
 /* END OF USER DEFINABLE OPTIONS */
 
+/*  On x86-64 systems where the AES code can use AES-NI we can also use 
+    PCLMULQDQ for GHASH and interleave the CTR-mode AES rounds with the 
+    GHASH multiplies, see gcm_ni.c.  The compiler conditions are the same 
+    ones that aesopt.h uses for USE_INTEL_AES_IF_PRESENT - pcg */
+
+#if ( defined( _MSC_VER ) && ( _MSC_VER > 1500 ) && defined( _M_X64 ) ) || \
+    ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) && defined( __x86_64__ ) )
+#  define USE_GCM_CLMUL_IF_PRESENT
+#endif
+
 /*  After encryption or decryption operations the return value of
     'compute tag' will be one of the values RETURN_GOOD, RETURN_WARN
     or RETURN_ERROR, the latter indicating an error. A return value
@@ -120,6 +130,10 @@ typedef struct
     gcm_buf_t       hdr_ghv;                /* ghash buffer (header)        */
     gcm_buf_t       txt_ghv;                /* ghash buffer (ciphertext)    */
     gf_t            ghash_h;                /* ghash H value                */
+#if defined( USE_GCM_CLMUL_IF_PRESENT )
+    gf_t            ghash_hp[8];            /* H^1...H^8, byte reversed     */
+    uint32_t        hw_ghash;               /* use PCLMULQDQ/AES-NI code    */
+#endif
     aes_encrypt_ctx aes[1];                 /* AES encryption context       */
     uint32_t        y0_val;                 /* initial counter value        */
     uint32_t        hdr_cnt;                /* header bytes so far          */
@@ -231,6 +245,20 @@ ret_type gcm_crypt_data(                    /* encrypt or decrypt data      */
             unsigned long data_len,         /* and its length in bytes      */
             gcm_ctx ctx[1]);                /* the mode context             */
 
+#if defined( USE_GCM_CLMUL_IF_PRESENT )
+
+/* PCLMULQDQ/AES-NI GHASH and stitched CTR + GHASH, in gcm_ni.c.  The 
+   encrypt/decrypt functions process whole blocks only and return the 
+   number of bytes that they've processed, the caller handles the rest */
+
+int gcm_ni_init(gcm_ctx ctx[1]);
+void gcm_ni_mul(gf_t a, const gf_t b);
+unsigned long gcm_ni_encrypt(unsigned char data[], unsigned long data_len,
+                             gcm_ctx ctx[1]);
+unsigned long gcm_ni_decrypt(unsigned char data[], unsigned long data_len,
+                             gcm_ctx ctx[1]);
+#endif
+
 #if defined(__cplusplus)
 }
 #endif
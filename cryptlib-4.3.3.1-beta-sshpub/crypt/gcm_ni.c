@@ -0,0 +1,437 @@
+/****************************************************************************
+*																			*
+*					cryptlib AES-GCM PCLMULQDQ/AES-NI Routines				*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+/* GHASH using the PCLMULQDQ carry-less multiply instruction, and a GCM
+   encrypt/decrypt loop that processes eight blocks at a time, interleaving
+   the AES-NI rounds for eight CTR-mode blocks with the GHASH multiplies for
+   eight blocks of ciphertext so that the AES and multiply units are both
+   kept busy.  The reduction modulo the field polynomial is aggregated over
+   the eight blocks using precomputed powers H^1...H^8, so it's only done
+   once per eight blocks rather than once per block.
+
+   The field arithmetic follows the Intel white paper "Intel Carry-Less
+   Multiplication Instruction and its Usage for Computing the GCM Mode" by
+   Gueron and Kounavis: blocks are byte-reversed so that the GCM bit order
+   becomes a (bit-reflected) 128-bit integer, multiplied as four 64 x 64-bit
+   carry-less products, shifted left by one bit to account for the
+   reflection, and reduced modulo x^128 + x^7 + x^2 + x + 1.
+
+   The state handling matches the table-driven code in gcm.c, for which the
+   GHASH buffer holds the running hash XORed with the most recent block but
+   not yet multiplied by H.  Processing n blocks C1...Cn starting from
+   state S therefore gives S' = S.H^n ^ C1.H^(n-1) ^ ... ^ C(n-1).H ^ Cn */
+
+#if defined( INC_ALL )
+  #include "gcm.h"
+  #include "aes_ni.h"
+#else
+  #include "crypt/gcm.h"
+  #include "crypt/aes_ni.h"
+#endif /* Compiler-specific includes */
+
+#if defined( USE_GCM ) && defined( USE_GCM_CLMUL_IF_PRESENT )
+
+#if defined( USE_INTEL_AES_IF_PRESENT )
+
+#if defined( _MSC_VER )
+
+#include <intrin.h>
+#define INLINE	static __forceinline
+
+#elif defined( __GNUC__ )
+
+#pragma GCC target ( "ssse3" )
+#pragma GCC target ( "sse4.1" )
+#pragma GCC target ( "aes" )
+#pragma GCC target ( "pclmul" )
+#include <x86intrin.h>
+#define INLINE	static __inline __attribute__(( always_inline ))
+
+#endif /* Compiler-specific intrinsics */
+
+/* The CPU capabilities that we need, PCLMULQDQ and AES-NI, which are 
+   determined when cryptlib starts up.  The presence of either of these 
+   also implies SSSE3 (for PSHUFB) and SSE4.1, see getHWInfo() in 
+   misc/os_spec.c */
+
+#define HWCAP_FLAGS_GCM_NI	( HWCAP_FLAG_PCLMUL | HWCAP_FLAG_AES )
+
+static int has_clmul_aes_ni( void )
+{
+	return ((getSysVar(SYSVAR_HWCAP) & HWCAP_FLAGS_GCM_NI) == \
+			HWCAP_FLAGS_GCM_NI) ? 1 : 0;
+}
+
+#define BLOCK_SIZE	GCM_BLOCK_SIZE
+#define BSWAP_MASK	_mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)
+
+/****************************************************************************
+*																			*
+*								GF(2^128) Arithmetic						*
+*																			*
+****************************************************************************/
+
+/* Accumulate the unreduced 256-bit product a * b into lo:mid:hi, where mid
+   holds the two middle 64 x 64-bit products that straddle lo and hi */
+
+INLINE void gf_mul_acc(const __m128i a, const __m128i b, __m128i *lo,
+					   __m128i *mid, __m128i *hi)
+{
+	*lo = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+	*mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x10));
+	*mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x01));
+	*hi = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+}
+
+/* Reduce an accumulated 256-bit product to a 128-bit field element */
+
+INLINE __m128i gf_reduce(__m128i lo, const __m128i mid, __m128i hi)
+{
+	__m128i t1, t2, t3;
+
+	lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+	hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+	/* Shift the 256-bit value hi:lo left by one bit since the operands
+	   are bit-reflected */
+	t1 = _mm_srli_epi32(lo, 31);
+	t2 = _mm_srli_epi32(hi, 31);
+	lo = _mm_slli_epi32(lo, 1);
+	hi = _mm_slli_epi32(hi, 1);
+	t3 = _mm_srli_si128(t1, 12);
+	t2 = _mm_slli_si128(t2, 4);
+	t1 = _mm_slli_si128(t1, 4);
+	lo = _mm_or_si128(lo, t1);
+	hi = _mm_or_si128(hi, t2);
+	hi = _mm_or_si128(hi, t3);
+
+	/* Reduce modulo x^128 + x^7 + x^2 + x + 1 */
+	t1 = _mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30));
+	t1 = _mm_xor_si128(t1, _mm_slli_epi32(lo, 25));
+	t2 = _mm_srli_si128(t1, 4);
+	t1 = _mm_slli_si128(t1, 12);
+	lo = _mm_xor_si128(lo, t1);
+	t3 = _mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2));
+	t3 = _mm_xor_si128(t3, _mm_srli_epi32(lo, 7));
+	t3 = _mm_xor_si128(t3, t2);
+	lo = _mm_xor_si128(lo, t3);
+
+	return _mm_xor_si128(hi, lo);
+}
+
+INLINE __m128i gf_mul_ni(const __m128i a, const __m128i b)
+{
+	__m128i lo = _mm_setzero_si128(), mid = lo, hi = lo;
+
+	gf_mul_acc(a, b, &lo, &mid, &hi);
+	return gf_reduce(lo, mid, hi);
+}
+
+/* Load block i of a buffer, or the power of H H^(i + 1), in byte-reversed 
+   form.  The blocks and powers of H are loaded as they're needed rather 
+   than being held in registers since x86-64 only has sixteen XMM 
+   registers and the eight AES blocks are already using half of them */
+
+#define load_block(p, i)	_mm_shuffle_epi8(_mm_loadu_si128((__m128i *)(p) + (i)), \
+											 BSWAP_MASK)
+#define load_h(hp, i)		_mm_loadu_si128((__m128i *)(hp)[i])
+
+/* Compute S' = S.H^8 ^ C[0].H^7 ^ ... ^ C[6].H ^ C[7] for eight blocks of 
+   ciphertext C[] */
+
+INLINE __m128i ghash8(const __m128i s, const unsigned char *c, 
+					  const gf_t *hp)
+{
+	__m128i lo = _mm_setzero_si128(), mid = lo, hi = lo;
+	int i;
+
+	gf_mul_acc(s, load_h(hp, 7), &lo, &mid, &hi);
+	for(i = 0; i < 7; i++)
+		gf_mul_acc(load_block(c, i), load_h(hp, 6 - i), &lo, &mid, &hi);
+	return _mm_xor_si128(gf_reduce(lo, mid, hi), load_block(c, 7));
+}
+
+/****************************************************************************
+*																			*
+*									AES Rounds								*
+*																			*
+****************************************************************************/
+
+/* Set up eight CTR-mode blocks for counter values ctr + 1...ctr + 8.  The
+   counter is held byte-reversed so that the 32-bit big-endian block
+   counter is in the low lane, where it wraps mod 2^32 as GCM requires */
+
+INLINE void ctr_init8(__m128i b[8], const __m128i ctr, const __m128i rk0)
+{
+	const __m128i bswap = BSWAP_MASK;
+	__m128i c = ctr, one = _mm_set_epi32(0, 0, 0, 1);
+	int i;
+
+	for(i = 0; i < 8; i++)
+	{
+		c = _mm_add_epi32(c, one);
+		b[i] = _mm_xor_si128(_mm_shuffle_epi8(c, bswap), rk0);
+	}
+}
+
+INLINE void aes_round8(__m128i b[8], const __m128i rk)
+{
+	b[0] = _mm_aesenc_si128(b[0], rk);
+	b[1] = _mm_aesenc_si128(b[1], rk);
+	b[2] = _mm_aesenc_si128(b[2], rk);
+	b[3] = _mm_aesenc_si128(b[3], rk);
+	b[4] = _mm_aesenc_si128(b[4], rk);
+	b[5] = _mm_aesenc_si128(b[5], rk);
+	b[6] = _mm_aesenc_si128(b[6], rk);
+	b[7] = _mm_aesenc_si128(b[7], rk);
+}
+
+/* Run the AES rounds for eight CTR blocks, interleaving the eight GHASH
+   multiplies for S' = S.H^8 ^ C[0].H^7 ^ ... ^ C[6].H ^ C[7] with the 
+   first eight AES rounds.  All AES key sizes have at least ten rounds so 
+   there's always room for the multiplies */
+
+INLINE __m128i aes_ghash8(__m128i b[8], const __m128i rk[15], const int nr,
+						  const __m128i s, const unsigned char *c,
+						  const gf_t *hp)
+{
+	__m128i lo = _mm_setzero_si128(), mid = lo, hi = lo;
+	int r;
+
+	aes_round8(b, rk[1]);
+	gf_mul_acc(s, load_h(hp, 7), &lo, &mid, &hi);
+	aes_round8(b, rk[2]);
+	gf_mul_acc(load_block(c, 0), load_h(hp, 6), &lo, &mid, &hi);
+	aes_round8(b, rk[3]);
+	gf_mul_acc(load_block(c, 1), load_h(hp, 5), &lo, &mid, &hi);
+	aes_round8(b, rk[4]);
+	gf_mul_acc(load_block(c, 2), load_h(hp, 4), &lo, &mid, &hi);
+	aes_round8(b, rk[5]);
+	gf_mul_acc(load_block(c, 3), load_h(hp, 3), &lo, &mid, &hi);
+	aes_round8(b, rk[6]);
+	gf_mul_acc(load_block(c, 4), load_h(hp, 2), &lo, &mid, &hi);
+	aes_round8(b, rk[7]);
+	gf_mul_acc(load_block(c, 5), load_h(hp, 1), &lo, &mid, &hi);
+	aes_round8(b, rk[8]);
+	gf_mul_acc(load_block(c, 6), load_h(hp, 0), &lo, &mid, &hi);
+	for(r = 9; r < nr; r++)
+		aes_round8(b, rk[r]);
+	for(r = 0; r < 8; r++)
+		b[r] = _mm_aesenclast_si128(b[r], rk[nr]);
+
+	return _mm_xor_si128(gf_reduce(lo, mid, hi), load_block(c, 7));
+}
+
+INLINE void aes8(__m128i b[8], const __m128i rk[15], const int nr)
+{
+	int r;
+
+	for(r = 1; r < nr; r++)
+		aes_round8(b, rk[r]);
+	for(r = 0; r < 8; r++)
+		b[r] = _mm_aesenclast_si128(b[r], rk[nr]);
+}
+
+INLINE __m128i aes1(__m128i b, const __m128i rk[15], const int nr)
+{
+	int r;
+
+	b = _mm_xor_si128(b, rk[0]);
+	for(r = 1; r < nr; r++)
+		b = _mm_aesenc_si128(b, rk[r]);
+	return _mm_aesenclast_si128(b, rk[nr]);
+}
+
+/****************************************************************************
+*																			*
+*								GCM Interface Functions						*
+*																			*
+****************************************************************************/
+
+int gcm_ni_init(gcm_ctx ctx[1])
+{
+	const __m128i bswap = BSWAP_MASK;
+	__m128i h, hn;
+	const int nr = ctx->aes->inf.b[0] >> 4;
+	int i;
+
+	if(!has_clmul_aes_ni() || (nr != 10 && nr != 12 && nr != 14))
+		return 0;
+
+	/* Precompute the byte-reversed powers H^1...H^8 */
+	h = hn = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)ctx->ghash_h), bswap);
+	_mm_storeu_si128((__m128i *)ctx->ghash_hp[0], h);
+	for(i = 1; i < 8; i++)
+	{
+		hn = gf_mul_ni(hn, h);
+		_mm_storeu_si128((__m128i *)ctx->ghash_hp[i], hn);
+	}
+
+	return 1;
+}
+
+void gcm_ni_mul(gf_t a, const gf_t b)
+{
+	const __m128i bswap = BSWAP_MASK;
+	__m128i x;
+
+	x = gf_mul_ni(load_block(a, 0), load_block(b, 0));
+	_mm_storeu_si128((__m128i *)a, _mm_shuffle_epi8(x, bswap));
+}
+
+/* Load the key schedule, counter, and GHASH state, and save the counter 
+   and GHASH state when we're done */
+
+#define GCM_NI_SETUP() \
+	const __m128i bswap = BSWAP_MASK; \
+	const __m128i one = _mm_set_epi32(0, 0, 0, 1); \
+	const int nr = ctx->aes->inf.b[0] >> 4; \
+	unsigned long nblocks = data_len / BLOCK_SIZE; \
+	const gf_t *hp = ctx->ghash_hp; \
+	__m128i rk[15], b[8], ctr, s; \
+	int i; \
+	\
+	if(nblocks == 0) \
+		return 0; \
+	for(i = 0; i <= nr; i++) \
+		rk[i] = _mm_loadu_si128((__m128i *)ctx->aes->ks + i); \
+	ctr = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)ctx->ctr_val), bswap); \
+	s = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)ctx->txt_ghv), bswap)
+
+#define GCM_NI_DONE() \
+	_mm_storeu_si128((__m128i *)ctx->ctr_val, _mm_shuffle_epi8(ctr, bswap)); \
+	_mm_storeu_si128((__m128i *)ctx->txt_ghv, _mm_shuffle_epi8(s, bswap)); \
+	ctx->txt_ccnt += (uint32_t)(data_len / BLOCK_SIZE) * BLOCK_SIZE; \
+	ctx->txt_acnt += (uint32_t)(data_len / BLOCK_SIZE) * BLOCK_SIZE; \
+	return (data_len / BLOCK_SIZE) * BLOCK_SIZE
+
+unsigned long gcm_ni_encrypt(unsigned char data[], unsigned long data_len,
+							 gcm_ctx ctx[1])
+{
+	unsigned char *prev;
+
+	GCM_NI_SETUP();
+
+	if(nblocks >= 8)
+	{
+		/* Encrypt the first eight blocks, there's no ciphertext to hash
+		   yet */
+		ctr_init8(b, ctr, rk[0]);
+		ctr = _mm_add_epi32(ctr, _mm_set_epi32(0, 0, 0, 8));
+		aes8(b, rk, nr);
+		for(i = 0; i < 8; i++)
+		{
+			b[i] = _mm_xor_si128(b[i],
+								 _mm_loadu_si128((__m128i *)data + i));
+			_mm_storeu_si128((__m128i *)data + i, b[i]);
+		}
+		prev = data;
+		data += 8 * BLOCK_SIZE;
+		nblocks -= 8;
+
+		/* Encrypt the next eight blocks while hashing the previous eight
+		   blocks of ciphertext */
+		while(nblocks >= 8)
+		{
+			ctr_init8(b, ctr, rk[0]);
+			ctr = _mm_add_epi32(ctr, _mm_set_epi32(0, 0, 0, 8));
+			s = aes_ghash8(b, rk, nr, s, prev, hp);
+			for(i = 0; i < 8; i++)
+			{
+				b[i] = _mm_xor_si128(b[i],
+									 _mm_loadu_si128((__m128i *)data + i));
+				_mm_storeu_si128((__m128i *)data + i, b[i]);
+			}
+			prev = data;
+			data += 8 * BLOCK_SIZE;
+			nblocks -= 8;
+		}
+
+		/* Hash the last eight blocks of ciphertext */
+		s = ghash8(s, prev, hp);
+	}
+
+	/* Process any remaining whole blocks one at a time */
+	while(nblocks-- > 0)
+	{
+		ctr = _mm_add_epi32(ctr, one);
+		b[0] = aes1(_mm_shuffle_epi8(ctr, bswap), rk, nr);
+		b[0] = _mm_xor_si128(b[0], _mm_loadu_si128((__m128i *)data));
+		_mm_storeu_si128((__m128i *)data, b[0]);
+		s = _mm_xor_si128(gf_mul_ni(s, load_h(hp, 0)), 
+						  _mm_shuffle_epi8(b[0], bswap));
+		data += BLOCK_SIZE;
+	}
+
+	GCM_NI_DONE();
+}
+
+unsigned long gcm_ni_decrypt(unsigned char data[], unsigned long data_len,
+							 gcm_ctx ctx[1])
+{
+	__m128i c;
+
+	GCM_NI_SETUP();
+
+	/* Decrypt eight blocks at a time, hashing the ciphertext while the
+	   keystream is being generated */
+	while(nblocks >= 8)
+	{
+		ctr_init8(b, ctr, rk[0]);
+		ctr = _mm_add_epi32(ctr, _mm_set_epi32(0, 0, 0, 8));
+		s = aes_ghash8(b, rk, nr, s, data, hp);
+		for(i = 0; i < 8; i++)
+		{
+			c = _mm_loadu_si128((__m128i *)data + i);
+			_mm_storeu_si128((__m128i *)data + i, _mm_xor_si128(b[i], c));
+		}
+		data += 8 * BLOCK_SIZE;
+		nblocks -= 8;
+	}
+
+	/* Process any remaining whole blocks one at a time */
+	while(nblocks-- > 0)
+	{
+		c = _mm_loadu_si128((__m128i *)data);
+		s = _mm_xor_si128(gf_mul_ni(s, load_h(hp, 0)), 
+						  _mm_shuffle_epi8(c, bswap));
+		ctr = _mm_add_epi32(ctr, one);
+		b[0] = aes1(_mm_shuffle_epi8(ctr, bswap), rk, nr);
+		_mm_storeu_si128((__m128i *)data, _mm_xor_si128(b[0], c));
+		data += BLOCK_SIZE;
+	}
+
+	GCM_NI_DONE();
+}
+
+#else
+
+/* The AES code isn't using AES-NI, so neither can we */
+
+int gcm_ni_init(gcm_ctx ctx[1])
+{
+	return 0;
+}
+
+void gcm_ni_mul(gf_t a, const gf_t b)
+{
+}
+
+unsigned long gcm_ni_encrypt(unsigned char data[], unsigned long data_len,
+							 gcm_ctx ctx[1])
+{
+	return 0;
+}
+
+unsigned long gcm_ni_decrypt(unsigned char data[], unsigned long data_len,
+							 gcm_ctx ctx[1])
+{
+	return 0;
+}
+#endif /* USE_INTEL_AES_IF_PRESENT */
+
+#endif /* USE_GCM && USE_GCM_CLMUL_IF_PRESENT */
@@ -0,0 +1,393 @@
+/****************************************************************************
+*																			*
+*						cryptlib Poly1305 MAC Routines						*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+/* Poly1305 as per RFC 8439.  The accumulator is evaluated modulo
+   2^130 - 5, if the compiler provides a native 128-bit type we use three
+   44/44/42-bit limbs with 64 x 64 -> 128-bit multiplies, otherwise five
+   26-bit limbs with 32 x 32 -> 64-bit multiplies.  In both cases the
+   reduction is folded into the multiply by premultiplying the high limbs of
+   r by 5 (since 2^130 = 5 mod p), and the final reduction and tag
+   computation are constant-time */
+
+#if defined( INC_ALL )
+  #include "crypt.h"
+  #include "chacha20.h"
+#else
+  #include "crypt.h"
+  #include "crypt/chacha20.h"
+#endif /* Compiler-specific includes */
+
+#ifdef USE_CHACHA20
+
+/* Read and write little-endian values */
+
+#define LOAD32_LE( p ) \
+		( ( uint32_t ) ( p )[ 0 ] | ( ( uint32_t ) ( p )[ 1 ] << 8 ) | \
+		  ( ( uint32_t ) ( p )[ 2 ] << 16 ) | ( ( uint32_t ) ( p )[ 3 ] << 24 ) )
+#define STORE32_LE( p, v ) \
+		( p )[ 0 ] = ( BYTE ) ( v ); ( p )[ 1 ] = ( BYTE ) ( ( v ) >> 8 ); \
+		( p )[ 2 ] = ( BYTE ) ( ( v ) >> 16 ); ( p )[ 3 ] = ( BYTE ) ( ( v ) >> 24 )
+#define LOAD64_LE( p ) \
+		( ( uint64_t ) LOAD32_LE( p ) | ( ( uint64_t ) LOAD32_LE( ( p ) + 4 ) << 32 ) )
+
+/* The value added to the top limb for each full block, corresponding to
+   the 2^128 bit that's appended to each 16-byte message block */
+
+#if defined( __SIZEOF_INT128__ )
+  #define HIBIT_FULL	( ( uint64_t ) 1 << 40 )
+#else
+  #define HIBIT_FULL	( ( uint32_t ) 1 << 24 )
+#endif /* __SIZEOF_INT128__ */
+
+#if defined( __SIZEOF_INT128__ )
+
+/****************************************************************************
+*																			*
+*							44-bit Limb Implementation						*
+*																			*
+****************************************************************************/
+
+typedef unsigned __int128 UINT128;
+
+#define MASK44		0xFFFFFFFFFFFULL
+#define MASK42		0x3FFFFFFFFFFULL
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void poly1305Init( OUT POLY1305_CTX *ctx,
+				   IN_BUFFER_C( POLY1305_KEY_SIZE ) const BYTE *key )
+	{
+	const uint64_t t0 = LOAD64_LE( key ), t1 = LOAD64_LE( key + 8 );
+
+	assert( isWritePtr( ctx, sizeof( POLY1305_CTX ) ) );
+	assert( isReadPtr( key, POLY1305_KEY_SIZE ) );
+
+	memset( ctx, 0, sizeof( POLY1305_CTX ) );
+
+	/* r &= 0x0FFFFFFC0FFFFFFC0FFFFFFC0FFFFFFF */
+	ctx->r[ 0 ] = t0 & 0xFFC0FFFFFFFULL;
+	ctx->r[ 1 ] = ( ( t0 >> 44 ) | ( t1 << 20 ) ) & 0xFFFFFC0FFFFULL;
+	ctx->r[ 2 ] = ( t1 >> 24 ) & 0x00FFFFFFC0FULL;
+	ctx->pad[ 0 ] = LOAD64_LE( key + 16 );
+	ctx->pad[ 1 ] = LOAD64_LE( key + 24 );
+	}
+
+static void poly1305Blocks( INOUT POLY1305_CTX *ctx,
+							IN_BUFFER( length ) const BYTE *data,
+							IN_LENGTH const int length,
+							const uint64_t hibit )
+	{
+	const uint64_t r0 = ctx->r[ 0 ], r1 = ctx->r[ 1 ], r2 = ctx->r[ 2 ];
+	const uint64_t s1 = r1 * ( 5 << 2 ), s2 = r2 * ( 5 << 2 );
+	uint64_t h0 = ctx->h[ 0 ], h1 = ctx->h[ 1 ], h2 = ctx->h[ 2 ];
+	int bytesLeft;
+
+	for( bytesLeft = length; bytesLeft >= POLY1305_BLOCK_SIZE;
+		 bytesLeft -= POLY1305_BLOCK_SIZE, data += POLY1305_BLOCK_SIZE )
+		{
+		const uint64_t t0 = LOAD64_LE( data ), t1 = LOAD64_LE( data + 8 );
+		UINT128 d0, d1, d2;
+		uint64_t c;
+
+		/* h += m */
+		h0 += t0 & MASK44;
+		h1 += ( ( t0 >> 44 ) | ( t1 << 20 ) ) & MASK44;
+		h2 += ( ( t1 >> 24 ) & MASK42 ) | hibit;
+
+		/* h *= r */
+		d0 = ( ( UINT128 ) h0 * r0 ) + ( ( UINT128 ) h1 * s2 ) + \
+			 ( ( UINT128 ) h2 * s1 );
+		d1 = ( ( UINT128 ) h0 * r1 ) + ( ( UINT128 ) h1 * r0 ) + \
+			 ( ( UINT128 ) h2 * s2 );
+		d2 = ( ( UINT128 ) h0 * r2 ) + ( ( UINT128 ) h1 * r1 ) + \
+			 ( ( UINT128 ) h2 * r0 );
+
+		/* Partial reduction mod 2^130 - 5 */
+		c = ( uint64_t ) ( d0 >> 44 ); h0 = ( uint64_t ) d0 & MASK44;
+		d1 += c; c = ( uint64_t ) ( d1 >> 44 ); h1 = ( uint64_t ) d1 & MASK44;
+		d2 += c; c = ( uint64_t ) ( d2 >> 42 ); h2 = ( uint64_t ) d2 & MASK42;
+		h0 += c * 5; c = h0 >> 44; h0 &= MASK44;
+		h1 += c;
+		}
+	ctx->h[ 0 ] = h0;
+	ctx->h[ 1 ] = h1;
+	ctx->h[ 2 ] = h2;
+	}
+
+static void poly1305Finish( INOUT POLY1305_CTX *ctx,
+							OUT_BUFFER_FIXED_C( POLY1305_TAG_SIZE ) BYTE *tag )
+	{
+	uint64_t h0 = ctx->h[ 0 ], h1 = ctx->h[ 1 ], h2 = ctx->h[ 2 ];
+	uint64_t g0, g1, g2, c, t0, t1;
+
+	/* Fully carry h */
+	c = h1 >> 44; h1 &= MASK44;
+	h2 += c; c = h2 >> 42; h2 &= MASK42;
+	h0 += c * 5; c = h0 >> 44; h0 &= MASK44;
+	h1 += c; c = h1 >> 44; h1 &= MASK44;
+	h2 += c; c = h2 >> 42; h2 &= MASK42;
+	h0 += c * 5; c = h0 >> 44; h0 &= MASK44;
+	h1 += c;
+
+	/* Compute g = h + -p = h - ( 2^130 - 5 ) and select h if h < p or g
+	   otherwise */
+	g0 = h0 + 5; c = g0 >> 44; g0 &= MASK44;
+	g1 = h1 + c; c = g1 >> 44; g1 &= MASK44;
+	g2 = h2 + c - ( ( uint64_t ) 1 << 42 );
+	c = ( g2 >> 63 ) - 1;
+	g0 &= c; g1 &= c; g2 &= c;
+	c = ~c;
+	h0 = ( h0 & c ) | g0;
+	h1 = ( h1 & c ) | g1;
+	h2 = ( h2 & c ) | g2;
+
+	/* h = ( h + s ) mod 2^128 */
+	t0 = ctx->pad[ 0 ];
+	t1 = ctx->pad[ 1 ];
+	h0 += t0 & MASK44; c = h0 >> 44; h0 &= MASK44;
+	h1 += ( ( ( t0 >> 44 ) | ( t1 << 20 ) ) & MASK44 ) + c;
+	c = h1 >> 44; h1 &= MASK44;
+	h2 += ( ( t1 >> 24 ) & MASK42 ) + c; h2 &= MASK42;
+	h0 = h0 | ( h1 << 44 );
+	h1 = ( h1 >> 20 ) | ( h2 << 24 );
+	STORE32_LE( tag, ( uint32_t ) h0 );
+	STORE32_LE( tag + 4, ( uint32_t ) ( h0 >> 32 ) );
+	STORE32_LE( tag + 8, ( uint32_t ) h1 );
+	STORE32_LE( tag + 12, ( uint32_t ) ( h1 >> 32 ) );
+	}
+#else
+
+/****************************************************************************
+*																			*
+*							26-bit Limb Implementation						*
+*																			*
+****************************************************************************/
+
+#define MASK26		0x3FFFFFFUL
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void poly1305Init( OUT POLY1305_CTX *ctx,
+				   IN_BUFFER_C( POLY1305_KEY_SIZE ) const BYTE *key )
+	{
+	assert( isWritePtr( ctx, sizeof( POLY1305_CTX ) ) );
+	assert( isReadPtr( key, POLY1305_KEY_SIZE ) );
+
+	memset( ctx, 0, sizeof( POLY1305_CTX ) );
+
+	/* r &= 0x0FFFFFFC0FFFFFFC0FFFFFFC0FFFFFFF */
+	ctx->r[ 0 ] = LOAD32_LE( key ) & 0x3FFFFFFUL;
+	ctx->r[ 1 ] = ( LOAD32_LE( key + 3 ) >> 2 ) & 0x3FFFF03UL;
+	ctx->r[ 2 ] = ( LOAD32_LE( key + 6 ) >> 4 ) & 0x3FFC0FFUL;
+	ctx->r[ 3 ] = ( LOAD32_LE( key + 9 ) >> 6 ) & 0x3F03FFFUL;
+	ctx->r[ 4 ] = ( LOAD32_LE( key + 12 ) >> 8 ) & 0x00FFFFFUL;
+	ctx->pad[ 0 ] = LOAD32_LE( key + 16 );
+	ctx->pad[ 1 ] = LOAD32_LE( key + 20 );
+	ctx->pad[ 2 ] = LOAD32_LE( key + 24 );
+	ctx->pad[ 3 ] = LOAD32_LE( key + 28 );
+	}
+
+static void poly1305Blocks( INOUT POLY1305_CTX *ctx,
+							IN_BUFFER( length ) const BYTE *data,
+							IN_LENGTH const int length,
+							const uint32_t hibit )
+	{
+	const uint32_t r0 = ctx->r[ 0 ], r1 = ctx->r[ 1 ], r2 = ctx->r[ 2 ];
+	const uint32_t r3 = ctx->r[ 3 ], r4 = ctx->r[ 4 ];
+	const uint32_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+	uint32_t h0 = ctx->h[ 0 ], h1 = ctx->h[ 1 ], h2 = ctx->h[ 2 ];
+	uint32_t h3 = ctx->h[ 3 ], h4 = ctx->h[ 4 ];
+	int bytesLeft;
+
+	for( bytesLeft = length; bytesLeft >= POLY1305_BLOCK_SIZE;
+		 bytesLeft -= POLY1305_BLOCK_SIZE, data += POLY1305_BLOCK_SIZE )
+		{
+		uint64_t d0, d1, d2, d3, d4;
+		uint32_t c;
+
+		/* h += m */
+		h0 += LOAD32_LE( data ) & MASK26;
+		h1 += ( LOAD32_LE( data + 3 ) >> 2 ) & MASK26;
+		h2 += ( LOAD32_LE( data + 6 ) >> 4 ) & MASK26;
+		h3 += ( LOAD32_LE( data + 9 ) >> 6 ) & MASK26;
+		h4 += ( LOAD32_LE( data + 12 ) >> 8 ) | hibit;
+
+		/* h *= r */
+		d0 = ( ( uint64_t ) h0 * r0 ) + ( ( uint64_t ) h1 * s4 ) + \
+			 ( ( uint64_t ) h2 * s3 ) + ( ( uint64_t ) h3 * s2 ) + \
+			 ( ( uint64_t ) h4 * s1 );
+		d1 = ( ( uint64_t ) h0 * r1 ) + ( ( uint64_t ) h1 * r0 ) + \
+			 ( ( uint64_t ) h2 * s4 ) + ( ( uint64_t ) h3 * s3 ) + \
+			 ( ( uint64_t ) h4 * s2 );
+		d2 = ( ( uint64_t ) h0 * r2 ) + ( ( uint64_t ) h1 * r1 ) + \
+			 ( ( uint64_t ) h2 * r0 ) + ( ( uint64_t ) h3 * s4 ) + \
+			 ( ( uint64_t ) h4 * s3 );
+		d3 = ( ( uint64_t ) h0 * r3 ) + ( ( uint64_t ) h1 * r2 ) + \
+			 ( ( uint64_t ) h2 * r1 ) + ( ( uint64_t ) h3 * r0 ) + \
+			 ( ( uint64_t ) h4 * s4 );
+		d4 = ( ( uint64_t ) h0 * r4 ) + ( ( uint64_t ) h1 * r3 ) + \
+			 ( ( uint64_t ) h2 * r2 ) + ( ( uint64_t ) h3 * r1 ) + \
+			 ( ( uint64_t ) h4 * r0 );
+
+		/* Partial reduction mod 2^130 - 5 */
+		c = ( uint32_t ) ( d0 >> 26 ); h0 = ( uint32_t ) d0 & MASK26;
+		d1 += c; c = ( uint32_t ) ( d1 >> 26 ); h1 = ( uint32_t ) d1 & MASK26;
+		d2 += c; c = ( uint32_t ) ( d2 >> 26 ); h2 = ( uint32_t ) d2 & MASK26;
+		d3 += c; c = ( uint32_t ) ( d3 >> 26 ); h3 = ( uint32_t ) d3 & MASK26;
+		d4 += c; c = ( uint32_t ) ( d4 >> 26 ); h4 = ( uint32_t ) d4 & MASK26;
+		h0 += c * 5; c = h0 >> 26; h0 &= MASK26;
+		h1 += c;
+		}
+	ctx->h[ 0 ] = h0;
+	ctx->h[ 1 ] = h1;
+	ctx->h[ 2 ] = h2;
+	ctx->h[ 3 ] = h3;
+	ctx->h[ 4 ] = h4;
+	}
+
+static void poly1305Finish( INOUT POLY1305_CTX *ctx,
+							OUT_BUFFER_FIXED_C( POLY1305_TAG_SIZE ) BYTE *tag )
+	{
+	uint32_t h0 = ctx->h[ 0 ], h1 = ctx->h[ 1 ], h2 = ctx->h[ 2 ];
+	uint32_t h3 = ctx->h[ 3 ], h4 = ctx->h[ 4 ];
+	uint32_t g0, g1, g2, g3, g4, c, mask;
+	uint64_t f;
+
+	/* Fully carry h */
+	c = h1 >> 26; h1 &= MASK26;
+	h2 += c; c = h2 >> 26; h2 &= MASK26;
+	h3 += c; c = h3 >> 26; h3 &= MASK26;
+	h4 += c; c = h4 >> 26; h4 &= MASK26;
+	h0 += c * 5; c = h0 >> 26; h0 &= MASK26;
+	h1 += c;
+
+	/* Compute g = h + -p = h - ( 2^130 - 5 ) and select h if h < p or g
+	   otherwise */
+	g0 = h0 + 5; c = g0 >> 26; g0 &= MASK26;
+	g1 = h1 + c; c = g1 >> 26; g1 &= MASK26;
+	g2 = h2 + c; c = g2 >> 26; g2 &= MASK26;
+	g3 = h3 + c; c = g3 >> 26; g3 &= MASK26;
+	g4 = h4 + c - ( ( uint32_t ) 1 << 26 );
+	mask = ( g4 >> 31 ) - 1;
+	g0 &= mask; g1 &= mask; g2 &= mask; g3 &= mask; g4 &= mask;
+	mask = ~mask;
+	h0 = ( h0 & mask ) | g0;
+	h1 = ( h1 & mask ) | g1;
+	h2 = ( h2 & mask ) | g2;
+	h3 = ( h3 & mask ) | g3;
+	h4 = ( h4 & mask ) | g4;
+
+	/* h = ( h + s ) mod 2^128 */
+	h0 = ( h0 | ( h1 << 26 ) ) & 0xFFFFFFFFUL;
+	h1 = ( ( h1 >> 6 ) | ( h2 << 20 ) ) & 0xFFFFFFFFUL;
+	h2 = ( ( h2 >> 12 ) | ( h3 << 14 ) ) & 0xFFFFFFFFUL;
+	h3 = ( ( h3 >> 18 ) | ( h4 << 8 ) ) & 0xFFFFFFFFUL;
+	f = ( uint64_t ) h0 + ctx->pad[ 0 ]; h0 = ( uint32_t ) f;
+	f = ( uint64_t ) h1 + ctx->pad[ 1 ] + ( f >> 32 ); h1 = ( uint32_t ) f;
+	f = ( uint64_t ) h2 + ctx->pad[ 2 ] + ( f >> 32 ); h2 = ( uint32_t ) f;
+	f = ( uint64_t ) h3 + ctx->pad[ 3 ] + ( f >> 32 ); h3 = ( uint32_t ) f;
+	STORE32_LE( tag, h0 );
+	STORE32_LE( tag + 4, h1 );
+	STORE32_LE( tag + 8, h2 );
+	STORE32_LE( tag + 12, h3 );
+	}
+#endif /* __SIZEOF_INT128__ */
+
+/****************************************************************************
+*																			*
+*								Poly1305 Interface							*
+*																			*
+****************************************************************************/
+
+/* MAC data, buffering any partial block until more data arrives */
+
+STDC_NONNULL_ARG( ( 1 ) ) \
+void poly1305Update( INOUT POLY1305_CTX *ctx,
+					 IN_BUFFER_OPT( length ) const BYTE *data,
+					 IN_LENGTH_Z const int length )
+	{
+	int bytesLeft = length;
+
+	assert( isWritePtr( ctx, sizeof( POLY1305_CTX ) ) );
+	assert( ( data == NULL && length == 0 ) || \
+			isReadPtrDynamic( data, length ) );
+
+	if( bytesLeft <= 0 )
+		return;
+
+	/* Complete any partial block from a previous call */
+	if( ctx->bufPos > 0 )
+		{
+		const int count = min( bytesLeft, \
+							   POLY1305_BLOCK_SIZE - ctx->bufPos );
+
+		memcpy( ctx->buffer + ctx->bufPos, data, count );
+		ctx->bufPos += count;
+		data += count;
+		bytesLeft -= count;
+		if( ctx->bufPos < POLY1305_BLOCK_SIZE )
+			return;
+		poly1305Blocks( ctx, ctx->buffer, POLY1305_BLOCK_SIZE, HIBIT_FULL );
+		ctx->bufPos = 0;
+		}
+
+	/* Process whole blocks directly from the input */
+	if( bytesLeft >= POLY1305_BLOCK_SIZE )
+		{
+		const int wholeBlocks = bytesLeft & ~( POLY1305_BLOCK_SIZE - 1 );
+
+		poly1305Blocks( ctx, data, wholeBlocks, HIBIT_FULL );
+		data += wholeBlocks;
+		bytesLeft -= wholeBlocks;
+		}
+
+	/* Save any remaining partial block */
+	if( bytesLeft > 0 )
+		{
+		memcpy( ctx->buffer, data, bytesLeft );
+		ctx->bufPos = bytesLeft;
+		}
+	}
+
+/* Zero-pad the data MAC'd so far to a multiple of the block size, as
+   required by the RFC 8439 AEAD construction */
+
+STDC_NONNULL_ARG( ( 1 ) ) \
+void poly1305Pad( INOUT POLY1305_CTX *ctx )
+	{
+	assert( isWritePtr( ctx, sizeof( POLY1305_CTX ) ) );
+
+	if( ctx->bufPos <= 0 )
+		return;
+	memset( ctx->buffer + ctx->bufPos, 0,
+			POLY1305_BLOCK_SIZE - ctx->bufPos );
+	poly1305Blocks( ctx, ctx->buffer, POLY1305_BLOCK_SIZE, HIBIT_FULL );
+	ctx->bufPos = 0;
+	}
+
+/* Wrap up the MAC'ing and return the tag.  A final partial block has a
+   single one bit appended in place of the 2^128 bit for full blocks */
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+void poly1305Final( INOUT POLY1305_CTX *ctx,
+					OUT_BUFFER_FIXED_C( POLY1305_TAG_SIZE ) BYTE *tag )
+	{
+	assert( isWritePtr( ctx, sizeof( POLY1305_CTX ) ) );
+	assert( isWritePtr( tag, POLY1305_TAG_SIZE ) );
+
+	if( ctx->bufPos > 0 )
+		{
+		ctx->buffer[ ctx->bufPos ] = 1;
+		if( ctx->bufPos + 1 < POLY1305_BLOCK_SIZE )
+			{
+			memset( ctx->buffer + ctx->bufPos + 1, 0,
+					POLY1305_BLOCK_SIZE - ( ctx->bufPos + 1 ) );
+			}
+		poly1305Blocks( ctx, ctx->buffer, POLY1305_BLOCK_SIZE, 0 );
+		ctx->bufPos = 0;
+		}
+	poly1305Finish( ctx, tag );
+	}
+#endif /* USE_CHACHA20 */
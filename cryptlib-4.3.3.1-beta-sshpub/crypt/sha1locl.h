@@ -62,9 +62,11 @@
 #if defined( INC_ALL )
   #include "crypt/osconfig.h"
   #include "sha.h"
+  #include "sha_ni.h"
 #else
   #include "crypt/osconfig.h"
   #include "crypt/sha.h"
+  #include "crypt/sha_ni.h"
 #endif /* Compiler-specific includes */
 
 #ifndef SHA_LONG_LOG2
@@ -240,6 +242,12 @@ void HASH_BLOCK_HOST_ORDER (SHA_CTX *c, const void *d, int num)
 	SHA_LONG	XX[16];
 #endif
 
+#if defined( SHA_1 ) && defined( USE_SHA_NI_IF_PRESENT )
+	/* Use the SHA-NI/AVX2 code if the CPU supports it - pcg */
+	if (sha1_hw_blocks(c,d,num,1))
+		return;
+#endif
+
 	A=c->h0;
 	B=c->h1;
 	C=c->h2;
@@ -365,6 +373,11 @@ void HASH_BLOCK_DATA_ORDER (SHA_CTX *c, const void *p, int num)
 	SHA_LONG	XX[16];
 #endif
 
+#if defined( SHA_1 ) && defined( USE_SHA_NI_IF_PRESENT )
+	if (sha1_hw_blocks(c,p,num,0))
+		return;
+#endif
+
 	A=c->h0;
 	B=c->h1;
 	C=c->h2;
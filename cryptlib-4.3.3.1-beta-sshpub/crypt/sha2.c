@@ -81,9 +81,11 @@
 
 #if defined( INC_ALL )
   #include "sha2.h"
+  #include "sha_ni.h"
   #include "brg_endian.h"
 #else
   #include "crypt/sha2.h"
+  #include "crypt/sha_ni.h"
   #include "crypt/brg_endian.h"
 #endif
 
@@ -199,6 +201,12 @@ VOID_RETURN sha256_compile(sha256_ctx ctx[1])
 
     uint32_t j, *p = ctx->wbuf, v[8];
 
+#if defined( USE_SHA_NI_IF_PRESENT )
+    /* use the SHA-NI/AVX2 code if the CPU supports it - pcg */
+    if(sha256_hw_blocks(ctx->hash, (const unsigned char*)ctx->wbuf, 1, 1))
+        return;
+#endif
+
     memcpy(v, ctx->hash, 8 * sizeof(uint32_t));
 
     for(j = 0; j < 64; j += 16)
@@ -222,6 +230,11 @@ VOID_RETURN sha256_compile(sha256_ctx ctx[1])
 
     uint32_t *p = ctx->wbuf,v0,v1,v2,v3,v4,v5,v6,v7;
 
+#if defined( USE_SHA_NI_IF_PRESENT )
+    if(sha256_hw_blocks(ctx->hash, (const unsigned char*)ctx->wbuf, 1, 1))
+        return;
+#endif
+
     v0 = ctx->hash[0]; v1 = ctx->hash[1];
     v2 = ctx->hash[2]; v3 = ctx->hash[3];
     v4 = ctx->hash[4]; v5 = ctx->hash[5];
@@ -315,6 +328,22 @@ VOID_RETURN sha256_hash(const unsigned char data[], unsigned long len, sha256_ct
 
     while(len >= space)     /* tranfer whole blocks while possible  */
     {
+#if defined( USE_SHA_NI_IF_PRESENT )
+        /* once we're block-aligned, pass all remaining whole blocks to
+           the SHA-NI/AVX2 code in one go if the CPU supports it, this
+           avoids the copy into the context buffer and the separate
+           byte-order conversion - pcg */
+        if(pos == 0)
+        {   const unsigned long blocks = len / SHA256_BLOCK_SIZE;
+
+            if(sha256_hw_blocks(ctx->hash, sp, blocks, 0))
+            {
+                sp += blocks * SHA256_BLOCK_SIZE;
+                len -= blocks * SHA256_BLOCK_SIZE;
+                break;
+            }
+        }
+#endif
         memcpy(((unsigned char*)ctx->wbuf) + pos, sp, space);
         sp += space; len -= space; space = SHA256_BLOCK_SIZE; pos = 0;
         bsw_32(ctx->wbuf, SHA256_BLOCK_SIZE >> 2)
@@ -0,0 +1,1140 @@
+/****************************************************************************
+*																			*
+*					cryptlib SHA-1/SHA-256 SHA-NI/AVX2 Routines				*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+/* Hardware-assisted SHA-1 and SHA-256 compression functions for x86-64.
+   If the CPU supports the SHA extensions then the entire compression
+   function, message schedule and rounds, is done with the SHA-NI
+   instructions following the sequence given in the Intel white paper "New
+   Instructions Supporting the Secure Hash Algorithm on Intel Architecture
+   Processors" by Gulley et al.
+
+   If there's no SHA-NI but AVX2 is available, the message schedule, which
+   accounts for a large part of the work in the C code, is computed with
+   vector operations for two blocks at a time, one block in each 128-bit
+   lane, four words per lane per step.  The schedule words have the round
+   constants added and are stored in a buffer from which the (inherently
+   serial) rounds for the two blocks are then run in turn, taking the
+   schedule computation out of the rounds' dependency chain entirely.  Where
+   there's an odd number of blocks the last one is loaded into both lanes
+   and the second lane's schedule is discarded.
+
+   The code is selected at runtime, on CPUs with neither the caller falls
+   back to the portable C code in sha1dgst.c/sha2.c.
+
+   In addition to the single-message compression functions there's an AVX2 
+   multi-buffer implementation of SHA-1 and SHA-256 that hashes eight 
+   independent messages at once, used for the batch hash functions that 
+   generate key IDs and certificate name hashes */
+
+#if defined( INC_ALL )
+  #include "crypt.h"
+  #include "sha.h"
+  #include "sha_ni.h"
+#else
+  #include "crypt.h"
+  #include "crypt/sha.h"
+  #include "crypt/sha_ni.h"
+#endif /* Compiler-specific includes */
+
+#ifdef USE_SHA_NI_IF_PRESENT
+
+#include <immintrin.h>
+
+/* The SHA-256 round constants, from sha2.c, and the SHA-1 ones */
+
+extern const uint32_t k256[ 64 ];
+
+#define SHA1_K1		0x5A827999UL
+#define SHA1_K2		0x6ED9EBA1UL
+#define SHA1_K3		0x8F1BBCDCUL
+#define SHA1_K4		0xCA62C1D6UL
+
+/* Scalar rotates and the SHA-1/SHA-256 round functions for the AVX2 code,
+   which vectorises the message schedule but runs the rounds as standard
+   scalar code */
+
+#define ROTL32( x, n )	( ( ( x ) << ( n ) ) | ( ( x ) >> ( 32 - ( n ) ) ) )
+#define ROTR32( x, n )	( ( ( x ) >> ( n ) ) | ( ( x ) << ( 32 - ( n ) ) ) )
+
+#define CH( x, y, z )	( ( z ) ^ ( ( x ) & ( ( y ) ^ ( z ) ) ) )
+#define PARITY( x, y, z ) ( ( x ) ^ ( y ) ^ ( z ) )
+#define MAJ( x, y, z )	( ( ( x ) & ( y ) ) | ( ( z ) & ( ( x ) | ( y ) ) ) )
+
+/****************************************************************************
+*																			*
+*								CPU Feature Checks							*
+*																			*
+****************************************************************************/
+
+/* Check whether the CPU supports the SHA extensions, and whether it 
+   supports AVX2 and the OS saves the YMM register state on context 
+   switches.  The CPU capabilities are determined when cryptlib starts up, 
+   see getHWInfo() in misc/os_spec.c, which only reports SHA-NI if SSSE3 
+   (for PSHUFB) and SSE4.1 (for PBLENDW and PEXTRD) are also present */
+
+static int hasSHANI( void )
+	{
+	return( ( getSysVar( SYSVAR_HWCAP ) & HWCAP_FLAG_SHA ) ? TRUE : FALSE );
+	}
+
+static int hasAVX2( void )
+	{
+	return( ( getSysVar( SYSVAR_HWCAP ) & HWCAP_FLAG_AVX2 ) ? TRUE : FALSE );
+	}
+
+/****************************************************************************
+*																			*
+*								SHA-NI Kernels								*
+*																			*
+****************************************************************************/
+
+/* The SHA-NI code is compiled for a target with the SHA extensions, which
+   is safe since it's only called once hasSHANI() has confirmed that the
+   CPU supports them */
+
+#if defined( __GNUC__ ) && !defined( _MSC_VER )
+  #pragma GCC push_options
+  #pragma GCC target( "sha", "ssse3", "sse4.1" )
+#endif /* gcc/clang */
+
+/* Load four message words, either converting them from big-endian byte
+   order or, if they're already in host byte order, using them as is.  The
+   SHA-1 instructions additionally expect the words in reverse order, with
+   the first word in the high lane */
+
+#define LOAD_SHA256( data, offset ) \
+		( hostOrder ? \
+			_mm_loadu_si128( ( const __m128i * ) ( ( data ) + ( offset ) ) ) : \
+			_mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i * ) \
+									( ( data ) + ( offset ) ) ), bswapMask ) )
+#define LOAD_SHA1( data, offset ) \
+		( hostOrder ? \
+			_mm_shuffle_epi32( _mm_loadu_si128( ( const __m128i * ) \
+									( ( data ) + ( offset ) ) ), 0x1B ) : \
+			_mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i * ) \
+									( ( data ) + ( offset ) ) ), bswapMask ) )
+
+/* Four SHA-256 rounds using the message words in msg, and the message
+   schedule step that computes the next four words from the current ones
+   once the SHA256MSG1 part has been applied to them */
+
+#define SHA256_ROUNDS4( msg, k ) \
+		wk = _mm_add_epi32( msg, _mm_loadu_si128( ( const __m128i * ) &k256[ k ] ) ); \
+		state1 = _mm_sha256rnds2_epu32( state1, state0, wk ); \
+		wk = _mm_shuffle_epi32( wk, 0x0E ); \
+		state0 = _mm_sha256rnds2_epu32( state0, state1, wk )
+#define SHA256_SCHEDULE( next, cur, prev ) \
+		next = _mm_sha256msg2_epu32( \
+					_mm_add_epi32( next, _mm_alignr_epi8( cur, prev, 4 ) ), cur )
+
+static void sha256BlocksNI( uint32_t hash[ 8 ], const BYTE *data,
+							unsigned long noBlocks, const int hostOrder )
+	{
+	const __m128i bswapMask = _mm_set_epi64x( 0x0C0D0E0F08090A0BLL,
+											  0x0405060700010203LL );
+	__m128i state0, state1, abefSave, cdghSave, wk, tmp;
+	__m128i msg0, msg1, msg2, msg3;
+
+	/* Rearrange the hash state from A...H into the ABEF/CDGH form used by
+	   the SHA-256 instructions */
+	tmp = _mm_loadu_si128( ( const __m128i * ) &hash[ 0 ] );
+	state1 = _mm_loadu_si128( ( const __m128i * ) &hash[ 4 ] );
+	tmp = _mm_shuffle_epi32( tmp, 0xB1 );			/* CDAB */
+	state1 = _mm_shuffle_epi32( state1, 0x1B );		/* EFGH */
+	state0 = _mm_alignr_epi8( tmp, state1, 8 );		/* ABEF */
+	state1 = _mm_blend_epi16( state1, tmp, 0xF0 );	/* CDGH */
+
+	for( ; noBlocks > 0; noBlocks--, data += 64 )
+		{
+		abefSave = state0;
+		cdghSave = state1;
+
+		/* Rounds 0-15, which use the message words directly */
+		msg0 = LOAD_SHA256( data, 0 );
+		SHA256_ROUNDS4( msg0, 0 );
+		msg1 = LOAD_SHA256( data, 16 );
+		SHA256_ROUNDS4( msg1, 4 );
+		msg0 = _mm_sha256msg1_epu32( msg0, msg1 );
+		msg2 = LOAD_SHA256( data, 32 );
+		SHA256_ROUNDS4( msg2, 8 );
+		msg1 = _mm_sha256msg1_epu32( msg1, msg2 );
+		msg3 = LOAD_SHA256( data, 48 );
+		SHA256_ROUNDS4( msg3, 12 );
+		SHA256_SCHEDULE( msg0, msg3, msg2 );
+		msg2 = _mm_sha256msg1_epu32( msg2, msg3 );
+
+		/* Rounds 16-51, with the message schedule computed alongside */
+		SHA256_ROUNDS4( msg0, 16 );
+		SHA256_SCHEDULE( msg1, msg0, msg3 );
+		msg3 = _mm_sha256msg1_epu32( msg3, msg0 );
+		SHA256_ROUNDS4( msg1, 20 );
+		SHA256_SCHEDULE( msg2, msg1, msg0 );
+		msg0 = _mm_sha256msg1_epu32( msg0, msg1 );
+		SHA256_ROUNDS4( msg2, 24 );
+		SHA256_SCHEDULE( msg3, msg2, msg1 );
+		msg1 = _mm_sha256msg1_epu32( msg1, msg2 );
+		SHA256_ROUNDS4( msg3, 28 );
+		SHA256_SCHEDULE( msg0, msg3, msg2 );
+		msg2 = _mm_sha256msg1_epu32( msg2, msg3 );
+		SHA256_ROUNDS4( msg0, 32 );
+		SHA256_SCHEDULE( msg1, msg0, msg3 );
+		msg3 = _mm_sha256msg1_epu32( msg3, msg0 );
+		SHA256_ROUNDS4( msg1, 36 );
+		SHA256_SCHEDULE( msg2, msg1, msg0 );
+		msg0 = _mm_sha256msg1_epu32( msg0, msg1 );
+		SHA256_ROUNDS4( msg2, 40 );
+		SHA256_SCHEDULE( msg3, msg2, msg1 );
+		msg1 = _mm_sha256msg1_epu32( msg1, msg2 );
+		SHA256_ROUNDS4( msg3, 44 );
+		SHA256_SCHEDULE( msg0, msg3, msg2 );
+		msg2 = _mm_sha256msg1_epu32( msg2, msg3 );
+		SHA256_ROUNDS4( msg0, 48 );
+		SHA256_SCHEDULE( msg1, msg0, msg3 );
+		msg3 = _mm_sha256msg1_epu32( msg3, msg0 );
+
+		/* Rounds 52-63, for which only the last few message words still
+		   need to be completed */
+		SHA256_ROUNDS4( msg1, 52 );
+		SHA256_SCHEDULE( msg2, msg1, msg0 );
+		SHA256_ROUNDS4( msg2, 56 );
+		SHA256_SCHEDULE( msg3, msg2, msg1 );
+		SHA256_ROUNDS4( msg3, 60 );
+
+		state0 = _mm_add_epi32( state0, abefSave );
+		state1 = _mm_add_epi32( state1, cdghSave );
+		}
+
+	/* Convert the state back to A...H form */
+	tmp = _mm_shuffle_epi32( state0, 0x1B );		/* FEBA */
+	state1 = _mm_shuffle_epi32( state1, 0xB1 );		/* DCHG */
+	state0 = _mm_blend_epi16( tmp, state1, 0xF0 );	/* DCBA */
+	state1 = _mm_alignr_epi8( state1, tmp, 8 );		/* HGFE */
+	_mm_storeu_si128( ( __m128i * ) &hash[ 0 ], state0 );
+	_mm_storeu_si128( ( __m128i * ) &hash[ 4 ], state1 );
+	}
+
+/* Four SHA-1 rounds using the message words in msg, with eIn being the
+   E value for these rounds and eOut receiving the one for the next four,
+   and the message schedule step that's performed alongside them for
+   rounds 12-67 */
+
+#define SHA1_ROUNDS4( eIn, eOut, msg, func ) \
+		eIn = _mm_sha1nexte_epu32( eIn, msg ); \
+		eOut = abcd; \
+		abcd = _mm_sha1rnds4_epu32( abcd, eIn, func )
+#define SHA1_SCHEDULE( next, cur, prev, next2 ) \
+		next = _mm_sha1msg2_epu32( next, cur ); \
+		prev = _mm_sha1msg1_epu32( prev, cur ); \
+		next2 = _mm_xor_si128( next2, cur )
+
+static void sha1BlocksNI( SHA_CTX *c, const BYTE *data, int noBlocks,
+						  const int hostOrder )
+	{
+	const __m128i bswapMask = _mm_set_epi64x( 0x0001020304050607LL,
+											  0x08090A0B0C0D0E0FLL );
+	__m128i abcd, abcdSave, e0, e0Save, e1;
+	__m128i msg0, msg1, msg2, msg3;
+
+	abcd = _mm_set_epi32( ( int ) c->h0, ( int ) c->h1, ( int ) c->h2,
+						  ( int ) c->h3 );
+	e0 = _mm_set_epi32( ( int ) c->h4, 0, 0, 0 );
+
+	for( ; noBlocks > 0; noBlocks--, data += 64 )
+		{
+		abcdSave = abcd;
+		e0Save = e0;
+
+		/* Rounds 0-15, which use the message words directly */
+		msg0 = LOAD_SHA1( data, 0 );
+		e0 = _mm_add_epi32( e0, msg0 );
+		e1 = abcd;
+		abcd = _mm_sha1rnds4_epu32( abcd, e0, 0 );
+		msg1 = LOAD_SHA1( data, 16 );
+		SHA1_ROUNDS4( e1, e0, msg1, 0 );
+		msg0 = _mm_sha1msg1_epu32( msg0, msg1 );
+		msg2 = LOAD_SHA1( data, 32 );
+		SHA1_ROUNDS4( e0, e1, msg2, 0 );
+		msg1 = _mm_sha1msg1_epu32( msg1, msg2 );
+		msg0 = _mm_xor_si128( msg0, msg2 );
+		msg3 = LOAD_SHA1( data, 48 );
+		SHA1_ROUNDS4( e1, e0, msg3, 0 );
+		SHA1_SCHEDULE( msg0, msg3, msg2, msg1 );
+
+		/* Rounds 16-67, with the message schedule computed alongside */
+		SHA1_ROUNDS4( e0, e1, msg0, 0 );
+		SHA1_SCHEDULE( msg1, msg0, msg3, msg2 );
+		SHA1_ROUNDS4( e1, e0, msg1, 1 );
+		SHA1_SCHEDULE( msg2, msg1, msg0, msg3 );
+		SHA1_ROUNDS4( e0, e1, msg2, 1 );
+		SHA1_SCHEDULE( msg3, msg2, msg1, msg0 );
+		SHA1_ROUNDS4( e1, e0, msg3, 1 );
+		SHA1_SCHEDULE( msg0, msg3, msg2, msg1 );
+		SHA1_ROUNDS4( e0, e1, msg0, 1 );
+		SHA1_SCHEDULE( msg1, msg0, msg3, msg2 );
+		SHA1_ROUNDS4( e1, e0, msg1, 1 );
+		SHA1_SCHEDULE( msg2, msg1, msg0, msg3 );
+		SHA1_ROUNDS4( e0, e1, msg2, 2 );
+		SHA1_SCHEDULE( msg3, msg2, msg1, msg0 );
+		SHA1_ROUNDS4( e1, e0, msg3, 2 );
+		SHA1_SCHEDULE( msg0, msg3, msg2, msg1 );
+		SHA1_ROUNDS4( e0, e1, msg0, 2 );
+		SHA1_SCHEDULE( msg1, msg0, msg3, msg2 );
+		SHA1_ROUNDS4( e1, e0, msg1, 2 );
+		SHA1_SCHEDULE( msg2, msg1, msg0, msg3 );
+		SHA1_ROUNDS4( e0, e1, msg2, 2 );
+		SHA1_SCHEDULE( msg3, msg2, msg1, msg0 );
+		SHA1_ROUNDS4( e1, e0, msg3, 3 );
+		SHA1_SCHEDULE( msg0, msg3, msg2, msg1 );
+		SHA1_ROUNDS4( e0, e1, msg0, 3 );
+		SHA1_SCHEDULE( msg1, msg0, msg3, msg2 );
+
+		/* Rounds 68-79, for which only the last few message words still
+		   need to be completed */
+		SHA1_ROUNDS4( e1, e0, msg1, 3 );
+		msg2 = _mm_sha1msg2_epu32( msg2, msg1 );
+		msg3 = _mm_xor_si128( msg3, msg1 );
+		SHA1_ROUNDS4( e0, e1, msg2, 3 );
+		msg3 = _mm_sha1msg2_epu32( msg3, msg2 );
+		SHA1_ROUNDS4( e1, e0, msg3, 3 );
+
+		e0 = _mm_sha1nexte_epu32( e0, e0Save );
+		abcd = _mm_add_epi32( abcd, abcdSave );
+		}
+
+	c->h0 = ( SHA_LONG ) _mm_extract_epi32( abcd, 3 );
+	c->h1 = ( SHA_LONG ) _mm_extract_epi32( abcd, 2 );
+	c->h2 = ( SHA_LONG ) _mm_extract_epi32( abcd, 1 );
+	c->h3 = ( SHA_LONG ) _mm_extract_epi32( abcd, 0 );
+	c->h4 = ( SHA_LONG ) _mm_extract_epi32( e0, 3 );
+	}
+
+#if defined( __GNUC__ ) && !defined( _MSC_VER )
+  #pragma GCC pop_options
+#endif /* gcc/clang */
+
+/****************************************************************************
+*																			*
+*							AVX2 Message Schedule Kernels					*
+*																			*
+****************************************************************************/
+
+/* The AVX2 code is compiled for an AVX2 target, which is safe since it's
+   only called once hasAVX2() has confirmed that the CPU supports it */
+
+#if defined( __GNUC__ ) && !defined( _MSC_VER )
+  #pragma GCC push_options
+  #pragma GCC target( "avx2" )
+#endif /* gcc/clang */
+
+/* The W + K values for two blocks are stored interleaved four words at a
+   time, so that round t for the first block uses the value at position
+   WK_INDEX( t ) and for the second block the one four words further on */
+
+#define WK_INDEX( t )	( ( ( ( t ) >> 2 ) << 3 ) + ( ( t ) & 3 ) )
+
+#define ROTL256( x, n ) \
+		_mm256_or_si256( _mm256_slli_epi32( x, n ), \
+						 _mm256_srli_epi32( x, 32 - ( n ) ) )
+#define ROTR256( x, n ) \
+		_mm256_or_si256( _mm256_srli_epi32( x, n ), \
+						 _mm256_slli_epi32( x, 32 - ( n ) ) )
+
+/* Load the same 16 bytes from two blocks, one into each 128-bit lane,
+   converting them from big-endian form if necessary */
+
+static __m256i load2Blocks( const BYTE *blockA, const BYTE *blockB,
+							const int offset, const int hostOrder )
+	{
+	const __m256i bswapMask = \
+			_mm256_set_epi64x( 0x0C0D0E0F08090A0BLL, 0x0405060700010203LL,
+							   0x0C0D0E0F08090A0BLL, 0x0405060700010203LL );
+	__m256i value;
+
+	value = _mm256_inserti128_si256( _mm256_castsi128_si256(
+				_mm_loadu_si128( ( const __m128i * ) ( blockA + offset ) ) ),
+				_mm_loadu_si128( ( const __m128i * ) ( blockB + offset ) ), 1 );
+	return( hostOrder ? value : _mm256_shuffle_epi8( value, bswapMask ) );
+	}
+
+/* Compute the next four SHA-256 message words W[ t...t + 3 ] for both
+   blocks from x0...x3 = W[ t - 16...t - 1 ].  The sigma1 terms for the
+   last two words depend on the first two, so they're computed in two
+   halves */
+
+#define SIGMA0_256( x ) \
+		_mm256_xor_si256( _mm256_xor_si256( ROTR256( x, 7 ), ROTR256( x, 18 ) ), \
+						  _mm256_srli_epi32( x, 3 ) )
+#define SIGMA1_256( x ) \
+		_mm256_xor_si256( _mm256_xor_si256( ROTR256( x, 17 ), ROTR256( x, 19 ) ), \
+						  _mm256_srli_epi32( x, 10 ) )
+
+static __m256i scheduleSHA256( const __m256i x0, const __m256i x1,
+							   const __m256i x2, const __m256i x3 )
+	{
+	__m256i w;
+
+	/* W[ t - 16 ] + sigma0( W[ t - 15 ] ) + W[ t - 7 ] */
+	w = _mm256_add_epi32( x0, SIGMA0_256( _mm256_alignr_epi8( x1, x0, 4 ) ) );
+	w = _mm256_add_epi32( w, _mm256_alignr_epi8( x3, x2, 4 ) );
+
+	/* sigma1( W[ t - 2 ] ) for the first two words, then the same for the
+	   last two words using the now-complete first two */
+	w = _mm256_add_epi32( w, _mm256_srli_si256( SIGMA1_256( x3 ), 8 ) );
+	return( _mm256_add_epi32( w, _mm256_slli_si256( SIGMA1_256( w ), 8 ) ) );
+	}
+
+/* Compute the SHA-256 message schedule plus round constants for two
+   blocks */
+
+static void wkSHA256( uint32_t wk[ 128 ], const BYTE *blockA,
+					  const BYTE *blockB, const int hostOrder )
+	{
+	__m256i w[ 16 ];
+	int i;
+
+	for( i = 0; i < 4; i++ )
+		w[ i ] = load2Blocks( blockA, blockB, i * 16, hostOrder );
+	for( i = 4; i < 16; i++ )
+		{
+		w[ i ] = scheduleSHA256( w[ i - 4 ], w[ i - 3 ], w[ i - 2 ],
+								 w[ i - 1 ] );
+		}
+	for( i = 0; i < 16; i++ )
+		{
+		const __m256i k = _mm256_broadcastsi128_si256(
+					_mm_loadu_si128( ( const __m128i * ) &k256[ i * 4 ] ) );
+
+		_mm256_storeu_si256( ( __m256i * ) &wk[ i * 8 ],
+							 _mm256_add_epi32( w[ i ], k ) );
+		}
+	}
+
+/* Run the SHA-256 rounds for one block using the precomputed W + K
+   values.  As with the unrolled code in sha2.c, rather than moving the
+   variables around on each round we rotate their roles */
+
+#define SUM0_256( x )	( ROTR32( x, 2 ) ^ ROTR32( x, 13 ) ^ ROTR32( x, 22 ) )
+#define SUM1_256( x )	( ROTR32( x, 6 ) ^ ROTR32( x, 11 ) ^ ROTR32( x, 25 ) )
+
+#define ROUND_SHA256( a, b, c, d, e, f, g, h, t ) \
+		h += SUM1_256( e ) + CH( e, f, g ) + wk[ WK_INDEX( t ) ]; \
+		d += h; \
+		h += SUM0_256( a ) + MAJ( a, b, c )
+
+static void roundsSHA256( uint32_t hash[ 8 ], const uint32_t *wk )
+	{
+	uint32_t a = hash[ 0 ], b = hash[ 1 ], c = hash[ 2 ], d = hash[ 3 ];
+	uint32_t e = hash[ 4 ], f = hash[ 5 ], g = hash[ 6 ], h = hash[ 7 ];
+	int t;
+
+	for( t = 0; t < 64; t += 8 )
+		{
+		ROUND_SHA256( a, b, c, d, e, f, g, h, t );
+		ROUND_SHA256( h, a, b, c, d, e, f, g, t + 1 );
+		ROUND_SHA256( g, h, a, b, c, d, e, f, t + 2 );
+		ROUND_SHA256( f, g, h, a, b, c, d, e, t + 3 );
+		ROUND_SHA256( e, f, g, h, a, b, c, d, t + 4 );
+		ROUND_SHA256( d, e, f, g, h, a, b, c, t + 5 );
+		ROUND_SHA256( c, d, e, f, g, h, a, b, t + 6 );
+		ROUND_SHA256( b, c, d, e, f, g, h, a, t + 7 );
+		}
+
+	hash[ 0 ] += a; hash[ 1 ] += b; hash[ 2 ] += c; hash[ 3 ] += d;
+	hash[ 4 ] += e; hash[ 5 ] += f; hash[ 6 ] += g; hash[ 7 ] += h;
+	}
+
+static void sha256BlocksAVX2( uint32_t hash[ 8 ], const BYTE *data,
+							  unsigned long noBlocks, const int hostOrder )
+	{
+	uint32_t wk[ 128 ];
+
+	while( noBlocks > 0 )
+		{
+		const BYTE *blockB = ( noBlocks > 1 ) ? data + 64 : data;
+
+		wkSHA256( wk, data, blockB, hostOrder );
+		roundsSHA256( hash, wk );
+		if( noBlocks < 2 )
+			break;
+		roundsSHA256( hash, wk + 4 );
+		data += 128;
+		noBlocks -= 2;
+		}
+	}
+
+/* Compute the next four SHA-1 message words W[ t...t + 3 ] for both blocks
+   from x0...x3 = W[ t - 16...t - 1 ].  The last word depends on the first
+   one, so its W[ t - 3 ] term is initially zero and the missing
+   contribution, which after the rotate comes out as the first word's
+   pre-rotate value rotated by two, is added in afterwards */
+
+static __m256i scheduleSHA1( const __m256i x0, const __m256i x1,
+							 const __m256i x2, const __m256i x3 )
+	{
+	__m256i w, fixup;
+
+	/* W[ t - 16 ] ^ W[ t - 14 ] ^ W[ t - 8 ] ^ W[ t - 3 ] */
+	w = _mm256_xor_si256( x0, _mm256_alignr_epi8( x1, x0, 8 ) );
+	w = _mm256_xor_si256( w, x2 );
+	w = _mm256_xor_si256( w, _mm256_srli_si256( x3, 4 ) );
+
+	/* Rotate, and add in the first word's contribution to the last one */
+	fixup = _mm256_slli_si256( w, 12 );
+	w = ROTL256( w, 1 );
+	return( _mm256_xor_si256( w, ROTL256( fixup, 2 ) ) );
+	}
+
+/* Compute the SHA-1 message schedule plus round constants for two blocks */
+
+static void wkSHA1( uint32_t wk[ 160 ], const BYTE *blockA,
+					const BYTE *blockB, const int hostOrder )
+	{
+	static const uint32_t sha1K[ 4 ] = {
+		SHA1_K1, SHA1_K2, SHA1_K3, SHA1_K4 };
+	__m256i w[ 20 ];
+	int i;
+
+	for( i = 0; i < 4; i++ )
+		w[ i ] = load2Blocks( blockA, blockB, i * 16, hostOrder );
+	for( i = 4; i < 20; i++ )
+		{
+		w[ i ] = scheduleSHA1( w[ i - 4 ], w[ i - 3 ], w[ i - 2 ],
+							   w[ i - 1 ] );
+		}
+	for( i = 0; i < 20; i++ )
+		{
+		const __m256i k = _mm256_set1_epi32( ( int ) sha1K[ i / 5 ] );
+
+		_mm256_storeu_si256( ( __m256i * ) &wk[ i * 8 ],
+							 _mm256_add_epi32( w[ i ], k ) );
+		}
+	}
+
+/* Run the SHA-1 rounds for one block using the precomputed W + K values */
+
+#define ROUND_SHA1( a, b, c, d, e, func, t ) \
+		e += ROTL32( a, 5 ) + func( b, c, d ) + wk[ WK_INDEX( t ) ]; \
+		b = ROTL32( b, 30 )
+
+#define ROUNDS5_SHA1( func, t ) \
+		ROUND_SHA1( a, b, c, d, e, func, t ); \
+		ROUND_SHA1( e, a, b, c, d, func, t + 1 ); \
+		ROUND_SHA1( d, e, a, b, c, func, t + 2 ); \
+		ROUND_SHA1( c, d, e, a, b, func, t + 3 ); \
+		ROUND_SHA1( b, c, d, e, a, func, t + 4 )
+
+static void roundsSHA1( SHA_CTX *ctx, const uint32_t *wk )
+	{
+	uint32_t a = ctx->h0, b = ctx->h1, c = ctx->h2, d = ctx->h3;
+	uint32_t e = ctx->h4;
+	int t;
+
+	for( t = 0; t < 20; t += 5 )
+		{
+		ROUNDS5_SHA1( CH, t );
+		}
+	for( t = 20; t < 40; t += 5 )
+		{
+		ROUNDS5_SHA1( PARITY, t );
+		}
+	for( t = 40; t < 60; t += 5 )
+		{
+		ROUNDS5_SHA1( MAJ, t );
+		}
+	for( t = 60; t < 80; t += 5 )
+		{
+		ROUNDS5_SHA1( PARITY, t );
+		}
+
+	ctx->h0 += a; ctx->h1 += b; ctx->h2 += c; ctx->h3 += d; ctx->h4 += e;
+	}
+
+static void sha1BlocksAVX2( SHA_CTX *c, const BYTE *data, int noBlocks,
+							const int hostOrder )
+	{
+	uint32_t wk[ 160 ];
+
+	while( noBlocks > 0 )
+		{
+		const BYTE *blockB = ( noBlocks > 1 ) ? data + 64 : data;
+
+		wkSHA1( wk, data, blockB, hostOrder );
+		roundsSHA1( c, wk );
+		if( noBlocks < 2 )
+			break;
+		roundsSHA1( c, wk + 4 );
+		data += 128;
+		noBlocks -= 2;
+		}
+	}
+
+#if defined( __GNUC__ ) && !defined( _MSC_VER )
+  #pragma GCC pop_options
+#endif /* gcc/clang */
+
+/****************************************************************************
+*																			*
+*							AVX2 Multi-buffer Kernels						*
+*																			*
+****************************************************************************/
+
+/* Hashing a set of short, independent messages one at a time leaves most 
+   of the vector unit idle since the rounds for any one message are 
+   inherently serial.  The multi-buffer code instead hashes eight messages 
+   at once, one in each 32-bit lane of the AVX2 registers, with the hash 
+   state held transposed so that word j of the state for the message in 
+   lane i is in element i of state[ j ].  Each lane takes its next block 
+   either directly from its message or, for the final one or two blocks, 
+   from a per-lane buffer containing the padded tail of the message.  When 
+   a lane's message is complete its hash is extracted and the next message 
+   in the batch is started in that lane, and once the batch runs out any 
+   idle lanes are fed a dummy block and their results discarded */
+
+#if defined( __GNUC__ ) && !defined( _MSC_VER )
+  #pragma GCC push_options
+  #pragma GCC target( "avx2" )
+#endif /* gcc/clang */
+
+#define MB_LANES		8
+
+typedef struct {
+	const BYTE *data;			/* Next full block of message data */
+	long noBlocks;				/* Number of full blocks remaining */
+	BYTE tail[ 128 + 8 ];		/* Padded final block(s) of message */
+	int tailBlocks, tailPos;	/* No.of and position in padded blocks */
+	HASH_BATCH_INFO *entry;		/* Batch entry being hashed, NULL if idle */
+	} MB_LANE;
+
+typedef void ( *MB_STEP_FUNCTION )( uint32_t state[ 8 ][ MB_LANES ],
+									const BYTE *blocks[ MB_LANES ] );
+
+/* Load eight big-endian message words from the block for each lane and 
+   transpose them so that w[ t ] contains word t for all eight lanes */
+
+static void loadMB( __m256i w[ 8 ], const BYTE *blocks[ MB_LANES ],
+					const int offset )
+	{
+	const __m256i bswapMask = \
+			_mm256_set_epi64x( 0x0C0D0E0F08090A0BLL, 0x0405060700010203LL,
+							   0x0C0D0E0F08090A0BLL, 0x0405060700010203LL );
+	__m256i r[ 8 ], t[ 8 ];
+	int i;
+
+	for( i = 0; i < MB_LANES; i++ )
+		{
+		r[ i ] = _mm256_shuffle_epi8( _mm256_loadu_si256( 
+					( const __m256i * ) ( blocks[ i ] + offset ) ), bswapMask );
+		}
+	for( i = 0; i < MB_LANES; i += 2 )
+		{
+		t[ i ] = _mm256_unpacklo_epi32( r[ i ], r[ i + 1 ] );
+		t[ i + 1 ] = _mm256_unpackhi_epi32( r[ i ], r[ i + 1 ] );
+		}
+	for( i = 0; i < MB_LANES; i += 4 )
+		{
+		r[ i ] = _mm256_unpacklo_epi64( t[ i ], t[ i + 2 ] );
+		r[ i + 1 ] = _mm256_unpackhi_epi64( t[ i ], t[ i + 2 ] );
+		r[ i + 2 ] = _mm256_unpacklo_epi64( t[ i + 1 ], t[ i + 3 ] );
+		r[ i + 3 ] = _mm256_unpackhi_epi64( t[ i + 1 ], t[ i + 3 ] );
+		}
+	for( i = 0; i < 4; i++ )
+		{
+		w[ i ] = _mm256_permute2x128_si256( r[ i ], r[ i + 4 ], 0x20 );
+		w[ i + 4 ] = _mm256_permute2x128_si256( r[ i ], r[ i + 4 ], 0x31 );
+		}
+	}
+
+#define ADD256( x, y )	_mm256_add_epi32( x, y )
+#define XOR256( x, y )	_mm256_xor_si256( x, y )
+#define CH256( x, y, z ) \
+		XOR256( z, _mm256_and_si256( x, XOR256( y, z ) ) )
+#define PARITY256( x, y, z ) \
+		XOR256( XOR256( x, y ), z )
+#define MAJ256( x, y, z ) \
+		_mm256_or_si256( _mm256_and_si256( x, y ), \
+						 _mm256_and_si256( z, _mm256_or_si256( x, y ) ) )
+#define LOAD_STATE( state, j ) \
+		_mm256_loadu_si256( ( const __m256i * ) state[ j ] )
+#define STORE_STATE( state, j, value ) \
+		_mm256_storeu_si256( ( __m256i * ) state[ j ], value )
+
+/* Run the SHA-256 compression function over one block in each lane, with 
+   the message words already transposed into w.  The message schedule is
+   computed in place in w */
+
+#define SUM0_MB( x ) \
+		XOR256( XOR256( ROTR256( x, 2 ), ROTR256( x, 13 ) ), ROTR256( x, 22 ) )
+#define SUM1_MB( x ) \
+		XOR256( XOR256( ROTR256( x, 6 ), ROTR256( x, 11 ) ), ROTR256( x, 25 ) )
+
+static void sha256Compress8( __m256i hash[ 8 ], __m256i w[ 16 ] )
+	{
+	__m256i a, b, c, d, e, f, g, h;
+	int t;
+
+	a = hash[ 0 ]; b = hash[ 1 ]; c = hash[ 2 ]; d = hash[ 3 ];
+	e = hash[ 4 ]; f = hash[ 5 ]; g = hash[ 6 ]; h = hash[ 7 ];
+	for( t = 0; t < 64; t++ )
+		{
+		__m256i t1, t2;
+
+		if( t >= 16 )
+			{
+			const __m256i w2 = w[ ( t - 2 ) & 15 ], w15 = w[ ( t - 15 ) & 15 ];
+
+			w[ t & 15 ] = ADD256( ADD256( w[ t & 15 ], w[ ( t - 7 ) & 15 ] ),
+								  ADD256( SIGMA0_256( w15 ), SIGMA1_256( w2 ) ) );
+			}
+		t1 = ADD256( ADD256( h, SUM1_MB( e ) ),
+					 ADD256( CH256( e, f, g ),
+							 ADD256( _mm256_set1_epi32( k256[ t ] ),
+									 w[ t & 15 ] ) ) );
+		t2 = ADD256( SUM0_MB( a ), MAJ256( a, b, c ) );
+		h = g; g = f; f = e; e = ADD256( d, t1 );
+		d = c; c = b; b = a; a = ADD256( t1, t2 );
+		}
+	hash[ 0 ] = ADD256( hash[ 0 ], a ); hash[ 1 ] = ADD256( hash[ 1 ], b );
+	hash[ 2 ] = ADD256( hash[ 2 ], c ); hash[ 3 ] = ADD256( hash[ 3 ], d );
+	hash[ 4 ] = ADD256( hash[ 4 ], e ); hash[ 5 ] = ADD256( hash[ 5 ], f );
+	hash[ 6 ] = ADD256( hash[ 6 ], g ); hash[ 7 ] = ADD256( hash[ 7 ], h );
+	}
+
+/* Run the SHA-1 compression function over one block in each lane, as for
+   the SHA-256 one */
+
+static void sha1Compress8( __m256i hash[ 8 ], __m256i w[ 16 ] )
+	{
+	__m256i a, b, c, d, e;
+	int t;
+
+	a = hash[ 0 ]; b = hash[ 1 ]; c = hash[ 2 ]; d = hash[ 3 ];
+	e = hash[ 4 ];
+	for( t = 0; t < 80; t++ )
+		{
+		__m256i f, k, temp;
+
+		if( t >= 16 )
+			{
+			temp = XOR256( XOR256( w[ ( t - 3 ) & 15 ], w[ ( t - 8 ) & 15 ] ),
+						   XOR256( w[ ( t - 14 ) & 15 ], w[ t & 15 ] ) );
+			w[ t & 15 ] = ROTL256( temp, 1 );
+			}
+		if( t < 20 )
+			{
+			f = CH256( b, c, d );
+			k = _mm256_set1_epi32( SHA1_K1 );
+			}
+		else
+		if( t < 40 )
+			{
+			f = PARITY256( b, c, d );
+			k = _mm256_set1_epi32( SHA1_K2 );
+			}
+		else
+		if( t < 60 )
+			{
+			f = MAJ256( b, c, d );
+			k = _mm256_set1_epi32( SHA1_K3 );
+			}
+		else
+			{
+			f = PARITY256( b, c, d );
+			k = _mm256_set1_epi32( SHA1_K4 );
+			}
+		temp = ADD256( ADD256( ROTL256( a, 5 ), f ),
+					   ADD256( ADD256( e, k ), w[ t & 15 ] ) );
+		e = d; d = c; c = ROTL256( b, 30 ); b = a; a = temp;
+		}
+	hash[ 0 ] = ADD256( hash[ 0 ], a ); hash[ 1 ] = ADD256( hash[ 1 ], b );
+	hash[ 2 ] = ADD256( hash[ 2 ], c ); hash[ 3 ] = ADD256( hash[ 3 ], d );
+	hash[ 4 ] = ADD256( hash[ 4 ], e );
+	}
+
+/* Run the compression function over one block from each lane's message, 
+   with the hash state for the lanes held in memory between calls */
+
+static void sha256Step8( uint32_t state[ 8 ][ MB_LANES ],
+						 const BYTE *blocks[ MB_LANES ] )
+	{
+	__m256i w[ 16 ], hash[ 8 ];
+	int j;
+
+	loadMB( w, blocks, 0 );
+	loadMB( w + 8, blocks, 32 );
+	for( j = 0; j < 8; j++ )
+		hash[ j ] = LOAD_STATE( state, j );
+	sha256Compress8( hash, w );
+	for( j = 0; j < 8; j++ )
+		STORE_STATE( state, j, hash[ j ] );
+	}
+
+static void sha1Step8( uint32_t state[ 8 ][ MB_LANES ],
+					   const BYTE *blocks[ MB_LANES ] )
+	{
+	__m256i w[ 16 ], hash[ 8 ];
+	int j;
+
+	loadMB( w, blocks, 0 );
+	loadMB( w + 8, blocks, 32 );
+	for( j = 0; j < 5; j++ )
+		hash[ j ] = LOAD_STATE( state, j );
+	sha1Compress8( hash, w );
+	for( j = 0; j < 5; j++ )
+		STORE_STATE( state, j, hash[ j ] );
+	}
+
+/* Start hashing a new message in a lane.  The message data is used in 
+   place apart from the last partial block, which is copied into the tail 
+   buffer along with the padding and the big-endian bit count */
+
+static void mbStartLane( MB_LANE *lane, uint32_t state[ 8 ][ MB_LANES ],
+						 const int laneNo, HASH_BATCH_INFO *entry,
+						 const uint32_t *iv, const int stateWords )
+	{
+	const long length = entry->dataLength;
+	const int remainder = ( int ) ( length & 63 );
+	BYTE *lengthPtr;
+	int j;
+
+	lane->data = entry->data;
+	lane->noBlocks = length >> 6;
+	memset( lane->tail, 0, 128 );
+	if( remainder > 0 )
+		memcpy( lane->tail, lane->data + ( lane->noBlocks << 6 ), remainder );
+	lane->tail[ remainder ] = 0x80;
+	lane->tailBlocks = ( remainder < 56 ) ? 1 : 2;
+	lane->tailPos = 0;
+	lengthPtr = lane->tail + ( lane->tailBlocks * 64 ) - 5;
+	lengthPtr[ 0 ] = ( BYTE ) ( length >> 29 );
+	lengthPtr[ 1 ] = ( BYTE ) ( length >> 21 );
+	lengthPtr[ 2 ] = ( BYTE ) ( length >> 13 );
+	lengthPtr[ 3 ] = ( BYTE ) ( length >> 5 );
+	lengthPtr[ 4 ] = ( BYTE ) ( length << 3 );
+	lane->entry = entry;
+	for( j = 0; j < stateWords; j++ )
+		state[ j ][ laneNo ] = iv[ j ];
+	}
+
+/* Hash a batch of messages, refilling lanes as the messages in them are
+   completed */
+
+static void mbHash( HASH_BATCH_INFO *hashBatchInfo, const int noEntries,
+					const uint32_t *iv, const int stateWords,
+					const MB_STEP_FUNCTION stepFunction )
+	{
+	static const BYTE dummyBlock[ 64 + 8 ] = { 0 };
+	MB_LANE lanes[ MB_LANES ];
+	uint32_t state[ 8 ][ MB_LANES ];
+	int nextEntry = 0, activeLanes = 0, i, j;
+
+	for( i = 0; i < MB_LANES; i++ )
+		{
+		if( nextEntry >= noEntries )
+			{
+			lanes[ i ].entry = NULL;
+			continue;
+			}
+		mbStartLane( &lanes[ i ], state, i, &hashBatchInfo[ nextEntry++ ],
+					 iv, stateWords );
+		activeLanes++;
+		}
+	while( activeLanes > 0 )
+		{
+		const BYTE *blocks[ MB_LANES ];
+
+		/* Get the next block for each lane */
+		for( i = 0; i < MB_LANES; i++ )
+			{
+			MB_LANE *lane = &lanes[ i ];
+
+			if( lane->entry == NULL )
+				blocks[ i ] = dummyBlock;
+			else
+			if( lane->noBlocks > 0 )
+				{
+				blocks[ i ] = lane->data;
+				lane->data += 64;
+				lane->noBlocks--;
+				}
+			else
+				blocks[ i ] = lane->tail + ( 64 * lane->tailPos++ );
+			}
+
+		stepFunction( state, blocks );
+
+		/* Extract the hash for any completed messages and start the next 
+		   message in the batch in their place */
+		for( i = 0; i < MB_LANES; i++ )
+			{
+			MB_LANE *lane = &lanes[ i ];
+
+			if( lane->entry == NULL || lane->noBlocks > 0 || \
+				lane->tailPos < lane->tailBlocks )
+				continue;
+			for( j = 0; j < stateWords; j++ )
+				{
+				const uint32_t value = state[ j ][ i ];
+				BYTE *hashPtr = lane->entry->hash + ( j * 4 );
+
+				hashPtr[ 0 ] = ( BYTE ) ( value >> 24 );
+				hashPtr[ 1 ] = ( BYTE ) ( value >> 16 );
+				hashPtr[ 2 ] = ( BYTE ) ( value >> 8 );
+				hashPtr[ 3 ] = ( BYTE ) value;
+				}
+			if( nextEntry < noEntries )
+				{
+				mbStartLane( lane, state, i, &hashBatchInfo[ nextEntry++ ], 
+							 iv, stateWords );
+				}
+			else
+				{
+				lane->entry = NULL;
+				activeLanes--;
+				}
+			}
+		}
+	zeroise( lanes, sizeof( MB_LANE ) * MB_LANES );
+	zeroise( state, sizeof( uint32_t ) * 8 * MB_LANES );
+	}
+
+/* Run a set of HMAC iteration chains, one per lane.  Each iteration is 
+   U = H( outer || H( inner || U ) ) followed by output ^= U, where inner 
+   and outer are the hash states after the ipad and opad blocks have been 
+   processed, so the message in each case is a single padded block 
+   containing the previous hash value.  This means that the whole chain can 
+   be run in registers, with the message words coming directly from the 
+   previous hash value rather than having to be loaded and transposed */
+
+typedef void ( *MB_COMPRESS_FUNCTION )( __m256i hash[ 8 ], __m256i w[ 16 ] );
+
+static void mbHmacChain( const uint32_t *innerHash, 
+						 const uint32_t *outerHash, 
+						 HMAC_CHAIN_INFO *hmacChainInfo, const int noChains, 
+						 const int iterations, const int stateWords,
+						 const MB_COMPRESS_FUNCTION compressFunction )
+	{
+	const __m256i padWord = _mm256_set1_epi32( ( int ) 0x80000000UL );
+	const __m256i lengthWord = _mm256_set1_epi32( ( 64 + stateWords * 4 ) * 8 );
+	const __m256i zeroWord = _mm256_setzero_si256();
+	__m256i inner[ 8 ], outer[ 8 ], value[ 8 ], output[ 8 ];
+	__m256i hash[ 8 ], w[ 16 ];
+	uint32_t lanes[ 8 ][ MB_LANES ];
+	int i, j;
+
+	/* Load the current value and output for each chain into the lanes, 
+	   transposed so that value[ j ] contains word j of the value for all 
+	   chains.  Any lanes without a chain are run on all-zero values and 
+	   their results discarded */
+	memset( lanes, 0, sizeof( uint32_t ) * 8 * MB_LANES );
+	for( i = 0; i < noChains; i++ )
+		{
+		const BYTE *valuePtr = hmacChainInfo[ i ].value;
+
+		for( j = 0; j < stateWords; j++ )
+			{
+			lanes[ j ][ i ] = mgetLong( valuePtr );
+			}
+		}
+	for( j = 0; j < stateWords; j++ )
+		value[ j ] = LOAD_STATE( lanes, j );
+	for( i = 0; i < noChains; i++ )
+		{
+		const BYTE *outputPtr = hmacChainInfo[ i ].output;
+
+		for( j = 0; j < stateWords; j++ )
+			{
+			lanes[ j ][ i ] = mgetLong( outputPtr );
+			}
+		}
+	for( j = 0; j < stateWords; j++ )
+		{
+		output[ j ] = LOAD_STATE( lanes, j );
+		inner[ j ] = _mm256_set1_epi32( ( int ) innerHash[ j ] );
+		outer[ j ] = _mm256_set1_epi32( ( int ) outerHash[ j ] );
+		}
+
+	for( i = 0; i < iterations; i++ )
+		{
+		/* U' = H( inner || U ) */
+		for( j = 0; j < stateWords; j++ )
+			{
+			w[ j ] = value[ j ];
+			hash[ j ] = inner[ j ];
+			}
+		w[ stateWords ] = padWord;
+		for( j = stateWords + 1; j < 15; j++ )
+			w[ j ] = zeroWord;
+		w[ 15 ] = lengthWord;
+		compressFunction( hash, w );
+
+		/* U = H( outer || U' ), output ^= U */
+		for( j = 0; j < stateWords; j++ )
+			{
+			w[ j ] = hash[ j ];
+			hash[ j ] = outer[ j ];
+			}
+		w[ stateWords ] = padWord;
+		for( j = stateWords + 1; j < 15; j++ )
+			w[ j ] = zeroWord;
+		w[ 15 ] = lengthWord;
+		compressFunction( hash, w );
+		for( j = 0; j < stateWords; j++ )
+			{
+			value[ j ] = hash[ j ];
+			output[ j ] = XOR256( output[ j ], hash[ j ] );
+			}
+		}
+
+	/* Write the final value and output back to each chain */
+	for( j = 0; j < stateWords; j++ )
+		STORE_STATE( lanes, j, value[ j ] );
+	for( i = 0; i < noChains; i++ )
+		{
+		BYTE *valuePtr = hmacChainInfo[ i ].value;
+
+		for( j = 0; j < stateWords; j++ )
+			{
+			mputLong( valuePtr, lanes[ j ][ i ] );
+			}
+		}
+	for( j = 0; j < stateWords; j++ )
+		STORE_STATE( lanes, j, output[ j ] );
+	for( i = 0; i < noChains; i++ )
+		{
+		BYTE *outputPtr = hmacChainInfo[ i ].output;
+
+		for( j = 0; j < stateWords; j++ )
+			{
+			mputLong( outputPtr, lanes[ j ][ i ] );
+			}
+		}
+	zeroise( lanes, sizeof( uint32_t ) * 8 * MB_LANES );
+	zeroise( value, sizeof( __m256i ) * 8 );
+	zeroise( output, sizeof( __m256i ) * 8 );
+	zeroise( hash, sizeof( __m256i ) * 8 );
+	zeroise( w, sizeof( __m256i ) * 16 );
+	}
+
+#if defined( __GNUC__ ) && !defined( _MSC_VER )
+  #pragma GCC pop_options
+#endif /* gcc/clang */
+
+/****************************************************************************
+*																			*
+*								Dispatch Functions							*
+*																			*
+****************************************************************************/
+
+/* Process data using whichever of the SHA-NI or AVX2 code the CPU
+   supports, or tell the caller to use the C code if neither is
+   available */
+
+int sha1_hw_blocks( struct SHAstate_st *c, const void *data, int noBlocks,
+					const int hostOrder )
+	{
+	if( hasSHANI() )
+		{
+		sha1BlocksNI( c, data, noBlocks, hostOrder );
+		return( TRUE );
+		}
+	if( hasAVX2() )
+		{
+		sha1BlocksAVX2( c, data, noBlocks, hostOrder );
+		return( TRUE );
+		}
+
+	return( FALSE );
+	}
+
+int sha256_hw_blocks( uint32_t hash[ 8 ], const unsigned char *data,
+					  unsigned long noBlocks, const int hostOrder )
+	{
+	if( hasSHANI() )
+		{
+		sha256BlocksNI( hash, data, noBlocks, hostOrder );
+		return( TRUE );
+		}
+	if( hasAVX2() )
+		{
+		sha256BlocksAVX2( hash, data, noBlocks, hostOrder );
+		return( TRUE );
+		}
+
+	return( FALSE );
+	}
+
+/* Hash a batch of independent messages using the AVX2 multi-buffer code, or
+   tell the caller to hash them one at a time if it's not available */
+
+int sha1_mb_hash( struct HBI *hashBatchInfo, const int noEntries )
+	{
+	static const uint32_t iv[ 5 ] = {
+		0x67452301UL, 0xEFCDAB89UL, 0x98BADCFEUL, 0x10325476UL, 0xC3D2E1F0UL 
+		};
+
+	if( !hasAVX2() )
+		return( FALSE );
+	mbHash( hashBatchInfo, noEntries, iv, 5, sha1Step8 );
+
+	return( TRUE );
+	}
+
+int sha256_mb_hash( struct HBI *hashBatchInfo, const int noEntries )
+	{
+	static const uint32_t iv[ 8 ] = {
+		0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+		0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+		};
+
+	if( !hasAVX2() )
+		return( FALSE );
+	mbHash( hashBatchInfo, noEntries, iv, 8, sha256Step8 );
+
+	return( TRUE );
+	}
+
+/* Run a set of HMAC iteration chains using the AVX2 multi-buffer code.  
+   With SHA-NI present the single-buffer code runs one chain in about a 
+   sixth of the time that the multi-buffer SHA-1 code takes to run all 
+   eight lanes, so we only use the multi-buffer code if there are enough 
+   chains to fill most of the lanes.  For SHA-256 the SHA-NI code is faster 
+   even with all lanes filled, so the multi-buffer code is only used if 
+   there's no SHA-NI support */
+
+#define MB_MIN_CHAINS_SHA1		6
+#define MB_MIN_CHAINS_SHA256	( MB_LANES + 1 )
+
+int sha1_mb_hmac_chain( const uint32_t innerHash[ 5 ],
+						const uint32_t outerHash[ 5 ],
+						struct HCI *hmacChainInfo, const int noChains,
+						const int iterations )
+	{
+	if( !hasAVX2() || noChains < 1 || noChains > MB_LANES )
+		return( FALSE );
+	if( hasSHANI() && noChains < MB_MIN_CHAINS_SHA1 )
+		return( FALSE );
+	mbHmacChain( innerHash, outerHash, hmacChainInfo, noChains, iterations, 
+				 5, sha1Compress8 );
+
+	return( TRUE );
+	}
+
+int sha256_mb_hmac_chain( const uint32_t innerHash[ 8 ],
+						  const uint32_t outerHash[ 8 ],
+						  struct HCI *hmacChainInfo, const int noChains,
+						  const int iterations )
+	{
+	if( !hasAVX2() || noChains < 1 || noChains > MB_LANES )
+		return( FALSE );
+	if( hasSHANI() && noChains < MB_MIN_CHAINS_SHA256 )
+		return( FALSE );
+	mbHmacChain( innerHash, outerHash, hmacChainInfo, noChains, iterations, 
+				 8, sha256Compress8 );
+
+	return( TRUE );
+	}
+#endif /* USE_SHA_NI_IF_PRESENT */
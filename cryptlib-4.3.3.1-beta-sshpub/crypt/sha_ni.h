@@ -0,0 +1,71 @@
+/****************************************************************************
+*																			*
+*				cryptlib SHA-1/SHA-256 SHA-NI/AVX2 Header File				*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#ifndef _SHA_NI_DEFINED
+
+#define _SHA_NI_DEFINED
+
+/* On x86-64 systems we can use the SHA extensions (SHA-NI) for the SHA-1
+   and SHA-256 compression functions if the CPU supports them, or an AVX2
+   message schedule for two blocks at a time if it doesn't, and AVX2 to hash
+   batches of independent messages in parallel, see sha_ni.c.
+   The compiler conditions are the same ones that gcm.h uses for
+   USE_GCM_CLMUL_IF_PRESENT, except that VC++ only has the SHA intrinsics
+   from VS 2015 onwards */
+
+#if ( defined( _MSC_VER ) && ( _MSC_VER >= 1900 ) && defined( _M_X64 ) ) || \
+	( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) && defined( __x86_64__ ) )
+  #define USE_SHA_NI_IF_PRESENT
+#endif /* VS 2015+/gcc 5+ on x86-64 */
+
+#ifdef USE_SHA_NI_IF_PRESENT
+
+/* Process a sequence of 64-byte blocks, either big-endian message data as
+   passed in by the caller or message words that have already been
+   converted to host byte order if hostOrder is set, as is the case for the
+   partial-block buffers in the SHA-1 and SHA-256 contexts.  These return
+   FALSE without touching the hash state if there's no hardware support
+   available, in which case the caller falls back to the portable C code */
+
+struct SHAstate_st;
+
+int sha1_hw_blocks( struct SHAstate_st *c, const void *data, int noBlocks,
+					const int hostOrder );
+int sha256_hw_blocks( uint32_t hash[ 8 ], const unsigned char *data,
+					  unsigned long noBlocks, const int hostOrder );
+
+/* Hash a batch of independent messages eight at a time, one per 32-bit 
+   vector lane, writing the result for each message to its batch entry.  
+   These return FALSE if there's no hardware support available, in which 
+   case the caller hashes the messages one at a time */
+
+struct HBI;
+
+int sha1_mb_hash( struct HBI *hashBatchInfo, const int noEntries );
+int sha256_mb_hash( struct HBI *hashBatchInfo, const int noEntries );
+
+/* Run up to eight HMAC iteration chains of the kind used by PBKDF2 in
+   parallel, one per vector lane, starting from the precomputed inner and
+   outer HMAC hash states.  These return FALSE if there's no hardware
+   support available or if the number of chains is too small for the
+   multi-buffer code to be faster than the single-buffer SHA-NI code, in
+   which case the caller runs the chains one at a time */
+
+struct HCI;
+
+int sha1_mb_hmac_chain( const uint32_t innerHash[ 5 ],
+						const uint32_t outerHash[ 5 ],
+						struct HCI *hmacChainInfo, const int noChains,
+						const int iterations );
+int sha256_mb_hmac_chain( const uint32_t innerHash[ 8 ],
+						  const uint32_t outerHash[ 8 ],
+						  struct HCI *hmacChainInfo, const int noChains,
+						  const int iterations );
+
+#endif /* USE_SHA_NI_IF_PRESENT */
+
+#endif /* _SHA_NI_DEFINED */
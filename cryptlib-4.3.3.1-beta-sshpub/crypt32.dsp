@@ -234,6 +234,10 @@ SOURCE=.\bn\bn_gcd.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\bn\bn_ifma.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\bn\bn_mul.c
 # End Source File
 # Begin Source File
@@ -394,6 +398,10 @@ SOURCE=.\context\ctx_3des.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\context\ctx_25519.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\context\ctx_aes.c
 # End Source File
 # Begin Source File
@@ -434,6 +442,10 @@ SOURCE=.\context\ctx_cast.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\context\ctx_chacha20.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\context\ctx_des.c
 # End Source File
 # Begin Source File
@@ -454,6 +466,10 @@ SOURCE=.\context\ctx_ecdsa.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\context\ctx_ed25519.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\context\ctx_elg.c
 # End Source File
 # Begin Source File
@@ -570,6 +586,14 @@ SOURCE=.\crypt\castskey.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\crypt\chacha20.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\crypt\curve25519.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\crypt\descbc.c
 # End Source File
 # Begin Source File
@@ -594,6 +618,10 @@ SOURCE=.\crypt\gcm.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\crypt\gcm_ni.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\crypt\gf128mul.c
 # End Source File
 # Begin Source File
@@ -614,6 +642,10 @@ SOURCE=.\crypt\md5dgst.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\crypt\poly1305.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\crypt\rc2cbc.c
 # End Source File
 # Begin Source File
@@ -638,6 +670,10 @@ SOURCE=.\crypt\sha2.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\crypt\sha_ni.c
+# End Source File
+# Begin Source File
+
 SOURCE=".\crypt\d-win32.obj"
 
 !IF  "$(CFG)" == "Crypt32 - Win32 Release"
@@ -1258,10 +1294,18 @@ SOURCE=.\random\win32.c
 # PROP Default_Filter ""
 # Begin Source File
 
+SOURCE=.\session\keypool.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\session\scorebrd.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\session\scoreshm.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\session\sess_attr.c
 # End Source File
 # Begin Source File
@@ -1378,8 +1422,24 @@ SOURCE=.\session\ssl_svr.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\session\ssl_tkt.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\session\ssl_tls13.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\session\ssl_wr.c
 # End Source File
+# Begin Source File
+
+SOURCE=.\session\stapling.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\session\certcache.c
+# End Source File
 # End Group
 # Begin Group "Sessions - PKI"
 
@@ -1734,6 +1794,10 @@ SOURCE=.\misc\user_int.h
 # PROP Default_Filter ""
 # Begin Source File
 
+SOURCE=.\session\certcache.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\session\certstore.h
 # End Source File
 # Begin Source File
@@ -1742,6 +1806,10 @@ SOURCE=.\session\cmp.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\session\keypool.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\session\scep.h
 # End Source File
 # Begin Source File
@@ -1760,6 +1828,10 @@ SOURCE=.\session\ssh.h
 
 SOURCE=.\session\ssl.h
 # End Source File
+# Begin Source File
+
+SOURCE=.\session\stapling.h
+# End Source File
 # End Group
 # Begin Source File
 
@@ -4927,49 +4927,102 @@ C_RET cryptFuzzSpecial(C_IN CRYPT_CONTEXT cryptContext,
 #include "io/stream.h"
 #include "enc_dec/misc_rw.h"
 
-C_RET cryptSetSshKey(C_IN CRYPT_CONTEXT publicKey,
-	C_IN void *publicKeyData,
-	C_IN int publicKeyDataLength)
+/* Decode a base64-encoded SSH public key into its binary form, prepending 
+   the uint32 length field that the SSH key-read code expects */
+
+static int decodeSshKey(const void *publicKeyData,
+	const int publicKeyDataLength,
+	BYTE *sshKey, const int sshKeyMaxLength,
+	int *sshKeyLength)
 {
 	CRYPT_CERTFORMAT_TYPE type;
 	STREAM stream;
-	MESSAGE_DATA msgData;
-	BYTE sshKey[4096];
 	int sshKeySize, startPos, status;
 
-	//DEBUG_PRINT(("cryptSetSshKey %d.\n", __LINE__));
+	*sshKeyLength = 0;
 
 	if (publicKeyDataLength < 64 || publicKeyDataLength > 4096)
 		return(CRYPT_ERROR_BADDATA);
 
 	/* Make sure that the key data looks valid and decode it */
-	memset(sshKey, 0, 4096);
+	memset(sshKey, 0, sshKeyMaxLength);
 	status = base64checkHeader(publicKeyData, publicKeyDataLength,
 		&type, &startPos);
 	if (cryptStatusError(status))
-	{
-		//DEBUG_PRINT(("cryptSetSshKey %d.\n", __LINE__));
 		return(status);
-	}
-
-	status = base64decode(sshKey + 4, 4096 - 4, &sshKeySize,
+	status = base64decode(sshKey + 4, sshKeyMaxLength - 4, &sshKeySize,
 		(BYTE *)publicKeyData + startPos,
 		publicKeyDataLength - startPos, type);
 	if (cryptStatusError(status))
-	{
-		//DEBUG_PRINT(("cryptSetSshKey %d.\n", __LINE__));
 		return(status);
-	}
 
 	/* Add the length field at the start */
 	sMemOpen(&stream, sshKey, 4);
-	//DEBUG_PRINT(("cryptSetSshKey %d.\n", __LINE__));
 	writeUint32(&stream, sshKeySize);
-	//DEBUG_PRINT(("cryptSetSshKey %d.\n", __LINE__));
 	sMemDisconnect(&stream);
+	*sshKeyLength = sshKeySize + 4;
+
+	return(CRYPT_OK);
+}
+
+/* Determine the public-key algorithm for an SSH public key from the 
+   algorithm name at the start of the key data */
+
+static int getSshKeyAlgo(const void *publicKeyData,
+	const int publicKeyDataLength,
+	CRYPT_ALGO_TYPE *cryptAlgo)
+{
+	STREAM stream;
+	BYTE sshKey[4096];
+	char algoName[CRYPT_MAX_TEXTSIZE + 8];
+	int sshKeySize, algoNameLength, status;
+
+	*cryptAlgo = CRYPT_ALGO_NONE;
+
+	status = decodeSshKey(publicKeyData, publicKeyDataLength, sshKey,
+		4096, &sshKeySize);
+	if (cryptStatusError(status))
+		return(status);
+	sMemConnect(&stream, sshKey, sshKeySize);
+	readUint32(&stream);
+	status = readString32(&stream, algoName, CRYPT_MAX_TEXTSIZE,
+		&algoNameLength);
+	sMemDisconnect(&stream);
+	if (cryptStatusError(status))
+		return(status);
+	if (algoNameLength == 7 && !memcmp(algoName, "ssh-rsa", 7))
+		*cryptAlgo = CRYPT_ALGO_RSA;
+	else if (algoNameLength == 7 && !memcmp(algoName, "ssh-dss", 7))
+		*cryptAlgo = CRYPT_ALGO_DSA;
+	else if (algoNameLength > 11 && !memcmp(algoName, "ecdsa-sha2-", 11))
+		*cryptAlgo = CRYPT_ALGO_ECDSA;
+	else if (algoNameLength == 11 && !memcmp(algoName, "ssh-ed25519", 11))
+		*cryptAlgo = CRYPT_ALGO_ED25519;
+	else
+		return(CRYPT_ERROR_NOTAVAIL);
+
+	return(CRYPT_OK);
+}
+
+C_RET cryptSetSshKey(C_IN CRYPT_CONTEXT publicKey,
+	C_IN void *publicKeyData,
+	C_IN int publicKeyDataLength)
+{
+	MESSAGE_DATA msgData;
+	BYTE sshKey[4096];
+	int sshKeySize, status;
+
 	//DEBUG_PRINT(("cryptSetSshKey %d.\n", __LINE__));
 
-	setMessageData(&msgData, sshKey, sshKeySize + 4);
+	status = decodeSshKey(publicKeyData, publicKeyDataLength, sshKey,
+		4096, &sshKeySize);
+	if (cryptStatusError(status))
+	{
+		//DEBUG_PRINT(("cryptSetSshKey %d.\n", __LINE__));
+		return(status);
+	}
+
+	setMessageData(&msgData, sshKey, sshKeySize);
 	//DEBUG_PRINT(("cryptSetSshKey %d.\n", __LINE__));
 	status = krnlSendMessage(publicKey, IMESSAGE_SETATTRIBUTE_S, &msgData,
 		CRYPT_IATTRIBUTE_KEY_SSH/*CRYPT_IATTRIBUTE_KEY_PGP*/);
@@ -5041,6 +5094,7 @@ C_RET convertSSHtoCert(char C_PTR fileName,
 	const time_t theTime = time(NULL);
 	const time_t theNextTenYearsTime = theTime + (3650 * 24 * 60 * 60);
 
+	CRYPT_ALGO_TYPE cryptAlgo;
 	CRYPT_CONTEXT cryptContext, cryptCAKey;
 	CRYPT_CERTIFICATE cryptCert;
 	FILE *filePtr;
@@ -5076,7 +5130,10 @@ C_RET convertSSHtoCert(char C_PTR fileName,
 	/*DEBUG_PRINT(("convertSSHtoCert %d.\n",
 		__LINE__));*/
 
-	status = cryptCreateContext(&cryptContext, CRYPT_UNUSED, CRYPT_ALGO_RSA);
+	/* Determine the key type from the algorithm name in the key data */
+	status = getSshKeyAlgo(buffer, count, &cryptAlgo);
+	if (cryptStatusOK(status))
+		status = cryptCreateContext(&cryptContext, CRYPT_UNUSED, cryptAlgo);
 	//DEBUG_PRINT(("convertSSHtoCert -- cryptContext: %d, status: %d\n", cryptContext, status));
 
 	if (cryptStatusOK(status))
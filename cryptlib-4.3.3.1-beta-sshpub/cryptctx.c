@@ -623,7 +623,8 @@ static void sanitiseFailedData( INOUT_BUFFER_FIXED( dataLength ) void *data,
 			}
 		else
 			{
-			if( isDlpAlgo( cryptAlgo ) || isEccAlgo( cryptAlgo ) )
+			if( isDlpAlgo( cryptAlgo ) || isEccAlgo( cryptAlgo ) || \
+				is25519Algo( cryptAlgo ) )
 				{
 				DLP_PARAMS *dlpParams = ( DLP_PARAMS * ) data;
 
@@ -1086,7 +1087,8 @@ static int contextMessageFunction( INOUT TYPECAST( CONTEXT_INFO * ) \
 
 				REQUIRES( contextInfoPtr->type == CONTEXT_CONV );
 
-				if( contextInfoPtr->ctxConv->mode != CRYPT_MODE_GCM )
+				if( contextInfoPtr->ctxConv->mode != CRYPT_MODE_GCM && \
+					!isNonceStreamCipher( capabilityInfoPtr->cryptAlgo ) )
 					return( CRYPT_ERROR_NOTAVAIL );
 				status = capabilityInfoPtr->getInfoFunction( CAPABILITY_INFO_ICV, 
 									contextInfoPtr, icv, msgData->length );
@@ -1234,7 +1236,9 @@ static int contextMessageFunction( INOUT TYPECAST( CONTEXT_INFO * ) \
 		{
 		MESSAGE_DATA msgData;
 		BYTE iv[ CRYPT_MAX_IVSIZE + 8 ];
-		const int ivSize = capabilityInfoPtr->blockSize;
+		const int ivSize = \
+				isNonceStreamCipher( capabilityInfoPtr->cryptAlgo ) ? \
+				NONCE_STREAM_IVSIZE : capabilityInfoPtr->blockSize;
 
 		REQUIRES( contextInfoPtr->type == CONTEXT_CONV );
 
@@ -1326,13 +1330,15 @@ int createContextFromCapability( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 			if( capabilityInfoPtr->encryptFunction != NULL || \
 				capabilityInfoPtr->encryptCBCFunction != NULL || \
 				capabilityInfoPtr->encryptCFBFunction != NULL || \
-				capabilityInfoPtr->encryptGCMFunction != NULL )
+				capabilityInfoPtr->encryptGCMFunction != NULL || \
+				capabilityInfoPtr->encryptCTRFunction != NULL )
 				actionFlags |= MK_ACTION_PERM( MESSAGE_CTX_ENCRYPT,
 											   ACTION_PERM_ALL );
 			if( capabilityInfoPtr->decryptFunction != NULL || \
 				capabilityInfoPtr->decryptCBCFunction != NULL || \
 				capabilityInfoPtr->decryptCFBFunction != NULL || \
-				capabilityInfoPtr->decryptGCMFunction != NULL )
+				capabilityInfoPtr->decryptGCMFunction != NULL || \
+				capabilityInfoPtr->decryptCTRFunction != NULL )
 				actionFlags |= MK_ACTION_PERM( MESSAGE_CTX_DECRYPT,
 											   ACTION_PERM_ALL );
 			actionFlags |= MK_ACTION_PERM( MESSAGE_CTX_GENKEY, ACTION_PERM_ALL );
@@ -1341,7 +1347,8 @@ int createContextFromCapability( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 		case CONTEXT_PKC:
 			subType = SUBTYPE_CTX_PKC;
 			storageSize = sizeof( PKC_INFO );
-			if( isDlpAlgo( cryptAlgo ) || isEccAlgo( cryptAlgo ) )
+			if( isDlpAlgo( cryptAlgo ) || isEccAlgo( cryptAlgo ) || \
+				is25519Algo( cryptAlgo ) )
 				{
 				/* The DLP- and ECDLP-based PKC's have somewhat specialised 
 				   usage requirements so we don't allow direct access by 
@@ -1533,7 +1540,8 @@ int createContextFromCapability( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 			   for block ciphers it'll cause problems because most crypto 
 			   protocols only allow CBC mode.  In addition we don't fall
 			   back to GCM, which is a sufficiently unusual mode that we
-			   require it to be explicitly enabled by the user */
+			   require it to be explicitly enabled by the user.  Nonce-
+			   based stream ciphers only have CTR mode */
 			if( capabilityInfoPtr->encryptCFBFunction != NULL )
 				{
 				contextInfoPtr->ctxConv->mode = CRYPT_MODE_CFB;
@@ -1542,6 +1550,15 @@ int createContextFromCapability( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 				FNPTR_SET( contextInfoPtr->decryptFunction,
 						   capabilityInfoPtr->decryptCFBFunction );
 				}
+			else
+			if( isNonceStreamCipher( capabilityInfoPtr->cryptAlgo ) )
+				{
+				contextInfoPtr->ctxConv->mode = CRYPT_MODE_CTR;
+				FNPTR_SET( contextInfoPtr->encryptFunction,
+						   capabilityInfoPtr->encryptCTRFunction );
+				FNPTR_SET( contextInfoPtr->decryptFunction,
+						   capabilityInfoPtr->decryptCTRFunction );
+				}
 			else
 				{
 				contextInfoPtr->ctxConv->mode = CRYPT_MODE_ECB;
@@ -1605,6 +1622,7 @@ int createContextFromCapability( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 
 				case CRYPT_ALGO_DSA:
 				case CRYPT_ALGO_ECDSA:
+				case CRYPT_ALGO_ED25519:
 					ENSURES( capabilityInfoPtr->signFunction != NULL && \
 							 capabilityInfoPtr->sigCheckFunction != NULL );
 					break;
@@ -751,6 +751,7 @@ typedef enum {
 	MECHANISM_ENC_CMS,			/* CMS key wrap */
 	MECHANISM_SIG_PKCS1,		/* PKCS #1 sign */
 	MECHANISM_SIG_SSL,			/* SSL sign with dual hashes */
+	MECHANISM_SIG_PSS,			/* PSS sign */
 	MECHANISM_DERIVE_PKCS5,		/* PKCS #5 derive */
 	MECHANISM_DERIVE_PKCS12,	/* PKCS #12 derive */
 	MECHANISM_DERIVE_SSL,		/* SSL derive */
@@ -1332,14 +1333,22 @@ BOOLEAN krnlIsExiting(void);
 typedef enum {
 	SEMAPHORE_NONE,					/* No semaphore */
 	SEMAPHORE_DRIVERBIND,			/* Async driver bind */
+	SEMAPHORE_KEYPOOL,				/* Session key pool fill */
+	SEMAPHORE_OCSPSTAPLE,			/* OCSP staple refresh */
 	SEMAPHORE_LAST					/* Last possible semaphore */
 } SEMAPHORE_TYPE;
 
 typedef enum {
 	MUTEX_NONE,						/* No mutex */
 	MUTEX_SCOREBOARD,				/* Session scoreboard */
+	MUTEX_SCOREBOARD1, MUTEX_SCOREBOARD2, MUTEX_SCOREBOARD3,
+									/* Further session scoreboard shards */
 	MUTEX_SOCKETPOOL,				/* Network socket pool */
 	MUTEX_RANDOM,					/* Randomness subsystem */
+	MUTEX_KEYPOOL,					/* Session key pool */
+	MUTEX_DHTABLES,					/* DH fixed-base tables */
+	MUTEX_OCSPSTAPLE,				/* OCSP staple cache */
+	MUTEX_CERTCACHE,				/* TLS certificate chain cache */
 	MUTEX_LAST						/* Last possible mutex */
 } MUTEX_TYPE;
 
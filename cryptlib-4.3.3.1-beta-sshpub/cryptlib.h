@@ -216,6 +216,7 @@ typedef enum {						/* Algorithms */
 	CRYPT_ALGO_RESERVED1,			/* Formerly RC5 */
 	CRYPT_ALGO_AES,					/* AES */
 	CRYPT_ALGO_RESERVED2,			/* Formerly Blowfish */
+	CRYPT_ALGO_CHACHA20,			/* ChaCha20 */
 
 	/* Public-key encryption */
 	CRYPT_ALGO_DH = 100,			/* Diffie-Hellman */
@@ -225,6 +226,8 @@ typedef enum {						/* Algorithms */
 	CRYPT_ALGO_RESERVED3,			/* Formerly KEA */
 	CRYPT_ALGO_ECDSA,				/* ECDSA */
 	CRYPT_ALGO_ECDH,				/* ECDH */
+	CRYPT_ALGO_25519,				/* X25519 */
+	CRYPT_ALGO_ED25519,				/* Ed25519 */
 
 	/* Hash algorithms */
 	CRYPT_ALGO_RESERVED4 = 200,		/* Formerly MD2 */
@@ -285,6 +288,7 @@ typedef enum {						/* Block cipher modes */
 	CRYPT_MODE_CBC,					/* CBC */
 	CRYPT_MODE_CFB,					/* CFB */
 	CRYPT_MODE_GCM,					/* GCM */
+	CRYPT_MODE_CTR,					/* CTR */
 	CRYPT_MODE_LAST					/* Last possible crypt mode value */
 } CRYPT_MODE_TYPE;
 
@@ -375,6 +379,7 @@ typedef enum {
 	   only visible internally */
 	CRYPT_IFORMAT_SSL,				/* SSL/TLS format */
 	CRYPT_IFORMAT_TLS12,			/* TLS 1.2 format */
+	CRYPT_IFORMAT_TLS13,			/* TLS 1.3 format */
 	CRYPT_IFORMAT_SSH,				/* SSH format */
 #endif /* _CRYPT_DEFINED */
 	CRYPT_FORMAT_LAST				/* Last possible format type */
@@ -543,6 +548,30 @@ typedef enum {
 	CRYPT_OPTION_CONFIGCHANGED,		/* Whether in-mem.opts match on-disk ones */
 	CRYPT_OPTION_SELFTESTOK,		/* Whether self-test was completed and OK */
 
+	/* Session key pool options, the hit/miss counts are read-only */
+	CRYPT_OPTION_SESSION_KEYPOOLSIZE,	/* Pre-generated DH/ECDH keys per group */
+	CRYPT_OPTION_SESSION_KEYPOOLLOWWATER,/* Key pool refill threshold */
+	CRYPT_OPTION_SESSION_KEYPOOLHITS,	/* Key requests satisfied from pool */
+	CRYPT_OPTION_SESSION_KEYPOOLMISSES,	/* Key requests not satisfied from pool */
+
+	/* Crypto kernel selection (CPU tier 0 = best available, 1 = C only, 
+	   2 = SSE2, 3 = AES-NI/SHA-NI, 4 = AVX2, 5 = AVX-512) */
+	CRYPT_OPTION_MISC_CPUTIER,		/* Restrict crypto code to CPU tier */
+	CRYPT_OPTION_MISC_CPUKERNELS,	/* Crypto kernels in use (read-only) */
+
+	/* TLS session ticket options, the hit/miss counts are read-only */
+	CRYPT_OPTION_SESSION_TICKETKEYFILE,	/* Shared TLS session ticket keys */
+	CRYPT_OPTION_SESSION_TICKETHITS,	/* Sessions resumed from ticket */
+	CRYPT_OPTION_SESSION_TICKETMISSES,	/* Tickets that couldn't be used */
+
+	/* TLS session cache options */
+	CRYPT_OPTION_SESSION_CACHESIZE,	/* TLS session cache entries */
+	CRYPT_OPTION_SESSION_CACHEFILE,	/* Shared TLS session cache file */
+
+	/* OCSP stapling options */
+	CRYPT_OPTION_SESSION_OCSPSTAPLING,/* Whether TLS server staples OCSP resp.*/
+	CRYPT_OPTION_SESSION_OCSPRESPONDER,/* OCSP responder for stapled resp.*/
+
 	/* Used internally */
 	CRYPT_OPTION_LAST, CRYPT_CTXINFO_FIRST = 1000,
 
@@ -1228,6 +1257,19 @@ CRYPT_CERTINFO_CMS_NONCE,				/* randomNonce */
 	CRYPT_SESSINFO_SSL_OPTIONS,		/* SSL/TLS protocol options */
 	CRYPT_SESSINFO_TSP_MSGIMPRINT,	/* TSP message imprint */
 
+	/* Further pseudo-information about the session */
+	CRYPT_SESSINFO_NETWORKEVENTS,	/* Network events session is waiting for */
+	CRYPT_SESSINFO_NONBLOCKING,		/* Session driven from external event loop */
+	CRYPT_SESSINFO_CORK,			/* Hold back flushes to coalesce writes */
+
+	/* Handshake timing information, in microseconds */
+	CRYPT_SESSINFO_TIMING_CONNECT,	/* Network connection established */
+	CRYPT_SESSINFO_TIMING_HELLOSENT,/* Hello sent */
+	CRYPT_SESSINFO_TIMING_HELLORECEIVED,/* Hello received */
+	CRYPT_SESSINFO_TIMING_KEYEXCHANGE,/* Key exchange computed */
+	CRYPT_SESSINFO_TIMING_CERTVERIFIED,/* Peer cert/key verified */
+	CRYPT_SESSINFO_TIMING_FINISHED,	/* Handshake completed */
+
 	/* Used internally */
 	CRYPT_SESSINFO_LAST, CRYPT_USERINFO_FIRST = 7000,
 
@@ -1666,6 +1708,25 @@ typedef enum {
 #define CRYPT_SSLOPTION_SUITEB_256			0x200	/*  vanish in future releases) */
 #ifdef _CRYPT_DEFINED
 #define CRYPT_SSLOPTION_MAX					0x7F	/* Defines for range checking */
+#endif /* _CRYPT_DEFINED */
+
+/* Network events that a session is waiting for, used when the session is
+   being driven from an external event loop via select()/poll()/epoll() 
+   with CRYPT_SESSINFO_NONBLOCKING set.  While the handshake is in progress
+   they indicate what the handshake is waiting for before the session can
+   be activated again.
+   CRYPT_NETWORKEVENT_READ means that the socket should be polled for
+   readability, CRYPT_NETWORKEVENT_WRITE that there's buffered data still
+   waiting to be flushed, and CRYPT_NETWORKEVENT_DATA that there's already
+   data (or a pending error) available to cryptPopData() without any further
+   network I/O */
+
+#define CRYPT_NETWORKEVENT_NONE				0x00
+#define CRYPT_NETWORKEVENT_READ				0x01	/* Wait for socket readable */
+#define CRYPT_NETWORKEVENT_WRITE			0x02	/* Wait for socket writeable */
+#define CRYPT_NETWORKEVENT_DATA				0x04	/* Data already available */
+#ifdef _CRYPT_DEFINED
+#define CRYPT_NETWORKEVENT_MAX				0x07	/* Defines for range checking */
 #endif /* _CRYPT_DEFINED */
 
    /****************************************************************************
@@ -11,21 +11,26 @@
 #ifdef INC_ALL
   #include "asn1.h"
   #include "stream.h"
+  #include "certcache.h"
+  #include "keypool.h"
   #include "session.h"
   #include "scorebrd.h"
+  #include "stapling.h"
 #else
   #include "enc_dec/asn1.h"
   #include "io/stream.h"
+  #include "session/certcache.h"
+  #include "session/keypool.h"
   #include "session/session.h"
   #include "session/scorebrd.h"
+  #include "session/stapling.h"
 #endif /* Compiler-specific includes */
 
 #ifdef USE_SESSIONS
 
-/* The number of entries in the SSL session cache.  Note that when increasing
-   the SESSIONCACHE_SIZE value to more than about 256 you need to also change 
-   MAX_ALLOC_SIZE in kernel/sec_mem.c to allow the allocation of such large 
-   amounts of secure memory */
+/* The default number of entries in the SSL session cache.  The actual size
+   is taken from the CRYPT_OPTION_SESSION_CACHESIZE configuration option, 
+   this value is only used if the option can't be read */
 
 #if defined( CONFIG_CONSERVE_MEMORY )
   #define SESSIONCACHE_SIZE			8
@@ -253,6 +258,17 @@ static int sessionMessageFunction( INOUT TYPECAST( CONTEXT_INFO * ) \
 			shutdownFunction( sessionInfoPtr );
 			}
 
+#ifdef USE_EVENTLOOP
+		/* If the session is being driven from an external event loop then 
+		   the handshake may still be suspended waiting for network I/O.  
+		   Destroying the handshake task cancels it, which makes the 
+		   handshake fail and clean up after itself.  This has to be done 
+		   before the session buffers are freed since the handshake still 
+		   uses them while it's exiting */
+		if( sessionInfoPtr->eventTask != NULL )
+			destroyTask( sessionInfoPtr->eventTask );
+#endif /* USE_EVENTLOOP */
+
 		/* Clear and free session state information if necessary */
 		if( sessionInfoPtr->sendBuffer != NULL )
 			{
@@ -680,6 +696,7 @@ static int openSession( OUT_HANDLE_OPT CRYPT_SESSION *iCryptSession,
 	sessionInfoPtr->readTimeout = \
 		sessionInfoPtr->writeTimeout = \
 			sessionInfoPtr->connectTimeout = CRYPT_ERROR;
+	initHandshakeTiming( sessionInfoPtr );
 
 	/* Set up the access information for the session and initialise it */
 	switch( sessionBaseType )
@@ -832,7 +849,7 @@ int sessionManagementFunction( IN_ENUM( MANAGEMENT_ACTION ) \
 								const MANAGEMENT_ACTION_TYPE action )
 	{
 	static int initLevel = 0;
-	int status;
+	int sessionCacheSize, status;
 
 	REQUIRES( action == MANAGEMENT_ACTION_INIT || \
 			  action == MANAGEMENT_ACTION_PRE_SHUTDOWN || \
@@ -850,8 +867,39 @@ int sessionManagementFunction( IN_ENUM( MANAGEMENT_ACTION ) \
 					/* The kernel is shutting down, exit */
 					return( CRYPT_ERROR_PERMISSION );
 					}
+				status = krnlSendMessage( DEFAULTUSER_OBJECT_HANDLE,
+										  IMESSAGE_GETATTRIBUTE, 
+										  &sessionCacheSize,
+										  CRYPT_OPTION_SESSION_CACHESIZE );
+				if( cryptStatusError( status ) )
+					sessionCacheSize = SESSIONCACHE_SIZE;
 				status = initScoreboard( &scoreboardInfo, 
-										 SESSIONCACHE_SIZE );
+										 sessionCacheSize );
+				}
+			if( cryptStatusOK( status ) )
+				{
+				initLevel++;
+				status = initKeyPool();
+				}
+			if( cryptStatusOK( status ) )
+				{
+				initLevel++;
+				status = initSessionTickets();
+				}
+			if( cryptStatusOK( status ) )
+				{
+				initLevel++;
+				status = initSharedScoreboard( sessionCacheSize );
+				}
+			if( cryptStatusOK( status ) )
+				{
+				initLevel++;
+				status = initOCSPStapling();
+				}
+			if( cryptStatusOK( status ) )
+				{
+				initLevel++;
+				status = initCertCache();
 				}
 			if( cryptStatusOK( status ) )
 				initLevel++;
@@ -869,9 +917,28 @@ int sessionManagementFunction( IN_ENUM( MANAGEMENT_ACTION ) \
 				}
 			if( initLevel > 0 )
 				netSignalShutdown();
+
+			/* Shut down the ephemeral key pool fill thread and destroy any 
+			   pooled keys.  This has to be done before the object table is 
+			   cleared since the pooled keys are kernel objects */
+			if( initLevel > 2 )
+				endKeyPool();
+
+			/* Shut down the OCSP staple refresh thread and destroy the 
+			   cached certificates, for the same reason */
+			if( initLevel > 5 )
+				endOCSPStapling();
+
+			/* Destroy the cached peer certificate chains */
+			if( initLevel > 6 )
+				endCertCache();
 			return( CRYPT_OK );
 
 		case MANAGEMENT_ACTION_SHUTDOWN:
+			if( initLevel > 4 )
+				endSharedScoreboard();
+			if( initLevel > 3 )
+				endSessionTickets();
 			if( initLevel > 1 )
 				endScoreboard( &scoreboardInfo );
 			if( initLevel > 0 )
@@ -123,6 +123,7 @@ typedef struct CA {
 	CAP_ENCRYPT_FUNCTION encryptCBCFunction, decryptCBCFunction;
 	CAP_ENCRYPT_FUNCTION encryptCFBFunction, decryptCFBFunction;
 	CAP_ENCRYPT_FUNCTION encryptGCMFunction, decryptGCMFunction;
+	CAP_ENCRYPT_FUNCTION encryptCTRFunction, decryptCTRFunction;
 	CAP_SIGN_FUNCTION signFunction, sigCheckFunction;
 
 	/* Non-native implementations may require extra parameters (for example
@@ -172,6 +173,7 @@ typedef struct {
 	CAP_ENCRYPT_FUNCTION encryptCBCFunction, decryptCBCFunction;
 	CAP_ENCRYPT_FUNCTION encryptCFBFunction, decryptCFBFunction;
 	CAP_ENCRYPT_FUNCTION encryptGCMFunction, decryptGCMFunction;
+	CAP_ENCRYPT_FUNCTION encryptCTRFunction, decryptCTRFunction;
 	CAP_SIGN_FUNCTION signFunction, sigCheckFunction;
 
 	int param1, param2, param3, param4;	/* Non-const */
@@ -194,6 +196,8 @@ const CAPABILITY_INFO *getAESCapability( void );
 CHECK_RETVAL_PTR_NONNULL \
 const CAPABILITY_INFO *getCASTCapability( void );
 CHECK_RETVAL_PTR_NONNULL \
+const CAPABILITY_INFO *getChaCha20Capability( void );
+CHECK_RETVAL_PTR_NONNULL \
 const CAPABILITY_INFO *getDESCapability( void );
 CHECK_RETVAL_PTR_NONNULL \
 const CAPABILITY_INFO *getIDEACapability( void );
@@ -228,6 +232,10 @@ CHECK_RETVAL_PTR_NONNULL \
 const CAPABILITY_INFO *getECDSACapability( void );
 CHECK_RETVAL_PTR_NONNULL \
 const CAPABILITY_INFO *getECDHCapability( void );
+CHECK_RETVAL_PTR_NONNULL \
+const CAPABILITY_INFO *get25519Capability( void );
+CHECK_RETVAL_PTR_NONNULL \
+const CAPABILITY_INFO *getEd25519Capability( void );
 
 CHECK_RETVAL_PTR_NONNULL \
 const CAPABILITY_INFO *getGenericSecretCapability( void );
@@ -835,7 +835,7 @@ static const CAPABILITY_INFO capabilities[] = {
 		MIN_PKCSIZE, bitsToBytes( 1024 ), CRYPT_MAX_PKCSIZE,
 		rsaSelfTest, getDefaultInfo, cleanupHardwareContext, NULL, rsaInitKey, rsaGenerateKey, 
 		rsaEncrypt, rsaDecrypt, NULL, NULL, NULL, NULL, NULL, NULL, 
-		rsaSign, rsaSigCheck },
+		NULL, NULL, rsaSign, rsaSigCheck },
 
 	/* The AES capabilities */
 	{ CRYPT_ALGO_AES, bitsToBytes( 128 ), "AES", 3,
@@ -56,6 +56,8 @@ static const MECHANISM_FUNCTION_INFO FAR_DATA mechanismFunctions[] = {
 	{ MESSAGE_DEV_DERIVE, MECHANISM_DERIVE_TLS12, ( MECHANISM_FUNCTION ) deriveTLS12 },
 	{ MESSAGE_DEV_SIGN, MECHANISM_SIG_SSL, ( MECHANISM_FUNCTION ) signSSL },
 	{ MESSAGE_DEV_SIGCHECK, MECHANISM_SIG_SSL, ( MECHANISM_FUNCTION ) sigcheckSSL },
+	{ MESSAGE_DEV_SIGN, MECHANISM_SIG_PSS, ( MECHANISM_FUNCTION ) signPSS },
+	{ MESSAGE_DEV_SIGCHECK, MECHANISM_SIG_PSS, ( MECHANISM_FUNCTION ) sigcheckPSS },
 #endif /* USE_SSL */
 #ifdef USE_CMP
 	{ MESSAGE_DEV_DERIVE, MECHANISM_DERIVE_CMP, ( MECHANISM_FUNCTION ) deriveCMP },
@@ -397,6 +399,12 @@ static const MECHANISM_TEST_INFO FAR_DATA mechanismTestInfo[] = {
 		"\x99\xF5\x06\x0F\x43\x06\xA5\xD0\x74\xC9\xD5\xC5\xA5\x05\xB5\x7F", MECHANISM_OUTPUT_SIZE,
 		inputValue, MECHANISM_INPUT_SIZE, CRYPT_ALGO_HMAC_SHA1, 0,
 		saltValue, MECHANISM_SALT_SIZE, 10 } },
+	{ MECHANISM_DERIVE_PKCS5,	/* Two output blocks = two HMAC chains */
+	  { "\x9B\x5C\x5D\xB4\xC1\xB6\xFE\x3F\x90\x6C\x9A\x08\x17\x98\x12\x4B"
+		"\x9C\xDC\x19\x60\x25\x3B\xB2\x22\xF4\xA1\xEF\x8F\xFA\x1E\xF3\x44"
+		"\xF0\x05\x1C\x56\x1E\x03\x16\xB8\xB1\x05\x7F\x2A\xC2\xF4\x90\xC4", MECHANISM_OUTPUT_SIZE_SSL,
+		inputValue, MECHANISM_INPUT_SIZE, CRYPT_ALGO_HMAC_SHA2, 0,
+		saltValue, MECHANISM_SALT_SIZE, 10 } },
 #if defined( USE_PGP ) || defined( USE_PGPKEYS )
 	{ MECHANISM_DERIVE_PGP,
 	  { "\x4A\x4B\x90\x09\x27\xF8\xD0\x93\x56\x16\xEA\xC1\x45\xCD\xEE\x05"
@@ -450,11 +458,15 @@ static const MECHANISM_TEST_INFO FAR_DATA mechanismTestInfo[] = {
 	};
 
 CHECK_RETVAL \
-static int mechanismSelfTest( void )
+static int mechanismSelfTest( IN_ENUM_OPT( MECHANISM ) \
+								const MECHANISM_TYPE mechanismType )
 	{
 	BYTE buffer[ MECHANISM_OUTPUT_SIZE_SSL + 8 ];
 	int i, status, LOOP_ITERATOR;
 
+	REQUIRES( mechanismType >= MECHANISM_NONE && \
+			  mechanismType < MECHANISM_LAST );
+
 	LOOP_LARGE( i = 0, 
 				mechanismTestInfo[ i ].mechanismType != MECHANISM_NONE && \
 					i < FAILSAFE_ARRAYSIZE( mechanismTestInfo, MECHANISM_TEST_INFO ),
@@ -464,6 +476,12 @@ static int mechanismSelfTest( void )
 											&mechanismTestInfo[ i ];
 		MECHANISM_DERIVE_INFO mechanismInfo;
 
+		/* If we've been asked to test only a particular mechanism, skip 
+		   any others */
+		if( mechanismType != MECHANISM_NONE && \
+			mechanismTestInfoPtr->mechanismType != mechanismType )
+			continue;
+
 		memcpy( &mechanismInfo, &mechanismTestInfoPtr->mechanismInfo, 
 				sizeof( MECHANISM_DERIVE_INFO ) );
 		mechanismInfo.dataOut = buffer;
@@ -485,6 +503,31 @@ static int mechanismSelfTest( void )
 
 	return( CRYPT_OK );
 	}
+
+/* The PBKDF2 HMAC-chain code has a SIMD implementation alongside the 
+   generic C one, and if the SIMD code is available then the generic code 
+   would never be exercised.  To check it we re-run the PBKDF2 tests with 
+   the crypto kernels restricted to the generic code, then restore the 
+   original setting */
+
+CHECK_RETVAL \
+static int mechanismSelfTestGeneric( void )
+	{
+	const HWCAP_TIER_TYPE hwCapTier = getHWCapTier();
+	int status, restoreStatus;
+
+	if( hwCapTier == HWCAP_TIER_GENERIC )
+		return( CRYPT_OK );
+	status = setHWCapTier( HWCAP_TIER_GENERIC );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = mechanismSelfTest( MECHANISM_DERIVE_PKCS5 );
+	restoreStatus = setHWCapTier( hwCapTier );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	return( restoreStatus );
+	}
 #endif /* CONFIG_NO_SELFTEST */
 
 /****************************************************************************
@@ -600,7 +643,10 @@ static int selftestFunction( INOUT DEVICE_INFO *deviceInfo,
 	if( cryptStatusError( status ) )
 		return( status );
 	setMessageObjectUnlocked( messageExtInfo );
-	return( mechanismSelfTest() );
+	status = mechanismSelfTest( MECHANISM_NONE );
+	if( cryptStatusError( status ) )
+		return( status );
+	return( mechanismSelfTestGeneric() );
 	}
 #endif /* !CONFIG_NO_SELFTEST */
 
@@ -791,6 +837,9 @@ static const GETCAPABILITY_FUNCTION FAR_DATA getCapabilityTable[] = {
 #ifdef USE_CAST
 	getCASTCapability,
 #endif /* USE_CAST */
+#ifdef USE_CHACHA20
+	getChaCha20Capability,
+#endif /* USE_CHACHA20 */
 #ifdef USE_DES
 	getDESCapability,
 #endif /* USE_DES */
@@ -831,6 +880,12 @@ static const GETCAPABILITY_FUNCTION FAR_DATA getCapabilityTable[] = {
 #ifdef USE_ECDH
 	getECDHCapability,
 #endif /* USE_ECDH */
+#ifdef USE_25519
+	get25519Capability,
+#endif /* USE_25519 */
+#ifdef USE_ED25519
+	getEd25519Capability,
+#endif /* USE_ED25519 */
 
 	getGenericSecretCapability,
 
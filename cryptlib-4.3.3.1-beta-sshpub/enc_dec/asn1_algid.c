@@ -55,7 +55,17 @@ static int oidToAlgorithm( IN_BUFFER( oidLength ) const BYTE *oid,
 	*param1 = *param2 = 0;
 
 	/* If the OID is shorter than the minimum possible algorithm OID value, 
-	   don't try and process it */
+	   don't try and process it.  The one exception to this is the RFC 8410 
+	   OID for Ed25519 (1 3 101 112), which is allocated from a very short 
+	   arc */
+#ifdef USE_ED25519
+	if( type == ALGOID_CLASS_PKC && oidLength == 5 && \
+		!memcmp( oid, "\x06\x03\x2B\x65\x70", 5 ) )
+		{
+		*cryptAlgo = CRYPT_ALGO_ED25519;
+		return( CRYPT_OK );
+		}
+#endif /* USE_ED25519 */
 	if( oidLength < 7 )
 		return( CRYPT_ERROR_BADDATA );
 	oidByte = oid[ 6 ];
@@ -179,13 +179,15 @@ static int processDataEnd( INOUT ENVELOPE_INFO *envelopeInfoPtr )
 	/* If this is PGP data and there's an MDC packet tacked onto the end of 
 	   the payload, record the fact that it's non-payload data 
 	   (processPgpSegment() has ensured that there's enough data present to 
-	   contain a full MDC packet) */
+	   contain a full MDC packet).  If the MDC packet was split across two 
+	   lots of copied-in data then all of the payload may already have been 
+	   copied out, leaving only the MDC packet in the buffer */
 #ifdef USE_PGP
 	if( envelopeInfoPtr->type == CRYPT_FORMAT_PGP && \
 		( envelopeInfoPtr->dataFlags & ENVDATA_HASATTACHEDOOB ) )
 		{
 		envelopeInfoPtr->dataLeft -= PGP_MDC_PACKET_SIZE;
-		ENSURES( envelopeInfoPtr->dataLeft > 0 && \
+		ENSURES( envelopeInfoPtr->dataLeft >= 0 && \
 				 envelopeInfoPtr->dataLeft < MAX_INTLENGTH );
 		}
 #endif /* USE_PGP */
@@ -817,6 +819,56 @@ static int copyEncryptedDataBlocks( INOUT ENVELOPE_INFO *envelopeInfoPtr,
 	return( CRYPT_OK );
 	}
 
+/* Decrypt data and hash the resulting plaintext.  Rather than decrypting 
+   all of the data and then making a second pass over it to hash it, which 
+   for large amounts of data means that it's been evicted from the cache by 
+   the time that it's hashed, we decrypt and hash it in chunks that remain 
+   in the cache between the two operations.  The chunks can't be made too 
+   small since each one costs a decrypt and a hash message, which for 
+   chunks of less than about 16K costs more than the cache misses that 
+   we're trying to avoid */
+
+#define DECRYPT_HASH_CHUNK_SIZE		65536
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int decryptHashData( INOUT ENVELOPE_INFO *envelopeInfoPtr,
+							INOUT_BUFFER_FIXED( length ) BYTE *data, 
+							IN_DATALENGTH const int length,
+							IN_DATALENGTH const int hashLength )
+	{
+	int offset, status, LOOP_ITERATOR;
+
+	assert( isWritePtr( envelopeInfoPtr, sizeof( ENVELOPE_INFO ) ) );
+	assert( isWritePtrDynamic( data, length ) );
+
+	REQUIRES( length > 0 && length < MAX_BUFFER_SIZE );
+	REQUIRES( hashLength >= 0 && hashLength <= length );
+
+	LOOP_MAX( offset = 0, offset < length, 
+			  offset += DECRYPT_HASH_CHUNK_SIZE )
+		{
+		const int chunkLength = min( length - offset, 
+									 DECRYPT_HASH_CHUNK_SIZE );
+
+		status = krnlSendMessage( envelopeInfoPtr->iCryptContext,
+								  IMESSAGE_CTX_DECRYPT, data + offset,
+								  chunkLength );
+		if( cryptStatusError( status ) )
+			return( status );
+		if( offset < hashLength )
+			{
+			status = hashEnvelopeData( envelopeInfoPtr, data + offset, 
+									   min( chunkLength, \
+											hashLength - offset ) );
+			if( cryptStatusError( status ) )
+				return( status );
+			}
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	return( CRYPT_OK );
+	}
+
 /* Copy possibly encrypted data into the envelope with special handling for
    block encryption modes.  Returns the number of bytes copied:
 
@@ -938,11 +990,6 @@ static int copyData( INOUT ENVELOPE_INFO *envelopeInfoPtr,
 			if( cryptStatusError( status ) )
 				return( status );
 			}
-		status = krnlSendMessage( envelopeInfoPtr->iCryptContext,
-								  IMESSAGE_CTX_DECRYPT, bufPtr,
-								  bytesToCopy );
-		if( cryptStatusError( status ) )
-			return( status );
 		if( envelopeInfoPtr->dataFlags & ENVDATA_HASHACTIONSACTIVE )
 			{
 			int bytesToHash = bytesToCopy;
@@ -961,18 +1008,42 @@ static int copyData( INOUT ENVELOPE_INFO *envelopeInfoPtr,
 			   processPgpSegment() converts the last segment of indefinite-
 			   length data into a definite-length one (so payloadSize != 
 			   CRYPT_UNUSED), and also ensures that there's enough data 
-			   present to contain a full MDC packet */
+			   present to contain a full MDC packet.
+			   
+			   If the payload is larger than the envelope buffer then the 
+			   MDC packet can also be split across two copies, in which 
+			   case we stop hashing at the start of the MDC packet in the
+			   first copy and hash none of the remainder of the MDC packet
+			   in the second copy */
 			if( ( envelopeInfoPtr->dataFlags & ENVDATA_HASATTACHEDOOB ) && \
-				envelopeInfoPtr->payloadSize != CRYPT_UNUSED && \
-				bytesToCopy >= envelopeInfoPtr->segmentSize )
+				envelopeInfoPtr->payloadSize != CRYPT_UNUSED )
 				{
-				bytesToHash -= PGP_MDC_PACKET_SIZE;
-				ENSURES( bytesToHash > 0 && bytesToHash < MAX_BUFFER_SIZE );
+				if( bytesToCopy >= envelopeInfoPtr->segmentSize )
+					{
+					bytesToHash = max( bytesToCopy - PGP_MDC_PACKET_SIZE, 0 );
+					}
+				else
+					{
+					if( bytesToCopy > envelopeInfoPtr->segmentSize - \
+									  PGP_MDC_PACKET_SIZE )
+						{
+						bytesToHash = envelopeInfoPtr->segmentSize - \
+									  PGP_MDC_PACKET_SIZE;
+						}
+					}
+				ENSURES( bytesToHash >= 0 && bytesToHash <= bytesToCopy );
 				}
-			status = hashEnvelopeData( envelopeInfoPtr, bufPtr, bytesToHash );
-			if( cryptStatusError( status ) )
-				return( status );
+			status = decryptHashData( envelopeInfoPtr, bufPtr, bytesToCopy, 
+									  bytesToHash );
 			}
+		else
+			{
+			status = krnlSendMessage( envelopeInfoPtr->iCryptContext,
+									  IMESSAGE_CTX_DECRYPT, bufPtr,
+									  bytesToCopy );
+			}
+		if( cryptStatusError( status ) )
+			return( status );
 		}
 	envelopeInfoPtr->bufPos += bytesToCopy;
 	if( !( envelopeInfoPtr->dataFlags & ENVDATA_NOLENGTHINFO ) )
@@ -1409,6 +1480,30 @@ static int copyFromDeenvelope( INOUT ENVELOPE_INFO *envelopeInfoPtr,
 			envelopeInfoPtr->blockBufferPos <= 0 )
 			bytesToCopy -= envelopeInfoPtr->blockSize;
 
+		/* If we're processing PGP data with an MDC packet attached to the 
+		   end of the payload and the MDC has been split across two lots of 
+		   copied-in data then the start of the MDC is already present in 
+		   the buffer but we won't know where the payload ends until the 
+		   remainder of the MDC has been copied in, so we have to retain 
+		   the partial MDC data until the end-of-contents has been reached.  
+		   If the end of the payload is already known (dataLeft is set) 
+		   then the copy has been limited to the payload data above */
+#ifdef USE_PGP
+		if( envelopeInfoPtr->type == CRYPT_FORMAT_PGP && \
+			( envelopeInfoPtr->dataFlags & ENVDATA_HASATTACHEDOOB ) && \
+			!( envelopeInfoPtr->dataFlags & ENVDATA_ENDOFCONTENTS ) && \
+			envelopeInfoPtr->dataLeft <= 0 && \
+			envelopeInfoPtr->payloadSize != CRYPT_UNUSED && \
+			envelopeInfoPtr->segmentSize < PGP_MDC_PACKET_SIZE )
+			{
+			const int mdcBytesPresent = PGP_MDC_PACKET_SIZE - \
+										envelopeInfoPtr->segmentSize;
+
+			if( bytesToCopy > envelopeInfoPtr->bufPos - mdcBytesPresent )
+				bytesToCopy = envelopeInfoPtr->bufPos - mdcBytesPresent;
+			}
+#endif /* USE_PGP */
+
 		/* If we've ended up with nothing to copy (e.g. due to blocking
 		   requirements), exit */
 		if( bytesToCopy <= 0 )
@@ -1012,6 +1012,22 @@ static int processPacketDataHeader( INOUT ENVELOPE_INFO *envelopeInfoPtr,
 				envelopeInfoPtr->dataLeft = envelopeInfoPtr->segmentSize;
 				envelopeInfoPtr->segmentSize = 0;
 				}
+			else
+				{
+				/* The segment extends past the data that's currently in 
+				   the buffer.  The data that's already present was copied 
+				   in as an opaque blob when we synchronised to the start of 
+				   the payload, which doesn't adjust segmentSize, so we 
+				   have to remove it from the count now to leave just the 
+				   data that's still to be copied in.  If there's an MDC 
+				   packet attached to the payload then it'll be copied in 
+				   after the payload, so we include it in the count in 
+				   order for copyData() to detect the end of the payload 
+				   and exclude the MDC packet from the hashed data */
+				envelopeInfoPtr->segmentSize -= envelopeInfoPtr->bufPos;
+				if( envelopeInfoPtr->dataFlags & ENVDATA_HASATTACHEDOOB )
+					envelopeInfoPtr->segmentSize += PGP_MDC_PACKET_SIZE;
+				}
 			}
 
 		/* We've processed the header, if this is signed data we start 
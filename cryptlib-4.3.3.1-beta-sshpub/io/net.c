@@ -501,6 +501,13 @@ static int initStream( OUT STREAM *stream,
 		netStream->nFlags = STREAM_NFLAG_ISSERVER;
 	if( protocol == STREAM_PROTOCOL_UDP )
 		netStream->nFlags |= STREAM_NFLAG_DGRAM;
+#ifdef USE_EVENTLOOP
+	if( connectInfo->eventTask != NULL )
+		{
+		netStream->nFlags |= STREAM_NFLAG_EVENTLOOP;
+		netStream->eventTask = connectInfo->eventTask;
+		}
+#endif /* USE_EVENTLOOP */
 
 	/* Set up the stream timeout information.  While we're connecting the 
 	   stream timeout is the connect timeout.  Once we've connected it's set
@@ -573,6 +580,12 @@ static void cleanupStream( INOUT STREAM *stream,
 		}
 
 	/* Clean up stream-related buffers if necessary */
+	if( ( netStream->nFlags & STREAM_NFLAG_READAHEAD ) && \
+		stream->buffer != NULL )
+		{
+		zeroise( stream->buffer, stream->bufSize );
+		clFree( "cleanupStream", stream->buffer );
+		}
 	zeroise( netStream, sizeof( NET_STREAM_INFO ) + netStream->storageSize );
 	clFree( "cleanupStream", netStream );
 
@@ -701,6 +714,10 @@ static int completeConnect( INOUT STREAM *stream,
 						  protocol == STREAM_PROTOCOL_TCP || \
 						  protocol == STREAM_PROTOCOL_UDP ) ? \
 						FALSE : TRUE;
+	const BOOLEAN useReadAhead = \
+						( protocol == STREAM_PROTOCOL_TCP && \
+						  options == NET_OPTION_HOSTNAME ) ? \
+						TRUE : FALSE;
 	STM_TRANSPORTOK_FUNCTION transportOKFunction;
 	NET_STREAM_INFO *netStream;
 	void *netStreamInfo;
@@ -841,6 +858,8 @@ static int completeConnect( INOUT STREAM *stream,
 	/* Initialise the network stream with the net stream template and set up 
 	   pointers to buffers if required */
 	memcpy( netStream, netStreamTemplate, sizeof( NET_STREAM_INFO ) );
+	if( useReadAhead )
+		netStream->nFlags |= STREAM_NFLAG_READAHEAD;
 	if( useTransportBuffering || urlInfo != NULL )
 		{
 		BYTE *netStreamDataPtr = netStream->storage;
@@ -19,9 +19,142 @@
 *																			*
 ****************************************************************************/
 
+/* Read-ahead transport-layer read function.  Secure session protocols 
+   read each packet as a fixed-size header followed by the packet body, 
+   which without buffering results in at least two recv() calls (and their
+   accompanying select()s) per packet.  To avoid this we read whatever data 
+   the network stack has available into a read-ahead buffer and satisfy the 
+   header and body reads from that, so that during a bulk transfer a single 
+   recv() can supply any number of packets.  The buffer management is the 
+   same as for bufferedTransportRead() below, but unlike that function 
+   which is used for PKI datagrams and forces the read to be atomic, this 
+   one preserves the standard stream timeout semantics:
+
+		   bPos		   bEnd
+			|			|
+			v			v
+	+-------+-----------+-------+
+	|		|///////////|		|
+	+-------+-----------+-------+
+
+   We only refill the buffer once it's been completely emptied, which means 
+   that there's never any data to move down.  If the caller is asking for
+   more data than the buffer can hold then there's nothing to be gained by 
+   going via the buffer so we read the remainder directly into the caller's
+   buffer.  Since the transport-layer read function only reports an error 
+   if no data at all was read, an error after we've already copied data 
+   from the buffer is reported as a short read, with the error being 
+   encountered again on the next read.
+
+   The buffer isn't allocated until it's first needed for a refill, so 
+   that streams that are opened but never read from, or that only ever 
+   perform reads larger than the buffer, don't tie up the memory for it */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3, 4 ) ) \
+static int readAheadTransportRead( INOUT STREAM *stream, 
+								   INOUT NET_STREAM_INFO *netStream,
+								   OUT_BUFFER( maxLength, *length ) \
+										BYTE *buffer, 
+								   IN_DATALENGTH const int maxLength, 
+								   OUT_DATALENGTH_Z int *length )
+	{
+	STM_TRANSPORTREAD_FUNCTION transportReadFunction;
+	int bytesCopied = 0, status, LOOP_ITERATOR;
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isWritePtr( netStream, sizeof( NET_STREAM_INFO ) ) );
+	assert( isWritePtrDynamic( buffer, maxLength ) );
+	assert( isWritePtr( length, sizeof( int ) ) );
+
+	REQUIRES_S( netStream->nFlags & STREAM_NFLAG_READAHEAD );
+	REQUIRES_S( ( stream->buffer == NULL && stream->bufSize == 0 ) || \
+				( stream->buffer != NULL && \
+				  stream->bufSize == NETWORK_READAHEAD_SIZE ) );
+	REQUIRES_S( stream->bufPos >= 0 && stream->bufPos <= stream->bufEnd && \
+				stream->bufEnd <= stream->bufSize );
+	REQUIRES_S( maxLength > 0 && maxLength < MAX_BUFFER_SIZE );
+
+	/* Set up the function pointers */
+	transportReadFunction = FNPTR_GET( netStream->transportReadFunction );
+	REQUIRES_S( transportReadFunction != NULL );
+
+	/* Clear return value */
+	*length = 0;
+
+	/* Return as much as we can from the read-ahead buffer, refilling it 
+	   from the network as required.  If there's no more data available then
+	   the refill returns zero bytes (for a nonblocking read) or a timeout 
+	   (for a blocking one) */
+	status = CRYPT_OK;
+	LOOP_MED_CHECK( bytesCopied < maxLength )
+		{
+		const int bytesAvail = stream->bufEnd - stream->bufPos;
+		int bytesRead;
+
+		/* If there's data in the read-ahead buffer, return as much of it 
+		   as we can */
+		if( bytesAvail > 0 )
+			{
+			const int bytesToCopy = min( bytesAvail, maxLength - bytesCopied );
+
+			REQUIRES_S( rangeCheckZ( stream->bufPos, bytesToCopy, 
+									stream->bufEnd ) );
+			memcpy( buffer + bytesCopied, stream->buffer + stream->bufPos, 
+					bytesToCopy );
+			stream->bufPos += bytesToCopy;
+			if( stream->bufPos >= stream->bufEnd )
+				stream->bufPos = stream->bufEnd = 0;
+			bytesCopied += bytesToCopy;
+			continue;
+			}
+
+		/* If the remaining data won't fit into the read-ahead buffer, read 
+		   it directly into the caller's buffer */
+		if( maxLength - bytesCopied >= NETWORK_READAHEAD_SIZE )
+			{
+			status = transportReadFunction( netStream, buffer + bytesCopied, 
+											maxLength - bytesCopied, 
+											&bytesRead, TRANSPORT_FLAG_NONE );
+			if( cryptStatusOK( status ) )
+				bytesCopied += bytesRead;
+			break;
+			}
+
+		/* If this is the first time that the read-ahead buffer is needed, 
+		   allocate it now */
+		if( stream->buffer == NULL )
+			{
+			stream->buffer = clAlloc( "readAheadTransportRead", 
+									  NETWORK_READAHEAD_SIZE );
+			if( stream->buffer == NULL )
+				{
+				status = CRYPT_ERROR_MEMORY;
+				break;
+				}
+			stream->bufSize = NETWORK_READAHEAD_SIZE;
+			}
+
+		/* Refill the read-ahead buffer with whatever's available */
+		status = transportReadFunction( netStream, stream->buffer, 
+										stream->bufSize, &bytesRead, 
+										TRANSPORT_FLAG_READAHEAD );
+		if( cryptStatusError( status ) || bytesRead <= 0 )
+			break;
+		ENSURES_S( bytesRead <= stream->bufSize );
+		stream->bufEnd = bytesRead;
+		}
+	ENSURES_S( LOOP_BOUND_OK );
+	if( cryptStatusError( status ) && bytesCopied <= 0 )
+		return( status );
+	*length = bytesCopied;
+
+	return( CRYPT_OK );
+	}
+
 /* Map the upper-layer I/O functions directly to the transport-layer
    equivalent.  This is used if we're performing raw I/O without any
-   intermediate protocol layers or buffering */
+   intermediate protocol layers or buffering, or only the read-ahead 
+   buffering above */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
 static int transportDirectReadFunction( INOUT STREAM *stream, 
@@ -47,6 +180,13 @@ static int transportDirectReadFunction( INOUT STREAM *stream,
 	transportReadFunction = FNPTR_GET( netStream->transportReadFunction );
 	REQUIRES_S( transportReadFunction != NULL );
 
+	/* If the stream uses a read-ahead buffer, read via that */
+	if( netStream->nFlags & STREAM_NFLAG_READAHEAD )
+		{
+		return( readAheadTransportRead( stream, netStream, buffer, 
+										maxLength, length ) );
+		}
+
 	return( transportReadFunction( netStream, buffer, maxLength, length,
 								   TRANSPORT_FLAG_NONE ) );
 	}
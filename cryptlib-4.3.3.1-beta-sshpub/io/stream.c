@@ -1719,6 +1719,34 @@ int sioctlGet( INOUT STREAM *stream,
 			return( CRYPT_OK );
 			}
 
+		case STREAM_IOCTL_GETSOCKET:
+			{
+			NET_STREAM_INFO *netStream = DATAPTR_GET( stream->netStream );
+
+			REQUIRES_S( netStream != NULL );
+			REQUIRES_S( dataMaxLen == sizeof( int ) );
+
+			/* If the stream is layered over another cryptlib session or 
+			   there's no connection established yet then there's no socket 
+			   that the caller could wait on */
+			if( netStream->iTransportSession != CRYPT_ERROR || \
+				( int ) netStream->netSocket < 0 )
+				return( CRYPT_ERROR_NOTFOUND );
+			*( ( int * ) data ) = ( int ) netStream->netSocket;
+			return( CRYPT_OK );
+			}
+
+		case STREAM_IOCTL_READAHEAD:
+			REQUIRES_S( dataMaxLen == sizeof( int ) );
+
+			/* Report how much data is waiting in the read-ahead buffer.  
+			   This can be read without any further network I/O, so a 
+			   caller that's waiting on the socket to become readable needs 
+			   to consume it first */
+			*( ( int * ) data ) = ( stream->buffer != NULL ) ? \
+								  stream->bufEnd - stream->bufPos : 0;
+			return( CRYPT_OK );
+
 		case STREAM_IOCTL_GETCLIENTNAME:
 			{
 			NET_STREAM_INFO *netStream = DATAPTR_GET( stream->netStream );
@@ -146,6 +146,8 @@ typedef enum {
 	STREAM_IOCTL_HTTPREQTYPES,		/* Permitted HTTP request types */
 	STREAM_IOCTL_CLOSESENDCHANNEL,	/* Close send side of channel */
 	STREAM_IOCTL_ERRORINFO,			/* Set stream extended error info */
+	STREAM_IOCTL_GETSOCKET,			/* Get underlying network socket */
+	STREAM_IOCTL_READAHEAD,			/* Get amount of read-ahead data */
 	STREAM_IOCTL_LAST				/* Last possible IOCTL type */
 	} STREAM_IOCTL_TYPE;
 
@@ -344,6 +346,12 @@ typedef struct {
 	CRYPT_USER iUserObject;		/* Owning user object */
 	int timeout, connectTimeout;/* Connect and data xfer.timeouts */
 	NET_OPTION_TYPE options;	/* Connect options */
+
+	/* If the stream is being driven from an external event loop, the task 
+	   to suspend when the stream would block on I/O */
+#ifdef USE_EVENTLOOP
+	TASK_INFO *eventTask;		/* Task to suspend on I/O wait */
+#endif /* USE_EVENTLOOP */
 	} NET_CONNECT_INFO;
 
 #define initNetConnectInfo( netConnectInfo, netUserObject, netTimeout, \
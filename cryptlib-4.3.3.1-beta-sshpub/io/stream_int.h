@@ -137,6 +137,11 @@ typedef enum {
 		bytes is requested and the encapsulation layer reports that only m 
 		bytes, m < n is present, this isn't treated as a read/timeout error.
 
+	NFLAG_EVENTLOOP: The stream is being driven from an external event 
+		loop, so an I/O wait performed from within a task suspends the task
+		until the event loop resumes it, and an I/O wait with a zero timeout
+		polls the socket once rather than returning without checking it.
+
 	NFLAG_FIRSTREADOK: The first data read from the stream succeeded.  This
 		is used to detect problems due to buggy firewall software, see the
 		comments in io/tcp.c for details.
@@ -173,6 +178,11 @@ typedef enum {
 		the other side (for example through an HTTP "Connection: close") 
 		that this is the case.
 
+	NFLAG_READAHEAD: Reads on the stream go via a read-ahead buffer, which 
+		is allocated on the first read that needs it.  This isn't used for 
+		user-supplied sockets since any data that's been read ahead would 
+		be lost when the socket is handed back to the user.
+
 	NFLAG_USERSOCKET: The network socket was supplied by the user rather 
 		than being created by cryptlib, so some actions such as socket
 		shutdown should be skipped */
@@ -191,7 +201,9 @@ typedef enum {
 #define STREAM_NFLAG_LASTMSGW	0x0400	/* Last message in write exchange */
 #define STREAM_NFLAG_ENCAPS		0x0800	/* Network transport is encapsulated */
 #define STREAM_NFLAG_FIRSTREADOK 0x1000	/* First data read succeeded */
-#define STREAM_NFLAG_MAX		0x1FFF	/* Maximum possible flag value */
+#define STREAM_NFLAG_EVENTLOOP	0x2000	/* Stream driven from ext.event loop */
+#define STREAM_NFLAG_READAHEAD	0x4000	/* Use read-ahead buffer for reads */
+#define STREAM_NFLAG_MAX		0x7FFF	/* Maximum possible flag value */
 #define STREAM_NFLAG_HTTPREQMASK ( STREAM_NFLAG_HTTPGET | STREAM_NFLAG_HTTPPOST | \
 								   STREAM_NFLAG_HTTPPOST_AS_GET )
 										/* Mask for permitted HTTP req.types */
@@ -202,13 +214,29 @@ typedef enum {
 		the stream buffers.
 	
 	FLAG_BLOCKING/FLAG_NONBLOCKING: Used to override the stream default 
-		behaviour on reads and writes and force blocking/nonblocking I/O */
+		behaviour on reads and writes and force blocking/nonblocking I/O.
+
+	FLAG_READAHEAD: Used in reads to fill a read-ahead buffer, the read 
+		waits as usual for data to become available but then returns 
+		whatever was read rather than waiting for the buffer to fill */
 
 #define TRANSPORT_FLAG_NONE		0x00	/* No transport flag */
 #define TRANSPORT_FLAG_FLUSH	0x01	/* Flush data on write */
 #define TRANSPORT_FLAG_NONBLOCKING 0x02	/* Explicitly perform nonblocking read */
 #define TRANSPORT_FLAG_BLOCKING	0x04	/* Explicitly perform blocking read */
-#define TRANSPORT_FLAG_MAX		0x07	/* Maximum possible flag value */
+#define TRANSPORT_FLAG_READAHEAD 0x08	/* Return once any data is read */
+#define TRANSPORT_FLAG_MAX		0x0F	/* Maximum possible flag value */
+
+/* Direct TCP streams, which carry SSH and SSL/TLS traffic, use a 
+   read-ahead buffer that allows multiple packets to be read with a single
+   recv().  This is sized to hold a maximum-size SSL/TLS packet payload, 
+   with anything larger being read directly into the caller's buffer */
+
+#ifdef CONFIG_CONSERVE_MEMORY
+  #define NETWORK_READAHEAD_SIZE	4096
+#else
+  #define NETWORK_READAHEAD_SIZE	16384
+#endif /* CONFIG_CONSERVE_MEMORY */
 
 /* URL component size limits, used when parsing a URL */
 
@@ -344,6 +372,14 @@ typedef struct NS {
 	   timeout is cleared */
 	int timeout, savedTimeout;	/* Network comms timeout */
 
+	/* If the stream is being driven from an external event loop then we
+	   never block waiting for I/O.  If the I/O is being performed from 
+	   within a task, typically the session handshake, then we suspend the 
+	   task until the event loop indicates that the I/O can proceed */
+#ifdef USE_EVENTLOOP
+	TASK_INFO *eventTask;		/* Task to suspend on I/O wait */
+#endif /* USE_EVENTLOOP */
+
 	/* Network streams require separate read/write buffers for packet
 	   assembly/disassembly so we provide a write buffer alongside the 
 	   generic stream read buffer */
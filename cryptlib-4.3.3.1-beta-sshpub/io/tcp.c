@@ -307,6 +307,74 @@ static int checkSocketFunction( INOUT NET_STREAM_INFO *netStream )
    non-portable interfaces like kqueue (and earlier alternatives like Sun's 
    /dev/poll, FreeBSD's get_next_event(), and SGI's /dev/imon) */
 
+#ifdef USE_EVENTLOOP
+
+/* Wait for I/O on a stream that's being driven from an external event loop.
+   Instead of blocking in select() we suspend the task that's performing 
+   the I/O, typically a session handshake, until the event loop resumes it, 
+   and repeat this until the socket is ready or the timeout expires.  Since 
+   the caller can resume the task at any time, being resumed doesn't 
+   necessarily mean that the I/O can proceed, so we recheck the socket each 
+   time.  The result is picked up by the caller's zero-wait select() in the 
+   usual manner */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int waitEventTask( INOUT NET_STREAM_INFO *netStream,
+						  INOUT MONOTIMER_INFO *timerInfo,
+						  IN_ENUM( IOWAIT ) const IOWAIT_TYPE type )
+	{
+	const int waitEvents = ( type == IOWAIT_WRITE || \
+							 type == IOWAIT_CONNECT ) ? \
+						   CRYPT_NETWORKEVENT_WRITE : CRYPT_NETWORKEVENT_READ;
+	int iterationCount, status, LOOP_ITERATOR;
+
+	assert( isWritePtr( netStream, sizeof( NET_STREAM_INFO ) ) );
+	assert( isWritePtr( timerInfo, sizeof( MONOTIMER_INFO ) ) );
+
+	REQUIRES( netStream->eventTask != NULL );
+	REQUIRES( type > IOWAIT_NONE && type < IOWAIT_LAST );
+
+	LOOP_MAX( iterationCount = 0, iterationCount < FAILSAFE_ITERATIONS_MAX,
+			  iterationCount++ )
+		{
+		struct timeval tv;
+		fd_set fds, exceptfds;
+
+		/* Check whether the I/O can proceed.  If the socket is ready or 
+		   there's an error condition then we let the caller sort it out */
+		FD_ZERO( &fds );
+		FD_SET( netStream->netSocket, &fds );
+		FD_ZERO( &exceptfds );
+		FD_SET( netStream->netSocket, &exceptfds );
+		tv.tv_sec = tv.tv_usec = 0;
+		clearErrorState();
+		status = select( ( int ) netStream->netSocket + 1, 
+						 ( waitEvents == CRYPT_NETWORKEVENT_READ ) ? \
+							&fds : NULL, 
+						 ( waitEvents == CRYPT_NETWORKEVENT_WRITE ) ? \
+							&fds : NULL, &exceptfds, &tv );
+		if( status > 0 || \
+			( isSocketError( status ) && !isRestartableError() ) )
+			return( CRYPT_OK );
+		if( checkMonoTimerExpired( timerInfo ) )
+			return( CRYPT_OK );
+
+		/* Suspend the task until the event loop resumes it.  If the task 
+		   has been cancelled then we report it as a timeout since the I/O 
+		   is never going to complete */
+		status = suspendTask( netStream->eventTask, waitEvents );
+		if( cryptStatusError( status ) )
+			{
+			return( setSocketError( netStream, "I/O wait was cancelled", 22,
+									CRYPT_ERROR_TIMEOUT, TRUE ) );
+			}
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	return( CRYPT_OK );
+	}
+#endif /* USE_EVENTLOOP */
+
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
 int ioWait( INOUT NET_STREAM_INFO *netStream, 
 			IN_INT_Z const int timeout,
@@ -332,6 +400,7 @@ int ioWait( INOUT NET_STREAM_INFO *netStream,
 						  type == IOWAIT_ACCEPT ) ? &readfds : NULL;
 	fd_set *writeFDPtr = ( type == IOWAIT_WRITE || \
 						   type == IOWAIT_CONNECT ) ? &writefds : NULL;
+	BOOLEAN isPoll = FALSE;
 	int selectIterations, status, LOOP_ITERATOR;
 
 	assert( isWritePtr( netStream, sizeof( NET_STREAM_INFO ) ) );
@@ -400,9 +469,36 @@ int ioWait( INOUT NET_STREAM_INFO *netStream,
 	status = setMonoTimer( &timerInfo, timeout );
 	if( cryptStatusError( status ) )
 		return( status );
+#ifdef USE_EVENTLOOP
+	/* If the stream is being driven from an external event loop then we 
+	   can't block in select() since this would stall every other session 
+	   that the event loop is servicing.  If the wait is being performed 
+	   from within a task then we suspend the task until the socket is 
+	   ready, and in either case we then poll the socket with a single 
+	   zero-wait select().  The zero-timeout case needs to be handled 
+	   explicitly since the timer has already expired by the time that it's 
+	   set, so the standard select() loop would never be executed */
+	if( netStream->nFlags & STREAM_NFLAG_EVENTLOOP )
+		{
+		if( netStream->eventTask != NULL && \
+			isTaskRunning( netStream->eventTask ) )
+			{
+			status = waitEventTask( netStream, &timerInfo, type );
+			if( cryptStatusError( status ) )
+				return( status );
+			isPoll = TRUE;
+			}
+		else
+			{
+			if( timeout <= 0 )
+				isPoll = TRUE;
+			}
+		}
+#endif /* USE_EVENTLOOP */
 	LOOP_MED( ( selectIterations = 0, status = SOCKET_ERROR ), \
 			  isSocketError( status ) && \
-				!checkMonoTimerExpired( &timerInfo ) && \
+				( isPoll ? ( selectIterations <= 0 ) : \
+						   !checkMonoTimerExpired( &timerInfo ) ) && \
 				selectIterations < 20, 
 			  selectIterations++ )
 		{
@@ -418,8 +514,8 @@ int ioWait( INOUT NET_STREAM_INFO *netStream,
 			}
 		FD_ZERO( &exceptfds );
 		FD_SET( netStream->netSocket, &exceptfds );
-		tv.tv_sec = timeout;
-		tv.tv_usec = ( timeout <= 0 ) ? 5000 : 0;
+		tv.tv_sec = isPoll ? 0 : timeout;
+		tv.tv_usec = ( timeout <= 0 && !isPoll ) ? 5000 : 0;
 
 		/* See if we can perform the I/O.  This gets a bit complex under 
 		   Windows because a socket isn't an int like everywhere else so the
@@ -603,7 +699,10 @@ int ioWait( INOUT NET_STREAM_INFO *netStream,
    flags are used by the buffered-read routines, which try and speculatively 
    read as much data as possible to avoid the many small reads required by 
    some protocols.  We don't do the blocking read using MSG_WAITALL since 
-   this can (potentially) block forever if not all of the data arrives.
+   this can (potentially) block forever if not all of the data arrives.  A
+   third flag, used to fill a read-ahead buffer, waits for data in the usual 
+   manner but then returns after the first recv() with whatever the network 
+   stack had available rather than continuing until the buffer is full.
 
    Finally, if we're performing an explicit blocking read (which is usually 
    done when we're expecting a predetermined number of bytes) we dynamically 
@@ -654,7 +753,8 @@ static int readSocketFunction( INOUT NET_STREAM_INFO *netStream,
 				timeout >= 0 && timeout < MAX_INTLENGTH ) );
 	REQUIRES( flags == TRANSPORT_FLAG_NONE || \
 			  flags == TRANSPORT_FLAG_NONBLOCKING || \
-			  flags == TRANSPORT_FLAG_BLOCKING );
+			  flags == TRANSPORT_FLAG_BLOCKING || \
+			  flags == TRANSPORT_FLAG_READAHEAD );
 
 	/* Clear return value */
 	*length = 0;
@@ -815,6 +915,12 @@ static int readSocketFunction( INOUT NET_STREAM_INFO *netStream,
 		   the long comment above) */
 		netStream->nFlags |= STREAM_NFLAG_FIRSTREADOK;
 
+		/* If we're filling a read-ahead buffer then we return whatever 
+		   the network stack had available rather than waiting for the
+		   buffer to fill */
+		if( flags & TRANSPORT_FLAG_READAHEAD )
+			break;
+
 		/* If this is a blocking read and we've been moving data at a 
 		   reasonable rate (~1K/s) and we're about to time out, adjust the 
 		   timeout to give us a bit more time.  This is an adaptive process 
@@ -566,6 +566,88 @@ static const ATTRIBUTE_ACL FAR_DATA optionACL[] = {
 		ST_NONE, ST_NONE, ST_USER_ANY, 
 		MKPERM( RWx_RWx ), 
 		ROUTE( OBJECT_TYPE_USER ) ),
+
+	MKACL_N(	/* Pre-generated DH/ECDH keys per group */
+		CRYPT_OPTION_SESSION_KEYPOOLSIZE,
+		ST_NONE, ST_NONE, ST_USER_SO, 
+		MKPERM_SESSIONS( RWx_RWx ),
+		ROUTE( OBJECT_TYPE_USER ),
+		RANGE( 0, MAX_KEYPOOL_SIZE ) ),
+	MKACL_N(	/* Key pool refill threshold */
+		CRYPT_OPTION_SESSION_KEYPOOLLOWWATER,
+		ST_NONE, ST_NONE, ST_USER_SO, 
+		MKPERM_SESSIONS( RWx_RWx ),
+		ROUTE( OBJECT_TYPE_USER ),
+		RANGE( 0, MAX_KEYPOOL_SIZE - 1 ) ),
+	MKACL_N(	/* Key requests satisfied from pool */
+		CRYPT_OPTION_SESSION_KEYPOOLHITS,
+		ST_NONE, ST_NONE, ST_USER_ANY, 
+		MKPERM_SESSIONS( Rxx_Rxx ),
+		ROUTE( OBJECT_TYPE_USER ),
+		RANGE( 0, MAX_INTLENGTH ) ),
+	MKACL_N(	/* Key requests not satisfied from pool */
+		CRYPT_OPTION_SESSION_KEYPOOLMISSES,
+		ST_NONE, ST_NONE, ST_USER_ANY, 
+		MKPERM_SESSIONS( Rxx_Rxx ),
+		ROUTE( OBJECT_TYPE_USER ),
+		RANGE( 0, MAX_INTLENGTH ) ),
+
+	MKACL_N(	/* Restrict crypto code to CPU tier */
+		CRYPT_OPTION_MISC_CPUTIER,
+		ST_NONE, ST_NONE, ST_USER_SO, 
+		MKPERM( RWx_RWx ),
+		ROUTE( OBJECT_TYPE_USER ),
+		RANGE( HWCAP_TIER_NONE, HWCAP_TIER_LAST - 1 ) ),
+	MKACL_S(	/* Crypto kernels in use */
+		CRYPT_OPTION_MISC_CPUKERNELS,
+		ST_NONE, ST_NONE, ST_USER_ANY, 
+		MKPERM( Rxx_Rxx ),
+		ROUTE( OBJECT_TYPE_USER ),
+		RANGE( 16, MAX_HWCAP_KERNELINFO_SIZE ) ),
+
+	MKACL_S(	/* Shared TLS session ticket keys */
+		CRYPT_OPTION_SESSION_TICKETKEYFILE,
+		ST_NONE, ST_NONE, ST_USER_SO, 
+		MKPERM_SSL( RWD_RWD ),
+		ROUTE( OBJECT_TYPE_USER ),
+		RANGE( 2, MAX_PATH_LENGTH ) ),
+	MKACL_N(	/* Sessions resumed from ticket */
+		CRYPT_OPTION_SESSION_TICKETHITS,
+		ST_NONE, ST_NONE, ST_USER_ANY, 
+		MKPERM_SSL( Rxx_Rxx ),
+		ROUTE( OBJECT_TYPE_USER ),
+		RANGE( 0, MAX_INTLENGTH ) ),
+	MKACL_N(	/* Tickets that couldn't be used */
+		CRYPT_OPTION_SESSION_TICKETMISSES,
+		ST_NONE, ST_NONE, ST_USER_ANY, 
+		MKPERM_SSL( Rxx_Rxx ),
+		ROUTE( OBJECT_TYPE_USER ),
+		RANGE( 0, MAX_INTLENGTH ) ),
+
+	MKACL_N(	/* TLS session cache entries */
+		CRYPT_OPTION_SESSION_CACHESIZE,
+		ST_NONE, ST_NONE, ST_USER_SO, 
+		MKPERM_SSL( RWx_RWx ),
+		ROUTE( OBJECT_TYPE_USER ),
+		RANGE( MIN_SESSIONCACHE_SIZE, MAX_SESSIONCACHE_SIZE ) ),
+	MKACL_S(	/* Shared TLS session cache file */
+		CRYPT_OPTION_SESSION_CACHEFILE,
+		ST_NONE, ST_NONE, ST_USER_SO, 
+		MKPERM_SSL( RWD_RWD ),
+		ROUTE( OBJECT_TYPE_USER ),
+		RANGE( 2, MAX_PATH_LENGTH ) ),
+
+	MKACL_B(	/* Whether TLS server staples OCSP response */
+		CRYPT_OPTION_SESSION_OCSPSTAPLING,
+		ST_NONE, ST_NONE, ST_USER_SO, 
+		MKPERM_SSL( RWx_RWx ),
+		ROUTE( OBJECT_TYPE_USER ) ),
+	MKACL_S(	/* OCSP responder for stapled response */
+		CRYPT_OPTION_SESSION_OCSPRESPONDER,
+		ST_NONE, ST_NONE, ST_USER_SO, 
+		MKPERM_SSL( RWD_RWD ),
+		ROUTE( OBJECT_TYPE_USER ),
+		RANGE( MIN_URL_SIZE, MAX_URL_SIZE ) ),
 	MKACL_END(), MKACL_END()
 	};
 
@@ -3399,12 +3481,13 @@ static const ATTRIBUTE_ACL FAR_DATA subACL_SessinfoVersion[] = {
 		MKPERM_SESSIONS( Rxx_RWx ),
 		ROUTE( OBJECT_TYPE_SESSION ),
 		RANGE( 1, 2 ) ),
-	MKACL_N(	/* SSL: 0 (SSLv3), 1 (TLS 1.0), 2 (TLS 1.1), or 3 (TLS 1.2) */
+	MKACL_N(	/* SSL: 0 (SSLv3), 1 (TLS 1.0), 2 (TLS 1.1), 3 (TLS 1.2), or 
+				   4 (TLS 1.3) */
 		CRYPT_SESSINFO_VERSION,
 		ST_NONE, ST_NONE, ST_SESS_SSL | ST_SESS_SSL_SVR, 
 		MKPERM_SESSIONS( Rxx_RWx ),
 		ROUTE( OBJECT_TYPE_SESSION ),
-		RANGE( 0, 3 ) ),
+		RANGE( 0, 4 ) ),
 	MKACL_N(	/* OCSP: 1 or 2 */
 		CRYPT_SESSINFO_VERSION,
 		ST_NONE, ST_NONE, ST_SESS_OCSP | ST_SESS_OCSP_SVR, 
@@ -3633,7 +3716,7 @@ static const ATTRIBUTE_ACL FAR_DATA sessionACL[] = {
 	MKACL_N(	/* User-supplied network socket */
 		CRYPT_SESSINFO_NETWORKSOCKET,
 		ST_NONE, ST_NONE, ST_SESS_ANY, 
-		MKPERM_SESSIONS( xxx_xWx ),
+		MKPERM_SESSIONS( Rxx_RWx ),
 		ROUTE( OBJECT_TYPE_SESSION ),
 		RANGE_ANY ),
 
@@ -3726,6 +3809,67 @@ static const ATTRIBUTE_ACL FAR_DATA sessionACL[] = {
 		MKPERM_TSP( xWD_xWD ),
 		ROUTE( OBJECT_TYPE_SESSION ), &objectCtxHash ),
 
+	MKACL_N(	/* Network events session is waiting for */
+		CRYPT_SESSINFO_NETWORKEVENTS,
+		ST_NONE, ST_NONE, ST_SESS_ANY, 
+		MKPERM_SESSIONS( Rxx_Rxx ),
+		ROUTE( OBJECT_TYPE_SESSION ),
+		RANGE( CRYPT_NETWORKEVENT_NONE, CRYPT_NETWORKEVENT_MAX ) ),
+	MKACL_B(	/* Session driven from external event loop */
+		CRYPT_SESSINFO_NONBLOCKING,
+		ST_NONE, ST_NONE, ST_SESS_SSH | ST_SESS_SSH_SVR | ST_SESS_SSL | \
+						  ST_SESS_SSL_SVR, 
+		MKPERM_SESSIONS( Rxx_RWx ),
+		ROUTE( OBJECT_TYPE_SESSION ) ),
+	MKACL_B(	/* Hold back flushes to coalesce writes */
+		CRYPT_SESSINFO_CORK,
+		ST_NONE, ST_NONE, ST_SESS_ANY_DATA, 
+		MKPERM_SESSIONS( RWx_RWx ),
+		ROUTE( OBJECT_TYPE_SESSION ) ),
+
+	MKACL_N(	/* Time to network connection established */
+		CRYPT_SESSINFO_TIMING_CONNECT,
+		ST_NONE, ST_NONE, ST_SESS_SSH | ST_SESS_SSH_SVR | ST_SESS_SSL | \
+						  ST_SESS_SSL_SVR, 
+		MKPERM_SESSIONS( Rxx_xxx ),
+		ROUTE( OBJECT_TYPE_SESSION ),
+		RANGE( 0, MAX_INTLENGTH - 1 ) ),
+	MKACL_N(	/* Time to hello sent */
+		CRYPT_SESSINFO_TIMING_HELLOSENT,
+		ST_NONE, ST_NONE, ST_SESS_SSH | ST_SESS_SSH_SVR | ST_SESS_SSL | \
+						  ST_SESS_SSL_SVR, 
+		MKPERM_SESSIONS( Rxx_xxx ),
+		ROUTE( OBJECT_TYPE_SESSION ),
+		RANGE( 0, MAX_INTLENGTH - 1 ) ),
+	MKACL_N(	/* Time to hello received */
+		CRYPT_SESSINFO_TIMING_HELLORECEIVED,
+		ST_NONE, ST_NONE, ST_SESS_SSH | ST_SESS_SSH_SVR | ST_SESS_SSL | \
+						  ST_SESS_SSL_SVR, 
+		MKPERM_SESSIONS( Rxx_xxx ),
+		ROUTE( OBJECT_TYPE_SESSION ),
+		RANGE( 0, MAX_INTLENGTH - 1 ) ),
+	MKACL_N(	/* Time to key exchange computed */
+		CRYPT_SESSINFO_TIMING_KEYEXCHANGE,
+		ST_NONE, ST_NONE, ST_SESS_SSH | ST_SESS_SSH_SVR | ST_SESS_SSL | \
+						  ST_SESS_SSL_SVR, 
+		MKPERM_SESSIONS( Rxx_xxx ),
+		ROUTE( OBJECT_TYPE_SESSION ),
+		RANGE( 0, MAX_INTLENGTH - 1 ) ),
+	MKACL_N(	/* Time to peer cert/key verified */
+		CRYPT_SESSINFO_TIMING_CERTVERIFIED,
+		ST_NONE, ST_NONE, ST_SESS_SSH | ST_SESS_SSH_SVR | ST_SESS_SSL | \
+						  ST_SESS_SSL_SVR, 
+		MKPERM_SESSIONS( Rxx_xxx ),
+		ROUTE( OBJECT_TYPE_SESSION ),
+		RANGE( 0, MAX_INTLENGTH - 1 ) ),
+	MKACL_N(	/* Time to handshake completed */
+		CRYPT_SESSINFO_TIMING_FINISHED,
+		ST_NONE, ST_NONE, ST_SESS_SSH | ST_SESS_SSH_SVR | ST_SESS_SSL | \
+						  ST_SESS_SSL_SVR, 
+		MKPERM_SESSIONS( Rxx_xxx ),
+		ROUTE( OBJECT_TYPE_SESSION ),
+		RANGE( 0, MAX_INTLENGTH - 1 ) ),
+
 	MKACL_END(), MKACL_END()
 	};
 #endif /* USE_SESSIONS */
@@ -3864,7 +4008,7 @@ static const ATTRIBUTE_ACL FAR_DATA internalACL[] = {
 		ST_CTX_PKC, ST_NONE, ST_NONE, 
 		MKPERM_INT( RWx_RWx ),
 		ROUTE( OBJECT_TYPE_CONTEXT ), RANGE( 8, 8 ) ),
-#if !( defined( USE_ECDH ) || defined( USE_ECDSA ) )
+#if !( defined( USE_ECDH ) || defined( USE_ECDSA ) || defined( USE_ED25519 ) )
 	MKACL_S_EX(	/* Ctx: SubjectPublicKeyInfo */
 		/* The attribute length values are only approximate because there's
 		   wrapper data involved, and (for the maximum length) several of
@@ -3909,7 +4053,8 @@ static const ATTRIBUTE_ACL FAR_DATA internalACL[] = {
 	MKACL_S_EX(	/* Ctx: SubjectPublicKeyInfo */
 		/* ECC keys are somewhat different, the lower bound is much smaller 
 		   but the key data consists of a point on a curve so it's calcuated
-		   as twice the minimum key size */
+		   as twice the minimum key size.  Ed25519 keys, which are a single 
+		   32-byte value, also fall within this range */
 		CRYPT_IATTRIBUTE_KEY_SPKI,
 		ST_CTX_PKC, ST_NONE, ST_NONE, 
 		MKPERM_INT( Rxx_xWx ), ATTRIBUTE_FLAG_TRIGGER,
@@ -3939,7 +4084,7 @@ static const ATTRIBUTE_ACL FAR_DATA internalACL[] = {
 		ST_CTX_PKC, ST_NONE, ST_NONE, 
 		MKPERM_INT( Rxx_RWx ),
 		ROUTE( OBJECT_TYPE_CONTEXT ), RANGE( 8 + MIN_PKCSIZE_ECCPOINT_THRESHOLD, CRYPT_MAX_PKCSIZE * 4 ) ),
-#endif /* !( USE_ECDH || USE_ECDSA ) */
+#endif /* !( USE_ECDH || USE_ECDSA || USE_ED25519 ) */
 	MKACL_S(	/* Ctx: PGP public key w/o trigger */
 		CRYPT_IATTRIBUTE_KEY_PGP_PARTIAL,
 		ST_CTX_PKC, ST_NONE, ST_NONE, 
@@ -377,6 +377,13 @@ typedef struct {
 	MUTEX_DECLARE_STORAGE( mutex1 );
 	MUTEX_DECLARE_STORAGE( mutex2 );
 	MUTEX_DECLARE_STORAGE( mutex3);
+	MUTEX_DECLARE_STORAGE( mutex4 );
+	MUTEX_DECLARE_STORAGE( mutex5 );
+	MUTEX_DECLARE_STORAGE( mutex6 );
+	MUTEX_DECLARE_STORAGE( mutex7 );
+	MUTEX_DECLARE_STORAGE( mutex8 );
+	MUTEX_DECLARE_STORAGE( mutex9 );
+	MUTEX_DECLARE_STORAGE( mutex10 );
 #endif /* USE_THREADS */
 
 	/* The kernel thread data */
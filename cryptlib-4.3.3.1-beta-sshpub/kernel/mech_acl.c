@@ -294,6 +294,16 @@ static const MECHANISM_ACL FAR_DATA mechanismSignACL[] = {
 				 ACL_FLAG_HIGH_STATE ),
 		MKACP_O( ST_CTX_PKC,				/* Signing context */
 				 ACL_FLAG_HIGH_STATE | ACL_FLAG_ROUTE_TO_CTX ) } },
+
+	/* PSS sign */
+	{ MECHANISM_SIG_PSS,
+	  { MKACP_S_OPT( MIN_PKCSIZE,			/* Signature */
+					 CRYPT_MAX_PKCSIZE ),
+		MKACP_O( ST_CTX_HASH,				/* Hash context */
+				 ACL_FLAG_HIGH_STATE ),
+		MKACP_N_FIXED( CRYPT_UNUSED ),		/* Secondary hash context */
+		MKACP_O( ST_CTX_PKC,				/* Signing context */
+				 ACL_FLAG_HIGH_STATE | ACL_FLAG_ROUTE_TO_CTX ) } },
 #endif /* USE_SSL */
 
 	/* End-of-ACL marker */
@@ -325,6 +335,16 @@ static const MECHANISM_ACL FAR_DATA mechanismSigCheckACL[] = {
 				 ACL_FLAG_HIGH_STATE ),
 		MKACP_O( ST_CTX_PKC,				/* Sig.check context */
 				 ACL_FLAG_HIGH_STATE | ACL_FLAG_ROUTE_TO_CTX ) } },
+
+	/* PSS sig check */
+	{ MECHANISM_SIG_PSS,
+	  { MKACP_S( MIN_PKCSIZE,				/* Signature */
+				 CRYPT_MAX_PKCSIZE ),
+		MKACP_O( ST_CTX_HASH,				/* Hash context */
+				 ACL_FLAG_HIGH_STATE ),
+		MKACP_N_FIXED( CRYPT_UNUSED ),		/* Secondary hash context */
+		MKACP_O( ST_CTX_PKC,				/* Sig.check context */
+				 ACL_FLAG_HIGH_STATE | ACL_FLAG_ROUTE_TO_CTX ) } },
 #endif /* USE_SSL */
 
 	/* End-of-ACL marker */
@@ -739,7 +759,8 @@ int preDispatchCheckMechanismSignAccess( IN_HANDLE const int objectHandle,
 			  message == MESSAGE_DEV_SIGCHECK || \
 			  message == IMESSAGE_DEV_SIGCHECK );
 	REQUIRES( messageValue == MECHANISM_SIG_PKCS1 || \
-			  messageValue == MECHANISM_SIG_SSL );
+			  messageValue == MECHANISM_SIG_SSL || \
+			  messageValue == MECHANISM_SIG_PSS );
 
 	/* Find the appropriate ACL for this mechanism */
 	LOOP_MED( i = 0, i < mechanismAclSize && \
@@ -37,7 +37,7 @@ int initSemaphores( void )
 	KERNEL_DATA *krnlData = getKrnlData();
 	int i, status, LOOP_ITERATOR;
 
-	static_assert( MUTEX_LAST == 4, "Mutex value" );
+	static_assert( MUTEX_LAST == 11, "Mutex value" );
 
 	/* Clear the semaphore table */
 	LOOP_SMALL( i = 0, i < SEMAPHORE_LAST, i++ )
@@ -56,6 +56,20 @@ int initSemaphores( void )
 	ENSURES( cryptStatusOK( status ) );
 	MUTEX_CREATE( mutex3, status );
 	ENSURES( cryptStatusOK( status ) );
+	MUTEX_CREATE( mutex4, status );
+	ENSURES( cryptStatusOK( status ) );
+	MUTEX_CREATE( mutex5, status );
+	ENSURES( cryptStatusOK( status ) );
+	MUTEX_CREATE( mutex6, status );
+	ENSURES( cryptStatusOK( status ) );
+	MUTEX_CREATE( mutex7, status );
+	ENSURES( cryptStatusOK( status ) );
+	MUTEX_CREATE( mutex8, status );
+	ENSURES( cryptStatusOK( status ) );
+	MUTEX_CREATE( mutex9, status );
+	ENSURES( cryptStatusOK( status ) );
+	MUTEX_CREATE( mutex10, status );
+	ENSURES( cryptStatusOK( status ) );
 
 	return( CRYPT_OK );
 	}
@@ -75,6 +89,13 @@ void endSemaphores( void )
 	krnlData->shutdownLevel = SHUTDOWN_LEVEL_MUTEXES;
 
 	/* Shut down the mutexes */
+	MUTEX_DESTROY( mutex10 );
+	MUTEX_DESTROY( mutex9 );
+	MUTEX_DESTROY( mutex8 );
+	MUTEX_DESTROY( mutex7 );
+	MUTEX_DESTROY( mutex6 );
+	MUTEX_DESTROY( mutex5 );
+	MUTEX_DESTROY( mutex4 );
 	MUTEX_DESTROY( mutex3 );
 	MUTEX_DESTROY( mutex2 );
 	MUTEX_DESTROY( mutex1 );
@@ -336,6 +357,18 @@ int krnlEnterMutex( IN_ENUM( MUTEX ) const MUTEX_TYPE mutex )
 			MUTEX_LOCK( mutex1 );
 			break;
 
+		case MUTEX_SCOREBOARD1:
+			MUTEX_LOCK( mutex6 );
+			break;
+
+		case MUTEX_SCOREBOARD2:
+			MUTEX_LOCK( mutex7 );
+			break;
+
+		case MUTEX_SCOREBOARD3:
+			MUTEX_LOCK( mutex8 );
+			break;
+
 		case MUTEX_SOCKETPOOL:
 			MUTEX_LOCK( mutex2 );
 			break;
@@ -344,6 +377,22 @@ int krnlEnterMutex( IN_ENUM( MUTEX ) const MUTEX_TYPE mutex )
 			MUTEX_LOCK( mutex3 );
 			break;
 
+		case MUTEX_KEYPOOL:
+			MUTEX_LOCK( mutex4 );
+			break;
+
+		case MUTEX_DHTABLES:
+			MUTEX_LOCK( mutex5 );
+			break;
+
+		case MUTEX_OCSPSTAPLE:
+			MUTEX_LOCK( mutex9 );
+			break;
+
+		case MUTEX_CERTCACHE:
+			MUTEX_LOCK( mutex10 );
+			break;
+
 		default:
 			retIntError();
 		}
@@ -370,6 +419,18 @@ void krnlExitMutex( IN_ENUM( MUTEX ) const MUTEX_TYPE mutex )
 			MUTEX_UNLOCK( mutex1 );
 			break;
 
+		case MUTEX_SCOREBOARD1:
+			MUTEX_UNLOCK( mutex6 );
+			break;
+
+		case MUTEX_SCOREBOARD2:
+			MUTEX_UNLOCK( mutex7 );
+			break;
+
+		case MUTEX_SCOREBOARD3:
+			MUTEX_UNLOCK( mutex8 );
+			break;
+
 		case MUTEX_SOCKETPOOL:
 			MUTEX_UNLOCK( mutex2 );
 			break;
@@ -378,6 +439,22 @@ void krnlExitMutex( IN_ENUM( MUTEX ) const MUTEX_TYPE mutex )
 			MUTEX_UNLOCK( mutex3 );
 			break;
 
+		case MUTEX_KEYPOOL:
+			MUTEX_UNLOCK( mutex4 );
+			break;
+
+		case MUTEX_DHTABLES:
+			MUTEX_UNLOCK( mutex5 );
+			break;
+
+		case MUTEX_OCSPSTAPLE:
+			MUTEX_UNLOCK( mutex9 );
+			break;
+
+		case MUTEX_CERTCACHE:
+			MUTEX_UNLOCK( mutex10 );
+			break;
+
 		default:
 			retIntError_Void();
 		}
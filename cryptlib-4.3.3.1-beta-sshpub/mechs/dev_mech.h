@@ -55,6 +55,12 @@ int signSSL( STDC_UNUSED void *dummy,
 CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
 int sigcheckSSL( STDC_UNUSED void *dummy, 
 				 INOUT MECHANISM_SIGN_INFO *mechanismInfo );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+int signPSS( STDC_UNUSED void *dummy, 
+			 INOUT MECHANISM_SIGN_INFO *mechanismInfo );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+int sigcheckPSS( STDC_UNUSED void *dummy, 
+				 INOUT MECHANISM_SIGN_INFO *mechanismInfo );
 
 /* Public-key key wrap mechanisms */
 
@@ -73,6 +73,7 @@ typedef enum {
 	SIGNATURE_SSH,		/* SSHv2 sig.record */
 	SIGNATURE_SSL,		/* Raw signature data (no encapsulation) with dual hash */
 	SIGNATURE_TLS12,	/* As SSL but with PKCS #1 format */
+	SIGNATURE_TLS13,	/* As TLS 1.2 but with PSS format */
 	SIGNATURE_LAST		/* Last possible signature type */
 	} SIGNATURE_TYPE;
 
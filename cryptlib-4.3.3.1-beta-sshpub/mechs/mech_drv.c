@@ -98,6 +98,48 @@ static int prfInit( IN const HASH_FUNCTION hashFunction,
 	return( CRYPT_OK );
 	}
 
+/* Perform the start of the outer hash.  This is normally done as part of 
+   prfEnd(), but PRFs that are applied repeatedly with the same key can
+   perform it once and reuse the resulting hash state */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+static int prfInitOuter( IN const HASH_FUNCTION hashFunction, 
+						 OUT TYPECAST( HASHINFO ) void *hashState, 
+						 IN_BUFFER( processedKeyLength ) \
+							const void *processedKey, 
+						 IN_RANGE( 1, HMAC_DATASIZE ) \
+							const int processedKeyLength )
+	{
+	BYTE hashBuffer[ HMAC_DATASIZE + 8 ];
+	int i, LOOP_ITERATOR;
+
+	assert( isWritePtr( hashState, sizeof( HASHINFO ) ) );
+	assert( isReadPtrDynamic( processedKey, processedKeyLength ) );
+
+	REQUIRES( hashFunction != NULL );
+	REQUIRES( processedKeyLength >= 1 && \
+			  processedKeyLength <= HMAC_DATASIZE );
+
+	/* Perform the start of the outer hash using the zero-padded key XORed 
+	   with the opad value.  As with the init function this could be done 
+	   slightly more efficiently, but the following sequence of operations 
+	   minimises timing channels leaking the key length */
+	memcpy( hashBuffer, processedKey, processedKeyLength );
+	if( processedKeyLength < HMAC_DATASIZE )
+		{
+		memset( hashBuffer + processedKeyLength, 0, 
+				HMAC_DATASIZE - processedKeyLength );
+		}
+	LOOP_EXT( i = 0, i < HMAC_DATASIZE, i++, HMAC_DATASIZE + 1 )
+		hashBuffer[ i ] ^= HMAC_OPAD;
+	ENSURES( LOOP_BOUND_OK );
+	hashFunction( hashState, NULL, 0, hashBuffer, HMAC_DATASIZE, 
+				  HASH_STATE_START );
+	zeroise( hashBuffer, HMAC_DATASIZE );
+
+	return( CRYPT_OK );
+	}
+
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4, 6 ) ) \
 static int prfEnd( IN const HASH_FUNCTION hashFunction, 
 				   INOUT TYPECAST( HASHINFO ) void *hashState,
@@ -107,9 +149,8 @@ static int prfEnd( IN const HASH_FUNCTION hashFunction,
 				   IN_BUFFER( processedKeyLength ) const void *processedKey, 
 				   IN_RANGE( 1, HMAC_DATASIZE ) const int processedKeyLength )
 	{
-	BYTE hashBuffer[ HMAC_DATASIZE + 8 ];
 	BYTE digestBuffer[ CRYPT_MAX_HASHSIZE + 8 ];
-	int i, LOOP_ITERATOR;
+	int status;
 
 	assert( isWritePtr( hashState, sizeof( HASHINFO ) ) );
 	assert( isWritePtrDynamic( hash, hashMaxSize ) );
@@ -126,22 +167,14 @@ static int prfEnd( IN const HASH_FUNCTION hashFunction,
 				  HASH_STATE_END );
 
 	/* Perform the outer hash using the zero-padded key XORed with the opad
-	   value followed by the digest from the inner hash.  As with the init
-	   function this could be done slightly more efficiently, but the 
-	   following sequence of operations minimises timing channels leaking 
-	   the key length */
-	memcpy( hashBuffer, processedKey, processedKeyLength );
-	if( processedKeyLength < HMAC_DATASIZE )
+	   value followed by the digest from the inner hash */
+	status = prfInitOuter( hashFunction, hashState, processedKey, 
+						   processedKeyLength );
+	if( cryptStatusError( status ) )
 		{
-		memset( hashBuffer + processedKeyLength, 0, 
-				HMAC_DATASIZE - processedKeyLength );
+		zeroise( digestBuffer, CRYPT_MAX_HASHSIZE );
+		return( status );
 		}
-	LOOP_EXT( i = 0, i < HMAC_DATASIZE, i++, HMAC_DATASIZE + 1 )
-		hashBuffer[ i ] ^= HMAC_OPAD;
-	ENSURES( LOOP_BOUND_OK );
-	hashFunction( hashState, NULL, 0, hashBuffer, HMAC_DATASIZE, 
-				  HASH_STATE_START );
-	zeroise( hashBuffer, HMAC_DATASIZE );
 	hashFunction( hashState, hash, hashMaxSize, digestBuffer, hashSize, 
 				  HASH_STATE_END );
 	zeroise( digestBuffer, CRYPT_MAX_HASHSIZE );
@@ -149,95 +182,187 @@ static int prfEnd( IN const HASH_FUNCTION hashFunction,
 	return( CRYPT_OK );
 	}
 
+/* Complete the PRF using an outer hash state precomputed with 
+   prfInitOuter() */
+
+STDC_NONNULL_ARG( ( 1, 2, 3, 5 ) ) \
+static void prfEndOuter( IN const HASH_FUNCTION hashFunction, 
+						 INOUT TYPECAST( HASHINFO ) void *hashState,
+						 IN TYPECAST( HASHINFO ) const void *outerHashState,
+						 IN_LENGTH_HASH const int hashSize, 
+						 OUT_BUFFER_FIXED( hashMaxSize ) void *hash, 
+						 IN_LENGTH_HASH const int hashMaxSize )
+	{
+	BYTE digestBuffer[ CRYPT_MAX_HASHSIZE + 8 ];
+
+	assert( isWritePtr( hashState, sizeof( HASHINFO ) ) );
+	assert( isReadPtr( outerHashState, sizeof( HASHINFO ) ) );
+	assert( isWritePtrDynamic( hash, hashMaxSize ) );
+
+	/* Complete the inner hash and then continue the outer hash from the 
+	   precomputed state with the digest from the inner hash */
+	hashFunction( hashState, digestBuffer, CRYPT_MAX_HASHSIZE, NULL, 0, 
+				  HASH_STATE_END );
+	memcpy( hashState, outerHashState, sizeof( HASHINFO ) );
+	hashFunction( hashState, hash, hashMaxSize, digestBuffer, hashSize, 
+				  HASH_STATE_END );
+	zeroise( digestBuffer, CRYPT_MAX_HASHSIZE );
+	}
+
 /****************************************************************************
 *																			*
 *							PKCS #5v2 Key Derivation 						*
 *																			*
 ****************************************************************************/
 
-/* Implement one round of the PKCS #5v2 PRF */
+/* Run the PKCS #5v2 PRF iteration chain for a single output block, 
+   U_i = HMAC( U_i-1 ), output ^= U_i.  This is the generic version used 
+   when there's no HMAC-chain function available for the hash algorithm, 
+   which still saves one hash compression per iteration over a full HMAC
+   by reusing the precomputed outer hash state */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3, 4 ) ) \
+static int pbkdf2Chain( INOUT HMAC_CHAIN_INFO *hmacChainInfo, 
+						IN const HASH_FUNCTION hashFunction, 
+						IN TYPECAST( HASHINFO ) const void *innerHashState,
+						IN TYPECAST( HASHINFO ) const void *outerHashState,
+						IN_LENGTH_HASH const int hashSize, 
+						IN_INT const int iterations )
+	{
+	HASHINFO hashInfo;
+	BYTE *block = hmacChainInfo->value;
+	int i, LOOP_ITERATOR;
+
+	assert( isWritePtr( hmacChainInfo, sizeof( HMAC_CHAIN_INFO ) ) );
+	assert( isReadPtr( innerHashState, sizeof( HASHINFO ) ) );
+	assert( isReadPtr( outerHashState, sizeof( HASHINFO ) ) );
+
+	REQUIRES( hashFunction != NULL );
+	REQUIRES( hashSize >= 16 && hashSize <= CRYPT_MAX_HASHSIZE );
+	REQUIRES( iterations > 0 && iterations < MAX_INTLENGTH );
+
+	LOOP_MAX( i = 0, i < iterations, i++ )
+		{
+		int j, LOOP_ITERATOR_ALT;
+
+		/* Generate the PRF output for the current iteration */
+		memcpy( hashInfo, innerHashState, sizeof( HASHINFO ) );
+		hashFunction( hashInfo, NULL, 0, block, hashSize, HASH_STATE_CONTINUE );
+		prfEndOuter( hashFunction, hashInfo, outerHashState, hashSize, 
+					 block, CRYPT_MAX_HASHSIZE );
+
+		/* XOR the new PRF output into the existing PRF output */
+		LOOP_EXT_ALT( j = 0, j < hashSize, j++, CRYPT_MAX_HASHSIZE + 1 )
+			hmacChainInfo->output[ j ] ^= block[ j ];
+		ENSURES( LOOP_BOUND_OK_ALT );
+		}
+	ENSURES( LOOP_BOUND_OK );
+	zeroise( hashInfo, sizeof( HASHINFO ) );
+
+	return( CRYPT_OK );
+	}
+
+/* Implement the PKCS #5v2 PRF for a group of up to MAX_HMAC_CHAINS 
+   consecutive output blocks.  The blocks are independent of each other so 
+   if there's an HMAC-chain function available for the hash algorithm their
+   iteration chains are run together, which allows it to process them in 
+   parallel */
 
-CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 4, 6, 8 ) ) \
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 5, 6, 8 ) ) \
 static int pbkdf2Hash( OUT_BUFFER_FIXED( outLength ) BYTE *out, 
-					   IN_RANGE( 1, CRYPT_MAX_HASHSIZE ) const int outLength, 
+					   IN_RANGE( 1, MAX_HMAC_CHAINS * CRYPT_MAX_HASHSIZE ) \
+							const int outLength, 
 					   IN const HASH_FUNCTION hashFunction, 
-					   INOUT TYPECAST( HASHINFO ) void *initialHashState,
+					   IN_OPT const HASH_FUNCTION_HMACCHAIN hashFunctionHmacChain,
+					   IN TYPECAST( HASHINFO ) const void *innerHashState,
+					   IN TYPECAST( HASHINFO ) const void *outerHashState,
 					   IN_LENGTH_HASH const int hashSize, 
-					   IN_BUFFER( keyLength ) const void *key, 
-					   IN_RANGE( 1, HMAC_DATASIZE ) const int keyLength,
 					   IN_BUFFER( saltLength ) const void *salt, 
 					   IN_RANGE( 4, 512 ) const int saltLength,
 					   IN_INT const int iterations, 
 					   IN_RANGE( 1, 1000 ) const int blockCount )
 	{
+	HMAC_CHAIN_INFO hmacChainInfo[ MAX_HMAC_CHAINS ];
 	HASHINFO hashInfo;
-	BYTE block[ CRYPT_MAX_HASHSIZE + 8 ], countBuffer[ 4 + 8 ];
-	int i, status, LOOP_ITERATOR;
+	BYTE countBuffer[ 4 + 8 ];
+	const int noBlocks = ( outLength + hashSize - 1 ) / hashSize;
+	int outIndex, i, status = CRYPT_OK, LOOP_ITERATOR;
 
 	assert( isWritePtrDynamic( out, outLength ) );
-	assert( isWritePtr( initialHashState, sizeof( HASHINFO ) ) );
-	assert( isReadPtrDynamic( key, keyLength ) );
+	assert( isReadPtr( innerHashState, sizeof( HASHINFO ) ) );
+	assert( isReadPtr( outerHashState, sizeof( HASHINFO ) ) );
 	assert( isReadPtrDynamic( salt, saltLength ) );
 
 	REQUIRES( hashFunction != NULL );
-	REQUIRES( outLength > 0 && outLength <= hashSize && \
-			  outLength <= CRYPT_MAX_HASHSIZE );
 	REQUIRES( hashSize >= 16 && hashSize <= CRYPT_MAX_HASHSIZE );
-	REQUIRES( keyLength >= 1 && keyLength <= HMAC_DATASIZE );
+	REQUIRES( outLength > 0 && \
+			  outLength <= MAX_HMAC_CHAINS * hashSize );
+	REQUIRES( noBlocks >= 1 && noBlocks <= MAX_HMAC_CHAINS );
 	REQUIRES( saltLength >= 4 && saltLength <= 512 );
 	REQUIRES( iterations > 0 && iterations < MAX_INTLENGTH );
-	REQUIRES( blockCount > 0 && blockCount <= 1000 );
+	REQUIRES( blockCount > 0 && blockCount + noBlocks <= 1000 );
 
 	/* Clear return value */
 	memset( out, 0, outLength );
 
-	/* Set up the block counter buffer.  This will never have more than the
-	   last few bits set (8 bits = 5100 bytes of key) so we only change the
-	   last byte */
+	/* Calculate U_1 = HMAC( salt || counter ) for each block.  The block 
+	   counter will never have more than the last few bits set (8 bits = 
+	   5100 bytes of key) so we only change the last byte */
 	memset( countBuffer, 0, 4 );
-	countBuffer[ 3 ] = ( BYTE ) blockCount;
-
-	/* Calculate HMAC( salt || counter ) */
-	memcpy( hashInfo, initialHashState, sizeof( HASHINFO ) );
-	hashFunction( hashInfo, NULL, 0, salt, saltLength, HASH_STATE_CONTINUE );
-	hashFunction( hashInfo, NULL, 0, countBuffer, 4, HASH_STATE_CONTINUE );
-	status = prfEnd( hashFunction, hashInfo, hashSize, block, 
-					 CRYPT_MAX_HASHSIZE, key, keyLength );
-	if( cryptStatusError( status ) )
+	LOOP_SMALL( i = 0, i < noBlocks, i++ )
 		{
-		zeroise( hashInfo, sizeof( HASHINFO ) );
-		return( status );
+		HMAC_CHAIN_INFO *chainInfo = &hmacChainInfo[ i ];
+
+		countBuffer[ 3 ] = ( BYTE ) ( blockCount + i );
+		memcpy( hashInfo, innerHashState, sizeof( HASHINFO ) );
+		hashFunction( hashInfo, NULL, 0, salt, saltLength, 
+					  HASH_STATE_CONTINUE );
+		hashFunction( hashInfo, NULL, 0, countBuffer, 4, 
+					  HASH_STATE_CONTINUE );
+		prfEndOuter( hashFunction, hashInfo, outerHashState, hashSize, 
+					 chainInfo->value, CRYPT_MAX_HASHSIZE );
+		memcpy( chainInfo->output, chainInfo->value, hashSize );
 		}
-	memcpy( out, block, outLength );
+	ENSURES( LOOP_BOUND_OK );
+	zeroise( hashInfo, sizeof( HASHINFO ) );
 
-	/* Calculate HMAC( T1 ) ^ HMAC( T2 ) ^ ... HMAC( Tc ) */
-	LOOP_MAX( i = 0, i < iterations - 1, i++ )
+	/* Calculate U_1 ^ U_2 ^ ... ^ U_c for each block */
+	if( iterations > 1 )
 		{
-		int j, LOOP_ITERATOR_ALT;
-
-		/* Generate the PRF output for the current iteration */
-		memcpy( hashInfo, initialHashState, sizeof( HASHINFO ) );
-		hashFunction( hashInfo, NULL, 0, block, hashSize, HASH_STATE_CONTINUE );
-		status = prfEnd( hashFunction, hashInfo, hashSize, block, 
-						 CRYPT_MAX_HASHSIZE, key, keyLength );
-		if( cryptStatusError( status ) )
+		if( hashFunctionHmacChain != NULL )
 			{
-			zeroise( hashInfo, sizeof( HASHINFO ) );
-			zeroise( block, CRYPT_MAX_HASHSIZE );
-			return( status );
+			status = hashFunctionHmacChain( innerHashState, outerHashState, 
+											hmacChainInfo, noBlocks, 
+											iterations - 1 );
+			}
+		else
+			{
+			LOOP_SMALL( i = 0, i < noBlocks, i++ )
+				{
+				status = pbkdf2Chain( &hmacChainInfo[ i ], hashFunction, 
+									  innerHashState, outerHashState, 
+									  hashSize, iterations - 1 );
+				if( cryptStatusError( status ) )
+					break;
+				}
+			ENSURES( LOOP_BOUND_OK );
 			}
-
-		/* XOR the new PRF output into the existing PRF output */
-		LOOP_EXT_ALT( j = 0, j < outLength, j++, CRYPT_MAX_HASHSIZE + 1 )
-			out[ j ] ^= block[ j ];
-		ENSURES( LOOP_BOUND_OK_ALT );
 		}
-	ENSURES( LOOP_BOUND_OK );
 
-	zeroise( hashInfo, sizeof( HASHINFO ) );
-	zeroise( block, CRYPT_MAX_HASHSIZE );
+	/* Copy the PRF output for each block to the caller */
+	if( cryptStatusOK( status ) )
+		{
+		LOOP_SMALL( ( i = 0, outIndex = 0 ), i < noBlocks, 
+					( i++, outIndex += hashSize ) )
+			{
+			memcpy( out + outIndex, hmacChainInfo[ i ].output, 
+					min( hashSize, outLength - outIndex ) );
+			}
+		ENSURES( LOOP_BOUND_OK );
+		}
+	zeroise( hmacChainInfo, sizeof( HMAC_CHAIN_INFO ) * MAX_HMAC_CHAINS );
 
-	return( CRYPT_OK );
+	return( status );
 	}
 
 /* Perform PKCS #5v2 derivation */
@@ -248,8 +373,9 @@ int derivePKCS5( STDC_UNUSED void *dummy,
 	{
 	CRYPT_ALGO_TYPE hashAlgo;
 	HASH_FUNCTION_ATOMIC hashFunctionAtomic;
+	HASH_FUNCTION_HMACCHAIN hashFunctionHmacChain;
 	HASH_FUNCTION hashFunction;
-	HASHINFO initialHashInfo;
+	HASHINFO initialHashInfo, outerHashInfo;
 	BYTE processedKey[ HMAC_DATASIZE + 8 ];
 	BYTE *dataOutPtr = mechanismInfo->dataOut;
 	static const MAP_TABLE mapTbl[] = {
@@ -258,7 +384,7 @@ int derivePKCS5( STDC_UNUSED void *dummy,
 		{ CRYPT_ALGO_HMAC_SHAng, CRYPT_ALGO_SHAng },
 		{ CRYPT_ERROR, CRYPT_ERROR }, { CRYPT_ERROR, CRYPT_ERROR }
 		};
-	int hashSize, keyIndex, processedKeyLength, blockCount = 1;
+	int hashSize, groupSize, keyIndex, processedKeyLength, blockCount = 1;
 	int value, status, LOOP_ITERATOR;
 
 	UNUSED_ARG( dummy );
@@ -280,38 +406,52 @@ int derivePKCS5( STDC_UNUSED void *dummy,
 	/* Initialise the HMAC information with the user key.  Although the user
 	   has specified the algorithm in terms of an HMAC we're synthesising it 
 	   from the underlying hash algorithm since this allows us to perform the
-	   PRF setup once and reuse the initial value for any future hashing */
+	   PRF setup once and reuse the initial inner and outer hash states for 
+	   all further hashing */
 	getHashAtomicParameters( hashAlgo, mechanismInfo->hashParam, 
 							 &hashFunctionAtomic, &hashSize );
 	getHashParameters( hashAlgo, mechanismInfo->hashParam, &hashFunction, 
 					   NULL );
+	getHashHmacChainParameters( hashAlgo, mechanismInfo->hashParam, 
+								&hashFunctionHmacChain );
 	status = prfInit( hashFunction, hashFunctionAtomic, initialHashInfo, 
 					  hashSize, processedKey, HMAC_DATASIZE, 
 					  &processedKeyLength, mechanismInfo->dataIn, 
 					  mechanismInfo->dataInLength );
+	if( cryptStatusOK( status ) )
+		{
+		status = prfInitOuter( hashFunction, outerHashInfo, processedKey, 
+							   processedKeyLength );
+		}
+	zeroise( processedKey, HMAC_DATASIZE );
 	if( cryptStatusError( status ) )
+		{
+		zeroise( initialHashInfo, sizeof( HASHINFO ) );
 		return( status );
+		}
 
 	/* Produce enough blocks of output to fill the key (nil sine magno 
-	   labore) */
+	   labore), processing up to MAX_HMAC_CHAINS blocks at a time */
+	groupSize = hashSize * MAX_HMAC_CHAINS;
 	LOOP_MED( keyIndex = 0, keyIndex < mechanismInfo->dataOutLength,
-			  ( keyIndex += hashSize, dataOutPtr += hashSize ) )
+			  ( keyIndex += groupSize, dataOutPtr += groupSize, 
+				blockCount += MAX_HMAC_CHAINS ) )
 		{
 		const int noKeyBytes = \
-			( mechanismInfo->dataOutLength - keyIndex > hashSize ) ? \
-			hashSize : mechanismInfo->dataOutLength - keyIndex;
+			( mechanismInfo->dataOutLength - keyIndex > groupSize ) ? \
+			groupSize : mechanismInfo->dataOutLength - keyIndex;
 
-		status = pbkdf2Hash( dataOutPtr, noKeyBytes, 
-							 hashFunction, initialHashInfo, hashSize,
-							 processedKey, processedKeyLength,
+		status = pbkdf2Hash( dataOutPtr, noKeyBytes, hashFunction, 
+							 hashFunctionHmacChain, initialHashInfo, 
+							 outerHashInfo, hashSize, 
 							 mechanismInfo->salt, mechanismInfo->saltLength,
-							 mechanismInfo->iterations, blockCount++ );
+							 mechanismInfo->iterations, blockCount );
 		if( cryptStatusError( status ) )
 			break;
 		}
 	ENSURES( LOOP_BOUND_OK );
 	zeroise( initialHashInfo, sizeof( HASHINFO ) );
-	zeroise( processedKey, HMAC_DATASIZE );
+	zeroise( outerHashInfo, sizeof( HASHINFO ) );
 	if( cryptStatusError( status ) )
 		{
 		zeroise( mechanismInfo->dataOut, mechanismInfo->dataOutLength );
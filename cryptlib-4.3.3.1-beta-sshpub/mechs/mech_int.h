@@ -34,6 +34,15 @@ CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
 int getHashAlgoParams( IN_HANDLE const CRYPT_CONTEXT hashContext,
 					   OUT_ALGO_Z CRYPT_ALGO_TYPE *hashAlgo, 
 					   OUT_OPT_LENGTH_HASH_Z int *hashSize );
+#if defined( USE_OAEP ) || defined( USE_SSL )
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3 ) ) \
+int mgf1( OUT_BUFFER_FIXED( maskLen ) void *mask, 
+		  IN_LENGTH_PKC const int maskLen, 
+		  IN_BUFFER( seedLen ) const void *seed, 
+		  IN_LENGTH_PKC const int seedLen,
+		  IN_ALGO const CRYPT_ALGO_TYPE hashAlgo,
+		  IN_INT_SHORT_Z const int hashParam );
+#endif /* USE_OAEP || USE_SSL */
 
 /* Prototypes for kernel-internal access functions.  This is a bit of an odd 
    place to have them but we need to have a prototype visible to both the
@@ -990,59 +990,6 @@ static int getOaepHash( OUT_BUFFER_OPT( lHashMaxLen, *lHashLen ) \
 #define getOaepHashSize( hashLen, hashAlgo, hashParam ) \
 		getOaepHash( NULL, 0, hashLen, hashAlgo, hashParam )
 
-/* OAEP mask generation function MGF1 */
-
-CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3 ) ) \
-static int mgf1( OUT_BUFFER_FIXED( maskLen ) void *mask, 
-				 IN_LENGTH_PKC const int maskLen, 
-				 IN_BUFFER( seedLen ) const void *seed, 
-				 IN_LENGTH_PKC const int seedLen,
-				 IN_ALGO const CRYPT_ALGO_TYPE hashAlgo,
-				 IN_INT_SHORT_Z const int hashParam )
-	{
-	HASH_FUNCTION hashFunction;
-	HASHINFO hashInfo;
-	BYTE countBuffer[ 4 + 8 ], maskBuffer[ CRYPT_MAX_HASHSIZE + 8 ];
-	BYTE *maskOutPtr = mask;
-	int hashSize, maskIndex, blockCount = 0, LOOP_ITERATOR;
-
-	assert( isWritePtrDynamic( mask, maskLen ) );
-	assert( isReadPtrDynamic( seed, seedLen ) );
-
-	REQUIRES( maskLen >= 20 && maskLen <= CRYPT_MAX_PKCSIZE );
-	REQUIRES( seedLen >= 20 && seedLen <= CRYPT_MAX_PKCSIZE );
-	REQUIRES( isHashAlgo( hashAlgo ) );
-	REQUIRES( hashParam >= 0 && hashParam < MAX_INTLENGTH_SHORT );
-
-	getHashParameters( hashAlgo, hashParam, &hashFunction, &hashSize );
-
-	/* Set up the block counter buffer.  This will never have more than the
-	   last few bits set (8 bits = 5120 bytes of mask for the smallest hash,
-	   SHA-1) so we only change the last byte */
-	memset( countBuffer, 0, 4 );
-
-	/* Produce enough blocks of output to fill the mask */
-	LOOP_MED( maskIndex = 0, maskIndex < maskLen, 
-			  ( maskIndex += hashSize, maskOutPtr += hashSize ) )
-		{
-		const int noMaskBytes = ( maskLen - maskIndex > hashSize ) ? \
-								hashSize : maskLen - maskIndex;
-
-		/* Calculate hash( seed || counter ) */
-		countBuffer[ 3 ] = ( BYTE ) blockCount++;
-		hashFunction( hashInfo, NULL, 0, seed, seedLen, HASH_STATE_START );
-		hashFunction( hashInfo, maskBuffer, hashSize, countBuffer, 4, 
-					  HASH_STATE_END );
-		REQUIRES( rangeCheckZ( maskIndex, noMaskBytes, maskLen ) );
-		memcpy( maskOutPtr, maskBuffer, noMaskBytes );
-		}
-	ENSURES( LOOP_BOUND_OK );
-	zeroise( hashInfo, sizeof( HASHINFO ) );
-	zeroise( maskBuffer, CRYPT_MAX_HASHSIZE );
-
-	return( CRYPT_OK );
-	}
-
 /* Generate/recover an OAEP data block:
 
 							 +----------+---------+-------+
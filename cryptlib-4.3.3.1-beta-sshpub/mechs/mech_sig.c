@@ -349,6 +349,162 @@ static int checkRecoveredSignature( IN_HANDLE const CRYPT_CONTEXT iSignContext,
 	return( status );
 	}
 
+#ifdef USE_SSL
+
+/* Encode/decode PSS signature formatting.  We always use MGF1 with the 
+   same hash as the message hash and a salt of the same size as the hash,
+   which is what TLS 1.3 mandates.  The encoded message length is taken to 
+   be the full size of the modulus with the top bit cleared, which is 
+   correct for the byte-aligned moduli that are universally used with RSA:
+
+	M' = [ 00 00 00 00 00 00 00 00 ][ mHash ][ salt ]
+	H = hash( M' )
+	DB = [ 00 padding ][ 01 ][ salt ]
+	EM = [ DB ^ MGF1( H ) ][ H ][ BC ] */
+
+#define PSS_PREFIX_SIZE		8
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 5, 6 ) ) \
+static int pssHash( OUT_BUFFER_FIXED( hashSize ) BYTE *hashValue, 
+					IN_ALGO const CRYPT_ALGO_TYPE hashAlgo,
+					IN_BUFFER( hashSize ) const BYTE *mHash, 
+					IN_LENGTH_HASH const int hashSize,
+					IN_BUFFER( hashSize ) const BYTE *salt,
+					OUT_LENGTH_HASH_Z int *hValueSize )
+	{
+	static const BYTE prefix[ PSS_PREFIX_SIZE + 8 ] = { 0 };
+	HASH_FUNCTION hashFunction;
+	HASHINFO hashInfo;
+
+	assert( isWritePtrDynamic( hashValue, hashSize ) );
+	assert( isReadPtrDynamic( mHash, hashSize ) );
+	assert( isReadPtrDynamic( salt, hashSize ) );
+
+	REQUIRES( isHashAlgo( hashAlgo ) );
+	REQUIRES( hashSize >= 20 && hashSize <= CRYPT_MAX_HASHSIZE );
+
+	getHashParameters( hashAlgo, hashSize, &hashFunction, hValueSize );
+	REQUIRES( *hValueSize == hashSize );
+	hashFunction( hashInfo, NULL, 0, prefix, PSS_PREFIX_SIZE, 
+				  HASH_STATE_START );
+	hashFunction( hashInfo, NULL, 0, mHash, hashSize, HASH_STATE_CONTINUE );
+	hashFunction( hashInfo, hashValue, hashSize, salt, hashSize, 
+				  HASH_STATE_END );
+	zeroise( hashInfo, sizeof( HASHINFO ) );
+
+	return( CRYPT_OK );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 4 ) ) \
+static int encodePSS( OUT_BUFFER_FIXED( length ) BYTE *data, 
+					  IN_LENGTH_PKC const int length,
+					  IN_ALGO const CRYPT_ALGO_TYPE hashAlgo,
+					  IN_BUFFER( hashSize ) const BYTE *mHash, 
+					  IN_LENGTH_HASH const int hashSize )
+	{
+	MESSAGE_DATA msgData;
+	BYTE salt[ CRYPT_MAX_HASHSIZE + 8 ], dbMask[ CRYPT_MAX_PKCSIZE + 8 ];
+	const int dbLen = length - ( hashSize + 1 );
+	int hValueSize, i, status, LOOP_ITERATOR;
+
+	assert( isWritePtrDynamic( data, length ) );
+	assert( isReadPtrDynamic( mHash, hashSize ) );
+
+	REQUIRES( length >= MIN_PKCSIZE && length <= CRYPT_MAX_PKCSIZE );
+	REQUIRES( isHashAlgo( hashAlgo ) );
+	REQUIRES( hashSize >= 20 && hashSize <= CRYPT_MAX_HASHSIZE );
+	REQUIRES( dbLen > hashSize + 1 && dbLen < length );
+
+	/* Generate the salt and calculate H = hash( M' ) */
+	setMessageData( &msgData, salt, hashSize );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_GETATTRIBUTE_S, 
+							  &msgData, CRYPT_IATTRIBUTE_RANDOM_NONCE );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = pssHash( data + dbLen, hashAlgo, mHash, hashSize, salt, 
+					  &hValueSize );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* DB = [ 00 padding ][ 01 ][ salt ], EM = [ DB ^ MGF1( H ) ][ H ][ BC ] */
+	memset( data, 0, dbLen - ( hashSize + 1 ) );
+	data[ dbLen - ( hashSize + 1 ) ] = 0x01;
+	memcpy( data + dbLen - hashSize, salt, hashSize );
+	status = mgf1( dbMask, dbLen, data + dbLen, hashSize, hashAlgo, 
+				   hashSize );
+	if( cryptStatusError( status ) )
+		{
+		zeroise( salt, CRYPT_MAX_HASHSIZE );
+		return( status );
+		}
+	LOOP_EXT( i = 0, i < dbLen, i++, CRYPT_MAX_PKCSIZE + 1 )
+		data[ i ] ^= dbMask[ i ];
+	ENSURES( LOOP_BOUND_OK );
+	data[ 0 ] &= 0x7F;
+	data[ length - 1 ] = 0xBC;
+	zeroise( salt, CRYPT_MAX_HASHSIZE );
+	zeroise( dbMask, CRYPT_MAX_PKCSIZE );
+
+	return( CRYPT_OK );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 4 ) ) \
+static int decodePSS( INOUT_BUFFER_FIXED( length ) BYTE *data, 
+					  IN_LENGTH_PKC const int length,
+					  IN_ALGO const CRYPT_ALGO_TYPE hashAlgo,
+					  IN_BUFFER( hashSize ) const BYTE *mHash, 
+					  IN_LENGTH_HASH const int hashSize )
+	{
+	BYTE dbMask[ CRYPT_MAX_PKCSIZE + 8 ], hValue[ CRYPT_MAX_HASHSIZE + 8 ];
+	const int dbLen = length - ( hashSize + 1 );
+	const int padLen = dbLen - ( hashSize + 1 );
+	int hValueSize, i, status, LOOP_ITERATOR;
+
+	assert( isWritePtrDynamic( data, length ) );
+	assert( isReadPtrDynamic( mHash, hashSize ) );
+
+	REQUIRES( length >= MIN_PKCSIZE && length <= CRYPT_MAX_PKCSIZE );
+	REQUIRES( isHashAlgo( hashAlgo ) );
+	REQUIRES( hashSize >= 20 && hashSize <= CRYPT_MAX_HASHSIZE );
+	REQUIRES( dbLen > hashSize + 1 && dbLen < length );
+
+	/* Check the fixed-format portions of EM and recover DB */
+	if( data[ length - 1 ] != 0xBC || ( data[ 0 ] & 0x80 ) )
+		return( CRYPT_ERROR_BADDATA );
+	status = mgf1( dbMask, dbLen, data + dbLen, hashSize, hashAlgo, 
+				   hashSize );
+	if( cryptStatusError( status ) )
+		return( status );
+	LOOP_EXT( i = 0, i < dbLen, i++, CRYPT_MAX_PKCSIZE + 1 )
+		data[ i ] ^= dbMask[ i ];
+	ENSURES( LOOP_BOUND_OK );
+	data[ 0 ] &= 0x7F;
+	zeroise( dbMask, CRYPT_MAX_PKCSIZE );
+
+	/* Make sure that DB = [ 00 padding ][ 01 ][ salt ] */
+	LOOP_EXT( i = 0, i < padLen, i++, CRYPT_MAX_PKCSIZE + 1 )
+		{
+		if( data[ i ] != 0 )
+			return( CRYPT_ERROR_BADDATA );
+		}
+	ENSURES( LOOP_BOUND_OK );
+	if( data[ padLen ] != 0x01 )
+		return( CRYPT_ERROR_BADDATA );
+
+	/* Recalculate H from the recovered salt and compare it to the H in the
+	   signature */
+	status = pssHash( hValue, hashAlgo, mHash, hashSize, 
+					  data + padLen + 1, &hValueSize );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( !compareDataConstTime( hValue, data + dbLen, hashSize ) )
+		status = CRYPT_ERROR_SIGNATURE;
+	zeroise( hValue, CRYPT_MAX_HASHSIZE );
+
+	return( status );
+	}
+#endif /* USE_SSL */
+
 /****************************************************************************
 *																			*
 *								Signature Mechanisms 						*
@@ -358,9 +514,10 @@ static int checkRecoveredSignature( IN_HANDLE const CRYPT_CONTEXT iSignContext,
 /* Perform signing.  There are several variations of this that are handled 
    through common signature mechanism functions */
 
-typedef enum { SIGN_NONE, SIGN_PKCS1, SIGN_SSL, SIGN_LAST } SIGN_TYPE;
+typedef enum { SIGN_NONE, SIGN_PKCS1, SIGN_SSL, SIGN_PSS, 
+			   SIGN_LAST } SIGN_TYPE;
 
-/* Perform PKCS #1 signing/sig.checking */
+/* Perform PKCS #1/PSS signing/sig.checking */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
 static int sign( INOUT MECHANISM_SIGN_INFO *mechanismInfo, 
@@ -469,6 +626,18 @@ static int sign( INOUT MECHANISM_SIGN_INFO *mechanismInfo,
 			status = swrite( &stream, hash2, hashSize2 );
 			break;
 
+#ifdef USE_SSL
+		case SIGN_PSS:
+			/* Encode the payload using the PSS format, see the comment for
+			   encodePSS() for details */
+			status = encodePSS( preSigData, length, hashAlgo, hash, 
+								hashSize );
+			if( cryptStatusOK( status ) )
+				status = swrite( &stream, preSigData, length );
+			zeroise( preSigData, CRYPT_MAX_PKCSIZE );
+			break;
+#endif /* USE_SSL */
+
 		default:
 			retIntError();
 		}
@@ -612,6 +781,17 @@ static int sigcheck( INOUT MECHANISM_SIGN_INFO *mechanismInfo,
 			break;
 			}
 
+#ifdef USE_SSL
+		case SIGN_PSS:
+			/* The payload is a PSS-encoded hash, which is checked in-place 
+			   rather than being read from the stream */
+			status = decodePSS( decryptedSignature, length, 
+								contextHashAlgo, hash, hashSize );
+			if( cryptStatusOK( status ) )
+				status = sSkip( &stream, length, MAX_INTLENGTH_SHORT );
+			break;
+#endif /* USE_SSL */
+
 		default:
 			retIntError();
 		}
@@ -674,4 +854,26 @@ int sigcheckSSL( STDC_UNUSED void *dummy,
 
 	return( sigcheck( mechanismInfo, SIGN_SSL ) );
 	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+int signPSS( STDC_UNUSED void *dummy, 
+			 INOUT MECHANISM_SIGN_INFO *mechanismInfo )
+	{
+	UNUSED_ARG( dummy );
+
+	assert( isWritePtr( mechanismInfo, sizeof( MECHANISM_SIGN_INFO ) ) );
+
+	return( sign( mechanismInfo, SIGN_PSS ) );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+int sigcheckPSS( STDC_UNUSED void *dummy, 
+				 INOUT MECHANISM_SIGN_INFO *mechanismInfo )
+	{
+	UNUSED_ARG( dummy );
+
+	assert( isWritePtr( mechanismInfo, sizeof( MECHANISM_SIGN_INFO ) ) );
+
+	return( sigcheck( mechanismInfo, SIGN_PSS ) );
+	}
 #endif /* USE_SSL */
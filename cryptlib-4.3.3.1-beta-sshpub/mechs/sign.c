@@ -456,7 +456,8 @@ int iCryptCreateSignature( OUT_BUFFER_OPT( signatureMaxLength, *signatureLength
 	REQUIRES( isHandleRangeValid( iHashContext ) );
 	REQUIRES( ( ( formatType == CRYPT_FORMAT_CRYPTLIB || \
 				  formatType == CRYPT_IFORMAT_SSH || \
-				  formatType == CRYPT_IFORMAT_TLS12 ) && \
+				  formatType == CRYPT_IFORMAT_TLS12 || \
+				  formatType == CRYPT_IFORMAT_TLS13 ) && \
 				sigParams == NULL ) || 
 			  ( ( formatType == CRYPT_FORMAT_CMS || \
 				  formatType == CRYPT_FORMAT_SMIME || \
@@ -586,6 +587,15 @@ int iCryptCreateSignature( OUT_BUFFER_OPT( signatureMaxLength, *signatureLength
 									  iHashContext, CRYPT_UNUSED,
 									  SIGNATURE_TLS12 );
 			break;
+
+		case CRYPT_IFORMAT_TLS13:
+			REQUIRES( sigParams == NULL );
+
+			status = createSignature( signature, signatureMaxLength, 
+									  signatureLength, iSignContext,
+									  iHashContext, CRYPT_UNUSED,
+									  SIGNATURE_TLS13 );
+			break;
 #endif /* USE_SSL */
 
 #ifdef USE_SSH
@@ -646,11 +656,13 @@ int iCryptCheckSignature( IN_BUFFER( signatureLength ) const void *signature,
 				isHandleRangeValid( iHash2Context ) && extraData == NULL ) || \
 			  ( ( formatType == CRYPT_FORMAT_CMS || \
 				  formatType == CRYPT_FORMAT_SMIME || \
-				  formatType == CRYPT_IFORMAT_TLS12 ) && \
+				  formatType == CRYPT_IFORMAT_TLS12 || \
+				  formatType == CRYPT_IFORMAT_TLS13 ) && \
 				iHash2Context == CRYPT_UNUSED ) || \
 			  ( ( formatType == CRYPT_FORMAT_CRYPTLIB || \
 				  formatType == CRYPT_FORMAT_PGP || \
 				  formatType == CRYPT_IFORMAT_TLS12 || \
+				  formatType == CRYPT_IFORMAT_TLS13 || \
 				  formatType == CRYPT_IFORMAT_SSH ) && \
 				iHash2Context == CRYPT_UNUSED && extraData == NULL ) );
 
@@ -708,6 +720,12 @@ int iCryptCheckSignature( IN_BUFFER( signatureLength ) const void *signature,
 									 sigCheckContext, iHashContext,
 									 CRYPT_UNUSED, SIGNATURE_TLS12 );
 			break;
+
+		case CRYPT_IFORMAT_TLS13:
+			status = checkSignature( signature, signatureLength,
+									 sigCheckContext, iHashContext,
+									 CRYPT_UNUSED, SIGNATURE_TLS13 );
+			break;
 #endif /* USE_SSL */
 
 #ifdef USE_SSH
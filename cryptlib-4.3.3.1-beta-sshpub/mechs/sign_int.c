@@ -244,6 +244,7 @@ int createSignature( OUT_BUFFER_OPT( sigMaxLength, *signatureLength ) \
 				  signatureType == SIGNATURE_RAW || \
 				  signatureType == SIGNATURE_SSH || \
 				  signatureType == SIGNATURE_TLS12 || \
+				  signatureType == SIGNATURE_TLS13 || \
 				  signatureType == SIGNATURE_X509 ) && \
 				iHashContext2 == CRYPT_UNUSED ) );
 
@@ -269,18 +270,30 @@ int createSignature( OUT_BUFFER_OPT( sigMaxLength, *signatureLength ) \
 	if( cryptStatusError( status ) )
 		return( cryptArgError( status ) ? CRYPT_ARGERROR_NUM2 : status );
 
+	/* Ed25519 signs the message itself rather than a hash of it, which 
+	   means that the hash value that we're given is treated as the message.
+	   The only format in which this is the expected behaviour is SSH, where 
+	   the message is the exchange hash or authentication data hash, so we 
+	   don't allow it for anything else */
+	if( signAlgo == CRYPT_ALGO_ED25519 && signatureType != SIGNATURE_SSH )
+		return( CRYPT_ERROR_NOTAVAIL );
+
 	/* DLP and ECDLP signatures are handled somewhat specially */
 	INJECT_FAULT( MECH_CORRUPT_HASH, MECH_CORRUPT_HASH_1 );
-	if( isDlpAlgo( signAlgo ) || isEccAlgo( signAlgo ) )
+	if( isDlpAlgo( signAlgo ) || isEccAlgo( signAlgo ) || \
+		signAlgo == CRYPT_ALGO_ED25519 )
 		{
 		/* In addition to the special-case processing for DLP/ECDLP 
 		   signatures, we have to provide even further special handling for 
 		   SSL signatures, which normally sign a dual hash of MD5 and SHA-1 
-		   but for DLP only sign the second SHA-1 hash */
+		   but for DLP only sign the second SHA-1 hash.  Ed25519 signatures
+		   are sized as for ECDLP ones, two values of the key size */
 		status = createDlpSignature( bufPtr, bufSize, &length, iSignContext, 
 									 isSSLsig ? iHashContext2 : iHashContext, 
 									 signatureType, 
-									 isEccAlgo( signAlgo ) ? TRUE : FALSE );
+									 ( isEccAlgo( signAlgo ) || \
+									   signAlgo == CRYPT_ALGO_ED25519 ) ? \
+										TRUE : FALSE );
 		}
 	else
 		{
@@ -291,6 +304,8 @@ int createSignature( OUT_BUFFER_OPT( sigMaxLength, *signatureLength ) \
 							  iHashContext2, iSignContext );
 		status = krnlSendMessage( iSignContext, IMESSAGE_DEV_SIGN, &mechanismInfo,
 								  isSSLsig ? MECHANISM_SIG_SSL : \
+								  ( signatureType == SIGNATURE_TLS13 ) ? \
+											 MECHANISM_SIG_PSS : \
 											 MECHANISM_SIG_PKCS1 );
 		if( cryptStatusOK( status ) )
 			length = mechanismInfo.signatureLength;
@@ -370,6 +385,7 @@ int checkSignature( IN_BUFFER( signatureLength ) const void *signature,
 				  signatureType == SIGNATURE_RAW || \
 				  signatureType == SIGNATURE_SSH || \
 				  signatureType == SIGNATURE_TLS12 || \
+				  signatureType == SIGNATURE_TLS13 || \
 				  signatureType == SIGNATURE_X509 ) && \
 				iHashContext2 == CRYPT_UNUSED ) );
 
@@ -403,8 +419,11 @@ int checkSignature( IN_BUFFER( signatureLength ) const void *signature,
 	/* Make sure that we've been given the correct algorithms */
 	if( signatureType != SIGNATURE_RAW && signatureType != SIGNATURE_SSL )
 		{
+		/* Ed25519 has no associated hash algorithm (see the comment in 
+		   createSignature()) so there's no hash algorithm to check */
 		if( signAlgo != queryInfo.cryptAlgo || \
-			hashAlgo != queryInfo.hashAlgo )
+			( signAlgo != CRYPT_ALGO_ED25519 && \
+			  hashAlgo != queryInfo.hashAlgo ) )
 			status = CRYPT_ERROR_SIGNATURE;
 		if( signatureType != SIGNATURE_SSH )
 			{
@@ -482,7 +501,8 @@ int checkSignature( IN_BUFFER( signatureLength ) const void *signature,
 	zeroise( &queryInfo, sizeof( QUERY_INFO ) );
 
 	/* DLP and ECDLP signatures are handled somewhat specially */
-	if( isDlpAlgo( signAlgo ) || isEccAlgo( signAlgo ) )
+	if( isDlpAlgo( signAlgo ) || isEccAlgo( signAlgo ) || \
+		signAlgo == CRYPT_ALGO_ED25519 )
 		{
 		/* In addition to the special-case processing for DLP/ECDLP 
 		   signatures, we have to provide even further special handling for 
@@ -499,6 +519,8 @@ int checkSignature( IN_BUFFER( signatureLength ) const void *signature,
 						  iHashContext, iHashContext2, iSigCheckContext );
 	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_DEV_SIGCHECK, 
 							  &mechanismInfo, isSSLsig ? MECHANISM_SIG_SSL : \
+							  ( signatureType == SIGNATURE_TLS13 ) ? \
+														 MECHANISM_SIG_PSS : \
 														 MECHANISM_SIG_PKCS1 );
 	clearMechanismInfo( &mechanismInfo );
 	if( cryptStatusError( status ) )
@@ -952,6 +952,14 @@ static int readSshSignature( INOUT STREAM *stream,
 			}
 		else
 			{
+#ifdef USE_ED25519
+			/* Ed25519 signs the exchange hash directly so there's no hash 
+			   algorithm associated with it */
+			if( length == 11 && !memcmp( buffer, "ssh-ed25519", 11 ) )
+				queryInfo->cryptAlgo = CRYPT_ALGO_ED25519;
+			else
+#endif /* USE_ED25519 */
+			{
 			/* It's probably an ECC signature algorithm.  We don't bother 
 			   checking the exact type since this is implicitly specified by 
 			   the signature-check key */
@@ -962,6 +970,7 @@ static int readSshSignature( INOUT STREAM *stream,
 			queryInfo->cryptAlgo = CRYPT_ALGO_ECDSA;
 			queryInfo->hashAlgo = CRYPT_ALGO_SHA2;
 			}
+			}
 		}
 
 	/* Read the start of the signature */
@@ -986,6 +995,13 @@ static int readSshSignature( INOUT STREAM *stream,
 				return( CRYPT_ERROR_BADDATA );
 			break;
 
+#ifdef USE_ED25519
+		case CRYPT_ALGO_ED25519:
+			if( length != ED25519_SIGNATURE_SIZE )
+				return( CRYPT_ERROR_BADDATA );
+			break;
+#endif /* USE_ED25519 */
+
 		default:
 			retIntError();
 		}
@@ -1015,10 +1031,24 @@ static int writeSshSignature( INOUT STREAM *stream,
 
 	REQUIRES( hashAlgo == CRYPT_ALGO_SHA1 || hashAlgo == CRYPT_ALGO_SHA2 );
 	REQUIRES( signAlgo == CRYPT_ALGO_RSA || signAlgo == CRYPT_ALGO_DSA || \
-			  signAlgo == CRYPT_ALGO_ECDSA );
+			  signAlgo == CRYPT_ALGO_ECDSA || \
+			  signAlgo == CRYPT_ALGO_ED25519 );
 	REQUIRES( signatureLength >= ( 20 + 20 ) && \
 			  signatureLength < MAX_INTLENGTH_SHORT );
 
+#ifdef USE_ED25519
+	/* Ed25519 signatures are a fixed-format blob with no parameters */
+	if( signAlgo == CRYPT_ALGO_ED25519 )
+		{
+		REQUIRES( signatureLength == ED25519_SIGNATURE_SIZE );
+
+		writeUint32( stream, sizeofString32( 11 ) + \
+							 sizeofString32( signatureLength ) );
+		writeString32( stream, "ssh-ed25519", 11 );
+		return( writeString32( stream, signature, signatureLength ) );
+		}
+#endif /* USE_ED25519 */
+
 #ifdef USE_ECDSA
 	/* ECC signatures require all sorts of calisthenics that aren't 
 	   necessary for standard signatures, specifically we have to encode the
@@ -1278,6 +1308,113 @@ static int writeTls12Signature( INOUT STREAM *stream,
 	writeUint16( stream, signatureLength );
 	return( swrite( stream, signature, signatureLength ) );
 	}
+
+/* Read/write TLS 1.3 signatures, which replace TLS 1.2's hash and signature 
+   algorithm bytes with a single 16-bit signature scheme identifier and use 
+   PSS instead of PKCS #1 formatting for RSA */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int readTls13Signature( INOUT STREAM *stream, 
+							   OUT QUERY_INFO *queryInfo )
+	{
+	const int startPos = stell( stream );
+	int sigScheme, length, status;
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isWritePtr( queryInfo, sizeof( QUERY_INFO ) ) );
+
+	REQUIRES( startPos >= 0 && startPos < MAX_BUFFER_SIZE );
+
+	/* Clear return value */
+	memset( queryInfo, 0, sizeof( QUERY_INFO ) );
+
+	/* Read the signature scheme */
+	status = sigScheme = readUint16( stream );
+	if( cryptStatusError( status ) )
+		return( status );
+	switch( sigScheme )
+		{
+		case /* TLS_SIGSCHEME_RSA_PSS_RSAE_SHA256 */ 0x0804:
+			queryInfo->cryptAlgo = CRYPT_ALGO_RSA;
+			queryInfo->hashAlgoParam = bitsToBytes( 256 );
+			break;
+
+		case /* TLS_SIGSCHEME_ECDSA_SECP256R1_SHA256 */ 0x0403:
+			queryInfo->cryptAlgo = CRYPT_ALGO_ECDSA;
+			queryInfo->hashAlgoParam = bitsToBytes( 256 );
+			break;
+
+#ifdef USE_SHA2_EXT
+		case /* TLS_SIGSCHEME_RSA_PSS_RSAE_SHA384 */ 0x0805:
+			queryInfo->cryptAlgo = CRYPT_ALGO_RSA;
+			queryInfo->hashAlgoParam = bitsToBytes( 384 );
+			break;
+
+		case /* TLS_SIGSCHEME_ECDSA_SECP384R1_SHA384 */ 0x0503:
+			queryInfo->cryptAlgo = CRYPT_ALGO_ECDSA;
+			queryInfo->hashAlgoParam = bitsToBytes( 384 );
+			break;
+#endif /* USE_SHA2_EXT */
+
+		default:
+			return( CRYPT_ERROR_BADDATA );
+		}
+	queryInfo->hashAlgo = CRYPT_ALGO_SHA2;
+
+	/* Read the start of the signature */
+	status = length = readUint16( stream );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( length < min( MIN_PKCSIZE, MIN_PKCSIZE_ECCPOINT ) || \
+		length > CRYPT_MAX_PKCSIZE )
+		return( CRYPT_ERROR_BADDATA );
+	queryInfo->dataStart = stell( stream ) - startPos;
+	queryInfo->dataLength = length;
+
+	/* Make sure that the remaining signature data is present */
+	return( sSkip( stream, length, MAX_INTLENGTH_SHORT ) );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 6 ) ) \
+static int writeTls13Signature( INOUT STREAM *stream,
+								STDC_UNUSED const CRYPT_CONTEXT iSignContext,
+								IN_ALGO const CRYPT_ALGO_TYPE hashAlgo,
+								IN_INT_SHORT_Z const int hashParam,
+								IN_ALGO const CRYPT_ALGO_TYPE signAlgo,
+								IN_BUFFER( signatureLength ) const BYTE *signature,
+								IN_LENGTH_SHORT_MIN( 18 + 18 + 1 ) \
+									const int signatureLength )
+	{
+	const BOOLEAN isSHA384 = ( hashParam == bitsToBytes( 384 ) ) ? \
+							 TRUE : FALSE;
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isReadPtrDynamic( signature, signatureLength ) );
+			/* Other parameters aren't used for this format */
+
+	REQUIRES( hashAlgo == CRYPT_ALGO_SHA2 );
+	REQUIRES( hashParam == 0 || hashParam == bitsToBytes( 256 ) || \
+			  hashParam == bitsToBytes( 384 ) );
+	REQUIRES( signAlgo == CRYPT_ALGO_RSA || signAlgo == CRYPT_ALGO_ECDSA );
+	REQUIRES( signatureLength > ( 18 + 18 ) && \
+			  signatureLength < MAX_INTLENGTH_SHORT );
+
+	/* Write the signature scheme */
+	if( signAlgo == CRYPT_ALGO_RSA )
+		{
+		/* TLS_SIGSCHEME_RSA_PSS_RSAE_SHA256/384 */
+		writeUint16( stream, isSHA384 ? 0x0805 : 0x0804 );
+		}
+	else
+		{
+		/* TLS_SIGSCHEME_ECDSA_SECP256R1_SHA256/SECP384R1_SHA384 */
+		writeUint16( stream, isSHA384 ? 0x0503 : 0x0403 );
+		}
+
+	/* Write the signature itself */
+	writeUint16( stream, signatureLength );
+	return( swrite( stream, signature, signatureLength ) );
+	}
 #endif /* USE_SSL */
 
 /****************************************************************************
@@ -1308,6 +1445,7 @@ static const SIG_READ_INFO sigReadTable[] = {
 #ifdef USE_SSL
 	{ SIGNATURE_SSL, readSslSignature },
 	{ SIGNATURE_TLS12, readTls12Signature },
+	{ SIGNATURE_TLS13, readTls13Signature },
 #endif /* USE_SSL */
 	{ SIGNATURE_NONE, NULL }, { SIGNATURE_NONE, NULL }
 	};
@@ -1334,6 +1472,7 @@ static const SIG_WRITE_INFO sigWriteTable[] = {
 #ifdef USE_SSL
 	{ SIGNATURE_SSL, writeSslSignature },
 	{ SIGNATURE_TLS12, writeTls12Signature },
+	{ SIGNATURE_TLS13, writeTls13Signature },
 #endif /* USE_SSH */
 	{ SIGNATURE_NONE, NULL }, { SIGNATURE_NONE, NULL }
 	};
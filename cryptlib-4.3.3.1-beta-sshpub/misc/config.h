@@ -252,6 +252,18 @@
 #define USE_MD5
 #define USE_RSA
 
+	  /* Curve25519 doesn't have the brittleness or the code-size issues of 
+		 the general-purpose ECC algorithms since it uses its own compact 
+		 fixed-curve implementation, so we enable it by default */
+
+#define USE_25519
+
+	  /* ChaCha20-Poly1305 is likewise a compact fixed-parameter design that, 
+		 unlike AES, is fast and constant-time in software without needing 
+		 hardware support, so we enable it by default as well */
+
+#define USE_CHACHA20
+
 #if !defined( USE_3DES ) && !defined( USE_AES ) 
 #error Either 3DES or AES must be enabled
 #endif /* !USE_3DES && !USE_AES ) */
@@ -268,10 +280,20 @@
 #define USE_SHA2_EXT
 #endif /* CONFIG_CONSERVE_MEMORY */
 
+	  /* Ed25519 shares the field arithmetic used for Curve25519, but 
+		 additionally requires SHA-512 for its internal hashing so it's only 
+		 available if the extended SHA-2's are */
+
+#if defined( USE_25519 ) && defined( USE_SHA2_EXT ) && \
+	!defined( CONFIG_SUITEB )
+#define USE_ED25519
+#endif /* USE_25519 && USE_SHA2_EXT */
+
 		 /* General PKC context usage */
 
 #if defined( USE_DH ) || defined( USE_DSA ) || defined( USE_ELGAMAL ) || \
-	defined( USE_RSA ) || defined( USE_ECDH ) || defined( USE_ECDSA )
+	defined( USE_RSA ) || defined( USE_ECDH ) || defined( USE_ECDSA ) || \
+	defined( USE_25519 )
 #define USE_PKC
 #endif /* PKC types */
 
@@ -978,6 +1000,17 @@
 #endif /* USE_TCP */
 #endif /* USE_SESSIONS */
 
+	  /* Sessions can be driven from an external event loop, with the 
+		 handshake being suspended whenever it would block on network I/O 
+		 and resumed once the event loop reports that the I/O can proceed.  
+		 This requires cooperative task switching, which is done via the 
+		 ucontext functions that aren't present in Android's Bionic libc */
+
+#if defined( USE_SESSIONS ) && defined( __linux__ ) && \
+	!defined( __ANDROID__ )
+#define USE_EVENTLOOP
+#endif /* USE_SESSIONS && Linux */
+
 		 /****************************************************************************
 		 *																			*
 		 *						Defines for Testing and Custom Builds				*
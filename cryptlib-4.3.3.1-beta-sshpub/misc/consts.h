@@ -49,6 +49,13 @@
 #define MIN_PKCSIZE				( bitsToBytes( 1024 ) - 2 )
 #define MIN_PKCSIZE_ECC			( bitsToBytes( 256 ) - 2 )
 
+/* Curve25519 keys, unlike other PKC keys, have a single fixed size, and 
+   are encoded as a fixed-length little-endian byte string rather than a
+   bignum or point.  This applies to both X25519 and Ed25519 keys */
+
+#define X25519_KEYSIZE			bitsToBytes( 256 )
+#define ED25519_SIGNATURE_SIZE	( X25519_KEYSIZE * 2 )
+
 /* When we read a public key, a value that's too short to be even vaguely
    sensible is reported as CRYPT_ERROR_BADDATA, but if it's at least 
    vaguely sensible but too short to be secure it's reported as 
@@ -279,6 +286,18 @@
 
 #define MAX_NETWORK_TIMEOUT		300
 
+/* The maximum number of pre-generated ephemeral DH/ECDH keys that are held 
+   for each key-agreement group by the session key pool */
+
+#define MAX_KEYPOOL_SIZE		16
+
+/* The minimum and maximum number of entries in the SSL session cache 
+   (scoreboard).  The upper limit is set to allow a busy server to keep 
+   several hundred thousand sessions available for resumption */
+
+#define MIN_SESSIONCACHE_SIZE	8
+#define MAX_SESSIONCACHE_SIZE	262144L
+
 /* Generic error return code/invalid value code */
 
 #define CRYPT_ERROR				-1
@@ -80,6 +80,7 @@ typedef enum {
 	/* SSL protocol-specific faults */
 	FAULT_SESSION_SSL_CORRUPT_FINISHED,	/* Corruption of finished MAC */
 	FAULT_SESSION_SSL_CORRUPT_IV,	/* Corruption of data IV */
+	FAULT_SESSION_SSL_TLS13_NO_KEYSHARE, /* Omit TLS 1.3 client key share */
 
 	/* SCEP protocol-specific faults */
 	FAULT_SESSION_SCEP_CORRUPT_MESSAGETYPE,	/* Corruption of message type */
@@ -404,6 +405,14 @@ typedef enum {
 #define FAULTACTION_SESSION_SSL_CORRUPT_IV_1 \
 		iv[ 2 ]++
 
+/* Send an empty key share list in the first TLS 1.3 client hello, which 
+   forces the server to respond with a HelloRetryRequest for the group that 
+   it wants */
+
+#define FAULTACTION_SESSION_SSL_TLS13_NO_KEYSHARE_1 \
+		if( !handshakeInfo->tls13Retry ) \
+			handshakeInfo->tls13KeyShareSent = FALSE
+
 /* CMP session fault types */
 
 /* Corrupt the transactionID */
@@ -788,6 +788,10 @@ static int checkKeyLength( INOUT STREAM *stream,
 		return( sseek( stream, startPos ) );
 		}
 
+	/* Curve25519 keys have a fixed size so there's nothing to check */
+	if( is25519Algo( cryptAlgo ) )
+		return( CRYPT_OK );
+
 	/* Read the key component that defines the nominal key size, either the 
 	   first algorithm parameter or the first public-key component */
 	if( hasAlgoParameters )
@@ -174,9 +174,84 @@ int getSysVar( IN_ENUM( SYSVAR ) const SYSVAR_TYPE type );
 #define HWCAP_FLAG_AES		0x040	/* Intel AES instruction support */
 #define HWCAP_FLAG_RDRAND	0x080	/* Intel RDRAND instruction support */
 #define HWCAP_FLAG_RDSEED	0x100	/* Intel RDSEED instruction support */
-#define HWCAP_FLAG_MAX		0x1FF	/* Maximum possible flag value */
+#define HWCAP_FLAG_SSE2		0x200	/* x86 SSE2 instruction support */
+#define HWCAP_FLAG_PCLMUL	0x400	/* Intel PCLMULQDQ instruction support */
+#define HWCAP_FLAG_SHA		0x800	/* Intel SHA instruction support */
+#define HWCAP_FLAG_AVX2		0x1000	/* AVX2 instruction support */
+#define HWCAP_FLAG_AVX512IFMA 0x2000 /* AVX-512 IFMA instruction support */
+#define HWCAP_FLAG_MAX		0x3FFF	/* Maximum possible flag value */
 #define HWCAP_FLAG_LAST		HWCAP_FLAG_MAX	/* For range checking */
 
+/* The capabilities that are used to select between the portable C code 
+   and the CPU-specific code in the crypto kernels.  The SIMD capabilities 
+   are only reported if the OS saves the corresponding register state and 
+   the compiler can build the code that uses them, so the kernels can 
+   check for the presence of a HWCAP_FLAG_xxx value and nothing else */
+
+#define HWCAP_FLAGS_KERNEL	( HWCAP_FLAG_SSE2 | HWCAP_FLAG_AES | \
+							  HWCAP_FLAG_PCLMUL | HWCAP_FLAG_SHA | \
+							  HWCAP_FLAG_AVX2 | HWCAP_FLAG_AVX512IFMA )
+
+/* The CPU-feature tiers that the crypto kernels can be restricted to via 
+   CRYPT_OPTION_MISC_CPUTIER, typically for benchmarking or for testing the 
+   fallback code on hardware that would never otherwise use it.  Each tier 
+   allows the use of the capabilities of the tiers below it */
+
+typedef enum {
+	HWCAP_TIER_NONE,		/* No restriction, use best available code */
+	HWCAP_TIER_GENERIC,		/* Portable C code only */
+	HWCAP_TIER_SSE2,		/* SSE2 SIMD code */
+	HWCAP_TIER_AESNI,		/* AES-NI, PCLMULQDQ, and SHA-NI code */
+	HWCAP_TIER_AVX2,		/* AVX2 code */
+	HWCAP_TIER_AVX512,		/* AVX-512 code */
+	HWCAP_TIER_LAST			/* Last valid tier */
+	} HWCAP_TIER_TYPE;
+
+CHECK_RETVAL \
+int setHWCapTier( IN_ENUM_OPT( HWCAP_TIER ) const HWCAP_TIER_TYPE tier );
+CHECK_RETVAL_ENUM( HWCAP_TIER ) \
+HWCAP_TIER_TYPE getHWCapTier( void );
+#define MAX_HWCAP_KERNELINFO_SIZE	192
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3 ) ) \
+int getHWCapKernelInfo( OUT_BUFFER( maxLength, *length ) char *buffer,
+						IN_LENGTH_SHORT_MIN( 64 ) const int maxLength,
+						OUT_LENGTH_BOUNDED_Z( maxLength ) int *length );
+
+/* Cooperative task switching, used to suspend a session handshake when it
+   would block on network I/O so that the session can be driven from an
+   external event loop.  runTask() runs the task function on the task's own
+   stack until it either completes, in which case runTask() returns the
+   function's status, or suspends itself via suspendTask(), in which case
+   runTask() returns OK_SPECIAL and the next call to runTask() continues
+   the task from where it left off.  A suspended task that's cancelled
+   sees an error returned from suspendTask() and is run to completion */
+
+#ifdef USE_EVENTLOOP
+
+typedef CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+		int ( *TASK_FUNCTION )( INOUT void *taskParam );
+
+typedef struct TI TASK_INFO;
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int createTask( OUT_PTR_COND TASK_INFO **taskInfoPtrPtr );
+STDC_NONNULL_ARG( ( 1 ) ) \
+void destroyTask( INOUT TASK_INFO *taskInfo );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int runTask( INOUT TASK_INFO *taskInfo,
+			 IN TASK_FUNCTION taskFunction, INOUT void *taskParam );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int suspendTask( INOUT TASK_INFO *taskInfo,
+				 IN_INT_SHORT const int waitEvents );
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+BOOLEAN isTaskRunning( const TASK_INFO *taskInfo );
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+BOOLEAN isTaskSuspended( const TASK_INFO *taskInfo );
+CHECK_RETVAL_RANGE_NOERROR( 0, MAX_INTLENGTH_SHORT ) STDC_NONNULL_ARG( ( 1 ) ) \
+int getTaskWaitEvents( const TASK_INFO *taskInfo );
+#endif /* USE_EVENTLOOP */
+
 /* cryptlib-specific feature flags used in the keyFeatures extension in
    certificates */
 
@@ -826,6 +901,22 @@ CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
 BOOLEAN checkMonoTimerExpiryImminent( INOUT MONOTIMER_INFO *timerInfo,
 									  IN_INT_Z const int timeLeft );
 
+/* High-resolution monotonic timer used to time protocol operations such as
+   the individual phases of a session handshake.  Timestamp values are only
+   meaningful relative to each other so the only thing that can be done 
+   with them is to get the time in microseconds that's elapsed since an 
+   earlier timestamp was taken */
+
+typedef struct {
+	time_t seconds;			/* Seconds from an arbitrary origin */
+	long microseconds;		/* Microseconds within the second */
+	} HIRES_TIMESTAMP;
+
+STDC_NONNULL_ARG( ( 1 ) ) \
+void getHiresTimestamp( OUT HIRES_TIMESTAMP *timestamp );
+CHECK_RETVAL_RANGE( 0, MAX_INTLENGTH - 1 ) STDC_NONNULL_ARG( ( 1 ) ) \
+int getHiresTimeElapsed( const HIRES_TIMESTAMP *startTimestamp );
+
 /* Hardware timer read routine used for performance evaluation */
 
 CHECK_RETVAL_RANGE( 0, INT_MAX ) \
@@ -997,6 +1088,50 @@ typedef STDC_NONNULL_ARG( ( 1, 3 ) ) \
 										IN_BUFFER( inLength ) const void *inBuffer, 
 										IN_LENGTH const int inLength );
 
+/* Finally, where there are many short independent messages to be hashed 
+   we provide a batch hash function that processes a set of messages in one 
+   go, which allows several of them to be hashed in parallel if the 
+   hardware supports it.  The hash of each message is returned in its batch 
+   entry */
+
+typedef struct HBI {
+	const void *data;				/* Data to hash */
+	int dataLength;
+	BYTE hash[ CRYPT_MAX_HASHSIZE + 8 ];	/* Hash of the data */
+	} HASH_BATCH_INFO;
+
+typedef STDC_NONNULL_ARG( ( 1 ) ) \
+		void ( *HASH_FUNCTION_BATCH )( INOUT_ARRAY( noEntries ) \
+											HASH_BATCH_INFO *hashBatchInfo,
+									   IN_INT_SHORT const int noEntries );
+
+/* PBKDF2 iterates an HMAC chain U_i = HMAC( U_i-1 ) many thousands of 
+   times over hash-sized data, so we provide an HMAC-chain function that 
+   works directly on the hash compression function rather than going 
+   through the general-purpose hash function for each HMAC.  This takes 
+   the hash states after the HMAC inner and outer pads have been processed 
+   and, for each of a set of independent chains, runs the chain for the 
+   given number of iterations, XORing each U_i into the chain's output.  
+   Where the hardware allows it the chains are run in parallel */
+
+#define MAX_HMAC_CHAINS			8
+
+typedef struct HCI {
+	BYTE value[ CRYPT_MAX_HASHSIZE + 8 ];	/* Current chain value U_i */
+	BYTE output[ CRYPT_MAX_HASHSIZE + 8 ];	/* U_1 ^ U_2 ^ ... ^ U_i */
+	} HMAC_CHAIN_INFO;
+
+typedef CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+		int ( *HASH_FUNCTION_HMACCHAIN )( IN TYPECAST( HASHINFO ) \
+												const void *innerHashState,
+										  IN TYPECAST( HASHINFO ) \
+												const void *outerHashState,
+										  INOUT_ARRAY( noChains ) \
+												HMAC_CHAIN_INFO *hmacChainInfo,
+										  IN_RANGE( 1, MAX_HMAC_CHAINS ) \
+												const int noChains,
+										  IN_INT const int iterations );
+
 STDC_NONNULL_ARG( ( 3 ) ) \
 void getHashParameters( IN_ALGO const CRYPT_ALGO_TYPE hashAlgorithm,
 						IN_INT_SHORT_Z const int hashParams,
@@ -1007,6 +1142,16 @@ void getHashAtomicParameters( IN_ALGO const CRYPT_ALGO_TYPE hashAlgorithm,
 							  IN_INT_SHORT_Z const int hashParams,
 							  OUT_PTR HASH_FUNCTION_ATOMIC *hashFunctionAtomic, 
 							  OUT_OPT_LENGTH_SHORT_Z int *hashOutputSize );
+STDC_NONNULL_ARG( ( 3 ) ) \
+void getHashBatchParameters( IN_ALGO const CRYPT_ALGO_TYPE hashAlgorithm,
+							 IN_INT_SHORT_Z const int hashParams,
+							 OUT_PTR HASH_FUNCTION_BATCH *hashFunctionBatch, 
+							 OUT_OPT_LENGTH_SHORT_Z int *hashOutputSize );
+STDC_NONNULL_ARG( ( 3 ) ) \
+void getHashHmacChainParameters( IN_ALGO const CRYPT_ALGO_TYPE hashAlgorithm,
+								 IN_INT_SHORT_Z const int hashParams,
+								 OUT_PTR_OPT \
+									HASH_FUNCTION_HMACCHAIN *hashFunctionHmacChain );
 
 /* Sometimes all that we need is a quick-reject check, usually performed to 
    lighten the load before we do a full hash check.  The following function 
@@ -542,6 +542,8 @@ const char *getAlgoName( IN_ALGO const CRYPT_ALGO_TYPE cryptAlgo )
 		{ CRYPT_ALGO_ELGAMAL, "ElGamal" },
 		{ CRYPT_ALGO_ECDSA,	"ECDSA" },
 		{ CRYPT_ALGO_ECDH, "ECDH" },
+		{ CRYPT_ALGO_25519, "X25519" },
+		{ CRYPT_ALGO_ED25519, "Ed25519" },
 		/* Hash algorithms */
 		{ CRYPT_ALGO_MD5, "CRYPT_ALGO_MD5" },
 		{ CRYPT_ALGO_SHA1, "CRYPT_ALGO_SHA1" },
@@ -376,6 +376,92 @@ BOOLEAN checkMonoTimerExpired( INOUT MONOTIMER_INFO *timerInfo )
 	return( checkMonoTimerExpiryImminent( timerInfo, 0 ) );
 	}
 
+/****************************************************************************
+*																			*
+*							High-resolution Timer Functions					*
+*																			*
+****************************************************************************/
+
+/* High-resolution monotonic timer used to time protocol operations like
+   the phases of a session handshake, which typically take anything from a
+   few hundred microseconds to a few seconds.  The one-second resolution of 
+   the standard time API is far too coarse for this, and it's not monotonic 
+   either, so where possible we use the system's monotonic clock.  If 
+   there's no high-resolution time source available we fall back to the 
+   standard time, which means that most intervals will be reported as 
+   zero */
+
+STDC_NONNULL_ARG( ( 1 ) ) \
+void getHiresTimestamp( OUT HIRES_TIMESTAMP *timestamp )
+	{
+#if defined( __WIN32__ )
+	LARGE_INTEGER performanceCount, performanceFrequency;
+#elif defined( __UNIX__ ) && defined( CLOCK_MONOTONIC )
+	struct timespec timeSpec;
+#endif /* OS-specific time sources */
+
+	assert( isWritePtr( timestamp, sizeof( HIRES_TIMESTAMP ) ) );
+
+	memset( timestamp, 0, sizeof( HIRES_TIMESTAMP ) );
+
+#if defined( __WIN32__ )
+	if( QueryPerformanceFrequency( &performanceFrequency ) && \
+		performanceFrequency.QuadPart > 0 && \
+		QueryPerformanceCounter( &performanceCount ) )
+		{
+		timestamp->seconds = ( time_t ) \
+				( performanceCount.QuadPart / performanceFrequency.QuadPart );
+		timestamp->microseconds = ( long ) \
+				( ( ( performanceCount.QuadPart % \
+					  performanceFrequency.QuadPart ) * 1000000L ) / \
+				  performanceFrequency.QuadPart );
+		return;
+		}
+#elif defined( __UNIX__ ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime( CLOCK_MONOTONIC, &timeSpec ) == 0 )
+		{
+		timestamp->seconds = timeSpec.tv_sec;
+		timestamp->microseconds = timeSpec.tv_nsec / 1000;
+		return;
+		}
+#endif /* OS-specific time sources */
+
+	/* There's no high-resolution time source available, fall back to the 
+	   standard time */
+	timestamp->seconds = getApproxTime();
+	}
+
+CHECK_RETVAL_RANGE( 0, MAX_INTLENGTH - 1 ) STDC_NONNULL_ARG( ( 1 ) ) \
+int getHiresTimeElapsed( const HIRES_TIMESTAMP *startTimestamp )
+	{
+	HIRES_TIMESTAMP currentTimestamp;
+	time_t seconds;
+	long microseconds;
+
+	assert( isReadPtr( startTimestamp, sizeof( HIRES_TIMESTAMP ) ) );
+
+	getHiresTimestamp( &currentTimestamp );
+	seconds = currentTimestamp.seconds - startTimestamp->seconds;
+	microseconds = currentTimestamp.microseconds - \
+				   startTimestamp->microseconds;
+	if( microseconds < 0 )
+		{
+		seconds--;
+		microseconds += 1000000L;
+		}
+
+	/* If we've had to fall back to the non-monotonic standard time and the
+	   clock has gone backwards, report a zero interval.  If the interval is 
+	   too long to represent in microseconds, report the maximum possible
+	   value */
+	if( seconds < 0 )
+		return( 0 );
+	if( seconds >= ( MAX_INTLENGTH - 1 ) / 1000000L )
+		return( MAX_INTLENGTH - 1 );
+
+	return( ( int ) ( ( seconds * 1000000L ) + microseconds ) );
+	}
+
 /****************************************************************************
 *																			*
 *								Self-test Functions							*
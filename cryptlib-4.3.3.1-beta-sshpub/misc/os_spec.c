@@ -634,6 +634,246 @@ int fixedSprintf( char *buffer, const int bufSize, const char *format, ... )
 	}
 #endif /* Old SunOS */
 
+/* Cooperative task switching for sessions that are driven from an external
+   event loop.  The session handshake runs as a task on its own stack, when
+   it would have to wait for network I/O the network code suspends the task
+   and control returns to runTask()'s caller, which reports a would-block
+   status back up to the event loop.  Once the event loop reports that the
+   I/O can proceed, the next call to runTask() switches back to the task,
+   which carries on from where it left off.
+
+   The task stack only exists while the task is active.  It has an
+   inaccessible guard page at the bottom so that an overflow faults rather
+   than overwriting whatever happens to be mapped below it, and since it's
+   unmapped rather than freed when the task completes any sensitive data
+   left on it by the handshake doesn't find its way back into the heap */
+
+#ifdef USE_EVENTLOOP
+
+#include <sys/mman.h>
+#include <ucontext.h>
+
+#define TASK_STACK_SIZE		( 128 * 1024 )
+
+typedef enum {
+	TASK_STATE_NONE,		/* Task isn't active */
+	TASK_STATE_RUNNING,		/* Task is running on its own stack */
+	TASK_STATE_SUSPENDED,	/* Task is suspended waiting for I/O */
+	TASK_STATE_LAST			/* Last possible task state */
+	} TASK_STATE;
+
+struct TI {
+	/* The task and caller state, saved and restored when we switch between
+	   them */
+	ucontext_t taskContext, callerContext;
+
+	/* The task stack, including the guard page */
+	void *stack;
+	size_t stackSize;
+
+	/* The function that the task runs and the status that it returned */
+	TASK_FUNCTION taskFunction;
+	void *taskParam;
+	int taskStatus;
+
+	/* The task state, whether the task has been cancelled, and the events
+	   that a suspended task is waiting for */
+	TASK_STATE state;
+	BOOLEAN isCancelled;
+	int waitEvents;
+	};
+
+/* The entry point for a task.  makecontext() can only pass int arguments
+   to the task function so we have to pass the TASK_INFO pointer in two
+   halves.  When the function returns, control passes back to the caller
+   via the uc_link context */
+
+static void taskEntry( const unsigned int taskInfoHi,
+					   const unsigned int taskInfoLo )
+	{
+	TASK_INFO *taskInfo = ( TASK_INFO * ) \
+			( ( ( ( uintptr_t ) taskInfoHi << 16 ) << 16 ) | taskInfoLo );
+
+	taskInfo->taskStatus = taskInfo->taskFunction( taskInfo->taskParam );
+	taskInfo->state = TASK_STATE_NONE;
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int createTask( OUT_PTR_COND TASK_INFO **taskInfoPtrPtr )
+	{
+	TASK_INFO *taskInfo;
+
+	assert( isWritePtr( taskInfoPtrPtr, sizeof( TASK_INFO * ) ) );
+
+	/* Clear return value */
+	*taskInfoPtrPtr = NULL;
+
+	if( ( taskInfo = clAlloc( "createTask", sizeof( TASK_INFO ) ) ) == NULL )
+		return( CRYPT_ERROR_MEMORY );
+	memset( taskInfo, 0, sizeof( TASK_INFO ) );
+	taskInfo->state = TASK_STATE_NONE;
+	*taskInfoPtrPtr = taskInfo;
+
+	return( CRYPT_OK );
+	}
+
+STDC_NONNULL_ARG( ( 1 ) ) \
+void destroyTask( INOUT TASK_INFO *taskInfo )
+	{
+	assert( isWritePtr( taskInfo, sizeof( TASK_INFO ) ) );
+
+	REQUIRES_V( taskInfo->state != TASK_STATE_RUNNING );
+
+	/* If the task is still suspended, cancel it so that it can clean up
+	   after itself */
+	if( taskInfo->state == TASK_STATE_SUSPENDED )
+		{
+		taskInfo->isCancelled = TRUE;
+		( void ) runTask( taskInfo, taskInfo->taskFunction,
+						  taskInfo->taskParam );
+		}
+	ENSURES_V( taskInfo->state == TASK_STATE_NONE && \
+			   taskInfo->stack == NULL );
+
+	zeroise( taskInfo, sizeof( TASK_INFO ) );
+	clFree( "destroyTask", taskInfo );
+	}
+
+/* Run a task, either starting it or continuing it from where it was
+   suspended */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int runTask( INOUT TASK_INFO *taskInfo,
+			 IN TASK_FUNCTION taskFunction, INOUT void *taskParam )
+	{
+	const uintptr_t taskInfoValue = ( uintptr_t ) taskInfo;
+
+	assert( isWritePtr( taskInfo, sizeof( TASK_INFO ) ) );
+
+	REQUIRES( taskInfo->state == TASK_STATE_NONE || \
+			  ( taskInfo->state == TASK_STATE_SUSPENDED && \
+				taskInfo->taskFunction == taskFunction && \
+				taskInfo->taskParam == taskParam ) );
+
+	/* If this is a new task, set up the task stack and context */
+	if( taskInfo->state == TASK_STATE_NONE )
+		{
+		const int pageSize = getSysVar( SYSVAR_PAGESIZE );
+		void *stack;
+
+		REQUIRES( taskInfo->stack == NULL );
+
+		stack = mmap( NULL, TASK_STACK_SIZE + pageSize,
+					  PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+					  -1, 0 );
+		if( stack == MAP_FAILED )
+			return( CRYPT_ERROR_MEMORY );
+		if( mprotect( stack, pageSize, PROT_NONE ) != 0 || \
+			getcontext( &taskInfo->taskContext ) != 0 )
+			{
+			munmap( stack, TASK_STACK_SIZE + pageSize );
+			return( CRYPT_ERROR_MEMORY );
+			}
+		taskInfo->stack = stack;
+		taskInfo->stackSize = TASK_STACK_SIZE + pageSize;
+		taskInfo->taskContext.uc_stack.ss_sp = stack;
+		taskInfo->taskContext.uc_stack.ss_size = taskInfo->stackSize;
+		taskInfo->taskContext.uc_link = &taskInfo->callerContext;
+		makecontext( &taskInfo->taskContext, ( void ( * )( void ) ) taskEntry,
+					 2, ( unsigned int ) ( ( taskInfoValue >> 16 ) >> 16 ),
+					 ( unsigned int ) ( taskInfoValue & 0xFFFFFFFFUL ) );
+		taskInfo->taskFunction = taskFunction;
+		taskInfo->taskParam = taskParam;
+		taskInfo->taskStatus = CRYPT_ERROR;
+		taskInfo->isCancelled = FALSE;
+		}
+
+	/* Switch to the task and run it until it either completes or suspends
+	   itself */
+	taskInfo->state = TASK_STATE_RUNNING;
+	if( swapcontext( &taskInfo->callerContext,
+					 &taskInfo->taskContext ) != 0 )
+		{
+		/* We couldn't switch to the task, which can only happen for a new
+		   task since resuming a suspended one just restores the context
+		   that swapcontext() saved when it was suspended */
+		taskInfo->state = TASK_STATE_NONE;
+		munmap( taskInfo->stack, taskInfo->stackSize );
+		taskInfo->stack = NULL;
+		retIntError();
+		}
+	if( taskInfo->state == TASK_STATE_SUSPENDED )
+		return( OK_SPECIAL );
+
+	/* The task has completed, clean up */
+	ENSURES( taskInfo->state == TASK_STATE_NONE );
+	munmap( taskInfo->stack, taskInfo->stackSize );
+	taskInfo->stack = NULL;
+	ENSURES( taskInfo->taskStatus != OK_SPECIAL );
+
+	return( taskInfo->taskStatus );
+	}
+
+/* Suspend the currently-running task until it's resumed by the next call
+   to runTask().  If the task has been cancelled then we return straight
+   away with an error so that it can exit */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int suspendTask( INOUT TASK_INFO *taskInfo,
+				 IN_INT_SHORT const int waitEvents )
+	{
+	assert( isWritePtr( taskInfo, sizeof( TASK_INFO ) ) );
+
+	REQUIRES( taskInfo->state == TASK_STATE_RUNNING );
+	REQUIRES( waitEvents > 0 && waitEvents < MAX_INTLENGTH_SHORT );
+
+	if( taskInfo->isCancelled )
+		return( CRYPT_ERROR_TIMEOUT );
+	taskInfo->waitEvents = waitEvents;
+	taskInfo->state = TASK_STATE_SUSPENDED;
+	if( swapcontext( &taskInfo->taskContext,
+					 &taskInfo->callerContext ) != 0 )
+		{
+		taskInfo->state = TASK_STATE_RUNNING;
+		taskInfo->waitEvents = 0;
+		retIntError();
+		}
+
+	/* We've been resumed by runTask() */
+	ENSURES( taskInfo->state == TASK_STATE_RUNNING );
+	taskInfo->waitEvents = 0;
+
+	return( taskInfo->isCancelled ? CRYPT_ERROR_TIMEOUT : CRYPT_OK );
+	}
+
+/* Get information on a task's state */
+
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+BOOLEAN isTaskRunning( const TASK_INFO *taskInfo )
+	{
+	assert( isReadPtr( taskInfo, sizeof( TASK_INFO ) ) );
+
+	return( ( taskInfo->state == TASK_STATE_RUNNING ) ? TRUE : FALSE );
+	}
+
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+BOOLEAN isTaskSuspended( const TASK_INFO *taskInfo )
+	{
+	assert( isReadPtr( taskInfo, sizeof( TASK_INFO ) ) );
+
+	return( ( taskInfo->state == TASK_STATE_SUSPENDED ) ? TRUE : FALSE );
+	}
+
+CHECK_RETVAL_RANGE_NOERROR( 0, MAX_INTLENGTH_SHORT ) STDC_NONNULL_ARG( ( 1 ) ) \
+int getTaskWaitEvents( const TASK_INFO *taskInfo )
+	{
+	assert( isReadPtr( taskInfo, sizeof( TASK_INFO ) ) );
+
+	return( ( taskInfo->state == TASK_STATE_SUSPENDED ) ? \
+			taskInfo->waitEvents : 0 );
+	}
+#endif /* USE_EVENTLOOP */
+
 /****************************************************************************
 *																			*
 *									Windows									*
@@ -1829,6 +2069,23 @@ int strlcat_s( char *dest, const int destLen, const char *src )
 *																			*
 ****************************************************************************/
 
+/* CPUID feature bits and XCR0 register-state flags used to determine the 
+   capabilities of the crypto kernels in the x86 getKernelHWInfo() 
+   variants below */
+
+#define CPUID_ECX_PCLMULQDQ		( 1 << 1 )
+#define CPUID_ECX_SSSE3			( 1 << 9 )
+#define CPUID_ECX_SSE41			( 1 << 19 )
+#define CPUID_ECX_AESNI			( 1 << 25 )
+#define CPUID_ECX_OSXSAVE		( 1 << 27 )
+#define CPUID_ECX_AVX			( 1 << 28 )
+#define CPUID7_EBX_AVX2			( 1 << 5 )
+#define CPUID7_EBX_AVX512F		( 1 << 16 )
+#define CPUID7_EBX_AVX512IFMA	( 1 << 21 )
+#define CPUID7_EBX_SHA			( 1 << 29 )
+#define XCR0_YMM_STATE			0x06
+#define XCR0_ZMM_STATE			0xE6
+
 #if defined( __WIN32__ )  && \
 	!( defined( _M_X64 ) || defined( __MINGW32__ ) || defined( NO_ASM ) )
 
@@ -1961,6 +2218,57 @@ static int getHWInfo( void )
 
 typedef struct { unsigned int eax, ebx, ecx, edx; } CPUID_INFO;
 
+/* Get the capabilities that are used by the crypto kernels, see the 
+   comment in int_api.h.  x86-64 always has SSE2, the AES-NI, PCLMULQDQ, 
+   and SHA-NI code also uses SSSE3 (for PSHUFB) and SSE4.1, and the AVX2 
+   and AVX-512 code can only be used if the OS saves the YMM and ZMM 
+   register state on context switches, which is indicated by XCR0.  The 
+   compiler versions are the ones needed for the intrinsics that the 
+   kernels use */
+
+CHECK_RETVAL_RANGE( 0, HWCAP_FLAG_MAX ) \
+static int getKernelHWInfo( const unsigned long maxCPUID, 
+							const unsigned long featureFlags )
+	{
+	int cpuInfo[ 4 ], sysCaps = HWCAP_FLAG_SSE2;
+
+	if( ( featureFlags & ( CPUID_ECX_SSSE3 | CPUID_ECX_SSE41 ) ) == \
+						 ( CPUID_ECX_SSSE3 | CPUID_ECX_SSE41 ) )
+		{
+		if( featureFlags & CPUID_ECX_AESNI )
+			sysCaps |= HWCAP_FLAG_AES;
+		if( featureFlags & CPUID_ECX_PCLMULQDQ )
+			sysCaps |= HWCAP_FLAG_PCLMUL;
+		}
+#if _MSC_VER >= 1800
+	if( maxCPUID < 7 )
+		return( sysCaps );
+	memset( cpuInfo, 0, sizeof( int ) * 4 );
+	__cpuidex( cpuInfo, 7, 0 );
+  #if _MSC_VER >= 1900
+	if( ( sysCaps & HWCAP_FLAG_AES ) && ( cpuInfo[ 1 ] & CPUID7_EBX_SHA ) )
+		sysCaps |= HWCAP_FLAG_SHA;
+  #endif /* VS 2015+ */
+	if( ( featureFlags & ( CPUID_ECX_OSXSAVE | CPUID_ECX_AVX ) ) == \
+						 ( CPUID_ECX_OSXSAVE | CPUID_ECX_AVX ) )
+		{
+		const unsigned __int64 xcr0 = _xgetbv( 0 );
+
+		if( ( xcr0 & XCR0_YMM_STATE ) == XCR0_YMM_STATE && \
+			( cpuInfo[ 1 ] & CPUID7_EBX_AVX2 ) )
+			sysCaps |= HWCAP_FLAG_AVX2;
+  #if _MSC_VER >= 1920
+		if( ( xcr0 & XCR0_ZMM_STATE ) == XCR0_ZMM_STATE && \
+			( cpuInfo[ 1 ] & CPUID7_EBX_AVX512F ) && \
+			( cpuInfo[ 1 ] & CPUID7_EBX_AVX512IFMA ) )
+			sysCaps |= HWCAP_FLAG_AVX512IFMA;
+  #endif /* VS 2019+ */
+		}
+#endif /* VS 2013+ */
+
+	return( sysCaps );
+	}
+
 STDC_NONNULL_ARG( ( 1 ) ) \
 static void cpuID( OUT CPUID_INFO *result, const int type )
 	{
@@ -1986,7 +2294,7 @@ static int getHWInfo( void )
 	CPUID_INFO cpuidInfo;
 	char vendorID[ 12 + 8 ];
 	int *vendorIDptr = ( int * ) vendorID;
-	unsigned long processorID, featureFlags, featureFlags2;
+	unsigned long maxCPUID, processorID, featureFlags, featureFlags2;
 	int sysCaps = HWCAP_FLAG_RDTSC;	/* x86-64 always has RDTSC */
 
 	/* Get any CPU info that we need.  There is an 
@@ -1996,6 +2304,7 @@ static int getHWInfo( void )
 	   check for the presence of other features, we do the whole thing 
 	   ourselves */
 	cpuID( &cpuidInfo, 0 );
+	maxCPUID = cpuidInfo.eax;
 	vendorIDptr[ 0 ] = cpuidInfo.ebx;
 	vendorIDptr[ 1 ] = cpuidInfo.edx;
 	vendorIDptr[ 2 ] = cpuidInfo.ecx;
@@ -2035,10 +2344,6 @@ static int getHWInfo( void )
 		}
 	if( !memcmp( vendorID, "GenuineIntel", 12 ) )
 		{
-		/* Check for hardware AES support */
-		if( featureFlags & ( 1 << 25 ) )
-			sysCaps |= HWCAP_FLAG_AES;
-
 		/* Check for the return of a hardware RNG */
 		if( featureFlags & ( 1 << 30 ) )
 			sysCaps |= HWCAP_FLAG_RDRAND;
@@ -2046,6 +2351,10 @@ static int getHWInfo( void )
 			sysCaps |= HWCAP_FLAG_RDSEED;
 		}
 
+	/* Check for the vendor-independent capabilities that are used by the 
+	   crypto kernels */
+	sysCaps |= getKernelHWInfo( maxCPUID, featureFlags );
+
 	return( sysCaps );
 	}
 
@@ -2085,18 +2394,71 @@ static BOOLEAN cpuID( OUT CPUID_INFO *result, const int type )
 	return( TRUE );
 	}
 
+/* Get the capabilities that are used by the crypto kernels, see the 
+   comment in int_api.h and the VC++ version of this function above.  We 
+   use the raw opcode for XGETBV rather than the _xgetbv() intrinsic since 
+   the latter requires enabling the XSAVE code generation target.  The 
+   compiler versions are the ones needed for the intrinsics that the 
+   kernels use */
+
+#if defined( __x86_64__ ) && \
+	( ( __GNUC__ >= 5 ) || \
+	  ( defined( __clang_major__ ) && ( __clang_major__ >= 4 ) ) )
+
+#define USE_HWCAP_KERNELS
+
+CHECK_RETVAL_RANGE( 0, HWCAP_FLAG_MAX ) \
+static int getKernelHWInfo( const unsigned long maxCPUID, 
+							const unsigned long featureFlags )
+	{
+	unsigned int a, b, c, d, xcr0Lo, xcr0Hi;
+	int sysCaps = HWCAP_FLAG_SSE2;
+
+	if( ( featureFlags & ( CPUID_ECX_SSSE3 | CPUID_ECX_SSE41 ) ) == \
+						 ( CPUID_ECX_SSSE3 | CPUID_ECX_SSE41 ) )
+		{
+		if( featureFlags & CPUID_ECX_AESNI )
+			sysCaps |= HWCAP_FLAG_AES;
+		if( featureFlags & CPUID_ECX_PCLMULQDQ )
+			sysCaps |= HWCAP_FLAG_PCLMUL;
+		}
+	if( maxCPUID < 7 )
+		return( sysCaps );
+	__cpuid_count( 7, 0, a, b, c, d );
+	if( ( sysCaps & HWCAP_FLAG_AES ) && ( b & CPUID7_EBX_SHA ) )
+		sysCaps |= HWCAP_FLAG_SHA;
+	if( ( featureFlags & ( CPUID_ECX_OSXSAVE | CPUID_ECX_AVX ) ) != \
+						 ( CPUID_ECX_OSXSAVE | CPUID_ECX_AVX ) )
+		return( sysCaps );
+	__asm__ __volatile__( ".byte 0x0F, 0x01, 0xD0"
+						  : "=a" ( xcr0Lo ), "=d" ( xcr0Hi ) : "c" ( 0 ) );
+	if( ( xcr0Lo & XCR0_YMM_STATE ) == XCR0_YMM_STATE && \
+		( b & CPUID7_EBX_AVX2 ) )
+		sysCaps |= HWCAP_FLAG_AVX2;
+#if ( __GNUC__ >= 8 ) || \
+	( defined( __clang_major__ ) && ( __clang_major__ >= 7 ) )
+	if( ( xcr0Lo & XCR0_ZMM_STATE ) == XCR0_ZMM_STATE && \
+		( b & CPUID7_EBX_AVX512F ) && ( b & CPUID7_EBX_AVX512IFMA ) )
+		sysCaps |= HWCAP_FLAG_AVX512IFMA;
+#endif /* gcc 8+/clang 7+ */
+
+	return( sysCaps );
+	}
+#endif /* gcc 5+/clang 4+ on x86-64 */
+
 CHECK_RETVAL \
 static int getHWInfo( void )
 	{
 	CPUID_INFO cpuidInfo;
 	char vendorID[ 12 + 8 ];
 	int *vendorIDptr = ( int * ) vendorID;
-	unsigned long processorID, featureFlags, featureFlags2;
+	unsigned long maxCPUID, processorID, featureFlags, featureFlags2;
 	int sysCaps = 0;
 
 	/* Get any CPU info that we need */
 	if( !cpuID( &cpuidInfo, 0 ) )	/* CPUID function 0: Get vendor ID */
 		return( HWCAP_FLAG_NONE );
+	maxCPUID = cpuidInfo.eax;
 	vendorIDptr[ 0 ] = cpuidInfo.ebx;
 	vendorIDptr[ 1 ] = cpuidInfo.edx;
 	vendorIDptr[ 2 ] = cpuidInfo.ecx;
@@ -2139,10 +2501,6 @@ static int getHWInfo( void )
 		}
 	if( !memcmp( vendorID, "GenuineIntel", 12 ) )
 		{
-		/* Check for hardware AES support */
-		if( featureFlags & ( 1 << 25 ) )
-			sysCaps |= HWCAP_FLAG_AES;
-
 		/* Check for the return of a hardware RNG */
 		if( featureFlags & ( 1 << 30 ) )
 			sysCaps |= HWCAP_FLAG_RDRAND;
@@ -2150,6 +2508,12 @@ static int getHWInfo( void )
 			sysCaps |= HWCAP_FLAG_RDSEED;
 		}
 
+#ifdef USE_HWCAP_KERNELS
+	/* Check for the vendor-independent capabilities that are used by the 
+	   crypto kernels */
+	sysCaps |= getKernelHWInfo( maxCPUID, featureFlags );
+#endif /* USE_HWCAP_KERNELS */
+
 	return( sysCaps );
 	}
 
@@ -2343,6 +2707,14 @@ static int getHWInfo( void )
 
 static int sysVars[ MAX_SYSVARS ];
 
+/* The hardware capabilities that were detected at startup.  The 
+   SYSVAR_HWCAP value that's reported to the rest of cryptlib may be a 
+   subset of these if the use of CPU-specific code has been restricted via 
+   setHWCapTier() */
+
+static int hwCapsDetected;
+static HWCAP_TIER_TYPE hwCapTier;
+
 #if ( defined( __WIN32__ ) || defined( __WINCE__ ) )
 
 CHECK_RETVAL \
@@ -2386,7 +2758,7 @@ int initSysVars( void )
 	sysVars[ SYSVAR_PAGESIZE ] = systemInfo.dwPageSize;
 
 	/* Get system hardware capabilities */
-	sysVars[ SYSVAR_HWCAP ] = getHWInfo();
+	sysVars[ SYSVAR_HWCAP ] = hwCapsDetected = getHWInfo();
 
 	return( CRYPT_OK );
 	}
@@ -2427,7 +2799,7 @@ int initSysVars( void )
 		}
 
 	/* Get system hardware capabilities */
-	sysVars[ SYSVAR_HWCAP ] = getHWInfo();
+	sysVars[ SYSVAR_HWCAP ] = hwCapsDetected = getHWInfo();
 
 #if defined( __IBMC__ ) || defined( __IBMCPP__ )
 	/* VisualAge C++ doesn't set the TZ correctly */
@@ -2446,7 +2818,7 @@ int initSysVars( void )
 	memset( sysVars, 0, sizeof( int ) * MAX_SYSVARS );
 
 	/* Get system hardware capabilities */
-	sysVars[ SYSVAR_HWCAP ] = getHWInfo();
+	sysVars[ SYSVAR_HWCAP ] = hwCapsDetected = getHWInfo();
 
 	return( CRYPT_OK );
 	}
@@ -2460,6 +2832,100 @@ int getSysVar( IN_ENUM( SYSVAR ) const SYSVAR_TYPE type )
 	return( sysVars[ type ] );
 	}
 
+/* Restrict the hardware capabilities that the crypto kernels can use to a 
+   given CPU-feature tier.  This only changes the capabilities that are 
+   reported via SYSVAR_HWCAP, so code that makes a per-call check will 
+   switch over immediately while objects that choose their implementation 
+   when they're set up, for example AES-GCM contexts that precompute GHASH 
+   tables or PCLMULQDQ key powers when the key is loaded, will continue 
+   using the implementation that they were set up with.  The tier that's 
+   currently in effect can be read back with getHWCapTier(), which allows 
+   the self-tests to temporarily drop down to the generic code */
+
+CHECK_RETVAL \
+int setHWCapTier( IN_ENUM_OPT( HWCAP_TIER ) const HWCAP_TIER_TYPE tier )
+	{
+	int hwCapsMask;
+
+	REQUIRES( tier >= HWCAP_TIER_NONE && tier < HWCAP_TIER_LAST );
+
+	switch( tier )
+		{
+		case HWCAP_TIER_NONE:
+		case HWCAP_TIER_AVX512:
+			hwCapsMask = HWCAP_FLAG_MAX;
+			break;
+
+		case HWCAP_TIER_GENERIC:
+			hwCapsMask = ~HWCAP_FLAGS_KERNEL;
+			break;
+
+		case HWCAP_TIER_SSE2:
+			hwCapsMask = ~( HWCAP_FLAGS_KERNEL & ~HWCAP_FLAG_SSE2 );
+			break;
+
+		case HWCAP_TIER_AESNI:
+			hwCapsMask = ~( HWCAP_FLAG_AVX2 | HWCAP_FLAG_AVX512IFMA );
+			break;
+
+		case HWCAP_TIER_AVX2:
+			hwCapsMask = ~HWCAP_FLAG_AVX512IFMA;
+			break;
+
+		default:
+			retIntError();
+		}
+	sysVars[ SYSVAR_HWCAP ] = hwCapsDetected & hwCapsMask;
+	hwCapTier = tier;
+
+	return( CRYPT_OK );
+	}
+
+CHECK_RETVAL_ENUM( HWCAP_TIER ) \
+HWCAP_TIER_TYPE getHWCapTier( void )
+	{
+	return( hwCapTier );
+	}
+
+/* Get a description of the crypto kernels that are currently in use, 
+   based on the capabilities in SYSVAR_HWCAP */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3 ) ) \
+int getHWCapKernelInfo( OUT_BUFFER( maxLength, *length ) char *buffer,
+						IN_LENGTH_SHORT_MIN( 64 ) const int maxLength,
+						OUT_LENGTH_BOUNDED_Z( maxLength ) int *length )
+	{
+	const int hwCaps = sysVars[ SYSVAR_HWCAP ];
+	int bufPos;
+
+	assert( isWritePtrDynamic( buffer, maxLength ) );
+	assert( isWritePtr( length, sizeof( int ) ) );
+
+	REQUIRES( maxLength >= 64 && maxLength < MAX_INTLENGTH_SHORT );
+
+	/* Clear return values */
+	memset( buffer, 0, min( 16, maxLength ) );
+	*length = 0;
+
+	bufPos = sprintf_s( buffer, maxLength, 
+			"AES: %s, GCM: %s, SHA-1/SHA-256: %s, SHA-1/SHA-256 batch: %s, "
+			"ChaCha20: %s, bignum: %s, base64: C",
+			( hwCaps & HWCAP_FLAG_AES ) ? "AES-NI" : "C",
+			( ( hwCaps & ( HWCAP_FLAG_AES | HWCAP_FLAG_PCLMUL ) ) == \
+						 ( HWCAP_FLAG_AES | HWCAP_FLAG_PCLMUL ) ) ? \
+				"PCLMULQDQ" : "C",
+			( hwCaps & HWCAP_FLAG_SHA ) ? "SHA-NI" : \
+				( hwCaps & HWCAP_FLAG_AVX2 ) ? "AVX2" : "C",
+			( hwCaps & HWCAP_FLAG_AVX2 ) ? "AVX2" : "C",
+			( hwCaps & HWCAP_FLAG_AVX2 ) ? "AVX2" : \
+				( hwCaps & HWCAP_FLAG_SSE2 ) ? "SSE2" : "C",
+			( hwCaps & HWCAP_FLAG_AVX512IFMA ) ? "AVX-512 IFMA" : "C" );
+	ENSURES( bufPos > 0 && bufPos < maxLength );
+	*length = bufPos;
+
+	return( CRYPT_OK );
+	}
+
 /****************************************************************************
 *																			*
 *				Miscellaneous System-specific Support Functions				*
@@ -8,11 +8,15 @@
 #include <stdio.h>		/* For snprintf_s() */
 #include "crypt.h"
 #ifdef INC_ALL
+  #include "keypool.h"
+  #include "scorebrd.h"
   #include "trustmgr.h"
   #include "user.h"
 #else
   #include "cert/trustmgr.h"
   #include "misc/user.h"
+  #include "session/keypool.h"
+  #include "session/scorebrd.h"
 #endif /* Compiler-specific includes */
 
 /****************************************************************************
@@ -300,6 +304,17 @@ int getUserAttribute( INOUT USER_INFO *userInfoPtr,
 			return( status );
 			}
 #endif /* USE_CERTIFICATES */
+
+		case CRYPT_OPTION_SESSION_KEYPOOLHITS:
+		case CRYPT_OPTION_SESSION_KEYPOOLMISSES:
+			/* The key pool statistics are maintained by the session code 
+			   rather than being stored as configuration values */
+			return( getKeyPoolStatistic( attribute, valuePtr ) );
+
+		case CRYPT_OPTION_SESSION_TICKETHITS:
+		case CRYPT_OPTION_SESSION_TICKETMISSES:
+			/* As are the session ticket statistics */
+			return( getSessionTicketStatistic( attribute, valuePtr ) );
 		}
 
 	/* Anything else has to be a configuration option */
@@ -333,6 +348,20 @@ int getUserAttributeS( INOUT USER_INFO *userInfoPtr,
 	REQUIRES( attribute > CRYPT_OPTION_FIRST && \
 			  attribute < CRYPT_OPTION_LAST );
 
+	/* The crypto kernel information is generated from the current hardware 
+	   capabilities rather than being stored as a configuration value */
+	if( attribute == CRYPT_OPTION_MISC_CPUKERNELS )
+		{
+		char buffer[ MAX_HWCAP_KERNELINFO_SIZE + 8 ];
+		int length;
+
+		status = getHWCapKernelInfo( buffer, MAX_HWCAP_KERNELINFO_SIZE, 
+									 &length );
+		if( cryptStatusError( status ) )
+			return( status );
+		return( attributeCopy( msgData, buffer, length ) );
+		}
+
 	/* Check whether there's a configuration value of this type present */
 	status = getOptionString( userInfoPtr->configOptions, 
 							  userInfoPtr->configOptionsCount, attribute, 
@@ -461,6 +490,14 @@ int setUserAttribute( INOUT USER_INFO *userInfoPtr,
 	   side-effects, we're done */
 	status = setOption( userInfoPtr->configOptions, 
 						userInfoPtr->configOptionsCount, attribute, value );
+	if( attribute == CRYPT_OPTION_MISC_CPUTIER )
+		{
+		/* Changing the CPU tier restricts the hardware capabilities that 
+		   are available to the crypto kernels */
+		if( cryptStatusError( status ) )
+			return( status );
+		return( setHWCapTier( value ) );
+		}
 	if( attribute != CRYPT_OPTION_CONFIGCHANGED && \
 		attribute != CRYPT_OPTION_SELFTESTOK )
 		return( status );
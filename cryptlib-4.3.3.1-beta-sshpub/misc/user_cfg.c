@@ -94,8 +94,6 @@ static const BUILTIN_OPTION_INFO FAR_DATA builtinOptionInfo[] = {
 	MK_OPTION_S( CRYPT_OPTION_DEVICE_PKCS11_DVR05, NULL, 0, 304 ),
 	MK_OPTION_B( CRYPT_OPTION_DEVICE_PKCS11_HARDWAREONLY, FALSE, 305 ),
 
-	/* Session options, base = 400 */
-
 	/* Miscellaneous options, base = 500.  The network options are mostly 
 	   used by sessions but also apply to other object types like network 
 	   keysets so they're classed as miscellaneous options. 
@@ -120,10 +118,6 @@ static const BUILTIN_OPTION_INFO FAR_DATA builtinOptionInfo[] = {
 	MK_OPTION( CRYPT_OPTION_MISC_SIDECHANNELPROTECTION, 0, 507 ),
 #endif /* Options based on CPU speed */
 
-	/* All options beyond this point are ephemeral and aren't stored to disk. 
-	   Remember to update the LAST_STORED_OPTION define in user_int.h when 
-	   adding new options here */
-
 	/* cryptlib state information.  These are special-case options that
 	   record state information rather than a static configuration value.  
 	   The configuration-option-changed status value is updated dynamically, 
@@ -134,6 +128,53 @@ static const BUILTIN_OPTION_INFO FAR_DATA builtinOptionInfo[] = {
 	MK_OPTION_B( CRYPT_OPTION_CONFIGCHANGED, FALSE, CRYPT_UNUSED ),
 	MK_OPTION( CRYPT_OPTION_SELFTESTOK, FALSE, CRYPT_UNUSED ),
 
+	/* Session options, base = 400.  These follow the cryptlib state 
+	   information since new options are added at the end of the attribute 
+	   list, remember to update the LAST_STORED_OPTION define in user_int.h 
+	   when adding new stored options.
+	   
+	   The ephemeral DH/ECDH key pool is disabled by default since each 
+	   pooled key occupies a full PKC context and the fill thread generates 
+	   keys in the background, which servers that want it have to opt in 
+	   to.  The hit and miss counts are read-only values that are maintained 
+	   by the session code rather than being stored in the configuration 
+	   data, the values here are only placeholders */
+	MK_OPTION( CRYPT_OPTION_SESSION_KEYPOOLSIZE, 0, 400 ),
+	MK_OPTION( CRYPT_OPTION_SESSION_KEYPOOLLOWWATER, 1, 401 ),
+	MK_OPTION( CRYPT_OPTION_SESSION_KEYPOOLHITS, 0, CRYPT_UNUSED ),
+	MK_OPTION( CRYPT_OPTION_SESSION_KEYPOOLMISSES, 0, CRYPT_UNUSED ),
+
+	/* Crypto kernel selection.  The CPU tier restriction is meant for 
+	   benchmarking and testing so it isn't stored with the other options, 
+	   and the crypto kernel information is a read-only value that's 
+	   generated when it's read, the value here is only a placeholder */
+	MK_OPTION( CRYPT_OPTION_MISC_CPUTIER, HWCAP_TIER_NONE, CRYPT_UNUSED ),
+	MK_OPTION_S( CRYPT_OPTION_MISC_CPUKERNELS, NULL, 0, CRYPT_UNUSED ),
+
+	/* TLS session ticket options.  The hit and miss counts are read-only 
+	   values that are maintained by the session code rather than being 
+	   stored in the configuration data, the values here are only 
+	   placeholders */
+	MK_OPTION_S( CRYPT_OPTION_SESSION_TICKETKEYFILE, NULL, 0, 402 ),
+	MK_OPTION( CRYPT_OPTION_SESSION_TICKETHITS, 0, CRYPT_UNUSED ),
+	MK_OPTION( CRYPT_OPTION_SESSION_TICKETMISSES, 0, CRYPT_UNUSED ),
+
+	/* TLS session cache options.  The cache is kept small in memory-
+	   constrained environments where each entry is a significant fraction 
+	   of the available memory */
+#if defined( CONFIG_CONSERVE_MEMORY )
+	MK_OPTION( CRYPT_OPTION_SESSION_CACHESIZE, 8, 403 ),
+#else
+	MK_OPTION( CRYPT_OPTION_SESSION_CACHESIZE, 64, 403 ),
+#endif /* CONFIG_CONSERVE_MEMORY */
+	MK_OPTION_S( CRYPT_OPTION_SESSION_CACHEFILE, NULL, 0, 404 ),
+
+	/* OCSP stapling options.  Stapling is disabled by default since it 
+	   requires the server to make outgoing connections to the CA's OCSP 
+	   responder */
+	MK_OPTION( CRYPT_OPTION_SESSION_OCSPSTAPLING, FALSE, 405 ),
+	MK_OPTION_S( CRYPT_OPTION_SESSION_OCSPRESPONDER, NULL, 0, 406 ),
+
 	/* End-of-list marker */
 	MK_OPTION_NONE(), MK_OPTION_NONE()
 	};
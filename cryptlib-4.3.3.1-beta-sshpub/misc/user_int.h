@@ -50,14 +50,15 @@ typedef struct {
    storage for it and initialise it from the builtinOptionInfo template */
 
 #define OPTION_INFO_SIZE	( sizeof( OPTION_INFO ) * \
-							  CRYPT_OPTION_CONFIGCHANGED - CRYPT_OPTION_FIRST )
+							  CRYPT_OPTION_LAST - CRYPT_OPTION_FIRST )
 
 /* The attribute ID of the last option that's written to disk, and an upper 
    bound on the corresponding persistent index value used for range checking.  
    Further options beyond this one are ephemeral and are never written to 
-   disk */
+   disk, ephemeral options before it are identified by having a persistent 
+   index value of CRYPT_UNUSED */
 
-#define LAST_STORED_OPTION			CRYPT_OPTION_MISC_SIDECHANNELPROTECTION
+#define LAST_STORED_OPTION			CRYPT_OPTION_SESSION_OCSPRESPONDER
 #define LAST_OPTION_INDEX			1000
 
 /* Get storage for the config option information */
@@ -283,36 +283,60 @@ static int writeConfigData( INOUT STREAM *stream,
 
 #ifdef USE_CERTIFICATES
 
+#define TRUSTEDCERT_BUFSIZE		( CRYPT_MAX_PKCSIZE + 1536 )
+
 CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
 static int readTrustedCerts( IN_HANDLE const CRYPT_KEYSET iCryptKeyset,
 							 INOUT void *trustInfoPtr )
 	{
-	MESSAGE_DATA msgData;
-	BYTE buffer[ CRYPT_MAX_PKCSIZE + 1536 + 8 ];
-	int status, LOOP_ITERATOR;
+	CRYPT_ATTRIBUTE_TYPE attribute = CRYPT_IATTRIBUTE_TRUSTEDCERT;
+	const void *certObjects[ MAX_TRUSTENTRY_BATCH + 8 ];
+	int certObjectLengths[ MAX_TRUSTENTRY_BATCH + 8 ];
+	BYTE *buffer;
+	int noCertObjects = 0, status = CRYPT_OK, LOOP_ITERATOR;
 
 	assert( trustInfoPtr != NULL );
 
 	REQUIRES( isHandleRangeValid( iCryptKeyset ) );
 
+	/* Since there may be a sizeable number of trusted certificates present 
+	   we read them in groups of MAX_TRUSTENTRY_BATCH and add each group in 
+	   one go, which allows the hashing needed to index them to be done as a 
+	   batch */
+	if( ( buffer = clAlloc( "readTrustedCerts", TRUSTEDCERT_BUFSIZE * \
+												MAX_TRUSTENTRY_BATCH ) ) == NULL )
+		return( CRYPT_ERROR_MEMORY );
+
 	/* Read each trusted certificate from the keyset */
-	setMessageData( &msgData, buffer, CRYPT_MAX_PKCSIZE + 1536 );
-	status = krnlSendMessage( iCryptKeyset, IMESSAGE_GETATTRIBUTE_S,
-							  &msgData, CRYPT_IATTRIBUTE_TRUSTEDCERT );
 	LOOP_LARGE_CHECK( cryptStatusOK( status ) )
 		{
-		/* Add the certificate data as a trusted certificate item and look 
-		   for the next one */
-		status = addTrustEntry( trustInfoPtr, CRYPT_UNUSED, msgData.data,
-								msgData.length, TRUE );
+		MESSAGE_DATA msgData;
+		BYTE *bufPtr = buffer + ( noCertObjects * TRUSTEDCERT_BUFSIZE );
+
+		/* Read the next certificate and, if we've got a full group or 
+		   there are no more certificates to be read, add the group as 
+		   trusted certificate items */
+		setMessageData( &msgData, bufPtr, TRUSTEDCERT_BUFSIZE );
+		status = krnlSendMessage( iCryptKeyset, IMESSAGE_GETATTRIBUTE_S,
+								  &msgData, attribute );
+		attribute = CRYPT_IATTRIBUTE_TRUSTEDCERT_NEXT;
 		if( cryptStatusOK( status ) )
 			{
-			setMessageData( &msgData, buffer, CRYPT_MAX_PKCSIZE + 1536 );
-			status = krnlSendMessage( iCryptKeyset, IMESSAGE_GETATTRIBUTE_S,
-									  &msgData, 
-									  CRYPT_IATTRIBUTE_TRUSTEDCERT_NEXT );
+			certObjects[ noCertObjects ] = msgData.data;
+			certObjectLengths[ noCertObjects++ ] = msgData.length;
+			}
+		if( noCertObjects > 0 && ( cryptStatusError( status ) || \
+								   noCertObjects >= MAX_TRUSTENTRY_BATCH ) )
+			{
+			const int addStatus = addTrustEntries( trustInfoPtr, certObjects, 
+												   certObjectLengths, 
+												   noCertObjects );
+			if( cryptStatusError( addStatus ) )
+				status = addStatus;
+			noCertObjects = 0;
 			}
 		}
+	clFree( "readTrustedCerts", buffer );
 	ENSURES( LOOP_BOUND_OK );
 
 	return( ( status == CRYPT_ERROR_NOTFOUND ) ? CRYPT_OK : status );
@@ -0,0 +1,370 @@
+/****************************************************************************
+*																			*
+*					cryptlib TLS Peer Certificate Chain Cache				*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#if defined( INC_ALL )
+  #include "crypt.h"
+  #include "certcache.h"
+#else
+  #include "crypt.h"
+  #include "session/certcache.h"
+#endif /* Compiler-specific includes */
+
+/* Every TLS handshake sends the peer's complete certificate chain, which
+   we have to import as a certificate object before we can use the key in
+   it.  Importing the chain is by far the most expensive part of processing
+   the Certificate message since it involves decoding every certificate in
+   the chain and loading and sanity-checking each certificate's public key,
+   and for a client that talks to the same server over and over again, or
+   a server that sees the same clients using client certificates, it's
+   repeated for an identical chain on every handshake.
+
+   To avoid this we cache the imported chain objects, keyed by a hash of
+   the encoded TLS certificate list as it appears on the wire along with the
+   certificate compliance level that the chain was imported at, so that a
+   chain that would now be rejected at a stricter compliance level won't be
+   accepted from the cache.  A repeat handshake with an identical chain
+   gets a new reference to the existing chain object rather than a freshly-
+   imported copy.  Cached chains are only used for a limited amount of time
+   and never beyond the expiry time of the leaf certificate, after which
+   they're re-imported.
+
+   Since the chain object is now shared across sessions, anything that
+   depends on the chain's selection state (which certificate in the chain
+   is selected, the attribute cursor) has to be done with the chain locked,
+   which saves the selection state on entry and restores it on exit */
+
+#ifdef USE_CERTCACHE
+
+/* The number of chains that we cache, and the time in seconds for which a
+   cached chain is used before it's re-imported */
+
+#define CERTCACHE_MAX_ENTRIES	32
+#define CERTCACHE_LIFETIME		3600
+
+/* The size of the hash used to identify an encoded chain */
+
+#define CERTCACHE_HASHSIZE		32
+
+/* The information for each cached chain */
+
+typedef struct {
+	BUFFER_FIXED( CERTCACHE_HASHSIZE ) \
+	BYTE chainHash[ CERTCACHE_HASHSIZE + 8 ];/* Hash of encoded chain */
+	int chainDataLength;			/* Length of encoded chain */
+	int complianceLevel;			/* Compliance level for import */
+	CRYPT_CERTIFICATE iCertChain;	/* Imported chain */
+	time_t expiryTime;				/* Time at which entry expires */
+	time_t lastUsedTime;			/* Time at which entry was last used */
+	} CERTCACHE_ENTRY;
+
+typedef struct {
+	CERTCACHE_ENTRY entries[ CERTCACHE_MAX_ENTRIES + 8 ];
+	BOOLEAN isShutdown;				/* Whether cache has been shut down */
+	} CERTCACHE_INFO;
+
+static CERTCACHE_INFO certCacheInfo;
+
+/****************************************************************************
+*																			*
+*								Utility Functions							*
+*																			*
+****************************************************************************/
+
+/* Get the information that we use to identify an encoded chain */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 4 ) ) \
+static int getChainID( IN_BUFFER( chainDataLength ) const void *chainData,
+					   IN_LENGTH_SHORT const int chainDataLength,
+					   OUT_BUFFER_FIXED( CERTCACHE_HASHSIZE ) BYTE *chainHash,
+					   OUT_RANGE( CRYPT_COMPLIANCELEVEL_OBLIVIOUS, \
+								  CRYPT_COMPLIANCELEVEL_LAST - 1 ) \
+							int *complianceLevel )
+	{
+	HASH_FUNCTION_ATOMIC hashFunctionAtomic;
+
+	assert( isReadPtr( chainData, chainDataLength ) );
+	assert( isWritePtr( chainHash, CERTCACHE_HASHSIZE ) );
+	assert( isWritePtr( complianceLevel, sizeof( int ) ) );
+
+	REQUIRES( chainDataLength > 0 && \
+			  chainDataLength < MAX_INTLENGTH_SHORT );
+
+	getHashAtomicParameters( CRYPT_ALGO_SHA2, bitsToBytes( 256 ),
+							 &hashFunctionAtomic, NULL );
+	hashFunctionAtomic( chainHash, CERTCACHE_HASHSIZE, chainData,
+						chainDataLength );
+
+	/* The chain is imported by the default user object, so it's the
+	   default user's compliance level that applies */
+	return( krnlSendMessage( DEFAULTUSER_OBJECT_HANDLE,
+							 IMESSAGE_GETATTRIBUTE, complianceLevel,
+							 CRYPT_OPTION_CERT_COMPLIANCELEVEL ) );
+	}
+
+/* Find the cache entry for an encoded chain.  This must be called with the
+   cache mutex held */
+
+CHECK_RETVAL_PTR STDC_NONNULL_ARG( ( 1 ) ) \
+static CERTCACHE_ENTRY *findEntry( IN_BUFFER( CERTCACHE_HASHSIZE ) \
+										const BYTE *chainHash,
+								   IN_LENGTH_SHORT const int chainDataLength,
+								   IN_RANGE( CRYPT_COMPLIANCELEVEL_OBLIVIOUS, \
+											 CRYPT_COMPLIANCELEVEL_LAST - 1 ) \
+										const int complianceLevel )
+	{
+	int i, LOOP_ITERATOR;
+
+	assert( isReadPtr( chainHash, CERTCACHE_HASHSIZE ) );
+
+	REQUIRES_N( chainDataLength > 0 && \
+			  chainDataLength < MAX_INTLENGTH_SHORT );
+
+	LOOP_MED( i = 0, i < CERTCACHE_MAX_ENTRIES, i++ )
+		{
+		CERTCACHE_ENTRY *entryPtr = &certCacheInfo.entries[ i ];
+
+		if( entryPtr->iCertChain != CRYPT_ERROR && \
+			entryPtr->chainDataLength == chainDataLength && \
+			entryPtr->complianceLevel == complianceLevel && \
+			!memcmp( entryPtr->chainHash, chainHash, CERTCACHE_HASHSIZE ) )
+			return( entryPtr );
+		}
+	ENSURES_N( LOOP_BOUND_OK );
+
+	return( NULL );
+	}
+
+/* Find a cache entry that can be used for a new chain, either an empty or
+   expired one or, if all entries are in use, the least recently used
+   one.  This must be called with the cache mutex held */
+
+CHECK_RETVAL_PTR \
+static CERTCACHE_ENTRY *findFreeEntry( const time_t currentTime )
+	{
+	CERTCACHE_ENTRY *lruEntryPtr = NULL;
+	int i, LOOP_ITERATOR;
+
+	LOOP_MED( i = 0, i < CERTCACHE_MAX_ENTRIES, i++ )
+		{
+		CERTCACHE_ENTRY *entryPtr = &certCacheInfo.entries[ i ];
+
+		if( entryPtr->iCertChain == CRYPT_ERROR || \
+			entryPtr->expiryTime <= currentTime )
+			return( entryPtr );
+		if( lruEntryPtr == NULL || \
+			entryPtr->lastUsedTime < lruEntryPtr->lastUsedTime )
+			lruEntryPtr = entryPtr;
+		}
+	ENSURES_N( LOOP_BOUND_OK );
+
+	return( lruEntryPtr );
+	}
+
+/* Clear a cache entry, releasing the cache's reference to the chain.  This
+   must be called with the cache mutex held */
+
+STDC_NONNULL_ARG( ( 1 ) ) \
+static void clearEntry( INOUT CERTCACHE_ENTRY *entryPtr )
+	{
+	assert( isWritePtr( entryPtr, sizeof( CERTCACHE_ENTRY ) ) );
+
+	if( entryPtr->iCertChain != CRYPT_ERROR )
+		krnlSendNotifier( entryPtr->iCertChain, IMESSAGE_DECREFCOUNT );
+	memset( entryPtr, 0, sizeof( CERTCACHE_ENTRY ) );
+	entryPtr->iCertChain = CRYPT_ERROR;
+	}
+
+/****************************************************************************
+*																			*
+*							Certificate Chain Cache							*
+*																			*
+****************************************************************************/
+
+/* Look up a previously-imported certificate chain */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int getCachedCertChain( OUT_HANDLE_OPT CRYPT_CERTIFICATE *iCertChain,
+						IN_BUFFER( chainDataLength ) const void *chainData,
+						IN_LENGTH_SHORT const int chainDataLength )
+	{
+	CERTCACHE_ENTRY *entryPtr;
+	BYTE chainHash[ CERTCACHE_HASHSIZE + 8 ];
+	const time_t currentTime = getTime();
+	int complianceLevel, status;
+
+	assert( isWritePtr( iCertChain, sizeof( CRYPT_CERTIFICATE ) ) );
+	assert( isReadPtr( chainData, chainDataLength ) );
+
+	REQUIRES( chainDataLength > 0 && \
+			  chainDataLength < MAX_INTLENGTH_SHORT );
+
+	/* Clear return value */
+	*iCertChain = CRYPT_ERROR;
+
+	/* If we can't tell whether a cached chain is still valid then we can't
+	   use the cache */
+	if( currentTime <= MIN_TIME_VALUE )
+		return( CRYPT_ERROR_NOTFOUND );
+
+	status = getChainID( chainData, chainDataLength, chainHash,
+						 &complianceLevel );
+	if( cryptStatusError( status ) )
+		return( CRYPT_ERROR_NOTFOUND );
+	status = krnlEnterMutex( MUTEX_CERTCACHE );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( certCacheInfo.isShutdown )
+		{
+		krnlExitMutex( MUTEX_CERTCACHE );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+	entryPtr = findEntry( chainHash, chainDataLength, complianceLevel );
+	if( entryPtr == NULL )
+		{
+		krnlExitMutex( MUTEX_CERTCACHE );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+	if( entryPtr->expiryTime <= currentTime )
+		{
+		/* The entry has expired, clear it so that the chain is imported
+		   again */
+		clearEntry( entryPtr );
+		krnlExitMutex( MUTEX_CERTCACHE );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+
+	/* Hand a new reference to the cached chain to the caller.  We have to
+	   do this while we hold the mutex since otherwise the chain could be
+	   evicted from the cache and destroyed before we get to it */
+	status = krnlSendNotifier( entryPtr->iCertChain, IMESSAGE_INCREFCOUNT );
+	if( cryptStatusOK( status ) )
+		{
+		*iCertChain = entryPtr->iCertChain;
+		entryPtr->lastUsedTime = currentTime;
+		}
+	krnlExitMutex( MUTEX_CERTCACHE );
+
+	return( cryptStatusOK( status ) ? CRYPT_OK : CRYPT_ERROR_NOTFOUND );
+	}
+
+/* Add a newly-imported certificate chain to the cache */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+int addCachedCertChain( IN_HANDLE const CRYPT_CERTIFICATE iCertChain,
+						IN_BUFFER( chainDataLength ) const void *chainData,
+						IN_LENGTH_SHORT const int chainDataLength )
+	{
+	CERTCACHE_ENTRY *entryPtr;
+	MESSAGE_DATA msgData;
+	BYTE chainHash[ CERTCACHE_HASHSIZE + 8 ];
+	const time_t currentTime = getTime();
+	time_t expiryTime = currentTime + CERTCACHE_LIFETIME, validTo;
+	int complianceLevel, status;
+
+	assert( isReadPtr( chainData, chainDataLength ) );
+
+	REQUIRES( isHandleRangeValid( iCertChain ) );
+	REQUIRES( chainDataLength > 0 && \
+			  chainDataLength < MAX_INTLENGTH_SHORT );
+
+	if( currentTime <= MIN_TIME_VALUE )
+		return( CRYPT_OK );
+
+	/* Don't cache the chain for longer than the leaf certificate is valid
+	   for, and don't cache it at all if it's already expired.  The chain
+	   has just been imported by the caller so the leaf certificate is
+	   still selected */
+	setMessageData( &msgData, &validTo, sizeof( time_t ) );
+	status = krnlSendMessage( iCertChain, IMESSAGE_GETATTRIBUTE_S,
+							  &msgData, CRYPT_CERTINFO_VALIDTO );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( validTo <= currentTime )
+		return( CRYPT_OK );
+	if( validTo < expiryTime )
+		expiryTime = validTo;
+
+	status = getChainID( chainData, chainDataLength, chainHash,
+						 &complianceLevel );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = krnlEnterMutex( MUTEX_CERTCACHE );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( certCacheInfo.isShutdown )
+		{
+		krnlExitMutex( MUTEX_CERTCACHE );
+		return( CRYPT_OK );
+		}
+
+	/* If another session has added the same chain in the meantime then we
+	   leave the existing entry in place */
+	if( findEntry( chainHash, chainDataLength, complianceLevel ) != NULL )
+		{
+		krnlExitMutex( MUTEX_CERTCACHE );
+		return( CRYPT_OK );
+		}
+
+	/* Take over a free entry, evicting whatever was there before, and
+	   record our own reference to the chain */
+	entryPtr = findFreeEntry( currentTime );
+	ENSURES_KRNLMUTEX( entryPtr != NULL, MUTEX_CERTCACHE );
+	clearEntry( entryPtr );
+	status = krnlSendNotifier( iCertChain, IMESSAGE_INCREFCOUNT );
+	if( cryptStatusOK( status ) )
+		{
+		memcpy( entryPtr->chainHash, chainHash, CERTCACHE_HASHSIZE );
+		entryPtr->chainDataLength = chainDataLength;
+		entryPtr->complianceLevel = complianceLevel;
+		entryPtr->iCertChain = iCertChain;
+		entryPtr->expiryTime = expiryTime;
+		entryPtr->lastUsedTime = currentTime;
+		}
+	krnlExitMutex( MUTEX_CERTCACHE );
+
+	return( status );
+	}
+
+/****************************************************************************
+*																			*
+*							Init/Shutdown Functions							*
+*																			*
+****************************************************************************/
+
+/* Initialise and shut down the certificate chain cache.  Since the cache
+   holds certificate objects it has to be cleared before the kernel starts
+   destroying objects */
+
+CHECK_RETVAL \
+int initCertCache( void )
+	{
+	int i, LOOP_ITERATOR;
+
+	memset( &certCacheInfo, 0, sizeof( CERTCACHE_INFO ) );
+	LOOP_MED( i = 0, i < CERTCACHE_MAX_ENTRIES, i++ )
+		certCacheInfo.entries[ i ].iCertChain = CRYPT_ERROR;
+	ENSURES( LOOP_BOUND_OK );
+
+	return( CRYPT_OK );
+	}
+
+void endCertCache( void )
+	{
+	int i, status, LOOP_ITERATOR;
+
+	REQUIRES_V( krnlIsExiting() );
+
+	status = krnlEnterMutex( MUTEX_CERTCACHE );
+	if( cryptStatusError( status ) )
+		return;
+	certCacheInfo.isShutdown = TRUE;
+	LOOP_MED( i = 0, i < CERTCACHE_MAX_ENTRIES, i++ )
+		clearEntry( &certCacheInfo.entries[ i ] );
+	ENSURES_KRNLMUTEX_V( LOOP_BOUND_OK, MUTEX_CERTCACHE );
+	krnlExitMutex( MUTEX_CERTCACHE );
+	}
+#endif /* USE_CERTCACHE */
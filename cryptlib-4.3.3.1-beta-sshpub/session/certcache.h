@@ -0,0 +1,63 @@
+/****************************************************************************
+*																			*
+*				cryptlib TLS Peer Certificate Chain Cache Header File		*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#ifndef _CERTCACHE_DEFINED
+
+#define _CERTCACHE_DEFINED
+
+/* The certificate chain cache is only useful for TLS, which is the only
+   protocol that sends the peer's full certificate chain on every
+   handshake.  Since each cached chain is a complete certificate object we
+   disable it on memory-constrained systems */
+
+#if defined( USE_SSL ) && !defined( CONFIG_CONSERVE_MEMORY )
+  #define USE_CERTCACHE
+#endif /* USE_SSL && !CONFIG_CONSERVE_MEMORY */
+
+/****************************************************************************
+*																			*
+*						Certificate Chain Cache Functions					*
+*																			*
+****************************************************************************/
+
+#ifdef USE_CERTCACHE
+
+/* Look up the certificate chain object that was previously imported from
+   an encoded TLS certificate list.  If there's a current entry present
+   this returns a new reference to the cached chain, otherwise it returns
+   CRYPT_ERROR_NOTFOUND and the caller has to import the chain itself.
+   Since the chain is shared with other sessions, any operation that
+   depends on the chain's selection state has to be performed with the
+   chain locked */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int getCachedCertChain( OUT_HANDLE_OPT CRYPT_CERTIFICATE *iCertChain,
+						IN_BUFFER( chainDataLength ) const void *chainData,
+						IN_LENGTH_SHORT const int chainDataLength );
+
+/* Add a certificate chain imported from an encoded TLS certificate list to
+   the cache */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+int addCachedCertChain( IN_HANDLE const CRYPT_CERTIFICATE iCertChain,
+						IN_BUFFER( chainDataLength ) const void *chainData,
+						IN_LENGTH_SHORT const int chainDataLength );
+
+/* Prototypes for init/shutdown functions */
+
+CHECK_RETVAL \
+int initCertCache( void );
+void endCertCache( void );
+#else
+  #define getCachedCertChain( iCertChain, chainData, chainDataLength ) \
+		  CRYPT_ERROR_NOTFOUND
+  #define addCachedCertChain( iCertChain, chainData, chainDataLength ) \
+		  CRYPT_OK
+  #define initCertCache()				CRYPT_OK
+  #define endCertCache()
+#endif /* USE_CERTCACHE */
+#endif /* _CERTCACHE_DEFINED */
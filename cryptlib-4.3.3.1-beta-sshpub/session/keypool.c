@@ -0,0 +1,539 @@
+/****************************************************************************
+*																			*
+*					cryptlib Session Ephemeral Key Pool						*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#if defined( INC_ALL )
+  #include "crypt.h"
+  #include "keypool.h"
+#else
+  #include "crypt.h"
+  #include "session/keypool.h"
+#endif /* Compiler-specific includes */
+
+/* Servers that use DHE/ECDHE (or SSH DH/ECDH, for which it's the only
+   option) have to generate a new ephemeral key for every handshake, which
+   makes the keygen the single most expensive operation in the server side
+   of the handshake and one that's performed while the client is sitting
+   waiting for a response.  To move this out of the handshake we maintain a
+   pool of pre-generated keys for each key-agreement group that's in use,
+   which is topped up by a background thread whenever the number of keys in
+   the pool drops to the configured low-water mark.
+
+   Each pooled key is a fully-initialised DH or ECDH context that's handed
+   over to the caller and removed from the pool, so a key can only ever be
+   used once.  The pool is bounded both in the number of groups that it
+   tracks and in the number of keys per group, and slots for a group are
+   only allocated once a session has actually requested a key for that
+   group, so there's no overhead for groups (or applications) that never
+   use it */
+
+#ifdef USE_KEYPOOL
+
+/* The number of distinct key-agreement groups (DH key sizes and ECC curves)
+   that we track.  In practice there'll only ever be one or two in use at
+   any one time */
+
+#define KEYPOOL_MAX_SLOTS		8
+
+/* The time in ms that the fill thread waits before rechecking the pool
+   when there's nothing to do.  This is the maximum latency between the
+   pool dropping below the low-water mark and the refill starting */
+
+#define KEYPOOL_IDLE_WAIT		250
+
+/* The information for each key-agreement group.  The 'refilling' flag
+   provides hysteresis, once a slot drops to the low-water mark it's
+   refilled all the way to the pool size rather than being topped up one
+   key at a time */
+
+typedef struct {
+	CRYPT_ALGO_TYPE cryptAlgo;		/* CRYPT_ALGO_DH or CRYPT_ALGO_ECDH */
+	int keyParam;					/* DH key size or ECC curve type */
+	CRYPT_CONTEXT iKeys[ MAX_KEYPOOL_SIZE + 8 ];
+	int noKeys;						/* Number of keys in the pool */
+	BOOLEAN refilling;				/* Whether slot is being refilled */
+	} KEYPOOL_SLOT;
+
+typedef struct {
+	KEYPOOL_SLOT slots[ KEYPOOL_MAX_SLOTS + 8 ];
+	int hits, misses;				/* Pool usage statistics */
+	BOOLEAN fillThreadActive;		/* Whether fill thread is running */
+	BOOLEAN isShutdown;				/* Whether pool has been shut down */
+	} KEYPOOL_INFO;
+
+static KEYPOOL_INFO keyPoolInfo;
+static THREAD_STATE keyPoolThreadState;
+
+/****************************************************************************
+*																			*
+*								Utility Functions							*
+*																			*
+****************************************************************************/
+
+/* Get the key pool configuration settings.  These are taken from the
+   default user object since the pool is shared across all sessions */
+
+STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static void getKeyPoolConfig( OUT_INT_SHORT_Z int *poolSize,
+							  OUT_INT_SHORT_Z int *lowWater )
+	{
+	int value, status;
+
+	assert( isWritePtr( poolSize, sizeof( int ) ) );
+	assert( isWritePtr( lowWater, sizeof( int ) ) );
+
+	/* Clear return values */
+	*poolSize = *lowWater = 0;
+
+	status = krnlSendMessage( DEFAULTUSER_OBJECT_HANDLE,
+							  IMESSAGE_GETATTRIBUTE, &value,
+							  CRYPT_OPTION_SESSION_KEYPOOLSIZE );
+	if( cryptStatusError( status ) || value <= 0 )
+		return;
+	*poolSize = min( value, MAX_KEYPOOL_SIZE );
+	status = krnlSendMessage( DEFAULTUSER_OBJECT_HANDLE,
+							  IMESSAGE_GETATTRIBUTE, &value,
+							  CRYPT_OPTION_SESSION_KEYPOOLLOWWATER );
+	if( cryptStatusOK( status ) )
+		*lowWater = min( value, *poolSize - 1 );
+	}
+
+/* Map a requested DH key size to the size of the built-in DH domain
+   parameters that'll be used for it.  This has to mirror the selection
+   performed in loadDHparams() so that requests for slightly different key
+   sizes that end up using the same group share a slot */
+
+CHECK_RETVAL_RANGE( MIN_PKCSIZE, CRYPT_MAX_PKCSIZE ) \
+static int getDHgroupSize( IN_LENGTH_PKC const int requestedKeySize )
+	{
+	REQUIRES_EXT( requestedKeySize >= MIN_PKCSIZE && \
+				  requestedKeySize <= CRYPT_MAX_PKCSIZE, MIN_PKCSIZE );
+
+#ifdef USE_DH1024
+	if( requestedKeySize <= 128 + 8 )
+		return( bitsToBytes( 1024 ) );
+#endif /* USE_DH1024 */
+	if( requestedKeySize <= 192 + 8 )
+		return( bitsToBytes( 1536 ) );
+#if CRYPT_MAX_PKCSIZE >= bitsToBytes( 3072 )
+	if( requestedKeySize <= 256 + 8 )
+		return( bitsToBytes( 2048 ) );
+	return( bitsToBytes( 3072 ) );
+#else
+	return( bitsToBytes( 2048 ) );
+#endif /* 3072-bit bignums */
+	}
+
+/* Find the slot for a key-agreement group, optionally allocating a new
+   slot if there isn't one present yet.  This must be called with the key
+   pool mutex held */
+
+CHECK_RETVAL_PTR \
+static KEYPOOL_SLOT *findSlot( IN_ALGO const CRYPT_ALGO_TYPE cryptAlgo,
+							   IN_INT_SHORT const int keyParam,
+							   const BOOLEAN allocateSlot )
+	{
+	KEYPOOL_SLOT *freeSlot = NULL;
+	int i, LOOP_ITERATOR;
+
+	REQUIRES_N( cryptAlgo == CRYPT_ALGO_DH || \
+				cryptAlgo == CRYPT_ALGO_ECDH );
+	REQUIRES_N( keyParam > 0 && keyParam < MAX_INTLENGTH_SHORT );
+	REQUIRES_N( allocateSlot == TRUE || allocateSlot == FALSE );
+
+	LOOP_SMALL( i = 0, i < KEYPOOL_MAX_SLOTS, i++ )
+		{
+		KEYPOOL_SLOT *slotPtr = &keyPoolInfo.slots[ i ];
+
+		if( slotPtr->cryptAlgo == cryptAlgo && \
+			slotPtr->keyParam == keyParam )
+			return( slotPtr );
+		if( slotPtr->cryptAlgo == CRYPT_ALGO_NONE && freeSlot == NULL )
+			freeSlot = slotPtr;
+		}
+	ENSURES_N( LOOP_BOUND_OK );
+
+	/* If there's no existing slot for this group, allocate a new one if
+	   possible */
+	if( !allocateSlot || freeSlot == NULL )
+		return( NULL );
+	memset( freeSlot, 0, sizeof( KEYPOOL_SLOT ) );
+	freeSlot->cryptAlgo = cryptAlgo;
+	freeSlot->keyParam = keyParam;
+
+	return( freeSlot );
+	}
+
+/* Generate a new ephemeral DH/ECDH key.  Loading the domain parameters into
+   the context generates the key as a side-effect */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int generateKey( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
+						IN_ALGO const CRYPT_ALGO_TYPE cryptAlgo,
+						IN_INT_SHORT const int keyParam )
+	{
+	MESSAGE_CREATEOBJECT_INFO createInfo;
+	MESSAGE_DATA msgData;
+	int status;
+
+	assert( isWritePtr( iCryptContext, sizeof( CRYPT_CONTEXT ) ) );
+
+	REQUIRES( cryptAlgo == CRYPT_ALGO_DH || cryptAlgo == CRYPT_ALGO_ECDH );
+	REQUIRES( keyParam > 0 && keyParam < MAX_INTLENGTH_SHORT );
+
+	/* Clear return value */
+	*iCryptContext = CRYPT_ERROR;
+
+	setMessageCreateObjectInfo( &createInfo, cryptAlgo );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_DEV_CREATEOBJECT,
+							  &createInfo, OBJECT_TYPE_CONTEXT );
+	if( cryptStatusError( status ) )
+		return( status );
+	setMessageData( &msgData, "Ephemeral key agreement key", 27 );
+	status = krnlSendMessage( createInfo.cryptHandle, IMESSAGE_SETATTRIBUTE_S,
+							  &msgData, CRYPT_CTXINFO_LABEL );
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( createInfo.cryptHandle,
+								  IMESSAGE_SETATTRIBUTE,
+								  ( MESSAGE_CAST ) &keyParam,
+								  ( cryptAlgo == CRYPT_ALGO_ECDH ) ? \
+									CRYPT_IATTRIBUTE_KEY_ECCPARAM : \
+									CRYPT_IATTRIBUTE_KEY_DLPPARAM );
+		}
+	if( cryptStatusError( status ) )
+		{
+		krnlSendNotifier( createInfo.cryptHandle, IMESSAGE_DECREFCOUNT );
+		return( status );
+		}
+	*iCryptContext = createInfo.cryptHandle;
+
+	return( CRYPT_OK );
+	}
+
+/****************************************************************************
+*																			*
+*								Pool Fill Thread							*
+*																			*
+****************************************************************************/
+
+/* Find a slot that needs refilling and mark it as being refilled.  This
+   must be called with the key pool mutex held */
+
+CHECK_RETVAL_PTR \
+static KEYPOOL_SLOT *findSlotToFill( IN_RANGE( 1, MAX_KEYPOOL_SIZE ) \
+										const int poolSize,
+									 IN_RANGE( 0, MAX_KEYPOOL_SIZE - 1 ) \
+										const int lowWater )
+	{
+	int i, LOOP_ITERATOR;
+
+	REQUIRES_N( poolSize >= 1 && poolSize <= MAX_KEYPOOL_SIZE );
+	REQUIRES_N( lowWater >= 0 && lowWater < poolSize );
+
+	LOOP_SMALL( i = 0, i < KEYPOOL_MAX_SLOTS, i++ )
+		{
+		KEYPOOL_SLOT *slotPtr = &keyPoolInfo.slots[ i ];
+
+		if( slotPtr->cryptAlgo == CRYPT_ALGO_NONE )
+			continue;
+		if( slotPtr->noKeys <= lowWater )
+			slotPtr->refilling = TRUE;
+		if( slotPtr->refilling && slotPtr->noKeys < poolSize )
+			return( slotPtr );
+		slotPtr->refilling = FALSE;
+		}
+	ENSURES_N( LOOP_BOUND_OK );
+
+	return( NULL );
+	}
+
+/* The pool fill thread.  This runs until the kernel shuts down, generating
+   keys for any slot that's dropped to the low-water mark and sleeping
+   otherwise.  Since all loops are bounded the thread will eventually exit
+   even if the kernel isn't shutting down, in which case it's restarted on
+   the next request for a pooled key */
+
+static void keyPoolFillThread( const THREAD_PARAMS *threadParams )
+	{
+	int iterationCount, LOOP_ITERATOR;
+
+	assert( isReadPtr( threadParams, sizeof( THREAD_PARAMS ) ) );
+
+	LOOP_MAX( iterationCount = 0, !krnlIsExiting(), iterationCount++ )
+		{
+		KEYPOOL_SLOT *slotPtr = NULL;
+		CRYPT_ALGO_TYPE cryptAlgo DUMMY_INIT;
+		CRYPT_CONTEXT iCryptContext;
+		int poolSize, lowWater, keyParam DUMMY_INIT, status;
+
+		/* Find a slot that needs refilling */
+		getKeyPoolConfig( &poolSize, &lowWater );
+		if( poolSize > 0 )
+			{
+			status = krnlEnterMutex( MUTEX_KEYPOOL );
+			if( cryptStatusError( status ) )
+				break;
+			slotPtr = findSlotToFill( poolSize, lowWater );
+			if( slotPtr != NULL )
+				{
+				cryptAlgo = slotPtr->cryptAlgo;
+				keyParam = slotPtr->keyParam;
+				}
+			krnlExitMutex( MUTEX_KEYPOOL );
+			}
+		if( slotPtr == NULL )
+			{
+			/* There's nothing to do, wait for a while before checking
+			   again */
+			( void ) krnlWait( KEYPOOL_IDLE_WAIT );
+			continue;
+			}
+
+		/* Generate the key without holding the mutex, since this is the
+		   slow part of the process */
+		status = generateKey( &iCryptContext, cryptAlgo, keyParam );
+		if( cryptStatusError( status ) )
+			{
+			/* If we can't generate the key there's no point in retrying
+			   immediately, back off for a while.  The consumer will fall
+			   back to generating the key inline */
+			( void ) krnlWait( KEYPOOL_IDLE_WAIT );
+			continue;
+			}
+
+		/* Add the new key to the pool, rechecking the slot state since the
+		   pool may have been shut down or filled while we weren't holding
+		   the mutex */
+		status = krnlEnterMutex( MUTEX_KEYPOOL );
+		if( cryptStatusError( status ) )
+			{
+			krnlSendNotifier( iCryptContext, IMESSAGE_DECREFCOUNT );
+			break;
+			}
+		if( !keyPoolInfo.isShutdown && \
+			slotPtr->cryptAlgo == cryptAlgo && \
+			slotPtr->keyParam == keyParam && \
+			slotPtr->noKeys < poolSize )
+			{
+			slotPtr->iKeys[ slotPtr->noKeys++ ] = iCryptContext;
+			iCryptContext = CRYPT_ERROR;
+			}
+		krnlExitMutex( MUTEX_KEYPOOL );
+		if( iCryptContext != CRYPT_ERROR )
+			krnlSendNotifier( iCryptContext, IMESSAGE_DECREFCOUNT );
+		}
+
+	/* Let the consumers know that they need to restart the thread if they
+	   want more keys */
+	if( cryptStatusOK( krnlEnterMutex( MUTEX_KEYPOOL ) ) )
+		{
+		keyPoolInfo.fillThreadActive = FALSE;
+		krnlExitMutex( MUTEX_KEYPOOL );
+		}
+	}
+
+/****************************************************************************
+*																			*
+*								Key Pool Access								*
+*																			*
+****************************************************************************/
+
+/* Get a pre-generated ephemeral DH/ECDH key from the pool */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int getKeyPoolContext( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
+					   IN_ALGO const CRYPT_ALGO_TYPE cryptAlgo,
+					   IN_INT_SHORT const int keyParam )
+	{
+	KEYPOOL_SLOT *slotPtr;
+	BOOLEAN startFillThread = FALSE;
+	int poolSize, lowWater, slotKeyParam = keyParam, status;
+
+	assert( isWritePtr( iCryptContext, sizeof( CRYPT_CONTEXT ) ) );
+
+	REQUIRES( cryptAlgo == CRYPT_ALGO_DH || cryptAlgo == CRYPT_ALGO_ECDH );
+	REQUIRES( ( cryptAlgo == CRYPT_ALGO_DH && \
+				keyParam >= MIN_PKCSIZE && \
+				keyParam <= CRYPT_MAX_PKCSIZE ) || \
+			  ( cryptAlgo == CRYPT_ALGO_ECDH && \
+				keyParam > CRYPT_ECCCURVE_NONE && \
+				keyParam < CRYPT_ECCCURVE_LAST ) );
+
+	/* Clear return value */
+	*iCryptContext = CRYPT_ERROR;
+
+	/* If the pool is disabled or there's no ECDH support, there's nothing
+	   to do */
+	getKeyPoolConfig( &poolSize, &lowWater );
+	if( poolSize <= 0 )
+		return( CRYPT_ERROR_NOTFOUND );
+#ifndef USE_ECDH
+	if( cryptAlgo == CRYPT_ALGO_ECDH )
+		return( CRYPT_ERROR_NOTFOUND );
+#endif /* !USE_ECDH */
+
+	/* DH keys of slightly different sizes map to the same built-in group,
+	   so we index the pool by group rather than by the requested size */
+	if( cryptAlgo == CRYPT_ALGO_DH )
+		{
+		slotKeyParam = getDHgroupSize( keyParam );
+		ENSURES( slotKeyParam >= MIN_PKCSIZE && \
+				 slotKeyParam <= CRYPT_MAX_PKCSIZE );
+		}
+
+	/* Take a key from the pool if there's one available.  Once removed
+	   from the pool the key belongs to the caller, so it can never be
+	   handed out a second time */
+	status = krnlEnterMutex( MUTEX_KEYPOOL );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( keyPoolInfo.isShutdown )
+		{
+		krnlExitMutex( MUTEX_KEYPOOL );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+	slotPtr = findSlot( cryptAlgo, slotKeyParam, TRUE );
+	if( slotPtr != NULL )
+		{
+		if( slotPtr->noKeys > 0 )
+			{
+			slotPtr->noKeys--;
+			*iCryptContext = slotPtr->iKeys[ slotPtr->noKeys ];
+			slotPtr->iKeys[ slotPtr->noKeys ] = CRYPT_ERROR;
+			if( keyPoolInfo.hits < MAX_INTLENGTH - 1 )
+				keyPoolInfo.hits++;
+			}
+		else
+			{
+			if( keyPoolInfo.misses < MAX_INTLENGTH - 1 )
+				keyPoolInfo.misses++;
+			}
+
+		/* If the pool for this group has run low and there's no fill
+		   thread running, start one */
+		if( slotPtr->noKeys <= lowWater && \
+			!keyPoolInfo.fillThreadActive )
+			{
+			keyPoolInfo.fillThreadActive = TRUE;
+			startFillThread = TRUE;
+			}
+		}
+	else
+		{
+		/* All of the slots are in use by other groups so this group can't 
+		   be pooled, the caller has to generate the key inline */
+		if( keyPoolInfo.misses < MAX_INTLENGTH - 1 )
+			keyPoolInfo.misses++;
+		}
+	krnlExitMutex( MUTEX_KEYPOOL );
+	if( startFillThread )
+		{
+		/* If there's a previous instance of the fill thread that's exited,
+		   wait for it to finish before we reuse its thread storage */
+		( void ) krnlWaitSemaphore( SEMAPHORE_KEYPOOL );
+		status = krnlDispatchThread( keyPoolFillThread, keyPoolThreadState,
+									 NULL, 0, SEMAPHORE_KEYPOOL );
+		if( cryptStatusError( status ) && \
+			cryptStatusOK( krnlEnterMutex( MUTEX_KEYPOOL ) ) )
+			{
+			keyPoolInfo.fillThreadActive = FALSE;
+			krnlExitMutex( MUTEX_KEYPOOL );
+			}
+		}
+
+	return( ( *iCryptContext != CRYPT_ERROR ) ? \
+			CRYPT_OK : CRYPT_ERROR_NOTFOUND );
+	}
+
+/* Get key pool usage statistics */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+int getKeyPoolStatistic( IN_ATTRIBUTE const CRYPT_ATTRIBUTE_TYPE attribute,
+						 OUT_INT_Z int *value )
+	{
+	int status;
+
+	assert( isWritePtr( value, sizeof( int ) ) );
+
+	REQUIRES( attribute == CRYPT_OPTION_SESSION_KEYPOOLHITS || \
+			  attribute == CRYPT_OPTION_SESSION_KEYPOOLMISSES );
+
+	/* Clear return value */
+	*value = 0;
+
+	status = krnlEnterMutex( MUTEX_KEYPOOL );
+	if( cryptStatusError( status ) )
+		return( status );
+	*value = ( attribute == CRYPT_OPTION_SESSION_KEYPOOLHITS ) ? \
+			 keyPoolInfo.hits : keyPoolInfo.misses;
+	krnlExitMutex( MUTEX_KEYPOOL );
+
+	return( CRYPT_OK );
+	}
+
+/****************************************************************************
+*																			*
+*							Init/Shutdown Functions							*
+*																			*
+****************************************************************************/
+
+/* Initialise and shut down the key pool.  The fill thread isn't started
+   until the first key is requested, and when we shut down we have to wait
+   for it to exit (which it does once krnlIsExiting() is set) before we can
+   destroy the pooled keys */
+
+CHECK_RETVAL \
+int initKeyPool( void )
+	{
+	int i, j, LOOP_ITERATOR, LOOP_ITERATOR_ALT;
+
+	memset( &keyPoolInfo, 0, sizeof( KEYPOOL_INFO ) );
+	LOOP_SMALL( i = 0, i < KEYPOOL_MAX_SLOTS, i++ )
+		{
+		KEYPOOL_SLOT *slotPtr = &keyPoolInfo.slots[ i ];
+
+		slotPtr->cryptAlgo = CRYPT_ALGO_NONE;
+		LOOP_MED_ALT( j = 0, j < MAX_KEYPOOL_SIZE, j++ )
+			slotPtr->iKeys[ j ] = CRYPT_ERROR;
+		ENSURES( LOOP_BOUND_OK_ALT );
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	return( CRYPT_OK );
+	}
+
+void endKeyPool( void )
+	{
+	int i, j, status, LOOP_ITERATOR, LOOP_ITERATOR_ALT;
+
+	REQUIRES_V( krnlIsExiting() );
+
+	/* Wait for the fill thread to exit */
+	( void ) krnlWaitSemaphore( SEMAPHORE_KEYPOOL );
+
+	/* Destroy any keys that are still in the pool */
+	status = krnlEnterMutex( MUTEX_KEYPOOL );
+	if( cryptStatusError( status ) )
+		return;
+	keyPoolInfo.isShutdown = TRUE;
+	LOOP_SMALL( i = 0, i < KEYPOOL_MAX_SLOTS, i++ )
+		{
+		KEYPOOL_SLOT *slotPtr = &keyPoolInfo.slots[ i ];
+
+		LOOP_MED_ALT( j = 0, j < slotPtr->noKeys && \
+							 j < MAX_KEYPOOL_SIZE, j++ )
+			{
+			krnlSendNotifier( slotPtr->iKeys[ j ], IMESSAGE_DECREFCOUNT );
+			slotPtr->iKeys[ j ] = CRYPT_ERROR;
+			}
+		ENSURES_KRNLMUTEX_V( LOOP_BOUND_OK_ALT, MUTEX_KEYPOOL );
+		slotPtr->noKeys = 0;
+		}
+	ENSURES_KRNLMUTEX_V( LOOP_BOUND_OK, MUTEX_KEYPOOL );
+	krnlExitMutex( MUTEX_KEYPOOL );
+	}
+#endif /* USE_KEYPOOL */
@@ -0,0 +1,58 @@
+/****************************************************************************
+*																			*
+*					cryptlib Session Ephemeral Key Pool Header File			*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#ifndef _KEYPOOL_DEFINED
+
+#define _KEYPOOL_DEFINED
+
+/* The key pool is only useful if there's something that consumes DH/ECDH
+   keys and a means of generating them in the background */
+
+#if ( defined( USE_SSH ) || defined( USE_SSL ) ) && \
+	defined( USE_THREAD_FUNCTIONS )
+  #define USE_KEYPOOL
+#endif /* ( USE_SSH || USE_SSL ) && USE_THREAD_FUNCTIONS */
+
+/****************************************************************************
+*																			*
+*								Key Pool Functions							*
+*																			*
+****************************************************************************/
+
+#ifdef USE_KEYPOOL
+
+/* Get a pre-generated ephemeral DH or ECDH key from the pool.  The key
+   parameter is the requested DH key size in bytes or the ECC curve type,
+   matching the value that would be used with CRYPT_IATTRIBUTE_KEY_DLPPARAM
+   to generate the key inline.  If there's no key available this returns
+   CRYPT_ERROR_NOTFOUND and the caller has to generate the key itself */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int getKeyPoolContext( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
+					   IN_ALGO const CRYPT_ALGO_TYPE cryptAlgo,
+					   IN_INT_SHORT const int keyParam );
+
+/* Get key pool usage statistics */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+int getKeyPoolStatistic( IN_ATTRIBUTE const CRYPT_ATTRIBUTE_TYPE attribute,
+						 OUT_INT_Z int *value );
+
+/* Prototypes for init/shutdown functions */
+
+CHECK_RETVAL \
+int initKeyPool( void );
+void endKeyPool( void );
+#else
+  #define getKeyPoolContext( iCryptContext, cryptAlgo, keyParam ) \
+		  CRYPT_ERROR_NOTFOUND
+  #define getKeyPoolStatistic( attribute, value ) \
+		  ( *( value ) = 0, CRYPT_OK )
+  #define initKeyPool()					CRYPT_OK
+  #define endKeyPool()
+#endif /* USE_KEYPOOL */
+#endif /* _KEYPOOL_DEFINED */
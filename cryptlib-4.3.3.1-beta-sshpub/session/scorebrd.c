@@ -19,30 +19,61 @@
 
 #ifdef USE_SSL
 
-/* The minimum and maximum permitted number of entries in the scoreboard */
-
-#define SCOREBOARD_MIN_SIZE		8
-#define SCOREBOARD_MAX_SIZE		128
-
-/* The minimum and maximum sizes of any identifiers and data values to be 
-   stored in the scoreboard.  Since the scoreboard is currently only used 
-   for SSL session resumption, these are MIN_SESSIONID_SIZE = 4 bytes, 
+/* The scoreboard is split into a number of shards, each of which has its
+   own set of indices, its own LRU list, and its own mutex, so that threads
+   working with different sessions don't all serialise on a single
+   scoreboard lock.  Entries are assigned to a shard based on the hash of
+   the key that they'll be looked up by, the session ID for server entries
+   and the FQDN for client entries */
+
+#define SCOREBOARD_SHARDS		4
+
+/* The minimum and maximum permitted number of entries in the scoreboard
+   and in each shard */
+
+#define SCOREBOARD_MIN_SIZE		MIN_SESSIONCACHE_SIZE
+#define SCOREBOARD_MAX_SIZE		MAX_SESSIONCACHE_SIZE
+#define SCOREBOARD_SHARD_MIN	( SCOREBOARD_MIN_SIZE / SCOREBOARD_SHARDS )
+#define SCOREBOARD_SHARD_MAX	( SCOREBOARD_MAX_SIZE / SCOREBOARD_SHARDS )
+
+/* The minimum and maximum sizes of any identifiers and data values to be
+   stored in the scoreboard.  Since the scoreboard is currently only used
+   for SSL session resumption, these are MIN_SESSIONID_SIZE = 4 bytes,
    MAX_SESSIONID_SIZE = 32 bytes, and SSL_SECRET_SIZE = 48 bytes */
 
 #define SCOREBOARD_KEY_MIN		MIN_SESSIONID_SIZE
 #define SCOREBOARD_KEY_SIZE		MAX_SESSIONID_SIZE
 #define SCOREBOARD_DATA_SIZE	SSL_SECRET_SIZE
 
-/* An individual scoreboard entry containing index information and its 
-   corresponding data.  This is stored in separate memory blocks because one 
-   is allocated in secure nonpageable storage and the other isn't, with 
-   scoreboardIndex[] containing pointers into corresponding entries in 
-   scoreboardData[] */
+/* The scoreboard data is held in secure memory, which is allocated in
+   blocks of SCOREBOARD_DATA_BLOCKSIZE entries since a large scoreboard
+   would otherwise exceed the upper limit on the size of a single secure
+   memory allocation */
+
+#define SCOREBOARD_DATA_BLOCKSIZE	128
+
+/* Each shard has a hash index for each type of key that an entry can be
+   located by.  Client and server session IDs have their own indices in
+   order to provide logically distinct namespaces for client and server
+   sessions, and the unique ID index is used to locate entries for
+   deletion */
+
+#define SCOREBOARD_TABLE_SESSIONID_CLI	0
+#define SCOREBOARD_TABLE_SESSIONID_SVR	1
+#define SCOREBOARD_TABLE_FQDN			2
+#define SCOREBOARD_TABLE_UNIQUEID		3
+#define SCOREBOARD_TABLE_LAST			4
+
+/* An individual scoreboard entry containing index information and its
+   corresponding data.  This is stored in separate memory blocks because one
+   is allocated in secure nonpageable storage and the other isn't, with
+   scoreboardIndex[] containing pointers into corresponding entries in
+   the scoreboard data blocks */
 
 typedef BYTE SCOREBOARD_DATA[ SCOREBOARD_DATA_SIZE ];
 typedef struct {
-	/* Identification information: The checksum and hash of the session ID 
-	   (to locate an entry based on the sessionID sent by the client) and 
+	/* Identification information: The checksum and hash of the session ID
+	   (to locate an entry based on the sessionID sent by the client) and
 	   checksum and hash of the FQDN (to locate an entry based on the server
 	   FQDN) */
 	int sessionCheckValue;
@@ -53,24 +84,31 @@ typedef struct {
 	BYTE fqdnHash[ HASH_DATA_SIZE + 4 ];
 
 	/* Since a lookup may have to return a session ID value if we're going
-	   from an FQDN to session a ID, we have to store the full session ID 
+	   from an FQDN to session a ID, we have to store the full session ID
 	   value alongside its checksum and hash */
 	BUFFER( SCOREBOARD_KEY_SIZE, sessionIDlength ) \
 	BYTE sessionID[ SCOREBOARD_KEY_SIZE + 4 ];
 	int sessionIDlength;
 
-	/* The scoreboard data, just a pointer into the secure SCOREBOARD_DATA 
+	/* The scoreboard data, just a pointer into the secure SCOREBOARD_DATA
 	   memory, along with a word of metadata that can be used to convey
-	   additional information about the data.  The dataLength variable 
-	   records how much data is actually present out of the 
+	   additional information about the data.  The dataLength variable
+	   records how much data is actually present out of the
 	   SCOREBOARD_DATA_SIZE bytes that are available for use */
 	BUFFER( SCOREBOARD_DATA_SIZE, dataLength ) \
 	void *data;
 	int dataLength;
 	int metaData;
 
+	/* Index and LRU information.  A used entry is linked into the hash
+	   chain for its session ID, for its FQDN if it's client data, and for
+	   its unique ID, and into the shard's LRU list.  A free entry is linked
+	   into the shard's free list via lruNext */
+	int nextSessionID, nextFQDN, nextUniqueID;
+	int lruPrev, lruNext;
+
 	/* Miscellaneous information.  We record whether an entry corresponds to
-	   server or client data in order to provide logically separate 
+	   server or client data in order to provide logically separate
 	   namespaces for client and server */
 	time_t timeStamp;		/* Time entry was added to the scoreboard */
 	BOOLEAN isServerData;	/* Whether this is client or server value */
@@ -82,24 +120,59 @@ typedef struct {
 
 #define SCOREBOARD_TIMEOUT		3600
 
-/* Overall scoreboard information.  Note that the SCOREBOARD_STATE size 
-   define in scorebrd.h will need to be updated if this structure is 
+/* An individual scoreboard shard */
+
+typedef struct {
+	/* Scoreboard index and data storage, and the number of entries in the
+	   shard */
+	void *index;				/* Scoreboard index */
+	void *dataBlocks;			/* Scoreboard data blocks */
+	int noDataBlocks;			/* Number of data blocks */
+	int noEntries;				/* Total entries in shard */
+	int noUsedEntries;			/* Entries currently in use */
+
+	/* The hash indices for the shard, SCOREBOARD_TABLE_LAST tables of
+	   hashSize entries each, with hashSize being a power of two */
+	int *hashTables;			/* Hash index heads */
+	int hashSize;				/* Number of entries per index */
+
+	/* The LRU list, from the most to the least recently used entry, and
+	   the list of free entries */
+	int lruHead, lruTail;		/* Most, least recently used entry */
+	int freeHead;				/* First free entry */
+
+	/* A unique ID for each scoreboard entry.  This is incremented for each
+	   index entry added, so that even if an entry is deleted and then
+	   another one with the same index value added, the uniqueID for the
+	   two will be different.  The value that's returned to the caller has
+	   the shard number folded into it so that we can tell which shard it
+	   belongs to */
+	int uniqueID;				/* Unique ID for scoreboard entry */
+	} SCOREBOARD_SHARD;
+
+/* Overall scoreboard information.  Note that the SCOREBOARD_STATE size
+   define in scorebrd.h will need to be updated if this structure is
    changed */
 
 typedef struct {
-	/* Scoreboard index and data storage, and the total number of entries in
-	   the scoreboard */
-	void *index, *data;			/* Scoreboard index and data */
+	SCOREBOARD_SHARD shards[ SCOREBOARD_SHARDS ];
 	int noEntries;				/* Total scoreboard entries */
-
-	/* The last used entry in the scoreboard, and a unique ID for each 
-	   scoreboard entry.  This is incremented for each index entry added,
-	   so that even if an entry is deleted and then another one with the 
-	   same index value added, the uniqueID for the two will be different */
-	int lastEntry;				/* Last used entry in scoreboard */
-	int uniqueID;				/* Unique ID for scoreboard entry */
 	} SCOREBOARD_INDEX_INFO;
 
+/* The mutexes that protect each shard */
+
+static const MUTEX_TYPE shardMutexes[ SCOREBOARD_SHARDS ] = {
+	MUTEX_SCOREBOARD, MUTEX_SCOREBOARD1, MUTEX_SCOREBOARD2, MUTEX_SCOREBOARD3
+	};
+
+/* The hashed form of a search key, calculated before we acquire the shard
+   mutex */
+
+typedef struct {
+	BYTE hashValue[ HASH_DATA_SIZE + 8 ];
+	int checkValue;
+	} SCOREBOARD_KEY_INFO;
+
 /****************************************************************************
 *																			*
 *								Utility Functions							*
@@ -111,25 +184,40 @@ typedef struct {
 /* Sanity-check the scoreboard state */
 
 CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
-static BOOLEAN sanityCheckScoreboard( const SCOREBOARD_INDEX_INFO *scoreboardIndexInfo )
+static BOOLEAN sanityCheckScoreboard( const SCOREBOARD_SHARD *scoreboardShard )
 	{
-	assert( isReadPtr( scoreboardIndexInfo, 
-					   sizeof( SCOREBOARD_INDEX_INFO ) ) );
+	assert( isReadPtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
 
 	/* Make sure that the general state is in order */
-	if( scoreboardIndexInfo->noEntries < SCOREBOARD_MIN_SIZE || \
-		scoreboardIndexInfo->noEntries > SCOREBOARD_MAX_SIZE )
+	if( scoreboardShard->noEntries < SCOREBOARD_SHARD_MIN || \
+		scoreboardShard->noEntries > SCOREBOARD_SHARD_MAX || \
+		scoreboardShard->hashSize < scoreboardShard->noEntries || \
+		scoreboardShard->hashSize > 2 * scoreboardShard->noEntries || \
+		( scoreboardShard->hashSize & ( scoreboardShard->hashSize - 1 ) ) )
 		{
 		DEBUG_PRINT(( "sanityCheckScoreboard: Scoreboard size" ));
 		return( FALSE );
 		}
-	if( scoreboardIndexInfo->lastEntry < 0 || \
-		scoreboardIndexInfo->lastEntry > scoreboardIndexInfo->noEntries )
+	if( scoreboardShard->noUsedEntries < 0 || \
+		scoreboardShard->noUsedEntries > scoreboardShard->noEntries )
 		{
-		DEBUG_PRINT(( "sanityCheckScoreboard: Scoreboard last entry" ));
+		DEBUG_PRINT(( "sanityCheckScoreboard: Scoreboard used entries" ));
 		return( FALSE );
 		}
-	if( scoreboardIndexInfo->uniqueID < 0 )
+	if( scoreboardShard->lruHead < CRYPT_ERROR || \
+		scoreboardShard->lruHead >= scoreboardShard->noEntries || \
+		scoreboardShard->lruTail < CRYPT_ERROR || \
+		scoreboardShard->lruTail >= scoreboardShard->noEntries || \
+		scoreboardShard->freeHead < CRYPT_ERROR || \
+		scoreboardShard->freeHead >= scoreboardShard->noEntries || \
+		( scoreboardShard->noUsedEntries > 0 && \
+		  ( scoreboardShard->lruHead == CRYPT_ERROR || \
+			scoreboardShard->lruTail == CRYPT_ERROR ) ) )
+		{
+		DEBUG_PRINT(( "sanityCheckScoreboard: Scoreboard lists" ));
+		return( FALSE );
+		}
+	if( scoreboardShard->uniqueID < 0 )
 		{
 		DEBUG_PRINT(( "sanityCheckScoreboard: Scoreboard unique ID" ));
 		return( FALSE );
@@ -139,6 +227,199 @@ static BOOLEAN sanityCheckScoreboard( const SCOREBOARD_INDEX_INFO *scoreboardInd
 	}
 #endif /* !CONFIG_CONSERVE_MEMORY_EXTRA */
 
+/* Hash a search key and determine which shard it belongs to */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int getKeyInfo( OUT SCOREBOARD_KEY_INFO *keyInfo,
+					   IN_BUFFER( keyLength ) const void *key,
+					   IN_LENGTH_SHORT_MIN( 2 ) const int keyLength )
+	{
+	assert( isWritePtr( keyInfo, sizeof( SCOREBOARD_KEY_INFO ) ) );
+	assert( isReadPtrDynamic( key, keyLength ) );
+
+	REQUIRES( keyLength >= SCOREBOARD_KEY_MIN && \
+			  keyLength < MAX_INTLENGTH_SHORT );
+
+	memset( keyInfo, 0, sizeof( SCOREBOARD_KEY_INFO ) );
+	keyInfo->checkValue = checksumData( key, keyLength );
+	if( cryptStatusError( keyInfo->checkValue ) )
+		return( keyInfo->checkValue );
+	hashData( keyInfo->hashValue, HASH_DATA_SIZE, key, keyLength );
+
+	return( CRYPT_OK );
+	}
+
+#define getShardNo( keyInfo ) \
+		( ( keyInfo )->hashValue[ 3 ] & ( SCOREBOARD_SHARDS - 1 ) )
+
+/* Get the hash index and position in the index for a key */
+
+CHECK_RETVAL_PTR STDC_NONNULL_ARG( ( 1 ) ) \
+static int *getHashTable( const SCOREBOARD_SHARD *scoreboardShard,
+						  IN_RANGE( 0, SCOREBOARD_TABLE_LAST - 1 ) \
+								const int table )
+	{
+	assert( isReadPtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+
+	REQUIRES_N( table >= 0 && table < SCOREBOARD_TABLE_LAST );
+
+	return( scoreboardShard->hashTables + \
+			( table * scoreboardShard->hashSize ) );
+	}
+
+CHECK_RETVAL_RANGE( 0, SCOREBOARD_SHARD_MAX ) STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int getHashPosition( const SCOREBOARD_SHARD *scoreboardShard,
+							IN_BUFFER_C( HASH_DATA_SIZE ) const BYTE *hashValue )
+	{
+	assert( isReadPtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+	assert( isReadPtr( hashValue, HASH_DATA_SIZE ) );
+
+	return( ( ( hashValue[ 0 ] << 16 ) | ( hashValue[ 1 ] << 8 ) | \
+			  hashValue[ 2 ] ) & ( scoreboardShard->hashSize - 1 ) );
+	}
+
+#define getUniqueIDposition( scoreboardShard, uniqueID ) \
+		( ( ( uniqueID ) / SCOREBOARD_SHARDS ) & \
+		  ( ( scoreboardShard )->hashSize - 1 ) )
+
+/* Get the link to the next entry in a given hash chain */
+
+CHECK_RETVAL_PTR STDC_NONNULL_ARG( ( 1 ) ) \
+static int *getChainLink( INOUT SCOREBOARD_INDEX *scoreboardEntryPtr,
+						  IN_RANGE( 0, SCOREBOARD_TABLE_LAST - 1 ) \
+								const int table )
+	{
+	assert( isWritePtr( scoreboardEntryPtr, sizeof( SCOREBOARD_INDEX ) ) );
+
+	switch( table )
+		{
+		case SCOREBOARD_TABLE_SESSIONID_CLI:
+		case SCOREBOARD_TABLE_SESSIONID_SVR:
+			return( &scoreboardEntryPtr->nextSessionID );
+
+		case SCOREBOARD_TABLE_FQDN:
+			return( &scoreboardEntryPtr->nextFQDN );
+
+		case SCOREBOARD_TABLE_UNIQUEID:
+			return( &scoreboardEntryPtr->nextUniqueID );
+		}
+
+	retIntError_Null();
+	}
+
+/* Add an entry to and remove an entry from a hash chain */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int insertChain( INOUT SCOREBOARD_SHARD *scoreboardShard,
+						IN_RANGE( 0, SCOREBOARD_TABLE_LAST - 1 ) \
+							const int table,
+						IN_INT_SHORT_Z const int hashPosition,
+						IN_INT_SHORT_Z const int entryNo )
+	{
+	SCOREBOARD_INDEX *scoreboardIndex = scoreboardShard->index;
+	int *hashTable, *chainLink;
+
+	assert( isWritePtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+
+	REQUIRES( hashPosition >= 0 && hashPosition < scoreboardShard->hashSize );
+	REQUIRES( entryNo >= 0 && entryNo < scoreboardShard->noEntries );
+
+	hashTable = getHashTable( scoreboardShard, table );
+	chainLink = getChainLink( &scoreboardIndex[ entryNo ], table );
+	ENSURES( hashTable != NULL && chainLink != NULL );
+	*chainLink = hashTable[ hashPosition ];
+	hashTable[ hashPosition ] = entryNo;
+
+	return( CRYPT_OK );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int deleteChain( INOUT SCOREBOARD_SHARD *scoreboardShard,
+						IN_RANGE( 0, SCOREBOARD_TABLE_LAST - 1 ) \
+							const int table,
+						IN_INT_SHORT_Z const int hashPosition,
+						IN_INT_SHORT_Z const int entryNo )
+	{
+	SCOREBOARD_INDEX *scoreboardIndex = scoreboardShard->index;
+	int *hashTable, *prevLinkPtr, *chainLink, LOOP_ITERATOR;
+
+	assert( isWritePtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+
+	REQUIRES( hashPosition >= 0 && hashPosition < scoreboardShard->hashSize );
+	REQUIRES( entryNo >= 0 && entryNo < scoreboardShard->noEntries );
+
+	/* Walk down the hash chain looking for the link that points to the
+	   entry being removed */
+	hashTable = getHashTable( scoreboardShard, table );
+	ENSURES( hashTable != NULL );
+	prevLinkPtr = &hashTable[ hashPosition ];
+	LOOP_MAX_CHECKINC( *prevLinkPtr != CRYPT_ERROR && \
+							*prevLinkPtr != entryNo,
+					   prevLinkPtr = chainLink )
+		{
+		ENSURES( *prevLinkPtr >= 0 && \
+				 *prevLinkPtr < scoreboardShard->noEntries );
+		chainLink = getChainLink( &scoreboardIndex[ *prevLinkPtr ], table );
+		ENSURES( chainLink != NULL );
+		}
+	ENSURES( LOOP_BOUND_OK );
+	ENSURES( *prevLinkPtr == entryNo );
+
+	/* Unlink the entry */
+	chainLink = getChainLink( &scoreboardIndex[ entryNo ], table );
+	ENSURES( chainLink != NULL );
+	*prevLinkPtr = *chainLink;
+	*chainLink = CRYPT_ERROR;
+
+	return( CRYPT_OK );
+	}
+
+/* Add an entry to the front of the LRU list and remove it from the list */
+
+STDC_NONNULL_ARG( ( 1 ) ) \
+static void insertLRU( INOUT SCOREBOARD_SHARD *scoreboardShard,
+					   IN_INT_SHORT_Z const int entryNo )
+	{
+	SCOREBOARD_INDEX *scoreboardIndex = scoreboardShard->index;
+	SCOREBOARD_INDEX *scoreboardEntryPtr = &scoreboardIndex[ entryNo ];
+
+	assert( isWritePtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+
+	scoreboardEntryPtr->lruPrev = CRYPT_ERROR;
+	scoreboardEntryPtr->lruNext = scoreboardShard->lruHead;
+	if( scoreboardShard->lruHead != CRYPT_ERROR )
+		scoreboardIndex[ scoreboardShard->lruHead ].lruPrev = entryNo;
+	else
+		scoreboardShard->lruTail = entryNo;
+	scoreboardShard->lruHead = entryNo;
+	}
+
+STDC_NONNULL_ARG( ( 1 ) ) \
+static void deleteLRU( INOUT SCOREBOARD_SHARD *scoreboardShard,
+					   IN_INT_SHORT_Z const int entryNo )
+	{
+	SCOREBOARD_INDEX *scoreboardIndex = scoreboardShard->index;
+	SCOREBOARD_INDEX *scoreboardEntryPtr = &scoreboardIndex[ entryNo ];
+
+	assert( isWritePtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+
+	if( scoreboardEntryPtr->lruPrev != CRYPT_ERROR )
+		{
+		scoreboardIndex[ scoreboardEntryPtr->lruPrev ].lruNext = \
+									scoreboardEntryPtr->lruNext;
+		}
+	else
+		scoreboardShard->lruHead = scoreboardEntryPtr->lruNext;
+	if( scoreboardEntryPtr->lruNext != CRYPT_ERROR )
+		{
+		scoreboardIndex[ scoreboardEntryPtr->lruNext ].lruPrev = \
+									scoreboardEntryPtr->lruPrev;
+		}
+	else
+		scoreboardShard->lruTail = scoreboardEntryPtr->lruPrev;
+	scoreboardEntryPtr->lruPrev = scoreboardEntryPtr->lruNext = CRYPT_ERROR;
+	}
+
 /* Clear a scoreboard entry */
 
 STDC_NONNULL_ARG( ( 1 ) ) \
@@ -157,67 +438,234 @@ static void clearScoreboardEntry( SCOREBOARD_INDEX *scoreboardEntryPtr )
 	scoreboardEntryPtr->data = savedDataPtr;
 	scoreboardEntryPtr->dataLength = \
 			scoreboardEntryPtr->metaData = 0;
+	scoreboardEntryPtr->nextSessionID = scoreboardEntryPtr->nextFQDN = \
+			scoreboardEntryPtr->nextUniqueID = CRYPT_ERROR;
+	scoreboardEntryPtr->lruPrev = scoreboardEntryPtr->lruNext = CRYPT_ERROR;
+	}
+
+/* Link a newly-added entry into the shard's indices and LRU list, and
+   unlink and free an existing entry */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int linkEntry( INOUT SCOREBOARD_SHARD *scoreboardShard,
+					  IN_INT_SHORT_Z const int entryNo )
+	{
+	SCOREBOARD_INDEX *scoreboardIndex = scoreboardShard->index;
+	const SCOREBOARD_INDEX *scoreboardEntryPtr = &scoreboardIndex[ entryNo ];
+	int status;
+
+	assert( isWritePtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+
+	REQUIRES( entryNo >= 0 && entryNo < scoreboardShard->noEntries );
+
+	status = insertChain( scoreboardShard,
+						  scoreboardEntryPtr->isServerData ? \
+							SCOREBOARD_TABLE_SESSIONID_SVR : \
+							SCOREBOARD_TABLE_SESSIONID_CLI,
+						  getHashPosition( scoreboardShard,
+										   scoreboardEntryPtr->sessionHash ),
+						  entryNo );
+	if( cryptStatusOK( status ) && !scoreboardEntryPtr->isServerData )
+		{
+		status = insertChain( scoreboardShard, SCOREBOARD_TABLE_FQDN,
+							  getHashPosition( scoreboardShard,
+											   scoreboardEntryPtr->fqdnHash ),
+							  entryNo );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = insertChain( scoreboardShard, SCOREBOARD_TABLE_UNIQUEID,
+							  getUniqueIDposition( scoreboardShard,
+											scoreboardEntryPtr->uniqueID ),
+							  entryNo );
+		}
+	if( cryptStatusError( status ) )
+		return( status );
+	insertLRU( scoreboardShard, entryNo );
+
+	return( CRYPT_OK );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int deleteEntry( INOUT SCOREBOARD_SHARD *scoreboardShard,
+						IN_INT_SHORT_Z const int entryNo )
+	{
+	SCOREBOARD_INDEX *scoreboardIndex = scoreboardShard->index;
+	SCOREBOARD_INDEX *scoreboardEntryPtr = &scoreboardIndex[ entryNo ];
+	int status;
+
+	assert( isWritePtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+
+	REQUIRES( entryNo >= 0 && entryNo < scoreboardShard->noEntries );
+	REQUIRES( scoreboardEntryPtr->timeStamp > MIN_TIME_VALUE );
+	REQUIRES( scoreboardShard->noUsedEntries > 0 );
+
+	/* Unlink the entry from the indices and LRU list */
+	status = deleteChain( scoreboardShard,
+						  scoreboardEntryPtr->isServerData ? \
+							SCOREBOARD_TABLE_SESSIONID_SVR : \
+							SCOREBOARD_TABLE_SESSIONID_CLI,
+						  getHashPosition( scoreboardShard,
+										   scoreboardEntryPtr->sessionHash ),
+						  entryNo );
+	if( cryptStatusOK( status ) && !scoreboardEntryPtr->isServerData )
+		{
+		status = deleteChain( scoreboardShard, SCOREBOARD_TABLE_FQDN,
+							  getHashPosition( scoreboardShard,
+											   scoreboardEntryPtr->fqdnHash ),
+							  entryNo );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = deleteChain( scoreboardShard, SCOREBOARD_TABLE_UNIQUEID,
+							  getUniqueIDposition( scoreboardShard,
+											scoreboardEntryPtr->uniqueID ),
+							  entryNo );
+		}
+	if( cryptStatusError( status ) )
+		return( status );
+	deleteLRU( scoreboardShard, entryNo );
+
+	/* Clear the entry and move it to the free list */
+	clearScoreboardEntry( scoreboardEntryPtr );
+	scoreboardEntryPtr->lruNext = scoreboardShard->freeHead;
+	scoreboardShard->freeHead = entryNo;
+	scoreboardShard->noUsedEntries--;
+
+	return( CRYPT_OK );
+	}
+
+/* Get a free entry in the shard, evicting the least recently used entry if
+   necessary */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int allocEntry( INOUT SCOREBOARD_SHARD *scoreboardShard,
+					   OUT_INT_SHORT_Z int *entryNo )
+	{
+	SCOREBOARD_INDEX *scoreboardIndex = scoreboardShard->index;
+	int status;
+
+	assert( isWritePtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+	assert( isWritePtr( entryNo, sizeof( int ) ) );
+
+	/* Clear return value */
+	*entryNo = CRYPT_ERROR;
+
+	/* If there are no free positions, evict the least recently used
+	   entry */
+	if( scoreboardShard->freeHead == CRYPT_ERROR )
+		{
+		REQUIRES( scoreboardShard->lruTail != CRYPT_ERROR );
+		status = deleteEntry( scoreboardShard, scoreboardShard->lruTail );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+	ENSURES( scoreboardShard->freeHead >= 0 && \
+			 scoreboardShard->freeHead < scoreboardShard->noEntries );
+
+	/* Take the first entry off the free list */
+	*entryNo = scoreboardShard->freeHead;
+	scoreboardShard->freeHead = scoreboardIndex[ *entryNo ].lruNext;
+	scoreboardIndex[ *entryNo ].lruNext = CRYPT_ERROR;
+	scoreboardShard->noUsedEntries++;
+
+	return( CRYPT_OK );
+	}
+
+/* Expire any entries that haven't been used within the timeout period.
+   Since every use of an entry moves it to the front of the LRU list, the
+   entries are ordered by last-use time and we only need to look at the
+   tail of the list */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int expireEntries( INOUT SCOREBOARD_SHARD *scoreboardShard,
+						  const time_t currentTime )
+	{
+	SCOREBOARD_INDEX *scoreboardIndex = scoreboardShard->index;
+	int status, LOOP_ITERATOR;
+
+	assert( isWritePtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+
+	REQUIRES( currentTime > MIN_TIME_VALUE );
+
+	LOOP_MAX_CHECK( scoreboardShard->lruTail != CRYPT_ERROR && \
+						scoreboardIndex[ scoreboardShard->lruTail ].timeStamp + \
+							SCOREBOARD_TIMEOUT < currentTime )
+		{
+		status = deleteEntry( scoreboardShard, scoreboardShard->lruTail );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	return( CRYPT_OK );
 	}
 
 /* Add a scoreboard entry */
 
-CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 8 ) ) \
-static int addEntryData( INOUT SCOREBOARD_INDEX *scoreboardEntryPtr, 
-						 IN_INT_Z const int keyCheckValue,
-						 IN_BUFFER( keyLength ) const void *key, 
-						 IN_LENGTH_SHORT_MIN( 8 ) const int keyLength, 
-						 IN_INT_Z const int altKeyCheckValue,
-						 IN_BUFFER_OPT( altKeyLength ) const void *altKey, 
-						 IN_LENGTH_SHORT_Z const int altKeyLength, 
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4, 9 ) ) \
+static int addEntryData( INOUT SCOREBOARD_INDEX *scoreboardEntryPtr,
+						 const SCOREBOARD_KEY_INFO *keyInfo,
+						 IN_BUFFER( keyLength ) const void *key,
+						 IN_LENGTH_SHORT_MIN( 8 ) const int keyLength,
+						 IN_OPT const SCOREBOARD_KEY_INFO *altKeyInfo,
+						 IN_BUFFER_OPT( altKeyLength ) const void *altKey,
+						 IN_LENGTH_SHORT_Z const int altKeyLength,
+						 IN_INT_Z const int uniqueID,
 						 const SCOREBOARD_INFO *scoreboardInfo,
 						 const time_t currentTime )
 	{
 	int status;
 
 	assert( isWritePtr( scoreboardEntryPtr, sizeof( SCOREBOARD_INDEX ) ) );
+	assert( isReadPtr( keyInfo, sizeof( SCOREBOARD_KEY_INFO ) ) );
 	assert( isReadPtrDynamic( key, keyLength ) );
-	assert( ( altKey == NULL && altKeyLength == 0 ) || \
-			isReadPtrDynamic( altKey, altKeyLength ) );
+	assert( ( altKey == NULL && altKeyLength == 0 && \
+			  altKeyInfo == NULL ) || \
+			( isReadPtrDynamic( altKey, altKeyLength ) && \
+			  isReadPtr( altKeyInfo, sizeof( SCOREBOARD_KEY_INFO ) ) ) );
 	assert( isReadPtr( scoreboardInfo, sizeof( SCOREBOARD_INFO ) ) );
 
-	REQUIRES( keyCheckValue >= 0 );
+	REQUIRES( keyInfo->checkValue >= 0 );
 	REQUIRES( keyLength >= SCOREBOARD_KEY_MIN && \
 			  keyLength < MAX_INTLENGTH_SHORT );
 	REQUIRES( ( altKey == NULL && altKeyLength == 0 && \
-				altKeyCheckValue == 0 ) || \
-			  ( altKey != NULL && \
+				altKeyInfo == NULL ) || \
+			  ( altKey != NULL && altKeyInfo != NULL && \
 				altKeyLength >= SCOREBOARD_KEY_MIN && \
 				altKeyLength < MAX_INTLENGTH_SHORT && \
-				altKeyCheckValue >= 0 ) );
+				altKeyInfo->checkValue >= 0 ) );
+	REQUIRES( isIntegerRange( uniqueID ) );
 	REQUIRES( currentTime > MIN_TIME_VALUE );
 
 	/* Clear the existing data in the entry */
 	clearScoreboardEntry( scoreboardEntryPtr );
 
-	/* Copy across the key and value (Amicitiae nostrae memoriam spero 
+	/* Copy across the key and value (Amicitiae nostrae memoriam spero
 	   sempiternam fore - Cicero) */
-	scoreboardEntryPtr->sessionCheckValue = keyCheckValue;
-	hashData( scoreboardEntryPtr->sessionHash, HASH_DATA_SIZE, 
-			  key, keyLength );
+	scoreboardEntryPtr->sessionCheckValue = keyInfo->checkValue;
+	memcpy( scoreboardEntryPtr->sessionHash, keyInfo->hashValue,
+			HASH_DATA_SIZE );
 	if( altKey != NULL )
 		{
-		scoreboardEntryPtr->fqdnCheckValue = altKeyCheckValue;
-		hashData( scoreboardEntryPtr->fqdnHash, HASH_DATA_SIZE, 
-				  altKey, altKeyLength );
+		scoreboardEntryPtr->fqdnCheckValue = altKeyInfo->checkValue;
+		memcpy( scoreboardEntryPtr->fqdnHash, altKeyInfo->hashValue,
+				HASH_DATA_SIZE );
 		}
-	status = attributeCopyParams( scoreboardEntryPtr->sessionID, 
-								  SCOREBOARD_KEY_SIZE, 
+	status = attributeCopyParams( scoreboardEntryPtr->sessionID,
+								  SCOREBOARD_KEY_SIZE,
 								  &scoreboardEntryPtr->sessionIDlength,
 								  key, keyLength );
 	ENSURES( cryptStatusOK( status ) );
-	status = attributeCopyParams( scoreboardEntryPtr->data, 
-								  SCOREBOARD_DATA_SIZE, 
+	status = attributeCopyParams( scoreboardEntryPtr->data,
+								  SCOREBOARD_DATA_SIZE,
 								  &scoreboardEntryPtr->dataLength,
-								  scoreboardInfo->data, 
+								  scoreboardInfo->data,
 								  scoreboardInfo->dataSize );
 	ENSURES( cryptStatusOK( status ) );
 	scoreboardEntryPtr->metaData = scoreboardInfo->metaData;
 	scoreboardEntryPtr->isServerData = ( altKey == NULL ) ? TRUE : FALSE;
+	scoreboardEntryPtr->uniqueID = uniqueID;
 	scoreboardEntryPtr->timeStamp = currentTime;
 
 	return( CRYPT_OK );
@@ -229,162 +677,78 @@ static int addEntryData( INOUT SCOREBOARD_INDEX *scoreboardEntryPtr,
 *																			*
 ****************************************************************************/
 
-/* Find an entry, returning its position in the scoreboard.  This function 
-   currently uses a straightforward linear search with entries clustered 
-   towards the start of the scoreboard.  Although this may seem somewhat 
-   suboptimal, since cryptlib isn't running as a high-performance web server 
-   the scoreboard will rarely contain more than a handful of entries (if 
-   any).  In any case a quick scan through a small number of integers is 
-   probably still faster than the complex in-memory database lookup schemes 
-   used by many servers, and is also required to handle things like 
-   scoreboard LRU management */
-
-CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 6 ) ) \
-static int findEntry( INOUT SCOREBOARD_INDEX_INFO *scoreboardIndexInfo,
+/* Find an entry, returning its position in the shard.  The search is a
+   walk down the hash chain for the key type, which in the absence of
+   collisions in the hash position will contain at most one entry.  We use
+   a quick check with the key checksum to weed out non-matching entries
+   before comparing the full key hash */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 4 ) ) \
+static int findEntry( const SCOREBOARD_SHARD *scoreboardShard,
 					  IN_ENUM( SCOREBOARD_KEY ) \
 							const SCOREBOARD_KEY_TYPE keyType,
-					  IN_BUFFER( keyLength ) const void *key, 
-					  IN_LENGTH_SHORT_MIN( 2 ) const int keyLength, 
-					  const time_t currentTime, 
+					  const SCOREBOARD_KEY_INFO *keyInfo,
 					  OUT_INT_SHORT_Z int *position )
 	{
-	SCOREBOARD_INDEX *scoreboardIndex = scoreboardIndexInfo->index;
-	BYTE hashValue[ HASH_DATA_SIZE + 8 ];
-	const BOOLEAN keyIsSessionID = \
-		( keyType == SCOREBOARD_KEY_SESSIONID_CLI || \
-		  keyType == SCOREBOARD_KEY_SESSIONID_SVR ) ? TRUE : FALSE;
-	const BOOLEAN isServerMatch = \
-		( keyType == SCOREBOARD_KEY_SESSIONID_SVR ) ? TRUE : FALSE;
-	BOOLEAN dataHashed = FALSE;
-	time_t oldestTime = currentTime;
-	const int checkValue = checksumData( key, keyLength );
-	int nextFreeEntry = CRYPT_ERROR, lastUsedEntry = 0, oldestEntry = 0;
-	int matchPosition = CRYPT_ERROR, i, LOOP_ITERATOR;
-
-	assert( isWritePtr( scoreboardIndexInfo, 
-						sizeof( SCOREBOARD_INDEX_INFO ) ) );
-	assert( isReadPtrDynamic( key, keyLength ) );
+	SCOREBOARD_INDEX *scoreboardIndex = scoreboardShard->index;
+	const int table = \
+		( keyType == SCOREBOARD_KEY_SESSIONID_CLI ) ? \
+			SCOREBOARD_TABLE_SESSIONID_CLI : \
+		( keyType == SCOREBOARD_KEY_SESSIONID_SVR ) ? \
+			SCOREBOARD_TABLE_SESSIONID_SVR : SCOREBOARD_TABLE_FQDN;
+	const int *hashTable;
+	int entryNo, LOOP_ITERATOR;
+
+	assert( isReadPtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+	assert( isReadPtr( keyInfo, sizeof( SCOREBOARD_KEY_INFO ) ) );
 	assert( isWritePtr( position, sizeof( int ) ) );
-	assert( isWritePtrDynamic( scoreboardIndex,
-							   scoreboardIndexInfo->noEntries * \
+	assert( isReadPtrDynamic( scoreboardIndex,
+							  scoreboardShard->noEntries * \
 									sizeof( SCOREBOARD_INDEX ) ) );
 
 	REQUIRES( keyType > SCOREBOARD_KEY_NONE && \
 			  keyType < SCOREBOARD_KEY_LAST );
-	REQUIRES( keyLength >= SCOREBOARD_KEY_MIN && \
-			  keyLength < MAX_INTLENGTH_SHORT);
-	REQUIRES( currentTime > MIN_TIME_VALUE );
 
 	/* Clear return value */
 	*position = CRYPT_ERROR;
 
-	/* Scan the scoreboard expiring old entries, looking for a match 
-	   (indicated by matchPosition), and keeping a record of the oldest 
-	   entry (recorded by oldestEntry) in case we need to expire an entry to
-	   make room for a new one */
-	LOOP_MAX( i = 0, i < scoreboardIndexInfo->lastEntry, i++ )
+	hashTable = getHashTable( scoreboardShard, table );
+	ENSURES( hashTable != NULL );
+	LOOP_MAX( entryNo = hashTable[ getHashPosition( scoreboardShard,
+											keyInfo->hashValue ) ],
+			  entryNo != CRYPT_ERROR,
+			  entryNo = ( table == SCOREBOARD_TABLE_FQDN ) ? \
+						scoreboardIndex[ entryNo ].nextFQDN : \
+						scoreboardIndex[ entryNo ].nextSessionID )
 		{
-		SCOREBOARD_INDEX *scoreboardEntryPtr = &scoreboardIndex[ i ];
+		const SCOREBOARD_INDEX *scoreboardEntryPtr;
 
-		/* If this entry has expired, delete it */
-		if( scoreboardEntryPtr->timeStamp + SCOREBOARD_TIMEOUT < currentTime )
-			clearScoreboardEntry( scoreboardEntryPtr );
-
-		/* Check for a free entry and the oldest non-free entry.  We could
-		   perform an early-out once we find a free entry but this would
-		   prevent any following expired entries from being deleted */
-		if( scoreboardEntryPtr->timeStamp <= MIN_TIME_VALUE )
-			{
-			/* We've found a free entry, remember it for future use if
-			   required and continue */
-			if( nextFreeEntry == CRYPT_ERROR )
-				nextFreeEntry = i;
-			continue;
-			}
-		lastUsedEntry = i;
-		if( scoreboardEntryPtr->timeStamp < oldestTime )
-			{
-			/* We've found an older entry than the current oldest entry,
-			   remember it */
-			oldestTime = scoreboardEntryPtr->timeStamp;
-			oldestEntry = i;
-			}
-
-		/* If we've already found a match then we're just scanning for LRU
-		   purposes and we don't need to go any further */
-		if( matchPosition != CRYPT_ERROR )
-			continue;
-
-		/* Make sure that this entry is appropriate for the match type that
-		   we're performing */
-		if( scoreboardEntryPtr->isServerData != isServerMatch )
-			continue;
-
-		/* Perform a quick check using a checksum of the name to weed out
-		   most entries */
-		if( ( keyIsSessionID && \
-			  scoreboardEntryPtr->sessionCheckValue == checkValue ) || \
-			( !keyIsSessionID && \
-			  scoreboardEntryPtr->fqdnCheckValue == checkValue ) )
+		ENSURES( entryNo >= 0 && entryNo < scoreboardShard->noEntries );
+		scoreboardEntryPtr = &scoreboardIndex[ entryNo ];
+		if( table == SCOREBOARD_TABLE_FQDN )
 			{
-			void *hashPtr = keyIsSessionID ? \
-								scoreboardEntryPtr->sessionHash : \
-								scoreboardEntryPtr->fqdnHash;
-
-			if( !dataHashed )
-				{
-				hashData( hashValue, HASH_DATA_SIZE, key, keyLength );
-				dataHashed = TRUE;
-				}
-			if( !memcmp( hashPtr, hashValue, HASH_DATA_SIZE ) )
+			if( scoreboardEntryPtr->fqdnCheckValue == keyInfo->checkValue && \
+				!memcmp( scoreboardEntryPtr->fqdnHash, keyInfo->hashValue,
+						 HASH_DATA_SIZE ) )
 				{
-				/* Remember the match position.  We can't immediately exit 
-				   at this point because we still need to look for the last 
-				   used entry and potentually shrink the scoreboard-used 
-				   size */
-				matchPosition = i;
+				*position = entryNo;
+				return( CRYPT_OK );
 				}
 			}
-		}
-	ENSURES( i < FAILSAFE_ITERATIONS_MAX );
-
-	/* If the total number of entries has shrunk due to old entries expiring,
-	   reduce the overall scoreboard-used size */
-	if( lastUsedEntry + 1 < scoreboardIndexInfo->lastEntry )
-		scoreboardIndexInfo->lastEntry = lastUsedEntry + 1;
-
-	/* If we've found a match, we're done */
-	if( matchPosition >= 0 )
-		{
-		*position = matchPosition;
-		return( CRYPT_OK );
-		}
-
-	/* The entry wasn't found, return the location where we can add a new 
-	   entry */
-	if( nextFreeEntry >= 0 )
-		{
-		/* We've found a freed-up existing position (which will be before 
-		   any remaining free entries), add the new entry there */
-		*position = nextFreeEntry;
-		}
-	else
-		{
-		/* If there are still free positions in the scoreboard, use the next
-		   available one */
-		if( scoreboardIndexInfo->lastEntry < scoreboardIndexInfo->noEntries )
-			*position = scoreboardIndexInfo->lastEntry;
 		else
 			{
-			/* There are no free positions, overwrite the oldest entry */
-			*position = oldestEntry;
+			if( scoreboardEntryPtr->sessionCheckValue == keyInfo->checkValue && \
+				!memcmp( scoreboardEntryPtr->sessionHash, keyInfo->hashValue,
+						 HASH_DATA_SIZE ) )
+				{
+				*position = entryNo;
+				return( CRYPT_OK );
+				}
 			}
 		}
-	ENSURES( *position >= 0 && *position < scoreboardIndexInfo->noEntries );
+	ENSURES( LOOP_BOUND_OK );
 
-	/* Let the caller know that this is an indication of a free position 
-	   rather than a match */
-	return( OK_SPECIAL );
+	return( CRYPT_ERROR_NOTFOUND );
 	}
 
 /* Add an entry to the scoreboard.  The strategy for updating entries can 
@@ -439,194 +803,195 @@ static int findEntry( INOUT SCOREBOARD_INDEX_INFO *scoreboardIndexInfo,
    two threads simultaneously connect to the same server, with FQDNs the 
    same but session IDs different */
 
-CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 6, 7 ) ) \
-static int addEntry( INOUT SCOREBOARD_INDEX_INFO *scoreboardIndexInfo, 
-					 IN_BUFFER( keyLength ) const void *key, 
-					 IN_LENGTH_SHORT_MIN( 8 ) const int keyLength, 
-					 IN_BUFFER_OPT( altKeyLength ) const void *altKey, 
-					 IN_LENGTH_SHORT_Z const int altKeyLength, 
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 4, 9, 10 ) ) \
+static int addEntry( INOUT SCOREBOARD_SHARD *scoreboardShard,
+					 IN_RANGE( 0, SCOREBOARD_SHARDS - 1 ) const int shardNo,
+					 IN_BUFFER( keyLength ) const void *key,
+					 const SCOREBOARD_KEY_INFO *keyInfo,
+					 IN_LENGTH_SHORT_MIN( 8 ) const int keyLength,
+					 IN_BUFFER_OPT( altKeyLength ) const void *altKey,
+					 IN_OPT const SCOREBOARD_KEY_INFO *altKeyInfo,
+					 IN_LENGTH_SHORT_Z const int altKeyLength,
 					 const SCOREBOARD_INFO *scoreboardInfo,
 					 OUT int *uniqueID )
 	{
-	SCOREBOARD_INDEX *scoreboardIndex = scoreboardIndexInfo->index;
-	SCOREBOARD_INDEX *scoreboardEntryPtr = NULL;
+	SCOREBOARD_INDEX *scoreboardIndex = scoreboardShard->index;
+	SCOREBOARD_INDEX *scoreboardEntryPtr;
 	const time_t currentTime = getTime();
 	const BOOLEAN isClient = ( altKey != NULL ) ? TRUE : FALSE;
-	const int checkValue = checksumData( key, keyLength );
-	int altCheckValue = 0, altPosition DUMMY_INIT;
-	int position, altStatus = CRYPT_ERROR, status;
+	int position, altPosition DUMMY_INIT, newUniqueID;
+	int altStatus = CRYPT_ERROR, status;
 
-	assert( isWritePtr( scoreboardIndexInfo, 
-						sizeof( SCOREBOARD_INDEX_INFO ) ) );
+	assert( isWritePtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
 	assert( isReadPtrDynamic( key, keyLength ) );
-	assert( ( altKey == NULL && altKeyLength == 0 ) || \
-			isReadPtrDynamic( altKey, altKeyLength ) );
+	assert( isReadPtr( keyInfo, sizeof( SCOREBOARD_KEY_INFO ) ) );
+	assert( ( altKey == NULL && altKeyLength == 0 && \
+			  altKeyInfo == NULL ) || \
+			( isReadPtrDynamic( altKey, altKeyLength ) && \
+			  isReadPtr( altKeyInfo, sizeof( SCOREBOARD_KEY_INFO ) ) ) );
 	assert( isReadPtr( scoreboardInfo, sizeof( SCOREBOARD_INFO ) ) );
 	assert( isWritePtr( uniqueID, sizeof( int ) ) );
-	assert( isWritePtrDynamic( scoreboardIndex,
-							   scoreboardIndexInfo->noEntries * \
-									sizeof( SCOREBOARD_INDEX ) ) );
 
+	REQUIRES( shardNo >= 0 && shardNo < SCOREBOARD_SHARDS );
 	REQUIRES( keyLength >= SCOREBOARD_KEY_MIN && \
 			  keyLength < MAX_INTLENGTH_SHORT );
-	REQUIRES( ( altKey == NULL && altKeyLength == 0 ) || \
-			  ( altKey != NULL && \
+	REQUIRES( ( altKey == NULL && altKeyLength == 0 && \
+				altKeyInfo == NULL ) || \
+			  ( altKey != NULL && altKeyInfo != NULL && \
 				altKeyLength >= SCOREBOARD_KEY_MIN && \
 				altKeyLength < MAX_INTLENGTH_SHORT ) );
-
-	REQUIRES( sanityCheckScoreboard( scoreboardIndexInfo ) );
+	REQUIRES( sanityCheckScoreboard( scoreboardShard ) );
 
 	/* Clear return value */
 	*uniqueID = CRYPT_ERROR;
 
-	/* Make sure that the checksum was calculated OK */
-	if( cryptStatusError( checkValue ) )
-		return( checkValue );
-	
 	/* If there's something wrong with the time then we can't perform (time-
 	   based) scoreboard management */
 	if( currentTime <= MIN_TIME_VALUE )
 		return( CRYPT_ERROR_NOTFOUND );
 
-	/* Try and find this entry in the scoreboard */
-	status = findEntry( scoreboardIndexInfo, isClient ? \
+	/* Clear out any expired entries and try and find this entry in the
+	   scoreboard */
+	status = expireEntries( scoreboardShard, currentTime );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = findEntry( scoreboardShard, isClient ? \
 							SCOREBOARD_KEY_SESSIONID_CLI : \
-							SCOREBOARD_KEY_SESSIONID_SVR, 
-						key, keyLength, currentTime, &position );
-	if( cryptStatusError( status ) && status != OK_SPECIAL )
+							SCOREBOARD_KEY_SESSIONID_SVR,
+						keyInfo, &position );
+	if( cryptStatusError( status ) && status != CRYPT_ERROR_NOTFOUND )
 		return( status );
-	ENSURES( position >= 0 && position < scoreboardIndexInfo->noEntries );
 	if( altKey != NULL )
 		{
-		altCheckValue = checksumData( altKey, altKeyLength );
-		if( cryptStatusError( altCheckValue ) )
-			return( altCheckValue );
-		altStatus = findEntry( scoreboardIndexInfo, SCOREBOARD_KEY_FQDN, 
-							   altKey, altKeyLength, currentTime, 
-							   &altPosition );
-		if( cryptStatusError( altStatus ) && altStatus != OK_SPECIAL )
+		altStatus = findEntry( scoreboardShard, SCOREBOARD_KEY_FQDN,
+							   altKeyInfo, &altPosition );
+		if( cryptStatusError( altStatus ) && \
+			altStatus != CRYPT_ERROR_NOTFOUND )
 			return( altStatus );
-		ENSURES( altPosition >= 0 && \
-				 altPosition < scoreboardIndexInfo->noEntries );
 		}
-	ENSURES( cryptStatusOK( status ) || status == OK_SPECIAL );
-	ENSURES( altKey == NULL || \
-			 cryptStatusOK( altStatus ) || altStatus == OK_SPECIAL );
 
-	/* We've done the match-checking, now we have to act on the results.  
+	/* We've done the match-checking, now we have to act on the results.
 	   The different result-value settings and corresponding actions are:
 
 		  Case	|		sessID		|		FQDN		| Action
 		--------+-------------------+-------------------+-----------------
-			1	|  s = MT, pos = x	|		!altK		| Add at x
+			1	|  s = NF			|		!altK		| Add new
 		--------+-------------------+-------------------+-----------------
 			2	|  s = OK, pos = x	|		!altK		| Add-special at x
 		--------+-------------------+-------------------+-----------------
-			3	|  s = MT, pos = x	| aS = MT, aPos = x	| Add at x
+			3	|  s = NF			|	aS = NF			| Add new
 		--------+-------------------+-------------------+-----------------
-			4	|  s = MT, pos = x	| aS = OK, aPos = y	| Replace at y
+			4	|  s = NF			| aS = OK, aPos = y	| Replace y
 		--------+-------------------+-------------------+-----------------
-			5	|  s = OK, pos = x	| aS = MT, aPos = y	| Clear at x
+			5	|  s = OK, pos = x	|	aS = NF			| Clear at x
 		--------+-------------------+-------------------+-----------------
 			6	|  s = OK, pos = x	| aS = OK, aPos = x	| Add-special at x
 		--------+-------------------+-------------------+-----------------
-			7	|  s = OK, pos = x	| aS = OK, aPos = y	| Clear at x and y */
+			7	|  s = OK, pos = x	| aS = OK, aPos = y	| Clear at x */
 	if( cryptStatusOK( status ) )
 		{
-		/* We matched on the main key (session ID), handle cases 2-S, 5-C, 
+		/* We matched on the main key (session ID), handle cases 2-S, 5-C,
 		   6-C and 7-C */
-		if( altKey != NULL && position != altPosition )
+		if( altKey != NULL && \
+			( cryptStatusError( altStatus ) || position != altPosition ) )
 			{
 			/* Cases 5-C + 7-C, clear */
-			clearScoreboardEntry( &scoreboardIndex[ position ] );
-			return( CRYPT_ERROR_NOTFOUND );
+			status = deleteEntry( scoreboardShard, position );
+			return( cryptStatusError( status ) ? \
+					status : CRYPT_ERROR_NOTFOUND );
 			}
 
 		/* Cases 2-S + 6-C, add-special */
-		ENSURES( altKey == NULL || ( cryptStatusOK( altStatus ) && \
-									 position == altPosition ) );
 		scoreboardEntryPtr = &scoreboardIndex[ position ];
 		if( scoreboardEntryPtr->dataLength != scoreboardInfo->dataSize || \
 			memcmp( scoreboardEntryPtr->data, scoreboardInfo->data, \
 					scoreboardInfo->dataSize ) )
 			{
-			/* The search keys match but the data doesn't, something funny 
+			/* The search keys match but the data doesn't, something funny
 			   is going on */
-			clearScoreboardEntry( &scoreboardIndex[ position ] );
+			status = deleteEntry( scoreboardShard, position );
 			assert( DEBUG_WARN );
-			return( CRYPT_ERROR_NOTFOUND );
+			return( cryptStatusError( status ) ? \
+					status : CRYPT_ERROR_NOTFOUND );
 			}
 		scoreboardEntryPtr->timeStamp = currentTime;
+		deleteLRU( scoreboardShard, position );
+		insertLRU( scoreboardShard, position );
+		*uniqueID = scoreboardEntryPtr->uniqueID;
 
 		return( CRYPT_OK );
 		}
-	REQUIRES( status == OK_SPECIAL );
 
-	/* We didn't match on the main key (session ID), check for a match on 
-	   the alt.key (FQDN) */
+	/* We didn't match on the main key (session ID), check for a match on
+	   the alt.key (FQDN).  If there's a match (case 4-C) then we replace
+	   the existing entry, which we do by deleting it and then adding the
+	   new one in its place */
 	if( cryptStatusOK( altStatus ) )
 		{
-		/* Case 4-C, add at location 'altPosition' */
-		ENSURES( position != altPosition );
-		scoreboardEntryPtr = &scoreboardIndex[ altPosition ];
+		status = deleteEntry( scoreboardShard, altPosition );
+		if( cryptStatusError( status ) )
+			return( status );
 		}
-	else
-		{
-		/* Cases 1-S + 3-C, add at location 'position' */
-		ENSURES( altKey == NULL || \
-				 ( altStatus == OK_SPECIAL && position == altPosition ) )
-		scoreboardEntryPtr = &scoreboardIndex[ position ];
-		}
-	ENSURES( scoreboardEntryPtr != NULL );
 
-	/* Add the data to the new scoreboard entry position */
-	status = addEntryData( scoreboardEntryPtr, checkValue, key, keyLength, 
-						   altCheckValue, altKey, altKeyLength, 
+	/* Cases 1-S + 3-C + 4-C, add the data to a new scoreboard entry,
+	   evicting the least recently used entry if the shard is full */
+	status = allocEntry( scoreboardShard, &position );
+	if( cryptStatusError( status ) )
+		return( status );
+	scoreboardEntryPtr = &scoreboardIndex[ position ];
+	newUniqueID = ( scoreboardShard->uniqueID * SCOREBOARD_SHARDS ) + shardNo;
+	status = addEntryData( scoreboardEntryPtr, keyInfo, key, keyLength,
+						   altKeyInfo, altKey, altKeyLength, newUniqueID,
 						   scoreboardInfo, currentTime );
+	if( cryptStatusOK( status ) )
+		status = linkEntry( scoreboardShard, position );
 	if( cryptStatusError( status ) )
 		{
+		/* The entry isn't linked into the indices yet so we can't use
+		   deleteEntry() on it, just return it to the free list */
 		clearScoreboardEntry( scoreboardEntryPtr );
+		scoreboardEntryPtr->lruNext = scoreboardShard->freeHead;
+		scoreboardShard->freeHead = position;
+		scoreboardShard->noUsedEntries--;
 		return( status );
 		}
-	*uniqueID = scoreboardEntryPtr->uniqueID = scoreboardIndexInfo->uniqueID++;
+	*uniqueID = newUniqueID;
+
+	/* Move on to the next unique ID, wrapping around well before the value
+	   could overflow */
+	scoreboardShard->uniqueID++;
+	if( scoreboardShard->uniqueID >= \
+			( MAX_INTLENGTH / SCOREBOARD_SHARDS ) - 1 )
+		scoreboardShard->uniqueID = 0;
 
-	/* If we've used a new entry, update the position-used index */
-	if( position >= scoreboardIndexInfo->lastEntry )
-		scoreboardIndexInfo->lastEntry = position + 1;
+	ENSURES( sanityCheckScoreboard( scoreboardShard ) );
 
 	return( CRYPT_OK );
 	}
 
 /* Look up data in the scoreboard */
 
-CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 5, 6 ) ) \
-static int lookupScoreboard( INOUT SCOREBOARD_INDEX_INFO *scoreboardIndexInfo,
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 4, 5 ) ) \
+static int lookupScoreboard( INOUT SCOREBOARD_SHARD *scoreboardShard,
 							 IN_ENUM( SCOREBOARD_KEY ) \
 								const SCOREBOARD_KEY_TYPE keyType,
-							 IN_BUFFER( keyLength ) const void *key, 
-							 IN_LENGTH_SHORT_MIN( 8 ) const int keyLength, 
+							 const SCOREBOARD_KEY_INFO *keyInfo,
 						     OUT SCOREBOARD_INFO *scoreboardInfo,
 							 OUT_INT_Z int *uniqueID )
 	{
-	SCOREBOARD_INDEX *scoreboardIndex = scoreboardIndexInfo->index;
+	SCOREBOARD_INDEX *scoreboardIndex = scoreboardShard->index;
 	SCOREBOARD_INDEX *scoreboardEntryPtr;
 	const time_t currentTime = getTime();
 	int position, status;
 
-	assert( isWritePtr( scoreboardIndexInfo, 
-						sizeof( SCOREBOARD_INDEX_INFO ) ) );
-	assert( isReadPtrDynamic( key, keyLength ) );
+	assert( isWritePtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+	assert( isReadPtr( keyInfo, sizeof( SCOREBOARD_KEY_INFO ) ) );
 	assert( isWritePtr( scoreboardInfo, sizeof( SCOREBOARD_INFO ) ) );
 	assert( isWritePtr( uniqueID, sizeof( int ) ) );
-	assert( isWritePtrDynamic( scoreboardIndex,
-							   scoreboardIndexInfo->noEntries * \
-									sizeof( SCOREBOARD_INDEX ) ) );
 
 	REQUIRES( keyType > SCOREBOARD_KEY_NONE && \
 			  keyType < SCOREBOARD_KEY_LAST );
-	REQUIRES( keyLength >= SCOREBOARD_KEY_MIN && \
-			  keyLength < MAX_INTLENGTH_SHORT );
-	REQUIRES( sanityCheckScoreboard( scoreboardIndexInfo ) );
+	REQUIRES( sanityCheckScoreboard( scoreboardShard ) );
 
 	/* Clear return values */
 	memset( scoreboardInfo, 0, sizeof( SCOREBOARD_INFO ) );
@@ -637,20 +1002,18 @@ static int lookupScoreboard( INOUT SCOREBOARD_INDEX_INFO *scoreboardIndexInfo,
 	if( currentTime <= MIN_TIME_VALUE )
 		return( CRYPT_ERROR_NOTFOUND );
 
-	/* Try and find this entry in the scoreboard */
-	status = findEntry( scoreboardIndexInfo, keyType, key, keyLength, 
-						currentTime, &position );
+	/* Clear out any expired entries and try and find this entry in the
+	   scoreboard */
+	status = expireEntries( scoreboardShard, currentTime );
 	if( cryptStatusError( status ) )
-		{
-		/* An OK_SPECIAL status means that the search found an unused entry 
-		   position but not a matching entry (this is used by addEntry()), 
-		   anything else is an error */
-		return( ( status == OK_SPECIAL ) ? CRYPT_ERROR_NOTFOUND : status );
-		}
-	ENSURES( position >= 0 && position < scoreboardIndexInfo->noEntries );
+		return( status );
+	status = findEntry( scoreboardShard, keyType, keyInfo, &position );
+	if( cryptStatusError( status ) )
+		return( status );
+	ENSURES( position >= 0 && position < scoreboardShard->noEntries );
 	scoreboardEntryPtr = &scoreboardIndex[ position ];
 
-	/* We've found a match, return a pointer to the data (which avoids 
+	/* We've found a match, return a pointer to the data (which avoids
 	   copying it out of secure memory) and the unique ID for it */
 	scoreboardInfo->key = scoreboardEntryPtr->sessionID;
 	scoreboardInfo->keySize = scoreboardEntryPtr->sessionIDlength;
@@ -659,14 +1022,88 @@ static int lookupScoreboard( INOUT SCOREBOARD_INDEX_INFO *scoreboardIndexInfo,
 	scoreboardInfo->metaData = scoreboardEntryPtr->metaData;
 	*uniqueID = scoreboardEntryPtr->uniqueID;
 
-	/* Update the entry's last-access date */
+	/* Update the entry's last-access date and move it to the front of the
+	   LRU list */
 	scoreboardEntryPtr->timeStamp = currentTime;
+	deleteLRU( scoreboardShard, position );
+	insertLRU( scoreboardShard, position );
 
-	ENSURES( sanityCheckScoreboard( scoreboardIndexInfo ) );
+	ENSURES( sanityCheckScoreboard( scoreboardShard ) );
 
 	return( CRYPT_OK );
 	}
 
+#ifdef USE_SHARED_SCOREBOARD
+
+/* If a server entry isn't in our scoreboard, it may have been added by
+   another process that's using the shared scoreboard.  If it's present
+   there, we copy it into our own scoreboard and return it from there so
+   that the caller gets it in the same way as a local entry and we don't
+   have to go back to the shared scoreboard the next time that it's used */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 4, 6, 7 ) ) \
+static int lookupSharedEntry( INOUT SCOREBOARD_SHARD *scoreboardShard,
+							  IN_RANGE( 0, SCOREBOARD_SHARDS - 1 ) \
+									const int shardNo,
+							  IN_BUFFER( keyLength ) const void *key,
+							  const SCOREBOARD_KEY_INFO *keyInfo,
+							  IN_LENGTH_SHORT_MIN( 2 ) const int keyLength,
+							  OUT SCOREBOARD_INFO *scoreboardInfo,
+							  OUT_INT_Z int *uniqueID )
+	{
+	SCOREBOARD_INFO sharedInfo;
+	BYTE data[ SCOREBOARD_DATA_SIZE + 8 ];
+	int dataLength, metaData, status;
+
+	assert( isWritePtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+	assert( isReadPtrDynamic( key, keyLength ) );
+	assert( isReadPtr( keyInfo, sizeof( SCOREBOARD_KEY_INFO ) ) );
+	assert( isWritePtr( scoreboardInfo, sizeof( SCOREBOARD_INFO ) ) );
+	assert( isWritePtr( uniqueID, sizeof( int ) ) );
+
+	REQUIRES( shardNo >= 0 && shardNo < SCOREBOARD_SHARDS );
+	REQUIRES( keyLength >= SCOREBOARD_KEY_MIN && \
+			  keyLength < MAX_INTLENGTH_SHORT );
+
+	/* Clear return values */
+	memset( scoreboardInfo, 0, sizeof( SCOREBOARD_INFO ) );
+	*uniqueID = CRYPT_ERROR;
+
+	/* Look for the entry in the shared scoreboard.  This is done without
+	   holding the shard mutex since it may involve waiting for another
+	   process */
+	status = lookupSharedScoreboardEntry( keyInfo->hashValue, data,
+										  SCOREBOARD_DATA_SIZE, &dataLength,
+										  &metaData );
+	if( cryptStatusError( status ) )
+		return( status );
+	memset( &sharedInfo, 0, sizeof( SCOREBOARD_INFO ) );
+	sharedInfo.data = data;
+	sharedInfo.dataSize = dataLength;
+	sharedInfo.metaData = metaData;
+
+	/* Add the entry to our scoreboard and return it from there */
+	status = krnlEnterMutex( shardMutexes[ shardNo ] );
+	if( cryptStatusError( status ) )
+		{
+		zeroise( data, SCOREBOARD_DATA_SIZE );
+		return( status );
+		}
+	status = addEntry( scoreboardShard, shardNo, key, keyInfo, keyLength,
+					   NULL, NULL, 0, &sharedInfo, uniqueID );
+	if( cryptStatusOK( status ) )
+		{
+		status = lookupScoreboard( scoreboardShard,
+								   SCOREBOARD_KEY_SESSIONID_SVR, keyInfo,
+								   scoreboardInfo, uniqueID );
+		}
+	krnlExitMutex( shardMutexes[ shardNo ] );
+	zeroise( data, SCOREBOARD_DATA_SIZE );
+
+	return( status );
+	}
+#endif /* USE_SHARED_SCOREBOARD */
+
 /****************************************************************************
 *																			*
 *							Scoreboard Access Functions						*
@@ -674,24 +1111,28 @@ static int lookupScoreboard( INOUT SCOREBOARD_INDEX_INFO *scoreboardIndexInfo,
 ****************************************************************************/
 
 /* Add and delete entries to/from the scoreboard.  These are just wrappers
-   for the local scoreboard-access function, for use by external code */
+   for the local scoreboard-access function, for use by external code.  The
+   key hashing is done before we acquire the shard mutex so that the time
+   spent holding it is kept to a minimum */
 
 CHECK_RETVAL_RANGE( 0, MAX_INTLENGTH ) STDC_NONNULL_ARG( ( 1, 3, 5 ) ) \
 int lookupScoreboardEntry( INOUT TYPECAST( SCOREBOARD_INDEX_INFO * ) \
 								void *scoreboardIndexInfoPtr,
 						   IN_ENUM( SCOREBOARD_KEY ) \
 								const SCOREBOARD_KEY_TYPE keyType,
-						   IN_BUFFER( keyLength ) const void *key, 
-						   IN_LENGTH_SHORT_MIN( 2 ) const int keyLength, 
+						   IN_BUFFER( keyLength ) const void *key,
+						   IN_LENGTH_SHORT_MIN( 2 ) const int keyLength,
 						   OUT SCOREBOARD_INFO *scoreboardInfo )
 	{
 	SCOREBOARD_INDEX_INFO *scoreboardIndexInfo = scoreboardIndexInfoPtr;
-	int uniqueID, status;
+	SCOREBOARD_KEY_INFO keyInfo;
+	int shardNo, lastShardNo, uniqueID = CRYPT_ERROR;
+	int status = CRYPT_ERROR_NOTFOUND, LOOP_ITERATOR;
 
-	assert( isWritePtr( scoreboardIndexInfo, 
+	assert( isWritePtr( scoreboardIndexInfo,
 						sizeof( SCOREBOARD_INDEX_INFO ) ) );
 	assert( isReadPtrDynamic( key, keyLength ) );
-	assert( isWritePtr( scoreboardInfo, 
+	assert( isWritePtr( scoreboardInfo,
 						sizeof( SCOREBOARD_INFO ) ) );
 
 	REQUIRES( keyType > SCOREBOARD_KEY_NONE && \
@@ -702,25 +1143,57 @@ int lookupScoreboardEntry( INOUT TYPECAST( SCOREBOARD_INDEX_INFO * ) \
 	/* Clear return values */
 	memset( scoreboardInfo, 0, sizeof( SCOREBOARD_INFO ) );
 
-	status = krnlEnterMutex( MUTEX_SCOREBOARD );
+	status = getKeyInfo( &keyInfo, key, keyLength );
 	if( cryptStatusError( status ) )
 		return( status );
-	status = lookupScoreboard( scoreboardIndexInfo, keyType, key, keyLength, 
-							   scoreboardInfo, &uniqueID );
-	krnlExitMutex( MUTEX_SCOREBOARD );
+
+	/* Client entries are assigned to a shard by their FQDN rather than
+	   their session ID, so a lookup of a client session ID has to check
+	   every shard */
+	if( keyType == SCOREBOARD_KEY_SESSIONID_CLI )
+		{
+		shardNo = 0;
+		lastShardNo = SCOREBOARD_SHARDS - 1;
+		}
+	else
+		shardNo = lastShardNo = getShardNo( &keyInfo );
+	LOOP_SMALL_CHECKINC( shardNo <= lastShardNo, shardNo++ )
+		{
+		status = krnlEnterMutex( shardMutexes[ shardNo ] );
+		if( cryptStatusError( status ) )
+			return( status );
+		status = lookupScoreboard( &scoreboardIndexInfo->shards[ shardNo ],
+								   keyType, &keyInfo, scoreboardInfo,
+								   &uniqueID );
+		krnlExitMutex( shardMutexes[ shardNo ] );
+		if( status != CRYPT_ERROR_NOTFOUND )
+			break;
+		}
+	ENSURES( LOOP_BOUND_OK );
+#ifdef USE_SHARED_SCOREBOARD
+	if( status == CRYPT_ERROR_NOTFOUND && \
+		keyType == SCOREBOARD_KEY_SESSIONID_SVR )
+		{
+		shardNo = getShardNo( &keyInfo );
+		status = lookupSharedEntry( &scoreboardIndexInfo->shards[ shardNo ],
+									shardNo, key, &keyInfo, keyLength,
+									scoreboardInfo, &uniqueID );
+		}
+#endif /* USE_SHARED_SCOREBOARD */
 	return( cryptStatusError( status ) ? status : uniqueID );
 	}
 
 CHECK_RETVAL_RANGE( 0, MAX_INTLENGTH ) STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
 int addScoreboardEntry( INOUT void *scoreboardIndexInfoPtr,
-						IN_BUFFER( keyLength ) const void *key, 
-						IN_LENGTH_SHORT_MIN( 8 ) const int keyLength, 
+						IN_BUFFER( keyLength ) const void *key,
+						IN_LENGTH_SHORT_MIN( 8 ) const int keyLength,
 						const SCOREBOARD_INFO *scoreboardInfo )
 	{
 	SCOREBOARD_INDEX_INFO *scoreboardIndexInfo = scoreboardIndexInfoPtr;
-	int uniqueID, status;
+	SCOREBOARD_KEY_INFO keyInfo;
+	int shardNo, uniqueID, status;
 
-	assert( isWritePtr( scoreboardIndexInfo, 
+	assert( isWritePtr( scoreboardIndexInfo,
 						sizeof( SCOREBOARD_INDEX_INFO ) ) );
 	assert( isReadPtrDynamic( key, keyLength ) );
 	assert( isReadPtr( scoreboardInfo, sizeof( SCOREBOARD_INFO ) ) );
@@ -728,28 +1201,46 @@ int addScoreboardEntry( INOUT void *scoreboardIndexInfoPtr,
 	REQUIRES( keyLength >= SCOREBOARD_KEY_MIN && \
 			  keyLength < MAX_INTLENGTH_SHORT );
 
+	status = getKeyInfo( &keyInfo, key, keyLength );
+	if( cryptStatusError( status ) )
+		return( status );
+	shardNo = getShardNo( &keyInfo );
+
 	/* Add the entry to the scoreboard */
-	status = krnlEnterMutex( MUTEX_SCOREBOARD );
+	status = krnlEnterMutex( shardMutexes[ shardNo ] );
 	if( cryptStatusError( status ) )
 		return( status );
-	status = addEntry( scoreboardIndexInfo, key, keyLength, NULL, 0,
+	status = addEntry( &scoreboardIndexInfo->shards[ shardNo ], shardNo,
+					   key, &keyInfo, keyLength, NULL, NULL, 0,
 					   scoreboardInfo, &uniqueID );
-	krnlExitMutex( MUTEX_SCOREBOARD );
-	return( cryptStatusError( status ) ? status : uniqueID );
+	krnlExitMutex( shardMutexes[ shardNo ] );
+	if( cryptStatusError( status ) )
+		return( status );
+
+#ifdef USE_SHARED_SCOREBOARD
+	/* Server entries are also written through to the shared scoreboard so
+	   that other server processes can resume the session.  Failing to add
+	   the entry there isn't an error since we've already got it in our own
+	   scoreboard */
+	( void ) addSharedScoreboardEntry( keyInfo.hashValue, scoreboardInfo );
+#endif /* USE_SHARED_SCOREBOARD */
+
+	return( uniqueID );
 	}
 
 CHECK_RETVAL_RANGE( 0, MAX_INTLENGTH ) STDC_NONNULL_ARG( ( 1, 2, 4, 6 ) ) \
 int addScoreboardEntryEx( INOUT void *scoreboardIndexInfoPtr,
-						  IN_BUFFER( keyLength ) const void *key, 
-						  IN_LENGTH_SHORT_MIN( 8 ) const int keyLength, 
-						  IN_BUFFER( keyLength ) const void *altKey, 
-						  IN_LENGTH_SHORT_MIN( 2 ) const int altKeyLength, 
+						  IN_BUFFER( keyLength ) const void *key,
+						  IN_LENGTH_SHORT_MIN( 8 ) const int keyLength,
+						  IN_BUFFER( keyLength ) const void *altKey,
+						  IN_LENGTH_SHORT_MIN( 2 ) const int altKeyLength,
 						  const SCOREBOARD_INFO *scoreboardInfo )
 	{
 	SCOREBOARD_INDEX_INFO *scoreboardIndexInfo = scoreboardIndexInfoPtr;
-	int uniqueID, status;
+	SCOREBOARD_KEY_INFO keyInfo, altKeyInfo;
+	int shardNo, uniqueID, status;
 
-	assert( isWritePtr( scoreboardIndexInfo, 
+	assert( isWritePtr( scoreboardIndexInfo,
 						sizeof( SCOREBOARD_INDEX_INFO ) ) );
 	assert( isReadPtrDynamic( key, keyLength ) );
 	assert( isReadPtrDynamic( altKey, altKeyLength ) );
@@ -760,62 +1251,73 @@ int addScoreboardEntryEx( INOUT void *scoreboardIndexInfoPtr,
 	REQUIRES( altKeyLength >= SCOREBOARD_KEY_MIN && \
 			  altKeyLength < MAX_INTLENGTH_SHORT );
 
+	/* Client entries are looked up by FQDN so the shard that they're
+	   stored in is determined by the FQDN rather than the session ID */
+	status = getKeyInfo( &keyInfo, key, keyLength );
+	if( cryptStatusOK( status ) )
+		status = getKeyInfo( &altKeyInfo, altKey, altKeyLength );
+	if( cryptStatusError( status ) )
+		return( status );
+	shardNo = getShardNo( &altKeyInfo );
+
 	/* Add the entry to the scoreboard */
-	status = krnlEnterMutex( MUTEX_SCOREBOARD );
+	status = krnlEnterMutex( shardMutexes[ shardNo ] );
 	if( cryptStatusError( status ) )
 		return( status );
-	status = addEntry( scoreboardIndexInfo, key, keyLength, altKey, 
+	status = addEntry( &scoreboardIndexInfo->shards[ shardNo ], shardNo,
+					   key, &keyInfo, keyLength, altKey, &altKeyInfo,
 					   altKeyLength, scoreboardInfo, &uniqueID );
-	krnlExitMutex( MUTEX_SCOREBOARD );
+	krnlExitMutex( shardMutexes[ shardNo ] );
 	return( cryptStatusError( status ) ? status : uniqueID );
 	}
 
 STDC_NONNULL_ARG( ( 1 ) ) \
 void deleteScoreboardEntry( INOUT TYPECAST( SCOREBOARD_INDEX_INFO * ) \
-								void *scoreboardIndexInfoPtr, 
+								void *scoreboardIndexInfoPtr,
 							IN_INT_Z const int uniqueID )
 	{
 	SCOREBOARD_INDEX_INFO *scoreboardIndexInfo = scoreboardIndexInfoPtr;
-	SCOREBOARD_INDEX *scoreboardIndex = scoreboardIndexInfo->index;
-	int lastUsedEntry = -1, i, status, LOOP_ITERATOR;
+	SCOREBOARD_SHARD *scoreboardShard;
+	SCOREBOARD_INDEX *scoreboardIndex;
+	const int shardNo = uniqueID % SCOREBOARD_SHARDS;
+	const int *hashTable;
+	int entryNo, status, LOOP_ITERATOR;
 
-	assert( isWritePtr( scoreboardIndexInfo, 
+	assert( isWritePtr( scoreboardIndexInfo,
 						sizeof( SCOREBOARD_INDEX_INFO ) ) );
-	
+
 	REQUIRES_V( uniqueID >= 0 && \
 				uniqueID < MAX_INTLENGTH );
 
-	status = krnlEnterMutex( MUTEX_SCOREBOARD );
+	/* The unique ID tells us which shard the entry is in */
+	scoreboardShard = &scoreboardIndexInfo->shards[ shardNo ];
+	scoreboardIndex = scoreboardShard->index;
+	status = krnlEnterMutex( shardMutexes[ shardNo ] );
 	if( cryptStatusError( status ) )
 		return;
 
-	/* Search the scoreboard for the entry with the given ID */
-	LOOP_MAX( i = 0, i < scoreboardIndexInfo->lastEntry, i++ )
+	/* Search the unique-ID index for the entry with the given ID */
+	hashTable = getHashTable( scoreboardShard, SCOREBOARD_TABLE_UNIQUEID );
+	if( hashTable == NULL )
+		{
+		krnlExitMutex( shardMutexes[ shardNo ] );
+		return;
+		}
+	LOOP_MAX( entryNo = hashTable[ getUniqueIDposition( scoreboardShard,
+														uniqueID ) ],
+			  entryNo >= 0 && entryNo < scoreboardShard->noEntries,
+			  entryNo = scoreboardIndex[ entryNo ].nextUniqueID )
 		{
-		SCOREBOARD_INDEX *scoreboardEntryPtr = &scoreboardIndex[ i ];
-
-		/* If it's an empty entry (due to it having expired or being 
-		   deleted), skip it and continue */
-		if( scoreboardEntryPtr->timeStamp <= MIN_TIME_VALUE )
-			continue;
-
 		/* If we've found the entry that we're after, clear it and exit */
-		if( scoreboardEntryPtr->uniqueID == uniqueID )
+		if( scoreboardIndex[ entryNo ].uniqueID == uniqueID )
 			{
-			clearScoreboardEntry( scoreboardEntryPtr );
-			continue;
+			( void ) deleteEntry( scoreboardShard, entryNo );
+			break;
 			}
-
-		/* Remember how far we got */
-		lastUsedEntry = i;
 		}
-	ENSURES_V( LOOP_BOUND_OK );
-
-	/* Since we may have deleted entries at the end of the scoreboard, we 
-	   can reduce the lastEntry value to the highest remaining entry */
-	scoreboardIndexInfo->lastEntry = lastUsedEntry + 1;
+	assert( LOOP_BOUND_OK );
 
-	krnlExitMutex( MUTEX_SCOREBOARD );
+	krnlExitMutex( shardMutexes[ shardNo ] );
 	}
 
 /****************************************************************************
@@ -830,9 +1332,9 @@ CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
 static BOOLEAN selfTest( INOUT SCOREBOARD_INDEX_INFO *scoreboardIndexInfo )
 	{
 	SCOREBOARD_INFO scoreboardInfo;
-	int uniqueID1, uniqueID2, foundUniqueID, status;
+	int uniqueID1, uniqueID2, foundUniqueID, i, status, LOOP_ITERATOR;
 
-	assert( isWritePtr( scoreboardIndexInfo, 
+	assert( isWritePtr( scoreboardIndexInfo,
 						sizeof( SCOREBOARD_INDEX_INFO ) ) );
 
 	memset( &scoreboardInfo, 0, sizeof( SCOREBOARD_INFO ) );
@@ -850,8 +1352,10 @@ static BOOLEAN selfTest( INOUT SCOREBOARD_INDEX_INFO *scoreboardIndexInfo )
 							&scoreboardInfo );
 	if( cryptStatusError( status ) )
 		return( FALSE );
+	if( uniqueID1 == uniqueID2 )
+		return( FALSE );
 	status = foundUniqueID = \
-		lookupScoreboardEntry( scoreboardIndexInfo, SCOREBOARD_KEY_SESSIONID_SVR, 
+		lookupScoreboardEntry( scoreboardIndexInfo, SCOREBOARD_KEY_SESSIONID_SVR,
 							   "test key 1", 10, &scoreboardInfo );
 	if( cryptStatusError( status ) )
 		return( FALSE );
@@ -862,97 +1366,256 @@ static BOOLEAN selfTest( INOUT SCOREBOARD_INDEX_INFO *scoreboardIndexInfo )
 		memcmp( scoreboardInfo.data, "test value 1", 12 ) )
 		return( FALSE );
 	deleteScoreboardEntry( scoreboardIndexInfo, uniqueID1 );
-	foundUniqueID = lookupScoreboardEntry( scoreboardIndexInfo, 
+	foundUniqueID = lookupScoreboardEntry( scoreboardIndexInfo,
 							SCOREBOARD_KEY_SESSIONID_SVR, "test key 1", 10,
 							&scoreboardInfo );
 	if( foundUniqueID != CRYPT_ERROR_NOTFOUND )
 		return( FALSE );
 	deleteScoreboardEntry( scoreboardIndexInfo, uniqueID2 );
-	if( scoreboardIndexInfo->lastEntry != 0 || \
-		scoreboardIndexInfo->uniqueID != 2 )
-		return( FALSE );
+	LOOP_SMALL( i = 0, i < SCOREBOARD_SHARDS, i++ )
+		{
+		const SCOREBOARD_SHARD *scoreboardShard = \
+									&scoreboardIndexInfo->shards[ i ];
+
+		if( scoreboardShard->noUsedEntries != 0 || \
+			scoreboardShard->lruHead != CRYPT_ERROR || \
+			scoreboardShard->lruTail != CRYPT_ERROR )
+			return( FALSE );
+		}
+	ENSURES_B( LOOP_BOUND_OK );
 
 	return( TRUE );
 	}
 
-/* Initialise and shut down the scoreboard */
+/* Free the storage for a scoreboard shard.  This can be called for a
+   partially-initialised shard if an allocation fails during
+   initialisation */
+
+STDC_NONNULL_ARG( ( 1 ) ) \
+static void freeShard( INOUT SCOREBOARD_SHARD *scoreboardShard )
+	{
+	SCOREBOARD_DATA **dataBlocks = scoreboardShard->dataBlocks;
+	int i, LOOP_ITERATOR;
+
+	assert( isWritePtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+
+	if( dataBlocks != NULL )
+		{
+		LOOP_LARGE( i = 0, i < scoreboardShard->noDataBlocks, i++ )
+			{
+			if( dataBlocks[ i ] != NULL )
+				( void ) krnlMemfree( ( void ** ) &dataBlocks[ i ] );
+			}
+		clFree( "freeShard", dataBlocks );
+		}
+	if( scoreboardShard->index != NULL )
+		{
+		zeroise( scoreboardShard->index,
+				 scoreboardShard->noEntries * sizeof( SCOREBOARD_INDEX ) );
+		clFree( "freeShard", scoreboardShard->index );
+		}
+	if( scoreboardShard->hashTables != NULL )
+		clFree( "freeShard", scoreboardShard->hashTables );
+	zeroise( scoreboardShard, sizeof( SCOREBOARD_SHARD ) );
+	}
+
+/* Allocate and initialise the storage for a scoreboard shard */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int initShard( OUT SCOREBOARD_SHARD *scoreboardShard,
+					  IN_RANGE( SCOREBOARD_SHARD_MIN, SCOREBOARD_SHARD_MAX ) \
+							const int noEntries )
+	{
+	SCOREBOARD_INDEX *scoreboardIndex;
+	SCOREBOARD_DATA **dataBlocks;
+	const int noDataBlocks = \
+		( noEntries + SCOREBOARD_DATA_BLOCKSIZE - 1 ) / \
+		SCOREBOARD_DATA_BLOCKSIZE;
+	int hashSize, i, status, LOOP_ITERATOR;
+
+	assert( isWritePtr( scoreboardShard, sizeof( SCOREBOARD_SHARD ) ) );
+
+	REQUIRES( noEntries >= SCOREBOARD_SHARD_MIN && \
+			  noEntries <= SCOREBOARD_SHARD_MAX );
+
+	memset( scoreboardShard, 0, sizeof( SCOREBOARD_SHARD ) );
+
+	/* The hash indices have one position for each entry, rounded up to the
+	   next power of two */
+	LOOP_MED( hashSize = 1, hashSize < noEntries, hashSize <<= 1 );
+	ENSURES( LOOP_BOUND_OK );
+
+	/* Allocate the index, hash tables, and data blocks */
+	scoreboardShard->noEntries = noEntries;
+	scoreboardShard->hashSize = hashSize;
+	scoreboardShard->index = scoreboardIndex = \
+		clAlloc( "initShard", noEntries * sizeof( SCOREBOARD_INDEX ) );
+	scoreboardShard->hashTables = \
+		clAlloc( "initShard", SCOREBOARD_TABLE_LAST * hashSize * sizeof( int ) );
+	scoreboardShard->dataBlocks = dataBlocks = \
+		clAlloc( "initShard", noDataBlocks * sizeof( SCOREBOARD_DATA * ) );
+	if( scoreboardIndex == NULL || scoreboardShard->hashTables == NULL || \
+		dataBlocks == NULL )
+		{
+		DEBUG_DIAG(( "Couldn't allocate memory for %d-entry scoreboard "
+					 "shard", noEntries ));
+		freeShard( scoreboardShard );
+		return( CRYPT_ERROR_MEMORY );
+		}
+	memset( dataBlocks, 0, noDataBlocks * sizeof( SCOREBOARD_DATA * ) );
+	scoreboardShard->noDataBlocks = noDataBlocks;
+	LOOP_LARGE( i = 0, i < noDataBlocks, i++ )
+		{
+		const int blockEntries = \
+			min( noEntries - ( i * SCOREBOARD_DATA_BLOCKSIZE ),
+				 SCOREBOARD_DATA_BLOCKSIZE );
+
+		status = krnlMemalloc( ( void ** ) &dataBlocks[ i ],
+							   blockEntries * sizeof( SCOREBOARD_DATA ) );
+		if( cryptStatusError( status ) )
+			{
+			DEBUG_DIAG(( "Couldn't allocate %d bytes secure memory for "
+						 "scoreboard data",
+						 blockEntries * sizeof( SCOREBOARD_DATA ) ));
+			freeShard( scoreboardShard );
+			return( status );
+			}
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	/* Initialise the index entries and place them all on the free list, and
+	   clear the hash tables */
+	memset( scoreboardIndex, 0, noEntries * sizeof( SCOREBOARD_INDEX ) );
+	LOOP_MAX( i = 0, i < noEntries, i++ )
+		{
+		SCOREBOARD_INDEX *scoreboardEntryPtr = &scoreboardIndex[ i ];
+
+		scoreboardEntryPtr->data = \
+			&dataBlocks[ i / SCOREBOARD_DATA_BLOCKSIZE ] \
+					   [ i % SCOREBOARD_DATA_BLOCKSIZE ];
+		clearScoreboardEntry( scoreboardEntryPtr );
+		scoreboardEntryPtr->lruNext = ( i < noEntries - 1 ) ? \
+									  i + 1 : CRYPT_ERROR;
+		}
+	ENSURES( LOOP_BOUND_OK );
+	LOOP_MAX( i = 0, i < hashSize, i++ )
+		{
+		int j, LOOP_ITERATOR_ALT;
+
+		LOOP_SMALL_ALT( j = 0, j < SCOREBOARD_TABLE_LAST, j++ )
+			scoreboardShard->hashTables[ ( j * hashSize ) + i ] = CRYPT_ERROR;
+		ENSURES( LOOP_BOUND_OK_ALT );
+		}
+	ENSURES( LOOP_BOUND_OK );
+	scoreboardShard->lruHead = scoreboardShard->lruTail = CRYPT_ERROR;
+	scoreboardShard->freeHead = 0;
+
+	ENSURES( sanityCheckScoreboard( scoreboardShard ) );
+
+	return( CRYPT_OK );
+	}
+
+/* Initialise and shut down the scoreboard.  We acquire the mutexes for all
+   of the shards, always in the same order, while we're doing this */
+
+static void unlockScoreboard( IN_RANGE( 0, SCOREBOARD_SHARDS ) \
+								const int noLockedShards )
+	{
+	int i, LOOP_ITERATOR;
+
+	LOOP_SMALL( i = noLockedShards - 1, i >= 0, i-- )
+		krnlExitMutex( shardMutexes[ i ] );
+	}
+
+CHECK_RETVAL \
+static int lockScoreboard( void )
+	{
+	int i, status, LOOP_ITERATOR;
+
+	LOOP_SMALL( i = 0, i < SCOREBOARD_SHARDS, i++ )
+		{
+		status = krnlEnterMutex( shardMutexes[ i ] );
+		if( cryptStatusError( status ) )
+			{
+			unlockScoreboard( i );
+			return( status );
+			}
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	return( CRYPT_OK );
+	}
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
 int initScoreboard( INOUT TYPECAST( SCOREBOARD_INDEX_INFO * ) \
-						void *scoreboardIndexInfoPtr, 
-					IN_LENGTH_SHORT_MIN( SCOREBOARD_MIN_SIZE ) \
+						void *scoreboardIndexInfoPtr,
+					IN_RANGE( SCOREBOARD_MIN_SIZE, SCOREBOARD_MAX_SIZE ) \
 						const int scoreboardEntries )
 	{
 	SCOREBOARD_INDEX_INFO *scoreboardIndexInfo = scoreboardIndexInfoPtr;
-	SCOREBOARD_INDEX *scoreboardIndex;
-	SCOREBOARD_DATA *scoreboardData;
-	int i, status, LOOP_ITERATOR;
+	SCOREBOARD_INDEX_INFO newScoreboardIndexInfo;
+	const int shardEntries = \
+		( scoreboardEntries + SCOREBOARD_SHARDS - 1 ) / SCOREBOARD_SHARDS;
+	int i, status = CRYPT_OK, LOOP_ITERATOR;
 
-	assert( isWritePtr( scoreboardIndexInfo, 
+	assert( isWritePtr( scoreboardIndexInfo,
 						sizeof( SCOREBOARD_INDEX_INFO ) ) );
-	
+
 	static_assert( sizeof( SCOREBOARD_STATE ) >= sizeof( SCOREBOARD_INDEX_INFO ), \
 				   "Scoreboard size" );
+	static_assert( SCOREBOARD_DATA_BLOCKSIZE * sizeof( SCOREBOARD_DATA ) <= 8192, \
+				   "Scoreboard data block size" );
 
 	REQUIRES( scoreboardEntries >= SCOREBOARD_MIN_SIZE && \
 			  scoreboardEntries <= SCOREBOARD_MAX_SIZE );
 
-	/* Allocate memory for the scoreboard, which we can do before acquiring 
-	   the scoreboard mutex */
-	scoreboardIndex = clAlloc( "initScoreboard", \
-						scoreboardEntries * sizeof( SCOREBOARD_INDEX ) );
-	if( scoreboardIndex == NULL )
+	/* Allocate memory for the scoreboard, which we can do before acquiring
+	   the scoreboard mutexes */
+	memset( &newScoreboardIndexInfo, 0, sizeof( SCOREBOARD_INDEX_INFO ) );
+	LOOP_SMALL( i = 0, i < SCOREBOARD_SHARDS, i++ )
 		{
-		DEBUG_DIAG(( "Couldn't allocate %d bytes for scoreboard",
-					 scoreboardEntries * sizeof( SCOREBOARD_INDEX ) ));
-		return( CRYPT_ERROR_MEMORY );
+		status = initShard( &newScoreboardIndexInfo.shards[ i ],
+							shardEntries );
+		if( cryptStatusError( status ) )
+			break;
 		}
-	status = krnlMemalloc( ( void ** ) &scoreboardData, \
-						   scoreboardEntries * sizeof( SCOREBOARD_DATA ) );
+	ENSURES( LOOP_BOUND_OK );
 	if( cryptStatusError( status ) )
 		{
-		clFree( "initScoreboard", scoreboardIndex );
-		DEBUG_DIAG(( "Couldn't allocate %d bytes secure memory for "
-					 "scoreboard data",
-					 scoreboardEntries * sizeof( SCOREBOARD_DATA ) ));
+		LOOP_SMALL( i = 0, i < SCOREBOARD_SHARDS, i++ )
+			freeShard( &newScoreboardIndexInfo.shards[ i ] );
 		return( status );
 		}
+	newScoreboardIndexInfo.noEntries = shardEntries * SCOREBOARD_SHARDS;
 
-	status = krnlEnterMutex( MUTEX_SCOREBOARD );
+	status = lockScoreboard();
 	if( cryptStatusError( status ) )
+		{
+		LOOP_SMALL( i = 0, i < SCOREBOARD_SHARDS, i++ )
+			freeShard( &newScoreboardIndexInfo.shards[ i ] );
 		return( status );
+		}
 
 	/* Initialise the scoreboard */
-	memset( scoreboardIndexInfo, 0, sizeof( SCOREBOARD_INDEX_INFO ) );
-	scoreboardIndexInfo->index = scoreboardIndex;
-	scoreboardIndexInfo->data = scoreboardData;
-	scoreboardIndexInfo->noEntries = scoreboardEntries;
-	scoreboardIndexInfo->lastEntry = 0;
-	scoreboardIndexInfo->uniqueID = 0;
-	memset( scoreboardIndex, 0, \
-			scoreboardEntries * sizeof( SCOREBOARD_INDEX ) );
-	LOOP_MAX( i = 0, i < scoreboardEntries, i++ )
-		scoreboardIndex[ i ].data = &scoreboardData[ i ];
-	ENSURES( LOOP_BOUND_OK );
-	memset( scoreboardIndexInfo->data, 0, \
-			scoreboardEntries * sizeof( SCOREBOARD_DATA ) );
+	memcpy( scoreboardIndexInfo, &newScoreboardIndexInfo,
+			sizeof( SCOREBOARD_INDEX_INFO ) );
+	zeroise( &newScoreboardIndexInfo, sizeof( SCOREBOARD_INDEX_INFO ) );
 
 	/* Make sure that everything's working as intended */
 #ifndef CONFIG_FUZZ
 	if( !selfTest( scoreboardIndexInfo ) )
 		{
-		status = krnlMemfree( ( void ** ) &scoreboardIndexInfo->data );
-		ENSURES( cryptStatusOK( status ) );
-		clFree( "initScoreboard", scoreboardIndexInfo->index );
+		LOOP_SMALL( i = 0, i < SCOREBOARD_SHARDS, i++ )
+			freeShard( &scoreboardIndexInfo->shards[ i ] );
 		memset( scoreboardIndexInfo, 0, sizeof( SCOREBOARD_INDEX_INFO ) );
 		DEBUG_DIAG(( "Couldn't initialise scoreboard" ));
 
-		krnlExitMutex( MUTEX_SCOREBOARD );
+		unlockScoreboard( SCOREBOARD_SHARDS );
 		retIntError();
 		}
 #endif /* !CONFIG_FUZZ */
 
-	krnlExitMutex( MUTEX_SCOREBOARD );
+	unlockScoreboard( SCOREBOARD_SHARDS );
 	return( CRYPT_OK );
 	}
 
@@ -961,30 +1624,27 @@ void endScoreboard( INOUT TYPECAST( SCOREBOARD_INDEX_INFO * ) \
 						void *scoreboardIndexInfoPtr )
 	{
 	SCOREBOARD_INDEX_INFO *scoreboardIndexInfo = scoreboardIndexInfoPtr;
-	int status;
+	int i, status, LOOP_ITERATOR;
 
-	assert( isWritePtr( scoreboardIndexInfo, 
+	assert( isWritePtr( scoreboardIndexInfo,
 						sizeof( SCOREBOARD_INDEX_INFO ) ) );
 
-	/* Shut down the scoreboard.  We acquire the mutex while we're doing 
-	   this to ensure that any threads still using it have exited before we 
-	   destroy it.  Exactly what to do if we can't acquire the mutex is a 
-	   bit complicated because failing to acquire the mutex is a special-
-	   case exception condition so it's not even possible to plan for this 
-	   since it's uncertain under which conditions (if ever) it would 
-	   occur.  For now we play it by the book and don't do anything if we 
-	   can't acquire the mutex, which is at least consistent */
-	status = krnlEnterMutex( MUTEX_SCOREBOARD );
+	/* Shut down the scoreboard.  We acquire the mutexes while we're doing
+	   this to ensure that any threads still using it have exited before we
+	   destroy it.  Exactly what to do if we can't acquire the mutexes is a
+	   bit complicated because failing to acquire a mutex is a special-
+	   case exception condition so it's not even possible to plan for this
+	   since it's uncertain under which conditions (if ever) it would
+	   occur.  For now we play it by the book and don't do anything if we
+	   can't acquire the mutexes, which is at least consistent */
+	status = lockScoreboard();
 	ENSURES_V( cryptStatusOK( status ) );	/* See comment above */
 
 	/* Clear and free the scoreboard */
-	status = krnlMemfree( ( void ** ) &scoreboardIndexInfo->data );
-	ENSURES_V( cryptStatusOK( status ) );	/* See comment above */
-	zeroise( scoreboardIndexInfo->index, \
-			 scoreboardIndexInfo->noEntries * sizeof( SCOREBOARD_INDEX ) );
-	clFree( "endScoreboard", scoreboardIndexInfo->index );
+	LOOP_SMALL( i = 0, i < SCOREBOARD_SHARDS, i++ )
+		freeShard( &scoreboardIndexInfo->shards[ i ] );
 	zeroise( scoreboardIndexInfo, sizeof( SCOREBOARD_INDEX_INFO ) );
 
-	krnlExitMutex( MUTEX_SCOREBOARD );
+	unlockScoreboard( SCOREBOARD_SHARDS );
 	}
 #endif /* USE_SSL */
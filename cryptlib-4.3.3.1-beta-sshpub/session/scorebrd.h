@@ -9,6 +9,26 @@
 
 #define _SCOREBRD_DEFINED
 
+/* Stateless session resumption via TLS session tickets (RFC 5077) is the 
+   counterpart to the scoreboard for servers.  Since the ticket has to 
+   carry the session state around with it, it's only enabled if we're not 
+   trying to conserve memory */
+
+#if defined( USE_SSL ) && !defined( CONFIG_CONSERVE_MEMORY )
+  #define USE_SSL_TICKETS
+#endif /* USE_SSL && !CONFIG_CONSERVE_MEMORY */
+
+/* Servers that run as a group of processes rather than a group of threads
+   can share session cache entries through a memory-mapped cache file.  The
+   entries are protected with keys derived from the shared ticket keys, so 
+   this requires ticket support as well as mmap() and atomic operations to 
+   lock the cache buckets */
+
+#if defined( USE_SSL_TICKETS ) && defined( __UNIX__ ) && \
+	defined( __GNUC__ ) && !defined( CONFIG_NO_SHAREDSCOREBOARD )
+  #define USE_SHARED_SCOREBOARD
+#endif /* USE_SSL_TICKETS && __UNIX__ && __GNUC__ */
+
 /****************************************************************************
 *																			*
 *						Scoreboard Types and Structures						*
@@ -46,7 +66,7 @@ typedef struct {
    it's declared as a void * because to the caller it's an opaque memory 
    block while to the scoreboard routines it's structured storage */
 
-typedef BYTE SCOREBOARD_STATE[ 64 ];
+typedef BYTE SCOREBOARD_STATE[ 384 ];
 
 /****************************************************************************
 *																			*
@@ -82,11 +102,74 @@ void deleteScoreboardEntry( INOUT void *scoreboardIndexInfoPtr,
 #ifdef USE_SSL
   CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
   int initScoreboard( INOUT void *scoreboardIndexInfoPtr, 
-					  IN_LENGTH_SHORT_MIN( 8 ) const int scoreboardEntries );
+					  IN_RANGE( MIN_SESSIONCACHE_SIZE, MAX_SESSIONCACHE_SIZE ) \
+						const int scoreboardEntries );
   STDC_NONNULL_ARG( ( 1 ) ) \
   void endScoreboard( INOUT void *scoreboardIndexInfoPtr );
 #else
   #define initScoreboard( scoreboardInfo, scoreboardSize )	CRYPT_OK
   #define endScoreboard( scoreboardInfo )
 #endif /* USE_SSL */
+
+/* The size of the data stored in a shared scoreboard entry and of the
+   sealed form of the entry, see ssl_tkt.c */
+
+#define SHARED_SCOREBOARD_DATA_SIZE		64
+#define SHARED_SCOREBOARD_SEALED_SIZE	( 16 + 16 + \
+										  SHARED_SCOREBOARD_DATA_SIZE + 32 )
+
+/* Shared scoreboard management functions */
+
+#ifdef USE_SHARED_SCOREBOARD
+  CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4, 5 ) ) \
+  int lookupSharedScoreboardEntry( IN_BUFFER( HASH_DATA_SIZE ) \
+										const BYTE *keyHash,
+								   OUT_BUFFER( dataMaxLength, \
+											   *dataLength ) void *data,
+								   IN_LENGTH_SHORT const int dataMaxLength,
+								   OUT_LENGTH_BOUNDED_Z( dataMaxLength ) \
+										int *dataLength,
+								   OUT_INT_Z int *metaData );
+  CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+  int addSharedScoreboardEntry( IN_BUFFER( HASH_DATA_SIZE ) \
+									const BYTE *keyHash,
+								const SCOREBOARD_INFO *scoreboardInfo );
+  CHECK_RETVAL \
+  int initSharedScoreboard( IN_RANGE( MIN_SESSIONCACHE_SIZE, \
+									  MAX_SESSIONCACHE_SIZE ) \
+								const int scoreboardEntries );
+  void endSharedScoreboard( void );
+#else
+  #define initSharedScoreboard( scoreboardEntries )	CRYPT_OK
+  #define endSharedScoreboard()
+#endif /* USE_SHARED_SCOREBOARD */
+
+/* Session ticket key management functions */
+
+#ifdef USE_SSL_TICKETS
+  CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+  int getSessionTicketStatistic( IN_ATTRIBUTE \
+									const CRYPT_ATTRIBUTE_TYPE attribute,
+								 OUT_INT_Z int *value );
+  CHECK_RETVAL \
+  int initSessionTickets( void );
+  void endSessionTickets( void );
+  CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+  int sealScoreboardEntry( IN_BUFFER( HASH_DATA_SIZE ) const BYTE *keyHash,
+						   IN_BUFFER( SHARED_SCOREBOARD_DATA_SIZE ) \
+								const BYTE *data,
+						   OUT_BUFFER_FIXED( SHARED_SCOREBOARD_SEALED_SIZE ) \
+								BYTE *sealedData );
+  CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+  int openScoreboardEntry( IN_BUFFER( HASH_DATA_SIZE ) const BYTE *keyHash,
+						   IN_BUFFER( SHARED_SCOREBOARD_SEALED_SIZE ) \
+								const BYTE *sealedData,
+						   OUT_BUFFER_FIXED( SHARED_SCOREBOARD_DATA_SIZE ) \
+								BYTE *data );
+#else
+  #define getSessionTicketStatistic( attribute, value ) \
+		  ( *( value ) = 0, CRYPT_OK )
+  #define initSessionTickets()			CRYPT_OK
+  #define endSessionTickets()
+#endif /* USE_SSL_TICKETS */
 #endif /* _SCOREBRD_DEFINED */
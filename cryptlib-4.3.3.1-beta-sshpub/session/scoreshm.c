@@ -0,0 +1,623 @@
+/****************************************************************************
+*																			*
+*						cryptlib Shared Session Scoreboard					*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#if defined( INC_ALL )
+  #include "crypt.h"
+  #include "misc_rw.h"
+  #include "session.h"
+  #include "scorebrd.h"
+#else
+  #include "crypt.h"
+  #include "enc_dec/misc_rw.h"
+  #include "session/session.h"
+  #include "session/scorebrd.h"
+#endif /* Compiler-specific includes */
+
+/* The scoreboard in scorebrd.c is private to the process that's using
+   cryptlib, which is fine for threaded servers but means that a server
+   that runs as a group of worker processes, or several servers on the same
+   machine behind a load balancer, can only resume a session if the client
+   happens to reconnect to the same process that it originally talked to.
+   The shared scoreboard is a second-level cache, held in a memory-mapped
+   file given by CRYPT_OPTION_SESSION_CACHEFILE, that every process using
+   the same file can see.  When an entry isn't found in the process' own
+   scoreboard we check the shared one, and entries added to the process'
+   own scoreboard are written through to the shared one.
+
+   The cache file consists of a header followed by an array of buckets,
+   each of which holds SHARED_BUCKET_ENTRIES entries and a lock word.
+   Entries are assigned to a bucket based on the hash of their key, and
+   when a bucket fills up the oldest entry in it is replaced.  The lock
+   word contains the process ID of the holder and is acquired with an
+   atomic compare-and-swap, so there's no lock covering the cache as a
+   whole and processes only contend if they're after the same bucket.  If
+   a process dies while holding a bucket lock (which can only happen
+   during the few memory copies that are performed with the lock held) the
+   next process to try for the bucket will find that the holder no longer
+   exists and take over the lock.
+
+   Since the cache file can be read by anything running with the server's
+   privileges, the entry data is sealed with keys derived from the shared
+   ticket keys (see ssl_tkt.c).  This means that the shared scoreboard is
+   only used when there's a ticket key file configured, which all of the
+   processes sharing the cache will need to have in any case in order to
+   resume sessions from each other's tickets */
+
+#ifdef USE_SHARED_SCOREBOARD
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* The number of entries in each bucket, the cache file format version, and
+   the magic value that identifies a cache file */
+
+#define SHARED_BUCKET_ENTRIES	4
+#define SHARED_VERSION			1
+#define SHARED_MAGIC			"cl_scbrd"
+#define SHARED_MAGIC_SIZE		8
+
+/* The maximum amount of time that an entry is retained in the shared
+   scoreboard, the same as for the process' own scoreboard */
+
+#define SHARED_TIMEOUT			3600
+
+/* How often we check whether the holder of a bucket lock is still alive
+   while we're waiting for the lock */
+
+#define SHARED_LOCKCHECK_MASK	0xFF
+
+/* The interval at which we check for the cache file if it's not
+   available */
+
+#define SHARED_RECHECK			60
+
+/* The cache file header, an entry in the cache, and a bucket of entries.
+   The data in the entry is laid out as:
+
+	byte		dataLength
+	uint32		metaData
+	byte[]		data
+	byte[]		padding				-- Zero
+
+   and stored in sealed form.  An entry with a zero timestamp is unused */
+
+typedef struct {
+	char magic[ SHARED_MAGIC_SIZE ];	/* Magic value */
+	int version;					/* Format version */
+	int noBuckets;					/* Number of buckets */
+	int bucketSize;					/* Size of each bucket */
+	BYTE padding[ 44 ];				/* Pad to 64 bytes */
+	} SHARED_HEADER;
+
+typedef struct {
+	BYTE keyHash[ HASH_DATA_SIZE ];	/* Hash of entry's key */
+	time_t timeStamp;				/* Time entry was added or used */
+	BYTE sealedData[ SHARED_SCOREBOARD_SEALED_SIZE ];
+	} SHARED_ENTRY;
+
+typedef struct {
+	volatile int lock;				/* PID of lock holder or zero */
+	int padding;
+	SHARED_ENTRY entries[ SHARED_BUCKET_ENTRIES ];
+	} SHARED_BUCKET;
+
+/* The mapped cache file */
+
+typedef struct {
+	void *mapping;					/* Mapped cache file */
+	size_t mappingSize;				/* Size of mapping */
+	SHARED_BUCKET *volatile buckets;/* Buckets in mapped file */
+	int noBuckets;					/* Number of buckets */
+	int requestedBuckets;			/* Buckets for a new cache file */
+	time_t checkTime;				/* When to next look for cache file */
+	} SHARED_SCOREBOARD_INFO;
+
+static SHARED_SCOREBOARD_INFO sharedScoreboardInfo;
+
+#define getSharedSize( noBuckets ) \
+		( sizeof( SHARED_HEADER ) + ( ( size_t ) ( noBuckets ) * \
+									  sizeof( SHARED_BUCKET ) ) )
+
+/****************************************************************************
+*																			*
+*								Utility Functions							*
+*																			*
+****************************************************************************/
+
+/* Get the bucket that an entry with the given key belongs in.  We use a
+   different part of the key hash than the one that scorebrd.c uses to
+   choose a shard so that all of the buckets get used even if only one
+   process is adding entries */
+
+CHECK_RETVAL_PTR STDC_NONNULL_ARG( ( 1 ) ) \
+static SHARED_BUCKET *getBucket( IN_BUFFER( HASH_DATA_SIZE ) \
+									const BYTE *keyHash )
+	{
+	const SHARED_SCOREBOARD_INFO *sharedInfo = &sharedScoreboardInfo;
+	const unsigned int hashValue = \
+			( ( unsigned int ) keyHash[ 4 ] << 24 ) | \
+			( ( unsigned int ) keyHash[ 5 ] << 16 ) | \
+			( ( unsigned int ) keyHash[ 6 ] << 8 ) | keyHash[ 7 ];
+
+	assert( isReadPtr( keyHash, HASH_DATA_SIZE ) );
+
+	if( sharedInfo->buckets == NULL || sharedInfo->noBuckets <= 0 )
+		return( NULL );
+	return( &sharedInfo->buckets[ hashValue % sharedInfo->noBuckets ] );
+	}
+
+/* Lock and unlock a bucket.  If we can't get the lock after a large number
+   of attempts then we give up, the caller treats this as a cache miss */
+
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+static BOOLEAN lockBucket( INOUT SHARED_BUCKET *bucket )
+	{
+	const int pid = ( int ) getpid();
+	int spinCount, LOOP_ITERATOR;
+
+	assert( isWritePtr( bucket, sizeof( SHARED_BUCKET ) ) );
+
+	LOOP_MAX( spinCount = 0,
+			  !__sync_bool_compare_and_swap( &bucket->lock, 0, pid ),
+			  spinCount++ )
+		{
+		const int lockHolder = bucket->lock;
+
+		/* Every now and then check whether the lock holder is still
+		   around, and if not take over the lock */
+		if( ( spinCount & SHARED_LOCKCHECK_MASK ) == \
+							SHARED_LOCKCHECK_MASK && \
+			lockHolder > 0 && lockHolder != pid && \
+			kill( lockHolder, 0 ) < 0 && errno == ESRCH )
+			{
+			if( __sync_bool_compare_and_swap( &bucket->lock, lockHolder,
+											  pid ) )
+				{
+				DEBUG_DIAG(( "Recovered shared scoreboard bucket lock from "
+							 "dead process %d", lockHolder ));
+				return( TRUE );
+				}
+			}
+		sched_yield();
+		}
+	if( !LOOP_BOUND_OK )
+		{
+		DEBUG_DIAG(( "Couldn't acquire shared scoreboard bucket lock" ));
+		return( FALSE );
+		}
+
+	return( TRUE );
+	}
+
+STDC_NONNULL_ARG( ( 1 ) ) \
+static void unlockBucket( INOUT SHARED_BUCKET *bucket )
+	{
+	assert( isWritePtr( bucket, sizeof( SHARED_BUCKET ) ) );
+
+	__sync_lock_release( &bucket->lock );
+	}
+
+/* Check whether an entry is in use and hasn't expired */
+
+CHECK_RETVAL_BOOL STDC_NONNULL_ARG( ( 1 ) ) \
+static BOOLEAN isValidEntry( const SHARED_ENTRY *entry,
+							 const time_t currentTime )
+	{
+	assert( isReadPtr( entry, sizeof( SHARED_ENTRY ) ) );
+
+	if( entry->timeStamp <= MIN_TIME_VALUE || \
+		entry->timeStamp > currentTime + 60 || \
+		currentTime >= entry->timeStamp + SHARED_TIMEOUT )
+		return( FALSE );
+
+	return( TRUE );
+	}
+
+/****************************************************************************
+*																			*
+*							Cache File Management							*
+*																			*
+****************************************************************************/
+
+/* Set up the cache file.  If the file is newly-created we write the header
+   and size it to fit the number of buckets that we want, otherwise we use
+   the geometry of the existing file.  The caller holds an exclusive lock
+   on the file while we do this so that two processes starting at the same
+   time don't both try and set it up */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+static int setupCacheFile( const int fd,
+						   OUT_INT_Z int *noBuckets,
+						   IN_RANGE( 1, MAX_SESSIONCACHE_SIZE ) \
+								const int requestedBuckets )
+	{
+	SHARED_HEADER header;
+	struct stat fileInfo;
+
+	assert( isWritePtr( noBuckets, sizeof( int ) ) );
+
+	REQUIRES( fd >= 0 );
+	REQUIRES( requestedBuckets > 0 && \
+			  requestedBuckets <= MAX_SESSIONCACHE_SIZE );
+
+	/* Clear return value */
+	*noBuckets = 0;
+
+	if( fstat( fd, &fileInfo ) < 0 )
+		return( CRYPT_ERROR_OPEN );
+
+	/* If it's a new file, set it up */
+	if( fileInfo.st_size == 0 )
+		{
+		memset( &header, 0, sizeof( SHARED_HEADER ) );
+		memcpy( header.magic, SHARED_MAGIC, SHARED_MAGIC_SIZE );
+		header.version = SHARED_VERSION;
+		header.noBuckets = requestedBuckets;
+		header.bucketSize = sizeof( SHARED_BUCKET );
+		if( ftruncate( fd, getSharedSize( requestedBuckets ) ) < 0 || \
+			pwrite( fd, &header, sizeof( SHARED_HEADER ), 0 ) != \
+										sizeof( SHARED_HEADER ) )
+			return( CRYPT_ERROR_WRITE );
+		*noBuckets = requestedBuckets;
+
+		return( CRYPT_OK );
+		}
+
+	/* It's an existing file, make sure that it's one that we can use */
+	if( pread( fd, &header, sizeof( SHARED_HEADER ), 0 ) != \
+										sizeof( SHARED_HEADER ) )
+		return( CRYPT_ERROR_READ );
+	if( memcmp( header.magic, SHARED_MAGIC, SHARED_MAGIC_SIZE ) || \
+		header.version != SHARED_VERSION || \
+		header.bucketSize != sizeof( SHARED_BUCKET ) || \
+		header.noBuckets <= 0 || \
+		header.noBuckets > MAX_SESSIONCACHE_SIZE || \
+		( size_t ) fileInfo.st_size != getSharedSize( header.noBuckets ) )
+		return( CRYPT_ERROR_BADDATA );
+	*noBuckets = header.noBuckets;
+
+	return( CRYPT_OK );
+	}
+
+/* Attach the cache file given in CRYPT_OPTION_SESSION_CACHEFILE.  Since
+   the shared scoreboard is only an optimisation, any problems with the
+   cache file are reported as the file not being available and the caller
+   continues with the process' own scoreboard */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int attachCacheFile( INOUT SHARED_SCOREBOARD_INFO *sharedInfo )
+	{
+	MESSAGE_DATA msgData;
+	char cacheFilePath[ MAX_PATH_LENGTH + 8 ];
+	void *mapping;
+	int fd, noBuckets, status;
+
+	assert( isWritePtr( sharedInfo, sizeof( SHARED_SCOREBOARD_INFO ) ) );
+
+	REQUIRES( sharedInfo->buckets == NULL );
+	REQUIRES( sharedInfo->requestedBuckets > 0 && \
+			  sharedInfo->requestedBuckets <= MAX_SESSIONCACHE_SIZE );
+
+	/* Get the cache file location.  Since this is a systemwide setting we
+	   always query the built-in default user object */
+	setMessageData( &msgData, cacheFilePath, MAX_PATH_LENGTH );
+	status = krnlSendMessage( DEFAULTUSER_OBJECT_HANDLE,
+							  IMESSAGE_GETATTRIBUTE_S, &msgData,
+							  CRYPT_OPTION_SESSION_CACHEFILE );
+	if( cryptStatusError( status ) )
+		return( CRYPT_ERROR_NOTFOUND );
+	cacheFilePath[ msgData.length ] = '\0';
+
+	/* Open the cache file and set it up if necessary */
+	fd = open( cacheFilePath, O_RDWR | O_CREAT | O_NOFOLLOW, 0600 );
+	if( fd < 0 )
+		{
+		DEBUG_DIAG(( "Couldn't open shared scoreboard file '%s'",
+					 cacheFilePath ));
+		return( CRYPT_ERROR_OPEN );
+		}
+	if( flock( fd, LOCK_EX ) < 0 )
+		{
+		close( fd );
+		return( CRYPT_ERROR_OPEN );
+		}
+	status = setupCacheFile( fd, &noBuckets,
+							 sharedInfo->requestedBuckets );
+	( void ) flock( fd, LOCK_UN );
+	if( cryptStatusError( status ) )
+		{
+		close( fd );
+		DEBUG_DIAG(( "Shared scoreboard file '%s' couldn't be set up, "
+					 "status %d", cacheFilePath, status ));
+		return( status );
+		}
+
+	/* Map the cache file.  Once it's mapped we don't need the file
+	   descriptor any more */
+	mapping = mmap( NULL, getSharedSize( noBuckets ),
+					PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+	close( fd );
+	if( mapping == MAP_FAILED )
+		{
+		DEBUG_DIAG(( "Couldn't map shared scoreboard file '%s'",
+					 cacheFilePath ));
+		return( CRYPT_ERROR_OPEN );
+		}
+	sharedInfo->mapping = mapping;
+	sharedInfo->mappingSize = getSharedSize( noBuckets );
+	sharedInfo->noBuckets = noBuckets;
+
+	/* Make the buckets visible to other threads only once everything else
+	   has been set up, since they check for the buckets without holding
+	   the mutex */
+	__sync_synchronize();
+	sharedInfo->buckets = ( SHARED_BUCKET * ) \
+						  ( ( BYTE * ) mapping + sizeof( SHARED_HEADER ) );
+
+	return( CRYPT_OK );
+	}
+
+/* Make sure that the cache file is attached.  Applications usually set
+   configuration options after cryptlib has been initialised, so rather
+   than only looking for the cache file at startup we check for it when
+   the shared scoreboard is used, rechecking every SHARED_RECHECK seconds
+   if it isn't available.  We borrow the scoreboard mutex to ensure that
+   only one thread tries to attach the file at a time */
+
+CHECK_RETVAL_BOOL \
+static BOOLEAN checkCacheFile( const time_t currentTime )
+	{
+	SHARED_SCOREBOARD_INFO *sharedInfo = &sharedScoreboardInfo;
+
+	REQUIRES_B( currentTime > MIN_TIME_VALUE );
+
+	if( sharedInfo->buckets != NULL )
+		return( TRUE );
+	if( sharedInfo->requestedBuckets <= 0 || \
+		currentTime < sharedInfo->checkTime )
+		return( FALSE );
+	if( cryptStatusError( krnlEnterMutex( MUTEX_SCOREBOARD ) ) )
+		return( FALSE );
+	if( sharedInfo->buckets == NULL && \
+		currentTime >= sharedInfo->checkTime )
+		{
+		sharedInfo->checkTime = currentTime + SHARED_RECHECK;
+		( void ) attachCacheFile( sharedInfo );
+		}
+	krnlExitMutex( MUTEX_SCOREBOARD );
+
+	return( ( sharedInfo->buckets != NULL ) ? TRUE : FALSE );
+	}
+
+/****************************************************************************
+*																			*
+*						Shared Scoreboard Access Functions					*
+*																			*
+****************************************************************************/
+
+/* Look up an entry in the shared scoreboard.  The entry is copied out of
+   the cache with the bucket locked and then opened once we've released the
+   lock, so that other processes aren't held up by the crypto */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4, 5 ) ) \
+int lookupSharedScoreboardEntry( IN_BUFFER( HASH_DATA_SIZE ) \
+									const BYTE *keyHash,
+								 OUT_BUFFER( dataMaxLength, \
+											 *dataLength ) void *data,
+								 IN_LENGTH_SHORT const int dataMaxLength,
+								 OUT_LENGTH_BOUNDED_Z( dataMaxLength ) \
+									int *dataLength,
+								 OUT_INT_Z int *metaData )
+	{
+	STREAM stream;
+	SHARED_BUCKET *bucket;
+	BYTE sealedData[ SHARED_SCOREBOARD_SEALED_SIZE + 8 ];
+	BYTE entryData[ SHARED_SCOREBOARD_DATA_SIZE + 8 ];
+	const time_t currentTime = getTime();
+	BOOLEAN entryFound = FALSE;
+	int length, metaDataValue, i, status, LOOP_ITERATOR;
+
+	assert( isReadPtr( keyHash, HASH_DATA_SIZE ) );
+	assert( isWritePtrDynamic( data, dataMaxLength ) );
+	assert( isWritePtr( dataLength, sizeof( int ) ) );
+	assert( isWritePtr( metaData, sizeof( int ) ) );
+
+	REQUIRES( dataMaxLength > 0 && dataMaxLength < MAX_INTLENGTH_SHORT );
+
+	/* Clear return values */
+	memset( data, 0, dataMaxLength );
+	*dataLength = 0;
+	*metaData = 0;
+
+	/* Find the entry and copy out the sealed data */
+	if( currentTime <= MIN_TIME_VALUE || !checkCacheFile( currentTime ) )
+		return( CRYPT_ERROR_NOTFOUND );
+	bucket = getBucket( keyHash );
+	if( bucket == NULL )
+		return( CRYPT_ERROR_NOTFOUND );
+	if( !lockBucket( bucket ) )
+		return( CRYPT_ERROR_NOTFOUND );
+	LOOP_SMALL( i = 0, i < SHARED_BUCKET_ENTRIES, i++ )
+		{
+		SHARED_ENTRY *entry = &bucket->entries[ i ];
+
+		if( isValidEntry( entry, currentTime ) && \
+			!memcmp( entry->keyHash, keyHash, HASH_DATA_SIZE ) )
+			{
+			memcpy( sealedData, entry->sealedData,
+					SHARED_SCOREBOARD_SEALED_SIZE );
+			entry->timeStamp = currentTime;
+			entryFound = TRUE;
+			break;
+			}
+		}
+	unlockBucket( bucket );
+	ENSURES( LOOP_BOUND_OK );
+	if( !entryFound )
+		return( CRYPT_ERROR_NOTFOUND );
+
+	/* Open the entry and decode the data in it */
+	status = openScoreboardEntry( keyHash, sealedData, entryData );
+	if( cryptStatusError( status ) )
+		return( CRYPT_ERROR_NOTFOUND );
+	sMemConnect( &stream, entryData, SHARED_SCOREBOARD_DATA_SIZE );
+	length = sgetc( &stream );
+	status = metaDataValue = readUint32( &stream );
+	if( !cryptStatusError( status ) )
+		{
+		if( length <= 0 || length > dataMaxLength )
+			status = CRYPT_ERROR_BADDATA;
+		else
+			status = sread( &stream, data, length );
+		}
+	sMemDisconnect( &stream );
+	zeroise( entryData, SHARED_SCOREBOARD_DATA_SIZE );
+	if( cryptStatusError( status ) )
+		{
+		zeroise( data, dataMaxLength );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+	*dataLength = length;
+	*metaData = metaDataValue;
+
+	return( CRYPT_OK );
+	}
+
+/* Add an entry to the shared scoreboard.  The entry replaces any existing
+   entry with the same key, or failing that an unused or expired one, or
+   failing that the oldest one in the bucket */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int addSharedScoreboardEntry( IN_BUFFER( HASH_DATA_SIZE ) \
+								const BYTE *keyHash,
+							  const SCOREBOARD_INFO *scoreboardInfo )
+	{
+	STREAM stream;
+	SHARED_BUCKET *bucket;
+	BYTE sealedData[ SHARED_SCOREBOARD_SEALED_SIZE + 8 ];
+	BYTE entryData[ SHARED_SCOREBOARD_DATA_SIZE + 8 ];
+	const time_t currentTime = getTime();
+	int entryNo = -1, freeEntryNo = -1, oldestEntryNo = -1;
+	int i, status, LOOP_ITERATOR;
+
+	assert( isReadPtr( keyHash, HASH_DATA_SIZE ) );
+	assert( isReadPtr( scoreboardInfo, sizeof( SCOREBOARD_INFO ) ) );
+
+	REQUIRES( scoreboardInfo->data != NULL && \
+			  scoreboardInfo->dataSize > 0 && \
+			  scoreboardInfo->dataSize <= \
+					SHARED_SCOREBOARD_DATA_SIZE - ( 1 + UINT32_SIZE ) );
+	REQUIRES( isIntegerRange( scoreboardInfo->metaData ) );
+
+	if( currentTime <= MIN_TIME_VALUE || !checkCacheFile( currentTime ) )
+		return( CRYPT_OK );
+	bucket = getBucket( keyHash );
+	if( bucket == NULL )
+		return( CRYPT_OK );
+
+	/* Encode and seal the entry data.  If there's no shared ticket key
+	   available then we can't protect the entry and don't add it */
+	memset( entryData, 0, SHARED_SCOREBOARD_DATA_SIZE );
+	sMemOpen( &stream, entryData, SHARED_SCOREBOARD_DATA_SIZE );
+	sputc( &stream, scoreboardInfo->dataSize );
+	writeUint32( &stream, scoreboardInfo->metaData );
+	status = swrite( &stream, scoreboardInfo->data,
+					 scoreboardInfo->dataSize );
+	sMemDisconnect( &stream );
+	ENSURES( cryptStatusOK( status ) );
+	status = sealScoreboardEntry( keyHash, entryData, sealedData );
+	zeroise( entryData, SHARED_SCOREBOARD_DATA_SIZE );
+	if( cryptStatusError( status ) )
+		return( ( status == CRYPT_ERROR_NOTFOUND ) ? CRYPT_OK : status );
+
+	/* Find a slot for the entry and store it */
+	if( !lockBucket( bucket ) )
+		return( CRYPT_OK );
+	LOOP_SMALL( i = 0, i < SHARED_BUCKET_ENTRIES, i++ )
+		{
+		const SHARED_ENTRY *entry = &bucket->entries[ i ];
+
+		/* Remember the first free entry in case we need it */
+		if( !isValidEntry( entry, currentTime ) )
+			{
+			if( freeEntryNo < 0 )
+				freeEntryNo = i;
+			continue;
+			}
+
+		/* If there's already an entry for this key, replace it */
+		if( !memcmp( entry->keyHash, keyHash, HASH_DATA_SIZE ) )
+			{
+			entryNo = i;
+			break;
+			}
+
+		/* Remember the oldest entry in case there are no free ones */
+		if( oldestEntryNo < 0 || \
+			entry->timeStamp < bucket->entries[ oldestEntryNo ].timeStamp )
+			oldestEntryNo = i;
+		}
+	if( entryNo < 0 )
+		entryNo = ( freeEntryNo >= 0 ) ? freeEntryNo : oldestEntryNo;
+	if( LOOP_BOUND_OK && entryNo >= 0 && entryNo < SHARED_BUCKET_ENTRIES )
+		{
+		SHARED_ENTRY *entry = &bucket->entries[ entryNo ];
+
+		memcpy( entry->keyHash, keyHash, HASH_DATA_SIZE );
+		memcpy( entry->sealedData, sealedData,
+				SHARED_SCOREBOARD_SEALED_SIZE );
+		entry->timeStamp = currentTime;
+		}
+	unlockBucket( bucket );
+	ENSURES( LOOP_BOUND_OK );
+	ENSURES( entryNo >= 0 && entryNo < SHARED_BUCKET_ENTRIES );
+
+	return( CRYPT_OK );
+	}
+
+/****************************************************************************
+*																			*
+*						Shared Scoreboard Init/Shutdown						*
+*																			*
+****************************************************************************/
+
+/* Initialise and shut down the shared scoreboard.  The cache file itself
+   is attached when the shared scoreboard is first used */
+
+CHECK_RETVAL \
+int initSharedScoreboard( IN_RANGE( MIN_SESSIONCACHE_SIZE, \
+									MAX_SESSIONCACHE_SIZE ) \
+							const int scoreboardEntries )
+	{
+	SHARED_SCOREBOARD_INFO *sharedInfo = &sharedScoreboardInfo;
+
+	REQUIRES( scoreboardEntries >= MIN_SESSIONCACHE_SIZE && \
+			  scoreboardEntries <= MAX_SESSIONCACHE_SIZE );
+
+	memset( sharedInfo, 0, sizeof( SHARED_SCOREBOARD_INFO ) );
+	sharedInfo->requestedBuckets = scoreboardEntries / SHARED_BUCKET_ENTRIES;
+
+	return( CRYPT_OK );
+	}
+
+void endSharedScoreboard( void )
+	{
+	SHARED_SCOREBOARD_INFO *sharedInfo = &sharedScoreboardInfo;
+
+	if( sharedInfo->mapping != NULL )
+		{
+		( void ) munmap( sharedInfo->mapping, sharedInfo->mappingSize );
+		}
+	memset( sharedInfo, 0, sizeof( SHARED_SCOREBOARD_INFO ) );
+	}
+#endif /* USE_SHARED_SCOREBOARD */
@@ -563,6 +563,122 @@ int getSessionAttribute( INOUT SESSION_INFO *sessionInfoPtr,
 						TRUE : FALSE;
 			return( CRYPT_OK );
 
+		case CRYPT_SESSINFO_CORK:
+			*valuePtr = ( sessionInfoPtr->flags & SESSION_CORKED ) ? \
+						TRUE : FALSE;
+			return( CRYPT_OK );
+
+		case CRYPT_SESSINFO_NONBLOCKING:
+			*valuePtr = ( sessionInfoPtr->flags & SESSION_NONBLOCKING ) ? \
+						TRUE : FALSE;
+			return( CRYPT_OK );
+
+		case CRYPT_SESSINFO_NETWORKEVENTS:
+			{
+			int events = CRYPT_NETWORKEVENT_NONE, readAheadLength;
+
+			/* Report what the session needs in order to make progress when 
+			   it's being driven from an external event loop with a zero
+			   read/write timeout.  Data that's already been decoded (or a 
+			   pending error that'll be returned once the data is consumed) 
+			   can be read without any further network I/O, so the caller 
+			   needs to call cryptPopData() without waiting on the socket.
+			   The same applies to data that's been read from the socket 
+			   into the network stream's read-ahead buffer but not yet 
+			   processed, since the socket won't signal readability for it.
+			   Otherwise we need the socket to become readable as long as 
+			   there's room in the receive buffer for more data (see the 
+			   corresponding check in tryRead()) and writeable if there's 
+			   data left over from a partial write that still needs to be 
+			   flushed.  If the handshake is still in progress then we 
+			   report what it's waiting for before it can continue */
+#ifdef USE_EVENTLOOP
+			if( isHandshakeSuspended( sessionInfoPtr ) )
+				{
+				*valuePtr = getTaskWaitEvents( sessionInfoPtr->eventTask );
+				return( CRYPT_OK );
+				}
+#endif /* USE_EVENTLOOP */
+			if( !( sessionInfoPtr->flags & SESSION_ISOPEN ) )
+				{
+				return( exitErrorNotInited( sessionInfoPtr, 
+											CRYPT_SESSINFO_ACTIVE ) );
+				}
+			if( sessionInfoPtr->receiveBufPos > 0 || \
+				cryptStatusError( sessionInfoPtr->pendingReadErrorState ) )
+				events |= CRYPT_NETWORKEVENT_DATA;
+			if( cryptStatusOK( sessionInfoPtr->readErrorState ) && \
+				cryptStatusOK( sioctlGet( &sessionInfoPtr->stream, 
+										  STREAM_IOCTL_READAHEAD, 
+										  &readAheadLength, 
+										  sizeof( int ) ) ) && \
+				readAheadLength > 0 )
+				events |= CRYPT_NETWORKEVENT_DATA;
+			if( cryptStatusOK( sessionInfoPtr->readErrorState ) && \
+				sessionInfoPtr->receiveBufSize - \
+					sessionInfoPtr->receiveBufEnd >= 1024 )
+				events |= CRYPT_NETWORKEVENT_READ;
+			if( sessionInfoPtr->partialWrite && \
+				cryptStatusOK( sessionInfoPtr->writeErrorState ) )
+				events |= CRYPT_NETWORKEVENT_WRITE;
+			*valuePtr = events;
+
+			return( CRYPT_OK );
+			}
+
+		case CRYPT_SESSINFO_NETWORKSOCKET:
+			{
+			int networkSocket, status;
+
+			/* If the session is active, or its handshake is suspended 
+			   waiting for network I/O, then we can report the socket that 
+			   it's using even if it was created internally by cryptlib, 
+			   which allows the caller to add it to their own poll set */
+			if( !( sessionInfoPtr->flags & SESSION_ISOPEN ) && \
+				!isHandshakeSuspended( sessionInfoPtr ) )
+				{
+				return( exitErrorNotFound( sessionInfoPtr, 
+										   CRYPT_SESSINFO_NETWORKSOCKET ) );
+				}
+			status = sioctlGet( &sessionInfoPtr->stream, 
+								STREAM_IOCTL_GETSOCKET, &networkSocket, 
+								sizeof( int ) );
+			if( cryptStatusError( status ) )
+				{
+				return( exitErrorNotFound( sessionInfoPtr, 
+										   CRYPT_SESSINFO_NETWORKSOCKET ) );
+				}
+			*valuePtr = networkSocket;
+
+			return( CRYPT_OK );
+			}
+
+		case CRYPT_SESSINFO_TIMING_CONNECT:
+		case CRYPT_SESSINFO_TIMING_HELLOSENT:
+		case CRYPT_SESSINFO_TIMING_HELLORECEIVED:
+		case CRYPT_SESSINFO_TIMING_KEYEXCHANGE:
+		case CRYPT_SESSINFO_TIMING_CERTVERIFIED:
+		case CRYPT_SESSINFO_TIMING_FINISHED:
+			{
+			const int timingIndex = SESSION_TIMING_CONNECT + \
+						( attribute - CRYPT_SESSINFO_TIMING_CONNECT );
+
+			REQUIRES( timingIndex > SESSION_TIMING_NONE && \
+					  timingIndex < SESSION_TIMING_LAST );
+
+			/* The handshake phase times remain available after a failed 
+			   activation so that the caller can see how far the handshake 
+			   got before it failed.  Phases that weren't reached, or that 
+			   don't occur in this type of handshake such as the certificate 
+			   check for a session resumed from cached information, are 
+			   reported as not found */
+			if( sessionInfoPtr->handshakeTime[ timingIndex ] < 0 )
+				return( exitErrorNotFound( sessionInfoPtr, attribute ) );
+			*valuePtr = sessionInfoPtr->handshakeTime[ timingIndex ];
+
+			return( CRYPT_OK );
+			}
+
 		case CRYPT_SESSINFO_SERVER_PORT:
 		case CRYPT_SESSINFO_CLIENT_PORT:
 			{
@@ -793,6 +909,52 @@ int setSessionAttribute( INOUT SESSION_INFO *sessionInfoPtr,
 			return( status );
 			}
 
+		case CRYPT_SESSINFO_CORK:
+			{
+			int dummy;
+
+			if( value )
+				{
+				sessionInfoPtr->flags |= SESSION_CORKED;
+				return( CRYPT_OK );
+				}
+			sessionInfoPtr->flags &= ~SESSION_CORKED;
+
+			/* Uncorking the session sends through any data whose flush was
+			   held back while it was corked.  If there's nothing pending or
+			   the session isn't active yet then there's nothing further to
+			   do */
+			if( !( sessionInfoPtr->flags & SESSION_ISOPEN ) || \
+				( !sessionInfoPtr->partialWrite && \
+				  sessionInfoPtr->sendBufPos <= \
+						sessionInfoPtr->sendBufStartOfs ) )
+				return( CRYPT_OK );
+			if( sessionInfoPtr->flags & SESSION_SENDCLOSED )
+				return( CRYPT_ERROR_COMPLETE );
+			if( cryptStatusError( sessionInfoPtr->writeErrorState ) )
+				return( sessionInfoPtr->writeErrorState );
+			clearErrorInfo( sessionInfoPtr );
+			return( putSessionData( sessionInfoPtr, NULL, 0, &dummy ) );
+			}
+
+		case CRYPT_SESSINFO_NONBLOCKING:
+#ifdef USE_EVENTLOOP
+			/* We can't switch modes while the handshake is suspended since 
+			   it's waiting to be resumed from the event loop */
+			if( isHandshakeSuspended( sessionInfoPtr ) )
+				{
+				return( exitErrorInited( sessionInfoPtr,
+										 CRYPT_SESSINFO_NONBLOCKING ) );
+				}
+			if( value )
+				sessionInfoPtr->flags |= SESSION_NONBLOCKING;
+			else
+				sessionInfoPtr->flags &= ~SESSION_NONBLOCKING;
+			return( CRYPT_OK );
+#else
+			return( CRYPT_ERROR_NOTAVAIL );
+#endif /* USE_EVENTLOOP */
+
 		case CRYPT_SESSINFO_SERVER_PORT:
 			/* If there's already a transport session or network socket 
 			   specified then we can't set a port as well */
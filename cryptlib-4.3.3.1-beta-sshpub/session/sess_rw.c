@@ -380,9 +380,14 @@ static int tryRead( INOUT SESSION_INFO *sessionInfoPtr,
 
 	/* Figure out how much we can read.  If there's not enough room in the 
 	   receive buffer to read at least 1K of packet data, don't try anything 
-	   until the user has emptied more data from the buffer */
+	   until the user has emptied more data from the buffer.  The exception 
+	   to this is when there's room for the rest of the packet, which can 
+	   happen if an earlier read returned only part of the packet, since 
+	   otherwise we'd never complete the packet and the buffer would never 
+	   be emptied */
 	bytesLeft = sessionInfoPtr->receiveBufSize - sessionInfoPtr->receiveBufEnd;
-	if( bytesLeft < 1024 )
+	if( bytesLeft < 1024 && \
+		bytesLeft < sessionInfoPtr->pendingPacketRemaining )
 		{
 		ENSURES( sanityCheckSessionRead( sessionInfoPtr ) );
 
@@ -566,12 +571,22 @@ static int getData( INOUT SESSION_INFO *sessionInfoPtr,
 		1. Blocking read, in which case we waited for the full timeout 
 		   period anyway and a small additional timeout won't be noticed.
 		2. Nonblocking read, in which case waiting for a nonzero time could 
-		   potentially have retrieved more data */
+		   potentially have retrieved more data.
+
+	   The exception to this is when the session is being driven from an 
+	   event loop and the caller has explicitly asked for nonblocking reads 
+	   by setting a zero read timeout, since the event loop is only going 
+	   to call us when the socket is readable.  In this case stalling for a 
+	   second would block every other session serviced by the loop, so we
+	   leave it to the caller to call back when the rest of the packet has 
+	   arrived */
 	if( status == OK_SPECIAL )
 		{
 		REQUIRES( readInfo == READINFO_PARTIAL || \
 				  readInfo == READINFO_NOOP );
 		if( readInfo == READINFO_PARTIAL && \
+			!( ( sessionInfoPtr->flags & SESSION_NONBLOCKING ) && \
+			   sessionInfoPtr->readTimeout <= 0 ) && \
 			sessionInfoPtr->pendingPacketRemaining <= \
 				sessionInfoPtr->receiveBufSize - sessionInfoPtr->receiveBufEnd )
 			{
@@ -1069,6 +1084,18 @@ int putSessionData( INOUT SESSION_INFO *sessionInfoPtr,
 		const int oldBufPos = sessionInfoPtr->sendBufPartialBufPos;
 		int bytesWritten;
 
+		/* If the session is corked, hold back the flush until the send
+		   buffer fills up or the session is uncorked.  This allows
+		   applications that write a message in many small pieces,
+		   flushing each one, to have them wrapped up into a single packet
+		   and sent in a single write rather than incurring the packet
+		   overhead and a system call for each piece.  Data left over from
+		   a partial write is still flushed since it's already been
+		   wrapped */
+		if( ( sessionInfoPtr->flags & SESSION_CORKED ) && \
+			!sessionInfoPtr->partialWrite )
+			return( CRYPT_OK );
+
 		status = flushData( sessionInfoPtr );
 		if( status != OK_SPECIAL )
 			return( status );
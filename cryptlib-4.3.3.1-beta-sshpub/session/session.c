@@ -74,6 +74,10 @@ int initSessionNetConnectInfo( const SESSION_INFO *sessionInfoPtr,
 					NET_OPTION_TRANSPORTSESSION : \
 				( sessionInfoPtr->networkSocket != CRYPT_ERROR ) ? \
 					NET_OPTION_NETWORKSOCKET : NET_OPTION_HOSTNAME );
+#ifdef USE_EVENTLOOP
+	if( sessionInfoPtr->flags & SESSION_NONBLOCKING )
+		connectInfo->eventTask = sessionInfoPtr->eventTask;
+#endif /* USE_EVENTLOOP */
 
 	/* If the user has supplied the network transport information, there's
 	   nothing further to do */
@@ -364,6 +368,38 @@ int getPaddedSize( IN_DATALENGTH_Z const int length )
 	return( roundUp( length, 128 ) );
 	}
 
+/* Start timing a session handshake and record the completion time for a 
+   handshake phase, reported via the CRYPT_SESSINFO_TIMING_xxx attributes.  
+   This allows the caller to tell whether a slow handshake was due to 
+   network latency, slow key exchange, or slow certificate processing */
+
+STDC_NONNULL_ARG( ( 1 ) ) \
+void initHandshakeTiming( INOUT SESSION_INFO *sessionInfoPtr )
+	{
+	int i, LOOP_ITERATOR;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+
+	getHiresTimestamp( &sessionInfoPtr->handshakeStartTime );
+	LOOP_SMALL( i = 0, i < SESSION_TIMING_LAST, i++ )
+		sessionInfoPtr->handshakeTime[ i ] = CRYPT_ERROR;
+	ENSURES_V( LOOP_BOUND_OK );
+	}
+
+STDC_NONNULL_ARG( ( 1 ) ) \
+void recordHandshakeTime( INOUT SESSION_INFO *sessionInfoPtr,
+						  IN_ENUM( SESSION_TIMING ) \
+							const SESSION_TIMING_TYPE timingType )
+	{
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+
+	REQUIRES_V( timingType > SESSION_TIMING_NONE && \
+				timingType < SESSION_TIMING_LAST );
+
+	sessionInfoPtr->handshakeTime[ timingType ] = \
+		getHiresTimeElapsed( &sessionInfoPtr->handshakeStartTime );
+	}
+
 /****************************************************************************
 *																			*
 *							Session Activation Functions					*
@@ -442,6 +478,152 @@ static CRYPT_ATTRIBUTE_TYPE checkServerParameters( const SESSION_INFO *sessionIn
 	return( CRYPT_ATTRIBUTE_NONE );
 	}
 
+/* Connect to the peer and perform the session handshake */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int performHandshake( INOUT SESSION_INFO *sessionInfoPtr )
+	{
+	int status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+
+	/* If this is the first time that we've got here, activate the session */
+	if( !( sessionInfoPtr->flags & SESSION_PARTIALOPEN ) )
+		{
+		const SES_CONNECT_FUNCTION connectFunction = \
+					FNPTR_GET( sessionInfoPtr->connectFunction );
+
+		REQUIRES( !( sessionInfoPtr->flags & SESSION_ISOPEN ) )
+		REQUIRES( connectFunction != NULL );
+
+		/* Start timing the handshake.  For a client this includes the time 
+		   taken to connect to the server, for a server it starts once the 
+		   client's connection has been accepted since before that the
+		   server is just waiting for a client to appear */
+		if( !isServer( sessionInfoPtr ) )
+			initHandshakeTiming( sessionInfoPtr );
+		status = connectFunction( sessionInfoPtr );
+		if( cryptStatusError( status ) )
+			return( status );
+		if( isServer( sessionInfoPtr ) )
+			initHandshakeTiming( sessionInfoPtr );
+		recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_CONNECT );
+		}
+
+	/* If it's a secure data transport session, complete the session state
+	   setup.  Note that some sessions dynamically change the protocol 
+	   information during the handshake to accommodate parameters negotiated 
+	   during the handshake so we can only access the protocol information 
+	   after the handshake has completed */
+	if( !sessionInfoPtr->protocolInfo->isReqResp )
+		{
+		const SES_TRANSACT_FUNCTION transactFunction = \
+					FNPTR_GET( sessionInfoPtr->transactFunction );
+
+		REQUIRES( transactFunction != NULL );
+
+		/* Complete the session handshake to set up the secure state */
+		status = transactFunction( sessionInfoPtr );
+		if( cryptStatusError( status ) )
+			{
+			/* If we need feedback from the user before we can complete the 
+			   handshake (for example checking a user name and password or 
+			   certificate supplied by the other side) we remain in the 
+			   handshake state so that the user can re-activate the session 
+			   after confirming (or denying) the check */
+			if( status == CRYPT_ENVELOPE_RESOURCE )
+				sessionInfoPtr->flags |= SESSION_PARTIALOPEN;
+
+			return( status );
+			}
+
+		/* Notify the kernel that the session key context is attached to the
+		   session object.  Note that we increment its reference count even
+		   though it's an internal object used only by the session because
+		   otherwise it'll be automatically destroyed by the kernel as a
+		   zero-reference dependent object when the session object is
+		   destroyed (but before the session object itself since the context 
+		   is just a dependent object).  This automatic cleanup could cause 
+		   problems for lower-level session management code that tries to 
+		   work with the (apparently still-valid) handle, for example 
+		   protocols that need to encrypt a close-channel message on session 
+		   shutdown */
+		krnlSendMessage( sessionInfoPtr->objectHandle, IMESSAGE_SETDEPENDENT,
+						 &sessionInfoPtr->iCryptInContext,
+						 SETDEP_OPTION_INCREF );
+
+		/* Set up the buffer management variables */
+		sessionInfoPtr->receiveBufPos = sessionInfoPtr->receiveBufEnd = 0;
+		sessionInfoPtr->sendBufPos = sessionInfoPtr->sendBufStartOfs;
+
+		/* For data transport sessions, partial reads and writes (that is,
+		   sending and receiving partial packets in the presence of 
+		   timeouts) are permitted */
+		sioctlSet( &sessionInfoPtr->stream, STREAM_IOCTL_PARTIALREAD, TRUE );
+		sioctlSet( &sessionInfoPtr->stream, STREAM_IOCTL_PARTIALWRITE, TRUE );
+		}
+
+	/* The handshake has been completed, switch from the handshake timeout
+	   to the data transfer timeout and remember that the session has been
+	   successfully established */
+	recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_FINISHED );
+	sioctlSet( &sessionInfoPtr->stream, STREAM_IOCTL_HANDSHAKECOMPLETE, TRUE );
+	sessionInfoPtr->flags &= ~SESSION_PARTIALOPEN;
+	sessionInfoPtr->flags |= SESSION_ISOPEN;
+
+	return( CRYPT_OK );
+	}
+
+#ifdef USE_EVENTLOOP
+
+/* Run the session handshake as a task for sessions that are driven from an
+   external event loop.  If the handshake would block on network I/O then 
+   the task is suspended and we return a timeout error, with 
+   CRYPT_SESSINFO_NETWORKEVENTS indicating what the handshake is waiting 
+   for.  Once the event loop reports that the I/O can proceed the caller 
+   activates the session again, which resumes the handshake from where it 
+   left off */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int handshakeTask( INOUT void *taskParam )
+	{
+	return( performHandshake( taskParam ) );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int runHandshakeTask( INOUT SESSION_INFO *sessionInfoPtr )
+	{
+	int status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+
+	/* Create the handshake task if necessary.  This has to be done before 
+	   the network connection is opened since the network stream records 
+	   the task that it needs to suspend */
+	if( sessionInfoPtr->eventTask == NULL )
+		{
+		status = createTask( &sessionInfoPtr->eventTask );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+
+	/* Start or resume the handshake */
+	status = runTask( sessionInfoPtr->eventTask, handshakeTask, 
+					  sessionInfoPtr );
+	if( status == OK_SPECIAL )
+		{
+		retExt( CRYPT_ERROR_TIMEOUT,
+				( CRYPT_ERROR_TIMEOUT, SESSION_ERRINFO, 
+				  "Handshake is waiting for network I/O" ) );
+		}
+	return( status );
+	}
+#endif /* USE_EVENTLOOP */
+
 /* Activate the network connection for a session */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
@@ -572,81 +754,14 @@ static int activateConnection( INOUT SESSION_INFO *sessionInfoPtr )
 		return( CRYPT_ERROR_PERMISSION );
 		}
 
-	/* If this is the first time that we've got here, activate the session */
-	if( !( sessionInfoPtr->flags & SESSION_PARTIALOPEN ) )
-		{
-		const SES_CONNECT_FUNCTION connectFunction = \
-					FNPTR_GET( sessionInfoPtr->connectFunction );
-
-		REQUIRES( !( sessionInfoPtr->flags & SESSION_ISOPEN ) )
-		REQUIRES( connectFunction != NULL );
-
-		status = connectFunction( sessionInfoPtr );
-		if( cryptStatusError( status ) )
-			return( status );
-		}
-
-	/* If it's a secure data transport session, complete the session state
-	   setup.  Note that some sessions dynamically change the protocol 
-	   information during the handshake to accommodate parameters negotiated 
-	   during the handshake so we can only access the protocol information 
-	   after the handshake has completed */
-	if( !sessionInfoPtr->protocolInfo->isReqResp )
-		{
-		const SES_TRANSACT_FUNCTION transactFunction = \
-					FNPTR_GET( sessionInfoPtr->transactFunction );
-
-		REQUIRES( transactFunction != NULL );
-
-		/* Complete the session handshake to set up the secure state */
-		status = transactFunction( sessionInfoPtr );
-		if( cryptStatusError( status ) )
-			{
-			/* If we need feedback from the user before we can complete the 
-			   handshake (for example checking a user name and password or 
-			   certificate supplied by the other side) we remain in the 
-			   handshake state so that the user can re-activate the session 
-			   after confirming (or denying) the check */
-			if( status == CRYPT_ENVELOPE_RESOURCE )
-				sessionInfoPtr->flags |= SESSION_PARTIALOPEN;
-
-			return( status );
-			}
-
-		/* Notify the kernel that the session key context is attached to the
-		   session object.  Note that we increment its reference count even
-		   though it's an internal object used only by the session because
-		   otherwise it'll be automatically destroyed by the kernel as a
-		   zero-reference dependent object when the session object is
-		   destroyed (but before the session object itself since the context 
-		   is just a dependent object).  This automatic cleanup could cause 
-		   problems for lower-level session management code that tries to 
-		   work with the (apparently still-valid) handle, for example 
-		   protocols that need to encrypt a close-channel message on session 
-		   shutdown */
-		krnlSendMessage( sessionInfoPtr->objectHandle, IMESSAGE_SETDEPENDENT,
-						 &sessionInfoPtr->iCryptInContext,
-						 SETDEP_OPTION_INCREF );
-
-		/* Set up the buffer management variables */
-		sessionInfoPtr->receiveBufPos = sessionInfoPtr->receiveBufEnd = 0;
-		sessionInfoPtr->sendBufPos = sessionInfoPtr->sendBufStartOfs;
-
-		/* For data transport sessions, partial reads and writes (that is,
-		   sending and receiving partial packets in the presence of 
-		   timeouts) are permitted */
-		sioctlSet( &sessionInfoPtr->stream, STREAM_IOCTL_PARTIALREAD, TRUE );
-		sioctlSet( &sessionInfoPtr->stream, STREAM_IOCTL_PARTIALWRITE, TRUE );
-		}
-
-	/* The handshake has been completed, switch from the handshake timeout
-	   to the data transfer timeout and remember that the session has been
-	   successfully established */
-	sioctlSet( &sessionInfoPtr->stream, STREAM_IOCTL_HANDSHAKECOMPLETE, TRUE );
-	sessionInfoPtr->flags &= ~SESSION_PARTIALOPEN;
-	sessionInfoPtr->flags |= SESSION_ISOPEN;
+#ifdef USE_EVENTLOOP
+	/* If the session is being driven from an external event loop, run the 
+	   handshake as a task that's suspended whenever it would block */
+	if( sessionInfoPtr->flags & SESSION_NONBLOCKING )
+		return( runHandshakeTask( sessionInfoPtr ) );
+#endif /* USE_EVENTLOOP */
 
-	return( CRYPT_OK );
+	return( performHandshake( sessionInfoPtr ) );
 	}
 
 /* Activate a session */
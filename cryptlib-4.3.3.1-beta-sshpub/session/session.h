@@ -44,6 +44,11 @@
 			however mean that no more data can be received on our receive 
 			channel.
 
+	SESSION_CORKED: The caller has corked the session, explicit flushes 
+			of data written to the session are held back until the send 
+			buffer fills up or the session is uncorked so that a sequence of 
+			small writes is sent as a single packet.
+
 	SESSION_ISCLOSINGDOWN: The session is in the shutdown stage, if further
 			requests from the remote system arrive they should be NACK'd or
 			ignored.
@@ -62,6 +67,12 @@
 			words the session has passed the initial handshake stage and all 
 			data is now being encrypted/MACd/whatever.
 
+	SESSION_NONBLOCKING: The session is being driven from an external event
+			loop.  The handshake is run as a task that's suspended whenever 
+			it would block on network I/O, with session activation 
+			returning a would-block indication that's cleared by activating
+			the session again once the I/O can proceed.
+
 	SESSION_NOREPORTERROR: Don't update the extended error information if
 			an error occurs, since this has already been set.  This is
 			typically used when performing shutdown actions in response to
@@ -81,7 +92,9 @@
 #define SESSION_ISCRYPTLIB			0x0100	/* Peer is running cryptlib */
 #define SESSION_ISHTTPTRANSPORT		0x0200	/* Session using HTTP transport */
 #define SESSION_CACHEDINFO			0x0400	/* Session established from cached info */
-#define SESSION_MAX					0x07FF	/* Maximum possible flag value */
+#define SESSION_CORKED				0x0800	/* Hold back flushes of written data */
+#define SESSION_NONBLOCKING			0x1000	/* Session driven from ext.event loop */
+#define SESSION_MAX					0x1FFF	/* Maximum possible flag value */
 
 /* Needed-information flags used by protocol-specific handlers to indicate
    that the caller must set the given attributes in the session information
@@ -155,6 +168,23 @@ typedef enum {
 	AUTHRESPONSE_LAST					/* Last possible authorisation response */
 	} AUTHRESPONSE_TYPE;
 
+/* The handshake phases whose completion times are recorded for the 
+   CRYPT_SESSINFO_TIMING_xxx attributes.  The key exchange phase is the 
+   point at which the shared secret has been computed and the certificate-
+   verified phase is the point at which the peer's certificate or key has 
+   been checked, or for SSH the server's signature on the exchange hash */
+
+typedef enum {
+	SESSION_TIMING_NONE,				/* No handshake phase */
+	SESSION_TIMING_CONNECT,				/* Network connection established */
+	SESSION_TIMING_HELLOSENT,			/* Hello sent */
+	SESSION_TIMING_HELLORECEIVED,		/* Hello received */
+	SESSION_TIMING_KEYEXCHANGE,			/* Key exchange computed */
+	SESSION_TIMING_CERTVERIFIED,		/* Peer cert/key verified */
+	SESSION_TIMING_FINISHED,			/* Handshake completed */
+	SESSION_TIMING_LAST					/* Last possible handshake phase */
+	} SESSION_TIMING_TYPE;
+
 /****************************************************************************
 *																			*
 *								Session Structures							*
@@ -278,6 +308,16 @@ typedef struct {
 	int dataLen;
 	} SSH_RESPONSE_INFO;
 
+/* TLS 1.3 requires an AEAD cipher, which means either GCM or 
+   ChaCha20-Poly1305, and at least one of the mandatory key-agreement 
+   groups, for which we use X25519 since it avoids all of the problems 
+   associated with the P-xxx curves */
+
+#if defined( USE_SSL ) && ( defined( USE_GCM ) || defined( USE_CHACHA20 ) ) && \
+	defined( USE_25519 )
+  #define USE_TLS13
+#endif /* USE_SSL && ( USE_GCM || USE_CHACHA20 ) && USE_25519 */
+
 /* The internal fields in a session that hold data for the various session
    types */
 
@@ -328,6 +368,21 @@ typedef struct {
 	/* A buffer for the SSL packet header, which is read out-of-band */
 	BUFFER_FIXED( 8 + CRYPT_MAX_IVSIZE ) \
 	BYTE headerBuffer[ 8 + CRYPT_MAX_IVSIZE + 8 ];
+
+	/* TLS 1.3 derives the session keys from per-direction traffic secrets 
+	   that can be updated during the session via a KeyUpdate message, and 
+	   issues session tickets after the handshake has completed, so we need 
+	   to keep the traffic secrets and the resumption master secret around 
+	   for the lifetime of the session */
+#ifdef USE_TLS13
+	BUFFER_FIXED( CRYPT_MAX_HASHSIZE ) \
+	BYTE tls13ReadSecret[ CRYPT_MAX_HASHSIZE + 8 ];
+	BUFFER_FIXED( CRYPT_MAX_HASHSIZE ) \
+	BYTE tls13WriteSecret[ CRYPT_MAX_HASHSIZE + 8 ];
+	BUFFER_FIXED( CRYPT_MAX_HASHSIZE ) \
+	BYTE tls13ResumptionSecret[ CRYPT_MAX_HASHSIZE + 8 ];
+	int tls13SecretSize;
+#endif /* USE_TLS13 */
 	} SSL_INFO;
 
 typedef struct {
@@ -339,6 +394,10 @@ typedef struct {
 	   insertion/deletion attacks */
 	long readSeqNo, writeSeqNo;
 
+	/* The negotiated encryption mode, since SSH can use the same cipher in
+	   CBC or CTR mode */
+	int cryptMode;
+
 	/* Per-channel state information */
 	int currReadChannel, currWriteChannel; /* Current active R/W channels */
 	int nextChannelNo;					/* Next SSH channel no.to use */
@@ -567,6 +626,22 @@ typedef struct SI {
 										/* Connect and data xfer.timeouts */
 	STREAM stream;						/* Network I/O stream */
 
+	/* If the session is being driven from an external event loop, the task 
+	   that the handshake runs in */
+#ifdef USE_EVENTLOOP
+	TASK_INFO *eventTask;				/* Handshake task */
+#endif /* USE_EVENTLOOP */
+
+	/* Handshake timing information.  The start time is taken when a client 
+	   starts connecting to the server or when a server accepts the client's 
+	   connection, and each phase time is the time in microseconds from 
+	   then until the phase was completed, or CRYPT_ERROR if it hasn't been 
+	   reached.  If a phase occurs more than once, for example the hellos 
+	   when the server asks the client to retry with different parameters, 
+	   we record the last occurrence */
+	HIRES_TIMESTAMP handshakeStartTime;	/* Handshake start time */
+	int handshakeTime[ SESSION_TIMING_LAST ];	/* Handshake phase times */
+
 	/* Low-level error information */
 	ERROR_INFO errorInfo;
 
@@ -617,6 +692,17 @@ typedef struct SI {
 #define isServer( sessionInfoPtr ) \
 		( sessionInfoPtr->flags & SESSION_ISSERVER )
 
+/* Check whether a handshake being driven from an external event loop is 
+   currently suspended waiting for network I/O */
+
+#ifdef USE_EVENTLOOP
+  #define isHandshakeSuspended( sessionInfoPtr ) \
+		( sessionInfoPtr->eventTask != NULL && \
+		  isTaskSuspended( sessionInfoPtr->eventTask ) )
+#else
+  #define isHandshakeSuspended( sessionInfoPtr )	FALSE
+#endif /* USE_EVENTLOOP */
+
 /* Session attribute handling functions */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
@@ -758,6 +844,12 @@ int sendCloseNotification( INOUT SESSION_INFO *sessionInfoPtr,
 						   IN_LENGTH_SHORT_Z const int length );
 CHECK_RETVAL_LENGTH \
 int getPaddedSize( IN_DATALENGTH_Z const int length );
+STDC_NONNULL_ARG( ( 1 ) ) \
+void initHandshakeTiming( INOUT SESSION_INFO *sessionInfoPtr );
+STDC_NONNULL_ARG( ( 1 ) ) \
+void recordHandshakeTime( INOUT SESSION_INFO *sessionInfoPtr,
+						  IN_ENUM( SESSION_TIMING ) \
+							const SESSION_TIMING_TYPE timingType );
 
 /* Prototypes for misc. management functions */
 
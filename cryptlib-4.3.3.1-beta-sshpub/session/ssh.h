@@ -231,6 +231,21 @@ typedef enum {
 		( ( algorithm ) >= CRYPT_PSEUDOALGO_PASSWORD && \
 		  ( algorithm ) <= CRYPT_PSEUDOALGO_PAM )
 
+/* Check whether the session is using chacha20-poly1305@openssh.com, which 
+   replaces the negotiated MAC with Poly1305 and encrypts the packet length 
+   with a separate header context.  The details are given in ssh2_cry.c */
+
+#define isChaChaPolySSH( sessionInfoPtr ) \
+		( ( sessionInfoPtr )->cryptAlgo == CRYPT_ALGO_CHACHA20 )
+
+/* The chacha20-poly1305@openssh.com (single) key size, tag size, and the 
+   padding block size, which is applied to the packet excluding the length 
+   field */
+
+#define SSH2_CHACHAPOLY_KEY_SIZE	32
+#define SSH2_CHACHAPOLY_TAG_SIZE	16
+#define SSH2_CHACHAPOLY_BLOCK_SIZE	8
+
 /* SSH algorithms are grouped into classes such as keyex algorithms or MAC
    algorithms, the following type identifies the different algorithm 
    classes */
@@ -289,6 +304,12 @@ typedef enum {
 #define extractECDHsize( value, extraLength ) \
 		( ( value - ( extraLength + 1 ) ) / 2 )
 
+/* X25519 values are fixed-length strings rather than MPIs or points so the
+   check for these is a simple exact-length match */
+
+#define isValid25519size( value, extraLength ) \
+		( ( value ) == X25519_KEYSIZE + ( extraLength ) )
+
 /* The following macro can be used to enable dumping of PDUs to disk.  As a
    safeguard, this only works in the Win32 debug version to prevent it from
    being accidentally enabled in any release version */
@@ -387,7 +408,8 @@ typedef struct SH {
 	   information iKeyexCryptContext for the client and privateKey for the 
 	   server.   Since ECDH doesn't just entail a new algorithm but an 
 	   entire cipher suite, we provide a flag to make checking for this 
-	   easier */
+	   easier.  The flag is also set for X25519, which uses the ECDH 
+	   message formats */
 	CRYPT_ALGO_TYPE keyexAlgo;				/* Keyex algo */
 	CRYPT_CONTEXT iServerCryptContext;
 	int serverKeySize, requestedServerKeySize;
@@ -474,6 +496,10 @@ int writeAlgoStringEx( INOUT STREAM *stream,
 					   IN_ALGO const CRYPT_ALGO_TYPE algo,
 					   IN_ALGO_OPT const CRYPT_ALGO_TYPE subAlgo,
 					   const BOOLEAN useSecondAlgoGroup );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int writeCipherAlgoString( INOUT STREAM *stream, 
+						   IN_ALGO const CRYPT_ALGO_TYPE algo,
+						   IN_MODE const CRYPT_MODE_TYPE mode );
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
 int writeAlgoList( INOUT STREAM *stream, 
 				   IN_ARRAY( noAlgoStringInfoEntries ) \
@@ -628,16 +654,33 @@ int initDHcontextSSH( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 					  IN_BUFFER_OPT( keyDataLength ) const void *keyData, 
 					  IN_LENGTH_SHORT_Z const int keyDataLength,
 					  IN_LENGTH_SHORT_OPT const int requestedKeySize );
-#ifdef USE_ECDH
+#if defined( USE_ECDH ) || defined( USE_25519 )
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
 int initECDHcontextSSH( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext, 
 						OUT_LENGTH_SHORT_Z int *keySize,
 						IN_ALGO const CRYPT_ALGO_TYPE cryptAlgo );
-#endif /* USE_ECDH */
+#endif /* USE_ECDH || USE_25519 */
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
 int completeKeyex( INOUT SESSION_INFO *sessionInfoPtr,
 				   INOUT SSH_HANDSHAKE_INFO *handshakeInfo,
 				   const BOOLEAN isServer );
+#ifdef USE_ED25519
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 5 ) ) \
+int createAuthSigEd25519( INOUT STREAM *stream,
+						  IN_HANDLE const CRYPT_CONTEXT iSignContext,
+						  IN_BUFFER( sessionIDlength ) const BYTE *sessionID,
+						  IN_LENGTH_HASH const int sessionIDlength,
+						  IN_BUFFER( packetDataLength ) const void *packetData,
+						  IN_LENGTH_SHORT const int packetDataLength );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2, 4, 6 ) ) \
+int checkAuthSigEd25519( IN_HANDLE const CRYPT_CONTEXT iSigCheckContext,
+						 IN_BUFFER( sessionIDlength ) const BYTE *sessionID,
+						 IN_LENGTH_HASH const int sessionIDlength,
+						 IN_BUFFER( packetDataLength ) const void *packetData,
+						 IN_LENGTH_SHORT const int packetDataLength,
+						 IN_BUFFER( sigDataLength ) const void *sigData,
+						 IN_LENGTH_SHORT const int sigDataLength );
+#endif /* USE_ED25519 */
 CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
 int hashAsString( IN_HANDLE const CRYPT_CONTEXT iHashContext,
 				  IN_BUFFER( dataLength ) const BYTE *data, 
@@ -668,6 +711,23 @@ int createMacSSH( IN_HANDLE const CRYPT_CONTEXT iMacContext,
 				  IN_BUFFER( dataMaxLength ) BYTE *data, 
 				  IN_DATALENGTH const int dataMaxLength, 
 				  IN_DATALENGTH const int dataLength );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3 ) ) \
+int decryptPacketHeaderChaChaSSH( INOUT SESSION_INFO *sessionInfoPtr,
+								  IN_INT const long seqNo,
+								  INOUT_BUFFER_FIXED( headerLength ) \
+									BYTE *header,
+								  IN_LENGTH_SHORT const int headerLength );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3 ) ) \
+int encryptPacketChaChaSSH( INOUT SESSION_INFO *sessionInfoPtr,
+							IN_INT const long seqNo,
+							INOUT_BUFFER( dataMaxLength, dataLength ) \
+								BYTE *data, 
+							IN_DATALENGTH const int dataMaxLength, 
+							IN_DATALENGTH const int dataLength );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+int checkPacketTagChaChaSSH( IN_HANDLE const CRYPT_CONTEXT iCryptContext,
+							 IN_BUFFER( tagLength ) const BYTE *tag,
+							 IN_LENGTH_SHORT const int tagLength );
 
 /* Prototypes for functions in ssh2_rd.c */
 
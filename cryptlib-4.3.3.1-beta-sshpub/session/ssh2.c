@@ -59,9 +59,19 @@
    "diffie-hellman-group14-sha1".  In order to distinguish between DH + SHA1 
    and DH + SHA1, we specify the hash algorithm for the latter as 
    CRYPT_ALGO_RESERVED1 in order to know that we have to send the peer the
-   group14 form of the suite name and not the group-exchange form */
+   group14 form of the suite name and not the group-exchange form.
+
+   Curve25519 also has two names, the standardised "curve25519-sha256" and
+   the original "curve25519-sha256@libssh.org", which is still the only
+   form that many older implementations recognise.  Unlike NIST-curve 
+   ECDH, Curve25519 isn't tied to the use of an ECDSA host key so we also 
+   allow it in the non-ECC keyex list */
 
 static const ALGO_STRING_INFO FAR_DATA algoStringKeyexTbl[] = {
+#ifdef USE_25519
+	{ "curve25519-sha256", 17, CRYPT_ALGO_25519, CRYPT_ALGO_SHA2, bitsToBytes( 256 ) },
+	{ "curve25519-sha256@libssh.org", 28, CRYPT_ALGO_25519, CRYPT_ALGO_SHA2, bitsToBytes( 256 ) },
+#endif /* USE_25519 */
 #if defined( USE_ECDH ) && defined( PREFER_ECC )
 	{ "ecdh-sha2-nistp256", 18, CRYPT_ALGO_ECDH, CRYPT_ALGO_SHA2, bitsToBytes( 256 ) },
 #endif /* USE_ECDH && PREFER_ECC */
@@ -76,6 +86,10 @@ static const ALGO_STRING_INFO FAR_DATA algoStringKeyexTbl[] = {
 		{ NULL, 0, CRYPT_ALGO_NONE, CRYPT_ALGO_NONE, 0 }
 	};
 static const ALGO_STRING_INFO FAR_DATA algoStringKeyexNoECCTbl[] = {
+#ifdef USE_25519
+	{ "curve25519-sha256", 17, CRYPT_ALGO_25519, CRYPT_ALGO_SHA2, bitsToBytes( 256 ) },
+	{ "curve25519-sha256@libssh.org", 28, CRYPT_ALGO_25519, CRYPT_ALGO_SHA2, bitsToBytes( 256 ) },
+#endif /* USE_25519 */
 	{ "diffie-hellman-group-exchange-sha256", 36, CRYPT_ALGO_DH, CRYPT_ALGO_SHA2 },
 	{ "diffie-hellman-group-exchange-sha1", 34, CRYPT_ALGO_DH, CRYPT_ALGO_SHA1 },
 	{ "diffie-hellman-group14-sha256", 29, CRYPT_ALGO_DH, CRYPT_ALGO_SHA2, bitsToBytes( 2048 ) },
@@ -85,6 +99,9 @@ static const ALGO_STRING_INFO FAR_DATA algoStringKeyexNoECCTbl[] = {
 	};
 
 static const ALGO_STRING_INFO FAR_DATA algoStringPubkeyTbl[] = {
+#ifdef USE_ED25519
+	{ "ssh-ed25519", 11, CRYPT_ALGO_ED25519, CRYPT_ALGO_SHA2 },
+#endif /* USE_ED25519 */
 #if defined( USE_ECDSA ) && defined( PREFER_ECC )
 	{ "ecdsa-sha2-nistp256", 19, CRYPT_ALGO_ECDSA, CRYPT_ALGO_SHA2, , bitsToBytes( 256 ) },
 #endif /* USE_ECDSA && PREFER_ECC */
@@ -100,10 +117,17 @@ static const ALGO_STRING_INFO FAR_DATA algoStringPubkeyTbl[] = {
 		{ NULL, 0, CRYPT_ALGO_NONE, CRYPT_ALGO_NONE, 0 }
 	};
 
+/* The encryption algorithms carry the cipher mode as the algorithm 
+   parameter, since the same cipher can be used in more than one mode */
+
 static const ALGO_STRING_INFO FAR_DATA algoStringEncrTbl[] = {
-	{ "aes128-cbc", 10, CRYPT_ALGO_AES },
+#ifdef USE_CHACHA20
+	{ "chacha20-poly1305@openssh.com", 29, CRYPT_ALGO_CHACHA20, CRYPT_ALGO_NONE, CRYPT_MODE_CTR },
+#endif /* USE_CHACHA20 */
+	{ "aes128-ctr", 10, CRYPT_ALGO_AES, CRYPT_ALGO_NONE, CRYPT_MODE_CTR },
+	{ "aes128-cbc", 10, CRYPT_ALGO_AES, CRYPT_ALGO_NONE, CRYPT_MODE_CBC },
 #ifdef USE_3DES
-	{ "3des-cbc", 8, CRYPT_ALGO_3DES },
+	{ "3des-cbc", 8, CRYPT_ALGO_3DES, CRYPT_ALGO_NONE, CRYPT_MODE_CBC },
 #endif /* USE_3DES */
 	{ NULL, 0, CRYPT_ALGO_NONE }, { NULL, 0, CRYPT_ALGO_NONE }
 	};
@@ -123,6 +147,10 @@ static const ALGO_STRING_INFO FAR_DATA algoStringCoprTbl[] = {
 
 static const ALGO_STRING_INFO FAR_DATA algoStringMapTbl[] = {
 	/* Keyex algorithms */
+#ifdef USE_25519
+	{ "curve25519-sha256", 17, CRYPT_ALGO_25519, CRYPT_ALGO_SHA2, bitsToBytes( 256 ) },
+	{ "curve25519-sha256@libssh.org", 28, CRYPT_ALGO_25519, CRYPT_ALGO_SHA2, bitsToBytes( 256 ) },
+#endif /* USE_25519 */
 	{ "diffie-hellman-group-exchange-sha256", 36, CRYPT_ALGO_DH, CRYPT_ALGO_SHA2 },
 	{ "diffie-hellman-group-exchange-sha1", 34, CRYPT_ALGO_DH, CRYPT_ALGO_SHA1 },
 	{ "diffie-hellman-group14-sha256", 29, CRYPT_ALGO_DH, CRYPT_ALGO_SHA2, bitsToBytes( 2048 ) },
@@ -140,6 +168,9 @@ static const ALGO_STRING_INFO FAR_DATA algoStringMapTbl[] = {
 #ifdef USE_ECDSA
 	{ "ecdsa-sha2-nistp256", 19, CRYPT_ALGO_ECDSA, CRYPT_ALGO_SHA2, bitsToBytes( 256 ) },
 #endif /* USE_ECDSA */
+#ifdef USE_ED25519
+	{ "ssh-ed25519", 11, CRYPT_ALGO_ED25519, CRYPT_ALGO_SHA2 },
+#endif /* USE_ED25519 */
 
 	/* Encryption algorithms */
 	{ "aes128-cbc", 10, CRYPT_ALGO_AES },
@@ -593,34 +624,41 @@ int readAlgoString( INOUT STREAM *stream,
    always force these to be the same, first reading the algorithm for one
    direction and then making sure that the one for the other direction
    matches this.  All implementations seem to do this anyway, many aren't
-   even capable of supporting asymmetric algorithm choices */
+   even capable of supporting asymmetric algorithm choices.  If the caller
+   asks for it, we also return the algorithm parameter, which for the 
+   encryption algorithms is the cipher mode, and require that this matches
+   as well */
 
-CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4, 7 ) ) \
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4, 8 ) ) \
 static int readAlgoStringPair( INOUT STREAM *stream, 
 							   IN_ARRAY( noAlgoStringEntries ) \
 									const ALGO_STRING_INFO *algoInfo,
 							   IN_RANGE( 1, 100 ) const int noAlgoStringEntries,
 							   OUT_ALGO_Z CRYPT_ALGO_TYPE *algo, 
+							   OUT_OPT_INT_Z int *algoParam,
 							   const BOOLEAN isServer,
 							   const BOOLEAN allowAsymmetricAlgos,
 							   INOUT ERROR_INFO *errorInfo )
 	{
 	CRYPT_ALGO_TYPE pairPreferredAlgo;
 	ALGOID_INFO algoIDInfo;
-	int status;
+	int pairPreferredParam, status;
 
 	assert( isWritePtr( stream, sizeof( STREAM ) ) );
 	assert( isReadPtr( algoInfo, sizeof( ALGO_STRING_INFO ) * \
 								 noAlgoStringEntries ) );
 	assert( isWritePtr( algo, sizeof( CRYPT_ALGO_TYPE ) ) );
+	assert( algoParam == NULL || isWritePtr( algoParam, sizeof( int ) ) );
 
 	REQUIRES( noAlgoStringEntries > 0 && noAlgoStringEntries <= 100 );
 	REQUIRES( isServer == TRUE || isServer == FALSE );
 	REQUIRES( allowAsymmetricAlgos == TRUE || \
 			  allowAsymmetricAlgos == FALSE );
 
-	/* Clear return value */
+	/* Clear return values */
 	*algo = CRYPT_ALGO_NONE;
+	if( algoParam != NULL )
+		*algoParam = 0;
 
 	/* Get the first algorithm */
 	setAlgoIDInfo( &algoIDInfo, algoInfo, noAlgoStringEntries, 
@@ -630,14 +668,28 @@ static int readAlgoStringPair( INOUT STREAM *stream,
 	if( cryptStatusError( status ) )
 		return( status );
 	pairPreferredAlgo = algoIDInfo.algo;
+	pairPreferredParam = algoIDInfo.parameter;
 
 	/* Get the matched second algorithm.  Some buggy implementations request
 	   mismatched algorithms (at the moment this is only for compression 
 	   algorithms) but have no problems in accepting the same algorithm in 
 	   both directions, so if we're talking to one of these then we ignore 
-	   an algorithm mismatch */
-	setAlgoIDInfo( &algoIDInfo, algoInfo, noAlgoStringEntries,
-				   pairPreferredAlgo, GETALGO_FIRST_MATCH );
+	   an algorithm mismatch.  If there's an algorithm parameter involved 
+	   then matching on the algorithm alone isn't enough since the same 
+	   algorithm can appear more than once with different parameters, so we
+	   perform the same match as for the first algorithm and require that 
+	   the two results are identical */
+	if( algoParam != NULL )
+		{
+		setAlgoIDInfo( &algoIDInfo, algoInfo, noAlgoStringEntries, 
+					   CRYPT_ALGO_NONE, isServer ? GETALGO_FIRST_MATCH : \
+												   GETALGO_BEST_MATCH );
+		}
+	else
+		{
+		setAlgoIDInfo( &algoIDInfo, algoInfo, noAlgoStringEntries,
+					   pairPreferredAlgo, GETALGO_FIRST_MATCH );
+		}
 	status = readAlgoStringEx( stream, &algoIDInfo, errorInfo );
 	if (cryptStatusError(status))
 		return(status);
@@ -649,6 +701,18 @@ static int readAlgoStringPair( INOUT STREAM *stream,
 				  "in algorithm pair", pairPreferredAlgo, 
 				  algoIDInfo.algo ) );
 		}
+	if( algoParam != NULL )
+		{
+		if( pairPreferredParam != algoIDInfo.parameter )
+			{
+			retExt( CRYPT_ERROR_BADDATA,
+					( CRYPT_ERROR_BADDATA, errorInfo, 
+					  "Client algorithm mode %d doesn't match server "
+					  "algorithm mode %d in algorithm pair", 
+					  pairPreferredParam, algoIDInfo.parameter ) );
+			}
+		*algoParam = algoIDInfo.parameter;
+		}
 	*algo = algoIDInfo.algo;
 
 	return( status );
@@ -728,6 +792,43 @@ int writeAlgoString( INOUT STREAM *stream,
 	return( writeAlgoStringEx( stream, algo, CRYPT_ALGO_NONE, FALSE ) );
 	}
 
+/* Write an encryption algorithm name.  Since the same cipher can be used in
+   more than one mode, this is identified by the mode as well as the 
+   algorithm */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int writeCipherAlgoString( INOUT STREAM *stream, 
+						   IN_ALGO const CRYPT_ALGO_TYPE algo,
+						   IN_MODE const CRYPT_MODE_TYPE mode )
+	{
+	int algoIndex, LOOP_ITERATOR;
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	
+	REQUIRES( algo > CRYPT_ALGO_NONE && algo < CRYPT_ALGO_LAST_EXTERNAL );
+	REQUIRES( mode > CRYPT_MODE_NONE && mode < CRYPT_MODE_LAST );
+
+	LOOP_SMALL( algoIndex = 0, 
+				algoStringEncrTbl[ algoIndex ].algo != CRYPT_ALGO_NONE && \
+					algoIndex < FAILSAFE_ARRAYSIZE( algoStringEncrTbl, \
+													ALGO_STRING_INFO ), 
+				algoIndex++ )
+		{
+		const ALGO_STRING_INFO *algoStringInfo = \
+								&algoStringEncrTbl[ algoIndex ];
+
+		if( algoStringInfo->algo == algo && \
+			algoStringInfo->parameter == mode )
+			{
+			return( writeString32( stream, algoStringInfo->name, 
+								   algoStringInfo->nameLen ) );
+			}
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	retIntError();
+	}
+
 /* Write a list of algorithms */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
@@ -951,10 +1052,14 @@ int processHelloSSH( INOUT SESSION_INFO *sessionInfoPtr,
 			handshakeInfo->requestedServerKeySize = SSH2_DEFAULT_KEYSIZE;
 			}
 		}
-	if( algoIDInfo.algo == CRYPT_ALGO_ECDH )
+	if( algoIDInfo.algo == CRYPT_ALGO_ECDH || \
+		algoIDInfo.algo == CRYPT_ALGO_25519 )
 		{
 		/* If we're using an ECDH cipher suite then we need to switch to the
-		   appropriate hash algorithm for the keyex hashing */
+		   appropriate hash algorithm for the keyex hashing.  X25519 is 
+		   handled as a special case of ECDH since it uses the same message
+		   formats and hashing, differing only in the encoding of the 
+		   keyex values */
 		handshakeInfo->isECDH = TRUE;
 		handshakeInfo->exchangeHashAlgo = algoIDInfo.subAlgo;
 		}
@@ -1000,14 +1105,15 @@ int processHelloSSH( INOUT SESSION_INFO *sessionInfoPtr,
 	status = readAlgoStringPair( &stream, algoStringEncrTbl,
 							FAILSAFE_ARRAYSIZE( algoStringEncrTbl, \
 												ALGO_STRING_INFO ),
-							&sessionInfoPtr->cryptAlgo, isServer, FALSE, 
-							SESSION_ERRINFO );
+							&sessionInfoPtr->cryptAlgo, 
+							&sessionInfoPtr->sessionSSH->cryptMode, 
+							isServer, FALSE, SESSION_ERRINFO );
 	if( cryptStatusOK( status ) )
 		{
 		status = readAlgoStringPair( &stream, algoStringMACTbl,
 									 FAILSAFE_ARRAYSIZE( algoStringMACTbl, \
 														 ALGO_STRING_INFO ),
-									 &sessionInfoPtr->integrityAlgo,
+									 &sessionInfoPtr->integrityAlgo, NULL,
 									 isServer, FALSE, SESSION_ERRINFO );
 		}
 	if( cryptStatusError( status ) )
@@ -1022,7 +1128,7 @@ int processHelloSSH( INOUT SESSION_INFO *sessionInfoPtr,
 	status = readAlgoStringPair( &stream, algoStringCoprTbl, 
 								 FAILSAFE_ARRAYSIZE( algoStringCoprTbl, \
 													 ALGO_STRING_INFO ),
-								 &dummyAlgo, isServer, 
+								 &dummyAlgo, NULL, isServer, 
 								 ( sessionInfoPtr->protocolFlags & SSH_PFLAG_ASYMMCOPR ) ? \
 									TRUE : FALSE, SESSION_ERRINFO );
 	if( cryptStatusError( status ) )
@@ -1086,7 +1192,12 @@ int processHelloSSH( INOUT SESSION_INFO *sessionInfoPtr,
 	string		[ server key/certificate ]
 		string	"ecdsa-sha2-*"
 		string	"*"				-- The "*" portion from the above field
-		string	Q */
+		string	Q
+
+   Ed25519:
+	string		[ server key/certificate ]
+		string	"ssh-ed25519"
+		string	A				-- 32-byte encoded point */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3, 4 ) ) \
 int checkReadPublicKey( INOUT STREAM *stream,
@@ -1147,6 +1258,20 @@ int checkReadPublicKey( INOUT STREAM *stream,
 			break;
 #endif /* USE_ECDSA */
 
+#ifdef USE_ED25519
+		case CRYPT_ALGO_ED25519:
+			{
+			BYTE buffer[ X25519_KEYSIZE + 8 ];
+
+			/* Ed25519 A, which is a fixed-length string rather than an
+			   mpint */
+			status = readString32( stream, buffer, X25519_KEYSIZE, &dummy );
+			if( cryptStatusOK( status ) && dummy != X25519_KEYSIZE )
+				status = CRYPT_ERROR_BADDATA;
+			break;
+			}
+#endif /* USE_ED25519 */
+
 		default:
 			retIntError();
 		}
@@ -1264,12 +1389,17 @@ static int readHeaderFunction( INOUT SESSION_INFO *sessionInfoPtr,
 			 length <= sessionInfoPtr->receiveBufSize - \
 					   sessionInfoPtr->receiveBufPos && \
 			 length < MAX_BUFFER_SIZE );
-	status = checkMacSSHIncremental( sessionInfoPtr->iAuthInContext, 
-									 sshInfo->readSeqNo, bufPtr, 
-									 MIN_PACKET_SIZE - LENGTH_SIZE,
-									 MIN_PACKET_SIZE - LENGTH_SIZE, 
-									 length, MAC_START, 
-									 sessionInfoPtr->authBlocksize );
+	if( !isChaChaPolySSH( sessionInfoPtr ) )
+		{
+		/* chacha20-poly1305 has already MAC'd the header as part of the 
+		   decryption so there's nothing further to do */
+		status = checkMacSSHIncremental( sessionInfoPtr->iAuthInContext, 
+										 sshInfo->readSeqNo, bufPtr, 
+										 MIN_PACKET_SIZE - LENGTH_SIZE,
+										 MIN_PACKET_SIZE - LENGTH_SIZE, 
+										 length, MAC_START, 
+										 sessionInfoPtr->authBlocksize );
+		}
 	if( cryptStatusError( status ) )
 		{
 		/* We don't return an extended status at this point because we
@@ -1406,8 +1536,13 @@ static int processBodyFunction( INOUT SESSION_INFO *sessionInfoPtr,
 	REQUIRES( rangeCheck( sessionInfoPtr->receiveBufPos + \
 							sshInfo->partialPacketDataLength,
 						  dataRemainingSize, sessionInfoPtr->receiveBufEnd ) );
-	REQUIRES( dataRemainingSize >= sessionInfoPtr->authBlocksize && \
-			  dataLength >= 0 && dataLength < dataRemainingSize );
+	REQUIRES( ( dataRemainingSize >= sessionInfoPtr->authBlocksize && \
+				dataLength >= 0 && dataLength < dataRemainingSize ) || \
+			  ( isChaChaPolySSH( sessionInfoPtr ) && \
+				dataLength < 0 && dataRemainingSize > 0 ) );
+			  /* chacha20-poly1305 packets can be shorter than the fixed-
+			     length header, in which case part of the tag has already
+				 been read as part of the header */
 
 	/* All errors processing the payload are fatal */
 	*readInfo = READINFO_FATAL;
@@ -1425,7 +1560,26 @@ static int processBodyFunction( INOUT SESSION_INFO *sessionInfoPtr,
 			|			|///////////////////////|\\\\\\\|		+--+
 		----+-----------+-----------------------+-------+--		+--+
 						|<---- dataLength ----->|		|		|\\| MAC
-						|<------- dataRemaining ------->|		+--+ */
+						|<------- dataRemaining ------->|		+--+ 
+
+	   chacha20-poly1305 MACs the encrypted rather than the decrypted data,
+	   which the ChaCha20 context takes care of as part of the decryption, 
+	   so all that's left to do is check the tag */
+	if( isChaChaPolySSH( sessionInfoPtr ) )
+		{
+		if( dataLength > 0 )
+			{
+			status = krnlSendMessage( sessionInfoPtr->iCryptInContext,
+									  IMESSAGE_CTX_DECRYPT, dataRemainingPtr,
+									  dataLength );
+			if( cryptStatusError( status ) )
+				return( status );
+			}
+		status = checkPacketTagChaChaSSH( sessionInfoPtr->iCryptInContext,
+										  dataRemainingPtr + dataLength,
+										  sessionInfoPtr->authBlocksize );
+		}
+	else
 	if( dataLength > 0 )
 		{
 		status = krnlSendMessage( sessionInfoPtr->iCryptInContext,
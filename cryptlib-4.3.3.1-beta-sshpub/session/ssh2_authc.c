@@ -336,7 +336,9 @@ static int createPubkeyAuth( const SESSION_INFO *sessionInfoPtr,
 	writeString32( stream, "ssh-connection", 14 );
 	writeString32( stream, "publickey", 9 );
 	sputc( stream, 1 );
-	status = writeAlgoStringEx( stream, pkcAlgo, handshakeInfo->hashAlgo,
+	status = writeAlgoStringEx( stream, pkcAlgo, 
+								( pkcAlgo == CRYPT_ALGO_ED25519 ) ? \
+									CRYPT_ALGO_NONE : handshakeInfo->hashAlgo,
 								FALSE );
 	if( cryptStatusError( status ) )
 		return( status );
@@ -348,6 +350,18 @@ static int createPubkeyAuth( const SESSION_INFO *sessionInfoPtr,
 									 &packetDataLength, packetDataLength );
 	if( cryptStatusError( status ) )
 		return( status );
+#ifdef USE_ED25519
+
+	/* Ed25519 signs the authentication data directly rather than a hash of 
+	   it */
+	if( pkcAlgo == CRYPT_ALGO_ED25519 )
+		{
+		return( createAuthSigEd25519( stream, sessionInfoPtr->privateKey,
+									  handshakeInfo->sessionID, 
+									  handshakeInfo->sessionIDlength,
+									  packetDataPtr, packetDataLength ) );
+		}
+#endif /* USE_ED25519 */
 
 	/* Hash the authentication request data, composed of:
 
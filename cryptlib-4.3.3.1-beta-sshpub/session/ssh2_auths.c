@@ -480,6 +480,9 @@ static int checkPublicKeySig(INOUT SESSION_INFO *sessionInfoPtr,
 	BYTE holderName[CRYPT_MAX_TEXTSIZE + 8];
 	void *packetDataPtr DUMMY_INIT_PTR, *sigDataPtr;
 	int packetDataLength, sigDataLength, holderNameLen, status;
+#ifdef USE_ED25519
+	int pubkeyAlgo;
+#endif /* USE_ED25519 */
 
 	assert(isWritePtr(sessionInfoPtr, sizeof(SESSION_INFO)));
 	assert(isReadPtr(handshakeInfo, sizeof(SSH_HANDSHAKE_INFO)));
@@ -556,6 +559,36 @@ static int checkPublicKeySig(INOUT SESSION_INFO *sessionInfoPtr,
 	}
 	if (cryptStatusError(status))
 		return(status);
+#ifdef USE_ED25519
+
+	/* Ed25519 signs the authentication data directly rather than a hash of
+	   it */
+	status = krnlSendMessage(sessionInfoPtr->iKeyexAuthContext,
+		IMESSAGE_GETATTRIBUTE, &pubkeyAlgo,
+		CRYPT_CTXINFO_ALGO);
+	if (cryptStatusError(status))
+		return(status);
+	if (pubkeyAlgo == CRYPT_ALGO_ED25519)
+	{
+		status = sMemGetDataBlockRemaining(stream, &sigDataPtr,
+			&sigDataLength);
+		if (cryptStatusOK(status))
+		{
+			status = checkAuthSigEd25519(sessionInfoPtr->iKeyexAuthContext,
+				handshakeInfo->sessionID,
+				handshakeInfo->sessionIDlength,
+				packetDataPtr, packetDataLength,
+				sigDataPtr, min(sigDataLength, MAX_INTLENGTH_SHORT - 1));
+		}
+		if (cryptStatusError(status))
+		{
+			retExt(status,
+				(status, SESSION_ERRINFO,
+					"Verification of client's pubkey auth failed"));
+		}
+		return(CRYPT_OK);
+	}
+#endif /* USE_ED25519 */
 
 	/* Hash the authentication request data, composed of:
 
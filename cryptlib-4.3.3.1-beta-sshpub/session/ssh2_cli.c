@@ -179,6 +179,7 @@ static int processDHE(INOUT SESSION_INFO *sessionInfoPtr,
 	sMemDisconnect(stream);
 	if (cryptStatusError(status))
 		return(status);
+	recordHandshakeTime(sessionInfoPtr, SESSION_TIMING_HELLOSENT);
 	ANALYSER_HINT(keyexInfoPtr != NULL);
 
 	/* Remember the encoded key size information for later when we generate
@@ -328,6 +329,7 @@ static int beginClientHandshake(INOUT SESSION_INFO *sessionInfoPtr,
 		&serverHelloLength, FALSE);
 	if (cryptStatusError(status))
 		return(status);
+	recordHandshakeTime(sessionInfoPtr, SESSION_TIMING_HELLORECEIVED);
 
 	/* Build the client hello and DH/ECDH phase 1 keyex packet:
 
@@ -389,9 +391,15 @@ static int beginClientHandshake(INOUT SESSION_INFO *sessionInfoPtr,
 			handshakeInfo->hashAlgo, FALSE);
 	}
 	if (cryptStatusOK(status))
-		status = writeAlgoString(&stream, sessionInfoPtr->cryptAlgo);
+	{
+		status = writeCipherAlgoString(&stream, sessionInfoPtr->cryptAlgo,
+			sessionInfoPtr->sessionSSH->cryptMode);
+	}
 	if (cryptStatusOK(status))
-		status = writeAlgoString(&stream, sessionInfoPtr->cryptAlgo);
+	{
+		status = writeCipherAlgoString(&stream, sessionInfoPtr->cryptAlgo,
+			sessionInfoPtr->sessionSSH->cryptMode);
+	}
 	if (cryptStatusOK(status))
 		status = writeAlgoString(&stream, sessionInfoPtr->integrityAlgo);
 	if (cryptStatusOK(status))
@@ -466,7 +474,7 @@ static int beginClientHandshake(INOUT SESSION_INFO *sessionInfoPtr,
 	}
 	else
 	{
-#ifdef USE_ECDH 
+#if defined( USE_ECDH ) || defined( USE_25519 )
 		/* A second possibility is when we're using ECDH rather than DH, for
 		   which we have to use ECDH contexts and values */
 		if (handshakeInfo->isECDH)
@@ -478,7 +486,7 @@ static int beginClientHandshake(INOUT SESSION_INFO *sessionInfoPtr,
 				handshakeInfo->keyexAlgo);
 		}
 		else
-#endif /* USE_ECDH */
+#endif /* USE_ECDH || USE_25519 */
 		{
 			status = processDHE(sessionInfoPtr, handshakeInfo, &stream,
 				&keyAgreeParams);
@@ -572,6 +580,12 @@ static int beginClientHandshake(INOUT SESSION_INFO *sessionInfoPtr,
 	sMemDisconnect(&stream);
 	if (cryptStatusError(status))
 		return(status);
+	if (handshakeInfo->isFixedDH || handshakeInfo->isECDH)
+	{
+		/* For the ephemeral DH keyex the hello went out earlier together 
+		   with the keyex group request in processDHE() */
+		recordHandshakeTime(sessionInfoPtr, SESSION_TIMING_HELLOSENT);
+	}
 	ANALYSER_HINT(keyexPtr != NULL);
 
 	/* Save the MPI-encoded client DH keyex value/octet string-encoded client
@@ -649,12 +663,19 @@ static int exchangeClientKeys(INOUT SESSION_INFO *sessionInfoPtr,
 	   bits instead of MIN_PKCSIZE in order to provide better diagnostics if
 	   the server is using weak keys since otherwise the data will be
 	   rejected in the header read long before it gets to the keysize
-	   check */
+	   check.  Ed25519 keys and signatures are fixed-size and smaller than
+	   this, so we use their exact size as the minimum */
 	status = length = \
 		readHSPacketSSH2(sessionInfoPtr,
 		(handshakeInfo->isFixedDH || \
 			handshakeInfo->isECDH) ? \
 			SSH_MSG_KEXDH_REPLY : SSH_MSG_KEX_DH_GEX_REPLY,
+			(handshakeInfo->pubkeyAlgo == CRYPT_ALGO_ED25519) ? \
+			ID_SIZE + LENGTH_SIZE + sizeofString32(11) + \
+			sizeofString32(X25519_KEYSIZE) + \
+			sizeofString32(X25519_KEYSIZE) + \
+			LENGTH_SIZE + sizeofString32(11) + \
+			sizeofString32(ED25519_SIGNATURE_SIZE) : \
 			ID_SIZE + LENGTH_SIZE + sizeofString32(6) + \
 			sizeofString32(1) + \
 			sizeofString32(bitsToBytes(512) - 4) + \
@@ -757,6 +778,13 @@ static int exchangeClientKeys(INOUT SESSION_INFO *sessionInfoPtr,
 	}
 	if (cryptStatusOK(status))
 	{
+		if (handshakeInfo->keyexAlgo == CRYPT_ALGO_25519)
+		{
+			if (!isValid25519size(handshakeInfo->serverKeyexValueLength,
+				LENGTH_SIZE))
+				status = CRYPT_ERROR_BADDATA;
+		}
+		else
 		if (handshakeInfo->isECDH)
 		{
 			if (!isValidECDHsize(handshakeInfo->clientKeyexValueLength,
@@ -774,9 +802,12 @@ static int exchangeClientKeys(INOUT SESSION_INFO *sessionInfoPtr,
 	}
 	if (cryptStatusError(status))
 	{
-		const int clientKeyexSize = handshakeInfo->isECDH ? \
-			extractECDHsize(handshakeInfo->clientKeyexValueLength, LENGTH_SIZE) : \
-			extractDHsize(handshakeInfo->clientKeyexValueLength, LENGTH_SIZE);
+		const int clientKeyexSize = \
+			(handshakeInfo->keyexAlgo == CRYPT_ALGO_25519) ? \
+				handshakeInfo->serverKeyexValueLength - LENGTH_SIZE : \
+			handshakeInfo->isECDH ? \
+				extractECDHsize(handshakeInfo->clientKeyexValueLength, LENGTH_SIZE) : \
+				extractDHsize(handshakeInfo->clientKeyexValueLength, LENGTH_SIZE);
 
 		retExt(CRYPT_ERROR_BADDATA,
 			(CRYPT_ERROR_BADDATA, SESSION_ERRINFO,
@@ -792,6 +823,7 @@ static int exchangeClientKeys(INOUT SESSION_INFO *sessionInfoPtr,
 		sMemDisconnect(&stream);
 		return(status);
 	}
+	recordHandshakeTime(sessionInfoPtr, SESSION_TIMING_KEYEXCHANGE);
 
 	/* Prepare to process the handshake packet signature ("What are you
 	   preparing?! You're always preparing! Just go!") */
@@ -884,6 +916,7 @@ static int exchangeClientKeys(INOUT SESSION_INFO *sessionInfoPtr,
 			(status, SESSION_ERRINFO,
 				"Invalid handshake data signature"));
 	}
+	recordHandshakeTime(sessionInfoPtr, SESSION_TIMING_CERTVERIFIED);
 
 	/* We don't need the exchange hash contexts any more, get rid of them */
 	krnlSendNotifier(handshakeInfo->iExchangeHashContext,
@@ -8,11 +8,13 @@
 #if defined( INC_ALL )
   #include "crypt.h"
   #include "misc_rw.h"
+  #include "keypool.h"
   #include "session.h"
   #include "ssh.h"
 #else
   #include "crypt.h"
   #include "enc_dec/misc_rw.h"
+  #include "session/keypool.h"
   #include "session/session.h"
   #include "session/ssh.h"
 #endif /* Compiler-specific includes */
@@ -30,7 +32,7 @@
    cryptlib (or much of anything else).  To deal with this we synthesise it
    from ECB mode */
 
-#if 0	/* Not needed at the moment */
+#if 0	/* Not needed any more, CTR mode is now a native cryptlib mode */
 
 #define KSG_BUFFER_SIZE		512
 
@@ -146,6 +148,28 @@ int initDHcontextSSH( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 	*iCryptContext = CRYPT_ERROR;
 	*keySize = 0;
 
+	/* If we're using a built-in key, try and get a pre-generated one from 
+	   the ephemeral key pool */
+	if( keyData == NULL )
+		{
+		status = getKeyPoolContext( &iDHContext, CRYPT_ALGO_DH, 
+									requestedKeySize );
+		if( cryptStatusOK( status ) )
+			{
+			status = krnlSendMessage( iDHContext, IMESSAGE_GETATTRIBUTE, 
+									  &keyLength, CRYPT_CTXINFO_KEYSIZE );
+			if( cryptStatusError( status ) )
+				{
+				krnlSendNotifier( iDHContext, IMESSAGE_DECREFCOUNT );
+				return( status );
+				}
+			*iCryptContext = iDHContext;
+			*keySize = keyLength;
+
+			return( CRYPT_OK );
+			}
+		}
+
 	/* Create the DH context to contain the key */
 	setMessageCreateObjectInfo( &createInfo, CRYPT_ALGO_DH );
 	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_DEV_CREATEOBJECT,
@@ -199,10 +223,11 @@ int initDHcontextSSH( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 	return( CRYPT_OK );
 	}
 
-#ifdef USE_ECDH
+#if defined( USE_ECDH ) || defined( USE_25519 )
 
 /* Load one of the fixed SSH ECDH keys into a context.  Since there's no SSH
-   format defined for this, we use the SSL format */
+   format defined for this, we use the SSL format.  X25519 has no domain 
+   parameters so instead of loading them we generate the key directly */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
 int initECDHcontextSSH( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext, 
@@ -212,18 +237,70 @@ int initECDHcontextSSH( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 	CRYPT_CONTEXT iECDHContext;
 	MESSAGE_CREATEOBJECT_INFO createInfo;
 	MESSAGE_DATA msgData;
+#ifdef USE_ECDH
 	static const int eccKeySize = CRYPT_ECCCURVE_P256;
+	int keyLength;
+#endif /* USE_ECDH */
 	int status;
 
 	assert( isWritePtr( iCryptContext, sizeof( CRYPT_CONTEXT ) ) );
 	assert( isWritePtr( keySize, sizeof( int ) ) );
 
-	REQUIRES( cryptAlgo == CRYPT_ALGO_ECDH );
+	REQUIRES( cryptAlgo == CRYPT_ALGO_ECDH || \
+			  cryptAlgo == CRYPT_ALGO_25519 );
 
 	/* Clear return values */
 	*iCryptContext = CRYPT_ERROR;
 	*keySize = 0;
 
+#ifdef USE_25519
+	if( cryptAlgo == CRYPT_ALGO_25519 )
+		{
+		/* Create the X25519 context and generate a key into it */
+		setMessageCreateObjectInfo( &createInfo, CRYPT_ALGO_25519 );
+		status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, 
+								  IMESSAGE_DEV_CREATEOBJECT, &createInfo, 
+								  OBJECT_TYPE_CONTEXT );
+		if( cryptStatusError( status ) )
+			return( status );
+		iECDHContext = createInfo.cryptHandle;
+		setMessageData( &msgData, "SSH X25519 key", 14 );
+		status = krnlSendMessage( iECDHContext, IMESSAGE_SETATTRIBUTE_S, 
+								  &msgData, CRYPT_CTXINFO_LABEL );
+		if( cryptStatusOK( status ) )
+			status = krnlSendNotifier( iECDHContext, IMESSAGE_CTX_GENKEY );
+		if( cryptStatusError( status ) )
+			{
+			krnlSendNotifier( iECDHContext, IMESSAGE_DECREFCOUNT );
+			return( status );
+			}
+		*iCryptContext = iECDHContext;
+		*keySize = X25519_KEYSIZE;
+
+		return( CRYPT_OK );
+		}
+#endif /* USE_25519 */
+#ifdef USE_ECDH
+	/* Try and get a pre-generated key from the ephemeral key pool.  The 
+	   key size is taken from the context rather than being assumed from 
+	   the curve type so that it always matches the key that we got */
+	status = getKeyPoolContext( &iECDHContext, CRYPT_ALGO_ECDH, 
+								eccKeySize );
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( iECDHContext, IMESSAGE_GETATTRIBUTE, 
+								  &keyLength, CRYPT_CTXINFO_KEYSIZE );
+		if( cryptStatusError( status ) )
+			{
+			krnlSendNotifier( iECDHContext, IMESSAGE_DECREFCOUNT );
+			return( status );
+			}
+		*iCryptContext = iECDHContext;
+		*keySize = keyLength;
+
+		return( CRYPT_OK );
+		}
+
 	/* Create the ECDH context to contain the key */
 	setMessageCreateObjectInfo( &createInfo, CRYPT_ALGO_ECDH );
 	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_DEV_CREATEOBJECT,
@@ -243,7 +320,12 @@ int initECDHcontextSSH( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 	/* Load the appropriate static ECDH key parameters */
 	status = krnlSendMessage( iECDHContext, IMESSAGE_SETATTRIBUTE, 
 							  ( MESSAGE_CAST ) &eccKeySize, 
-							  CRYPT_IATTRIBUTE_KEY_DLPPARAM );
+							  CRYPT_IATTRIBUTE_KEY_ECCPARAM );
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( iECDHContext, IMESSAGE_GETATTRIBUTE, 
+								  &keyLength, CRYPT_CTXINFO_KEYSIZE );
+		}
 	if( cryptStatusError( status ) )
 		{
 		krnlSendNotifier( iECDHContext, IMESSAGE_DECREFCOUNT );
@@ -254,15 +336,80 @@ int initECDHcontextSSH( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 		retIntError();
 		}
 	*iCryptContext = iECDHContext;
-	*keySize = bitsToBytes( 256 );
+	*keySize = keyLength;
 
 	return( CRYPT_OK );
-	}
+#else
+	retIntError();
 #endif /* USE_ECDH */
+	}
+#endif /* USE_ECDH || USE_25519 */
 
 /* Complete the hashing necessary to generate a cryptovariable and send it
    to a context */
 
+#define MAX_CRYPTOVARIABLE_SIZE	( SSH2_CHACHAPOLY_KEY_SIZE * 2 )
+#define CRYPTOVARIABLE_BUFSIZE	( MAX_CRYPTOVARIABLE_SIZE + CRYPT_MAX_HASHSIZE )
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 5, 6, 8 ) ) \
+static int generateCryptovariable( OUT_BUFFER_FIXED( attributeSize ) \
+										BYTE *buffer,
+								   IN_RANGE( 8, MAX_CRYPTOVARIABLE_SIZE ) \
+										const int attributeSize, 
+								   const HASH_FUNCTION hashFunction,
+								   IN_RANGE( 20, 32 ) const int hashSize,
+								   const HASHINFO initialHashInfo, 
+								   IN_BUFFER( nonceLen ) const BYTE *nonce, 
+								   IN_RANGE( 1, 4 ) const int nonceLen,
+								   IN_BUFFER( dataLen ) const BYTE *data, 
+								   IN_LENGTH_SHORT const int dataLen )
+	{
+	HASHINFO hashInfo;
+	int generatedSize, LOOP_ITERATOR;
+
+	assert( isWritePtr( buffer, CRYPTOVARIABLE_BUFSIZE ) );
+	assert( isReadPtr( initialHashInfo, sizeof( HASHINFO ) ) );
+	assert( isReadPtrDynamic( nonce, nonceLen ) );
+	assert( isReadPtrDynamic( data, dataLen ) );
+
+	REQUIRES( attributeSize >= 8 && \
+			  attributeSize <= MAX_CRYPTOVARIABLE_SIZE );
+	REQUIRES( hashFunction != NULL );
+	REQUIRES( hashSize == 20 || hashSize == 32 );
+	REQUIRES( nonceLen >= 1 && nonceLen <= 4 );
+	REQUIRES( dataLen > 0 && dataLen < MAX_INTLENGTH_SHORT );
+
+	/* Complete the hashing */
+	memcpy( hashInfo, initialHashInfo, sizeof( HASHINFO ) );
+	hashFunction( hashInfo, NULL, 0, nonce, nonceLen, HASH_STATE_CONTINUE );
+	hashFunction( hashInfo, buffer, CRYPT_MAX_HASHSIZE, data, dataLen, 
+				  HASH_STATE_END );
+
+	/* If we need more data than the hashing will provide in one go,
+	   generate further blocks as:
+
+		hash( shared_secret || exchange_hash || data )
+
+	   where the shared secret and exchange hash are present as the
+	   precomputed data in the initial hash information and the data part 
+	   is the output of all of the hash steps so far.  This is normally 
+	   only a single additional block, but chacha20-poly1305 needs 64 bytes 
+	   of keying material which requires up to four blocks */
+	LOOP_SMALL( generatedSize = hashSize, generatedSize < attributeSize, 
+				generatedSize += hashSize )
+		{
+		ENSURES( generatedSize + CRYPT_MAX_HASHSIZE <= \
+				 CRYPTOVARIABLE_BUFSIZE );
+		memcpy( hashInfo, initialHashInfo, sizeof( HASHINFO ) );
+		hashFunction( hashInfo, buffer + generatedSize, CRYPT_MAX_HASHSIZE, 
+					  buffer, generatedSize, HASH_STATE_END );
+		}
+	ENSURES( LOOP_BOUND_OK );
+	zeroise( hashInfo, sizeof( HASHINFO ) );
+
+	return( CRYPT_OK );
+	}
+
 CHECK_RETVAL STDC_NONNULL_ARG( ( 4, 6, 7, 9 ) ) \
 static int loadCryptovariable( IN_HANDLE const CRYPT_CONTEXT iCryptContext,
 							   IN_ATTRIBUTE const CRYPT_ATTRIBUTE_TYPE attribute,
@@ -276,8 +423,7 @@ static int loadCryptovariable( IN_HANDLE const CRYPT_CONTEXT iCryptContext,
 							   IN_LENGTH_SHORT const int dataLen )
 	{
 	MESSAGE_DATA msgData;
-	HASHINFO hashInfo;
-	BYTE buffer[ CRYPT_MAX_KEYSIZE + 8 ];
+	BYTE buffer[ CRYPTOVARIABLE_BUFSIZE + 8 ];
 	int status;
 
 	assert( isReadPtr( initialHashInfo, sizeof( HASHINFO ) ) );
@@ -288,40 +434,68 @@ static int loadCryptovariable( IN_HANDLE const CRYPT_CONTEXT iCryptContext,
 	REQUIRES( attribute == CRYPT_CTXINFO_IV || \
 			  attribute == CRYPT_CTXINFO_KEY );
 	REQUIRES( attributeSize >= 8 && attributeSize <= 40 );
-	REQUIRES( hashFunction != NULL );
-	REQUIRES( hashSize == 20 || hashSize == 32 );
-	REQUIRES( nonceLen >= 1 && nonceLen <= 4 );
-	REQUIRES( dataLen > 0 && dataLen < MAX_INTLENGTH_SHORT );
-
-	static_assert( CRYPT_MAX_KEYSIZE >= CRYPT_MAX_HASHSIZE * 2,
-				   "Key size buffer as hash target" );
-
-	/* Complete the hashing */
-	memcpy( hashInfo, initialHashInfo, sizeof( HASHINFO ) );
-	hashFunction( hashInfo, NULL, 0, nonce, nonceLen, HASH_STATE_CONTINUE );
-	hashFunction( hashInfo, buffer, CRYPT_MAX_HASHSIZE, data, dataLen, 
-				  HASH_STATE_END );
-	if( attributeSize > hashSize )
-		{
-		/* If we need more data than the hashing will provide in one go,
-		   generate a second block as:
 
-			hash( shared_secret || exchange_hash || data )
-
-		   where the shared secret and exchange hash are present as the
-		   precomputed data in the initial hash information and the data 
-		   part is the output of the hash step above */
-		memcpy( hashInfo, initialHashInfo, sizeof( HASHINFO ) );
-		hashFunction( hashInfo, buffer + hashSize, CRYPT_MAX_HASHSIZE, 
-					  buffer, hashSize, HASH_STATE_END );
-		}
-	zeroise( hashInfo, sizeof( HASHINFO ) );
+	/* Generate the cryptovariable */
+	status = generateCryptovariable( buffer, attributeSize, hashFunction, 
+									 hashSize, initialHashInfo, nonce, 
+									 nonceLen, data, dataLen );
+	if( cryptStatusError( status ) )
+		return( status );
 
 	/* Send the data to the context */
 	setMessageData( &msgData, buffer, attributeSize );
 	status = krnlSendMessage( iCryptContext, IMESSAGE_SETATTRIBUTE_S,
 							  &msgData, attribute );
-	zeroise( buffer, CRYPT_MAX_KEYSIZE );
+	zeroise( buffer, CRYPTOVARIABLE_BUFSIZE );
+
+	return( status );
+	}
+
+/* Load the chacha20-poly1305 keys.  This uses a double-length key of which 
+   the first half keys the main context and the second half keys the header
+   context used to encrypt the packet length */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 3, 5, 6, 8 ) ) \
+static int loadChaChaPolyKeys( IN_HANDLE const CRYPT_CONTEXT iCryptContext,
+							   IN_HANDLE const CRYPT_CONTEXT iHeaderContext,
+							   const HASH_FUNCTION hashFunction,
+							   IN_RANGE( 20, 32 ) const int hashSize,
+							   const HASHINFO initialHashInfo, 
+							   IN_BUFFER( nonceLen ) const BYTE *nonce, 
+							   IN_RANGE( 1, 4 ) const int nonceLen,
+							   IN_BUFFER( dataLen ) const BYTE *data, 
+							   IN_LENGTH_SHORT const int dataLen )
+	{
+	MESSAGE_DATA msgData;
+	BYTE buffer[ CRYPTOVARIABLE_BUFSIZE + 8 ];
+	int status;
+
+	assert( isReadPtr( initialHashInfo, sizeof( HASHINFO ) ) );
+	assert( isReadPtrDynamic( nonce, nonceLen ) );
+	assert( isReadPtrDynamic( data, dataLen ) );
+
+	REQUIRES( isHandleRangeValid( iCryptContext ) );
+	REQUIRES( isHandleRangeValid( iHeaderContext ) );
+
+	/* Generate the double-length key and send each half to the 
+	   appropriate context */
+	status = generateCryptovariable( buffer, SSH2_CHACHAPOLY_KEY_SIZE * 2, 
+									 hashFunction, hashSize, 
+									 initialHashInfo, nonce, nonceLen, 
+									 data, dataLen );
+	if( cryptStatusError( status ) )
+		return( status );
+	setMessageData( &msgData, buffer, SSH2_CHACHAPOLY_KEY_SIZE );
+	status = krnlSendMessage( iCryptContext, IMESSAGE_SETATTRIBUTE_S,
+							  &msgData, CRYPT_CTXINFO_KEY );
+	if( cryptStatusOK( status ) )
+		{
+		setMessageData( &msgData, buffer + SSH2_CHACHAPOLY_KEY_SIZE, 
+						SSH2_CHACHAPOLY_KEY_SIZE );
+		status = krnlSendMessage( iHeaderContext, IMESSAGE_SETATTRIBUTE_S,
+								  &msgData, CRYPT_CTXINFO_KEY );
+		}
+	zeroise( buffer, CRYPTOVARIABLE_BUFSIZE );
 
 	return( status );
 	}
@@ -356,6 +530,34 @@ int initSecurityContextsSSH( INOUT SESSION_INFO *sessionInfoPtr )
 						 IMESSAGE_GETATTRIBUTE, &sessionInfoPtr->cryptBlocksize,
 						 CRYPT_CTXINFO_BLOCKSIZE );
 		}
+	if( cryptStatusOK( status ) && isChaChaPolySSH( sessionInfoPtr ) )
+		{
+		/* ChaCha20 is a stream cipher with a block size of one byte, but
+		   chacha20-poly1305 pads packets to a multiple of 8 bytes */
+		sessionInfoPtr->cryptBlocksize = SSH2_CHACHAPOLY_BLOCK_SIZE;
+		}
+	if( cryptStatusOK( status ) && !isChaChaPolySSH( sessionInfoPtr ) && \
+		sessionInfoPtr->sessionSSH->cryptMode == CRYPT_MODE_CTR )
+		{
+		const int cryptMode = CRYPT_MODE_CTR;	/* int vs.enum */
+
+		/* The cipher defaults to CBC mode, if we've negotiated CTR mode 
+		   then we have to set the mode explicitly.  We've already read the
+		   cipher blocksize, which is still used for the packet padding and
+		   length-decryption, before switching the context to the 
+		   (byte-oriented) CTR mode */
+		status = krnlSendMessage( sessionInfoPtr->iCryptInContext,
+								  IMESSAGE_SETATTRIBUTE,
+								  ( MESSAGE_CAST ) &cryptMode,
+								  CRYPT_CTXINFO_MODE );
+		if( cryptStatusOK( status ) )
+			{
+			status = krnlSendMessage( sessionInfoPtr->iCryptOutContext,
+									  IMESSAGE_SETATTRIBUTE,
+									  ( MESSAGE_CAST ) &cryptMode,
+									  CRYPT_CTXINFO_MODE );
+			}
+		}
 #ifdef USE_SSH1
 	if( cryptStatusOK( status ) && sessionInfoPtr->version == 1 && \
 		sessionInfoPtr->cryptAlgo == CRYPT_ALGO_IDEA )
@@ -380,15 +582,22 @@ int initSecurityContextsSSH( INOUT SESSION_INFO *sessionInfoPtr )
 #endif /* USE_SSH1 */
 	if( cryptStatusOK( status ) )
 		{
-		setMessageCreateObjectInfo( &createInfo, sessionInfoPtr->integrityAlgo );
+		/* If we're using chacha20-poly1305 then there's no MAC context, 
+		   instead the auth.contexts are the ChaCha20 header contexts used 
+		   to encrypt the packet length and the "MAC" is the Poly1305 tag
+		   produced by the main contexts */
+		const CRYPT_ALGO_TYPE authAlgo = \
+						isChaChaPolySSH( sessionInfoPtr ) ? \
+						CRYPT_ALGO_CHACHA20 : sessionInfoPtr->integrityAlgo;
+
+		setMessageCreateObjectInfo( &createInfo, authAlgo );
 		status = krnlSendMessage( SYSTEM_OBJECT_HANDLE,
 								  IMESSAGE_DEV_CREATEOBJECT, &createInfo,
 								  OBJECT_TYPE_CONTEXT );
 		if( cryptStatusOK( status ) )
 			{
 			sessionInfoPtr->iAuthInContext = createInfo.cryptHandle;
-			setMessageCreateObjectInfo( &createInfo,
-										sessionInfoPtr->integrityAlgo );
+			setMessageCreateObjectInfo( &createInfo, authAlgo );
 			status = krnlSendMessage( SYSTEM_OBJECT_HANDLE,
 									  IMESSAGE_DEV_CREATEOBJECT, &createInfo,
 									  OBJECT_TYPE_CONTEXT );
@@ -396,10 +605,15 @@ int initSecurityContextsSSH( INOUT SESSION_INFO *sessionInfoPtr )
 		if( cryptStatusOK( status ) )
 			{
 			sessionInfoPtr->iAuthOutContext = createInfo.cryptHandle;
-			krnlSendMessage( sessionInfoPtr->iAuthInContext,
-							 IMESSAGE_GETATTRIBUTE,
-							 &sessionInfoPtr->authBlocksize,
-							 CRYPT_CTXINFO_BLOCKSIZE );
+			if( isChaChaPolySSH( sessionInfoPtr ) )
+				sessionInfoPtr->authBlocksize = SSH2_CHACHAPOLY_TAG_SIZE;
+			else
+				{
+				krnlSendMessage( sessionInfoPtr->iAuthInContext,
+								 IMESSAGE_GETATTRIBUTE,
+								 &sessionInfoPtr->authBlocksize,
+								 CRYPT_CTXINFO_BLOCKSIZE );
+				}
 			}
 		}
 	if( cryptStatusError( status ) )
@@ -476,7 +690,8 @@ int initSecurityInfo( INOUT SESSION_INFO *sessionInfoPtr,
 							  CRYPT_CTXINFO_KEYSIZE );
 	if( cryptStatusError( status ) )
 		return( status );
-	if( !isStreamCipher( sessionInfoPtr->cryptAlgo ) )
+	if( !isStreamCipher( sessionInfoPtr->cryptAlgo ) && \
+		!isChaChaPolySSH( sessionInfoPtr ) )
 		{
 		status = krnlSendMessage( sessionInfoPtr->iCryptInContext,
 								  IMESSAGE_GETATTRIBUTE, &ivSize,
@@ -555,6 +770,37 @@ int initSecurityInfo( INOUT SESSION_INFO *sessionInfoPtr,
 	   set to the HMAC block size.  Some implementations erroneously use
 	   the fixed-size key, so we adjust the HMAC key size if we're talking
 	   to one of these */
+	if( isChaChaPolySSH( sessionInfoPtr ) )
+		{
+		/* chacha20-poly1305 has no IVs, since the nonce is the packet 
+		   sequence number, and no MAC keys, so all that we need are the 
+		   double-length keys for the main and header contexts */
+		status = loadChaChaPolyKeys( isClient ? \
+										sessionInfoPtr->iCryptOutContext : \
+										sessionInfoPtr->iCryptInContext,
+									 isClient ? \
+										sessionInfoPtr->iAuthOutContext : \
+										sessionInfoPtr->iAuthInContext,
+									 hashFunction, hashSize,
+									 initialHashInfo, MKDATA( "C" ), 1,
+									 handshakeInfo->sessionID,
+									 handshakeInfo->sessionIDlength );
+		if( cryptStatusOK( status ) )
+			{
+			status = loadChaChaPolyKeys( isClient ? \
+											sessionInfoPtr->iCryptInContext : \
+											sessionInfoPtr->iCryptOutContext,
+										 isClient ? \
+											sessionInfoPtr->iAuthInContext : \
+											sessionInfoPtr->iAuthOutContext,
+										 hashFunction, hashSize,
+										 initialHashInfo, MKDATA( "D" ), 1,
+										 handshakeInfo->sessionID,
+										 handshakeInfo->sessionIDlength );
+			}
+		zeroise( initialHashInfo, sizeof( HASHINFO ) );
+		return( status );
+		}
 	if( !isStreamCipher( sessionInfoPtr->cryptAlgo ) )
 		{
 		status = loadCryptovariable( isClient ? \
@@ -966,6 +1212,366 @@ int createMacSSH( IN_HANDLE const CRYPT_CONTEXT iMacContext,
 	return( CRYPT_OK );
 	}
 
+/****************************************************************************
+*																			*
+*							ChaCha20-Poly1305 Packets						*
+*																			*
+****************************************************************************/
+
+/* chacha20-poly1305@openssh.com doesn't use the negotiated MAC but uses
+   two ChaCha20 contexts per direction, a header context keyed with K_1 
+   that encrypts only the packet length and a main context keyed with K_2
+   that encrypts the rest of the packet and provides the Poly1305 tag.  
+   Both contexts use the 64-bit packet sequence number as the nonce:
+
+	length = ChaCha20( K_1, seqNo, length )
+	Poly1305 key = ChaCha20( K_2, seqNo, ctr = 0 )
+	data = ChaCha20( K_2, seqNo, ctr = 1, data )
+	tag = Poly1305( length || data )
+
+   The ChaCha20 context handles the Poly1305 side of things when it's given 
+   an 8-byte nonce and AAD, which here is the encrypted length, so all that 
+   we need to do is set the nonce for each packet and feed the two parts of 
+   the packet to the appropriate context */
+
+CHECK_RETVAL \
+static int setPacketNonce( IN_HANDLE const CRYPT_CONTEXT iCryptContext,
+						   IN_HANDLE const CRYPT_CONTEXT iHeaderContext,
+						   IN_INT const long seqNo )
+	{
+	STREAM stream;
+	MESSAGE_DATA msgData;
+	BYTE nonce[ 8 + 8 ];
+	int status;
+
+	REQUIRES( isHandleRangeValid( iCryptContext ) );
+	REQUIRES( isHandleRangeValid( iHeaderContext ) );
+	REQUIRES( seqNo >= 2 && seqNo < INT_MAX );
+
+	sMemOpen( &stream, nonce, 8 );
+	status = writeUint64( &stream, seqNo );
+	sMemDisconnect( &stream );
+	ENSURES( cryptStatusOK( status ) );
+	setMessageData( &msgData, nonce, 8 );
+	status = krnlSendMessage( iHeaderContext, IMESSAGE_SETATTRIBUTE_S,
+							  &msgData, CRYPT_CTXINFO_IV );
+	if( cryptStatusError( status ) )
+		return( status );
+	setMessageData( &msgData, nonce, 8 );
+	return( krnlSendMessage( iCryptContext, IMESSAGE_SETATTRIBUTE_S,
+							 &msgData, CRYPT_CTXINFO_IV ) );
+	}
+
+/* Decrypt the fixed-length packet header.  Since the packet can be shorter 
+   than the header, in which case part of what's been read is the tag, we 
+   only decrypt as much of the header as is covered by the packet length */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3 ) ) \
+int decryptPacketHeaderChaChaSSH( INOUT SESSION_INFO *sessionInfoPtr,
+								  IN_INT const long seqNo,
+								  INOUT_BUFFER_FIXED( headerLength ) \
+									BYTE *header,
+								  IN_LENGTH_SHORT const int headerLength )
+	{
+	STREAM stream;
+	MESSAGE_DATA msgData;
+	BYTE encLength[ LENGTH_SIZE + 8 ];
+	int length, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtrDynamic( header, headerLength ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( isChaChaPolySSH( sessionInfoPtr ) );
+	REQUIRES( seqNo >= 2 && seqNo < INT_MAX );
+	REQUIRES( headerLength > LENGTH_SIZE && \
+			  headerLength < MAX_INTLENGTH_SHORT );
+
+	status = setPacketNonce( sessionInfoPtr->iCryptInContext, 
+							 sessionInfoPtr->iAuthInContext, seqNo );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Decrypt the length with the header context and MAC the encrypted 
+	   form with the main context */
+	memcpy( encLength, header, LENGTH_SIZE );
+	status = krnlSendMessage( sessionInfoPtr->iAuthInContext,
+							  IMESSAGE_CTX_DECRYPT, header, LENGTH_SIZE );
+	if( cryptStatusError( status ) )
+		return( status );
+	setMessageData( &msgData, encLength, LENGTH_SIZE );
+	status = krnlSendMessage( sessionInfoPtr->iCryptInContext, 
+							  IMESSAGE_SETATTRIBUTE_S, &msgData, 
+							  CRYPT_IATTRIBUTE_AAD );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Decrypt the rest of the header, or as much of it as belongs to the 
+	   packet.  If the length is invalid then we leave the rest of the 
+	   header as is, the caller will reject the packet in any case */
+	sMemConnect( &stream, header, LENGTH_SIZE );
+	status = length = readUint32( &stream );
+	sMemDisconnect( &stream );
+	if( cryptStatusError( status ) || length <= 0 )
+		return( CRYPT_OK );
+	return( krnlSendMessage( sessionInfoPtr->iCryptInContext,
+							 IMESSAGE_CTX_DECRYPT, header + LENGTH_SIZE,
+							 min( length, headerLength - LENGTH_SIZE ) ) );
+	}
+
+/* Encrypt a packet and append the tag */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3 ) ) \
+int encryptPacketChaChaSSH( INOUT SESSION_INFO *sessionInfoPtr,
+							IN_INT const long seqNo,
+							INOUT_BUFFER( dataMaxLength, dataLength ) \
+								BYTE *data, 
+							IN_DATALENGTH const int dataMaxLength, 
+							IN_DATALENGTH const int dataLength )
+	{
+	MESSAGE_DATA msgData;
+	int status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtrDynamic( data, dataMaxLength ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( isChaChaPolySSH( sessionInfoPtr ) );
+	REQUIRES( seqNo >= 2 && seqNo < INT_MAX );
+	REQUIRES( dataMaxLength > 0 && dataMaxLength < MAX_BUFFER_SIZE );
+	REQUIRES( dataLength > LENGTH_SIZE && \
+			  dataLength + SSH2_CHACHAPOLY_TAG_SIZE <= dataMaxLength );
+
+	status = setPacketNonce( sessionInfoPtr->iCryptOutContext, 
+							 sessionInfoPtr->iAuthOutContext, seqNo );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Encrypt the length with the header context, MAC the encrypted form 
+	   with the main context, and encrypt the remainder of the packet with
+	   the main context */
+	status = krnlSendMessage( sessionInfoPtr->iAuthOutContext,
+							  IMESSAGE_CTX_ENCRYPT, data, LENGTH_SIZE );
+	if( cryptStatusError( status ) )
+		return( status );
+	setMessageData( &msgData, data, LENGTH_SIZE );
+	status = krnlSendMessage( sessionInfoPtr->iCryptOutContext, 
+							  IMESSAGE_SETATTRIBUTE_S, &msgData, 
+							  CRYPT_IATTRIBUTE_AAD );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = krnlSendMessage( sessionInfoPtr->iCryptOutContext,
+							  IMESSAGE_CTX_ENCRYPT, data + LENGTH_SIZE,
+							  dataLength - LENGTH_SIZE );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Append the tag */
+	setMessageData( &msgData, data + dataLength, SSH2_CHACHAPOLY_TAG_SIZE );
+	status = krnlSendMessage( sessionInfoPtr->iCryptOutContext,
+							  IMESSAGE_GETATTRIBUTE_S, &msgData, 
+							  CRYPT_IATTRIBUTE_ICV );
+
+	return( status );
+	}
+
+/* Check the tag on a decrypted packet */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+int checkPacketTagChaChaSSH( IN_HANDLE const CRYPT_CONTEXT iCryptContext,
+							 IN_BUFFER( tagLength ) const BYTE *tag,
+							 IN_LENGTH_SHORT const int tagLength )
+	{
+	MESSAGE_DATA msgData;
+
+	assert( isReadPtrDynamic( tag, tagLength ) );
+
+	REQUIRES( isHandleRangeValid( iCryptContext ) );
+	REQUIRES( tagLength == SSH2_CHACHAPOLY_TAG_SIZE );
+
+	setMessageData( &msgData, ( BYTE * ) tag, tagLength );
+	return( krnlSendMessage( iCryptContext, IMESSAGE_COMPARE, &msgData, 
+							 MESSAGE_COMPARE_ICV ) );
+	}
+
+/****************************************************************************
+*																			*
+*						Ed25519 Authentication Signatures					*
+*																			*
+****************************************************************************/
+
+#ifdef USE_ED25519
+
+/* Ed25519 signs the raw authentication data rather than a hash of it
+   (RFC 8709), so we can't go via iCryptCreateSignature()/
+   iCryptCheckSignature(), which work with hash contexts, and have to 
+   assemble the data to be signed and talk to the context directly.  The 
+   data is:
+
+	string		exchange hash
+	[ SSH_MSG_USERAUTH_REQUEST packet payload up to signature start ]
+
+   The server-side code has had the packet ID byte stripped by 
+   readAuthPacketSSH2(), so we re-insert it if required */
+
+#define ED25519_AUTHDATA_SIZE	1024
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 4, 6 ) ) \
+static int getAuthData( OUT_BUFFER( authDataMaxLength, *authDataLength ) \
+							BYTE *authData, 
+						IN_LENGTH_SHORT const int authDataMaxLength,
+						OUT_LENGTH_SHORT_Z int *authDataLength,
+						IN_BUFFER( sessionIDlength ) const BYTE *sessionID,
+						IN_LENGTH_HASH const int sessionIDlength,
+						IN_BUFFER( packetDataLength ) const void *packetData,
+						IN_LENGTH_SHORT const int packetDataLength,
+						const BOOLEAN addPacketID )
+	{
+	STREAM stream;
+	int status;
+
+	assert( isWritePtrDynamic( authData, authDataMaxLength ) );
+	assert( isWritePtr( authDataLength, sizeof( int ) ) );
+	assert( isReadPtrDynamic( sessionID, sessionIDlength ) );
+	assert( isReadPtrDynamic( packetData, packetDataLength ) );
+
+	REQUIRES( authDataMaxLength > 0 && \
+			  authDataMaxLength < MAX_INTLENGTH_SHORT );
+	REQUIRES( sessionIDlength > 0 && \
+			  sessionIDlength <= CRYPT_MAX_HASHSIZE );
+	REQUIRES( packetDataLength > 0 && \
+			  packetDataLength < MAX_INTLENGTH_SHORT );
+
+	/* Clear return value */
+	*authDataLength = 0;
+
+	sMemOpen( &stream, authData, authDataMaxLength );
+	writeString32( &stream, sessionID, sessionIDlength );
+	if( addPacketID )
+		sputc( &stream, SSH_MSG_USERAUTH_REQUEST );
+	status = swrite( &stream, packetData, packetDataLength );
+	if( cryptStatusOK( status ) )
+		*authDataLength = stell( &stream );
+	sMemDisconnect( &stream );
+
+	return( status );
+	}
+
+/* Create and check Ed25519 authentication signatures:
+
+	string		signature_blob
+		string	"ssh-ed25519"
+		string	signature */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 5 ) ) \
+int createAuthSigEd25519( INOUT STREAM *stream,
+						  IN_HANDLE const CRYPT_CONTEXT iSignContext,
+						  IN_BUFFER( sessionIDlength ) const BYTE *sessionID,
+						  IN_LENGTH_HASH const int sessionIDlength,
+						  IN_BUFFER( packetDataLength ) const void *packetData,
+						  IN_LENGTH_SHORT const int packetDataLength )
+	{
+	DLP_PARAMS dlpParams;
+	BYTE authData[ ED25519_AUTHDATA_SIZE + 8 ];
+	BYTE signature[ ED25519_SIGNATURE_SIZE + 8 ];
+	int authDataLength, status;
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isReadPtrDynamic( sessionID, sessionIDlength ) );
+	assert( isReadPtrDynamic( packetData, packetDataLength ) );
+
+	REQUIRES( isHandleRangeValid( iSignContext ) );
+	REQUIRES( sessionIDlength > 0 && \
+			  sessionIDlength <= CRYPT_MAX_HASHSIZE );
+	REQUIRES( packetDataLength > 0 && \
+			  packetDataLength < MAX_INTLENGTH_SHORT );
+
+	status = getAuthData( authData, ED25519_AUTHDATA_SIZE, &authDataLength,
+						  sessionID, sessionIDlength, packetData, 
+						  packetDataLength, FALSE );
+	if( cryptStatusError( status ) )
+		return( status );
+	setDLPParams( &dlpParams, authData, authDataLength, signature, 
+				  ED25519_SIGNATURE_SIZE );
+	dlpParams.formatType = CRYPT_IFORMAT_SSH;
+	status = krnlSendMessage( iSignContext, IMESSAGE_CTX_SIGN, &dlpParams, 
+							  sizeof( DLP_PARAMS ) );
+	zeroise( authData, ED25519_AUTHDATA_SIZE );
+	if( cryptStatusError( status ) )
+		return( status );
+	ENSURES( dlpParams.outLen == ED25519_SIGNATURE_SIZE );
+	writeUint32( stream, sizeofString32( 11 ) + \
+						 sizeofString32( ED25519_SIGNATURE_SIZE ) );
+	writeString32( stream, "ssh-ed25519", 11 );
+	return( writeString32( stream, signature, ED25519_SIGNATURE_SIZE ) );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2, 4, 6 ) ) \
+int checkAuthSigEd25519( IN_HANDLE const CRYPT_CONTEXT iSigCheckContext,
+						 IN_BUFFER( sessionIDlength ) const BYTE *sessionID,
+						 IN_LENGTH_HASH const int sessionIDlength,
+						 IN_BUFFER( packetDataLength ) const void *packetData,
+						 IN_LENGTH_SHORT const int packetDataLength,
+						 IN_BUFFER( sigDataLength ) const void *sigData,
+						 IN_LENGTH_SHORT const int sigDataLength )
+	{
+	STREAM stream;
+	DLP_PARAMS dlpParams;
+	BYTE authData[ ED25519_AUTHDATA_SIZE + 8 ];
+	BYTE signature[ ED25519_SIGNATURE_SIZE + 8 ];
+	BYTE algoName[ CRYPT_MAX_TEXTSIZE + 8 ];
+	int authDataLength, algoNameLength, signatureLength, status;
+
+	assert( isReadPtrDynamic( sessionID, sessionIDlength ) );
+	assert( isReadPtrDynamic( packetData, packetDataLength ) );
+	assert( isReadPtrDynamic( sigData, sigDataLength ) );
+
+	REQUIRES( isHandleRangeValid( iSigCheckContext ) );
+	REQUIRES( sessionIDlength > 0 && \
+			  sessionIDlength <= CRYPT_MAX_HASHSIZE );
+	REQUIRES( packetDataLength > 0 && \
+			  packetDataLength < MAX_INTLENGTH_SHORT );
+	REQUIRES( sigDataLength > 0 && sigDataLength < MAX_INTLENGTH_SHORT );
+
+	/* Read the signature blob */
+	sMemConnect( &stream, sigData, sigDataLength );
+	readUint32( &stream );
+	status = readString32( &stream, algoName, CRYPT_MAX_TEXTSIZE, 
+						   &algoNameLength );
+	if( cryptStatusOK( status ) )
+		{
+		if( algoNameLength != 11 || \
+			memcmp( algoName, "ssh-ed25519", 11 ) )
+			status = CRYPT_ERROR_BADDATA;
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = readString32( &stream, signature, ED25519_SIGNATURE_SIZE, 
+							   &signatureLength );
+		}
+	sMemDisconnect( &stream );
+	if( cryptStatusError( status ) )
+		return( CRYPT_ERROR_BADDATA );
+	if( signatureLength != ED25519_SIGNATURE_SIZE )
+		return( CRYPT_ERROR_BADDATA );
+
+	/* Check the signature over the authentication data */
+	status = getAuthData( authData, ED25519_AUTHDATA_SIZE, &authDataLength,
+						  sessionID, sessionIDlength, packetData, 
+						  packetDataLength, TRUE );
+	if( cryptStatusError( status ) )
+		return( status );
+	setDLPParams( &dlpParams, authData, authDataLength, NULL, 0 );
+	dlpParams.inParam2 = signature;
+	dlpParams.inLen2 = ED25519_SIGNATURE_SIZE;
+	dlpParams.formatType = CRYPT_IFORMAT_SSH;
+	status = krnlSendMessage( iSigCheckContext, IMESSAGE_CTX_SIGCHECK, 
+							  &dlpParams, sizeof( DLP_PARAMS ) );
+	zeroise( authData, ED25519_AUTHDATA_SIZE );
+	return( status );
+	}
+#endif /* USE_ED25519 */
+
 /****************************************************************************
 *																			*
 *								Keyex Functions								*
@@ -1005,6 +1611,16 @@ int completeKeyex( INOUT SESSION_INFO *sessionInfoPtr,
 		sMemConnect( &stream, handshakeInfo->serverKeyexValue,
 					 handshakeInfo->serverKeyexValueLength );
 		}
+	if( handshakeInfo->keyexAlgo == CRYPT_ALGO_25519 )
+		{
+		/* X25519 values are fixed-length little-endian strings that can 
+		   have leading zero bytes, so we have to read them as strings 
+		   rather than integers */
+		status = readString32( &stream, keyAgreeParams.publicValue,
+							   CRYPT_MAX_PKCSIZE, 
+							   &keyAgreeParams.publicValueLen );
+		}
+	else
 	if( handshakeInfo->isECDH )
 		{
 		/* This is actually a String32 and not an Integer32, however the
@@ -1030,6 +1646,12 @@ int completeKeyex( INOUT SESSION_INFO *sessionInfoPtr,
 		}
 	if( cryptStatusOK( status ) )
 		{
+		if( handshakeInfo->keyexAlgo == CRYPT_ALGO_25519 )
+			{
+			if( !isValid25519size( keyAgreeParams.publicValueLen, 0 ) )
+				status = CRYPT_ERROR_BADDATA;
+			}
+		else
 		if( handshakeInfo->isECDH )
 			{
 			if( !isValidECDHsize( keyAgreeParams.publicValueLen,
@@ -1045,9 +1667,12 @@ int completeKeyex( INOUT SESSION_INFO *sessionInfoPtr,
 		}
 	if( cryptStatusError( status ) )
 		{
-		const int clientKeyexSize = handshakeInfo->isECDH ? \
-			extractECDHsize( keyAgreeParams.publicValueLen, 0 ) : \
-			extractDHsize( keyAgreeParams.publicValueLen, 0 );
+		const int clientKeyexSize = \
+			( handshakeInfo->keyexAlgo == CRYPT_ALGO_25519 ) ? \
+				keyAgreeParams.publicValueLen : \
+			handshakeInfo->isECDH ? \
+				extractECDHsize( keyAgreeParams.publicValueLen, 0 ) : \
+				extractDHsize( keyAgreeParams.publicValueLen, 0 );
 
 		retExt( CRYPT_ERROR_BADDATA,
 				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
@@ -1062,6 +1687,27 @@ int completeKeyex( INOUT SESSION_INFO *sessionInfoPtr,
 	status = krnlSendMessage( handshakeInfo->iServerCryptContext,
 							  IMESSAGE_CTX_DECRYPT, &keyAgreeParams,
 							  sizeof( KEYAGREE_PARAMS ) );
+	if( cryptStatusOK( status ) && \
+		handshakeInfo->keyexAlgo == CRYPT_ALGO_25519 )
+		{
+		int i, LOOP_ITERATOR;
+
+		/* The X25519 shared secret is a fixed-length string but SSH hashes 
+		   it as an MPI, so we have to strip any leading zero bytes to get
+		   the canonical MPI form (RFC 8731 section 3.1).  The all-zero 
+		   value has already been rejected by the X25519 context */
+		LOOP_SMALL( i = 0, i < keyAgreeParams.wrappedKeyLen - 1 && \
+						   keyAgreeParams.wrappedKey[ i ] == 0, i++ );
+		ENSURES( LOOP_BOUND_OK );
+		if( i > 0 )
+			{
+			memmove( keyAgreeParams.wrappedKey, 
+					 keyAgreeParams.wrappedKey + i, 
+					 keyAgreeParams.wrappedKeyLen - i );
+			keyAgreeParams.wrappedKeyLen -= i;
+			}
+		}
+	else
 	if( cryptStatusOK( status ) && handshakeInfo->isECDH )
 		{
 		const int xCoordLen = ( keyAgreeParams.wrappedKeyLen - 1 ) / 2;
@@ -1196,6 +1842,11 @@ int completeKeyex( INOUT SESSION_INFO *sessionInfoPtr,
 	if( cryptStatusError( status ) )
 		return( status );
 
+	/* Ed25519 signs the exchange hash directly rather than a hash of it, so
+	   the hash value in the exchange hash context is what gets signed */
+	if( handshakeInfo->pubkeyAlgo == CRYPT_ALGO_ED25519 )
+		return( CRYPT_OK );
+
 	/* At this point we continue the hash-algorithm dance, in most cases 
 	   switching back to SHA-1 if we've been using a different algorithm for 
 	   the hashing so far.  This is required because while the exchange hash 
@@ -486,9 +486,19 @@ int readPacketHeaderSSH2( INOUT SESSION_INFO *sessionInfoPtr,
 	/* Decrypt the header if necessary */
 	if( sessionInfoPtr->flags & SESSION_ISSECURE_READ )
 		{
-		status = krnlSendMessage( sessionInfoPtr->iCryptInContext,
-								  IMESSAGE_CTX_DECRYPT, headerBufPtr,
-								  MIN_PACKET_SIZE );
+		if( isChaChaPolySSH( sessionInfoPtr ) )
+			{
+			status = decryptPacketHeaderChaChaSSH( sessionInfoPtr, 
+												   sshInfo->readSeqNo,
+												   headerBufPtr, 
+												   MIN_PACKET_SIZE );
+			}
+		else
+			{
+			status = krnlSendMessage( sessionInfoPtr->iCryptInContext,
+									  IMESSAGE_CTX_DECRYPT, headerBufPtr,
+									  MIN_PACKET_SIZE );
+			}
 		if( cryptStatusError( status ) )
 			return( status );
 		}
@@ -526,8 +536,14 @@ int readPacketHeaderSSH2( INOUT SESSION_INFO *sessionInfoPtr,
 				  ID_SIZE + PADLENGTH_SIZE + SSH2_MIN_PADLENGTH_SIZE,
 				  sessionInfoPtr->receiveBufSize - extraLength ) );
 		}
+
+	/* Make sure that the packet is a multiple of the cipher block size 
+	   long.  chacha20-poly1305 encrypts the length separately from the 
+	   rest of the packet so it's excluded from the padding */
 	if( ( sessionInfoPtr->flags & SESSION_ISSECURE_READ ) && \
-		( LENGTH_SIZE + length ) % sessionInfoPtr->cryptBlocksize != 0 )
+		( isChaChaPolySSH( sessionInfoPtr ) ? length : \
+											  LENGTH_SIZE + length ) % \
+			sessionInfoPtr->cryptBlocksize != 0 )
 		{
 		sMemDisconnect( &stream );
 		retExt( CRYPT_ERROR_BADDATA,
@@ -705,12 +721,23 @@ static int readHSPacket( INOUT SESSION_INFO *sessionInfoPtr,
 					return( status );
 				}
 
-			/* MAC the decrypted payload */
-			status = checkMacSSH( sessionInfoPtr->iAuthInContext,
-								  sshInfo->readSeqNo,
-								  sessionInfoPtr->receiveBuffer, 
-								  length + extraLength, length, 
-								  extraLength );
+			/* MAC the decrypted payload, or for chacha20-poly1305 check 
+			   the tag on the encrypted payload */
+			if( isChaChaPolySSH( sessionInfoPtr ) )
+				{
+				status = checkPacketTagChaChaSSH( \
+								sessionInfoPtr->iCryptInContext,
+								sessionInfoPtr->receiveBuffer + length, 
+								extraLength );
+				}
+			else
+				{
+				status = checkMacSSH( sessionInfoPtr->iAuthInContext,
+									  sshInfo->readSeqNo,
+									  sessionInfoPtr->receiveBuffer, 
+									  length + extraLength, length, 
+									  extraLength );
+				}
 			if( cryptStatusError( status ) )
 				{
 				/* If we're expecting a service control packet after a change
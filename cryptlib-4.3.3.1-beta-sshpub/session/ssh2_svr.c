@@ -43,6 +43,13 @@ static int initPubkeyAlgo( INOUT SESSION_INFO *sessionInfoPtr,
 		{ NULL, 0, CRYPT_ALGO_NONE, CRYPT_ALGO_NONE }, 
 			{ NULL, 0, CRYPT_ALGO_NONE, CRYPT_ALGO_NONE }
 		};
+#ifdef USE_ED25519
+	static const ALGO_STRING_INFO FAR_DATA algoStringPubkeyEd25519Tbl[] = {
+		{ "ssh-ed25519", 11, CRYPT_ALGO_ED25519, CRYPT_ALGO_SHA2 },
+		{ NULL, 0, CRYPT_ALGO_NONE, CRYPT_ALGO_NONE }, 
+			{ NULL, 0, CRYPT_ALGO_NONE, CRYPT_ALGO_NONE }
+		};
+#endif /* USE_ED25519 */
 #ifdef USE_ECDSA
 	static const ALGO_STRING_INFO FAR_DATA algoStringPubkeyECDSATbl[] = {
 		{ "ecdsa-sha2-nistp256", 19, CRYPT_ALGO_ECDSA, CRYPT_ALGO_SHA2 },
@@ -90,6 +97,15 @@ static int initPubkeyAlgo( INOUT SESSION_INFO *sessionInfoPtr,
 			FAILSAFE_ARRAYSIZE( algoStringPubkeyDSATbl, ALGO_STRING_INFO );
 		return( CRYPT_OK );
 		}
+#ifdef USE_ED25519
+	if( handshakeInfo->pubkeyAlgo == CRYPT_ALGO_ED25519 )
+		{
+		handshakeInfo->algoStringPubkeyTbl = algoStringPubkeyEd25519Tbl;
+		handshakeInfo->algoStringPubkeyTblNoEntries = \
+			FAILSAFE_ARRAYSIZE( algoStringPubkeyEd25519Tbl, ALGO_STRING_INFO );
+		return( CRYPT_OK );
+		}
+#endif /* USE_ED25519 */
 #ifdef USE_ECDSA
 	ENSURES( handshakeInfo->pubkeyAlgo == CRYPT_ALGO_ECDSA );
 
@@ -481,6 +497,7 @@ static int beginServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 	sMemDisconnect( &stream );
 	if( cryptStatusError( status ) )
 		return( status );
+	recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_HELLOSENT );
 	ANALYSER_HINT( serverHelloPtr != NULL );
 	INJECT_FAULT( SESSION_CORRUPT_HANDSHAKE, SESSION_CORRUPT_HANDSHAKE_SSH_2 );
 
@@ -500,6 +517,7 @@ static int beginServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 		   need to hash the data sitting in the receive buffer) */
 		skipGuessedKeyex = TRUE;
 		}
+	recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_HELLORECEIVED );
 	REQUIRES( rangeCheck( 1, clientHelloLength, 
 						  sessionInfoPtr->receiveBufSize ) );
 	memmove( sessionInfoPtr->receiveBuffer + 1, 
@@ -547,7 +565,7 @@ static int beginServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 		}
 	else
 		{
-#ifdef USE_ECDH 
+#if defined( USE_ECDH ) || defined( USE_25519 )
 		/* A second possibility is when we're using ECDH rather than DH, for 
 		   which we have to use ECDH contexts and values */
 		if( handshakeInfo->isECDH )
@@ -559,7 +577,7 @@ static int beginServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 										 handshakeInfo->keyexAlgo );
 			}
 		else
-#endif /* USE_ECDH */
+#endif /* USE_ECDH || USE_25519 */
 			{
 			status = processDHE( sessionInfoPtr, handshakeInfo );
  			}
@@ -597,7 +615,10 @@ static int beginServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 						  ( handshakeInfo->isFixedDH || \
 						    handshakeInfo->isECDH ) ? \
 							SSH_MSG_KEXDH_INIT : SSH_MSG_KEX_DH_GEX_INIT,
-						  ID_SIZE + ( handshakeInfo->isECDH ? \
+						  ID_SIZE + \
+						  ( ( handshakeInfo->keyexAlgo == CRYPT_ALGO_25519 ) ? \
+							sizeofString32( X25519_KEYSIZE ) : \
+							handshakeInfo->isECDH ? \
 							sizeofString32( MIN_PKCSIZE_ECCPOINT ) : \
 							sizeofString32( MIN_PKCSIZE ) ) );
 	if( cryptStatusError( status ) )
@@ -614,6 +635,13 @@ static int beginServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 				  "Invalid %s phase 1 keyex value",
 				  handshakeInfo->isECDH ? "ECDH" : "DH" ) );
 		}
+	if( handshakeInfo->keyexAlgo == CRYPT_ALGO_25519 )
+		{
+		if( !isValid25519size( handshakeInfo->clientKeyexValueLength,
+							   LENGTH_SIZE ) )
+			status = CRYPT_ERROR_BADDATA;
+		}
+	else
 	if( handshakeInfo->isECDH )
 		{
 		if( !isValidECDHsize( handshakeInfo->clientKeyexValueLength,
@@ -628,9 +656,12 @@ static int beginServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 		}
 	if( cryptStatusError( status ) )
 		{
-		const int clientKeyexSize = handshakeInfo->isECDH ? \
-			extractECDHsize( handshakeInfo->clientKeyexValueLength, LENGTH_SIZE ) : \
-			extractDHsize( handshakeInfo->clientKeyexValueLength, LENGTH_SIZE );
+		const int clientKeyexSize = \
+			( handshakeInfo->keyexAlgo == CRYPT_ALGO_25519 ) ? \
+				handshakeInfo->clientKeyexValueLength - LENGTH_SIZE : \
+			handshakeInfo->isECDH ? \
+				extractECDHsize( handshakeInfo->clientKeyexValueLength, LENGTH_SIZE ) : \
+				extractDHsize( handshakeInfo->clientKeyexValueLength, LENGTH_SIZE );
 
 		retExt( CRYPT_ERROR_BADDATA,
 				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
@@ -764,6 +795,7 @@ static int exchangeServerKeys( INOUT SESSION_INFO *sessionInfoPtr,
 	status = completeKeyex( sessionInfoPtr, handshakeInfo, TRUE );
 	if( cryptStatusError( status ) )
 		return( status );
+	recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_KEYEXCHANGE );
 
 	/* Sign the hash.  The reason for the min() part of the expression is
 	   that iCryptCreateSignature() gets suspicious of very large buffer
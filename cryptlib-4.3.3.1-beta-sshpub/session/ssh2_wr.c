@@ -242,6 +242,8 @@ int wrapPacketSSH2( INOUT SESSION_INFO *sessionInfoPtr,
 	const int payloadLength = length - SSH2_HEADER_SIZE;
 	void *bufStartPtr;
 	const int extraLength = sessionInfoPtr->authBlocksize;
+	const int padOffset = isChaChaPolySSH( sessionInfoPtr ) ? \
+						  LENGTH_SIZE : 0;
 	int padLength, status;
 
 	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
@@ -257,7 +259,9 @@ int wrapPacketSSH2( INOUT SESSION_INFO *sessionInfoPtr,
 
 	/* Evaluate the number of padding bytes that we need to add to a packet
 	   to make it a multiple of the cipher block size long, with a minimum
-	   padding size of SSH2_MIN_PADLENGTH_SIZE bytes */
+	   padding size of SSH2_MIN_PADLENGTH_SIZE bytes.  chacha20-poly1305 
+	   excludes the length field from the padded data, so we pad relative 
+	   to padOffset rather than the start of the packet */
 	if( useQuantisedPadding )
 		{
 		int LOOP_ITERATOR;
@@ -268,17 +272,18 @@ int wrapPacketSSH2( INOUT SESSION_INFO *sessionInfoPtr,
 		   Note that we can't pad more than 255 bytes because the padding 
 		   schemes has a single-byte pad length value, so we use 128 */
 		LOOP_MED( padLength = 128,
-				  ( length + SSH2_MIN_PADLENGTH_SIZE ) > padLength,
+				  ( length - padOffset + SSH2_MIN_PADLENGTH_SIZE ) > padLength,
 				  padLength += 128 );
 		ENSURES( LOOP_BOUND_OK );
-		padLength -= length;
+		padLength -= length - padOffset;
 		}
 	else
 		{
-		const int paddedLength = getPaddedSize( length + SSH2_MIN_PADLENGTH_SIZE );
+		const int paddedLength = \
+				getPaddedSize( length - padOffset + SSH2_MIN_PADLENGTH_SIZE );
 		
 		ENSURES( paddedLength >= 16 && paddedLength <= MAX_BUFFER_SIZE ); 
-		padLength = paddedLength - length;
+		padLength = paddedLength - ( length - padOffset );
 		}
 	ENSURES( padLength >= SSH2_MIN_PADLENGTH_SIZE && padLength < 256 );
 	length += padLength;
@@ -325,6 +330,22 @@ int wrapPacketSSH2( INOUT SESSION_INFO *sessionInfoPtr,
 		status = sSkip( stream, padLength, MAX_INTLENGTH_SHORT );
 	ENSURES( cryptStatusOK( status ) );
 
+	/* If we're using chacha20-poly1305 then the encryption and MAC'ing are 
+	   combined, with the tag appended to the encrypted data */
+	if( isChaChaPolySSH( sessionInfoPtr ) )
+		{
+		status = encryptPacketChaChaSSH( sessionInfoPtr, sshInfo->writeSeqNo,
+										 bufStartPtr, length + extraLength,
+										 length );
+		if( cryptStatusError( status ) )
+			return( status );
+		status = sSkip( stream, extraLength, MAX_INTLENGTH_SHORT );
+		ENSURES( cryptStatusOK( status ) );
+		sshInfo->writeSeqNo++;
+
+		return( CRYPT_OK );
+		}
+
 	/* MAC the data and append the MAC to the stream.  We skip the length 
 	   value at the start since this is computed by the MAC'ing code */
 	status = createMacSSH( sessionInfoPtr->iAuthOutContext,
@@ -7,12 +7,14 @@
 
 #if defined( INC_ALL )
   #include "crypt.h"
+  #include "certcache.h"
   #include "misc_rw.h"
   #include "session.h"
   #include "ssl.h"
 #else
   #include "crypt.h"
   #include "enc_dec/misc_rw.h"
+  #include "session/certcache.h"
   #include "session/session.h"
   #include "session/ssl.h"
 #endif /* Compiler-specific includes */
@@ -238,7 +240,8 @@ CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
 int readEcdhValue( INOUT STREAM *stream,
 				   OUT_BUFFER( valueMaxLen, *valueLen ) void *value,
 				   IN_LENGTH_SHORT_MIN( 64 ) const int valueMaxLen,
-				   OUT_LENGTH_BOUNDED_Z( valueMaxLen ) int *valueLen )
+				   OUT_LENGTH_BOUNDED_Z( valueMaxLen ) int *valueLen,
+				   const BOOLEAN isX25519 )
 	{
 	int length, status;
 
@@ -247,16 +250,26 @@ int readEcdhValue( INOUT STREAM *stream,
 	assert( isWritePtr( valueLen, sizeof( int ) ) );
 
 	REQUIRES( valueMaxLen >= 64 && valueMaxLen < MAX_INTLENGTH_SHORT );
+	REQUIRES( isX25519 == TRUE || isX25519 == FALSE );
 
 	/* Clear return value */
 	memset( value, 0, min( 16, valueMaxLen ) );
 	*valueLen = 0;
 
 
-	/* Get the length (as a byte) and make sure that it's valid */
+	/* Get the length (as a byte) and make sure that it's valid.  X25519 
+	   values are a fixed-length u-coordinate rather than an X9.62 point */
 	status = length = sgetc( stream );
 	if( cryptStatusError( status ) )
 		return( status );
+	if( isX25519 )
+		{
+		if( length != X25519_KEYSIZE )
+			return( CRYPT_ERROR_BADDATA );
+		*valueLen = length;
+
+		return( sread( stream, value, length ) );
+		}
 	if( isShortECCKey( length / 2 ) )
 		return( CRYPT_ERROR_NOSECURE );
 	if( length < MIN_PKCSIZE_ECCPOINT || length > MAX_PKCSIZE_ECCPOINT )
@@ -395,6 +408,43 @@ int sslSuiteBTestConfig( const int magicValue )
 *																			*
 ****************************************************************************/
 
+/* Lock a peer's certificate chain with the leaf certificate selected, and 
+   unlock it again.  Since the chain may be shared with other sessions via 
+   the certificate chain cache, anything that depends on the currently-
+   selected certificate or the attribute cursor has to be done with the 
+   chain locked, which saves the selection state when the chain is locked 
+   and restores it when it's unlocked */
+
+CHECK_RETVAL \
+int lockCertChainLeaf( IN_HANDLE const CRYPT_CERTIFICATE iCertChain )
+	{
+	int status;
+
+	REQUIRES( isHandleRangeValid( iCertChain ) );
+
+	status = krnlSendMessage( iCertChain, IMESSAGE_SETATTRIBUTE,
+							  MESSAGE_VALUE_TRUE, CRYPT_IATTRIBUTE_LOCKED );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Select the leaf certificate.  If the peer only sent a single 
+	   certificate then there's no chain to select from, so we don't treat 
+	   a failure to move the cursor as an error */
+	( void ) krnlSendMessage( iCertChain, IMESSAGE_SETATTRIBUTE,
+							  MESSAGE_VALUE_CURSORFIRST,
+							  CRYPT_CERTINFO_CURRENT_CERTIFICATE );
+
+	return( CRYPT_OK );
+	}
+
+void unlockCertChain( IN_HANDLE const CRYPT_CERTIFICATE iCertChain )
+	{
+	REQUIRES_V( isHandleRangeValid( iCertChain ) );
+
+	( void ) krnlSendMessage( iCertChain, IMESSAGE_SETATTRIBUTE,
+							  MESSAGE_VALUE_FALSE, CRYPT_IATTRIBUTE_LOCKED );
+	}
+
 /* Read/write an SSL/TLS certificate chain:
 
 	byte		ID = SSL_HAND_CERTIFICATE
@@ -422,6 +472,8 @@ int readSSLCertChain( INOUT SESSION_INFO *sessionInfoPtr,
 #ifdef CONFIG_SUITEB
 	const char *requiredLengthString = NULL;
 #endif /* CONFIG_SUITEB */
+	BOOLEAN isCachedChain = FALSE;
+	void *chainDataPtr;
 	int certAlgo, certFingerprintLength, chainLength, length, status;
 
 	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
@@ -479,13 +531,37 @@ int readSSLCertChain( INOUT SESSION_INFO *sessionInfoPtr,
 				  chainLength, length - LENGTH_SIZE ) );
 		}
 
-	/* Import the certificate chain.  This isn't a true certificate chain (in 
-	   the sense of being degenerate PKCS #7 SignedData) but a special-case 
-	   SSL/TLS-encoded certificate chain */
-	status = importCertFromStream( stream, &iLocalCertChain, 
-								   DEFAULTUSER_OBJECT_HANDLE,
-								   CRYPT_ICERTTYPE_SSL_CERTCHAIN,
-								   chainLength, KEYMGMT_FLAG_NONE );
+	/* If we've seen this exact certificate chain before, use the 
+	   previously-imported copy rather than importing it again */
+	status = sMemGetDataBlock( stream, &chainDataPtr, chainLength );
+	if( cryptStatusError( status ) )
+		{
+		retExt( CRYPT_ERROR_BADDATA,
+				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
+				  "Invalid certificate chain data" ) );
+		}
+	status = getCachedCertChain( &iLocalCertChain, chainDataPtr, 
+								 chainLength );
+	if( cryptStatusOK( status ) )
+		{
+		isCachedChain = TRUE;
+		status = sSkip( stream, chainLength, MAX_INTLENGTH_SHORT );
+		if( cryptStatusError( status ) )
+			{
+			krnlSendNotifier( iLocalCertChain, IMESSAGE_DECREFCOUNT );
+			return( status );
+			}
+		}
+	else
+		{
+		/* Import the certificate chain.  This isn't a true certificate 
+		   chain (in the sense of being degenerate PKCS #7 SignedData) but 
+		   a special-case SSL/TLS-encoded certificate chain */
+		status = importCertFromStream( stream, &iLocalCertChain, 
+									   DEFAULTUSER_OBJECT_HANDLE,
+									   CRYPT_ICERTTYPE_SSL_CERTCHAIN,
+									   chainLength, KEYMGMT_FLAG_NONE );
+		}
 	if( cryptStatusError( status ) )
 		{
 		/* There are sufficient numbers of broken certificates around that 
@@ -507,6 +583,12 @@ int readSSLCertChain( INOUT SESSION_INFO *sessionInfoPtr,
 	/* Get information on the chain */
 	status = krnlSendMessage( iLocalCertChain, IMESSAGE_GETATTRIBUTE,
 							  &certAlgo, CRYPT_CTXINFO_ALGO );
+	if( cryptStatusError( status ) )
+		{
+		krnlSendNotifier( iLocalCertChain, IMESSAGE_DECREFCOUNT );
+		return( status );
+		}
+	status = lockCertChainLeaf( iLocalCertChain );
 	if( cryptStatusError( status ) )
 		{
 		krnlSendNotifier( iLocalCertChain, IMESSAGE_DECREFCOUNT );
@@ -532,6 +614,7 @@ int readSSLCertChain( INOUT SESSION_INFO *sessionInfoPtr,
 		status = krnlSendMessage( iLocalCertChain, IMESSAGE_GETATTRIBUTE_S,
 								  &msgData, CRYPT_CERTINFO_FINGERPRINT_SHA1 );
 		}
+	unlockCertChain( iLocalCertChain );
 	if( cryptStatusError( status ) )
 		{
 		krnlSendNotifier( iLocalCertChain, IMESSAGE_DECREFCOUNT );
@@ -641,6 +724,15 @@ int readSSLCertChain( INOUT SESSION_INFO *sessionInfoPtr,
 		}
 #endif /* CONFIG_SUITEB */
 
+	/* Remember the newly-imported chain so that we don't have to import it
+	   again the next time that it's used.  As with the fingerprint, this 
+	   isn't worth aborting the handshake for if it fails */
+	if( !isCachedChain )
+		{
+		( void ) addCachedCertChain( iLocalCertChain, chainDataPtr, 
+									 chainLength );
+		}
+
 	*iCertChain = iLocalCertChain;
 
 	return( CRYPT_OK );
@@ -757,6 +849,13 @@ static int commonStartup( INOUT SESSION_INFO *sessionInfoPtr,
 				  "aren't available in this build of cryptlib" ) );
 		}
 
+#ifdef USE_TLS13
+	/* If the user has asked for TLS 1.3 as the minimum version then 
+	   there's no point in offering anything lower */
+	if( sessionInfoPtr->sessionSSL->minVersion >= SSL_MINOR_VERSION_TLS13 )
+		sessionInfoPtr->version = SSL_MINOR_VERSION_TLS13;
+#endif /* USE_TLS13 */
+
 	/* Begin the handshake, unless we're continuing a partially-opened 
 	   session */
 	if( !( sessionInfoPtr->flags & SESSION_PARTIALOPEN ) )
@@ -1159,6 +1258,50 @@ static int processBodyFunction( INOUT SESSION_INFO *sessionInfoPtr,
 		return( OK_SPECIAL );
 		}
 
+#ifdef USE_TLS13
+	/* TLS 1.3 hides the actual packet type inside the encrypted payload, 
+	   so we don't know what we've got until we've decrypted it.  Alongside 
+	   the application data the other side can send us post-handshake 
+	   messages like session tickets and key updates, which we process and 
+	   then treat as a no-op in the same way as for a rehandshake above */
+	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS13 )
+		{
+		BYTE *dataPtr = sessionInfoPtr->receiveBuffer + \
+						sessionInfoPtr->receiveBufPos;
+		int packetType;
+
+		status = unwrapPacketTLS13( sessionInfoPtr, dataPtr, 
+									sessionInfoPtr->pendingPacketLength, 
+									&length, &packetType );
+		if( cryptStatusError( status ) )
+			return( status );
+		switch( packetType )
+			{
+			case SSL_MSG_APPLICATION_DATA:
+				*readInfo = READINFO_NONE;
+				return( length );
+
+			case SSL_MSG_HANDSHAKE:
+				status = processPostHandshakeTLS13( sessionInfoPtr, 
+													dataPtr, length );
+				if( cryptStatusError( status ) )
+					return( status );
+				sessionInfoPtr->receiveBufEnd = sessionInfoPtr->receiveBufPos;
+				sessionInfoPtr->pendingPacketLength = 0;
+				*readInfo = READINFO_NOOP;
+				return( OK_SPECIAL );
+
+			case SSL_MSG_ALERT:
+				return( processAlertPayload( sessionInfoPtr, dataPtr, 
+											 length ) );
+			}
+		retExt( CRYPT_ERROR_BADDATA,
+				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
+				  "Unexpected %s (%d) packet, expected application data",
+				  getSSLPacketName( packetType ), packetType ) );
+		}
+#endif /* USE_TLS13 */
+
 	/* Unwrap the payload */
 	status = unwrapPacketSSL( sessionInfoPtr, 
 							  sessionInfoPtr->receiveBuffer + \
@@ -1247,8 +1390,12 @@ int setAccessMethodSSL( INOUT SESSION_INFO *sessionInfoPtr )
 			   certificates and the like, so we require some sort of 
 			   server-side key set in advance */
 		SSL_MINOR_VERSION_TLS11,	/* TLS 1.1 */
-#ifdef USE_SSL3
+#if defined( USE_SSL3 ) && defined( USE_TLS13 )
+			SSL_MINOR_VERSION_SSL, SSL_MINOR_VERSION_TLS13,
+#elif defined( USE_SSL3 )
 			SSL_MINOR_VERSION_SSL, SSL_MINOR_VERSION_TLS12,
+#elif defined( USE_TLS13 )
+			SSL_MINOR_VERSION_TLS, SSL_MINOR_VERSION_TLS13,
 #else
 			SSL_MINOR_VERSION_TLS, SSL_MINOR_VERSION_TLS12,
 #endif /* USE_SSL3 */
@@ -41,10 +41,15 @@
 #define GCMICV_SIZE					16	/* Size of GCM ICV */
 #define GCM_SALT_SIZE				4	/* Size of implicit portion of GCM IV */
 #define GCM_IV_SIZE					12	/* Overall size of GCM IV */
+#define CHACHA20_SALT_SIZE			12	/* Size of implicit ChaCha20 nonce */
+#define POLY1305ICV_SIZE			16	/* Size of Poly1305 ICV */
 #define TLS_HASHEDMAC_SIZE			12	/* Size of TLS PRF( MD5 + SHA1 ) */
 #define SESSIONID_SIZE				16	/* Size of session ID */
 #define MIN_SESSIONID_SIZE			4	/* Min.allowed session ID size */
 #define MAX_SESSIONID_SIZE			32	/* Max.allowed session ID size */
+#define SSL_TICKET_SIZE				160	/* Size of session ticket */
+#define SSL_TICKET_LIFETIME			3600	/* Session ticket lifetime */
+#define TLS13_SECRET_SIZE			32	/* Size of TLS 1.3 secrets/hashes */
 #define MAX_KEYBLOCK_SIZE			( ( 64 + 32 + 16 ) * 2 )
 										/* HMAC-SHA2 + AES-256 key + AES IV */
 #define MIN_PACKET_SIZE				4	/* Minimum SSL packet size */
@@ -112,6 +117,11 @@
 	FLAG_ENCTHENMAC: Use encrypt-then-MAC rather than the standard 
 		MAC-then-encrypt.
 
+	FLAG_CHACHA20: The encryption used is ChaCha20-Poly1305, which like 
+		GCM unifies encryption and MACing into a single operation.  In
+		addition the nonce is entirely implicit, being derived from the
+		master secret and the sequence number.
+
 	FLAG_GCM: The encryption used is GCM and not the usual CBC, which 
 		unifies encryption and MACing into a single operation.
 	
@@ -123,7 +133,13 @@
 	FLAG_SUITEB_256: 1.2 + ECC + AES-GCM ones.  _128 = P256 + P384, 
 		_256 = P384 only.
 
-	FLAG_TLS12LTS: TLS 1.2 LTS session with enhanced crypto protection */
+	FLAG_TLS12LTS: TLS 1.2 LTS session with enhanced crypto protection.
+
+	FLAG_TLS13: The session is using TLS 1.3, which has a completely 
+		different handshake and key schedule and hides the actual record 
+		type inside the encrypted payload.  Since the version number that's 
+		sent on the wire is always TLS 1.2 we can't use the session version 
+		to identify the use of TLS 1.3 in the record-layer code */
 
 #define SSL_PFLAG_NONE				0x0000	/* No protocol-specific flags */
 #define SSL_PFLAG_ALERTSENT			0x0001	/* Close alert sent */
@@ -138,7 +154,9 @@
 #define SSL_PFLAG_ENCTHENMAC		0x0200	/* Use encrypt-then-MAC */
 #define SSL_PFLAG_EMS				0x0400	/* Use extended Master Secret */
 #define SSL_PFLAG_TLS12LTS			0x0800	/* Use TLS 1.2 LTS profile */
-#define SSL_PFLAG_MAX				0x0FFF	/* Maximum possible flag value */
+#define SSL_PFLAG_CHACHA20			0x1000	/* Encryption uses ChaCha20-Poly1305 */
+#define SSL_PFLAG_TLS13				0x2000	/* Session uses TLS 1.3 */
+#define SSL_PFLAG_MAX				0x3FFF	/* Maximum possible flag value */
 
 /* Some of the flags above denote extended TLS facilities that need to be
    preserved across session resumptions.  The following value defines the 
@@ -160,6 +178,12 @@
 #define SSL_PFLAG_SUITEB			( SSL_PFLAG_SUITEB_128 | \
 									  SSL_PFLAG_SUITEB_256 )
 
+/* GCM and ChaCha20-Poly1305 are both AEAD modes that combine encryption and 
+   MACing, in order to identify generic use of an AEAD mode we provide a
+   pseudo-value that combines the two */
+
+#define SSL_PFLAG_AEAD				( SSL_PFLAG_GCM | SSL_PFLAG_CHACHA20 )
+
 /* The SSL minimmum version number is encoded as a CRYPT_SSLOPTION_MINVER_xxx
    value, the following mask allows the version to be extracted from the SSL
    option value */
@@ -198,6 +222,9 @@
 
 #define SSL_HAND_CLIENT_HELLO		1
 #define SSL_HAND_SERVER_HELLO		2
+#define SSL_HAND_NEWSESSIONTICKET	4
+#define SSL_HAND_ENDOFEARLYDATA		5
+#define SSL_HAND_ENCRYPTED_EXTENSIONS 8
 #define SSL_HAND_CERTIFICATE		11
 #define SSL_HAND_SERVER_KEYEXCHANGE	12
 #define SSL_HAND_SERVER_CERTREQUEST	13
@@ -205,10 +232,19 @@
 #define SSL_HAND_CLIENT_CERTVERIFY	15
 #define SSL_HAND_CLIENT_KEYEXCHANGE	16
 #define SSL_HAND_FINISHED			20
+#define SSL_HAND_CERTIFICATE_STATUS	22
 #define SSL_HAND_SUPPLEMENTAL_DATA	23
+#define SSL_HAND_KEYUPDATE			24
 
 #define SSL_HAND_FIRST				SSL_HAND_CLIENT_HELLO
-#define SSL_HAND_LAST				SSL_HAND_SUPPLEMENTAL_DATA
+#define SSL_HAND_LAST				SSL_HAND_KEYUPDATE
+
+/* TLS 1.3 replaces the hash of the first client hello with a synthetic 
+   message_hash handshake message when a HelloRetryRequest is sent, this 
+   is never sent over the wire so we keep it out of the range of valid 
+   handshake message types */
+
+#define SSL_HAND_MESSAGE_HASH		254
 
 /* SSL and TLS alert levels and types */
 
@@ -240,15 +276,17 @@
 #define TLS_ALERT_INAPPROPRIATE_FALLBACK	86
 #define TLS_ALERT_USER_CANCELLED			90
 #define TLS_ALERT_NO_RENEGOTIATION			100
+#define TLS_ALERT_MISSING_EXTENSION			109
 #define TLS_ALERT_UNSUPPORTED_EXTENSION		110
 #define TLS_ALERT_CERTIFICATE_UNOBTAINABLE	111
 #define TLS_ALERT_UNRECOGNIZED_NAME			112
 #define TLS_ALERT_BAD_CERTIFICATE_STATUS_RESPONSE 113
 #define TLS_ALERT_BAD_CERTIFICATE_HASH_VALUE 114
 #define TLS_ALERT_UNKNOWN_PSK_IDENTITY		115
+#define TLS_ALERT_CERTIFICATE_REQUIRED		116
 
 #define SSL_ALERT_FIRST						SSL_ALERT_CLOSE_NOTIFY
-#define SSL_ALERT_LAST						TLS_ALERT_UNKNOWN_PSK_IDENTITY
+#define SSL_ALERT_LAST						TLS_ALERT_CERTIFICATE_REQUIRED
 
 /* TLS supplemental data subtypes */
 
@@ -376,6 +414,12 @@ typedef enum {
 	/* TLS secure-rengotiation signalling cipher suite, RFC 5746 */
 	TLS_EMPTY_RENEGOTIATION_INFO_SCSV = 255,
 
+	/* TLS 1.3 (RFC 8446) cipher suites, which only specify the AEAD cipher
+	   and hash algorithm since the keyex and authentication are negotiated
+	   separately, starting at 4865/0x1301 */
+	TLS_AES_128_GCM_SHA256 = 4865, TLS_AES_256_GCM_SHA384, 
+	TLS_CHACHA20_POLY1305_SHA256,
+
 	/* TLS fallback signalling cpiher suite, RFC 7507, stuffed into a gap in 
 	   the range starting at 22016/0x5600 */
 	TLS_FALLBACK_SCSV = 22016,
@@ -426,6 +470,16 @@ typedef enum {
     TLS_ECDHE_PSK_WITH_NULL_SHA, TLS_ECDHE_PSK_WITH_NULL_SHA256,
     TLS_ECDHE_PSK_WITH_NULL_SHA384,
 
+	/* TLS ChaCha20-Poly1305 (RFC 7905) cipher suites, in yet another range
+	   at 52392/0xCCA8...52398 */
+	TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256 = 52392,
+	TLS_ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256,
+	TLS_DHE_RSA_WITH_CHACHA20_POLY1305_SHA256,
+	TLS_PSK_WITH_CHACHA20_POLY1305_SHA256,
+	TLS_ECDHE_PSK_WITH_CHACHA20_POLY1305_SHA256,
+	TLS_DHE_PSK_WITH_CHACHA20_POLY1305_SHA256,
+	TLS_RSA_PSK_WITH_CHACHA20_POLY1305_SHA256,
+
 	/* Endless vanity suites, Aria, Camellia, etc */
 
 	SSL_LAST_SUITE
@@ -463,7 +517,16 @@ typedef enum {
 	TLS_EXT_CACHED_INFO,		/* 25: Draft, cached info */
 		/* 26...34 unused */
 	TLS_EXT_SESSIONTICKET = 35,	/* RFC 4507 session ticket support */
-		/* 36....65280 unused */
+		/* 36...40 unused */
+	TLS_EXT_PRE_SHARED_KEY = 41,/* 41: TLS 1.3 PSK identities */
+	TLS_EXT_EARLY_DATA,			/* 42: TLS 1.3 0-RTT data */
+	TLS_EXT_SUPPORTED_VERSIONS,	/* 43: TLS 1.3 version negotiation */
+	TLS_EXT_COOKIE,				/* 44: TLS 1.3 HelloRetryRequest cookie */
+	TLS_EXT_PSK_KEX_MODES,		/* 45: TLS 1.3 PSK keyex modes */
+		/* 46...49 unused */
+	TLS_EXT_SIGALGS_CERT = 50,	/* 50: TLS 1.3 certificate sig.algos */
+	TLS_EXT_KEY_SHARE,			/* 51: TLS 1.3 keyex values */
+		/* 52....65280 unused */
 	TLS_EXT_LAST,
 
 	/* Temporary value for TLS-LTS */
@@ -476,6 +539,12 @@ typedef enum {
 	TLS_EXT_SECURE_RENEG = 65281,/* RFC 5746 secure renegotiation */
 	} TLS_EXT_TYPE;
 
+/* TLS certificate status request types, RFC 6066 */
+
+typedef enum {
+	TLS_STATUSTYPE_NONE, TLS_STATUSTYPE_OCSP, TLS_STATUSTYPE_LAST
+	} TLS_STATUSTYPE_TYPE;
+
 /* SSL/TLS certificate types */
 
 typedef enum {
@@ -515,6 +584,7 @@ typedef enum {
 	TLS_CURVE_BRAINPOOLP256R1 /* Brainpool P256 */, 
 	TLS_CURVE_BRAINPOOLP384R1 /* Brainpool P384 */, 
 	TLS_CURVE_BRAINPOOLP512R1 /* Brainpool P512 */, 
+	TLS_CURVE_X25519 /* Curve25519 */, 
 	TLS_CURVE_LAST
 	} TLS_CURVE_TYPE;
 
@@ -525,6 +595,7 @@ typedef enum {
 #define SSL_MINOR_VERSION_TLS	1
 #define SSL_MINOR_VERSION_TLS11	2
 #define SSL_MINOR_VERSION_TLS12	3
+#define SSL_MINOR_VERSION_TLS13	4
 
 /* SSL sender label values for the finished message MAC */
 
@@ -532,6 +603,19 @@ typedef enum {
 #define SSL_SENDER_SERVERLABEL	"SRVR"
 #define SSL_SENDERLABEL_SIZE	4
 
+/* TLS 1.3 special-case nonce values.  A HelloRetryRequest is a server hello
+   with the nonce set to SHA-256( "HelloRetryRequest" ), and a TLS 1.3 
+   server that negotiates an earlier version sets the last 8 bytes of its 
+   nonce to a downgrade sentinel value, "DOWNGRD" followed by 0x01 for 
+   TLS 1.2 or 0x00 for earlier versions */
+
+#define TLS13_HRR_NONCE			"\xCF\x21\xAD\x74\xE5\x9A\x61\x11" \
+								"\xBE\x1D\x8C\x02\x1E\x65\xB8\x91" \
+								"\xC2\xA2\x11\x16\x7A\xBB\x8C\x5E" \
+								"\x07\x9E\x09\xE2\xC8\xA8\x33\x9C"
+#define TLS13_DOWNGRADE_SENTINEL	"DOWNGRD\x01"
+#define TLS13_DOWNGRADE_SENTINEL_SIZE	8
+
 /* SSL/TLS cipher suite flags.  These are:
 
 	CIPHERSUITE_PSK: Suite is a TLS-PSK suite and is used only if we're
@@ -542,10 +626,17 @@ typedef enum {
 	CIPHERSUITE_ECC: Suite is an ECC suite and is used only if ECC is
 		enabled.
 
+	CIPHERSUITE_CHACHA20: Encryption uses ChaCha20-Poly1305 instead of the 
+		usual CBC.
+
 	CIPHERSUITE_GCM: Encryption uses GCM instead of the usual CBC.
 
 	CIPHERSUITE_TLS12: Suite is a TLS 1.2 suite and is only sent if
-		TLS 1.2 is enabled */
+		TLS 1.2 is enabled.
+
+	CIPHERSUITE_TLS13: Suite is a TLS 1.3 suite and is only sent if 
+		TLS 1.3 is enabled.  These suites only specify the AEAD cipher and 
+		hash, and can't be used with any earlier protocol version */
 
 #define CIPHERSUITE_FLAG_NONE	0x00	/* No suite */
 #define CIPHERSUITE_FLAG_PSK	0x01	/* TLS-PSK suite */
@@ -553,7 +644,9 @@ typedef enum {
 #define CIPHERSUITE_FLAG_ECC	0x04	/* ECC suite */
 #define CIPHERSUITE_FLAG_TLS12	0x08	/* TLS 1.2 suite */
 #define CIPHERSUITE_FLAG_GCM	0x10	/* GCM instead of CBC */
-#define CIPHERSUITE_FLAG_MAX	0x1F	/* Maximum possible flag value */
+#define CIPHERSUITE_FLAG_CHACHA20 0x20	/* ChaCha20-Poly1305 instead of CBC */
+#define CIPHERSUITE_FLAG_TLS13	0x40	/* TLS 1.3 suite */
+#define CIPHERSUITE_FLAG_MAX	0x7F	/* Maximum possible flag value */
 
 typedef struct {
 	/* The SSL/TLS cipher suite */
@@ -663,6 +756,16 @@ typedef struct SL {
 	BYTE hashedSNI[ KEYID_SIZE + 8 ];
 	BOOLEAN hashedSNIpresent;
 
+	/* Session ticket sent by the client, RFC 5077.  Tickets that aren't 
+	   the size of the ones that we issue can't be ours so we only record 
+	   the fact that one was present */
+#ifdef USE_SSL_TICKETS
+	BUFFER( SSL_TICKET_SIZE, sessionTicketLength ) \
+	BYTE sessionTicket[ SSL_TICKET_SIZE + 8 ];
+	int sessionTicketLength;
+	BOOLEAN sessionTicketPresent;
+#endif /* USE_SSL_TICKETS */
+
 	/* Client/server hello hash, the hash of the Client Hello and Server 
 	   Hello, and session hash, the hash of all messages from Client Hello 
 	   to Client Keyex */
@@ -706,6 +809,8 @@ typedef struct SL {
 	BOOLEAN needEncThenMACResponse;/* Server needs to respond to encThenMAC */
 	BOOLEAN needEMSResponse;	/* Server needs to respond to EMS */
 	BOOLEAN needTLS12LTSResponse;/* Server needs to respond to TLS-LTS */
+	BOOLEAN needSessionTicketResponse;/* Server needs to issue a ticket */
+	BOOLEAN needStatusResponse;	/* Server needs to staple OCSP resp.*/
 	int failAlertType;			/* Alert type to send on failure */
 
 	/* ECC-related information.  Since ECC algorithms have a huge pile of
@@ -721,12 +826,59 @@ typedef struct SL {
 	   
 	   If the use of ECC isn't retroactively disabled then the eccCurveID 
 	   and sendECCPointExtn values indicate which curve to use and whether 
-	   the server needs to respond with a point-extension indicator */
+	   the server needs to respond with a point-extension indicator.  Since
+	   the keyex curve is independent of the signing curve, useX25519 
+	   indicates that the ECDH keyex is performed with X25519 rather than
+	   the eccCurveID curve */
 	BOOLEAN disableECC;			/* Extn.disabled use of ECC suites */
 	CRYPT_ECCCURVE_TYPE eccCurveID;	/* cryptlib ID of ECC curve to use */
+	BOOLEAN useX25519;			/* Use X25519 for the ECDH keyex */
 	BOOLEAN sendECCPointExtn;	/* Whether svr.has to respond with ECC point ext.*/
 	const void *eccSuiteInfoPtr;	/* ECC suite information */
 
+	/* TLS 1.3 information.  Since the TLS 1.3 suites can only be used if 
+	   the peer also indicates TLS 1.3 support via the supported_versions 
+	   extension, which isn't known until after the cipher suites have been 
+	   processed, we remember the preferred TLS 1.3 suite in 
+	   'tls13SuiteInfoPtr' in the same way as for ECC suites and switch to 
+	   it once the extensions have been processed.  The peer's X25519 key 
+	   share, the HelloRetryRequest cookie, and the PSK identity are 
+	   recorded from the extensions for later use in the handshake, and the 
+	   handshake secret and handshake traffic secrets are derived from the 
+	   ECDHE value via the TLS 1.3 key schedule once the hellos have been 
+	   exchanged */
+#ifdef USE_TLS13
+	const void *tls13SuiteInfoPtr;	/* TLS 1.3 suite information */
+	BOOLEAN tls13VersionSeen;	/* Peer indicated TLS 1.3 support */
+	BOOLEAN tls13Retry;			/* HelloRetryRequest sent/received */
+	BUFFER( 32, tls13KeyShareLength ) \
+	BYTE tls13KeyShare[ 32 + 8 ];	/* Peer's X25519 key share */
+	int tls13KeyShareLength;
+	BUFFER_FIXED( 32 ) \
+	BYTE tls13LocalKeyShare[ 32 + 8 ];	/* Our X25519 key share */
+	BOOLEAN tls13KeyShareSent;	/* Client hello contained our key share */
+	BUFFER( 512, tls13CookieLength ) \
+	BYTE tls13Cookie[ 512 + 8 ];	/* HelloRetryRequest cookie */
+	int tls13CookieLength;
+	BOOLEAN tls13PskModeOK;		/* Peer allows PSK with (EC)DHE */
+	BOOLEAN tls13PskAccepted;	/* PSK was accepted by the peer */
+	BUFFER( 512, tls13PskIdentityLength ) \
+	BYTE tls13PskIdentity[ 512 + 8 ];	/* PSK identity/ticket */
+	int tls13PskIdentityLength;
+	long tls13PskObfuscatedAge;	/* Obfuscated ticket age */
+	BUFFER_FIXED( 32 ) \
+	BYTE tls13Psk[ 32 + 8 ];	/* PSK for resumed session */
+	int tls13BinderOffset;		/* Offset of PSK binders in client hello */
+	BUFFER_FIXED( 32 ) \
+	BYTE tls13Secret[ 32 + 8 ];	/* Early/handshake/master secret */
+	BUFFER_FIXED( 32 ) \
+	BYTE tls13ClientHSSecret[ 32 + 8 ];	/* Client handshake traffic secret */
+	BUFFER_FIXED( 32 ) \
+	BYTE tls13ServerHSSecret[ 32 + 8 ];	/* Server handshake traffic secret */
+	BUFFER_FIXED( 32 ) \
+	BYTE tls13ClientAppSecret[ 32 + 8 ];	/* Client app.traffic secret */
+#endif /* USE_TLS13 */
+
 	/* The packet data stream.  Since SSL can encapsulate multiple handshake
 	   packets within a single SSL packet, the stream has to be persistent
 	   across the different handshake functions to allow the continuation of
@@ -755,7 +907,11 @@ CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
 int readEcdhValue( INOUT STREAM *stream,
 				   OUT_BUFFER( valueMaxLen, *valueLen ) void *value,
 				   IN_LENGTH_SHORT_MIN( 64 ) const int valueMaxLen,
-				   OUT_LENGTH_BOUNDED_Z( valueMaxLen ) int *valueLen );
+				   OUT_LENGTH_BOUNDED_Z( valueMaxLen ) int *valueLen,
+				   const BOOLEAN isX25519 );
+CHECK_RETVAL \
+int lockCertChainLeaf( IN_HANDLE const CRYPT_CERTIFICATE iCertChain );
+void unlockCertChain( IN_HANDLE const CRYPT_CERTIFICATE iCertChain );
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3, 4 ) ) \
 int readSSLCertChain( INOUT SESSION_INFO *sessionInfoPtr, 
 					  INOUT SSL_HANDSHAKE_INFO *handshakeInfo, 
@@ -766,6 +922,15 @@ CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
 int writeSSLCertChain( INOUT SESSION_INFO *sessionInfoPtr, 
 					   INOUT STREAM *stream );
 
+/* Prototypes for functions in ssl_cli.c */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int checkCertificateInfo( INOUT SESSION_INFO *sessionInfoPtr );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int writeClientHello( INOUT SESSION_INFO *sessionInfoPtr,
+					  INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+					  OUT_LENGTH_SHORT_Z int *clientHelloLength );
+
 /* Prototypes for functions in ssl_cry.c */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
@@ -803,13 +968,6 @@ int checkMacSSL( INOUT SESSION_INFO *sessionInfoPtr,
 				 IN_RANGE( 0, 255 ) const int type, 
 				 const BOOLEAN noReportError );
 #endif /* USE_SSL3 */
-CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
-int createMacTLS( INOUT SESSION_INFO *sessionInfoPtr, 
-				  INOUT_BUFFER( dataMaxLength, *dataLength ) void *data,
-				  IN_DATALENGTH const int dataMaxLength, 
-				  OUT_DATALENGTH_Z int *dataLength,
-				  IN_DATALENGTH const int payloadLength, 
-				  IN_RANGE( 0, 255 ) const int type );
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
 int checkMacTLS( INOUT SESSION_INFO *sessionInfoPtr, 
 				 IN_BUFFER( dataLength ) const void *data, 
@@ -817,7 +975,30 @@ int checkMacTLS( INOUT SESSION_INFO *sessionInfoPtr,
 				 IN_DATALENGTH_Z const int payloadLength, 
 				 IN_RANGE( 0, 255 ) const int type, 
 				 const BOOLEAN noReportError );
-#ifdef USE_GCM
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+int macEncryptDataTLS( INOUT SESSION_INFO *sessionInfoPtr, 
+					   INOUT_BUFFER( dataMaxLength, *dataLength ) \
+							BYTE *data, 
+					   IN_DATALENGTH const int dataMaxLength, 
+					   OUT_DATALENGTH_Z int *dataLength,
+					   IN_LENGTH_IV_Z const int ivLength,
+					   IN_DATALENGTH_Z const int payloadLength, 
+					   IN_RANGE( 0, 255 ) const int type );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+int encryptMacDataTLS( INOUT SESSION_INFO *sessionInfoPtr, 
+					   INOUT_BUFFER( dataMaxLength, *dataLength ) \
+							BYTE *data, 
+					   IN_DATALENGTH const int dataMaxLength, 
+					   OUT_DATALENGTH_Z int *dataLength,
+					   IN_DATALENGTH const int payloadLength, 
+					   IN_RANGE( 0, 255 ) const int type );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+int checkMacDecryptDataTLS( INOUT SESSION_INFO *sessionInfoPtr, 
+							INOUT_BUFFER_FIXED( dataLength ) BYTE *data, 
+							IN_DATALENGTH const int dataLength, 
+							OUT_DATALENGTH_Z int *processedDataLength,
+							IN_RANGE( 0, 255 ) const int type );
+#if defined( USE_GCM ) || defined( USE_CHACHA20 )
 CHECK_RETVAL \
 int macDataTLSGCM( IN_HANDLE const CRYPT_CONTEXT iCryptContext, 
 				   IN_INT_Z const long seqNo, 
@@ -825,7 +1006,18 @@ int macDataTLSGCM( IN_HANDLE const CRYPT_CONTEXT iCryptContext,
 							 SSL_MINOR_VERSION_TLS12 ) const int version,
 				   IN_LENGTH_Z const int payloadLength, 
 				   IN_RANGE( 0, 255 ) const int type );
-#endif /* USE_GCM */
+#endif /* USE_GCM || USE_CHACHA20 */
+#if defined( USE_CHACHA20 ) || defined( USE_TLS13 )
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+int loadNonceTLSChaCha20( IN_HANDLE const CRYPT_CONTEXT iCryptContext, 
+						  IN_BUFFER_C( CHACHA20_SALT_SIZE ) const BYTE *salt,
+						  IN_INT_Z const long seqNo );
+#endif /* USE_CHACHA20 || USE_TLS13 */
+#ifdef USE_TLS13
+CHECK_RETVAL \
+int macDataTLS13( IN_HANDLE const CRYPT_CONTEXT iCryptContext, 
+				  IN_DATALENGTH const int recordLength );
+#endif /* USE_TLS13 */
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
 int hashHSPacketRead( const SSL_HANDSHAKE_INFO *handshakeInfo, 
 					  INOUT STREAM *stream );
@@ -910,7 +1102,8 @@ int readExtensions( INOUT SESSION_INFO *sessionInfoPtr,
 					IN_LENGTH_SHORT const int length );
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
 int writeClientExtensions( INOUT STREAM *stream,
-						   INOUT SESSION_INFO *sessionInfoPtr );
+						   INOUT SESSION_INFO *sessionInfoPtr,
+						   INOUT SSL_HANDSHAKE_INFO *handshakeInfo );
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
 int writeServerExtensions( INOUT STREAM *stream,
 						   INOUT SSL_HANDSHAKE_INFO *handshakeInfo );
@@ -947,6 +1140,10 @@ int initDHcontextSSL( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 					  IN_ENUM_OPT( CRYPT_ECCCURVE ) \
 							const CRYPT_ECCCURVE_TYPE eccParams,
 					  const BOOLEAN isTLSLTS );
+#ifdef USE_25519
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int initX25519contextSSL( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext );
+#endif /* USE_25519 */
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 4 ) ) \
 int createSharedPremasterSecret( OUT_BUFFER( premasterSecretMaxLength, \
 											 *premasterSecretLength ) \
@@ -985,6 +1182,30 @@ CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
 int loadExplicitIV( INOUT SESSION_INFO *sessionInfoPtr, 
 					INOUT STREAM *stream, 
 					OUT_INT_SHORT_Z int *ivLength );
+#ifdef USE_TLS13
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 4 ) ) \
+int hkdfExpandLabelTLS13( OUT_BUFFER_FIXED( outLength ) BYTE *out,
+						  IN_RANGE( 1, TLS13_SECRET_SIZE ) const int outLength,
+						  IN_BUFFER_C( TLS13_SECRET_SIZE ) const BYTE *secret,
+						  IN_BUFFER( labelLength ) const char *label,
+						  IN_RANGE( 1, 32 ) const int labelLength,
+						  IN_BUFFER_OPT( contextLength ) const void *context,
+						  IN_RANGE( 0, 255 ) const int contextLength );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int advanceSecretTLS13( INOUT_BUFFER_FIXED( TLS13_SECRET_SIZE ) BYTE *secret,
+						IN_BUFFER_OPT( keyLength ) const void *key,
+						IN_LENGTH_SHORT_Z const int keyLength,
+						const BOOLEAN isInitial );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int createFinishedTLS13( OUT_BUFFER_FIXED( TLS13_SECRET_SIZE ) BYTE *macValue,
+						 IN_BUFFER_C( TLS13_SECRET_SIZE ) const BYTE *secret,
+						 IN_BUFFER_C( TLS13_SECRET_SIZE ) const BYTE *hash );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int loadKeysTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+				   IN_BUFFER_C( TLS13_SECRET_SIZE ) const BYTE *secret,
+				   IN_RANGE( 0, CRYPT_MAX_KEYSIZE ) const int keySize,
+				   const BOOLEAN isRead );
+#endif /* USE_TLS13 */
 
 /* Prototypes for functions in ssl_rd.c */
 
@@ -1021,6 +1242,15 @@ int unwrapPacketSSL( INOUT SESSION_INFO *sessionInfoPtr,
 					 OUT_DATALENGTH_Z int *dataLength,
 					 IN_RANGE( SSL_HAND_FIRST, \
 							   SSL_HAND_LAST ) const int packetType );
+#ifdef USE_TLS13
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4, 5 ) ) \
+int unwrapPacketTLS13( INOUT SESSION_INFO *sessionInfoPtr, 
+					   INOUT_BUFFER( dataMaxLength, \
+									 *dataLength ) void *data, 
+					   IN_DATALENGTH const int dataMaxLength, 
+					   OUT_DATALENGTH_Z int *dataLength,
+					   OUT_RANGE( 0, 255 ) int *packetType );
+#endif /* USE_TLS13 */
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3 ) ) \
 int readHSPacketSSL( INOUT SESSION_INFO *sessionInfoPtr,
 					 INOUT_OPT SSL_HANDSHAKE_INFO *handshakeInfo, 
@@ -1058,6 +1288,93 @@ int convertSNISessionID( INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
 						 OUT_BUFFER_FIXED( idBufferLength ) BYTE *idBuffer,
 						 IN_LENGTH_FIXED( KEYID_SIZE ) const int idBufferLength );
 
+/* Prototypes for functions in ssl_tls13.c */
+
+#ifdef USE_TLS13
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int initClientHelloTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+						  INOUT SSL_HANDSHAKE_INFO *handshakeInfo );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int beginClientHandshakeTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							   INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+							   IN_LENGTH_SHORT const int clientHelloLength );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int beginServerHandshakeTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							   INOUT SSL_HANDSHAKE_INFO *handshakeInfo );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int exchangeClientKeysTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							 INOUT SSL_HANDSHAKE_INFO *handshakeInfo );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int exchangeServerKeysTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							 INOUT SSL_HANDSHAKE_INFO *handshakeInfo );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int completeHandshakeTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+							const BOOLEAN isClient );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int processPostHandshakeTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							   IN_BUFFER( dataLength ) const BYTE *data,
+							   IN_DATALENGTH const int dataLength );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int fillPSKBinderTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+						INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+						INOUT_BUFFER_FIXED( helloLength ) BYTE *hello,
+						IN_LENGTH_SHORT const int helloLength );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int checkPSKBinderTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+						 INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+						 IN_BUFFER( helloLength ) const BYTE *hello,
+						 IN_LENGTH_SHORT const int helloLength );
+
+#endif /* USE_TLS13 */
+
+/* Prototypes for functions in ssl_tkt.c */
+
+#ifdef USE_SSL_TICKETS
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3, 4 ) ) \
+int writeSessionTicket( INOUT SESSION_INFO *sessionInfoPtr,
+						const SSL_HANDSHAKE_INFO *handshakeInfo,
+						INOUT STREAM *stream,
+						IN_BUFFER( masterSecretSize ) const void *masterSecret,
+						IN_LENGTH_FIXED( SSL_SECRET_SIZE ) \
+							const int masterSecretSize );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3, 5, 6 ) ) \
+int checkSessionTicket( INOUT SESSION_INFO *sessionInfoPtr,
+						const SSL_HANDSHAKE_INFO *handshakeInfo,
+						OUT_BUFFER( masterSecretMaxLength, \
+									*masterSecretLength ) \
+							void *masterSecret,
+						IN_LENGTH_FIXED( SSL_SECRET_SIZE ) \
+							const int masterSecretMaxLength,
+						OUT_LENGTH_BOUNDED_Z( masterSecretMaxLength ) \
+							int *masterSecretLength,
+						OUT_INT_Z int *metaData );
+#ifdef USE_TLS13
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 5 ) ) \
+int addClientTicket( IN_BUFFER( serverNameLength ) const void *serverName,
+					 IN_LENGTH_DNS const int serverNameLength,
+					 IN_BUFFER( ticketLength ) const void *ticket,
+					 IN_LENGTH_SHORT const int ticketLength,
+					 IN_BUFFER_C( 32 ) const BYTE *psk,
+					 IN_RANGE( 1, 65535 ) const int cipherSuite,
+					 const long ticketAgeAdd, const int ticketLifetime );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 5, 6, 7, 8 ) ) \
+int getClientTicket( IN_BUFFER( serverNameLength ) const void *serverName,
+					 IN_LENGTH_DNS const int serverNameLength,
+					 OUT_BUFFER( ticketMaxLength, *ticketLength ) \
+						void *ticket,
+					 IN_LENGTH_SHORT const int ticketMaxLength,
+					 OUT_LENGTH_BOUNDED_Z( ticketMaxLength ) \
+						int *ticketLength,
+					 OUT_BUFFER_FIXED( 32 ) BYTE *psk,
+					 OUT_INT_Z int *cipherSuite,
+					 OUT long *obfuscatedAge );
+#endif /* USE_TLS13 */
+
+#endif /* USE_SSL_TICKETS */
+
 /* Prototypes for functions in ssl_wr.c */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
@@ -1094,6 +1411,10 @@ CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
 int processAlert( INOUT SESSION_INFO *sessionInfoPtr, 
 				  IN_BUFFER( headerLength ) const void *header, 
 				  IN_DATALENGTH const int headerLength );
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int processAlertPayload( INOUT SESSION_INFO *sessionInfoPtr, 
+						 IN_BUFFER( alertLength ) const BYTE *alertData, 
+						 IN_LENGTH_SHORT const int alertLength );
 STDC_NONNULL_ARG( ( 1 ) ) \
 void sendCloseAlert( INOUT SESSION_INFO *sessionInfoPtr, 
 					 const BOOLEAN alertReceived );
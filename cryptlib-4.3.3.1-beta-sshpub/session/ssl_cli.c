@@ -103,7 +103,7 @@ static int checkSuiteBSelection( IN_RANGE( SSL_FIRST_VALID_SUITE, \
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
 static int writeCipherSuiteList( INOUT STREAM *stream, 
 								 IN_RANGE( SSL_MINOR_VERSION_SSL, \
-										   SSL_MINOR_VERSION_TLS12 ) \
+										   SSL_MINOR_VERSION_TLS13 ) \
 									const int sslVersion,
 								 const BOOLEAN usePSK, 
 								 IN_FLAGS_Z( SSL ) const int suiteBinfo )
@@ -119,7 +119,7 @@ static int writeCipherSuiteList( INOUT STREAM *stream,
 	assert( isWritePtr( stream, sizeof( STREAM ) ) );
 
 	REQUIRES( sslVersion >= SSL_MINOR_VERSION_SSL && \
-			  sslVersion <= SSL_MINOR_VERSION_TLS12 );
+			  sslVersion <= SSL_MINOR_VERSION_TLS13 );
 	REQUIRES( usePSK == TRUE || usePSK == FALSE );
 #ifdef CONFIG_SUITEB
 	REQUIRES( suiteBinfo >= SSL_PFLAG_NONE && suiteBinfo < SSL_PFLAG_MAX );
@@ -170,7 +170,9 @@ static int writeCipherSuiteList( INOUT STREAM *stream,
 		if( ( ( suiteFlags & CIPHERSUITE_FLAG_ECC ) && \
 			  sslVersion <= SSL_MINOR_VERSION_SSL ) || \
 			( ( suiteFlags & CIPHERSUITE_FLAG_TLS12 ) && \
-			  sslVersion <= SSL_MINOR_VERSION_TLS11 ) )
+			  sslVersion <= SSL_MINOR_VERSION_TLS11 ) || \
+			( ( suiteFlags & CIPHERSUITE_FLAG_TLS13 ) && \
+			  sslVersion <= SSL_MINOR_VERSION_TLS12 ) )
 			{
 			suiteIndex++;
 			continue;
@@ -461,26 +463,45 @@ static int readServerKeyexDH( INOUT STREAM *stream,
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
 static int readServerKeyexECDH( INOUT STREAM *stream, 
 								OUT KEYAGREE_PARAMS *keyAgreeParams,
-								OUT_HANDLE_OPT CRYPT_CONTEXT *dhContextPtr )
+								OUT_HANDLE_OPT CRYPT_CONTEXT *dhContextPtr,
+								OUT_BOOL BOOLEAN *isX25519 )
 	{
 	void *keyData;
 	const int keyDataOffset = stell( stream );
-	int keyDataLength, status;
+	int keyDataLength, curveID, status;
 
 	assert( isWritePtr( stream, sizeof( STREAM ) ) );
 	assert( isWritePtr( keyAgreeParams, sizeof( KEYAGREE_PARAMS ) ) );
 	assert( isWritePtr( dhContextPtr, sizeof( CRYPT_CONTEXT ) ) );
+	assert( isWritePtr( isX25519, sizeof( BOOLEAN ) ) );
 
 	/* Clear return values */
 	memset( keyAgreeParams, 0, sizeof( KEYAGREE_PARAMS ) );
 	*dhContextPtr = CRYPT_ERROR;
+	*isX25519 = FALSE;
 
 	/* Read the server ECDH public key data */
 	( void ) sgetc( stream );
-	status = readUint16( stream );
+	status = curveID = readUint16( stream );
 	if( cryptStatusError( status ) )
 		return( status );
 
+#ifdef USE_25519
+	/* If the server has chosen X25519 then there are no parameters to 
+	   load, all that we need is a fresh X25519 key of our own */
+	if( curveID == TLS_CURVE_X25519 )
+		{
+		status = initX25519contextSSL( dhContextPtr );
+		if( cryptStatusError( status ) )
+			return( status );
+		*isX25519 = TRUE;
+
+		return( readEcdhValue( stream, keyAgreeParams->publicValue,
+							   CRYPT_MAX_PKCSIZE, 
+							   &keyAgreeParams->publicValueLen, TRUE ) );
+		}
+#endif /* USE_25519 */
+
 	/* Create an ECDH context from the public key data.  We set a dummy 
 	   curve type, the actual value is determined by the parameters sent 
 	   by the server */
@@ -499,7 +520,7 @@ static int readServerKeyexECDH( INOUT STREAM *stream,
 	/* Read the ECDH public value */
 	return( readEcdhValue( stream, keyAgreeParams->publicValue,
 						   CRYPT_MAX_PKCSIZE, 
-						   &keyAgreeParams->publicValueLen ) );
+						   &keyAgreeParams->publicValueLen, FALSE ) );
 	}
 
 /* Process the optional server keyex:
@@ -610,7 +631,8 @@ static int processServerKeyex( INOUT SESSION_INFO *sessionInfoPtr,
 	if( isECC )
 		{
 		status = readServerKeyexECDH( stream, &keyAgreeParams, 
-									  &handshakeInfo->dhContext );
+									  &handshakeInfo->dhContext,
+									  &handshakeInfo->useX25519 );
 		}
 	else
 		{
@@ -703,7 +725,7 @@ static int processServerKeyex( INOUT SESSION_INFO *sessionInfoPtr,
 		zeroise( &keyAgreeParams, sizeof( KEYAGREE_PARAMS ) );
 		return( status );
 		}
-	if( isECC && !isTLSLTS )
+	if( isECC && !isTLSLTS && !handshakeInfo->useX25519 )
 		{
 		const int xCoordLen = ( keyAgreeParams.wrappedKeyLen - 1 ) / 2;
 
@@ -711,7 +733,8 @@ static int processServerKeyex( INOUT SESSION_INFO *sessionInfoPtr,
 		   unknown reason TLS only uses the x coordinate and not the full 
 		   point.  To work around this we have to rewrite the point as a 
 		   standalone x coordinate, which is relatively easy because we're 
-		   using an uncompressed point format: 
+		   using an uncompressed point format (X25519 produces a standalone 
+		   u-coordinate so there's nothing to do there): 
 
 			+---+---------------+---------------+
 			|04	|		qx		|		qy		|
@@ -1163,7 +1186,7 @@ static int checkHostName( const CRYPT_CERTIFICATE iCryptCert,
    itself is in order */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
-static int checkCertificateInfo( INOUT SESSION_INFO *sessionInfoPtr )
+int checkCertificateInfo( INOUT SESSION_INFO *sessionInfoPtr )
 	{
 	const CRYPT_CERTIFICATE iCryptCert = sessionInfoPtr->iKeyexCryptContext;
 	MESSAGE_DATA msgData;
@@ -1247,74 +1270,26 @@ static int checkCertificateInfo( INOUT SESSION_INFO *sessionInfoPtr )
 *																			*
 ****************************************************************************/
 
-/* Perform the initial part of the handshake with the server */
+/* Write the client hello and send it to the server.  This is split out 
+   from beginClientHandshake() because TLS 1.3 may require a second client
+   hello to be sent in response to a HelloRetryRequest */
 
-CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
-static int beginClientHandshake( INOUT SESSION_INFO *sessionInfoPtr,
-								 INOUT SSL_HANDSHAKE_INFO *handshakeInfo )
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int writeClientHello( INOUT SESSION_INFO *sessionInfoPtr,
+					  INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+					  OUT_LENGTH_SHORT_Z int *clientHelloLength )
 	{
-#ifndef NO_SESSION_CACHE
-	const ATTRIBUTE_LIST *attributeListPtr;
-#endif /* NO_SESSION_CACHE */
 	STREAM *stream = &handshakeInfo->stream;
-	SCOREBOARD_INFO scoreboardInfo = { 0 };
-	MESSAGE_DATA msgData;
-	BYTE sentSessionID[ MAX_SESSIONID_SIZE + 8 ];
-	BOOLEAN sessionIDsent = FALSE, resumeSession = FALSE;
-	int packetOffset, clientHelloLength, serverHelloLength;
-	int sentSessionIDlength DUMMY_INIT, status;
+	int packetOffset, status;
 
 	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
 	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isWritePtr( clientHelloLength, sizeof( int ) ) );
 
 	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
 
-	/* Check whether we have (potentially) cached data available for the
-	   server.  If we've had the connection to the remote system provided
-	   by the user (for example as an already-connected socket) then there
-	   won't be any server name information present, so we can only
-	   perform a session resume if we've established the connection
-	   ourselves */
-#ifndef NO_SESSION_CACHE
-	attributeListPtr = findSessionInfo( sessionInfoPtr, 
-										CRYPT_SESSINFO_SERVER_NAME );
-	if( attributeListPtr != NULL )
-		{
-		int resumedSessionID;
-
-		resumedSessionID = \
-			lookupScoreboardEntry( sessionInfoPtr->sessionSSL->scoreboardInfoPtr,
-								   SCOREBOARD_KEY_FQDN, attributeListPtr->value,
-								   attributeListPtr->valueLength, 
-								   &scoreboardInfo );
-		if( !cryptStatusError( resumedSessionID ) )
-			{
-			/* We've got cached data for the server available, remember the 
-			   session ID so that we can send it to the server */
-			status = attributeCopyParams( handshakeInfo->sessionID, 
-										  MAX_SESSIONID_SIZE, 
-										  &handshakeInfo->sessionIDlength,
-										  scoreboardInfo.key, 
-										  scoreboardInfo.keySize );
-			ENSURES( cryptStatusOK( status ) );
-
-			/* Make a copy of the session ID that we're sending so that we 
-			   can check it against what the server sends back to us later.  
-			   This is required for when the server can't resume the session
-			   and sends us a fresh session ID */
-			memcpy( sentSessionID, handshakeInfo->sessionID, 
-					handshakeInfo->sessionIDlength );
-			sentSessionIDlength = handshakeInfo->sessionIDlength;
-			}
-		}
-#endif /* NO_SESSION_CACHE */
-
-	/* Get the nonce that's used to randomise all crypto ops */
-	setMessageData( &msgData, handshakeInfo->clientNonce, SSL_NONCE_SIZE );
-	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_GETATTRIBUTE_S,
-							  &msgData, CRYPT_IATTRIBUTE_RANDOM_NONCE );
-	if( cryptStatusError( status ) )
-		return( status );
+	/* Clear return value */
+	*clientHelloLength = 0;
 
 	/* Build the client hello packet:
 
@@ -1353,7 +1328,8 @@ static int beginClientHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 		return( status );
 		}
 	sputc( stream, SSL_MAJOR_VERSION );
-	sputc( stream, sessionInfoPtr->version );
+	sputc( stream, min( sessionInfoPtr->version, \
+						SSL_MINOR_VERSION_TLS12 ) );
 	handshakeInfo->clientOfferedVersion = sessionInfoPtr->version;
 	swrite( stream, handshakeInfo->clientNonce, SSL_NONCE_SIZE );
 	sputc( stream, handshakeInfo->sessionIDlength );
@@ -1361,7 +1337,6 @@ static int beginClientHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 		{
 		swrite( stream, handshakeInfo->sessionID, 
 				handshakeInfo->sessionIDlength );
-		sessionIDsent = TRUE;
 		}
 	status = writeCipherSuiteList( stream, sessionInfoPtr->version,
 						findSessionInfo( sessionInfoPtr,
@@ -1379,10 +1354,30 @@ static int beginClientHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 		{
 		/* Extensions are only written when newer versions of TLS are 
 		   enabled, see the comment earlier for details */
-		status = writeClientExtensions( stream, sessionInfoPtr );
+		status = writeClientExtensions( stream, sessionInfoPtr, 
+										handshakeInfo );
 		}
 	if( cryptStatusOK( status ) )
 		status = completeHSPacketStream( stream, packetOffset );
+#ifdef USE_TLS13
+	if( cryptStatusOK( status ) && \
+		handshakeInfo->tls13PskIdentityLength > 0 )
+		{
+		/* We're trying to resume a TLS 1.3 session, fill in the PSK 
+		   binder now that the rest of the hello that it covers has been 
+		   written */
+		status = completePacketStreamSSL( stream, 0 );
+		if( cryptStatusOK( status ) )
+			{
+			status = fillPSKBinderTLS13( sessionInfoPtr, handshakeInfo,
+								sessionInfoPtr->sendBuffer + SSL_HEADER_SIZE,
+								stell( stream ) - SSL_HEADER_SIZE );
+			}
+		if( cryptStatusOK( status ) )
+			status = sendPacketSSL( sessionInfoPtr, stream, TRUE );
+		}
+	else
+#endif /* USE_TLS13 */
 	if( cryptStatusOK( status ) )
 		status = sendPacketSSL( sessionInfoPtr, stream, FALSE );
 	if( cryptStatusError( status ) )
@@ -1390,12 +1385,103 @@ static int beginClientHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 		sMemDisconnect( stream );
 		return( status );
 		}
-	clientHelloLength = stell( stream ) - SSL_HEADER_SIZE;
+	recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_HELLOSENT );
+	*clientHelloLength = stell( stream ) - SSL_HEADER_SIZE;
 
 	/* Perform the assorted hashing of the client hello in between the 
 	   network ops where it's effectively free */
 	status = hashHSPacketWrite( handshakeInfo, stream, 0 );
 	sMemDisconnect( stream );
+
+	return( status );
+	}
+
+/* Perform the initial part of the handshake with the server */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int beginClientHandshake( INOUT SESSION_INFO *sessionInfoPtr,
+								 INOUT SSL_HANDSHAKE_INFO *handshakeInfo )
+	{
+#ifndef NO_SESSION_CACHE
+	const ATTRIBUTE_LIST *attributeListPtr;
+#endif /* NO_SESSION_CACHE */
+	STREAM *stream = &handshakeInfo->stream;
+	SCOREBOARD_INFO scoreboardInfo = { 0 };
+	MESSAGE_DATA msgData;
+	BYTE sentSessionID[ MAX_SESSIONID_SIZE + 8 ];
+	BOOLEAN sessionIDsent = FALSE, resumeSession = FALSE;
+	int clientHelloLength, serverHelloLength;
+	int sentSessionIDlength DUMMY_INIT, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+
+	/* Check whether we have (potentially) cached data available for the
+	   server.  If we've had the connection to the remote system provided
+	   by the user (for example as an already-connected socket) then there
+	   won't be any server name information present, so we can only
+	   perform a session resume if we've established the connection
+	   ourselves */
+#ifndef NO_SESSION_CACHE
+	attributeListPtr = findSessionInfo( sessionInfoPtr, 
+										CRYPT_SESSINFO_SERVER_NAME );
+	if( attributeListPtr != NULL )
+		{
+		int resumedSessionID;
+
+		resumedSessionID = \
+			lookupScoreboardEntry( sessionInfoPtr->sessionSSL->scoreboardInfoPtr,
+								   SCOREBOARD_KEY_FQDN, attributeListPtr->value,
+								   attributeListPtr->valueLength, 
+								   &scoreboardInfo );
+		if( !cryptStatusError( resumedSessionID ) )
+			{
+			/* We've got cached data for the server available, remember the 
+			   session ID so that we can send it to the server */
+			status = attributeCopyParams( handshakeInfo->sessionID, 
+										  MAX_SESSIONID_SIZE, 
+										  &handshakeInfo->sessionIDlength,
+										  scoreboardInfo.key, 
+										  scoreboardInfo.keySize );
+			ENSURES( cryptStatusOK( status ) );
+
+			/* Make a copy of the session ID that we're sending so that we 
+			   can check it against what the server sends back to us later.  
+			   This is required for when the server can't resume the session
+			   and sends us a fresh session ID */
+			memcpy( sentSessionID, handshakeInfo->sessionID, 
+					handshakeInfo->sessionIDlength );
+			sentSessionIDlength = handshakeInfo->sessionIDlength;
+			}
+		}
+#endif /* NO_SESSION_CACHE */
+
+	/* Get the nonce that's used to randomise all crypto ops */
+	setMessageData( &msgData, handshakeInfo->clientNonce, SSL_NONCE_SIZE );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_GETATTRIBUTE_S,
+							  &msgData, CRYPT_IATTRIBUTE_RANDOM_NONCE );
+	if( cryptStatusError( status ) )
+		return( status );
+
+#ifdef USE_TLS13
+	/* If we're offering TLS 1.3, set up our key share and, if we've got a 
+	   ticket from a previous session with the server, the PSK to resume it 
+	   with */
+	if( sessionInfoPtr->version >= SSL_MINOR_VERSION_TLS13 )
+		{
+		status = initClientHelloTLS13( sessionInfoPtr, handshakeInfo );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+#endif /* USE_TLS13 */
+
+	/* Send the client hello to the server */
+	if( handshakeInfo->sessionIDlength > 0 )
+		sessionIDsent = TRUE;
+	status = writeClientHello( sessionInfoPtr, handshakeInfo, 
+							   &clientHelloLength );
 	if( cryptStatusError( status ) )
 		return( status );
 
@@ -1425,6 +1511,17 @@ static int beginClientHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 		return( status );
 	sMemConnect( stream, sessionInfoPtr->receiveBuffer, serverHelloLength );
 	status = processHelloSSL( sessionInfoPtr, handshakeInfo, stream, FALSE );
+#ifdef USE_TLS13
+	if( ( cryptStatusOK( status ) || status == OK_SPECIAL ) && \
+		( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS13 ) )
+		{
+		/* The server has selected TLS 1.3, which uses a completely 
+		   different handshake from here on */
+		sMemDisconnect( stream );
+		return( beginClientHandshakeTLS13( sessionInfoPtr, handshakeInfo,
+										   clientHelloLength ) );
+		}
+#endif /* USE_TLS13 */
 	if( status == OK_SPECIAL )
 		{
 		/* The server has provided a session ID, if we sent one in our 
@@ -1488,7 +1585,7 @@ static int beginClientHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS12LTS )
 		{
 		sessionInfoPtr->protocolFlags |= SSL_PFLAG_EMS;
-		if( !( sessionInfoPtr->protocolFlags & SSL_PFLAG_GCM ) )
+		if( !( sessionInfoPtr->protocolFlags & SSL_PFLAG_AEAD ) )
 			sessionInfoPtr->protocolFlags |= SSL_PFLAG_ENCTHENMAC;
 
 		/* Hash the hello messages */
@@ -1523,6 +1620,12 @@ static int exchangeClientKeys( INOUT SESSION_INFO *sessionInfoPtr,
 
 	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
 
+#ifdef USE_TLS13
+	/* TLS 1.3 has its own handshake message flow */
+	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS13 )
+		return( exchangeClientKeysTLS13( sessionInfoPtr, handshakeInfo ) );
+#endif /* USE_TLS13 */
+
 	/* Process the optional server supplemental data:
 
 		byte		ID = SSL_HAND_SUPPLEMENTAL_DATA
@@ -1588,13 +1691,21 @@ static int exchangeClientKeys( INOUT SESSION_INFO *sessionInfoPtr,
 			return( status );
 			}
 
-		/* Check the details in the certificate chain */
-		status = checkCertificateInfo( sessionInfoPtr );
+		/* Check the details in the certificate chain.  Since this moves 
+		   the chain's attribute cursor around, we lock it while we're 
+		   doing this */
+		status = lockCertChainLeaf( sessionInfoPtr->iKeyexCryptContext );
+		if( cryptStatusOK( status ) )
+			{
+			status = checkCertificateInfo( sessionInfoPtr );
+			unlockCertChain( sessionInfoPtr->iKeyexCryptContext );
+			}
 		if( cryptStatusError( status ) )
 			{
 			sMemDisconnect( stream );
 			return( status );
 			}
+		recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_CERTVERIFIED );
 		}
 #endif /* CONFIG_FUZZ */
 
@@ -1769,6 +1880,7 @@ static int exchangeClientKeys( INOUT SESSION_INFO *sessionInfoPtr,
 		sMemDisconnect( stream );
 		return( status );
 		}
+	recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_KEYEXCHANGE );
 
 	/* Wrap up the packet and create the session hash if required */
 	status = completePacketStreamSSL( stream, 0 );
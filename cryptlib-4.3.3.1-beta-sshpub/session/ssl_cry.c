@@ -27,7 +27,10 @@
 
 /* Write packet metadata for input to the MAC/ICV authentication process:
 
-	seq_num || type || version || length */
+	seq_num || type || version || length
+
+   With encrypt-then-MAC the length is that of the IV and padded ciphertext, 
+   so it can be somewhat larger than MAX_PACKET_SIZE */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3 ) ) \
 static int writePacketMetadata( OUT_BUFFER( dataMaxLength, *dataLength ) \
@@ -54,7 +57,7 @@ static int writePacketMetadata( OUT_BUFFER( dataMaxLength, *dataLength ) \
 	REQUIRES( seqNo >= 0 );
 	REQUIRES( version >= SSL_MINOR_VERSION_TLS && \
 			  version <= SSL_MINOR_VERSION_TLS12 );
-	REQUIRES( payloadLength >= 0 && payloadLength <= MAX_PACKET_SIZE );
+	REQUIRES( payloadLength >= 0 && payloadLength <= MAX_PACKET_SIZE + 512 );
 
 	/* Clear return values */
 	memset( data, 0, min( 16, dataMaxLength ) );
@@ -80,6 +83,142 @@ static int writePacketMetadata( OUT_BUFFER( dataMaxLength, *dataLength ) \
 *																			*
 ****************************************************************************/
 
+/* Add end-of-block and message padding for a block cipher.  We can't pad 
+   GCM because the spec doesn't allow it so this is only used with CBC-mode
+   ciphers.
+
+   Note that the padding size can range from 0 to 255 bytes, with zero
+   bytes of padding being non-PKCS #5 conformant.  This is possible
+   because the padding doesn't also encode the length as it does in 
+   PKCS #5, the padding length is an extra byte that's always present 
+   but is also treated as the last byte of the padding.  To deal with 
+   this special case we round up the payload size to ensure that 
+   there's always at least one byte of padding present */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+static int addPadding( const SESSION_INFO *sessionInfoPtr, 
+					   INOUT_BUFFER( dataMaxLength, *dataLength ) \
+							BYTE *data, 
+					   IN_DATALENGTH const int dataMaxLength,
+					   OUT_DATALENGTH_Z int *dataLength,
+					   IN_DATALENGTH const int payloadLength )
+	{
+#ifdef USE_SSL3
+	const int paddedSize = ( sessionInfoPtr->version == SSL_MINOR_VERSION_SSL ) ? \
+							 roundUp( payloadLength + 1, sessionInfoPtr->cryptBlocksize ) : \
+							 getPaddedSize( payloadLength + 1 );
+#else
+	const int paddedSize = getPaddedSize( payloadLength + 1 );
+#endif /* USE_SSL3 */
+	const int padSize = paddedSize - payloadLength;
+	int length = payloadLength, i, LOOP_ITERATOR;
+
+	assert( isReadPtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtrDynamic( data, dataMaxLength ) );
+	assert( isWritePtr( dataLength, sizeof( int ) ) );
+
+	REQUIRES( sessionInfoPtr->cryptBlocksize > 1 );
+	REQUIRES( dataMaxLength > 0 && dataMaxLength < MAX_BUFFER_SIZE );
+	REQUIRES( payloadLength > 0 && payloadLength <= dataMaxLength );
+
+	/* Clear return value */
+	*dataLength = 0;
+
+	ENSURES( paddedSize >= 16 && paddedSize <= MAX_BUFFER_SIZE ); 
+	ENSURES( padSize > 0 && padSize <= 255 && \
+			 length + padSize <= dataMaxLength );
+
+	/* Add the PKCS #5-style padding (PKCS #5 uses n, TLS uses n-1) */
+	LOOP_EXT( i = 0, i < padSize, i++, 257 )
+		data[ length++ ] = intToByte( padSize - 1 );
+	ENSURES( LOOP_BOUND_OK );
+	*dataLength = length;
+
+	return( CRYPT_OK );
+	}
+
+/* Remove end-of-block padding for a block cipher.  Up until TLS 1.1 the 
+   spec was silent about any requirement to check the padding (and for 
+   SSLv3 it didn't specify the padding format at all apart from specifying 
+   that it had to be  less than the cipher block size) so it's not really 
+   safe to reject an SSL message if we don't find the correct padding 
+   because many SSL implementations didn't process the padded data space 
+   in any way, leaving it containing whatever was there before (which can 
+   include old plaintext (!!)).  Almost all TLS implementations get it 
+   right (even though in TLS 1.0 there was only a requirement to generate, 
+   but not to check, the PKCS #5-style padding).  Because of this we only 
+   check the padding bytes if we're talking TLS */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+static int removePadding( INOUT SESSION_INFO *sessionInfoPtr, 
+						  IN_BUFFER( dataLength ) const BYTE *data, 
+						  IN_DATALENGTH const int dataLength, 
+						  OUT_DATALENGTH_Z int *processedDataLength )
+	{
+	int length = dataLength, padSize;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isReadPtrDynamic( data, dataLength ) );
+	assert( isWritePtr( processedDataLength, sizeof( int ) ) );
+
+	REQUIRES( sessionInfoPtr->cryptBlocksize > 1 );
+	REQUIRES( dataLength > 0 && dataLength < MAX_BUFFER_SIZE );
+
+	/* Clear return value */
+	*processedDataLength = 0;
+
+	/* First we make sure that the padding information looks OK.  TLS allows 
+	   up to 256 bytes of padding (only GnuTLS actually seems to use this 
+	   capability though) so we can't check for a sensible (small) padding 
+	   length, however we can check this for SSL, which is good because for 
+	   that we can't check the padding itself.
+
+	   There's no easy way to perform these checks in a timing-independent
+	   manner because we're using them to reject completely malformed
+	   packets (out-of-bounds array references), but hopefully the few 
+	   cycles difference won't be measurable in the overall scheme of 
+	   things */
+	padSize = byteToInt( data[ dataLength - 1 ] );
+	if( padSize < 0 || padSize > 255 || \
+		( sessionInfoPtr->version == SSL_MINOR_VERSION_SSL && \
+		  padSize > sessionInfoPtr->cryptBlocksize - 1 ) )
+		{
+		retExt( CRYPT_ERROR_BADDATA,
+				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
+				  "Invalid encryption padding value 0x%02X (%d)", 
+				  padSize, padSize ) );
+		}
+	length -= padSize + 1;
+	if( length < 0 || length > MAX_BUFFER_SIZE )
+		{
+		retExt( CRYPT_ERROR_BADDATA,
+				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
+				  "Encryption padding adjustment value %d is greater "
+				  "than packet length %d", padSize, dataLength ) );
+		}
+
+	/* Check for PKCS #5-type padding (PKCS #5 uses n, TLS uses n-1) if 
+	   necessary, in a timing-independent manner */
+	if( sessionInfoPtr->version >= SSL_MINOR_VERSION_TLS )
+		{
+		int value = 0, i, LOOP_ITERATOR;
+
+		LOOP_EXT( i = 0, i < padSize, i++, 257 )
+			value |= data[ length + i ] ^ padSize;
+		ENSURES( LOOP_BOUND_OK );
+		if( value != 0 )
+			{
+			retExt( CRYPT_ERROR_BADDATA,
+					( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
+					  "Invalid encryption padding byte, expected 0x%02X",
+					  padSize ) );
+			}
+		}
+	*processedDataLength = length;
+
+	return( CRYPT_OK );
+	}
+
 /* Encrypt/decrypt a data block (in mose cases this also includes the MAC, 
    which has been added to the data by the caller).  The handling of length 
    arguments for these is a bit tricky, for encryption the input is { data, 
@@ -112,36 +251,13 @@ int encryptData( const SESSION_INFO *sessionInfoPtr,
 	/* Clear return value */
 	*dataLength = 0;
 
-	/* If it's a block cipher then we add end-of-block and message padding.  
-	   We can't pad GCM because the spec doesn't allow it.
-	   
-	   Note that the padding size can range from 0 to 255 bytes, with zero
-	   bytes of padding being non-PKCS #5 conformant.  This is possible
-	   because the padding doesn't also encode the length as it does in 
-	   PKCS #5, the padding length is an extra byte that's always present 
-	   but is also treated as the last byte of the padding.  To deal with 
-	   this special case we round up the payload size to ensure that 
-	   there's always at least one byte of padding present */
+	/* If it's a block cipher then we add end-of-block and message padding */
 	if( sessionInfoPtr->cryptBlocksize > 1 )
 		{
-#ifdef USE_SSL3
-		const int paddedSize = ( sessionInfoPtr->version == SSL_MINOR_VERSION_SSL ) ? \
-								 roundUp( payloadLength + 1, sessionInfoPtr->cryptBlocksize ) : \
-								 getPaddedSize( payloadLength + 1 );
-#else
-		const int paddedSize = getPaddedSize( payloadLength + 1 );
-#endif /* USE_SSL3 */
-		const int padSize = paddedSize - payloadLength;
-		int i, LOOP_ITERATOR;
-
-		ENSURES( paddedSize >= 16 && paddedSize <= MAX_BUFFER_SIZE ); 
-		ENSURES( padSize > 0 && padSize <= 255 && \
-				 length + padSize <= dataMaxLength );
-
-		/* Add the PKCS #5-style padding (PKCS #5 uses n, TLS uses n-1) */
-		LOOP_EXT( i = 0, i < padSize, i++, 257 )
-			data[ length++ ] = intToByte( padSize - 1 );
-		ENSURES( LOOP_BOUND_OK );
+		status = addPadding( sessionInfoPtr, data, dataMaxLength, &length,
+							 payloadLength );
+		if( cryptStatusError( status ) )
+			return( status );
 		}
 
 	/* Encrypt the data and optional padding */
@@ -151,8 +267,9 @@ int encryptData( const SESSION_INFO *sessionInfoPtr,
 		return( status );
 	*dataLength = length;
 
-	/* If we're using GCM then we have to append the ICV to the data */
-	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_GCM )
+	/* If we're using GCM or ChaCha20-Poly1305 then we have to append the 
+	   ICV to the data */
+	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_AEAD )
 		{
 		MESSAGE_DATA msgData;
 
@@ -178,7 +295,7 @@ int decryptData( SESSION_INFO *sessionInfoPtr,
 				 IN_DATALENGTH const int dataLength, 
 				 OUT_DATALENGTH_Z int *processedDataLength )
 	{
-	int length = dataLength, padSize, status;
+	int length = dataLength, status;
 
 	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
 	assert( isWritePtrDynamic( data, dataLength ) );
@@ -202,9 +319,9 @@ int decryptData( SESSION_INFO *sessionInfoPtr,
 				  "Packet decryption failed" ) );
 		}
 
-	/* If we're using GCM then we have to check the ICV that follows the 
-	   data */
-	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_GCM )
+	/* If we're using GCM or ChaCha20-Poly1305 then we have to check the ICV 
+	   that follows the data */
+	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_AEAD )
 		{
 		MESSAGE_DATA msgData;
 
@@ -230,69 +347,9 @@ int decryptData( SESSION_INFO *sessionInfoPtr,
 		return( CRYPT_OK );
 		}
 
-	/* If it's a block cipher, we need to remove end-of-block padding.  Up 
-	   until TLS 1.1 the spec was silent about any requirement to check the 
-	   padding (and for SSLv3 it didn't specify the padding format at all
-	   apart from specifying that it had to be  less than the cipher block
-	   size) so it's not really safe to reject an SSL message if we don't 
-	   find the correct padding because many SSL implementations didn't 
-	   process the padded data space in any way, leaving it containing 
-	   whatever was there before (which can include old plaintext (!!)).  
-	   Almost all TLS implementations get it right (even though in TLS 1.0 
-	   there was only a requirement to generate, but not to check, the PKCS 
-	   #5-style padding).  Because of this we only check the padding bytes 
-	   if we're talking TLS.
-
-	   First we make sure that the padding information looks OK.  TLS allows 
-	   up to 256 bytes of padding (only GnuTLS actually seems to use this 
-	   capability though) so we can't check for a sensible (small) padding 
-	   length, however we can check this for SSL, which is good because for 
-	   that we can't check the padding itself.
-
-	   There's no easy way to perform these checks in a timing-independent
-	   manner because we're using them to reject completely malformed
-	   packets (out-of-bounds array references), but hopefully the few 
-	   cycles difference won't be measurable in the overall scheme of 
-	   things */
-	padSize = byteToInt( data[ dataLength - 1 ] );
-	if( padSize < 0 || padSize > 255 || \
-		( sessionInfoPtr->version == SSL_MINOR_VERSION_SSL && \
-		  padSize > sessionInfoPtr->cryptBlocksize - 1 ) )
-		{
-		retExt( CRYPT_ERROR_BADDATA,
-				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
-				  "Invalid encryption padding value 0x%02X (%d)", 
-				  padSize, padSize ) );
-		}
-	length -= padSize + 1;
-	if( length < 0 || length > MAX_BUFFER_SIZE )
-		{
-		retExt( CRYPT_ERROR_BADDATA,
-				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
-				  "Encryption padding adjustment value %d is greater "
-				  "than packet length %d", padSize, dataLength ) );
-		}
-
-	/* Check for PKCS #5-type padding (PKCS #5 uses n, TLS uses n-1) if 
-	   necessary, in a timing-independent manner */
-	if( sessionInfoPtr->version >= SSL_MINOR_VERSION_TLS )
-		{
-		int value = 0, i, LOOP_ITERATOR;
-
-		LOOP_EXT( i = 0, i < padSize, i++, 257 )
-			value |= data[ length + i ] ^ padSize;
-		ENSURES( LOOP_BOUND_OK );
-		if( value != 0 )
-			{
-			retExt( CRYPT_ERROR_BADDATA,
-					( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
-					  "Invalid encryption padding byte, expected 0x%02X",
-					  padSize ) );
-			}
-		}
-	*processedDataLength = length;
-
-	return( CRYPT_OK );
+	/* If it's a block cipher, we need to remove end-of-block padding */
+	return( removePadding( sessionInfoPtr, data, dataLength, 
+						   processedDataLength ) );
 	}
 
 /****************************************************************************
@@ -545,26 +602,30 @@ int checkMacSSL( INOUT SESSION_INFO *sessionInfoPtr,
    single component MAC operation since it would lead to endless sequences
    of 'status = x; if( cSOK( x ) ) ...' chains, on the remote chance that
    there's some transient failure in a single component operation it'll be
-   picked up at the end anyway when the overall MAC check fails */
+   picked up at the end anyway when the overall MAC check fails.  
+   
+   macDataStartTLS() resets the hash context and MACs the packet metadata 
+   and optional IV, after which the caller can either MAC the payload data 
+   in one go via macDataTLS() or piecewise interleaved with the en/
+   decryption of the data, see the stitched en/decryption functions 
+   further down */
 
 CHECK_RETVAL \
-static int macDataTLS( IN_HANDLE const CRYPT_CONTEXT iHashContext, 
-					   IN_INT_Z const long seqNo, 
-					   IN_RANGE( SSL_MINOR_VERSION_TLS, \
-								 SSL_MINOR_VERSION_TLS12 ) const int version,
-					   IN_BUFFER_OPT( ivLength ) const void *iv, 
-					   IN_LENGTH_IV_Z const int ivLength, 
-					   IN_BUFFER_OPT( dataLength ) const void *data, 
-					   IN_DATALENGTH_Z const int dataLength, 
-					   IN_RANGE( 0, 255 ) const int type )
+static int macDataStartTLS( IN_HANDLE const CRYPT_CONTEXT iHashContext, 
+							IN_INT_Z const long seqNo, 
+							IN_RANGE( SSL_MINOR_VERSION_TLS, \
+									  SSL_MINOR_VERSION_TLS12 ) \
+								const int version,
+							IN_BUFFER_OPT( ivLength ) const void *iv, 
+							IN_LENGTH_IV_Z const int ivLength, 
+							IN_DATALENGTH_Z const int dataLength, 
+							IN_RANGE( 0, 255 ) const int type )
 	{
 	BYTE buffer[ 64 + CRYPT_MAX_IVSIZE + 8 ];
 	int length, status;
 
 	assert( ( iv == NULL && ivLength == 0 ) || \
 			isReadPtrDynamic( iv, ivLength ) );
-	assert( ( data == NULL && dataLength == 0 ) || \
-			isReadPtrDynamic( data, dataLength ) );
 
 	REQUIRES( isHandleRangeValid( iHashContext ) );
 	REQUIRES( seqNo >= 0 );
@@ -573,9 +634,7 @@ static int macDataTLS( IN_HANDLE const CRYPT_CONTEXT iHashContext,
 	REQUIRES( ( iv == NULL && ivLength == 0 ) || \
 			  ( iv != NULL && \
 				ivLength > 0 && ivLength <= CRYPT_MAX_IVSIZE ) );
-	REQUIRES( ( data == NULL && dataLength == 0 ) || \
-			  ( data != NULL && \
-				dataLength > 0 && dataLength <= MAX_PACKET_SIZE ) );
+	REQUIRES( dataLength >= 0 && dataLength <= MAX_PACKET_SIZE + 512 );
 	REQUIRES( type >= 0 && type <= 255 );
 
 	/* Set up the packet metadata to be MACed */
@@ -591,69 +650,45 @@ static int macDataTLS( IN_HANDLE const CRYPT_CONTEXT iHashContext,
 		length += ivLength;
 		}
 
-	/* Reset the hash context and generate the MAC:
+	/* Reset the hash context and start generating the MAC:
 
 		HMAC( metadata || (IV) || data ) */
 	krnlSendMessage( iHashContext, IMESSAGE_DELETEATTRIBUTE, NULL,
 					 CRYPT_CTXINFO_HASHVALUE );
-	krnlSendMessage( iHashContext, IMESSAGE_CTX_HASH, buffer, length );
-	if( dataLength > 0 )
-		{
-		krnlSendMessage( iHashContext, IMESSAGE_CTX_HASH, 
-						 ( MESSAGE_CAST ) data, dataLength );
-		}
-	return( krnlSendMessage( iHashContext, IMESSAGE_CTX_HASH, "", 0 ) );
+	return( krnlSendMessage( iHashContext, IMESSAGE_CTX_HASH, buffer, 
+							 length ) );
 	}
 
-CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
-int createMacTLS( INOUT SESSION_INFO *sessionInfoPtr, 
-				  INOUT_BUFFER( dataMaxLength, *dataLength ) void *data, 
-				  IN_DATALENGTH const int dataMaxLength, 
-				  OUT_DATALENGTH_Z int *dataLength,
-				  IN_DATALENGTH const int payloadLength, 
-				  IN_RANGE( 0, 255 ) const int type )
+CHECK_RETVAL \
+static int macDataTLS( IN_HANDLE const CRYPT_CONTEXT iHashContext, 
+					   IN_INT_Z const long seqNo, 
+					   IN_RANGE( SSL_MINOR_VERSION_TLS, \
+								 SSL_MINOR_VERSION_TLS12 ) const int version,
+					   IN_BUFFER_OPT( dataLength ) const void *data, 
+					   IN_DATALENGTH_Z const int dataLength, 
+					   IN_RANGE( 0, 255 ) const int type )
 	{
-	SSL_INFO *sslInfo = sessionInfoPtr->sessionSSL;
-	MESSAGE_DATA msgData;
 	int status;
 
-	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
-	assert( isWritePtrDynamic( data, dataMaxLength ) );
-	assert( isWritePtr( dataLength, sizeof( int ) ) );
-
-	REQUIRES( dataMaxLength > 0 && dataMaxLength < MAX_BUFFER_SIZE );
-	REQUIRES( payloadLength > 0 && payloadLength <= MAX_PACKET_SIZE && \
-			  payloadLength + sessionInfoPtr->authBlocksize <= dataMaxLength );
-	REQUIRES( type >= 0 && type <= 255 );
-
-	/* Clear return values */
-	*dataLength = 0;
+	assert( ( data == NULL && dataLength == 0 ) || \
+			isReadPtrDynamic( data, dataLength ) );
 
-	/* MAC the payload.  When wrapping a packet the IV is treaded as part of
-	   the payload so it's always passed in as { NULL, 0 }, it's only when
-	   unwrapping that it's stripped before the payload data is copied into
-	   the session buffer and so needs to be passed in explicitly */
-	status = macDataTLS( sessionInfoPtr->iAuthOutContext, sslInfo->writeSeqNo,
-						 sessionInfoPtr->version, NULL, 0, data, 
-						 payloadLength, type );
-	if( cryptStatusError( status ) )
-		return( status );
-	sslInfo->writeSeqNo++;
+	REQUIRES( isHandleRangeValid( iHashContext ) );
+	REQUIRES( ( data == NULL && dataLength == 0 ) || \
+			  ( data != NULL && \
+				dataLength > 0 && dataLength <= MAX_PACKET_SIZE ) );
 
-	/* Append the MAC value to the end of the packet */
-	ENSURES( rangeCheck( payloadLength, sessionInfoPtr->authBlocksize,
-						 dataMaxLength ) );
-	setMessageData( &msgData, ( BYTE * ) data + payloadLength,
-					sessionInfoPtr->authBlocksize );
-	status = krnlSendMessage( sessionInfoPtr->iAuthOutContext, 
-							  IMESSAGE_GETATTRIBUTE_S, &msgData, 
-							  CRYPT_CTXINFO_HASHVALUE );
+	/* MAC the metadata followed by the payload data */
+	status = macDataStartTLS( iHashContext, seqNo, version, NULL, 0, 
+							  dataLength, type );
 	if( cryptStatusError( status ) )
 		return( status );
-	*dataLength = payloadLength + msgData.length;
-	INJECT_FAULT( SESSION_CORRUPT_MAC, SESSION_CORRUPT_MAC_SSL_1 );
-
-	return( CRYPT_OK );
+	if( dataLength > 0 )
+		{
+		krnlSendMessage( iHashContext, IMESSAGE_CTX_HASH, 
+						 ( MESSAGE_CAST ) data, dataLength );
+		}
+	return( krnlSendMessage( iHashContext, IMESSAGE_CTX_HASH, "", 0 ) );
 	}
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
@@ -666,8 +701,7 @@ int checkMacTLS( INOUT SESSION_INFO *sessionInfoPtr,
 	{
 	SSL_INFO *sslInfo = sessionInfoPtr->sessionSSL;
 	MESSAGE_DATA msgData;
-	const void *ivPtr = NULL;
-	int ivLength = 0, status;
+	int status;
 
 	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
 	assert( isReadPtrDynamic( data, dataLength ) );
@@ -682,25 +716,17 @@ int checkMacTLS( INOUT SESSION_INFO *sessionInfoPtr,
 	   payload, this can happen with some versions of OpenSSL that send 
 	   zero-length blocks as a kludge to work around pre-TLS 1.1 chosen-IV
 	   attacks */
-	if( ( sessionInfoPtr->protocolFlags & SSL_PFLAG_ENCTHENMAC ) && \
-		sslInfo->ivSize > 0 )
-		{
-		/* When using encrypt-then-MAC and TLS 1.1+ explicit IVs, the IV is
-		   authenticated alongside the encrypted payload data */
-		ivPtr = sslInfo->iv;
-		ivLength = sslInfo->ivSize;
-		}
 	if( payloadLength <= 0 )
 		{
 		status = macDataTLS( sessionInfoPtr->iAuthInContext, 
 							 sslInfo->readSeqNo, sessionInfoPtr->version, 
-							 ivPtr, ivLength, NULL, 0, type );
+							 NULL, 0, type );
 		}
 	else
 		{
 		status = macDataTLS( sessionInfoPtr->iAuthInContext, 
 							 sslInfo->readSeqNo, sessionInfoPtr->version, 
-							 ivPtr, ivLength, data, payloadLength, type );
+							 data, payloadLength, type );
 		}
 	if( cryptStatusError( status ) )
 		return( status );
@@ -733,17 +759,351 @@ int checkMacTLS( INOUT SESSION_INFO *sessionInfoPtr,
 
 /****************************************************************************
 *																			*
-*								TLS GCM Functions							*
+*						TLS Stitched Encrypt/MAC Functions					*
+*																			*
+****************************************************************************/
+
+/* With non-AEAD cipher suites each record has to be both en/decrypted and 
+   MAC'd, and doing this as two separate passes over a 16kB record means 
+   that by the time that the second pass gets to the start of the record 
+   the first pass has pushed it out of the L1 cache.  To avoid this we 
+   stitch the two operations together, processing the record in chunks 
+   that are en/decrypted and MAC'd back-to-back so that the second 
+   operation always works on data that the first one has just touched.  
+   The chunk size has to be a multiple of the cipher block size, and is 
+   small enough that a chunk and the cipher and hash state stay resident in 
+   L1 while being large enough to amortise the per-message overhead and to 
+   keep the AES-NI multi-block kernels busy */
+
+#define STITCH_CHUNK_SIZE		4096
+
+/* En/decrypt and MAC a block of data for encrypt-then-MAC.  Since the MAC 
+   is over the ciphertext, when encrypting we encrypt each chunk and then
+   MAC it and when decrypting we MAC each chunk and then decrypt it.  The 
+   MAC has already been started via macDataStartTLS() and is wrapped up 
+   once all of the data has been processed */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 3 ) ) \
+static int cryptMacData( IN_HANDLE const CRYPT_CONTEXT iCryptContext, 
+						 IN_HANDLE const CRYPT_CONTEXT iHashContext,
+						 INOUT_BUFFER_FIXED( dataLength ) BYTE *data, 
+						 IN_DATALENGTH const int dataLength,
+						 const BOOLEAN isEncrypt )
+	{
+	int offset, LOOP_ITERATOR;
+
+	assert( isWritePtrDynamic( data, dataLength ) );
+
+	REQUIRES( isHandleRangeValid( iCryptContext ) );
+	REQUIRES( isHandleRangeValid( iHashContext ) );
+	REQUIRES( dataLength > 0 && dataLength < MAX_BUFFER_SIZE );
+	REQUIRES( isEncrypt == TRUE || isEncrypt == FALSE );
+
+	LOOP_MED( offset = 0, offset < dataLength, 
+			  offset += STITCH_CHUNK_SIZE )
+		{
+		const int chunkLength = min( dataLength - offset, 
+									 STITCH_CHUNK_SIZE );
+		int status;
+
+		if( isEncrypt )
+			{
+			status = krnlSendMessage( iCryptContext, IMESSAGE_CTX_ENCRYPT, 
+									  data + offset, chunkLength );
+			if( cryptStatusOK( status ) )
+				{
+				status = krnlSendMessage( iHashContext, IMESSAGE_CTX_HASH, 
+										  data + offset, chunkLength );
+				}
+			}
+		else
+			{
+			status = krnlSendMessage( iHashContext, IMESSAGE_CTX_HASH, 
+									  data + offset, chunkLength );
+			if( cryptStatusOK( status ) )
+				{
+				status = krnlSendMessage( iCryptContext, IMESSAGE_CTX_DECRYPT, 
+										  data + offset, chunkLength );
+				}
+			}
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	/* Wrap up the MAC'ing */
+	return( krnlSendMessage( iHashContext, IMESSAGE_CTX_HASH, "", 0 ) );
+	}
+
+/* MAC, pad, and encrypt a TLS record for MAC-then-encrypt.  The input is 
+   { data, ivLength + payloadLength } where the optional IV is encrypted 
+   as part of the data and the payload is MAC'd.  Encryption lags the 
+   MAC'ing by up to one cipher block since the final partial block of the 
+   payload can only be encrypted once the MAC value and padding have been 
+   appended to it */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+int macEncryptDataTLS( INOUT SESSION_INFO *sessionInfoPtr, 
+					   INOUT_BUFFER( dataMaxLength, *dataLength ) \
+							BYTE *data, 
+					   IN_DATALENGTH const int dataMaxLength, 
+					   OUT_DATALENGTH_Z int *dataLength,
+					   IN_LENGTH_IV_Z const int ivLength,
+					   IN_DATALENGTH_Z const int payloadLength, 
+					   IN_RANGE( 0, 255 ) const int type )
+	{
+	SSL_INFO *sslInfo = sessionInfoPtr->sessionSSL;
+	MESSAGE_DATA msgData;
+	const int blockSize = max( sessionInfoPtr->cryptBlocksize, 1 );
+	BYTE *payloadPtr = data + ivLength;
+	int cryptOffset = 0, macOffset, length, status, LOOP_ITERATOR;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtrDynamic( data, dataMaxLength ) );
+	assert( isWritePtr( dataLength, sizeof( int ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( dataMaxLength > 0 && dataMaxLength < MAX_BUFFER_SIZE );
+	REQUIRES( ivLength >= 0 && ivLength <= CRYPT_MAX_IVSIZE && \
+			  ( ivLength % blockSize ) == 0 );
+	REQUIRES( payloadLength >= 0 && payloadLength <= MAX_PACKET_SIZE && \
+			  ivLength + payloadLength + \
+				sessionInfoPtr->authBlocksize < dataMaxLength );
+	REQUIRES( type >= 0 && type <= 255 );
+
+	/* Clear return value */
+	*dataLength = 0;
+
+	/* MAC each chunk of the payload and then encrypt all of the complete 
+	   cipher blocks, including the IV, that have been MAC'd so far.  The 
+	   IV is treated as part of the payload for encryption purposes but 
+	   isn't covered by the MAC */
+	status = macDataStartTLS( sessionInfoPtr->iAuthOutContext, 
+							  sslInfo->writeSeqNo, sessionInfoPtr->version, 
+							  NULL, 0, payloadLength, type );
+	if( cryptStatusError( status ) )
+		return( status );
+	LOOP_MED( macOffset = 0, macOffset < payloadLength, 
+			  macOffset += STITCH_CHUNK_SIZE )
+		{
+		const int chunkLength = min( payloadLength - macOffset, 
+									 STITCH_CHUNK_SIZE );
+		int cryptEnd;
+
+		status = krnlSendMessage( sessionInfoPtr->iAuthOutContext, 
+								  IMESSAGE_CTX_HASH, payloadPtr + macOffset, 
+								  chunkLength );
+		if( cryptStatusError( status ) )
+			return( status );
+		cryptEnd = ivLength + macOffset + chunkLength;
+		cryptEnd -= cryptEnd % blockSize;
+		if( cryptEnd > cryptOffset )
+			{
+			status = krnlSendMessage( sessionInfoPtr->iCryptOutContext,
+									  IMESSAGE_CTX_ENCRYPT, 
+									  data + cryptOffset, 
+									  cryptEnd - cryptOffset );
+			if( cryptStatusError( status ) )
+				return( status );
+			cryptOffset = cryptEnd;
+			}
+		}
+	ENSURES( LOOP_BOUND_OK );
+	status = krnlSendMessage( sessionInfoPtr->iAuthOutContext, 
+							  IMESSAGE_CTX_HASH, "", 0 );
+	if( cryptStatusError( status ) )
+		return( status );
+	sslInfo->writeSeqNo++;
+
+	/* Append the MAC value to the end of the payload */
+	setMessageData( &msgData, payloadPtr + payloadLength,
+					sessionInfoPtr->authBlocksize );
+	status = krnlSendMessage( sessionInfoPtr->iAuthOutContext, 
+							  IMESSAGE_GETATTRIBUTE_S, &msgData, 
+							  CRYPT_CTXINFO_HASHVALUE );
+	if( cryptStatusError( status ) )
+		return( status );
+	length = ivLength + payloadLength + msgData.length;
+	INJECT_FAULT( SESSION_CORRUPT_MAC, SESSION_CORRUPT_MAC_SSL_1 );
+
+	/* Pad the data if necessary and encrypt whatever's left */
+	if( sessionInfoPtr->cryptBlocksize > 1 )
+		{
+		status = addPadding( sessionInfoPtr, data, dataMaxLength, &length,
+							 length );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+	ENSURES( length > cryptOffset && length <= dataMaxLength );
+	status = krnlSendMessage( sessionInfoPtr->iCryptOutContext,
+							  IMESSAGE_CTX_ENCRYPT, data + cryptOffset, 
+							  length - cryptOffset );
+	if( cryptStatusError( status ) )
+		return( status );
+	*dataLength = length;
+
+	return( CRYPT_OK );
+	}
+
+/* Pad, encrypt, and MAC a TLS record for encrypt-then-MAC.  The input is 
+   { data, payloadLength } where the payload includes any explicit IV, 
+   which is encrypted and MAC'd as part of the data */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+int encryptMacDataTLS( INOUT SESSION_INFO *sessionInfoPtr, 
+					   INOUT_BUFFER( dataMaxLength, *dataLength ) \
+							BYTE *data, 
+					   IN_DATALENGTH const int dataMaxLength, 
+					   OUT_DATALENGTH_Z int *dataLength,
+					   IN_DATALENGTH const int payloadLength, 
+					   IN_RANGE( 0, 255 ) const int type )
+	{
+	SSL_INFO *sslInfo = sessionInfoPtr->sessionSSL;
+	MESSAGE_DATA msgData;
+	int length, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtrDynamic( data, dataMaxLength ) );
+	assert( isWritePtr( dataLength, sizeof( int ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( sessionInfoPtr->cryptBlocksize > 1 );
+	REQUIRES( dataMaxLength > 0 && dataMaxLength < MAX_BUFFER_SIZE );
+	REQUIRES( payloadLength > 0 && \
+			  payloadLength <= MAX_PACKET_SIZE + CRYPT_MAX_IVSIZE && \
+			  payloadLength < dataMaxLength );
+	REQUIRES( type >= 0 && type <= 255 );
+
+	/* Clear return value */
+	*dataLength = 0;
+
+	/* Pad the data and then encrypt and MAC it */
+	status = addPadding( sessionInfoPtr, data, dataMaxLength, &length,
+						 payloadLength );
+	if( cryptStatusError( status ) )
+		return( status );
+	REQUIRES( length + sessionInfoPtr->authBlocksize <= dataMaxLength );
+	status = macDataStartTLS( sessionInfoPtr->iAuthOutContext, 
+							  sslInfo->writeSeqNo, sessionInfoPtr->version, 
+							  NULL, 0, length, type );
+	if( cryptStatusOK( status ) )
+		{
+		status = cryptMacData( sessionInfoPtr->iCryptOutContext, 
+							   sessionInfoPtr->iAuthOutContext, data, 
+							   length, TRUE );
+		}
+	if( cryptStatusError( status ) )
+		return( status );
+	sslInfo->writeSeqNo++;
+
+	/* Append the MAC value to the end of the ciphertext */
+	setMessageData( &msgData, data + length, sessionInfoPtr->authBlocksize );
+	status = krnlSendMessage( sessionInfoPtr->iAuthOutContext, 
+							  IMESSAGE_GETATTRIBUTE_S, &msgData, 
+							  CRYPT_CTXINFO_HASHVALUE );
+	if( cryptStatusError( status ) )
+		return( status );
+	*dataLength = length + msgData.length;
+	INJECT_FAULT( SESSION_CORRUPT_MAC, SESSION_CORRUPT_MAC_SSL_1 );
+
+	return( CRYPT_OK );
+	}
+
+/* Check the MAC on, decrypt, and remove the padding from a TLS record for 
+   encrypt-then-MAC.  The input is { data, dataLength } consisting of the 
+   ciphertext followed by the MAC, with any explicit IV having already been 
+   stripped and stored in the SSL session information.  Since the MAC'ing 
+   and decryption are interleaved the data is decrypted before we know 
+   whether the MAC is valid, but none of it is used (in particular the 
+   padding isn't looked at) until the MAC has been verified so this 
+   doesn't provide any oracle to an attacker */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+int checkMacDecryptDataTLS( INOUT SESSION_INFO *sessionInfoPtr, 
+							INOUT_BUFFER_FIXED( dataLength ) BYTE *data, 
+							IN_DATALENGTH const int dataLength, 
+							OUT_DATALENGTH_Z int *processedDataLength,
+							IN_RANGE( 0, 255 ) const int type )
+	{
+	SSL_INFO *sslInfo = sessionInfoPtr->sessionSSL;
+	MESSAGE_DATA msgData;
+	const void *ivPtr = NULL;
+	const int length = dataLength - sessionInfoPtr->authBlocksize;
+	int ivLength = 0, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtrDynamic( data, dataLength ) );
+	assert( isWritePtr( processedDataLength, sizeof( int ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( sessionInfoPtr->cryptBlocksize > 1 );
+	REQUIRES( dataLength > 0 && dataLength < MAX_BUFFER_SIZE );
+	REQUIRES( length > 0 && length <= MAX_PACKET_SIZE + 256 && \
+			  ( length % sessionInfoPtr->cryptBlocksize ) == 0 );
+	REQUIRES( type >= 0 && type <= 255 );
+
+	/* Clear return value */
+	*processedDataLength = 0;
+
+	/* If we're using TLS 1.1+ explicit IVs then the IV is authenticated 
+	   alongside the encrypted payload data */
+	if( sslInfo->ivSize > 0 )
+		{
+		ivPtr = sslInfo->iv;
+		ivLength = sslInfo->ivSize;
+		}
+
+	/* MAC and decrypt the data */
+	status = macDataStartTLS( sessionInfoPtr->iAuthInContext, 
+							  sslInfo->readSeqNo, sessionInfoPtr->version, 
+							  ivPtr, ivLength, length, type );
+	if( cryptStatusOK( status ) )
+		{
+		status = cryptMacData( sessionInfoPtr->iCryptInContext, 
+							   sessionInfoPtr->iAuthInContext, data, 
+							   length, FALSE );
+		}
+	if( cryptStatusError( status ) )
+		{
+		retExt( status,
+				( status, SESSION_ERRINFO, 
+				  "Packet decryption failed" ) );
+		}
+	sslInfo->readSeqNo++;
+
+	/* Compare the calculated MAC to the MAC present at the end of the 
+	   data */
+	setMessageData( &msgData, data + length, sessionInfoPtr->authBlocksize );
+	status = krnlSendMessage( sessionInfoPtr->iAuthInContext, 
+							  IMESSAGE_COMPARE, &msgData, 
+							  MESSAGE_COMPARE_HASH );
+	if( cryptStatusError( status ) )
+		{
+		retExt( CRYPT_ERROR_SIGNATURE,
+				( CRYPT_ERROR_SIGNATURE, SESSION_ERRINFO, 
+				  "Bad message MAC for packet type %d, length %d",
+				  type, dataLength ) );
+		}
+
+	/* Now that we know that the data is authentic, remove the padding */
+	return( removePadding( sessionInfoPtr, data, length, 
+						   processedDataLength ) );
+	}
+
+/****************************************************************************
+*																			*
+*							TLS GCM/ChaCha20 Functions						*
 *																			*
 ****************************************************************************/
 
-#ifdef USE_GCM
+#if defined( USE_GCM ) || defined( USE_CHACHA20 )
 
 /* Perform a TLS GCM integrity check of a data block.  This differs somewhat
    from the more conventional MACing routines because GCM combines the ICV
    generation with encryption, so all that we're actually doing is 
    generating the initial stage of the ICV over the packet metadata handled
-   as GCM AAD */
+   as GCM AAD.  ChaCha20-Poly1305 uses the same AAD as GCM so we use this 
+   function for both */
 
 CHECK_RETVAL \
 int macDataTLSGCM( IN_HANDLE const CRYPT_CONTEXT iCryptContext, 
@@ -776,7 +1136,96 @@ int macDataTLSGCM( IN_HANDLE const CRYPT_CONTEXT iCryptContext,
 	return( krnlSendMessage( iCryptContext, IMESSAGE_SETATTRIBUTE_S,
 							 &msgData, CRYPT_IATTRIBUTE_AAD ) );
 	}
-#endif /* USE_GCM */
+#endif /* USE_GCM || USE_CHACHA20 */
+
+#ifdef USE_TLS13
+
+/* Process the TLS 1.3 additional data.  TLS 1.3 drops the sequence number 
+   and actual record type and length from the AAD and just authenticates 
+   the record header as it's sent on the wire (RFC 8446 section 5.2):
+
+	byte		type = SSL_MSG_APPLICATION_DATA
+	byte[2]		version = { 0x03, 0x03 }
+	uint16		length				-- Length of ciphertext + ICV */
+
+CHECK_RETVAL \
+int macDataTLS13( IN_HANDLE const CRYPT_CONTEXT iCryptContext, 
+				  IN_DATALENGTH const int recordLength )
+	{
+	MESSAGE_DATA msgData;
+	BYTE buffer[ SSL_HEADER_SIZE + 8 ];
+
+	REQUIRES( isHandleRangeValid( iCryptContext ) );
+	REQUIRES( recordLength > 0 && \
+			  recordLength <= MAX_PACKET_SIZE + 256 );
+
+	/* Set up the record header to be authenticated */
+	buffer[ 0 ] = SSL_MSG_APPLICATION_DATA;
+	buffer[ 1 ] = SSL_MAJOR_VERSION;
+	buffer[ 2 ] = SSL_MINOR_VERSION_TLS12;
+	buffer[ 3 ] = intToByte( recordLength >> 8 );
+	buffer[ 4 ] = intToByte( recordLength );
+
+	/* Send the AAD to the AEAD context for inclusion in the ICV 
+	   calculation */
+	setMessageData( &msgData, buffer, SSL_HEADER_SIZE );
+	return( krnlSendMessage( iCryptContext, IMESSAGE_SETATTRIBUTE_S,
+							 &msgData, CRYPT_IATTRIBUTE_AAD ) );
+	}
+#endif /* USE_TLS13 */
+
+#if defined( USE_CHACHA20 ) || defined( USE_TLS13 )
+
+/* Load the per-packet ChaCha20 nonce.  Unlike GCM there's no explicit 
+   nonce portion sent with the packet, instead the nonce is the implicit 
+   salt derived from the master secret XOR'd with the sequence number 
+   (RFC 7905 section 2).  TLS 1.3 uses the same nonce construction for all
+   AEAD ciphers, so this is also used for GCM with TLS 1.3 (RFC 8446 
+   section 5.3):
+
+	|<------- 12 bytes -------->|
+	+---------------------------+
+	|			Salt			|
+	+---------------------------+
+				XOR
+	+-------+-------------------+
+	| 0...0	|		seqNo		|
+	+-------+-------------------+
+	|<- 4 ->|<------ 8 -------->| */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+int loadNonceTLSChaCha20( IN_HANDLE const CRYPT_CONTEXT iCryptContext, 
+						  IN_BUFFER_C( CHACHA20_SALT_SIZE ) const BYTE *salt,
+						  IN_INT_Z const long seqNo )
+	{
+	STREAM stream;
+	MESSAGE_DATA msgData;
+	BYTE nonce[ CHACHA20_SALT_SIZE + 8 ];
+	int i, status, LOOP_ITERATOR;
+
+	assert( isReadPtr( salt, CHACHA20_SALT_SIZE ) );
+
+	REQUIRES( isHandleRangeValid( iCryptContext ) );
+	REQUIRES( seqNo >= 0 );
+
+	/* Set up the nonce from the salt and sequence number */
+	memset( nonce, 0, CHACHA20_SALT_SIZE );
+	sMemOpen( &stream, nonce + CHACHA20_SALT_SIZE - UINT64_SIZE, 
+			  UINT64_SIZE );
+	status = writeUint64( &stream, seqNo );
+	sMemDisconnect( &stream );
+	ENSURES( cryptStatusOK( status ) );
+	LOOP_MED( i = 0, i < CHACHA20_SALT_SIZE, i++ )
+		nonce[ i ] ^= salt[ i ];
+	ENSURES( LOOP_BOUND_OK );
+
+	/* Load the nonce into the context, which also resets the Poly1305 
+	   state for the new packet */
+	setMessageData( &msgData, nonce, CHACHA20_SALT_SIZE );
+	return( krnlSendMessage( iCryptContext, IMESSAGE_SETATTRIBUTE_S,
+							 &msgData, CRYPT_CTXINFO_IV ) );
+	}
+#endif /* USE_CHACHA20 || USE_TLS13 */
 
 /****************************************************************************
 *																			*
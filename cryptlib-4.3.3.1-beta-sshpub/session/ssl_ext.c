@@ -10,11 +10,13 @@
   #include "misc_rw.h"
   #include "session.h"
   #include "ssl.h"
+  #include "stapling.h"
 #else
   #include "crypt.h"
   #include "enc_dec/misc_rw.h"
   #include "session/session.h"
   #include "session/ssl.h"
+  #include "session/stapling.h"
 #endif /* Compiler-specific includes */
 
 #ifdef USE_SSL
@@ -275,6 +277,71 @@ static const EXT_CHECK_INFO extCheckInfoTbl[] = {
 	  TYPENAME( "session ticket" ) },
 #endif /* CONFIG_CONSERVE_MEMORY */
 
+#ifdef USE_TLS13
+	/* TLS 1.3 pre-shared key, RFC 8446.  The client sends a list of
+	   identities and binders, the server returns the index of the selected
+	   identity:
+
+		uint16		identityListLength
+			uint16	identityLength
+				byte[]	identity
+			uint32	obfuscatedTicketAge
+		uint16		binderListLength
+			uint8	binderLength
+				byte[]	binder
+
+		uint16		selectedIdentity */
+	{ TLS_EXT_PRE_SHARED_KEY,
+	  UINT16_SIZE + UINT16_SIZE + 1 + UINT32_SIZE + UINT16_SIZE + 1 + 32,
+	  UINT16_SIZE, 8192
+	  TYPENAME( "pre-shared key" ) },
+
+	/* TLS 1.3 early data indication, RFC 8446:
+
+		uint32		maxEarlyDataSize (new session ticket only) */
+	{ TLS_EXT_EARLY_DATA, 0, 0, UINT32_SIZE
+	  TYPENAME( "early data" ) },
+
+	/* TLS 1.3 supported versions, RFC 8446.  The client sends a list of
+	   versions, the server returns the selected one:
+
+		uint8		versionListLength
+			uint16	version
+
+		uint16		selectedVersion */
+	{ TLS_EXT_SUPPORTED_VERSIONS, 1 + UINT16_SIZE, UINT16_SIZE, 255
+	  TYPENAME( "supported versions" ) },
+
+	/* TLS 1.3 cookie, RFC 8446:
+
+		uint16		cookieLength
+			byte[]	cookie */
+	{ TLS_EXT_COOKIE, UINT16_SIZE + 1, UINT16_SIZE + 1, 8192
+	  TYPENAME( "cookie" ) },
+
+	/* TLS 1.3 PSK keyex modes, RFC 8446:
+
+		uint8		modeListLength
+			byte[]	modes */
+	{ TLS_EXT_PSK_KEX_MODES, 1 + 1, CRYPT_ERROR, 255
+	  TYPENAME( "PSK keyex modes" ) },
+
+	/* TLS 1.3 key share, RFC 8446.  The client sends a possibly-empty list
+	   of key shares, the server returns a single key share, or just the
+	   selected group in a HelloRetryRequest:
+
+		uint16		keyShareListLength
+			uint16	group
+			uint16	keyShareLength
+				byte[]	keyShare
+
+		uint16		group
+		uint16		keyShareLength
+			byte[]	keyShare */
+	{ TLS_EXT_KEY_SHARE, UINT16_SIZE, UINT16_SIZE, 8192
+	  TYPENAME( "key share" ) },
+#endif /* USE_TLS13 */
+
 	/* TLS 1.2 LTS, RFC xxxx */
 	{ TLS_EXT_TLS12LTS, 0, 0, 0
 	  TYPENAME( "TLS 1.2 LTS" ) },
@@ -389,17 +456,20 @@ static int processSNI( INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
    key that we use for signing, we require that the client report support 
    for the curve that matches our signing key.  Support for the 
    corresponding ECDH curve is automatic, since we support all curves for 
-   ECDH that are supported for ECDSA:
+   ECDH that are supported for ECDSA.  The exception to this is X25519, 
+   which can only be used for the keyex, so we record its presence 
+   separately from the curve used for signing:
 
 	uint16		namedCurveListLength
 	uint16[]	namedCurve */
 
-CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4, 5 ) ) \
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4, 5, 6 ) ) \
 static int processSupportedCurveID( INOUT SESSION_INFO *sessionInfoPtr, 
 									INOUT STREAM *stream, 
 									IN_LENGTH_SHORT_Z const int extLength,
 									OUT_ENUM_OPT( CRYPT_ECCCURVE ) \
 										CRYPT_ECCCURVE_TYPE *preferredCurveIdPtr,
+									OUT_BOOL BOOLEAN *x25519Supported,
 									OUT_BOOL BOOLEAN *extErrorInfoSet )
 	{
 	static const MAP_TABLE curveIDTbl[] = {
@@ -430,12 +500,14 @@ static int processSupportedCurveID( INOUT SESSION_INFO *sessionInfoPtr,
 	assert( isWritePtr( stream, sizeof( STREAM ) ) );
 	assert( isWritePtr( preferredCurveIdPtr, \
 						sizeof( CRYPT_ECCCURVE_TYPE ) ) );
+	assert( isWritePtr( x25519Supported, sizeof( BOOLEAN ) ) );
 
 	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
 	REQUIRES( extLength >= 0 && extLength < MAX_INTLENGTH_SHORT );
 
 	/* Clear return values */
 	*preferredCurveIdPtr = CRYPT_ECCCURVE_NONE;
+	*x25519Supported = FALSE;
 	*extErrorInfoSet = FALSE;
 
 	/* Get the size of the server's signing key to bound the curve size */
@@ -464,6 +536,21 @@ static int processSupportedCurveID( INOUT SESSION_INFO *sessionInfoPtr,
 			return( status );
 		if( value <= TLS_CURVE_NONE || value >= TLS_CURVE_LAST )
 			continue;	/* Unrecognised curve type */
+#ifdef USE_25519
+		if( value == TLS_CURVE_X25519 )
+			{
+			/* X25519 is only used for the keyex so it's not subject to 
+			   the signing-key match below.  Suite B mandates the use of 
+			   the NIST curves so we don't allow it there */
+#ifdef CONFIG_SUITEB
+			if( sessionInfoPtr->protocolFlags & SSL_PFLAG_SUITEB )
+				continue;
+#endif /* CONFIG_SUITEB */
+			if( algoAvailable( CRYPT_ALGO_25519 ) )
+				*x25519Supported = TRUE;
+			continue;
+			}
+#endif /* USE_25519 */
 		status = mapValue( value, &curveID, curveIDTbl, 
 						   FAILSAFE_ARRAYSIZE( curveIDTbl, MAP_TABLE ) );
 		if( cryptStatusError( status ) )
@@ -715,7 +802,296 @@ static int processSignatureAlgos( INOUT SESSION_INFO *sessionInfoPtr,
 #endif /* CONFIG_SUITEB */
 	}
 
-/* Process a single extension.  The internal structure of some of these 
+/* Process a TLS 1.3 extension.  If we're not doing TLS 1.3 then these are
+   simply skipped, which is what a pre-1.3 implementation would do with
+   them anyway */
+
+#ifdef USE_TLS13
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+static int processExtensionTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+								  INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+								  INOUT STREAM *stream,
+								  IN_RANGE( 0, 65536 ) const int type,
+								  IN_LENGTH_SHORT_Z const int extLength )
+	{
+	const BOOLEAN isServerSession = isServer( sessionInfoPtr ) ? \
+									TRUE : FALSE;
+	const int extStartPos = stell( stream );
+	BOOLEAN firstIdentity = TRUE;
+	int listLen, value, status, LOOP_ITERATOR;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( type >= 0 && type <= 65536 );
+	REQUIRES( extLength >= 0 && extLength < MAX_INTLENGTH_SHORT );
+
+	/* If we haven't enabled TLS 1.3 then there's nothing to do.  A server
+	   that doesn't know about TLS 1.3 should never send these to us as a
+	   client so if we get one anyway then it's an error */
+	if( handshakeInfo->originalVersion < SSL_MINOR_VERSION_TLS13 )
+		{
+		if( !isServerSession )
+			return( CRYPT_ERROR_BADDATA );
+		if( extLength <= 0 )
+			return( CRYPT_OK );
+		return( sSkip( stream, extLength, MAX_INTLENGTH_SHORT ) );
+		}
+
+	switch( type )
+		{
+		case TLS_EXT_SUPPORTED_VERSIONS:
+			/* If we're the client then the server has to have selected
+			   TLS 1.3, the only version that's ever negotiated through this
+			   extension */
+			if( !isServerSession )
+				{
+				if( extLength != UINT16_SIZE )
+					return( CRYPT_ERROR_BADDATA );
+				status = value = readUint16( stream );
+				if( cryptStatusError( status ) )
+					return( status );
+				if( value != ( ( SSL_MAJOR_VERSION << 8 ) | \
+							   SSL_MINOR_VERSION_TLS13 ) )
+					return( CRYPT_ERROR_BADDATA );
+				handshakeInfo->tls13VersionSeen = TRUE;
+
+				return( CRYPT_OK );
+				}
+
+			/* We're the server, look for TLS 1.3 in the client's version
+			   list */
+			status = listLen = sgetc( stream );
+			if( cryptStatusError( status ) )
+				return( status );
+			if( listLen != extLength - 1 || listLen < UINT16_SIZE || \
+				( listLen % UINT16_SIZE ) != 0 )
+				return( CRYPT_ERROR_BADDATA );
+			LOOP_MED_CHECKINC( listLen > 0, listLen -= UINT16_SIZE )
+				{
+				status = value = readUint16( stream );
+				if( cryptStatusError( status ) )
+					return( status );
+				if( value == ( ( SSL_MAJOR_VERSION << 8 ) | \
+							   SSL_MINOR_VERSION_TLS13 ) )
+					handshakeInfo->tls13VersionSeen = TRUE;
+				}
+			ENSURES( LOOP_BOUND_OK );
+
+			return( CRYPT_OK );
+
+		case TLS_EXT_KEY_SHARE:
+			/* If we're the client then we either get the server's key share
+			   or, in a HelloRetryRequest, the group that the server would
+			   like us to use.  Since the only group that we support is
+			   X25519, the only valid request is for X25519 when we haven't
+			   already sent a key share for it */
+			if( !isServerSession )
+				{
+				if( handshakeInfo->tls13Retry )
+					{
+					if( extLength != UINT16_SIZE )
+						return( CRYPT_ERROR_BADDATA );
+					status = value = readUint16( stream );
+					if( cryptStatusError( status ) )
+						return( status );
+					if( value != TLS_CURVE_X25519 || \
+						handshakeInfo->tls13KeyShareSent )
+						return( CRYPT_ERROR_NOTAVAIL );
+
+					return( CRYPT_OK );
+					}
+				if( extLength != UINT16_SIZE + UINT16_SIZE + 32 )
+					return( CRYPT_ERROR_BADDATA );
+				status = value = readUint16( stream );
+				if( !cryptStatusError( status ) && \
+					value != TLS_CURVE_X25519 )
+					status = CRYPT_ERROR_NOTAVAIL;
+				if( !cryptStatusError( status ) )
+					{
+					status = value = readUint16( stream );
+					if( !cryptStatusError( status ) && value != 32 )
+						status = CRYPT_ERROR_BADDATA;
+					}
+				if( cryptStatusError( status ) )
+					return( status );
+				status = sread( stream, handshakeInfo->tls13KeyShare, 32 );
+				if( cryptStatusError( status ) )
+					return( status );
+				handshakeInfo->tls13KeyShareLength = 32;
+
+				return( CRYPT_OK );
+				}
+
+			/* We're the server, look for an X25519 key share in the
+			   client's list.  If there isn't one then we have to send a
+			   HelloRetryRequest to ask for it */
+			status = listLen = readUint16( stream );
+			if( cryptStatusError( status ) )
+				return( status );
+			if( listLen != extLength - UINT16_SIZE )
+				return( CRYPT_ERROR_BADDATA );
+			LOOP_MED_CHECK( listLen > 0 )
+				{
+				int group, keyShareLength;
+
+				if( listLen < UINT16_SIZE + UINT16_SIZE + 1 )
+					return( CRYPT_ERROR_BADDATA );
+				group = readUint16( stream );
+				status = keyShareLength = readUint16( stream );
+				if( cryptStatusError( status ) )
+					return( status );
+				if( keyShareLength < 1 || \
+					keyShareLength > listLen - ( UINT16_SIZE + UINT16_SIZE ) )
+					return( CRYPT_ERROR_BADDATA );
+				listLen -= UINT16_SIZE + UINT16_SIZE + keyShareLength;
+				if( group != TLS_CURVE_X25519 || keyShareLength != 32 || \
+					handshakeInfo->tls13KeyShareLength > 0 )
+					{
+					status = sSkip( stream, keyShareLength,
+									MAX_INTLENGTH_SHORT );
+					if( cryptStatusError( status ) )
+						return( status );
+					continue;
+					}
+				status = sread( stream, handshakeInfo->tls13KeyShare, 32 );
+				if( cryptStatusError( status ) )
+					return( status );
+				handshakeInfo->tls13KeyShareLength = 32;
+				}
+			ENSURES( LOOP_BOUND_OK );
+
+			return( CRYPT_OK );
+
+		case TLS_EXT_COOKIE:
+			/* We never send cookies as the server so there's nothing to
+			   process there, as the client we have to echo the server's
+			   cookie back to it in the second client hello */
+			status = listLen = readUint16( stream );
+			if( cryptStatusError( status ) )
+				return( status );
+			if( listLen != extLength - UINT16_SIZE || listLen < 1 )
+				return( CRYPT_ERROR_BADDATA );
+			if( isServerSession || listLen > 512 )
+				return( sSkip( stream, listLen, MAX_INTLENGTH_SHORT ) );
+			status = sread( stream, handshakeInfo->tls13Cookie, listLen );
+			if( cryptStatusError( status ) )
+				return( status );
+			handshakeInfo->tls13CookieLength = listLen;
+
+			return( CRYPT_OK );
+
+		case TLS_EXT_PSK_KEX_MODES:
+			/* The only mode that we allow is PSK with (EC)DHE, the client
+			   can only use a ticket that we issued to it if it permits this
+			   mode */
+			status = listLen = sgetc( stream );
+			if( cryptStatusError( status ) )
+				return( status );
+			if( listLen != extLength - 1 || listLen < 1 )
+				return( CRYPT_ERROR_BADDATA );
+			LOOP_MED_CHECKINC( listLen > 0, listLen-- )
+				{
+				status = value = sgetc( stream );
+				if( cryptStatusError( status ) )
+					return( status );
+				if( value == 1 )	/* psk_dhe_ke */
+					handshakeInfo->tls13PskModeOK = TRUE;
+				}
+			ENSURES( LOOP_BOUND_OK );
+
+			return( CRYPT_OK );
+
+		case TLS_EXT_PRE_SHARED_KEY:
+			/* If we're the client then the server has to have selected the
+			   one and only PSK identity that we sent */
+			if( !isServerSession )
+				{
+				if( extLength != UINT16_SIZE || \
+					handshakeInfo->tls13PskIdentityLength <= 0 )
+					return( CRYPT_ERROR_BADDATA );
+				status = value = readUint16( stream );
+				if( cryptStatusError( status ) )
+					return( status );
+				if( value != 0 )
+					return( CRYPT_ERROR_BADDATA );
+				handshakeInfo->tls13PskAccepted = TRUE;
+
+				return( CRYPT_OK );
+				}
+
+			/* We're the server, remember the first identity, which is the
+			   only one that could have been issued by us, and the position
+			   of the binders so that we can check the binder for it later
+			   once the hello has been hashed.  Since the binder covers the
+			   client hello up to the binder list, this extension has to be
+			   the last one in the hello, which is checked by the caller */
+			status = listLen = readUint16( stream );
+			if( cryptStatusError( status ) )
+				return( status );
+			if( listLen < UINT16_SIZE + 1 + UINT32_SIZE || \
+				listLen > extLength - ( UINT16_SIZE + UINT16_SIZE + 1 + 32 ) )
+				return( CRYPT_ERROR_BADDATA );
+			LOOP_MED_CHECK( listLen > 0 )
+				{
+				int identityLength;
+
+				if( listLen < UINT16_SIZE + 1 + UINT32_SIZE )
+					return( CRYPT_ERROR_BADDATA );
+				status = identityLength = readUint16( stream );
+				if( cryptStatusError( status ) )
+					return( status );
+				if( identityLength < 1 || \
+					identityLength > listLen - ( UINT16_SIZE + UINT32_SIZE ) )
+					return( CRYPT_ERROR_BADDATA );
+				if( !firstIdentity || identityLength > 512 )
+					{
+					status = sSkip( stream, identityLength + UINT32_SIZE,
+									MAX_INTLENGTH_SHORT );
+					}
+				else
+					{
+					status = sread( stream, handshakeInfo->tls13PskIdentity,
+									identityLength );
+					if( cryptStatusOK( status ) )
+						{
+						/* We don't check the ticket age, which is a full 
+						   32-bit value that can't be read with 
+						   readUint32(), so we just skip it */
+						handshakeInfo->tls13PskIdentityLength = identityLength;
+						status = sSkip( stream, UINT32_SIZE, 
+										MAX_INTLENGTH_SHORT );
+						}
+					}
+				if( cryptStatusError( status ) )
+					return( status );
+				listLen -= UINT16_SIZE + identityLength + UINT32_SIZE;
+				firstIdentity = FALSE;
+				}
+			ENSURES( LOOP_BOUND_OK );
+
+			/* Remember where the binders start and skip them */
+			handshakeInfo->tls13BinderOffset = stell( stream );
+			status = listLen = readUint16( stream );
+			if( cryptStatusError( status ) )
+				return( status );
+			if( listLen < 1 + 32 || \
+				listLen != extLength - ( stell( stream ) - extStartPos ) )
+				return( CRYPT_ERROR_BADDATA );
+			return( sSkip( stream, listLen, MAX_INTLENGTH_SHORT ) );
+		}
+
+	/* It's some other TLS 1.3 extension, skip it */
+	if( extLength <= 0 )
+		return( CRYPT_OK );
+	return( sSkip( stream, extLength, MAX_INTLENGTH_SHORT ) );
+	}
+#endif /* USE_TLS13 */
+
+/* Process a single extension.  The internal structure of some of these
    things shows that they were created by ASN.1 people... */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3, 6 ) ) \
@@ -772,10 +1148,12 @@ static int processExtension( INOUT SESSION_INFO *sessionInfoPtr,
 		case TLS_EXT_ELLIPTIC_CURVES:
 			{
 			CRYPT_ECCCURVE_TYPE preferredCurveID;
+			BOOLEAN x25519Supported;
 
 			/* Read and process the list of preferred curves */
 			status = processSupportedCurveID( sessionInfoPtr, stream,
 											  extLength, &preferredCurveID,
+											  &x25519Supported,
 											  extErrorInfoSet );
 			if( cryptStatusError( status ) )
 				return( status );
@@ -794,6 +1172,11 @@ static int processExtension( INOUT SESSION_INFO *sessionInfoPtr,
 			else
 				handshakeInfo->eccCurveID = preferredCurveID;
 
+			/* If the client supports X25519, use it in preference to the
+			   NIST/Brainpool curves for the keyex */
+			if( x25519Supported )
+				handshakeInfo->useX25519 = TRUE;
+
 			return( CRYPT_OK );
 			}
 
@@ -875,6 +1258,73 @@ static int processExtension( INOUT SESSION_INFO *sessionInfoPtr,
 				handshakeInfo->needTLS12LTSResponse = TRUE;
 			return( CRYPT_OK );
 
+#ifdef USE_SSL_TICKETS
+		case TLS_EXT_SESSIONTICKET:
+			/* We only process session tickets if we're the server since we
+			   never ask for one as the client */
+			if( !isServer( sessionInfoPtr ) )
+				{
+				if( extLength > 0 )
+					{
+					status = sSkip( stream, extLength, MAX_INTLENGTH_SHORT );
+					if( cryptStatusError( status ) )
+						return( status );
+					}
+				return( CRYPT_OK );
+				}
+
+			/* The client supports session tickets, remember that we have 
+			   to issue it with one.  If it's sent us a ticket that could 
+			   be one of ours, remember it so that we can try and resume 
+			   the session with it */
+			handshakeInfo->needSessionTicketResponse = TRUE;
+			if( extLength <= 0 )
+				return( CRYPT_OK );
+			handshakeInfo->sessionTicketPresent = TRUE;
+			if( extLength != SSL_TICKET_SIZE )
+				return( sSkip( stream, extLength, MAX_INTLENGTH_SHORT ) );
+			status = sread( stream, handshakeInfo->sessionTicket, 
+							SSL_TICKET_SIZE );
+			if( cryptStatusError( status ) )
+				return( status );
+			handshakeInfo->sessionTicketLength = SSL_TICKET_SIZE;
+			return( CRYPT_OK );
+#endif /* USE_SSL_TICKETS */
+
+#ifdef USE_OCSP_STAPLING
+		case TLS_EXT_STATUS_REQUEST:
+			/* We only process status requests if we're the server since we
+			   never ask for one as the client */
+			if( !isServer( sessionInfoPtr ) )
+				return( sSkip( stream, extLength, MAX_INTLENGTH_SHORT ) );
+
+			/* The client would like a stapled OCSP response, remember that 
+			   we may have to provide it with one.  Whether we actually do 
+			   depends on whether we've got a current response available, 
+			   which is decided once we know whether it's a full handshake.  
+			   We ignore the responder ID list and request extensions, the 
+			   former because we always use the CA's responder and the 
+			   latter because the only extension in use is a nonce, which 
+			   can't be applied to a cached response */
+			value = sgetc( stream );
+			if( cryptStatusError( value ) )
+				return( value );
+			if( value == TLS_STATUSTYPE_OCSP )
+				handshakeInfo->needStatusResponse = TRUE;
+			return( sSkip( stream, extLength - 1, MAX_INTLENGTH_SHORT ) );
+#endif /* USE_OCSP_STAPLING */
+
+#ifdef USE_TLS13
+		case TLS_EXT_PRE_SHARED_KEY:
+		case TLS_EXT_EARLY_DATA:
+		case TLS_EXT_SUPPORTED_VERSIONS:
+		case TLS_EXT_COOKIE:
+		case TLS_EXT_PSK_KEX_MODES:
+		case TLS_EXT_KEY_SHARE:
+			return( processExtensionTLS13( sessionInfoPtr, handshakeInfo,
+										   stream, type, extLength ) );
+#endif /* USE_TLS13 */
+
 		default:
 			/* Default: Ignore the extension */
 			if( extLength > 0 )
@@ -1055,6 +1505,21 @@ int readExtensions( INOUT SESSION_INFO *sessionInfoPtr,
 					  "Invalid TLS extension data for extension "
 					  "type %d", type ) );
 			}
+#ifdef USE_TLS13
+		/* The TLS 1.3 PSK binders are calculated over the client hello up 
+		   to the binders, so the PSK extension has to be the last one in 
+		   the hello */
+		if( type == TLS_EXT_PRE_SHARED_KEY && \
+			isServer( sessionInfoPtr ) && \
+			handshakeInfo->originalVersion >= SSL_MINOR_VERSION_TLS13 && \
+			stell( stream ) < endPos )
+			{
+			retExt( CRYPT_ERROR_BADDATA,
+					( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
+					  "TLS %s extension isn't the last extension in the "
+					  "client hello", extCheckInfoPtr->description ) );
+			}
+#endif /* USE_TLS13 */
 		}
 	ENSURES( LOOP_BOUND_OK );
 	if( noExtensions >= MAX_EXTENSIONS )
@@ -1088,10 +1553,17 @@ int readExtensions( INOUT SESSION_INFO *sessionInfoPtr,
    We disallow SHA1 (except for DSA where it's needed due to the hardcoding
    into the signature format) since the whole point of TLS 1.2 was to move 
    away from it, and a poll on the ietf-tls list indicated that all known 
-   implementations (both of them) work fine with this configuration */
+   implementations (both of them) work fine with this configuration.
+
+   TLS 1.3 dispenses with the { hash, sig } pairs and replaces them with
+   opaque signature scheme values, which also rule out the use of PKCS #1
+   v1.5 signatures in the handshake, so if we're offering TLS 1.3 we also
+   have to include rsa_pss_rsae_sha256 (0x0804), whose value is chosen to
+   look like a { hash, sig } pair with an unknown hash algorithm to pre-1.3
+   implementations */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
-static int writeSigHashAlgoList( STREAM *stream )
+static int writeSigHashAlgoList( STREAM *stream, const BOOLEAN isTLS13 )
 	{
 	typedef struct {
 		CRYPT_ALGO_TYPE sigAlgo, hashAlgo;
@@ -1131,6 +1603,15 @@ static int writeSigHashAlgoList( STREAM *stream )
 	BYTE algoList[ 32 + 8 ];
 	int algoIndex = 0, i, LOOP_ITERATOR;
 
+#ifdef USE_TLS13
+	/* If we're using TLS 1.3, add the RSA-PSS signature scheme */
+	if( isTLS13 && algoAvailable( CRYPT_ALGO_RSA ) )
+		{
+		algoList[ algoIndex++ ] = 0x08;
+		algoList[ algoIndex++ ] = 0x04;
+		}
+#endif /* USE_TLS13 */
+
 	/* Determine which signature and hash algorithms are available for use */
 	LOOP_MED( i = 0, algoTbl[ i ].sigAlgo != CRYPT_ALGO_NONE && \
 					 i < FAILSAFE_ARRAYSIZE( algoTbl, SIG_HASH_INFO ), i++ )
@@ -1207,9 +1688,17 @@ static int writeServerName( INOUT STREAM *stream,
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
 int writeClientExtensions( INOUT STREAM *stream,
-						   INOUT SESSION_INFO *sessionInfoPtr )
+						   INOUT SESSION_INFO *sessionInfoPtr,
+						   INOUT SSL_HANDSHAKE_INFO *handshakeInfo )
 	{
 	STREAM nullStream;
+#ifdef USE_TLS13
+	const BOOLEAN isTLS13 = \
+		( sessionInfoPtr->version >= SSL_MINOR_VERSION_TLS13 ) ? TRUE : FALSE;
+	int tls13ExtLen = 0;
+#else
+	const BOOLEAN isTLS13 = FALSE;
+#endif /* USE_TLS13 */
 	const void *eccCurveInfoPtr DUMMY_INIT_PTR;
 	const BOOLEAN hasServerName = \
 				( findSessionInfo( sessionInfoPtr,
@@ -1221,6 +1710,7 @@ int writeClientExtensions( INOUT STREAM *stream,
 
 	assert( isWritePtr( stream, sizeof( STREAM ) ) );
 	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
 
 	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
 	REQUIRES( sessionInfoPtr->version >= SSL_MINOR_VERSION_TLS );
@@ -1247,7 +1737,7 @@ int writeClientExtensions( INOUT STREAM *stream,
 	if( sessionInfoPtr->version >= SSL_MINOR_VERSION_TLS12 )
 		{
 		sMemNullOpen( &nullStream );
-		status = writeSigHashAlgoList( &nullStream );
+		status = writeSigHashAlgoList( &nullStream, isTLS13 );
 		if( cryptStatusOK( status ) )
 			{
 			sigHashHdrLen = UINT16_SIZE + UINT16_SIZE;
@@ -1264,13 +1754,20 @@ int writeClientExtensions( INOUT STREAM *stream,
 		algoAvailable( CRYPT_ALGO_ECDSA ) )
 		{
 		static const BYTE eccCurveInfo[] = {
+#ifdef USE_25519
+			0, TLS_CURVE_X25519,
+#endif /* USE_25519 */
 			0, TLS_CURVE_BRAINPOOLP512R1, 0, TLS_CURVE_BRAINPOOLP384R1,
 			0, TLS_CURVE_BRAINPOOLP256R1,
 			0, TLS_CURVE_SECP521R1, 0, TLS_CURVE_SECP384R1, 
 			0, TLS_CURVE_SECP256R1, 0, TLS_CURVE_SECP224R1, 
 			0, TLS_CURVE_SECP192R1, 0, 0 
 			};
+#ifdef USE_25519
+		static const int eccCurveCount = 9;
+#else
 		static const int eccCurveCount = 8;
+#endif /* USE_25519 */
 
 #ifdef CONFIG_SUITEB
 		if( sessionInfoPtr->protocolFlags & SSL_PFLAG_SUITEB )
@@ -1319,13 +1816,58 @@ int writeClientExtensions( INOUT STREAM *stream,
 		eccInfoLen += UINT16_SIZE + UINT16_SIZE + 1 + 1;
 		}
 
+#ifdef USE_TLS13
+	/* TLS 1.3 information: the supported versions, the supported groups if
+	   they haven't already been sent as part of the ECC information, our
+	   X25519 key share, the PSK keyex modes, the HelloRetryRequest cookie 
+	   if there is one, and finally the PSK identity and binder if we're 
+	   trying to resume a previous session, which has to be the last 
+	   extension since the binder is calculated over the client hello up to 
+	   that point */
+	if( isTLS13 )
+		{
+		tls13ExtLen = UINT16_SIZE + UINT16_SIZE + 1 + UINT16_SIZE + \
+					  UINT16_SIZE;							/* Versions */
+		if( eccInfoLen <= 0 )
+			{
+			tls13ExtLen += UINT16_SIZE + UINT16_SIZE + \
+						   UINT16_SIZE + UINT16_SIZE;		/* Groups */
+			}
+		handshakeInfo->tls13KeyShareSent = TRUE;
+		INJECT_FAULT( SESSION_SSL_TLS13_NO_KEYSHARE, 
+					  SESSION_SSL_TLS13_NO_KEYSHARE_1 );
+		tls13ExtLen += UINT16_SIZE + UINT16_SIZE + UINT16_SIZE;
+		if( handshakeInfo->tls13KeyShareSent )
+			{
+			tls13ExtLen += UINT16_SIZE + UINT16_SIZE + 32;	/* Key share */
+			}
+		tls13ExtLen += UINT16_SIZE + UINT16_SIZE + 1 + 1;	/* PSK modes */
+		if( handshakeInfo->tls13CookieLength > 0 )
+			{
+			tls13ExtLen += UINT16_SIZE + UINT16_SIZE + UINT16_SIZE + \
+						   handshakeInfo->tls13CookieLength;	/* Cookie */
+			}
+		if( handshakeInfo->tls13PskIdentityLength > 0 )
+			{
+			tls13ExtLen += UINT16_SIZE + UINT16_SIZE + \
+						   UINT16_SIZE + UINT16_SIZE + \
+						   handshakeInfo->tls13PskIdentityLength + \
+						   UINT32_SIZE + UINT16_SIZE + 1 + 32;	/* PSK */
+			}
+		}
+#endif /* USE_TLS13 */
+
 	/* Write the list of extensions */
 	writeUint16( stream, serverNameHdrLen + serverNameExtLen + \
 						 RENEG_EXT_SIZE +					/* Renegotiation */
 						 ( UINT16_SIZE + UINT16_SIZE ) +	/* EncThenMAC */
 						 ( UINT16_SIZE + UINT16_SIZE ) +	/* Extended MS */
 						 ( UINT16_SIZE + UINT16_SIZE ) +	/* TLS 1.2 LTS */
-						 sigHashHdrLen + sigHashExtLen + eccInfoLen );
+						 sigHashHdrLen + sigHashExtLen + eccInfoLen
+#ifdef USE_TLS13
+						 + tls13ExtLen 
+#endif /* USE_TLS13 */
+						 );
 	if( hasServerName )
 		{
 		writeUint16( stream, TLS_EXT_SERVER_NAME );
@@ -1366,7 +1908,7 @@ int writeClientExtensions( INOUT STREAM *stream,
 		{
 		writeUint16( stream, TLS_EXT_SIGNATURE_ALGORITHMS );
 		writeUint16( stream, sigHashExtLen );
-		status = writeSigHashAlgoList( stream );
+		status = writeSigHashAlgoList( stream, isTLS13 );
 		if( cryptStatusError( status ) )
 			return( status );
 		DEBUG_PRINT(( "Wrote extension signature algorithm (%d), length %d.\n",
@@ -1400,6 +1942,127 @@ int writeClientExtensions( INOUT STREAM *stream,
 					  TLS_EXT_EC_POINT_FORMATS, 1 + 1 ));
 		DEBUG_DUMP_STREAM( stream, stell( stream ) - ( 1 + 1 ), 1 + 1 );
 		}
+#ifdef USE_TLS13
+	if( isTLS13 )
+		{
+		/* Write the supported versions extension, TLS 1.3 and TLS 1.2 */
+		writeUint16( stream, TLS_EXT_SUPPORTED_VERSIONS );
+		writeUint16( stream, 1 + UINT16_SIZE + UINT16_SIZE );
+		sputc( stream, UINT16_SIZE + UINT16_SIZE );
+		writeUint16( stream, ( SSL_MAJOR_VERSION << 8 ) | \
+							 SSL_MINOR_VERSION_TLS13 );
+		status = writeUint16( stream, ( SSL_MAJOR_VERSION << 8 ) | \
+									  SSL_MINOR_VERSION_TLS12 );
+		if( cryptStatusError( status ) )
+			return( status );
+		DEBUG_PRINT(( "Wrote extension supported versions (%d), length %d.\n",
+					  TLS_EXT_SUPPORTED_VERSIONS, 
+					  1 + UINT16_SIZE + UINT16_SIZE ));
+
+		/* Write the supported groups extension if it hasn't already been 
+		   written as part of the ECC information */
+		if( eccInfoLen <= 0 )
+			{
+			writeUint16( stream, TLS_EXT_ELLIPTIC_CURVES );
+			writeUint16( stream, UINT16_SIZE + UINT16_SIZE );
+			writeUint16( stream, UINT16_SIZE );
+			status = writeUint16( stream, TLS_CURVE_X25519 );
+			if( cryptStatusError( status ) )
+				return( status );
+			DEBUG_PRINT(( "Wrote extension ECC curve type (%d), length %d.\n",
+						  TLS_EXT_ELLIPTIC_CURVES, 
+						  UINT16_SIZE + UINT16_SIZE ));
+			}
+
+		/* Write the key share extension.  The key share list is normally 
+		   our X25519 key share, but for the fault-injection tests it can 
+		   be empty, in which case the server has to send a 
+		   HelloRetryRequest asking for it */
+		writeUint16( stream, TLS_EXT_KEY_SHARE );
+		if( handshakeInfo->tls13KeyShareSent )
+			{
+			writeUint16( stream, UINT16_SIZE + UINT16_SIZE + UINT16_SIZE + 32 );
+			writeUint16( stream, UINT16_SIZE + UINT16_SIZE + 32 );
+			writeUint16( stream, TLS_CURVE_X25519 );
+			writeUint16( stream, 32 );
+			status = swrite( stream, handshakeInfo->tls13LocalKeyShare, 32 );
+			}
+		else
+			{
+			writeUint16( stream, UINT16_SIZE );
+			status = writeUint16( stream, 0 );
+			}
+		if( cryptStatusError( status ) )
+			return( status );
+		DEBUG_PRINT(( "Wrote extension key share (%d), length %d.\n",
+					  TLS_EXT_KEY_SHARE, 
+					  handshakeInfo->tls13KeyShareSent ? \
+						UINT16_SIZE + UINT16_SIZE + UINT16_SIZE + 32 : \
+						UINT16_SIZE ));
+
+		/* Write the PSK keyex modes extension, PSK with (EC)DHE */
+		writeUint16( stream, TLS_EXT_PSK_KEX_MODES );
+		writeUint16( stream, 1 + 1 );
+		sputc( stream, 1 );
+		status = sputc( stream, 1 );
+		if( cryptStatusError( status ) )
+			return( status );
+		DEBUG_PRINT(( "Wrote extension PSK keyex modes (%d), length %d.\n",
+					  TLS_EXT_PSK_KEX_MODES, 1 + 1 ));
+
+		/* Write the HelloRetryRequest cookie if there is one */
+		if( handshakeInfo->tls13CookieLength > 0 )
+			{
+			writeUint16( stream, TLS_EXT_COOKIE );
+			writeUint16( stream, UINT16_SIZE + \
+								 handshakeInfo->tls13CookieLength );
+			writeUint16( stream, handshakeInfo->tls13CookieLength );
+			status = swrite( stream, handshakeInfo->tls13Cookie, 
+							 handshakeInfo->tls13CookieLength );
+			if( cryptStatusError( status ) )
+				return( status );
+			DEBUG_PRINT(( "Wrote extension cookie (%d), length %d.\n",
+						  TLS_EXT_COOKIE, 
+						  UINT16_SIZE + handshakeInfo->tls13CookieLength ));
+			}
+
+		/* Write the PSK identity and a placeholder for the binder, which 
+		   is filled in once the rest of the client hello is complete */
+		if( handshakeInfo->tls13PskIdentityLength > 0 )
+			{
+			const int identityLength = \
+							handshakeInfo->tls13PskIdentityLength;
+			const unsigned long ticketAge = \
+					( unsigned long ) handshakeInfo->tls13PskObfuscatedAge;
+			BYTE binderPlaceholder[ 32 + 8 ], ticketAgeBuffer[ UINT32_SIZE + 8 ];
+
+			writeUint16( stream, TLS_EXT_PRE_SHARED_KEY );
+			writeUint16( stream, UINT16_SIZE + UINT16_SIZE + \
+								 identityLength + UINT32_SIZE + \
+								 UINT16_SIZE + 1 + 32 );
+			writeUint16( stream, UINT16_SIZE + identityLength + \
+								 UINT32_SIZE );
+			writeUint16( stream, identityLength );
+			swrite( stream, handshakeInfo->tls13PskIdentity, 
+					identityLength );
+			ticketAgeBuffer[ 0 ] = intToByte( ( ticketAge >> 24 ) & 0xFF );
+			ticketAgeBuffer[ 1 ] = intToByte( ( ticketAge >> 16 ) & 0xFF );
+			ticketAgeBuffer[ 2 ] = intToByte( ( ticketAge >> 8 ) & 0xFF );
+			ticketAgeBuffer[ 3 ] = intToByte( ticketAge & 0xFF );
+			swrite( stream, ticketAgeBuffer, UINT32_SIZE );
+			writeUint16( stream, 1 + 32 );
+			sputc( stream, 32 );
+			memset( binderPlaceholder, 0, 32 );
+			status = swrite( stream, binderPlaceholder, 32 );
+			if( cryptStatusError( status ) )
+				return( status );
+			DEBUG_PRINT(( "Wrote extension pre-shared key (%d), length %d.\n",
+						  TLS_EXT_PRE_SHARED_KEY, 
+						  UINT16_SIZE + UINT16_SIZE + identityLength + \
+						  UINT32_SIZE + UINT16_SIZE + 1 + 32 ));
+			}
+		}
+#endif /* USE_TLS13 */
 
 	return( CRYPT_OK );
 	}
@@ -1427,6 +2090,10 @@ int writeServerExtensions( INOUT STREAM *stream,
 		extListLen += UINT16_SIZE + UINT16_SIZE;
 	if( handshakeInfo->needTLS12LTSResponse )
 		extListLen += UINT16_SIZE + UINT16_SIZE;
+	if( handshakeInfo->needSessionTicketResponse )
+		extListLen += UINT16_SIZE + UINT16_SIZE;
+	if( handshakeInfo->needStatusResponse )
+		extListLen += UINT16_SIZE + UINT16_SIZE;
 	if( extListLen <= 0 )
 		{
 		/* No extensions to write, we're done */
@@ -1499,6 +2166,32 @@ int writeServerExtensions( INOUT STREAM *stream,
 					  TLS_EXT_TLS12LTS, 0 ));
 		}
 
+	/* If the client indicated support for session tickets, let it know 
+	   that we'll be sending it a new one once it's completed its side of 
+	   the handshake */
+	if( handshakeInfo->needSessionTicketResponse )
+		{
+		writeUint16( stream, TLS_EXT_SESSIONTICKET );
+		status = writeUint16( stream, 0 );
+		if( cryptStatusError( status ) )
+			return( status );
+		DEBUG_PRINT(( "Wrote extension session ticket (%d), length 0.\n", 
+					  TLS_EXT_SESSIONTICKET, 0 ));
+		}
+
+	/* If the client asked for certificate status information and we have 
+	   an OCSP response to give it, let it know that it'll be getting it 
+	   in a CertificateStatus message following the certificate chain */
+	if( handshakeInfo->needStatusResponse )
+		{
+		writeUint16( stream, TLS_EXT_STATUS_REQUEST );
+		status = writeUint16( stream, 0 );
+		if( cryptStatusError( status ) )
+			return( status );
+		DEBUG_PRINT(( "Wrote extension OCSP status request (%d), "
+					  "length 0.\n", TLS_EXT_STATUS_REQUEST, 0 ));
+		}
+
 	/* If the client sent ECC extensions and we've negotiated an ECC cipher 
 	   suite, send back the appropriate response.  We don't have to send 
 	   back the curve ID that we've chosen because this is communicated 
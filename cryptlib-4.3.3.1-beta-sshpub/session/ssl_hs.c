@@ -69,15 +69,17 @@ static int processSessionID( INOUT SESSION_INFO *sessionInfoPtr,
 				  "Invalid session ID data" ) );
 		}
 
-	/* If we're the server and it's not (potentially) one of our sessionIDs, 
-	   we're done */
+	/* Remember the session ID.  If we're the server and it's not 
+	   (potentially) one of our sessionIDs then we're done, although we 
+	   still need to remember it because the client may be trying to resume 
+	   the session via a session ticket, in which case we have to echo the
+	   session ID back to it */
+	memcpy( handshakeInfo->sessionID, sessionID, sessionIDlength );
+	handshakeInfo->sessionIDlength = sessionIDlength;
 	if( isServer( sessionInfoPtr ) && sessionIDlength != SESSIONID_SIZE )
 		return( CRYPT_OK );
 
-	/* It's a potentially resumed session, remember the details and let the 
-	   caller know */
-	memcpy( handshakeInfo->sessionID, sessionID, sessionIDlength );
-	handshakeInfo->sessionIDlength = sessionIDlength;
+	/* It's a potentially resumed session, let the caller know */
 	return( OK_SPECIAL );
 	}
 
@@ -264,11 +266,15 @@ static int setSuiteInfo( INOUT SESSION_INFO *sessionInfoPtr,
 		}
 #endif /* USE_SSL3 */
 	sessionInfoPtr->authBlocksize = cipherSuiteInfoPtr->macBlockSize;
-	if( cipherSuiteInfoPtr->flags & CIPHERSUITE_FLAG_GCM )
+	if( cipherSuiteInfoPtr->flags & \
+			( CIPHERSUITE_FLAG_GCM | CIPHERSUITE_FLAG_CHACHA20 ) )
 		{
-		/* GCM is a stream cipher with special-case requirements */
+		/* GCM and ChaCha20-Poly1305 are stream ciphers with special-case 
+		   requirements */
 		sessionInfoPtr->cryptBlocksize = 1;
-		sessionInfoPtr->protocolFlags |= SSL_PFLAG_GCM;
+		sessionInfoPtr->protocolFlags |= \
+				( cipherSuiteInfoPtr->flags & CIPHERSUITE_FLAG_GCM ) ? \
+				SSL_PFLAG_GCM : SSL_PFLAG_CHACHA20;
 		}
 	else
 		{
@@ -302,6 +308,10 @@ static int processCipherSuite( INOUT SESSION_INFO *sessionInfoPtr,
 	BOOLEAN allowTLS12 = \
 		( sessionInfoPtr->version >= SSL_MINOR_VERSION_TLS12 ) ? TRUE : FALSE;
 	int cipherSuiteInfoSize, suiteIndex = 999, altSuiteIndex = 999;
+	int maxVersion = sessionInfoPtr->protocolInfo->maxVersion;
+#ifdef USE_TLS13
+	int tls13SuiteIndex = 999;
+#endif /* USE_TLS13 */
 	int i, status, LOOP_ITERATOR;
 
 	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
@@ -311,6 +321,13 @@ static int processCipherSuite( INOUT SESSION_INFO *sessionInfoPtr,
 	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
 	REQUIRES( noSuites > 0 && noSuites <= MAX_CIPHERSUITES );
 
+	/* TLS 1.3 is only used if it's been explicitly enabled, so unless 
+	   that's the case the highest version that a client could expect to 
+	   negotiate with us is TLS 1.2 */
+	if( handshakeInfo->originalVersion < SSL_MINOR_VERSION_TLS13 && \
+		maxVersion > SSL_MINOR_VERSION_TLS12 )
+		maxVersion = SSL_MINOR_VERSION_TLS12;
+
 	/* Get the information for the supported cipher suites */
 	status = getCipherSuiteInfo( &cipherSuiteInfo, &cipherSuiteInfoSize );
 	if( cryptStatusError( status ) )
@@ -415,8 +432,7 @@ static int processCipherSuite( INOUT SESSION_INFO *sessionInfoPtr,
 					   lower than what we'd normally be using, abort the
 					   handshake with an insecure-fallback alert */
 					if( isServer && \
-						handshakeInfo->clientOfferedVersion < \
-							sessionInfoPtr->protocolInfo->maxVersion )
+						handshakeInfo->clientOfferedVersion < maxVersion )
 						{
 						handshakeInfo->failAlertType = \
 											TLS_ALERT_INAPPROPRIATE_FALLBACK;
@@ -424,7 +440,7 @@ static int processCipherSuite( INOUT SESSION_INFO *sessionInfoPtr,
 								( CRYPT_ERROR_NOSECURE, SESSION_ERRINFO, 
 								  "Client attempted insecure falback from "
 								  "protocol version %d to version %d",
-								  sessionInfoPtr->protocolInfo->maxVersion,
+								  maxVersion,
 								  handshakeInfo->clientOfferedVersion ) );
 						}
 					break;
@@ -530,6 +546,25 @@ static int processCipherSuite( INOUT SESSION_INFO *sessionInfoPtr,
 			  !isKeyxAlgo( cipherSuiteInfoPtr->keyexAlgo ) ) ) 
 			continue;
 
+#ifdef USE_TLS13
+		/* TLS 1.3 suites can only be used if the peer also supports TLS 
+		   1.3, which we don't know until the hello extensions have been 
+		   processed, so we remember the most preferred one separately and 
+		   leave it to the caller to switch to it if required */
+		if( cipherSuiteInfoPtr->flags & CIPHERSUITE_FLAG_TLS13 )
+			{
+			if( handshakeInfo->originalVersion >= SSL_MINOR_VERSION_TLS13 && \
+				newSuiteIndex < tls13SuiteIndex )
+				{
+				tls13SuiteIndex = newSuiteIndex;
+				handshakeInfo->tls13SuiteInfoPtr = cipherSuiteInfoPtr;
+				DEBUG_PRINT(( "Accepted TLS 1.3 suite: %s.\n", 
+							  cipherSuiteInfoPtr->description ));
+				}
+			continue;
+			}
+#endif /* USE_TLS13 */
+
 		/* If the new suite is more preferred (i.e. with a lower index) than 
 		   the existing one, use that.  The presence of the ECC suites 
 		   significantly complicates this process because the ECC curve 
@@ -577,6 +612,12 @@ static int processCipherSuite( INOUT SESSION_INFO *sessionInfoPtr,
 	if( suiteIndex >= cipherSuiteInfoSize && \
 		altSuiteIndex >= cipherSuiteInfoSize )
 		{
+#ifdef USE_TLS13
+		/* If the only thing that we found was a TLS 1.3 suite then we can 
+		   only continue if TLS 1.3 is negotiated, let the caller know */
+		if( tls13SuiteIndex < cipherSuiteInfoSize )
+			return( OK_SPECIAL );
+#endif /* USE_TLS13 */
 		retExt( CRYPT_ERROR_NOTAVAIL,
 				( CRYPT_ERROR_NOTAVAIL, SESSION_ERRINFO, 
 				  "No encryption mechanism compatible with the remote "
@@ -634,6 +675,9 @@ int processHelloSSL( INOUT SESSION_INFO *sessionInfoPtr,
 					 const BOOLEAN isServer )
 	{
 	BOOLEAN potentiallyResumedSession = FALSE;
+#ifdef USE_TLS13
+	BOOLEAN tls13SuiteOnly = FALSE;
+#endif /* USE_TLS13 */
 	int endPos, length, suiteLength = 1, status;
 
 	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
@@ -713,6 +757,18 @@ int processHelloSSL( INOUT SESSION_INFO *sessionInfoPtr,
 		else
 			return( status );
 		}
+#ifdef USE_TLS13
+	/* If we're the client then a TLS 1.3 server hello may actually be a 
+	   HelloRetryRequest in disguise, indicated by the use of a special 
+	   fixed value in place of the nonce */
+	if( !isServer )
+		{
+		handshakeInfo->tls13Retry = \
+			( handshakeInfo->originalVersion >= SSL_MINOR_VERSION_TLS13 && \
+			  !memcmp( handshakeInfo->serverNonce, TLS13_HRR_NONCE, 
+					   SSL_NONCE_SIZE ) ) ? TRUE : FALSE;
+		}
+#endif /* USE_TLS13 */
 
 	/* Process the cipher suite information */
 	if( isServer )
@@ -739,6 +795,15 @@ int processHelloSSL( INOUT SESSION_INFO *sessionInfoPtr,
 		}
 	status = processCipherSuite( sessionInfoPtr, handshakeInfo, stream,
 								 suiteLength );
+#ifdef USE_TLS13
+	if( status == OK_SPECIAL )
+		{
+		/* The only usable suite is a TLS 1.3 one, whether we can continue
+		   is decided once we know whether TLS 1.3 is being used */
+		tls13SuiteOnly = TRUE;
+		status = CRYPT_OK;
+		}
+#endif /* USE_TLS13 */
 	if( cryptStatusError( status ) )
 		return( status );
 
@@ -793,6 +858,82 @@ int processHelloSSL( INOUT SESSION_INFO *sessionInfoPtr,
 		handshakeInfo->hasExtensions = TRUE;
 		}
 
+#ifdef USE_TLS13
+	/* If both sides have indicated support for TLS 1.3 and we've got a 
+	   TLS 1.3 suite to use, switch to TLS 1.3.  This replaces the TLS 1.2
+	   mechanisms like encrypt-then-MAC and the extended master secret, so 
+	   we turn these off again if they were selected via extensions */
+	if( handshakeInfo->tls13VersionSeen && \
+		handshakeInfo->tls13SuiteInfoPtr != NULL )
+		{
+		sessionInfoPtr->protocolFlags &= ~( SSL_PFLAG_AEAD | \
+											SSL_PFLAG_ENCTHENMAC | \
+											SSL_PFLAG_EMS | \
+											SSL_PFLAG_TLS12LTS );
+		status = setSuiteInfo( sessionInfoPtr, handshakeInfo, 
+							   handshakeInfo->tls13SuiteInfoPtr );
+		if( cryptStatusError( status ) )
+			return( status );
+		sessionInfoPtr->version = SSL_MINOR_VERSION_TLS13;
+		sessionInfoPtr->protocolFlags |= SSL_PFLAG_TLS13;
+		handshakeInfo->needEncThenMACResponse = \
+			handshakeInfo->needEMSResponse = \
+			handshakeInfo->needTLS12LTSResponse = \
+			handshakeInfo->needSessionTicketResponse = \
+			handshakeInfo->needStatusResponse = FALSE;
+		DEBUG_PRINT(( "Negotiated TLS 1.3.\n" ));
+		recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_HELLORECEIVED );
+
+		return( potentiallyResumedSession ? OK_SPECIAL : CRYPT_OK );
+		}
+
+	/* We're not using TLS 1.3, either because the peer doesn't support it
+	   or because there's no suitable TLS 1.3 suite, make sure that we can 
+	   continue with an earlier version.  If we're the client and the 
+	   server selected TLS 1.3 then it also has to select a TLS 1.3 suite */
+	if( tls13SuiteOnly || \
+		( !isServer && handshakeInfo->tls13VersionSeen ) )
+		{
+		retExt( CRYPT_ERROR_NOTAVAIL,
+				( CRYPT_ERROR_NOTAVAIL, SESSION_ERRINFO, 
+				  "No encryption mechanism compatible with the remote "
+				  "system could be found" ) );
+		}
+	if( !isServer && handshakeInfo->tls13Retry )
+		{
+		retExt( CRYPT_ERROR_BADDATA,
+				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
+				  "Server sent TLS 1.3 HelloRetryRequest without "
+				  "negotiating TLS 1.3" ) );
+		}
+	if( sessionInfoPtr->sessionSSL->minVersion >= SSL_MINOR_VERSION_TLS13 )
+		{
+		retExt( CRYPT_ERROR_NOSECURE,
+				( CRYPT_ERROR_NOSECURE, SESSION_ERRINFO, 
+				  "Remote system doesn't support TLS 1.3" ) );
+		}
+	if( sessionInfoPtr->version > SSL_MINOR_VERSION_TLS12 )
+		sessionInfoPtr->version = SSL_MINOR_VERSION_TLS12;
+
+	/* If we're the client and asked for TLS 1.3, make sure that the server
+	   hasn't indicated that it also supports TLS 1.3, which means that 
+	   someone has interfered with our hello in order to force a downgrade 
+	   to an earlier version (RFC 8446 section 4.1.3) */
+	if( !isServer && \
+		handshakeInfo->originalVersion >= SSL_MINOR_VERSION_TLS13 && \
+		!memcmp( handshakeInfo->serverNonce + \
+					SSL_NONCE_SIZE - TLS13_DOWNGRADE_SENTINEL_SIZE, 
+				 TLS13_DOWNGRADE_SENTINEL, 
+				 TLS13_DOWNGRADE_SENTINEL_SIZE - 1 ) )
+		{
+		handshakeInfo->failAlertType = TLS_ALERT_ILLEGAL_PARAMETER;
+		retExt( CRYPT_ERROR_NOSECURE,
+				( CRYPT_ERROR_NOSECURE, SESSION_ERRINFO, 
+				  "Server indicated TLS 1.3 support but negotiated an "
+				  "earlier version, possible downgrade attack" ) );
+		}
+#endif /* USE_TLS13 */
+
 	/* If we're the server, perform any special-case handling required by 
 	   the fact that the selection of an ECC cipher suite can be 
 	   retroactively modified by by TLS extensions that disable its use
@@ -847,10 +988,10 @@ int processHelloSSL( INOUT SESSION_INFO *sessionInfoPtr,
 		handshakeInfo->needTLS12LTSResponse = FALSE;
 		}
 
-	/* If we've eventually ended up with a GCM suite, typically in 
-	   conjunction with an ECC suite, turn off encrypt-then-MAC in case it 
-	   was selected */
-	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_GCM )
+	/* If we've eventually ended up with a GCM or ChaCha20-Poly1305 suite, 
+	   typically in conjunction with an ECC suite, turn off encrypt-then-MAC 
+	   in case it was selected */
+	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_AEAD )
 		{
 		sessionInfoPtr->protocolFlags &= ~SSL_PFLAG_ENCTHENMAC;
 		if( isServer )
@@ -872,6 +1013,10 @@ int processHelloSSL( INOUT SESSION_INFO *sessionInfoPtr,
 		}
 #endif /* CONFIG_SUITEB */
 
+	/* We've got the other side's hello, record how long it took to arrive 
+	   for the handshake timing information */
+	recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_HELLORECEIVED );
+
 	return( potentiallyResumedSession ? OK_SPECIAL : CRYPT_OK );
 	}
 #endif /* USE_SSL */
@@ -146,6 +146,105 @@ static int addSessionToCache( INOUT SESSION_INFO *sessionInfoPtr,
 	return( CRYPT_OK );
 	}
 
+#ifdef USE_SSL_TICKETS
+
+/* Send a session ticket to the client.  This is sent immediately before 
+   our change cipherspec so the stream is left open for the handshake 
+   completion data that follows.  Since the ticket message is part of the 
+   handshake it's hashed into the responder's hash context(s) so that it's
+   covered by our finished message:
+
+	byte		ID = SSL_HAND_NEWSESSIONTICKET
+	uint24		len
+	uint32		ticketLifetimeHint
+	uint16		ticketLength
+	byte[]		ticket */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+static int writeSessionTicketPacket( INOUT SESSION_INFO *sessionInfoPtr,
+									 INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+									 IN_BUFFER( masterSecretSize ) \
+										const void *masterSecret,
+									 IN_LENGTH_FIXED( SSL_SECRET_SIZE ) \
+										const int masterSecretSize,
+									 IN_HANDLE_OPT \
+										const CRYPT_CONTEXT hashContext1,
+									 IN_HANDLE_OPT \
+										const CRYPT_CONTEXT hashContext2,
+									 IN_HANDLE_OPT \
+										const CRYPT_CONTEXT hashContext3 )
+	{
+	STREAM *stream = &handshakeInfo->stream;
+	void *data;
+	int packetOffset, dataLength = 0, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isReadPtrDynamic( masterSecret, masterSecretSize ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( masterSecretSize == SSL_SECRET_SIZE );
+	REQUIRES( ( isHandleRangeValid( hashContext1 ) && \
+				isHandleRangeValid( hashContext2 ) && \
+				hashContext3 == CRYPT_ERROR ) || \
+			  ( hashContext1 == CRYPT_ERROR && \
+				hashContext2 == CRYPT_ERROR && \
+				isHandleRangeValid( hashContext3 ) ) );
+
+	status = openPacketStreamSSL( stream, sessionInfoPtr, CRYPT_USE_DEFAULT, 
+								  SSL_MSG_HANDSHAKE );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = continueHSPacketStream( stream, SSL_HAND_NEWSESSIONTICKET, 
+									 &packetOffset );
+	if( cryptStatusOK( status ) )
+		{
+		status = writeSessionTicket( sessionInfoPtr, handshakeInfo, stream,
+									 masterSecret, masterSecretSize );
+		}
+	if( cryptStatusOK( status ) )
+		status = completeHSPacketStream( stream, packetOffset );
+	if( cryptStatusOK( status ) )
+		status = completePacketStreamSSL( stream, 0 );
+	if( cryptStatusOK( status ) )
+		{
+		dataLength = stell( stream ) - SSL_HEADER_SIZE;
+		status = sMemGetDataBlockAbs( stream, SSL_HEADER_SIZE, &data, 
+									  dataLength );
+		}
+	if( cryptStatusError( status ) )
+		{
+		sMemDisconnect( stream );
+		return( status );
+		}
+	ANALYSER_HINT( data != NULL );
+
+	/* Hash the ticket message into the responder's hash context(s) */
+	if( hashContext1 != CRYPT_ERROR )
+		{
+		status = krnlSendMessage( hashContext1, IMESSAGE_CTX_HASH, data, 
+								  dataLength );
+		if( cryptStatusOK( status ) )
+			{
+			status = krnlSendMessage( hashContext2, IMESSAGE_CTX_HASH, 
+									  data, dataLength );
+			}
+		}
+	else
+		{
+		status = krnlSendMessage( hashContext3, IMESSAGE_CTX_HASH, data, 
+								  dataLength );
+		}
+	if( cryptStatusError( status ) )
+		{
+		sMemDisconnect( stream );
+		return( status );
+		}
+
+	return( CRYPT_OK );
+	}
+#endif /* USE_SSL_TICKETS */
+
 /****************************************************************************
 *																			*
 *					Read/Write Handshake Completion Messages				*
@@ -227,7 +326,9 @@ static int readHandshakeCompletionData( INOUT SESSION_INFO *sessionInfoPtr,
 	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_GCM )
 		{
 		/* If we're using GCM then the IV is partially explicit and 
-		   partially implicit, and unrelated to the cipher block size */
+		   partially implicit, and unrelated to the cipher block size.  
+		   ChaCha20-Poly1305 has an entirely implicit IV so there's no
+		   change in the start offset */
 		sessionInfoPtr->sessionSSL->ivSize = \
 					GCM_IV_SIZE - sessionInfoPtr->sessionSSL->gcmSaltSize;
 		startOffsetChanged = TRUE;
@@ -391,7 +492,9 @@ static int writeHandshakeCompletionData( INOUT SESSION_INFO *sessionInfoPtr,
 	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_GCM )
 		{
 		/* If we're using GCM then the IV is partially explicit and 
-		   partially implicit, and unrelated to the cipher block size */
+		   partially implicit, and unrelated to the cipher block size.  
+		   ChaCha20-Poly1305 has an entirely implicit IV so there's no
+		   change in the start offset */
 		sessionInfoPtr->sessionSSL->ivSize = \
 					GCM_IV_SIZE - sessionInfoPtr->sessionSSL->gcmSaltSize;
 		startOffsetChanged = TRUE;
@@ -503,6 +606,9 @@ int completeHandshakeSSL( INOUT SESSION_INFO *sessionInfoPtr,
 	const BOOLEAN updateSessionCache = 	\
 			( !isResumedSession && handshakeInfo->sessionIDlength > 0 ) ? \
 			TRUE : FALSE;
+	BOOLEAN continuedStream = \
+			( ( isClient && !isResumedSession ) || \
+			  ( !isClient && isResumedSession ) ) ? TRUE : FALSE;
 	int initiatorHashLength, responderHashLength;
 	int tlsLabelLength, status;
 
@@ -510,6 +616,17 @@ int completeHandshakeSSL( INOUT SESSION_INFO *sessionInfoPtr,
 	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
 
 	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+
+	/* TLS 1.3 has its own completely different handshake completion 
+	   process */
+#ifdef USE_TLS13
+	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS13 )
+		{
+		return( completeHandshakeTLS13( sessionInfoPtr, handshakeInfo, 
+										isClient ) );
+		}
+#endif /* USE_TLS13 */
+
 	REQUIRES( MAX_KEYBLOCK_SIZE >= ( sessionInfoPtr->authBlocksize + \
 									 handshakeInfo->cryptKeysize +
 									 sessionInfoPtr->cryptBlocksize ) * 2 );
@@ -671,6 +788,23 @@ int completeHandshakeSSL( INOUT SESSION_INFO *sessionInfoPtr,
 			status = krnlSendMessage( responderSHA1context, IMESSAGE_CTX_HASH,
 									  initiatorHashes, initiatorHashLength );
 		}
+#ifdef USE_SSL_TICKETS
+	if( cryptStatusOK( status ) && !isClient && !isResumedSession && \
+		handshakeInfo->needSessionTicketResponse )
+		{
+		/* The client has asked for a session ticket, send it before our 
+		   change cipherspec and finished.  Since the ticket is written to 
+		   the start of the packet stream, the change cipherspec that 
+		   follows continues the stream rather than starting a new one */
+		status = writeSessionTicketPacket( sessionInfoPtr, handshakeInfo,
+										   masterSecret, SSL_SECRET_SIZE,
+										   responderMD5context, 
+										   responderSHA1context,
+										   responderSHA2context );
+		if( cryptStatusOK( status ) )
+			continuedStream = TRUE;
+		}
+#endif /* USE_SSL_TICKETS */
 	if( cryptStatusError( status ) )
 		{
 		zeroise( masterSecret, SSL_SECRET_SIZE );
@@ -724,9 +858,15 @@ int completeHandshakeSSL( INOUT SESSION_INFO *sessionInfoPtr,
 	status = writeHandshakeCompletionData( sessionInfoPtr, handshakeInfo,
 					isInitiator ? initiatorHashes : responderHashes,
 					initiatorHashLength /* Same as responderHashLength */,
-					( ( isClient && !isResumedSession ) || \
-					  ( !isClient && isResumedSession ) ) ? TRUE : FALSE );
+					continuedStream );
 #endif /* CONFIG_FUZZ */
+	if( cryptStatusOK( status ) && !isClient && isResumedSession )
+		{
+		/* If we're the server resuming a session then the server hello 
+		   has just gone out along with our change cipherspec and 
+		   finished */
+		recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_HELLOSENT );
+		}
 	if( cryptStatusOK( status ) && isInitiator )
 		{
 		status = readHandshakeCompletionData( sessionInfoPtr, responderHashes,
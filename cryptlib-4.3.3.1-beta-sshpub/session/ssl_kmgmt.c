@@ -8,11 +8,13 @@
 #if defined( INC_ALL )
   #include "crypt.h"
   #include "misc_rw.h"
+  #include "keypool.h"
   #include "session.h"
   #include "ssl.h"
 #else
   #include "crypt.h"
   #include "enc_dec/misc_rw.h"
+  #include "session/keypool.h"
   #include "session/session.h"
   #include "session/ssl.h"
 #endif /* Compiler-specific includes */
@@ -183,7 +185,7 @@ static int initSecurityContextsSSL( INOUT SESSION_INFO *sessionInfoPtr
 
 	/* Create the authentication contexts, unless we're using a combined
 	   encryption+authentication mode */
-	if( !( sessionInfoPtr->protocolFlags & SSL_PFLAG_GCM ) )
+	if( !( sessionInfoPtr->protocolFlags & SSL_PFLAG_AEAD ) )
 		{
 		const CRYPT_ALGO_TYPE integrityAlgo = sessionInfoPtr->integrityAlgo;
 
@@ -411,6 +413,20 @@ int initDHcontextSSL( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 			return( status );
 		}
 
+	/* If we're using a built-in key, try and get a pre-generated one from 
+	   the ephemeral key pool.  If there's none available then we fall back 
+	   to generating the key ourselves */
+	if( keyData == NULL )
+		{
+		status = getKeyPoolContext( iCryptContext, 
+							( eccParams != CRYPT_ECCCURVE_NONE ) ? \
+								CRYPT_ALGO_ECDH : CRYPT_ALGO_DH,
+							( eccParams != CRYPT_ECCCURVE_NONE ) ? \
+								eccParams : keySize );
+		if( cryptStatusOK( status ) )
+			return( CRYPT_OK );
+		}
+
 	/* Create the DH/ECDH context */
 	setMessageCreateObjectInfo( &createInfo, \
 								( eccParams != CRYPT_ECCCURVE_NONE ) ? \
@@ -479,6 +495,49 @@ int initDHcontextSSL( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext,
 	return( CRYPT_OK );
 	}
 
+#ifdef USE_25519
+
+/* Create an X25519 context for the ECDH keyex.  Unlike DH and ECDH there 
+   are no key parameters to load for either the client or the server since 
+   the curve is fixed, so all that we need to do is generate an ephemeral 
+   key into the context */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int initX25519contextSSL( OUT_HANDLE_OPT CRYPT_CONTEXT *iCryptContext )
+	{
+	MESSAGE_CREATEOBJECT_INFO createInfo;
+	MESSAGE_DATA msgData;
+	int status;
+
+	assert( isWritePtr( iCryptContext, sizeof( CRYPT_CONTEXT ) ) );
+
+	/* Clear return value */
+	*iCryptContext = CRYPT_ERROR;
+
+	/* Create the X25519 context and generate a key into it */
+	setMessageCreateObjectInfo( &createInfo, CRYPT_ALGO_25519 );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_DEV_CREATEOBJECT,
+							  &createInfo, OBJECT_TYPE_CONTEXT );
+	if( cryptStatusError( status ) )
+		return( status );
+	setMessageData( &msgData, "TLS key agreement key", 21 );
+	status = krnlSendMessage( createInfo.cryptHandle, IMESSAGE_SETATTRIBUTE_S,
+							  &msgData, CRYPT_CTXINFO_LABEL );
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendNotifier( createInfo.cryptHandle, 
+								   IMESSAGE_CTX_GENKEY );
+		}
+	if( cryptStatusError( status ) )
+		{
+		krnlSendNotifier( createInfo.cryptHandle, IMESSAGE_DECREFCOUNT );
+		return( status );
+		}
+	*iCryptContext = createInfo.cryptHandle;
+	return( CRYPT_OK );
+	}
+#endif /* USE_25519 */
+
 /* Create the master secret from a shared (PSK) secret value, typically a
    password */
 
@@ -913,9 +972,10 @@ static int loadKeys( INOUT SESSION_INFO *sessionInfoPtr,
 	   First we load the MAC keys.  For TLS these are proper MAC keys, for
 	   SSL we have to build the proto-HMAC ourselves from a straight hash
 	   context so we store the raw cryptovariables rather than loading them
-	   into a context, and if we're using GCM we skip them since the 
-	   encryption key also functions as the authentication key */
-	if( !( sessionInfoPtr->protocolFlags & SSL_PFLAG_GCM ) )
+	   into a context, and if we're using GCM or ChaCha20-Poly1305 we skip 
+	   them since the encryption key also functions as the authentication 
+	   key */
+	if( !( sessionInfoPtr->protocolFlags & SSL_PFLAG_AEAD ) )
 		{
 		if( sessionInfoPtr->version == SSL_MINOR_VERSION_SSL )
 			{
@@ -992,6 +1052,22 @@ static int loadKeys( INOUT SESSION_INFO *sessionInfoPtr,
 		return( CRYPT_OK );
 		}
 
+	/* If we're using ChaCha20-Poly1305 then the IV is entirely implicit, 
+	   derived from the master secret and combined with the sequence number 
+	   for each packet */
+	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_CHACHA20 )
+		{
+		memcpy( isClient ? sessionInfoPtr->sessionSSL->gcmWriteSalt : \
+						   sessionInfoPtr->sessionSSL->gcmReadSalt, 
+				keyBlockPtr, CHACHA20_SALT_SIZE );
+		memcpy( isClient ? sessionInfoPtr->sessionSSL->gcmReadSalt : \
+						   sessionInfoPtr->sessionSSL->gcmWriteSalt, 
+				keyBlockPtr + CHACHA20_SALT_SIZE, CHACHA20_SALT_SIZE );
+		sessionInfoPtr->sessionSSL->gcmSaltSize = CHACHA20_SALT_SIZE;
+
+		return( CRYPT_OK );
+		}
+
 	/* It's a standard block cipher, load the IVs.  This load is actually 
 	   redundant for TLS 1.1+ since it uses explicit IVs, but it's easier to 
 	   just do it anyway */
@@ -1146,4 +1222,364 @@ int loadExplicitIV( INOUT SESSION_INFO *sessionInfoPtr,
 
 	return( CRYPT_OK );
 	}
+
+/****************************************************************************
+*																			*
+*							TLS 1.3 Key Schedule							*
+*																			*
+****************************************************************************/
+
+#ifdef USE_TLS13
+
+/* TLS 1.3 replaces the TLS PRF with HKDF (RFC 5869), applied in a fixed 
+   sequence of extract and expand steps to produce a chain of secrets from
+   which the traffic keys are derived (RFC 8446 section 7.1):
+
+		PSK -> HKDF-Extract = Early Secret
+				 |
+		Derive-Secret( ., "derived", "" )
+				 |
+	 (EC)DHE -> HKDF-Extract = Handshake Secret
+				 +-> Derive-Secret( ., "c hs traffic", CH...SH )
+				 +-> Derive-Secret( ., "s hs traffic", CH...SH )
+		Derive-Secret( ., "derived", "" )
+				 |
+		  0 -> HKDF-Extract = Master Secret
+				 +-> Derive-Secret( ., "c ap traffic", CH...server Fin )
+				 +-> Derive-Secret( ., "s ap traffic", CH...server Fin )
+				 +-> Derive-Secret( ., "res master", CH...client Fin )
+
+   Since we only support SHA-256-based cipher suites, all secrets and hash
+   values are 32 bytes long, and since none of the values that we derive is 
+   longer than the hash output, HKDF-Expand only ever needs a single 
+   iteration of the underlying HMAC */
+
+/* Perform an HMAC-SHA256 over one or two data values */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+static int hmacSHA256( OUT_BUFFER_FIXED( TLS13_SECRET_SIZE ) BYTE *macValue,
+					   IN_BUFFER( keyLength ) const void *key,
+					   IN_LENGTH_SHORT const int keyLength,
+					   IN_BUFFER( data1Length ) const void *data1,
+					   IN_LENGTH_SHORT const int data1Length,
+					   IN_BUFFER_OPT( data2Length ) const void *data2,
+					   IN_LENGTH_SHORT_Z const int data2Length )
+	{
+	MESSAGE_CREATEOBJECT_INFO createInfo;
+	MESSAGE_DATA msgData;
+	int status;
+
+	assert( isWritePtr( macValue, TLS13_SECRET_SIZE ) );
+	assert( isReadPtrDynamic( key, keyLength ) );
+	assert( isReadPtrDynamic( data1, data1Length ) );
+	assert( data2 == NULL || isReadPtrDynamic( data2, data2Length ) );
+
+	REQUIRES( keyLength > 0 && keyLength < MAX_INTLENGTH_SHORT );
+	REQUIRES( data1Length > 0 && data1Length < MAX_INTLENGTH_SHORT );
+	REQUIRES( ( data2 == NULL && data2Length == 0 ) || \
+			  ( data2 != NULL && \
+				data2Length > 0 && data2Length < MAX_INTLENGTH_SHORT ) );
+
+	setMessageCreateObjectInfo( &createInfo, CRYPT_ALGO_HMAC_SHA2 );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_DEV_CREATEOBJECT,
+							  &createInfo, OBJECT_TYPE_CONTEXT );
+	if( cryptStatusError( status ) )
+		return( status );
+	setMessageData( &msgData, ( MESSAGE_CAST ) key, keyLength );
+	status = krnlSendMessage( createInfo.cryptHandle, IMESSAGE_SETATTRIBUTE_S,
+							  &msgData, CRYPT_CTXINFO_KEY );
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( createInfo.cryptHandle, IMESSAGE_CTX_HASH,
+								  ( MESSAGE_CAST ) data1, data1Length );
+		}
+	if( cryptStatusOK( status ) && data2 != NULL )
+		{
+		status = krnlSendMessage( createInfo.cryptHandle, IMESSAGE_CTX_HASH,
+								  ( MESSAGE_CAST ) data2, data2Length );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( createInfo.cryptHandle, IMESSAGE_CTX_HASH,
+								  "", 0 );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		setMessageData( &msgData, macValue, TLS13_SECRET_SIZE );
+		status = krnlSendMessage( createInfo.cryptHandle,
+								  IMESSAGE_GETATTRIBUTE_S, &msgData,
+								  CRYPT_CTXINFO_HASHVALUE );
+		}
+	krnlSendNotifier( createInfo.cryptHandle, IMESSAGE_DECREFCOUNT );
+
+	return( status );
+	}
+
+/* HKDF-Expand-Label( secret, label, context, length ):
+
+	HkdfLabel = uint16	length
+				uint8	labelLength
+				byte[]	"tls13 " || label
+				uint8	contextLength
+				byte[]	context 
+
+	output = HMAC( secret, HkdfLabel || 0x01 )[ 0...length-1 ] */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 4 ) ) \
+int hkdfExpandLabelTLS13( OUT_BUFFER_FIXED( outLength ) BYTE *out,
+						  IN_RANGE( 1, TLS13_SECRET_SIZE ) const int outLength,
+						  IN_BUFFER_C( TLS13_SECRET_SIZE ) const BYTE *secret,
+						  IN_BUFFER( labelLength ) const char *label,
+						  IN_RANGE( 1, 32 ) const int labelLength,
+						  IN_BUFFER_OPT( contextLength ) const void *context,
+						  IN_RANGE( 0, 255 ) const int contextLength )
+	{
+	STREAM stream;
+	BYTE hkdfLabel[ 2 + 1 + 6 + 32 + 1 + 255 + 1 + 8 ];
+	BYTE macValue[ TLS13_SECRET_SIZE + 8 ];
+	int hkdfLabelLength, status;
+
+	assert( isWritePtrDynamic( out, outLength ) );
+	assert( isReadPtr( secret, TLS13_SECRET_SIZE ) );
+	assert( isReadPtrDynamic( label, labelLength ) );
+	assert( context == NULL || isReadPtrDynamic( context, contextLength ) );
+
+	REQUIRES( outLength >= 1 && outLength <= TLS13_SECRET_SIZE );
+	REQUIRES( labelLength >= 1 && labelLength <= 32 );
+	REQUIRES( ( context == NULL && contextLength == 0 ) || \
+			  ( context != NULL && \
+				contextLength > 0 && contextLength <= 255 ) );
+
+	/* Build the HkdfLabel followed by the HKDF-Expand counter byte */
+	sMemOpen( &stream, hkdfLabel, 2 + 1 + 6 + 32 + 1 + 255 + 1 );
+	writeUint16( &stream, outLength );
+	sputc( &stream, 6 + labelLength );
+	swrite( &stream, "tls13 ", 6 );
+	swrite( &stream, label, labelLength );
+	sputc( &stream, contextLength );
+	if( contextLength > 0 )
+		swrite( &stream, context, contextLength );
+	status = sputc( &stream, 1 );
+	hkdfLabelLength = stell( &stream );
+	sMemDisconnect( &stream );
+	ENSURES( cryptStatusOK( status ) );
+
+	/* Expand the secret */
+	status = hmacSHA256( macValue, secret, TLS13_SECRET_SIZE, 
+						 hkdfLabel, hkdfLabelLength, NULL, 0 );
+	if( cryptStatusOK( status ) )
+		memcpy( out, macValue, outLength );
+	zeroise( macValue, TLS13_SECRET_SIZE );
+
+	return( status );
+	}
+
+/* Advance the key schedule to the next secret by extracting the new input
+   keying material, or a string of zeroes if there isn't any, into it.  If 
+   'secret' isn't set yet (isInitial == TRUE) then we're creating the early 
+   secret, otherwise we derive the salt for the extract step from the 
+   current secret as Derive-Secret( secret, "derived", "" ) */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int advanceSecretTLS13( INOUT_BUFFER_FIXED( TLS13_SECRET_SIZE ) BYTE *secret,
+						IN_BUFFER_OPT( keyLength ) const void *key,
+						IN_LENGTH_SHORT_Z const int keyLength,
+						const BOOLEAN isInitial )
+	{
+	/* SHA-256 hash of the empty string */
+	static const BYTE emptyHash[ TLS13_SECRET_SIZE + 8 ] = {
+		0xE3, 0xB0, 0xC4, 0x42, 0x98, 0xFC, 0x1C, 0x14,
+		0x9A, 0xFB, 0xF4, 0xC8, 0x99, 0x6F, 0xB9, 0x24,
+		0x27, 0xAE, 0x41, 0xE4, 0x64, 0x9B, 0x93, 0x4C,
+		0xA4, 0x95, 0x99, 0x1B, 0x78, 0x52, 0xB8, 0x55
+		};
+	static const BYTE zeroes[ TLS13_SECRET_SIZE + 8 ] = { 0 };
+	BYTE salt[ TLS13_SECRET_SIZE + 8 ];
+	int status;
+
+	assert( isWritePtr( secret, TLS13_SECRET_SIZE ) );
+	assert( key == NULL || isReadPtrDynamic( key, keyLength ) );
+
+	REQUIRES( ( key == NULL && keyLength == 0 ) || \
+			  ( key != NULL && \
+				keyLength > 0 && keyLength < MAX_INTLENGTH_SHORT ) );
+	REQUIRES( isInitial == TRUE || isInitial == FALSE );
+
+	/* Get the salt for the extract step */
+	if( isInitial )
+		memset( salt, 0, TLS13_SECRET_SIZE );
+	else
+		{
+		status = hkdfExpandLabelTLS13( salt, TLS13_SECRET_SIZE, secret, 
+									   "derived", 7, emptyHash, 
+									   TLS13_SECRET_SIZE );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+
+	/* Extract the input keying material into the new secret */
+	if( key != NULL )
+		{
+		status = hmacSHA256( secret, salt, TLS13_SECRET_SIZE, key, 
+							 keyLength, NULL, 0 );
+		}
+	else
+		{
+		status = hmacSHA256( secret, salt, TLS13_SECRET_SIZE, zeroes, 
+							 TLS13_SECRET_SIZE, NULL, 0 );
+		}
+	zeroise( salt, TLS13_SECRET_SIZE );
+
+	return( status );
+	}
+
+/* Compute the finished-message MAC value from a handshake traffic secret 
+   and the transcript hash:
+
+	finished_key = HKDF-Expand-Label( secret, "finished", "", 32 )
+	verify_data = HMAC( finished_key, transcript_hash ) */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int createFinishedTLS13( OUT_BUFFER_FIXED( TLS13_SECRET_SIZE ) BYTE *macValue,
+						 IN_BUFFER_C( TLS13_SECRET_SIZE ) const BYTE *secret,
+						 IN_BUFFER_C( TLS13_SECRET_SIZE ) const BYTE *hash )
+	{
+	BYTE finishedKey[ TLS13_SECRET_SIZE + 8 ];
+	int status;
+
+	assert( isWritePtr( macValue, TLS13_SECRET_SIZE ) );
+	assert( isReadPtr( secret, TLS13_SECRET_SIZE ) );
+	assert( isReadPtr( hash, TLS13_SECRET_SIZE ) );
+
+	status = hkdfExpandLabelTLS13( finishedKey, TLS13_SECRET_SIZE, secret,
+								   "finished", 8, NULL, 0 );
+	if( cryptStatusOK( status ) )
+		{
+		status = hmacSHA256( macValue, finishedKey, TLS13_SECRET_SIZE, 
+							 hash, TLS13_SECRET_SIZE, NULL, 0 );
+		}
+	zeroise( finishedKey, TLS13_SECRET_SIZE );
+
+	return( status );
+	}
+
+/* Load the record-protection key and IV for one direction of the session 
+   from a traffic secret:
+
+	key = HKDF-Expand-Label( secret, "key", "", keySize )
+	iv = HKDF-Expand-Label( secret, "iv", "", 12 )
+
+   Since the key changes several times during the lifetime of a TLS 1.3 
+   session, first for the handshake traffic, then for the application 
+   traffic, and then on every KeyUpdate, we create a new context for each 
+   key rather than trying to reuse the existing one.  If 'keySize' isn't
+   specified (this is a key update) then we reuse the key size from the 
+   existing context */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int loadKeysTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+				   IN_BUFFER_C( TLS13_SECRET_SIZE ) const BYTE *secret,
+				   IN_RANGE( 0, CRYPT_MAX_KEYSIZE ) const int keySize,
+				   const BOOLEAN isRead )
+	{
+	SSL_INFO *sslInfo = sessionInfoPtr->sessionSSL;
+	CRYPT_CONTEXT *iCryptContextPtr = isRead ? \
+				&sessionInfoPtr->iCryptInContext : \
+				&sessionInfoPtr->iCryptOutContext;
+	MESSAGE_CREATEOBJECT_INFO createInfo;
+	MESSAGE_DATA msgData;
+	BYTE key[ CRYPT_MAX_KEYSIZE + 8 ];
+	int newKeySize = keySize, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isReadPtr( secret, TLS13_SECRET_SIZE ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( keySize == 0 || \
+			  ( keySize >= MIN_KEYSIZE && keySize <= TLS13_SECRET_SIZE ) );
+	REQUIRES( isRead == TRUE || isRead == FALSE );
+
+	/* Get rid of the existing context if there is one */
+	if( *iCryptContextPtr != CRYPT_ERROR )
+		{
+		if( newKeySize <= 0 )
+			{
+			status = krnlSendMessage( *iCryptContextPtr, 
+									  IMESSAGE_GETATTRIBUTE, &newKeySize,
+									  CRYPT_CTXINFO_KEYSIZE );
+			if( cryptStatusError( status ) )
+				return( status );
+			}
+		krnlSendNotifier( *iCryptContextPtr, IMESSAGE_DECREFCOUNT );
+		*iCryptContextPtr = CRYPT_ERROR;
+		}
+	REQUIRES( newKeySize >= MIN_KEYSIZE && \
+			  newKeySize <= TLS13_SECRET_SIZE );
+
+	/* Create the new context, switching it to GCM mode if required */
+	setMessageCreateObjectInfo( &createInfo, sessionInfoPtr->cryptAlgo );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE,
+							  IMESSAGE_DEV_CREATEOBJECT, &createInfo,
+							  OBJECT_TYPE_CONTEXT );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_GCM ) 
+		{
+		static const int mode = CRYPT_MODE_GCM;	/* int vs.enum */
+
+		status = krnlSendMessage( createInfo.cryptHandle,
+								  IMESSAGE_SETATTRIBUTE, 
+								  ( MESSAGE_CAST ) &mode,
+								  CRYPT_CTXINFO_MODE );
+		}
+
+	/* Derive and load the key and IV */
+	if( cryptStatusOK( status ) )
+		{
+		status = hkdfExpandLabelTLS13( key, newKeySize, secret, "key", 3, 
+									   NULL, 0 );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		setMessageData( &msgData, key, newKeySize );
+		status = krnlSendMessage( createInfo.cryptHandle,
+								  IMESSAGE_SETATTRIBUTE_S, &msgData,
+								  CRYPT_CTXINFO_KEY );
+		}
+	zeroise( key, CRYPT_MAX_KEYSIZE );
+	if( cryptStatusOK( status ) )
+		{
+		status = hkdfExpandLabelTLS13( isRead ? sslInfo->gcmReadSalt : \
+												sslInfo->gcmWriteSalt, 
+									   CHACHA20_SALT_SIZE, secret, "iv", 2, 
+									   NULL, 0 );
+		}
+	if( cryptStatusError( status ) )
+		{
+		krnlSendNotifier( createInfo.cryptHandle, IMESSAGE_DECREFCOUNT );
+		return( status );
+		}
+	*iCryptContextPtr = createInfo.cryptHandle;
+	sslInfo->gcmSaltSize = CHACHA20_SALT_SIZE;
+
+	/* Remember the traffic secret for KeyUpdates and reset the sequence 
+	   number for the new key.  Once the key is loaded everything in this 
+	   direction is encrypted */
+	if( isRead )
+		{
+		memcpy( sslInfo->tls13ReadSecret, secret, TLS13_SECRET_SIZE );
+		sslInfo->readSeqNo = 0;
+		sessionInfoPtr->flags |= SESSION_ISSECURE_READ;
+		}
+	else
+		{
+		memcpy( sslInfo->tls13WriteSecret, secret, TLS13_SECRET_SIZE );
+		sslInfo->writeSeqNo = 0;
+		sessionInfoPtr->flags |= SESSION_ISSECURE_WRITE;
+		}
+	sslInfo->tls13SecretSize = TLS13_SECRET_SIZE;
+
+	return( CRYPT_OK );
+	}
+#endif /* USE_TLS13 */
 #endif /* USE_SSL */
@@ -181,6 +181,8 @@ const char *getSSLHSPacketName( IN_RANGE( 0, 255 ) const int packetType )
 	static const PACKET_NAME_INFO packetNameInfo[] = {
 		{ SSL_HAND_CLIENT_HELLO, "client_hello" },
 		{ SSL_HAND_SERVER_HELLO, "server_hello" },
+		{ SSL_HAND_NEWSESSIONTICKET, "new_session_ticket" },
+		{ SSL_HAND_ENCRYPTED_EXTENSIONS, "encrypted_extensions" },
 		{ SSL_HAND_CERTIFICATE, "certificate" },
 		{ SSL_HAND_SERVER_KEYEXCHANGE, "server_key_exchange" },
 		{ SSL_HAND_SERVER_CERTREQUEST, "certificate_request" },
@@ -188,7 +190,9 @@ const char *getSSLHSPacketName( IN_RANGE( 0, 255 ) const int packetType )
 		{ SSL_HAND_CLIENT_CERTVERIFY, "certificate_verify" },
 		{ SSL_HAND_CLIENT_KEYEXCHANGE, "client_key_exchange" },
 		{ SSL_HAND_FINISHED, "finished" },
+		{ SSL_HAND_CERTIFICATE_STATUS, "certificate_status" },
 		{ SSL_HAND_SUPPLEMENTAL_DATA, "supplemental_data" },
+		{ SSL_HAND_KEYUPDATE, "key_update" },
 		{ CRYPT_ERROR, "<Unknown type>" },
 			{ CRYPT_ERROR, "<Unknown type>" }
 		};
@@ -286,13 +290,17 @@ int processVersionInfo( INOUT SESSION_INFO *sessionInfoPtr,
 			}
 
 		/* It's a subsequent message in the exchange, the version number has
-		   to match what we're expecting */
-		if( version != sessionInfoPtr->version )
+		   to match what we're expecting.  TLS 1.3 freezes the version 
+		   number in the record header at TLS 1.2, so if we're using TLS 1.3 
+		   we check for that instead */
+		if( version != min( sessionInfoPtr->version, \
+							SSL_MINOR_VERSION_TLS12 ) )
 			{
 			retExt( CRYPT_ERROR_BADDATA,
 					( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
 					  "Invalid version number 3.%d, should be 3.%d", 
-					  version, sessionInfoPtr->version ) );
+					  version, min( sessionInfoPtr->version, \
+									SSL_MINOR_VERSION_TLS12 ) ) );
 			}
 		return( CRYPT_OK );
 		}
@@ -354,8 +362,11 @@ int processVersionInfo( INOUT SESSION_INFO *sessionInfoPtr,
 				  sessionInfoPtr->version ));
 
 	/* If there's a requirement for a minimum version, make sure that it's
-	   been met */
+	   been met.  TLS 1.3 is negotiated via an extension rather than the
+	   version number in the hello, so a requirement for TLS 1.3 can only
+	   be checked once the hello extensions have been processed */
 	if( sessionInfoPtr->sessionSSL->minVersion > 0 && \
+		sessionInfoPtr->sessionSSL->minVersion <= SSL_MINOR_VERSION_TLS12 && \
 		version < sessionInfoPtr->sessionSSL->minVersion )
 		{
 		retExt( CRYPT_ERROR_BADDATA,
@@ -771,18 +782,13 @@ static int unwrapPacketTLSMAC( INOUT SESSION_INFO *sessionInfoPtr,
 	/* Clear return value */
 	*dataLength = 0;
 
-	/* MAC the encrypted data */
-	status = checkMacTLS( sessionInfoPtr, data, length, 
-						  length - sessionInfoPtr->authBlocksize, 
-						  packetType, FALSE );
-	if( cryptStatusError( status ) )
-		return( status );
-
-	/* Decrypt the packet in the buffer.  We allow zero-length blocks (once
-	   the padding is stripped) because some versions of OpenSSL send these 
-	   as a kludge to work around pre-TLS 1.1 chosen-IV attacks */
-	status = decryptData( sessionInfoPtr, data, 
-						  length - sessionInfoPtr->authBlocksize, &length );
+	/* MAC and decrypt the packet in the buffer, with the MAC'ing and 
+	   decryption stitched together so that each chunk of the record is 
+	   still in the cache when it's decrypted.  We allow zero-length blocks 
+	   (once the padding is stripped) because some versions of OpenSSL send 
+	   these as a kludge to work around pre-TLS 1.1 chosen-IV attacks */
+	status = checkMacDecryptDataTLS( sessionInfoPtr, data, length, &length, 
+									 packetType );
 	if( cryptStatusError( status ) )
 		return( status );
 
@@ -790,7 +796,7 @@ static int unwrapPacketTLSMAC( INOUT SESSION_INFO *sessionInfoPtr,
 	return( CRYPT_OK );
 	}
 
-#ifdef USE_GCM
+#if defined( USE_GCM ) || defined( USE_CHACHA20 )
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
 static int unwrapPacketTLSGCM( INOUT SESSION_INFO *sessionInfoPtr, 
@@ -829,6 +835,20 @@ static int unwrapPacketTLSGCM( INOUT SESSION_INFO *sessionInfoPtr,
 				  getSSLPacketName( packetType ), packetType ) );
 		}
 
+#ifdef USE_CHACHA20
+	/* If we're using ChaCha20-Poly1305 then there's no explicit IV sent 
+	   with the packet, so we have to load the nonce for the packet 
+	   ourselves */
+	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_CHACHA20 )
+		{
+		status = loadNonceTLSChaCha20( sessionInfoPtr->iCryptInContext, 
+									   sslInfo->gcmReadSalt, 
+									   sslInfo->readSeqNo );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+#endif /* USE_CHACHA20 */
+
 	/* Process the packet metadata as GCM AAD */
 	status = macDataTLSGCM( sessionInfoPtr->iCryptInContext, 
 							sslInfo->readSeqNo, sessionInfoPtr->version, 
@@ -853,7 +873,93 @@ static int unwrapPacketTLSGCM( INOUT SESSION_INFO *sessionInfoPtr,
 
 	return( CRYPT_OK );
 	}
-#endif /* USE_GCM */
+#endif /* USE_GCM || USE_CHACHA20 */
+
+#ifdef USE_TLS13
+
+/* Unwrap a TLS 1.3 packet.  TLS 1.3 hides the actual record type inside 
+   the encrypted payload, with the outer record type always being 
+   application data, so we return the inner type alongside the data:
+
+	byte[]		data
+	byte		type
+	byte[]		padding				-- All zeroes
+	byte[]		icv
+
+   The nonce is the per-direction IV XOR'd with the sequence number in the
+   same way as for ChaCha20 in TLS 1.2, and the AAD is the record header */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4, 5 ) ) \
+int unwrapPacketTLS13( INOUT SESSION_INFO *sessionInfoPtr, 
+					   INOUT_BUFFER( dataMaxLength, \
+									 *dataLength ) void *data, 
+					   IN_DATALENGTH const int dataMaxLength, 
+					   OUT_DATALENGTH_Z int *dataLength,
+					   OUT_RANGE( 0, 255 ) int *packetType )
+	{
+	SSL_INFO *sslInfo = sessionInfoPtr->sessionSSL;
+	const BYTE *dataPtr = data;
+	int length = dataMaxLength, i, status, LOOP_ITERATOR;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) && \
+			sessionInfoPtr->flags & SESSION_ISSECURE_READ );
+	assert( isWritePtrDynamic( data, dataMaxLength ) );
+	assert( isWritePtr( dataLength, sizeof( int ) ) );
+	assert( isWritePtr( packetType, sizeof( int ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS13 );
+	REQUIRES( dataMaxLength >= sessionInfoPtr->authBlocksize && \
+			  dataMaxLength <= MAX_PACKET_SIZE + \
+							   sessionInfoPtr->authBlocksize + 256 && \
+			  dataMaxLength < MAX_BUFFER_SIZE );
+
+	/* Clear return values */
+	*dataLength = 0;
+	*packetType = 0;
+
+	/* Shorten the packet by the size of the ICV */
+	length -= sessionInfoPtr->authBlocksize;
+	if( length < 1 || length > MAX_PACKET_SIZE + 256 )
+		{
+		retExt( CRYPT_ERROR_BADDATA,
+				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
+				  "Invalid TLS 1.3 payload length %d", length ) );
+		}
+
+	/* Load the per-packet nonce and process the record header as AAD */
+	status = loadNonceTLSChaCha20( sessionInfoPtr->iCryptInContext, 
+								   sslInfo->gcmReadSalt, 
+								   sslInfo->readSeqNo );
+	if( cryptStatusOK( status ) )
+		{
+		status = macDataTLS13( sessionInfoPtr->iCryptInContext, 
+							   dataMaxLength );
+		}
+	if( cryptStatusError( status ) )
+		return( status );
+	sslInfo->readSeqNo++;
+
+	/* Decrypt the packet in the buffer */
+	status = decryptData( sessionInfoPtr, data, length, &length );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Strip the padding and extract the actual record type */
+	LOOP_MAX( i = length - 1, i >= 0 && dataPtr[ i ] == 0, i-- );
+	ENSURES( LOOP_BOUND_OK );
+	if( i < 0 )
+		{
+		retExt( CRYPT_ERROR_BADDATA,
+				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
+				  "TLS 1.3 packet contains no record type" ) );
+		}
+	*packetType = dataPtr[ i ];
+	*dataLength = i;
+
+	return( CRYPT_OK );
+	}
+#endif /* USE_TLS13 */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
 int unwrapPacketSSL( INOUT SESSION_INFO *sessionInfoPtr, 
@@ -907,14 +1013,14 @@ int unwrapPacketSSL( INOUT SESSION_INFO *sessionInfoPtr,
 		}
 	else
 		{
-#ifdef USE_GCM
-		if( sessionInfoPtr->protocolFlags & SSL_PFLAG_GCM )
+#if defined( USE_GCM ) || defined( USE_CHACHA20 )
+		if( sessionInfoPtr->protocolFlags & SSL_PFLAG_AEAD )
 			{
 			status = unwrapPacketTLSGCM( sessionInfoPtr, data, dataMaxLength, 
 										 dataLength, packetType );
 			}
 		else
-#endif /* USE_GCM */
+#endif /* USE_GCM || USE_CHACHA20 */
 			{
 			status = unwrapPacketSSLStd( sessionInfoPtr, data, dataMaxLength, 
 										 dataLength, packetType );
@@ -924,6 +1030,95 @@ int unwrapPacketSSL( INOUT SESSION_INFO *sessionInfoPtr,
 	return( status );
 	}
 
+#ifdef USE_TLS13
+
+/* Read an encrypted TLS 1.3 handshake packet.  Since the outer packet type 
+   is always application data, we can only check the actual packet type 
+   once we've decrypted the packet.  Unlike the standard handshake-packet 
+   read we don't hash the packet contents since TLS 1.3 requires that the 
+   hashing be performed on a per-message rather than per-packet basis, 
+   with the transcript hash being required at intermediate points within 
+   a single flight of messages */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+static int readHSPacketTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							  IN_BUFFER( headerLength ) const BYTE *header,
+							  IN_LENGTH_SHORT const int headerLength,
+							  OUT_DATALENGTH_Z int *packetLength, 
+							  IN_RANGE( SSL_MSG_FIRST, \
+										SSL_MSG_LAST ) const int packetType )
+	{
+	STREAM stream;
+	int bytesToRead, length, innerType, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isReadPtrDynamic( header, headerLength ) );
+	assert( isWritePtr( packetLength, sizeof( int ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( headerLength == SSL_HEADER_SIZE );
+	REQUIRES( packetType >= SSL_MSG_FIRST && packetType <= SSL_MSG_LAST );
+
+	/* Clear return value */
+	*packetLength = 0;
+
+	/* Check the outer packet header and read the packet */
+	sMemConnect( &stream, header, headerLength );
+	status = checkPacketHeader( sessionInfoPtr, &stream, &bytesToRead, 
+								SSL_MSG_APPLICATION_DATA, 0,
+								sessionInfoPtr->receiveBufSize ); 
+	sMemDisconnect( &stream );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = length = \
+		sread( &sessionInfoPtr->stream, sessionInfoPtr->receiveBuffer, 
+			   bytesToRead );
+	if( cryptStatusError( status ) )
+		{
+		sNetGetErrorInfo( &sessionInfoPtr->stream,
+						  &sessionInfoPtr->errorInfo );
+		return( status );
+		}
+	if( length != bytesToRead )
+		{
+		retExt( CRYPT_ERROR_TIMEOUT,
+				( CRYPT_ERROR_TIMEOUT, SESSION_ERRINFO, 
+				  "Timed out reading packet data for %s (%d) packet, only "
+				  "got %d of %d bytes", getSSLPacketName( packetType ), 
+				  packetType, length, bytesToRead ) );
+		}
+	sessionInfoPtr->receiveBufPos = 0;
+	sessionInfoPtr->receiveBufEnd = length;
+	DEBUG_DUMP_SSL( header, headerLength, sessionInfoPtr->receiveBuffer, 
+					length );
+
+	/* Decrypt the packet and make sure that it's what we're expecting */
+	status = unwrapPacketTLS13( sessionInfoPtr, 
+								sessionInfoPtr->receiveBuffer, length, 
+								&length, &innerType );
+	if( cryptStatusError( status ) )
+		return( status );
+	sessionInfoPtr->receiveBufEnd = length;
+	if( innerType == SSL_MSG_ALERT )
+		{
+		return( processAlertPayload( sessionInfoPtr, 
+									 sessionInfoPtr->receiveBuffer, 
+									 length ) );
+		}
+	if( innerType != packetType || length < MIN_PACKET_SIZE )
+		{
+		retExt( CRYPT_ERROR_BADDATA,
+				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
+				  "Unexpected %s (%d) packet of length %d, expected %s "
+				  "(%d)", getSSLPacketName( innerType ), innerType, length, 
+				  getSSLPacketName( packetType ), packetType ) );
+		}
+	*packetLength = length;
+
+	return( CRYPT_OK );
+	}
+#endif /* USE_TLS13 */
+
 /* Read an SSL handshake packet.  Since the data transfer phase has its own 
    read/write code we can perform some special-case handling based on this */
 
@@ -986,6 +1181,46 @@ int readHSPacketSSL( INOUT SESSION_INFO *sessionInfoPtr,
 		}
 	firstByte = byteToInt( headerBuffer[ 0 ] );
 
+#ifdef USE_TLS13
+	/* TLS 1.3 peers send dummy change cipher spec packets at various 
+	   points in the handshake in order to make the exchange look like a 
+	   TLS 1.2 session resumption to middleboxes (RFC 8446 section D.4).  
+	   These are never protected and have no meaning, so we skip them and 
+	   read the packet that follows */
+	if( ( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS13 ) && \
+		firstByte == SSL_MSG_CHANGE_CIPHER_SPEC )
+		{
+		BYTE ccsBuffer[ 8 + 8 ];
+
+		if( headerBuffer[ 3 ] != 0 || headerBuffer[ 4 ] != 1 )
+			{
+			retExt( CRYPT_ERROR_BADDATA,
+					( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
+					  "Invalid TLS 1.3 compatibility change cipher spec "
+					  "packet" ) );
+			}
+		status = sread( &sessionInfoPtr->stream, ccsBuffer, 1 );
+		if( cryptStatusError( status ) )
+			{
+			sNetGetErrorInfo( &sessionInfoPtr->stream,
+							  &sessionInfoPtr->errorInfo );
+			return( status );
+			}
+		if( status != 1 || ccsBuffer[ 0 ] != 1 )
+			{
+			retExt( CRYPT_ERROR_BADDATA,
+					( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
+					  "Invalid TLS 1.3 compatibility change cipher spec "
+					  "packet" ) );
+			}
+		status = readFixedHeaderAtomic( sessionInfoPtr, headerBuffer,
+										sessionInfoPtr->receiveBufStartOfs );
+		if( cryptStatusError( status ) )
+			return( status );
+		firstByte = byteToInt( headerBuffer[ 0 ] );
+		}
+#endif /* USE_TLS13 */
+
 	/* Check for an SSL alert message */
 	if( firstByte == SSL_MSG_ALERT )
 		{
@@ -993,6 +1228,19 @@ int readHSPacketSSL( INOUT SESSION_INFO *sessionInfoPtr,
 							  sessionInfoPtr->receiveBufStartOfs ) );
 		}
 
+#ifdef USE_TLS13
+	/* If we're using TLS 1.3 and encryption has been turned on then the 
+	   packet is an encrypted packet of hidden type that has to be 
+	   processed specially */
+	if( ( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS13 ) && \
+		( sessionInfoPtr->flags & SESSION_ISSECURE_READ ) )
+		{
+		return( readHSPacketTLS13( sessionInfoPtr, headerBuffer, 
+								   sessionInfoPtr->receiveBufStartOfs,
+								   packetLength, localPacketType ) );
+		}
+#endif /* USE_TLS13 */
+
 	/* Decode and process the SSL packet header.  If this is the first 
 	   packet sent by the other side we check for various special-case 
 	   conditions and handle them specially.  Since the first byte is 
@@ -1177,12 +1425,14 @@ static const ALERT_INFO alertInfo[] = {
 	{ TLS_ALERT_INAPPROPRIATE_FALLBACK, "Inappropriate fallback", 22, CRYPT_ERROR_NOSECURE },
 	{ TLS_ALERT_USER_CANCELLED, "User cancelled", 14, CRYPT_ERROR_FAILED },
 	{ TLS_ALERT_NO_RENEGOTIATION, "No renegotiation", 16, CRYPT_ERROR_FAILED },
+	{ TLS_ALERT_MISSING_EXTENSION, "Missing extension", 17, CRYPT_ERROR_NOTAVAIL },
 	{ TLS_ALERT_UNSUPPORTED_EXTENSION, "Unsupported extension", 21, CRYPT_ERROR_NOTAVAIL },
 	{ TLS_ALERT_CERTIFICATE_UNOBTAINABLE, "Certificate unobtainable", 24, CRYPT_ERROR_NOTFOUND },
 	{ TLS_ALERT_UNRECOGNIZED_NAME, "Unrecognized name", 17, CRYPT_ERROR_FAILED },
 	{ TLS_ALERT_BAD_CERTIFICATE_STATUS_RESPONSE, "Bad certificate status response", 31, CRYPT_ERROR_FAILED },
 	{ TLS_ALERT_BAD_CERTIFICATE_HASH_VALUE, "Bad certificate hash value", 26, CRYPT_ERROR_FAILED },
 	{ TLS_ALERT_UNKNOWN_PSK_IDENTITY, "Unknown PSK identity", 20, CRYPT_ERROR_NOTFOUND },
+	{ TLS_ALERT_CERTIFICATE_REQUIRED, "Certificate required", 20, CRYPT_ERROR_PERMISSION },
 	{ CRYPT_ERROR, NULL }, { CRYPT_ERROR, NULL }
 	};
 
@@ -1208,7 +1458,7 @@ int processAlert( INOUT SESSION_INFO *sessionInfoPtr,
 	{
 	STREAM stream;
 	BYTE buffer[ 256 + 8 ];
-	int length, type, i, status, LOOP_ITERATOR;
+	int length, status;
 
 	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
 	assert( isReadPtrDynamic( header, headerLength ) );
@@ -1266,6 +1516,7 @@ int processAlert( INOUT SESSION_INFO *sessionInfoPtr,
 				  "bytes", status, length ) );
 		}
 	if( ( sessionInfoPtr->flags & SESSION_ISSECURE_READ ) && \
+		!( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS13 ) && \
 		( length > ALERTINFO_SIZE || \
 		  isStreamCipher( sessionInfoPtr->cryptAlgo ) ) )
 		{
@@ -1292,9 +1543,34 @@ int processAlert( INOUT SESSION_INFO *sessionInfoPtr,
 			}
 		}
 
+	return( processAlertPayload( sessionInfoPtr, buffer, length ) );
+	}
+
+/* Process the contents of an alert packet once it's been read and, if 
+   necessary, decrypted */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int processAlertPayload( INOUT SESSION_INFO *sessionInfoPtr, 
+						 IN_BUFFER( alertLength ) const BYTE *buffer, 
+						 IN_LENGTH_SHORT const int alertLength )
+	{
+	int type, i, LOOP_ITERATOR;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isReadPtrDynamic( buffer, alertLength ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( alertLength >= 0 && alertLength < MAX_INTLENGTH_SHORT );
+
 	/* Tell the other side that we're going away */
 	sendCloseAlert( sessionInfoPtr, TRUE );
 	sessionInfoPtr->flags |= SESSION_SENDCLOSED;
+	if( alertLength < ALERTINFO_SIZE )
+		{
+		retExt( CRYPT_ERROR_BADDATA,
+				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO, 
+				  "Invalid alert message length %d", alertLength ) );
+		}
 
 	/* Process the alert information.  In theory we should also make the 
 	   session non-resumable if the other side goes away without sending a 
@@ -53,6 +53,16 @@
 #define MAX_CIPHERSUITE_TBLSIZE		64
 
 static const CIPHERSUITE_INFO cipherSuiteDH[] = {
+	/* ChaCha20-Poly1305 with DH */
+#ifdef USE_CHACHA20
+	{ TLS_DHE_RSA_WITH_CHACHA20_POLY1305_SHA256,
+	  DESCRIPTION( "TLS_DHE_RSA_WITH_CHACHA20_POLY1305_SHA256" )
+	  CRYPT_ALGO_DH, CRYPT_ALGO_RSA, CRYPT_ALGO_CHACHA20,
+	  CRYPT_ALGO_HMAC_SHA2, 0, 32, POLY1305ICV_SIZE, 
+	  CIPHERSUITE_FLAG_DH | CIPHERSUITE_FLAG_CHACHA20 |
+	  CIPHERSUITE_FLAG_TLS12 },
+#endif /* USE_CHACHA20 */
+
 	/* AES with DH */
 	{ TLS_DHE_RSA_WITH_AES_128_CBC_SHA256,
 	  DESCRIPTION( "TLS_DHE_RSA_WITH_AES_128_CBC_SHA256" )
@@ -97,6 +107,16 @@ static const CIPHERSUITE_INFO cipherSuiteDH[] = {
 #if defined( USE_ECDSA ) && defined( USE_ECDH )
 
 static const CIPHERSUITE_INFO cipherSuiteECC[] = {
+	/* ECDH with ECDSA and ChaCha20-Poly1305 */
+#ifdef USE_CHACHA20
+	{ TLS_ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256, 
+	  DESCRIPTION( "TLS_ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256" )
+	  CRYPT_ALGO_ECDH, CRYPT_ALGO_ECDSA, CRYPT_ALGO_CHACHA20,
+	  CRYPT_ALGO_HMAC_SHA2, 0, 32, POLY1305ICV_SIZE, 
+	  CIPHERSUITE_FLAG_ECC | CIPHERSUITE_FLAG_CHACHA20 |
+	  CIPHERSUITE_FLAG_TLS12 },
+#endif /* USE_CHACHA20 */
+
 	/* ECDH with ECDSA */
 	{ TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA256, 
 	  DESCRIPTION( "TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA256" )
@@ -191,8 +211,55 @@ static const CIPHERSUITE_INFO cipherSuiteGCM[] = {
 	};
 #endif /* USE_GCM */
 
+#ifdef USE_TLS13
+
+/* TLS 1.3 suites.  These only specify the AEAD cipher and the hash 
+   algorithm used for the key schedule, with the keyex being negotiated via 
+   extensions and the authentication via the signature algorithms.  Since 
+   the only keyex group that we support is X25519 we record this as the 
+   keyex algorithm, and since we only do signature-based 
+   server authentication with RSA we record this as the authentication 
+   algorithm so that the suite is knocked out if RSA isn't available.  The 
+   AES-256-GCM-SHA384 suite isn't supported since it'd require carrying 
+   SHA-384 transcript hashes alongside the SHA-256 ones for no real gain in 
+   security */
+
+static const CIPHERSUITE_INFO cipherSuiteTLS13[] = {
+	{ TLS_CHACHA20_POLY1305_SHA256,
+	  DESCRIPTION( "TLS_CHACHA20_POLY1305_SHA256" )
+	  CRYPT_ALGO_25519, CRYPT_ALGO_RSA, CRYPT_ALGO_CHACHA20,
+	  CRYPT_ALGO_HMAC_SHA2, 0, 32, POLY1305ICV_SIZE, 
+	  CIPHERSUITE_FLAG_CHACHA20 | CIPHERSUITE_FLAG_TLS13 },
+#ifdef USE_GCM
+	{ TLS_AES_128_GCM_SHA256,
+	  DESCRIPTION( "TLS_AES_128_GCM_SHA256" )
+	  CRYPT_ALGO_25519, CRYPT_ALGO_RSA, CRYPT_ALGO_AES,
+	  CRYPT_ALGO_HMAC_SHA2, 0, 16, GCMICV_SIZE, 
+	  CIPHERSUITE_FLAG_GCM | CIPHERSUITE_FLAG_TLS13 },
+#endif /* USE_GCM */
+
+	/* End-of-list marker */
+	{ SSL_NULL_WITH_NULL,
+	  DESCRIPTION( "End-of-list marker" )
+	  CRYPT_ALGO_NONE, CRYPT_ALGO_NONE, CRYPT_ALGO_NONE, 
+	  CRYPT_ALGO_NONE, 0, 0, 0, CIPHERSUITE_FLAG_NONE },
+	{ SSL_NULL_WITH_NULL,
+	  DESCRIPTION( "End-of-list marker" )
+	  CRYPT_ALGO_NONE, CRYPT_ALGO_NONE, CRYPT_ALGO_NONE, 
+	  CRYPT_ALGO_NONE, 0, 0, 0, CIPHERSUITE_FLAG_NONE }
+	};
+#endif /* USE_TLS13 */
+
 static const CIPHERSUITE_INFO cipherSuitePSK[] = {
 	/* PSK with PFS */
+#ifdef USE_CHACHA20
+	{ TLS_DHE_PSK_WITH_CHACHA20_POLY1305_SHA256,
+	  DESCRIPTION( "TLS_DHE_PSK_WITH_CHACHA20_POLY1305_SHA256" )
+	  CRYPT_ALGO_DH, CRYPT_ALGO_NONE, CRYPT_ALGO_CHACHA20,
+	  CRYPT_ALGO_HMAC_SHA2, 0, 32, POLY1305ICV_SIZE, 
+	  CIPHERSUITE_FLAG_PSK | CIPHERSUITE_FLAG_DH |
+	  CIPHERSUITE_FLAG_CHACHA20 | CIPHERSUITE_FLAG_TLS12 },
+#endif /* USE_CHACHA20 */
 	{ TLS_DHE_PSK_WITH_AES_128_CBC_SHA256,
 	  DESCRIPTION( "TLS_DHE_PSK_WITH_AES_128_CBC_SHA256" )
 	  CRYPT_ALGO_DH, CRYPT_ALGO_NONE, CRYPT_ALGO_AES,
@@ -298,6 +365,9 @@ static const CIPHERSUITE_INFO cipherSuiteRSA[] = {
    single monster list.  The order of adding suites is as follows:
 
 	[ Optional special-case suites, for testing or custom configurations ].
+	TLS 1.3 suites, which are only ever sent or selected when TLS 1.3 is 
+			enabled so they don't displace any of the suites below for 
+			earlier versions of the protocol.
 	PSK suites, since they provide proper mutual authentication. 
 	ECC suites if PREFER_ECC is defined, since anyone wanting to make this 
 			particular fashion statement probably wants to actually use the 
@@ -314,6 +384,9 @@ typedef struct {
 	} CIPHERSUITES_LIST;
 
 static const CIPHERSUITES_LIST cipherSuitesList[] = {
+#ifdef USE_TLS13
+	{ cipherSuiteTLS13, FAILSAFE_ARRAYSIZE( cipherSuiteTLS13, CIPHERSUITE_INFO ) },
+#endif /* USE_TLS13 */
 	{ cipherSuitePSK, FAILSAFE_ARRAYSIZE( cipherSuitePSK, CIPHERSUITE_INFO ) },
 #ifdef PREFER_ECC
   #ifdef USE_GCM
@@ -10,11 +10,13 @@
   #include "misc_rw.h"
   #include "session.h"
   #include "ssl.h"
+  #include "stapling.h"
 #else
   #include "crypt.h"
   #include "enc_dec/misc_rw.h"
   #include "session/session.h"
   #include "session/ssl.h"
+  #include "session/stapling.h"
 #endif /* Compiler-specific includes */
 
 #ifdef USE_SSL
@@ -94,10 +96,15 @@ static int readCheckClientCerts( INOUT SESSION_INFO *sessionInfoPtr,
 		MESSAGE_DATA msgData;
 		BYTE certID[ KEYID_SIZE + 8 ];
 
-		setMessageData( &msgData, certID, KEYID_SIZE );
-		status = krnlSendMessage( sessionInfoPtr->iKeyexAuthContext, 
-								  IMESSAGE_GETATTRIBUTE_S, &msgData, 
-								  CRYPT_CERTINFO_FINGERPRINT_SHA1 );
+		status = lockCertChainLeaf( sessionInfoPtr->iKeyexAuthContext );
+		if( cryptStatusOK( status ) )
+			{
+			setMessageData( &msgData, certID, KEYID_SIZE );
+			status = krnlSendMessage( sessionInfoPtr->iKeyexAuthContext, 
+									  IMESSAGE_GETATTRIBUTE_S, &msgData, 
+									  CRYPT_CERTINFO_FINGERPRINT_SHA1 );
+			unlockCertChain( sessionInfoPtr->iKeyexAuthContext );
+			}
 		if( cryptStatusOK( status ) )
 			{
 			setMessageKeymgmtInfo( &getkeyInfo, CRYPT_IKEYID_CERTID, 
@@ -431,7 +438,8 @@ static int processECDHKeyex( INOUT SESSION_INFO *sessionInfoPtr,
 	memset( &keyAgreeParams, 0, sizeof( KEYAGREE_PARAMS ) );
 	status = readEcdhValue( stream, keyAgreeParams.publicValue,
 							CRYPT_MAX_PKCSIZE, 
-							&keyAgreeParams.publicValueLen );
+							&keyAgreeParams.publicValueLen,
+							handshakeInfo->useX25519 );
 	if( cryptStatusError( status ) )
 		{
 		/* Some misconfigured clients may use very short keys, we perform a 
@@ -475,8 +483,11 @@ static int processECDHKeyex( INOUT SESSION_INFO *sessionInfoPtr,
 		+---+---------------+---------------+
 		|04	|		qx		|		qy		|
 		+---+---------------+---------------+
-			|<- fldSize --> |<- fldSize --> | */
-	if( !( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS12LTS ) )
+			|<- fldSize --> |<- fldSize --> | 
+
+	   X25519 produces a standalone u-coordinate that's used as is */
+	if( !handshakeInfo->useX25519 && \
+		!( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS12LTS ) )
 		{
 		const int xCoordLen = ( keyAgreeParams.wrappedKeyLen - 1 ) / 2;
 
@@ -885,6 +896,9 @@ int beginServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 	STREAM *stream = &handshakeInfo->stream;
 	SCOREBOARD_INFO scoreboardInfo DUMMY_INIT_STRUCT;
 	MESSAGE_DATA msgData;
+#ifdef USE_SSL_TICKETS
+	BYTE ticketSecret[ SSL_SECRET_SIZE + 8 ];
+#endif /* USE_SSL_TICKETS */
 	int packetOffset, clientHelloLength, serverHelloLength;
 	int resumedSessionID = CRYPT_ERROR, status;
 
@@ -912,7 +926,52 @@ int beginServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 #endif /* ALLOW_SSLV2_HELLO */
 	status = processHelloSSL( sessionInfoPtr, handshakeInfo, stream, TRUE );
 	sMemDisconnect( stream );
+#ifdef USE_TLS13
+	if( ( cryptStatusOK( status ) || status == OK_SPECIAL ) && \
+		( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS13 ) )
+		{
+		/* We're using TLS 1.3, which has its own handshake process that 
+		   doesn't use the TLS 1.2 session cache or tickets */
+		return( beginServerHandshakeTLS13( sessionInfoPtr, 
+										   handshakeInfo ) );
+		}
+#endif /* USE_TLS13 */
+#ifdef USE_SSL_TICKETS
+	if( ( cryptStatusOK( status ) || status == OK_SPECIAL ) && \
+		handshakeInfo->sessionTicketPresent && \
+		handshakeInfo->sessionIDlength > 0 )
+		{
+		int ticketSecretLength;
+
+		/* The client has sent us a session ticket in an attempt to resume 
+		   a previous session, see if it's one that we can use.  We only 
+		   allow this if the client has also sent a session ID since 
+		   that's the only way to tell it that we're resuming the session 
+		   (RFC 5077 section 3.4).  If the ticket is OK then we resume the 
+		   session from the ticket in the same way as we would from the 
+		   scoreboard, otherwise we fall back to the scoreboard */
+		status = checkSessionTicket( sessionInfoPtr, handshakeInfo, 
+									 ticketSecret, SSL_SECRET_SIZE, 
+									 &ticketSecretLength, 
+									 &scoreboardInfo.metaData );
+		if( cryptStatusOK( status ) )
+			{
+			scoreboardInfo.data = ticketSecret;
+			scoreboardInfo.dataSize = ticketSecretLength;
+			resumedSessionID = CRYPT_OK;
+			}
+		else
+			{
+			if( status != CRYPT_ERROR_NOTFOUND )
+				return( status );
+			status = ( handshakeInfo->sessionIDlength == SESSIONID_SIZE ) ? \
+					 OK_SPECIAL : CRYPT_OK;
+			}
+		}
+	if( cryptStatusError( resumedSessionID ) && cryptStatusError( status ) )
+#else
 	if( cryptStatusError( status ) )
+#endif /* USE_SSL_TICKETS */
 		{
 		BYTE sessionIDbuffer[ KEYID_SIZE + 8 ];
 		const BYTE *sessionIDptr = handshakeInfo->sessionID;
@@ -985,14 +1044,58 @@ int beginServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 									  &handshakeInfo->premasterSecretSize,
 									  scoreboardInfo.data, 
 									  scoreboardInfo.dataSize );
+#ifdef USE_SSL_TICKETS
+		zeroise( ticketSecret, SSL_SECRET_SIZE );
+#endif /* USE_SSL_TICKETS */
 		ENSURES( cryptStatusOK( status ) );
+
+		/* We don't issue a new session ticket for a resumed session, the
+		   client can continue to use the existing one */
+		handshakeInfo->needSessionTicketResponse = FALSE;
 		}
 
+	/* If the client has asked for certificate status information, check 
+	   whether we've got a current OCSP response for our certificate that 
+	   we can staple to the certificate chain.  A resumed session, or one 
+	   that doesn't use certificates, doesn't send a certificate chain so 
+	   there's nothing to staple the response to */
+	if( handshakeInfo->needStatusResponse && \
+		( !cryptStatusError( resumedSessionID ) || \
+		  handshakeInfo->authAlgo == CRYPT_ALGO_NONE || \
+		  cryptStatusError( checkOCSPStaple( sessionInfoPtr->privateKey ) ) ) )
+		handshakeInfo->needStatusResponse = FALSE;
+
 	/* Get the nonce that's used to randomise all crypto operations and set 
 	   up the server DH/ECDH context if necessary */
 	setMessageData( &msgData, handshakeInfo->serverNonce, SSL_NONCE_SIZE );
 	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_GETATTRIBUTE_S, 
 							  &msgData, CRYPT_IATTRIBUTE_RANDOM_NONCE );
+#ifdef USE_TLS13
+	if( cryptStatusOK( status ) && \
+		handshakeInfo->originalVersion >= SSL_MINOR_VERSION_TLS13 )
+		{
+		BYTE *sentinelPtr = handshakeInfo->serverNonce + \
+							SSL_NONCE_SIZE - TLS13_DOWNGRADE_SENTINEL_SIZE;
+
+		/* We support TLS 1.3 but the client doesn't, tell it that we're 
+		   using an earlier version because that's all that it supports 
+		   and not because someone has interfered with its hello */
+		memcpy( sentinelPtr, TLS13_DOWNGRADE_SENTINEL, 
+				TLS13_DOWNGRADE_SENTINEL_SIZE );
+		if( sessionInfoPtr->version < SSL_MINOR_VERSION_TLS12 )
+			sentinelPtr[ TLS13_DOWNGRADE_SENTINEL_SIZE - 1 ] = 0;
+		}
+#endif /* USE_TLS13 */
+#ifdef USE_25519
+	if( cryptStatusOK( status ) && \
+		isEccAlgo( handshakeInfo->keyexAlgo ) && handshakeInfo->useX25519 )
+		{
+		/* The client has indicated support for X25519, use it for the 
+		   ECDH keyex */
+		status = initX25519contextSSL( &handshakeInfo->dhContext );
+		}
+	else
+#endif /* USE_25519 */
 	if( cryptStatusOK( status ) && isKeyxAlgo( handshakeInfo->keyexAlgo ) )
 		{
 		status = initDHcontextSSL( &handshakeInfo->dhContext, NULL, 0,
@@ -1064,7 +1167,7 @@ int beginServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS12LTS )
 		{
 		sessionInfoPtr->protocolFlags |= SSL_PFLAG_EMS;
-		if( !( sessionInfoPtr->protocolFlags & SSL_PFLAG_GCM ) )
+		if( !( sessionInfoPtr->protocolFlags & SSL_PFLAG_AEAD ) )
 			sessionInfoPtr->protocolFlags |= SSL_PFLAG_ENCTHENMAC;
 
 		/* Hash the hello messages */
@@ -1125,6 +1228,32 @@ int beginServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 		INJECT_FAULT( SESSION_WRONGCERT, SESSION_WRONGCERT_SSL_2 );
 		}
 
+	/*	...			(optional certificate status, RFC 6066)
+		byte		ID = SSL_HAND_CERTIFICATE_STATUS
+		uint24		len
+		byte		statusType = TLS_STATUSTYPE_OCSP
+		uint24		ocspResponseLen
+		byte[]		ocspResponse */
+	if( handshakeInfo->needStatusResponse )
+		{
+		status = continueHSPacketStream( stream, SSL_HAND_CERTIFICATE_STATUS, 
+										 &packetOffset );
+		if( cryptStatusOK( status ) )
+			status = sputc( stream, TLS_STATUSTYPE_OCSP );
+		if( cryptStatusOK( status ) )
+			{
+			status = writeOCSPStaple( stream, 
+									  sessionInfoPtr->privateKey );
+			}
+		if( cryptStatusOK( status ) )
+			status = completeHSPacketStream( stream, packetOffset );
+		if( cryptStatusError( status ) )
+			{
+			sMemDisconnect( stream );
+			return( status );
+			}
+		}
+
 	/*	...			(optional server keyex) */
 	if( isKeyxAlgo( handshakeInfo->keyexAlgo ) )
 		{
@@ -1194,7 +1323,10 @@ int beginServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
 	status = sendPacketSSL( sessionInfoPtr, stream, FALSE );
 	INJECT_FAULT( SESSION_CORRUPT_HANDSHAKE, SESSION_CORRUPT_HANDSHAKE_SSL_2 );
 	if( cryptStatusOK( status ) )
+		{
+		recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_HELLOSENT );
 		status = hashHSPacketWrite( handshakeInfo, stream, 0 );
+		}
 	sMemDisconnect( stream );
 	return( status );
 	}
@@ -1213,6 +1345,11 @@ int exchangeServerKeys( INOUT SESSION_INFO *sessionInfoPtr,
 
 	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
 
+#ifdef USE_TLS13
+	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS13 )
+		return( exchangeServerKeysTLS13( sessionInfoPtr, handshakeInfo ) );
+#endif /* USE_TLS13 */
+
 	/* Read the response from the client and, if we're expecting a client 
 	   certificate, make sure that it's present */
 	status = readHSPacketSSL( sessionInfoPtr, handshakeInfo, &length,
@@ -1257,6 +1394,7 @@ int exchangeServerKeys( INOUT SESSION_INFO *sessionInfoPtr,
 		sMemDisconnect( stream );
 		return( status );
 		}
+	recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_KEYEXCHANGE );
 
 	/* Create the session hash if required */
 	if( ( sessionInfoPtr->protocolFlags & SSL_PFLAG_EMS ) || \
@@ -1296,6 +1434,7 @@ int exchangeServerKeys( INOUT SESSION_INFO *sessionInfoPtr,
 			sMemDisconnect( stream );
 			return( status );
 			}
+		recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_CERTVERIFIED );
 		}
 	sMemDisconnect( stream );
 
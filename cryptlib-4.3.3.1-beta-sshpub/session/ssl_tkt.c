@@ -0,0 +1,1179 @@
+/****************************************************************************
+*																			*
+*					cryptlib TLS Session Ticket Management					*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#if defined( INC_ALL )
+  #include "crypt.h"
+  #include "misc_rw.h"
+  #include "session.h"
+  #include "ssl.h"
+#else
+  #include "crypt.h"
+  #include "enc_dec/misc_rw.h"
+  #include "session/session.h"
+  #include "session/ssl.h"
+#endif /* Compiler-specific includes */
+
+/* Session tickets (RFC 5077) allow a server to resume a session without
+   having to remember anything about it.  Instead of storing the master
+   secret in the scoreboard, the server seals it and hands it to the client
+   in a ticket that the client presents when it reconnects.  Since the only
+   thing that the server needs to open the ticket is the ticket key, any
+   server that shares the key can resume the session, which isn't the case
+   for the scoreboard when there are several servers behind a load
+   balancer.
+
+   The ticket format is the one recommended in RFC 5077 section 4:
+
+	byte[16]	keyName
+	byte[16]	iv
+	byte[96]	encryptedState		-- AES-256-CBC
+	byte[32]	mac					-- HMAC-SHA256( keyName || iv ||
+															encryptedState )
+
+   with the encrypted state being:
+
+	byte		version = TICKET_VERSION
+	byte		protocolVersion		-- Minor version
+	uint16		cipherSuite
+	uint32		metaData			-- SSL_RESUMEDSESSION_FLAGS
+	uint32		issueTime
+	byte		hashedSNIpresent
+	byte[20]	hashedSNI			-- Zero if not present
+	byte[48]	masterSecret
+	byte[]		padding				-- Zero
+
+   The ticket is sealed using encrypt-then-MAC rather than an AEAD mode
+   since GCM isn't necessarily available in every build of cryptlib, while
+   AES and HMAC-SHA256 always are if TLS is.
+
+   The ticket keys are either generated internally, in which case they're
+   replaced every TICKET_KEY_LIFETIME seconds with the previous key still
+   being accepted for a further TICKET_KEY_LIFETIME seconds so that
+   tickets issued just before the changeover remain valid, or read from
+   the file given in CRYPT_OPTION_SESSION_TICKETKEYFILE.  The key file
+   contains one or more 80-byte records of { keyName[ 16 ], macKey[ 32 ],
+   encKey[ 32 ] }, with the first record being used to issue tickets and
+   all records being accepted.  The file is re-read every
+   TICKET_KEYFILE_RECHECK seconds, so keys can be rotated across a group
+   of servers by distributing a new file with the new key at the start and
+   the previous key(s) following it */
+
+#ifdef USE_SSL_TICKETS
+
+/* The sizes of the various ticket components */
+
+#define TICKET_KEYNAME_SIZE		16
+#define TICKET_ENCKEY_SIZE		32
+#define TICKET_MACKEY_SIZE		32
+#define TICKET_KEYRECORD_SIZE	( TICKET_KEYNAME_SIZE + TICKET_MACKEY_SIZE + \
+								  TICKET_ENCKEY_SIZE )
+#define TICKET_IV_SIZE			16
+#define TICKET_STATE_SIZE		96
+#define TICKET_MAC_SIZE			32
+#define TICKET_MACDATA_SIZE		( TICKET_KEYNAME_SIZE + TICKET_IV_SIZE + \
+								  TICKET_STATE_SIZE )
+
+/* The ticket state format version */
+
+#define TICKET_VERSION			1
+
+/* The maximum number of ticket keys that we accept at any one time, the
+   lifetime of an internally-generated ticket key, and the interval at
+   which we check the ticket key file for updated keys */
+
+#define TICKET_MAX_KEYS			4
+#define TICKET_KEY_LIFETIME		SSL_TICKET_LIFETIME
+#define TICKET_KEYFILE_RECHECK	300
+
+/* A ticket key and the overall ticket key state.  The 'refreshActive' flag
+   records the fact that a thread is currently updating the ticket keys
+   so that other threads don't all try and do the same thing at once */
+
+typedef struct {
+	BYTE keyName[ TICKET_KEYNAME_SIZE + 8 ];
+	BYTE macKey[ TICKET_MACKEY_SIZE + 8 ];
+	BYTE encKey[ TICKET_ENCKEY_SIZE + 8 ];
+	} TICKET_KEY;
+
+#ifdef USE_TLS13
+
+/* A ticket received by a TLS 1.3 client, stored alongside the PSK that's
+   derived from it.  Tickets are filed under a hash of the server name and
+   are used once only, as RFC 8446 section C.4 recommends, so a new ticket
+   for the same server replaces the old one */
+
+#define CLIENT_TICKET_MAX		8
+#define CLIENT_TICKET_SIZE		512
+
+typedef struct {
+	BYTE nameHash[ KEYID_SIZE + 8 ];/* Hash of server name */
+	BYTE ticket[ CLIENT_TICKET_SIZE + 8 ];
+	int ticketLength;				/* Ticket, zero if entry unused */
+	BYTE psk[ TLS13_SECRET_SIZE + 8 ];	/* PSK for the ticket */
+	int cipherSuite;				/* Suite that the PSK is tied to */
+	long ticketAgeAdd;				/* Ticket age obfuscation value */
+	time_t issueTime, expiryTime;	/* Ticket validity period */
+	} CLIENT_TICKET;
+#endif /* USE_TLS13 */
+
+typedef struct {
+	TICKET_KEY keys[ TICKET_MAX_KEYS + 1 ];	/* Issuing key is keys[ 0 ] */
+	int noKeys;						/* Number of keys present */
+	BOOLEAN keysFromFile;			/* Whether keys came from key file */
+	time_t keyTime;					/* When issuing key was generated */
+	time_t checkTime;				/* When to next check for new keys */
+	BOOLEAN refreshActive;			/* Whether key refresh in progress */
+	int hits, misses;				/* Ticket usage statistics */
+#ifdef USE_TLS13
+	CLIENT_TICKET clientTickets[ CLIENT_TICKET_MAX + 1 ];
+#endif /* USE_TLS13 */
+	} TICKET_KEY_INFO;
+
+static TICKET_KEY_INFO *ticketKeyInfo = NULL;
+
+/****************************************************************************
+*																			*
+*							Ticket Key Management							*
+*																			*
+****************************************************************************/
+
+/* Read the ticket keys from the ticket key file.  If there's no key file
+   configured we return CRYPT_ERROR_NOTFOUND to tell the caller to use
+   internally-generated keys */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int readTicketKeyFile( OUT_ARRAY( TICKET_MAX_KEYS ) TICKET_KEY *keys,
+							  OUT_RANGE( 0, TICKET_MAX_KEYS ) int *noKeys )
+	{
+	STREAM stream;
+	MESSAGE_DATA msgData;
+	BYTE streamBuffer[ STREAM_BUFSIZE + 8 ];
+	BYTE keyBuffer[ ( TICKET_KEYRECORD_SIZE * TICKET_MAX_KEYS ) + 8 ];
+	char keyFilePath[ MAX_PATH_LENGTH + 8 ];
+	int length, i, status, LOOP_ITERATOR;
+
+	assert( isWritePtr( keys, sizeof( TICKET_KEY ) * TICKET_MAX_KEYS ) );
+	assert( isWritePtr( noKeys, sizeof( int ) ) );
+
+	/* Clear return value */
+	*noKeys = 0;
+
+	/* Get the key file location.  Since this is a systemwide setting we
+	   always query the built-in default user object */
+	setMessageData( &msgData, keyFilePath, MAX_PATH_LENGTH );
+	status = krnlSendMessage( DEFAULTUSER_OBJECT_HANDLE,
+							  IMESSAGE_GETATTRIBUTE_S, &msgData,
+							  CRYPT_OPTION_SESSION_TICKETKEYFILE );
+	if( cryptStatusError( status ) )
+		return( CRYPT_ERROR_NOTFOUND );
+	keyFilePath[ msgData.length ] = '\0';
+
+	/* Read the key records.  Anything after the last complete record that
+	   we can use is ignored */
+	status = sFileOpen( &stream, keyFilePath, FILE_FLAG_READ );
+	if( cryptStatusError( status ) )
+		{
+		DEBUG_DIAG(( "Couldn't open session ticket key file '%s'",
+					 keyFilePath ));
+		return( status );
+		}
+	sioctlSetString( &stream, STREAM_IOCTL_IOBUFFER, streamBuffer,
+					 STREAM_BUFSIZE );
+	sioctlSet( &stream, STREAM_IOCTL_PARTIALREAD, TRUE );
+	status = length = sread( &stream, keyBuffer,
+							 TICKET_KEYRECORD_SIZE * TICKET_MAX_KEYS );
+	sFileClose( &stream );
+	zeroise( streamBuffer, STREAM_BUFSIZE );
+	if( cryptStatusError( status ) || length < TICKET_KEYRECORD_SIZE )
+		{
+		zeroise( keyBuffer, TICKET_KEYRECORD_SIZE * TICKET_MAX_KEYS );
+		DEBUG_DIAG(( "Session ticket key file '%s' doesn't contain any "
+					 "keys", keyFilePath ));
+		return( CRYPT_ERROR_BADDATA );
+		}
+	LOOP_SMALL( i = 0, i < length / TICKET_KEYRECORD_SIZE, i++ )
+		{
+		const BYTE *keyRecord = keyBuffer + ( i * TICKET_KEYRECORD_SIZE );
+
+		memcpy( keys[ i ].keyName, keyRecord, TICKET_KEYNAME_SIZE );
+		memcpy( keys[ i ].macKey, keyRecord + TICKET_KEYNAME_SIZE,
+				TICKET_MACKEY_SIZE );
+		memcpy( keys[ i ].encKey,
+				keyRecord + TICKET_KEYNAME_SIZE + TICKET_MACKEY_SIZE,
+				TICKET_ENCKEY_SIZE );
+		}
+	ENSURES( LOOP_BOUND_OK );
+	zeroise( keyBuffer, TICKET_KEYRECORD_SIZE * TICKET_MAX_KEYS );
+	*noKeys = i;
+
+	return( CRYPT_OK );
+	}
+
+/* Generate a new internal ticket key */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int generateTicketKey( OUT TICKET_KEY *ticketKey )
+	{
+	MESSAGE_DATA msgData;
+	int status;
+
+	assert( isWritePtr( ticketKey, sizeof( TICKET_KEY ) ) );
+
+	/* The key name doesn't need to be secret, it only has to be unique
+	   among the keys that we accept */
+	setMessageData( &msgData, ticketKey->keyName, TICKET_KEYNAME_SIZE );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_GETATTRIBUTE_S,
+							  &msgData, CRYPT_IATTRIBUTE_RANDOM_NONCE );
+	if( cryptStatusOK( status ) )
+		{
+		setMessageData( &msgData, ticketKey->macKey, TICKET_MACKEY_SIZE );
+		status = krnlSendMessage( SYSTEM_OBJECT_HANDLE,
+								  IMESSAGE_GETATTRIBUTE_S, &msgData,
+								  CRYPT_IATTRIBUTE_RANDOM );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		setMessageData( &msgData, ticketKey->encKey, TICKET_ENCKEY_SIZE );
+		status = krnlSendMessage( SYSTEM_OBJECT_HANDLE,
+								  IMESSAGE_GETATTRIBUTE_S, &msgData,
+								  CRYPT_IATTRIBUTE_RANDOM );
+		}
+	if( cryptStatusError( status ) )
+		zeroise( ticketKey, sizeof( TICKET_KEY ) );
+	return( status );
+	}
+
+/* Update the ticket keys if they're due for a refresh.  The file access
+   and key generation are performed without holding the scoreboard mutex
+   (which we borrow to protect the ticket keys since tickets are the
+   stateless equivalent of the scoreboard) so that we don't stall other
+   sessions while we're doing it */
+
+CHECK_RETVAL \
+static int updateTicketKeys( const time_t currentTime )
+	{
+	TICKET_KEY newKeys[ TICKET_MAX_KEYS + 1 ];
+	BOOLEAN needNewKey, keysFromFile = FALSE;
+	int noNewKeys = 0, status;
+
+	REQUIRES( ticketKeyInfo != NULL );
+	REQUIRES( currentTime > MIN_TIME_VALUE );
+
+	/* See whether the keys are due for a refresh */
+	status = krnlEnterMutex( MUTEX_SCOREBOARD );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( ticketKeyInfo->refreshActive || \
+		currentTime < ticketKeyInfo->checkTime )
+		{
+		krnlExitMutex( MUTEX_SCOREBOARD );
+		return( CRYPT_OK );
+		}
+	ticketKeyInfo->refreshActive = TRUE;
+	needNewKey = ( ticketKeyInfo->keysFromFile || \
+				   ticketKeyInfo->noKeys <= 0 || \
+				   currentTime >= ticketKeyInfo->keyTime + \
+								  TICKET_KEY_LIFETIME ) ? TRUE : FALSE;
+	krnlExitMutex( MUTEX_SCOREBOARD );
+
+	/* Get the new keys, either from the key file or, if there's no key
+	   file configured and the current internal key has expired, by
+	   generating a new one.  If the key file can't be read then we
+	   continue with the existing keys until the next check */
+	status = readTicketKeyFile( newKeys, &noNewKeys );
+	if( cryptStatusOK( status ) )
+		keysFromFile = TRUE;
+	else
+		{
+		if( status == CRYPT_ERROR_NOTFOUND && needNewKey )
+			{
+			status = generateTicketKey( &newKeys[ 0 ] );
+			if( cryptStatusOK( status ) )
+				noNewKeys = 1;
+			}
+		}
+
+	/* Install the new keys.  For internally-generated keys the previous
+	   key is retained so that tickets issued with it remain valid */
+	status = krnlEnterMutex( MUTEX_SCOREBOARD );
+	if( cryptStatusError( status ) )
+		{
+		zeroise( newKeys, sizeof( TICKET_KEY ) * TICKET_MAX_KEYS );
+		return( status );
+		}
+	ticketKeyInfo->refreshActive = FALSE;
+	ticketKeyInfo->checkTime = currentTime + TICKET_KEYFILE_RECHECK;
+	if( keysFromFile )
+		{
+		memcpy( ticketKeyInfo->keys, newKeys,
+				sizeof( TICKET_KEY ) * noNewKeys );
+		ticketKeyInfo->noKeys = noNewKeys;
+		ticketKeyInfo->keysFromFile = TRUE;
+		ticketKeyInfo->keyTime = currentTime;
+		}
+	else
+		{
+		if( noNewKeys > 0 )
+			{
+			if( ticketKeyInfo->noKeys > 0 && !ticketKeyInfo->keysFromFile )
+				{
+				memcpy( &ticketKeyInfo->keys[ 1 ], &ticketKeyInfo->keys[ 0 ],
+						sizeof( TICKET_KEY ) );
+				ticketKeyInfo->noKeys = 2;
+				}
+			else
+				ticketKeyInfo->noKeys = 1;
+			memcpy( &ticketKeyInfo->keys[ 0 ], &newKeys[ 0 ],
+					sizeof( TICKET_KEY ) );
+			ticketKeyInfo->keysFromFile = FALSE;
+			ticketKeyInfo->keyTime = currentTime;
+			}
+		}
+	krnlExitMutex( MUTEX_SCOREBOARD );
+	zeroise( newKeys, sizeof( TICKET_KEY ) * TICKET_MAX_KEYS );
+
+	return( CRYPT_OK );
+	}
+
+/* Get a copy of a ticket key, either the current issuing key if no key
+   name is given or the key with the given name.  The key is copied out so
+   that the crypto operations can be performed without holding the mutex */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int getTicketKey( OUT TICKET_KEY *ticketKey,
+						 IN_BUFFER_OPT( TICKET_KEYNAME_SIZE ) \
+							const BYTE *keyName,
+						 const time_t currentTime )
+	{
+	int i, status, LOOP_ITERATOR;
+
+	assert( isWritePtr( ticketKey, sizeof( TICKET_KEY ) ) );
+	assert( keyName == NULL || \
+			isReadPtr( keyName, TICKET_KEYNAME_SIZE ) );
+
+	REQUIRES( currentTime > MIN_TIME_VALUE );
+
+	/* Clear return value */
+	memset( ticketKey, 0, sizeof( TICKET_KEY ) );
+
+	if( ticketKeyInfo == NULL )
+		return( CRYPT_ERROR_NOTFOUND );
+	status = updateTicketKeys( currentTime );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = krnlEnterMutex( MUTEX_SCOREBOARD );
+	if( cryptStatusError( status ) )
+		return( status );
+	LOOP_SMALL( i = 0, i < ticketKeyInfo->noKeys && \
+					   i < TICKET_MAX_KEYS, i++ )
+		{
+		if( keyName == NULL || \
+			!memcmp( ticketKeyInfo->keys[ i ].keyName, keyName,
+					 TICKET_KEYNAME_SIZE ) )
+			{
+			memcpy( ticketKey, &ticketKeyInfo->keys[ i ],
+					sizeof( TICKET_KEY ) );
+			krnlExitMutex( MUTEX_SCOREBOARD );
+			return( CRYPT_OK );
+			}
+		}
+	ENSURES_KRNLMUTEX( LOOP_BOUND_OK, MUTEX_SCOREBOARD );
+	krnlExitMutex( MUTEX_SCOREBOARD );
+
+	return( CRYPT_ERROR_NOTFOUND );
+	}
+
+/* Record a ticket hit or miss */
+
+static void updateTicketStatistics( const BOOLEAN isHit )
+	{
+	if( ticketKeyInfo == NULL )
+		return;
+	if( cryptStatusError( krnlEnterMutex( MUTEX_SCOREBOARD ) ) )
+		return;
+	if( isHit )
+		{
+		if( ticketKeyInfo->hits < MAX_INTLENGTH - 1 )
+			ticketKeyInfo->hits++;
+		}
+	else
+		{
+		if( ticketKeyInfo->misses < MAX_INTLENGTH - 1 )
+			ticketKeyInfo->misses++;
+		}
+	krnlExitMutex( MUTEX_SCOREBOARD );
+	}
+
+/****************************************************************************
+*																			*
+*							Ticket Crypto Functions							*
+*																			*
+****************************************************************************/
+
+/* MAC the ticket data */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 4 ) ) \
+static int macTicket( const TICKET_KEY *ticketKey,
+					  IN_BUFFER( dataLength ) const BYTE *data,
+					  IN_LENGTH_SHORT const int dataLength,
+					  INOUT_BUFFER_FIXED( TICKET_MAC_SIZE ) BYTE *macValue,
+					  const BOOLEAN checkMAC )
+	{
+	MESSAGE_CREATEOBJECT_INFO createInfo;
+	MESSAGE_DATA msgData;
+	int status;
+
+	assert( isReadPtr( ticketKey, sizeof( TICKET_KEY ) ) );
+	assert( isReadPtrDynamic( data, dataLength ) );
+	assert( isWritePtr( macValue, TICKET_MAC_SIZE ) );
+
+	REQUIRES( dataLength > 0 && dataLength < MAX_INTLENGTH_SHORT );
+	REQUIRES( checkMAC == TRUE || checkMAC == FALSE );
+
+	setMessageCreateObjectInfo( &createInfo, CRYPT_ALGO_HMAC_SHA2 );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_DEV_CREATEOBJECT,
+							  &createInfo, OBJECT_TYPE_CONTEXT );
+	if( cryptStatusError( status ) )
+		return( status );
+	setMessageData( &msgData, ( MESSAGE_CAST ) ticketKey->macKey,
+					TICKET_MACKEY_SIZE );
+	status = krnlSendMessage( createInfo.cryptHandle, IMESSAGE_SETATTRIBUTE_S,
+							  &msgData, CRYPT_CTXINFO_KEY );
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( createInfo.cryptHandle, IMESSAGE_CTX_HASH,
+								  ( MESSAGE_CAST ) data, dataLength );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( createInfo.cryptHandle, IMESSAGE_CTX_HASH,
+								  "", 0 );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		setMessageData( &msgData, macValue, TICKET_MAC_SIZE );
+		if( checkMAC )
+			{
+			status = krnlSendMessage( createInfo.cryptHandle,
+									  IMESSAGE_COMPARE, &msgData,
+									  MESSAGE_COMPARE_HASH );
+			if( cryptStatusError( status ) )
+				status = CRYPT_ERROR_SIGNATURE;
+			}
+		else
+			{
+			status = krnlSendMessage( createInfo.cryptHandle,
+									  IMESSAGE_GETATTRIBUTE_S, &msgData,
+									  CRYPT_CTXINFO_HASHVALUE );
+			}
+		}
+	krnlSendNotifier( createInfo.cryptHandle, IMESSAGE_DECREFCOUNT );
+
+	return( status );
+	}
+
+/* Encrypt or decrypt the ticket state */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+static int cryptTicket( const TICKET_KEY *ticketKey,
+						IN_BUFFER( TICKET_IV_SIZE ) const BYTE *iv,
+						INOUT_BUFFER_FIXED( stateLength ) BYTE *state,
+						IN_LENGTH_SHORT const int stateLength,
+						const BOOLEAN doEncrypt )
+	{
+	MESSAGE_CREATEOBJECT_INFO createInfo;
+	MESSAGE_DATA msgData;
+	int status;
+
+	assert( isReadPtr( ticketKey, sizeof( TICKET_KEY ) ) );
+	assert( isReadPtr( iv, TICKET_IV_SIZE ) );
+	assert( isWritePtrDynamic( state, stateLength ) );
+
+	REQUIRES( stateLength > 0 && stateLength < MAX_INTLENGTH_SHORT && \
+			  stateLength % 16 == 0 );
+	REQUIRES( doEncrypt == TRUE || doEncrypt == FALSE );
+
+	setMessageCreateObjectInfo( &createInfo, CRYPT_ALGO_AES );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_DEV_CREATEOBJECT,
+							  &createInfo, OBJECT_TYPE_CONTEXT );
+	if( cryptStatusError( status ) )
+		return( status );
+	setMessageData( &msgData, ( MESSAGE_CAST ) ticketKey->encKey,
+					TICKET_ENCKEY_SIZE );
+	status = krnlSendMessage( createInfo.cryptHandle, IMESSAGE_SETATTRIBUTE_S,
+							  &msgData, CRYPT_CTXINFO_KEY );
+	if( cryptStatusOK( status ) )
+		{
+		setMessageData( &msgData, ( MESSAGE_CAST ) iv, TICKET_IV_SIZE );
+		status = krnlSendMessage( createInfo.cryptHandle,
+								  IMESSAGE_SETATTRIBUTE_S, &msgData,
+								  CRYPT_CTXINFO_IV );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( createInfo.cryptHandle,
+								  doEncrypt ? IMESSAGE_CTX_ENCRYPT : \
+											  IMESSAGE_CTX_DECRYPT,
+								  state, stateLength );
+		}
+	krnlSendNotifier( createInfo.cryptHandle, IMESSAGE_DECREFCOUNT );
+
+	return( status );
+	}
+
+/****************************************************************************
+*																			*
+*							Write/Check Session Tickets						*
+*																			*
+****************************************************************************/
+
+/* Write the body of a NewSessionTicket message:
+
+	uint32		ticketLifetimeHint
+	uint16		ticketLength
+	byte[]		ticket
+
+   If we can't create a ticket then we send a zero-length one, which tells
+   the client that it's not getting a ticket after all (RFC 5077 section
+   3.3) */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3, 4 ) ) \
+int writeSessionTicket( INOUT SESSION_INFO *sessionInfoPtr,
+						const SSL_HANDSHAKE_INFO *handshakeInfo,
+						INOUT STREAM *stream,
+						IN_BUFFER( masterSecretSize ) const void *masterSecret,
+						IN_LENGTH_FIXED( SSL_SECRET_SIZE ) \
+							const int masterSecretSize )
+	{
+	STREAM stateStream;
+	MESSAGE_DATA msgData;
+	TICKET_KEY ticketKey;
+	BYTE ticket[ SSL_TICKET_SIZE + 8 ];
+	BYTE *ivPtr = ticket + TICKET_KEYNAME_SIZE;
+	BYTE *statePtr = ivPtr + TICKET_IV_SIZE;
+	const time_t currentTime = getTime();
+	int status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isReadPtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+	assert( isReadPtrDynamic( masterSecret, masterSecretSize ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( masterSecretSize == SSL_SECRET_SIZE );
+	REQUIRES( SSL_TICKET_SIZE == TICKET_MACDATA_SIZE + TICKET_MAC_SIZE );
+
+	/* Get the current ticket key.  If there's no time or no key available
+	   then we can't issue a ticket */
+	if( currentTime <= MIN_TIME_VALUE )
+		status = CRYPT_ERROR_NOTINITED;
+	else
+		status = getTicketKey( &ticketKey, NULL, currentTime );
+	if( cryptStatusError( status ) )
+		{
+		writeUint32( stream, 0 );
+		return( writeUint16( stream, 0 ) );
+		}
+	memcpy( ticket, ticketKey.keyName, TICKET_KEYNAME_SIZE );
+	setMessageData( &msgData, ivPtr, TICKET_IV_SIZE );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_GETATTRIBUTE_S,
+							  &msgData, CRYPT_IATTRIBUTE_RANDOM_NONCE );
+	if( cryptStatusError( status ) )
+		{
+		zeroise( &ticketKey, sizeof( TICKET_KEY ) );
+		return( status );
+		}
+
+	/* Encode the session state */
+	memset( statePtr, 0, TICKET_STATE_SIZE );
+	sMemOpen( &stateStream, statePtr, TICKET_STATE_SIZE );
+	sputc( &stateStream, TICKET_VERSION );
+	sputc( &stateStream, sessionInfoPtr->version );
+	writeUint16( &stateStream, handshakeInfo->cipherSuite );
+	writeUint32( &stateStream, sessionInfoPtr->protocolFlags & \
+							   SSL_RESUMEDSESSION_FLAGS );
+	writeUint32Time( &stateStream, currentTime );
+	sputc( &stateStream, handshakeInfo->hashedSNIpresent ? 1 : 0 );
+	swrite( &stateStream, handshakeInfo->hashedSNI, KEYID_SIZE );
+	status = swrite( &stateStream, masterSecret, masterSecretSize );
+	sMemDisconnect( &stateStream );
+	ENSURES( cryptStatusOK( status ) );
+
+	/* Seal the state and write the ticket */
+	status = cryptTicket( &ticketKey, ivPtr, statePtr, TICKET_STATE_SIZE,
+						  TRUE );
+	if( cryptStatusOK( status ) )
+		{
+		status = macTicket( &ticketKey, ticket, TICKET_MACDATA_SIZE,
+							ticket + TICKET_MACDATA_SIZE, FALSE );
+		}
+	zeroise( &ticketKey, sizeof( TICKET_KEY ) );
+	if( cryptStatusError( status ) )
+		{
+		zeroise( ticket, SSL_TICKET_SIZE );
+		return( status );
+		}
+	writeUint32( stream, SSL_TICKET_LIFETIME );
+	writeUint16( stream, SSL_TICKET_SIZE );
+	status = swrite( stream, ticket, SSL_TICKET_SIZE );
+	DEBUG_PRINT(( "Issued session ticket, key name = \n" ));
+	DEBUG_DUMP_DATA( ticket, TICKET_KEYNAME_SIZE );
+
+	return( status );
+	}
+
+/* Check a session ticket sent by the client and, if it's valid for the
+   current session, return the master secret and metadata for it.  Tickets
+   that can't be used, either because they're not one of ours or because
+   they're for a different cipher suite or protocol version, are reported
+   as CRYPT_ERROR_NOTFOUND, in which case the caller continues with a full
+   handshake */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3, 5, 6 ) ) \
+int checkSessionTicket( INOUT SESSION_INFO *sessionInfoPtr,
+						const SSL_HANDSHAKE_INFO *handshakeInfo,
+						OUT_BUFFER( masterSecretMaxLength, \
+									*masterSecretLength ) \
+							void *masterSecret,
+						IN_LENGTH_FIXED( SSL_SECRET_SIZE ) \
+							const int masterSecretMaxLength,
+						OUT_LENGTH_BOUNDED_Z( masterSecretMaxLength ) \
+							int *masterSecretLength,
+						OUT_INT_Z int *metaData )
+	{
+	STREAM stream;
+	TICKET_KEY ticketKey;
+	BYTE ticket[ SSL_TICKET_SIZE + 8 ];
+	BYTE hashedSNI[ KEYID_SIZE + 8 ];
+	BYTE *statePtr = ticket + TICKET_KEYNAME_SIZE + TICKET_IV_SIZE;
+	const time_t currentTime = getTime();
+	time_t issueTime;
+	int version, protocolVersion, cipherSuite, hashedSNIpresent = 0;
+	int metaDataValue, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isReadPtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isWritePtrDynamic( masterSecret, masterSecretMaxLength ) );
+	assert( isWritePtr( masterSecretLength, sizeof( int ) ) );
+	assert( isWritePtr( metaData, sizeof( int ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( masterSecretMaxLength == SSL_SECRET_SIZE );
+
+	/* Clear return values */
+	memset( masterSecret, 0, masterSecretMaxLength );
+	*masterSecretLength = 0;
+	*metaData = 0;
+
+	/* Make sure that the ticket is one that we could have issued and get
+	   the key that was used to create it */
+	if( handshakeInfo->sessionTicketLength != SSL_TICKET_SIZE || \
+		currentTime <= MIN_TIME_VALUE )
+		{
+		updateTicketStatistics( FALSE );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+	memcpy( ticket, handshakeInfo->sessionTicket, SSL_TICKET_SIZE );
+	status = getTicketKey( &ticketKey, ticket, currentTime );
+	if( cryptStatusError( status ) )
+		{
+		updateTicketStatistics( FALSE );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+
+	/* Check the MAC and decrypt the session state */
+	status = macTicket( &ticketKey, ticket, TICKET_MACDATA_SIZE,
+						ticket + TICKET_MACDATA_SIZE, TRUE );
+	if( cryptStatusOK( status ) )
+		{
+		status = cryptTicket( &ticketKey, ticket + TICKET_KEYNAME_SIZE,
+							  statePtr, TICKET_STATE_SIZE, FALSE );
+		}
+	zeroise( &ticketKey, sizeof( TICKET_KEY ) );
+	if( cryptStatusError( status ) )
+		{
+		zeroise( ticket, SSL_TICKET_SIZE );
+		updateTicketStatistics( FALSE );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+
+	/* Decode the session state */
+	sMemConnect( &stream, statePtr, TICKET_STATE_SIZE );
+	version = sgetc( &stream );
+	protocolVersion = sgetc( &stream );
+	cipherSuite = readUint16( &stream );
+	metaDataValue = readUint32( &stream );
+	status = readUint32Time( &stream, &issueTime );
+	if( cryptStatusOK( status ) )
+		{
+		hashedSNIpresent = sgetc( &stream );
+		status = sread( &stream, hashedSNI, KEYID_SIZE );
+		}
+	if( cryptStatusOK( status ) )
+		status = sread( &stream, masterSecret, SSL_SECRET_SIZE );
+	sMemDisconnect( &stream );
+	zeroise( ticket, SSL_TICKET_SIZE );
+	if( cryptStatusError( status ) || version != TICKET_VERSION || \
+		cryptStatusError( metaDataValue ) )
+		{
+		zeroise( masterSecret, masterSecretMaxLength );
+		updateTicketStatistics( FALSE );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+
+	/* Make sure that the ticket is still valid and that it's for the
+	   current session parameters, including the server name if SNI is in
+	   use in the same way as it's used with the session ID for scoreboard
+	   lookups */
+	if( issueTime > currentTime + 60 || \
+		currentTime >= issueTime + SSL_TICKET_LIFETIME || \
+		protocolVersion != sessionInfoPtr->version || \
+		cipherSuite != handshakeInfo->cipherSuite || \
+		( hashedSNIpresent ? TRUE : FALSE ) != \
+			( handshakeInfo->hashedSNIpresent ? TRUE : FALSE ) || \
+		( handshakeInfo->hashedSNIpresent && \
+		  !compareDataConstTime( hashedSNI, handshakeInfo->hashedSNI,
+								 KEYID_SIZE ) ) )
+		{
+		zeroise( masterSecret, masterSecretMaxLength );
+		updateTicketStatistics( FALSE );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+	*masterSecretLength = SSL_SECRET_SIZE;
+	*metaData = metaDataValue;
+	updateTicketStatistics( TRUE );
+
+	return( CRYPT_OK );
+	}
+
+/****************************************************************************
+*																			*
+*						Shared Scoreboard Entry Protection					*
+*																			*
+****************************************************************************/
+
+/* Entries in the shared scoreboard (see scoreshm.c) are sealed in the same
+   way as tickets, since the cache file is just as exposed as a ticket
+   that's been handed to the client.  The sealed entry is:
+
+	byte[16]	keyName
+	byte[16]	iv
+	byte[64]	encryptedData		-- AES-256-CBC
+	byte[32]	mac					-- HMAC-SHA256( keyHash || keyName ||
+															iv || encryptedData )
+
+   with the key hash under which the entry is filed being MAC'd alongside
+   the entry so that an entry can't be moved to a different slot in the
+   cache to have it returned for a different session ID.  Since the cache
+   is shared across processes, the keys have to be shared as well, so we
+   only use the ticket keys if they've come from the ticket key file.
+   Internally-generated keys are private to each process, which would make
+   the entries unreadable to anything but the process that wrote them.
+   The encryption and MAC keys are derived from the ticket MAC key so that
+   the same keys are never used for both tickets and scoreboard entries */
+
+#define SEALED_KEYNAME_OFFSET	0
+#define SEALED_IV_OFFSET		TICKET_KEYNAME_SIZE
+#define SEALED_DATA_OFFSET		( SEALED_IV_OFFSET + TICKET_IV_SIZE )
+#define SEALED_MAC_OFFSET		( SEALED_DATA_OFFSET + \
+								  SHARED_SCOREBOARD_DATA_SIZE )
+#define SEALED_MACDATA_SIZE		( HASH_DATA_SIZE + SEALED_MAC_OFFSET )
+
+/* Get the keys for a shared scoreboard entry, either the keys derived from
+   the current issuing ticket key if no key name is given or the ones
+   derived from the ticket key with the given name */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int getScoreboardKey( OUT TICKET_KEY *scoreboardKey,
+							 IN_BUFFER_OPT( TICKET_KEYNAME_SIZE ) \
+								const BYTE *keyName,
+							 const time_t currentTime )
+	{
+	static const char *macKeyLabel = "scoreboard entry MAC key";
+	static const char *encKeyLabel = "scoreboard entry encryption key";
+	TICKET_KEY ticketKey;
+	BOOLEAN keysFromFile;
+	int status;
+
+	assert( isWritePtr( scoreboardKey, sizeof( TICKET_KEY ) ) );
+	assert( keyName == NULL || \
+			isReadPtr( keyName, TICKET_KEYNAME_SIZE ) );
+
+	REQUIRES( currentTime > MIN_TIME_VALUE );
+
+	/* Clear return value */
+	memset( scoreboardKey, 0, sizeof( TICKET_KEY ) );
+
+	/* Get the ticket key and make sure that it's one that's shared with
+	   other processes */
+	status = getTicketKey( &ticketKey, keyName, currentTime );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = krnlEnterMutex( MUTEX_SCOREBOARD );
+	if( cryptStatusError( status ) )
+		{
+		zeroise( &ticketKey, sizeof( TICKET_KEY ) );
+		return( status );
+		}
+	keysFromFile = ticketKeyInfo->keysFromFile;
+	krnlExitMutex( MUTEX_SCOREBOARD );
+	if( !keysFromFile )
+		{
+		zeroise( &ticketKey, sizeof( TICKET_KEY ) );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+
+	/* Derive the scoreboard entry keys from the ticket MAC key */
+	memcpy( scoreboardKey->keyName, ticketKey.keyName, TICKET_KEYNAME_SIZE );
+	status = macTicket( &ticketKey, ( const BYTE * ) macKeyLabel,
+						strlen( macKeyLabel ), scoreboardKey->macKey,
+						FALSE );
+	if( cryptStatusOK( status ) )
+		{
+		status = macTicket( &ticketKey, ( const BYTE * ) encKeyLabel,
+							strlen( encKeyLabel ), scoreboardKey->encKey,
+							FALSE );
+		}
+	zeroise( &ticketKey, sizeof( TICKET_KEY ) );
+	if( cryptStatusError( status ) )
+		zeroise( scoreboardKey, sizeof( TICKET_KEY ) );
+	return( status );
+	}
+
+/* Seal and open a shared scoreboard entry */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int sealScoreboardEntry( IN_BUFFER( HASH_DATA_SIZE ) const BYTE *keyHash,
+						 IN_BUFFER( SHARED_SCOREBOARD_DATA_SIZE ) \
+							const BYTE *data,
+						 OUT_BUFFER_FIXED( SHARED_SCOREBOARD_SEALED_SIZE ) \
+							BYTE *sealedData )
+	{
+	MESSAGE_DATA msgData;
+	TICKET_KEY scoreboardKey;
+	BYTE macData[ SEALED_MACDATA_SIZE + 8 ];
+	const time_t currentTime = getTime();
+	int status;
+
+	assert( isReadPtr( keyHash, HASH_DATA_SIZE ) );
+	assert( isReadPtr( data, SHARED_SCOREBOARD_DATA_SIZE ) );
+	assert( isWritePtr( sealedData, SHARED_SCOREBOARD_SEALED_SIZE ) );
+
+	REQUIRES( SHARED_SCOREBOARD_SEALED_SIZE == \
+			  SEALED_MAC_OFFSET + TICKET_MAC_SIZE );
+
+	/* Clear return value */
+	memset( sealedData, 0, SHARED_SCOREBOARD_SEALED_SIZE );
+
+	if( currentTime <= MIN_TIME_VALUE )
+		return( CRYPT_ERROR_NOTINITED );
+	status = getScoreboardKey( &scoreboardKey, NULL, currentTime );
+	if( cryptStatusError( status ) )
+		return( status );
+	memcpy( sealedData + SEALED_KEYNAME_OFFSET, scoreboardKey.keyName,
+			TICKET_KEYNAME_SIZE );
+	setMessageData( &msgData, sealedData + SEALED_IV_OFFSET,
+					TICKET_IV_SIZE );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_GETATTRIBUTE_S,
+							  &msgData, CRYPT_IATTRIBUTE_RANDOM_NONCE );
+	if( cryptStatusOK( status ) )
+		{
+		memcpy( sealedData + SEALED_DATA_OFFSET, data,
+				SHARED_SCOREBOARD_DATA_SIZE );
+		status = cryptTicket( &scoreboardKey, sealedData + SEALED_IV_OFFSET,
+							  sealedData + SEALED_DATA_OFFSET,
+							  SHARED_SCOREBOARD_DATA_SIZE, TRUE );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		memcpy( macData, keyHash, HASH_DATA_SIZE );
+		memcpy( macData + HASH_DATA_SIZE, sealedData, SEALED_MAC_OFFSET );
+		status = macTicket( &scoreboardKey, macData, SEALED_MACDATA_SIZE,
+							sealedData + SEALED_MAC_OFFSET, FALSE );
+		}
+	zeroise( &scoreboardKey, sizeof( TICKET_KEY ) );
+	if( cryptStatusError( status ) )
+		zeroise( sealedData, SHARED_SCOREBOARD_SEALED_SIZE );
+	return( status );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int openScoreboardEntry( IN_BUFFER( HASH_DATA_SIZE ) const BYTE *keyHash,
+						 IN_BUFFER( SHARED_SCOREBOARD_SEALED_SIZE ) \
+							const BYTE *sealedData,
+						 OUT_BUFFER_FIXED( SHARED_SCOREBOARD_DATA_SIZE ) \
+							BYTE *data )
+	{
+	TICKET_KEY scoreboardKey;
+	BYTE macData[ SEALED_MACDATA_SIZE + 8 ];
+	const time_t currentTime = getTime();
+	int status;
+
+	assert( isReadPtr( keyHash, HASH_DATA_SIZE ) );
+	assert( isReadPtr( sealedData, SHARED_SCOREBOARD_SEALED_SIZE ) );
+	assert( isWritePtr( data, SHARED_SCOREBOARD_DATA_SIZE ) );
+
+	/* Clear return value */
+	memset( data, 0, SHARED_SCOREBOARD_DATA_SIZE );
+
+	if( currentTime <= MIN_TIME_VALUE )
+		return( CRYPT_ERROR_NOTFOUND );
+	status = getScoreboardKey( &scoreboardKey,
+							   sealedData + SEALED_KEYNAME_OFFSET,
+							   currentTime );
+	if( cryptStatusError( status ) )
+		return( CRYPT_ERROR_NOTFOUND );
+
+	/* Check the MAC and decrypt the entry */
+	memcpy( macData, keyHash, HASH_DATA_SIZE );
+	memcpy( macData + HASH_DATA_SIZE, sealedData, SEALED_MAC_OFFSET );
+	status = macTicket( &scoreboardKey, macData, SEALED_MACDATA_SIZE,
+						( BYTE * ) sealedData + SEALED_MAC_OFFSET, TRUE );
+	if( cryptStatusOK( status ) )
+		{
+		memcpy( data, sealedData + SEALED_DATA_OFFSET,
+				SHARED_SCOREBOARD_DATA_SIZE );
+		status = cryptTicket( &scoreboardKey,
+							  sealedData + SEALED_IV_OFFSET, data,
+							  SHARED_SCOREBOARD_DATA_SIZE, FALSE );
+		}
+	zeroise( &scoreboardKey, sizeof( TICKET_KEY ) );
+	if( cryptStatusError( status ) )
+		{
+		zeroise( data, SHARED_SCOREBOARD_DATA_SIZE );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+
+	return( CRYPT_OK );
+	}
+
+#ifdef USE_TLS13
+
+/****************************************************************************
+*																			*
+*							TLS 1.3 Client Tickets							*
+*																			*
+****************************************************************************/
+
+/* Remember a ticket sent to us by a TLS 1.3 server.  If there's already a
+   ticket for the server then it's replaced, otherwise we use a free or
+   expired entry or, if the cache is full, the oldest one */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 5 ) ) \
+int addClientTicket( IN_BUFFER( serverNameLength ) const void *serverName,
+					 IN_LENGTH_DNS const int serverNameLength,
+					 IN_BUFFER( ticketLength ) const void *ticket,
+					 IN_LENGTH_SHORT const int ticketLength,
+					 IN_BUFFER_C( 32 ) const BYTE *psk,
+					 IN_RANGE( 1, 65535 ) const int cipherSuite,
+					 const long ticketAgeAdd, const int ticketLifetime )
+	{
+	CLIENT_TICKET *clientTicket = NULL;
+	BYTE nameHash[ KEYID_SIZE + 8 ];
+	const time_t currentTime = getTime();
+	int i, LOOP_ITERATOR;
+
+	assert( isReadPtrDynamic( serverName, serverNameLength ) );
+	assert( isReadPtrDynamic( ticket, ticketLength ) );
+	assert( isReadPtr( psk, TLS13_SECRET_SIZE ) );
+
+	REQUIRES( serverNameLength > 0 && serverNameLength <= MAX_DNS_SIZE );
+	REQUIRES( ticketLength > 0 && ticketLength < MAX_INTLENGTH_SHORT );
+	REQUIRES( cipherSuite >= 1 && cipherSuite <= 65535 );
+
+	/* If the ticket is too large to store, has no lifetime, or we can't
+	   tell when it'll expire, there's nothing to do */
+	if( ticketLength > CLIENT_TICKET_SIZE || ticketLifetime <= 0 || \
+		currentTime <= MIN_TIME_VALUE || ticketKeyInfo == NULL )
+		return( CRYPT_OK );
+
+	hashData( nameHash, KEYID_SIZE, serverName, serverNameLength );
+	if( cryptStatusError( krnlEnterMutex( MUTEX_SCOREBOARD ) ) )
+		return( CRYPT_OK );
+	LOOP_SMALL( i = 0, i < CLIENT_TICKET_MAX, i++ )
+		{
+		CLIENT_TICKET *entry = &ticketKeyInfo->clientTickets[ i ];
+
+		if( entry->ticketLength > 0 && \
+			!memcmp( entry->nameHash, nameHash, KEYID_SIZE ) )
+			{
+			clientTicket = entry;
+			break;
+			}
+		if( clientTicket == NULL || entry->ticketLength <= 0 || \
+			entry->expiryTime <= currentTime || \
+			( clientTicket->ticketLength > 0 && \
+			  clientTicket->expiryTime > currentTime && \
+			  entry->issueTime < clientTicket->issueTime ) )
+			clientTicket = entry;
+		}
+	ENSURES_KRNLMUTEX( LOOP_BOUND_OK, MUTEX_SCOREBOARD );
+	ENSURES_KRNLMUTEX( clientTicket != NULL, MUTEX_SCOREBOARD );
+	memcpy( clientTicket->nameHash, nameHash, KEYID_SIZE );
+	memcpy( clientTicket->ticket, ticket, ticketLength );
+	clientTicket->ticketLength = ticketLength;
+	memcpy( clientTicket->psk, psk, TLS13_SECRET_SIZE );
+	clientTicket->cipherSuite = cipherSuite;
+	clientTicket->ticketAgeAdd = ticketAgeAdd;
+	clientTicket->issueTime = currentTime;
+	clientTicket->expiryTime = currentTime + \
+							   min( ticketLifetime, SSL_TICKET_LIFETIME );
+	krnlExitMutex( MUTEX_SCOREBOARD );
+
+	return( CRYPT_OK );
+	}
+
+/* Get a ticket for a server, removing it from the cache in the process.
+   The ticket age is returned in the obfuscated form that's sent to the
+   server, ( age_ms + ticketAgeAdd ) mod 2^32 */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 5, 6, 7, 8 ) ) \
+int getClientTicket( IN_BUFFER( serverNameLength ) const void *serverName,
+					 IN_LENGTH_DNS const int serverNameLength,
+					 OUT_BUFFER( ticketMaxLength, *ticketLength ) \
+						void *ticket,
+					 IN_LENGTH_SHORT const int ticketMaxLength,
+					 OUT_LENGTH_BOUNDED_Z( ticketMaxLength ) \
+						int *ticketLength,
+					 OUT_BUFFER_FIXED( 32 ) BYTE *psk,
+					 OUT_INT_Z int *cipherSuite,
+					 OUT long *obfuscatedAge )
+	{
+	BYTE nameHash[ KEYID_SIZE + 8 ];
+	const time_t currentTime = getTime();
+	int i, status = CRYPT_ERROR_NOTFOUND, LOOP_ITERATOR;
+
+	assert( isReadPtrDynamic( serverName, serverNameLength ) );
+	assert( isWritePtrDynamic( ticket, ticketMaxLength ) );
+	assert( isWritePtr( ticketLength, sizeof( int ) ) );
+	assert( isWritePtr( psk, TLS13_SECRET_SIZE ) );
+	assert( isWritePtr( cipherSuite, sizeof( int ) ) );
+	assert( isWritePtr( obfuscatedAge, sizeof( long ) ) );
+
+	REQUIRES( serverNameLength > 0 && serverNameLength <= MAX_DNS_SIZE );
+	REQUIRES( ticketMaxLength > 0 && ticketMaxLength < MAX_INTLENGTH_SHORT );
+
+	/* Clear return values */
+	memset( ticket, 0, min( 16, ticketMaxLength ) );
+	*ticketLength = 0;
+	memset( psk, 0, TLS13_SECRET_SIZE );
+	*cipherSuite = 0;
+	*obfuscatedAge = 0;
+
+	if( currentTime <= MIN_TIME_VALUE || ticketKeyInfo == NULL )
+		return( CRYPT_ERROR_NOTFOUND );
+	hashData( nameHash, KEYID_SIZE, serverName, serverNameLength );
+	status = krnlEnterMutex( MUTEX_SCOREBOARD );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = CRYPT_ERROR_NOTFOUND;
+	LOOP_SMALL( i = 0, i < CLIENT_TICKET_MAX, i++ )
+		{
+		CLIENT_TICKET *entry = &ticketKeyInfo->clientTickets[ i ];
+
+		if( entry->ticketLength <= 0 || \
+			memcmp( entry->nameHash, nameHash, KEYID_SIZE ) )
+			continue;
+		if( entry->expiryTime > currentTime && \
+			entry->issueTime <= currentTime && \
+			entry->ticketLength <= ticketMaxLength )
+			{
+			const unsigned long ageMS = \
+				( unsigned long ) ( currentTime - entry->issueTime ) * 1000;
+
+			memcpy( ticket, entry->ticket, entry->ticketLength );
+			*ticketLength = entry->ticketLength;
+			memcpy( psk, entry->psk, TLS13_SECRET_SIZE );
+			*cipherSuite = entry->cipherSuite;
+			*obfuscatedAge = ( long ) ( ( ageMS + \
+								( unsigned long ) entry->ticketAgeAdd ) & \
+										0xFFFFFFFFUL );
+			status = CRYPT_OK;
+			}
+		zeroise( entry, sizeof( CLIENT_TICKET ) );
+		break;
+		}
+	krnlExitMutex( MUTEX_SCOREBOARD );
+	ENSURES( LOOP_BOUND_OK );
+
+	return( status );
+	}
+#endif /* USE_TLS13 */
+
+/****************************************************************************
+*																			*
+*							Init/Shutdown Functions							*
+*																			*
+****************************************************************************/
+
+/* Get session ticket usage statistics */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+int getSessionTicketStatistic( IN_ATTRIBUTE \
+									const CRYPT_ATTRIBUTE_TYPE attribute,
+							   OUT_INT_Z int *value )
+	{
+	int status;
+
+	assert( isWritePtr( value, sizeof( int ) ) );
+
+	REQUIRES( attribute == CRYPT_OPTION_SESSION_TICKETHITS || \
+			  attribute == CRYPT_OPTION_SESSION_TICKETMISSES );
+
+	/* Clear return value */
+	*value = 0;
+
+	if( ticketKeyInfo == NULL )
+		return( CRYPT_OK );
+	status = krnlEnterMutex( MUTEX_SCOREBOARD );
+	if( cryptStatusError( status ) )
+		return( status );
+	*value = ( attribute == CRYPT_OPTION_SESSION_TICKETHITS ) ? \
+			 ticketKeyInfo->hits : ticketKeyInfo->misses;
+	krnlExitMutex( MUTEX_SCOREBOARD );
+
+	return( CRYPT_OK );
+	}
+
+/* Initialise and shut down the session ticket key storage.  The keys
+   themselves aren't generated or read until the first ticket is issued or
+   checked, since the randomness subsystem may not be ready yet when we're
+   called */
+
+CHECK_RETVAL \
+int initSessionTickets( void )
+	{
+	int status;
+
+	status = krnlMemalloc( ( void ** ) &ticketKeyInfo,
+						   sizeof( TICKET_KEY_INFO ) );
+	if( cryptStatusError( status ) )
+		{
+		DEBUG_DIAG(( "Couldn't allocate %d bytes secure memory for "
+					 "session ticket keys", sizeof( TICKET_KEY_INFO ) ));
+		return( status );
+		}
+	memset( ticketKeyInfo, 0, sizeof( TICKET_KEY_INFO ) );
+
+	return( CRYPT_OK );
+	}
+
+void endSessionTickets( void )
+	{
+	int status;
+
+	if( ticketKeyInfo == NULL )
+		return;
+	status = krnlEnterMutex( MUTEX_SCOREBOARD );
+	if( cryptStatusError( status ) )
+		return;
+	zeroise( ticketKeyInfo, sizeof( TICKET_KEY_INFO ) );
+	status = krnlMemfree( ( void ** ) &ticketKeyInfo );
+	krnlExitMutex( MUTEX_SCOREBOARD );
+	ENSURES_V( cryptStatusOK( status ) );
+	}
+#endif /* USE_SSL_TICKETS */
@@ -0,0 +1,2178 @@
+/****************************************************************************
+*																			*
+*					cryptlib TLS 1.3 Handshake Management					*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#if defined( INC_ALL )
+  #include "crypt.h"
+  #include "misc_rw.h"
+  #include "session.h"
+  #include "ssl.h"
+#else
+  #include "crypt.h"
+  #include "enc_dec/misc_rw.h"
+  #include "session/session.h"
+  #include "session/ssl.h"
+#endif /* Compiler-specific includes */
+
+/* TLS 1.3 (RFC 8446) reuses the TLS 1.2 hello messages for version and
+   cipher suite negotiation but from then on runs a completely different
+   handshake in which the key exchange is carried in the hellos and
+   everything after the server hello is encrypted:
+
+	Client								Server
+
+	ClientHello + key_share		--->
+								<---	ServerHello + key_share
+										{EncryptedExtensions}
+										{Certificate}
+										{CertificateVerify}
+										{Finished}
+	{Finished}					--->
+								<---	[NewSessionTicket]
+
+   If the client hasn't sent a key share for a group that the server can
+   use, or the server wants to force a round trip via a cookie, it responds
+   to the client hello with a HelloRetryRequest and the client sends a
+   second client hello.  If the client is resuming a session it sends the
+   ticket from a previous session as a PSK identity and, if the server
+   accepts it, the certificate and certificate verify messages are
+   omitted.  We always use the PSK together with an ephemeral key exchange
+   (psk_dhe_ke) so that resumed sessions retain forward secrecy.
+
+   The handshake hashing is also different to TLS 1.2 since the transcript
+   hash is required at several intermediate points within a single flight
+   of messages, so we hash each message individually rather than each
+   packet as a whole.
+
+   We implement a deliberately restricted profile of TLS 1.3, X25519 for
+   the key exchange, RSA-PSS for the signatures, and SHA-256-based suites,
+   since these are the ones that all implementations support.  Early
+   (0-RTT) data and client certificates aren't supported */
+
+#if defined( USE_SSL ) && defined( USE_TLS13 )
+
+/* The size of the TLS 1.3 X25519 key share and the shared secret derived
+   from it */
+
+#define TLS13_KEYSHARE_SIZE		32
+
+/* The maximum number of certificates in a TLS 1.3 certificate chain that
+   we send */
+
+#define TLS13_MAX_CHAINLENGTH	16
+
+/****************************************************************************
+*																			*
+*								Utility Functions							*
+*																			*
+****************************************************************************/
+
+/* Hash a handshake message into the transcript hash */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int hashTranscript( const SSL_HANDSHAKE_INFO *handshakeInfo,
+						   IN_BUFFER( dataLength ) const void *data,
+						   IN_DATALENGTH const int dataLength )
+	{
+	assert( isReadPtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isReadPtrDynamic( data, dataLength ) );
+
+	REQUIRES( dataLength > 0 && dataLength < MAX_BUFFER_SIZE );
+
+	return( krnlSendMessage( handshakeInfo->sha2context, IMESSAGE_CTX_HASH,
+							 ( MESSAGE_CAST ) data, dataLength ) );
+	}
+
+/* Hash the handshake message that extends from 'startPos' to the current
+   position in the stream into the transcript hash */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int hashStreamMessage( const SSL_HANDSHAKE_INFO *handshakeInfo,
+							  INOUT STREAM *stream,
+							  IN_DATALENGTH_Z const int startPos )
+	{
+	const int length = stell( stream ) - startPos;
+	void *dataPtr;
+	int status;
+
+	assert( isReadPtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+
+	REQUIRES( startPos >= 0 && startPos < MAX_BUFFER_SIZE );
+	REQUIRES( length > 0 && length < MAX_BUFFER_SIZE );
+
+	status = sMemGetDataBlockAbs( stream, startPos, &dataPtr, length );
+	if( cryptStatusError( status ) )
+		return( status );
+	ANALYSER_HINT( dataPtr != NULL );
+	return( hashTranscript( handshakeInfo, dataPtr, length ) );
+	}
+
+/* Get a SHA-256 hash value, either of the given data or of the current
+   transcript continued over the given data.  Since the transcript hash is
+   required at intermediate points in the handshake, we get it by
+   completing a clone of the transcript-hash context rather than the
+   context itself */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 4 ) ) \
+static int getHashValue( IN_HANDLE_OPT const CRYPT_CONTEXT iTranscriptContext,
+						 IN_BUFFER_OPT( dataLength ) const void *data,
+						 IN_LENGTH_SHORT_Z const int dataLength,
+						 OUT_BUFFER_FIXED( TLS13_SECRET_SIZE ) BYTE *hash )
+	{
+	CRYPT_CONTEXT iHashContext;
+	MESSAGE_DATA msgData;
+	int status;
+
+	assert( ( data == NULL && dataLength == 0 ) || \
+			isReadPtrDynamic( data, dataLength ) );
+	assert( isWritePtr( hash, TLS13_SECRET_SIZE ) );
+
+	REQUIRES( iTranscriptContext == CRYPT_UNUSED || \
+			  isHandleRangeValid( iTranscriptContext ) );
+	REQUIRES( ( data == NULL && dataLength == 0 ) || \
+			  ( data != NULL && \
+				dataLength > 0 && dataLength < MAX_INTLENGTH_SHORT ) );
+
+	/* Clear return value */
+	memset( hash, 0, TLS13_SECRET_SIZE );
+
+	/* Create the context for the hashing, either a new context or a clone
+	   of the transcript-hash context */
+	if( iTranscriptContext == CRYPT_UNUSED )
+		{
+		MESSAGE_CREATEOBJECT_INFO createInfo;
+
+		setMessageCreateObjectInfo( &createInfo, CRYPT_ALGO_SHA2 );
+		status = krnlSendMessage( SYSTEM_OBJECT_HANDLE,
+								  IMESSAGE_DEV_CREATEOBJECT, &createInfo,
+								  OBJECT_TYPE_CONTEXT );
+		iHashContext = createInfo.cryptHandle;
+		}
+	else
+		status = cloneHashContext( iTranscriptContext, &iHashContext );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Hash the data and get the hash value */
+	if( data != NULL )
+		{
+		status = krnlSendMessage( iHashContext, IMESSAGE_CTX_HASH,
+								  ( MESSAGE_CAST ) data, dataLength );
+		}
+	if( cryptStatusOK( status ) )
+		status = krnlSendMessage( iHashContext, IMESSAGE_CTX_HASH, "", 0 );
+	if( cryptStatusOK( status ) )
+		{
+		setMessageData( &msgData, hash, TLS13_SECRET_SIZE );
+		status = krnlSendMessage( iHashContext, IMESSAGE_GETATTRIBUTE_S,
+								  &msgData, CRYPT_CTXINFO_HASHVALUE );
+		}
+	krnlSendNotifier( iHashContext, IMESSAGE_DECREFCOUNT );
+
+	return( status );
+	}
+
+#define getTranscriptHash( handshakeInfo, hash ) \
+		getHashValue( ( handshakeInfo )->sha2context, NULL, 0, hash )
+
+/* After a HelloRetryRequest the first client hello in the transcript is
+   replaced by a synthetic message_hash message containing the hash of
+   the client hello (RFC 8446 section 4.4.1), which is then followed by
+   the HelloRetryRequest itself.  Since we can't reset a hash context, we
+   replace the existing transcript-hash context with a new one */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int restartTranscript( INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+							  IN_BUFFER_C( TLS13_SECRET_SIZE ) \
+								const BYTE *clientHelloHash )
+	{
+	MESSAGE_CREATEOBJECT_INFO createInfo;
+	BYTE messageHash[ 1 + LENGTH_SIZE + TLS13_SECRET_SIZE + 8 ];
+	int status;
+
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isReadPtr( clientHelloHash, TLS13_SECRET_SIZE ) );
+
+	/* Create the new transcript-hash context */
+	setMessageCreateObjectInfo( &createInfo, CRYPT_ALGO_SHA2 );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE,
+							  IMESSAGE_DEV_CREATEOBJECT, &createInfo,
+							  OBJECT_TYPE_CONTEXT );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( handshakeInfo->sha2context != CRYPT_ERROR )
+		krnlSendNotifier( handshakeInfo->sha2context, IMESSAGE_DECREFCOUNT );
+	handshakeInfo->sha2context = createInfo.cryptHandle;
+
+	/* Hash the message_hash message:
+
+		byte		ID = SSL_HAND_MESSAGE_HASH
+		uint24		len = TLS13_SECRET_SIZE
+		byte[]		hash( clientHello ) */
+	messageHash[ 0 ] = SSL_HAND_MESSAGE_HASH;
+	messageHash[ 1 ] = 0;
+	messageHash[ 2 ] = 0;
+	messageHash[ 3 ] = TLS13_SECRET_SIZE;
+	memcpy( messageHash + 1 + LENGTH_SIZE, clientHelloHash,
+			TLS13_SECRET_SIZE );
+	return( hashTranscript( handshakeInfo, messageHash,
+							1 + LENGTH_SIZE + TLS13_SECRET_SIZE ) );
+	}
+
+/* Generate our X25519 key share and compute the shared secret from the
+   peer's key share */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int createKeyShare( INOUT SSL_HANDSHAKE_INFO *handshakeInfo )
+	{
+	KEYAGREE_PARAMS keyAgreeParams;
+	int status;
+
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	status = initX25519contextSSL( &handshakeInfo->dhContext );
+	if( cryptStatusError( status ) )
+		return( status );
+	memset( &keyAgreeParams, 0, sizeof( KEYAGREE_PARAMS ) );
+	status = krnlSendMessage( handshakeInfo->dhContext,
+							  IMESSAGE_CTX_ENCRYPT, &keyAgreeParams,
+							  sizeof( KEYAGREE_PARAMS ) );
+	if( cryptStatusOK( status ) && \
+		keyAgreeParams.publicValueLen != TLS13_KEYSHARE_SIZE )
+		status = CRYPT_ERROR_INTERNAL;
+	if( cryptStatusOK( status ) )
+		{
+		memcpy( handshakeInfo->tls13LocalKeyShare,
+				keyAgreeParams.publicValue, TLS13_KEYSHARE_SIZE );
+		}
+	zeroise( &keyAgreeParams, sizeof( KEYAGREE_PARAMS ) );
+
+	return( status );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int computeSharedSecret( const SSL_HANDSHAKE_INFO *handshakeInfo,
+								OUT_BUFFER_FIXED( TLS13_KEYSHARE_SIZE ) \
+									BYTE *sharedSecret )
+	{
+	KEYAGREE_PARAMS keyAgreeParams;
+	int status;
+
+	assert( isReadPtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isWritePtr( sharedSecret, TLS13_KEYSHARE_SIZE ) );
+
+	REQUIRES( handshakeInfo->tls13KeyShareLength == TLS13_KEYSHARE_SIZE );
+	REQUIRES( isHandleRangeValid( handshakeInfo->dhContext ) );
+
+	/* Clear return value */
+	memset( sharedSecret, 0, TLS13_KEYSHARE_SIZE );
+
+	memset( &keyAgreeParams, 0, sizeof( KEYAGREE_PARAMS ) );
+	memcpy( keyAgreeParams.publicValue, handshakeInfo->tls13KeyShare,
+			TLS13_KEYSHARE_SIZE );
+	keyAgreeParams.publicValueLen = TLS13_KEYSHARE_SIZE;
+	status = krnlSendMessage( handshakeInfo->dhContext,
+							  IMESSAGE_CTX_DECRYPT, &keyAgreeParams,
+							  sizeof( KEYAGREE_PARAMS ) );
+	if( cryptStatusOK( status ) && \
+		keyAgreeParams.wrappedKeyLen != TLS13_KEYSHARE_SIZE )
+		status = CRYPT_ERROR_BADDATA;
+	if( cryptStatusOK( status ) )
+		{
+		memcpy( sharedSecret, keyAgreeParams.wrappedKey,
+				TLS13_KEYSHARE_SIZE );
+		}
+	zeroise( &keyAgreeParams, sizeof( KEYAGREE_PARAMS ) );
+
+	return( status );
+	}
+
+/* Derive the handshake traffic secrets from the early secret and the
+   (EC)DH shared secret, and the application traffic secrets from the
+   handshake secret.  The server's application traffic key is loaded
+   immediately since it's used as soon as the server has sent its
+   Finished, the client's one is remembered until the client's Finished
+   has been sent/received */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+static int deriveHandshakeSecrets( INOUT SSL_HANDSHAKE_INFO *handshakeInfo )
+	{
+	BYTE sharedSecret[ TLS13_KEYSHARE_SIZE + 8 ];
+	BYTE transcriptHash[ TLS13_SECRET_SIZE + 8 ];
+	int status;
+
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	/* Mix the shared secret into the early secret to get the handshake
+	   secret */
+	status = computeSharedSecret( handshakeInfo, sharedSecret );
+	if( cryptStatusOK( status ) )
+		{
+		status = advanceSecretTLS13( handshakeInfo->tls13Secret,
+									 sharedSecret, TLS13_KEYSHARE_SIZE,
+									 FALSE );
+		}
+	zeroise( sharedSecret, TLS13_KEYSHARE_SIZE );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Derive the handshake traffic secrets from the transcript up to the
+	   server hello */
+	status = getTranscriptHash( handshakeInfo, transcriptHash );
+	if( cryptStatusOK( status ) )
+		{
+		status = hkdfExpandLabelTLS13( handshakeInfo->tls13ClientHSSecret,
+									   TLS13_SECRET_SIZE,
+									   handshakeInfo->tls13Secret,
+									   "c hs traffic", 12, transcriptHash,
+									   TLS13_SECRET_SIZE );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = hkdfExpandLabelTLS13( handshakeInfo->tls13ServerHSSecret,
+									   TLS13_SECRET_SIZE,
+									   handshakeInfo->tls13Secret,
+									   "s hs traffic", 12, transcriptHash,
+									   TLS13_SECRET_SIZE );
+		}
+	return( status );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int deriveAppSecrets( INOUT SESSION_INFO *sessionInfoPtr,
+							 INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+							 const BOOLEAN isClient )
+	{
+	BYTE transcriptHash[ TLS13_SECRET_SIZE + 8 ];
+	BYTE serverAppSecret[ TLS13_SECRET_SIZE + 8 ];
+	int status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	REQUIRES( isClient == TRUE || isClient == FALSE );
+
+	/* Advance the handshake secret to the master secret and derive the
+	   application traffic secrets from the transcript up to the server's
+	   Finished */
+	status = advanceSecretTLS13( handshakeInfo->tls13Secret, NULL, 0,
+								 FALSE );
+	if( cryptStatusOK( status ) )
+		status = getTranscriptHash( handshakeInfo, transcriptHash );
+	if( cryptStatusOK( status ) )
+		{
+		status = hkdfExpandLabelTLS13( handshakeInfo->tls13ClientAppSecret,
+									   TLS13_SECRET_SIZE,
+									   handshakeInfo->tls13Secret,
+									   "c ap traffic", 12, transcriptHash,
+									   TLS13_SECRET_SIZE );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = hkdfExpandLabelTLS13( serverAppSecret, TLS13_SECRET_SIZE,
+									   handshakeInfo->tls13Secret,
+									   "s ap traffic", 12, transcriptHash,
+									   TLS13_SECRET_SIZE );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = loadKeysTLS13( sessionInfoPtr, serverAppSecret,
+								handshakeInfo->cryptKeysize, isClient );
+		}
+	zeroise( serverAppSecret, TLS13_SECRET_SIZE );
+
+	return( status );
+	}
+
+/* Derive the resumption master secret from the master secret and the
+   transcript up to the client's Finished */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int deriveResumptionSecret( INOUT SESSION_INFO *sessionInfoPtr,
+								   const SSL_HANDSHAKE_INFO *handshakeInfo )
+	{
+	SSL_INFO *sslInfo = sessionInfoPtr->sessionSSL;
+	BYTE transcriptHash[ TLS13_SECRET_SIZE + 8 ];
+	int status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isReadPtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	status = getTranscriptHash( handshakeInfo, transcriptHash );
+	if( cryptStatusOK( status ) )
+		{
+		status = hkdfExpandLabelTLS13( sslInfo->tls13ResumptionSecret,
+									   TLS13_SECRET_SIZE,
+									   handshakeInfo->tls13Secret,
+									   "res master", 10, transcriptHash,
+									   TLS13_SECRET_SIZE );
+		}
+	return( status );
+	}
+
+/* Compute the PSK binder, a MAC over the client hello up to the binder
+   list using a key derived from the early secret for the PSK
+   (RFC 8446 section 4.2.11.2).  If there's been a HelloRetryRequest then
+   the transcript that precedes the client hello is included in the MAC'd
+   data */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 5 ) ) \
+static int computeBinder( const SSL_HANDSHAKE_INFO *handshakeInfo,
+						  const BOOLEAN includeTranscript,
+						  IN_BUFFER( helloLength ) const BYTE *hello,
+						  IN_LENGTH_SHORT const int helloLength,
+						  OUT_BUFFER_FIXED( TLS13_SECRET_SIZE ) BYTE *binder )
+	{
+	/* SHA-256 hash of the empty string */
+	static const BYTE emptyHash[ TLS13_SECRET_SIZE + 8 ] = {
+		0xE3, 0xB0, 0xC4, 0x42, 0x98, 0xFC, 0x1C, 0x14,
+		0x9A, 0xFB, 0xF4, 0xC8, 0x99, 0x6F, 0xB9, 0x24,
+		0x27, 0xAE, 0x41, 0xE4, 0x64, 0x9B, 0x93, 0x4C,
+		0xA4, 0x95, 0x99, 0x1B, 0x78, 0x52, 0xB8, 0x55
+		};
+	BYTE earlySecret[ TLS13_SECRET_SIZE + 8 ];
+	BYTE binderKey[ TLS13_SECRET_SIZE + 8 ];
+	BYTE transcriptHash[ TLS13_SECRET_SIZE + 8 ];
+	int status;
+
+	assert( isReadPtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isReadPtrDynamic( hello, helloLength ) );
+	assert( isWritePtr( binder, TLS13_SECRET_SIZE ) );
+
+	REQUIRES( includeTranscript == TRUE || includeTranscript == FALSE );
+	REQUIRES( helloLength > 0 && helloLength < MAX_INTLENGTH_SHORT );
+
+	/* Clear return value */
+	memset( binder, 0, TLS13_SECRET_SIZE );
+
+	/* Derive the binder key from the early secret for the PSK:
+
+		binder_key = Derive-Secret( early_secret, "res binder", "" ) */
+	status = advanceSecretTLS13( earlySecret, handshakeInfo->tls13Psk,
+								 TLS13_SECRET_SIZE, TRUE );
+	if( cryptStatusOK( status ) )
+		{
+		status = hkdfExpandLabelTLS13( binderKey, TLS13_SECRET_SIZE,
+									   earlySecret, "res binder", 10,
+									   emptyHash, TLS13_SECRET_SIZE );
+		}
+	zeroise( earlySecret, TLS13_SECRET_SIZE );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* MAC the (partial) transcript in the same way as for a Finished
+	   message */
+	status = getHashValue( includeTranscript ? \
+								handshakeInfo->sha2context : CRYPT_UNUSED,
+						   hello, helloLength, transcriptHash );
+	if( cryptStatusOK( status ) )
+		status = createFinishedTLS13( binder, binderKey, transcriptHash );
+	zeroise( binderKey, TLS13_SECRET_SIZE );
+
+	return( status );
+	}
+
+/****************************************************************************
+*																			*
+*						Certificate Management Functions					*
+*																			*
+****************************************************************************/
+
+/* Create the hash of the data that's signed in a certificate verify
+   message (RFC 8446 section 4.4.3):
+
+	byte[64]	0x20 padding
+	byte[]		"TLS 1.3, server CertificateVerify"
+	byte		0
+	byte[]		transcriptHash */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int createCertVerifyHash( IN_BUFFER_C( TLS13_SECRET_SIZE ) \
+									const BYTE *transcriptHash,
+								 OUT_HANDLE_OPT CRYPT_CONTEXT *iHashContext )
+	{
+	MESSAGE_CREATEOBJECT_INFO createInfo;
+	BYTE buffer[ 64 + 33 + 1 + TLS13_SECRET_SIZE + 8 ];
+	int status;
+
+	assert( isReadPtr( transcriptHash, TLS13_SECRET_SIZE ) );
+	assert( isWritePtr( iHashContext, sizeof( CRYPT_CONTEXT ) ) );
+
+	/* Clear return value */
+	*iHashContext = CRYPT_ERROR;
+
+	/* Assemble the data to be signed */
+	memset( buffer, 0x20, 64 );
+	memcpy( buffer + 64, "TLS 1.3, server CertificateVerify", 33 );
+	buffer[ 64 + 33 ] = 0;
+	memcpy( buffer + 64 + 33 + 1, transcriptHash, TLS13_SECRET_SIZE );
+
+	/* Hash it */
+	setMessageCreateObjectInfo( &createInfo, CRYPT_ALGO_SHA2 );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE,
+							  IMESSAGE_DEV_CREATEOBJECT, &createInfo,
+							  OBJECT_TYPE_CONTEXT );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = krnlSendMessage( createInfo.cryptHandle, IMESSAGE_CTX_HASH,
+							  buffer, 64 + 33 + 1 + TLS13_SECRET_SIZE );
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( createInfo.cryptHandle,
+								  IMESSAGE_CTX_HASH, buffer, 0 );
+		}
+	if( cryptStatusError( status ) )
+		{
+		krnlSendNotifier( createInfo.cryptHandle, IMESSAGE_DECREFCOUNT );
+		return( status );
+		}
+	*iHashContext = createInfo.cryptHandle;
+
+	return( CRYPT_OK );
+	}
+
+/* TLS 1.3 changes the certificate message to add a (for the server,
+   always empty) request context and per-certificate extensions:
+
+	TLS 1.2:						TLS 1.3:
+	byte		ID = 0x0B			byte		ID = 0x0B
+	uint24		len					uint24		len
+									byte		contextLen = 0
+	uint24		certListLen			uint24		certListLen
+		uint24	certLen					uint24	certLen
+		byte[]	cert					byte[]	cert
+										uint16	extLen
+										byte[]	ext
+
+   Rather than duplicating the certificate-chain handling, we convert the
+   TLS 1.3 form into the TLS 1.2 one on read and the TLS 1.2 form into the
+   TLS 1.3 one on write.  Since the TLS 1.2 form is always shorter than the
+   TLS 1.3 one, the conversion on read can be performed in place.  This 
+   also means that TLS 1.3 certificate chains go through the same 
+   certificate-chain cache lookup in readSSLCertChain() as TLS 1.2 ones */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int readCertChainTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							   INOUT SSL_HANDSHAKE_INFO *handshakeInfo )
+	{
+	STREAM *stream = &handshakeInfo->stream;
+	STREAM certStream;
+	BYTE *dataPtr;
+	const int startPos = stell( stream );
+	int length, listLength, readPos, writePos, status, LOOP_ITERATOR;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	/* Check the packet header and hash the message in its original TLS 1.3
+	   form */
+	status = checkHSPacketHeader( sessionInfoPtr, stream, &length,
+								  SSL_HAND_CERTIFICATE,
+								  1 + LENGTH_SIZE + MIN_CERTSIZE );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = sSkip( stream, length, MAX_INTLENGTH_SHORT );
+	if( cryptStatusOK( status ) )
+		status = hashStreamMessage( handshakeInfo, stream, startPos );
+	if( cryptStatusOK( status ) )
+		{
+		status = sMemGetDataBlockAbs( stream, startPos,
+									  ( void ** ) &dataPtr,
+									  1 + LENGTH_SIZE + length );
+		}
+	if( cryptStatusError( status ) )
+		return( status );
+	ANALYSER_HINT( dataPtr != NULL );
+
+	/* Check the request context and the certificate list length */
+	dataPtr += 1 + LENGTH_SIZE;
+	listLength = ( ( int ) dataPtr[ 1 ] << 16 ) | \
+				 ( ( int ) dataPtr[ 2 ] << 8 ) | dataPtr[ 3 ];
+	if( dataPtr[ 0 ] != 0 || listLength != length - ( 1 + LENGTH_SIZE ) )
+		{
+		retExt( CRYPT_ERROR_BADDATA,
+				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO,
+				  "Invalid TLS 1.3 certificate chain header" ) );
+		}
+
+	/* Convert each certificate entry to the TLS 1.2 form by removing the
+	   request context and the extensions, which we don't use */
+	readPos = 1 + LENGTH_SIZE;
+	writePos = LENGTH_SIZE;
+	LOOP_MED_CHECK( readPos < length )
+		{
+		int certLength, extLength;
+
+		if( length - readPos < LENGTH_SIZE + 1 + UINT16_SIZE )
+			{
+			retExt( CRYPT_ERROR_BADDATA,
+					( CRYPT_ERROR_BADDATA, SESSION_ERRINFO,
+					  "Invalid TLS 1.3 certificate chain entry" ) );
+			}
+		certLength = ( ( int ) dataPtr[ readPos ] << 16 ) | \
+					 ( ( int ) dataPtr[ readPos + 1 ] << 8 ) | \
+					 dataPtr[ readPos + 2 ];
+		if( certLength < 1 || \
+			certLength > length - ( readPos + LENGTH_SIZE + UINT16_SIZE ) )
+			{
+			retExt( CRYPT_ERROR_BADDATA,
+					( CRYPT_ERROR_BADDATA, SESSION_ERRINFO,
+					  "Invalid TLS 1.3 certificate length %d",
+					  certLength ) );
+			}
+		memmove( dataPtr + writePos, dataPtr + readPos,
+				 LENGTH_SIZE + certLength );
+		readPos += LENGTH_SIZE + certLength;
+		writePos += LENGTH_SIZE + certLength;
+		extLength = ( ( int ) dataPtr[ readPos ] << 8 ) | \
+					dataPtr[ readPos + 1 ];
+		if( extLength > length - ( readPos + UINT16_SIZE ) )
+			{
+			retExt( CRYPT_ERROR_BADDATA,
+					( CRYPT_ERROR_BADDATA, SESSION_ERRINFO,
+					  "Invalid TLS 1.3 certificate extension length %d",
+					  extLength ) );
+			}
+		readPos += UINT16_SIZE + extLength;
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	/* Rewrite the headers for the TLS 1.2 form of the message */
+	listLength = writePos - LENGTH_SIZE;
+	dataPtr[ 0 ] = intToByte( listLength >> 16 );
+	dataPtr[ 1 ] = intToByte( listLength >> 8 );
+	dataPtr[ 2 ] = intToByte( listLength );
+	dataPtr -= 1 + LENGTH_SIZE;
+	dataPtr[ 1 ] = intToByte( writePos >> 16 );
+	dataPtr[ 2 ] = intToByte( writePos >> 8 );
+	dataPtr[ 3 ] = intToByte( writePos );
+
+	/* Read the certificate chain in its TLS 1.2 form */
+	sMemConnect( &certStream, dataPtr, 1 + LENGTH_SIZE + writePos );
+	status = readSSLCertChain( sessionInfoPtr, handshakeInfo, &certStream,
+							   &sessionInfoPtr->iKeyexCryptContext, FALSE );
+	sMemDisconnect( &certStream );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Make sure that the certificate is usable with this session */
+	status = lockCertChainLeaf( sessionInfoPtr->iKeyexCryptContext );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = checkCertificateInfo( sessionInfoPtr );
+	unlockCertChain( sessionInfoPtr->iKeyexCryptContext );
+
+	return( status );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int writeCertChainTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+								INOUT STREAM *stream )
+	{
+	BYTE *dataPtr;
+	const int startPos = stell( stream );
+	int certStart[ TLS13_MAX_CHAINLENGTH + 8 ];
+	int certEnd[ TLS13_MAX_CHAINLENGTH + 8 ];
+	int length, listLength, position, noCerts = 0, extraLength, i;
+	int status, LOOP_ITERATOR;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+
+	/* Write the certificate chain in TLS 1.2 form and locate the
+	   certificates within it */
+	status = writeSSLCertChain( sessionInfoPtr, stream );
+	if( cryptStatusError( status ) )
+		return( status );
+	length = stell( stream ) - startPos;
+	status = sMemGetDataBlockAbs( stream, startPos, ( void ** ) &dataPtr,
+								  length );
+	if( cryptStatusError( status ) )
+		return( status );
+	ANALYSER_HINT( dataPtr != NULL );
+	listLength = ( ( int ) dataPtr[ 4 ] << 16 ) | \
+				 ( ( int ) dataPtr[ 5 ] << 8 ) | dataPtr[ 6 ];
+	ENSURES( listLength == length - ( 1 + LENGTH_SIZE + LENGTH_SIZE ) );
+	LOOP_MED( position = 1 + LENGTH_SIZE + LENGTH_SIZE, position < length,
+			  position = certEnd[ noCerts++ ] )
+		{
+		const int certLength = ( ( int ) dataPtr[ position ] << 16 ) | \
+							   ( ( int ) dataPtr[ position + 1 ] << 8 ) | \
+							   dataPtr[ position + 2 ];
+
+		ENSURES( certLength > 0 && \
+				 certLength <= length - ( position + LENGTH_SIZE ) );
+		if( noCerts >= TLS13_MAX_CHAINLENGTH )
+			{
+			retExt( CRYPT_ERROR_OVERFLOW,
+					( CRYPT_ERROR_OVERFLOW, SESSION_ERRINFO,
+					  "Certificate chain is too long to send via TLS 1.3, "
+					  "maximum length is %d certificates",
+					  TLS13_MAX_CHAINLENGTH ) );
+			}
+		certStart[ noCerts ] = position;
+		certEnd[ noCerts ] = position + LENGTH_SIZE + certLength;
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	/* Extend the message by the size of the request context and the
+	   per-certificate extensions */
+	extraLength = 1 + ( noCerts * UINT16_SIZE );
+	LOOP_LARGE( i = 0, i < extraLength, i++ )
+		{
+		status = sputc( stream, 0 );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+	ENSURES( LOOP_BOUND_OK );
+	status = sMemGetDataBlockAbs( stream, startPos, ( void ** ) &dataPtr,
+								  length + extraLength );
+	if( cryptStatusError( status ) )
+		return( status );
+	ANALYSER_HINT( dataPtr != NULL );
+
+	/* Move the certificates up to make room for the request context and
+	   the extensions, working backwards from the last certificate so that
+	   we don't overwrite certificates that haven't been moved yet */
+	LOOP_MED( i = noCerts - 1, i >= 0, i-- )
+		{
+		const int newStart = certStart[ i ] + 1 + ( i * UINT16_SIZE );
+		const int certLength = certEnd[ i ] - certStart[ i ];
+
+		memmove( dataPtr + newStart, dataPtr + certStart[ i ], certLength );
+		dataPtr[ newStart + certLength ] = 0;
+		dataPtr[ newStart + certLength + 1 ] = 0;
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	/* Rewrite the headers for the TLS 1.3 form of the message */
+	length += extraLength - ( 1 + LENGTH_SIZE );
+	listLength += noCerts * UINT16_SIZE;
+	dataPtr[ 1 ] = intToByte( length >> 16 );
+	dataPtr[ 2 ] = intToByte( length >> 8 );
+	dataPtr[ 3 ] = intToByte( length );
+	dataPtr[ 4 ] = 0;
+	dataPtr[ 5 ] = intToByte( listLength >> 16 );
+	dataPtr[ 6 ] = intToByte( listLength >> 8 );
+	dataPtr[ 7 ] = intToByte( listLength );
+
+	return( CRYPT_OK );
+	}
+
+/****************************************************************************
+*																			*
+*							PSK Binder Functions							*
+*																			*
+****************************************************************************/
+
+/* Fill in the PSK binder at the end of the client hello.  At this point
+   the binder list contains a single all-zero placeholder binder which is
+   replaced by the actual binder:
+
+	uint16		binderListLen = 1 + TLS13_SECRET_SIZE
+		byte	binderLen = TLS13_SECRET_SIZE
+		byte[]	binder */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int fillPSKBinderTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+						INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+						INOUT_BUFFER_FIXED( helloLength ) BYTE *hello,
+						IN_LENGTH_SHORT const int helloLength )
+	{
+	const int binderListStart = helloLength - \
+								( UINT16_SIZE + 1 + TLS13_SECRET_SIZE );
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isWritePtrDynamic( hello, helloLength ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( helloLength > UINT16_SIZE + 1 + TLS13_SECRET_SIZE && \
+			  helloLength < MAX_INTLENGTH_SHORT );
+	REQUIRES( handshakeInfo->tls13PskIdentityLength > 0 );
+	REQUIRES( hello[ binderListStart + UINT16_SIZE ] == TLS13_SECRET_SIZE );
+
+	/* The transcript-hash context contains either nothing or, if there's
+	   been a HelloRetryRequest, the messages that precede this client
+	   hello, so we can always continue it with the partial client hello */
+	return( computeBinder( handshakeInfo, TRUE, hello, binderListStart,
+						   hello + helloLength - TLS13_SECRET_SIZE ) );
+	}
+
+/* Check the PSK binder in the client hello.  The binder list position has
+   been recorded when the client hello was read */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+int checkPSKBinderTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+						 INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+						 IN_BUFFER( helloLength ) const BYTE *hello,
+						 IN_LENGTH_SHORT const int helloLength )
+	{
+	const int binderListStart = handshakeInfo->tls13BinderOffset;
+	BYTE binder[ TLS13_SECRET_SIZE + 8 ];
+	int status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isReadPtrDynamic( hello, helloLength ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( helloLength > 0 && helloLength < MAX_INTLENGTH_SHORT );
+	REQUIRES( binderListStart > 0 && \
+			  binderListStart <= helloLength - \
+								 ( UINT16_SIZE + 1 + TLS13_SECRET_SIZE ) );
+
+	/* Make sure that the first binder has the correct length */
+	if( hello[ binderListStart + UINT16_SIZE ] != TLS13_SECRET_SIZE )
+		{
+		retExt( CRYPT_ERROR_BADDATA,
+				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO,
+				  "Invalid TLS 1.3 PSK binder length %d, should be %d",
+				  hello[ binderListStart + UINT16_SIZE ],
+				  TLS13_SECRET_SIZE ) );
+		}
+
+	/* Compute the binder and compare it to the client's one.  The client
+	   hello hasn't been hashed into the transcript yet, so if there's been
+	   a HelloRetryRequest then we continue the transcript with it and if
+	   not we hash it on its own */
+	status = computeBinder( handshakeInfo, handshakeInfo->tls13Retry,
+							hello, binderListStart, binder );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( !compareDataConstTime( binder,
+							   hello + binderListStart + UINT16_SIZE + 1,
+							   TLS13_SECRET_SIZE ) )
+		{
+		zeroise( binder, TLS13_SECRET_SIZE );
+		retExt( CRYPT_ERROR_SIGNATURE,
+				( CRYPT_ERROR_SIGNATURE, SESSION_ERRINFO,
+				  "Client's TLS 1.3 PSK binder doesn't match our "
+				  "calculated value" ) );
+		}
+	zeroise( binder, TLS13_SECRET_SIZE );
+
+	return( CRYPT_OK );
+	}
+
+/****************************************************************************
+*																			*
+*						Client-side Handshake Functions						*
+*																			*
+****************************************************************************/
+
+/* Set up the TLS 1.3 information sent in the client hello, our key share
+   and, if we have a ticket from a previous session with this server, the
+   PSK identity for resumption */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int initClientHelloTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+						  INOUT SSL_HANDSHAKE_INFO *handshakeInfo )
+	{
+#ifdef USE_SSL_TICKETS
+	const ATTRIBUTE_LIST *attributeListPtr = \
+				findSessionInfo( sessionInfoPtr, CRYPT_SESSINFO_SERVER_NAME );
+#endif /* USE_SSL_TICKETS */
+	int status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( sessionInfoPtr->version >= SSL_MINOR_VERSION_TLS13 );
+
+	/* Create our key share */
+	status = createKeyShare( handshakeInfo );
+	if( cryptStatusError( status ) )
+		return( status );
+
+#ifdef USE_SSL_TICKETS
+	/* If we've got a ticket for this server, use it to try and resume the
+	   previous session.  Since all of the suites that we support use
+	   SHA-256 we don't have to check that the cipher suite from the
+	   previous session is compatible with the one that'll be selected for
+	   this one, which is the only requirement for using the PSK */
+	if( attributeListPtr != NULL )
+		{
+		int cipherSuite;
+
+		status = getClientTicket( attributeListPtr->value,
+								  attributeListPtr->valueLength,
+								  handshakeInfo->tls13PskIdentity, 512,
+								  &handshakeInfo->tls13PskIdentityLength,
+								  handshakeInfo->tls13Psk, &cipherSuite,
+								  &handshakeInfo->tls13PskObfuscatedAge );
+		if( cryptStatusError( status ) )
+			{
+			/* There's no (usable) ticket present, continue with a full
+			   handshake */
+			handshakeInfo->tls13PskIdentityLength = 0;
+			}
+		else
+			{
+			DEBUG_PRINT(( "Using TLS 1.3 ticket to resume session.\n" ));
+			}
+		}
+#endif /* USE_SSL_TICKETS */
+
+	return( CRYPT_OK );
+	}
+
+/* Continue the handshake once the server has selected TLS 1.3 in its
+   hello.  If the server hello was a HelloRetryRequest we have to send a
+   second client hello and process the server hello that follows it, then
+   we set up the handshake traffic keys */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int beginClientHandshakeTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							   INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+							   IN_LENGTH_SHORT const int clientHelloLength )
+	{
+	STREAM *stream = &handshakeInfo->stream;
+	int status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( clientHelloLength > 0 && \
+			  clientHelloLength < MAX_INTLENGTH_SHORT );
+	REQUIRES( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS13 );
+
+	/* If the server hello was a HelloRetryRequest, send a second client
+	   hello */
+	if( handshakeInfo->tls13Retry )
+		{
+		BYTE clientHelloHash[ TLS13_SECRET_SIZE + 8 ];
+		const int cipherSuite = handshakeInfo->cipherSuite;
+		int length;
+
+		DEBUG_PRINT(( "Server sent TLS 1.3 HelloRetryRequest.\n" ));
+
+		/* Replace the first client hello in the transcript with its hash
+		   and add the HelloRetryRequest */
+		status = getHashValue( CRYPT_UNUSED,
+							   sessionInfoPtr->sendBuffer + SSL_HEADER_SIZE,
+							   clientHelloLength, clientHelloHash );
+		if( cryptStatusOK( status ) )
+			{
+			status = restartTranscript( handshakeInfo, clientHelloHash );
+			}
+		if( cryptStatusOK( status ) )
+			{
+			status = hashTranscript( handshakeInfo,
+									 sessionInfoPtr->receiveBuffer,
+									 sessionInfoPtr->receiveBufEnd );
+			}
+		if( cryptStatusError( status ) )
+			return( status );
+
+		/* Send the second client hello, which contains the cookie from
+		   the HelloRetryRequest if there was one, and read the server's
+		   response */
+		handshakeInfo->tls13VersionSeen = FALSE;
+		handshakeInfo->tls13SuiteInfoPtr = NULL;
+		status = writeClientHello( sessionInfoPtr, handshakeInfo, &length );
+		if( cryptStatusOK( status ) )
+			{
+			status = readHSPacketSSL( sessionInfoPtr, handshakeInfo,
+									  &length, SSL_MSG_HANDSHAKE );
+			}
+		if( cryptStatusError( status ) )
+			return( status );
+		sMemConnect( stream, sessionInfoPtr->receiveBuffer, length );
+		status = processHelloSSL( sessionInfoPtr, handshakeInfo, stream,
+								  FALSE );
+		sMemDisconnect( stream );
+		if( cryptStatusError( status ) && status != OK_SPECIAL )
+			return( status );
+		if( handshakeInfo->tls13Retry || !handshakeInfo->tls13VersionSeen )
+			{
+			retExt( CRYPT_ERROR_BADDATA,
+					( CRYPT_ERROR_BADDATA, SESSION_ERRINFO,
+					  "Server sent %s in response to our second TLS 1.3 "
+					  "client hello", handshakeInfo->tls13Retry ? \
+						"a second HelloRetryRequest" : \
+						"a non-TLS 1.3 server hello" ) );
+			}
+		if( handshakeInfo->cipherSuite != cipherSuite )
+			{
+			retExt( CRYPT_ERROR_BADDATA,
+					( CRYPT_ERROR_BADDATA, SESSION_ERRINFO,
+					  "Server changed the cipher suite from %d to %d "
+					  "after sending a HelloRetryRequest", cipherSuite,
+					  handshakeInfo->cipherSuite ) );
+			}
+		}
+	if( handshakeInfo->tls13KeyShareLength != TLS13_KEYSHARE_SIZE )
+		{
+		retExt( CRYPT_ERROR_BADDATA,
+				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO,
+				  "Server didn't send a TLS 1.3 key share" ) );
+		}
+	if( handshakeInfo->tls13PskAccepted )
+		{
+		DEBUG_PRINT(( "Server accepted TLS 1.3 ticket, resuming "
+					  "session.\n" ));
+		}
+
+	/* Set up the handshake traffic keys.  From now on everything that the
+	   server sends us is encrypted */
+	status = advanceSecretTLS13( handshakeInfo->tls13Secret,
+								 handshakeInfo->tls13PskAccepted ? \
+									handshakeInfo->tls13Psk : NULL,
+								 handshakeInfo->tls13PskAccepted ? \
+									TLS13_SECRET_SIZE : 0, TRUE );
+	if( cryptStatusOK( status ) )
+		status = deriveHandshakeSecrets( handshakeInfo );
+	if( cryptStatusOK( status ) )
+		{
+		status = loadKeysTLS13( sessionInfoPtr,
+								handshakeInfo->tls13ServerHSSecret,
+								handshakeInfo->cryptKeysize, TRUE );
+		}
+	zeroise( handshakeInfo->tls13Psk, TLS13_SECRET_SIZE );
+	if( cryptStatusOK( status ) )
+		recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_KEYEXCHANGE );
+
+	return( status );
+	}
+
+/* Read the server's encrypted handshake messages:
+
+	byte		ID = SSL_HAND_ENCRYPTED_EXTENSIONS
+	uint24		len
+	uint16		extListLen
+		byte[]	extensions
+  [	byte		ID = SSL_HAND_CERTIFICATE
+	...										-- See writeCertChainTLS13()
+	byte		ID = SSL_HAND_CLIENT_CERTVERIFY
+	uint24		len
+	uint16		sigAlgo
+	uint16		sigLen
+		byte[]	signature ]
+	byte		ID = SSL_HAND_FINISHED
+	uint24		len
+	byte[]		verifyData */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int exchangeClientKeysTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							 INOUT SSL_HANDSHAKE_INFO *handshakeInfo )
+	{
+	STREAM *stream = &handshakeInfo->stream;
+	BYTE transcriptHash[ TLS13_SECRET_SIZE + 8 ];
+	BYTE finishedValue[ TLS13_SECRET_SIZE + 8 ];
+	void *dataPtr;
+	int startPos, length, extLength, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+
+	/* Read and process the encrypted extensions.  We don't send any
+	   extensions that require a response from the server so all that we
+	   need to do is check the format */
+	status = readHSPacketSSL( sessionInfoPtr, handshakeInfo, &length,
+							  SSL_MSG_FIRST_ENCRHANDSHAKE );
+	if( cryptStatusError( status ) )
+		return( status );
+	sMemConnect( stream, sessionInfoPtr->receiveBuffer, length );
+	startPos = stell( stream );
+	status = checkHSPacketHeader( sessionInfoPtr, stream, &length,
+								  SSL_HAND_ENCRYPTED_EXTENSIONS,
+								  UINT16_SIZE );
+	if( cryptStatusOK( status ) )
+		{
+		status = extLength = readUint16( stream );
+		if( !cryptStatusError( status ) && \
+			extLength != length - UINT16_SIZE )
+			status = CRYPT_ERROR_BADDATA;
+		}
+	if( cryptStatusOK( status ) && extLength > 0 )
+		status = sSkip( stream, extLength, MAX_INTLENGTH_SHORT );
+	if( cryptStatusOK( status ) )
+		status = hashStreamMessage( handshakeInfo, stream, startPos );
+	if( cryptStatusError( status ) )
+		{
+		sMemDisconnect( stream );
+		if( status == CRYPT_ERROR_BADDATA )
+			{
+			retExt( CRYPT_ERROR_BADDATA,
+					( CRYPT_ERROR_BADDATA, SESSION_ERRINFO,
+					  "Invalid TLS 1.3 encrypted extensions" ) );
+			}
+		return( status );
+		}
+
+	/* If we're not resuming a previous session, read the server's
+	   certificate chain and the signature over the transcript that proves
+	   possession of the private key for it */
+	if( !handshakeInfo->tls13PskAccepted )
+		{
+		CRYPT_CONTEXT iHashContext;
+
+		status = refreshHSStream( sessionInfoPtr, handshakeInfo );
+		if( cryptStatusError( status ) )
+			return( status );
+		if( sPeek( stream ) == SSL_HAND_SERVER_CERTREQUEST )
+			{
+			sMemDisconnect( stream );
+			retExt( CRYPT_ERROR_NOTAVAIL,
+					( CRYPT_ERROR_NOTAVAIL, SESSION_ERRINFO,
+					  "Server requested TLS 1.3 client certificate "
+					  "authentication, which isn't supported" ) );
+			}
+		status = readCertChainTLS13( sessionInfoPtr, handshakeInfo );
+		if( cryptStatusError( status ) )
+			{
+			sMemDisconnect( stream );
+			return( status );
+			}
+
+		/* Check the certificate verify signature */
+		status = refreshHSStream( sessionInfoPtr, handshakeInfo );
+		if( cryptStatusError( status ) )
+			return( status );
+		startPos = stell( stream );
+		status = getTranscriptHash( handshakeInfo, transcriptHash );
+		if( cryptStatusOK( status ) )
+			{
+			status = checkHSPacketHeader( sessionInfoPtr, stream, &length,
+										  SSL_HAND_CLIENT_CERTVERIFY,
+										  MIN_CRYPT_OBJECTSIZE );
+			}
+		if( cryptStatusOK( status ) )
+			status = sMemGetDataBlock( stream, &dataPtr, length );
+		if( cryptStatusError( status ) )
+			{
+			sMemDisconnect( stream );
+			return( status );
+			}
+		ANALYSER_HINT( dataPtr != NULL );
+		status = createCertVerifyHash( transcriptHash, &iHashContext );
+		if( cryptStatusOK( status ) )
+			{
+			status = iCryptCheckSignature( dataPtr, length,
+										   CRYPT_IFORMAT_TLS13,
+										   sessionInfoPtr->iKeyexCryptContext,
+										   iHashContext, CRYPT_UNUSED, NULL );
+			krnlSendNotifier( iHashContext, IMESSAGE_DECREFCOUNT );
+			}
+		if( cryptStatusError( status ) )
+			{
+			sMemDisconnect( stream );
+			retExt( status,
+					( status, SESSION_ERRINFO,
+					  "Verification of server's TLS 1.3 certificate verify "
+					  "signature failed" ) );
+			}
+		recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_CERTVERIFIED );
+		status = sSkip( stream, length, MAX_INTLENGTH_SHORT );
+		if( cryptStatusOK( status ) )
+			status = hashStreamMessage( handshakeInfo, stream, startPos );
+		if( cryptStatusError( status ) )
+			{
+			sMemDisconnect( stream );
+			return( status );
+			}
+		}
+
+	/* Check the server's Finished */
+	status = refreshHSStream( sessionInfoPtr, handshakeInfo );
+	if( cryptStatusError( status ) )
+		return( status );
+	startPos = stell( stream );
+	status = getTranscriptHash( handshakeInfo, transcriptHash );
+	if( cryptStatusOK( status ) )
+		{
+		status = createFinishedTLS13( finishedValue,
+									  handshakeInfo->tls13ServerHSSecret,
+									  transcriptHash );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = checkHSPacketHeader( sessionInfoPtr, stream, &length,
+									  SSL_HAND_FINISHED, TLS13_SECRET_SIZE );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		if( length != TLS13_SECRET_SIZE )
+			status = CRYPT_ERROR_BADDATA;
+		else
+			status = sMemGetDataBlock( stream, &dataPtr, length );
+		}
+	if( cryptStatusError( status ) )
+		{
+		sMemDisconnect( stream );
+		zeroise( finishedValue, TLS13_SECRET_SIZE );
+		return( status );
+		}
+	ANALYSER_HINT( dataPtr != NULL );
+	if( !compareDataConstTime( dataPtr, finishedValue, TLS13_SECRET_SIZE ) )
+		{
+		sMemDisconnect( stream );
+		zeroise( finishedValue, TLS13_SECRET_SIZE );
+		retExt( CRYPT_ERROR_SIGNATURE,
+				( CRYPT_ERROR_SIGNATURE, SESSION_ERRINFO,
+				  "Server's TLS 1.3 Finished doesn't match our calculated "
+				  "value" ) );
+		}
+	zeroise( finishedValue, TLS13_SECRET_SIZE );
+	status = sSkip( stream, length, MAX_INTLENGTH_SHORT );
+	if( cryptStatusOK( status ) )
+		status = hashStreamMessage( handshakeInfo, stream, startPos );
+	if( cryptStatusOK( status ) && sMemDataLeft( stream ) > 0 )
+		{
+		/* There can't be any further handshake messages from the server
+		   until we've sent our Finished */
+		status = CRYPT_ERROR_BADDATA;
+		}
+	sMemDisconnect( stream );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Switch the read side over to the application traffic keys */
+	return( deriveAppSecrets( sessionInfoPtr, handshakeInfo, TRUE ) );
+	}
+
+/****************************************************************************
+*																			*
+*						Server-side Handshake Functions						*
+*																			*
+****************************************************************************/
+
+/* Write a server hello or HelloRetryRequest:
+
+	byte		ID = SSL_HAND_SERVER_HELLO
+	uint24		len
+	byte[2]		version = { 0x03, 0x03 }
+	byte[32]	nonce						-- TLS13_HRR_NONCE for HRR
+	byte		sessIDlen
+		byte[]	sessID						-- Echoed from client
+	uint16		suite
+	byte		copr = 0
+	uint16		extListLen
+		uint16	extType = TLS_EXT_SUPPORTED_VERSIONS
+		uint16	extLen = 2
+		uint16	version = 0x0304
+		uint16	extType = TLS_EXT_KEY_SHARE
+		uint16	extLen
+		uint16	group = TLS_CURVE_X25519
+	  [	uint16	keyShareLen					-- Not for HRR
+		byte[]	keyShare ]
+	  [	uint16	extType = TLS_EXT_PRE_SHARED_KEY	-- If PSK accepted
+		uint16	extLen = 2
+		uint16	selectedIdentity = 0 ] */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2, 3 ) ) \
+static int writeServerHello( const SESSION_INFO *sessionInfoPtr,
+							 const SSL_HANDSHAKE_INFO *handshakeInfo,
+							 INOUT STREAM *stream,
+							 const BOOLEAN isHelloRetry )
+	{
+	const int keyShareExtLength = isHelloRetry ? UINT16_SIZE : \
+						UINT16_SIZE + UINT16_SIZE + TLS13_KEYSHARE_SIZE;
+	int extListLength, packetOffset, status;
+
+	assert( isReadPtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isReadPtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+
+	REQUIRES( isHelloRetry == TRUE || isHelloRetry == FALSE );
+
+	extListLength = ( UINT16_SIZE + UINT16_SIZE + UINT16_SIZE ) + \
+					( UINT16_SIZE + UINT16_SIZE + keyShareExtLength );
+	if( handshakeInfo->tls13PskAccepted )
+		extListLength += UINT16_SIZE + UINT16_SIZE + UINT16_SIZE;
+
+	status = continueHSPacketStream( stream, SSL_HAND_SERVER_HELLO,
+									 &packetOffset );
+	if( cryptStatusError( status ) )
+		return( status );
+	sputc( stream, SSL_MAJOR_VERSION );
+	sputc( stream, SSL_MINOR_VERSION_TLS12 );
+	if( isHelloRetry )
+		swrite( stream, TLS13_HRR_NONCE, SSL_NONCE_SIZE );
+	else
+		swrite( stream, handshakeInfo->serverNonce, SSL_NONCE_SIZE );
+	sputc( stream, handshakeInfo->sessionIDlength );
+	if( handshakeInfo->sessionIDlength > 0 )
+		{
+		swrite( stream, handshakeInfo->sessionID,
+				handshakeInfo->sessionIDlength );
+		}
+	writeUint16( stream, handshakeInfo->cipherSuite );
+	sputc( stream, 0 );	/* No compression */
+	writeUint16( stream, extListLength );
+	writeUint16( stream, TLS_EXT_SUPPORTED_VERSIONS );
+	writeUint16( stream, UINT16_SIZE );
+	writeUint16( stream, ( SSL_MAJOR_VERSION << 8 ) | \
+						 SSL_MINOR_VERSION_TLS13 );
+	writeUint16( stream, TLS_EXT_KEY_SHARE );
+	writeUint16( stream, keyShareExtLength );
+	status = writeUint16( stream, TLS_CURVE_X25519 );
+	if( !isHelloRetry )
+		{
+		writeUint16( stream, TLS13_KEYSHARE_SIZE );
+		status = swrite( stream, handshakeInfo->tls13LocalKeyShare,
+						 TLS13_KEYSHARE_SIZE );
+		}
+	if( handshakeInfo->tls13PskAccepted )
+		{
+		writeUint16( stream, TLS_EXT_PRE_SHARED_KEY );
+		writeUint16( stream, UINT16_SIZE );
+		status = writeUint16( stream, 0 );
+		}
+	if( cryptStatusError( status ) )
+		return( status );
+	status = completeHSPacketStream( stream, packetOffset );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	return( hashStreamMessage( handshakeInfo, stream, packetOffset ) );
+	}
+
+/* Write the dummy change cipherspec that makes the exchange look like a
+   TLS 1.2 session resumption to middleboxes */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int writeDummyCCS( const SESSION_INFO *sessionInfoPtr,
+						  INOUT STREAM *stream )
+	{
+	int packetOffset, status;
+
+	assert( isReadPtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+
+	status = continuePacketStreamSSL( stream, sessionInfoPtr,
+									  SSL_MSG_CHANGE_CIPHER_SPEC,
+									  &packetOffset );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = sputc( stream, 1 );
+	if( cryptStatusError( status ) )
+		return( status );
+	return( completePacketStreamSSL( stream, packetOffset ) );
+	}
+
+/* Send a HelloRetryRequest asking the client for an X25519 key share and
+   process the second client hello that it sends in response */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int processHelloRetry( INOUT SESSION_INFO *sessionInfoPtr,
+							  INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+							  OUT_LENGTH_SHORT_Z int *clientHelloLength )
+	{
+	STREAM *stream = &handshakeInfo->stream;
+	BYTE clientHelloHash[ TLS13_SECRET_SIZE + 8 ];
+	const int cipherSuite = handshakeInfo->cipherSuite;
+	int length, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+	assert( isWritePtr( clientHelloLength, sizeof( int ) ) );
+
+	/* Clear return value */
+	*clientHelloLength = 0;
+
+	DEBUG_PRINT(( "Client didn't send X25519 key share, sending TLS 1.3 "
+				  "HelloRetryRequest.\n" ));
+
+	/* The transcript-hash context currently contains only the first client
+	   hello, which is replaced by its hash followed by the
+	   HelloRetryRequest */
+	status = getTranscriptHash( handshakeInfo, clientHelloHash );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = restartTranscript( handshakeInfo, clientHelloHash );
+	if( cryptStatusError( status ) )
+		return( status );
+	handshakeInfo->tls13Retry = TRUE;
+
+	/* Send the HelloRetryRequest followed by the dummy change cipherspec */
+	status = openPacketStreamSSL( stream, sessionInfoPtr, CRYPT_USE_DEFAULT,
+								  SSL_MSG_HANDSHAKE );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = writeServerHello( sessionInfoPtr, handshakeInfo, stream, TRUE );
+	if( cryptStatusOK( status ) )
+		status = completePacketStreamSSL( stream, 0 );
+	if( cryptStatusOK( status ) )
+		status = writeDummyCCS( sessionInfoPtr, stream );
+	if( cryptStatusOK( status ) )
+		status = sendPacketSSL( sessionInfoPtr, stream, TRUE );
+	sMemDisconnect( stream );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Read and process the second client hello */
+	status = readHSPacketSSL( sessionInfoPtr, NULL, &length,
+							  SSL_MSG_HANDSHAKE );
+	if( cryptStatusError( status ) )
+		return( status );
+	handshakeInfo->tls13VersionSeen = FALSE;
+	handshakeInfo->tls13SuiteInfoPtr = NULL;
+	handshakeInfo->tls13KeyShareLength = 0;
+	handshakeInfo->tls13PskModeOK = FALSE;
+	handshakeInfo->tls13PskIdentityLength = 0;
+	handshakeInfo->tls13BinderOffset = 0;
+	sMemConnect( stream, sessionInfoPtr->receiveBuffer, length );
+	status = processHelloSSL( sessionInfoPtr, handshakeInfo, stream, TRUE );
+	sMemDisconnect( stream );
+	if( cryptStatusError( status ) && status != OK_SPECIAL )
+		return( status );
+	if( sessionInfoPtr->version < SSL_MINOR_VERSION_TLS13 || \
+		!handshakeInfo->tls13VersionSeen || \
+		handshakeInfo->tls13KeyShareLength != TLS13_KEYSHARE_SIZE || \
+		handshakeInfo->cipherSuite != cipherSuite )
+		{
+		retExt( CRYPT_ERROR_BADDATA,
+				( CRYPT_ERROR_BADDATA, SESSION_ERRINFO,
+				  "Client's second TLS 1.3 client hello doesn't contain "
+				  "the requested information" ) );
+		}
+	*clientHelloLength = length;
+
+	return( CRYPT_OK );
+	}
+
+/* Process the client hello once we've decided to use TLS 1.3 and send our
+   side of the handshake, which for TLS 1.3 is everything up to and
+   including our Finished */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int beginServerHandshakeTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							   INOUT SSL_HANDSHAKE_INFO *handshakeInfo )
+	{
+	STREAM *stream = &handshakeInfo->stream;
+	MESSAGE_DATA msgData;
+	BYTE transcriptHash[ TLS13_SECRET_SIZE + 8 ];
+	BYTE finishedValue[ TLS13_SECRET_SIZE + 8 ];
+	int clientHelloLength = sessionInfoPtr->receiveBufEnd;
+	int packetOffset, hsPacketOffset, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS13 );
+
+	/* We don't support TLS 1.3 client certificate authentication, which
+	   is performed in a completely different manner to TLS 1.2 */
+	if( sessionInfoPtr->cryptKeyset != CRYPT_ERROR || \
+		( sessionInfoPtr->protocolFlags & SSL_PFLAG_MANUAL_CERTCHECK ) )
+		{
+		retExt( CRYPT_ERROR_NOTAVAIL,
+				( CRYPT_ERROR_NOTAVAIL, SESSION_ERRINFO,
+				  "TLS 1.3 client certificate authentication isn't "
+				  "supported" ) );
+		}
+	if( sessionInfoPtr->privateKey == CRYPT_ERROR )
+		{
+		retExt( CRYPT_ERROR_NOTINITED,
+				( CRYPT_ERROR_NOTINITED, SESSION_ERRINFO,
+				  "TLS 1.3 requires a server private key" ) );
+		}
+
+	/* If the client didn't send an X25519 key share, ask it for one */
+	if( handshakeInfo->tls13KeyShareLength != TLS13_KEYSHARE_SIZE )
+		{
+		status = processHelloRetry( sessionInfoPtr, handshakeInfo,
+									&clientHelloLength );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+
+#ifdef USE_SSL_TICKETS
+	/* If the client has sent a ticket that we issued and allows it to be
+	   used with an (EC)DHE key exchange, try and resume the session */
+	if( handshakeInfo->tls13PskIdentityLength == SSL_TICKET_SIZE && \
+		handshakeInfo->tls13PskModeOK )
+		{
+		BYTE ticketSecret[ SSL_SECRET_SIZE + 8 ];
+		int ticketSecretLength, metaData;
+
+		memcpy( handshakeInfo->sessionTicket,
+				handshakeInfo->tls13PskIdentity, SSL_TICKET_SIZE );
+		handshakeInfo->sessionTicketLength = SSL_TICKET_SIZE;
+		status = checkSessionTicket( sessionInfoPtr, handshakeInfo,
+									 ticketSecret, SSL_SECRET_SIZE,
+									 &ticketSecretLength, &metaData );
+		if( cryptStatusOK( status ) )
+			{
+			memcpy( handshakeInfo->tls13Psk, ticketSecret,
+					TLS13_SECRET_SIZE );
+			zeroise( ticketSecret, SSL_SECRET_SIZE );
+			status = checkPSKBinderTLS13( sessionInfoPtr, handshakeInfo,
+										  sessionInfoPtr->receiveBuffer,
+										  clientHelloLength );
+			if( cryptStatusError( status ) )
+				return( status );
+			handshakeInfo->tls13PskAccepted = TRUE;
+			DEBUG_PRINT(( "Accepted TLS 1.3 ticket, resuming session.\n" ));
+			}
+		zeroise( ticketSecret, SSL_SECRET_SIZE );
+		}
+#endif /* USE_SSL_TICKETS */
+
+	/* If there's been a HelloRetryRequest then the second client hello
+	   hasn't been hashed yet since the PSK binder check requires the
+	   transcript without it */
+	if( handshakeInfo->tls13Retry )
+		{
+		status = hashTranscript( handshakeInfo,
+								 sessionInfoPtr->receiveBuffer,
+								 clientHelloLength );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+
+	/* Get our nonce and key share */
+	setMessageData( &msgData, handshakeInfo->serverNonce, SSL_NONCE_SIZE );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_GETATTRIBUTE_S,
+							  &msgData, CRYPT_IATTRIBUTE_RANDOM_NONCE );
+	if( cryptStatusOK( status ) )
+		status = createKeyShare( handshakeInfo );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Send the server hello, followed by the dummy change cipherspec if we
+	   haven't already sent one with a HelloRetryRequest */
+	status = openPacketStreamSSL( stream, sessionInfoPtr, CRYPT_USE_DEFAULT,
+								  SSL_MSG_HANDSHAKE );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = writeServerHello( sessionInfoPtr, handshakeInfo, stream, FALSE );
+	if( cryptStatusOK( status ) )
+		status = completePacketStreamSSL( stream, 0 );
+	if( cryptStatusOK( status ) && !handshakeInfo->tls13Retry )
+		status = writeDummyCCS( sessionInfoPtr, stream );
+	if( cryptStatusError( status ) )
+		{
+		sMemDisconnect( stream );
+		return( status );
+		}
+
+	/* Set up the handshake traffic keys.  From now on everything that we
+	   send is encrypted */
+	status = advanceSecretTLS13( handshakeInfo->tls13Secret,
+								 handshakeInfo->tls13PskAccepted ? \
+									handshakeInfo->tls13Psk : NULL,
+								 handshakeInfo->tls13PskAccepted ? \
+									TLS13_SECRET_SIZE : 0, TRUE );
+	zeroise( handshakeInfo->tls13Psk, TLS13_SECRET_SIZE );
+	if( cryptStatusOK( status ) )
+		status = deriveHandshakeSecrets( handshakeInfo );
+	if( cryptStatusOK( status ) )
+		{
+		status = loadKeysTLS13( sessionInfoPtr,
+								handshakeInfo->tls13ServerHSSecret,
+								handshakeInfo->cryptKeysize, FALSE );
+		}
+	if( cryptStatusError( status ) )
+		{
+		sMemDisconnect( stream );
+		return( status );
+		}
+	recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_KEYEXCHANGE );
+
+	/* Write the encrypted extensions, which are empty since we don't
+	   support any extensions that require a response */
+	status = continuePacketStreamSSL( stream, sessionInfoPtr,
+									  SSL_MSG_HANDSHAKE, &packetOffset );
+	if( cryptStatusOK( status ) )
+		{
+		status = continueHSPacketStream( stream,
+										 SSL_HAND_ENCRYPTED_EXTENSIONS,
+										 &hsPacketOffset );
+		}
+	if( cryptStatusOK( status ) )
+		status = writeUint16( stream, 0 );
+	if( cryptStatusOK( status ) )
+		status = completeHSPacketStream( stream, hsPacketOffset );
+	if( cryptStatusOK( status ) )
+		status = hashStreamMessage( handshakeInfo, stream, hsPacketOffset );
+	if( cryptStatusError( status ) )
+		{
+		sMemDisconnect( stream );
+		return( status );
+		}
+
+	/* If we're not resuming a previous session, write our certificate
+	   chain and a signature over the transcript that proves possession of
+	   the private key for it */
+	if( !handshakeInfo->tls13PskAccepted )
+		{
+		CRYPT_CONTEXT iHashContext;
+		void *dataPtr;
+		int dataLength, sigLength DUMMY_INIT;
+
+		hsPacketOffset = stell( stream );
+		status = writeCertChainTLS13( sessionInfoPtr, stream );
+		if( cryptStatusOK( status ) )
+			{
+			status = hashStreamMessage( handshakeInfo, stream,
+										hsPacketOffset );
+			}
+		if( cryptStatusOK( status ) )
+			status = getTranscriptHash( handshakeInfo, transcriptHash );
+		if( cryptStatusOK( status ) )
+			{
+			status = continueHSPacketStream( stream,
+											 SSL_HAND_CLIENT_CERTVERIFY,
+											 &hsPacketOffset );
+			}
+		if( cryptStatusOK( status ) )
+			status = sMemGetDataBlockRemaining( stream, &dataPtr,
+												&dataLength );
+		if( cryptStatusOK( status ) )
+			status = createCertVerifyHash( transcriptHash, &iHashContext );
+		if( cryptStatusOK( status ) )
+			{
+			/* See the comment in createCertVerify() for the reason for
+			   the min() */
+			status = iCryptCreateSignature( dataPtr,
+							min( dataLength, MAX_INTLENGTH_SHORT - 1 ),
+							&sigLength, CRYPT_IFORMAT_TLS13,
+							sessionInfoPtr->privateKey, iHashContext, NULL );
+			krnlSendNotifier( iHashContext, IMESSAGE_DECREFCOUNT );
+			}
+		if( cryptStatusOK( status ) )
+			status = sSkip( stream, sigLength, MAX_INTLENGTH_SHORT );
+		if( cryptStatusOK( status ) )
+			status = completeHSPacketStream( stream, hsPacketOffset );
+		if( cryptStatusOK( status ) )
+			{
+			status = hashStreamMessage( handshakeInfo, stream,
+										hsPacketOffset );
+			}
+		if( cryptStatusError( status ) )
+			{
+			sMemDisconnect( stream );
+			return( status );
+			}
+		}
+
+	/* Write our Finished and send the whole flight to the client */
+	status = getTranscriptHash( handshakeInfo, transcriptHash );
+	if( cryptStatusOK( status ) )
+		{
+		status = createFinishedTLS13( finishedValue,
+									  handshakeInfo->tls13ServerHSSecret,
+									  transcriptHash );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = continueHSPacketStream( stream, SSL_HAND_FINISHED,
+										 &hsPacketOffset );
+		}
+	if( cryptStatusOK( status ) )
+		status = swrite( stream, finishedValue, TLS13_SECRET_SIZE );
+	zeroise( finishedValue, TLS13_SECRET_SIZE );
+	if( cryptStatusOK( status ) )
+		status = completeHSPacketStream( stream, hsPacketOffset );
+	if( cryptStatusOK( status ) )
+		status = hashStreamMessage( handshakeInfo, stream, hsPacketOffset );
+	if( cryptStatusOK( status ) )
+		status = wrapPacketSSL( sessionInfoPtr, stream, packetOffset );
+	if( cryptStatusOK( status ) )
+		status = sendPacketSSL( sessionInfoPtr, stream, TRUE );
+	sMemDisconnect( stream );
+	if( cryptStatusError( status ) )
+		return( status );
+	recordHandshakeTime( sessionInfoPtr, SESSION_TIMING_HELLOSENT );
+
+	/* Switch the write side over to the application traffic keys and the
+	   read side to the client's handshake traffic keys */
+	status = deriveAppSecrets( sessionInfoPtr, handshakeInfo, FALSE );
+	if( cryptStatusError( status ) )
+		return( status );
+	return( loadKeysTLS13( sessionInfoPtr,
+						   handshakeInfo->tls13ClientHSSecret,
+						   handshakeInfo->cryptKeysize, TRUE ) );
+	}
+
+/* In TLS 1.3 the server has already sent all of its keying information
+   along with the server hello, so there's nothing further to do until the
+   client's Finished arrives */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int exchangeServerKeysTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							 INOUT SSL_HANDSHAKE_INFO *handshakeInfo )
+	{
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+
+	return( CRYPT_OK );
+	}
+
+#ifdef USE_SSL_TICKETS
+
+/* Send a session ticket to the client that it can use to resume the
+   session.  The PSK for resumption is derived from the resumption master
+   secret and a per-ticket nonce, since we only ever send a single ticket
+   we use a fixed nonce:
+
+	byte		ID = SSL_HAND_NEWSESSIONTICKET
+	uint24		len
+	uint32		lifetime
+	uint32		ageAdd
+	byte		nonceLen = 1
+		byte	nonce = 0
+	uint16		ticketLen
+		byte[]	ticket
+	uint16		extListLen = 0 */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int sendSessionTicket( INOUT SESSION_INFO *sessionInfoPtr,
+							  INOUT SSL_HANDSHAKE_INFO *handshakeInfo )
+	{
+	SSL_INFO *sslInfo = sessionInfoPtr->sessionSSL;
+	STREAM *stream = &handshakeInfo->stream;
+	STREAM ticketStream;
+	MESSAGE_DATA msgData;
+	BYTE ticketSecret[ SSL_SECRET_SIZE + 8 ];
+	BYTE ticketBuffer[ UINT32_SIZE + UINT16_SIZE + SSL_TICKET_SIZE + 8 ];
+	BYTE ageAdd[ UINT32_SIZE + 8 ];
+	static const BYTE ticketNonce[] = { 0x00, 0x00 };
+	int ticketLength, packetOffset, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	/* Derive the PSK and seal it in a ticket, padding it out to the size
+	   of the TLS 1.2 master secret that tickets normally contain */
+	memset( ticketSecret, 0, SSL_SECRET_SIZE );
+	status = hkdfExpandLabelTLS13( ticketSecret, TLS13_SECRET_SIZE,
+								   sslInfo->tls13ResumptionSecret,
+								   "resumption", 10, ticketNonce, 1 );
+	if( cryptStatusError( status ) )
+		return( status );
+	sMemOpen( &ticketStream, ticketBuffer,
+			  UINT32_SIZE + UINT16_SIZE + SSL_TICKET_SIZE );
+	status = writeSessionTicket( sessionInfoPtr, handshakeInfo,
+								 &ticketStream, ticketSecret,
+								 SSL_SECRET_SIZE );
+	ticketLength = stell( &ticketStream ) - ( UINT32_SIZE + UINT16_SIZE );
+	sMemDisconnect( &ticketStream );
+	zeroise( ticketSecret, SSL_SECRET_SIZE );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( ticketLength <= 0 )
+		{
+		/* There's no ticket key available, we can't issue a ticket */
+		return( CRYPT_OK );
+		}
+	setMessageData( &msgData, ageAdd, UINT32_SIZE );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE, IMESSAGE_GETATTRIBUTE_S,
+							  &msgData, CRYPT_IATTRIBUTE_RANDOM_NONCE );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Send the ticket to the client */
+	status = openPacketStreamSSL( stream, sessionInfoPtr, CRYPT_USE_DEFAULT,
+								  SSL_MSG_HANDSHAKE );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = continueHSPacketStream( stream, SSL_HAND_NEWSESSIONTICKET,
+									 &packetOffset );
+	if( cryptStatusOK( status ) )
+		{
+		swrite( stream, ticketBuffer, UINT32_SIZE );	/* Lifetime */
+		swrite( stream, ageAdd, UINT32_SIZE );
+		sputc( stream, 1 );
+		swrite( stream, ticketNonce, 1 );
+		writeUint16( stream, ticketLength );
+		swrite( stream, ticketBuffer + UINT32_SIZE + UINT16_SIZE,
+				ticketLength );
+		status = writeUint16( stream, 0 );
+		}
+	if( cryptStatusOK( status ) )
+		status = completeHSPacketStream( stream, packetOffset );
+	if( cryptStatusOK( status ) )
+		status = wrapPacketSSL( sessionInfoPtr, stream, 0 );
+	if( cryptStatusOK( status ) )
+		status = sendPacketSSL( sessionInfoPtr, stream, TRUE );
+	sMemDisconnect( stream );
+
+	return( status );
+	}
+#endif /* USE_SSL_TICKETS */
+
+/****************************************************************************
+*																			*
+*						Shared Handshake Functions							*
+*																			*
+****************************************************************************/
+
+/* Complete the handshake.  The client sends its Finished, the server
+   checks it and optionally sends a session ticket */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int completeClientHandshake( INOUT SESSION_INFO *sessionInfoPtr,
+									INOUT SSL_HANDSHAKE_INFO *handshakeInfo )
+	{
+	STREAM *stream = &handshakeInfo->stream;
+	BYTE transcriptHash[ TLS13_SECRET_SIZE + 8 ];
+	BYTE finishedValue[ TLS13_SECRET_SIZE + 8 ];
+	int packetOffset, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	/* Send our Finished, encrypted with the client handshake traffic key */
+	status = loadKeysTLS13( sessionInfoPtr,
+							handshakeInfo->tls13ClientHSSecret,
+							handshakeInfo->cryptKeysize, FALSE );
+	if( cryptStatusOK( status ) )
+		status = getTranscriptHash( handshakeInfo, transcriptHash );
+	if( cryptStatusOK( status ) )
+		{
+		status = createFinishedTLS13( finishedValue,
+									  handshakeInfo->tls13ClientHSSecret,
+									  transcriptHash );
+		}
+	if( cryptStatusError( status ) )
+		return( status );
+	status = openPacketStreamSSL( stream, sessionInfoPtr, CRYPT_USE_DEFAULT,
+								  SSL_MSG_HANDSHAKE );
+	if( cryptStatusError( status ) )
+		{
+		zeroise( finishedValue, TLS13_SECRET_SIZE );
+		return( status );
+		}
+	status = continueHSPacketStream( stream, SSL_HAND_FINISHED,
+									 &packetOffset );
+	if( cryptStatusOK( status ) )
+		status = swrite( stream, finishedValue, TLS13_SECRET_SIZE );
+	zeroise( finishedValue, TLS13_SECRET_SIZE );
+	if( cryptStatusOK( status ) )
+		status = completeHSPacketStream( stream, packetOffset );
+	if( cryptStatusOK( status ) )
+		status = hashStreamMessage( handshakeInfo, stream, packetOffset );
+	if( cryptStatusOK( status ) )
+		status = wrapPacketSSL( sessionInfoPtr, stream, 0 );
+	if( cryptStatusOK( status ) )
+		status = sendPacketSSL( sessionInfoPtr, stream, TRUE );
+	sMemDisconnect( stream );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Switch the write side over to the application traffic keys and
+	   remember the resumption secret in case the server sends us a
+	   ticket */
+	status = loadKeysTLS13( sessionInfoPtr,
+							handshakeInfo->tls13ClientAppSecret,
+							handshakeInfo->cryptKeysize, FALSE );
+	if( cryptStatusOK( status ) )
+		status = deriveResumptionSecret( sessionInfoPtr, handshakeInfo );
+	return( status );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+static int completeServerHandshake( INOUT SESSION_INFO *sessionInfoPtr,
+									INOUT SSL_HANDSHAKE_INFO *handshakeInfo )
+	{
+	STREAM *stream = &handshakeInfo->stream;
+	BYTE transcriptHash[ TLS13_SECRET_SIZE + 8 ];
+	BYTE finishedValue[ TLS13_SECRET_SIZE + 8 ];
+	void *dataPtr;
+	int length, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	/* Read the client's Finished and check it */
+	status = getTranscriptHash( handshakeInfo, transcriptHash );
+	if( cryptStatusOK( status ) )
+		{
+		status = createFinishedTLS13( finishedValue,
+									  handshakeInfo->tls13ClientHSSecret,
+									  transcriptHash );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = readHSPacketSSL( sessionInfoPtr, NULL, &length,
+								  SSL_MSG_FIRST_ENCRHANDSHAKE );
+		}
+	if( cryptStatusError( status ) )
+		{
+		zeroise( finishedValue, TLS13_SECRET_SIZE );
+		return( status );
+		}
+	sMemConnect( stream, sessionInfoPtr->receiveBuffer, length );
+	status = checkHSPacketHeader( sessionInfoPtr, stream, &length,
+								  SSL_HAND_FINISHED, TLS13_SECRET_SIZE );
+	if( cryptStatusOK( status ) )
+		{
+		if( length != TLS13_SECRET_SIZE || \
+			sMemDataLeft( stream ) != TLS13_SECRET_SIZE )
+			status = CRYPT_ERROR_BADDATA;
+		else
+			status = sMemGetDataBlock( stream, &dataPtr, length );
+		}
+	if( cryptStatusError( status ) )
+		{
+		sMemDisconnect( stream );
+		zeroise( finishedValue, TLS13_SECRET_SIZE );
+		return( status );
+		}
+	ANALYSER_HINT( dataPtr != NULL );
+	if( !compareDataConstTime( dataPtr, finishedValue, TLS13_SECRET_SIZE ) )
+		{
+		sMemDisconnect( stream );
+		zeroise( finishedValue, TLS13_SECRET_SIZE );
+		retExt( CRYPT_ERROR_SIGNATURE,
+				( CRYPT_ERROR_SIGNATURE, SESSION_ERRINFO,
+				  "Client's TLS 1.3 Finished doesn't match our calculated "
+				  "value" ) );
+		}
+	zeroise( finishedValue, TLS13_SECRET_SIZE );
+	status = sSkip( stream, length, MAX_INTLENGTH_SHORT );
+	if( cryptStatusOK( status ) )
+		status = hashStreamMessage( handshakeInfo, stream, 0 );
+	sMemDisconnect( stream );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Switch the read side over to the application traffic keys */
+	status = loadKeysTLS13( sessionInfoPtr,
+							handshakeInfo->tls13ClientAppSecret,
+							handshakeInfo->cryptKeysize, TRUE );
+	if( cryptStatusOK( status ) )
+		status = deriveResumptionSecret( sessionInfoPtr, handshakeInfo );
+	if( cryptStatusError( status ) )
+		return( status );
+
+#ifdef USE_SSL_TICKETS
+	/* If the client can use a ticket, send it one */
+	if( handshakeInfo->tls13PskModeOK )
+		{
+		status = sendSessionTicket( sessionInfoPtr, handshakeInfo );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+#endif /* USE_SSL_TICKETS */
+
+	return( CRYPT_OK );
+	}
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int completeHandshakeTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							INOUT SSL_HANDSHAKE_INFO *handshakeInfo,
+							const BOOLEAN isClient )
+	{
+	int status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isWritePtr( handshakeInfo, sizeof( SSL_HANDSHAKE_INFO ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( isClient == TRUE || isClient == FALSE );
+
+	if( isClient )
+		status = completeClientHandshake( sessionInfoPtr, handshakeInfo );
+	else
+		status = completeServerHandshake( sessionInfoPtr, handshakeInfo );
+
+	/* We don't need the handshake secrets any more, get rid of them */
+	zeroise( handshakeInfo->tls13Secret, TLS13_SECRET_SIZE );
+	zeroise( handshakeInfo->tls13ClientHSSecret, TLS13_SECRET_SIZE );
+	zeroise( handshakeInfo->tls13ServerHSSecret, TLS13_SECRET_SIZE );
+	zeroise( handshakeInfo->tls13ClientAppSecret, TLS13_SECRET_SIZE );
+	if( cryptStatusError( status ) )
+		return( status );
+	DEBUG_PRINT(( "TLS 1.3 handshake completed.\n" ));
+
+	return( CRYPT_OK );
+	}
+
+/****************************************************************************
+*																			*
+*						Post-handshake Message Processing					*
+*																			*
+****************************************************************************/
+
+/* Process handshake messages sent after the handshake has completed.
+   These are session tickets from the server, which we remember for later
+   resumption, and key updates, for which we switch the read side to the
+   next-generation traffic key.  We don't respond to update requests for
+   our own traffic key since this would require sending a packet from
+   within the read code, but the peer continues to use its own updated
+   key which is all that's required for the traffic that it sends */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
+int processPostHandshakeTLS13( INOUT SESSION_INFO *sessionInfoPtr,
+							   IN_BUFFER( dataLength ) const BYTE *data,
+							   IN_DATALENGTH const int dataLength )
+	{
+	SSL_INFO *sslInfo = sessionInfoPtr->sessionSSL;
+	STREAM stream;
+	int status = CRYPT_OK, LOOP_ITERATOR;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isReadPtrDynamic( data, dataLength ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( dataLength > 0 && dataLength < MAX_BUFFER_SIZE );
+
+	sMemConnect( &stream, data, dataLength );
+	LOOP_MED_CHECK( cryptStatusOK( status ) && sMemDataLeft( &stream ) > 0 )
+		{
+		BYTE newSecret[ TLS13_SECRET_SIZE + 8 ];
+		int type, length;
+
+		/* Get the message header */
+		status = type = sgetc( &stream );
+		if( !cryptStatusError( status ) )
+			status = length = readUint24( &stream );
+		if( !cryptStatusError( status ) && \
+			( length < 1 || length > sMemDataLeft( &stream ) ) )
+			status = CRYPT_ERROR_BADDATA;
+		if( cryptStatusError( status ) )
+			break;
+		status = CRYPT_OK;
+
+		switch( type )
+			{
+			case SSL_HAND_NEWSESSIONTICKET:
+				{
+#ifdef USE_SSL_TICKETS
+				const ATTRIBUTE_LIST *attributeListPtr = \
+							findSessionInfo( sessionInfoPtr,
+											 CRYPT_SESSINFO_SERVER_NAME );
+				BYTE nonce[ 255 + 8 ], ageAddBuffer[ UINT32_SIZE + 8 ];
+				void *ticketPtr;
+				long ageAdd;
+				int lifetime, nonceLength, ticketLength, extLength;
+
+				if( isServer( sessionInfoPtr ) )
+					{
+					status = CRYPT_ERROR_BADDATA;
+					break;
+					}
+
+				/* Read the ticket information.  The age-add value is a 
+				   full 32-bit random value so we can't use readUint32(), 
+				   which rejects values with the high bit set */
+				lifetime = ( int ) readUint32( &stream );
+				sread( &stream, ageAddBuffer, UINT32_SIZE );
+				ageAdd = ( long ) ( ( ( unsigned long ) ageAddBuffer[ 0 ] << 24 ) | \
+									( ( unsigned long ) ageAddBuffer[ 1 ] << 16 ) | \
+									( ( unsigned long ) ageAddBuffer[ 2 ] << 8 ) | \
+														ageAddBuffer[ 3 ] );
+				status = nonceLength = sgetc( &stream );
+				if( !cryptStatusError( status ) && nonceLength > 0 )
+					status = sread( &stream, nonce, nonceLength );
+				if( !cryptStatusError( status ) )
+					status = ticketLength = readUint16( &stream );
+				if( !cryptStatusError( status ) )
+					{
+					if( ticketLength < 1 || ticketLength > 512 )
+						status = CRYPT_ERROR_BADDATA;
+					else
+						{
+						status = sMemGetDataBlock( &stream, &ticketPtr,
+												   ticketLength );
+						}
+					}
+				if( !cryptStatusError( status ) )
+					{
+					status = sSkip( &stream, ticketLength,
+									MAX_INTLENGTH_SHORT );
+					}
+				if( !cryptStatusError( status ) )
+					status = extLength = readUint16( &stream );
+				if( !cryptStatusError( status ) && extLength > 0 )
+					{
+					status = sSkip( &stream, extLength,
+									MAX_INTLENGTH_SHORT );
+					}
+				if( cryptStatusError( status ) )
+					{
+					status = CRYPT_ERROR_BADDATA;
+					break;
+					}
+				status = CRYPT_OK;
+
+				/* If there's no server name to file the ticket under or
+				   it's a zero-lifetime ticket, there's nothing to do */
+				if( attributeListPtr == NULL || lifetime <= 0 )
+					break;
+
+				/* Derive the PSK for the ticket and remember it for later
+				   use */
+				status = hkdfExpandLabelTLS13( newSecret, TLS13_SECRET_SIZE,
+											   sslInfo->tls13ResumptionSecret,
+											   "resumption", 10, nonce,
+											   nonceLength );
+				if( cryptStatusOK( status ) )
+					{
+					status = addClientTicket( attributeListPtr->value,
+								attributeListPtr->valueLength,
+								ticketPtr, ticketLength, newSecret,
+								( sessionInfoPtr->protocolFlags & \
+								  SSL_PFLAG_GCM ) ? \
+									TLS_AES_128_GCM_SHA256 : \
+									TLS_CHACHA20_POLY1305_SHA256,
+								ageAdd, lifetime );
+					}
+				zeroise( newSecret, TLS13_SECRET_SIZE );
+				DEBUG_PRINT(( "Received TLS 1.3 session ticket.\n" ));
+#else
+				status = sSkip( &stream, length, MAX_INTLENGTH_SHORT );
+#endif /* USE_SSL_TICKETS */
+				break;
+				}
+
+			case SSL_HAND_KEYUPDATE:
+				if( length != 1 )
+					{
+					status = CRYPT_ERROR_BADDATA;
+					break;
+					}
+				status = sgetc( &stream );
+				if( cryptStatusError( status ) )
+					break;
+
+				/* Switch to the next-generation read key:
+
+					new_secret = HKDF-Expand-Label( secret, "traffic upd",
+													"", hashLen ) */
+				status = hkdfExpandLabelTLS13( newSecret, TLS13_SECRET_SIZE,
+											   sslInfo->tls13ReadSecret,
+											   "traffic upd", 11, NULL, 0 );
+				if( cryptStatusOK( status ) )
+					{
+					status = loadKeysTLS13( sessionInfoPtr, newSecret, 0,
+											TRUE );
+					}
+				zeroise( newSecret, TLS13_SECRET_SIZE );
+				DEBUG_PRINT(( "Processed TLS 1.3 key update.\n" ));
+				break;
+
+			default:
+				/* It's something that we don't handle, skip it */
+				status = sSkip( &stream, length, MAX_INTLENGTH_SHORT );
+				break;
+			}
+		}
+	ENSURES( LOOP_BOUND_OK );
+	sMemDisconnect( &stream );
+	if( cryptStatusError( status ) )
+		{
+		retExt( status,
+				( status, SESSION_ERRINFO,
+				  "Invalid TLS 1.3 post-handshake message" ) );
+		}
+
+	return( CRYPT_OK );
+	}
+#endif /* USE_SSL && USE_TLS13 */
@@ -75,10 +75,14 @@ static int startPacketStream( INOUT STREAM *stream,
 		byte		ID = packetType
 		byte[2]		version = { 0x03, 0x0n }
 		uint16		len = 0 (placeholder) 
-	  [ byte[]		iv	- TLS 1.1+ only ] */
+	  [ byte[]		iv	- TLS 1.1+ only ] 
+
+	   TLS 1.3 freezes the version number in the packet header at TLS 1.2, 
+	   so we never write a version number higher than that */
 	sputc( stream, packetType );
 	sputc( stream, SSL_MAJOR_VERSION );
-	sputc( stream, sessionInfoPtr->version );
+	sputc( stream, min( sessionInfoPtr->version, \
+						SSL_MINOR_VERSION_TLS12 ) );
 	status = writeUint16( stream, 0 );		/* Placeholder */
 	if( cryptStatusError( status ) )
 		return( status );
@@ -320,21 +324,28 @@ static int wrapPacketSSLStd( INOUT SESSION_INFO *sessionInfoPtr,
 	/* Clear return values */
 	*length = 0;
 
-	/* MAC the payload */
+	DEBUG_PRINT(( "Wrote %s (%d) packet, length %ld.\n", 
+				  getSSLPacketName( packetType ), packetType, 
+				  dataLength ));
+	DEBUG_DUMP_DATA( dataPtr, dataLength );
+
 #ifdef USE_SSL3
+	/* If it's SSL then we MAC the payload and then pad and encrypt it */
 	if( sessionInfoPtr->version == SSL_MINOR_VERSION_SSL )
 		{
 		status = createMacSSL( sessionInfoPtr, dataPtr, bufMaxLen, 
 							   &payloadLength, dataLength, packetType );
+		if( cryptStatusError( status ) )
+			return( status );
+		status = encryptData( sessionInfoPtr, dataPtr, bufMaxLen, 
+							  &payloadLength, payloadLength );
+		if( cryptStatusError( status ) )
+			return( status );
+		*length = payloadLength;
+
+		return( CRYPT_OK );
 		}
-	else
 #endif /* USE_SSL3 */
-		{
-		status = createMacTLS( sessionInfoPtr, dataPtr, bufMaxLen, 
-							   &payloadLength, dataLength, packetType );
-		}
-	if( cryptStatusError( status ) )
-		return( status );
 
 	/* If it's TLS 1.1+ and we're using a block cipher, adjust for the 
 	   explicit IV that precedes the data.  This is because the IV load is
@@ -347,20 +358,17 @@ static int wrapPacketSSLStd( INOUT SESSION_INFO *sessionInfoPtr,
 													 sslInfo->ivSize && \
 				  sessionInfoPtr->sendBufStartOfs <= sessionInfoPtr->sendBufSize );
 		dataPtr -= sslInfo->ivSize;
-		payloadLength += sslInfo->ivSize;
 		effectiveBufMaxLen = bufMaxLen + sslInfo->ivSize;
-		ENSURES( payloadLength > 0 && payloadLength <= effectiveBufMaxLen )
 		}
 	else
 		effectiveBufMaxLen = bufMaxLen;
-	DEBUG_PRINT(( "Wrote %s (%d) packet, length %ld.\n", 
-				  getSSLPacketName( packetType ), packetType, 
-				  payloadLength ));
-	DEBUG_DUMP_DATA( dataPtr, payloadLength );
 
-	/* Pad and encrypt the payload */
-	status = encryptData( sessionInfoPtr, dataPtr, effectiveBufMaxLen, 
-						  &payloadLength, payloadLength );
+	/* MAC, pad, and encrypt the payload, with the MAC'ing and encryption 
+	   stitched together so that each chunk of the record is still in the
+	   cache when it's encrypted */
+	status = macEncryptDataTLS( sessionInfoPtr, dataPtr, effectiveBufMaxLen, 
+								&payloadLength, sslInfo->ivSize, dataLength, 
+								packetType );
 	if( cryptStatusError( status ) )
 		return( status );
 
@@ -417,15 +425,11 @@ static int wrapPacketTLSMAC( INOUT SESSION_INFO *sessionInfoPtr,
 				  payloadLength ));
 	DEBUG_DUMP_DATA( dataPtr, payloadLength );
 
-	/* Pad and encrypt the payload */
-	status = encryptData( sessionInfoPtr, dataPtr, effectiveBufMaxLen, 
-						  &payloadLength, payloadLength );
-	if( cryptStatusError( status ) )
-		return( status );
-
-	/* MAC the payload */
-	status = createMacTLS( sessionInfoPtr, dataPtr, bufMaxLen, 
-						   &payloadLength, payloadLength, packetType );
+	/* Pad, encrypt, and MAC the payload, with the encryption and MAC'ing 
+	   stitched together so that each chunk of the record is still in the
+	   cache when it's MAC'd */
+	status = encryptMacDataTLS( sessionInfoPtr, dataPtr, effectiveBufMaxLen, 
+								&payloadLength, payloadLength, packetType );
 	if( cryptStatusError( status ) )
 		return( status );
 
@@ -435,7 +439,7 @@ static int wrapPacketTLSMAC( INOUT SESSION_INFO *sessionInfoPtr,
 	return( CRYPT_OK );
 	}
 
-#ifdef USE_GCM
+#if defined( USE_GCM ) || defined( USE_CHACHA20 )
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 5 ) ) \
 static int wrapPacketTLSGCM( INOUT SESSION_INFO *sessionInfoPtr, 
@@ -496,15 +500,29 @@ static int wrapPacketTLSGCM( INOUT SESSION_INFO *sessionInfoPtr,
 		+-------+-----------+
 		|<- 4 ->|<--- 8 --->| 
 
+	   ChaCha20-Poly1305 doesn't have an explicit nonce portion but 
+	   combines the salt with the sequence number.
+
 	   In addition we have to process the packet metadata that's normally
 	   MACed as GCM AAD */
-	memcpy( iv, sslInfo->gcmWriteSalt, sslInfo->gcmSaltSize );
-	memcpy( iv + sslInfo->gcmSaltSize, dataPtr - sslInfo->ivSize, 
-			sslInfo->ivSize );
-	setMessageData( &msgData, iv, GCM_IV_SIZE );
-	status = krnlSendMessage( sessionInfoPtr->iCryptOutContext,
-							  IMESSAGE_SETATTRIBUTE_S,
-							  &msgData, CRYPT_CTXINFO_IV );
+#ifdef USE_CHACHA20
+	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_CHACHA20 )
+		{
+		status = loadNonceTLSChaCha20( sessionInfoPtr->iCryptOutContext, 
+									   sslInfo->gcmWriteSalt, 
+									   sslInfo->writeSeqNo );
+		}
+	else
+#endif /* USE_CHACHA20 */
+		{
+		memcpy( iv, sslInfo->gcmWriteSalt, sslInfo->gcmSaltSize );
+		memcpy( iv + sslInfo->gcmSaltSize, dataPtr - sslInfo->ivSize, 
+				sslInfo->ivSize );
+		setMessageData( &msgData, iv, GCM_IV_SIZE );
+		status = krnlSendMessage( sessionInfoPtr->iCryptOutContext,
+								  IMESSAGE_SETATTRIBUTE_S,
+								  &msgData, CRYPT_CTXINFO_IV );
+		}
 	if( cryptStatusError( status ) )
 		return( status );
 
@@ -532,7 +550,71 @@ static int wrapPacketTLSGCM( INOUT SESSION_INFO *sessionInfoPtr,
 
 	return( CRYPT_OK );
 	}
-#endif /* USE_GCM */
+#endif /* USE_GCM || USE_CHACHA20 */
+
+#ifdef USE_TLS13
+
+/* Wrap a TLS 1.3 packet.  The actual packet type is appended to the 
+   payload and encrypted alongside it, with the outer packet type being 
+   set to application data by the caller.  We don't add any padding since 
+   cryptlib's typical applications don't need to hide the length of the 
+   data being sent */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 3, 5 ) ) \
+static int wrapPacketTLS13( INOUT SESSION_INFO *sessionInfoPtr, 
+							IN_RANGE( SSL_MSG_FIRST, \
+									  SSL_MSG_LAST ) const int packetType,
+							INOUT_BUFFER( bufMaxLen, *length ) \
+									BYTE *dataPtr,
+							IN_LENGTH_SHORT const int bufMaxLen,
+							OUT_LENGTH_BOUNDED_Z( bufMaxLen ) int *length,
+							IN_LENGTH_SHORT_Z const int dataLength )
+	{
+	SSL_INFO *sslInfo = sessionInfoPtr->sessionSSL;
+	int payloadLength = dataLength + 1, status;
+
+	assert( isWritePtr( sessionInfoPtr, sizeof( SESSION_INFO ) ) );
+	assert( isReadPtrDynamic( dataPtr, bufMaxLen ) );
+	assert( isWritePtr( length, sizeof( int ) ) );
+
+	REQUIRES( sanityCheckSession( sessionInfoPtr ) );
+	REQUIRES( packetType >= SSL_MSG_FIRST && packetType <= SSL_MSG_LAST );
+	REQUIRES( bufMaxLen > 0 && bufMaxLen <= sessionInfoPtr->sendBufSize );
+	REQUIRES( dataLength >= 0 && dataLength <= MAX_PACKET_SIZE && \
+			  dataLength + 1 + sessionInfoPtr->authBlocksize <= bufMaxLen );
+
+	/* Clear return values */
+	*length = 0;
+
+	/* Append the actual packet type to the payload */
+	dataPtr[ dataLength ] = intToByte( packetType );
+
+	/* Load the per-packet nonce and process the packet header as AAD */
+	status = loadNonceTLSChaCha20( sessionInfoPtr->iCryptOutContext, 
+								   sslInfo->gcmWriteSalt, 
+								   sslInfo->writeSeqNo );
+	if( cryptStatusOK( status ) )
+		{
+		status = macDataTLS13( sessionInfoPtr->iCryptOutContext, 
+							   payloadLength + \
+									sessionInfoPtr->authBlocksize );
+		}
+	if( cryptStatusError( status ) )
+		return( status );
+	sslInfo->writeSeqNo++;
+
+	/* Encrypt the payload */
+	status = encryptData( sessionInfoPtr, dataPtr, bufMaxLen, 
+						  &payloadLength, payloadLength );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Tell the caller what the final packet size is */
+	*length = payloadLength;
+
+	return( CRYPT_OK );
+	}
+#endif /* USE_TLS13 */
 
 CHECK_RETVAL STDC_NONNULL_ARG( ( 1, 2 ) ) \
 int wrapPacketSSL( INOUT SESSION_INFO *sessionInfoPtr, 
@@ -574,6 +656,16 @@ int wrapPacketSSL( INOUT SESSION_INFO *sessionInfoPtr,
 	ENSURES( packetType >= SSL_MSG_FIRST && packetType <= SSL_MSG_LAST );
 
 	/* Wrap the data based on the type of processing that we're using */
+#ifdef USE_TLS13
+	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_TLS13 )
+		{
+		status = wrapPacketTLS13( sessionInfoPtr, packetType, dataPtr, 
+								  bufMaxLen, &length, payloadLength );
+		if( cryptStatusOK( status ) )
+			*headerPtr = SSL_MSG_APPLICATION_DATA;
+		}
+	else
+#endif /* USE_TLS13 */
 	if( sessionInfoPtr->protocolFlags & SSL_PFLAG_ENCTHENMAC )
 		{
 		status = wrapPacketTLSMAC( sessionInfoPtr, packetType, dataPtr, 
@@ -581,14 +673,14 @@ int wrapPacketSSL( INOUT SESSION_INFO *sessionInfoPtr,
 		}
 	else
 		{
-#ifdef USE_GCM
-		if( sessionInfoPtr->protocolFlags & SSL_PFLAG_GCM )
+#if defined( USE_GCM ) || defined( USE_CHACHA20 )
+		if( sessionInfoPtr->protocolFlags & SSL_PFLAG_AEAD )
 			{
 			status = wrapPacketTLSGCM( sessionInfoPtr, packetType, dataPtr, 
 									   bufMaxLen, &length, payloadLength );
 			}
 		else
-#endif /* USE_GCM */
+#endif /* USE_GCM || USE_CHACHA20 */
 			{
 			status = wrapPacketSSLStd( sessionInfoPtr, packetType, dataPtr, 
 									   bufMaxLen, &length, payloadLength );
@@ -0,0 +1,855 @@
+/****************************************************************************
+*																			*
+*						cryptlib TLS OCSP Stapling							*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#if defined( INC_ALL )
+  #include "crypt.h"
+  #include "asn1.h"
+  #include "asn1_ext.h"
+  #include "session.h"
+  #include "ssl.h"
+  #include "stapling.h"
+#else
+  #include "crypt.h"
+  #include "enc_dec/asn1.h"
+  #include "enc_dec/asn1_ext.h"
+  #include "session/session.h"
+  #include "session/ssl.h"
+  #include "session/stapling.h"
+#endif /* Compiler-specific includes */
+
+/* OCSP stapling (RFC 6066 section 8) allows a TLS server to send the
+   client a current OCSP response for the server's certificate alongside
+   the certificate itself, saving the client from having to contact the
+   CA's OCSP responder (and the CA from finding out which sites the client
+   is visiting).  Since the responder is typically some distance away and
+   not noted for its speed, we never fetch the response as part of the
+   handshake.  Instead, the first handshake that uses a given server
+   certificate registers it with the stapling cache, after which a
+   background thread fetches the response using the standard OCSP client
+   and refreshes it once half of its validity period has elapsed.
+   Handshakes that occur before a response is available, or after it's
+   expired without a successful refresh, simply go ahead without a stapled
+   response, which the client treats in the same way as a server that
+   doesn't support stapling.
+
+   The cache is keyed by the fingerprint of the server certificate and
+   holds standalone copies of the server certificate and its issuer,
+   which are needed to create the OCSP request, along with the encoded
+   OCSPResponse as it's sent in the CertificateStatus message.  If the
+   server's certificate chain doesn't contain the issuer certificate then
+   we can't create a request and the entry is marked as unusable so that
+   we don't keep retrying on every handshake */
+
+#ifdef USE_OCSP_STAPLING
+
+/* The number of distinct server certificates that we cache responses for.
+   In practice there'll only ever be one or two (typically an RSA and an
+   ECC certificate) */
+
+#define STAPLE_MAX_ENTRIES		4
+
+/* The maximum size of a cached OCSP response.  A response for a single
+   certificate is typically well under 2kB, but some responders include
+   their own certificate chain in the response */
+
+#define MAX_STAPLE_SIZE			4096
+
+/* The time in ms that the refresh thread waits before rechecking the cache
+   when there's nothing to do */
+
+#define STAPLE_IDLE_WAIT		1000
+
+/* The time in seconds before we retry a failed fetch, and the lifetime
+   that we assume for responses that don't specify a nextUpdate time */
+
+#define STAPLE_RETRY_TIME		60
+#define STAPLE_DEFAULT_LIFETIME	3600
+
+/* The information for each server certificate.  An entry with no issuer
+   certificate is one for which we can't fetch a response */
+
+typedef struct {
+	BUFFER_FIXED( KEYID_SIZE ) \
+	BYTE certID[ KEYID_SIZE + 8 ];	/* Server certificate fingerprint */
+	CRYPT_CERTIFICATE iServerCert;	/* Server certificate */
+	CRYPT_CERTIFICATE iIssuerCert;	/* Server certificate's issuer */
+	BUFFER( MAX_STAPLE_SIZE, responseLength ) \
+	BYTE response[ MAX_STAPLE_SIZE + 8 ];
+	int responseLength;				/* Encoded OCSPResponse */
+	time_t expiryTime;				/* Time at which response expires */
+	time_t refreshTime;				/* Time to fetch a new response */
+	BOOLEAN inUse;					/* Whether entry is in use */
+	} STAPLE_ENTRY;
+
+typedef struct {
+	STAPLE_ENTRY entries[ STAPLE_MAX_ENTRIES + 4 ];
+	BOOLEAN refreshThreadActive;	/* Whether refresh thread is running */
+	BOOLEAN isShutdown;				/* Whether cache has been shut down */
+	} STAPLE_INFO;
+
+static STAPLE_INFO stapleInfo;
+static THREAD_STATE stapleThreadState;
+
+/****************************************************************************
+*																			*
+*								Utility Functions							*
+*																			*
+****************************************************************************/
+
+/* Get the ID that we use to identify the certificate associated with a
+   server's private key */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+static int getCertID( IN_HANDLE const CRYPT_CONTEXT iServerKey,
+					  OUT_BUFFER_FIXED( KEYID_SIZE ) BYTE *certID )
+	{
+	MESSAGE_DATA msgData;
+
+	assert( isWritePtr( certID, KEYID_SIZE ) );
+
+	REQUIRES( isHandleRangeValid( iServerKey ) );
+
+	setMessageData( &msgData, certID, KEYID_SIZE );
+	return( krnlSendMessage( iServerKey, IMESSAGE_GETATTRIBUTE_S,
+							 &msgData, CRYPT_CERTINFO_FINGERPRINT_SHA1 ) );
+	}
+
+/* Find the cache entry for a server certificate.  This must be called with
+   the stapling mutex held */
+
+CHECK_RETVAL_PTR STDC_NONNULL_ARG( ( 1 ) ) \
+static STAPLE_ENTRY *findEntry( IN_BUFFER( KEYID_SIZE ) const BYTE *certID,
+								OUT_OPT_PTR_COND STAPLE_ENTRY **freeEntryPtr )
+	{
+	int i, LOOP_ITERATOR;
+
+	assert( isReadPtr( certID, KEYID_SIZE ) );
+	assert( freeEntryPtr == NULL || \
+			isWritePtr( freeEntryPtr, sizeof( STAPLE_ENTRY * ) ) );
+
+	/* Clear return value */
+	if( freeEntryPtr != NULL )
+		*freeEntryPtr = NULL;
+
+	LOOP_SMALL( i = 0, i < STAPLE_MAX_ENTRIES, i++ )
+		{
+		STAPLE_ENTRY *entryPtr = &stapleInfo.entries[ i ];
+
+		if( !entryPtr->inUse )
+			{
+			if( freeEntryPtr != NULL && *freeEntryPtr == NULL )
+				*freeEntryPtr = entryPtr;
+			continue;
+			}
+		if( !memcmp( entryPtr->certID, certID, KEYID_SIZE ) )
+			return( entryPtr );
+		}
+	ENSURES_N( LOOP_BOUND_OK );
+
+	return( NULL );
+	}
+
+/* Create a standalone copy of the currently-selected certificate in a
+   certificate chain.  The chain is attached to the server's private key
+   and may be in use by other sessions, so we can't use it directly */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+static int copyChainCert( IN_HANDLE const CRYPT_CERTIFICATE iCertChain,
+						  OUT_HANDLE_OPT CRYPT_CERTIFICATE *iCertCopy )
+	{
+	MESSAGE_DATA msgData;
+	BYTE certData[ 2048 + 8 ], *certDataPtr = certData;
+	int status;
+
+	assert( isWritePtr( iCertCopy, sizeof( CRYPT_CERTIFICATE ) ) );
+
+	REQUIRES( isHandleRangeValid( iCertChain ) );
+
+	/* Clear return value */
+	*iCertCopy = CRYPT_ERROR;
+
+	setMessageData( &msgData, NULL, 0 );
+	status = krnlSendMessage( iCertChain, IMESSAGE_CRT_EXPORT, &msgData,
+							  CRYPT_CERTFORMAT_CERTIFICATE );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( msgData.length > 2048 )
+		{
+		if( ( certDataPtr = clAlloc( "copyChainCert", \
+									 msgData.length + 8 ) ) == NULL )
+			return( CRYPT_ERROR_MEMORY );
+		}
+	setMessageData( &msgData, certDataPtr, msgData.length );
+	status = krnlSendMessage( iCertChain, IMESSAGE_CRT_EXPORT, &msgData,
+							  CRYPT_CERTFORMAT_CERTIFICATE );
+	if( cryptStatusOK( status ) )
+		{
+		MESSAGE_CREATEOBJECT_INFO createInfo;
+
+		setMessageCreateObjectIndirectInfo( &createInfo, certDataPtr,
+											msgData.length,
+											CRYPT_CERTTYPE_CERTIFICATE );
+		status = krnlSendMessage( SYSTEM_OBJECT_HANDLE,
+								  IMESSAGE_DEV_CREATEOBJECT_INDIRECT,
+								  &createInfo, OBJECT_TYPE_CERTIFICATE );
+		if( cryptStatusOK( status ) )
+			*iCertCopy = createInfo.cryptHandle;
+		}
+	if( certDataPtr != certData )
+		clFree( "copyChainCert", certDataPtr );
+
+	return( status );
+	}
+
+/* Get copies of the server certificate and its issuer from the certificate
+   chain attached to the server's private key.  If there's no issuer
+   certificate present then we return CRYPT_ERROR_NOTFOUND */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2, 3 ) ) \
+static int getServerCerts( IN_HANDLE const CRYPT_CONTEXT iServerKey,
+						   OUT_HANDLE_OPT CRYPT_CERTIFICATE *iServerCert,
+						   OUT_HANDLE_OPT CRYPT_CERTIFICATE *iIssuerCert )
+	{
+	CRYPT_CERTIFICATE iCertChain;
+	int status;
+
+	assert( isWritePtr( iServerCert, sizeof( CRYPT_CERTIFICATE ) ) );
+	assert( isWritePtr( iIssuerCert, sizeof( CRYPT_CERTIFICATE ) ) );
+
+	REQUIRES( isHandleRangeValid( iServerKey ) );
+
+	/* Clear return values */
+	*iServerCert = *iIssuerCert = CRYPT_ERROR;
+
+	status = krnlSendMessage( iServerKey, IMESSAGE_GETDEPENDENT,
+							  &iCertChain, OBJECT_TYPE_CERTIFICATE );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Lock the chain for our exclusive use while we walk the cursor over
+	   it, since other sessions may be using the same server key */
+	status = krnlSendMessage( iCertChain, IMESSAGE_SETATTRIBUTE,
+							  MESSAGE_VALUE_TRUE, CRYPT_IATTRIBUTE_LOCKED );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = krnlSendMessage( iCertChain, IMESSAGE_SETATTRIBUTE,
+							  MESSAGE_VALUE_CURSORFIRST,
+							  CRYPT_CERTINFO_CURRENT_CERTIFICATE );
+	if( cryptStatusOK( status ) )
+		status = copyChainCert( iCertChain, iServerCert );
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( iCertChain, IMESSAGE_SETATTRIBUTE,
+								  MESSAGE_VALUE_CURSORNEXT,
+								  CRYPT_CERTINFO_CURRENT_CERTIFICATE );
+		if( cryptStatusError( status ) )
+			{
+			/* There's no issuer certificate present */
+			status = CRYPT_ERROR_NOTFOUND;
+			}
+		}
+	if( cryptStatusOK( status ) )
+		status = copyChainCert( iCertChain, iIssuerCert );
+	( void ) krnlSendMessage( iCertChain, IMESSAGE_SETATTRIBUTE,
+							  MESSAGE_VALUE_CURSORFIRST,
+							  CRYPT_CERTINFO_CURRENT_CERTIFICATE );
+	( void ) krnlSendMessage( iCertChain, IMESSAGE_SETATTRIBUTE,
+							  MESSAGE_VALUE_FALSE, CRYPT_IATTRIBUTE_LOCKED );
+	if( cryptStatusError( status ) && *iServerCert != CRYPT_ERROR )
+		{
+		krnlSendNotifier( *iServerCert, IMESSAGE_DECREFCOUNT );
+		*iServerCert = CRYPT_ERROR;
+		}
+
+	return( status );
+	}
+
+/****************************************************************************
+*																			*
+*							OCSP Response Fetch								*
+*																			*
+****************************************************************************/
+
+/* Send an OCSP request for the server certificate to the responder and get
+   back the response */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 3 ) ) \
+static int getOCSPResponse( IN_HANDLE const CRYPT_CERTIFICATE iServerCert,
+							IN_HANDLE const CRYPT_CERTIFICATE iIssuerCert,
+							OUT_HANDLE_OPT CRYPT_CERTIFICATE *iOcspResponse )
+	{
+	CRYPT_CERTIFICATE iOcspRequest;
+	CRYPT_SESSION iOcspSession;
+	MESSAGE_CREATEOBJECT_INFO createInfo;
+	MESSAGE_DATA msgData;
+	BYTE responderURL[ MAX_URL_SIZE + 8 ];
+	int status;
+
+	assert( isWritePtr( iOcspResponse, sizeof( CRYPT_CERTIFICATE ) ) );
+
+	REQUIRES( isHandleRangeValid( iServerCert ) );
+	REQUIRES( isHandleRangeValid( iIssuerCert ) );
+
+	/* Clear return value */
+	*iOcspResponse = CRYPT_ERROR;
+
+	/* Create the OCSP request for the server certificate */
+	setMessageCreateObjectInfo( &createInfo, CRYPT_CERTTYPE_OCSP_REQUEST );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE,
+							  IMESSAGE_DEV_CREATEOBJECT, &createInfo,
+							  OBJECT_TYPE_CERTIFICATE );
+	if( cryptStatusError( status ) )
+		return( status );
+	iOcspRequest = createInfo.cryptHandle;
+	status = krnlSendMessage( iOcspRequest, IMESSAGE_SETATTRIBUTE,
+							  ( MESSAGE_CAST ) &iIssuerCert,
+							  CRYPT_CERTINFO_CACERTIFICATE );
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( iOcspRequest, IMESSAGE_SETATTRIBUTE,
+								  ( MESSAGE_CAST ) &iServerCert,
+								  CRYPT_CERTINFO_CERTIFICATE );
+		}
+	if( cryptStatusError( status ) )
+		{
+		krnlSendNotifier( iOcspRequest, IMESSAGE_DECREFCOUNT );
+		return( status );
+		}
+
+	/* Create the OCSP session.  If the user has specified a responder then
+	   we use that, otherwise the session takes the responder location from
+	   the server certificate's authorityInfoAccess extension when the
+	   request is added */
+	setMessageCreateObjectInfo( &createInfo, CRYPT_SESSION_OCSP );
+	status = krnlSendMessage( SYSTEM_OBJECT_HANDLE,
+							  IMESSAGE_DEV_CREATEOBJECT, &createInfo,
+							  OBJECT_TYPE_SESSION );
+	if( cryptStatusError( status ) )
+		{
+		krnlSendNotifier( iOcspRequest, IMESSAGE_DECREFCOUNT );
+		return( status );
+		}
+	iOcspSession = createInfo.cryptHandle;
+	setMessageData( &msgData, responderURL, MAX_URL_SIZE );
+	status = krnlSendMessage( DEFAULTUSER_OBJECT_HANDLE,
+							  IMESSAGE_GETATTRIBUTE_S, &msgData,
+							  CRYPT_OPTION_SESSION_OCSPRESPONDER );
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( iOcspSession, IMESSAGE_SETATTRIBUTE_S,
+								  &msgData, CRYPT_SESSINFO_SERVER_NAME );
+		}
+	else
+		{
+		/* There's no explicit responder configured, use the one from the
+		   certificate */
+		status = CRYPT_OK;
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( iOcspSession, IMESSAGE_SETATTRIBUTE,
+								  ( MESSAGE_CAST ) &iOcspRequest,
+								  CRYPT_SESSINFO_REQUEST );
+		}
+	krnlSendNotifier( iOcspRequest, IMESSAGE_DECREFCOUNT );
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( iOcspSession, IMESSAGE_SETATTRIBUTE,
+								  MESSAGE_VALUE_TRUE,
+								  CRYPT_SESSINFO_ACTIVE );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = krnlSendMessage( iOcspSession, IMESSAGE_GETATTRIBUTE,
+								  iOcspResponse, CRYPT_SESSINFO_RESPONSE );
+		}
+	krnlSendNotifier( iOcspSession, IMESSAGE_DECREFCOUNT );
+
+	return( status );
+	}
+
+/* Fetch an OCSP response for the server certificate and encode it as an
+   OCSPResponse for use in the TLS CertificateStatus message.  The OCSP
+   client only retains the inner BasicOCSPResponse, so we have to rebuild
+   the OCSPResponse wrapper around it:
+
+	OCSPResponse ::= SEQUENCE {
+		responseStatus		ENUMERATED = 0,
+		responseBytes	[0]	EXPLICIT SEQUENCE {
+			responseType	OBJECT IDENTIFIER id-pkix-ocsp-basic,
+			response		OCTET STRING BasicOCSPResponse
+			}
+		} */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 3, 5, 6 ) ) \
+static int fetchOCSPResponse( IN_HANDLE const CRYPT_CERTIFICATE iServerCert,
+							  IN_HANDLE const CRYPT_CERTIFICATE iIssuerCert,
+							  OUT_BUFFER( responseMaxLength, \
+										  *responseLength ) \
+								BYTE *response,
+							  IN_LENGTH_SHORT const int responseMaxLength,
+							  OUT_LENGTH_BOUNDED_Z( responseMaxLength ) \
+								int *responseLength,
+							  OUT time_t *expiryTime )
+	{
+	CRYPT_CERTIFICATE iOcspResponse;
+	STREAM stream;
+	MESSAGE_DATA msgData;
+	const time_t currentTime = getTime();
+	time_t nextUpdate;
+	int responseDataLength, responseBytesLength, status;
+
+	assert( isWritePtr( response, responseMaxLength ) );
+	assert( isWritePtr( responseLength, sizeof( int ) ) );
+	assert( isWritePtr( expiryTime, sizeof( time_t ) ) );
+
+	REQUIRES( isHandleRangeValid( iServerCert ) );
+	REQUIRES( isHandleRangeValid( iIssuerCert ) );
+	REQUIRES( responseMaxLength > 0 && \
+			  responseMaxLength < MAX_INTLENGTH_SHORT );
+
+	/* Clear return values */
+	memset( response, 0, min( 16, responseMaxLength ) );
+	*responseLength = 0;
+	*expiryTime = 0;
+
+	/* If we can't tell whether a response is still valid then there's no
+	   point in fetching it */
+	if( currentTime <= MIN_TIME_VALUE )
+		return( CRYPT_ERROR_NOTAVAIL );
+
+	/* Get the response from the responder */
+	status = getOCSPResponse( iServerCert, iIssuerCert, &iOcspResponse );
+	if( cryptStatusError( status ) )
+		return( status );
+
+	/* Determine when the response expires.  If the responder doesn't
+	   provide a nextUpdate time then we assume a default lifetime, and if
+	   it's provided a response that's already expired then there's no
+	   point in using it */
+	setMessageData( &msgData, &nextUpdate, sizeof( time_t ) );
+	status = krnlSendMessage( iOcspResponse, IMESSAGE_GETATTRIBUTE_S,
+							  &msgData, CRYPT_CERTINFO_NEXTUPDATE );
+	if( cryptStatusError( status ) )
+		nextUpdate = currentTime + STAPLE_DEFAULT_LIFETIME;
+	if( nextUpdate <= currentTime )
+		{
+		krnlSendNotifier( iOcspResponse, IMESSAGE_DECREFCOUNT );
+		return( CRYPT_ERROR_INVALID );
+		}
+
+	/* Get the size of the encoded BasicOCSPResponse and make sure that the
+	   full OCSPResponse will fit into the response buffer */
+	setMessageData( &msgData, NULL, 0 );
+	status = krnlSendMessage( iOcspResponse, IMESSAGE_CRT_EXPORT,
+							  &msgData, CRYPT_CERTFORMAT_CERTIFICATE );
+	if( cryptStatusError( status ) )
+		{
+		krnlSendNotifier( iOcspResponse, IMESSAGE_DECREFCOUNT );
+		return( status );
+		}
+	responseDataLength = msgData.length;
+	responseBytesLength = sizeofOID( OID_OCSP_RESPONSE_OCSP ) + \
+						  sizeofObject( responseDataLength );
+	if( sizeofObject( sizeofEnumerated( 0 ) + \
+					  sizeofObject( sizeofObject( responseBytesLength ) ) ) > \
+		responseMaxLength )
+		{
+		krnlSendNotifier( iOcspResponse, IMESSAGE_DECREFCOUNT );
+		return( CRYPT_ERROR_OVERFLOW );
+		}
+
+	/* Write the OCSPResponse wrapper and the BasicOCSPResponse */
+	sMemOpen( &stream, response, responseMaxLength );
+	writeSequence( &stream, sizeofEnumerated( 0 ) + \
+				   sizeofObject( sizeofObject( responseBytesLength ) ) );
+	writeEnumerated( &stream, 0, DEFAULT_TAG );		/* respStatus */
+	writeConstructed( &stream, sizeofObject( responseBytesLength ), 0 );
+	writeSequence( &stream, responseBytesLength );	/* respBytes */
+	writeOID( &stream, OID_OCSP_RESPONSE_OCSP );	/* respType */
+	status = writeOctetStringHole( &stream, responseDataLength,
+								   DEFAULT_TAG );	/* response */
+	if( cryptStatusOK( status ) )
+		{
+		status = exportCertToStream( &stream, iOcspResponse,
+									 CRYPT_CERTFORMAT_CERTIFICATE );
+		}
+	if( cryptStatusOK( status ) )
+		*responseLength = stell( &stream );
+	sMemDisconnect( &stream );
+	krnlSendNotifier( iOcspResponse, IMESSAGE_DECREFCOUNT );
+	if( cryptStatusError( status ) )
+		return( status );
+	*expiryTime = nextUpdate;
+
+	return( CRYPT_OK );
+	}
+
+/****************************************************************************
+*																			*
+*							Response Refresh Thread							*
+*																			*
+****************************************************************************/
+
+/* Find an entry whose response needs to be fetched or refreshed.  This
+   must be called with the stapling mutex held */
+
+CHECK_RETVAL_PTR \
+static STAPLE_ENTRY *findEntryToRefresh( const time_t currentTime )
+	{
+	int i, LOOP_ITERATOR;
+
+	LOOP_SMALL( i = 0, i < STAPLE_MAX_ENTRIES, i++ )
+		{
+		STAPLE_ENTRY *entryPtr = &stapleInfo.entries[ i ];
+
+		if( !entryPtr->inUse || entryPtr->iIssuerCert == CRYPT_ERROR )
+			continue;
+		if( entryPtr->refreshTime <= currentTime )
+			return( entryPtr );
+		}
+	ENSURES_N( LOOP_BOUND_OK );
+
+	return( NULL );
+	}
+
+/* The response refresh thread.  This runs until the kernel shuts down,
+   fetching responses for any entry that's due for a refresh and sleeping
+   otherwise.  As with the key pool fill thread, all loops are bounded so
+   the thread will eventually exit even if the kernel isn't shutting down,
+   in which case it's restarted on the next handshake that checks for a
+   stapled response */
+
+static void stapleRefreshThread( const THREAD_PARAMS *threadParams )
+	{
+	int iterationCount, LOOP_ITERATOR;
+
+	assert( isReadPtr( threadParams, sizeof( THREAD_PARAMS ) ) );
+
+	LOOP_MAX( iterationCount = 0, !krnlIsExiting(), iterationCount++ )
+		{
+		STAPLE_ENTRY *entryPtr;
+		CRYPT_CERTIFICATE iServerCert DUMMY_INIT;
+		CRYPT_CERTIFICATE iIssuerCert DUMMY_INIT;
+		BYTE certID[ KEYID_SIZE + 8 ];
+		BYTE response[ MAX_STAPLE_SIZE + 8 ];
+		const time_t currentTime = getTime();
+		time_t expiryTime;
+		int responseLength, fetchStatus, status;
+
+		/* Find an entry that needs refreshing.  The certificates in the
+		   entry are only destroyed at shutdown, after this thread has
+		   exited, so we can continue to use them once we've released the
+		   mutex */
+		status = krnlEnterMutex( MUTEX_OCSPSTAPLE );
+		if( cryptStatusError( status ) )
+			break;
+		entryPtr = findEntryToRefresh( currentTime );
+		if( entryPtr != NULL )
+			{
+			memcpy( certID, entryPtr->certID, KEYID_SIZE );
+			iServerCert = entryPtr->iServerCert;
+			iIssuerCert = entryPtr->iIssuerCert;
+			}
+		krnlExitMutex( MUTEX_OCSPSTAPLE );
+		if( entryPtr == NULL )
+			{
+			/* There's nothing to do, wait for a while before checking
+			   again */
+			( void ) krnlWait( STAPLE_IDLE_WAIT );
+			continue;
+			}
+
+		/* Fetch the response without holding the mutex, since this is the
+		   slow part of the process */
+		fetchStatus = fetchOCSPResponse( iServerCert, iIssuerCert, 
+										 response, MAX_STAPLE_SIZE, 
+										 &responseLength, &expiryTime );
+
+		/* Update the entry.  If the fetch failed then we continue to use
+		   any existing response until it expires, and try again later.
+		   If it succeeded then we refresh the response once half of its
+		   validity period has elapsed, which leaves plenty of time for
+		   retries if the responder is temporarily unavailable */
+		status = krnlEnterMutex( MUTEX_OCSPSTAPLE );
+		if( cryptStatusError( status ) )
+			break;
+		if( !stapleInfo.isShutdown && entryPtr->inUse && \
+			!memcmp( entryPtr->certID, certID, KEYID_SIZE ) )
+			{
+			if( cryptStatusOK( fetchStatus ) )
+				{
+				memcpy( entryPtr->response, response, responseLength );
+				entryPtr->responseLength = responseLength;
+				entryPtr->expiryTime = expiryTime;
+				entryPtr->refreshTime = currentTime + \
+										( ( expiryTime - currentTime ) / 2 );
+				}
+			else
+				entryPtr->refreshTime = currentTime + STAPLE_RETRY_TIME;
+			}
+		krnlExitMutex( MUTEX_OCSPSTAPLE );
+		}
+
+	/* Let the TLS server know that it needs to restart the thread if it
+	   wants further refreshes */
+	if( cryptStatusOK( krnlEnterMutex( MUTEX_OCSPSTAPLE ) ) )
+		{
+		stapleInfo.refreshThreadActive = FALSE;
+		krnlExitMutex( MUTEX_OCSPSTAPLE );
+		}
+	}
+
+/* Start the refresh thread if it isn't already running */
+
+static void startRefreshThread( void )
+	{
+	int status;
+
+	status = krnlEnterMutex( MUTEX_OCSPSTAPLE );
+	if( cryptStatusError( status ) )
+		return;
+	if( stapleInfo.refreshThreadActive || stapleInfo.isShutdown )
+		{
+		krnlExitMutex( MUTEX_OCSPSTAPLE );
+		return;
+		}
+	stapleInfo.refreshThreadActive = TRUE;
+	krnlExitMutex( MUTEX_OCSPSTAPLE );
+
+	/* If there's a previous instance of the refresh thread that's exited,
+	   wait for it to finish before we reuse its thread storage */
+	( void ) krnlWaitSemaphore( SEMAPHORE_OCSPSTAPLE );
+	status = krnlDispatchThread( stapleRefreshThread, stapleThreadState,
+								 NULL, 0, SEMAPHORE_OCSPSTAPLE );
+	if( cryptStatusError( status ) && \
+		cryptStatusOK( krnlEnterMutex( MUTEX_OCSPSTAPLE ) ) )
+		{
+		stapleInfo.refreshThreadActive = FALSE;
+		krnlExitMutex( MUTEX_OCSPSTAPLE );
+		}
+	}
+
+/****************************************************************************
+*																			*
+*								Stapling Access								*
+*																			*
+****************************************************************************/
+
+/* Add a cache entry for the certificate associated with a server's private
+   key */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 2 ) ) \
+static int addEntry( IN_HANDLE const CRYPT_CONTEXT iServerKey,
+					 IN_BUFFER( KEYID_SIZE ) const BYTE *certID )
+	{
+	STAPLE_ENTRY *entryPtr, *freeEntryPtr;
+	CRYPT_CERTIFICATE iServerCert, iIssuerCert;
+	int status;
+
+	assert( isReadPtr( certID, KEYID_SIZE ) );
+
+	REQUIRES( isHandleRangeValid( iServerKey ) );
+
+	/* Get the certificates that we need to create the OCSP request.  This
+	   is done without holding the mutex since it involves a fair amount of
+	   work, if the chain doesn't contain the issuer certificate then we
+	   still add an entry in order to record that we can't staple a
+	   response for this certificate */
+	status = getServerCerts( iServerKey, &iServerCert, &iIssuerCert );
+	if( cryptStatusError( status ) && status != CRYPT_ERROR_NOTFOUND )
+		return( status );
+
+	/* Add the new entry, rechecking the cache state since another thread
+	   may have added the same certificate while we weren't holding the
+	   mutex */
+	status = krnlEnterMutex( MUTEX_OCSPSTAPLE );
+	if( cryptStatusError( status ) )
+		{
+		if( iServerCert != CRYPT_ERROR )
+			krnlSendNotifier( iServerCert, IMESSAGE_DECREFCOUNT );
+		if( iIssuerCert != CRYPT_ERROR )
+			krnlSendNotifier( iIssuerCert, IMESSAGE_DECREFCOUNT );
+		return( status );
+		}
+	entryPtr = findEntry( certID, &freeEntryPtr );
+	if( entryPtr == NULL && freeEntryPtr != NULL && !stapleInfo.isShutdown )
+		{
+		memset( freeEntryPtr, 0, sizeof( STAPLE_ENTRY ) );
+		memcpy( freeEntryPtr->certID, certID, KEYID_SIZE );
+		freeEntryPtr->iServerCert = iServerCert;
+		freeEntryPtr->iIssuerCert = iIssuerCert;
+		freeEntryPtr->inUse = TRUE;
+		iServerCert = iIssuerCert = CRYPT_ERROR;
+		}
+	krnlExitMutex( MUTEX_OCSPSTAPLE );
+	if( iServerCert != CRYPT_ERROR )
+		krnlSendNotifier( iServerCert, IMESSAGE_DECREFCOUNT );
+	if( iIssuerCert != CRYPT_ERROR )
+		krnlSendNotifier( iIssuerCert, IMESSAGE_DECREFCOUNT );
+
+	return( CRYPT_OK );
+	}
+
+/* Check whether there's a current OCSP response available for the
+   certificate associated with a server's private key */
+
+CHECK_RETVAL \
+int checkOCSPStaple( IN_HANDLE const CRYPT_CONTEXT iServerKey )
+	{
+	const STAPLE_ENTRY *entryPtr;
+	BYTE certID[ KEYID_SIZE + 8 ];
+	const time_t currentTime = getTime();
+	BOOLEAN responseAvailable = FALSE, entryPresent = FALSE;
+	int value, status;
+
+	REQUIRES( isHandleRangeValid( iServerKey ) );
+
+	/* If stapling isn't enabled or we can't tell whether a response is
+	   still valid, there's nothing to do */
+	status = krnlSendMessage( DEFAULTUSER_OBJECT_HANDLE,
+							  IMESSAGE_GETATTRIBUTE, &value,
+							  CRYPT_OPTION_SESSION_OCSPSTAPLING );
+	if( cryptStatusError( status ) || !value )
+		return( CRYPT_ERROR_NOTFOUND );
+	if( currentTime <= MIN_TIME_VALUE )
+		return( CRYPT_ERROR_NOTFOUND );
+
+	/* Check for a current response for the server certificate */
+	status = getCertID( iServerKey, certID );
+	if( cryptStatusError( status ) )
+		return( CRYPT_ERROR_NOTFOUND );
+	status = krnlEnterMutex( MUTEX_OCSPSTAPLE );
+	if( cryptStatusError( status ) )
+		return( status );
+	if( stapleInfo.isShutdown )
+		{
+		krnlExitMutex( MUTEX_OCSPSTAPLE );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+	entryPtr = findEntry( certID, NULL );
+	if( entryPtr != NULL )
+		{
+		entryPresent = TRUE;
+		if( entryPtr->responseLength > 0 && \
+			entryPtr->expiryTime > currentTime )
+			responseAvailable = TRUE;
+		}
+	krnlExitMutex( MUTEX_OCSPSTAPLE );
+
+	/* If this is the first time that we've seen this certificate, add it
+	   to the cache so that the refresh thread can fetch a response for
+	   it */
+	if( !entryPresent )
+		{
+		status = addEntry( iServerKey, certID );
+		if( cryptStatusError( status ) )
+			return( CRYPT_ERROR_NOTFOUND );
+		}
+
+	/* Make sure that the refresh thread is running, since it may have
+	   exited after reaching its iteration limit */
+	startRefreshThread();
+
+	return( responseAvailable ? CRYPT_OK : CRYPT_ERROR_NOTFOUND );
+	}
+
+/* Write the cached OCSP response for the certificate associated with a
+   server's private key */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int writeOCSPStaple( INOUT STREAM *stream,
+					 IN_HANDLE const CRYPT_CONTEXT iServerKey )
+	{
+	const STAPLE_ENTRY *entryPtr;
+	BYTE certID[ KEYID_SIZE + 8 ];
+	int status;
+
+	assert( isWritePtr( stream, sizeof( STREAM ) ) );
+
+	REQUIRES( isHandleRangeValid( iServerKey ) );
+
+	status = getCertID( iServerKey, certID );
+	if( cryptStatusError( status ) )
+		return( status );
+	status = krnlEnterMutex( MUTEX_OCSPSTAPLE );
+	if( cryptStatusError( status ) )
+		return( status );
+	entryPtr = findEntry( certID, NULL );
+	if( entryPtr == NULL || entryPtr->responseLength <= 0 )
+		{
+		/* The response that was present when checkOCSPStaple() was called
+		   has disappeared, which can only happen if we've been shut down
+		   in the meantime */
+		krnlExitMutex( MUTEX_OCSPSTAPLE );
+		return( CRYPT_ERROR_NOTFOUND );
+		}
+	writeUint24( stream, entryPtr->responseLength );
+	status = swrite( stream, entryPtr->response,
+					 entryPtr->responseLength );
+	krnlExitMutex( MUTEX_OCSPSTAPLE );
+
+	return( status );
+	}
+
+/****************************************************************************
+*																			*
+*							Init/Shutdown Functions							*
+*																			*
+****************************************************************************/
+
+/* Initialise and shut down the stapling cache.  The refresh thread isn't
+   started until the first handshake that asks for a stapled response, and
+   when we shut down we have to wait for it to exit before we can destroy
+   the cached certificates */
+
+CHECK_RETVAL \
+int initOCSPStapling( void )
+	{
+	int i, LOOP_ITERATOR;
+
+	memset( &stapleInfo, 0, sizeof( STAPLE_INFO ) );
+	LOOP_SMALL( i = 0, i < STAPLE_MAX_ENTRIES, i++ )
+		{
+		STAPLE_ENTRY *entryPtr = &stapleInfo.entries[ i ];
+
+		entryPtr->iServerCert = entryPtr->iIssuerCert = CRYPT_ERROR;
+		}
+	ENSURES( LOOP_BOUND_OK );
+
+	return( CRYPT_OK );
+	}
+
+void endOCSPStapling( void )
+	{
+	int i, status, LOOP_ITERATOR;
+
+	REQUIRES_V( krnlIsExiting() );
+
+	/* Wait for the refresh thread to exit */
+	( void ) krnlWaitSemaphore( SEMAPHORE_OCSPSTAPLE );
+
+	/* Destroy the cached certificates and clear the responses */
+	status = krnlEnterMutex( MUTEX_OCSPSTAPLE );
+	if( cryptStatusError( status ) )
+		return;
+	stapleInfo.isShutdown = TRUE;
+	LOOP_SMALL( i = 0, i < STAPLE_MAX_ENTRIES, i++ )
+		{
+		STAPLE_ENTRY *entryPtr = &stapleInfo.entries[ i ];
+
+		if( entryPtr->iServerCert != CRYPT_ERROR )
+			krnlSendNotifier( entryPtr->iServerCert, IMESSAGE_DECREFCOUNT );
+		if( entryPtr->iIssuerCert != CRYPT_ERROR )
+			krnlSendNotifier( entryPtr->iIssuerCert, IMESSAGE_DECREFCOUNT );
+		zeroise( entryPtr, sizeof( STAPLE_ENTRY ) );
+		entryPtr->iServerCert = entryPtr->iIssuerCert = CRYPT_ERROR;
+		}
+	ENSURES_KRNLMUTEX_V( LOOP_BOUND_OK, MUTEX_OCSPSTAPLE );
+	krnlExitMutex( MUTEX_OCSPSTAPLE );
+	}
+#endif /* USE_OCSP_STAPLING */
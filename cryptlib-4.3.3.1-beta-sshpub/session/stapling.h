@@ -0,0 +1,58 @@
+/****************************************************************************
+*																			*
+*					cryptlib TLS OCSP Stapling Header File					*
+*							Copyright agent 2026							*
+*																			*
+****************************************************************************/
+
+#ifndef _STAPLING_DEFINED
+
+#define _STAPLING_DEFINED
+
+/* OCSP stapling needs both TLS and the OCSP client, and a means of fetching
+   the OCSP response in the background so that the handshake never waits on
+   the CA's responder.  Since each cached response occupies a fixed-size
+   buffer we also disable it on memory-constrained systems */
+
+#if defined( USE_SSL ) && defined( USE_OCSP ) && \
+	defined( USE_THREAD_FUNCTIONS ) && !defined( CONFIG_CONSERVE_MEMORY )
+  #define USE_OCSP_STAPLING
+#endif /* USE_SSL && USE_OCSP && USE_THREAD_FUNCTIONS && !CONFIG_CONSERVE_MEMORY */
+
+/****************************************************************************
+*																			*
+*							OCSP Stapling Functions							*
+*																			*
+****************************************************************************/
+
+#ifdef USE_OCSP_STAPLING
+
+/* Check whether there's a current OCSP response available for the
+   certificate associated with a server's private key.  If there isn't,
+   this registers the certificate with the stapling cache so that a
+   response is fetched in the background and returns CRYPT_ERROR_NOTFOUND,
+   in which case the handshake proceeds without a stapled response */
+
+CHECK_RETVAL \
+int checkOCSPStaple( IN_HANDLE const CRYPT_CONTEXT iServerKey );
+
+/* Write the cached OCSP response for the certificate associated with a
+   server's private key as a uint24 length-prefixed OCSPResponse, as used
+   in the TLS CertificateStatus message */
+
+CHECK_RETVAL STDC_NONNULL_ARG( ( 1 ) ) \
+int writeOCSPStaple( INOUT STREAM *stream,
+					 IN_HANDLE const CRYPT_CONTEXT iServerKey );
+
+/* Prototypes for init/shutdown functions */
+
+CHECK_RETVAL \
+int initOCSPStapling( void );
+void endOCSPStapling( void );
+#else
+  #define checkOCSPStaple( iServerKey )		CRYPT_ERROR_NOTFOUND
+  #define writeOCSPStaple( stream, iServerKey )	CRYPT_ERROR_NOTFOUND
+  #define initOCSPStapling()				CRYPT_OK
+  #define endOCSPStapling()
+#endif /* USE_OCSP_STAPLING */
+#endif /* _STAPLING_DEFINED */
@@ -269,7 +269,7 @@ int testSessionUrlParse( void )
 int testSessionAttributes( void )
 	{
 	CRYPT_SESSION cryptSession;
-	int status;
+	int value, status;
 
 	puts( "Testing session attribute handling..." );
 
@@ -365,6 +365,41 @@ int testSessionAttributes( void )
 		return( FALSE );
 		}
 
+	/* The network-event state only exists once the session is active, 
+	   make sure that it can't be read before then */
+	status = cryptGetAttribute( cryptSession, CRYPT_SESSINFO_NETWORKEVENTS,
+								&value );
+	if( cryptStatusOK( status ) )
+		{
+		printf( "Read of network events for inactive session wasn't "
+				"detected, line %d.\n", __LINE__ );
+		return( FALSE );
+		}
+
+	/* Corking the session can be done at any time, make sure that the
+	   cork state is recorded and that uncorking an inactive session, for
+	   which there's no data to flush, succeeds */
+	status = cryptSetAttribute( cryptSession, CRYPT_SESSINFO_CORK, TRUE );
+	if( cryptStatusOK( status ) )
+		status = cryptGetAttribute( cryptSession, CRYPT_SESSINFO_CORK,
+									&value );
+	if( cryptStatusError( status ) || value != TRUE )
+		{
+		printf( "Corking of session failed with status %d, line %d.\n",
+				status, __LINE__ );
+		return( FALSE );
+		}
+	status = cryptSetAttribute( cryptSession, CRYPT_SESSINFO_CORK, FALSE );
+	if( cryptStatusOK( status ) )
+		status = cryptGetAttribute( cryptSession, CRYPT_SESSINFO_CORK,
+									&value );
+	if( cryptStatusError( status ) || value != FALSE )
+		{
+		printf( "Uncorking of session failed with status %d, line %d.\n",
+				status, __LINE__ );
+		return( FALSE );
+		}
+
 	/* Clean up */
 	status = cryptDestroySession( cryptSession );
 	if( cryptStatusError( status ) )
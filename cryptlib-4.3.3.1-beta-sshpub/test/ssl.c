@@ -93,6 +93,7 @@ typedef enum {
 	SSL_TEST_NONE,				/* No SSL/TLS test type */
 	SSL_TEST_NORMAL,			/* Standard SSL/TLS test */
 	SSL_TEST_BULKTRANSER,		/* Bulk data transfer */
+	SSL_TEST_READAHEAD,			/* Bulk transfer with varying record sizes */
 	SSL_TEST_CLIENTCERT,		/* User auth.with client certificate */
 	SSL_TEST_CLIENTCERT_MANUAL,	/* User auth.client certificate manual verif.*/
 	SSL_TEST_PSK,				/* User auth.with shared key */
@@ -105,6 +106,7 @@ typedef enum {
 	SSL_TEST_RESUME,			/* Session resumption */
 	SSL_TEST_DUALTHREAD,		/* Two-phase connect via different threads */
 	SSL_TEST_MULTITHREAD,		/* Multiple server threads */
+	SSL_TEST_KEYSHARE_RETRY,	/* TLS 1.3 HelloRetryRequest for key share */
 	SSL_TEST_CORRUPT_HANDSHAKE,	/* Detect corruption of handshake data */
 	SSL_TEST_CORRUPT_DATA,		/* Detect corruption of payload data */
 	SSL_TEST_CORRUPT_MAC,		/* Detect corruption of payload MAC */
@@ -536,6 +538,29 @@ static BOOLEAN handleBulkBuffer( BYTE *buffer, const BOOLEAN isInit )
 	return( TRUE );
 	}
 
+/* Record sizes used for the read-ahead test.  The stream layer reads 
+   ahead into a 16kB buffer, so sending records of these sizes back-to-back 
+   results in record headers and bodies that are split across the point 
+   where the buffer has to be refilled, as well as records that are larger 
+   than the buffer and therefore read partly from it and partly directly 
+   from the network */
+
+static const int readAheadSizes[] = {
+	1, 4091, 16384, 5, 16383, 333, 8192, 16379, 2, 12000, 16380, 4096 
+	};
+
+#define READAHEAD_SIZE_COUNT	\
+			( sizeof( readAheadSizes ) / sizeof( int ) )
+
+static int getTransferSize( const SSL_TEST_TYPE testType, const int index,
+							const long bytesLeft )
+	{
+	if( testType != SSL_TEST_READAHEAD )
+		return( ( int ) bytesLeft );
+	return( ( int ) min( bytesLeft, 
+						 readAheadSizes[ index % READAHEAD_SIZE_COUNT ] ) );
+	}
+
 /* Negotiate through a STARTTLS */
 
 #ifdef USE_LOCAL_SOCKETS
@@ -687,6 +712,9 @@ static int connectSSLTLS( const CRYPT_SESSION_TYPE sessionType,
 	CRYPT_SESSION cryptSession;
 	const BOOLEAN isServer = ( sessionType == CRYPT_SESSION_SSL_SERVER ) ? \
 							   TRUE : FALSE;
+	const BOOLEAN isBulkTransfer = ( testType == SSL_TEST_BULKTRANSER || \
+									 testType == SSL_TEST_READAHEAD ) ? \
+									 TRUE : FALSE;
 	const BOOLEAN isErrorTest = ( testType >= SSL_TEST_CORRUPT_HANDSHAKE && \
 								  testType < SSL_TEST_LAST ) ? \
 								  TRUE : FALSE;
@@ -749,11 +777,13 @@ static int connectSSLTLS( const CRYPT_SESSION_TYPE sessionType,
 			( testType == SSL_TEST_CLIENTCERT_MANUAL ) ? " with manual verification of client cert" : \
 			( testType == SSL_TEST_STARTTLS ) ? " with local socket" : \
 			( testType == SSL_TEST_BULKTRANSER ) ? " for bulk data transfer" : \
+			( testType == SSL_TEST_READAHEAD ) ? " for bulk data transfer with varying record sizes" : \
 			( testType == SSL_TEST_PSK ) ? " with shared key" : \
 			( testType == SSL_TEST_PSK_CLIONLY ) ? " with client-only PSK" : \
 			( testType == SSL_TEST_PSK_SVRONLY ) ? " with server-only PSK" : \
 			( testType == SSL_TEST_ECC ) ? " with P256 ECC crypto" : \
 			( testType == SSL_TEST_ECC_P384 ) ? " with P384 ECC crypto" : \
+			( testType == SSL_TEST_KEYSHARE_RETRY ) ? " with HelloRetryRequest" : \
 			isErrorTest ? " with checking for error handling" : "" );
 #ifndef NO_SESSION_CACHE
 	if( isServer )
@@ -813,10 +843,12 @@ static int connectSSLTLS( const CRYPT_SESSION_TYPE sessionType,
 							 FAULT_BADSIG_DATA : \
 							 FAULT_NONE );
 		}
+	if( !isServer && testType == SSL_TEST_KEYSHARE_RETRY )
+		cryptSetFaultType( FAULT_SESSION_SSL_TLS13_NO_KEYSHARE );
 #endif /* CONFIG_FAULTS && Debug */
 
 	/* If we're doing a bulk data transfer, set up the necessary buffer */
-	if( testType == SSL_TEST_BULKTRANSER )
+	if( isBulkTransfer )
 		{
 		if( ( bulkBuffer = malloc( BULKDATA_BUFFER_SIZE ) ) == NULL )
 			{
@@ -946,7 +978,7 @@ static int connectSSLTLS( const CRYPT_SESSION_TYPE sessionType,
 						  "to the TLS upgrade).\n" );
 					return( TRUE );
 					}
-				if( testType == SSL_TEST_BULKTRANSER )
+				if( isBulkTransfer )
 					free( bulkBuffer );
 				return( FALSE );
 				}
@@ -977,7 +1009,7 @@ static int connectSSLTLS( const CRYPT_SESSION_TYPE sessionType,
 				{
 				if( !setLocalConnect( cryptSession, 443 ) )
 					{
-					if( testType == SSL_TEST_BULKTRANSER )
+					if( isBulkTransfer )
 						free( bulkBuffer );
 					return( FALSE );
 					}
@@ -1124,7 +1156,7 @@ static int connectSSLTLS( const CRYPT_SESSION_TYPE sessionType,
 			}
 		printf( "cryptSetAttribute/AttributeString() failed with error code "
 				"%d, line %d.\n", status, __LINE__ );
-		if( testType == SSL_TEST_BULKTRANSER )
+		if( isBulkTransfer )
 			free( bulkBuffer );
 		return( FALSE );
 		}
@@ -1259,7 +1291,7 @@ dualThreadContinue:
 				 isServer ? "SVR: " : "", localSession ? "local " : "",
 				 versionStr[ version ] );
 		printExtError( cryptSession, strBuffer, status, __LINE__ );
-		if( testType == SSL_TEST_BULKTRANSER )
+		if( isBulkTransfer )
 			free( bulkBuffer );
 		if( !isServer && isServerDown( cryptSession, status ) )
 			{
@@ -1385,7 +1417,7 @@ dualThreadContinue:
 				( isServer && ( testType == SSL_TEST_CLIENTCERT || \
 								testType == SSL_TEST_CLIENTCERT_MANUAL ) ) ) )
 			{
-			if( testType == SSL_TEST_BULKTRANSER )
+			if( isBulkTransfer )
 				free( bulkBuffer );
 			return( FALSE );
 			}
@@ -1393,7 +1425,7 @@ dualThreadContinue:
 		if( !printSecurityInfo( cryptSession, isServer, isFirstSession,
 								!isServer && isFirstSession, FALSE ) )
 			{
-			if( testType == SSL_TEST_BULKTRANSER )
+			if( isBulkTransfer )
 				free( bulkBuffer );
 			return( FALSE );
 			}
@@ -1425,7 +1457,7 @@ dualThreadContinue:
 			printf( "%sCouldn't get %s certificate, status %d, line %d.\n",
 					isServer ? "SVR: " : "", isServer ? "client" : "server",
 					status, __LINE__ );
-			if( testType == SSL_TEST_BULKTRANSER )
+			if( isBulkTransfer )
 				free( bulkBuffer );
 			return( FALSE );
 			}
@@ -1488,18 +1520,18 @@ dualThreadContinue:
 								5 );
 #else
 	status = cryptSetAttribute( cryptSession, CRYPT_OPTION_NET_READTIMEOUT,
-								( testType == SSL_TEST_BULKTRANSER ) ? 0 : 5 );
+								isBulkTransfer ? 0 : 5 );
 #endif /* IS_HIGHVOLUME_SERVER */
 	if( cryptStatusError( status ) )
 		{
-		if( testType == SSL_TEST_BULKTRANSER )
+		if( isBulkTransfer )
 			free( bulkBuffer );
 		printExtError( cryptSession, isServer ? \
 					   "SVR: Session timeout set" : "Session timeout set", 
 					   status, __LINE__ );
 		return( FALSE );
 		}
-	if( testType == SSL_TEST_BULKTRANSER )
+	if( isBulkTransfer )
 		{
 #ifdef USE_TIMING
 		int timeMS;
@@ -1509,13 +1541,20 @@ dualThreadContinue:
 		if( isServer )
 			{
 			long byteCount = 0;
+			int index = 0;
 
+			/* For the read-ahead test each piece of data is flushed 
+			   separately so that it's sent as its own record */
 			do
 				{
 				status = cryptPushData( cryptSession, bulkBuffer + byteCount,
-										BULKDATA_BUFFER_SIZE - byteCount,
+										getTransferSize( testType, index++,
+											BULKDATA_BUFFER_SIZE - byteCount ),
 										&bytesCopied );
 				byteCount += bytesCopied;
+				if( cryptStatusOK( status ) && \
+					testType == SSL_TEST_READAHEAD )
+					status = cryptFlushData( cryptSession );
 				}
 			while( ( cryptStatusOK( status ) || \
 					 status == CRYPT_ERROR_TIMEOUT ) && \
@@ -1545,11 +1584,13 @@ dualThreadContinue:
 		else
 			{
 			long byteCount = 0;
+			int index = 0;
 
 			do
 				{
 				status = cryptPopData( cryptSession, bulkBuffer + byteCount,
-									   BULKDATA_BUFFER_SIZE - byteCount,
+									   getTransferSize( testType, index++,
+											BULKDATA_BUFFER_SIZE - byteCount ),
 									   &bytesCopied );
 				byteCount += bytesCopied;
 				}
@@ -2116,6 +2157,10 @@ int testSessionTLSBulkTransferClientServer( void )
 	{
 	return( tlsClientServer( SSL_TEST_BULKTRANSER ) );
 	}
+int testSessionTLSReadAheadClientServer( void )
+	{
+	return( tlsClientServer( SSL_TEST_READAHEAD ) );
+	}
 
 unsigned __stdcall tls11ServerThread( void *arg )
 	{
@@ -2224,6 +2269,65 @@ int testSessionTLS12ClientCertManualClientServer( void )
 	return( tls12ClientServer( SSL_TEST_CLIENTCERT_MANUAL ) );
 	}
 
+unsigned __stdcall tls13ServerThread( void *arg )
+	{
+	const int argValue = *( ( int * ) arg );
+
+	connectSSLTLS( CRYPT_SESSION_SSL_SERVER, argValue, 4, CRYPT_UNUSED, 
+				   TRUE );
+	_endthreadex( 0 );
+	return( 0 );
+	}
+static int tls13ClientServer( const SSL_TEST_TYPE testType )
+	{
+	HANDLE hThread;
+	unsigned threadID;
+	int arg = testType, status;
+
+	/* Start the server */
+	createMutex();
+	hThread = ( HANDLE ) _beginthreadex( NULL, 0, tls13ServerThread, &arg, 0, 
+										 &threadID );
+	Sleep( 1000 );
+
+	/* Connect to the local server */
+	status = connectSSLTLS( CRYPT_SESSION_SSL, testType, 4, CRYPT_UNUSED, 
+							TRUE );
+	waitForThread( hThread );
+	destroyMutex();
+	return( status );
+	}
+int testSessionTLS13ClientServer( void )
+	{
+	return( tls13ClientServer( SSL_TEST_NORMAL ) );
+	}
+int testSessionTLS13ResumeClientServer( void )
+	{
+	/* Note that this function has to be called after 
+	   testSessionTLS13ClientServer(), since it checks for the ability to 
+	   resume the previous session using the ticket that the server sent */
+	return( tls13ClientServer( SSL_TEST_RESUME ) );
+	}
+int testSessionTLS13HelloRetryClientServer( void )
+	{
+#if defined( CONFIG_FAULTS ) && !defined( NDEBUG )
+	int status;
+
+	/* The client always sends a key share for the one group that the 
+	   server supports so a HelloRetryRequest never occurs naturally, to 
+	   test it we have the client send an empty key share list in its first 
+	   client hello */
+	cryptSetFaultType( FAULT_NONE );
+	status = tls13ClientServer( SSL_TEST_KEYSHARE_RETRY );
+	cryptSetFaultType( FAULT_NONE );
+	return( status );
+#else
+	puts( "Fault injection isn't enabled in this build of cryptlib, "
+		  "skipping TLS 1.3 HelloRetryRequest test." );
+	return( TRUE );
+#endif /* CONFIG_FAULTS && Debug */
+	}
+
 unsigned __stdcall tlsServerDualThread2( void *dummy )
 	{
 	connectSSLTLS( CRYPT_SESSION_SSL_SERVER, SSL_TEST_DUALTHREAD, 1, 0, TRUE );
@@ -2343,4 +2447,935 @@ int testSessionSSLClientServerDebugCheck( void )
 	}
 #endif /* WINDOWS_THREADS */
 
+/****************************************************************************
+*																			*
+*							Event-driven TLS Server							*
+*																			*
+****************************************************************************/
+
+/* Drive a large number of TLS server sessions from a single thread via 
+   epoll().  The event-loop thread manages the listen socket itself, 
+   accepting connections and handing them to cryptlib via 
+   CRYPT_SESSINFO_NETWORKSOCKET.  The sessions are marked as nonblocking, 
+   so that activating them returns a timeout status whenever the handshake 
+   would block on network I/O, with CRYPT_SESSINFO_NETWORKEVENTS indicating 
+   what the session is waiting for.  Once the socket is ready the event 
+   loop activates the session again, which continues the handshake from 
+   where it left off.  After the handshake has completed the read and write 
+   timeouts are set to zero and the event loop echoes any data that arrives 
+   back to the client.
+   
+   The client side drives its own nonblocking handshakes for all of the 
+   connections concurrently via poll(), and then performs a series of echo 
+   rounds across them, reporting how long it took to establish the 
+   connections and the round-trip rate that the single event-loop thread 
+   achieved */
+
+#if defined( __linux__ ) && defined( UNIX_THREADS )
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/time.h>
+
+#define EVENTLOOP_CONNECTIONS		64
+#define EVENTLOOP_ROUNDS			50
+#define EVENTLOOP_MSG_SIZE			256
+#define EVENTLOOP_BUFFER_SIZE		4096
+#define EVENTLOOP_LISTEN_INDEX		EVENTLOOP_CONNECTIONS
+
+typedef struct {
+	CRYPT_SESSION cryptSession;	/* Session */
+	SOCKET netSocket;			/* Socket that the session is using */
+	BOOLEAN isEstablished;		/* Whether handshake has completed */
+	} EVENTLOOP_SESSION;
+
+typedef struct {
+	SOCKET listenSocket;		/* Socket that connections arrive on */
+	int epollFD;				/* Event-loop poll set */
+	CRYPT_CONTEXT privateKey;	/* Server private key */
+	EVENTLOOP_SESSION session[ EVENTLOOP_CONNECTIONS ];
+	int noAccepted, noClosed;	/* Connection counts */
+	volatile BOOLEAN isShutdown;/* Client side has finished */
+	} EVENTLOOP_INFO;
+
+/* Tell epoll() which events a session is waiting for */
+
+static int updateEventLoopEvents( EVENTLOOP_INFO *eventLoopInfo, 
+								  const int index, const int networkEvents )
+	{
+	struct epoll_event event;
+
+	memset( &event, 0, sizeof( struct epoll_event ) );
+	if( networkEvents & CRYPT_NETWORKEVENT_READ )
+		event.events |= EPOLLIN;
+	if( networkEvents & CRYPT_NETWORKEVENT_WRITE )
+		event.events |= EPOLLOUT;
+	event.data.u32 = index;
+	if( epoll_ctl( eventLoopInfo->epollFD, EPOLL_CTL_MOD, 
+				   eventLoopInfo->session[ index ].netSocket, 
+				   &event ) < 0 )
+		return( CRYPT_ERROR_WRITE );
+
+	return( CRYPT_OK );
+	}
+
+/* Start or continue the handshake for a session.  If the handshake would 
+   block then the activation returns a timeout status and we wait for the 
+   events that the session reports before activating it again */
+
+static int continueEventLoopHandshake( EVENTLOOP_INFO *eventLoopInfo, 
+									   const int index )
+	{
+	EVENTLOOP_SESSION *sessionInfo = &eventLoopInfo->session[ index ];
+	int networkEvents, status;
+
+	status = cryptSetAttribute( sessionInfo->cryptSession, 
+								CRYPT_SESSINFO_ACTIVE, TRUE );
+	if( status == CRYPT_ERROR_TIMEOUT )
+		{
+		/* If the handshake is waiting for network I/O then the session 
+		   reports what it's waiting for, if it's timed out for real then 
+		   there are no network events to report */
+		status = cryptGetAttribute( sessionInfo->cryptSession, 
+									CRYPT_SESSINFO_NETWORKEVENTS, 
+									&networkEvents );
+		if( cryptStatusOK( status ) )
+			{
+			return( updateEventLoopEvents( eventLoopInfo, index, 
+										   networkEvents ) );
+			}
+		status = CRYPT_ERROR_TIMEOUT;
+		}
+	if( cryptStatusError( status ) )
+		{
+		printExtError( sessionInfo->cryptSession, 
+					   "Event-loop server handshake", status, __LINE__ );
+		return( status );
+		}
+
+	/* The handshake has completed, from now on all I/O is nonblocking */
+	cryptSetAttribute( sessionInfo->cryptSession, 
+					   CRYPT_OPTION_NET_READTIMEOUT, 0 );
+	cryptSetAttribute( sessionInfo->cryptSession, 
+					   CRYPT_OPTION_NET_WRITETIMEOUT, 0 );
+	sessionInfo->isEstablished = TRUE;
+	return( updateEventLoopEvents( eventLoopInfo, index, 
+								   CRYPT_NETWORKEVENT_READ ) );
+	}
+
+/* Accept any pending connections and start the handshake for them */
+
+static int acceptEventLoopConnections( EVENTLOOP_INFO *eventLoopInfo )
+	{
+	while( eventLoopInfo->noAccepted < EVENTLOOP_CONNECTIONS )
+		{
+		const int index = eventLoopInfo->noAccepted;
+		EVENTLOOP_SESSION *sessionInfo = &eventLoopInfo->session[ index ];
+		struct epoll_event event;
+		SOCKET netSocket;
+		int status;
+
+		/* Accept the next connection, the listen socket is nonblocking so 
+		   we stop once there are no more pending connections */
+		netSocket = accept( eventLoopInfo->listenSocket, NULL, NULL );
+		if( netSocket == INVALID_SOCKET )
+			{
+			return( ( errno == EAGAIN || errno == EWOULDBLOCK ) ? \
+					CRYPT_OK : CRYPT_ERROR_OPEN );
+			}
+		eventLoopInfo->noAccepted++;
+
+		/* Create a nonblocking session for the connection and add it to 
+		   the poll set */
+		status = cryptCreateSession( &sessionInfo->cryptSession, 
+									 CRYPT_UNUSED, CRYPT_SESSION_SSL_SERVER );
+		if( cryptStatusError( status ) )
+			{
+			closesocket( netSocket );
+			return( status );
+			}
+		sessionInfo->netSocket = netSocket;
+		status = cryptSetAttribute( sessionInfo->cryptSession, 
+									CRYPT_SESSINFO_PRIVATEKEY,
+									eventLoopInfo->privateKey );
+		if( cryptStatusOK( status ) )
+			{
+			status = cryptSetAttribute( sessionInfo->cryptSession, 
+										CRYPT_SESSINFO_NETWORKSOCKET, 
+										netSocket );
+			}
+		if( cryptStatusOK( status ) )
+			{
+			status = cryptSetAttribute( sessionInfo->cryptSession, 
+										CRYPT_SESSINFO_NONBLOCKING, TRUE );
+			}
+		if( cryptStatusError( status ) )
+			{
+			printExtError( sessionInfo->cryptSession, 
+						   "Event-loop server session setup", status, 
+						   __LINE__ );
+			return( status );
+			}
+		memset( &event, 0, sizeof( struct epoll_event ) );
+		event.events = EPOLLIN;
+		event.data.u32 = index;
+		epoll_ctl( eventLoopInfo->epollFD, EPOLL_CTL_ADD, netSocket, 
+				   &event );
+
+		/* Start the handshake */
+		status = continueEventLoopHandshake( eventLoopInfo, index );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+
+	return( CRYPT_OK );
+	}
+
+/* Service a session that the event loop has reported as ready by echoing 
+   any data that's arrived back to the client.  Since the session timeouts
+   are zero this never blocks, if only part of a TLS record has arrived 
+   then no data is returned and we wait for the socket to become readable 
+   again */
+
+static int serviceEventLoopSession( EVENTLOOP_INFO *eventLoopInfo, 
+									const int index, 
+									const BOOLEAN isWriteable )
+	{
+	const CRYPT_SESSION cryptSession = \
+						eventLoopInfo->session[ index ].cryptSession;
+	BYTE buffer[ EVENTLOOP_BUFFER_SIZE ];
+	int networkEvents, status;
+
+	/* If we're waiting to flush data from an earlier write, try that 
+	   first */
+	if( isWriteable )
+		{
+		status = cryptFlushData( cryptSession );
+		if( cryptStatusError( status ) && status != CRYPT_ERROR_TIMEOUT )
+			return( status );
+		}
+
+	/* Echo everything that's available back to the client.  The session 
+	   may decode more data than fits into our buffer, in which case it 
+	   reports that further data is available without the socket needing 
+	   to become readable again */
+	do
+		{
+		int bytesCopied, bytesWritten;
+
+		status = cryptPopData( cryptSession, buffer, EVENTLOOP_BUFFER_SIZE, 
+							   &bytesCopied );
+		if( cryptStatusError( status ) )
+			return( status );
+		if( bytesCopied > 0 )
+			{
+			status = cryptPushData( cryptSession, buffer, bytesCopied, 
+									&bytesWritten );
+			if( cryptStatusOK( status ) && bytesWritten != bytesCopied )
+				status = CRYPT_ERROR_OVERFLOW;
+			if( cryptStatusOK( status ) )
+				{
+				/* A timeout on the flush means that only part of the data 
+				   could be written, the rest is sent when the socket 
+				   becomes writeable */
+				status = cryptFlushData( cryptSession );
+				if( status == CRYPT_ERROR_TIMEOUT )
+					status = CRYPT_OK;
+				}
+			if( cryptStatusError( status ) )
+				return( status );
+			}
+		status = cryptGetAttribute( cryptSession, 
+									CRYPT_SESSINFO_NETWORKEVENTS, 
+									&networkEvents );
+		if( cryptStatusError( status ) )
+			return( status );
+		}
+	while( networkEvents & CRYPT_NETWORKEVENT_DATA );
+
+	/* Update the events that we're waiting for on this socket */
+	return( updateEventLoopEvents( eventLoopInfo, index, networkEvents ) );
+	}
+
+/* Shut down a session */
+
+static void closeEventLoopSession( EVENTLOOP_INFO *eventLoopInfo, 
+								   const int index )
+	{
+	EVENTLOOP_SESSION *sessionInfo = &eventLoopInfo->session[ index ];
+
+	if( sessionInfo->cryptSession == CRYPT_UNUSED )
+		return;
+	epoll_ctl( eventLoopInfo->epollFD, EPOLL_CTL_DEL, sessionInfo->netSocket, 
+			   NULL );
+	cryptDestroySession( sessionInfo->cryptSession );
+	closesocket( sessionInfo->netSocket );
+	sessionInfo->cryptSession = CRYPT_UNUSED;
+	eventLoopInfo->noClosed++;
+	}
+
+/* The event loop, which accepts connections and services all sessions, 
+   both during and after the handshake, from a single thread */
+
+static void *eventLoopThread( void *arg )
+	{
+	EVENTLOOP_INFO *eventLoopInfo = arg;
+	struct epoll_event events[ EVENTLOOP_CONNECTIONS + 1 ];
+	int i;
+
+	while( TRUE )
+		{
+		int noEvents;
+
+		/* Exit once the client side has finished and all sessions have 
+		   been closed down */
+		if( eventLoopInfo->isShutdown && \
+			eventLoopInfo->noClosed >= eventLoopInfo->noAccepted )
+			break;
+
+		noEvents = epoll_wait( eventLoopInfo->epollFD, events, 
+							   EVENTLOOP_CONNECTIONS + 1, 100 );
+		if( noEvents < 0 )
+			break;
+		if( noEvents == 0 && eventLoopInfo->isShutdown )
+			{
+			/* The clients have gone away without the remaining sessions 
+			   being closed down, we're done */
+			break;
+			}
+		for( i = 0; i < noEvents; i++ )
+			{
+			const int index = events[ i ].data.u32;
+			int status;
+
+			if( index == EVENTLOOP_LISTEN_INDEX )
+				{
+				status = acceptEventLoopConnections( eventLoopInfo );
+				if( cryptStatusError( status ) && \
+					eventLoopInfo->noAccepted > 0 )
+					{
+					/* Clean up the session for which the handshake 
+					   couldn't be started */
+					closeEventLoopSession( eventLoopInfo, 
+										   eventLoopInfo->noAccepted - 1 );
+					}
+				continue;
+				}
+			if( eventLoopInfo->session[ index ].cryptSession == CRYPT_UNUSED )
+				continue;
+			if( !eventLoopInfo->session[ index ].isEstablished )
+				status = continueEventLoopHandshake( eventLoopInfo, index );
+			else
+				{
+				status = serviceEventLoopSession( eventLoopInfo, index, 
+									( events[ i ].events & EPOLLOUT ) ? \
+									TRUE : FALSE );
+				}
+			if( cryptStatusOK( status ) )
+				continue;
+
+			/* The client has closed the connection or there was an error, 
+			   shut down the session */
+			closeEventLoopSession( eventLoopInfo, index );
+			}
+		}
+
+	/* Clean up any sessions that are still open */
+	for( i = 0; i < eventLoopInfo->noAccepted; i++ )
+		closeEventLoopSession( eventLoopInfo, i );
+
+	THREAD_EXIT();
+	}
+
+/* Create the client sessions and drive their handshakes with the 
+   event-driven server concurrently via poll() */
+
+static int connectEventLoopClients( CRYPT_SESSION *cryptSession, 
+									const int port )
+	{
+	struct pollfd pollInfo[ EVENTLOOP_CONNECTIONS ];
+	BOOLEAN isConnected[ EVENTLOOP_CONNECTIONS ];
+	int noPending = EVENTLOOP_CONNECTIONS, iterationCount, i;
+	int status = CRYPT_OK;
+
+	/* Create the client sessions.  A negative descriptor in the poll set 
+	   marks a session that isn't waiting for network I/O, which poll() 
+	   ignores */
+	for( i = 0; i < EVENTLOOP_CONNECTIONS; i++ )
+		cryptSession[ i ] = CRYPT_UNUSED;
+	for( i = 0; i < EVENTLOOP_CONNECTIONS; i++ )
+		{
+		status = cryptCreateSession( &cryptSession[ i ], CRYPT_UNUSED, 
+									 CRYPT_SESSION_SSL );
+		if( cryptStatusError( status ) )
+			{
+			cryptSession[ i ] = CRYPT_UNUSED;
+			return( status );
+			}
+		status = cryptSetAttributeString( cryptSession[ i ], 
+										  CRYPT_SESSINFO_SERVER_NAME, 
+										  "127.0.0.1", 9 );
+		if( cryptStatusOK( status ) )
+			{
+			status = cryptSetAttribute( cryptSession[ i ], 
+										CRYPT_SESSINFO_SERVER_PORT, port );
+			}
+		if( cryptStatusOK( status ) )
+			{
+			/* We're connecting to the server's explicit IPv4 address 
+			   rather than "localhost", disable host-name verification */
+			status = cryptSetAttribute( cryptSession[ i ], 
+										CRYPT_SESSINFO_SSL_OPTIONS,
+										CRYPT_SSLOPTION_DISABLE_NAMEVERIFY );
+			}
+		if( cryptStatusOK( status ) )
+			{
+			status = cryptSetAttribute( cryptSession[ i ], 
+										CRYPT_SESSINFO_NONBLOCKING, TRUE );
+			}
+		if( cryptStatusError( status ) )
+			{
+			printExtError( cryptSession[ i ], "Event-loop client setup", 
+						   status, __LINE__ );
+			return( status );
+			}
+		memset( &pollInfo[ i ], 0, sizeof( struct pollfd ) );
+		pollInfo[ i ].fd = -1;
+		isConnected[ i ] = FALSE;
+		}
+
+	/* Activate each session whose socket is ready until all of the 
+	   handshakes have completed */
+	for( iterationCount = 0; noPending > 0 && iterationCount < 100000; 
+		 iterationCount++ )
+		{
+		int noEvents;
+
+		for( i = 0; i < EVENTLOOP_CONNECTIONS; i++ )
+			{
+			int networkEvents, networkSocket;
+
+			if( isConnected[ i ] || pollInfo[ i ].fd >= 0 )
+				continue;
+			status = cryptSetAttribute( cryptSession[ i ], 
+										CRYPT_SESSINFO_ACTIVE, TRUE );
+			if( cryptStatusOK( status ) )
+				{
+				/* The handshake has completed, from now on we use the 
+				   session in the standard blocking manner */
+				status = cryptSetAttribute( cryptSession[ i ], 
+											CRYPT_OPTION_NET_READTIMEOUT, 5 );
+				if( cryptStatusError( status ) )
+					return( status );
+				isConnected[ i ] = TRUE;
+				noPending--;
+				continue;
+				}
+			if( status == CRYPT_ERROR_TIMEOUT )
+				{
+				/* The handshake is waiting for network I/O, find out what 
+				   it's waiting for */
+				status = cryptGetAttribute( cryptSession[ i ], 
+											CRYPT_SESSINFO_NETWORKEVENTS, 
+											&networkEvents );
+				if( cryptStatusOK( status ) )
+					{
+					status = cryptGetAttribute( cryptSession[ i ], 
+												CRYPT_SESSINFO_NETWORKSOCKET, 
+												&networkSocket );
+					}
+				if( cryptStatusError( status ) )
+					status = CRYPT_ERROR_TIMEOUT;
+				}
+			if( cryptStatusError( status ) )
+				{
+				printExtError( cryptSession[ i ], "Event-loop client "
+							   "handshake", status, __LINE__ );
+				return( status );
+				}
+			pollInfo[ i ].fd = networkSocket;
+			pollInfo[ i ].events = \
+					( ( networkEvents & CRYPT_NETWORKEVENT_READ ) ? \
+						POLLIN : 0 ) | \
+					( ( networkEvents & CRYPT_NETWORKEVENT_WRITE ) ? \
+						POLLOUT : 0 );
+			}
+		if( noPending <= 0 )
+			break;
+
+		/* Wait for some of the handshakes to be able to continue */
+		noEvents = poll( pollInfo, EVENTLOOP_CONNECTIONS, 10000 );
+		if( noEvents <= 0 )
+			{
+			printf( "Event-loop client handshakes stalled with %d "
+					"handshakes pending, line %d.\n", noPending, __LINE__ );
+			return( CRYPT_ERROR_TIMEOUT );
+			}
+		for( i = 0; i < EVENTLOOP_CONNECTIONS; i++ )
+			{
+			if( pollInfo[ i ].revents != 0 )
+				pollInfo[ i ].fd = -1;
+			}
+		}
+
+	return( ( noPending <= 0 ) ? CRYPT_OK : CRYPT_ERROR_TIMEOUT );
+	}
+
+/* Perform one echo round across all client sessions: send a message on 
+   every connection and then collect the responses */
+
+static int echoEventLoopRound( const CRYPT_SESSION *cryptSession, 
+							   const int round )
+	{
+	BYTE buffer[ EVENTLOOP_MSG_SIZE ], response[ EVENTLOOP_MSG_SIZE ];
+	int i, status;
+
+	for( i = 0; i < EVENTLOOP_CONNECTIONS; i++ )
+		{
+		int bytesCopied;
+
+		memset( buffer, ( round + i ) & 0xFF, EVENTLOOP_MSG_SIZE );
+		status = cryptPushData( cryptSession[ i ], buffer, 
+								EVENTLOOP_MSG_SIZE, &bytesCopied );
+		if( cryptStatusOK( status ) )
+			status = cryptFlushData( cryptSession[ i ] );
+		if( cryptStatusError( status ) )
+			{
+			printExtError( cryptSession[ i ], "Event-loop client send", 
+						   status, __LINE__ );
+			return( status );
+			}
+		}
+	for( i = 0; i < EVENTLOOP_CONNECTIONS; i++ )
+		{
+		int length = 0;
+
+		while( length < EVENTLOOP_MSG_SIZE )
+			{
+			int bytesCopied;
+
+			status = cryptPopData( cryptSession[ i ], response + length, 
+								   EVENTLOOP_MSG_SIZE - length, &bytesCopied );
+			if( cryptStatusOK( status ) && bytesCopied <= 0 )
+				status = CRYPT_ERROR_TIMEOUT;
+			if( cryptStatusError( status ) )
+				{
+				printExtError( cryptSession[ i ], "Event-loop client "
+							   "receive", status, __LINE__ );
+				return( status );
+				}
+			length += bytesCopied;
+			}
+		memset( buffer, ( round + i ) & 0xFF, EVENTLOOP_MSG_SIZE );
+		if( memcmp( buffer, response, EVENTLOOP_MSG_SIZE ) )
+			{
+			printf( "Echoed data for connection %d doesn't match sent "
+					"data, line %d.\n", i, __LINE__ );
+			return( CRYPT_ERROR_BADDATA );
+			}
+		}
+
+	return( CRYPT_OK );
+	}
+
+static long getElapsedTime( const struct timeval *startTime )
+	{
+	struct timeval endTime;
+
+	gettimeofday( &endTime, NULL );
+	return( ( ( endTime.tv_sec - startTime->tv_sec ) * 1000L ) + \
+			( ( endTime.tv_usec - startTime->tv_usec ) / 1000L ) );
+	}
+
+int testSessionTLSEventLoopClientServer( void )
+	{
+	EVENTLOOP_INFO eventLoopInfo;
+	CRYPT_SESSION cryptSession[ EVENTLOOP_CONNECTIONS ];
+	pthread_t loopThread;
+	struct sockaddr_in serverAddr;
+	struct epoll_event event;
+	struct timeval startTime;
+	socklen_t addrLen = sizeof( struct sockaddr_in );
+	char filenameBuffer[ FILENAME_BUFFER_SIZE ];
+	long connectTime, echoTime = 0;
+	int round, i, status = CRYPT_OK;
+
+	puts( "Testing event-driven TLS server with a single event-loop "
+		  "thread..." );
+
+	/* Set up the server state and listen socket.  We let the system 
+	   choose the port since we're managing the socket ourselves */
+	memset( &eventLoopInfo, 0, sizeof( EVENTLOOP_INFO ) );
+	for( i = 0; i < EVENTLOOP_CONNECTIONS; i++ )
+		eventLoopInfo.session[ i ].cryptSession = CRYPT_UNUSED;
+	filenameFromTemplate( filenameBuffer, SERVER_PRIVKEY_FILE_TEMPLATE, 1 );
+	status = getPrivateKey( &eventLoopInfo.privateKey, filenameBuffer,
+							USER_PRIVKEY_LABEL, TEST_PRIVKEY_PASSWORD );
+	if( cryptStatusError( status ) )
+		{
+		printf( "Couldn't read server private key, status %d, line %d.\n",
+				status, __LINE__ );
+		return( FALSE );
+		}
+	memset( &serverAddr, 0, sizeof( struct sockaddr_in ) );
+	serverAddr.sin_family = AF_INET;
+	serverAddr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+	eventLoopInfo.listenSocket = socket( PF_INET, SOCK_STREAM, 0 );
+	if( eventLoopInfo.listenSocket == INVALID_SOCKET || \
+		bind( eventLoopInfo.listenSocket, ( struct sockaddr * ) &serverAddr,
+			  sizeof( struct sockaddr_in ) ) == SOCKET_ERROR || \
+		listen( eventLoopInfo.listenSocket, 
+				EVENTLOOP_CONNECTIONS ) == SOCKET_ERROR || \
+		getsockname( eventLoopInfo.listenSocket, 
+					 ( struct sockaddr * ) &serverAddr, 
+					 &addrLen ) == SOCKET_ERROR || \
+		fcntl( eventLoopInfo.listenSocket, F_SETFL, O_NONBLOCK ) < 0 )
+		{
+		printf( "Couldn't create listen socket, line %d.\n", __LINE__ );
+		if( eventLoopInfo.listenSocket != INVALID_SOCKET )
+			closesocket( eventLoopInfo.listenSocket );
+		cryptDestroyContext( eventLoopInfo.privateKey );
+		return( FALSE );
+		}
+	eventLoopInfo.epollFD = epoll_create1( 0 );
+	memset( &event, 0, sizeof( struct epoll_event ) );
+	event.events = EPOLLIN;
+	event.data.u32 = EVENTLOOP_LISTEN_INDEX;
+	epoll_ctl( eventLoopInfo.epollFD, EPOLL_CTL_ADD, 
+			   eventLoopInfo.listenSocket, &event );
+
+	/* Start the event loop and perform the handshakes for all of the 
+	   client connections concurrently */
+	pthread_create( &loopThread, NULL, eventLoopThread, &eventLoopInfo );
+	gettimeofday( &startTime, NULL );
+	status = connectEventLoopClients( cryptSession, 
+									  ntohs( serverAddr.sin_port ) );
+	connectTime = getElapsedTime( &startTime );
+
+	/* Run the echo rounds across all of the connections */
+	if( cryptStatusOK( status ) )
+		{
+		gettimeofday( &startTime, NULL );
+		for( round = 0; round < EVENTLOOP_ROUNDS; round++ )
+			{
+			status = echoEventLoopRound( cryptSession, round );
+			if( cryptStatusError( status ) )
+				break;
+			}
+		echoTime = getElapsedTime( &startTime );
+		}
+
+	/* Shut down the clients and then the server */
+	for( i = 0; i < EVENTLOOP_CONNECTIONS; i++ )
+		{
+		if( cryptSession[ i ] != CRYPT_UNUSED )
+			cryptDestroySession( cryptSession[ i ] );
+		}
+	eventLoopInfo.isShutdown = TRUE;
+	pthread_join( loopThread, NULL );
+	close( eventLoopInfo.epollFD );
+	closesocket( eventLoopInfo.listenSocket );
+	cryptDestroyContext( eventLoopInfo.privateKey );
+	if( cryptStatusError( status ) )
+		{
+		printf( "Event-driven TLS server test failed, line %d.\n", 
+				__LINE__ );
+		return( FALSE );
+		}
+
+	printf( "  %d concurrent handshakes completed in %ld ms by 1 "
+			"event-loop thread.\n", EVENTLOOP_CONNECTIONS, connectTime );
+	printf( "  %d concurrent connections serviced by 1 event-loop thread, "
+			"%d round trips\n  of %d bytes in %ld ms (%ld round trips/s).\n",
+			EVENTLOOP_CONNECTIONS, EVENTLOOP_CONNECTIONS * EVENTLOOP_ROUNDS, 
+			EVENTLOOP_MSG_SIZE, echoTime, 
+			( EVENTLOOP_CONNECTIONS * EVENTLOOP_ROUNDS * 1000L ) / \
+				max( echoTime, 1 ) );
+	puts( "Event-driven TLS server test succeeded.\n" );
+	return( TRUE );
+	}
+
+/****************************************************************************
+*																			*
+*								Corked TLS Writes							*
+*																			*
+****************************************************************************/
+
+/* Check that writes made while a session is corked are held back and are 
+   then sent as a single TLS record when the session is uncorked.  The 
+   client writes a message in many small pieces, flushing each one, and we 
+   look at the raw data arriving at the server's socket to make sure that 
+   nothing is sent until the cork is removed and that what's sent then is a 
+   single record containing all of the pieces */
+
+#define CORK_PIECES				50
+#define CORK_PIECE_SIZE			16
+#define TLS_RECORD_APPDATA		23
+
+typedef struct {
+	CRYPT_SESSION cryptSession;	/* Server session */
+	CRYPT_CONTEXT privateKey;	/* Server private key */
+	SOCKET netSocket;			/* Server's side of the connection */
+	int status;					/* Handshake status */
+	} CORK_SERVER_INFO;
+
+static void *corkServerThread( void *arg )
+	{
+	CORK_SERVER_INFO *serverInfo = arg;
+	int status;
+
+	status = cryptCreateSession( &serverInfo->cryptSession, CRYPT_UNUSED,
+								 CRYPT_SESSION_SSL_SERVER );
+	if( cryptStatusError( status ) )
+		{
+		serverInfo->cryptSession = CRYPT_UNUSED;
+		serverInfo->status = status;
+		THREAD_EXIT();
+		}
+	status = cryptSetAttribute( serverInfo->cryptSession, 
+								CRYPT_SESSINFO_PRIVATEKEY,
+								serverInfo->privateKey );
+	if( cryptStatusOK( status ) )
+		{
+		status = cryptSetAttribute( serverInfo->cryptSession, 
+									CRYPT_SESSINFO_NETWORKSOCKET, 
+									serverInfo->netSocket );
+		}
+	if( cryptStatusOK( status ) )
+		{
+		status = cryptSetAttribute( serverInfo->cryptSession, 
+									CRYPT_SESSINFO_ACTIVE, TRUE );
+		}
+	if( cryptStatusError( status ) )
+		{
+		printExtError( serverInfo->cryptSession, "Cork test server "
+					   "activation", status, __LINE__ );
+		}
+	serverInfo->status = status;
+
+	THREAD_EXIT();
+	}
+
+/* Send the message in corked pieces and check how it arrives at the 
+   server */
+
+static int corkedWrite( const CRYPT_SESSION cryptSession, 
+						const SOCKET serverSocket )
+	{
+	struct pollfd pollInfo;
+	BYTE buffer[ CORK_PIECE_SIZE ], header[ 5 ];
+	int recordLength, i, status;
+
+	/* Cork the session and write the message a piece at a time */
+	status = cryptSetAttribute( cryptSession, CRYPT_SESSINFO_CORK, TRUE );
+	if( cryptStatusError( status ) )
+		{
+		printExtError( cryptSession, "Cork test cork", status, __LINE__ );
+		return( status );
+		}
+	for( i = 0; i < CORK_PIECES; i++ )
+		{
+		int bytesCopied;
+
+		memset( buffer, i, CORK_PIECE_SIZE );
+		status = cryptPushData( cryptSession, buffer, CORK_PIECE_SIZE, 
+								&bytesCopied );
+		if( cryptStatusOK( status ) )
+			status = cryptFlushData( cryptSession );
+		if( cryptStatusError( status ) )
+			{
+			printExtError( cryptSession, "Cork test corked write", status, 
+						   __LINE__ );
+			return( status );
+			}
+		}
+
+	/* Nothing should have been sent yet */
+	memset( &pollInfo, 0, sizeof( struct pollfd ) );
+	pollInfo.fd = serverSocket;
+	pollInfo.events = POLLIN;
+	if( poll( &pollInfo, 1, 500 ) != 0 )
+		{
+		printf( "Data written to corked session was sent before the "
+				"session was uncorked, line %d.\n", __LINE__ );
+		return( CRYPT_ERROR_FAILED );
+		}
+
+	/* Uncork the session, which should send everything as a single 
+	   record */
+	status = cryptSetAttribute( cryptSession, CRYPT_SESSINFO_CORK, FALSE );
+	if( cryptStatusError( status ) )
+		{
+		printExtError( cryptSession, "Cork test uncork", status, __LINE__ );
+		return( status );
+		}
+	if( poll( &pollInfo, 1, 5000 ) != 1 || \
+		recv( serverSocket, header, 5, MSG_PEEK | MSG_WAITALL ) != 5 )
+		{
+		printf( "Data held back by corked session wasn't sent when the "
+				"session was uncorked, line %d.\n", __LINE__ );
+		return( CRYPT_ERROR_FAILED );
+		}
+	recordLength = ( header[ 3 ] << 8 ) | header[ 4 ];
+	if( header[ 0 ] != TLS_RECORD_APPDATA || \
+		recordLength < CORK_PIECES * CORK_PIECE_SIZE )
+		{
+		printf( "Corked writes weren't coalesced, first record has type "
+				"%d and length %d, should be type %d with length at least "
+				"%d, line %d.\n", header[ 0 ], recordLength, 
+				TLS_RECORD_APPDATA, CORK_PIECES * CORK_PIECE_SIZE, 
+				__LINE__ );
+		return( CRYPT_ERROR_FAILED );
+		}
+
+	return( CRYPT_OK );
+	}
+
+/* Make sure that the server received the pieces intact and in order */
+
+static int checkCorkedData( const CRYPT_SESSION cryptSession )
+	{
+	BYTE buffer[ CORK_PIECES * CORK_PIECE_SIZE ];
+	int length = 0, i, status;
+
+	while( length < CORK_PIECES * CORK_PIECE_SIZE )
+		{
+		int bytesCopied;
+
+		status = cryptPopData( cryptSession, buffer + length, 
+							   CORK_PIECES * CORK_PIECE_SIZE - length, 
+							   &bytesCopied );
+		if( cryptStatusOK( status ) && bytesCopied <= 0 )
+			status = CRYPT_ERROR_TIMEOUT;
+		if( cryptStatusError( status ) )
+			{
+			printExtError( cryptSession, "Cork test server read", status, 
+						   __LINE__ );
+			return( status );
+			}
+		length += bytesCopied;
+		}
+	for( i = 0; i < CORK_PIECES * CORK_PIECE_SIZE; i++ )
+		{
+		if( buffer[ i ] != ( i / CORK_PIECE_SIZE ) )
+			{
+			printf( "Data received from corked session doesn't match "
+					"sent data at position %d, line %d.\n", i, __LINE__ );
+			return( CRYPT_ERROR_BADDATA );
+			}
+		}
+
+	return( CRYPT_OK );
+	}
+
+int testSessionTLSCorkClientServer( void )
+	{
+	CORK_SERVER_INFO serverInfo;
+	CRYPT_SESSION cryptSession = CRYPT_UNUSED;
+	SOCKET listenSocket, clientSocket = INVALID_SOCKET;
+	pthread_t serverThread;
+	struct sockaddr_in serverAddr;
+	socklen_t addrLen = sizeof( struct sockaddr_in );
+	char filenameBuffer[ FILENAME_BUFFER_SIZE ];
+	int status;
+
+	puts( "Testing TLS write coalescing via a corked session..." );
+
+	/* Set up the server key and a pair of connected sockets.  We let the 
+	   system choose the port since we're managing the sockets ourselves */
+	memset( &serverInfo, 0, sizeof( CORK_SERVER_INFO ) );
+	serverInfo.cryptSession = CRYPT_UNUSED;
+	serverInfo.netSocket = INVALID_SOCKET;
+	filenameFromTemplate( filenameBuffer, SERVER_PRIVKEY_FILE_TEMPLATE, 1 );
+	status = getPrivateKey( &serverInfo.privateKey, filenameBuffer,
+							USER_PRIVKEY_LABEL, TEST_PRIVKEY_PASSWORD );
+	if( cryptStatusError( status ) )
+		{
+		printf( "Couldn't read server private key, status %d, line %d.\n",
+				status, __LINE__ );
+		return( FALSE );
+		}
+	memset( &serverAddr, 0, sizeof( struct sockaddr_in ) );
+	serverAddr.sin_family = AF_INET;
+	serverAddr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+	listenSocket = socket( PF_INET, SOCK_STREAM, 0 );
+	if( listenSocket != INVALID_SOCKET && \
+		bind( listenSocket, ( struct sockaddr * ) &serverAddr,
+			  sizeof( struct sockaddr_in ) ) != SOCKET_ERROR && \
+		listen( listenSocket, 1 ) != SOCKET_ERROR && \
+		getsockname( listenSocket, ( struct sockaddr * ) &serverAddr, 
+					 &addrLen ) != SOCKET_ERROR )
+		{
+		clientSocket = socket( PF_INET, SOCK_STREAM, 0 );
+		if( clientSocket != INVALID_SOCKET && \
+			connect( clientSocket, ( struct sockaddr * ) &serverAddr,
+					 sizeof( struct sockaddr_in ) ) != SOCKET_ERROR )
+			serverInfo.netSocket = accept( listenSocket, NULL, NULL );
+		}
+	if( listenSocket != INVALID_SOCKET )
+		closesocket( listenSocket );
+	if( serverInfo.netSocket == INVALID_SOCKET )
+		{
+		printf( "Couldn't create connected sockets, line %d.\n", __LINE__ );
+		if( clientSocket != INVALID_SOCKET )
+			closesocket( clientSocket );
+		cryptDestroyContext( serverInfo.privateKey );
+		return( FALSE );
+		}
+
+	/* Establish the session, with the server side running in its own 
+	   thread */
+	pthread_create( &serverThread, NULL, corkServerThread, &serverInfo );
+	status = cryptCreateSession( &cryptSession, CRYPT_UNUSED, 
+								 CRYPT_SESSION_SSL );
+	if( cryptStatusOK( status ) )
+		{
+		status = cryptSetAttribute( cryptSession, 
+									CRYPT_SESSINFO_NETWORKSOCKET, 
+									clientSocket );
+		if( cryptStatusOK( status ) )
+			{
+			status = cryptSetAttribute( cryptSession, 
+										CRYPT_SESSINFO_ACTIVE, TRUE );
+			}
+		if( cryptStatusError( status ) )
+			{
+			printExtError( cryptSession, "Cork test client activation", 
+						   status, __LINE__ );
+			}
+		}
+	else
+		cryptSession = CRYPT_UNUSED;
+	pthread_join( serverThread, NULL );
+	if( cryptStatusOK( status ) )
+		status = serverInfo.status;
+
+	/* Send the data corked and check that it arrives as a single record */
+	if( cryptStatusOK( status ) )
+		status = corkedWrite( cryptSession, serverInfo.netSocket );
+	if( cryptStatusOK( status ) )
+		status = checkCorkedData( serverInfo.cryptSession );
+
+	/* Clean up */
+	if( cryptSession != CRYPT_UNUSED )
+		cryptDestroySession( cryptSession );
+	if( serverInfo.cryptSession != CRYPT_UNUSED )
+		cryptDestroySession( serverInfo.cryptSession );
+	closesocket( clientSocket );
+	closesocket( serverInfo.netSocket );
+	cryptDestroyContext( serverInfo.privateKey );
+	if( cryptStatusError( status ) )
+		{
+		printf( "Corked TLS write test failed, line %d.\n", __LINE__ );
+		return( FALSE );
+		}
+
+	printf( "  %d corked %d-byte writes were sent as a single record on "
+			"uncork.\n", CORK_PIECES, CORK_PIECE_SIZE );
+	puts( "Corked TLS write test succeeded.\n" );
+	return( TRUE );
+	}
+#endif /* Linux && UNIX_THREADS */
+
 #endif /* TEST_SESSION || TEST_SESSION_LOOPBACK */
@@ -1021,6 +1021,7 @@ int testSessionTLS12ServerClientCertManual( void );
   int testSessionTLSSharedKeyClientServer( void );
   int testSessionTLSNoSharedKeyClientServer( void );
   int testSessionTLSBulkTransferClientServer( void );
+  int testSessionTLSReadAheadClientServer( void );
   int testSessionTLS11ClientServer( void );
   int testSessionTLS11ClientCertClientServer( void );
   int testSessionTLS11ResumeClientServer( void );
@@ -1029,6 +1030,13 @@ int testSessionTLS12ServerClientCertManual( void );
   int testSessionTLS12ClientServerEcc384Key( void );
   int testSessionTLS12ClientCertClientServer( void );
   int testSessionTLS12ClientCertManualClientServer( void );
+  int testSessionTLS13ClientServer( void );
+  int testSessionTLS13ResumeClientServer( void );
+  int testSessionTLS13HelloRetryClientServer( void );
+  #if defined( __linux__ ) && defined( UNIX_THREADS )
+	int testSessionTLSEventLoopClientServer( void );
+	int testSessionTLSCorkClientServer( void );
+  #endif /* Linux && UNIX_THREADS */
   int testSessionTLSClientServerDualThread( void );
   int testSessionTLSClientServerMultiThread( void );
   int testSessionSSLClientServerDebugCheck( void );
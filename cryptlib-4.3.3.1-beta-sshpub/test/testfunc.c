@@ -605,6 +605,21 @@ static struct {
 { CRYPT_OPTION_MISC_ASYNCINIT, "CRYPT_OPTION_MISC_ASYNCINIT", TRUE },
 { CRYPT_OPTION_MISC_SIDECHANNELPROTECTION, "CRYPT_OPTION_MISC_SIDECHANNELPROTECTION", TRUE },
 
+{ CRYPT_OPTION_SESSION_KEYPOOLSIZE, "CRYPT_OPTION_SESSION_KEYPOOLSIZE", TRUE },
+{ CRYPT_OPTION_SESSION_KEYPOOLLOWWATER, "CRYPT_OPTION_SESSION_KEYPOOLLOWWATER", TRUE },
+{ CRYPT_OPTION_SESSION_TICKETKEYFILE, "CRYPT_OPTION_SESSION_TICKETKEYFILE", FALSE },
+{ CRYPT_OPTION_SESSION_CACHESIZE, "CRYPT_OPTION_SESSION_CACHESIZE", TRUE },
+{ CRYPT_OPTION_SESSION_CACHEFILE, "CRYPT_OPTION_SESSION_CACHEFILE", FALSE },
+{ CRYPT_OPTION_SESSION_OCSPSTAPLING, "CRYPT_OPTION_SESSION_OCSPSTAPLING", TRUE },
+{ CRYPT_OPTION_SESSION_OCSPRESPONDER, "CRYPT_OPTION_SESSION_OCSPRESPONDER", FALSE },
+{ CRYPT_OPTION_SESSION_KEYPOOLHITS, "CRYPT_OPTION_SESSION_KEYPOOLHITS", TRUE },
+{ CRYPT_OPTION_SESSION_KEYPOOLMISSES, "CRYPT_OPTION_SESSION_KEYPOOLMISSES", TRUE },
+{ CRYPT_OPTION_SESSION_TICKETHITS, "CRYPT_OPTION_SESSION_TICKETHITS", TRUE },
+{ CRYPT_OPTION_SESSION_TICKETMISSES, "CRYPT_OPTION_SESSION_TICKETMISSES", TRUE },
+
+{ CRYPT_OPTION_MISC_CPUTIER, "CRYPT_OPTION_MISC_CPUTIER", TRUE },
+{ CRYPT_OPTION_MISC_CPUKERNELS, "CRYPT_OPTION_MISC_CPUKERNELS", FALSE },
+
 { CRYPT_ATTRIBUTE_NONE, NULL, 0 }
 };
 
@@ -1260,6 +1275,8 @@ BOOLEAN testSessionsLoopback(void)
 		return(FALSE);
 	if (!testSessionTLSBulkTransferClientServer())
 		return(FALSE);
+	if (!testSessionTLSReadAheadClientServer())
+		return(FALSE);
 	if (!testSessionTLS11ClientServer())
 		return(FALSE);
 	if (!testSessionTLS11ClientCertClientServer())
@@ -1270,6 +1287,18 @@ BOOLEAN testSessionsLoopback(void)
 		return(FALSE);
 	if (!testSessionTLS12ClientCertManualClientServer())
 		return(FALSE);
+	if (!testSessionTLS13ClientServer())
+		return(FALSE);
+	if (!testSessionTLS13ResumeClientServer())
+		return(FALSE);
+	if (!testSessionTLS13HelloRetryClientServer())
+		return(FALSE);
+#if defined( __linux__ ) && defined( UNIX_THREADS )
+	if (!testSessionTLSEventLoopClientServer())
+		return(FALSE);
+	if (!testSessionTLSCorkClientServer())
+		return(FALSE);
+#endif /* Linux && UNIX_THREADS */
 	if (!testSessionSSLClientServerDebugCheck())
 		return(FALSE);
 	if (!testSessionHTTPCertstoreClientServer())
@@ -488,7 +488,9 @@ static int encTests( const CRYPT_DEVICE cryptDevice,
 							   ( cryptAlgo == CRYPT_ALGO_DES ) ? 8 : \
 							   ( cryptAlgo == CRYPT_ALGO_3DES || \
 							     cryptAlgo == CRYPT_ALGO_RC4 || \
-								 cryptAlgo == CRYPT_ALGO_AES ) ? 16 : 0 );
+								 cryptAlgo == CRYPT_ALGO_AES || \
+								 ( cryptAlgo >= CRYPT_ALGO_FIRST_MAC && \
+								   cryptAlgo <= CRYPT_ALGO_LAST_MAC ) ) ? 16 : 0 );
 		timeVal = timeDiff( timeVal );
 		if( status == CRYPT_ERROR_NOTAVAIL || !status )
 			return( FALSE );
@@ -553,7 +555,11 @@ static void performanceTests( const CRYPT_DEVICE cryptDevice,
 	encTests( cryptDevice, CRYPT_ALGO_AES, CRYPT_MODE_CBC, buffer, ticksPerSec );
 	putchar( '\n' );
 	encTests( cryptDevice, CRYPT_ALGO_MD5, CRYPT_MODE_NONE, buffer, ticksPerSec );
-	encTests( cryptDevice, CRYPT_ALGO_SHA, CRYPT_MODE_NONE, buffer, ticksPerSec );
+	encTests( cryptDevice, CRYPT_ALGO_SHA1, CRYPT_MODE_NONE, buffer, ticksPerSec );
+	encTests( cryptDevice, CRYPT_ALGO_SHA2, CRYPT_MODE_NONE, buffer, ticksPerSec );
+	putchar( '\n' );
+	encTests( cryptDevice, CRYPT_ALGO_HMAC_SHA1, CRYPT_MODE_NONE, buffer, ticksPerSec );
+	encTests( cryptDevice, CRYPT_ALGO_HMAC_SHA2, CRYPT_MODE_NONE, buffer, ticksPerSec );
 	free( buffer );
 	}
 
@@ -1034,16 +1040,16 @@ static BOOLEAN loadDSAKey( const CRYPT_DEVICE cryptDevice,
 
 static int encRSATest( const CRYPT_CONTEXT cryptContext,
 					   const CRYPT_CONTEXT decryptContext,
-					   HIRES_TIME times[] )
+					   HIRES_TIME times[], const int length )
 	{
 	BYTE buffer[ CRYPT_MAX_PKCSIZE ];
 	HIRES_TIME timeVal;
 	int status;
 
-	memset( buffer, '*', 128 );
+	memset( buffer, '*', length );
 	buffer[ 0 ] = 1;
 	timeVal = timeDiff( 0 );
-	status = cryptEncrypt( cryptContext, buffer, 128 );
+	status = cryptEncrypt( cryptContext, buffer, length );
 	times[ 0 ] = timeDiff( timeVal );
 	if( cryptStatusError( status ) )
 		{
@@ -1051,7 +1057,7 @@ static int encRSATest( const CRYPT_CONTEXT cryptContext,
 		return( FALSE );
 		}
 	timeVal = timeDiff( 0 );
-	status = cryptDecrypt( decryptContext, buffer, 128 );
+	status = cryptDecrypt( decryptContext, buffer, length );
 	times[ 1 ] = timeDiff( timeVal );
 	if( cryptStatusError( status ) )
 		{
@@ -1079,7 +1085,7 @@ static BOOLEAN testRSA( long ticksPerSec )
 		{
 		int status;
 
-		status = encRSATest( cryptContext, decryptContext, times[ i ] );
+		status = encRSATest( cryptContext, decryptContext, times[ i ], 128 );
 		if( !status )
 			return( FALSE );
 		}
@@ -1092,6 +1098,68 @@ static BOOLEAN testRSA( long ticksPerSec )
 	return( TRUE );
 	}
 
+/* Time the RSA operation speed for the larger key sizes, for which the 
+   private-key op is dominated by the modexp for the CRT halves.  Since we 
+   don't have fixed test keys of these sizes we generate them on the fly */
+
+static const int rsaKeySizes[] = { 2048, 3072, 4096, 0 };
+
+static BOOLEAN testRSAKeysizes( long ticksPerSec )
+	{
+	int keySizeIndex;
+
+	for( keySizeIndex = 0; rsaKeySizes[ keySizeIndex ] != 0; 
+		 keySizeIndex++ )
+		{
+		CRYPT_CONTEXT cryptContext;
+		HIRES_TIME times[ NO_TESTS + 1 ][ 8 ];
+		const int keySize = rsaKeySizes[ keySizeIndex ];
+		int i, status;
+
+		memset( times, 0, sizeof( times ) );
+
+		/* Generate the RSA key */
+		status = cryptCreateContext( &cryptContext, CRYPT_UNUSED, 
+									 CRYPT_ALGO_RSA );
+		if( cryptStatusError( status ) )
+			return( FALSE );
+		status = cryptSetAttributeString( cryptContext, CRYPT_CTXINFO_LABEL,
+										  "RSA key", strlen( "RSA key" ) );
+		if( cryptStatusOK( status ) )
+			status = cryptSetAttribute( cryptContext, CRYPT_CTXINFO_KEYSIZE,
+										keySize / 8 );
+		if( cryptStatusOK( status ) )
+			status = cryptGenerateKey( cryptContext );
+		if( cryptStatusError( status ) )
+			{
+			printf( "RSA %d-bit key generation failed, status = %d.\n", 
+					keySize, status );
+			cryptDestroyContext( cryptContext );
+			return( FALSE );
+			}
+
+		/* Encrypt and decrypt a test buffer, the latter being the same 
+		   operation as a signature */
+		printf( "RSA %d-bit ", keySize );
+		for( i = 0; i < NO_TESTS + 1; i++ )
+			{
+			status = encRSATest( cryptContext, cryptContext, times[ i ], 
+								 keySize / 8 );
+			if( !status )
+				{
+				cryptDestroyContext( cryptContext );
+				return( FALSE );
+				}
+			}
+		printTimes( times, 2, ticksPerSec );
+
+		/* Clean up */
+		cryptDestroyContext( cryptContext );
+		}
+
+	return( TRUE );
+	}
+
 /* Time the DSA operation speed */
 
 static BOOLEAN testDSA( long ticksPerSec )
@@ -1255,6 +1323,7 @@ int main( int argc, char **argv )
 			  "start of timings.c?)" );
 		}
 	testRSA( ticksPerSec );
+	testRSAKeysizes( ticksPerSec );
 	status = testDSA( ticksPerSec );
 	if( !status )
 		{